@@ -41,3 +41,7 @@ MACRO(FEATURE_METIS_FIND_EXTERNAL var)
 ENDMACRO()
 
 CONFIGURE_FEATURE(METIS)
+
+IF(DEAL_II_WITH_METIS)
+  SET(DEAL_II_METIS_WITH_PARMETIS ${METIS_WITH_PARMETIS})
+ENDIF()
@@ -0,0 +1,46 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2020 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Configuration for the ADIOS2 library:
+#
+
+MACRO(FEATURE_ADIOS2_FIND_EXTERNAL var)
+  FIND_PACKAGE(ADIOS2)
+
+  IF(ADIOS2_FOUND)
+    SET(${var} TRUE)
+
+    #
+    # A parallel deal.II must not be linked against a serial ADIOS2, since
+    # the parallel writer of DataOutBase::ADIOS2Stream requires the MPI
+    # flavor of the library:
+    #
+    IF(DEAL_II_WITH_MPI AND NOT ADIOS2_WITH_MPI)
+      MESSAGE(STATUS "Insufficient ADIOS2 installation found: "
+        "deal.II is configured with MPI, but the MPI flavor of the ADIOS2 "
+        "libraries (adios2_cxx11_mpi, adios2_core_mpi) was not found."
+        )
+      SET(ADIOS2_ADDITIONAL_ERROR_STRING
+        "Insufficient ADIOS2 installation found!\n"
+        "deal.II is configured with MPI, but the MPI flavor of the ADIOS2 "
+        "libraries (adios2_cxx11_mpi, adios2_core_mpi) was not found.\n"
+        )
+      SET(${var} FALSE)
+    ENDIF()
+  ENDIF()
+ENDMACRO()
+
+CONFIGURE_FEATURE(ADIOS2)
@@ -0,0 +1,77 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2020 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Try to find the ADIOS2 libraries
+#
+# This module exports
+#
+#   ADIOS2_LIBRARIES
+#   ADIOS2_INCLUDE_DIRS
+#   ADIOS2_WITH_MPI
+#
+
+SET(ADIOS2_DIR "" CACHE PATH "An optional hint to an ADIOS2 installation")
+SET_IF_EMPTY(ADIOS2_DIR "$ENV{ADIOS2_DIR}")
+
+DEAL_II_FIND_LIBRARY(ADIOS2_CXX11_LIB NAMES adios2_cxx11
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+DEAL_II_FIND_LIBRARY(ADIOS2_CORE_LIB NAMES adios2_core
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+#
+# The MPI flavor of the libraries is only picked up if deal.II is configured
+# with MPI:
+#
+IF(DEAL_II_WITH_MPI)
+  DEAL_II_FIND_LIBRARY(ADIOS2_CXX11_MPI_LIB NAMES adios2_cxx11_mpi
+    HINTS ${ADIOS2_DIR}
+    PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+    )
+
+  DEAL_II_FIND_LIBRARY(ADIOS2_CORE_MPI_LIB NAMES adios2_core_mpi
+    HINTS ${ADIOS2_DIR}
+    PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+    )
+ENDIF()
+
+DEAL_II_FIND_PATH(ADIOS2_INC adios2.h
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES include
+  )
+
+IF(EXISTS "${ADIOS2_CXX11_MPI_LIB}" AND EXISTS "${ADIOS2_CORE_MPI_LIB}")
+  SET(ADIOS2_WITH_MPI TRUE)
+ELSE()
+  SET(ADIOS2_WITH_MPI FALSE)
+ENDIF()
+
+DEAL_II_PACKAGE_HANDLE(ADIOS2
+  LIBRARIES
+    REQUIRED ADIOS2_CXX11_LIB ADIOS2_CORE_LIB
+    OPTIONAL ADIOS2_CXX11_MPI_LIB ADIOS2_CORE_MPI_LIB
+  INCLUDE_DIRS
+    REQUIRED ADIOS2_INC
+  USER_INCLUDE_DIRS
+    REQUIRED ADIOS2_INC
+  CLEAR
+    ADIOS2_CXX11_LIB ADIOS2_CORE_LIB ADIOS2_CXX11_MPI_LIB ADIOS2_CORE_MPI_LIB
+    ADIOS2_INC
+  )
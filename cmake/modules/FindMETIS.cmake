@@ -24,11 +24,15 @@
 #   METIS_VERSION_MAJOR
 #   METIS_VERSION_MINOR
 #   METIS_VERSION_SUBMINOR
+#   METIS_WITH_PARMETIS
 #
 
 SET(METIS_DIR "" CACHE PATH "An optional hint to a metis directory")
 SET_IF_EMPTY(METIS_DIR "$ENV{METIS_DIR}")
 
+SET(PARMETIS_DIR "" CACHE PATH "An optional hint to a parmetis directory")
+SET_IF_EMPTY(PARMETIS_DIR "$ENV{PARMETIS_DIR}")
+
 #
 # Metis is usually pretty self contained. So no external dependencies
 # so far. But there could be dependencies on pcre and mpi...
@@ -51,6 +55,35 @@ DEAL_II_FIND_PATH(METIS_INCLUDE_DIR metis.h
   PATH_SUFFIXES metis include/metis include
   )
 
+#
+# ParMETIS is optional and only of use if we also have MPI. It is usually
+# installed alongside METIS, so also look in the METIS directory.
+#
+IF(DEAL_II_WITH_MPI)
+  GET_FILENAME_COMPONENT(_path "${METIS_LIBRARY}" PATH)
+  DEAL_II_FIND_LIBRARY(PARMETIS_LIBRARY
+    NAMES parmetis
+    HINTS ${PARMETIS_DIR} ${_path} ${METIS_DIR}
+    PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+    )
+  DEAL_II_FIND_PATH(PARMETIS_INCLUDE_DIR parmetis.h
+    HINTS ${PARMETIS_DIR} ${METIS_INCLUDE_DIR} ${METIS_DIR}
+    PATH_SUFFIXES parmetis include/parmetis include
+    )
+ELSE()
+  SET(PARMETIS_LIBRARY "PARMETIS_LIBRARY-NOTFOUND")
+  SET(PARMETIS_INCLUDE_DIR "PARMETIS_INCLUDE_DIR-NOTFOUND")
+ENDIF()
+
+IF(NOT PARMETIS_LIBRARY MATCHES "-NOTFOUND" AND
+   EXISTS ${PARMETIS_INCLUDE_DIR}/parmetis.h)
+  SET(METIS_WITH_PARMETIS TRUE)
+ELSE()
+  SET(METIS_WITH_PARMETIS FALSE)
+  SET(PARMETIS_LIBRARY "PARMETIS_LIBRARY-NOTFOUND")
+  SET(PARMETIS_INCLUDE_DIR "PARMETIS_INCLUDE_DIR-NOTFOUND")
+ENDIF()
+
 IF(EXISTS ${METIS_INCLUDE_DIR}/metis.h)
   #
   # Extract the version number out of metis.h
@@ -83,11 +116,14 @@ ENDIF()
 
 DEAL_II_PACKAGE_HANDLE(METIS
   LIBRARIES
+    OPTIONAL PARMETIS_LIBRARY
     REQUIRED METIS_LIBRARY
     OPTIONAL MPI_C_LIBRARIES
   INCLUDE_DIRS
     REQUIRED METIS_INCLUDE_DIR
+    OPTIONAL PARMETIS_INCLUDE_DIR
   USER_INCLUDE_DIRS
     REQUIRED METIS_INCLUDE_DIR 
-  CLEAR METIS_LIBRARY METIS_INCLUDE_DIR
+    OPTIONAL PARMETIS_INCLUDE_DIR
+  CLEAR METIS_LIBRARY METIS_INCLUDE_DIR PARMETIS_LIBRARY PARMETIS_INCLUDE_DIR
   )
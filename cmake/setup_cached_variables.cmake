@@ -50,6 +50,7 @@
 #
 #     DEAL_II_WITH_64BIT_INDICES
 #     DEAL_II_WITH_COMPLEX_VALUES
+#     DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX
 #     DEAL_II_DOXYGEN_USE_MATHJAX
 #     DEAL_II_COMPILE_EXAMPLES
 #     DEAL_II_CPACK_BUNDLE_NAME
@@ -378,6 +379,11 @@ OPTION(DEAL_II_WITH_COMPLEX_VALUES
   )
 LIST(APPEND DEAL_II_FEATURES COMPLEX_VALUES)
 
+SET(DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX "9" CACHE STRING
+  "The largest polynomial degree for which FEEvaluation with a degree that is only known at run time (fe_degree=-1) uses precompiled, specialized kernels. Higher degrees use a slower, general kernel. Raising this value increases the time needed to compile the matrix-free module."
+  )
+MARK_AS_ADVANCED(DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX)
+
 OPTION(DEAL_II_DOXYGEN_USE_MATHJAX
   "If set to ON, doxygen documentation is generated using mathjax"
   OFF
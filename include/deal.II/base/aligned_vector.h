@@ -35,8 +35,16 @@
 #include <boost/serialization/split_member.hpp>
 
 #include <cstring>
+#include <functional>
+#include <limits>
 #include <type_traits>
 
+#if defined(DEAL_II_WITH_MPI) || defined(DEAL_II_WITH_PETSC)
+#  include <mpi.h>
+#else
+using MPI_Comm = int;
+#endif
+
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -55,6 +63,12 @@ DEAL_II_NAMESPACE_OPEN
  * is a bit more memory-consuming than std::vector because of alignment, so it
  * is recommended to only use this vector on long vectors.
  *
+ * Arrays of at least 8 MB are aligned to 2 MB boundaries and, on Linux, are
+ * marked as candidates for transparent huge pages. Since the elements are
+ * initialized in parallel with the same task partitioning as used by the
+ * parallel copy operations, the memory pages are first touched (and thus
+ * placed on the NUMA domain) by the threads that later access them.
+ *
  * @p author Katharina Kormann, Martin Kronbichler, 2011
  */
 template <class T>
@@ -232,6 +246,32 @@ public:
   void
   fill(const T &element);
 
+  /**
+   * Make the contents of this vector on the process with rank @p root_process
+   * of @p communicator available on all processes of that communicator, e.g.
+   * for large read-only tables that would otherwise be replicated on every
+   * MPI rank. The contents of the vector on the other processes are
+   * discarded.
+   *
+   * If @p T is trivially copyable, the data are stored only once per
+   * shared-memory domain (i.e., compute node): The processes of each node
+   * allocate an MPI-3 shared-memory window, one process per node receives
+   * the data from @p root_process, and all other processes of the node point
+   * into that window. The content must then be treated as read-only, since a
+   * write by one process is seen by all processes of the node. Since the
+   * window is released collectively, all operations that release the memory
+   * of the vector (clear(), the destructor, or growing the vector beyond its
+   * size) must be invoked on all processes of @p communicator. For other
+   * types, the data are serialized and broadcast to every process, which
+   * requires @p T to be serializable.
+   *
+   * This function is collective over @p communicator. If deal.II has been
+   * configured without MPI or MPI has not been initialized, it does nothing.
+   */
+  void
+  replicate_across_communicator(const MPI_Comm &   communicator,
+                                const unsigned int root_process);
+
   /**
    * Swaps the given vector with the calling vector.
    */
@@ -356,6 +396,38 @@ private:
    * Pointer to the end of the allocated memory.
    */
   T *allocated_end;
+
+  /**
+   * If the data of this vector lives in a shared-memory window set up by
+   * replicate_across_communicator(), the function that releases the window.
+   * Empty if the memory has been allocated with posix_memalign().
+   */
+  std::function<void()> release_shared_memory;
+
+  /**
+   * Implementation of replicate_across_communicator() for trivially
+   * copyable types, storing the data once per shared-memory domain.
+   */
+  void
+  replicate_across_communicator(const MPI_Comm &   communicator,
+                                const unsigned int root_process,
+                                const std::true_type);
+
+  /**
+   * Implementation of replicate_across_communicator() for other types,
+   * broadcasting the serialized data to all processes.
+   */
+  void
+  replicate_across_communicator(const MPI_Comm &   communicator,
+                                const unsigned int root_process,
+                                const std::false_type);
+
+  /**
+   * Release the memory pointed to by @p memory, either with
+   * <code>free</code> or through the release_shared_memory function.
+   */
+  void
+  release_memory(T *memory);
 };
 
 
@@ -752,8 +824,10 @@ inline AlignedVector<T>::AlignedVector(AlignedVector<T> &&vec) noexcept
   : data_begin(vec.data_begin)
   , data_end(vec.data_end)
   , allocated_end(vec.allocated_end)
+  , release_shared_memory(std::move(vec.release_shared_memory))
 {
-  vec.data_begin    = nullptr;
+  vec.release_shared_memory = nullptr;
+  vec.data_begin            = nullptr;
   vec.data_end      = nullptr;
   vec.allocated_end = nullptr;
 }
@@ -778,13 +852,15 @@ AlignedVector<T>::operator=(AlignedVector<T> &&vec) noexcept
 {
   clear();
 
-  data_begin    = vec.data_begin;
-  data_end      = vec.data_end;
-  allocated_end = vec.allocated_end;
+  data_begin            = vec.data_begin;
+  data_end              = vec.data_end;
+  allocated_end         = vec.allocated_end;
+  release_shared_memory = std::move(vec.release_shared_memory);
 
-  vec.data_begin    = nullptr;
-  vec.data_end      = nullptr;
-  vec.allocated_end = nullptr;
+  vec.data_begin            = nullptr;
+  vec.data_end              = nullptr;
+  vec.allocated_end         = nullptr;
+  vec.release_shared_memory = nullptr;
 
   return *this;
 }
@@ -883,11 +959,21 @@ AlignedVector<T>::reserve(const size_type size_alloc)
       const size_type size_actual_allocate = new_size * sizeof(T);
 
       // allocate and align along 64-byte boundaries (this is enough for all
-      // levels of vectorization currently supported by deal.II)
+      // levels of vectorization currently supported by deal.II). large
+      // arrays get aligned to the 2 MB boundaries of huge pages instead and
+      // the operating system is asked to back them by huge pages, which
+      // reduces TLB misses when streaming through them. the memory is only
+      // touched by the (parallel) initialization done by the caller, so the
+      // pages get placed close to the threads that will later work on them
+      const std::size_t huge_page_size = 2 * 1024 * 1024;
+      const bool        use_huge_pages =
+        size_actual_allocate >= 4 * huge_page_size;
       T *new_data;
       Utilities::System::posix_memalign(reinterpret_cast<void **>(&new_data),
-                                        64,
+                                        use_huge_pages ? huge_page_size : 64,
                                         size_actual_allocate);
+      if (use_huge_pages)
+        Utilities::System::advise_huge_pages(new_data, size_actual_allocate);
 
       // copy data in case there was some content before and release the old
       // memory with the function corresponding to the one used for allocating
@@ -899,7 +985,7 @@ AlignedVector<T>::reserve(const size_type size_alloc)
           dealii::internal::AlignedVectorMove<T>(new_data,
                                                  new_data + old_size,
                                                  data_begin);
-          free(new_data);
+          release_memory(new_data);
         }
       else
         Assert(new_data == nullptr, ExcInternalError());
@@ -916,11 +1002,14 @@ AlignedVector<T>::clear()
 {
   if (data_begin != nullptr)
     {
-      if (std::is_trivial<T>::value == false)
+      // the elements in a shared-memory window are trivially copyable and
+      // thus trivially destructible, and they must not be touched since
+      // other processes might still be reading them
+      if (std::is_trivial<T>::value == false && !release_shared_memory)
         while (data_end != data_begin)
           (--data_end)->~T();
 
-      free(data_begin);
+      release_memory(data_begin);
     }
   data_begin    = nullptr;
   data_end      = nullptr;
@@ -1009,6 +1098,202 @@ AlignedVector<T>::swap(AlignedVector<T> &vec)
   std::swap(data_begin, vec.data_begin);
   std::swap(data_end, vec.data_end);
   std::swap(allocated_end, vec.allocated_end);
+  std::swap(release_shared_memory, vec.release_shared_memory);
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::release_memory(T *memory)
+{
+  if (release_shared_memory)
+    {
+      release_shared_memory();
+      release_shared_memory = nullptr;
+    }
+  else
+    free(memory);
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::replicate_across_communicator(
+  const MPI_Comm &   communicator,
+  const unsigned int root_process)
+{
+#  ifdef DEAL_II_WITH_MPI
+  int mpi_initialized = 0;
+  int ierr            = MPI_Initialized(&mpi_initialized);
+  AssertThrowMPI(ierr);
+  if (mpi_initialized == 0)
+    return;
+
+  int n_procs = 1;
+  ierr        = MPI_Comm_size(communicator, &n_procs);
+  AssertThrowMPI(ierr);
+  AssertIndexRange(root_process, static_cast<unsigned int>(n_procs));
+  if (n_procs == 1)
+    return;
+
+  replicate_across_communicator(
+    communicator,
+    root_process,
+    std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+#  else
+  (void)communicator;
+  (void)root_process;
+#  endif
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::replicate_across_communicator(
+  const MPI_Comm &   communicator,
+  const unsigned int root_process,
+  const std::true_type)
+{
+#  ifdef DEAL_II_WITH_MPI
+  int rank = 0;
+  int ierr = MPI_Comm_rank(communicator, &rank);
+  AssertThrowMPI(ierr);
+
+  unsigned long long int n_elements = size();
+  ierr                              = MPI_Bcast(
+    &n_elements, 1, MPI_UNSIGNED_LONG_LONG, root_process, communicator);
+  AssertThrowMPI(ierr);
+
+  if (n_elements == 0)
+    {
+      clear();
+      return;
+    }
+
+  // group the processes by shared-memory domain. the data is written by the
+  // root process itself if it is in the group, else by the group's first
+  // process
+  MPI_Comm comm_shmem;
+  ierr = MPI_Comm_split_type(
+    communicator, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &comm_shmem);
+  AssertThrowMPI(ierr);
+  int rank_shmem = 0;
+  ierr           = MPI_Comm_rank(comm_shmem, &rank_shmem);
+  AssertThrowMPI(ierr);
+  int writer_shmem =
+    (rank == static_cast<int>(root_process)) ? rank_shmem : -1;
+  ierr = MPI_Allreduce(
+    MPI_IN_PLACE, &writer_shmem, 1, MPI_INT, MPI_MAX, comm_shmem);
+  AssertThrowMPI(ierr);
+  writer_shmem = std::max(writer_shmem, 0);
+
+  const std::size_t n_bytes = n_elements * sizeof(T);
+  T *               values  = nullptr;
+  MPI_Win           window;
+  ierr = MPI_Win_allocate_shared(rank_shmem == writer_shmem ? n_bytes : 0,
+                                 sizeof(T),
+                                 MPI_INFO_NULL,
+                                 comm_shmem,
+                                 &values,
+                                 &window);
+  AssertThrowMPI(ierr);
+  MPI_Aint window_size = 0;
+  int      disp_unit   = 0;
+  ierr                 = MPI_Win_shared_query(
+    window, writer_shmem, &window_size, &disp_unit, &values);
+  AssertThrowMPI(ierr);
+
+  // the writing processes of all groups form a communicator in which the
+  // root process has rank zero, and exchange the data in chunks whose size
+  // fits into an int
+  MPI_Comm comm_writers;
+  ierr = MPI_Comm_split(communicator,
+                        rank_shmem == writer_shmem ? 0 : MPI_UNDEFINED,
+                        rank == static_cast<int>(root_process) ? -1 : rank,
+                        &comm_writers);
+  AssertThrowMPI(ierr);
+  if (comm_writers != MPI_COMM_NULL)
+    {
+      if (rank == static_cast<int>(root_process))
+        std::memcpy(static_cast<void *>(values), data_begin, n_bytes);
+
+      char *const           bytes = reinterpret_cast<char *>(values);
+      constexpr std::size_t chunk_size =
+        std::numeric_limits<int>::max() / 2;
+      for (std::size_t offset = 0; offset < n_bytes; offset += chunk_size)
+        {
+          ierr = MPI_Bcast(bytes + offset,
+                           std::min(chunk_size, n_bytes - offset),
+                           MPI_BYTE,
+                           0,
+                           comm_writers);
+          AssertThrowMPI(ierr);
+        }
+      ierr = MPI_Comm_free(&comm_writers);
+      AssertThrowMPI(ierr);
+    }
+  // make the data written into the window visible to all processes of the
+  // group
+  ierr = MPI_Win_fence(0, window);
+  AssertThrowMPI(ierr);
+
+  clear();
+  data_begin            = values;
+  data_end              = values + n_elements;
+  allocated_end         = data_end;
+  release_shared_memory = [window, comm_shmem]() mutable {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized == 0)
+      {
+        MPI_Win_free(&window);
+        MPI_Comm_free(&comm_shmem);
+      }
+  };
+#  else
+  (void)communicator;
+  (void)root_process;
+#  endif
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::replicate_across_communicator(
+  const MPI_Comm &   communicator,
+  const unsigned int root_process,
+  const std::false_type)
+{
+#  ifdef DEAL_II_WITH_MPI
+  int rank = 0;
+  int ierr = MPI_Comm_rank(communicator, &rank);
+  AssertThrowMPI(ierr);
+
+  std::vector<char> buffer;
+  if (rank == static_cast<int>(root_process))
+    buffer = Utilities::pack(*this, false);
+  unsigned long long int n_bytes = buffer.size();
+  ierr =
+    MPI_Bcast(&n_bytes, 1, MPI_UNSIGNED_LONG_LONG, root_process, communicator);
+  AssertThrowMPI(ierr);
+  AssertThrow(n_bytes <= static_cast<unsigned long long int>(
+                           std::numeric_limits<int>::max()),
+              ExcNotImplemented());
+  buffer.resize(n_bytes);
+  ierr =
+    MPI_Bcast(buffer.data(), n_bytes, MPI_CHAR, root_process, communicator);
+  AssertThrowMPI(ierr);
+
+  if (rank != static_cast<int>(root_process))
+    *this = Utilities::unpack<AlignedVector<T>>(buffer, false);
+#  else
+  (void)communicator;
+  (void)root_process;
+#  endif
 }
 
 
@@ -1135,11 +1420,13 @@ AlignedVector<T>::load(Archive &ar, const unsigned int)
   size_type vec_size = 0;
   ar &      vec_size;
 
+  // construct the elements before loading into them, which is necessary for
+  // non-trivial types
+  clear();
   if (vec_size > 0)
     {
-      reserve(vec_size);
+      resize_fast(vec_size);
       ar &boost::serialization::make_array(data_begin, vec_size);
-      data_end = data_begin + vec_size;
     }
 }
 
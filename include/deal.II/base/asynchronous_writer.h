@@ -0,0 +1,236 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_asynchronous_writer_h
+#define dealii_asynchronous_writer_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A service that performs output operations on background threads, so that
+ * writing files to disk overlaps with the computations that follow.
+ *
+ * The typical use is that a writer first generates its output into a buffer
+ * on the thread that owns the data (for example by calling
+ * DataOutInterface::write_vtu() with an <code>std::ostringstream</code> as
+ * argument). This part has to be done synchronously since the data may be
+ * changed right after the call. The buffer is then handed over to this
+ * class, which writes it to a file on one of its worker threads:
+ * @code
+ *   std::ostringstream buffer;
+ *   grid_out.write_vtu(triangulation, buffer);
+ *   std::future<void> done =
+ *     AsynchronousWriter::instance().write_file("grid.vtu", buffer.str());
+ *   ...           // continue with the computation
+ *   done.get();   // wait for the file, and rethrow errors during writing
+ * @endcode
+ * This works for every writer of the library that produces its output into
+ * an <code>std::ostream</code>, e.g., DataOutInterface, GridOut,
+ * TableHandler, or the serialization of user data. The function
+ * DataOutInterface::write_vtu_with_pvtu_record_async() uses this class to
+ * write a complete parallel output record in the background.
+ *
+ * The memory held by queued jobs is bounded by the value given to the
+ * constructor or set_max_queued_bytes(). If a new job would exceed this
+ * limit, submit() and write_file() block until enough of the pending jobs
+ * have been completed. A single job that is larger than the limit is
+ * accepted once the queue is empty, so that no job is rejected.
+ *
+ * Jobs are started in the order in which they were submitted. With more
+ * than one worker thread, jobs may run at the same time and complete in a
+ * different order, so several jobs writing to the same file need to be
+ * synchronized by the caller, for example by waiting on the future of the
+ * first job before submitting the second one.
+ *
+ * Exceptions thrown by a job are stored in the future returned for it and
+ * are rethrown when calling <code>get()</code> on that future.
+ *
+ * @note The jobs run on threads that do not participate in any MPI
+ * communication. Jobs must therefore not call MPI functions, and creating
+ * the buffer, which may involve communication, needs to happen before
+ * submitting the job.
+ *
+ * @ingroup threads
+ */
+class AsynchronousWriter
+{
+public:
+  /**
+   * Constructor. Start @p n_threads worker threads and limit the memory
+   * held by jobs that have been submitted but not completed yet to
+   * @p max_queued_bytes bytes.
+   */
+  AsynchronousWriter(const unsigned int n_threads        = 1,
+                     const std::size_t  max_queued_bytes = 256 << 20);
+
+  /**
+   * Destructor. Waits for all submitted jobs to complete and then stops the
+   * worker threads.
+   */
+  ~AsynchronousWriter();
+
+  /**
+   * Return a reference to the object shared by all writers of the library.
+   * It is created with the default arguments of the constructor upon the
+   * first call of this function, and writes all outstanding files when the
+   * program exits.
+   */
+  static AsynchronousWriter &
+  instance();
+
+  /**
+   * Write the content of @p data to the file @p filename on a worker
+   * thread. An existing file of the same name is overwritten. The returned
+   * future becomes ready once the file has been written and closed; an
+   * ExcFileNotOpen or ExcIO exception is stored in it if this failed.
+   */
+  std::future<void>
+  write_file(const std::string &filename, std::string &&data);
+
+  /**
+   * Run the function @p job on a worker thread and return a future that
+   * holds its return value. The argument @p n_bytes is the amount of memory
+   * kept alive by @p job (typically the size of the buffers it captures),
+   * and is accounted for in the memory limit of this object until the job
+   * has completed.
+   */
+  template <typename RT>
+  std::future<RT>
+  submit(const std::function<RT()> &job, const std::size_t n_bytes);
+
+  /**
+   * Wait until all jobs submitted so far have been completed.
+   */
+  void
+  wait();
+
+  /**
+   * Set the maximal amount of memory held by jobs that have been submitted
+   * but not completed.
+   */
+  void
+  set_max_queued_bytes(const std::size_t max_queued_bytes);
+
+  /**
+   * Return the amount of memory currently held by jobs that have been
+   * submitted but not completed.
+   */
+  std::size_t
+  n_queued_bytes() const;
+
+  /**
+   * Return the number of jobs that have been submitted but not completed.
+   */
+  unsigned int
+  n_queued_jobs() const;
+
+private:
+  /**
+   * Put the function @p job into the queue, after waiting until the memory
+   * limit allows to add @p n_bytes more bytes.
+   */
+  void
+  enqueue(std::function<void()> &&job, const std::size_t n_bytes);
+
+  /**
+   * The loop executed by each of the worker threads.
+   */
+  void
+  run_worker();
+
+  /**
+   * The jobs that have not been started yet, together with their size.
+   */
+  std::deque<std::pair<std::function<void()>, std::size_t>> queue;
+
+  /**
+   * The memory held by jobs that have not been completed yet.
+   */
+  std::size_t queued_bytes;
+
+  /**
+   * The number of jobs that have not been completed yet.
+   */
+  unsigned int queued_jobs;
+
+  /**
+   * The limit on the memory held by jobs that have not been completed yet.
+   */
+  std::size_t max_queued_bytes;
+
+  /**
+   * A flag telling the worker threads to stop once the queue is empty.
+   */
+  bool stop_workers;
+
+  /**
+   * Mutex guarding the variables above.
+   */
+  mutable std::mutex mutex;
+
+  /**
+   * Condition variable signaled when a job has been added to the queue, or
+   * when the worker threads should stop.
+   */
+  std::condition_variable job_available;
+
+  /**
+   * Condition variable signaled when a job has been completed.
+   */
+  std::condition_variable job_completed;
+
+  /**
+   * The worker threads.
+   */
+  std::vector<std::thread> workers;
+};
+
+
+
+#ifndef DOXYGEN
+
+template <typename RT>
+std::future<RT>
+AsynchronousWriter::submit(const std::function<RT()> &job,
+                           const std::size_t          n_bytes)
+{
+  // std::function requires a copyable object, so we hold the packaged_task
+  // in a shared pointer
+  const auto task = std::make_shared<std::packaged_task<RT()>>(job);
+  std::future<RT> future = task->get_future();
+  enqueue([task]() { (*task)(); }, n_bytes);
+  return future;
+}
+
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
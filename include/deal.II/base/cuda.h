@@ -57,6 +57,16 @@ namespace Utilities
        */
       ~Handle();
 
+      /**
+       * Set the CUDA stream on which the cuSOLVER and cuSPARSE functions
+       * called with these handles, e.g. in CUDAWrappers::SparseMatrix::vmult(),
+       * are executed. Use the same stream as for the vectors involved, see
+       * LinearAlgebra::CUDAWrappers::Vector::set_stream(), to avoid
+       * synchronizations. The stream is not owned by this object.
+       */
+      void
+      set_stream(const cudaStream_t stream);
+
       /**
        * Pointer to an opaque cuSolverDN context.
        * The handle must be passed to every cuSolverDN library function.
@@ -26,10 +26,15 @@
 
 #include <deal.II/numerics/data_component_interpretation.h>
 
-// To be able to serialize XDMFEntry
+// To be able to serialize XDMFEntry and XDMFTimeSeries
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/vector.hpp>
 
+#include <functional>
+#include <future>
 #include <limits>
+#include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <typeinfo>
@@ -1171,15 +1176,31 @@ namespace DataOutBase
      */
     bool write_higher_order_cells;
 
+    /**
+     * Flag determining whether the nodes that are shared between the
+     * high-order cells of neighboring patches are written only once in VTU
+     * output. Two nodes are merged if their coordinates and all their data
+     * values agree in the single precision used for output, so nodes with
+     * discontinuous data, e.g. from discontinuous elements, are kept apart.
+     * This reduces the size of the output by up to a factor of
+     * $2^\text{dim}$ for low subdivisions and removes the duplicated nodes on
+     * faces for high subdivisions. The flag is only used if
+     * write_higher_order_cells is set.
+     *
+     * Default is <tt>false</tt>.
+     */
+    bool filter_duplicate_vertices;
+
     /**
      * Constructor.
      */
     VtkFlags(
       const double       time  = std::numeric_limits<double>::min(),
       const unsigned int cycle = std::numeric_limits<unsigned int>::min(),
-      const bool         print_date_and_time              = true,
-      const ZlibCompressionLevel compression_level        = best_compression,
-      const bool                 write_higher_order_cells = false);
+      const bool         print_date_and_time               = true,
+      const ZlibCompressionLevel compression_level         = best_compression,
+      const bool                 write_higher_order_cells  = false,
+      const bool                 filter_duplicate_vertices = false);
   };
 
 
@@ -1432,7 +1453,16 @@ namespace DataOutBase
     n_data_sets() const;
 
     /**
-     * Empty functions to do base class inheritance.
+     * Number all the points recorded by write_point() since the last call
+     * to this function, merging duplicate points if requested by the flags.
+     * This function must be called after the last call to write_point() and
+     * before the first call to write_cell().
+     *
+     * Duplicate points are found by distributing the points to buckets
+     * according to a hash of their coordinates, and by merging the points
+     * of each bucket in parallel. Points are only merged if their
+     * coordinates are exactly equal. The resulting numbering is that of the
+     * first occurrence of each point.
      */
     void
     flush_points();
@@ -1446,35 +1476,26 @@ namespace DataOutBase
 
   private:
     /**
-     * Empty class to provide comparison function for Map3DPoint.
+     * A hash function for points, used to merge duplicate points.
      */
-    struct Point3Comp
+    struct Point3Hash
     {
-      bool
-      operator()(const Point<3> &one, const Point<3> &two) const
+      std::size_t
+      operator()(const Point<3> &p) const
       {
-        /*
-         * The return statement below is an optimized version of the following
-         * code:
-         *
-         * for (unsigned int d=0; d<3; ++d)
-         * {
-         *   if (one(d) < two(d))
-         *     return true;
-         *   else if (one(d) > two(d))
-         *     return false;
-         * }
-         * return false;
-         */
-
-        return (one(0) < two(0) ||
-                (!(two(0) < one(0)) &&
-                 (one(1) < two(1) || (!(two(1) < one(1)) && one(2) < two(2)))));
+        std::size_t seed = 0;
+        for (unsigned int d = 0; d < 3; ++d)
+          {
+            // Make sure that 0.0 and -0.0, which compare equal, also have
+            // the same hash
+            const double x = (p(d) == 0. ? 0. : p(d));
+            seed ^= std::hash<double>()(x) + 0x9e3779b9 + (seed << 6) +
+                    (seed >> 2);
+          }
+        return seed;
       }
     };
 
-    using Map3DPoint = std::multimap<Point<3>, unsigned int, Point3Comp>;
-
     /**
      * Flags used to specify filtering behavior.
      */
@@ -1497,19 +1518,25 @@ namespace DataOutBase
     unsigned int vertices_per_cell;
 
     /**
-     * Map of points to an internal index.
+     * The points recorded by write_point() that have not yet been numbered
+     * by flush_points(), indexed by the actual point index.
      */
-    Map3DPoint existing_points;
+    std::vector<Point<3>> written_points;
+
+    /**
+     * The filtered points, indexed by their internal index.
+     */
+    std::vector<Point<3>> existing_points;
 
     /**
      * Map of actual point index to internal point index.
      */
-    std::map<unsigned int, unsigned int> filtered_points;
+    std::vector<unsigned int> filtered_points;
 
     /**
      * Map of cells to the filtered points.
      */
-    std::map<unsigned int, unsigned int> filtered_cells;
+    std::vector<unsigned int> filtered_cells;
 
     /**
      * Data set names.
@@ -2058,6 +2085,107 @@ namespace DataOutBase
     const VtkFlags &flags,
     std::ostream &  out);
 
+  /**
+   * Collective version of write_vtu() that writes the @p patches of all
+   * processes in the communicator @p comm into the single file @p filename
+   * using MPI-IO: Every process writes its piece at an offset into the file
+   * computed from the sizes of the pieces of the processes with lower rank,
+   * and all processes write at the same time. This is the function that
+   * DataOutInterface::write_vtu_in_parallel() calls, and it can be used by
+   * other classes that generate patches by themselves, such as GridOut.
+   * Without MPI, the function falls back to write_vtu().
+   */
+  template <int dim, int spacedim>
+  void
+  write_vtu_in_parallel(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &                nonscalar_data_ranges,
+    const VtkFlags &   flags,
+    const std::string &filename,
+    const MPI_Comm     comm);
+
+  /**
+   * Write a cloud of points, e.g. the locations of particles, along with
+   * data attached to each point in the xml based vtu file format. Every
+   * point is written as a VTK_VERTEX cell of its own.
+   *
+   * In contrast to write_vtu(), this function does not work on patches
+   * (which would need to be of dimension zero and require several heap
+   * allocations for each point), but on the flat arrays @p points and
+   * @p data. The latter contains the value of data set @p i at point @p j
+   * in the entry <code>data(i,j)</code>, so that its number of rows equals
+   * the size of @p data_names. This makes the function suitable for
+   * writing large numbers of points. The interpretation of the data sets in
+   * @p nonscalar_data_ranges and the meaning of @p flags are the same as
+   * for write_vtu(). In particular, the data is written in compressed
+   * binary format if deal.II was configured with zlib.
+   */
+  template <int spacedim>
+  void
+  write_vtu_point_cloud(
+    const std::vector<Point<spacedim>> &points,
+    const Table<2, double> &            data,
+    const std::vector<std::string> &    data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out);
+
+  /**
+   * This function writes the main part of a vtu file for a cloud of points,
+   * see write_vtu_point_cloud(). It is the counterpart of write_vtu_main()
+   * and is used together with write_vtu_header() and write_vtu_footer().
+   */
+  template <int spacedim>
+  void
+  write_vtu_point_cloud_main(
+    const std::vector<Point<spacedim>> &points,
+    const Table<2, double> &            data,
+    const std::vector<std::string> &    data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out);
+
+  /**
+   * Collective version of write_vtu_point_cloud() that writes the points of
+   * all processes in the communicator @p comm into the single file
+   * @p filename, using MPI-IO in the same way as
+   * DataOutInterface::write_vtu_in_parallel(): Every process writes its
+   * piece at an offset into the file computed from the sizes of the pieces
+   * of the processes with lower rank, and all processes write at the same
+   * time. Without MPI, the function falls back to write_vtu_point_cloud().
+   */
+  template <int spacedim>
+  void
+  write_vtu_point_cloud_in_parallel(
+    const std::vector<Point<spacedim>> &points,
+    const Table<2, double> &            data,
+    const std::vector<std::string> &    data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &                nonscalar_data_ranges,
+    const VtkFlags &   flags,
+    const std::string &filename,
+    const MPI_Comm     comm);
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -2379,6 +2507,114 @@ namespace DataOutBase
       &            nonscalar_data_ranges,
     DataOutFilter &filtered_data);
 
+  /**
+   * Return a reduced copy of @p patches for level-of-detail output, e.g.,
+   * for in-situ visualization where the full resolution is not needed.
+   *
+   * Only every @p patch_stride th patch is kept. The number of subdivisions
+   * of each kept patch is reduced to at most @p max_n_subdivisions by
+   * keeping every $k$th point in each coordinate direction, where $k$ is
+   * the smallest divisor of the number of subdivisions of the patch that
+   * reduces it sufficiently. No values are interpolated, so that the data
+   * at the kept points is exact. If @p patch_stride is larger than one, the
+   * neighbor information of the patches is discarded.
+   */
+  template <int dim, int spacedim>
+  std::vector<Patch<dim, spacedim>>
+  reduce_patches(const std::vector<Patch<dim, spacedim>> &patches,
+                 const unsigned int                       max_n_subdivisions,
+                 const unsigned int                       patch_stride = 1);
+
+#ifdef DEAL_II_WITH_ADIOS2
+  /**
+   * A class that streams patches to the ADIOS2 library, see
+   * https://adios2.readthedocs.io, instead of writing them to files in one
+   * of the formats above. Depending on the ADIOS2 engine, the data is
+   * written to disk in the BP format (engines "BP4" or "BP5") or sent to a
+   * running reader, e.g., a visualization or analysis code, without any
+   * file I/O (engines "SST" or "SSC"). Each call to write() produces one
+   * ADIOS2 step.
+   *
+   * Each process writes its own block of the variables "points" (the
+   * coordinates of the nodes), "cells" (the
+   * node indices of each cell in the block, in the order of the VTK
+   * quadrilateral and hexahedron cells) and one variable per data set, named
+   * as in the XDMF output. The variable "time" is only written by the root
+   * process. The attributes "dimension", "space_dimension", "data_set_names"
+   * and "data_set_dimensions" describe the data.
+   *
+   * To bound the cost of the output, the patches can be reduced with
+   * reduce_patches() before they are streamed, see the constructor.
+   */
+  class ADIOS2Stream
+  {
+  public:
+    /**
+     * Constructor. Open the ADIOS2 stream @p stream_name with the ADIOS2
+     * engine @p engine_type and the engine parameters @p engine_parameters,
+     * e.g., <code>{{"QueueLimit", "2"}}</code> for the SST engine. The
+     * patches are reduced to at most @p max_n_subdivisions subdivisions and
+     * every @p patch_stride th patch before they are streamed.
+     */
+    ADIOS2Stream(
+      const std::string &                       stream_name,
+      MPI_Comm                                  comm,
+      const std::string &                       engine_type = "BP4",
+      const std::map<std::string, std::string> &engine_parameters = {},
+      const unsigned int max_n_subdivisions = numbers::invalid_unsigned_int,
+      const unsigned int patch_stride       = 1);
+
+    /**
+     * Destructor. Closes the stream.
+     */
+    ~ADIOS2Stream();
+
+    /**
+     * Stream the data of @p patches at the time @p time as one step. This
+     * function is collective over the communicator passed to the
+     * constructor.
+     */
+    template <int dim, int spacedim>
+    void
+    write(const std::vector<Patch<dim, spacedim>> &patches,
+          const std::vector<std::string> &         data_names,
+          const std::vector<
+            std::tuple<unsigned int,
+                       unsigned int,
+                       std::string,
+                       DataComponentInterpretation::DataComponentInterpretation>>
+            &          nonscalar_data_ranges,
+          const double time);
+
+  private:
+    /**
+     * The ADIOS2 objects, which are hidden here to avoid including the
+     * ADIOS2 headers.
+     */
+    struct Implementation;
+
+    /**
+     * Pointer to the ADIOS2 objects.
+     */
+    std::unique_ptr<Implementation> implementation;
+
+    /**
+     * The maximal number of subdivisions of the streamed patches.
+     */
+    const unsigned int max_n_subdivisions;
+
+    /**
+     * The stride of the streamed patches.
+     */
+    const unsigned int patch_stride;
+
+    /**
+     * The communicator of the processes that write to the stream.
+     */
+    MPI_Comm comm;
+  };
+#endif
+
   /**
    * Given an input stream that contains data written by
    * write_deal_II_intermediate(), determine the <tt>dim</tt> and
@@ -2696,8 +2932,11 @@ public:
    * (those in the given communicator) to a single compressed .vtu file on a
    * shared file system.  The communicator can be a sub communicator of the
    * one used by the computation.  This routine uses MPI I/O to achieve high
-   * performance on parallel filesystems. Also see
-   * DataOutInterface::write_vtu().
+   * performance on parallel filesystems: Each process computes the position
+   * of its piece in the file from the sizes of the pieces of the processes
+   * with lower rank, and all processes then write their data concurrently.
+   * The compression is done in blocks that are processed in parallel by the
+   * available threads. Also see DataOutInterface::write_vtu().
    */
   void
   write_vtu_in_parallel(const std::string &filename, MPI_Comm comm) const;
@@ -2805,6 +3044,34 @@ public:
     const unsigned int n_digits_for_counter = numbers::invalid_unsigned_int,
     const unsigned int n_groups             = 0) const;
 
+  /**
+   * A non-blocking variant of write_vtu_with_pvtu_record() that takes the
+   * same arguments and writes the same files. The output is generated into
+   * memory buffers before this function returns, so the data of the current
+   * object may be changed right afterwards, but the buffers are written to
+   * disk on a worker thread of AsynchronousWriter::instance(). This allows
+   * the output to overlap with the computation of the next time steps.
+   *
+   * The returned future holds the filename of the master file for the pvtu
+   * record once all files of the calling process have been written. Calling
+   * <code>get()</code> on it rethrows exceptions that occurred during
+   * writing.
+   *
+   * @note If @p n_groups is larger than zero and not larger than the number
+   * of processes, the .vtu files are written collectively through MPI I/O.
+   * These writes are done before this function returns, since MPI calls
+   * can not be moved to the worker threads, and only the .pvtu record is
+   * written in the background.
+   */
+  std::future<std::string>
+  write_vtu_with_pvtu_record_async(
+    const std::string &directory,
+    const std::string &filename_without_extension,
+    const unsigned int counter,
+    const MPI_Comm &   mpi_communicator,
+    const unsigned int n_digits_for_counter = numbers::invalid_unsigned_int,
+    const unsigned int n_groups             = 0) const;
+
   /**
    * Obtain data through get_patches() and write it to <tt>out</tt> in SVG
    * format. See DataOutBase::write_svg.
@@ -2919,6 +3186,15 @@ public:
   void
   write_filtered_data(DataOutBase::DataOutFilter &filtered_data) const;
 
+#ifdef DEAL_II_WITH_ADIOS2
+  /**
+   * Stream the patches of this object as one step of @p stream, see
+   * DataOutBase::ADIOS2Stream.
+   */
+  void
+  write_adios2(DataOutBase::ADIOS2Stream &stream, const double time) const;
+#endif
+
 
   /**
    * Write data and grid to <tt>out</tt> according to the given data format.
@@ -3423,6 +3699,126 @@ private:
 
 
 
+/**
+ * A class that writes a time series in the HDF5/XDMF format while storing
+ * the mesh only once per mesh version.
+ *
+ * At every call to write_time_step(), the filtered mesh of the given
+ * DataOutInterface object is compared to the one of the previous time step.
+ * The mesh is only written to a new HDF5 mesh file if it has changed, e.g.,
+ * after mesh refinement or because the vertices have moved. Otherwise, only
+ * the solution data of the time step is written, and the XDMF file, which is
+ * updated at every time step, links the solution to the mesh file of the
+ * last mesh version. For meshes that do not change between most time steps,
+ * this reduces the output volume to that of the solution data.
+ *
+ * The class writes the files
+ * <code>filename_prefix-mesh-VVVV.h5</code> for each mesh version,
+ * <code>filename_prefix-SSSSS.h5</code> for each time step and
+ * <code>filename_prefix.xdmf</code>. Below is an example of how to use this
+ * class:
+ *
+ * @code
+ * XDMFTimeSeries time_series("solution",
+ *                            DataOutBase::DataOutFilterFlags(true, true),
+ *                            MPI_COMM_WORLD);
+ * for (...)
+ *   {
+ *     DataOut<dim> data_out;
+ *     ...
+ *     data_out.build_patches();
+ *     time_series.write_time_step(data_out, time);
+ *   }
+ * @endcode
+ */
+class XDMFTimeSeries
+{
+public:
+  /**
+   * Constructor. The names of all the files written by this object start
+   * with @p filename_prefix, and the data is filtered according to @p flags
+   * before it is written.
+   */
+  XDMFTimeSeries(const std::string &                    filename_prefix,
+                 const DataOutBase::DataOutFilterFlags &flags,
+                 MPI_Comm                               comm);
+
+  /**
+   * Write the data of @p data_out as the time step at time @p time. The
+   * mesh is written as well if it differs from the one of the previous time
+   * step, or if @p force_mesh_output is true. This function is collective
+   * over the communicator passed to the constructor.
+   */
+  template <int dim, int spacedim>
+  void
+  write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                  const double                           time,
+                  const bool force_mesh_output = false);
+
+  /**
+   * Return the number of mesh versions written so far.
+   */
+  unsigned int
+  n_mesh_versions() const;
+
+  /**
+   * Return the XDMF entries of all time steps written so far. The entries
+   * are only valid on the root process.
+   */
+  const std::vector<XDMFEntry> &
+  get_entries() const;
+
+  /**
+   * Read or write the data of this object for serialization, e.g., to
+   * continue a time series after a restart.
+   */
+  template <class Archive>
+  void
+  serialize(Archive &ar, const unsigned int /*version*/)
+  {
+    ar &entries &mesh_version &mesh_hash &mesh_filename;
+  }
+
+private:
+  /**
+   * The prefix of the names of all files written by this object.
+   */
+  const std::string filename_prefix;
+
+  /**
+   * The flags used to filter the data.
+   */
+  const DataOutBase::DataOutFilterFlags flags;
+
+  /**
+   * The communicator of the processes that write the data.
+   */
+  MPI_Comm comm;
+
+  /**
+   * The XDMF entries of all time steps written so far.
+   */
+  std::vector<XDMFEntry> entries;
+
+  /**
+   * The number of mesh versions written so far.
+   */
+  unsigned int mesh_version;
+
+  /**
+   * A hash of the locally owned part of the last mesh that has been
+   * written.
+   */
+  std::size_t mesh_hash;
+
+  /**
+   * The name of the file holding the last mesh version.
+   */
+  std::string mesh_filename;
+};
+
+
+
 /* -------------------- inline functions ------------------- */
 
 namespace DataOutBase
@@ -25,6 +25,7 @@
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <functional>
 #include <vector>
@@ -169,6 +170,13 @@ public:
   using time_type = typename FunctionTime<
     typename numbers::NumberTraits<RangeNumberType>::real_type>::time_type;
 
+  /**
+   * The vectorized real type used by vectorized_value() to evaluate the
+   * function at several points at once.
+   */
+  using vectorized_number_type = VectorizedArray<
+    typename numbers::NumberTraits<RangeNumberType>::real_type>;
+
   /**
    * Constructor. May take an initial value for the number of components
    * (which defaults to one, i.e. a scalar function), and the time variable,
@@ -233,6 +241,26 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<RangeNumberType> &values) const;
 
+  /**
+   * Return the value of the specified component of the function at a batch
+   * of points given as a Point whose coordinates are VectorizedArray
+   * objects, i.e., each lane of @p p represents one point. This is the
+   * format in which FEEvaluation provides quadrature points, so matrix-free
+   * codes can evaluate right hand sides or boundary data without unpacking
+   * the lanes.
+   *
+   * The default implementation calls value() for each lane separately.
+   * Derived classes whose value() is given by a closed-form expression can
+   * override this function to evaluate the expression on all lanes at once
+   * with SIMD instructions.
+   *
+   * @note This function is only available for real-valued functions; calling
+   * it for a complex-valued RangeNumberType raises an exception.
+   */
+  virtual vectorized_number_type
+  vectorized_value(const Point<dim, vectorized_number_type> &p,
+                   const unsigned int component = 0) const;
+
   /**
    * Set <tt>values</tt> to the point values of the specified component of the
    * function at the <tt>points</tt>.  It is assumed that <tt>values</tt>
@@ -441,6 +469,12 @@ namespace Functions
     virtual RangeNumberType
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    virtual typename Function<dim, RangeNumberType>::vectorized_number_type
+    vectorized_value(const Point<dim,
+                                 typename Function<dim, RangeNumberType>::
+                                   vectorized_number_type> &p,
+                     const unsigned int component = 0) const override;
+
     virtual void
     vector_value(const Point<dim> &       p,
                  Vector<RangeNumberType> &return_value) const override;
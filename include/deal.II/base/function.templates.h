@@ -25,6 +25,7 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <complex>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -70,6 +71,57 @@ Function<dim, RangeNumberType>::value(const Point<dim> &,
 }
 
 
+namespace internal
+{
+  namespace FunctionImplementation
+  {
+    /**
+     * Convert a function value to the real type used by
+     * Function::vectorized_value(). Complex-valued functions cannot be
+     * evaluated through that interface.
+     */
+    template <typename Number>
+    inline Number
+    to_vectorizable_value(const Number &value)
+    {
+      return value;
+    }
+
+
+
+    template <typename Number>
+    inline Number
+    to_vectorizable_value(const std::complex<Number> &)
+    {
+      Assert(false,
+             ExcMessage("vectorized_value() is only available for "
+                        "real-valued functions."));
+      return Number();
+    }
+  } // namespace FunctionImplementation
+} // namespace internal
+
+
+
+template <int dim, typename RangeNumberType>
+typename Function<dim, RangeNumberType>::vectorized_number_type
+Function<dim, RangeNumberType>::vectorized_value(
+  const Point<dim, vectorized_number_type> &p,
+  const unsigned int                        component) const
+{
+  vectorized_number_type result;
+  for (unsigned int v = 0; v < vectorized_number_type::size(); ++v)
+    {
+      Point<dim> point;
+      for (unsigned int d = 0; d < dim; ++d)
+        point[d] = p[d][v];
+      result[v] = internal::FunctionImplementation::to_vectorizable_value(
+        this->value(point, component));
+    }
+  return result;
+}
+
+
 template <int dim, typename RangeNumberType>
 void
 Function<dim, RangeNumberType>::vector_value(const Point<dim> &       p,
@@ -388,6 +440,22 @@ namespace Functions
 
 
 
+  template <int dim, typename RangeNumberType>
+  typename Function<dim, RangeNumberType>::vectorized_number_type
+  ConstantFunction<dim, RangeNumberType>::vectorized_value(
+    const Point<dim,
+                typename Function<dim, RangeNumberType>::vectorized_number_type>
+      &,
+    const unsigned int component) const
+  {
+    AssertIndexRange(component, this->n_components);
+    return typename Function<dim, RangeNumberType>::vectorized_number_type(
+      internal::FunctionImplementation::to_vectorizable_value(
+        function_value_vector[component]));
+  }
+
+
+
   template <int dim, typename RangeNumberType>
   void
   ConstantFunction<dim, RangeNumberType>::vector_value(
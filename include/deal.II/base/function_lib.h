@@ -53,6 +53,9 @@ namespace Functions
   public:
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
     virtual void
     vector_value(const Point<dim> &p, Vector<double> &values) const override;
     virtual void
@@ -228,6 +231,10 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
     virtual void
     value_list(const std::vector<Point<dim>> &points,
                std::vector<double> &          values,
@@ -339,6 +346,13 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    /**
+     * The values at a batch of points, evaluated on all lanes at once.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Values at multiple points.
      */
@@ -709,6 +723,14 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    /**
+     * Return the value of the function at a batch of points given with
+     * VectorizedArray coordinates, evaluated on all lanes at once.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Return the gradient of the specified component of the function at the
      * given point.
@@ -763,6 +785,14 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    /**
+     * Return the value of the function at a batch of points given with
+     * VectorizedArray coordinates, evaluated on all lanes at once.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Return the gradient of the specified component of the function at the
      * given point.
@@ -1333,6 +1363,14 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    /**
+     * Function value at a batch of points given with VectorizedArray
+     * coordinates.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Return all components of a vector-valued function at a given point.
      *
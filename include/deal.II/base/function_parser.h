@@ -363,6 +363,38 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<double> &values) const override;
 
+  /**
+   * Set @p values to the values of the specified component of the function
+   * at the given @p points.
+   *
+   * This function looks up the parser objects of the current thread only
+   * once and then evaluates the byte code of the expression for all points,
+   * which is considerably cheaper than calling value() for each point
+   * separately.
+   */
+  virtual void
+  value_list(const std::vector<Point<dim>> &points,
+             std::vector<double> &          values,
+             const unsigned int             component = 0) const override;
+
+  /**
+   * Set @p values to the values of all components of the function at the
+   * given @p points. As for value_list(), the parser objects of the current
+   * thread are looked up only once for all points.
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>> &  values) const override;
+
+  /**
+   * Return the value of the specified component of the function at a batch
+   * of points given with VectorizedArray coordinates. The lanes are
+   * evaluated one after the other by the same parser object.
+   */
+  virtual VectorizedArray<double>
+  vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                   const unsigned int component = 0) const override;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
@@ -20,10 +20,14 @@
 
 #ifdef DEAL_II_WITH_HDF5
 
+#  include <deal.II/base/thread_management.h>
+
 #  include <deal.II/lac/full_matrix.h>
 
 #  include <hdf5.h>
 
+#  include <map>
+#  include <string>
 #  include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -404,6 +408,87 @@ namespace HDF5
     const bool mpi;
   };
 
+  /**
+   * Options for the storage layout and the compression of a DataSet, see
+   * Group::create_dataset().
+   *
+   * By default, a dataset is stored contiguously and without compression.
+   * Compression requires a chunked layout. If a compression filter is
+   * selected but no @p chunk_dimensions are given, then the whole dataset is
+   * stored in a single chunk.
+   *
+   * @note Parallel HDF5 supports writing to compressed datasets only with
+   * collective writes and HDF5 1.10.2 or later. Since all the writes of
+   * deal.II's HDF5 interface are collective, the only requirement is the
+   * HDF5 version.
+   */
+  struct DataSetCreationOptions
+  {
+    /**
+     * Compression filters.
+     */
+    enum class Compression
+    {
+      /**
+       * Do not compress the data
+       */
+      none,
+      /**
+       * Use the gzip compression filter with level @p deflate_level
+       */
+      deflate,
+      /**
+       * Use the szip compression filter with @p szip_pixels_per_block. The
+       * filter has to be available in the HDF5 library.
+       */
+      szip,
+      /**
+       * Use the filter @p custom_filter_id with the parameters
+       * @p custom_filter_parameters, e.g., a registered plugin filter.
+       */
+      custom
+    };
+
+    /**
+     * The dimensions of a chunk. If this vector is empty and no compression
+     * is used, then the dataset is stored contiguously. Otherwise, it must
+     * have the rank of the dataset.
+     */
+    std::vector<hsize_t> chunk_dimensions;
+
+    /**
+     * The compression filter.
+     */
+    Compression compression = Compression::none;
+
+    /**
+     * The gzip compression level between 0 and 9.
+     */
+    unsigned int deflate_level = 6;
+
+    /**
+     * The number of pixels per block of the szip filter. It must be even and
+     * not larger than 32.
+     */
+    unsigned int szip_pixels_per_block = 16;
+
+    /**
+     * The identifier of the custom filter.
+     */
+    H5Z_filter_t custom_filter_id = 0;
+
+    /**
+     * The parameters of the custom filter.
+     */
+    std::vector<unsigned int> custom_filter_parameters;
+
+    /**
+     * If true, the shuffle filter is applied before the compression filter,
+     * which usually improves the compression ratio of floating point data.
+     */
+    bool shuffle = true;
+  };
+
   /**
    * This class implements an HDF5 DataSet.
    */
@@ -426,7 +511,8 @@ namespace HDF5
             const hid_t &                 parent_group_id,
             const std::vector<hsize_t> &  dimensions,
             const std::shared_ptr<hid_t> &t_type,
-            const bool                    mpi);
+            const bool                    mpi,
+            const DataSetCreationOptions &options = DataSetCreationOptions());
 
   public:
     /**
@@ -732,6 +818,49 @@ namespace HDF5
     void
     write_none();
 
+    /**
+     * Non-blocking variant of write(). The @p data is copied into an internal
+     * buffer, and the write is performed on a background task while the
+     * calling thread continues. The returned task can be joined to wait for
+     * the completion of the write; the write is also completed before any
+     * other read or write operation on this DataSet starts, see
+     * wait_for_pending_write().
+     *
+     * The write is collective as write(), i.e., all processes have to call
+     * this function or write_hyperslab_async().
+     *
+     * @note Since the write is performed concurrently with the calling
+     * thread, the HDF5 library must have been built thread-safe if the
+     * calling thread performs other HDF5 calls before the task is joined.
+     * In parallel, MPI must have been initialized with
+     * `MPI_THREAD_MULTIPLE`; this is checked at run time.
+     *
+     * @note The I/O mode of asynchronous writes is not recorded, even if
+     * set_query_io_mode() has been set to true.
+     */
+    template <typename Container>
+    Threads::Task<>
+    write_async(const Container &data);
+
+    /**
+     * Non-blocking variant of write_hyperslab(const Container &, const
+     * std::vector<hsize_t> &, const std::vector<hsize_t> &). The same
+     * requirements as for write_async() apply.
+     */
+    template <typename Container>
+    Threads::Task<>
+    write_hyperslab_async(const Container &           data,
+                          const std::vector<hsize_t> &offset,
+                          const std::vector<hsize_t> &count);
+
+    /**
+     * Wait until the write started by the last call to write_async() or
+     * write_hyperslab_async() has been completed. This function does nothing
+     * if there is no pending write.
+     */
+    void
+    wait_for_pending_write();
+
     /**
      * This function returns the boolean query_io_mode.
      *
@@ -934,6 +1063,11 @@ namespace HDF5
      */
     bool query_io_mode;
 
+    /**
+     * The task performing the last asynchronous write.
+     */
+    Threads::Task<> pending_write;
+
     /**
      * I/O mode that was performed on the last parallel I/O call.
      */
@@ -1028,6 +1162,17 @@ namespace HDF5
     create_dataset(const std::string &         name,
                    const std::vector<hsize_t> &dimensions) const;
 
+    /**
+     * Creates a dataset with the chunk layout and the compression filter
+     * given in @p options. @p number can be `float`, `double`,
+     * `std::complex<float>`, `std::complex<double>`, `int` or `unsigned int`.
+     */
+    template <typename number>
+    DataSet
+    create_dataset(const std::string &           name,
+                   const std::vector<hsize_t> &  dimensions,
+                   const DataSetCreationOptions &options) const;
+
     /**
      * Create and write data to a dataset. @p number can be `float`, `double`,
      * `std::complex<float>`, `std::complex<double>`, `int` or `unsigned int`.
@@ -1090,6 +1235,20 @@ namespace HDF5
          const FileAccessMode mode,
          const MPI_Comm       mpi_communicator);
 
+    /**
+     * Creates or opens an HDF5 file in parallel using MPI as the constructor
+     * above, and passes the MPI-IO hints @p mpi_io_hints to the MPI library.
+     * The hints can be used to tune collective buffering, e.g.,
+     * `{{"romio_cb_write", "enable"}, {"cb_nodes", "16"},
+     * {"cb_buffer_size", "16777216"}}`, or the striping of parallel file
+     * systems, e.g., `{{"striping_factor", "32"}}`. Hints that are not known
+     * to the MPI implementation are ignored.
+     */
+    File(const std::string &                       name,
+         const FileAccessMode                      mode,
+         const MPI_Comm                            mpi_communicator,
+         const std::map<std::string, std::string> &mpi_io_hints);
+
   private:
     /**
      * Delegation internal constructor.
@@ -1098,10 +1257,11 @@ namespace HDF5
      * File(const std::string &, const Mode)
      * should be used to open or create HDF5 files.
      */
-    File(const std::string &  name,
-         const FileAccessMode mode,
-         const bool           mpi,
-         const MPI_Comm       mpi_communicator);
+    File(const std::string &                       name,
+         const FileAccessMode                      mode,
+         const bool                                mpi,
+         const MPI_Comm                            mpi_communicator,
+         const std::map<std::string, std::string> &mpi_io_hints = {});
   };
 } // namespace HDF5
 
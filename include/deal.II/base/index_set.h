@@ -270,6 +270,26 @@ public:
   size_type
   index_within_set(const size_type global_index) const;
 
+  /**
+   * Bulk version of the function above: For each of the entries of
+   * @p global_indices, which need to be sorted in ascending order, write
+   * the how-manyth element of this set it is into the corresponding entry
+   * of @p local_indices, or numbers::invalid_dof_index if it is not an
+   * element of this set. @p local_indices is resized as necessary.
+   *
+   * Since the indices are sorted, this function walks through the given
+   * indices and the intervals of this set at the same time, rather than
+   * doing a separate binary search for each index. Its cost is therefore
+   * proportional to the number of indices plus the number of intervals.
+   *
+   * Like the function above, this function does not compress the set and
+   * hence does not modify any (mutable) data of the object, making it
+   * safe to call from several threads at once.
+   */
+  void
+  index_within_set(const std::vector<size_type> &global_indices,
+                   std::vector<size_type> &      local_indices) const;
+
   /**
    * Each index set can be represented as the union of a number of contiguous
    * intervals of indices, where if necessary intervals may only consist of
@@ -298,6 +318,12 @@ public:
   /**
    * Compress the internal representation by merging individual elements with
    * contiguous ranges, etc. This function does not have any external effect.
+   *
+   * Many 'const' member functions call this function internally. Once an
+   * index set is compressed, these functions only read its data, and the
+   * object can be queried concurrently from several threads without any
+   * locking. It is therefore a good idea to call this function before an
+   * index set is shared among threads.
    */
   void
   compress() const;
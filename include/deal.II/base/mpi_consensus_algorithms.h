@@ -241,7 +241,80 @@ namespace Utilities
         virtual void
         run() override;
 
+        /**
+         * Start the algorithm without waiting for it to complete. This
+         * sends all requests of this process, but returns immediately. The
+         * algorithm then has to be driven forward by calling test() or
+         * finish(); in the meantime, the calling process can do other work,
+         * including running other instances of this class.
+         *
+         * Unlike run(), the algorithm works on a duplicate of the
+         * communicator given to the constructor, so that several exchanges
+         * can be in flight at the same time without their messages getting
+         * mixed up. Creating this duplicate is a collective operation, i.e.,
+         * all processes of the communicator have to call this function, and
+         * if several exchanges are started, they need to be started in the
+         * same order on all processes. The Process object given to the
+         * constructor needs to live until finish() has returned.
+         */
+        void
+        start();
+
+        /**
+         * Make progress on an algorithm started with start(): answer the
+         * requests of other processes that have arrived, and check whether
+         * the algorithm has completed on all processes. If it has, the
+         * answers are handed to Process::read_answer() and this function
+         * returns true. Otherwise, it returns false and needs to be called
+         * again later, as no progress is made in between.
+         */
+        bool
+        test();
+
+        /**
+         * Complete an algorithm started with start(), i.e., call test()
+         * until it returns true. Afterwards, start() may be called again.
+         */
+        void
+        finish();
+
       private:
+        /**
+         * The states of an exchange started with start().
+         */
+        enum class ExchangeState
+        {
+          /**
+           * No non-blocking exchange is in flight.
+           */
+          not_started,
+          /**
+           * Not all answers to the requests of this process have been
+           * received yet.
+           */
+          waiting_for_answers,
+          /**
+           * All answers have been received, but other processes may still
+           * send requests.
+           */
+          waiting_for_other_processes,
+          /**
+           * The exchange is complete, but finish() has not been called yet.
+           */
+          completed
+        };
+
+        /**
+         * The state of the current non-blocking exchange.
+         */
+        ExchangeState state;
+
+        /**
+         * The communicator used for the exchange: the one given to the
+         * constructor for run(), and a duplicate of it for start().
+         */
+        MPI_Comm exchange_comm;
+
 #ifdef DEAL_II_WITH_MPI
         /**
          * List of processes this process wants to send requests to.
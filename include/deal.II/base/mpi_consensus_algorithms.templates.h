@@ -92,6 +92,8 @@ namespace Utilities
       template <typename T1, typename T2>
       NBX<T1, T2>::NBX(Process<T1, T2> &process, const MPI_Comm &comm)
         : Interface<T1, T2>(process, comm)
+        , state(ExchangeState::not_started)
+        , exchange_comm(comm)
       {}
 
 
@@ -100,6 +102,10 @@ namespace Utilities
       void
       NBX<T1, T2>::run()
       {
+        Assert(state == ExchangeState::not_started,
+               ExcMessage("A non-blocking exchange is still in flight. "
+                          "Call finish() before calling run()."));
+
         static CollectiveMutex      mutex;
         CollectiveMutex::ScopedLock lock(mutex, this->comm);
 
@@ -129,6 +135,80 @@ namespace Utilities
 
 
 
+      template <typename T1, typename T2>
+      void
+      NBX<T1, T2>::start()
+      {
+        Assert(state == ExchangeState::not_started,
+               ExcMessage("A non-blocking exchange is already in flight. "
+                          "Call finish() before starting a new one."));
+
+#ifdef DEAL_II_WITH_MPI
+        exchange_comm = duplicate_communicator(this->comm);
+
+        request_buffers.clear();
+        request_requests.clear();
+#endif
+#ifdef DEBUG
+        requesting_processes.clear();
+#endif
+
+        state = ExchangeState::waiting_for_answers;
+
+        // send requests and start receiving the answers, just as steps 1)
+        // of run(). the remaining steps are done in test()
+        start_communication();
+      }
+
+
+
+      template <typename T1, typename T2>
+      bool
+      NBX<T1, T2>::test()
+      {
+        Assert(state != ExchangeState::not_started,
+               ExcMessage("You need to call start() before test()."));
+
+        if (state == ExchangeState::completed)
+          return true;
+
+        answer_requests();
+
+        if (state == ExchangeState::waiting_for_answers && check_own_state())
+          {
+            signal_finish();
+            state = ExchangeState::waiting_for_other_processes;
+          }
+
+        if (state == ExchangeState::waiting_for_other_processes &&
+            check_global_state())
+          {
+            clean_up_and_end_communication();
+#ifdef DEAL_II_WITH_MPI
+            free_communicator(exchange_comm);
+#endif
+            exchange_comm = this->comm;
+            state         = ExchangeState::completed;
+          }
+
+        return state == ExchangeState::completed;
+      }
+
+
+
+      template <typename T1, typename T2>
+      void
+      NBX<T1, T2>::finish()
+      {
+        while (!test())
+          {
+          }
+
+        state = ExchangeState::not_started;
+      }
+
+
+
       template <typename T1, typename T2>
       bool
       NBX<T1, T2>::check_own_state()
@@ -155,7 +235,7 @@ namespace Utilities
       {
 #ifdef DEAL_II_WITH_MPI
 #  if DEAL_II_MPI_VERSION_GTE(3, 0)
-        const auto ierr = MPI_Ibarrier(this->comm, &barrier_request);
+        const auto ierr = MPI_Ibarrier(exchange_comm, &barrier_request);
         AssertThrowMPI(ierr);
 #  else
         AssertThrow(
@@ -202,7 +282,7 @@ namespace Utilities
         int        request_is_pending;
         const auto ierr = MPI_Iprobe(MPI_ANY_SOURCE,
                                      tag_request,
-                                     this->comm,
+                                     exchange_comm,
                                      &request_is_pending,
                                      &status);
         AssertThrowMPI(ierr);
@@ -233,7 +313,7 @@ namespace Utilities
                             MPI_BYTE,
                             other_rank,
                             tag_request,
-                            this->comm,
+                            exchange_comm,
                             &status);
             AssertThrowMPI(ierr);
 
@@ -253,7 +333,7 @@ namespace Utilities
                              MPI_BYTE,
                              other_rank,
                              tag_deliver,
-                             this->comm,
+                             exchange_comm,
                              request_requests.back().get());
             AssertThrowMPI(ierr);
           }
@@ -299,7 +379,7 @@ namespace Utilities
                                     MPI_BYTE,
                                     rank,
                                     tag_request,
-                                    this->comm,
+                                    exchange_comm,
                                     &send_requests[index]);
               AssertThrowMPI(ierr);
 
@@ -311,7 +391,7 @@ namespace Utilities
                                MPI_BYTE,
                                rank,
                                tag_deliver,
-                               this->comm,
+                               exchange_comm,
                                &recv_requests[index]);
               AssertThrowMPI(ierr);
             }
@@ -356,8 +436,12 @@ namespace Utilities
 
 #  ifdef DEBUG
           // note: IBarrier seems to make problem during testing, this
-          // additional Barrier seems to help
-          MPI_Barrier(this->comm);
+          // additional Barrier seems to help. a non-blocking exchange works
+          // on its own communicator that is freed right afterwards, so it
+          // does not need this, and a blocking barrier here could deadlock
+          // if several exchanges are completed in different orders
+          if (state == ExchangeState::not_started)
+            MPI_Barrier(this->comm);
 #  endif
         }
 
@@ -0,0 +1,562 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mpi_remote_point_evaluation_h
+#define dealii_mpi_remote_point_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_tags.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    /**
+     * Helper class to access values on non-matching grids, i.e., at
+     * arbitrary points of a possibly distributed Triangulation that might be
+     * owned by other processes.
+     *
+     * The points of interest are passed to reinit(), which searches the
+     * owners of the points once with the help of
+     * GridTools::Cache::get_covering_rtree() and
+     * GridTools::distributed_compute_point_locations(), determines the cells
+     * and the reference positions of the points on the owning processes, and
+     * stores the resulting communication pattern. Afterwards, an arbitrary
+     * number of evaluations can be performed with evaluate_and_process(),
+     * each requiring only one point-to-point exchange with non-blocking
+     * sends among the processes that actually share points, rather than a
+     * new search of the points in the mesh.
+     *
+     * The evaluation itself is done by a user-provided function that is
+     * given the cells and the reference positions of all points located on
+     * the locally owned part of the mesh (see CellData) and fills a buffer
+     * with the results, e.g., by using FEPointEvaluation. The values are
+     * then sent back to the processes that requested them. The function
+     * VectorTools::point_values() wraps this for finite element solutions.
+     *
+     * @note A point might be found on more than one process (or more than one
+     * cell) if it lies on a face or a vertex shared by several cells. For this
+     * reason, the results for the points are returned in a CRS-like data
+     * structure, see get_point_ptrs() and is_map_unique().
+     *
+     * @note The communication pattern is invalidated as soon as the
+     * triangulation changes, see is_ready().
+     */
+    template <int dim, int spacedim = dim>
+    class RemotePointEvaluation
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      RemotePointEvaluation();
+
+      /**
+       * Destructor.
+       */
+      ~RemotePointEvaluation();
+
+      /**
+       * Set up the internal data structures and the communication pattern
+       * for the evaluation at the points @p points on the Triangulation
+       * @p tria with the geometry described by @p mapping. Each process can
+       * pass a different set of points, which need not be located in the
+       * locally owned part of the mesh.
+       *
+       * @note This is a collective operation that needs to be called on all
+       * processes of the communicator of the triangulation.
+       */
+      void
+      reinit(const std::vector<Point<spacedim>> &points,
+             const Triangulation<dim, spacedim> &tria,
+             const Mapping<dim, spacedim> &      mapping);
+
+      /**
+       * Data of points positioned in a cell, as passed to the evaluation
+       * function in evaluate_and_process() and process_and_evaluate().
+       */
+      struct CellData
+      {
+        /**
+         * Level and index of the cells.
+         */
+        std::vector<std::pair<int, int>> cells;
+
+        /**
+         * Pointers to the beginning and ending of the (reference) points
+         * associated with each cell in the array @p reference_point_values,
+         * i.e., the points of cell @p i are stored in the range
+         * <code>[reference_point_ptrs[i], reference_point_ptrs[i+1])</code>.
+         */
+        std::vector<unsigned int> reference_point_ptrs;
+
+        /**
+         * Reference points in the interval [0,1]^dim.
+         */
+        std::vector<Point<dim>> reference_point_values;
+      };
+
+      /**
+       * Evaluate function @p evaluation_function in the given points and
+       * triangulation. The result is stored in @p output.
+       *
+       * The function @p evaluation_function is passed a view into a buffer of
+       * the size of CellData::reference_point_values and is supposed to fill
+       * it with the values at the points in the order given by CellData. The
+       * vector @p buffer is used as temporary storage and can be reused
+       * between calls to avoid memory allocation.
+       *
+       * @note If the map of points to cells is not a one-to-one relation
+       * (see is_map_unique()), the result needs to be post-processed by the
+       * user with the help of get_point_ptrs().
+       *
+       * @note This is a collective operation.
+       */
+      template <typename T>
+      void
+      evaluate_and_process(
+        std::vector<T> &output,
+        std::vector<T> &buffer,
+        const std::function<void(const ArrayView<T> &, const CellData &)>
+          &evaluation_function) const;
+
+      /**
+       * This method is the inverse of the method evaluate_and_process(). It
+       * makes the data at the points, provided by @p input, available on the
+       * processes owning the cells, where it is processed by the function
+       * @p evaluation_function, e.g., to integrate the contributions of
+       * particles or of the quadrature points of another mesh. The vector
+       * @p input is expected to be of the size given by
+       * <code>get_point_ptrs().back()</code>, i.e., to contain one entry for
+       * each location a point has been found at.
+       *
+       * @note This is a collective operation.
+       */
+      template <typename T>
+      void
+      process_and_evaluate(
+        const std::vector<T> &input,
+        std::vector<T> &      buffer,
+        const std::function<void(const ArrayView<const T> &, const CellData &)>
+          &evaluation_function) const;
+
+      /**
+       * Return a CRS-like data structure to determine the position of the
+       * result corresponding to a point and the amount: The results of point
+       * @p i are stored in the range <code>[get_point_ptrs()[i],
+       * get_point_ptrs()[i+1])</code> of the output vector of
+       * evaluate_and_process().
+       */
+      const std::vector<unsigned int> &
+      get_point_ptrs() const;
+
+      /**
+       * Return whether all points (on all processes) have been found in
+       * exactly one location, i.e., whether the output of
+       * evaluate_and_process() has the same size and ordering as the points
+       * passed to reinit().
+       */
+      bool
+      is_map_unique() const;
+
+      /**
+       * Return whether all points (on all processes) have been found in at
+       * least one location of the triangulation.
+       */
+      bool
+      all_points_found() const;
+
+      /**
+       * Return the Triangulation object used during reinit().
+       */
+      const Triangulation<dim, spacedim> &
+      get_triangulation() const;
+
+      /**
+       * Return the Mapping object used during reinit().
+       */
+      const Mapping<dim, spacedim> &
+      get_mapping() const;
+
+      /**
+       * Return whether the internal data structures have been set up and
+       * the triangulation has not been modified since the last call to
+       * reinit().
+       */
+      bool
+      is_ready() const;
+
+    private:
+      /**
+       * Storage for the status of the triangulation signal.
+       */
+      boost::signals2::connection tria_signal;
+
+      /**
+       * Flag indicating whether the reinit() function has been called and
+       * if yes the triangulation has not been modified since then.
+       */
+      bool ready_flag;
+
+      /**
+       * Reference to the Triangulation object used during reinit().
+       */
+      SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+      /**
+       * Reference to the Mapping object used during reinit().
+       */
+      SmartPointer<const Mapping<dim, spacedim>> mapping;
+
+      /**
+       * The communicator of the triangulation.
+       */
+      MPI_Comm communicator;
+
+      /**
+       * (One-to-one) relation of points and cells on all processes.
+       */
+      bool unique_mapping;
+
+      /**
+       * Whether all points have been found on some process.
+       */
+      bool all_found;
+
+      /**
+       * Since for each point multiple or no results can be available, the
+       * pointers in this vector indicate the first and last entry associated
+       * with a point in a CRS-like fashion.
+       */
+      std::vector<unsigned int> point_ptrs;
+
+      /**
+       * Permutation index within a recv buffer, i.e., the position in the
+       * output vector of each received value.
+       */
+      std::vector<unsigned int> recv_permutation;
+
+      /**
+       * Pointers of each process into the recv buffer.
+       */
+      std::vector<unsigned int> recv_ptrs;
+
+      /**
+       * Ranks from where data is received.
+       */
+      std::vector<unsigned int> recv_ranks;
+
+      /**
+       * Point data sorted according to cells so that evaluation (incl.
+       * reading of degrees of freedoms) needs to be performed only once per
+       * cell.
+       */
+      CellData cell_data;
+
+      /**
+       * Permutation index within a send buffer, i.e., the position in the
+       * buffer sorted by ranks of the value computed for each point in the
+       * ordering of CellData.
+       */
+      std::vector<unsigned int> send_permutation;
+
+      /**
+       * Ranks to send to.
+       */
+      std::vector<unsigned int> send_ranks;
+
+      /**
+       * Pointers of each process into the send buffer.
+       */
+      std::vector<unsigned int> send_ptrs;
+    };
+
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::evaluate_and_process(
+      std::vector<T> &output,
+      std::vector<T> &buffer,
+      const std::function<void(const ArrayView<T> &, const CellData &)>
+        &evaluation_function) const
+    {
+      Assert(ready_flag, ExcMessage("RemotePointEvaluation is not ready!"));
+
+      const unsigned int my_rank = this_mpi_process(communicator);
+      const unsigned int n_local = send_permutation.size();
+
+      output.resize(point_ptrs.back());
+      buffer.resize(2 * n_local);
+
+      // evaluate the functions at all points on the locally owned cells,
+      // then sort the results according to the destination ranks
+      const ArrayView<T> buffer_eval(buffer.data(), n_local);
+      const ArrayView<T> buffer_sorted(buffer.data() + n_local, n_local);
+      evaluation_function(buffer_eval, cell_data);
+
+      for (unsigned int i = 0; i < n_local; ++i)
+        buffer_sorted[send_permutation[i]] = buffer_eval[i];
+
+#ifdef DEAL_II_WITH_MPI
+      const int mpi_tag =
+        internal::Tags::remote_point_evaluation_evaluate_and_process;
+
+      std::vector<std::vector<char>> send_buffers(send_ranks.size());
+      std::vector<MPI_Request>       send_requests;
+      send_requests.reserve(send_ranks.size());
+
+      // start the non-blocking sends to the processes that requested the
+      // points
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        {
+          if (send_ranks[i] == my_rank)
+            continue;
+
+          send_buffers[i] = Utilities::pack(
+            std::vector<T>(buffer_sorted.begin() + send_ptrs[i],
+                           buffer_sorted.begin() + send_ptrs[i + 1]),
+            false);
+
+          send_requests.emplace_back(MPI_Request());
+          const int ierr = MPI_Isend(send_buffers[i].data(),
+                                     send_buffers[i].size(),
+                                     MPI_CHAR,
+                                     send_ranks[i],
+                                     mpi_tag,
+                                     communicator,
+                                     &send_requests.back());
+          AssertThrowMPI(ierr);
+        }
+#endif
+
+      // copy the data this process computed for itself, which is done while
+      // the messages are on their way
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] == my_rank)
+          {
+            const auto ptr = std::find(recv_ranks.begin(),
+                                       recv_ranks.end(),
+                                       my_rank) -
+                             recv_ranks.begin();
+            AssertDimension(send_ptrs[i + 1] - send_ptrs[i],
+                            recv_ptrs[ptr + 1] - recv_ptrs[ptr]);
+            for (unsigned int j = recv_ptrs[ptr], k = send_ptrs[i];
+                 j < recv_ptrs[ptr + 1];
+                 ++j, ++k)
+              output[recv_permutation[j]] = buffer_sorted[k];
+          }
+
+#ifdef DEAL_II_WITH_MPI
+      // receive the data in the order the messages arrive
+      std::vector<char> recv_buffer;
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        {
+          if (recv_ranks[i] == my_rank)
+            continue;
+
+          MPI_Status status;
+          int ierr = MPI_Probe(MPI_ANY_SOURCE, mpi_tag, communicator, &status);
+          AssertThrowMPI(ierr);
+
+          int message_length;
+          ierr = MPI_Get_count(&status, MPI_CHAR, &message_length);
+          AssertThrowMPI(ierr);
+          recv_buffer.resize(message_length);
+
+          ierr = MPI_Recv(recv_buffer.data(),
+                          recv_buffer.size(),
+                          MPI_CHAR,
+                          status.MPI_SOURCE,
+                          mpi_tag,
+                          communicator,
+                          MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+
+          const auto ptr =
+            std::find(recv_ranks.begin(),
+                      recv_ranks.end(),
+                      static_cast<unsigned int>(status.MPI_SOURCE)) -
+            recv_ranks.begin();
+          Assert(static_cast<unsigned int>(ptr) < recv_ranks.size(),
+                 ExcInternalError());
+
+          const std::vector<T> recv_data =
+            Utilities::unpack<std::vector<T>>(recv_buffer, false);
+          AssertDimension(recv_data.size(),
+                          recv_ptrs[ptr + 1] - recv_ptrs[ptr]);
+
+          for (unsigned int j = recv_ptrs[ptr], k = 0; j < recv_ptrs[ptr + 1];
+               ++j, ++k)
+            output[recv_permutation[j]] = recv_data[k];
+        }
+
+      const int ierr = MPI_Waitall(send_requests.size(),
+                                   send_requests.data(),
+                                   MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+#endif
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::process_and_evaluate(
+      const std::vector<T> &input,
+      std::vector<T> &      buffer,
+      const std::function<void(const ArrayView<const T> &, const CellData &)>
+        &evaluation_function) const
+    {
+      Assert(ready_flag, ExcMessage("RemotePointEvaluation is not ready!"));
+      AssertDimension(input.size(), point_ptrs.back());
+
+      const unsigned int my_rank = this_mpi_process(communicator);
+      const unsigned int n_local = send_permutation.size();
+
+      buffer.resize(2 * n_local);
+      const ArrayView<T> buffer_eval(buffer.data(), n_local);
+      const ArrayView<T> buffer_sorted(buffer.data() + n_local, n_local);
+
+#ifdef DEAL_II_WITH_MPI
+      const int mpi_tag =
+        internal::Tags::remote_point_evaluation_process_and_evaluate;
+
+      // the roles of senders and receivers are swapped compared to
+      // evaluate_and_process()
+      std::vector<std::vector<char>> send_buffers(recv_ranks.size());
+      std::vector<MPI_Request>       send_requests;
+      send_requests.reserve(recv_ranks.size());
+
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        {
+          if (recv_ranks[i] == my_rank)
+            continue;
+
+          std::vector<T> send_data(recv_ptrs[i + 1] - recv_ptrs[i]);
+          for (unsigned int j = recv_ptrs[i], k = 0; j < recv_ptrs[i + 1];
+               ++j, ++k)
+            send_data[k] = input[recv_permutation[j]];
+          send_buffers[i] = Utilities::pack(send_data, false);
+
+          send_requests.emplace_back(MPI_Request());
+          const int ierr = MPI_Isend(send_buffers[i].data(),
+                                     send_buffers[i].size(),
+                                     MPI_CHAR,
+                                     recv_ranks[i],
+                                     mpi_tag,
+                                     communicator,
+                                     &send_requests.back());
+          AssertThrowMPI(ierr);
+        }
+#endif
+
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        if (recv_ranks[i] == my_rank)
+          {
+            const auto ptr = std::find(send_ranks.begin(),
+                                       send_ranks.end(),
+                                       my_rank) -
+                             send_ranks.begin();
+            for (unsigned int j = recv_ptrs[i], k = send_ptrs[ptr];
+                 j < recv_ptrs[i + 1];
+                 ++j, ++k)
+              buffer_sorted[k] = input[recv_permutation[j]];
+          }
+
+#ifdef DEAL_II_WITH_MPI
+      std::vector<char> recv_buffer;
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        {
+          if (send_ranks[i] == my_rank)
+            continue;
+
+          MPI_Status status;
+          int ierr = MPI_Probe(MPI_ANY_SOURCE, mpi_tag, communicator, &status);
+          AssertThrowMPI(ierr);
+
+          int message_length;
+          ierr = MPI_Get_count(&status, MPI_CHAR, &message_length);
+          AssertThrowMPI(ierr);
+          recv_buffer.resize(message_length);
+
+          ierr = MPI_Recv(recv_buffer.data(),
+                          recv_buffer.size(),
+                          MPI_CHAR,
+                          status.MPI_SOURCE,
+                          mpi_tag,
+                          communicator,
+                          MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+
+          const auto ptr =
+            std::find(send_ranks.begin(),
+                      send_ranks.end(),
+                      static_cast<unsigned int>(status.MPI_SOURCE)) -
+            send_ranks.begin();
+          Assert(static_cast<unsigned int>(ptr) < send_ranks.size(),
+                 ExcInternalError());
+
+          const std::vector<T> recv_data =
+            Utilities::unpack<std::vector<T>>(recv_buffer, false);
+          AssertDimension(recv_data.size(),
+                          send_ptrs[ptr + 1] - send_ptrs[ptr]);
+
+          for (unsigned int j = send_ptrs[ptr], k = 0; j < send_ptrs[ptr + 1];
+               ++j, ++k)
+            buffer_sorted[j] = recv_data[k];
+        }
+
+      const int ierr = MPI_Waitall(send_requests.size(),
+                                   send_requests.data(),
+                                   MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+#endif
+
+      // bring the data into the order of the cells and evaluate
+      for (unsigned int i = 0; i < n_local; ++i)
+        buffer_eval[i] = buffer_sorted[send_permutation[i]];
+
+      evaluation_function(ArrayView<const T>(buffer_eval.data(), n_local),
+                          cell_data);
+    }
+
+  } // end of namespace MPI
+} // end of namespace Utilities
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
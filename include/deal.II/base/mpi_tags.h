@@ -59,6 +59,12 @@ namespace Utilities
           /// GridTools::exchange_cell_data_to_ghosts():
           exchange_cell_data_to_ghosts,
 
+          /// GridTools::CellDataExchanger::setup()
+          grid_tools_cell_data_exchanger_setup,
+
+          /// GridTools::CellDataExchanger::start_exchange()
+          grid_tools_cell_data_exchanger,
+
           /// Triangulation<dim, spacedim>::communicate_locally_moved_vertices()
           triangulation_communicate_locally_moved_vertices,
 
@@ -110,6 +116,8 @@ namespace Utilities
           particle_handler_send_recv_particles_setup,
           /// ParticleHandler<dim, spacedim>::send_recv_particles
           particle_handler_send_recv_particles_send,
+          /// ParticleHandler<dim, spacedim>::update_ghost_particles
+          particle_handler_update_ghost_particles,
 
           /// ScaLAPACKMatrix<NumberType>::copy_to
           scalapack_copy_to,
@@ -135,6 +143,26 @@ namespace Utilities
           // Utilities::MPI::compute_union
           compute_union,
 
+          /// RemotePointEvaluation::evaluate_and_process()
+          remote_point_evaluation_evaluate_and_process,
+          /// RemotePointEvaluation::process_and_evaluate()
+          remote_point_evaluation_process_and_evaluate,
+
+          /// Partitioner::set_shared_memory_communicator()
+          partitioner_setup_shared_memory,
+
+          /// 200 tags for the completion signals within shared memory of
+          /// Partitioner::import_from_ghosted_array_finish()
+          partitioner_import_shared_memory_start,
+          partitioner_import_shared_memory_end =
+            partitioner_import_shared_memory_start + 200,
+
+          /// 200 tags for the completion signals within shared memory of
+          /// Partitioner::export_to_ghosted_array_finish()
+          partitioner_export_shared_memory_start,
+          partitioner_export_shared_memory_end =
+            partitioner_export_shared_memory_start + 200,
+
         };
       } // namespace Tags
     }   // namespace internal
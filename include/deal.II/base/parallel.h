@@ -37,9 +37,6 @@
 #endif
 
 
-// TODO[WB]: allow calling functions to pass along a tbb::affinity_partitioner
-// object to ensure that subsequent calls use the same cache lines
-
 DEAL_II_NAMESPACE_OPEN
 
 namespace parallel
@@ -764,6 +761,32 @@ namespace parallel
 #endif
     };
   } // namespace internal
+
+
+
+  /**
+   * A variant of the apply_to_subranges() function above in which the
+   * distribution of subranges to threads is guided by an affinity
+   * partitioner stored in @p partitioner. The partitioner records which
+   * thread worked on which subrange, so repeated calls with the same range,
+   * grain size, and partitioner object (say, once in every iteration of a
+   * solver) let the same thread work on the same subrange again, finding
+   * its data in the cache or at least in the memory of its own NUMA domain.
+   * The partitioner object can be shared by several loops over ranges of
+   * the same length that touch the same data; it is safe to use it from
+   * several threads at once, in which case all but one of the concurrent
+   * loops fall back to a fresh partitioner.
+   *
+   * If multithreading is not enabled, this function simply calls
+   * <code>f(begin,end)</code>.
+   */
+  template <typename RangeType, typename Function>
+  void
+  apply_to_subranges(const RangeType &                         begin,
+                     const typename identity<RangeType>::type &end,
+                     const Function &                          f,
+                     const unsigned int                        grainsize,
+                     internal::TBBPartitioner &                partitioner);
 } // namespace parallel
 
 
@@ -851,6 +874,38 @@ namespace parallel
 #endif
   }
 
+
+
+  template <typename RangeType, typename Function>
+  void
+  apply_to_subranges(const RangeType &                         begin,
+                     const typename identity<RangeType>::type &end,
+                     const Function &                          f,
+                     const unsigned int                        grainsize,
+                     internal::TBBPartitioner &                partitioner)
+  {
+#ifndef DEAL_II_WITH_TBB
+    // make sure we don't get compiler
+    // warnings about unused arguments
+    (void)grainsize;
+    (void)partitioner;
+
+    f(begin, end);
+#else
+    std::shared_ptr<tbb::affinity_partitioner> tbb_partitioner =
+      partitioner.acquire_one_partitioner();
+    internal::parallel_for(begin,
+                           end,
+                           [&f](const tbb::blocked_range<RangeType> &range) {
+                             internal::apply_to_subranges<RangeType, Function>(
+                               range, f);
+                           },
+                           grainsize,
+                           tbb_partitioner);
+    partitioner.release_one_partitioner(tbb_partitioner);
+#endif
+  }
+
 } // end of namespace parallel
 
 DEAL_II_NAMESPACE_CLOSE
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/subscriptor.h>
 
@@ -1041,6 +1042,24 @@ public:
               const bool         skip_undefined                     = false,
               const bool         assert_mandatory_entries_are_found = false);
 
+  /**
+   * Same as the previous function, but only the process with rank zero in
+   * @p mpi_communicator reads the file @p filename, and its content is then
+   * broadcast to all other processes, which parse it from memory. This
+   * avoids that all processes of a large parallel job access the same file
+   * at the same time. All processes throw an exception if the file cannot
+   * be opened on the root process. Files included via `include` statements
+   * in a .prm file are still opened by every process.
+   *
+   * This function must be called on all processes of @p mpi_communicator.
+   */
+  void
+  parse_input(const std::string &filename,
+              const MPI_Comm &   mpi_communicator,
+              const std::string &last_line                          = "",
+              const bool         skip_undefined                     = false,
+              const bool         assert_mandatory_entries_are_found = false);
+
   /**
    * Parse input from a string to populate known parameter fields. The lines
    * in the string must be separated by <tt>@\n</tt> characters.
@@ -1822,6 +1841,18 @@ private:
             const unsigned int current_line_n,
             const bool         skip_undefined);
 
+  /**
+   * Parse the content of the stream @p input with the parser that belongs to
+   * the ending of @p filename, i.e., parse_input() for .prm files,
+   * parse_input_from_xml() for .xml files, and parse_input_from_json() for
+   * .json files.
+   */
+  void
+  parse_input_by_file_ending(std::istream &     input,
+                             const std::string &filename,
+                             const std::string &last_line,
+                             const bool         skip_undefined);
+
   /**
    * Print out the parameters of the subsection given by the
    * @p target_subsection_path argument, as well as all subsections
@@ -23,6 +23,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/types.h>
 #include <deal.II/base/utilities.h>
 
@@ -39,6 +40,157 @@ namespace Utilities
 {
   namespace MPI
   {
+    namespace internal
+    {
+      /**
+       * A cache of persistent MPI requests, as created by MPI_Send_init() and
+       * MPI_Recv_init(), for the point-to-point communication of a
+       * Partitioner. Vectors exchange their ghost values many times with the
+       * same arrays, so the requests can be set up once and then only be
+       * started with MPI_Start() in each exchange, which saves the matching
+       * and setup overhead of MPI_Isend() and MPI_Irecv().
+       *
+       * The requests are identified by the arrays they communicate, the
+       * communication channel, and the size of the vector entries. The cache
+       * holds a limited number of entries and releases the least recently
+       * used one once this number is exceeded. Copying a cache gives an empty
+       * cache, as MPI requests must not be shared.
+       */
+      class PersistentRequestCache
+      {
+      public:
+        /**
+         * The data that identifies a set of requests.
+         */
+        struct Key
+        {
+          /**
+           * Whether the requests belong to
+           * Partitioner::import_from_ghosted_array_start() (true) or to
+           * Partitioner::export_to_ghosted_array_start() (false).
+           */
+          bool is_import;
+
+          /**
+           * The communication channel.
+           */
+          unsigned int channel;
+
+          /**
+           * The address and size of the array of ghost entries.
+           */
+          const void *ghost_array;
+          std::size_t ghost_array_size;
+
+          /**
+           * The address of the temporary storage for the import data.
+           */
+          const void *temporary_storage;
+
+          /**
+           * The size of each entry in bytes.
+           */
+          std::size_t entry_size;
+
+          /**
+           * Comparison operator.
+           */
+          bool
+          operator==(const Key &other) const;
+        };
+
+        /**
+         * The maximal number of entries held in the cache.
+         */
+        static constexpr unsigned int max_n_entries = 32;
+
+        /**
+         * Constructor.
+         */
+        PersistentRequestCache() = default;
+
+        /**
+         * Copy constructor, creating an empty cache.
+         */
+        PersistentRequestCache(const PersistentRequestCache &);
+
+        /**
+         * Copy assignment, releasing all requests of this object and leaving
+         * it empty.
+         */
+        PersistentRequestCache &
+        operator=(const PersistentRequestCache &);
+
+        /**
+         * Destructor. Releases all requests.
+         */
+        ~PersistentRequestCache();
+
+        /**
+         * Look up the requests for the given @p key. If they exist and are
+         * not currently in use, copy them into @p requests, mark them as in
+         * use, and return true. Otherwise, return false.
+         */
+        bool
+        acquire(const Key &key, std::vector<MPI_Request> &requests);
+
+        /**
+         * Store newly created @p requests for the given @p key, marked as in
+         * use.
+         */
+        void
+        insert(const Key &key, const std::vector<MPI_Request> &requests);
+
+        /**
+         * Mark the set of requests whose handles are given by @p requests as
+         * not in use anymore, once the caller has completed them. Nothing
+         * happens if the requests are not from this cache.
+         */
+        void
+        release(const std::vector<MPI_Request> &requests);
+
+        /**
+         * Remove the set of requests whose handles are given by @p requests
+         * from the cache without freeing them, which is then the
+         * responsibility of the caller. Nothing happens if the requests are
+         * not from this cache.
+         */
+        void
+        erase(const std::vector<MPI_Request> &requests);
+
+        /**
+         * Free all requests and empty the cache.
+         */
+        void
+        clear();
+
+      private:
+        /**
+         * An entry of the cache.
+         */
+        struct Entry
+        {
+          Key                      key;
+          std::vector<MPI_Request> requests;
+          bool                     in_use;
+        };
+
+        /**
+         * The entries, sorted by the time of their last use with the most
+         * recently used one last.
+         */
+        std::vector<Entry> entries;
+
+        /**
+         * A mutex, as the same partitioner is used by several vectors that
+         * may be communicated from different threads.
+         */
+        Threads::Mutex mutex;
+      };
+    } // namespace internal
+
+
+
     /**
      * This class defines a model for the partitioning of a vector (or, in
      * fact, any linear data structure) among processors using MPI.
@@ -170,6 +322,21 @@ namespace Utilities
      * </ul>
      *
      * The MPI communication routines are point-to-point communication patterns.
+     * Since the same arrays are usually exchanged many times, e.g. in every
+     * iteration of a linear solver, the messages are set up as persistent MPI
+     * requests (MPI_Send_init() and MPI_Recv_init()) in the first exchange
+     * and only started in subsequent calls with the same arrays and
+     * communication channel, which avoids the setup cost of the requests in
+     * each exchange. The requests are freed when the index sets of this
+     * class change or the object is destroyed.
+     *
+     * Splitting the exchange into a start and a finish function allows to
+     * overlap the communication with computations that do not depend on the
+     * ghost data. For LinearAlgebra::distributed::Vector, this is exposed
+     * through the functions update_ghost_values_start() and
+     * update_ghost_values_finish() as well as compress_start() and
+     * compress_finish(). MatrixFree::loop() uses them to work on cells
+     * without ghost dependencies while the messages are in flight.
      *
      *
      * <h4>Sending only selected ghost data</h4>
@@ -449,6 +616,34 @@ namespace Utilities
       bool
       ghost_indices_initialized() const;
 
+      /**
+       * Set the communicator of those processes in get_mpi_communicator()
+       * that share memory with the current process, typically the processes
+       * on the same compute node as obtained by `MPI_Comm_split_type(comm,
+       * MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &communicator_sm)`. Data
+       * is then exchanged between these processes by direct access to the
+       * memory of the other process rather than by MPI messages, and
+       * LinearAlgebra::distributed::Vector objects set up with this
+       * partitioner allocate their memory in an MPI-3 shared-memory window
+       * to make this possible. Only small synchronization messages are still
+       * exchanged between the processes sharing memory.
+       *
+       * This is a collective operation on all processes of
+       * get_mpi_communicator(), and the given communicator must be kept
+       * alive as long as this object is used. Passing `MPI_COMM_SELF`, which
+       * is the default, disables the shared-memory exchange. The setting is
+       * kept when the ghost indices are changed by set_ghost_indices().
+       */
+      void
+      set_shared_memory_communicator(const MPI_Comm &communicator_sm);
+
+      /**
+       * Return the communicator of the processes that share memory with the
+       * current process, see set_shared_memory_communicator().
+       */
+      const MPI_Comm &
+      get_shared_memory_communicator() const;
+
 #ifdef DEAL_II_WITH_MPI
       /**
        * Start the exportation of the data in a locally owned array to the
@@ -508,6 +703,14 @@ namespace Utilities
        * export_to_ghosted_array_start() call. This must be the same array as
        * passed to that function, otherwise MPI will likely throw an error.
        *
+       * @param shared_arrays If a shared-memory communicator has been set
+       * with set_shared_memory_communicator(), the arrays of all processes
+       * in that communicator, indexed by their rank within it, that contain
+       * the locally owned entries followed by the ghost entries of the
+       * respective process. The ghost values owned by processes in the
+       * shared-memory communicator are read directly from these arrays.
+       * Can be left empty otherwise.
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::update_ghost_values().
        */
@@ -515,7 +718,9 @@ namespace Utilities
       void
       export_to_ghosted_array_finish(
         const ArrayView<Number, MemorySpaceType> &ghost_array,
-        std::vector<MPI_Request> &                requests) const;
+        std::vector<MPI_Request> &                requests,
+        const std::vector<ArrayView<const Number, MemorySpaceType>>
+          &shared_arrays = {}) const;
 
       /**
        * Start importing the data on an array indexed by the ghost indices of
@@ -594,6 +799,14 @@ namespace Utilities
        * import_to_ghosted_array_finish() call. This must be the same array as
        * passed to that function, otherwise MPI will likely throw an error.
        *
+       * @param shared_arrays If a shared-memory communicator has been set
+       * with set_shared_memory_communicator(), the arrays of all processes
+       * in that communicator, indexed by their rank within it, that contain
+       * the locally owned entries followed by the ghost entries of the
+       * respective process. The contributions of processes in the
+       * shared-memory communicator are read directly from these arrays.
+       * Can be left empty otherwise.
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::compress().
        */
@@ -604,7 +817,20 @@ namespace Utilities
         const ArrayView<const Number, MemorySpaceType> &temporary_storage,
         const ArrayView<Number, MemorySpaceType> &      locally_owned_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
-        std::vector<MPI_Request> &                      requests) const;
+        std::vector<MPI_Request> &                      requests,
+        const std::vector<ArrayView<const Number, MemorySpaceType>>
+          &shared_arrays = {}) const;
+
+      /**
+       * Free the MPI requests of an exchange started with
+       * export_to_ghosted_array_start() or import_from_ghosted_array_start()
+       * that is not going to be finished, e.g. because the vector using this
+       * partitioner is reinitialized. The requests are removed from the
+       * persistent requests held by this class, freed, and @p requests is
+       * cleared.
+       */
+      void
+      free_requests(std::vector<MPI_Request> &requests) const;
 #endif
 
       /**
@@ -644,6 +870,30 @@ namespace Utilities
       void
       initialize_import_indices_plain_dev() const;
 
+      /**
+       * Set up the data for the exchange with the processes in
+       * communicator_sm, i.e., the ghost_targets_sm_ranks,
+       * ghost_indices_sm_data, import_targets_sm_ranks, and
+       * import_targets_sm_offsets fields. Collective on all processes of
+       * the communicator.
+       */
+      void
+      initialize_shared_memory_data();
+
+      /**
+       * Return whether the process of the entry @p i in ghost_targets_data
+       * shares memory with the current process.
+       */
+      bool
+      is_shared_memory_ghost_target(const unsigned int i) const;
+
+      /**
+       * Return whether the process of the entry @p i in import_targets_data
+       * shares memory with the current process.
+       */
+      bool
+      is_shared_memory_import_target(const unsigned int i) const;
+
       /**
        * The global size of the vector over all processors
        */
@@ -758,6 +1008,69 @@ namespace Utilities
        * A variable storing whether the ghost indices have been explicitly set.
        */
       bool have_ghost_indices;
+
+      /**
+       * The communicator of the processes that share memory with the current
+       * one, see set_shared_memory_communicator().
+       */
+      MPI_Comm communicator_sm;
+
+      /**
+       * For each entry in ghost_targets_data, the rank of the owner within
+       * communicator_sm, or numbers::invalid_unsigned_int if the owner does
+       * not share memory with the current process. Empty if no shared-memory
+       * communicator is set.
+       */
+      std::vector<unsigned int> ghost_targets_sm_ranks;
+
+      /**
+       * The number of valid entries in ghost_targets_sm_ranks.
+       */
+      unsigned int n_ghost_targets_sm;
+
+      /**
+       * The ranges of ghost entries that are owned by processes sharing
+       * memory with the current one, given as indices into the locally owned
+       * array of the owner, in the order of the ghost indices.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> ghost_indices_sm_data;
+
+      /**
+       * An array that caches the number of chunks in ghost_indices_sm_data
+       * per entry in ghost_targets_data. The length is
+       * ghost_targets_data.size()+1.
+       */
+      std::vector<unsigned int> ghost_indices_sm_chunks_by_rank_data;
+
+      /**
+       * For each entry in import_targets_data, the rank of the process within
+       * communicator_sm, or numbers::invalid_unsigned_int if that process does
+       * not share memory with the current one. Empty if no shared-memory
+       * communicator is set.
+       */
+      std::vector<unsigned int> import_targets_sm_ranks;
+
+      /**
+       * The number of valid entries in import_targets_sm_ranks.
+       */
+      unsigned int n_import_targets_sm;
+
+      /**
+       * For each entry in import_targets_data of a process sharing memory
+       * with the current one, the position in the array of that process
+       * (locally owned entries followed by ghost entries) where the ghost
+       * values to be sent to the current process start in
+       * import_from_ghosted_array_start().
+       */
+      std::vector<unsigned int> import_targets_sm_offsets;
+
+      /**
+       * Persistent MPI requests for export_to_ghosted_array_start() and
+       * import_from_ghosted_array_start(), set up on first use with a given
+       * set of arrays and reused in subsequent calls with the same arrays.
+       * The variable is mutable as the communication functions are const.
+       */
+      mutable internal::PersistentRequestCache persistent_requests;
     };
 
 
@@ -949,6 +1262,32 @@ namespace Utilities
       return have_ghost_indices;
     }
 
+
+
+    inline const MPI_Comm &
+    Partitioner::get_shared_memory_communicator() const
+    {
+      return communicator_sm;
+    }
+
+
+
+    inline bool
+    Partitioner::is_shared_memory_ghost_target(const unsigned int i) const
+    {
+      return n_ghost_targets_sm > 0 &&
+             ghost_targets_sm_ranks[i] != numbers::invalid_unsigned_int;
+    }
+
+
+
+    inline bool
+    Partitioner::is_shared_memory_import_target(const unsigned int i) const
+    {
+      return n_import_targets_sm > 0 &&
+             import_targets_sm_ranks[i] != numbers::invalid_unsigned_int;
+    }
+
 #endif // ifndef DOXYGEN
 
   } // end of namespace MPI
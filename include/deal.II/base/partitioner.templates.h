@@ -70,11 +70,6 @@ namespace Utilities
       Assert(mpi_tag <= Utilities::MPI::internal::Tags::partitioner_export_end,
              ExcInternalError());
 
-      // Need to send and receive the data. Use non-blocking communication,
-      // where it is usually less overhead to first initiate the receive and
-      // then actually send the data
-      requests.resize(n_import_targets + n_ghost_targets);
-
       // as a ghost array pointer, put the data at the end of the given ghost
       // array in case we want to fill only a subset of the ghosts so that we
       // can move data to the right position in a forward loop in the _finish
@@ -83,25 +78,130 @@ namespace Utilities
       const bool use_larger_set =
         (n_ghost_indices_in_larger_set > n_ghost_indices() &&
          ghost_array.size() == n_ghost_indices_in_larger_set);
-      Number *ghost_array_ptr =
-        use_larger_set ? ghost_array.data() + n_ghost_indices_in_larger_set -
-                           n_ghost_indices() :
-                         ghost_array.data();
 
-      for (unsigned int i = 0; i < n_ghost_targets; i++)
+      // Need to send and receive the data. Use persistent non-blocking
+      // communication: the same arrays are typically exchanged many times,
+      // so we set up the requests with MPI_Recv_init() and MPI_Send_init()
+      // only in the first exchange and then only start them with
+      // MPI_Start(). As usual, it is less overhead to first initiate the
+      // receive and then actually send the data.
+      //
+      // For the processes that share memory with us, no data is sent.
+      // Instead, the owner only signals with an empty message that its data
+      // is ready, the ghost values are read directly from the owner's array
+      // in export_to_ghosted_array_finish(), and the reader signals back
+      // when it is done reading. The requests are stored after the ones for
+      // the data: first the receives of the completion signals from the
+      // processes reading our data, then the sends of the completion
+      // signals to the owners of our ghosts.
+      Assert(n_ghost_targets_sm + n_import_targets_sm == 0 ||
+               (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+             ExcNotImplemented());
+      const unsigned int n_requests = n_import_targets + n_ghost_targets +
+                                      n_import_targets_sm + n_ghost_targets_sm;
+      if (n_requests > 0)
+        {
+          const internal::PersistentRequestCache::Key key{
+            false,
+            communication_channel,
+            ghost_array.data(),
+            ghost_array.size(),
+            temporary_storage.data(),
+            sizeof(Number)};
+          if (persistent_requests.acquire(key, requests) == false)
+            {
+              requests.resize(n_requests);
+
+              Number *ghost_array_ptr =
+                use_larger_set ? ghost_array.data() +
+                                   n_ghost_indices_in_larger_set -
+                                   n_ghost_indices() :
+                                 ghost_array.data();
+              for (unsigned int i = 0; i < n_ghost_targets; i++)
+                {
+                  const bool shared = is_shared_memory_ghost_target(i);
+
+                  // allow writing into ghost indices even though we are in a
+                  // const function
+                  const int ierr = MPI_Recv_init(
+                    ghost_array_ptr,
+                    shared ? 0 : ghost_targets_data[i].second * sizeof(Number),
+                    MPI_BYTE,
+                    ghost_targets_data[i].first,
+                    mpi_tag,
+                    communicator,
+                    &requests[i]);
+                  AssertThrowMPI(ierr);
+                  ghost_array_ptr += ghost_targets_data[i].second;
+                }
+
+              Number *temp_array_ptr = temporary_storage.data();
+              for (unsigned int i = 0; i < n_import_targets; i++)
+                {
+                  const bool shared = is_shared_memory_import_target(i);
+
+                  const int ierr = MPI_Send_init(
+                    temp_array_ptr,
+                    shared ? 0 :
+                             import_targets_data[i].second * sizeof(Number),
+                    MPI_BYTE,
+                    import_targets_data[i].first,
+                    mpi_tag,
+                    communicator,
+                    &requests[n_ghost_targets + i]);
+                  AssertThrowMPI(ierr);
+                  temp_array_ptr += import_targets_data[i].second;
+                }
+
+              const unsigned int mpi_tag_sm =
+                Utilities::MPI::internal::Tags::
+                  partitioner_export_shared_memory_start +
+                communication_channel;
+              Assert(mpi_tag_sm <= Utilities::MPI::internal::Tags::
+                                     partitioner_export_shared_memory_end,
+                     ExcInternalError());
+              unsigned int index = n_ghost_targets + n_import_targets;
+              for (unsigned int i = 0; i < n_import_targets; i++)
+                if (is_shared_memory_import_target(i))
+                  {
+                    const int ierr = MPI_Recv_init(nullptr,
+                                                   0,
+                                                   MPI_BYTE,
+                                                   import_targets_data[i].first,
+                                                   mpi_tag_sm,
+                                                   communicator,
+                                                   &requests[index++]);
+                    AssertThrowMPI(ierr);
+                  }
+              for (unsigned int i = 0; i < n_ghost_targets; i++)
+                if (is_shared_memory_ghost_target(i))
+                  {
+                    const int ierr = MPI_Send_init(nullptr,
+                                                   0,
+                                                   MPI_BYTE,
+                                                   ghost_targets_data[i].first,
+                                                   mpi_tag_sm,
+                                                   communicator,
+                                                   &requests[index++]);
+                    AssertThrowMPI(ierr);
+                  }
+              AssertDimension(index, n_requests);
+
+              persistent_requests.insert(key, requests);
+            }
+        }
+
+      if (n_ghost_targets > 0)
+        {
+          const int ierr = MPI_Startall(n_ghost_targets, requests.data());
+          AssertThrowMPI(ierr);
+        }
+      if (n_import_targets_sm > 0)
         {
-          // allow writing into ghost indices even though we are in a
-          // const function
           const int ierr =
-            MPI_Irecv(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[i]);
+            MPI_Startall(n_import_targets_sm,
+                         requests.data() + n_ghost_targets + n_import_targets);
           AssertThrowMPI(ierr);
-          ghost_array_ptr += ghost_targets_data[i].second;
         }
 
       Number *temp_array_ptr = temporary_storage.data();
@@ -119,56 +219,55 @@ namespace Utilities
 
       for (unsigned int i = 0; i < n_import_targets; i++)
         {
-#    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
-      defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
-          if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+          // processes sharing memory with us read the data directly from
+          // locally_owned_array, so we only need to signal that it is ready
+          if (is_shared_memory_import_target(i) == false)
             {
-              const auto chunk_size = import_indices_plain_dev[i].second;
-              const int  n_blocks =
-                1 + chunk_size / (::dealii::CUDAWrappers::chunk_size *
-                                  ::dealii::CUDAWrappers::block_size);
-              ::dealii::LinearAlgebra::CUDAWrappers::kernel::
-                gather<<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
-                  temp_array_ptr,
-                  import_indices_plain_dev[i].first.get(),
-                  locally_owned_array.data(),
-                  chunk_size);
-              cudaDeviceSynchronize();
-            }
-          else
-#    endif
-            {
-              // copy the data to be sent to the import_data field
-              std::vector<std::pair<unsigned int, unsigned int>>::const_iterator
-                my_imports = import_indices_data.begin() +
-                             import_indices_chunks_by_rank_data[i],
-                end_my_imports = import_indices_data.begin() +
-                                 import_indices_chunks_by_rank_data[i + 1];
-              unsigned int index = 0;
-              for (; my_imports != end_my_imports; ++my_imports)
+#    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+          defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+              if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
                 {
-                  const unsigned int chunk_size =
-                    my_imports->second - my_imports->first;
-                  {
-                    std::memcpy(temp_array_ptr + index,
-                                locally_owned_array.data() + my_imports->first,
-                                chunk_size * sizeof(Number));
-                  }
-                  index += chunk_size;
+                  const auto chunk_size = import_indices_plain_dev[i].second;
+                  const int  n_blocks =
+                    1 + chunk_size / (::dealii::CUDAWrappers::chunk_size *
+                                      ::dealii::CUDAWrappers::block_size);
+                  ::dealii::LinearAlgebra::CUDAWrappers::kernel::
+                    gather<<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
+                      temp_array_ptr,
+                      import_indices_plain_dev[i].first.get(),
+                      locally_owned_array.data(),
+                      chunk_size);
+                  cudaDeviceSynchronize();
                 }
+              else
+#    endif
+                {
+                  // copy the data to be sent to the import_data field
+                  auto my_imports = import_indices_data.begin() +
+                                    import_indices_chunks_by_rank_data[i];
+                  const auto end_my_imports =
+                    import_indices_data.begin() +
+                    import_indices_chunks_by_rank_data[i + 1];
+                  unsigned int index = 0;
+                  for (; my_imports != end_my_imports; ++my_imports)
+                    {
+                      const unsigned int chunk_size =
+                        my_imports->second - my_imports->first;
+                      {
+                        std::memcpy(temp_array_ptr + index,
+                                    locally_owned_array.data() +
+                                      my_imports->first,
+                                    chunk_size * sizeof(Number));
+                      }
+                      index += chunk_size;
+                    }
 
-              AssertDimension(index, import_targets_data[i].second);
+                  AssertDimension(index, import_targets_data[i].second);
+                }
             }
 
           // start the send operations
-          const int ierr =
-            MPI_Isend(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[n_ghost_targets + i]);
+          const int ierr = MPI_Start(&requests[n_ghost_targets + i]);
           AssertThrowMPI(ierr);
           temp_array_ptr += import_targets_data[i].second;
         }
@@ -180,7 +279,9 @@ namespace Utilities
     void
     Partitioner::export_to_ghosted_array_finish(
       const ArrayView<Number, MemorySpaceType> &ghost_array,
-      std::vector<MPI_Request> &                requests) const
+      std::vector<MPI_Request> &                requests,
+      const std::vector<ArrayView<const Number, MemorySpaceType>>
+        &shared_arrays) const
     {
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -188,16 +289,73 @@ namespace Utilities
                                             n_ghost_indices(),
                                             n_ghost_indices_in_larger_set));
 
+      const unsigned int n_import_targets = import_targets_data.size();
+      const unsigned int n_ghost_targets  = ghost_targets_data.size();
+      const unsigned int n_data_requests  = n_ghost_targets + n_import_targets;
+
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
-      AssertDimension(ghost_targets().size() + import_targets().size(),
+      AssertDimension(n_data_requests + n_import_targets_sm +
+                        n_ghost_targets_sm,
                       requests.size());
       if (requests.size() > 0)
         {
           const int ierr =
-            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+            MPI_Waitall(n_data_requests, requests.data(), MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      // read the ghost values owned by processes sharing memory with us
+      // directly from their arrays, placing them where the receive would have
+      // put them, and signal to the owners that we are done reading. then
+      // wait for the processes reading from our array to finish, as our
+      // locally owned values must not be changed before
+      if (n_ghost_targets_sm + n_import_targets_sm > 0)
+        {
+          Assert(shared_arrays.size() ==
+                   Utilities::MPI::n_mpi_processes(communicator_sm),
+                 ExcMessage("The vector must be allocated in a shared-memory "
+                            "window, i.e., be set up with this partitioner."));
+          Number *ghost_array_ptr =
+            (n_ghost_indices_in_larger_set > n_ghost_indices() &&
+             ghost_array.size() == n_ghost_indices_in_larger_set) ?
+              ghost_array.data() + n_ghost_indices_in_larger_set -
+                n_ghost_indices() :
+              ghost_array.data();
+          for (unsigned int i = 0; i < n_ghost_targets; i++)
+            {
+              if (is_shared_memory_ghost_target(i))
+                {
+                  const Number *owned_array =
+                    shared_arrays[ghost_targets_sm_ranks[i]].data();
+                  Number *write_position = ghost_array_ptr;
+                  for (unsigned int c = ghost_indices_sm_chunks_by_rank_data[i];
+                       c < ghost_indices_sm_chunks_by_rank_data[i + 1];
+                       ++c)
+                    {
+                      const auto &range = ghost_indices_sm_data[c];
+                      std::copy(owned_array + range.first,
+                                owned_array + range.second,
+                                write_position);
+                      write_position += range.second - range.first;
+                    }
+                  AssertDimension(write_position - ghost_array_ptr,
+                                  ghost_targets_data[i].second);
+                }
+              ghost_array_ptr += ghost_targets_data[i].second;
+            }
+
+          int ierr = MPI_Startall(n_ghost_targets_sm,
+                                  requests.data() + n_data_requests +
+                                    n_import_targets_sm);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Waitall(n_import_targets_sm + n_ghost_targets_sm,
+                             requests.data() + n_data_requests,
+                             MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
         }
+
+      persistent_requests.release(requests);
       requests.resize(0);
 
       // in case we only sent a subset of indices, we now need to move the data
@@ -302,38 +460,142 @@ namespace Utilities
              ExcMessage("Another compress operation seems to still be running. "
                         "Call compress_finish() first."));
 
-      // Need to send and receive the data. Use non-blocking communication,
-      // where it is generally less overhead to first initiate the receive and
-      // then actually send the data
+      // Need to send and receive the data. As in
+      // export_to_ghosted_array_start(), we use persistent requests that are
+      // set up in the first call and then only started, and first initiate
+      // the receive before actually sending the data. Processes sharing
+      // memory with us only exchange empty messages as signals that the
+      // ghost values are ready and, in import_from_ghosted_array_finish(),
+      // that the owner has read them. The requests for the latter are stored
+      // after the ones for the data: first the receives of the signals from
+      // the owners of our ghosts, then the sends to the processes whose
+      // ghost values we read.
 
       const unsigned int mpi_tag =
         Utilities::MPI::internal::Tags::partitioner_import_start +
         communication_channel;
       Assert(mpi_tag <= Utilities::MPI::internal::Tags::partitioner_import_end,
              ExcInternalError());
-      requests.resize(n_import_targets + n_ghost_targets);
+
+      Assert(n_ghost_targets_sm + n_import_targets_sm == 0 ||
+               (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+             ExcNotImplemented());
+      const unsigned int n_requests = n_import_targets + n_ghost_targets +
+                                      n_ghost_targets_sm + n_import_targets_sm;
+      if (n_requests > 0)
+        {
+          const internal::PersistentRequestCache::Key key{
+            true,
+            communication_channel,
+            ghost_array.data(),
+            ghost_array.size(),
+            temporary_storage.data(),
+            sizeof(Number)};
+          if (persistent_requests.acquire(key, requests) == false)
+            {
+              requests.resize(n_requests);
+
+              Number *temp_array_ptr = temporary_storage.data();
+              for (unsigned int i = 0; i < n_import_targets; i++)
+                {
+                  AssertThrow(
+                    static_cast<std::size_t>(import_targets_data[i].second) *
+                        sizeof(Number) <
+                      static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                    ExcMessage(
+                      "Index overflow: Maximum message size in MPI is 2GB. "
+                      "The number of ghost entries times the size of 'Number' "
+                      "exceeds this value. This is not supported."));
+                  const bool shared = is_shared_memory_import_target(i);
+
+                  const int ierr = MPI_Recv_init(
+                    temp_array_ptr,
+                    shared ? 0 :
+                             import_targets_data[i].second * sizeof(Number),
+                    MPI_BYTE,
+                    import_targets_data[i].first,
+                    mpi_tag,
+                    communicator,
+                    &requests[i]);
+                  AssertThrowMPI(ierr);
+                  temp_array_ptr += import_targets_data[i].second;
+                }
+
+              Number *ghost_array_ptr = ghost_array.data();
+              for (unsigned int i = 0; i < n_ghost_targets; i++)
+                {
+                  AssertThrow(
+                    static_cast<std::size_t>(ghost_targets_data[i].second) *
+                        sizeof(Number) <
+                      static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                    ExcMessage(
+                      "Index overflow: Maximum message size in MPI is 2GB. "
+                      "The number of ghost entries times the size of 'Number' "
+                      "exceeds this value. This is not supported."));
+                  const bool shared = is_shared_memory_ghost_target(i);
+
+                  const int ierr = MPI_Send_init(
+                    ghost_array_ptr,
+                    shared ? 0 : ghost_targets_data[i].second * sizeof(Number),
+                    MPI_BYTE,
+                    ghost_targets_data[i].first,
+                    mpi_tag,
+                    communicator,
+                    &requests[n_import_targets + i]);
+                  AssertThrowMPI(ierr);
+                  ghost_array_ptr += ghost_targets_data[i].second;
+                }
+
+              const unsigned int mpi_tag_sm =
+                Utilities::MPI::internal::Tags::
+                  partitioner_import_shared_memory_start +
+                communication_channel;
+              Assert(mpi_tag_sm <= Utilities::MPI::internal::Tags::
+                                     partitioner_import_shared_memory_end,
+                     ExcInternalError());
+              unsigned int index = n_import_targets + n_ghost_targets;
+              for (unsigned int i = 0; i < n_ghost_targets; i++)
+                if (is_shared_memory_ghost_target(i))
+                  {
+                    const int ierr = MPI_Recv_init(nullptr,
+                                                   0,
+                                                   MPI_BYTE,
+                                                   ghost_targets_data[i].first,
+                                                   mpi_tag_sm,
+                                                   communicator,
+                                                   &requests[index++]);
+                    AssertThrowMPI(ierr);
+                  }
+              for (unsigned int i = 0; i < n_import_targets; i++)
+                if (is_shared_memory_import_target(i))
+                  {
+                    const int ierr = MPI_Send_init(nullptr,
+                                                   0,
+                                                   MPI_BYTE,
+                                                   import_targets_data[i].first,
+                                                   mpi_tag_sm,
+                                                   communicator,
+                                                   &requests[index++]);
+                    AssertThrowMPI(ierr);
+                  }
+              AssertDimension(index, n_requests);
+
+              persistent_requests.insert(key, requests);
+            }
+        }
 
       // initiate the receive operations
-      Number *temp_array_ptr = temporary_storage.data();
-      for (unsigned int i = 0; i < n_import_targets; i++)
+      if (n_import_targets > 0)
+        {
+          const int ierr = MPI_Startall(n_import_targets, requests.data());
+          AssertThrowMPI(ierr);
+        }
+      if (n_ghost_targets_sm > 0)
         {
-          AssertThrow(
-            static_cast<std::size_t>(import_targets_data[i].second) *
-                sizeof(Number) <
-              static_cast<std::size_t>(std::numeric_limits<int>::max()),
-            ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
-                       "The number of ghost entries times the size of 'Number' "
-                       "exceeds this value. This is not supported."));
           const int ierr =
-            MPI_Irecv(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[i]);
+            MPI_Startall(n_ghost_targets_sm,
+                         requests.data() + n_import_targets + n_ghost_targets);
           AssertThrowMPI(ierr);
-          temp_array_ptr += import_targets_data[i].second;
         }
 
       // initiate the send operations
@@ -405,26 +667,12 @@ namespace Utilities
               AssertDimension(offset, ghost_targets_data[i].second);
             }
 
-          AssertThrow(
-            static_cast<std::size_t>(ghost_targets_data[i].second) *
-                sizeof(Number) <
-              static_cast<std::size_t>(std::numeric_limits<int>::max()),
-            ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
-                       "The number of ghost entries times the size of 'Number' "
-                       "exceeds this value. This is not supported."));
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
           if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
             cudaDeviceSynchronize();
 #    endif
-          const int ierr =
-            MPI_Isend(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[n_import_targets + i]);
+          const int ierr = MPI_Start(&requests[n_import_targets + i]);
           AssertThrowMPI(ierr);
 
           ghost_array_ptr += ghost_targets_data[i].second;
@@ -503,7 +751,9 @@ namespace Utilities
       const ArrayView<const Number, MemorySpaceType> &temporary_storage,
       const ArrayView<Number, MemorySpaceType> &      locally_owned_array,
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
-      std::vector<MPI_Request> &                      requests) const
+      std::vector<MPI_Request> &                      requests,
+      const std::vector<ArrayView<const Number, MemorySpaceType>>
+        &shared_arrays) const
     {
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
@@ -571,16 +821,54 @@ namespace Utilities
         initialize_import_indices_plain_dev();
 #    endif
 
+      const unsigned int n_data_requests = n_ghost_targets + n_import_targets;
       if (vector_operation != dealii::VectorOperation::insert)
-        AssertDimension(n_ghost_targets + n_import_targets, requests.size());
+        AssertDimension(n_data_requests + n_ghost_targets_sm +
+                          n_import_targets_sm,
+                        requests.size());
       // first wait for the receive to complete
       if (requests.size() > 0 && n_import_targets > 0)
         {
           AssertDimension(locally_owned_array.size(), local_size());
-          const int ierr =
+          int ierr =
             MPI_Waitall(n_import_targets, requests.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
 
+          // read the ghost values of the processes sharing memory with us
+          // directly from their arrays into the position of the temporary
+          // storage where the receive would have put them, and signal that
+          // we are done reading. the temporary storage is the same array as
+          // passed to import_from_ghosted_array_start(), so it is safe to
+          // write into it here
+          if (n_import_targets_sm > 0)
+            {
+              Assert(shared_arrays.size() ==
+                       Utilities::MPI::n_mpi_processes(communicator_sm),
+                     ExcMessage(
+                       "The vector must be allocated in a shared-memory "
+                       "window, i.e., be set up with this partitioner."));
+              Number *temp_array_ptr =
+                const_cast<Number *>(temporary_storage.data());
+              for (unsigned int i = 0; i < n_import_targets; i++)
+                {
+                  if (is_shared_memory_import_target(i))
+                    {
+                      const Number *ghost_values =
+                        shared_arrays[import_targets_sm_ranks[i]].data() +
+                        import_targets_sm_offsets[i];
+                      std::copy(ghost_values,
+                                ghost_values + import_targets_data[i].second,
+                                temp_array_ptr);
+                    }
+                  temp_array_ptr += import_targets_data[i].second;
+                }
+
+              ierr = MPI_Startall(n_import_targets_sm,
+                                  requests.data() + n_data_requests +
+                                    n_ghost_targets_sm);
+              AssertThrowMPI(ierr);
+            }
+
           const Number *read_position = temporary_storage.data();
 #    if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
           defined(DEAL_II_MPI_WITH_CUDA_SUPPORT))
@@ -720,6 +1008,16 @@ namespace Utilities
       else
         AssertDimension(n_ghost_indices(), 0);
 
+      // wait for the owners sharing memory with us to have read our ghost
+      // values before we clear them
+      if (requests.size() > 0 && n_ghost_targets_sm + n_import_targets_sm > 0)
+        {
+          const int ierr = MPI_Waitall(n_ghost_targets_sm + n_import_targets_sm,
+                                       requests.data() + n_data_requests,
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
       // clear the ghost array in case we did not yet do that in the _start
       // function
       if (ghost_array.size() > 0)
@@ -756,6 +1054,7 @@ namespace Utilities
         }
 
       // clear the compress requests
+      persistent_requests.release(requests);
       requests.resize(0);
     }
 
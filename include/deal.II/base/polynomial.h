@@ -129,6 +129,19 @@ namespace Polynomials
           const unsigned int n_derivatives,
           number *           values) const;
 
+    /**
+     * Same as the previous function, but for an argument of a generic type
+     * @p Number2 such as VectorizedArray that allows to evaluate the
+     * polynomial at several points at once. The derivatives are computed by
+     * a Horner-type scheme that does not allocate memory, which makes this
+     * function suitable for the inner loops of evaluation kernels.
+     */
+    template <typename Number2>
+    void
+    value(const Number2 &    x,
+          const unsigned int n_derivatives,
+          Number2 *          values) const;
+
     /**
      * Degree of the polynomial. This is the degree reflected by the number of
      * coefficients provided by the constructor. Leading non-zero coefficients
@@ -807,6 +820,54 @@ namespace Polynomials
 
 
 
+  template <typename number>
+  template <typename Number2>
+  inline void
+  Polynomial<number>::value(const Number2 &    x,
+                            const unsigned int n_derivatives,
+                            Number2 *          values) const
+  {
+    // the same product rule expansion of the derivatives is used for the
+    // Lagrange product form and for the coefficient form, where the latter
+    // corresponds to a synthetic division in the Horner scheme
+    for (unsigned int d = 1; d <= n_derivatives; ++d)
+      values[d] = Number2();
+    if (in_lagrange_product_form == true)
+      {
+        values[0] = Number2(1.);
+        for (unsigned int i = 0; i < lagrange_support_points.size(); ++i)
+          {
+            const Number2 v = x - lagrange_support_points[i];
+            for (unsigned int k = n_derivatives; k > 0; --k)
+              values[k] = values[k] * v + values[k - 1];
+            values[0] *= v;
+          }
+      }
+    else
+      {
+        Assert(coefficients.size() > 0, ExcEmptyObject());
+        values[0] = Number2(coefficients.back());
+        for (int i = static_cast<int>(coefficients.size()) - 2; i >= 0; --i)
+          {
+            for (unsigned int k = n_derivatives; k > 0; --k)
+              values[k] = values[k] * x + values[k - 1];
+            values[0] = values[0] * x + coefficients[i];
+          }
+      }
+
+    // transform the Taylor coefficients p^(k)(x)/k! into derivatives and
+    // apply the weight of the Lagrange denominator
+    number k_faculty =
+      in_lagrange_product_form == true ? lagrange_weight : number(1.);
+    for (unsigned int k = 0; k <= n_derivatives; ++k)
+      {
+        values[k] *= k_faculty;
+        k_faculty *= static_cast<number>(k + 1);
+      }
+  }
+
+
+
   template <typename number>
   template <class Archive>
   inline void
@@ -21,6 +21,8 @@
 
 #include <deal.II/base/quadrature.h>
 
+#include <memory>
+
 DEAL_II_NAMESPACE_OPEN
 
 /*!@addtogroup Quadrature */
@@ -781,6 +783,89 @@ public:
 
 /*@}*/
 
+
+/**
+ * A registry of quadrature rules that are computed only once per program run
+ * and then shared among all users.
+ *
+ * Constructing a QGauss object, for example, computes its points and weights
+ * by Newton iterations and sets up the tensor product of the one-dimensional
+ * rule. Similarly, the constructors of FEFaceValues and FESubfaceValues
+ * project the face quadrature rule onto all faces or subfaces of the
+ * reference cell. In programs that create many such objects, e.g., the
+ * hp::QCollection objects of hp-adaptive programs with many different
+ * polynomial degrees, this work is repeated over and over again. The
+ * functions in this namespace instead return a pointer to a rule that is
+ * computed upon the first request and kept for later requests with the same
+ * arguments.
+ *
+ * The returned rules must not be modified, which is why only pointers to
+ * constant objects are returned. All functions may be called concurrently
+ * from several threads.
+ *
+ * An example is given by
+ * @code
+ * hp::QCollection<dim> q_collection;
+ * for (unsigned int degree = 1; degree <= max_degree; ++degree)
+ *   q_collection.push_back(QuadratureRegistry::gauss<dim>(degree + 1));
+ * @endcode
+ *
+ * @ingroup Quadrature
+ */
+namespace QuadratureRegistry
+{
+  /**
+   * Return the rule <tt>QGauss<dim>(n)</tt>.
+   */
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  gauss(const unsigned int n);
+
+  /**
+   * Return the rule <tt>QGaussLobatto<dim>(n)</tt>.
+   */
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  gauss_lobatto(const unsigned int n);
+
+  /**
+   * Return the rule <tt>QGaussRadauChebyshev<dim>(n, end_point)</tt>.
+   */
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  gauss_radau_chebyshev(
+    const unsigned int                                 n,
+    const typename QGaussRadauChebyshev<dim>::EndPoint end_point =
+      QGaussRadauChebyshev<dim>::left);
+
+  /**
+   * Return the rule that QProjector::project_to_all_faces() computes from the
+   * face rule @p quadrature. The rules are identified by comparing their
+   * points and weights, so this function can be called with any face rule,
+   * not only with the ones returned by the other functions of this
+   * namespace.
+   */
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  project_to_all_faces(const Quadrature<dim - 1> &quadrature);
+
+  /**
+   * Same as project_to_all_faces(), but for
+   * QProjector::project_to_all_subfaces().
+   */
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  project_to_all_subfaces(const Quadrature<dim - 1> &quadrature);
+
+  /**
+   * Release all rules stored in the registry. Pointers returned previously
+   * remain valid.
+   */
+  void
+  clear();
+} // namespace QuadratureRegistry
+
+
 /* -------------- declaration of explicit specializations ------------- */
 
 #ifndef DOXYGEN
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx17/optional.h>
 #include <deal.II/base/subscriptor.h>
@@ -252,6 +253,166 @@ private:
 };
 
 
+
+/**
+ * A class for storing the same number of objects of a single type
+ * @p DataType at each locally owned active cell of a triangulation, e.g.,
+ * the history variables at the quadrature points of a plasticity model.
+ *
+ * In contrast to CellDataStorage, which allocates each object separately
+ * behind a std::shared_ptr and finds the data of a cell by a search in a
+ * std::map keyed by the CellId, this class stores the objects of all cells
+ * by value in one contiguous array, cell after cell, and finds the data of
+ * a cell through its active_cell_index(). This saves the memory of the
+ * pointers, the control blocks and the map nodes, which can be much larger
+ * than the data itself for small @p DataType objects, and makes access as
+ * well as loops over all cells cache friendly. The price is that all
+ * objects have the same type @p DataType (which therefore cannot be an
+ * abstract class) and that the data is tied to the current set of active
+ * cells: After the triangulation has been refined, coarsened or
+ * repartitioned, the storage has to be initialized again. The data on the
+ * old mesh can be carried over by
+ * parallel::distributed::ContinuousQuadratureDataTransfer, as for
+ * CellDataStorage.
+ *
+ * A typical use is
+ * @code
+ * ContiguousCellDataStorage<typename Triangulation<dim>::cell_iterator,
+ *                           PointHistory<dim>>
+ *   history;
+ * history.initialize(triangulation.begin_active(),
+ *                    triangulation.end(),
+ *                    quadrature.size());
+ * ...
+ * for (const auto &cell : triangulation.active_cell_iterators())
+ *   if (cell->is_locally_owned())
+ *     {
+ *       const ArrayView<PointHistory<dim>> data = history.get_data(cell);
+ *       for (unsigned int q = 0; q < quadrature.size(); ++q)
+ *         // ... work on data[q]
+ *     }
+ * @endcode
+ */
+template <typename CellIteratorType, typename DataType>
+class ContiguousCellDataStorage : public Subscriptor
+{
+public:
+  /**
+   * Default constructor.
+   */
+  ContiguousCellDataStorage() = default;
+
+  /**
+   * Default destructor.
+   */
+  ~ContiguousCellDataStorage() override = default;
+
+  /**
+   * Initialize the storage with @p number_of_data_points_per_cell
+   * default-constructed objects of type @p DataType on each locally owned
+   * active cell in the range [@p cell_start, @p cell_end). Other cells in
+   * the range are skipped. Data stored by a previous call to this function
+   * is discarded, so this function must be called with all cells at once
+   * and again after each change of the active cells of the triangulation.
+   */
+  void
+  initialize(const CellIteratorType &cell_start,
+             const CellIteratorType &cell_end,
+             const unsigned int      number_of_data_points_per_cell);
+
+  /**
+   * Remove all data from this object.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of objects stored per cell.
+   */
+  unsigned int
+  n_data_points_per_cell() const;
+
+  /**
+   * Return the objects stored on @p cell. The cell must have been part of
+   * the range passed to the last call of initialize().
+   */
+  ArrayView<DataType>
+  get_data(const CellIteratorType &cell);
+
+  /**
+   * Same as above, but for constant access.
+   */
+  ArrayView<const DataType>
+  get_data(const CellIteratorType &cell) const;
+
+  /**
+   * Return the objects stored on @p cell if the cell was part of the range
+   * passed to the last call of initialize(), and an empty optional object
+   * otherwise.
+   */
+  std_cxx17::optional<ArrayView<DataType>>
+  try_get_data(const CellIteratorType &cell);
+
+  /**
+   * Same as above, but for constant access.
+   */
+  std_cxx17::optional<ArrayView<const DataType>>
+  try_get_data(const CellIteratorType &cell) const;
+
+  /**
+   * Return an estimate for the memory consumption (in bytes) of this
+   * object, not counting memory that the stored objects allocate
+   * themselves.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Return the position of the first object of @p cell in #data, or
+   * numbers::invalid_size_type if no data is stored on @p cell.
+   */
+  std::size_t
+  first_data_index(const CellIteratorType &cell) const;
+
+  /**
+   * Number of dimensions.
+   */
+  static constexpr unsigned int dimension =
+    CellIteratorType::AccessorType::dimension;
+
+  /**
+   * Number of space dimensions.
+   */
+  static constexpr unsigned int space_dimension =
+    CellIteratorType::AccessorType::space_dimension;
+
+  /**
+   * The triangulation whose cells the data is attached to.
+   */
+  SmartPointer<const Triangulation<dimension, space_dimension>,
+               ContiguousCellDataStorage<CellIteratorType, DataType>>
+    tria;
+
+  /**
+   * Number of objects per cell.
+   */
+  unsigned int data_points_per_cell = 0;
+
+  /**
+   * For each active cell of the triangulation, indexed by its
+   * active_cell_index(), the number of the cell within the cells that have
+   * data, or numbers::invalid_unsigned_int if no data is stored on the cell.
+   */
+  std::vector<unsigned int> cell_slots;
+
+  /**
+   * The objects of all cells with data, cell after cell.
+   */
+  std::vector<DataType> data;
+};
+
+
 /**
  * An abstract class which specifies requirements for data on
  * a single quadrature point to be transferable during refinement or
@@ -476,6 +637,18 @@ namespace parallel
         parallel::distributed::Triangulation<dim> &  tria,
         CellDataStorage<CellIteratorType, DataType> &data_storage);
 
+      /**
+       * Same as above, but for data stored in a ContiguousCellDataStorage
+       * object. Since that class ties the data to the active cells, the
+       * user has to call ContiguousCellDataStorage::initialize() for the new
+       * set of locally owned active cells after the mesh has changed and
+       * before calling interpolate().
+       */
+      void
+      prepare_for_coarsening_and_refinement(
+        parallel::distributed::Triangulation<dim> &            tria,
+        ContiguousCellDataStorage<CellIteratorType, DataType> &data_storage);
+
       /**
        * Interpolate the data previously stored in this object before the mesh
        * was refined or coarsened onto the quadrature points of the currently
@@ -574,6 +747,14 @@ namespace parallel
        */
       CellDataStorage<CellIteratorType, DataType> *data_storage;
 
+      /**
+       * A pointer to the ContiguousCellDataStorage class whose data will be
+       * transferred, if the data is stored in that format rather than in
+       * #data_storage.
+       */
+      ContiguousCellDataStorage<CellIteratorType, DataType>
+        *contiguous_data_storage;
+
       /**
        * A pointer to the distributed triangulation to which cell data is
        * attached.
@@ -804,6 +985,162 @@ CellDataStorage<CellIteratorType, DataType>::try_get_data(
     }
 }
 
+//--------------------------------------------------------------------
+//                    ContiguousCellDataStorage
+//--------------------------------------------------------------------
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::initialize(
+  const CellIteratorType &cell_start,
+  const CellIteratorType &cell_end,
+  const unsigned int      number_of_data_points_per_cell)
+{
+  data.clear();
+  cell_slots.clear();
+  data_points_per_cell = number_of_data_points_per_cell;
+  tria                 = nullptr;
+  if (cell_start == cell_end)
+    return;
+
+  tria = &cell_start->get_triangulation();
+  cell_slots.resize(tria->n_active_cells(), numbers::invalid_unsigned_int);
+
+  unsigned int n_cells_with_data = 0;
+  for (CellIteratorType cell = cell_start; cell != cell_end; ++cell)
+    if (cell->is_active() && cell->is_locally_owned())
+      {
+        Assert(&cell->get_triangulation() == tria,
+               ExcMessage("The cells in the given range must belong to the "
+                          "same triangulation."));
+        Assert(cell_slots[cell->active_cell_index()] ==
+                 numbers::invalid_unsigned_int,
+               ExcMessage("A cell must only appear once in the given range."));
+        cell_slots[cell->active_cell_index()] = n_cells_with_data++;
+      }
+
+  // allocate all objects in one go rather than one after the other
+  data.resize(static_cast<std::size_t>(n_cells_with_data) *
+              data_points_per_cell);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::clear()
+{
+  data.clear();
+  data.shrink_to_fit();
+  cell_slots.clear();
+  cell_slots.shrink_to_fit();
+  data_points_per_cell = 0;
+  tria                 = nullptr;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline unsigned int
+ContiguousCellDataStorage<CellIteratorType, DataType>::n_data_points_per_cell()
+  const
+{
+  return data_points_per_cell;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std::size_t
+ContiguousCellDataStorage<CellIteratorType, DataType>::first_data_index(
+  const CellIteratorType &cell) const
+{
+  if (tria == nullptr)
+    return numbers::invalid_size_type;
+
+  Assert(&cell->get_triangulation() == tria,
+         ExcMessage("The provided cell iterator does not belong to the "
+                    "triangulation the data was initialized for."));
+  Assert(tria->n_active_cells() == cell_slots.size(),
+         ExcMessage("The number of active cells of the triangulation has "
+                    "changed since the data was initialized. You need to "
+                    "call initialize() again after changing the mesh."));
+  if (cell->is_active() == false)
+    return numbers::invalid_size_type;
+
+  const unsigned int slot = cell_slots[cell->active_cell_index()];
+  if (slot == numbers::invalid_unsigned_int)
+    return numbers::invalid_size_type;
+  else
+    return static_cast<std::size_t>(slot) * data_points_per_cell;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const CellIteratorType &cell)
+{
+  const std::size_t index = first_data_index(cell);
+  Assert(index != numbers::invalid_size_type,
+         ExcMessage("Could not find data for the cell"));
+  return ArrayView<DataType>(data.data() + index, data_points_per_cell);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<const DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const CellIteratorType &cell) const
+{
+  const std::size_t index = first_data_index(cell);
+  Assert(index != numbers::invalid_size_type,
+         ExcMessage("Could not find data for the cell"));
+  return ArrayView<const DataType>(data.data() + index, data_points_per_cell);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std_cxx17::optional<ArrayView<DataType>>
+ContiguousCellDataStorage<CellIteratorType, DataType>::try_get_data(
+  const CellIteratorType &cell)
+{
+  const std::size_t index = first_data_index(cell);
+  if (index != numbers::invalid_size_type)
+    return {ArrayView<DataType>(data.data() + index, data_points_per_cell)};
+  else
+    return {};
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std_cxx17::optional<ArrayView<const DataType>>
+ContiguousCellDataStorage<CellIteratorType, DataType>::try_get_data(
+  const CellIteratorType &cell) const
+{
+  const std::size_t index = first_data_index(cell);
+  if (index != numbers::invalid_size_type)
+    return {
+      ArrayView<const DataType>(data.data() + index, data_points_per_cell)};
+  else
+    return {};
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std::size_t
+ContiguousCellDataStorage<CellIteratorType, DataType>::memory_consumption()
+  const
+{
+  return sizeof(*this) + cell_slots.capacity() * sizeof(unsigned int) +
+         data.capacity() * sizeof(DataType);
+}
+
 //--------------------------------------------------------------------
 //                    ContinuousQuadratureDataTransfer
 //--------------------------------------------------------------------
@@ -882,6 +1219,78 @@ unpack_to_cell_data(const CellIteratorType &                     cell,
 }
 
 
+
+/*
+ * Same as above for data stored in a ContiguousCellDataStorage object.
+ */
+template <typename CellIteratorType, typename DataType>
+inline void
+pack_cell_data(
+  const CellIteratorType &                                     cell,
+  const ContiguousCellDataStorage<CellIteratorType, DataType> *data_storage,
+  FullMatrix<double> &                                         matrix_data)
+{
+  static_assert(
+    std::is_base_of<TransferableQuadraturePointData, DataType>::value,
+    "User's DataType class should be derived from QPData");
+
+  if (const auto qpd = data_storage->try_get_data(cell))
+    {
+      const unsigned int m = qpd->size();
+      Assert(m > 0, ExcInternalError());
+      const unsigned int n = (*qpd)[0].number_of_values();
+      matrix_data.reinit(m, n);
+
+      std::vector<double> single_qp_data(n);
+      for (unsigned int q = 0; q < m; ++q)
+        {
+          (*qpd)[q].pack_values(single_qp_data);
+          AssertDimension(single_qp_data.size(), n);
+
+          for (unsigned int i = 0; i < n; ++i)
+            matrix_data(q, i) = single_qp_data[i];
+        }
+    }
+  else
+    {
+      matrix_data.reinit({0, 0});
+    }
+}
+
+
+
+/*
+ * Same as above for data stored in a ContiguousCellDataStorage object.
+ */
+template <typename CellIteratorType, typename DataType>
+inline void
+unpack_to_cell_data(
+  const CellIteratorType &                               cell,
+  const FullMatrix<double> &                             values_at_qp,
+  ContiguousCellDataStorage<CellIteratorType, DataType> *data_storage)
+{
+  static_assert(
+    std::is_base_of<TransferableQuadraturePointData, DataType>::value,
+    "User's DataType class should be derived from QPData");
+
+  if (const auto qpd = data_storage->try_get_data(cell))
+    {
+      const unsigned int n = values_at_qp.n();
+      AssertDimension((*qpd)[0].number_of_values(), n);
+
+      std::vector<double> single_qp_data(n);
+      AssertDimension(qpd->size(), values_at_qp.m());
+
+      for (unsigned int q = 0; q < qpd->size(); ++q)
+        {
+          for (unsigned int i = 0; i < n; ++i)
+            single_qp_data[i] = values_at_qp(q, i);
+          (*qpd)[q].unpack_values(single_qp_data);
+        }
+    }
+}
+
+
 #  ifdef DEAL_II_WITH_P4EST
 
 namespace parallel
@@ -901,6 +1310,7 @@ namespace parallel
       , project_to_qp_matrix(n_q_points, projection_fe->dofs_per_cell)
       , handle(numbers::invalid_unsigned_int)
       , data_storage(nullptr)
+      , contiguous_data_storage(nullptr)
       , triangulation(nullptr)
     {
       Assert(
@@ -927,7 +1337,7 @@ namespace parallel
         parallel::distributed::Triangulation<dim> &  tr_,
         CellDataStorage<CellIteratorType, DataType> &data_storage_)
     {
-      Assert(data_storage == nullptr,
+      Assert(data_storage == nullptr && contiguous_data_storage == nullptr,
              ExcMessage("This function can be called only once"));
       triangulation = &tr_;
       data_storage  = &data_storage_;
@@ -943,6 +1353,29 @@ namespace parallel
 
 
 
+    template <int dim, typename DataType>
+    inline void
+    ContinuousQuadratureDataTransfer<dim, DataType>::
+      prepare_for_coarsening_and_refinement(
+        parallel::distributed::Triangulation<dim> &            tr_,
+        ContiguousCellDataStorage<CellIteratorType, DataType> &data_storage_)
+    {
+      Assert(data_storage == nullptr && contiguous_data_storage == nullptr,
+             ExcMessage("This function can be called only once"));
+      triangulation           = &tr_;
+      contiguous_data_storage = &data_storage_;
+
+      handle = triangulation->register_data_attach(
+        [this](
+          const typename parallel::distributed::Triangulation<
+            dim>::cell_iterator &cell,
+          const typename parallel::distributed::Triangulation<dim>::CellStatus
+            status) { return this->pack_function(cell, status); },
+        /*returns_variable_size_data=*/true);
+    }
+
+
+
     template <int dim, typename DataType>
     inline void
     ContinuousQuadratureDataTransfer<dim, DataType>::interpolate()
@@ -958,8 +1391,9 @@ namespace parallel
             &data_range) { this->unpack_function(cell, status, data_range); });
 
       // invalidate the pointers
-      data_storage  = nullptr;
-      triangulation = nullptr;
+      data_storage            = nullptr;
+      contiguous_data_storage = nullptr;
+      triangulation           = nullptr;
     }
 
 
@@ -972,7 +1406,10 @@ namespace parallel
       const typename parallel::distributed::Triangulation<
         dim>::CellStatus /*status*/)
     {
-      pack_cell_data(cell, data_storage, matrix_quadrature);
+      if (data_storage != nullptr)
+        pack_cell_data(cell, data_storage, matrix_quadrature);
+      else
+        pack_cell_data(cell, contiguous_data_storage, matrix_quadrature);
 
       // project to FE
       const unsigned int number_of_values = matrix_quadrature.n();
@@ -1029,9 +1466,14 @@ namespace parallel
                                            matrix_dofs_child);
 
                 // finally, put back into the map:
-                unpack_to_cell_data(cell->child(child),
-                                    matrix_quadrature,
-                                    data_storage);
+                if (data_storage != nullptr)
+                  unpack_to_cell_data(cell->child(child),
+                                      matrix_quadrature,
+                                      data_storage);
+                else
+                  unpack_to_cell_data(cell->child(child),
+                                      matrix_quadrature,
+                                      contiguous_data_storage);
               }
         }
       else
@@ -1041,7 +1483,12 @@ namespace parallel
           project_to_qp_matrix.mmult(matrix_quadrature, matrix_dofs);
 
           // finally, put back into the map:
-          unpack_to_cell_data(cell, matrix_quadrature, data_storage);
+          if (data_storage != nullptr)
+            unpack_to_cell_data(cell, matrix_quadrature, data_storage);
+          else
+            unpack_to_cell_data(cell,
+                                matrix_quadrature,
+                                contiguous_data_storage);
         }
     }
 
@@ -19,8 +19,10 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
 #include <vector>
@@ -104,6 +106,26 @@ public:
            std::vector<Tensor<3, dim>> &third_derivatives,
            std::vector<Tensor<4, dim>> &fourth_derivatives) const = 0;
 
+  /**
+   * Compute the values and the first derivatives of all polynomials at all
+   * points in @p unit_points at once. Entry <tt>(i,q)</tt> of @p values and
+   * @p grads is set to the value and the gradient of the <tt>i</tt>th
+   * polynomial at the <tt>q</tt>th point, which is the layout used for shape
+   * function data in the finite element classes.
+   *
+   * The tables must either be empty or of size <tt>n()</tt> times
+   * <tt>unit_points.size()</tt>. In the first case, the function will not
+   * compute these values.
+   *
+   * The default implementation calls evaluate() for each point. Derived
+   * classes can override this function with an implementation that
+   * evaluates several points at once, as TensorProductPolynomials does.
+   */
+  virtual void
+  evaluate_values_and_gradients(const ArrayView<const Point<dim>> &unit_points,
+                                Table<2, double> &                 values,
+                                Table<2, Tensor<1, dim>> &grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th polynomial at unit point
    * <tt>p</tt>.
@@ -975,6 +975,11 @@ private:
   friend DEAL_II_CONSTEXPR SymmetricTensor<4, dim2, Number2>
                            identity_tensor();
 
+  template <int dim2, typename Number2>
+  friend DEAL_II_CONSTEXPR SymmetricTensor<4, dim2, Number2>
+    outer_product(const SymmetricTensor<2, dim2, Number2> &t1,
+                  const SymmetricTensor<2, dim2, Number2> &t2);
+
 
   // Make a few helper classes friends as well.
   friend struct internal::SymmetricTensorImplementation::
@@ -1731,14 +1736,18 @@ namespace internal
     for (unsigned int i = 0; i < data_dim; ++i)
       for (unsigned int j = 0; j < data_dim; ++j)
         {
-          // Start with the non-diagonal part
+          // Start with the non-diagonal part. Accumulate into a local
+          // variable that the compiler can keep in a register, rather than
+          // into the entry of the result
+          value_type sum = NumberType<value_type>::value(0.0);
           for (unsigned int d = dim; d < (dim * (dim + 1) / 2); ++d)
-            tmp[i][j] += data[i][d] * sdata[d][j];
-          tmp[i][j] += tmp[i][j]; // tmp[i][j] = tmp[i][j] * 2;
+            sum += data[i][d] * sdata[d][j];
+          sum += sum; // sum = sum * 2.;
 
           // Now add the contributions from the diagonal
           for (unsigned int d = 0; d < dim; ++d)
-            tmp[i][j] += data[i][d] * sdata[d][j];
+            sum += data[i][d] * sdata[d][j];
+          tmp[i][j] = sum;
         }
     return tmp;
   }
@@ -3476,12 +3485,15 @@ outer_product(const SymmetricTensor<2, dim, Number> &t1,
 {
   SymmetricTensor<4, dim, Number> tmp;
 
-  // fill only the elements really needed
-  for (unsigned int i = 0; i < dim; ++i)
-    for (unsigned int j = i; j < dim; ++j)
-      for (unsigned int k = 0; k < dim; ++k)
-        for (unsigned int l = k; l < dim; ++l)
-          tmp[i][j][k][l] = t1[i][j] * t2[k][l];
+  // the independent entries of the rank-4 tensor are stored as a matrix
+  // whose rows and columns are indexed like the independent entries of the
+  // rank-2 tensors, so fill it directly rather than through the index
+  // translation of the accessors
+  constexpr unsigned int n_entries =
+    SymmetricTensor<2, dim, Number>::n_independent_components;
+  for (unsigned int i = 0; i < n_entries; ++i)
+    for (unsigned int j = 0; j < n_entries; ++j)
+      tmp.data[i][j] = t1.data[i] * t2.data[j];
 
   return tmp;
 }
@@ -111,6 +111,14 @@ public:
   const std::vector<unsigned int> &
   get_numbering_inverse() const;
 
+  /**
+   * Give read access to the one-dimensional polynomials the tensor product
+   * is built from. This is useful for evaluating the polynomial space with
+   * sum factorization, see e.g. the FEPointEvaluation class.
+   */
+  const std::vector<PolynomialType> &
+  get_underlying_polynomials() const;
+
   /**
    * Compute the value and the first and second derivatives of each tensor
    * product polynomial at <tt>unit_point</tt>.
@@ -131,6 +139,42 @@ public:
            std::vector<Tensor<3, dim>> &third_derivatives,
            std::vector<Tensor<4, dim>> &fourth_derivatives) const override;
 
+  /**
+   * Compute the values and the first derivatives of all tensor product
+   * polynomials at all points in @p unit_points, see
+   * ScalarPolynomialsBase::evaluate_values_and_gradients() for the layout of
+   * the output arrays.
+   *
+   * This function evaluates VectorizedArray::size() points at once by the
+   * function below. It is used by FE_Poly to fill the shape function tables
+   * when a finite element is evaluated at all quadrature points of a cell.
+   */
+  void
+  evaluate_values_and_gradients(
+    const ArrayView<const Point<dim>> &unit_points,
+    Table<2, double> &                 values,
+    Table<2, Tensor<1, dim>> &         grads) const override;
+
+  /**
+   * Compute the values and the first derivatives of all tensor product
+   * polynomials at the VectorizedArray::size() points whose coordinates are
+   * stored in the lanes of @p unit_point.
+   *
+   * The size of the arrays must either be equal 0 or equal n(). In the first
+   * case, the function will not compute these values.
+   *
+   * The one-dimensional polynomials are evaluated with the Horner scheme or,
+   * for polynomials given by their roots such as those generated by
+   * Polynomials::generate_complete_Lagrange_basis(), with the product of the
+   * linear factors scaled by the barycentric weight, which remains accurate
+   * also for high polynomial degrees.
+   */
+  void
+  evaluate_values_and_gradients(
+    const Point<dim, VectorizedArray<double>> &               unit_point,
+    const ArrayView<VectorizedArray<double>> &                values,
+    const ArrayView<Tensor<1, dim, VectorizedArray<double>>> &grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
@@ -520,6 +564,16 @@ TensorProductPolynomials<dim, PolynomialType>::get_numbering_inverse() const
 }
 
 
+
+template <int dim, typename PolynomialType>
+inline const std::vector<PolynomialType> &
+TensorProductPolynomials<dim, PolynomialType>::get_underlying_polynomials()
+  const
+{
+  return polynomials;
+}
+
+
 template <int dim, typename PolynomialType>
 inline std::string
 TensorProductPolynomials<dim, PolynomialType>::name() const
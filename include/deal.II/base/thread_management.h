@@ -36,6 +36,9 @@
 #  include <utility>
 #  include <vector>
 
+#  ifdef DEAL_II_WITH_TBB
+#    include <tbb/task_group.h>
+#  endif
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -993,8 +996,39 @@ namespace Threads
     Task(const std::function<RT()> &function_object)
     {
       if (MultithreadInfo::n_threads() > 1)
-        task_data = std::make_shared<TaskData>(
-          std::async(std::launch::async, function_object));
+        {
+#  ifdef DEAL_II_WITH_TBB
+          // Run the function on the TBB thread pool rather than on a
+          // newly created thread, so that tasks started from within
+          // parallel regions do not oversubscribe the machine: Create a
+          // promise from which we get the future up front, and let a
+          // task_group (for just this one task) run the function and set
+          // the promise.
+          const auto promise = std::make_shared<std::promise<RT>>();
+
+          task_data = std::make_shared<TaskData>(promise->get_future());
+          task_data->task_group.run([function_object, promise]() {
+            try
+              {
+                internal::evaluate_and_set_promise(function_object, *promise);
+              }
+            catch (...)
+              {
+                try
+                  {
+                    // store anything thrown in the promise
+                    promise->set_exception(std::current_exception());
+                  }
+                catch (...)
+                  {}
+                // set_exception() may throw too
+              }
+          });
+#  else
+          task_data = std::make_shared<TaskData>(
+            std::async(std::launch::async, function_object));
+#  endif
+        }
       else
         {
           // Only one thread allowed. So let the task run to completion
@@ -1191,6 +1225,18 @@ namespace Threads
         , task_has_finished(false)
       {}
 
+#  ifdef DEAL_II_WITH_TBB
+      /**
+       * Destructor. A tbb::task_group must not be destroyed while its tasks
+       * are still running, so wait for the task to finish. (This mirrors
+       * the behavior of the std::future returned by std::async.)
+       */
+      ~TaskData()
+      {
+        task_group.wait();
+      }
+#  endif
+
       /**
        * Wait for the std::future object to be ready, i.e., for the
        * time when the std::promise receives its value. If this has
@@ -1223,6 +1269,11 @@ namespace Threads
             // anything, and so it looks odd to have the explicit call
             // to future.wait() in the set_from() function. Avoid the
             // issue by just explicitly calling future.wait() here.)
+#  ifdef DEAL_II_WITH_TBB
+            // Waiting on the task_group lets the current thread work on the
+            // task itself if no other thread has picked it up yet.
+            task_group.wait();
+#  endif
             future.wait();
             returned_object.set_from(future);
 
@@ -1263,6 +1314,14 @@ namespace Threads
        * has delivered.
        */
       internal::return_value<RT> returned_object;
+
+#  ifdef DEAL_II_WITH_TBB
+    public:
+      /**
+       * The task group object on which the task is run.
+       */
+      tbb::task_group task_group;
+#  endif
     };
 
     /**
@@ -1295,7 +1354,10 @@ namespace Threads
    *   value is placed in the Task object returned here. This is useful for
    *   cases where one wants to run a program in a way where deal.II does not
    *   internally create parallel tasks, for example because one is already
-   *   using one MPI process per core in a parallel computation.
+   *   using one MPI process per core in a parallel computation. If deal.II
+   *   uses TBB, the task is run on the thread pool of TBB rather than on a
+   *   newly created thread, so that tasks created from within other tasks or
+   *   parallel loops do not oversubscribe the machine.
    *
    * @ingroup threads
    */
@@ -1385,7 +1447,10 @@ namespace Threads
    *   value is placed in the Task object returned here. This is useful for
    *   cases where one wants to run a program in a way where deal.II does not
    *   internally create parallel tasks, for example because one is already
-   *   using one MPI process per core in a parallel computation.
+   *   using one MPI process per core in a parallel computation. If deal.II
+   *   uses TBB, the task is run on the thread pool of TBB rather than on a
+   *   newly created thread, so that tasks created from within other tasks or
+   *   parallel loops do not oversubscribe the machine.
    *
    * @ingroup CPP11
    */
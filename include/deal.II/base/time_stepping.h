@@ -20,7 +20,9 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/vectorization.h>
 
+#include <array>
 #include <functional>
 #include <vector>
 
@@ -38,6 +40,12 @@ namespace TimeStepping
    *   - FORWARD_EULER (first order)
    *   - RK_THIRD_ORDER (third order Runge-Kutta)
    *   - RK_CLASSIC_FOURTH_ORDER (classical fourth order Runge-Kutta)
+   * - Low-storage (explicit) Runge-Kutta methods (see
+   *   LowStorageRungeKutta::initialize):
+   *   - LOW_STORAGE_RK_STAGE3_ORDER3 (Three stages and third order)
+   *   - LOW_STORAGE_RK_STAGE5_ORDER4 (Five stages and fourth order)
+   *   - LOW_STORAGE_RK_STAGE7_ORDER4 (Seven stages and fourth order)
+   *   - LOW_STORAGE_RK_STAGE9_ORDER5 (Nine stages and fifth order)
    * - Implicit methods (see ImplicitRungeKutta::initialize):
    *   - BACKWARD_EULER (first order)
    *   - IMPLICIT_MIDPOINT (second order)
@@ -56,6 +64,10 @@ namespace TimeStepping
     FORWARD_EULER,
     RK_THIRD_ORDER,
     RK_CLASSIC_FOURTH_ORDER,
+    LOW_STORAGE_RK_STAGE3_ORDER3,
+    LOW_STORAGE_RK_STAGE5_ORDER4,
+    LOW_STORAGE_RK_STAGE7_ORDER4,
+    LOW_STORAGE_RK_STAGE9_ORDER5,
     BACKWARD_EULER,
     IMPLICIT_MIDPOINT,
     CRANK_NICOLSON,
@@ -318,6 +330,172 @@ namespace TimeStepping
 
 
 
+  /**
+   * The LowStorageRungeKutta class is derived from RungeKutta and implements
+   * explicit Runge-Kutta methods in the two-register (2N) form of Kennedy,
+   * Carpenter, and Lewis (2000). These methods only need two auxiliary
+   * vectors besides the solution, independently of the number of stages,
+   * and each stage consists of one evaluation of $f$ followed by a single
+   * sweep over the vectors:
+   * @f{align*}{
+   *   k_i &= f(t^n + c_i \Delta t, r_i), \
+   *   r_{i+1} &= y + a_i \Delta t\, k_i, \
+   *   y &\leftarrow y + b_i \Delta t\, k_i,
+   * @f}
+   * starting from $r_1 = y^n$, where $a_i$ is the subdiagonal of the Butcher
+   * tableau (all other entries of row $i$ coincide with $b$). In contrast,
+   * ExplicitRungeKutta stores one vector per stage. The methods are
+   * - LOW_STORAGE_RK_STAGE3_ORDER3: the third order scheme of Kennedy,
+   *   Carpenter, and Lewis (2000), RK3(2)3[2R+],
+   * - LOW_STORAGE_RK_STAGE5_ORDER4: the fourth order scheme RK4(3)5[2R+]C of
+   *   Kennedy, Carpenter, and Lewis (2000),
+   * - LOW_STORAGE_RK_STAGE7_ORDER4: the fourth order scheme of Tselios and
+   *   Simos (2007) with a large stability region along the imaginary axis,
+   * - LOW_STORAGE_RK_STAGE9_ORDER5: the fifth order scheme RK5(4)9[2R+]S of
+   *   Kennedy, Carpenter, and Lewis (2000).
+   *
+   * The updates of $r_{i+1}$ and $y$ are fused into one loop for Vector and
+   * LinearAlgebra::distributed::Vector. For operators based on MatrixFree,
+   * the evaluation of $f$ and the updates of a stage can also be merged by
+   * the variant of evolve_one_time_step() that takes a stage operator, which
+   * can perform the updates in the `operation_after_loop` of
+   * MatrixFree::cell_loop(), while the entries are still in cache.
+   */
+  template <typename VectorType>
+  class LowStorageRungeKutta : public RungeKutta<VectorType>
+  {
+  public:
+    using RungeKutta<VectorType>::evolve_one_time_step;
+
+    /**
+     * Default constructor. This constructor creates an object for which
+     * you will want to call <code>initialize(runge_kutta_method)</code>
+     * before it can be used.
+     */
+    LowStorageRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method).
+     */
+    LowStorageRungeKutta(const runge_kutta_method method);
+
+    /**
+     * Initialize the low-storage Runge-Kutta method.
+     */
+    void
+    initialize(const runge_kutta_method method) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. @p f
+     * is the function $ f(t,y) $ that should be integrated, the input
+     * parameters are the time t and the vector y and the output is value of f
+     * at this point. @p id_minus_tau_J_inverse is not used by the explicit
+     * methods. evolve_one_time_step returns the time at the end of the time
+     * step. This function allocates the two auxiliary vectors in each call,
+     * and @p f returns its result by value; the other variants avoid both.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &         id_minus_tau_J_inverse,
+      double      t,
+      double      delta_t,
+      VectorType &y) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. The
+     * function @p f computes $f(t, \text{src})$ and stores it in its last
+     * argument. The vectors @p vec_ri and @p vec_ki are used as storage for
+     * the stage vectors $r_i$ and $k_i$ and need to have the same layout as
+     * @p solution; their content on entry is overwritten. This function
+     * returns the time at the end of the time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<void(const double, const VectorType &, VectorType &)>
+        &         f,
+      double      t,
+      double      delta_t,
+      VectorType &solution,
+      VectorType &vec_ri,
+      VectorType &vec_ki);
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t,
+     * leaving the work of each stage to @p stage_operator. A call
+     * `stage_operator(t, factor_solution, factor_ai, current_ri, vec_ki,
+     * solution, next_ri)` needs to compute `vec_ki` $= f(t,
+     * \text{current\_ri})$ and then, entry by entry,
+     * `next_ri = solution + factor_ai * vec_ki` (only if `factor_ai` is
+     * nonzero, which is not the case in the last stage) and
+     * `solution += factor_solution * vec_ki`.
+     *
+     * `current_ri` coincides with `solution` in the first stage and with
+     * `next_ri` in all other stages, so an entry may only be overwritten
+     * once $f$ does not read it anymore. This is the case in the
+     * `operation_after_loop` of MatrixFree::cell_loop(), which is the
+     * intended place for the updates.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<void(const double      t,
+                               const double      factor_solution,
+                               const double      factor_ai,
+                               const VectorType &current_ri,
+                               VectorType &      vec_ki,
+                               VectorType &      solution,
+                               VectorType &      next_ri)> &stage_operator,
+      double                                             t,
+      double                                             delta_t,
+      VectorType &                                       solution,
+      VectorType &                                       vec_ri,
+      VectorType &                                       vec_ki);
+
+    /**
+     * Get the coefficients of the scheme, i.e., the subdiagonal @p a of the
+     * Butcher tableau, the weights @p b, and the nodes @p c. The vector
+     * @p a has one entry less than the number of stages.
+     */
+    void
+    get_coefficients(std::vector<double> &a,
+                     std::vector<double> &b,
+                     std::vector<double> &c) const;
+
+    /**
+     * This structure stores the name of the method used.
+     */
+    struct Status : public TimeStepping<VectorType>::Status
+    {
+      Status()
+        : method(invalid)
+      {}
+
+      runge_kutta_method method;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * The subdiagonal of the Butcher tableau, which together with the
+     * weights b of the base class defines the scheme.
+     */
+    std::vector<double> a_subdiagonal;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
   /**
    * This class is derived from RungeKutta and implement the implicit methods.
    * This class works only for Diagonal Implicit Runge-Kutta (DIRK) methods.
@@ -560,6 +738,17 @@ namespace TimeStepping
                                    const double refine_tol,
                                    const double coarsen_tol);
 
+    /**
+     * Get the coefficients of the Butcher tableau, i.e., the matrix @p a,
+     * the weights @p b1 of the solution, the weights @p b2 of the embedded
+     * method used for the error estimate, and the nodes @p c.
+     */
+    void
+    get_coefficients(std::vector<std::vector<double>> &a,
+                     std::vector<double> &             b1,
+                     std::vector<double> &             b2,
+                     std::vector<double> &             c) const;
+
     /**
      * Structure that stores the name of the method, the reason to exit
      * evolve_one_time_step, the number of iteration inside n_iterations, a
@@ -654,6 +843,189 @@ namespace TimeStepping
      */
     Status status;
   };
+
+
+
+  /**
+   * This class advances a batch of VectorizedArray<Number>::size()
+   * independent systems of ODEs of the same size, e.g., the reaction
+   * equations at the quadrature points of a cell, with the embedded explicit
+   * methods of EmbeddedExplicitRungeKutta. Lane $v$ of the vectorized arrays
+   * holds the system $v$ with its own time and time step, so that the stages
+   * of all systems are computed at once with SIMD instructions.
+   *
+   * The time step of each system is adapted independently with the same
+   * rules as in EmbeddedExplicitRungeKutta: the stages are recomputed as long
+   * as the time step of at least one system needs to be refined, whereas the
+   * systems whose time step has already been accepted keep their result.
+   * As opposed to EmbeddedExplicitRungeKutta, the last stage is never reused
+   * as the first stage of the next time step.
+   */
+  template <typename Number>
+  class EmbeddedExplicitRungeKuttaBatch
+  {
+  public:
+    /**
+     * The type containing the entries of all systems.
+     */
+    using value_type = VectorizedArray<Number>;
+
+    /**
+     * Default constructor. initialize(runge_kutta_method) and
+     * set_time_adaptation_parameters(double, double, double, double, double,
+     * double) need to be called before the object can be used.
+     */
+    EmbeddedExplicitRungeKuttaBatch() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method) and
+     * initialize the parameters needed for time adaptation, which are the
+     * same for all systems.
+     */
+    EmbeddedExplicitRungeKuttaBatch(const runge_kutta_method method,
+                                    const double coarsen_param = 1.2,
+                                    const double refine_param  = 0.8,
+                                    const double min_delta     = 1e-14,
+                                    const double max_delta     = 1e100,
+                                    const double refine_tol    = 1e-8,
+                                    const double coarsen_tol   = 1e-12);
+
+    /**
+     * Initialize the embedded explicit Runge-Kutta method, see
+     * EmbeddedExplicitRungeKutta::initialize().
+     */
+    void
+    initialize(const runge_kutta_method method);
+
+    /**
+     * Set the parameters necessary for the time adaptation.
+     */
+    void
+    set_time_adaptation_parameters(const double coarsen_param,
+                                   const double refine_param,
+                                   const double min_delta,
+                                   const double max_delta,
+                                   const double refine_tol,
+                                   const double coarsen_tol);
+
+    /**
+     * This function is used to advance all systems from the times @p t by
+     * the time steps @p delta_t, which may be reduced for each system
+     * separately. The function @p f computes $f(t,y)$ of all systems and
+     * stores it in its last argument, which has the same size as @p y.
+     * evolve_one_time_step returns the times at the end of the time steps.
+     */
+    value_type
+    evolve_one_time_step(
+      const std::function<void(const value_type &             t,
+                               const std::vector<value_type> &y,
+                               std::vector<value_type> &      f)> &f,
+      const value_type &                                           t,
+      const value_type &                                           delta_t,
+      std::vector<value_type> &                                    y);
+
+    /**
+     * Structure that stores the name of the method, the reason to exit
+     * evolve_one_time_step for each system, the number of iterations, a guess
+     * of what the next time step should be, and an estimate of the norm of
+     * the error for each system.
+     */
+    struct Status
+    {
+      runge_kutta_method method;
+      std::array<embedded_runge_kutta_time_step, value_type::size()>
+                   exit_delta_t;
+      unsigned int n_iterations;
+      value_type   delta_t_guess;
+      value_type   error_norm;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const;
+
+  private:
+    /**
+     * Number of stages.
+     */
+    unsigned int n_stages;
+
+    /**
+     * Butcher tableau coefficients.
+     */
+    std::vector<std::vector<double>> a;
+
+    /**
+     * Butcher tableau coefficients.
+     */
+    std::vector<double> b1;
+
+    /**
+     * Butcher tableau coefficients.
+     */
+    std::vector<double> b2;
+
+    /**
+     * Butcher tableau coefficients.
+     */
+    std::vector<double> c;
+
+    /**
+     * This parameter is the factor (>1) by which the time step is multiplied
+     * when the time stepping can be coarsen.
+     */
+    double coarsen_param;
+
+    /**
+     * This parameter is the factor (<1) by which the time step is multiplied
+     * when the time stepping must be refined.
+     */
+    double refine_param;
+
+    /**
+     * Smallest time step allowed.
+     */
+    double min_delta_t;
+
+    /**
+     * Largest time step allowed.
+     */
+    double max_delta_t;
+
+    /**
+     * Refinement tolerance: if the error estimate is larger than refine_tol,
+     * the time step is refined.
+     */
+    double refine_tol;
+
+    /**
+     * Coarsening tolerance: if the error estimate is smaller than coarse_tol,
+     * the time step is coarsen.
+     */
+    double coarsen_tol;
+
+    /**
+     * The stages, kept between calls to avoid allocations.
+     */
+    std::vector<std::vector<value_type>> f_stages;
+
+    /**
+     * The solution at the beginning of the time step.
+     */
+    std::vector<value_type> old_y;
+
+    /**
+     * Scratch vector for the arguments of the stages and the new solution.
+     */
+    std::vector<value_type> stage_y;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
 } // namespace TimeStepping
 
 DEAL_II_NAMESPACE_CLOSE
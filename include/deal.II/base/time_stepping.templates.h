@@ -19,9 +19,16 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/time_stepping.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
 #include <functional>
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -218,6 +225,378 @@ namespace TimeStepping
 
 
 
+  // ----------------------------------------------------------------------
+  // LowStorageRungeKutta
+  // ----------------------------------------------------------------------
+
+  namespace internal
+  {
+    /**
+     * Perform the vector updates of one stage of a low-storage Runge-Kutta
+     * scheme, i.e., next_ri = solution + factor_ai * vec_ki (unless factor_ai
+     * is zero) and solution += factor_solution * vec_ki. This is the general
+     * implementation that calls two vector operations.
+     */
+    template <typename VectorType>
+    void
+    low_storage_stage_update(const double      factor_solution,
+                             const double      factor_ai,
+                             const VectorType &vec_ki,
+                             VectorType &      solution,
+                             VectorType &      next_ri)
+    {
+      if (factor_ai != 0.)
+        {
+          next_ri = solution;
+          next_ri.add(factor_ai, vec_ki);
+        }
+      solution.add(factor_solution, vec_ki);
+    }
+
+
+
+    /**
+     * Perform the vector updates of one stage on raw arrays of length
+     * @p size in one sweep, possibly in parallel.
+     */
+    template <typename Number>
+    void
+    low_storage_stage_update(const double       factor_solution,
+                             const double       factor_ai,
+                             const std::size_t  size,
+                             const Number *const vec_ki,
+                             Number *const      solution,
+                             Number *const      next_ri)
+    {
+      const Number f_sol = factor_solution;
+      const Number f_ai  = factor_ai;
+      const auto   update_range =
+        [=](const std::size_t begin, const std::size_t end) {
+          if (f_ai != Number())
+            {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (std::size_t i = begin; i < end; ++i)
+                {
+                  const Number k = vec_ki[i];
+                  const Number u = solution[i];
+                  next_ri[i]     = u + f_ai * k;
+                  solution[i]    = u + f_sol * k;
+                }
+            }
+          else
+            {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (std::size_t i = begin; i < end; ++i)
+                solution[i] += f_sol * vec_ki[i];
+            }
+        };
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        size,
+        update_range,
+        dealii::internal::VectorImplementation::minimum_parallel_grain_size);
+    }
+
+
+
+    template <typename Number>
+    void
+    low_storage_stage_update(const double          factor_solution,
+                             const double          factor_ai,
+                             const Vector<Number> &vec_ki,
+                             Vector<Number> &      solution,
+                             Vector<Number> &      next_ri)
+    {
+      AssertDimension(vec_ki.size(), solution.size());
+      AssertDimension(next_ri.size(), solution.size());
+      low_storage_stage_update(factor_solution,
+                               factor_ai,
+                               solution.size(),
+                               vec_ki.begin(),
+                               solution.begin(),
+                               next_ri.begin());
+    }
+
+
+
+    template <typename Number>
+    void
+    low_storage_stage_update(
+      const double                                      factor_solution,
+      const double                                      factor_ai,
+      const LinearAlgebra::distributed::Vector<Number> &vec_ki,
+      LinearAlgebra::distributed::Vector<Number> &      solution,
+      LinearAlgebra::distributed::Vector<Number> &      next_ri)
+    {
+      AssertDimension(vec_ki.local_size(), solution.local_size());
+      AssertDimension(next_ri.local_size(), solution.local_size());
+      // The ghost entries would not be consistent after the update
+      if (solution.has_ghost_elements())
+        solution.zero_out_ghosts();
+      if (next_ri.has_ghost_elements())
+        next_ri.zero_out_ghosts();
+      low_storage_stage_update(factor_solution,
+                               factor_ai,
+                               solution.local_size(),
+                               vec_ki.begin(),
+                               solution.begin(),
+                               next_ri.begin());
+    }
+  } // namespace internal
+
+
+
+  template <typename VectorType>
+  LowStorageRungeKutta<VectorType>::LowStorageRungeKutta(
+    const runge_kutta_method method)
+  {
+    // virtual functions called in constructors and destructors never use the
+    // override in a derived class
+    // for clarity be explicit on which function is called
+    LowStorageRungeKutta<VectorType>::initialize(method);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::initialize(const runge_kutta_method method)
+  {
+    status.method = method;
+
+    switch (method)
+      {
+        case (LOW_STORAGE_RK_STAGE3_ORDER3):
+          {
+            this->n_stages = 3;
+            a_subdiagonal  = {0.755726351946097, 0.386954477304099};
+            this->b = {0.245170287303492, 0.184896052186740, 0.569933660509768};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE5_ORDER4):
+          {
+            this->n_stages = 5;
+            a_subdiagonal  = {970286171893. / 4311952581923.,
+                             6584761158862. / 12103376702013.,
+                             2251764453980. / 15575788980749.,
+                             26877169314380. / 34165994151039.};
+            this->b        = {1153189308089. / 22510343858157.,
+                       1772645290293. / 4653164025191.,
+                       -1672844663538. / 4480602732383.,
+                       2114624349019. / 3568978502595.,
+                       5198255086312. / 14908931495163.};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE7_ORDER4):
+          {
+            this->n_stages = 7;
+            this->b        = {0.0941840925477795334,
+                       0.149683694803496998,
+                       0.285204742060440058,
+                       -0.122201846148053668,
+                       0.0605151571191401122,
+                       0.345986987898399296,
+                       0.186627171718797670};
+            // The scheme is given in terms of the differences between the
+            // subdiagonal and the weights
+            const std::vector<double> a_minus_b = {0.241566650129646868,
+                                                   0.0423866513027719953,
+                                                   0.215602732678803776,
+                                                   0.232328007537583987,
+                                                   0.256223412574146438,
+                                                   0.0978694102142697230};
+            a_subdiagonal.resize(this->n_stages - 1);
+            for (unsigned int i = 0; i < this->n_stages - 1; ++i)
+              a_subdiagonal[i] = a_minus_b[i] + this->b[i];
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE9_ORDER5):
+          {
+            this->n_stages = 9;
+            a_subdiagonal  = {1107026461565. / 5417078080134.,
+                             38141181049399. / 41724347789894.,
+                             493273079041. / 11940823631197.,
+                             1851571280403. / 6147804934346.,
+                             11782306865191. / 62590030070788.,
+                             9452544825720. / 13648368537481.,
+                             4435885630781. / 26285702406235.,
+                             2357909744247. / 11371140753790.};
+            this->b        = {2274579626619. / 23610510767302.,
+                       693987741272. / 12394497428653.,
+                       -347131529483. / 15096185902911.,
+                       1144057200723. / 32081666971178.,
+                       1562491064753. / 11797114684756.,
+                       13113619727965. / 44346030145118.,
+                       393957816125. / 7825732611452.,
+                       720647959663. / 6565743875477.,
+                       3559252274877. / 14424734981077.};
+
+            break;
+          }
+        default:
+          {
+            AssertThrow(false,
+                        ExcMessage(
+                          "Unimplemented low-storage Runge-Kutta method."));
+          }
+      }
+
+    // Stage i is evaluated at r_i, which contains the weights b of all
+    // stages up to i-2 and the subdiagonal entry of stage i-1
+    this->c.resize(this->n_stages);
+    this->c[0]         = 0.;
+    double sum_weights = 0.;
+    for (unsigned int i = 1; i < this->n_stages; ++i)
+      {
+        this->c[i] = sum_weights + a_subdiagonal[i - 1];
+        sum_weights += this->b[i - 1];
+      }
+
+    // Also fill the a of the base class with the full Butcher tableau
+    this->a.resize(this->n_stages);
+    for (unsigned int i = 0; i < this->n_stages; ++i)
+      {
+        this->a[i].resize(i);
+        for (unsigned int j = 0; j + 1 < i; ++j)
+          this->a[i][j] = this->b[j];
+        if (i > 0)
+          this->a[i][i - 1] = a_subdiagonal[i - 1];
+      }
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      & /*id_minus_tau_J_inverse*/,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    VectorType vec_ri(y), vec_ki(y);
+    const std::function<void(const double, const VectorType &, VectorType &)>
+      f_in_place =
+        [&f](const double t, const VectorType &src, VectorType &dst) {
+          dst = f(t, src);
+        };
+    return evolve_one_time_step(f_in_place, t, delta_t, y, vec_ri, vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<void(const double, const VectorType &, VectorType &)>
+      &         f,
+    double      t,
+    double      delta_t,
+    VectorType &solution,
+    VectorType &vec_ri,
+    VectorType &vec_ki)
+  {
+    const std::function<void(const double,
+                             const double,
+                             const double,
+                             const VectorType &,
+                             VectorType &,
+                             VectorType &,
+                             VectorType &)>
+      stage_operator = [&f](const double      t,
+                            const double      factor_solution,
+                            const double      factor_ai,
+                            const VectorType &current_ri,
+                            VectorType &      vec_ki,
+                            VectorType &      solution,
+                            VectorType &      next_ri) {
+        f(t, current_ri, vec_ki);
+        internal::low_storage_stage_update(
+          factor_solution, factor_ai, vec_ki, solution, next_ri);
+      };
+    return evolve_one_time_step(
+      stage_operator, t, delta_t, solution, vec_ri, vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<void(const double      t,
+                             const double      factor_solution,
+                             const double      factor_ai,
+                             const VectorType &current_ri,
+                             VectorType &      vec_ki,
+                             VectorType &      solution,
+                             VectorType &      next_ri)> &stage_operator,
+    double                                             t,
+    double                                             delta_t,
+    VectorType &                                       solution,
+    VectorType &                                       vec_ri,
+    VectorType &                                       vec_ki)
+  {
+    Assert(status.method != invalid,
+           ExcMessage("The method has not been initialized."));
+    AssertDimension(a_subdiagonal.size() + 1, this->n_stages);
+
+    // The first stage is evaluated at the solution itself
+    stage_operator(t,
+                   this->b[0] * delta_t,
+                   this->n_stages > 1 ? a_subdiagonal[0] * delta_t : 0.,
+                   solution,
+                   vec_ki,
+                   solution,
+                   vec_ri);
+
+    for (unsigned int stage = 1; stage < this->n_stages; ++stage)
+      {
+        // There is no next stage vector in the last stage
+        const double factor_ai =
+          stage + 1 < this->n_stages ? a_subdiagonal[stage] * delta_t : 0.;
+        stage_operator(t + this->c[stage] * delta_t,
+                       this->b[stage] * delta_t,
+                       factor_ai,
+                       vec_ri,
+                       vec_ki,
+                       solution,
+                       vec_ri);
+      }
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::get_coefficients(
+    std::vector<double> &a,
+    std::vector<double> &b,
+    std::vector<double> &c) const
+  {
+    a = a_subdiagonal;
+    b = this->b;
+    c = this->c;
+  }
+
+
+
+  template <typename VectorType>
+  const typename LowStorageRungeKutta<VectorType>::Status &
+  LowStorageRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
   // ----------------------------------------------------------------------
   // ImplicitRungeKutta
   // ----------------------------------------------------------------------
@@ -444,6 +823,140 @@ namespace TimeStepping
   // EmbeddedExplicitRungeKutta
   // ----------------------------------------------------------------------
 
+  namespace internal
+  {
+    /**
+     * Compute y = old_y + delta_t * sum_i b1[i] f_stages[i] and return the
+     * l2 norm of the error estimate delta_t * sum_i (b2[i]-b1[i])
+     * f_stages[i]. This is the general implementation that stores the error
+     * estimate in the vector @p error, which is created in the first call.
+     */
+    template <typename VectorType>
+    double
+    embedded_final_update(const double                   delta_t,
+                          const std::vector<double> &    b1,
+                          const std::vector<double> &    b2,
+                          const std::vector<VectorType> &f_stages,
+                          const VectorType &             old_y,
+                          VectorType &                   y,
+                          std::unique_ptr<VectorType> &  error)
+    {
+      if (error == nullptr)
+        error = std::make_unique<VectorType>(y);
+      *error = 0.;
+      y      = old_y;
+      for (unsigned int i = 0; i < f_stages.size(); ++i)
+        {
+          y.sadd(1., delta_t * b1[i], f_stages[i]);
+          error->sadd(1., delta_t * (b2[i] - b1[i]), f_stages[i]);
+        }
+      return error->l2_norm();
+    }
+
+
+
+    /**
+     * Same as above on raw arrays of length @p size, computing the new
+     * solution and the square of the error norm in one sweep over the stages
+     * without storing the error estimate.
+     */
+    template <typename Number>
+    double
+    embedded_final_update_sqr(const double                       delta_t,
+                              const std::vector<double> &        b1,
+                              const std::vector<double> &        b2,
+                              const std::vector<const Number *> &f_stages,
+                              const std::size_t                  size,
+                              const Number *const                old_y,
+                              Number *const                      y)
+    {
+      const unsigned int  n_stages = f_stages.size();
+      std::vector<Number> weights_solution(n_stages);
+      std::vector<Number> weights_error(n_stages);
+      for (unsigned int s = 0; s < n_stages; ++s)
+        {
+          weights_solution[s] = delta_t * b1[s];
+          weights_error[s]    = delta_t * (b2[s] - b1[s]);
+        }
+
+      return parallel::accumulate_from_subranges<double>(
+        [&](const std::size_t begin, const std::size_t end) {
+          double error_sqr = 0.;
+          for (std::size_t i = begin; i < end; ++i)
+            {
+              Number u = old_y[i];
+              Number e = Number();
+              for (unsigned int s = 0; s < n_stages; ++s)
+                {
+                  const Number k = f_stages[s][i];
+                  u += weights_solution[s] * k;
+                  e += weights_error[s] * k;
+                }
+              y[i] = u;
+              error_sqr += e * e;
+            }
+          return error_sqr;
+        },
+        std::size_t(0),
+        size,
+        dealii::internal::VectorImplementation::minimum_parallel_grain_size);
+    }
+
+
+
+    template <typename Number>
+    double
+    embedded_final_update(const double                       delta_t,
+                          const std::vector<double> &        b1,
+                          const std::vector<double> &        b2,
+                          const std::vector<Vector<Number>> &f_stages,
+                          const Vector<Number> &             old_y,
+                          Vector<Number> &                   y,
+                          std::unique_ptr<Vector<Number>> & /*error*/)
+    {
+      std::vector<const Number *> stages(f_stages.size());
+      for (unsigned int s = 0; s < f_stages.size(); ++s)
+        {
+          AssertDimension(f_stages[s].size(), y.size());
+          stages[s] = f_stages[s].begin();
+        }
+      AssertDimension(old_y.size(), y.size());
+      return std::sqrt(embedded_final_update_sqr(
+        delta_t, b1, b2, stages, y.size(), old_y.begin(), y.begin()));
+    }
+
+
+
+    template <typename Number>
+    double
+    embedded_final_update(
+      const double                                                   delta_t,
+      const std::vector<double> &                                    b1,
+      const std::vector<double> &                                    b2,
+      const std::vector<LinearAlgebra::distributed::Vector<Number>> &f_stages,
+      const LinearAlgebra::distributed::Vector<Number> &             old_y,
+      LinearAlgebra::distributed::Vector<Number> &                   y,
+      std::unique_ptr<LinearAlgebra::distributed::Vector<Number>> & /*error*/)
+    {
+      std::vector<const Number *> stages(f_stages.size());
+      for (unsigned int s = 0; s < f_stages.size(); ++s)
+        {
+          AssertDimension(f_stages[s].local_size(), y.local_size());
+          stages[s] = f_stages[s].begin();
+        }
+      AssertDimension(old_y.local_size(), y.local_size());
+      // The ghost entries would not be consistent after the update
+      if (y.has_ghost_elements())
+        y.zero_out_ghosts();
+      const double local_error_sqr = embedded_final_update_sqr(
+        delta_t, b1, b2, stages, y.local_size(), old_y.begin(), y.begin());
+      return std::sqrt(
+        Utilities::MPI::sum(local_error_sqr, y.get_mpi_communicator()));
+    }
+  } // namespace internal
+
+
+
   template <typename VectorType>
   EmbeddedExplicitRungeKutta<VectorType>::EmbeddedExplicitRungeKutta(
     const runge_kutta_method method,
@@ -750,27 +1263,22 @@ namespace TimeStepping
     double                                                             delta_t,
     VectorType &                                                       y)
   {
-    bool                    done       = false;
-    unsigned int            count      = 0;
-    double                  error_norm = 0.;
-    VectorType              old_y(y);
-    VectorType              error(y);
-    std::vector<VectorType> f_stages(this->n_stages, y);
+    bool                        done       = false;
+    unsigned int                count      = 0;
+    double                      error_norm = 0.;
+    VectorType                  old_y(y);
+    std::unique_ptr<VectorType> error;
+    std::vector<VectorType>     f_stages(this->n_stages, y);
 
     while (!done)
       {
-        error = 0.;
-        y     = old_y;
         // Compute the different stages needed.
-        compute_stages(f, t, delta_t, y, f_stages);
-
-        for (unsigned int i = 0; i < this->n_stages; ++i)
-          {
-            y.sadd(1., delta_t * this->b1[i], f_stages[i]);
-            error.sadd(1., delta_t * (b2[i] - b1[i]), f_stages[i]);
-          }
+        compute_stages(f, t, delta_t, old_y, f_stages);
 
-        error_norm = error.l2_norm();
+        // Compute the new solution and the norm of the error estimate, in a
+        // single sweep over the stages for deal.II's own vectors
+        error_norm = internal::embedded_final_update(
+          delta_t, this->b1, b2, f_stages, old_y, y, error);
         // Check if the norm of error is less than the coarsening tolerance
         if (error_norm < coarsen_tol)
           {
@@ -855,6 +1363,22 @@ namespace TimeStepping
 
 
 
+  template <typename VectorType>
+  void
+  EmbeddedExplicitRungeKutta<VectorType>::get_coefficients(
+    std::vector<std::vector<double>> &a,
+    std::vector<double> &             b1,
+    std::vector<double> &             b2,
+    std::vector<double> &             c) const
+  {
+    a  = this->a;
+    b1 = this->b1;
+    b2 = this->b2;
+    c  = this->c;
+  }
+
+
+
   template <typename VectorType>
   const typename EmbeddedExplicitRungeKutta<VectorType>::Status &
   EmbeddedExplicitRungeKutta<VectorType>::get_status() const
@@ -894,6 +1418,202 @@ namespace TimeStepping
         f_stages[i] = f(t + this->c[i] * delta_t, Y);
       }
   }
+
+
+  // ----------------------------------------------------------------------
+  // EmbeddedExplicitRungeKuttaBatch
+  // ----------------------------------------------------------------------
+
+  template <typename Number>
+  EmbeddedExplicitRungeKuttaBatch<Number>::EmbeddedExplicitRungeKuttaBatch(
+    const runge_kutta_method method,
+    const double             coarsen_param,
+    const double             refine_param,
+    const double             min_delta,
+    const double             max_delta,
+    const double             refine_tol,
+    const double             coarsen_tol)
+    : coarsen_param(coarsen_param)
+    , refine_param(refine_param)
+    , min_delta_t(min_delta)
+    , max_delta_t(max_delta)
+    , refine_tol(refine_tol)
+    , coarsen_tol(coarsen_tol)
+    , status{}
+  {
+    initialize(method);
+  }
+
+
+
+  template <typename Number>
+  void
+  EmbeddedExplicitRungeKuttaBatch<Number>::initialize(
+    const runge_kutta_method method)
+  {
+    // Take the Butcher tableau from the method for a single system
+    const EmbeddedExplicitRungeKutta<Vector<Number>> scalar_method(method);
+    scalar_method.get_coefficients(a, b1, b2, c);
+    n_stages      = b1.size();
+    status.method = method;
+  }
+
+
+
+  template <typename Number>
+  void
+  EmbeddedExplicitRungeKuttaBatch<Number>::set_time_adaptation_parameters(
+    const double coarsen_param_,
+    const double refine_param_,
+    const double min_delta_,
+    const double max_delta_,
+    const double refine_tol_,
+    const double coarsen_tol_)
+  {
+    coarsen_param = coarsen_param_;
+    refine_param  = refine_param_;
+    min_delta_t   = min_delta_;
+    max_delta_t   = max_delta_;
+    refine_tol    = refine_tol_;
+    coarsen_tol   = coarsen_tol_;
+  }
+
+
+
+  template <typename Number>
+  typename EmbeddedExplicitRungeKuttaBatch<Number>::value_type
+  EmbeddedExplicitRungeKuttaBatch<Number>::evolve_one_time_step(
+    const std::function<void(const value_type &             t,
+                             const std::vector<value_type> &y,
+                             std::vector<value_type> &      f)> &f,
+    const value_type &                                           t,
+    const value_type &                                           delta_t,
+    std::vector<value_type> &                                    y)
+  {
+    constexpr unsigned int n_lanes = value_type::size();
+    const std::size_t      size    = y.size();
+
+    f_stages.resize(n_stages);
+    for (auto &stage : f_stages)
+      stage.resize(size);
+    old_y = y;
+    stage_y.resize(size);
+
+    std::array<bool, n_lanes> done;
+    done.fill(false);
+    unsigned int n_done = 0;
+    unsigned int count  = 0;
+    value_type   dt     = delta_t;
+    value_type   error_norm;
+    error_norm = 0.;
+
+    while (n_done < n_lanes)
+      {
+        // Compute the stages of all systems. The systems with an accepted
+        // time step are computed again with the same time step to keep the
+        // loops vectorized, but their result is not used anymore.
+        for (unsigned int i = 0; i < n_stages; ++i)
+          {
+            stage_y = old_y;
+            for (unsigned int j = 0; j < i; ++j)
+              {
+                const value_type factor = dt * Number(a[i][j]);
+                for (std::size_t k = 0; k < size; ++k)
+                  stage_y[k] += factor * f_stages[j][k];
+              }
+            f(t + Number(c[i]) * dt, stage_y, f_stages[i]);
+          }
+
+        // Compute the new solutions and the error norms in one sweep
+        std::vector<value_type> weights_solution(n_stages);
+        std::vector<value_type> weights_error(n_stages);
+        for (unsigned int s = 0; s < n_stages; ++s)
+          {
+            weights_solution[s] = dt * Number(b1[s]);
+            weights_error[s]    = dt * Number(b2[s] - b1[s]);
+          }
+        value_type error_sqr;
+        error_sqr = 0.;
+        for (std::size_t k = 0; k < size; ++k)
+          {
+            value_type u = old_y[k];
+            value_type e;
+            e = 0.;
+            for (unsigned int s = 0; s < n_stages; ++s)
+              {
+                u += weights_solution[s] * f_stages[s][k];
+                e += weights_error[s] * f_stages[s][k];
+              }
+            stage_y[k] = u;
+            error_sqr += e * e;
+          }
+        const value_type new_error_norm = std::sqrt(error_sqr);
+
+        // Decide on the time step of each system separately, with the same
+        // rules as in EmbeddedExplicitRungeKutta::evolve_one_time_step()
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          {
+            if (done[v])
+              continue;
+
+            bool accept = true;
+            if (new_error_norm[v] < coarsen_tol)
+              {
+                const double new_delta_t = dt[v] * coarsen_param;
+                if (new_delta_t > max_delta_t)
+                  {
+                    status.exit_delta_t[v]  = MAX_DELTA_T;
+                    status.delta_t_guess[v] = max_delta_t;
+                  }
+                else
+                  {
+                    status.exit_delta_t[v]  = DELTA_T;
+                    status.delta_t_guess[v] = new_delta_t;
+                  }
+              }
+            else if (new_error_norm[v] < refine_tol)
+              {
+                status.exit_delta_t[v]  = DELTA_T;
+                status.delta_t_guess[v] = dt[v];
+              }
+            else if (dt[v] == min_delta_t)
+              {
+                status.exit_delta_t[v]  = MIN_DELTA_T;
+                status.delta_t_guess[v] = dt[v];
+              }
+            else
+              {
+                accept = false;
+                dt[v]  = std::max<Number>(dt[v] * refine_param, min_delta_t);
+              }
+
+            if (accept)
+              {
+                done[v] = true;
+                ++n_done;
+                error_norm[v] = new_error_norm[v];
+                for (std::size_t k = 0; k < size; ++k)
+                  y[k][v] = stage_y[k][v];
+              }
+          }
+
+        ++count;
+      }
+
+    status.n_iterations = count;
+    status.error_norm   = error_norm;
+
+    return t + dt;
+  }
+
+
+
+  template <typename Number>
+  const typename EmbeddedExplicitRungeKuttaBatch<Number>::Status &
+  EmbeddedExplicitRungeKuttaBatch<Number>::get_status() const
+  {
+    return status;
+  }
 } // namespace TimeStepping
 
 DEAL_II_NAMESPACE_CLOSE
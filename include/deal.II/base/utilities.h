@@ -20,6 +20,7 @@
 
 #include <deal.II/base/exceptions.h>
 
+#include <cstring>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -570,6 +571,12 @@ namespace Utilities
    * If many consecutive calls with the same buffer are considered, it is
    * recommended for reasons of performance to ensure that its capacity is
    * sufficient.
+   *
+   * @note Objects of small trivially copyable types, as well as objects of
+   * type std::vector<T> and std::vector<std::vector<T>> where T is
+   * trivially copyable (e.g., a number type, a Point, or a Tensor of rank
+   * one), are not serialized but copied bit by bit into the buffer. For
+   * these types, the data is never compressed.
    */
   template <typename T>
   size_t
@@ -890,6 +897,19 @@ namespace Utilities
      */
     void
     posix_memalign(void **memptr, std::size_t alignment, std::size_t size);
+
+    /**
+     * Tell the operating system that the memory region of @p size bytes
+     * starting at @p ptr is a good candidate for being backed by huge pages,
+     * which reduces the pressure on the translation lookaside buffer when
+     * large arrays are traversed. On Linux, this calls
+     * <code>madvise(MADV_HUGEPAGE)</code> for transparent huge pages; on
+     * other systems, or if the kernel rejects the request, this function
+     * does nothing. The memory must have been allocated by the caller, e.g.
+     * via posix_memalign().
+     */
+    void
+    advise_huge_pages(void *ptr, std::size_t size);
   } // namespace System
 
 
@@ -1177,6 +1197,201 @@ namespace Utilities
 
   // --------------------- non-inline functions
 
+  namespace PackUnpackImplementation
+  {
+    /**
+     * A structure that is used to identify whether a template argument is a
+     * std::vector<T> (or a std::vector<std::vector<T>>) where T is a type
+     * that satisfies std::is_trivially_copyable<T>::value == true. Objects
+     * of such types can be packed by simply copying the bytes of the
+     * elements, without going through BOOST serialization.
+     */
+    template <typename T>
+    struct IsVectorOfTriviallyCopyable
+    {
+      static constexpr bool value = false;
+    };
+
+
+
+    template <typename T>
+    struct IsVectorOfTriviallyCopyable<std::vector<T>>
+    {
+      static constexpr bool value =
+        std::is_trivially_copyable<T>::value && !std::is_same<T, bool>::value;
+    };
+
+
+
+    template <typename T>
+    struct IsVectorOfTriviallyCopyable<std::vector<std::vector<T>>>
+    {
+      static constexpr bool value =
+        std::is_trivially_copyable<T>::value && !std::is_same<T, bool>::value;
+    };
+
+
+
+    /**
+     * A function that is used to append the contents of a std::vector<T>
+     * (where T is a type that satisfies IsVectorOfTriviallyCopyable<T>) bit
+     * for bit to a character array.
+     *
+     * If the type is not such a vector of T, then the function throws an
+     * exception.
+     */
+    template <typename T>
+    inline void
+    append_vector_of_trivially_copyable_to_buffer(const T &,
+                                                  std::vector<char> &)
+    {
+      // We shouldn't get here:
+      Assert(false, ExcInternalError());
+    }
+
+
+
+    template <typename T,
+              typename = typename std::enable_if<
+                !std::is_same<T, bool>::value &&
+                std::is_trivially_copyable<T>::value>::type>
+    inline void
+    append_vector_of_trivially_copyable_to_buffer(
+      const std::vector<T> &object,
+      std::vector<char> &   dest_buffer)
+    {
+      const auto current_position = dest_buffer.size();
+
+      dest_buffer.resize(dest_buffer.size() + object.size() * sizeof(T));
+      if (object.size() > 0)
+        std::memcpy(dest_buffer.data() + current_position,
+                    object.data(),
+                    object.size() * sizeof(T));
+    }
+
+
+
+    template <typename T,
+              typename = typename std::enable_if<
+                !std::is_same<T, bool>::value &&
+                std::is_trivially_copyable<T>::value>::type>
+    inline void
+    append_vector_of_trivially_copyable_to_buffer(
+      const std::vector<std::vector<T>> &object,
+      std::vector<char> &                dest_buffer)
+    {
+      // first store the number of vectors and their sizes, then their
+      // contents, one after the other
+      std::size_t total_size = 0;
+      for (const auto &a : object)
+        total_size += a.size();
+
+      const auto current_position = dest_buffer.size();
+      dest_buffer.resize(dest_buffer.size() +
+                         (object.size() + 1) * sizeof(std::size_t) +
+                         total_size * sizeof(T));
+
+      char *data = dest_buffer.data() + current_position;
+
+      const std::size_t n_vectors = object.size();
+      std::memcpy(data, &n_vectors, sizeof(std::size_t));
+      data += sizeof(std::size_t);
+
+      for (const auto &a : object)
+        {
+          const std::size_t size = a.size();
+          std::memcpy(data, &size, sizeof(std::size_t));
+          data += sizeof(std::size_t);
+        }
+
+      for (const auto &a : object)
+        if (a.size() > 0)
+          {
+            std::memcpy(data, a.data(), a.size() * sizeof(T));
+            data += a.size() * sizeof(T);
+          }
+    }
+
+
+
+    /**
+     * The inverse of the functions above: restore a vector of trivially
+     * copyable objects from the given range of characters.
+     *
+     * If the type is not such a vector of T, then the function throws an
+     * exception.
+     */
+    template <typename T>
+    inline void
+    create_vector_of_trivially_copyable_from_buffer(
+      const std::vector<char>::const_iterator &,
+      const std::vector<char>::const_iterator &,
+      T &)
+    {
+      // We shouldn't get here:
+      Assert(false, ExcInternalError());
+    }
+
+
+
+    template <typename T,
+              typename = typename std::enable_if<
+                !std::is_same<T, bool>::value &&
+                std::is_trivially_copyable<T>::value>::type>
+    inline void
+    create_vector_of_trivially_copyable_from_buffer(
+      const std::vector<char>::const_iterator &cbegin,
+      const std::vector<char>::const_iterator &cend,
+      std::vector<T> &                         object)
+    {
+      const std::size_t n_bytes = std::distance(cbegin, cend);
+      Assert(n_bytes % sizeof(T) == 0, ExcInternalError());
+
+      object.resize(n_bytes / sizeof(T));
+      if (n_bytes > 0)
+        std::memcpy(object.data(), &*cbegin, n_bytes);
+    }
+
+
+
+    template <typename T,
+              typename = typename std::enable_if<
+                !std::is_same<T, bool>::value &&
+                std::is_trivially_copyable<T>::value>::type>
+    inline void
+    create_vector_of_trivially_copyable_from_buffer(
+      const std::vector<char>::const_iterator &cbegin,
+      const std::vector<char>::const_iterator &cend,
+      std::vector<std::vector<T>> &            object)
+    {
+      (void)cend;
+      const char *data = &*cbegin;
+
+      std::size_t n_vectors;
+      std::memcpy(&n_vectors, data, sizeof(std::size_t));
+      data += sizeof(std::size_t);
+
+      object.resize(n_vectors);
+      std::vector<std::size_t> sizes(n_vectors);
+      if (n_vectors > 0)
+        std::memcpy(sizes.data(), data, n_vectors * sizeof(std::size_t));
+      data += n_vectors * sizeof(std::size_t);
+
+      for (std::size_t i = 0; i < n_vectors; ++i)
+        {
+          object[i].resize(sizes[i]);
+          if (sizes[i] > 0)
+            std::memcpy(object[i].data(), data, sizes[i] * sizeof(T));
+          data += sizes[i] * sizeof(T);
+        }
+
+      Assert(data == &*cbegin + std::distance(cbegin, cend),
+             ExcInternalError());
+    }
+  } // namespace PackUnpackImplementation
+
+
+
   template <typename T>
   size_t
   pack(const T &          object,
@@ -1212,6 +1427,16 @@ namespace Utilities
 
         size = sizeof(T);
       }
+    // see if the object is a vector of copyable objects. if so, copy the
+    // bytes of its elements in one go, rather than serializing each of them
+    // through a stream. this path does not compress the data.
+    else if (PackUnpackImplementation::IsVectorOfTriviallyCopyable<T>::value)
+      {
+        const std::size_t previous_size = dest_buffer.size();
+        PackUnpackImplementation::
+          append_vector_of_trivially_copyable_to_buffer(object, dest_buffer);
+        size = dest_buffer.size() - previous_size;
+      }
     else
       {
         // use buffer as the target of a compressing
@@ -1290,6 +1515,13 @@ namespace Utilities
         Assert(std::distance(cbegin, cend) == sizeof(T), ExcInternalError());
         std::memcpy(&object, &*cbegin, sizeof(T));
       }
+    // see if the object is a vector of copyable objects, which pack()
+    // stores as the bytes of its elements
+    else if (PackUnpackImplementation::IsVectorOfTriviallyCopyable<T>::value)
+      {
+        PackUnpackImplementation::
+          create_vector_of_trivially_copyable_from_buffer(cbegin, cend, object);
+      }
     else
       {
         std::string decompressed_buffer;
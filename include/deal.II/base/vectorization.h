@@ -69,6 +69,8 @@
 #    undef vector
 #    undef pixel
 #    undef bool
+#  elif defined(__ARM_NEON)
+#    include <arm_neon.h>
 #  else
 #    include <x86intrin.h>
 #  endif
@@ -370,6 +372,11 @@ public:
  *  - VectorizedArray<double, 1>
  *  - VectorizedArray<double, 2>
  *
+ * and for 64-bit ARM processors with NEON support (e.g. Cortex-A72,
+ * Neoverse N1/V1, A64FX):
+ *  - VectorizedArray<double, 1>
+ *  - VectorizedArray<double, 2> // NEON (default)
+ *
  * for older x86 processors or in case no processor-specific compilation flags
  * were added (i.e., without `-D CMAKE_CXX_FLAGS=-march=native` or similar
  * flags):
@@ -4603,6 +4610,899 @@ private:
          // defined(__VSX__)
 
 
+#  if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 && defined(__ARM_NEON) && \
+    defined(__aarch64__)
+
+/**
+ * Specialization for double and ARM NEON.
+ */
+template <>
+class VectorizedArray<double, 2>
+  : public VectorizedArrayBase<VectorizedArray<double, 2>, 2>
+{
+public:
+  /**
+   * This gives the type of the array elements.
+   */
+  using value_type = double;
+
+  /**
+   * This gives the number of vectors collected in this class.
+   *
+   * @deprecated Use VectorizedArrayBase::size() instead.
+   */
+  DEAL_II_DEPRECATED static const unsigned int n_array_elements = 2;
+
+  /**
+   * Default empty constructor, leaving the data in an uninitialized state
+   * similar to float/double.
+   */
+  VectorizedArray() = default;
+
+  /**
+   * Construct an array with the given scalar broadcast to all lanes.
+   */
+  VectorizedArray(const double scalar)
+  {
+    this->operator=(scalar);
+  }
+
+  /**
+   * This function can be used to set all data fields to a given scalar.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator=(const double x)
+  {
+    data = vdupq_n_f64(x);
+    return *this;
+  }
+
+  /**
+   * Access operator. The component must be either 0 or 1.
+   */
+  DEAL_II_ALWAYS_INLINE
+  double &operator[](const unsigned int comp)
+  {
+    AssertIndexRange(comp, 2);
+    return *(reinterpret_cast<double *>(&data) + comp);
+  }
+
+  /**
+   * Constant access operator.
+   */
+  DEAL_II_ALWAYS_INLINE
+  const double &operator[](const unsigned int comp) const
+  {
+    AssertIndexRange(comp, 2);
+    return *(reinterpret_cast<const double *>(&data) + comp);
+  }
+
+  /**
+   * Addition.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator+=(const VectorizedArray &vec)
+  {
+    data = vaddq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Subtraction.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator-=(const VectorizedArray &vec)
+  {
+    data = vsubq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Multiplication.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator*=(const VectorizedArray &vec)
+  {
+    data = vmulq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Division.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator/=(const VectorizedArray &vec)
+  {
+    data = vdivq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Load @p size() from memory into the calling class, starting at
+   * the given address. The memory need not be aligned by 16 bytes, as opposed
+   * to casting a double address to VectorizedArray<double>*.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    data = vld1q_f64(ptr);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * size() to the given address. The memory need not be aligned by
+   * 16 bytes, as opposed to casting a double address to
+   * VectorizedArray<double>*.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    vst1q_f64(ptr, data);
+  }
+
+  /** @copydoc VectorizedArray<Number>::streaming_store()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  streaming_store(double *ptr) const
+  {
+    store(ptr);
+  }
+
+  /**
+   * Load @p size() from memory into the calling class, starting at
+   * the given address and with given offsets, each entry from the offset
+   * providing one element of the vectorized array.
+   *
+   * This operation corresponds to the following code (but uses a more
+   * efficient implementation in case the vector class allows for that):
+   * @code
+   * for (unsigned int v=0; v<VectorizedArray<Number>::size(); ++v)
+   *   this->operator[](v) = base_ptr[offsets[v]];
+   * @endcode
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  gather(const double *base_ptr, const unsigned int *offsets)
+  {
+    // NEON has no gather instruction, so build the vector from lanes
+    data = vld1q_dup_f64(base_ptr + offsets[0]);
+    data = vld1q_lane_f64(base_ptr + offsets[1], data, 1);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * size() to the given address and the given offsets, filling the
+   * elements of the vectorized array into each offset.
+   *
+   * This operation corresponds to the following code (but uses a more
+   * efficient implementation in case the vector class allows for that):
+   * @code
+   * for (unsigned int v=0; v<VectorizedArray<Number>::size(); ++v)
+   *   base_ptr[offsets[v]] = this->operator[](v);
+   * @endcode
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  scatter(const unsigned int *offsets, double *base_ptr) const
+  {
+    vst1q_lane_f64(base_ptr + offsets[0], data, 0);
+    vst1q_lane_f64(base_ptr + offsets[1], data, 1);
+  }
+
+  /**
+   * Actual data field. To be consistent with the standard layout type and to
+   * enable interaction with external SIMD functionality, this member is
+   * declared public.
+   */
+  float64x2_t data;
+
+private:
+  /**
+   * Return the square root of this field. Not for use in user code. Use
+   * sqrt(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_sqrt() const
+  {
+    VectorizedArray res;
+    res.data = vsqrtq_f64(data);
+    return res;
+  }
+
+  /**
+   * Return the absolute value of this field. Not for use in user code. Use
+   * abs(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_abs() const
+  {
+    VectorizedArray res;
+    res.data = vabsq_f64(data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise maximum of this field and another one. Not for
+   * use in user code. Use max(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_max(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vmaxq_f64(data, other.data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise minimum of this field and another one. Not for
+   * use in user code. Use min(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_min(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vminq_f64(data, other.data);
+    return res;
+  }
+
+  // Make a few functions friends.
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::sqrt(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::abs(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::max(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::min(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+};
+
+
+
+/**
+ * Specialization for double and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int          n_entries,
+                              const double *              in,
+                              const unsigned int *        offsets,
+                              VectorizedArray<double, 2> *out)
+{
+  const unsigned int n_chunks = n_entries / 2;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      const float64x2_t u0 = vld1q_f64(in + 2 * i + offsets[0]);
+      const float64x2_t u1 = vld1q_f64(in + 2 * i + offsets[1]);
+      out[2 * i + 0].data  = vzip1q_f64(u0, u1);
+      out[2 * i + 1].data  = vzip2q_f64(u0, u1);
+    }
+
+  // remainder loop of work that does not divide by 2
+  for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 2; ++v)
+      out[i][v] = in[offsets[v] + i];
+}
+
+
+
+/**
+ * Specialization for double and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int             n_entries,
+                              const std::array<double *, 2> &in,
+                              VectorizedArray<double, 2> *   out)
+{
+  // see the comments in the vectorized_load_and_transpose above
+
+  const unsigned int n_chunks = n_entries / 2;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      const float64x2_t u0 = vld1q_f64(in[0] + 2 * i);
+      const float64x2_t u1 = vld1q_f64(in[1] + 2 * i);
+      out[2 * i + 0].data  = vzip1q_f64(u0, u1);
+      out[2 * i + 1].data  = vzip2q_f64(u0, u1);
+    }
+
+  for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 2; ++v)
+      out[i][v] = in[v][i];
+}
+
+
+
+/**
+ * Specialization for double and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                        add_into,
+                               const unsigned int                n_entries,
+                               const VectorizedArray<double, 2> *in,
+                               const unsigned int *              offsets,
+                               double *                          out)
+{
+  const unsigned int n_chunks = n_entries / 2;
+  if (add_into)
+    {
+      for (unsigned int i = 0; i < n_chunks; ++i)
+        {
+          const float64x2_t u0   = in[2 * i + 0].data;
+          const float64x2_t u1   = in[2 * i + 1].data;
+          const float64x2_t res0 = vzip1q_f64(u0, u1);
+          const float64x2_t res1 = vzip2q_f64(u0, u1);
+          vst1q_f64(out + 2 * i + offsets[0],
+                    vaddq_f64(vld1q_f64(out + 2 * i + offsets[0]), res0));
+          vst1q_f64(out + 2 * i + offsets[1],
+                    vaddq_f64(vld1q_f64(out + 2 * i + offsets[1]), res1));
+        }
+      // remainder loop of work that does not divide by 2
+      for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+        for (unsigned int v = 0; v < 2; ++v)
+          out[offsets[v] + i] += in[i][v];
+    }
+  else
+    {
+      for (unsigned int i = 0; i < n_chunks; ++i)
+        {
+          const float64x2_t u0   = in[2 * i + 0].data;
+          const float64x2_t u1   = in[2 * i + 1].data;
+          const float64x2_t res0 = vzip1q_f64(u0, u1);
+          const float64x2_t res1 = vzip2q_f64(u0, u1);
+          vst1q_f64(out + 2 * i + offsets[0], res0);
+          vst1q_f64(out + 2 * i + offsets[1], res1);
+        }
+      // remainder loop of work that does not divide by 2
+      for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+        for (unsigned int v = 0; v < 2; ++v)
+          out[offsets[v] + i] = in[i][v];
+    }
+}
+
+
+
+/**
+ * Specialization for double and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                        add_into,
+                               const unsigned int                n_entries,
+                               const VectorizedArray<double, 2> *in,
+                               std::array<double *, 2> &         out)
+{
+  // see the comments in the vectorized_transpose_and_store above
+
+  const unsigned int n_chunks = n_entries / 2;
+  if (add_into)
+    {
+      for (unsigned int i = 0; i < n_chunks; ++i)
+        {
+          const float64x2_t u0   = in[2 * i + 0].data;
+          const float64x2_t u1   = in[2 * i + 1].data;
+          const float64x2_t res0 = vzip1q_f64(u0, u1);
+          const float64x2_t res1 = vzip2q_f64(u0, u1);
+          vst1q_f64(out[0] + 2 * i,
+                    vaddq_f64(vld1q_f64(out[0] + 2 * i), res0));
+          vst1q_f64(out[1] + 2 * i,
+                    vaddq_f64(vld1q_f64(out[1] + 2 * i), res1));
+        }
+
+      for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+        for (unsigned int v = 0; v < 2; ++v)
+          out[v][i] += in[i][v];
+    }
+  else
+    {
+      for (unsigned int i = 0; i < n_chunks; ++i)
+        {
+          const float64x2_t u0   = in[2 * i + 0].data;
+          const float64x2_t u1   = in[2 * i + 1].data;
+          const float64x2_t res0 = vzip1q_f64(u0, u1);
+          const float64x2_t res1 = vzip2q_f64(u0, u1);
+          vst1q_f64(out[0] + 2 * i, res0);
+          vst1q_f64(out[1] + 2 * i, res1);
+        }
+
+      for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+        for (unsigned int v = 0; v < 2; ++v)
+          out[v][i] = in[i][v];
+    }
+}
+
+
+
+/**
+ * Specialization for float and ARM NEON.
+ */
+template <>
+class VectorizedArray<float, 4>
+  : public VectorizedArrayBase<VectorizedArray<float, 4>, 4>
+{
+public:
+  /**
+   * This gives the type of the array elements.
+   */
+  using value_type = float;
+
+  /**
+   * This gives the number of vectors collected in this class.
+   *
+   * @deprecated Use VectorizedArrayBase::size() instead.
+   */
+  DEAL_II_DEPRECATED static const unsigned int n_array_elements = 4;
+
+  /**
+   * Default empty constructor, leaving the data in an uninitialized state
+   * similar to float/double.
+   */
+  VectorizedArray() = default;
+
+  /**
+   * Construct an array with the given scalar broadcast to all lanes.
+   */
+  VectorizedArray(const float scalar)
+  {
+    this->operator=(scalar);
+  }
+
+  /**
+   * This function can be used to set all data fields to a given scalar.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator=(const float x)
+  {
+    data = vdupq_n_f32(x);
+    return *this;
+  }
+
+  /**
+   * Access operator. The component must be between 0 and 3.
+   */
+  DEAL_II_ALWAYS_INLINE
+  float &operator[](const unsigned int comp)
+  {
+    AssertIndexRange(comp, 4);
+    return *(reinterpret_cast<float *>(&data) + comp);
+  }
+
+  /**
+   * Constant access operator.
+   */
+  DEAL_II_ALWAYS_INLINE
+  const float &operator[](const unsigned int comp) const
+  {
+    AssertIndexRange(comp, 4);
+    return *(reinterpret_cast<const float *>(&data) + comp);
+  }
+
+  /**
+   * Addition.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator+=(const VectorizedArray &vec)
+  {
+    data = vaddq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Subtraction.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator-=(const VectorizedArray &vec)
+  {
+    data = vsubq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Multiplication.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator*=(const VectorizedArray &vec)
+  {
+    data = vmulq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Division.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator/=(const VectorizedArray &vec)
+  {
+    data = vdivq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Load @p size() from memory into the calling class, starting at
+   * the given address. The memory need not be aligned by 16 bytes, as opposed
+   * to casting a float address to VectorizedArray<float>*.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const float *ptr)
+  {
+    data = vld1q_f32(ptr);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * size() to the given address. The memory need not be aligned by
+   * 16 bytes, as opposed to casting a float address to
+   * VectorizedArray<float>*.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(float *ptr) const
+  {
+    vst1q_f32(ptr, data);
+  }
+
+  /** @copydoc VectorizedArray<Number>::streaming_store()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  streaming_store(float *ptr) const
+  {
+    store(ptr);
+  }
+
+  /**
+   * Load @p size() from memory into the calling class, starting at
+   * the given address and with given offsets, each entry from the offset
+   * providing one element of the vectorized array.
+   *
+   * This operation corresponds to the following code (but uses a more
+   * efficient implementation in case the vector class allows for that):
+   * @code
+   * for (unsigned int v=0; v<VectorizedArray<Number>::size(); ++v)
+   *   this->operator[](v) = base_ptr[offsets[v]];
+   * @endcode
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  gather(const float *base_ptr, const unsigned int *offsets)
+  {
+    // NEON has no gather instruction, so build the vector from lanes
+    data = vld1q_dup_f32(base_ptr + offsets[0]);
+    data = vld1q_lane_f32(base_ptr + offsets[1], data, 1);
+    data = vld1q_lane_f32(base_ptr + offsets[2], data, 2);
+    data = vld1q_lane_f32(base_ptr + offsets[3], data, 3);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * size() to the given address and the given offsets, filling the
+   * elements of the vectorized array into each offset.
+   *
+   * This operation corresponds to the following code (but uses a more
+   * efficient implementation in case the vector class allows for that):
+   * @code
+   * for (unsigned int v=0; v<VectorizedArray<Number>::size(); ++v)
+   *   base_ptr[offsets[v]] = this->operator[](v);
+   * @endcode
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  scatter(const unsigned int *offsets, float *base_ptr) const
+  {
+    vst1q_lane_f32(base_ptr + offsets[0], data, 0);
+    vst1q_lane_f32(base_ptr + offsets[1], data, 1);
+    vst1q_lane_f32(base_ptr + offsets[2], data, 2);
+    vst1q_lane_f32(base_ptr + offsets[3], data, 3);
+  }
+
+  /**
+   * Actual data field. To be consistent with the standard layout type and to
+   * enable interaction with external SIMD functionality, this member is
+   * declared public.
+   */
+  float32x4_t data;
+
+private:
+  /**
+   * Return the square root of this field. Not for use in user code. Use
+   * sqrt(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_sqrt() const
+  {
+    VectorizedArray res;
+    res.data = vsqrtq_f32(data);
+    return res;
+  }
+
+  /**
+   * Return the absolute value of this field. Not for use in user code. Use
+   * abs(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_abs() const
+  {
+    VectorizedArray res;
+    res.data = vabsq_f32(data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise maximum of this field and another one. Not for
+   * use in user code. Use max(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_max(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vmaxq_f32(data, other.data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise minimum of this field and another one. Not for
+   * use in user code. Use min(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_min(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vminq_f32(data, other.data);
+    return res;
+  }
+
+  // Make a few functions friends.
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::sqrt(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::abs(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::max(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::min(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+};
+
+
+
+namespace internal
+{
+  /**
+   * Transpose four NEON float vectors in place, i.e., treat them as the rows
+   * of a 4x4 matrix. This operation is its own inverse and is used both for
+   * loading and for storing.
+   */
+  inline DEAL_II_ALWAYS_INLINE void
+  transpose_neon_float4(float32x4_t &u0,
+                        float32x4_t &u1,
+                        float32x4_t &u2,
+                        float32x4_t &u3)
+  {
+    const float32x4_t t0 = vtrn1q_f32(u0, u1);
+    const float32x4_t t1 = vtrn2q_f32(u0, u1);
+    const float32x4_t t2 = vtrn1q_f32(u2, u3);
+    const float32x4_t t3 = vtrn2q_f32(u2, u3);
+    u0                   = vreinterpretq_f32_f64(
+      vtrn1q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+    u1 = vreinterpretq_f32_f64(
+      vtrn1q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+    u2 = vreinterpretq_f32_f64(
+      vtrn2q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+    u3 = vreinterpretq_f32_f64(
+      vtrn2q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+  }
+} // namespace internal
+
+
+
+/**
+ * Specialization for float and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int         n_entries,
+                              const float *              in,
+                              const unsigned int *       offsets,
+                              VectorizedArray<float, 4> *out)
+{
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = vld1q_f32(in + 4 * i + offsets[0]);
+      float32x4_t u1 = vld1q_f32(in + 4 * i + offsets[1]);
+      float32x4_t u2 = vld1q_f32(in + 4 * i + offsets[2]);
+      float32x4_t u3 = vld1q_f32(in + 4 * i + offsets[3]);
+      internal::transpose_neon_float4(u0, u1, u2, u3);
+      out[4 * i + 0].data = u0;
+      out[4 * i + 1].data = u1;
+      out[4 * i + 2].data = u2;
+      out[4 * i + 3].data = u3;
+    }
+
+  // remainder loop of work that does not divide by 4
+  for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 4; ++v)
+      out[i][v] = in[offsets[v] + i];
+}
+
+
+
+/**
+ * Specialization for float and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int            n_entries,
+                              const std::array<float *, 4> &in,
+                              VectorizedArray<float, 4> *   out)
+{
+  // see the comments in the vectorized_load_and_transpose above
+
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = vld1q_f32(in[0] + 4 * i);
+      float32x4_t u1 = vld1q_f32(in[1] + 4 * i);
+      float32x4_t u2 = vld1q_f32(in[2] + 4 * i);
+      float32x4_t u3 = vld1q_f32(in[3] + 4 * i);
+      internal::transpose_neon_float4(u0, u1, u2, u3);
+      out[4 * i + 0].data = u0;
+      out[4 * i + 1].data = u1;
+      out[4 * i + 2].data = u2;
+      out[4 * i + 3].data = u3;
+    }
+
+  for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 4; ++v)
+      out[i][v] = in[v][i];
+}
+
+
+
+/**
+ * Specialization for float and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                       add_into,
+                               const unsigned int               n_entries,
+                               const VectorizedArray<float, 4> *in,
+                               const unsigned int *             offsets,
+                               float *                          out)
+{
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = in[4 * i + 0].data;
+      float32x4_t u1 = in[4 * i + 1].data;
+      float32x4_t u2 = in[4 * i + 2].data;
+      float32x4_t u3 = in[4 * i + 3].data;
+      internal::transpose_neon_float4(u0, u1, u2, u3);
+
+      // Cannot use the same store instructions in both paths of the 'if'
+      // because the compiler cannot know that there is no aliasing between
+      // pointers
+      if (add_into)
+        {
+          u0 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[0]), u0);
+          vst1q_f32(out + 4 * i + offsets[0], u0);
+          u1 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[1]), u1);
+          vst1q_f32(out + 4 * i + offsets[1], u1);
+          u2 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[2]), u2);
+          vst1q_f32(out + 4 * i + offsets[2], u2);
+          u3 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[3]), u3);
+          vst1q_f32(out + 4 * i + offsets[3], u3);
+        }
+      else
+        {
+          vst1q_f32(out + 4 * i + offsets[0], u0);
+          vst1q_f32(out + 4 * i + offsets[1], u1);
+          vst1q_f32(out + 4 * i + offsets[2], u2);
+          vst1q_f32(out + 4 * i + offsets[3], u3);
+        }
+    }
+
+  // remainder loop of work that does not divide by 4
+  if (add_into)
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[offsets[v] + i] += in[i][v];
+  else
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[offsets[v] + i] = in[i][v];
+}
+
+
+
+/**
+ * Specialization for float and ARM NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                       add_into,
+                               const unsigned int               n_entries,
+                               const VectorizedArray<float, 4> *in,
+                               std::array<float *, 4> &         out)
+{
+  // see the comments in the vectorized_transpose_and_store above
+
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = in[4 * i + 0].data;
+      float32x4_t u1 = in[4 * i + 1].data;
+      float32x4_t u2 = in[4 * i + 2].data;
+      float32x4_t u3 = in[4 * i + 3].data;
+      internal::transpose_neon_float4(u0, u1, u2, u3);
+
+      if (add_into)
+        {
+          u0 = vaddq_f32(vld1q_f32(out[0] + 4 * i), u0);
+          vst1q_f32(out[0] + 4 * i, u0);
+          u1 = vaddq_f32(vld1q_f32(out[1] + 4 * i), u1);
+          vst1q_f32(out[1] + 4 * i, u1);
+          u2 = vaddq_f32(vld1q_f32(out[2] + 4 * i), u2);
+          vst1q_f32(out[2] + 4 * i, u2);
+          u3 = vaddq_f32(vld1q_f32(out[3] + 4 * i), u3);
+          vst1q_f32(out[3] + 4 * i, u3);
+        }
+      else
+        {
+          vst1q_f32(out[0] + 4 * i, u0);
+          vst1q_f32(out[1] + 4 * i, u1);
+          vst1q_f32(out[2] + 4 * i, u2);
+          vst1q_f32(out[3] + 4 * i, u3);
+        }
+    }
+
+  if (add_into)
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[v][i] += in[i][v];
+  else
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[v][i] = in[i][v];
+}
+
+#  endif // if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 &&
+         // defined(__ARM_NEON) && defined(__aarch64__)
+
+
 #endif // DOXYGEN
 
 /**
@@ -26,14 +26,17 @@
 #  include <deal.II/base/template_constraints.h>
 #  include <deal.II/base/thread_local_storage.h>
 #  include <deal.II/base/thread_management.h>
+#  include <deal.II/base/types.h>
 
 #  ifdef DEAL_II_WITH_TBB
 #    include <tbb/pipeline.h>
 #  endif
 
+#  include <algorithm>
 #  include <functional>
 #  include <iterator>
 #  include <memory>
+#  include <mutex>
 #  include <utility>
 #  include <vector>
 
@@ -1224,20 +1227,22 @@ namespace WorkStream
 #  ifdef DEAL_II_WITH_TBB
     else // have TBB and use more than one thread
       {
+        using WorkerAndCopier = internal::Implementation3::
+          WorkerAndCopier<Iterator, ScratchData, CopyData>;
+
+        // create the object holding the thread-local scratch and copy data
+        // objects only once, so that the objects created on (and first
+        // touched by) a worker thread are reused for all colors rather than
+        // being re-allocated for each color
+        WorkerAndCopier worker_and_copier(worker,
+                                          copier,
+                                          sample_scratch_data,
+                                          sample_copy_data);
+
         // loop over the various colors of what we're given
         for (unsigned int color = 0; color < colored_iterators.size(); ++color)
           if (colored_iterators[color].size() > 0)
             {
-              using WorkerAndCopier = internal::Implementation3::
-                WorkerAndCopier<Iterator, ScratchData, CopyData>;
-
-              using RangeType = typename std::vector<Iterator>::const_iterator;
-
-              WorkerAndCopier worker_and_copier(worker,
-                                                copier,
-                                                sample_scratch_data,
-                                                sample_copy_data);
-
               parallel::internal::parallel_for(
                 colored_iterators[color].begin(),
                 colored_iterators[color].end(),
@@ -1431,6 +1436,204 @@ namespace WorkStream
         chunk_size);
   }
 
+
+
+  /**
+   * A variant of the run() functions for copiers that can safely be called
+   * concurrently from several threads, for example because they protect
+   * their writes into the global objects by an IndexRangeLocks object.
+   * Worker and copier are then called one after the other on the same
+   * thread for each element of the range [@p begin, @p end), and no serial
+   * copier stage that might become a bottleneck on machines with many cores
+   * is needed. Contrary to the run() function operating on colored
+   * iterators, no graph coloring is required either.
+   *
+   * The @p chunk_size argument indicates the number of elements that are
+   * worked on by the same thread one after the other. The scratch and copy
+   * data objects are created on the worker threads and reused for all
+   * chunks a thread works on.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run_with_thread_safe_copier(const Iterator &                         begin,
+                              const typename identity<Iterator>::type &end,
+                              Worker                                   worker,
+                              Copier                                   copier,
+                              const ScratchData &sample_scratch_data,
+                              const CopyData &   sample_copy_data,
+                              const unsigned int chunk_size = 8)
+  {
+    // the colored version of run() calls worker and copier on the same
+    // thread, so a single color is all we need
+    std::vector<std::vector<Iterator>> all_iterators(1);
+    for (Iterator p = begin; p != end; ++p)
+      all_iterators[0].push_back(p);
+
+    run(all_iterators,
+        worker,
+        copier,
+        sample_scratch_data,
+        sample_copy_data,
+        2 * MultithreadInfo::n_threads(),
+        chunk_size);
+  }
+
+
+
+  /**
+   * Same as the function above, but for deal.II's IteratorRange.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run_with_thread_safe_copier(const IteratorRange<Iterator> &iterator_range,
+                              Worker                         worker,
+                              Copier                         copier,
+                              const ScratchData &sample_scratch_data,
+                              const CopyData &   sample_copy_data,
+                              const unsigned int chunk_size = 8)
+  {
+    run_with_thread_safe_copier(iterator_range.begin(),
+                                iterator_range.end(),
+                                worker,
+                                copier,
+                                sample_scratch_data,
+                                sample_copy_data,
+                                chunk_size);
+  }
+
+
+
+  /**
+   * A set of locks protecting contiguous ranges of the index space of a
+   * global object, e.g., the rows of a matrix and the entries of a vector,
+   * for use in copiers passed to run_with_thread_safe_copier(). The index
+   * space is split into a fixed number of ranges of equal size, each
+   * protected by its own mutex. A copier locks all ranges touched by its
+   * local contribution by creating a Guard object, which acquires the locks
+   * in ascending order to avoid deadlocks, and releases them upon
+   * destruction:
+   * @code
+   * WorkStream::IndexRangeLocks locks(dof_handler.n_dofs());
+   * WorkStream::run_with_thread_safe_copier(
+   *   dof_handler.begin_active(),
+   *   dof_handler.end(),
+   *   worker,
+   *   [&](const CopyData &copy_data) {
+   *     WorkStream::IndexRangeLocks::Guard guard(locks,
+   *                                              copy_data.local_dof_indices);
+   *     for (unsigned int i = 0; i < copy_data.local_dof_indices.size(); ++i)
+   *       for (unsigned int j = 0; j < copy_data.local_dof_indices.size(); ++j)
+   *         system_matrix.add(copy_data.local_dof_indices[i],
+   *                           copy_data.local_dof_indices[j],
+   *                           copy_data.cell_matrix(i, j));
+   *   },
+   *   scratch_data,
+   *   copy_data);
+   * @endcode
+   * Since cells only share a small number of indices and the number of
+   * ranges is chosen much larger than the number of threads, contention is
+   * low. Note that the guard must cover all indices written by the copier;
+   * if local contributions are distributed via
+   * AffineConstraints::distribute_local_to_global(), this includes the
+   * indices that constrained degrees of freedom are resolved into.
+   */
+  class IndexRangeLocks
+  {
+  public:
+    /**
+     * Constructor. Split the index space [0, @p n_indices) into
+     * @p n_ranges ranges.
+     */
+    IndexRangeLocks(const types::global_dof_index n_indices,
+                    const unsigned int            n_ranges = 0)
+      : range_size(
+          std::max<types::global_dof_index>(
+            (n_indices + get_n_ranges(n_ranges) - 1) / get_n_ranges(n_ranges),
+            1))
+      , mutexes(get_n_ranges(n_ranges))
+    {}
+
+    /**
+     * An object that holds the locks of all ranges touched by a set of
+     * indices for the duration of its lifetime.
+     */
+    class Guard
+    {
+    public:
+      /**
+       * Constructor. Acquire the locks of all ranges that contain at least
+       * one of the given @p indices.
+       */
+      Guard(IndexRangeLocks &                           locks,
+            const std::vector<types::global_dof_index> &indices)
+        : locks(locks)
+      {
+        locked_ranges.reserve(indices.size());
+        for (const types::global_dof_index index : indices)
+          locked_ranges.push_back(index / locks.range_size);
+        std::sort(locked_ranges.begin(), locked_ranges.end());
+        locked_ranges.erase(std::unique(locked_ranges.begin(),
+                                        locked_ranges.end()),
+                            locked_ranges.end());
+        for (const types::global_dof_index range : locked_ranges)
+          {
+            AssertIndexRange(range, locks.mutexes.size());
+            locks.mutexes[range].lock();
+          }
+      }
+
+      /**
+       * Destructor. Release the locks in reverse order.
+       */
+      ~Guard()
+      {
+        for (auto range = locked_ranges.rbegin(); range != locked_ranges.rend();
+             ++range)
+          locks.mutexes[*range].unlock();
+      }
+
+    private:
+      /**
+       * The object holding the mutexes.
+       */
+      IndexRangeLocks &locks;
+
+      /**
+       * The sorted list of ranges locked by this object.
+       */
+      std::vector<types::global_dof_index> locked_ranges;
+    };
+
+  private:
+    /**
+     * Return the number of ranges to use, with a default of 64 ranges per
+     * thread if @p n_ranges is zero.
+     */
+    static unsigned int
+    get_n_ranges(const unsigned int n_ranges)
+    {
+      return n_ranges > 0 ? n_ranges : 64 * MultithreadInfo::n_threads();
+    }
+
+    /**
+     * The number of indices per range.
+     */
+    const types::global_dof_index range_size;
+
+    /**
+     * One mutex per range.
+     */
+    std::vector<std::mutex> mutexes;
+  };
+
 } // namespace WorkStream
 
 
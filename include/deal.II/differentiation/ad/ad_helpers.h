@@ -22,7 +22,9 @@
 
 #  include <deal.II/base/numbers.h>
 #  include <deal.II/base/symmetric_tensor.h>
+#  include <deal.II/base/table.h>
 #  include <deal.II/base/tensor.h>
+#  include <deal.II/base/vectorization.h>
 
 #  include <deal.II/differentiation/ad/ad_drivers.h>
 #  include <deal.II/differentiation/ad/ad_number_traits.h>
@@ -37,6 +39,7 @@
 #  include <deal.II/lac/vector.h>
 
 #  include <algorithm>
+#  include <functional>
 #  include <iostream>
 #  include <iterator>
 #  include <numeric>
@@ -3299,6 +3302,88 @@ namespace Differentiation
 
       //@}
 
+      /**
+       * @name Batched evaluation
+       */
+      //@{
+
+      /**
+       * Evaluate the scalar field $\Psi(\mathbf{X})$ defined by @p function,
+       * and optionally its gradient and Hessian, at a batch of points whose
+       * independent variables are given lane-wise in @p independent_values,
+       * e.g., at all quadrature points of a batch of cells processed by
+       * FEEvaluation.
+       *
+       * For taped AD numbers, the operations of @p function are recorded on
+       * the tape @p tape_index only if that tape does not exist yet, and the
+       * tape is then reevaluated for all lanes. The tape is only recorded
+       * again at a lane if the tape reports that the recorded branch of the
+       * operations cannot be used for the independent variables of that lane,
+       * see active_tape_requires_retaping(). A tape can therefore be shared
+       * by all points at which the energy has the same structure, e.g., all
+       * quadrature points of the same material, without being recorded per
+       * point. For tapeless AD numbers, @p function is evaluated for each
+       * lane, and @p tape_index is ignored.
+       *
+       * @param[in] tape_index The tape that the operations of @p function are
+       * recorded to and reevaluated from.
+       * @param[in] function The definition of the scalar field in terms of
+       * the independent variables.
+       * @param[in] independent_values The values of the independent variables
+       * of all lanes, with length @p n_independent_variables.
+       * @param[out] value The value of the scalar field in each lane.
+       * @param[out] gradient The gradient of the scalar field in each lane,
+       * only computed if @p n_derivative_levels is at least one.
+       * @param[out] hessian The Hessian of the scalar field in each lane, only
+       * computed if @p n_derivative_levels is two.
+       * @param[in] n_derivative_levels The order of the derivatives to
+       * compute.
+       * @param[in] n_filled_lanes The number of lanes that hold valid
+       * independent variables. The output in the remaining lanes is not
+       * touched.
+       *
+       * The output objects are only resized if their size does not match, so
+       * that no memory is allocated if the same objects are passed for every
+       * batch. The same holds for the internal storage of this class used to
+       * evaluate a single lane.
+       *
+       * @note Since the independent variables are registered through
+       * register_independent_variables(), none of them is treated as the
+       * component of a symmetric tensor, and any symmetry of the independent
+       * variables set up before is reset by this function.
+       */
+      template <std::size_t width>
+      void
+      compute_vectorized(
+        const typename Types<ad_type>::tape_index                   tape_index,
+        const std::function<ad_type(const std::vector<ad_type> &)> &function,
+        const std::vector<VectorizedArray<scalar_type, width>>
+          &                                               independent_values,
+        VectorizedArray<scalar_type, width> &             value,
+        std::vector<VectorizedArray<scalar_type, width>> &gradient,
+        Table<2, VectorizedArray<scalar_type, width>> &   hessian,
+        const unsigned int n_derivative_levels = 2,
+        const unsigned int n_filled_lanes      = width);
+
+      //@}
+
+    private:
+      /**
+       * The independent variables of the lane evaluated by
+       * compute_vectorized().
+       */
+      std::vector<scalar_type> lane_independent_values;
+
+      /**
+       * The gradient of the lane evaluated by compute_vectorized().
+       */
+      Vector<scalar_type> lane_gradient;
+
+      /**
+       * The Hessian of the lane evaluated by compute_vectorized().
+       */
+      FullMatrix<scalar_type> lane_hessian;
+
     }; // class ScalarFunction
 
 
@@ -3967,6 +4052,98 @@ namespace Differentiation
 
 
 
+    template <int                  dim,
+              enum AD::NumberTypes ADNumberTypeCode,
+              typename ScalarType>
+    template <std::size_t width>
+    void
+    ScalarFunction<dim, ADNumberTypeCode, ScalarType>::compute_vectorized(
+      const typename Types<ad_type>::tape_index                   tape_index,
+      const std::function<ad_type(const std::vector<ad_type> &)> &function,
+      const std::vector<VectorizedArray<scalar_type, width>>
+        &                                               independent_values,
+      VectorizedArray<scalar_type, width> &             value,
+      std::vector<VectorizedArray<scalar_type, width>> &gradient,
+      Table<2, VectorizedArray<scalar_type, width>> &   hessian,
+      const unsigned int                                n_derivative_levels,
+      const unsigned int                                n_filled_lanes)
+    {
+      const unsigned int n_independent_variables =
+        this->n_independent_variables();
+      Assert(independent_values.size() == n_independent_variables,
+             ExcDimensionMismatch(independent_values.size(),
+                                  n_independent_variables));
+      AssertIndexRange(n_filled_lanes, width + 1);
+      AssertIndexRange(n_derivative_levels, 3);
+      Assert(n_derivative_levels <=
+               AD::ADNumberTraits<ad_type>::n_supported_derivative_levels,
+             ExcMessage("The AD number type does not support the calculation "
+                        "of the requested derivatives."));
+
+      if (n_derivative_levels >= 1 &&
+          gradient.size() != n_independent_variables)
+        gradient.resize(n_independent_variables);
+      if (n_derivative_levels >= 2 &&
+          (hessian.size(0) != n_independent_variables ||
+           hessian.size(1) != n_independent_variables))
+        hessian.reinit(n_independent_variables, n_independent_variables);
+      lane_independent_values.resize(n_independent_variables);
+
+      for (unsigned int v = 0; v < n_filled_lanes; ++v)
+        {
+          for (unsigned int i = 0; i < n_independent_variables; ++i)
+            lane_independent_values[i] = independent_values[i][v];
+
+          // Reevaluate an existing tape, unless the operations recorded on it
+          // do not hold for the values of this lane
+          bool record_function =
+            (ADNumberTraits<ad_type>::is_tapeless == true ||
+             this->is_registered_tape(tape_index) == false);
+          if (record_function == false)
+            {
+              this->activate_recorded_tape(tape_index);
+              this->set_independent_variables(lane_independent_values);
+              value[v]        = this->compute_value();
+              record_function = this->active_tape_requires_retaping();
+            }
+
+          if (record_function == true)
+            {
+              // The AD data must be cleared before a tape is overwritten or a
+              // tapeless number is set up again, but all other tapes are kept
+              this->reset(numbers::invalid_unsigned_int,
+                          numbers::invalid_unsigned_int,
+                          false /*clear_registered_tapes*/);
+              this->start_recording_operations(tape_index,
+                                               true /*overwrite_tape*/,
+                                               true /*keep_independent_values*/);
+              this->register_independent_variables(lane_independent_values);
+              this->register_dependent_variable(
+                function(this->get_sensitive_variables()));
+              this->stop_recording_operations(false /*write_tapes_to_file*/);
+              if (ADNumberTraits<ad_type>::is_taped == true)
+                this->activate_recorded_tape(tape_index);
+              value[v] = this->compute_value();
+            }
+
+          if (n_derivative_levels >= 1)
+            {
+              this->compute_gradient(lane_gradient);
+              for (unsigned int i = 0; i < n_independent_variables; ++i)
+                gradient[i][v] = lane_gradient[i];
+            }
+          if (n_derivative_levels >= 2)
+            {
+              this->compute_hessian(lane_hessian);
+              for (unsigned int i = 0; i < n_independent_variables; ++i)
+                for (unsigned int j = 0; j < n_independent_variables; ++j)
+                  hessian(i, j)[v] = lane_hessian(i, j);
+            }
+        }
+    }
+
+
+
     /* ----------------- VectorFunction ----------------- */
 
 
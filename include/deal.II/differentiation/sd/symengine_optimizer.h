@@ -37,7 +37,9 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
 #  include <deal.II/base/exceptions.h>
 #  include <deal.II/base/logstream.h>
+#  include <deal.II/base/mpi.h>
 #  include <deal.II/base/utilities.h>
+#  include <deal.II/base/vectorization.h>
 
 #  include <deal.II/differentiation/sd/symengine_number_types.h>
 #  include <deal.II/differentiation/sd/symengine_number_visitor_internal.h>
@@ -51,6 +53,7 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #  include <algorithm>
 #  include <map>
 #  include <memory>
+#  include <string>
 #  include <type_traits>
 #  include <utility>
 #  include <vector>
@@ -1768,6 +1771,36 @@ namespace Differentiation
       void
       optimize();
 
+      /**
+       * Perform the optimization of all registered dependent functions using
+       * the registered symbols, reusing the result of a previous optimization
+       * of the same set of functions if one is found in the
+       * @p cache_directory.
+       *
+       * The cache entry is identified by hash(). If no entry exists, then
+       * the root process of the @p mpi_communicator calls optimize() and
+       * writes the serialized state of this object to the cache directory.
+       * The serialized state is then sent from the root process to all other
+       * processes, so that the optimization is performed at most once per
+       * set of functions, rather than once per process and per run.
+       *
+       * All processes must have registered the same symbols and functions,
+       * and the cache directory must already exist and be writable by the
+       * root process.
+       *
+       * @note The reuse is most beneficial for the LLVM optimizer, for which
+       * the compiled function itself is serialized. The lambda optimizer
+       * cannot be serialized and is rebuilt when the cache entry is read,
+       * see load().
+       *
+       * @note The hash that identifies a cache entry is computed by
+       * SymEngine. It is only guaranteed to be reproducible for the same
+       * version and build of the SymEngine library.
+       */
+      void
+      optimize(const std::string &cache_directory,
+               const MPI_Comm &   mpi_communicator = MPI_COMM_SELF);
+
       /**
        * Returns a flag which indicates whether the optimize()
        * function has been called and the class is finalized.
@@ -1775,6 +1808,15 @@ namespace Differentiation
       bool
       optimized() const;
 
+      /**
+       * Return a hash of the optimization method and flags, the registered
+       * independent symbols and the registered dependent functions. Two
+       * optimizers that return the same hash can reuse each other's
+       * optimized state.
+       */
+      std::size_t
+      hash() const;
+
       //@}
 
       /**
@@ -1918,6 +1960,33 @@ namespace Differentiation
       SymmetricTensor<rank, dim, ReturnType>
       evaluate(const SymmetricTensor<rank, dim, Expression> &funcs) const;
 
+      /**
+       * Substitute the values of the independent variables given lane-wise
+       * in @p substitution_values into the optimized counterpart of all
+       * dependent functions, and return the results of all lanes in
+       * @p dependent_values. This permits the use of the optimizer, e.g., at
+       * all quadrature points of a batch of cells processed by FEEvaluation.
+       *
+       * The order of the @p substitution_values is that of the registered
+       * symbols, see the substitute() function that takes a vector of
+       * values, and the order of the @p dependent_values is that of the
+       * evaluate() function that returns all cached values. Only the first
+       * @p n_filled_lanes lanes are computed; the remaining lanes of
+       * @p dependent_values are not touched. The @p dependent_values are only
+       * resized if their size does not match the number of dependent
+       * variables.
+       *
+       * @note After this call, evaluate() returns the results of the last
+       * filled lane.
+       */
+      template <std::size_t width>
+      void
+      substitute_and_evaluate(
+        const std::vector<VectorizedArray<ReturnType, width>>
+          &                                              substitution_values,
+        std::vector<VectorizedArray<ReturnType, width>> &dependent_values,
+        const unsigned int n_filled_lanes = width) const;
+
       //@}
 
     private:
@@ -2025,6 +2094,12 @@ namespace Differentiation
        */
       mutable bool has_been_serialized;
 
+      /**
+       * The values of the independent variables of the lane that is
+       * evaluated by substitute_and_evaluate().
+       */
+      mutable std::vector<ReturnType> lane_substitution_values;
+
       /**
        * Register a single symbol that represents a dependent variable.
        */
@@ -2471,6 +2546,42 @@ namespace Differentiation
       return internal::tensor_evaluate_optimized(funcs, *this);
     }
 
+
+
+
+    template <typename ReturnType>
+    template <std::size_t width>
+    void
+    BatchOptimizer<ReturnType>::substitute_and_evaluate(
+      const std::vector<VectorizedArray<ReturnType, width>>
+        &                                              substitution_values,
+      std::vector<VectorizedArray<ReturnType, width>> &dependent_values,
+      const unsigned int                               n_filled_lanes) const
+    {
+      static_assert(std::is_floating_point<ReturnType>::value,
+                    "Vectorized evaluation is only implemented for floating "
+                    "point return types.");
+      Assert(substitution_values.size() == n_independent_variables(),
+             ExcDimensionMismatch(substitution_values.size(),
+                                  n_independent_variables()));
+      AssertIndexRange(n_filled_lanes, width + 1);
+
+      if (dependent_values.size() != n_dependent_variables())
+        dependent_values.resize(n_dependent_variables());
+      lane_substitution_values.resize(substitution_values.size());
+
+      for (unsigned int v = 0; v < n_filled_lanes; ++v)
+        {
+          for (unsigned int i = 0; i < substitution_values.size(); ++i)
+            lane_substitution_values[i] = substitution_values[i][v];
+
+          substitute(lane_substitution_values);
+
+          for (unsigned int i = 0; i < dependent_variables_output.size(); ++i)
+            dependent_values[i][v] = dependent_variables_output[i];
+        }
+    }
+
 #  endif // DOXYGEN
 
   } // namespace SD
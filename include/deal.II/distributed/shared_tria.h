@@ -113,7 +113,8 @@ namespace parallel
        *
        * The constructor requires that exactly one of
        * <code>partition_auto</code>, <code>partition_metis</code>,
-       * <code>partition_zorder</code>, <code>partition_zoltan</code> and
+       * <code>partition_zorder</code>, <code>partition_zoltan</code>,
+       * <code>partition_parmetis</code> and
        * <code>partition_custom_signal</code> is set. If
        * <code>partition_auto</code> is chosen, it will use
        * <code>partition_zoltan</code> (if available), then
@@ -222,6 +223,16 @@ namespace parallel
          * active cell partitioning method.
          */
         construct_multigrid_hierarchy = 0x8,
+
+        /**
+         * Use the parallel graph partitioner ParMETIS to partition active
+         * cells, see GridTools::partition_triangulation_parmetis(). As
+         * opposed to partition_metis, the cell connectivity graph is
+         * distributed among the processes of the communicator and the
+         * partitioning is computed in parallel, which reduces the time and
+         * memory for large meshes.
+         */
+        partition_parmetis = 0x10,
       };
 
 
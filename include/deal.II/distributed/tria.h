@@ -234,6 +234,27 @@ namespace parallel
      * are called more than once, sometimes several times, every time the
      * triangulation is actually refined.
      *
+     * <h3>Memory consumption of the coarse mesh</h3>
+     *
+     * The p4est library needs the connectivity of the complete coarse mesh
+     * on every process, so every process stores all coarse cells, plus the
+     * artificial cells that keep the refinement hierarchy balanced. For
+     * coarse meshes with millions of cells, this dominates the memory
+     * consumption, which can be assessed with
+     * parallel::TriangulationBase::compute_memory_statistics(). Once the
+     * mesh has been refined and partitioned with this class, it can be
+     * transferred into a parallel::fullydistributed::Triangulation, which
+     * only stores the coarse cells of the locally owned and ghost cells:
+     * @code
+     * parallel::fullydistributed::Triangulation<dim> tria_pft(comm);
+     * tria_pft.create_triangulation(
+     *   TriangulationDescription::Utilities::
+     *     create_description_from_triangulation(tria_pdt, comm));
+     * @endcode
+     * If the coarse mesh does not even fit on a single process, use
+     * TriangulationDescription::Utilities::
+     * create_description_from_distributed_coarse_grid() instead.
+     *
      *
      * @ingroup distributed
      */
@@ -611,10 +632,47 @@ namespace parallel
        * computation on a shared network file system. See the SolutionTransfer
        * class on how to store solution vectors into this file. Additional
        * cell-based data can be saved using register_data_attach().
+       *
+       * This function is equivalent to calling save_start() and
+       * save_finish() right after each other.
        */
       void
       save(const std::string &filename) const;
 
+      /**
+       * Start saving the triangulation and the attached cell-based data into
+       * the given file, like save(), but return before the attached data has
+       * been written. The data registered with register_data_attach() is
+       * packed into buffers that are owned by this object, and the write
+       * operations of the MPI-IO layer are started with nonblocking calls,
+       * so that the computation can continue while the file system
+       * processes the data. The data of the triangulation itself, which p4est
+       * writes, is still saved before the function returns. Hence, the mesh
+       * may be refined or the attached vectors may be changed right after
+       * this call.
+       *
+       * The operation must be completed by a call to save_finish() on all
+       * processes before the files may be read by load(). Calling this
+       * function while a previous save operation is still in progress first
+       * completes the previous operation. The destructor also completes a
+       * pending operation.
+       *
+       * @note How much of the write operation actually overlaps with the
+       * computation depends on the progress the MPI implementation makes in
+       * the background, which for some implementations only happens within
+       * calls to MPI functions.
+       */
+      void
+      save_start(const std::string &filename) const;
+
+      /**
+       * Wait for the completion of the save operation started with
+       * save_start() and close the files. This is a collective operation.
+       * Nothing happens if no save operation is in progress.
+       */
+      void
+      save_finish() const;
+
       /**
        * Load the refinement information saved with save() back in. The mesh
        * must contain the same coarse mesh that was used in save() before
@@ -1051,12 +1109,23 @@ namespace parallel
          * Each processor's position to write to will be determined
          * from the provided @p parallel_forest.
          *
-         * Data has to be previously packed with pack_data().
+         * Data has to be previously packed with pack_data(). The packed
+         * buffers are moved into separate storage for the write operation,
+         * which is started with nonblocking calls and needs to be completed
+         * with save_finish().
          */
         void
-        save(const typename dealii::internal::p4est::types<dim>::forest
-               *                parallel_forest,
-             const std::string &filename) const;
+        save_start(const typename dealii::internal::p4est::types<dim>::forest
+                     *                parallel_forest,
+                   const std::string &filename);
+
+        /**
+         * Wait for the write operations started with save_start(), close the
+         * files, and release the buffers. Nothing happens if no write
+         * operation is in progress.
+         */
+        void
+        save_finish();
 
         /**
          * Transfer data from file system.
@@ -1127,6 +1196,23 @@ namespace parallel
         std::vector<int>  dest_sizes_variable;
         std::vector<char> src_data_variable;
         std::vector<char> dest_data_variable;
+
+        /**
+         * The buffers that are being written to file by a save operation
+         * started with save_start(). They must stay untouched until
+         * save_finish() has been called.
+         */
+        std::vector<unsigned int> save_sizes_fixed_cumulative;
+        std::vector<char>         save_data_fixed;
+        std::vector<int>          save_sizes_variable;
+        std::vector<char>         save_data_variable;
+
+        /**
+         * The files and requests of a save operation started with
+         * save_start().
+         */
+        std::vector<MPI_File>    save_files;
+        std::vector<MPI_Request> save_requests;
       };
 
       DataTransfer data_transfer;
@@ -1317,6 +1403,20 @@ namespace parallel
       void
       save(const std::string &filename) const;
 
+      /**
+       * This function is not implemented, but needs to be present for the
+       * compiler.
+       */
+      void
+      save_start(const std::string &filename) const;
+
+      /**
+       * This function is not implemented, but needs to be present for the
+       * compiler.
+       */
+      void
+      save_finish() const;
+
       bool
       is_multilevel_hierarchy_constructed() const override;
 
@@ -231,6 +231,96 @@ namespace parallel
     virtual std::vector<types::manifold_id>
     get_manifold_ids() const override;
 
+    /**
+     * Compute the statistics over all processes of the weights of the
+     * locally owned active cells, as a means to assess the quality of a
+     * partitioning, e.g. after a repartitioning. The first entry of the
+     * returned vector refers to the scalar weights, i.e., the reference
+     * weight of 1000 per cell plus the values returned by the functions
+     * connected to the Triangulation::Signals::cell_weight signal. The
+     * remaining entries refer to the constraints provided through the
+     * Triangulation::Signals::multi_constraint_cell_weight signal, if any.
+     * All signals are evaluated with the status
+     * Triangulation::CellStatus::CELL_PERSIST.
+     *
+     * The load imbalance of a quantity is the ratio of the maximum and the
+     * average of the respective entry, where a value of one corresponds to
+     * a perfectly balanced partitioning.
+     *
+     * @note This function involves a global communication and needs to be
+     *   called on all processes.
+     */
+    std::vector<Utilities::MPI::MinMaxAvg>
+    compute_cell_weight_statistics() const;
+
+    /**
+     * A structure that describes which cells the current process stores and
+     * how much memory they take.
+     */
+    struct MemoryStatistics
+    {
+      /**
+       * The number of coarse cells stored on this process. For
+       * parallel::shared::Triangulation and
+       * parallel::distributed::Triangulation, this is the number of cells
+       * of the complete coarse mesh, whereas
+       * parallel::fullydistributed::Triangulation only stores the coarse
+       * cells that are needed for the locally owned and ghost cells.
+       */
+      unsigned int n_coarse_cells;
+
+      /**
+       * The number of locally owned active cells.
+       */
+      unsigned int n_locally_owned_active_cells;
+
+      /**
+       * The number of active ghost cells.
+       */
+      unsigned int n_ghost_cells;
+
+      /**
+       * The number of active artificial cells, i.e., of the active cells
+       * that are stored on this process although they are neither locally
+       * owned nor ghost cells.
+       */
+      unsigned int n_artificial_cells;
+
+      /**
+       * The number of cells on all levels that have children.
+       */
+      unsigned int n_parent_cells;
+
+      /**
+       * The memory in bytes of the cells, faces, and vertices stored in the
+       * dealii::Triangulation base class.
+       */
+      std::size_t triangulation_memory;
+
+      /**
+       * The memory in bytes of the data this class and its derived classes
+       * store in addition to the triangulation, e.g., the p4est forest of a
+       * parallel::distributed::Triangulation.
+       */
+      std::size_t additional_memory;
+
+      /**
+       * Return an estimate of the memory in bytes spent on the artificial
+       * cells, computed from the average memory per cell.
+       */
+      std::size_t
+      artificial_cell_memory() const;
+    };
+
+    /**
+     * Compute the number of stored cells of the current process by
+     * category, together with the memory they take. This function does not
+     * communicate; use, e.g., Utilities::MPI::min_max_avg() on the members of
+     * the result for statistics over all processes.
+     */
+    MemoryStatistics
+    compute_memory_statistics() const;
+
   protected:
     /**
      * MPI communicator to be used for the triangulation. We create a unique
@@ -24,12 +24,23 @@
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <deal.II/grid/cell_id.h>
+
 #include <deal.II/hp/dof_handler.h>
 
+#include <map>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class AffineConstraints;
+template <int dim, typename Number, typename VectorizedArrayType>
+class MatrixFree;
+#endif
+
 /**
  * Implementation of a number of renumbering algorithms for the degrees of
  * freedom on a triangulation. The functions in this namespace compute
@@ -1171,6 +1182,60 @@ namespace DoFRenumbering
                  const DoFHandlerType &                dof_handler,
                  const unsigned int                    level);
 
+  /**
+   * Renumber the degrees of freedom after a refinement of the mesh such that
+   * the degrees of freedom on the cells that have not been changed by the
+   * refinement keep the indices they had before. The remaining degrees of
+   * freedom, i.e., the ones on new cells, fill the indices that are not used
+   * by the unchanged cells in the order of their present numbering. For
+   * local mesh adaptation where only a small fraction of the cells change,
+   * this keeps most of the numbering intact, so data structures that depend
+   * on the numbering, such as constraints or sparsity patterns, only change
+   * close to the adapted cells.
+   *
+   * The indices before the refinement are passed by the map
+   * @p previous_cell_dof_indices from the CellId of the active cells to their
+   * DoF indices, which is obtained before the refinement by
+   * @code
+   * std::map<CellId, std::vector<types::global_dof_index>> previous;
+   * for (const auto &cell : dof_handler.active_cell_iterators())
+   *   {
+   *     std::vector<types::global_dof_index> dof_indices(
+   *       cell->get_fe().dofs_per_cell);
+   *     cell->get_dof_indices(dof_indices);
+   *     previous[cell->id()] = dof_indices;
+   *   }
+   * @endcode
+   * Cells that are contained in the map and active after the refinement
+   * are considered as unchanged. Indices that are not smaller than the
+   * present number of degrees of freedom, as may happen after coarsening,
+   * cannot be kept and are treated like the ones on new cells.
+   *
+   * @note This function is only implemented for triangulations that are not
+   * distributed among several processors.
+   */
+  template <typename DoFHandlerType>
+  void
+  keep_previous_numbering(
+    DoFHandlerType &dof_handler,
+    const std::map<CellId, std::vector<types::global_dof_index>>
+      &previous_cell_dof_indices);
+
+  /**
+   * Compute the renumbering vector needed by the keep_previous_numbering()
+   * function. See there for more information.
+   *
+   * This function does not perform the renumbering on the DoFHandler dofs but
+   * returns the renumbering vector.
+   */
+  template <typename DoFHandlerType>
+  void
+  compute_keep_previous_numbering(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandlerType &                dof_handler,
+    const std::map<CellId, std::vector<types::global_dof_index>>
+      &previous_cell_dof_indices);
+
   /**
    * @}
    */
@@ -1220,6 +1285,68 @@ namespace DoFRenumbering
    * @}
    */
 
+  /**
+   * @name Numberings for better performance with the matrix-free framework
+   * @{
+   */
+
+  /**
+   * Renumber the degrees of freedom in the order in which they are first
+   * accessed by the cell batches of MatrixFree::cell_loop(). This makes
+   * the access to vector entries in FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global() mostly contiguous and thus
+   * cache-friendly, and allows the matrix-free framework to detect more cells
+   * with contiguous index ranges that can be accessed with vectorized loads.
+   * Degrees of freedom only accessed indirectly, like the hanging-node
+   * constrained ones that are resolved by the matrix-free framework, are
+   * numbered last.
+   *
+   * This function sets up a MatrixFree object with the given @p constraints
+   * and @p matrix_free_data, where the data structures for the mapping are
+   * not initialized, and then calls compute_matrix_free_data_locality().
+   * If the field <tt>mg_level</tt> of @p matrix_free_data is set, the degrees
+   * of freedom of that multigrid level are renumbered.
+   *
+   * The renumbering only permutes the locally owned degrees of freedom
+   * within their index range, so the parallel partitioning of the degrees of
+   * freedom is not changed.
+   */
+  template <int dim, typename Number, typename AdditionalDataType>
+  void
+  matrix_free_data_locality(DoFHandler<dim> &                dof_handler,
+                            const AffineConstraints<Number> &constraints,
+                            const AdditionalDataType &       matrix_free_data);
+
+  /**
+   * Same as above, but taking the cell batches and the access pattern of an
+   * already initialized MatrixFree object. The @p dof_handler needs to be
+   * one of the DoFHandler objects @p matrix_free was set up with. Note that
+   * @p matrix_free needs to be re-initialized after the renumbering.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * Compute the renumbering vector needed by the matrix_free_data_locality()
+   * function. Does not perform the renumbering on the @p DoFHandler dofs but
+   * returns the renumbering vector, which contains the new indices of the
+   * locally owned degrees of freedom (of the multigrid level @p matrix_free
+   * was set up for, if any).
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * @}
+   */
+
 
 
   /**
@@ -832,6 +832,50 @@ namespace DoFTools
            const unsigned int)> &face_has_flux_coupling =
       &internal::always_couple_on_faces<DoFHandlerType>);
 
+  /**
+   * Compute the same sparsity pattern as the first make_sparsity_pattern()
+   * function above, but build the final SparsityPattern object directly
+   * instead of going through an intermediate DynamicSparsityPattern.
+   *
+   * The function works in two passes over the rows of the matrix: the first
+   * one determines the exact length of each row, the pattern is then
+   * allocated once, and the second pass writes the sorted column indices of
+   * each row into it. Both passes run in parallel over the rows, and no
+   * memory beyond the final pattern and the lists of DoF indices of all
+   * cells is needed. The object passed as @p sparsity_pattern is
+   * reinitialized and is compressed upon return.
+   *
+   * The @p constraints and @p keep_constrained_dofs arguments have the same
+   * meaning as for the make_sparsity_pattern() function above.
+   *
+   * @note This function builds the pattern for all degrees of freedom and can
+   * consequently only be used with sequential triangulations.
+   *
+   * @ingroup constraints
+   */
+  template <typename DoFHandlerType, typename number = double>
+  void
+  make_sparsity_pattern_direct(
+    const DoFHandlerType &           dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true);
+
+  /**
+   * Like make_sparsity_pattern_direct(), but additionally add the couplings
+   * between degrees of freedom on neighboring cells, i.e., compute the same
+   * pattern as make_flux_sparsity_pattern().
+   *
+   * @ingroup constraints
+   */
+  template <typename DoFHandlerType, typename number = double>
+  void
+  make_flux_sparsity_pattern_direct(
+    const DoFHandlerType &           dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true);
+
   /**
    * Create the sparsity pattern for boundary matrices. See the general
    * documentation of this class for more information.
@@ -2757,6 +2801,51 @@ namespace DoFTools
     AffineConstraints<number> &          zero_boundary_constraints,
     const ComponentMask &                component_mask = ComponentMask());
 
+  /**
+   * Write a snapshot of the triangulation of @p dof_handler and of the
+   * enumeration of its degrees of freedom to the file @p filename. The
+   * snapshot contains the complete refinement history of the triangulation
+   * along with the boundary, manifold, and material ids, as well as the
+   * indices of the degrees of freedom on all cells. It can be read with
+   * read_snapshot(), which restores the state of both objects without
+   * having to recreate and refine the coarse mesh or to distribute and
+   * renumber the degrees of freedom.
+   *
+   * The data is stored in a binary format, prefixed by a header with a
+   * format version, the space dimensions, and the name of the finite
+   * element. Consequently, a snapshot can only be read on machines with the
+   * same representation of the data types as the one it has been written
+   * on. Like Triangulation::save(), the snapshot does not store the
+   * manifold objects attached to the triangulation.
+   *
+   * @note This function is only implemented for serial triangulations.
+   * Use parallel::distributed::Triangulation::save() for distributed
+   * triangulations instead.
+   */
+  template <int dim, int spacedim>
+  void
+  write_snapshot(const DoFHandler<dim, spacedim> &dof_handler,
+                 const std::string &              filename);
+
+  /**
+   * Read a snapshot written by write_snapshot() from the file
+   * @p filename into @p triangulation and @p dof_handler, where the latter
+   * needs to be associated with the former already. The finite element
+   * @p fe needs to be the same as the one used when writing the snapshot,
+   * which is checked via its name. All previous content of both objects is
+   * deleted.
+   *
+   * @note As for Triangulation::load(), the manifold objects of
+   * @p triangulation are removed, and need to be attached again after
+   * calling this function. The manifold ids are restored from the snapshot.
+   */
+  template <int dim, int spacedim>
+  void
+  read_snapshot(Triangulation<dim, spacedim> &      triangulation,
+                DoFHandler<dim, spacedim> &         dof_handler,
+                const FiniteElement<dim, spacedim> &fe,
+                const std::string &                 filename);
+
   /**
    * @}
    */
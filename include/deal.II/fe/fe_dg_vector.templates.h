@@ -51,9 +51,9 @@ FE_DGVector<PolynomialType, dim, spacedim>::FE_DGVector(const unsigned int deg,
   QGauss<dim> quadrature(polynomial_degree + 1);
   this->generalized_support_points = quadrature.get_points();
 
-  this->reinit_restriction_and_prolongation_matrices(true, true);
-  FETools::compute_projection_matrices(*this, this->restriction, true);
-  FETools::compute_embedding_matrices(*this, this->prolongation, true);
+  // do not initialize embedding and restriction here. these matrices are
+  // initialized on demand in get_restriction_matrix and
+  // get_prolongation_matrix
 }
 
 
@@ -65,6 +65,78 @@ FE_DGVector<PolynomialType, dim, spacedim>::clone() const
 }
 
 
+template <class PolynomialType, int dim, int spacedim>
+const FullMatrix<double> &
+FE_DGVector<PolynomialType, dim, spacedim>::get_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // initialization upon first request. the matrices for isotropic refinement
+  // are set last, so they indicate whether all matrices are available
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if the matrices got computed while waiting for the lock, there is
+      // nothing left to do
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_DGVector<PolynomialType, dim, spacedim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim, spacedim>::get_prolongation_matrix(child,
+                                                               refinement_case);
+}
+
+
+
+template <class PolynomialType, int dim, int spacedim>
+const FullMatrix<double> &
+FE_DGVector<PolynomialType, dim, spacedim>::get_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // the matrices are initialized together with the prolongation matrices
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_DGVector<PolynomialType, dim, spacedim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim, spacedim>::get_restriction_matrix(child,
+                                                              refinement_case);
+}
+
+
+
+template <class PolynomialType, int dim, int spacedim>
+void
+FE_DGVector<PolynomialType, dim, spacedim>::initialize_transfer_matrices()
+{
+  // compute the matrices in temporary objects and only move them into place
+  // at the end, because other threads check them to see whether the matrices
+  // are available without acquiring the lock
+  std::vector<std::vector<FullMatrix<double>>> prolongation(
+    RefinementCase<dim>::isotropic_refinement);
+  std::vector<std::vector<FullMatrix<double>>> restriction(
+    RefinementCase<dim>::isotropic_refinement);
+  prolongation.back().resize(
+    GeometryInfo<dim>::max_children_per_cell,
+    FullMatrix<double>(this->dofs_per_cell, this->dofs_per_cell));
+  restriction.back() = prolongation.back();
+
+  FETools::compute_projection_matrices(*this, restriction, true);
+  FETools::compute_embedding_matrices(*this, prolongation, true);
+
+  this->restriction.back().swap(restriction.back());
+  this->prolongation.back().swap(prolongation.back());
+}
+
+
+
 template <class PolynomialType, int dim, int spacedim>
 std::string
 FE_DGVector<PolynomialType, dim, spacedim>::get_name() const
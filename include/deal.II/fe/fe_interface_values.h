@@ -21,6 +21,11 @@
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 /**
@@ -420,6 +425,27 @@ private:
    */
   std::vector<std::array<unsigned int, 2>> dofmap;
 
+  /**
+   * The DoF indices of the first and the second cell of the interface of the
+   * last call to reinit() with two cells.
+   */
+  std::vector<types::global_dof_index> cell_dof_indices;
+  std::vector<types::global_dof_index> neighbor_dof_indices;
+
+  /**
+   * The pairs of global and local DoF indices of the two cells, sorted by
+   * the global index.
+   */
+  std::vector<std::pair<types::global_dof_index, unsigned int>>
+    sorted_cell_dof_indices;
+  std::vector<std::pair<types::global_dof_index, unsigned int>>
+    sorted_neighbor_dof_indices;
+
+  /**
+   * Scratch array for the DoF indices requested in reinit().
+   */
+  std::vector<types::global_dof_index> dof_indices_buffer;
+
   /**
    * The FEFaceValues object for the current cell.
    */
@@ -539,50 +565,62 @@ FEInterfaceValues<dim, spacedim>::reinit(
       fe_face_values_neighbor = &internal_fe_subface_values_neighbor;
     }
 
-  // Set up dof mapping and remove duplicates (for continuous elements).
-  {
-    // Get dof indices first:
-    std::vector<types::global_dof_index> v(
-      fe_face_values->get_fe().n_dofs_per_cell());
-    cell->get_active_or_mg_dof_indices(v);
-    std::vector<types::global_dof_index> v2(
-      fe_face_values_neighbor->get_fe().n_dofs_per_cell());
-    cell_neighbor->get_active_or_mg_dof_indices(v2);
-
-
-
-    // Fill a map from the global dof index to the left and right
-    // local index.
-    std::map<types::global_dof_index, std::pair<unsigned int, unsigned int>>
-                                          tempmap;
-    std::pair<unsigned int, unsigned int> invalid_entry(
-      numbers::invalid_unsigned_int, numbers::invalid_unsigned_int);
-
-    for (unsigned int i = 0; i < v.size(); ++i)
-      {
-        // If not already existing, add an invalid entry:
-        auto result = tempmap.insert(std::make_pair(v[i], invalid_entry));
-        result.first->second.first = i;
-      }
-
-    for (unsigned int i = 0; i < v2.size(); ++i)
-      {
-        // If not already existing, add an invalid entry:
-        auto result = tempmap.insert(std::make_pair(v2[i], invalid_entry));
-        result.first->second.second = i;
-      }
-
-    // Transfer from the map to the sorted std::vectors.
-    dofmap.resize(tempmap.size());
-    interface_dof_indices.resize(tempmap.size());
-    unsigned int idx = 0;
-    for (auto &x : tempmap)
-      {
-        interface_dof_indices[idx] = x.first;
-        dofmap[idx]                = {{x.second.first, x.second.second}};
-        ++idx;
-      }
-  }
+  // Set up dof mapping and remove duplicates (for continuous elements). We
+  // keep the DoF indices of both cells together with a copy sorted by the
+  // global index, and only sort again if the indices differ from the ones of
+  // the previous call. That is the common case when looping over all faces
+  // of a cell, where the first cell stays the same.
+  const auto update_sorted_dof_indices =
+    [this](const CellIteratorType &                 c,
+           const unsigned int                       n_dofs,
+           std::vector<types::global_dof_index> &   dof_indices,
+           std::vector<std::pair<types::global_dof_index, unsigned int>>
+             &sorted_dof_indices) {
+      dof_indices_buffer.resize(n_dofs);
+      c->get_active_or_mg_dof_indices(dof_indices_buffer);
+      if (dof_indices_buffer != dof_indices ||
+          sorted_dof_indices.size() != n_dofs)
+        {
+          dof_indices.swap(dof_indices_buffer);
+          sorted_dof_indices.resize(n_dofs);
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            sorted_dof_indices[i] = {dof_indices[i], i};
+          std::sort(sorted_dof_indices.begin(), sorted_dof_indices.end());
+        }
+    };
+  update_sorted_dof_indices(cell,
+                            fe_face_values->get_fe().n_dofs_per_cell(),
+                            cell_dof_indices,
+                            sorted_cell_dof_indices);
+  update_sorted_dof_indices(cell_neighbor,
+                            fe_face_values_neighbor->get_fe().n_dofs_per_cell(),
+                            neighbor_dof_indices,
+                            sorted_neighbor_dof_indices);
+
+  // Merge the two sorted lists into the list of interface DoFs, which is
+  // sorted by global index. If a global index appears several times on the
+  // same cell, the last local index is used.
+  interface_dof_indices.clear();
+  dofmap.clear();
+  auto       a     = sorted_cell_dof_indices.cbegin();
+  const auto a_end = sorted_cell_dof_indices.cend();
+  auto       b     = sorted_neighbor_dof_indices.cbegin();
+  const auto b_end = sorted_neighbor_dof_indices.cend();
+  while (a != a_end || b != b_end)
+    {
+      const types::global_dof_index index =
+        (b == b_end || (a != a_end && a->first < b->first)) ? a->first :
+                                                              b->first;
+      std::array<unsigned int, 2> local_indices = {
+        {numbers::invalid_unsigned_int, numbers::invalid_unsigned_int}};
+      for (; a != a_end && a->first == index; ++a)
+        local_indices[0] = a->second;
+      for (; b != b_end && b->first == index; ++b)
+        local_indices[1] = b->second;
+
+      interface_dof_indices.push_back(index);
+      dofmap.push_back(local_indices);
+    }
 }
 
 
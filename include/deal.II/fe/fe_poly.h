@@ -315,9 +315,27 @@ protected:
 
     // next already fill those fields of which we have information by
     // now. note that the shape gradients are only those on the unit
-    // cell, and need to be transformed when visiting an actual cell
-    if (update_flags & (update_values | update_gradients | update_hessians |
-                        update_3rd_derivatives))
+    // cell, and need to be transformed when visiting an actual cell.
+    //
+    // in the common case where only values and gradients are needed, let the
+    // polynomial space evaluate all quadrature points at once, which allows
+    // it to work on several points in parallel. the values are written
+    // right into the output array if it has the correct size, see below
+    if ((update_flags & (update_values | update_gradients)) &&
+        !(update_flags & (update_hessians | update_3rd_derivatives)))
+      {
+        Table<2, double> no_values;
+        poly_space->evaluate_values_and_gradients(
+          make_array_view(quadrature.get_points()),
+          (update_flags & update_values) ?
+            (output_data.shape_values.n_cols() == n_q_points ?
+               output_data.shape_values :
+               data.shape_values) :
+            no_values,
+          data.shape_gradients);
+      }
+    else if (update_flags & (update_values | update_gradients |
+                             update_hessians | update_3rd_derivatives))
       for (unsigned int i = 0; i < n_q_points; ++i)
         {
           poly_space->evaluate(quadrature.point(i),
@@ -259,8 +259,8 @@ protected:
     std::vector<Tensor<4, dim>> third_derivatives(0);
     std::vector<Tensor<5, dim>> fourth_derivatives(0);
 
-    if (update_flags & (update_values | update_gradients | update_hessians))
-      data.sign_change.resize(this->dofs_per_cell);
+    data.sign_change.resize(this->dofs_per_cell);
+    data.previous_sign_change.resize(this->dofs_per_cell);
 
     // initialize fields only if really
     // necessary. otherwise, don't
@@ -464,6 +464,14 @@ protected:
     // for shape_hessian computations
     mutable std::vector<Tensor<3, spacedim>> transformed_shape_hessians;
     mutable std::vector<Tensor<3, dim>> untransformed_shape_hessian_tensors;
+
+    /**
+     * The sign changes of the cell last passed to fill_fe_values(). On a
+     * cell that is a translation of that cell, the transformed data of all
+     * shape functions whose sign is the same on both cells is unchanged and
+     * need not be computed again.
+     */
+    mutable std::vector<double> previous_sign_change;
   };
 
 
@@ -27,6 +27,7 @@
 #  include <deal.II/fe/fe.h>
 #  include <deal.II/fe/fe_tools.h>
 
+#  include <array>
 #  include <memory>
 #  include <type_traits>
 #  include <utility>
@@ -1136,6 +1137,23 @@ private:
    */
   std::vector<std::vector<std::size_t>> generalized_support_points_index_table;
 
+  /**
+   * A table that describes how the shape function data computed by the base
+   * elements in fill_fe_values() and related functions is copied into the
+   * output arrays of this element. For each base element, there is one entry
+   * per shape function of this element that belongs to one of the copies of
+   * the base element, holding the first row of the shape function in the
+   * arrays of the base element, the first row in the arrays of this element,
+   * and the number of rows, i.e., the number of nonzero components of the
+   * shape function.
+   *
+   * Using this table, the copy operation only touches the shape functions of
+   * the respective base element and has a cost proportional to the number of
+   * shape functions, rather than one that grows quadratically with the
+   * number of copies of a base element.
+   */
+  std::vector<std::vector<std::array<unsigned int, 3>>> base_to_system_rows;
+
   /**
    * This function is simply singled out of the constructors since there are
    * several of them. It sets up the index table for the system as well as @p
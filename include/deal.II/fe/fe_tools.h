@@ -424,6 +424,46 @@ namespace FETools
     std::vector<std::vector<FullMatrix<number>>> &matrices,
     const bool                                    isotropic_only = false);
 
+  /**
+   * Remove all matrices from the cache of compute_embedding_matrices(),
+   * compute_face_embedding_matrices(), and compute_projection_matrices().
+   *
+   * These functions solve dense least-squares or mass matrix problems,
+   * which for high polynomial degrees can take seconds for a single finite
+   * element. Since they are typically called by the constructors of finite
+   * element classes, programs that create many finite element objects would
+   * repeat this work over and over. Therefore, the results are stored in a
+   * cache that is shared by all threads of the program and that identifies
+   * elements by their name as returned by FiniteElement::get_name(), their
+   * number of degrees of freedom and vector components, and the remaining
+   * arguments of these functions. A finite element class derived by the
+   * user must consequently give different elements different names.
+   */
+  void
+  clear_embedding_matrix_cache();
+
+  /**
+   * Write the content of the cache described in
+   * clear_embedding_matrix_cache() into the file @p filename, so that a
+   * later run of the program can read it via load_embedding_matrix_cache()
+   * instead of computing the matrices again.
+   *
+   * The file is written in a binary format that can only be read on the
+   * same kind of machine by the same version of deal.II.
+   */
+  void
+  save_embedding_matrix_cache(const std::string &filename);
+
+  /**
+   * Add the matrices stored in the file @p filename by
+   * save_embedding_matrix_cache() to the cache described in
+   * clear_embedding_matrix_cache(). Entries that are already present in the
+   * cache are kept. An exception is thrown if the file cannot be read or
+   * was written by a different version of deal.II.
+   */
+  void
+  load_embedding_matrix_cache(const std::string &filename);
+
   /**
    * Project scalar data defined in quadrature points to a finite element
    * space on a single cell.
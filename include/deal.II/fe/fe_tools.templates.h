@@ -65,8 +65,10 @@
 #include <deal.II/lac/householder.h>
 
 #include <cctype>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -1875,6 +1877,109 @@ namespace FETools
           }
       }
     } // namespace FEToolsComputeEmbeddingMatricesHelper
+
+
+
+    namespace FEToolsMatrixCacheHelper
+    {
+      /**
+       * Copy the matrices stored in the cache under @p key into
+       * @p matrices and return true, or return false if there is no such
+       * entry. Defined in fe_tools.cc.
+       */
+      bool
+      get_cached_matrices(const std::string &              key,
+                          std::vector<FullMatrix<double>> &matrices);
+
+      /**
+       * Store @p matrices in the cache under @p key. Defined in
+       * fe_tools.cc.
+       */
+      void
+      store_cached_matrices(const std::string &                    key,
+                            const std::vector<FullMatrix<double>> &matrices);
+
+      /**
+       * Return the key under which the matrices of kind @p kind computed
+       * for @p fe with the given additional @p parameters are cached.
+       */
+      template <int dim, int spacedim, typename number>
+      std::string
+      get_key(const std::string &                 kind,
+              const FiniteElement<dim, spacedim> &fe,
+              const std::vector<double> &         parameters)
+      {
+        std::ostringstream key;
+        key << kind << ' ' << fe.get_name() << ' ' << dim << ' ' << spacedim
+            << ' ' << fe.dofs_per_cell << ' ' << fe.n_components() << ' '
+            << sizeof(number) << std::setprecision(17);
+        for (const double parameter : parameters)
+          key << ' ' << parameter;
+        return key.str();
+      }
+
+      /**
+       * Copy the matrices cached under @p key into the matrices pointed to
+       * by @p matrices, if there is an entry with matching sizes. Return
+       * whether the matrices were found.
+       */
+      template <typename number>
+      bool
+      copy_from_cache(const std::string &                     key,
+                      const std::vector<FullMatrix<number> *> &matrices)
+      {
+        std::vector<FullMatrix<double>> cached_matrices;
+        if (!get_cached_matrices(key, cached_matrices) ||
+            cached_matrices.size() != matrices.size())
+          return false;
+
+        for (unsigned int i = 0; i < matrices.size(); ++i)
+          if (cached_matrices[i].m() != matrices[i]->m() ||
+              cached_matrices[i].n() != matrices[i]->n())
+            return false;
+
+        for (unsigned int i = 0; i < matrices.size(); ++i)
+          *matrices[i] = cached_matrices[i];
+        return true;
+      }
+
+      /**
+       * Store the matrices pointed to by @p matrices in the cache under
+       * @p key.
+       */
+      template <typename number>
+      void
+      copy_to_cache(const std::string &                     key,
+                    const std::vector<FullMatrix<number> *> &matrices)
+      {
+        std::vector<FullMatrix<double>> cached_matrices(matrices.size());
+        for (unsigned int i = 0; i < matrices.size(); ++i)
+          cached_matrices[i] = *matrices[i];
+        store_cached_matrices(key, cached_matrices);
+      }
+
+      /**
+       * Collect pointers to the matrices of all refinement cases that
+       * compute_embedding_matrices() and compute_projection_matrices()
+       * fill for the given value of @p isotropic_only.
+       */
+      template <int dim, typename number>
+      std::vector<FullMatrix<number> *>
+      collect_refinement_matrices(
+        std::vector<std::vector<FullMatrix<number>>> &matrices,
+        const bool                                    isotropic_only)
+      {
+        std::vector<FullMatrix<number> *> result;
+        for (unsigned int ref_case =
+               (isotropic_only ? RefinementCase<dim>::isotropic_refinement :
+                                 RefinementCase<dim>::cut_x);
+             ref_case <= RefinementCase<dim>::isotropic_refinement;
+             ++ref_case)
+          for (FullMatrix<number> &matrix : matrices[ref_case - 1])
+            result.push_back(&matrix);
+        return result;
+      }
+    } // namespace FEToolsMatrixCacheHelper
   }   // namespace internal
 
 
@@ -1888,6 +1993,16 @@ namespace FETools
                              const bool                          isotropic_only,
                              const double                        threshold)
   {
+    const std::string cache_key =
+      internal::FEToolsMatrixCacheHelper::get_key<dim, spacedim, number>(
+        "embedding", fe, {double(isotropic_only), threshold});
+    const std::vector<FullMatrix<number> *> matrices_to_fill =
+      internal::FEToolsMatrixCacheHelper::collect_refinement_matrices<dim>(
+        matrices, isotropic_only);
+    if (internal::FEToolsMatrixCacheHelper::copy_from_cache(cache_key,
+                                                             matrices_to_fill))
+      return;
+
     Threads::TaskGroup<void> task_group;
 
     // loop over all possible refinement cases
@@ -1905,6 +2020,9 @@ namespace FETools
         threshold);
 
     task_group.join_all();
+
+    internal::FEToolsMatrixCacheHelper::copy_to_cache(cache_key,
+                                                      matrices_to_fill);
   }
 
 
@@ -1920,6 +2038,18 @@ namespace FETools
     Assert(face_coarse == 0, ExcNotImplemented());
     Assert(face_fine == 0, ExcNotImplemented());
 
+    const std::string cache_key =
+      internal::FEToolsMatrixCacheHelper::get_key<dim, spacedim, number>(
+        "face_embedding",
+        fe,
+        {double(face_coarse), double(face_fine), threshold});
+    std::vector<FullMatrix<number> *> matrices_to_fill;
+    for (FullMatrix<number> &matrix : matrices)
+      matrices_to_fill.push_back(&matrix);
+    if (internal::FEToolsMatrixCacheHelper::copy_from_cache(cache_key,
+                                                             matrices_to_fill))
+      return;
+
     const unsigned int nc     = GeometryInfo<dim>::max_children_per_face;
     const unsigned int n      = fe.dofs_per_face;
     const unsigned int nd     = fe.n_components();
@@ -2120,6 +2250,9 @@ namespace FETools
             if (std::fabs(this_matrix(i, j)) < 1e-12)
               this_matrix(i, j) = 0.;
       }
+
+    internal::FEToolsMatrixCacheHelper::copy_to_cache(cache_key,
+                                                      matrices_to_fill);
   }
 
 
@@ -2131,6 +2264,16 @@ namespace FETools
                                           > &                     matrices,
                               const bool isotropic_only)
   {
+    const std::string cache_key =
+      internal::FEToolsMatrixCacheHelper::get_key<dim, spacedim, number>(
+        "projection", fe, {double(isotropic_only)});
+    const std::vector<FullMatrix<number> *> matrices_to_fill =
+      internal::FEToolsMatrixCacheHelper::collect_refinement_matrices<dim>(
+        matrices, isotropic_only);
+    if (internal::FEToolsMatrixCacheHelper::copy_from_cache(cache_key,
+                                                             matrices_to_fill))
+      return;
+
     const unsigned int n      = fe.dofs_per_cell;
     const unsigned int nd     = fe.n_components();
     const unsigned int degree = fe.degree;
@@ -2346,6 +2489,9 @@ namespace FETools
     tasks.
 
       join_all();
+
+    internal::FEToolsMatrixCacheHelper::copy_to_cache(cache_key,
+                                                      matrices_to_fill);
   }
 
 
@@ -41,6 +41,8 @@
 #include <deal.II/hp/dof_handler.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <type_traits>
 
@@ -3686,12 +3688,82 @@ public:
   const FEValues<dim, spacedim> &
   get_present_fe_values() const;
 
+  /**
+   * Enable a cache of the shape function data transformed to the real cell,
+   * keyed by the vertex configuration of the cell relative to its first
+   * vertex. The base class only detects whether the present cell is a
+   * translation of the previously visited one, see CellSimilarity. With the
+   * cache, reinit() additionally looks up the transformed values, gradients,
+   * and higher derivatives of any previously visited cell with the same
+   * shape, which avoids most of the work in FiniteElement::fill_fe_values()
+   * on structured parts of a mesh visited in an arbitrary order. The mapping
+   * is still evaluated on every cell, and the cached data are only used if
+   * the Jacobians (and, if higher derivatives are requested, their
+   * derivatives) on the present cell agree with the ones of the cached cell
+   * to roundoff accuracy. This makes the cache safe to use with curved
+   * mappings, for which the vertices do not determine the geometry.
+   *
+   * Since cells that are translations of each other can produce Jacobians
+   * that differ in the last digits, the results of a computation with the
+   * cache enabled may differ at the level of roundoff from the ones without.
+   *
+   * At most @p max_n_entries different cell shapes are stored. The cache is
+   * only used for primitive finite elements whose shape functions do not
+   * depend on the position of the quadrature points in real space; for other
+   * elements this function has no effect.
+   */
+  void
+  enable_geometry_cache(const unsigned int max_n_entries = 64);
+
 private:
   /**
    * Store a copy of the quadrature formula here.
    */
   const Quadrature<dim> quadrature;
 
+  /**
+   * The data stored in the geometry cache for one cell shape.
+   */
+  struct GeometryCacheEntry
+  {
+    /**
+     * The Jacobians on the cell the data was computed on.
+     */
+    std::vector<DerivativeForm<1, dim, spacedim>> jacobians;
+
+    /**
+     * The pushed-forward gradients of the Jacobians on the cell the data was
+     * computed on, if higher derivatives of the shape functions are
+     * requested.
+     */
+    std::vector<Tensor<3, spacedim>> jacobian_pushed_forward_grads;
+
+    /**
+     * The pushed-forward second derivatives of the Jacobians on the cell the
+     * data was computed on, if third derivatives of the shape functions are
+     * requested.
+     */
+    std::vector<Tensor<4, spacedim>> jacobian_pushed_forward_2nd_derivatives;
+
+    /**
+     * The output of FiniteElement::fill_fe_values() on that cell.
+     */
+    internal::FEValuesImplementation::FiniteElementRelatedData<dim, spacedim>
+      finite_element_output;
+  };
+
+  /**
+   * The geometry cache, keyed by the quantized vertex coordinates of a cell
+   * relative to its first vertex. See enable_geometry_cache().
+   */
+  std::map<std::vector<std::int64_t>, GeometryCacheEntry> geometry_cache;
+
+  /**
+   * The maximal number of entries in the geometry cache, or zero if the
+   * cache is disabled.
+   */
+  unsigned int geometry_cache_max_n_entries;
+
   /**
    * Do work common to the two constructors.
    */
@@ -3706,6 +3778,13 @@ private:
    */
   void
   do_reinit();
+
+  /**
+   * The variant of do_reinit() used when the geometry cache is enabled and
+   * the present cell is not a translation of the previous one.
+   */
+  void
+  do_reinit_with_geometry_cache();
 };
 
 
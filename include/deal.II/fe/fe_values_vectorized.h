@@ -0,0 +1,780 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fe_values_vectorized_h
+#define dealii_fe_values_vectorized_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_extractors.h>
+#include <deal.II/fe/mapping.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * FEValuesVectorized is a variant of FEValues that computes the data of a
+ * finite element on a batch of several cells at once and stores them in the
+ * lanes of a VectorizedArray, with one cell per lane. The functions
+ * shape_value(), shape_grad(), JxW() and the extractor views accessed via
+ * operator[] return vectorized data, so that the arithmetic of a classical
+ * matrix-based assembly loop runs on all cells of the batch in one SIMD
+ * instruction, in the same way as the cell integrals in matrix-free
+ * computations with FEEvaluation:
+ * @code
+ * FEValuesVectorized<dim> fe_values(mapping, fe, quadrature,
+ *                                   update_gradients | update_JxW_values);
+ * std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+ * FullMatrix<double> cell_matrix(fe.dofs_per_cell, fe.dofs_per_cell);
+ * for (const auto &cell : dof_handler.active_cell_iterators())
+ *   {
+ *     cells.push_back(cell);
+ *     if (cells.size() < VectorizedArray<double>::size() &&
+ *         cell != last_cell)
+ *       continue;
+ *
+ *     fe_values.reinit(cells);
+ *     for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+ *       for (unsigned int j = 0; j < fe_values.dofs_per_cell; ++j)
+ *         {
+ *           VectorizedArray<double> sum = 0;
+ *           for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+ *             sum += fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q) *
+ *                    fe_values.JxW(q);
+ *           // sum[v] is the matrix entry (i,j) of the cell cells[v]
+ *         }
+ *     cells.clear();
+ *   }
+ * @endcode
+ *
+ * Since the shape functions of the finite elements supported by this class
+ * do not depend on the cell, their values and reference gradients are
+ * computed once in the constructor. In reinit(), the mapping is queried for
+ * the geometry of each cell, and the transformation of the gradients of all
+ * shape functions to the real cells, which dominates the cost of
+ * FEValues::reinit() for higher polynomial degrees, is done in vectorized
+ * form.
+ *
+ * This class supports primitive finite elements whose shape functions are
+ * mapped by the identity for the values and the covariant transformation for
+ * the gradients, such as FE_Q, FE_DGQ, FE_DGP, and systems of those. If the
+ * batch passed to reinit() contains fewer cells than there are lanes in @p
+ * VectorizedArrayType, the last cell is repeated in the remaining lanes, see
+ * n_filled_lanes().
+ */
+template <int dim,
+          typename VectorizedArrayType = VectorizedArray<double>>
+class FEValuesVectorized
+{
+public:
+  /**
+   * The scalar number type underlying @p VectorizedArrayType.
+   */
+  using Number = typename VectorizedArrayType::value_type;
+
+  /**
+   * Number of quadrature points.
+   */
+  const unsigned int n_quadrature_points;
+
+  /**
+   * Number of shape functions per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+  /**
+   * A view of a single scalar component of a possibly vector-valued finite
+   * element, the vectorized counterpart of FEValuesViews::Scalar.
+   */
+  class Scalar
+  {
+  public:
+    /**
+     * Constructor for an object that represents the component @p component
+     * of @p fe_values.
+     */
+    Scalar(const FEValuesVectorized &fe_values, const unsigned int component);
+
+    /**
+     * Return the value of the selected component of the shape function
+     * @p i at the quadrature point @p q.
+     */
+    VectorizedArrayType
+    value(const unsigned int i, const unsigned int q) const;
+
+    /**
+     * Return the gradient of the selected component of the shape function
+     * @p i at the quadrature point @p q.
+     */
+    Tensor<1, dim, VectorizedArrayType>
+    gradient(const unsigned int i, const unsigned int q) const;
+
+  private:
+    /**
+     * The object this view refers to.
+     */
+    const FEValuesVectorized &fe_values;
+
+    /**
+     * The selected component.
+     */
+    const unsigned int component;
+  };
+
+  /**
+   * A view of @p dim consecutive components of a vector-valued finite
+   * element, the vectorized counterpart of FEValuesViews::Vector.
+   */
+  class Vector
+  {
+  public:
+    /**
+     * Constructor for an object that represents the components starting at
+     * @p first_component of @p fe_values.
+     */
+    Vector(const FEValuesVectorized &fe_values,
+           const unsigned int        first_component);
+
+    /**
+     * Return the value of the selected components of the shape function
+     * @p i at the quadrature point @p q.
+     */
+    Tensor<1, dim, VectorizedArrayType>
+    value(const unsigned int i, const unsigned int q) const;
+
+    /**
+     * Return the gradient of the selected components of the shape function
+     * @p i at the quadrature point @p q, with the first index running over
+     * the components and the second over the coordinate directions.
+     */
+    Tensor<2, dim, VectorizedArrayType>
+    gradient(const unsigned int i, const unsigned int q) const;
+
+    /**
+     * Return the symmetric gradient of the selected components of the shape
+     * function @p i at the quadrature point @p q.
+     */
+    SymmetricTensor<2, dim, VectorizedArrayType>
+    symmetric_gradient(const unsigned int i, const unsigned int q) const;
+
+    /**
+     * Return the divergence of the selected components of the shape
+     * function @p i at the quadrature point @p q.
+     */
+    VectorizedArrayType
+    divergence(const unsigned int i, const unsigned int q) const;
+
+  private:
+    /**
+     * The object this view refers to.
+     */
+    const FEValuesVectorized &fe_values;
+
+    /**
+     * The first selected component.
+     */
+    const unsigned int first_component;
+  };
+
+  /**
+   * Constructor. Sets up the values and reference gradients of the shape
+   * functions of @p fe in the points of @p quadrature. The @p update_flags
+   * may contain update_values, update_gradients, update_JxW_values,
+   * update_quadrature_points, and update_inverse_jacobians.
+   */
+  FEValuesVectorized(const Mapping<dim> &      mapping,
+                     const FiniteElement<dim> &fe,
+                     const Quadrature<dim> &   quadrature,
+                     const UpdateFlags         update_flags);
+
+  /**
+   * Compute the data for the cells in @p cells, one cell per lane of @p
+   * VectorizedArrayType. At most VectorizedArrayType::size() cells may be
+   * given. The iterators can be of any type that is convertible to a
+   * Triangulation::cell_iterator, e.g. DoFHandler::active_cell_iterator.
+   */
+  template <typename CellIteratorType>
+  void
+  reinit(const std::vector<CellIteratorType> &cells);
+
+  /**
+   * Return the number of lanes filled with cells in the last call to
+   * reinit().
+   */
+  unsigned int
+  n_filled_lanes() const;
+
+  /**
+   * Return the value of the shape function @p i at the quadrature point
+   * @p q. For vector-valued elements, this is the value of the only non-zero
+   * component of the shape function.
+   */
+  VectorizedArrayType
+  shape_value(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the gradient of the shape function @p i at the quadrature point
+   * @p q on the cells of the current batch. For vector-valued elements, this
+   * is the gradient of the only non-zero component of the shape function.
+   */
+  const Tensor<1, dim, VectorizedArrayType> &
+  shape_grad(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the value of the component @p component of the shape function
+   * @p i at the quadrature point @p q.
+   */
+  VectorizedArrayType
+  shape_value_component(const unsigned int i,
+                        const unsigned int q,
+                        const unsigned int component) const;
+
+  /**
+   * Return the gradient of the component @p component of the shape function
+   * @p i at the quadrature point @p q.
+   */
+  Tensor<1, dim, VectorizedArrayType>
+  shape_grad_component(const unsigned int i,
+                       const unsigned int q,
+                       const unsigned int component) const;
+
+  /**
+   * Return the mapped quadrature weight, i.e., the product of the
+   * determinant of the Jacobian and the quadrature weight, at the
+   * quadrature point @p q.
+   */
+  const VectorizedArrayType &
+  JxW(const unsigned int q) const;
+
+  /**
+   * Return the position of the quadrature point @p q in real space.
+   */
+  const Point<dim, VectorizedArrayType> &
+  quadrature_point(const unsigned int q) const;
+
+  /**
+   * Return the inverse of the Jacobian of the mapping at the quadrature
+   * point @p q.
+   */
+  const Tensor<2, dim, VectorizedArrayType> &
+  inverse_jacobian(const unsigned int q) const;
+
+  /**
+   * Create a view of the scalar component selected by @p scalar.
+   */
+  Scalar
+  operator[](const FEValuesExtractors::Scalar &scalar) const;
+
+  /**
+   * Create a view of the vector-valued components selected by @p vector.
+   */
+  Vector
+  operator[](const FEValuesExtractors::Vector &vector) const;
+
+  /**
+   * Return the finite element this object was set up with.
+   */
+  const FiniteElement<dim> &
+  get_fe() const;
+
+  /**
+   * Return the update flags this object was set up with.
+   */
+  UpdateFlags
+  get_update_flags() const;
+
+private:
+  /**
+   * The finite element.
+   */
+  SmartPointer<const FiniteElement<dim>> fe;
+
+  /**
+   * The update flags.
+   */
+  const UpdateFlags update_flags;
+
+  /**
+   * A dummy element to let FEValues only evaluate the mapping.
+   */
+  const FE_Nothing<dim> fe_nothing;
+
+  /**
+   * The FEValues object for evaluating the mapping on the individual cells
+   * of a batch.
+   */
+  FEValues<dim> mapping_values;
+
+  /**
+   * The non-zero component of each shape function.
+   */
+  std::vector<unsigned int> shape_function_component;
+
+  /**
+   * The values of the shape functions in the quadrature points, with the
+   * shape function index running slowest.
+   */
+  Table<2, Number> shape_values;
+
+  /**
+   * The gradients of the shape functions on the reference cell.
+   */
+  Table<2, Tensor<1, dim, Number>> reference_shape_gradients;
+
+  /**
+   * The gradients of the shape functions on the cells of the current batch,
+   * with the shape function index running slowest.
+   */
+  AlignedVector<Tensor<1, dim, VectorizedArrayType>> shape_gradients;
+
+  /**
+   * The JxW values on the cells of the current batch.
+   */
+  AlignedVector<VectorizedArrayType> JxW_values;
+
+  /**
+   * The quadrature points on the cells of the current batch.
+   */
+  AlignedVector<Point<dim, VectorizedArrayType>> quadrature_points;
+
+  /**
+   * The inverse Jacobians on the cells of the current batch.
+   */
+  AlignedVector<Tensor<2, dim, VectorizedArrayType>> inverse_jacobians;
+
+  /**
+   * The number of filled lanes in the current batch.
+   */
+  unsigned int n_lanes_filled;
+};
+
+
+
+#ifndef DOXYGEN
+
+/*---------------------- Inline functions: FEValuesVectorized --------------*/
+
+namespace internal
+{
+  namespace FEValuesVectorizedImplementation
+  {
+    /**
+     * Translate the update flags of FEValuesVectorized into those needed for
+     * the FEValues object that queries the mapping.
+     */
+    inline UpdateFlags
+    mapping_update_flags(const UpdateFlags update_flags)
+    {
+      UpdateFlags flags = update_default;
+      if (update_flags & (update_gradients | update_inverse_jacobians))
+        flags |= update_inverse_jacobians;
+      if (update_flags & update_JxW_values)
+        flags |= update_JxW_values;
+      if (update_flags & update_quadrature_points)
+        flags |= update_quadrature_points;
+      return flags;
+    }
+  } // namespace FEValuesVectorizedImplementation
+} // namespace internal
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline FEValuesVectorized<dim, VectorizedArrayType>::FEValuesVectorized(
+  const Mapping<dim> &      mapping,
+  const FiniteElement<dim> &fe,
+  const Quadrature<dim> &   quadrature,
+  const UpdateFlags         update_flags)
+  : n_quadrature_points(quadrature.size())
+  , dofs_per_cell(fe.dofs_per_cell)
+  , fe(&fe)
+  , update_flags(update_flags)
+  , mapping_values(mapping,
+                   fe_nothing,
+                   quadrature,
+                   internal::FEValuesVectorizedImplementation::
+                     mapping_update_flags(update_flags))
+  , shape_function_component(fe.dofs_per_cell)
+  , n_lanes_filled(0)
+{
+  AssertThrow(fe.is_primitive(),
+              ExcMessage("FEValuesVectorized only supports primitive "
+                         "finite elements."));
+
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    shape_function_component[i] = fe.system_to_component_index(i).first;
+
+  if (update_flags & update_values)
+    {
+      shape_values.reinit(dofs_per_cell, n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          shape_values(i, q) = fe.shape_value(i, quadrature.point(q));
+    }
+  if (update_flags & update_gradients)
+    {
+      reference_shape_gradients.reinit(dofs_per_cell, n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          reference_shape_gradients(i, q) =
+            fe.shape_grad(i, quadrature.point(q));
+      shape_gradients.resize(dofs_per_cell * n_quadrature_points);
+    }
+  if (update_flags & update_JxW_values)
+    JxW_values.resize(n_quadrature_points);
+  if (update_flags & update_quadrature_points)
+    quadrature_points.resize(n_quadrature_points);
+  if (update_flags & (update_gradients | update_inverse_jacobians))
+    inverse_jacobians.resize(n_quadrature_points);
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+template <typename CellIteratorType>
+inline void
+FEValuesVectorized<dim, VectorizedArrayType>::reinit(
+  const std::vector<CellIteratorType> &cells)
+{
+  Assert(cells.size() > 0, ExcMessage("The batch of cells must not be empty"));
+  AssertIndexRange(cells.size(), VectorizedArrayType::size() + 1);
+  n_lanes_filled = cells.size();
+
+  // query the mapping on each cell and fill the remaining lanes with the
+  // data of the last cell
+  for (unsigned int v = 0; v < n_lanes_filled; ++v)
+    {
+      mapping_values.reinit(
+        typename Triangulation<dim>::cell_iterator(cells[v]));
+      const unsigned int n_lanes =
+        (v + 1 == n_lanes_filled) ? VectorizedArrayType::size() - v : 1;
+      for (unsigned int lane = v; lane < v + n_lanes; ++lane)
+        {
+          if (update_flags & update_JxW_values)
+            for (unsigned int q = 0; q < n_quadrature_points; ++q)
+              JxW_values[q][lane] = mapping_values.JxW(q);
+          if (update_flags & update_quadrature_points)
+            for (unsigned int q = 0; q < n_quadrature_points; ++q)
+              for (unsigned int d = 0; d < dim; ++d)
+                quadrature_points[q][d][lane] =
+                  mapping_values.quadrature_point(q)[d];
+          if (update_flags & (update_gradients | update_inverse_jacobians))
+            for (unsigned int q = 0; q < n_quadrature_points; ++q)
+              for (unsigned int d = 0; d < dim; ++d)
+                for (unsigned int e = 0; e < dim; ++e)
+                  inverse_jacobians[q][d][e][lane] =
+                    mapping_values.inverse_jacobian(q)[d][e];
+        }
+    }
+
+  // transform the reference gradients of all shape functions on all cells of
+  // the batch at once: grad_d = sum_e (dx_hat_e / dx_d) d phi / dx_hat_e
+  if (update_flags & update_gradients)
+    for (unsigned int q = 0; q < n_quadrature_points; ++q)
+      {
+        const Tensor<2, dim, VectorizedArrayType> &inv_jac =
+          inverse_jacobians[q];
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const Tensor<1, dim, Number> &ref_grad =
+              reference_shape_gradients(i, q);
+            Tensor<1, dim, VectorizedArrayType> &grad =
+              shape_gradients[i * n_quadrature_points + q];
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                VectorizedArrayType sum = inv_jac[0][d] * ref_grad[0];
+                for (unsigned int e = 1; e < dim; ++e)
+                  sum += inv_jac[e][d] * ref_grad[e];
+                grad[d] = sum;
+              }
+          }
+      }
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline unsigned int
+FEValuesVectorized<dim, VectorizedArrayType>::n_filled_lanes() const
+{
+  return n_lanes_filled;
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline VectorizedArrayType
+FEValuesVectorized<dim, VectorizedArrayType>::shape_value(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  Assert(update_flags & update_values,
+         (typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_values")));
+  return VectorizedArrayType(shape_values(i, q));
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline const Tensor<1, dim, VectorizedArrayType> &
+FEValuesVectorized<dim, VectorizedArrayType>::shape_grad(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  Assert(update_flags & update_gradients,
+         (typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_gradients")));
+  AssertIndexRange(i, dofs_per_cell);
+  AssertIndexRange(q, n_quadrature_points);
+  return shape_gradients[i * n_quadrature_points + q];
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline VectorizedArrayType
+FEValuesVectorized<dim, VectorizedArrayType>::shape_value_component(
+  const unsigned int i,
+  const unsigned int q,
+  const unsigned int component) const
+{
+  AssertIndexRange(component, fe->n_components());
+  if (shape_function_component[i] == component)
+    return shape_value(i, q);
+  else
+    return VectorizedArrayType();
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline Tensor<1, dim, VectorizedArrayType>
+FEValuesVectorized<dim, VectorizedArrayType>::shape_grad_component(
+  const unsigned int i,
+  const unsigned int q,
+  const unsigned int component) const
+{
+  AssertIndexRange(component, fe->n_components());
+  if (shape_function_component[i] == component)
+    return shape_grad(i, q);
+  else
+    return Tensor<1, dim, VectorizedArrayType>();
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline const VectorizedArrayType &
+FEValuesVectorized<dim, VectorizedArrayType>::JxW(const unsigned int q) const
+{
+  Assert(update_flags & update_JxW_values,
+         (typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_JxW_values")));
+  AssertIndexRange(q, n_quadrature_points);
+  return JxW_values[q];
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline const Point<dim, VectorizedArrayType> &
+FEValuesVectorized<dim, VectorizedArrayType>::quadrature_point(
+  const unsigned int q) const
+{
+  Assert(update_flags & update_quadrature_points,
+         (typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_quadrature_points")));
+  AssertIndexRange(q, n_quadrature_points);
+  return quadrature_points[q];
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline const Tensor<2, dim, VectorizedArrayType> &
+FEValuesVectorized<dim, VectorizedArrayType>::inverse_jacobian(
+  const unsigned int q) const
+{
+  Assert(update_flags & (update_gradients | update_inverse_jacobians),
+         (typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_inverse_jacobians")));
+  AssertIndexRange(q, n_quadrature_points);
+  return inverse_jacobians[q];
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline typename FEValuesVectorized<dim, VectorizedArrayType>::Scalar
+FEValuesVectorized<dim, VectorizedArrayType>::
+operator[](const FEValuesExtractors::Scalar &scalar) const
+{
+  return Scalar(*this, scalar.component);
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline typename FEValuesVectorized<dim, VectorizedArrayType>::Vector
+FEValuesVectorized<dim, VectorizedArrayType>::
+operator[](const FEValuesExtractors::Vector &vector) const
+{
+  return Vector(*this, vector.first_vector_component);
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline const FiniteElement<dim> &
+FEValuesVectorized<dim, VectorizedArrayType>::get_fe() const
+{
+  return *fe;
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline UpdateFlags
+FEValuesVectorized<dim, VectorizedArrayType>::get_update_flags() const
+{
+  return update_flags;
+}
+
+
+
+/*------------------ Inline functions: FEValuesVectorized::Scalar ----------*/
+
+template <int dim, typename VectorizedArrayType>
+inline FEValuesVectorized<dim, VectorizedArrayType>::Scalar::Scalar(
+  const FEValuesVectorized &fe_values,
+  const unsigned int        component)
+  : fe_values(fe_values)
+  , component(component)
+{
+  AssertIndexRange(component, fe_values.get_fe().n_components());
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline VectorizedArrayType
+FEValuesVectorized<dim, VectorizedArrayType>::Scalar::value(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  return fe_values.shape_value_component(i, q, component);
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline Tensor<1, dim, VectorizedArrayType>
+FEValuesVectorized<dim, VectorizedArrayType>::Scalar::gradient(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  return fe_values.shape_grad_component(i, q, component);
+}
+
+
+
+/*------------------ Inline functions: FEValuesVectorized::Vector ----------*/
+
+template <int dim, typename VectorizedArrayType>
+inline FEValuesVectorized<dim, VectorizedArrayType>::Vector::Vector(
+  const FEValuesVectorized &fe_values,
+  const unsigned int        first_component)
+  : fe_values(fe_values)
+  , first_component(first_component)
+{
+  AssertIndexRange(first_component + dim - 1,
+                   fe_values.get_fe().n_components());
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline Tensor<1, dim, VectorizedArrayType>
+FEValuesVectorized<dim, VectorizedArrayType>::Vector::value(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  Tensor<1, dim, VectorizedArrayType> result;
+  const unsigned int comp = fe_values.shape_function_component[i];
+  if (comp >= first_component && comp < first_component + dim)
+    result[comp - first_component] = fe_values.shape_value(i, q);
+  return result;
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline Tensor<2, dim, VectorizedArrayType>
+FEValuesVectorized<dim, VectorizedArrayType>::Vector::gradient(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  Tensor<2, dim, VectorizedArrayType> result;
+  const unsigned int comp = fe_values.shape_function_component[i];
+  if (comp >= first_component && comp < first_component + dim)
+    result[comp - first_component] = fe_values.shape_grad(i, q);
+  return result;
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline SymmetricTensor<2, dim, VectorizedArrayType>
+FEValuesVectorized<dim, VectorizedArrayType>::Vector::symmetric_gradient(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  return symmetrize(gradient(i, q));
+}
+
+
+
+template <int dim, typename VectorizedArrayType>
+inline VectorizedArrayType
+FEValuesVectorized<dim, VectorizedArrayType>::Vector::divergence(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  const unsigned int comp = fe_values.shape_function_component[i];
+  if (comp >= first_component && comp < first_component + dim)
+    return fe_values.shape_grad(i, q)[comp - first_component];
+  else
+    return VectorizedArrayType();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -452,6 +452,35 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map multiple points from real to unit coordinates on the given @p cell.
+   * This is the batched counterpart of transform_real_to_unit_cell() and is
+   * meant for situations where many points are to be located in the same
+   * cell, e.g., for all particles stored in one cell.
+   *
+   * The default implementation simply calls transform_real_to_unit_cell()
+   * for each point. Derived classes can provide more efficient
+   * implementations that compute the data associated with the cell only
+   * once and process several points at once.
+   *
+   * @param[in] cell Iterator to the cell that will be used to define the
+   * mapping.
+   * @param[in] real_points Array of points on the given cell.
+   * @param[out] unit_points Array of the reference cell locations of the
+   * points, of the same size as @p real_points. In contrast to
+   * transform_real_to_unit_cell(), this function does not throw an
+   * exception of type Mapping::ExcTransformationFailed if the transformation
+   * of a point fails. Instead, the first coordinate of the respective
+   * unit point is set to <code>std::numeric_limits<double>::infinity()</code>,
+   * which is recognized as being outside the reference cell by
+   * GeometryInfo::is_inside_unit_cell().
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the reference cell, and then project this point to a (dim-1)-dimensional
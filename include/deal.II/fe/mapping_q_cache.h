@@ -26,6 +26,9 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+template <int, int>
+class DoFHandler;
+
 
 
 /*!@addtogroup mapping */
@@ -38,6 +41,13 @@ DEAL_II_NAMESPACE_OPEN
  * which is used in all operations of MappingQGeneric. The information of the
  * mapping is pre-computed by the MappingQCache::initialize() function.
  *
+ * The support points of all cells of one level are stored in a single
+ * contiguous array, avoiding one memory allocation per cell. For an
+ * arbitrary Lagrangian-Eulerian (ALE) setting in which the mesh moves by a
+ * displacement field, the cached points can be updated by
+ * MappingQCache::update_with_displacement() without evaluating the
+ * manifold description of the geometry again.
+ *
  * The use of this class is discussed extensively in step-65.
  */
 template <int dim, int spacedim = dim>
@@ -111,6 +121,34 @@ public:
                const typename Triangulation<dim, spacedim>::cell_iterator &)>
                &compute_points_on_cell);
 
+  /**
+   * Update the cached support points of all active cells by adding the
+   * displacement field given by the finite element vector @p displacement
+   * defined on @p dof_handler. The first @p spacedim components of the
+   * finite element of @p dof_handler are interpreted as the displacement.
+   * The displacement is always added to the support points that were
+   * computed by the last call to initialize() (and not to the result of a
+   * previous displacement), so that this function can be called repeatedly
+   * for a moving mesh, e.g., once per time step. The computation only
+   * evaluates the displacement field in the support points and does not
+   * query the manifolds of the triangulation, and is typically much cheaper
+   * than calling initialize() again.
+   *
+   * The support points of cells that are not active are left unchanged.
+   * For parallel vectors, @p displacement needs to have its ghost values
+   * set on all locally relevant DoFs.
+   *
+   * @note The first call to this function after initialize() stores a copy
+   * of the support points computed by initialize(), which doubles the
+   * memory consumption of this class.
+   *
+   * @note If multiple threads are enabled, this function runs in parallel.
+   */
+  template <typename VectorType>
+  void
+  update_with_displacement(const DoFHandler<dim, spacedim> &dof_handler,
+                           const VectorType &               displacement);
+
   /**
    * Return the memory consumption (in bytes) of the cache.
    */
@@ -128,13 +166,30 @@ protected:
 
 private:
   /**
-   * The point cache filled upon calling initialize(). It is made a shared
-   * pointer to allow several instances (created via clone()) to share this
-   * cache.
+   * Return the number of support points of a cell, $(p+1)^\text{dim}$.
+   */
+  unsigned int
+  n_support_points() const;
+
+  /**
+   * The point cache filled upon calling initialize(). The outer index runs
+   * over the levels of the triangulation, and the support points of the cell
+   * with index `c` on a level are stored contiguously starting at position
+   * `c * n_support_points()`. It is made a shared pointer to allow several
+   * instances (created via clone()) to share this cache.
    */
-  std::shared_ptr<std::vector<std::vector<std::vector<Point<spacedim>>>>>
+  std::shared_ptr<std::vector<std::vector<Point<spacedim>>>>
     support_point_cache;
 
+  /**
+   * The support points computed by initialize(), in the same layout as
+   * #support_point_cache. This field is only filled once
+   * update_with_displacement() has been called, and serves as the reference
+   * configuration to which the displacement is added.
+   */
+  std::shared_ptr<std::vector<std::vector<Point<spacedim>>>>
+    reference_support_point_cache;
+
   /**
    * The connection to Triangulation::signals::any that must be reset once
    * this class goes out of scope.
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/derivative_form.h>
+#include <deal.II/base/polynomial.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/vectorization.h>
@@ -41,6 +42,9 @@ class MappingQ;
 template <int, int>
 class MappingQCache;
 
+template <int, int, int, typename>
+class FEPointEvaluation;
+
 
 /*!@addtogroup mapping */
 /*@{*/
@@ -180,6 +184,27 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &p) const override;
 
+  /**
+   * Map multiple points from real to unit coordinates on the given @p cell,
+   * see Mapping::transform_points_real_to_unit_cell() for the interface.
+   *
+   * For dim==spacedim, this function computes the support points of the
+   * mapping on @p cell only once. If the cell is the affine image of the
+   * reference cell (i.e., a parallelogram or parallelepiped also in terms
+   * of the interior support points for higher order mappings), the inverse
+   * of the affine map is applied to all points directly. Otherwise, a Newton
+   * iteration is run on VectorizedArray::size() points at once, using the
+   * sum-factorized evaluation of the mapping and its gradient. Points for
+   * which this iteration does not converge are passed to
+   * transform_real_to_unit_cell(), which uses a more robust but slower
+   * algorithm.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const override;
+
   /**
    * @}
    */
@@ -277,6 +302,23 @@ public:
                     const Quadrature<dim> &quadrature,
                     const unsigned int     n_original_q_points);
 
+    /**
+     * Set up the data for evaluating the mapping on faces with sum
+     * factorization, using the face quadrature formula @p quadrature and
+     * its projection @p all_faces_quadrature to all faces of the reference
+     * cell as given by QProjector::project_to_all_faces(). This is only done
+     * if @p quadrature is the tensor product of a one-dimensional formula
+     * whose points are mapped onto each other by all face orientations, and
+     * if no derivatives of the Jacobian are requested by the update flags
+     * passed to initialize_face() before; otherwise, the member variables
+     * set up here stay empty and the evaluation on faces uses the full
+     * tables of #shape_values and #shape_derivatives.
+     */
+    void
+    initialize_face_tensor_product(
+      const Quadrature<dim - 1> &quadrature,
+      const Quadrature<dim> &    all_faces_quadrature);
+
     /**
      * Compute the values and/or derivatives of the shape functions used for
      * the mapping.
@@ -491,6 +533,57 @@ public:
      */
     bool tensor_product_quadrature;
 
+    /**
+     * In case the face quadrature formula is a tensor product (see
+     * initialize_face_tensor_product()), the values of the one-dimensional
+     * shape functions of the mapping in the points of the one-dimensional
+     * quadrature formula, with the index of the shape function running
+     * fastest. Empty otherwise.
+     */
+    std::vector<double> face_shape_values_1d;
+
+    /**
+     * Same as #face_shape_values_1d, but for the derivatives of the
+     * one-dimensional shape functions.
+     */
+    std::vector<double> face_shape_derivatives_1d;
+
+    /**
+     * The values of the one-dimensional shape functions of the mapping at
+     * the two end points 0 and 1 of the unit interval, with the index of the
+     * shape function running fastest. Only filled together with
+     * #face_shape_values_1d.
+     */
+    std::vector<double> end_point_shape_values_1d;
+
+    /**
+     * Same as #end_point_shape_values_1d, but for the derivatives of the
+     * one-dimensional shape functions.
+     */
+    std::vector<double> end_point_shape_derivatives_1d;
+
+    /**
+     * For the data set of each face and face orientation in the projected
+     * face quadrature formula (see QProjector::DataSetDescriptor), the index
+     * of the point of the face quadrature formula at each position of the
+     * tensor-product grid of points on that face, in lexicographic order.
+     * Only filled together with #face_shape_values_1d.
+     */
+    std::vector<unsigned int> face_tensor_quadrature_numbering;
+
+    /**
+     * The renumbering from the lexicographic order of the mapping support
+     * points to their hierarchical order. Only filled together with
+     * #face_shape_values_1d.
+     */
+    std::vector<unsigned int> face_lexicographic_numbering;
+
+    /**
+     * Temporary storage for the evaluation of the mapping on faces with sum
+     * factorization.
+     */
+    mutable std::vector<Tensor<1, spacedim>> face_scratch;
+
     /**
      * Tensors of covariant transformation at each of the quadrature points.
      * The matrix stored is the Jacobian * G^{-1}, where G = Jacobian^{t} *
@@ -642,6 +735,21 @@ protected:
    */
   Table<2, double> support_point_weights_cell;
 
+  /**
+   * The one-dimensional Lagrange polynomials on the points of
+   * line_support_points, whose tensor product spans the space of the
+   * mapping. Used for the sum-factorized evaluation of the mapping in
+   * transform_points_real_to_unit_cell().
+   */
+  std::vector<Polynomials::Polynomial<double>> polynomials_1d;
+
+  /**
+   * The numbering of the support points returned by
+   * compute_mapping_support_points() in lexicographic order, i.e., entry
+   * @p i holds the position of the @p i-th lexicographic support point.
+   */
+  std::vector<unsigned int> renumber_lexicographic_to_hierarchic;
+
   /**
    * Return the locations of support points for the mapping. For example, for
    * $Q_1$ mappings these are the vertices, and for higher order polynomial
@@ -731,6 +839,11 @@ protected:
   // compute_mapping_support_points() function.
   template <int, int>
   friend class MappingQCache;
+
+  // Make FEPointEvaluation a friend since it needs to call the
+  // compute_mapping_support_points() function.
+  template <int, int, int, typename>
+  friend class FEPointEvaluation;
 };
 
 
@@ -497,10 +497,16 @@ public:
   read_xda(std::istream &in);
 
   /**
-   * Read grid data from an msh file, either version 1 or version 2 of that
-   * file format. The %Gmsh formats are documented at
+   * Read grid data from an msh file, in one of the versions 1, 2, or 4 of
+   * that file format. The %Gmsh formats are documented at
    * http://www.gmsh.info/.
    *
+   * Besides the ASCII variant, the binary variant of version 4.1 of the
+   * format is supported, which is considerably faster to read for large
+   * meshes. Binary files can only be read on machines with the same
+   * endianness and sizes of the data types as the machine that has
+   * written them.
+   *
    * @note The input function of deal.II does not distinguish between newline
    * and other whitespace. Therefore, deal.II will be able to read files in a
    * slightly more general format than %Gmsh.
@@ -1355,6 +1355,31 @@ public:
                                   const bool         view_levels = false,
                                   const bool include_artificial  = false) const;
 
+  /**
+   * Write the triangulation in VTU format into the single file @p filename
+   * from all processes at once. If @p tria is a parallel triangulation,
+   * every process only converts its locally owned active cells and all
+   * processes write their pieces at the same time into the file using
+   * MPI-IO, see DataOutBase::write_vtu_in_parallel(). Consequently, the
+   * mesh never needs to be gathered on a single process, and ghost and
+   * artificial cells do not appear in the output. For a serial
+   * triangulation, the function writes all active cells.
+   *
+   * In addition to the attributes written by write_vtu(), namely level,
+   * manifold, material, subdomain, and level_subdomain, the file contains
+   * a field <tt>boundary</tt> that holds the boundary id at the vertices of
+   * the boundary faces of each cell and -1 at all other vertices. As for all
+   * VTU output, the data is written in binary (base64 encoded) format,
+   * compressed according to the compression level of the vtu flags.
+   *
+   * This function is collective over the communicator of @p tria and has to
+   * be called on all processes.
+   */
+  template <int dim, int spacedim>
+  void
+  write_vtu_in_parallel(const Triangulation<dim, spacedim> &tria,
+                        const std::string &                 filename) const;
+
   /**
    * Write grid to @p out according to the given data format. This function
    * simply calls the appropriate <tt>write_*</tt> function.
@@ -21,6 +21,7 @@
 
 #  include <deal.II/base/bounding_box.h>
 #  include <deal.II/base/geometry_info.h>
+#  include <deal.II/base/smartpointer.h>
 #  include <deal.II/base/std_cxx17/optional.h>
 
 #  include <deal.II/boost_adaptors/bounding_box.h>
@@ -59,6 +60,7 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #  include <bitset>
 #  include <list>
 #  include <set>
+#  include <type_traits>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -1311,6 +1313,39 @@ namespace GridTools
     const double                   tolerance       = 1e-10,
     const std::vector<bool> &      marked_vertices = {});
 
+  /**
+   * Find all active cells around each of the given @p points, in the sense
+   * of find_all_active_cells_around_point(), using the tree of the cell
+   * bounding boxes provided by
+   * GridTools::Cache::get_cell_bounding_boxes_rtree() instead of a walk over
+   * adjacent cells starting from the closest vertex.
+   *
+   * The candidate cells of all points are collected first, and then the
+   * points of each candidate cell are transformed to unit coordinates at
+   * once with Mapping::transform_points_real_to_unit_cell(). Both steps run
+   * in parallel on several threads. This makes the function much faster than
+   * repeated calls to find_all_active_cells_around_point() when many points
+   * need to be located.
+   *
+   * The i-th entry of the returned vector contains the pairs of cells and
+   * unit coordinates of the i-th point, and is empty if the point is not
+   * within any cell of the triangulation. Artificial cells are not
+   * considered. The cells of a point are sorted in the order of
+   * the cell iterators.
+   *
+   * @note A point is only found in a cell if it lies within the bounding box
+   * returned by Mapping::get_bounding_box() for that cell, even if it is
+   * within the given @p tolerance (in unit coordinates) of the cell.
+   */
+  template <int dim, int spacedim>
+  std::vector<std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>>
+  find_all_active_cells_around_points(
+    const Cache<dim, spacedim> &        cache,
+    const std::vector<Point<spacedim>> &points,
+    const double                        tolerance = 1e-10);
+
   /**
    * Return a list of all descendants of the given cell that are active. For
    * example, if the current cell is once refined but none of its children are
@@ -1726,6 +1761,26 @@ namespace GridTools
     std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>>
   vertex_to_cell_map(const Triangulation<dim, spacedim> &triangulation);
 
+  /**
+   * Return the same information as vertex_to_cell_map(), but in compressed
+   * (CSR-like) form: the cells adjacent to vertex <code>v</code> are stored
+   * in the entries <code>result.second[result.first[v]]</code> to
+   * <code>result.second[result.first[v+1]-1]</code>, in the same order in
+   * which they would appear in the corresponding std::set returned by
+   * vertex_to_cell_map(). The first vector of the result therefore has
+   * Triangulation::n_vertices()+1 entries.
+   *
+   * Compared to vertex_to_cell_map(), this layout avoids one memory
+   * allocation per vertex-cell pair, uses considerably less memory, and
+   * allows constant-time access to the $i$th cell adjacent to a vertex.
+   */
+  template <int dim, int spacedim>
+  std::pair<
+    std::vector<unsigned int>,
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
+  compressed_vertex_to_cell_map(
+    const Triangulation<dim, spacedim> &triangulation);
+
   /**
    * Return a vector of normalized tensors for each vertex-cell combination of
    * the output of GridTools::vertex_to_cell_map() (which is expected as input
@@ -1960,6 +2015,36 @@ namespace GridTools
                           const SparsityTools::Partitioner partitioner =
                             SparsityTools::Partitioner::metis);
 
+  /**
+   * Generate a partitioning of the active cells of @p triangulation with the
+   * parallel graph partitioner ParMETIS, using the processes of
+   * @p mpi_communicator. This function is meant for triangulations that are
+   * stored in their entirety on every process, like
+   * parallel::shared::Triangulation, and must be called on all processes of
+   * @p mpi_communicator with the same triangulation.
+   *
+   * As opposed to partition_triangulation(), the cell connectivity graph is
+   * never built in its entirety: every process only sets up the rows of the
+   * graph for a contiguous range of the active cells, and the graph is
+   * partitioned in parallel. Only the resulting subdomain ids are
+   * communicated to all processes.
+   *
+   * If @p cell_weights is empty, the weights are taken from the
+   * Triangulation::Signals::cell_weight signal if a function is connected
+   * to it, or otherwise all cells have the same weight. If not, its size
+   * must equal the number of active cells.
+   *
+   * @note This function requires deal.II to be configured with METIS and
+   * MPI, and METIS to be installed together with ParMETIS.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_parmetis(
+    const unsigned int               n_partitions,
+    const std::vector<unsigned int> &cell_weights,
+    Triangulation<dim, spacedim> &   triangulation,
+    const MPI_Comm &                 mpi_communicator);
+
   /**
    * Generates a partitioning of the active cells making up the entire domain
    * using the same partitioning scheme as in the p4est library if the flag
@@ -1980,6 +2065,36 @@ namespace GridTools
                                  Triangulation<dim, spacedim> &triangulation,
                                  const bool group_siblings = true);
 
+  /**
+   * This function performs the same operation as the one above, except that
+   * it balances several weights per cell at the same time, e.g., the number
+   * of degrees of freedom and the number of particles of each cell. The
+   * entry <code>cell_weights[c][i]</code> denotes the weight of the
+   * constraint @p c on the active cell with active_cell_index() @p i.
+   *
+   * Each constraint is normalized by its sum over all cells, and the
+   * normalized weights are added up to one combined weight per cell. The
+   * space-filling curve is then cut into @p n_partitions pieces of equal
+   * combined weight. This function can be registered as partitioner of a
+   * parallel::fullydistributed::Triangulation via a lambda function. The
+   * balance that has been reached for the individual constraints can be
+   * assessed with
+   * parallel::TriangulationBase::compute_cell_weight_statistics().
+   *
+   * @note If the @p cell_weights vector is empty, then no weighting is taken
+   * into consideration and the result is the same as for the function above.
+   * If not, then the size of each of its entries must equal the number of
+   * active cells in the triangulation. If the number of cells should be
+   * balanced as well, add a constraint with the weight one on every cell.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_zorder(
+    const unsigned int                            n_partitions,
+    const std::vector<std::vector<unsigned int>> &cell_weights,
+    Triangulation<dim, spacedim> &                triangulation,
+    const bool                                    group_siblings = true);
+
   /**
    * Partitions the cells of a multigrid hierarchy by assigning level subdomain
    * ids using the "youngest child" rule, that is, each cell in the hierarchy is
@@ -2824,6 +2939,171 @@ namespace GridTools
     const std::function<void(const typename MeshType::active_cell_iterator &,
                              const DataType &)> &        unpack);
 
+  /**
+   * A class that exchanges data of a fixed size between the locally owned
+   * cells of a parallel triangulation and the corresponding ghost cells on
+   * other processes, like exchange_cell_data_to_ghosts(), but for the case
+   * that the same exchange is done many times (e.g., once per time step) on
+   * the same mesh.
+   *
+   * The constructor determines once which locally owned cells are ghost
+   * cells on which other process, and which ghost cells are received from
+   * which process. The exchange then only sends the raw data of the cells,
+   * without the cell ids, and packs it directly into buffers that are kept
+   * between exchanges. The lists of cells are recomputed automatically
+   * (which requires communication) at the next exchange after the
+   * triangulation has changed.
+   *
+   * The exchange is split into start_exchange() and finish_exchange(), so
+   * that computations can be done while the data is in transit:
+   * @code
+   * GridTools::CellDataExchanger<double, DoFHandler<dim>> exchanger(
+   *   dof_handler);
+   * ...
+   * exchanger.start_exchange([&](const auto &cell) {
+   *   return material_data[cell->active_cell_index()];
+   * });
+   * // ... work on locally owned cells ...
+   * exchanger.finish_exchange(
+   *   [&](const auto &cell, const double value) {
+   *     material_data[cell->active_cell_index()] = value;
+   *   });
+   * @endcode
+   * The data of all locally owned cells that are ghost cells elsewhere is
+   * sent, i.e., there is no possibility to skip cells as with the
+   * std_cxx17::optional return value of exchange_cell_data_to_ghosts().
+   *
+   * @tparam DataType The type of the data to be exchanged. It must be
+   *   trivially copyable, since it is sent as raw bytes.
+   * @tparam MeshType The type of the mesh, see exchange_cell_data_to_ghosts().
+   *
+   * @note All member functions that communicate are collective over the
+   *   communicator of the triangulation. If several objects of this class
+   *   are used on the same triangulation at the same time, the exchanges
+   *   must be started in the same order on all processes.
+   */
+  template <typename DataType, typename MeshType>
+  class CellDataExchanger
+  {
+  public:
+    static_assert(std::is_trivially_copyable<DataType>::value,
+                  "The data type to be exchanged must be trivially copyable.");
+
+    /**
+     * The type of the cell iterators passed to the pack and unpack
+     * functions.
+     */
+    using active_cell_iterator = typename MeshType::active_cell_iterator;
+
+    /**
+     * Constructor. Set up the lists of cells to be sent and received, which
+     * is a collective operation.
+     */
+    CellDataExchanger(const MeshType &mesh);
+
+    /**
+     * Destructor.
+     */
+    ~CellDataExchanger();
+
+    /**
+     * Call @p pack on all locally owned cells that are ghost cells on some
+     * other process and start sending the data. Every call must be followed
+     * by a call to finish_exchange() before the next exchange can start.
+     */
+    void
+    start_exchange(
+      const std::function<DataType(const active_cell_iterator &)> &pack);
+
+    /**
+     * Wait for the data started with start_exchange() and call @p unpack
+     * for each ghost cell with the data of the owning process. The data of
+     * each process is unpacked as soon as it arrives.
+     */
+    void
+    finish_exchange(
+      const std::function<void(const active_cell_iterator &, const DataType &)>
+        &unpack);
+
+    /**
+     * Do a complete exchange, i.e., call start_exchange() and
+     * finish_exchange().
+     */
+    void
+    exchange(
+      const std::function<DataType(const active_cell_iterator &)> &pack,
+      const std::function<void(const active_cell_iterator &, const DataType &)>
+        &unpack);
+
+  private:
+    /**
+     * Compute the lists of cells to be sent and received.
+     */
+    void
+    setup();
+
+    /**
+     * The mesh.
+     */
+    SmartPointer<const MeshType, CellDataExchanger<DataType, MeshType>> mesh;
+
+    /**
+     * The ranks of the processes we exchange data with, i.e., the owners of
+     * our ghost cells.
+     */
+    std::vector<unsigned int> neighbor_ranks;
+
+    /**
+     * The locally owned cells to be sent to each process in
+     * neighbor_ranks.
+     */
+    std::vector<std::vector<active_cell_iterator>> send_cells;
+
+    /**
+     * The ghost cells received from each process in neighbor_ranks, in the
+     * order in which the data is sent.
+     */
+    std::vector<std::vector<active_cell_iterator>> receive_cells;
+
+    /**
+     * The buffers for the data to be sent to each process.
+     */
+    std::vector<std::vector<DataType>> send_buffers;
+
+    /**
+     * The buffers for the data received from each process.
+     */
+    std::vector<std::vector<DataType>> receive_buffers;
+
+#  ifdef DEAL_II_WITH_MPI
+    /**
+     * The requests of the sends of the current exchange.
+     */
+    std::vector<MPI_Request> send_requests;
+
+    /**
+     * The requests of the receives of the current exchange.
+     */
+    std::vector<MPI_Request> receive_requests;
+#  endif
+
+    /**
+     * Whether an exchange has been started but not yet finished.
+     */
+    bool exchange_is_active;
+
+    /**
+     * Whether the lists of cells must be recomputed because the
+     * triangulation has changed.
+     */
+    bool cell_lists_are_outdated;
+
+    /**
+     * The connection to Triangulation::signals::any_change.
+     */
+    boost::signals2::connection tria_listener;
+  };
+
   /* Exchange with all processors of the MPI communicator @p mpi_communicator the vector of bounding
    * boxes @p local_bboxes.
    *
@@ -4008,6 +4288,283 @@ namespace GridTools
       }
 #    endif // DEAL_II_WITH_MPI
   }
+
+
+  template <typename DataType, typename MeshType>
+  CellDataExchanger<DataType, MeshType>::CellDataExchanger(
+    const MeshType &mesh)
+    : mesh(&mesh)
+    , exchange_is_active(false)
+    , cell_lists_are_outdated(true)
+  {
+    tria_listener = mesh.get_triangulation().signals.any_change.connect(
+      [this]() { cell_lists_are_outdated = true; });
+    setup();
+  }
+
+
+
+  template <typename DataType, typename MeshType>
+  CellDataExchanger<DataType, MeshType>::~CellDataExchanger()
+  {
+    tria_listener.disconnect();
+  }
+
+
+
+  template <typename DataType, typename MeshType>
+  void
+  CellDataExchanger<DataType, MeshType>::setup()
+  {
+#    ifndef DEAL_II_WITH_MPI
+    Assert(false,
+           ExcMessage("GridTools::CellDataExchanger requires MPI."));
+#    else
+    constexpr int dim      = MeshType::dimension;
+    constexpr int spacedim = MeshType::space_dimension;
+    const auto    tria =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+        &mesh->get_triangulation());
+    Assert(
+      tria != nullptr,
+      ExcMessage(
+        "The class CellDataExchanger only works with parallel triangulations."));
+
+    const std::set<types::subdomain_id> ghost_owners = tria->ghost_owners();
+    neighbor_ranks.assign(ghost_owners.begin(), ghost_owners.end());
+    const unsigned int n_neighbors = neighbor_ranks.size();
+
+    // determine the cells to be sent in the same way as in
+    // exchange_cell_data_to_ghosts()
+    std::map<types::subdomain_id, unsigned int> rank_to_index;
+    for (unsigned int i = 0; i < n_neighbors; ++i)
+      rank_to_index[neighbor_ranks[i]] = i;
+
+    send_cells.clear();
+    send_cells.resize(n_neighbors);
+    std::vector<std::vector<CellId::binary_type>> send_ids(n_neighbors);
+
+    const std::map<unsigned int, std::set<types::subdomain_id>>
+      vertices_with_ghost_neighbors =
+        GridTools::compute_vertices_with_ghost_neighbors(*tria);
+
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          std::set<types::subdomain_id> send_to;
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            {
+              const auto neighbor_subdomains_of_vertex =
+                vertices_with_ghost_neighbors.find(cell->vertex_index(v));
+              if (neighbor_subdomains_of_vertex !=
+                  vertices_with_ghost_neighbors.end())
+                send_to.insert(neighbor_subdomains_of_vertex->second.begin(),
+                               neighbor_subdomains_of_vertex->second.end());
+            }
+
+          for (const auto subdomain : send_to)
+            {
+              const auto index = rank_to_index.find(subdomain);
+              Assert(index != rank_to_index.end(), ExcInternalError());
+              send_cells[index->second].emplace_back(tria,
+                                                     cell->level(),
+                                                     cell->index(),
+                                                     &*mesh);
+              send_ids[index->second].push_back(
+                cell->id().template to_binary<dim>());
+            }
+        }
+
+    // send the ids of the cells once, so that the exchanges only need to
+    // send the data
+    const MPI_Comm comm    = tria->get_communicator();
+    const int      mpi_tag = Utilities::MPI::internal::Tags::
+      grid_tools_cell_data_exchanger_setup;
+
+    std::vector<MPI_Request> requests(n_neighbors);
+    for (unsigned int i = 0; i < n_neighbors; ++i)
+      {
+        const int ierr =
+          MPI_Isend(send_ids[i].data(),
+                    send_ids[i].size() * sizeof(CellId::binary_type),
+                    MPI_BYTE,
+                    neighbor_ranks[i],
+                    mpi_tag,
+                    comm,
+                    &requests[i]);
+        AssertThrowMPI(ierr);
+      }
+
+    receive_cells.clear();
+    receive_cells.resize(n_neighbors);
+    std::vector<CellId::binary_type> receive_ids;
+    for (unsigned int i = 0; i < n_neighbors; ++i)
+      {
+        MPI_Status status;
+        int ierr = MPI_Probe(neighbor_ranks[i], mpi_tag, comm, &status);
+        AssertThrowMPI(ierr);
+
+        int len;
+        ierr = MPI_Get_count(&status, MPI_BYTE, &len);
+        AssertThrowMPI(ierr);
+        Assert(len % sizeof(CellId::binary_type) == 0, ExcInternalError());
+
+        receive_ids.resize(len / sizeof(CellId::binary_type));
+        ierr = MPI_Recv(receive_ids.data(),
+                        len,
+                        MPI_BYTE,
+                        neighbor_ranks[i],
+                        mpi_tag,
+                        comm,
+                        MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        receive_cells[i].reserve(receive_ids.size());
+        for (const auto &id : receive_ids)
+          {
+            const typename Triangulation<dim, spacedim>::cell_iterator
+              tria_cell = CellId(id).to_cell(*tria);
+            receive_cells[i].emplace_back(tria,
+                                          tria_cell->level(),
+                                          tria_cell->index(),
+                                          &*mesh);
+          }
+      }
+
+    if (n_neighbors > 0)
+      {
+        const int ierr =
+          MPI_Waitall(n_neighbors, requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    send_buffers.resize(n_neighbors);
+    receive_buffers.resize(n_neighbors);
+    for (unsigned int i = 0; i < n_neighbors; ++i)
+      {
+        send_buffers[i].resize(send_cells[i].size());
+        receive_buffers[i].resize(receive_cells[i].size());
+      }
+    send_requests.resize(n_neighbors);
+    receive_requests.resize(n_neighbors);
+
+    cell_lists_are_outdated = false;
+#    endif
+  }
+
+
+
+  template <typename DataType, typename MeshType>
+  void
+  CellDataExchanger<DataType, MeshType>::start_exchange(
+    const std::function<DataType(const active_cell_iterator &)> &pack)
+  {
+    Assert(exchange_is_active == false,
+           ExcMessage("The previous exchange has not been finished yet."));
+#    ifndef DEAL_II_WITH_MPI
+    (void)pack;
+    Assert(false,
+           ExcMessage("GridTools::CellDataExchanger requires MPI."));
+#    else
+    if (cell_lists_are_outdated)
+      setup();
+
+    const MPI_Comm comm =
+      dynamic_cast<
+        const parallel::TriangulationBase<MeshType::dimension,
+                                          MeshType::space_dimension> &>(
+        mesh->get_triangulation())
+        .get_communicator();
+    const int mpi_tag =
+      Utilities::MPI::internal::Tags::grid_tools_cell_data_exchanger;
+
+    // post the receives first, so that MPI can place the data directly into
+    // the receive buffers
+    for (unsigned int i = 0; i < neighbor_ranks.size(); ++i)
+      {
+        const int ierr =
+          MPI_Irecv(receive_buffers[i].data(),
+                    receive_buffers[i].size() * sizeof(DataType),
+                    MPI_BYTE,
+                    neighbor_ranks[i],
+                    mpi_tag,
+                    comm,
+                    &receive_requests[i]);
+        AssertThrowMPI(ierr);
+      }
+
+    for (unsigned int i = 0; i < neighbor_ranks.size(); ++i)
+      {
+        for (unsigned int c = 0; c < send_cells[i].size(); ++c)
+          send_buffers[i][c] = pack(send_cells[i][c]);
+
+        const int ierr = MPI_Isend(send_buffers[i].data(),
+                                   send_buffers[i].size() * sizeof(DataType),
+                                   MPI_BYTE,
+                                   neighbor_ranks[i],
+                                   mpi_tag,
+                                   comm,
+                                   &send_requests[i]);
+        AssertThrowMPI(ierr);
+      }
+
+    exchange_is_active = true;
+#    endif
+  }
+
+
+
+  template <typename DataType, typename MeshType>
+  void
+  CellDataExchanger<DataType, MeshType>::finish_exchange(
+    const std::function<void(const active_cell_iterator &, const DataType &)>
+      &unpack)
+  {
+    Assert(exchange_is_active == true,
+           ExcMessage("There is no exchange to be finished. You need to call "
+                      "start_exchange() first."));
+#    ifndef DEAL_II_WITH_MPI
+    (void)unpack;
+#    else
+    // unpack the data in the order in which it arrives
+    for (unsigned int n = 0; n < neighbor_ranks.size(); ++n)
+      {
+        int       i;
+        const int ierr = MPI_Waitany(receive_requests.size(),
+                                     receive_requests.data(),
+                                     &i,
+                                     MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+        AssertIndexRange(i, neighbor_ranks.size());
+
+        for (unsigned int c = 0; c < receive_cells[i].size(); ++c)
+          unpack(receive_cells[i][c], receive_buffers[i][c]);
+      }
+
+    if (send_requests.size() > 0)
+      {
+        const int ierr = MPI_Waitall(send_requests.size(),
+                                     send_requests.data(),
+                                     MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    exchange_is_active = false;
+#    endif
+  }
+
+
+
+  template <typename DataType, typename MeshType>
+  void
+  CellDataExchanger<DataType, MeshType>::exchange(
+    const std::function<DataType(const active_cell_iterator &)> &pack,
+    const std::function<void(const active_cell_iterator &, const DataType &)>
+      &unpack)
+  {
+    start_exchange(pack);
+    finish_exchange(unpack);
+  }
 } // namespace GridTools
 
 #  endif
@@ -59,7 +59,9 @@ namespace GridTools
    * vertices through its own transformation, or because you manually change
    * some vertex locations, then some of the structures in this class become
    * obsolete, and you will have to mark them as outdated, by calling the
-   * method mark_for_update() manually.
+   * method mark_for_update() manually. If only some vertices move while the
+   * connectivity of the mesh stays the same, calling mark_vertices_moved()
+   * instead allows the cached RTree objects to be updated incrementally.
    */
   template <int dim, int spacedim = dim>
   class Cache : public Subscriptor
@@ -96,6 +98,34 @@ namespace GridTools
     void
     mark_for_update(const CacheUpdateFlags &flags = update_all);
 
+    /**
+     * Notify this object that the vertices flagged in @p moved_vertices have
+     * changed their location, e.g., because they were moved by an arbitrary
+     * Lagrangian-Eulerian scheme or because the mapping passed at
+     * construction time sees them through a different displacement, while
+     * the topology of the Triangulation remained the same.
+     *
+     * In contrast to calling mark_for_update() with the corresponding flags,
+     * this function keeps all objects that only depend on the connectivity
+     * of the mesh (like the ones returned by get_vertex_to_cell_map() and
+     * get_compressed_vertex_to_cell_map()). The RTree objects returned by
+     * get_used_vertices_rtree() and get_cell_bounding_boxes_rtree() as well
+     * as the map returned by get_used_vertices() are updated incrementally
+     * the next time they are requested: only the entries of moved vertices
+     * and the bounding boxes of cells adjacent to them are replaced. If a
+     * large fraction of the cells is affected, the cell bounding box tree is
+     * rebuilt from scratch instead, since packing all boxes at once yields a
+     * tree of higher quality. All other objects depending on vertex
+     * locations are marked for update.
+     *
+     * Like mark_for_update(), this function does not perform any work by
+     * itself. The vector @p moved_vertices must have
+     * Triangulation::n_vertices() entries. Calls to this function accumulate
+     * until the next time the updated objects are requested.
+     */
+    void
+    mark_vertices_moved(const std::vector<bool> &moved_vertices);
+
 
     /**
      * Return the cached vertex_to_cell_map as computed by
@@ -105,9 +135,29 @@ namespace GridTools
       std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>> &
     get_vertex_to_cell_map() const;
 
+    /**
+     * Return the cached vertex to cell map in compressed form, as computed
+     * by GridTools::compressed_vertex_to_cell_map(). The cells adjacent to
+     * vertex <code>v</code> are
+     * <code>result.second[result.first[v]]</code> to
+     * <code>result.second[result.first[v+1]-1]</code>.
+     *
+     * This object contains the same information as the one returned by
+     * get_vertex_to_cell_map(), but is cheaper to build, uses less memory,
+     * and provides constant-time access to each adjacent cell.
+     */
+    const std::pair<
+      std::vector<unsigned int>,
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      &
+      get_compressed_vertex_to_cell_map() const;
+
     /**
      * Return the cached vertex_to_cell_centers_directions as computed by
-     * GridTools::vertex_to_cell_centers_directions().
+     * GridTools::vertex_to_cell_centers_directions(). The $c$th entry for a
+     * vertex refers to the $c$th cell adjacent to that vertex, both in the
+     * object returned by get_vertex_to_cell_map() and in the one returned by
+     * get_compressed_vertex_to_cell_map().
      */
     const std::vector<std::vector<Tensor<1, spacedim>>> &
     get_vertex_to_cell_centers_directions() const;
@@ -175,11 +225,36 @@ namespace GridTools
     get_covering_rtree() const;
 
   private:
+    /**
+     * Build the RTree of cell bounding boxes from scratch.
+     */
+    void
+    build_cell_bounding_boxes_rtree() const;
+
+    /**
+     * Replace the entries of moved vertices in the map of used vertices and
+     * in the RTree of used vertices, as requested by mark_vertices_moved().
+     */
+    void
+    update_moved_used_vertices() const;
+
     /**
      * Keep track of what needs to be updated next.
      */
     mutable CacheUpdateFlags update_flags;
 
+    /**
+     * Vertices that have moved since the RTree of cell bounding boxes was
+     * last updated, or an empty vector if no vertex has moved.
+     */
+    mutable std::vector<bool> moved_vertices_cell_bounding_boxes;
+
+    /**
+     * Vertices that have moved since the map and the RTree of used vertices
+     * were last updated, or an empty vector if no vertex has moved.
+     */
+    mutable std::vector<bool> moved_vertices_used_vertices;
+
     /**
      * A pointer to the Triangulation.
      */
@@ -199,6 +274,15 @@ namespace GridTools
       std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>>
       vertex_to_cells;
 
+    /**
+     * Store the compressed vertex to cell map, as generated by
+     * GridTools::compressed_vertex_to_cell_map().
+     */
+    mutable std::pair<
+      std::vector<unsigned int>,
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      compressed_vertex_to_cells;
+
     /**
      * Store vertex to cell center directions, as generated by
      * GridTools::vertex_to_cell_centers_directions().
@@ -232,6 +316,13 @@ namespace GridTools
                 typename Triangulation<dim, spacedim>::active_cell_iterator>>
       cell_bounding_boxes_rtree;
 
+    /**
+     * The bounding boxes stored in @p cell_bounding_boxes_rtree, indexed by
+     * the active cell index. They are needed to remove outdated entries from
+     * the tree when updating it incrementally.
+     */
+    mutable std::vector<BoundingBox<spacedim>> cell_bounding_boxes;
+
     /**
      * Storage for the status of the triangulation signal.
      */
@@ -43,12 +43,18 @@ namespace GridTools
      */
     update_vertex_to_cell_map = 0x001,
 
+    /**
+     * Update the compressed vertex to cell map, as returned by
+     * GridTools::compressed_vertex_to_cell_map().
+     */
+    update_compressed_vertex_to_cell_map = 0x080,
+
     /**
      * Update vertex_to_cell_centers_directions, as returned by
      * GridTools::vertex_to_cell_centers_directions()
      */
     update_vertex_to_cell_centers_directions =
-      update_vertex_to_cell_map | 0x002,
+      update_compressed_vertex_to_cell_map | 0x002,
 
     /**
      * Update a mapping of used vertices.
@@ -97,6 +103,8 @@ namespace GridTools
       s << "|vertex_to_cells_centers_directions";
     if (u & update_covering_rtree)
       s << "|covering_rtree";
+    if (u & update_compressed_vertex_to_cell_map)
+      s << "|compressed_vertex_to_cell_map";
     return s;
   }
 
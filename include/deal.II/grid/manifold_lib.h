@@ -21,11 +21,14 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/function_parser.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/grid/manifold.h>
 
 #include <boost/container/small_vector.hpp>
 
+#include <unordered_map>
+
 DEAL_II_NAMESPACE_OPEN
 
 /**
@@ -950,6 +953,14 @@ private:
  * current implementation by a pre-identification of relevant cells with
  * axis-aligned bounding boxes.
  *
+ * The chart coordinates of points that have been pulled back or created
+ * before are cached and used as initial guesses, and the chart of the cached
+ * points is tried before all other coarse cells. This makes repeated calls
+ * with shared surrounding points, as they occur for the support points of
+ * MappingQGeneric or for the vertices of the next refinement level, much
+ * cheaper, and removes the linear complexity in the number of coarse cells
+ * for most of the calls.
+ *
  * @ingroup manifold
  */
 template <int dim, int spacedim = dim>
@@ -1135,6 +1146,48 @@ private:
    */
   FlatManifold<dim> chart_manifold;
 
+  /**
+   * Hash function for the points in the cache of pull-backs.
+   */
+  struct PointHash
+  {
+    std::size_t
+    operator()(const Point<spacedim> &p) const
+    {
+      std::size_t seed = 0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          // Make sure that 0.0 and -0.0, which compare equal, also have the
+          // same hash
+          const double x = (p(d) == 0. ? 0. : p(d));
+          seed ^= std::hash<double>()(x) + 0x9e3779b9 + (seed << 6) +
+                  (seed >> 2);
+        }
+      return seed;
+    }
+  };
+
+  /**
+   * A cache of the coarse cell index and the chart coordinates of points
+   * that have been pulled back before or that have been created by
+   * get_new_point() and get_new_points(). Since new points become the
+   * surrounding points of the next refinement level, and since vertices and
+   * support points are shared between neighboring cells, the pull-back of
+   * most surrounding points can start from the cached chart point, for which
+   * the Newton iteration typically converges in its first step. Furthermore,
+   * the search over all coarse cells in get_possible_cells_around_points()
+   * can be skipped if the chart of the cached points is valid.
+   *
+   * The cache only provides initial guesses, so it does not need to be
+   * updated when the vertices of the triangulation are moved. Each thread
+   * keeps its own cache to avoid locking.
+   */
+  mutable Threads::ThreadLocalStorage<
+    std::unordered_map<Point<spacedim>,
+                       std::pair<unsigned int, Point<dim>>,
+                       PointHash>>
+    pull_back_cache;
+
   /**
    * The connection to Triangulation::signals::clear that must be reset once
    * this class goes out of scope.
@@ -35,6 +35,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/signals2.hpp>
 
+#include <array>
 #include <bitset>
 #include <functional>
 #include <list>
@@ -51,6 +52,9 @@ DEAL_II_NAMESPACE_OPEN
 template <int dim, int spacedim>
 class Manifold;
 
+template <int dim, int spacedim>
+class Triangulation;
+
 template <int dim>
 struct CellData;
 
@@ -305,6 +309,101 @@ namespace internal
       void
       serialize(Archive &ar, const unsigned int version);
     };
+
+
+    /**
+     * Cache class used to store the geometric data of the active cells of a
+     * triangulation, see Triangulation::enable_cell_geometry_cache(). The
+     * data is kept as a structure of arrays: Each quantity is stored in a
+     * contiguous array indexed by CellAccessor::active_cell_index(), with
+     * one array per coordinate direction for vector-valued quantities. As
+     * opposed to collecting the vertices of a cell through the TriaLevel and
+     * TriaObjects data structures and the global vertex array, the data of
+     * cells that are traversed one after the other is adjacent in memory.
+     */
+    template <int dim, int spacedim>
+    struct CellGeometryCache
+    {
+      /**
+       * Constructor. Mark the cache as invalid.
+       */
+      CellGeometryCache();
+
+      /**
+       * Compute the data of all active cells of the given triangulation and
+       * mark the cache as valid.
+       */
+      void
+      reinit(const Triangulation<dim, spacedim> &tria);
+
+      /**
+       * Release the memory and mark the cache as invalid.
+       */
+      void
+      clear();
+
+      /**
+       * Determine an estimate for the memory consumption (in bytes) of this
+       * object.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * The coordinates of the vertices of the active cells. The coordinate
+       * in direction @p d of vertex @p v of the cell with active cell index
+       * @p c is stored at position
+       * <code>vertices[d][c * GeometryInfo<dim>::vertices_per_cell +
+       * v]</code>.
+       */
+      std::array<std::vector<double>, spacedim> vertices;
+
+      /**
+       * The centers of the active cells as returned by TriaAccessor::center()
+       * with default arguments, one array per coordinate direction.
+       */
+      std::array<std::vector<double>, spacedim> centers;
+
+      /**
+       * The diameters of the active cells as returned by
+       * TriaAccessor::diameter().
+       */
+      std::vector<double> diameters;
+
+      /**
+       * The measures of the active cells as returned by
+       * TriaAccessor::measure().
+       */
+      std::vector<double> measures;
+
+      /**
+       * The lower left corners of the bounding boxes of the active cells as
+       * returned by TriaAccessor::bounding_box(), one array per coordinate
+       * direction.
+       */
+      std::array<std::vector<double>, spacedim> bounding_box_lower;
+
+      /**
+       * The upper right corners of the bounding boxes of the active cells,
+       * one array per coordinate direction.
+       */
+      std::array<std::vector<double>, spacedim> bounding_box_upper;
+
+      /**
+       * A flag indicating whether the arrays above describe the current
+       * state of the triangulation. The flag is reset when the
+       * triangulation is about to change, and set again by reinit(). While
+       * it is not set, the accessors compute the geometric data from the
+       * vertices.
+       */
+      bool is_valid;
+
+      /**
+       * The connections to the signals of the triangulation that keep the
+       * cache up to date.
+       */
+      std::vector<boost::signals2::connection> connections;
+    };
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -1993,6 +2092,35 @@ public:
     }
   };
 
+  /**
+   * A structure used to accumulate the results of the
+   * multi_constraint_cell_weight slot functions below. It takes an iterator
+   * range of vectors and returns their sum, computed entry by entry. All
+   * vectors need to have the same size.
+   */
+  template <typename T>
+  struct CellWeightVectorSum
+  {
+    using result_type = std::vector<T>;
+
+    template <typename InputIterator>
+    std::vector<T>
+    operator()(InputIterator first, InputIterator last) const
+    {
+      std::vector<T> sum;
+      for (; first != last; ++first)
+        {
+          const std::vector<T> weights = *first;
+          if (sum.empty())
+            sum.resize(weights.size(), T());
+          AssertDimension(weights.size(), sum.size());
+          for (unsigned int i = 0; i < weights.size(); ++i)
+            sum[i] += weights[i];
+        }
+      return sum;
+    }
+  };
+
   /**
    * A structure that has boost::signal objects for a number of actions that a
    * triangulation can do to itself. Please refer to the "Getting notice when
@@ -2131,6 +2259,33 @@ public:
                             CellWeightSum<unsigned int>>
       cell_weight;
 
+    /**
+     * This signal is the analogue of the cell_weight signal for the case
+     * where several quantities need to be balanced at the same time, e.g.
+     * the number of degrees of freedom and the number of particles of a
+     * cell. Any connected function is expected to take the same arguments
+     * as for the cell_weight signal, and to return a vector with one weight
+     * per balancing constraint. The size of this vector needs to be the same
+     * for all cells and on all processes. If several functions are connected
+     * to this signal, their return values are summed entry by entry.
+     *
+     * During repartitioning, each constraint is normalized by its sum over
+     * all cells, such that the total of each constraint is equal to the
+     * total of the reference weight of 1000 per cell described for the
+     * cell_weight signal. The normalized weights are then added to the
+     * scalar weight of each cell, which lets a space-filling curve
+     * partitioner balance all constraints at the same time. In other words,
+     * the number of cells and each of the constraints enter the partitioning
+     * with the same importance, on top of the weights provided through the
+     * cell_weight signal. Use
+     * parallel::TriangulationBase::compute_cell_weight_statistics() to
+     * assess the balance that has been reached for each of the constraints.
+     */
+    boost::signals2::signal<std::vector<unsigned int>(const cell_iterator &,
+                                                      const CellStatus),
+                            CellWeightVectorSum<unsigned int>>
+      multi_constraint_cell_weight;
+
     /**
      * This signal is triggered at the beginning of execution of the
      * parallel::distributed::Triangulation::execute_coarsening_and_refinement()
@@ -3228,6 +3383,45 @@ public:
    * @}
    */
 
+  /**
+   * Enable or disable a cache for the geometric data of the active cells,
+   * i.e., the coordinates of their vertices, their centers, diameters,
+   * measures, and bounding boxes. While the cache is enabled, the functions
+   * TriaAccessor::center() (when called with default arguments),
+   * TriaAccessor::diameter(), TriaAccessor::measure(), and
+   * TriaAccessor::bounding_box() return the cached values for active cells,
+   * rather than collecting the vertices of the cell through the several
+   * indirections of the data structures of the triangulation. The data is
+   * also accessible directly through get_cell_geometry_cache().
+   *
+   * Upon enabling, the data is computed for the current mesh. The cache is
+   * invalidated when the triangulation is cleared or about to be refined,
+   * and recomputed whenever the Signals::create, Signals::post_refinement,
+   * or Signals::mesh_movement signals are triggered.
+   *
+   * @note Modifications of vertices in user code through
+   * <code>cell->vertex(v) = ...</code> cannot be detected. In that case,
+   * trigger the Signals::mesh_movement signal after the modification to
+   * update the cache.
+   */
+  void
+  enable_cell_geometry_cache(const bool enable = true);
+
+  /**
+   * Return whether the cache for the geometric data of the active cells is
+   * enabled, see enable_cell_geometry_cache().
+   */
+  bool
+  cell_geometry_cache_is_enabled() const;
+
+  /**
+   * Return the cache for the geometric data of the active cells, see
+   * enable_cell_geometry_cache(). The cache must have been enabled.
+   */
+  const internal::TriangulationImplementation::CellGeometryCache<dim, spacedim>
+    &
+    get_cell_geometry_cache() const;
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object.
@@ -3870,6 +4064,16 @@ private:
    */
   dealii::internal::TriangulationImplementation::NumberCache<dim> number_cache;
 
+  /**
+   * Cache for the geometric data of the active cells, see
+   * enable_cell_geometry_cache(). The pointer is null if the cache is not
+   * enabled.
+   */
+  std::unique_ptr<
+    dealii::internal::TriangulationImplementation::CellGeometryCache<dim,
+                                                                     spacedim>>
+    cell_geometry_cache;
+
   /**
    * A map that relates the number of a boundary vertex to the boundary
    * indicator. This field is only used in 1d. We have this field because we
@@ -505,6 +505,31 @@ namespace internal
      */
     struct Implementation
     {
+      /**
+       * Return a pointer to the cell geometry cache of the triangulation if
+       * the given object is an active cell and the cache is enabled and up to
+       * date, and a null pointer otherwise. In the former case, the position
+       * of the cell within the cache is returned in @p index.
+       */
+      template <int structdim, int dim, int spacedim>
+      inline static const dealii::internal::TriangulationImplementation::
+        CellGeometryCache<dim, spacedim> *
+        cell_geometry_cache(
+          const TriaAccessor<structdim, dim, spacedim> &accessor,
+          unsigned int &                                index)
+      {
+        const auto *cache = accessor.tria->cell_geometry_cache.get();
+        if (structdim != dim || cache == nullptr || cache->is_valid == false ||
+            accessor.has_children())
+          return nullptr;
+
+        index = accessor.tria->levels[accessor.present_level]
+                  ->active_cell_indices[accessor.present_index];
+        return cache;
+      }
+
+
+
       /**
        * Implementation of the function of some name in the mother class.
        */
@@ -1921,6 +1946,12 @@ template <int structdim, int dim, int spacedim>
 double
 TriaAccessor<structdim, dim, spacedim>::diameter() const
 {
+  unsigned int index = 0;
+  if (const auto *cache =
+        internal::TriaAccessorImplementation::Implementation::
+          cell_geometry_cache(*this, index))
+    return cache->diameters[index];
+
   switch (structdim)
     {
       case 1:
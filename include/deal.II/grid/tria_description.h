@@ -483,6 +483,68 @@ namespace TriangulationDescription
       const TriangulationDescription::Settings setting =
         TriangulationDescription::Settings::default_setting);
 
+
+    /**
+     * Construct a TriangulationDescription::Description from a coarse grid
+     * that is distributed among the processes in arbitrary slices, without
+     * any process ever holding the complete mesh. This allows to set up a
+     * parallel::fullydistributed::Triangulation from meshes that are too
+     * large to fit into the memory of a single compute node, e.g., by
+     * letting each process read a contiguous part of the vertices and cells
+     * of a mesh file.
+     *
+     * The vertices and cells are numbered globally in the order of the
+     * ranks, i.e., the vertices in @p local_vertices of process $p$ have
+     * the global indices $\sum_{q<p} n_q, \ldots, \sum_{q\le p} n_q - 1$,
+     * where $n_q$ denotes the size of @p local_vertices on process $q$. The
+     * vertex indices of the cells in @p local_cells refer to this global
+     * numbering, and the cells are numbered in the same way to give
+     * the coarse-cell ids of the resulting triangulation. Each process
+     * may hold any number of vertices and cells, including none.
+     *
+     * The function first fetches the coordinates of the vertices of the
+     * local cells from the processes that own them. It then sorts the cells
+     * along a space-filling curve (Morton order) through their centers and
+     * cuts the curve into pieces of equal numbers of cells, which become the
+     * locally owned cells of the processes. Finally, each process receives
+     * the ghost cells, i.e., the cells that share a vertex with one of its
+     * own cells. Apart from a few reductions over all processes, the
+     * communication is point to point, and the memory consumption on each
+     * process is proportional to the size of its slices.
+     *
+     * @param local_vertices The vertices owned by this process.
+     * @param local_cells The cells owned by this process, in terms of
+     *   global vertex indices. Material and manifold ids are carried over to
+     *   the resulting triangulation.
+     * @param comm MPI communicator.
+     * @param smoothing Mesh smoothing type.
+     * @param settings See the description of the Settings enumerator.
+     * @return Description to be used to set up a Triangulation.
+     *
+     * @note The cells need to be given in the vertex ordering used by
+     *   deal.II and need to be consistently oriented, since they cannot be
+     *   reordered without the complete mesh. All boundary faces get the
+     *   boundary id zero, and the manifold ids of faces and edges are set to
+     *   numbers::flat_manifold_id. Both can be changed after the creation
+     *   of the triangulation, e.g., based on the location of the faces.
+     *   Periodicity is not taken into account when determining the ghost
+     *   cells.
+     *
+     * @note If construct_multigrid_hierarchy is set in the settings, the
+     *   @p smoothing parameter is extended with the
+     *   limit_level_difference_at_vertices flag.
+     */
+    template <int dim, int spacedim = dim>
+    Description<dim, spacedim>
+    create_description_from_distributed_coarse_grid(
+      const std::vector<Point<spacedim>> &      local_vertices,
+      const std::vector<dealii::CellData<dim>> &local_cells,
+      const MPI_Comm                            comm,
+      const typename Triangulation<dim, spacedim>::MeshSmoothing smoothing =
+        dealii::Triangulation<dim, spacedim>::none,
+      const TriangulationDescription::Settings settings =
+        TriangulationDescription::Settings::default_setting);
+
   } // namespace Utilities
 
 
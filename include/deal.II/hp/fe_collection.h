@@ -18,10 +18,15 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/table.h>
+#include <deal.II/base/thread_management.h>
+
 #include <deal.II/fe/component_mask.h>
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_values_extractors.h>
 
+#include <deal.II/lac/full_matrix.h>
+
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -526,6 +531,51 @@ namespace hp
     find_dominated_fe_extended(const std::set<unsigned int> &fes,
                                const unsigned int            codim = 0) const;
 
+    /**
+     * Return the result of FiniteElement::compare_for_domination() for the
+     * elements with indices @p fe_index_1 and @p fe_index_2, in this order.
+     *
+     * The result is computed the first time it is requested for a particular
+     * pair of elements and codimension, and is then stored in this object.
+     * All functions above that determine dominating or dominated elements use
+     * this cached information, so that the (possibly expensive) comparison of
+     * elements happens at most once per pair for the lifetime of the
+     * collection. This function may be called concurrently from several
+     * threads.
+     */
+    FiniteElementDomination::Domination
+    compare_for_domination(const unsigned int fe_index_1,
+                           const unsigned int fe_index_2,
+                           const unsigned int codim = 0) const;
+
+    /**
+     * Return the matrix interpolating from a face of the element with index
+     * @p source_fe_index to the face of the element with index @p fe_index,
+     * as computed by FiniteElement::get_face_interpolation_matrix(). The
+     * matrix has dimensions dofs_per_face of the source element times
+     * dofs_per_face of the element with index @p fe_index.
+     *
+     * Like compare_for_domination(), the matrix is computed on first use and
+     * kept for the lifetime of the collection, so that functions like
+     * DoFTools::make_hanging_node_constraints() do not recompute it for every
+     * call and every face between the same pair of elements. The returned
+     * reference stays valid until the next call of push_back(). This function
+     * may be called concurrently from several threads.
+     */
+    const FullMatrix<double> &
+    get_face_interpolation_matrix(const unsigned int fe_index,
+                                  const unsigned int source_fe_index) const;
+
+    /**
+     * Same as get_face_interpolation_matrix(), but for the interpolation from
+     * the @p subface of the element with index @p source_fe_index, as computed
+     * by FiniteElement::get_subface_interpolation_matrix().
+     */
+    const FullMatrix<double> &
+    get_subface_interpolation_matrix(const unsigned int fe_index,
+                                     const unsigned int source_fe_index,
+                                     const unsigned int subface) const;
+
     /**
      * Set functions determining the hierarchy of finite elements, i.e. a
      * function @p next that returns the index of the finite element following
@@ -821,6 +871,53 @@ namespace hp
     std::function<unsigned int(const typename hp::FECollection<dim, spacedim> &,
                                const unsigned int)>
       hierarchy_prev;
+
+    /**
+     * Information about pairs of elements of this collection that is
+     * computed on demand and kept for later use. See
+     * compare_for_domination(), get_face_interpolation_matrix(), and
+     * get_subface_interpolation_matrix().
+     */
+    struct PairCache
+    {
+      /**
+       * Resize all tables for a collection of @p n_elements elements.
+       */
+      PairCache(const unsigned int n_elements);
+
+      /**
+       * Mutex guarding concurrent access to the tables below.
+       */
+      Threads::Mutex mutex;
+
+      /**
+       * The results of FiniteElement::compare_for_domination() for each pair
+       * of elements and each codimension. An entry is only valid if the
+       * corresponding flag in @p domination_computed is set.
+       */
+      Table<3, FiniteElementDomination::Domination> domination;
+
+      /**
+       * Flags indicating which entries of @p domination have been computed.
+       */
+      Table<3, bool> domination_computed;
+
+      /**
+       * Face and subface interpolation matrices between pairs of elements,
+       * or empty pointers if they have not been requested yet.
+       */
+      Table<2, std::unique_ptr<const FullMatrix<double>>>
+        face_interpolation_matrices;
+      Table<3, std::unique_ptr<const FullMatrix<double>>>
+        subface_interpolation_matrices;
+    };
+
+    /**
+     * The cache of information on pairs of elements. It is replaced by an
+     * empty one whenever an element is added to the collection. Copies of a
+     * collection share their cache, as they share their elements.
+     */
+    std::shared_ptr<PairCache> pair_cache;
   };
 
 
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -598,6 +599,41 @@ namespace hp
            const unsigned int fe_index      = numbers::invalid_unsigned_int);
   };
 
+
+
+  /**
+   * Return the locally owned active cells of @p dof_handler grouped by their
+   * active FE index, in ascending order of the index. Within each group, the
+   * cells appear in the same order as in a loop over
+   * DoFHandler::active_cell_iterators().
+   *
+   * In hp discretizations, the active FE index usually changes many times
+   * during a loop over all cells in the usual order, and with it the
+   * ::FEValues object that hp::FEValues::reinit() selects. Looping over the
+   * cells returned by this function instead uses each of these objects for
+   * one long run of cells, so that the data of the finite element and the
+   * quadrature at hand stay in cache, and ::FEValues can exploit the
+   * similarity between consecutive cells more often:
+   * @code
+   * for (const auto &cell : hp::active_cells_sorted_by_fe_index(dof_handler))
+   *   {
+   *     hp_fe_values.reinit(cell);
+   *     ...
+   *   }
+   * @endcode
+   * The returned array can also be passed to WorkStream::run() or
+   * MeshWorker::mesh_loop() through its begin() and end() iterators, in which
+   * case the worker functions receive iterators into this array.
+   *
+   * The array needs to be computed again whenever the triangulation or the
+   * active FE indices change.
+   *
+   * @ingroup hp
+   */
+  template <typename DoFHandlerType>
+  std::vector<typename DoFHandlerType::active_cell_iterator>
+  active_cells_sorted_by_fe_index(const DoFHandlerType &dof_handler);
+
 } // namespace hp
 
 
@@ -96,6 +96,14 @@ namespace hp
     void
     push_back(const Quadrature<dim> &new_quadrature);
 
+    /**
+     * Add a quadrature rule that is shared with other objects, such as the
+     * rules returned by the functions in the QuadratureRegistry namespace.
+     * In contrast to the previous function, no copy of the rule is created.
+     */
+    void
+    push_back(const std::shared_ptr<const Quadrature<dim>> &new_quadrature);
+
     /**
      * Return a reference to the quadrature rule specified by the argument.
      *
@@ -246,6 +254,17 @@ namespace hp
       std::make_shared<const Quadrature<dim>>(new_quadrature));
   }
 
+
+
+  template <int dim>
+  inline void
+  QCollection<dim>::push_back(
+    const std::shared_ptr<const Quadrature<dim>> &new_quadrature)
+  {
+    Assert(new_quadrature != nullptr, ExcNotInitialized());
+    quadratures.push_back(new_quadrature);
+  }
+
 } // namespace hp
 
 
@@ -48,6 +48,11 @@ class SparseMatrix;
 template <typename number>
 class BlockSparseMatrix;
 
+namespace WorkStream
+{
+  class IndexRangeLocks;
+}
+
 namespace internal
 {
   namespace AffineConstraints
@@ -1411,6 +1416,28 @@ public:
                              VectorType &                  global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Same as the previous function, but safe to call simultaneously from
+   * several threads on the same global matrix and vector. Before writing,
+   * the function acquires the locks of @p locks for all rows it touches,
+   * i.e., the rows in @p local_dof_indices and the rows constrained degrees
+   * of freedom among them are resolved into. Rows in ranges not locked by
+   * other threads are written concurrently, which makes this function
+   * suitable for the copier of WorkStream::run_with_thread_safe_copier(),
+   * avoiding the serial copier stage of WorkStream::run(). The object
+   * @p locks needs to be set up for the size of the global vector and must
+   * be shared between all threads writing into the same objects.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(const FullMatrix<number> &    local_matrix,
+                             const Vector<number> &        local_vector,
+                             const std::vector<size_type> &local_dof_indices,
+                             MatrixType &                  global_matrix,
+                             VectorType &                  global_vector,
+                             WorkStream::IndexRangeLocks & locks,
+                             bool use_inhomogeneities_for_rhs = false) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
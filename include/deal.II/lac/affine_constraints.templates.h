@@ -20,8 +20,10 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/block_sparse_matrix.h>
@@ -48,6 +50,10 @@
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #include <deal.II/lac/trilinos_vector.h>
 
+#ifdef DEAL_II_WITH_TBB
+#  include <tbb/parallel_sort.h>
+#endif
+
 #include <boost/serialization/complex.hpp>
 #include <boost/serialization/utility.hpp>
 
@@ -309,8 +315,16 @@ AffineConstraints<number>::close()
   if (sorted == true)
     return;
 
+  // the number of lines handed to a thread at once when working on the
+  // lines in parallel below
+  const size_type grain_size = 256;
+
   // sort the lines
+#ifdef DEAL_II_WITH_TBB
+  tbb::parallel_sort(lines.begin(), lines.end());
+#else
   std::sort(lines.begin(), lines.end());
+#endif
 
   // update list of pointers and give the vector a sharp size since we
   // won't modify the size any more after this point.
@@ -363,214 +377,253 @@ AffineConstraints<number>::close()
 
   // replace references to dofs that are themselves constrained. note that
   // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
+  // constrained to third ones, we have to recursively expand the chains of
+  // constraints
   //
-  // the iteration replaces references to constrained degrees of freedom by
+  // the expansion replaces references to constrained degrees of freedom by
   // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
   // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
   // twice. we will throw this duplicate out in the following step, where
   // we sort the list so that throwing out duplicates becomes much more
-  // efficient. also, we have to do it only once, rather than in each
-  // iteration
-  size_type iteration = 0;
-  while (true)
-    {
-      bool chained_constraint_replaced = false;
+  // efficient. also, we have to do it only once, rather than after each
+  // replacement
+  //
+  // in order to work on the lines in parallel, the expansion only reads
+  // from the lines as they were before this step: lines that do not
+  // reference any constrained dof are not modified and can be read in
+  // place, whereas we keep a copy of the entries of the other lines. each
+  // line then gets fully resolved in a single pass over its entries,
+  // including the ones appended during that pass. this also makes the
+  // result independent of the number of threads and the order in which
+  // the lines are processed
+  const auto is_further_constrained = [this](const size_type dof_index) {
+    return ((local_lines.size() == 0) || (local_lines.is_element(dof_index))) &&
+           is_constrained(dof_index);
+  };
 
-      for (ConstraintLine &line : lines)
+  std::vector<size_type> copy_index(lines.size(), numbers::invalid_size_type);
+  std::vector<typename ConstraintLine::Entries> original_entries;
+  std::vector<number>                           original_inhomogeneities;
+  for (size_type i = 0; i < lines.size(); ++i)
+    for (const std::pair<size_type, number> &entry : lines[i].entries)
+      if (is_further_constrained(entry.first))
         {
+          copy_index[i] = original_entries.size();
+          original_entries.push_back(lines[i].entries);
+          original_inhomogeneities.push_back(lines[i].inhomogeneity);
+          break;
+        }
+
+  if (original_entries.size() > 0)
+    parallel::apply_to_subranges(
+      size_type(0),
+      lines.size(),
+      [&](const size_type begin, const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          {
+            if (copy_index[i] == numbers::invalid_size_type)
+              continue;
+
+            ConstraintLine &line = lines[i];
+
 #ifdef DEBUG
-          // we need to keep track of how many replacements we do in this line,
-          // because we can end up in a cycle A->B->C->A without the number of
-          // entries growing.
-          size_type n_replacements = 0;
+            // we need to keep track of how many replacements we do in this
+            // line, because we can end up in a cycle A->B->C->A without the
+            // number of entries growing. there cannot be more replacements
+            // than chains of entries through all other lines
+            size_type n_replacements = 0;
 #endif
 
-          // loop over all entries of this line (including ones that we
-          // have appended in this go around) and see whether they are
-          // further constrained. ignore elements that we don't store on
-          // the current processor
-          size_type entry = 0;
-          while (entry < line.entries.size())
-            if (((local_lines.size() == 0) ||
-                 (local_lines.is_element(line.entries[entry].first))) &&
-                is_constrained(line.entries[entry].first))
-              {
-                // ok, this entry is further constrained:
-                chained_constraint_replaced = true;
-
-                // look up the chain of constraints for this entry
-                const size_type dof_index = line.entries[entry].first;
-                const number    weight    = line.entries[entry].second;
-
-                Assert(dof_index != line.index,
-                       ExcMessage("Cycle in constraints detected!"));
-
-                const ConstraintLine &constrained_line =
-                  lines[lines_cache[calculate_line_index(dof_index)]];
-                Assert(constrained_line.index == dof_index, ExcInternalError());
-
-                // now we have to replace an entry by its expansion. we do
-                // that by overwriting the entry by the first entry of the
-                // expansion and adding the remaining ones to the end,
-                // where we will later process them once more
-                //
-                // we can of course only do that if the DoF that we are
-                // currently handle is constrained by a linear combination
-                // of other dofs:
-                if (constrained_line.entries.size() > 0)
-                  {
-                    for (size_type i = 0; i < constrained_line.entries.size();
-                         ++i)
-                      Assert(dof_index != constrained_line.entries[i].first,
-                             ExcMessage("Cycle in constraints detected!"));
+            // loop over all entries of this line (including ones that we
+            // have appended in this go around) and see whether they are
+            // further constrained. ignore elements that we don't store on
+            // the current processor
+            size_type entry = 0;
+            while (entry < line.entries.size())
+              if (is_further_constrained(line.entries[entry].first))
+                {
+                  // look up the chain of constraints for this entry
+                  const size_type dof_index = line.entries[entry].first;
+                  const number    weight    = line.entries[entry].second;
 
-                    // replace first entry, then tack the rest to the end
-                    // of the list
-                    line.entries[entry] = std::pair<size_type, number>(
-                      constrained_line.entries[0].first,
-                      constrained_line.entries[0].second * weight);
+                  Assert(dof_index != line.index,
+                         ExcMessage("Cycle in constraints detected!"));
 
-                    for (size_type i = 1; i < constrained_line.entries.size();
-                         ++i)
-                      line.entries.emplace_back(
-                        constrained_line.entries[i].first,
-                        constrained_line.entries[i].second * weight);
+                  const size_type constrained_line_index =
+                    lines_cache[calculate_line_index(dof_index)];
+                  Assert(lines[constrained_line_index].index == dof_index,
+                         ExcInternalError());
+                  const bool is_copied = copy_index[constrained_line_index] !=
+                                         numbers::invalid_size_type;
+                  const typename ConstraintLine::Entries &constrained_entries =
+                    is_copied ?
+                      original_entries[copy_index[constrained_line_index]] :
+                      lines[constrained_line_index].entries;
+                  const number constrained_inhomogeneity =
+                    is_copied ?
+                      original_inhomogeneities
+                        [copy_index[constrained_line_index]] :
+                      lines[constrained_line_index].inhomogeneity;
+
+                  // now we have to replace an entry by its expansion. we do
+                  // that by overwriting the entry by the first entry of the
+                  // expansion and adding the remaining ones to the end,
+                  // where we will later process them once more
+                  //
+                  // we can of course only do that if the DoF that we are
+                  // currently handle is constrained by a linear combination
+                  // of other dofs:
+                  if (constrained_entries.size() > 0)
+                    {
+                      for (size_type j = 0; j < constrained_entries.size();
+                           ++j)
+                        Assert(dof_index != constrained_entries[j].first,
+                               ExcMessage("Cycle in constraints detected!"));
+
+                      // replace first entry, then tack the rest to the end
+                      // of the list
+                      line.entries[entry] = std::pair<size_type, number>(
+                        constrained_entries[0].first,
+                        constrained_entries[0].second * weight);
+
+                      for (size_type j = 1; j < constrained_entries.size();
+                           ++j)
+                        line.entries.emplace_back(
+                          constrained_entries[j].first,
+                          constrained_entries[j].second * weight);
 
 #ifdef DEBUG
-                    // keep track of how many entries we replace in this
-                    // line. If we do more than there are constraints or
-                    // dofs in our system, we must have a cycle.
-                    ++n_replacements;
-                    Assert(n_replacements / 2 < largest_idx,
-                           ExcMessage("Cycle in constraints detected!"));
-                    if (n_replacements / 2 >= largest_idx)
-                      return; // this enables us to test for this Exception.
+                      // keep track of how many entries we replace in this
+                      // line. If we do more than there are constrained
+                      // lines times their lengths, we must have a cycle.
+                      ++n_replacements;
+                      Assert(n_replacements / 2 < largest_idx,
+                             ExcMessage("Cycle in constraints detected!"));
+                      if (n_replacements / 2 >= largest_idx)
+                        return; // this enables us to test for this Exception.
 #endif
-                  }
-                else
-                  // the DoF that we encountered is not constrained by a
-                  // linear combination of other dofs but is equal to just
-                  // the inhomogeneity (i.e. its chain of entries is
-                  // empty). in that case, we can't just overwrite the
-                  // current entry, but we have to actually eliminate it
-                  {
-                    line.entries.erase(line.entries.begin() + entry);
-                  }
-
-                line.inhomogeneity += constrained_line.inhomogeneity * weight;
-
-                // now that we're here, do not increase index by one but
-                // rather make another pass for the present entry because
-                // we have replaced the present entry by another one, or
-                // because we have deleted it and shifted all following
-                // ones one forward
-              }
-            else
-              // entry not further constrained. just move ahead by one
-              ++entry;
-        }
+                    }
+                  else
+                    // the DoF that we encountered is not constrained by a
+                    // linear combination of other dofs but is equal to just
+                    // the inhomogeneity (i.e. its chain of entries is
+                    // empty). in that case, we can't just overwrite the
+                    // current entry, but we have to actually eliminate it
+                    {
+                      line.entries.erase(line.entries.begin() + entry);
+                    }
 
-      // if we didn't do anything in this round, then quit the loop
-      if (chained_constraint_replaced == false)
-        break;
+                  line.inhomogeneity += constrained_inhomogeneity * weight;
 
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size(), ExcInternalError());
-    }
+                  // now that we're here, do not increase index by one but
+                  // rather make another pass for the present entry because
+                  // we have replaced the present entry by another one, or
+                  // because we have deleted it and shifted all following
+                  // ones one forward
+                }
+              else
+                // entry not further constrained. just move ahead by one
+                ++entry;
+          }
+      },
+      grain_size);
 
   // finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
   // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
-        {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
-            {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
-
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+  // sharp sizes. the lines are independent of each other here, so we can
+  // work on them in parallel
+  const auto finalize_line = [](ConstraintLine &line) {
+    std::sort(line.entries.begin(),
+              line.entries.end(),
+              [](const std::pair<size_type, number> &a,
+                 const std::pair<size_type, number> &b) -> bool {
+                // Let's use lexicogrpahic ordering with std::abs for number
+                // type (it might be complex valued).
+                return (a.first < b.first) ||
+                       (a.first == b.first &&
+                        std::abs(a.second) < std::abs(b.second));
+              });
+
+    // loop over the now sorted list and see whether any of the entries
+    // references the same dofs more than once in order to find how many
+    // non-duplicate entries we have. This lets us allocate the correct
+    // amount of memory for the constraint entries.
+    size_type duplicates = 0;
+    for (size_type i = 1; i < line.entries.size(); ++i)
+      if (line.entries[i].first == line.entries[i - 1].first)
+        duplicates++;
+
+    if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+      {
+        typename ConstraintLine::Entries new_entries;
 
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
+        // if we have no duplicates, copy verbatim the entries. this way,
+        // the final size is of the vector is correct.
+        if (duplicates == 0)
+          new_entries = line.entries;
+        else
+          {
+            // otherwise, we need to go through the list and resolve the
+            // duplicates
+            new_entries.reserve(line.entries.size() - duplicates);
+            new_entries.push_back(line.entries[0]);
+            for (size_type j = 1; j < line.entries.size(); ++j)
+              if (line.entries[j].first == line.entries[j - 1].first)
                 {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
+                  Assert(new_entries.back().first == line.entries[j].first,
                          ExcInternalError());
+                  new_entries.back().second += line.entries[j].second;
                 }
-            }
+              else
+                new_entries.push_back(line.entries[j]);
 
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
+            Assert(new_entries.size() == line.entries.size() - duplicates,
+                   ExcInternalError());
 
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+            // make sure there are really no duplicates left and that the
+            // list is still sorted
+            for (size_type j = 1; j < new_entries.size(); ++j)
+              {
+                Assert(new_entries[j].first != new_entries[j - 1].first,
+                       ExcInternalError());
+                Assert(new_entries[j].first > new_entries[j - 1].first,
+                       ExcInternalError());
+              }
+          }
+
+        // replace old list of constraints for this dof by the new one
+        line.entries.swap(new_entries);
+      }
+
+    // Finally do the following check: if the sum of weights for the
+    // constraints is close to one, but not exactly one, then rescale all
+    // the weights so that they sum up to 1. this adds a little numerical
+    // stability and avoids all sorts of problems where the actual value
+    // is close to, but not quite what we expected
+    //
+    // the case where the weights don't quite sum up happens when we
+    // compute the interpolation weights "on the fly", i.e. not from
+    // precomputed tables. in this case, the interpolation weights are
+    // also subject to round-off
+    number sum = 0.;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      sum += entry.second;
+    if (std::abs(sum - number(1.)) < 1.e-13)
+      {
+        for (std::pair<size_type, number> &entry : line.entries)
+          entry.second /= sum;
+        line.inhomogeneity /= sum;
+      }
+  };
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type i = begin; i < end; ++i)
+        finalize_line(lines[i]);
+    },
+    grain_size);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -3680,6 +3733,36 @@ AffineConstraints<number>::distribute_local_to_global(
     use_inhomogeneities_for_rhs);
 }
 
+template <typename number>
+template <typename MatrixType, typename VectorType>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const FullMatrix<number> &    local_matrix,
+  const Vector<number> &        local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  MatrixType &                  global_matrix,
+  VectorType &                  global_vector,
+  WorkStream::IndexRangeLocks & locks,
+  bool                          use_inhomogeneities_for_rhs) const
+{
+  // collect the rows we are going to write into: the local rows, which
+  // includes the diagonal entries set for constrained rows, and the rows
+  // constrained entries are resolved into
+  std::vector<size_type> rows(local_dof_indices);
+  for (const size_type index : local_dof_indices)
+    if (const auto *entries = get_constraint_entries(index))
+      for (const auto &entry : *entries)
+        rows.push_back(entry.first);
+
+  const WorkStream::IndexRangeLocks::Guard guard(locks, rows);
+  distribute_local_to_global(local_matrix,
+                             local_vector,
+                             local_dof_indices,
+                             global_matrix,
+                             global_vector,
+                             use_inhomogeneities_for_rhs);
+}
+
 // similar function as above, but now specialized for block matrices. See the
 // other function for additional comments.
 template <typename number>
@@ -0,0 +1,684 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_batched_full_matrix_h
+#define dealii_batched_full_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A collection of many small dense square matrices of the same size, which
+ * are factorized and solved together. The matrices are stored interleaved in
+ * batches of VectorizedArray<Number>::size() matrices, such that each entry
+ * $(i,j)$ of all matrices of a batch fills one VectorizedArray. All
+ * operations of the factorizations and the forward and backward
+ * substitutions are then performed on all matrices of a batch at once with
+ * the SIMD instructions of the processor, as opposed to one matrix after
+ * the other with FullMatrix::gauss_jordan() or LAPACKFullMatrix. This is
+ * the typical situation of block preconditioners and block relaxation
+ * methods that invert the diagonal blocks of a matrix associated with the
+ * degrees of freedom of a cell or a vertex patch.
+ *
+ * Two factorizations are available: An LU factorization with partial
+ * (row) pivoting, selected for each matrix of a batch independently, for
+ * general matrices, and a Cholesky factorization for symmetric positive
+ * definite matrices. The factorizations overwrite the matrices. The solve()
+ * functions then apply the inverse of a single matrix or of all the
+ * matrices of a batch.
+ *
+ * A typical use is:
+ * @code
+ * BatchedFullMatrix<double> blocks(n_blocks, block_size);
+ * for (unsigned int b = 0; b < n_blocks; ++b)
+ *   blocks.set_matrix(b, diagonal_block(b));
+ * blocks.compute_lu_factorization();
+ * ...
+ * blocks.solve(b, x.begin());
+ * @endcode
+ */
+template <typename Number>
+class BatchedFullMatrix
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = unsigned int;
+
+  /**
+   * The vectorized type used to store the entries of a batch of matrices.
+   */
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * Constructor. Create an empty collection.
+   */
+  BatchedFullMatrix();
+
+  /**
+   * Constructor. Create @p n_matrices matrices of size $n\times n$, see
+   * reinit().
+   */
+  BatchedFullMatrix(const size_type n_matrices, const size_type n);
+
+  /**
+   * Create @p n_matrices matrices of size $n\times n$ with all entries set to
+   * zero. The unused slots in the last batch are set to the identity matrix,
+   * such that the factorizations are well-defined for them.
+   */
+  void
+  reinit(const size_type n_matrices, const size_type n);
+
+  /**
+   * Return the number of matrices.
+   */
+  size_type
+  n_matrices() const;
+
+  /**
+   * Return the number of rows (and columns) of each matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of batches, i.e., the number of matrices rounded up
+   * to a multiple of VectorizedArray<Number>::size(), divided by that
+   * size.
+   */
+  size_type
+  n_batches() const;
+
+  /**
+   * Read-write access to the entry $(i,j)$ of matrix @p matrix. This must
+   * only be used before a factorization has been computed.
+   */
+  Number &
+  operator()(const size_type matrix, const size_type i, const size_type j);
+
+  /**
+   * Read access to the entry $(i,j)$ of matrix @p matrix, or of its
+   * factors once a factorization has been computed.
+   */
+  const Number &
+  operator()(const size_type matrix,
+             const size_type i,
+             const size_type j) const;
+
+  /**
+   * Copy the full matrix @p M into the slot @p matrix. Different slots can
+   * be filled concurrently from different threads.
+   */
+  template <typename OtherNumber>
+  void
+  set_matrix(const size_type matrix, const FullMatrix<OtherNumber> &M);
+
+  /**
+   * Compute the LU factorization with partial pivoting $PA=LU$ of all
+   * matrices, in parallel over the batches. An exception is raised if a
+   * matrix is singular.
+   */
+  void
+  compute_lu_factorization();
+
+  /**
+   * Compute the Cholesky factorization $A=LL^T$ of all matrices, which need
+   * to be symmetric and positive definite, in parallel over the batches.
+   * Only the lower triangle of the matrices is accessed.
+   */
+  void
+  compute_cholesky_factorization();
+
+  /**
+   * Overwrite the vector @p x of length n() with $A^{-1}x$ using the
+   * factorization of the matrix with index @p matrix.
+   */
+  template <typename OtherNumber>
+  void
+  solve(const size_type matrix, OtherNumber *x) const;
+
+  /**
+   * Overwrite the vector @p x of length n() with $A^{-T}x$ using the
+   * factorization of the matrix with index @p matrix.
+   */
+  template <typename OtherNumber>
+  void
+  Tsolve(const size_type matrix, OtherNumber *x) const;
+
+  /**
+   * Overwrite the n() entries of @p x, each holding the right hand sides of
+   * all matrices of batch @p batch in its lanes, with the solutions
+   * $A^{-1}x$ (or $A^{-T}x$ if @p transpose is set) of all matrices of the
+   * batch at once.
+   */
+  void
+  solve_batch(const size_type      batch,
+              VectorizedArrayType *x,
+              const bool           transpose = false) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception raised for a zero pivot in the LU factorization or a
+   * non-positive diagonal entry in the Cholesky factorization.
+   */
+  DeclException1(ExcSingularMatrix,
+                 size_type,
+                 << "The matrix with index " << arg1
+                 << " is singular or, for the Cholesky factorization, not "
+                 << "positive definite.");
+
+private:
+  /**
+   * The possible states of the stored matrices.
+   */
+  enum State
+  {
+    matrices,
+    lu,
+    cholesky
+  };
+
+  /**
+   * Factorize the matrices in the batches [@p batch_begin, @p batch_end).
+   */
+  void
+  factorize_batches(const size_type batch_begin, const size_type batch_end);
+
+  /**
+   * Return the position of the entry $(i,j)$ of the batch @p batch in
+   * #data.
+   */
+  std::size_t
+  index(const size_type batch, const size_type i, const size_type j) const;
+
+  /**
+   * The number of matrices.
+   */
+  size_type n_mat;
+
+  /**
+   * The number of rows and columns of each matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * The entries of all matrices, or their factors. The entries of the batch
+   * @p b are stored row by row starting at position b*n()*n().
+   */
+  AlignedVector<VectorizedArrayType> data;
+
+  /**
+   * The row exchanged with row $k$ in the $k$th step of the LU
+   * factorization, for each matrix. The entry for matrix @p m is stored at
+   * position <tt>(m / width * n() + k) * width + m % width</tt> with
+   * <tt>width = VectorizedArray<Number>::size()</tt>.
+   */
+  std::vector<size_type> pivots;
+
+  /**
+   * The current state.
+   */
+  State state;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*-------------------------Inline functions -------------------------------*/
+
+
+template <typename Number>
+inline BatchedFullMatrix<Number>::BatchedFullMatrix()
+  : n_mat(0)
+  , n_rows(0)
+  , state(matrices)
+{}
+
+
+
+template <typename Number>
+inline BatchedFullMatrix<Number>::BatchedFullMatrix(const size_type n_matrices,
+                                                    const size_type n)
+  : BatchedFullMatrix()
+{
+  reinit(n_matrices, n);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::reinit(const size_type n_matrices, const size_type n)
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+
+  n_mat  = n_matrices;
+  n_rows = n;
+  state  = matrices;
+  pivots.clear();
+
+  data.resize_fast(static_cast<std::size_t>(n_batches()) * n * n);
+  data.fill(VectorizedArrayType());
+
+  if (n_batches() > 0)
+    for (unsigned int v = n_mat - (n_batches() - 1) * width; v < width; ++v)
+      for (size_type i = 0; i < n; ++i)
+        data[index(n_batches() - 1, i, i)][v] = Number(1.);
+}
+
+
+
+template <typename Number>
+inline typename BatchedFullMatrix<Number>::size_type
+BatchedFullMatrix<Number>::n_matrices() const
+{
+  return n_mat;
+}
+
+
+
+template <typename Number>
+inline typename BatchedFullMatrix<Number>::size_type
+BatchedFullMatrix<Number>::n() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline typename BatchedFullMatrix<Number>::size_type
+BatchedFullMatrix<Number>::n_batches() const
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  return (n_mat + width - 1) / width;
+}
+
+
+
+template <typename Number>
+inline std::size_t
+BatchedFullMatrix<Number>::index(const size_type batch,
+                                 const size_type i,
+                                 const size_type j) const
+{
+  return (static_cast<std::size_t>(batch) * n_rows + i) * n_rows + j;
+}
+
+
+
+template <typename Number>
+inline Number &
+BatchedFullMatrix<Number>::operator()(const size_type matrix,
+                                      const size_type i,
+                                      const size_type j)
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  AssertIndexRange(matrix, n_mat);
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_rows);
+  Assert(state == matrices,
+         ExcMessage("The entries can not be modified after the "
+                    "factorization has been computed."));
+  return data[index(matrix / width, i, j)][matrix % width];
+}
+
+
+
+template <typename Number>
+inline const Number &
+BatchedFullMatrix<Number>::operator()(const size_type matrix,
+                                      const size_type i,
+                                      const size_type j) const
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  AssertIndexRange(matrix, n_mat);
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_rows);
+  return data[index(matrix / width, i, j)][matrix % width];
+}
+
+
+
+template <typename Number>
+template <typename OtherNumber>
+inline void
+BatchedFullMatrix<Number>::set_matrix(const size_type                matrix,
+                                      const FullMatrix<OtherNumber> &M)
+{
+  AssertDimension(M.m(), n_rows);
+  AssertDimension(M.n(), n_rows);
+  for (size_type i = 0; i < n_rows; ++i)
+    for (size_type j = 0; j < n_rows; ++j)
+      (*this)(matrix, i, j) = M(i, j);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::compute_lu_factorization()
+{
+  Assert(state == matrices, ExcMessage("The factorization has been computed."));
+  state = lu;
+  pivots.resize(static_cast<std::size_t>(n_batches()) * n_rows *
+                VectorizedArrayType::size());
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches(),
+    [this](const size_type begin, const size_type end) {
+      factorize_batches(begin, end);
+    },
+    16);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::compute_cholesky_factorization()
+{
+  Assert(state == matrices, ExcMessage("The factorization has been computed."));
+  state = cholesky;
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches(),
+    [this](const size_type begin, const size_type end) {
+      factorize_batches(begin, end);
+    },
+    16);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::factorize_batches(const size_type batch_begin,
+                                             const size_type batch_end)
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  const size_type        n     = n_rows;
+
+  for (size_type batch = batch_begin; batch < batch_end; ++batch)
+    {
+      VectorizedArrayType *a = data.begin() + index(batch, 0, 0);
+
+      if (state == lu)
+        for (size_type k = 0; k < n; ++k)
+          {
+            // select the pivot of each lane, encoding the row index as
+            // number to be able to use the SIMD comparisons
+            VectorizedArrayType max_abs = std::abs(a[k * n + k]);
+            VectorizedArrayType pivot   = Number(k);
+            for (size_type i = k + 1; i < n; ++i)
+              {
+                const VectorizedArrayType abs_entry = std::abs(a[i * n + k]);
+                pivot = compare_and_apply_mask<SIMDComparison::greater_than>(
+                  abs_entry, max_abs, VectorizedArrayType(Number(i)), pivot);
+                max_abs = std::max(max_abs, abs_entry);
+              }
+
+            for (unsigned int v = 0; v < width; ++v)
+              {
+                AssertThrow(max_abs[v] > Number(0.),
+                            ExcSingularMatrix(batch * width + v));
+                pivots[(batch * n + k) * width + v] =
+                  static_cast<size_type>(pivot[v]);
+              }
+
+            // exchange the rows in the lanes that actually pivot,
+            // skipping the rows not selected by any lane
+            for (size_type i = k + 1; i < n; ++i)
+              {
+                bool any_lane = false;
+                for (unsigned int v = 0; v < width; ++v)
+                  if (pivots[(batch * n + k) * width + v] == i)
+                    any_lane = true;
+                if (!any_lane)
+                  continue;
+
+                const VectorizedArrayType row_index = Number(i);
+                for (size_type j = 0; j < n; ++j)
+                  {
+                    const VectorizedArrayType tmp = a[k * n + j];
+                    a[k * n + j] =
+                      compare_and_apply_mask<SIMDComparison::equal>(
+                        pivot, row_index, a[i * n + j], tmp);
+                    a[i * n + j] =
+                      compare_and_apply_mask<SIMDComparison::equal>(
+                        pivot, row_index, tmp, a[i * n + j]);
+                  }
+              }
+
+            const VectorizedArrayType inv_pivot = Number(1.) / a[k * n + k];
+            for (size_type i = k + 1; i < n; ++i)
+              {
+                const VectorizedArrayType factor = a[i * n + k] * inv_pivot;
+                a[i * n + k]                     = factor;
+                for (size_type j = k + 1; j < n; ++j)
+                  a[i * n + j] -= factor * a[k * n + j];
+              }
+          }
+      else
+        for (size_type k = 0; k < n; ++k)
+          {
+            for (unsigned int v = 0; v < width; ++v)
+              AssertThrow(a[k * n + k][v] > Number(0.),
+                          ExcSingularMatrix(batch * width + v));
+
+            // store the inverse of the diagonal of L to replace the
+            // divisions in the substitutions by multiplications
+            const VectorizedArrayType diagonal = std::sqrt(a[k * n + k]);
+            const VectorizedArrayType inv_diagonal = Number(1.) / diagonal;
+            a[k * n + k]                           = inv_diagonal;
+            for (size_type i = k + 1; i < n; ++i)
+              a[i * n + k] *= inv_diagonal;
+            for (size_type j = k + 1; j < n; ++j)
+              for (size_type i = j; i < n; ++i)
+                a[i * n + j] -= a[i * n + k] * a[j * n + k];
+          }
+    }
+}
+
+
+
+template <typename Number>
+template <typename OtherNumber>
+inline void
+BatchedFullMatrix<Number>::solve(const size_type matrix, OtherNumber *x) const
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  Assert(state != matrices, ExcMessage("No factorization has been computed."));
+  AssertIndexRange(matrix, n_mat);
+
+  const size_type            n     = n_rows;
+  const size_type            batch = matrix / width;
+  const unsigned int         v     = matrix % width;
+  const VectorizedArrayType *a     = data.begin() + index(batch, 0, 0);
+
+  if (state == lu)
+    {
+      for (size_type k = 0; k < n; ++k)
+        std::swap(x[k], x[pivots[(batch * n + k) * width + v]]);
+      for (size_type i = 1; i < n; ++i)
+        for (size_type j = 0; j < i; ++j)
+          x[i] -= a[i * n + j][v] * x[j];
+      for (size_type i = n; i-- > 0;)
+        {
+          for (size_type j = i + 1; j < n; ++j)
+            x[i] -= a[i * n + j][v] * x[j];
+          x[i] /= a[i * n + i][v];
+        }
+    }
+  else
+    {
+      for (size_type i = 0; i < n; ++i)
+        {
+          for (size_type j = 0; j < i; ++j)
+            x[i] -= a[i * n + j][v] * x[j];
+          x[i] *= a[i * n + i][v];
+        }
+      for (size_type i = n; i-- > 0;)
+        {
+          for (size_type j = i + 1; j < n; ++j)
+            x[i] -= a[j * n + i][v] * x[j];
+          x[i] *= a[i * n + i][v];
+        }
+    }
+}
+
+
+
+template <typename Number>
+template <typename OtherNumber>
+inline void
+BatchedFullMatrix<Number>::Tsolve(const size_type matrix, OtherNumber *x) const
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  Assert(state != matrices, ExcMessage("No factorization has been computed."));
+  AssertIndexRange(matrix, n_mat);
+
+  // the Cholesky factorization is symmetric
+  if (state == cholesky)
+    {
+      solve(matrix, x);
+      return;
+    }
+
+  const size_type            n     = n_rows;
+  const size_type            batch = matrix / width;
+  const unsigned int         v     = matrix % width;
+  const VectorizedArrayType *a     = data.begin() + index(batch, 0, 0);
+
+  // A^T = U^T L^T P, so solve with U^T and L^T and apply the inverse
+  // permutation in reverse order
+  for (size_type i = 0; i < n; ++i)
+    {
+      for (size_type j = 0; j < i; ++j)
+        x[i] -= a[j * n + i][v] * x[j];
+      x[i] /= a[i * n + i][v];
+    }
+  for (size_type i = n; i-- > 0;)
+    for (size_type j = i + 1; j < n; ++j)
+      x[i] -= a[j * n + i][v] * x[j];
+  for (size_type k = n; k-- > 0;)
+    std::swap(x[k], x[pivots[(batch * n + k) * width + v]]);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::solve_batch(const size_type      batch,
+                                       VectorizedArrayType *x,
+                                       const bool           transpose) const
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+  Assert(state != matrices, ExcMessage("No factorization has been computed."));
+  AssertIndexRange(batch, n_batches());
+
+  const size_type            n = n_rows;
+  const VectorizedArrayType *a = data.begin() + index(batch, 0, 0);
+
+  if (state == cholesky)
+    {
+      for (size_type i = 0; i < n; ++i)
+        {
+          for (size_type j = 0; j < i; ++j)
+            x[i] -= a[i * n + j] * x[j];
+          x[i] *= a[i * n + i];
+        }
+      for (size_type i = n; i-- > 0;)
+        {
+          for (size_type j = i + 1; j < n; ++j)
+            x[i] -= a[j * n + i] * x[j];
+          x[i] *= a[i * n + i];
+        }
+    }
+  else if (transpose == false)
+    {
+      const size_type *p = pivots.data() + batch * n * width;
+      for (size_type k = 0; k < n; ++k)
+        for (unsigned int v = 0; v < width; ++v)
+          std::swap(x[k][v], x[p[k * width + v]][v]);
+      for (size_type i = 1; i < n; ++i)
+        for (size_type j = 0; j < i; ++j)
+          x[i] -= a[i * n + j] * x[j];
+      for (size_type i = n; i-- > 0;)
+        {
+          for (size_type j = i + 1; j < n; ++j)
+            x[i] -= a[i * n + j] * x[j];
+          x[i] /= a[i * n + i];
+        }
+    }
+  else
+    {
+      const size_type *p = pivots.data() + batch * n * width;
+      for (size_type i = 0; i < n; ++i)
+        {
+          for (size_type j = 0; j < i; ++j)
+            x[i] -= a[j * n + i] * x[j];
+          x[i] /= a[i * n + i];
+        }
+      for (size_type i = n; i-- > 0;)
+        for (size_type j = i + 1; j < n; ++j)
+          x[i] -= a[j * n + i] * x[j];
+      for (size_type k = n; k-- > 0;)
+        for (unsigned int v = 0; v < width; ++v)
+          std::swap(x[k][v], x[p[k * width + v]][v]);
+    }
+}
+
+
+
+template <typename Number>
+inline std::size_t
+BatchedFullMatrix<Number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(data) +
+         MemoryConsumption::memory_consumption(pivots);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
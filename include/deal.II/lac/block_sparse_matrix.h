@@ -19,12 +19,15 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/block_matrix_base.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparse_matrix.h>
 
+#include <algorithm>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -395,7 +398,54 @@ inline void
 BlockSparseMatrix<number>::vmult(BlockVector<block_number> &      dst,
                                  const BlockVector<block_number> &src) const
 {
-  BaseClass::vmult_block_block(dst, src);
+  Assert(dst.n_blocks() == this->n_block_rows(),
+         ExcDimensionMismatch(dst.n_blocks(), this->n_block_rows()));
+  Assert(src.n_blocks() == this->n_block_cols(),
+         ExcDimensionMismatch(src.n_blocks(), this->n_block_cols()));
+
+  // Rather than multiplying with one block after the other, each of which
+  // would read and write the whole block of the destination vector and
+  // start its own parallel loop, split the rows of the whole matrix into
+  // tasks. Within a task, go through the rows of each block row in tiles
+  // that are small enough for their part of the destination vector to stay
+  // in cache while the contributions of all blocks of the block row are
+  // accumulated into it.
+  const unsigned int tile_size    = 512;
+  const BlockIndices &row_indices = this->get_row_indices();
+  parallel::apply_to_subranges(
+    size_type(0),
+    this->m(),
+    [this, &row_indices, &dst, &src](const size_type begin,
+                                     const size_type end) {
+      size_type row = begin;
+      while (row < end)
+        {
+          const std::pair<unsigned int, size_type> row_index =
+            row_indices.global_to_local(row);
+          const unsigned int block_row   = row_index.first;
+          const size_type    block_start = row - row_index.second;
+          const size_type    block_end =
+            std::min(end, block_start + row_indices.block_size(block_row));
+
+          for (size_type tile_begin = row; tile_begin < block_end;
+               tile_begin += tile_size)
+            {
+              const size_type tile_end =
+                std::min<size_type>(tile_begin + tile_size, block_end);
+              for (unsigned int block_col = 0;
+                   block_col < this->n_block_cols();
+                   ++block_col)
+                this->block(block_row, block_col)
+                  .vmult_on_subrange(dst.block(block_row),
+                                     src.block(block_col),
+                                     tile_begin - block_start,
+                                     tile_end - block_start,
+                                     block_col > 0);
+            }
+          row = block_end;
+        }
+    },
+    SparseMatrix<number>::get_parallel_grain_size());
 }
 
 
@@ -50,6 +50,20 @@ namespace internal
      */
     using size_type = types::global_dof_index;
 
+    /**
+     * Return the minimal number of chunk rows per task in the parallel
+     * matrix-vector products. The same value is used when zeroing the matrix
+     * entries in ChunkSparseMatrix::operator=(), such that the memory is
+     * touched first by the same tasks that later work on it.
+     */
+    inline unsigned int
+    vmult_grain_size(const size_type chunk_size)
+    {
+      return internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               chunk_size +
+             1;
+    }
+
     /**
      * Add the result of multiplying a chunk of size chunk_size times
      * chunk_size by a source vector fragment of size chunk_size to the
@@ -79,6 +93,39 @@ namespace internal
 
 
 
+    /**
+     * Same as the previous function, but with the chunk size given as a
+     * compile-time constant. This allows the compiler to unroll the loops
+     * and keep the source vector fragment and the row sums in registers,
+     * which is considerably faster than the loops with run-time bounds for
+     * the small chunk sizes typically used.
+     */
+    template <int chunk_size,
+              typename MatrixIterator,
+              typename SrcIterator,
+              typename DstIterator>
+    inline void
+    chunk_vmult_add(const MatrixIterator matrix,
+                    const SrcIterator    src,
+                    DstIterator          dst)
+    {
+      using value_type = typename std::iterator_traits<DstIterator>::value_type;
+
+      value_type src_values[chunk_size];
+      for (int j = 0; j < chunk_size; ++j)
+        src_values[j] = src[j];
+
+      for (int i = 0; i < chunk_size; ++i)
+        {
+          value_type sum = matrix[i * chunk_size] * src_values[0];
+          for (int j = 1; j < chunk_size; ++j)
+            sum += matrix[i * chunk_size + j] * src_values[j];
+          dst[i] += sum;
+        }
+    }
+
+
+
     /**
      * Like the previous function, but subtract. We need this for computing
      * the residual.
@@ -165,9 +212,77 @@ namespace internal
 
 
 
+    /**
+     * Add the products of all chunks in the chunk rows
+     * [begin_row, end_row) without padding with the source vector to the
+     * destination vector, where the pointers @p val_ptr, @p colnum_ptr, and
+     * @p dst_ptr refer to the data of chunk row @p begin_row and are
+     * advanced to the end of the range. The chunk size is either given as
+     * the compile-time constant @p fixed_chunk_size, or as the run-time
+     * argument @p chunk_size if @p fixed_chunk_size is zero. If @p zero_dst
+     * is true, the destination entries are set to zero first.
+     */
+    template <int fixed_chunk_size,
+              typename number,
+              typename InVector,
+              typename OutIterator>
+    inline void
+    vmult_add_regular_rows(const size_type   chunk_size,
+                           const size_type   begin_row,
+                           const size_type   end_row,
+                           const size_type   irregular_col,
+                           const size_type   n_filled_last_cols,
+                           const bool        zero_dst,
+                           const number *    values,
+                           const std::size_t *rowstart,
+                           const number *&   val_ptr,
+                           const size_type *&colnum_ptr,
+                           const InVector &  src,
+                           OutIterator &     dst_ptr)
+    {
+      for (size_type chunk_row = begin_row; chunk_row < end_row; ++chunk_row)
+        {
+          if (zero_dst)
+            for (size_type r = 0; r < chunk_size; ++r)
+              dst_ptr[r] = 0;
+
+          const number *const val_end_of_row =
+            &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
+          while (val_ptr != val_end_of_row)
+            {
+              if (*colnum_ptr != irregular_col)
+                {
+                  if constexpr (fixed_chunk_size > 0)
+                    chunk_vmult_add<fixed_chunk_size>(
+                      val_ptr, src.begin() + *colnum_ptr * chunk_size, dst_ptr);
+                  else
+                    chunk_vmult_add(chunk_size,
+                                    val_ptr,
+                                    src.begin() + *colnum_ptr * chunk_size,
+                                    dst_ptr);
+                }
+              else
+                // we're at a chunk column that has padding
+                for (size_type r = 0; r < chunk_size; ++r)
+                  for (size_type c = 0; c < n_filled_last_cols; ++c)
+                    dst_ptr[r] += (val_ptr[r * chunk_size + c] *
+                                   src(*colnum_ptr * chunk_size + c));
+
+              ++colnum_ptr;
+              val_ptr += chunk_size * chunk_size;
+            }
+
+          dst_ptr += chunk_size;
+        }
+    }
+
+
+
     /**
      * Perform a vmult_add using the ChunkSparseMatrix data structures, but
-     * only using a subinterval of the matrix rows.
+     * only using a subinterval of the matrix rows. If @p zero_dst is true,
+     * the destination vector entries of these rows are set to zero first,
+     * such that this function computes a vmult instead.
      *
      * In the sequential case, this function is called on all rows, in the
      * parallel case it may be called on a subrange, at the discretion of the
@@ -182,7 +297,8 @@ namespace internal
                           const std::size_t *         rowstart,
                           const size_type *           colnums,
                           const InVector &            src,
-                          OutVector &                 dst)
+                          OutVector &                 dst,
+                          const bool                  zero_dst = false)
     {
       const size_type m          = cols.n_rows();
       const size_type n          = cols.n_cols();
@@ -204,30 +320,46 @@ namespace internal
       const number *val_ptr =
         &values[rowstart[begin_row] * chunk_size * chunk_size];
       const size_type *colnum_ptr = &colnums[rowstart[begin_row]];
-      for (unsigned int chunk_row = begin_row; chunk_row < last_regular_row;
-           ++chunk_row)
-        {
-          const number *const val_end_of_row =
-            &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
-          while (val_ptr != val_end_of_row)
-            {
-              if (*colnum_ptr != irregular_col)
-                chunk_vmult_add(chunk_size,
-                                val_ptr,
-                                src.begin() + *colnum_ptr * chunk_size,
-                                dst_ptr);
-              else
-                // we're at a chunk column that has padding
-                for (size_type r = 0; r < chunk_size; ++r)
-                  for (size_type c = 0; c < n_filled_last_cols; ++c)
-                    dst_ptr[r] += (val_ptr[r * chunk_size + c] *
-                                   src(*colnum_ptr * chunk_size + c));
 
-              ++colnum_ptr;
-              val_ptr += chunk_size * chunk_size;
-            }
-
-          dst_ptr += chunk_size;
+      // dispatch the chunk sizes that are most common for vector-valued
+      // problems to kernels with compile-time loop bounds
+      const auto apply_regular_rows = [&](const auto fixed_chunk_size) {
+        vmult_add_regular_rows<decltype(fixed_chunk_size)::value>(
+          chunk_size,
+          begin_row,
+          last_regular_row,
+          irregular_col,
+          n_filled_last_cols,
+          zero_dst,
+          values,
+          rowstart,
+          val_ptr,
+          colnum_ptr,
+          src,
+          dst_ptr);
+      };
+      switch (chunk_size)
+        {
+          case 1:
+            apply_regular_rows(std::integral_constant<int, 1>());
+            break;
+          case 2:
+            apply_regular_rows(std::integral_constant<int, 2>());
+            break;
+          case 3:
+            apply_regular_rows(std::integral_constant<int, 3>());
+            break;
+          case 4:
+            apply_regular_rows(std::integral_constant<int, 4>());
+            break;
+          case 6:
+            apply_regular_rows(std::integral_constant<int, 6>());
+            break;
+          case 8:
+            apply_regular_rows(std::integral_constant<int, 8>());
+            break;
+          default:
+            apply_regular_rows(std::integral_constant<int, 0>());
         }
 
       // now deal with last chunk row if necessary
@@ -235,6 +367,10 @@ namespace internal
         {
           const size_type chunk_row = last_regular_row;
 
+          if (zero_dst)
+            for (size_type r = 0; r < n_filled_last_rows; ++r)
+              dst_ptr[r] = 0;
+
           const number *const val_end_of_row =
             &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
           while (val_ptr != val_end_of_row)
@@ -361,7 +497,7 @@ namespace internal
   {
     template <typename T>
     void
-    zero_subrange(const unsigned int begin, const unsigned int end, T *dst)
+    zero_subrange(const std::size_t begin, const std::size_t end, T *dst)
     {
       std::memset(dst + begin, 0, (end - begin) * sizeof(T));
     }
@@ -381,30 +517,30 @@ ChunkSparseMatrix<number>::operator=(const double d)
   Assert(cols->sparsity_pattern.compressed || cols->empty(),
          ChunkSparsityPattern::ExcNotCompressed());
 
-  // do initial zeroing of elements in parallel. Try to achieve a similar
+  // do initial zeroing of elements in parallel. Try to achieve the same
   // layout as when doing matrix-vector products, as on some NUMA systems, a
   // memory block is assigned to memory banks where the first access is
   // generated. For sparse matrices, the first operations is usually the
-  // operator=. The grain size is chosen to reflect the number of rows in
-  // minimum_parallel_grain_size, weighted by the number of nonzero entries
-  // per row on average.
-  const unsigned int matrix_size = cols->sparsity_pattern.n_nonzero_elements() *
-                                   cols->chunk_size * cols->chunk_size;
-  const unsigned int grain_size =
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size *
-    (matrix_size + m()) / m();
-  if (matrix_size > grain_size)
+  // operator=. Therefore, we split the range of chunk rows in the same way
+  // as vmult() and vmult_add() do and zero the values of each subrange.
+  const size_type n_chunk_rows = cols->sparsity_pattern.n_rows();
+  const std::size_t chunk_entries = cols->chunk_size * cols->chunk_size;
+  const std::size_t *const rowstart = cols->sparsity_pattern.rowstart.get();
+  const std::size_t        matrix_size =
+    n_chunk_rows > 0 ? rowstart[n_chunk_rows] * chunk_entries : 0;
+  if (matrix_size > 0)
     parallel::apply_to_subranges(
       0U,
-      matrix_size,
-      [this](const unsigned int begin, const unsigned int end) {
-        internal::ChunkSparseMatrixImplementation::zero_subrange(begin,
-                                                                 end,
-                                                                 val.get());
+      static_cast<unsigned int>(n_chunk_rows),
+      [this, rowstart, chunk_entries](const unsigned int begin_row,
+                                      const unsigned int end_row) {
+        internal::ChunkSparseMatrixImplementation::zero_subrange(
+          rowstart[begin_row] * chunk_entries,
+          rowstart[end_row] * chunk_entries,
+          val.get());
       },
-      grain_size);
-  else if (matrix_size > 0)
-    std::memset(val.get(), 0, matrix_size * sizeof(number));
+      internal::ChunkSparseMatrixImplementation::vmult_grain_size(
+        cols->chunk_size));
 
   return *this;
 }
@@ -657,10 +793,27 @@ ChunkSparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
-  // set the output vector to zero and then add to it the contributions of
-  // vmults from individual chunks. this is what vmult_add does
-  dst = 0;
-  vmult_add(dst, src);
+  // compute the product in the same way as vmult_add, but let each task set
+  // its part of the output vector to zero before adding the contributions
+  // of the chunks, rather than zeroing the whole vector in a separate pass
+  parallel::apply_to_subranges(
+    0U,
+    cols->sparsity_pattern.n_rows(),
+    [this, &src, &dst](const unsigned int begin_row,
+                       const unsigned int end_row) {
+      internal::ChunkSparseMatrixImplementation::vmult_add_on_subrange(
+        *cols,
+        begin_row,
+        end_row,
+        val.get(),
+        cols->sparsity_pattern.rowstart.get(),
+        cols->sparsity_pattern.colnums.get(),
+        src,
+        dst,
+        /*zero_dst=*/true);
+    },
+    internal::ChunkSparseMatrixImplementation::vmult_grain_size(
+      cols->chunk_size));
 }
 
 
@@ -718,9 +871,8 @@ ChunkSparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
         src,
         dst);
     },
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
-        cols->chunk_size +
-      1);
+    internal::ChunkSparseMatrixImplementation::vmult_grain_size(
+      cols->chunk_size));
 }
 
 
@@ -453,6 +453,42 @@ namespace LinearAlgebra
 
 
 
+      /**
+       * Addition of a multiple of a vector with a factor that is only known
+       * on the device, i.e., <tt>val += a * (*numerator / *denominator) *
+       * V_val</tt>. The two scalars are typically the results of previous
+       * reductions, which avoids their transfer to the host.
+       *
+       * @ingroup CUDAWrappers
+       */
+      template <typename Number>
+      __global__ void
+      add_ratio_aV(Number *        val,
+                   const Number    a,
+                   const Number *  numerator,
+                   const Number *  denominator,
+                   const Number *  V_val,
+                   const size_type N);
+
+
+
+      /**
+       * Scaling with a factor that is only known on the device and addition
+       * of a vector, i.e., <tt>val = (*numerator / *denominator) * val +
+       * V_val</tt>.
+       *
+       * @ingroup CUDAWrappers
+       */
+      template <typename Number>
+      __global__ void
+      sadd_ratio(const Number *  numerator,
+                 const Number *  denominator,
+                 Number *        val,
+                 const Number *  V_val,
+                 const size_type N);
+
+
+
       /**
        * Set each element of @p val to @p s.
        *
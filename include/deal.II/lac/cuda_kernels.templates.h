@@ -512,6 +512,49 @@ namespace LinearAlgebra
 
 
 
+      template <typename Number>
+      __global__ void
+      add_ratio_aV(Number *        val,
+                   const Number    a,
+                   const Number *  numerator,
+                   const Number *  denominator,
+                   const Number *  V_val,
+                   const size_type N)
+      {
+        const Number    factor = a * (*numerator / *denominator);
+        const size_type idx_base =
+          threadIdx.x + blockIdx.x * (blockDim.x * chunk_size);
+        for (unsigned int i = 0; i < chunk_size; ++i)
+          {
+            const size_type idx = idx_base + i * block_size;
+            if (idx < N)
+              val[idx] += factor * V_val[idx];
+          }
+      }
+
+
+
+      template <typename Number>
+      __global__ void
+      sadd_ratio(const Number *  numerator,
+                 const Number *  denominator,
+                 Number *        val,
+                 const Number *  V_val,
+                 const size_type N)
+      {
+        const Number    s = *numerator / *denominator;
+        const size_type idx_base =
+          threadIdx.x + blockIdx.x * (blockDim.x * chunk_size);
+        for (unsigned int i = 0; i < chunk_size; ++i)
+          {
+            const size_type idx = idx_base + i * block_size;
+            if (idx < N)
+              val[idx] = s * val[idx] + V_val[idx];
+          }
+      }
+
+
+
       template <typename Number>
       __global__ void
       set(Number *val, const Number s, const size_type N)
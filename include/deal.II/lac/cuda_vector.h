@@ -26,6 +26,8 @@
 
 #ifdef DEAL_II_WITH_CUDA
 
+#  include <cuda_runtime_api.h>
+
 DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
@@ -46,6 +48,29 @@ namespace LinearAlgebra
      * This class implements a vector using CUDA for use on Nvidia GPUs. This
      * class is derived from the LinearAlgebra::VectorSpaceVector class.
      *
+     * All kernels and memory transfers of a vector are issued on the CUDA
+     * stream set by set_stream(), which is the default stream unless
+     * specified otherwise. Functions returning a value to the host, like
+     * the norms and inner products, only wait for the operations on that
+     * stream. For iterative solvers whose performance is limited by the
+     * latency of these transfers, the results of the reductions can instead
+     * be kept on the device with the functions dot_on_device(),
+     * norm_sqr_on_device(), and add_and_dot_on_device(), and fed into the
+     * next vector update by add_ratio() and sadd_ratio() without any
+     * synchronization with the host. A conjugate gradient iteration then
+     * reads
+     * @code
+     * A.vmult(Ap, p);
+     * p.dot_on_device(Ap, pAp);
+     * x.add_ratio(1., rr, pAp, p);
+     * r.add_ratio(-1., rr, pAp, Ap);
+     * r.norm_sqr_on_device(rr_new);
+     * p.sadd_ratio(rr_new, rr, r);
+     * @endcode
+     * with device pointers @p rr, @p rr_new, and @p pAp. Note that all
+     * vectors within an operation need to use the same stream, or the
+     * streams need to be synchronized by the user.
+     *
      * @note Only float and double are supported.
      *
      * @see CUDAWrappers
@@ -291,6 +316,69 @@ namespace LinearAlgebra
                   const VectorSpaceVector<Number> &V,
                   const VectorSpaceVector<Number> &W) override;
 
+      /**
+       * Compute the inner product of this vector with @p V like operator*(),
+       * but write the result to the device memory pointed to by
+       * @p result_device instead of returning it, so that the call does not
+       * wait for the completion of the computation.
+       */
+      void
+      dot_on_device(const Vector<Number> &V, Number *result_device) const;
+
+      /**
+       * Compute the square of the $l_2$-norm like norm_sqr(), but write the
+       * result to the device memory pointed to by @p result_device.
+       */
+      void
+      norm_sqr_on_device(Number *result_device) const;
+
+      /**
+       * Perform the same operation as add_and_dot(), but write the result
+       * of the inner product to the device memory pointed to by
+       * @p result_device.
+       */
+      void
+      add_and_dot_on_device(const Number          a,
+                            const Vector<Number> &V,
+                            const Vector<Number> &W,
+                            Number *              result_device);
+
+      /**
+       * Addition of a multiple of a vector whose factor is given by scalars
+       * in device memory, i.e. <tt>*this += a * (*numerator /
+       * *denominator) * V</tt>, as it appears in the update of the solution
+       * and the residual of a conjugate gradient method.
+       */
+      void
+      add_ratio(const Number          a,
+                const Number *        numerator,
+                const Number *        denominator,
+                const Vector<Number> &V);
+
+      /**
+       * Scaling by a factor given by scalars in device memory and addition
+       * of a vector, i.e. <tt>*this = (*numerator / *denominator) * (*this) +
+       * V</tt>, as it appears in the update of the search direction of a
+       * conjugate gradient method.
+       */
+      void
+      sadd_ratio(const Number *        numerator,
+                 const Number *        denominator,
+                 const Vector<Number> &V);
+
+      /**
+       * Set the CUDA stream on which all kernels and memory transfers of
+       * this vector are issued. The stream is not owned by the vector.
+       */
+      void
+      set_stream(const cudaStream_t stream);
+
+      /**
+       * Return the CUDA stream used by this vector.
+       */
+      cudaStream_t
+      get_stream() const;
+
       /**
        * Return the pointer to the underlying array. Ownership still resides
        * with this class.
@@ -343,6 +431,32 @@ namespace LinearAlgebra
        * Number of elements in the vector.
        */
       size_type n_elements;
+
+      /**
+       * The CUDA stream on which the operations of this vector are issued.
+       */
+      cudaStream_t stream;
+
+      /**
+       * A scalar in device memory to store the results of reductions
+       * returned to the host. It is allocated on first use and kept to avoid
+       * the device-wide synchronization implied by freeing device memory.
+       */
+      mutable std::unique_ptr<Number[], void (*)(Number *)> reduction_buffer;
+
+      /**
+       * Return the reduction buffer, set to zero on the stream of this
+       * vector.
+       */
+      Number *
+      get_zeroed_reduction_buffer() const;
+
+      /**
+       * Copy the content of the reduction buffer to the host, waiting for
+       * the completion of the operations on the stream of this vector.
+       */
+      Number
+      read_reduction_buffer() const;
     };
   } // namespace CUDAWrappers
 } // namespace LinearAlgebra
@@ -394,6 +508,24 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number>
+    inline void
+    Vector<Number>::set_stream(const cudaStream_t new_stream)
+    {
+      stream = new_stream;
+    }
+
+
+
+    template <typename Number>
+    inline cudaStream_t
+    Vector<Number>::get_stream() const
+    {
+      return stream;
+    }
+
+
+
     template <typename Number>
     inline void
     Vector<Number>::swap(Vector<Number> &v)
@@ -23,6 +23,7 @@
 
 #    include <deal.II/lac/block_sparse_matrix.h>
 #    include <deal.II/lac/exceptions.h>
+#    include <deal.II/lac/la_parallel_vector.h>
 #    include <deal.II/lac/solver_control.h>
 #    include <deal.II/lac/sparse_matrix.h>
 #    include <deal.II/lac/vector.h>
@@ -111,6 +112,11 @@ namespace GinkgoWrappers
 
     /**
      * Initialize the matrix and copy over its data to Ginkgo's data structures.
+     *
+     * The matrix is stored on the device of the executor, and the solver,
+     * including its preconditioner, is generated for it right away. Both
+     * are kept until the next call of this function, so that subsequent
+     * calls to apply() only transfer the vectors.
      */
     void
     initialize(const SparseMatrix<ValueType> &matrix);
@@ -123,6 +129,17 @@ namespace GinkgoWrappers
     void
     apply(Vector<ValueType> &solution, const Vector<ValueType> &rhs);
 
+    /**
+     * Solve the linear system <tt>Ax=b</tt> for vectors of type
+     * LinearAlgebra::distributed::Vector. As the Ginkgo solvers work in a
+     * single address space, all elements of the vectors need to be locally
+     * owned, i.e., the vectors must not be partitioned among several MPI
+     * processes.
+     */
+    void
+    apply(LinearAlgebra::distributed::Vector<ValueType> &      solution,
+          const LinearAlgebra::distributed::Vector<ValueType> &rhs);
+
     /**
      * Solve the linear system <tt>Ax=b</tt>. Dependent on the information
      * provided by derived classes one of Ginkgo's linear solvers is
@@ -179,6 +196,15 @@ namespace GinkgoWrappers
     std::shared_ptr<gko::Executor> executor;
 
   private:
+    /**
+     * Solve the linear system for the @p size entries starting at
+     * @p solution and @p rhs, which are stored on the host.
+     */
+    void
+    apply_to_raw_data(ValueType *       solution,
+                      const ValueType * rhs,
+                      const std::size_t size);
+
     /**
      * Initialize the Ginkgo logger object with event masks. Refer to
      * <a
@@ -197,6 +223,12 @@ namespace GinkgoWrappers
      */
     std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>> system_matrix;
 
+    /**
+     * The solver generated by solver_gen for system_matrix in
+     * initialize().
+     */
+    std::shared_ptr<gko::LinOp> solver;
+
     /**
      * The execution paradigm as a string to be set by the user. The choices
      * are between `omp`, `cuda` and `reference` and more details can be found
@@ -568,6 +600,37 @@ namespace GinkgoWrappers
   };
 
 
+  /**
+   * Create the factory of one of Ginkgo's preconditioners, to be passed to
+   * the constructors of the solver classes above. The preconditioner is
+   * generated for the system matrix together with the solver in
+   * SolverBase::initialize(), i.e., it is reused by all calls to
+   * SolverBase::apply() with the same matrix.
+   *
+   * The @p name is one of
+   * - "none": no preconditioner, represented by a null pointer,
+   * - "jacobi": block-Jacobi with blocks of up to @p max_block_size rows
+   *   that Ginkgo detects from the sparsity pattern,
+   * - "ilu": incomplete LU factorization without fill-in, computed by
+   *   Ginkgo's fixed-point iteration (ParILU),
+   * - "parilut": threshold-based incomplete LU factorization (ParILUT).
+   *
+   * @p exec_type selects the executor as in the constructor of SolverBase,
+   * and should match the one of the solver.
+   */
+  template <typename ValueType = double, typename IndexType = int32_t>
+  std::shared_ptr<gko::LinOpFactory>
+  create_preconditioner(const std::string &name,
+                        const std::string &exec_type,
+                        const unsigned int max_block_size = 32);
+
+  /**
+   * Return the names of the preconditioners create_preconditioner()
+   * accepts, separated by vertical bars as needed by Patterns::Selection.
+   */
+  std::string
+  get_preconditioner_names();
+
 } // namespace GinkgoWrappers
 
 DEAL_II_NAMESPACE_CLOSE
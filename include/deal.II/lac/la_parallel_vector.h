@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/numbers.h>
@@ -776,6 +777,27 @@ namespace LinearAlgebra
                   const VectorSpaceVector<Number> &V,
                   const VectorSpaceVector<Number> &W) override;
 
+      /**
+       * Compute the inner products of the present vector with all vectors
+       * in @p vectors at once, i.e., set
+       * @code
+       * results[k] = *this * (*vectors[k]);
+       * @endcode
+       * for all @p k. The entries of @p this are read from memory once for
+       * every group of up to four vectors rather than once per vector, and
+       * the results of all inner products are combined in a single global
+       * reduction. This is useful for iterative solvers that need several
+       * scalar products involving the same vector, e.g., a product and a
+       * norm, and that are limited by memory transfer and the latency of
+       * global communication.
+       *
+       * The same applies for complex-valued vectors as for operator*().
+       */
+      void
+      multi_dot(const ArrayView<const Vector<Number, MemorySpace> *const>
+                  &                      vectors,
+                const ArrayView<Number> &results) const;
+
       /**
        * Return the global size of the vector, equal to the sum of the number of
        * locally owned indices among all processors.
@@ -1086,6 +1108,24 @@ namespace LinearAlgebra
       const std::shared_ptr<const Utilities::MPI::Partitioner> &
       get_partitioner() const;
 
+      /**
+       * Return views to the locally owned and ghost entries of all processes
+       * in the shared-memory communicator of the partitioner, indexed by the
+       * rank within that communicator, see
+       * Utilities::MPI::Partitioner::set_shared_memory_communicator(). If a
+       * shared-memory communicator with more than one process is set, the
+       * memory of the vector is allocated in an MPI shared-memory window
+       * and the ghost exchange copies the entries of processes on the same
+       * node directly from their memory. Otherwise, the returned array is
+       * empty.
+       *
+       * @note Since the allocation of the window is collective over the
+       * shared-memory communicator, reinit() and the destruction of such a
+       * vector must be performed by all processes of that communicator.
+       */
+      const std::vector<ArrayView<const Number>> &
+      shared_vector_data() const;
+
       /**
        * Check whether the given partitioner is compatible with the
        * partitioner used for this vector. Two partitioners are compatible if
@@ -1231,6 +1271,14 @@ namespace LinearAlgebra
                         const Vector<Number, MemorySpace> &V,
                         const Vector<Number, MemorySpace> &W);
 
+      /**
+       * Local part of multi_dot().
+       */
+      void
+      multi_dot_local(
+        const ArrayView<const Vector<Number, MemorySpace> *const> &vectors,
+        const ArrayView<Number> &results) const;
+
       /**
        * Shared pointer to store the parallel partitioning information. This
        * information can be shared between several vectors that have the same
@@ -1248,6 +1296,13 @@ namespace LinearAlgebra
        */
       mutable ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> data;
 
+      /**
+       * Views to the memory of all processes in the shared-memory
+       * communicator of the partitioner if @p data is allocated in an MPI
+       * shared-memory window, and empty otherwise.
+       */
+      std::vector<ArrayView<const Number>> shared_values;
+
       /**
        * For parallel loops with TBB, this member variable stores the affinity
        * information of loops.
@@ -1702,6 +1757,15 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpace>
+    inline const std::vector<ArrayView<const Number>> &
+    Vector<Number, MemorySpace>::shared_vector_data() const
+    {
+      return shared_values;
+    }
+
+
+
     template <typename Number, typename MemorySpace>
     inline void
     Vector<Number, MemorySpace>::set_ghost_state(const bool ghosted) const
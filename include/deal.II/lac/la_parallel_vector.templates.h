@@ -94,7 +94,9 @@ namespace LinearAlgebra
           const types::global_dof_index /*new_alloc_size*/,
           types::global_dof_index & /*allocated_size*/,
           ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
-            & /*data*/)
+            & /*data*/,
+          std::vector<ArrayView<const Number>> & /*shared_values*/,
+          const MPI_Comm & /*communicator_sm*/)
         {}
 
         static void
@@ -128,9 +130,85 @@ namespace LinearAlgebra
         resize_val(const types::global_dof_index new_alloc_size,
                    types::global_dof_index &     allocated_size,
                    ::dealii::MemorySpace::
-                     MemorySpaceData<Number, ::dealii::MemorySpace::Host> &data)
+                     MemorySpaceData<Number, ::dealii::MemorySpace::Host> &data,
+                   std::vector<ArrayView<const Number>> &shared_values,
+                   const MPI_Comm &                      communicator_sm)
         {
-          if (new_alloc_size > allocated_size)
+#ifdef DEAL_II_WITH_MPI
+          const unsigned int n_procs_sm =
+            Utilities::MPI::job_supports_mpi() ?
+              Utilities::MPI::n_mpi_processes(communicator_sm) :
+              1;
+          if (n_procs_sm > 1)
+            {
+              // allocating a shared-memory window is collective, so all
+              // processes of the shared-memory communicator need to agree on
+              // whether to reallocate
+              const unsigned int must_reallocate =
+                (new_alloc_size > allocated_size ||
+                 shared_values.size() != n_procs_sm) ?
+                  1 :
+                  0;
+              if (Utilities::MPI::max(must_reallocate, communicator_sm) == 0)
+                return;
+
+              // release the old memory first, which might be a window
+              // itself
+              shared_values.clear();
+              data.values.reset();
+
+              MPI_Info info;
+              int      ierr = MPI_Info_create(&info);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Info_set(info, "alloc_shared_noncontig", "true");
+              AssertThrowMPI(ierr);
+
+              // allocate at least one entry, such that the pointer is
+              // non-zero and the deleter that frees the window runs on all
+              // processes
+              Number *new_val = nullptr;
+              MPI_Win win;
+              ierr = MPI_Win_allocate_shared(
+                std::max<types::global_dof_index>(new_alloc_size, 1) *
+                  sizeof(Number),
+                sizeof(Number),
+                info,
+                communicator_sm,
+                &new_val,
+                &win);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Info_free(&info);
+              AssertThrowMPI(ierr);
+
+              data.values = {new_val, [win](Number *) mutable {
+                               int finalized = 0;
+                               MPI_Finalized(&finalized);
+                               if (finalized == 0)
+                                 MPI_Win_free(&win);
+                             }};
+
+              // look up the memory of the other processes on the node
+              shared_values.resize(n_procs_sm);
+              for (unsigned int p = 0; p < n_procs_sm; ++p)
+                {
+                  MPI_Aint size      = 0;
+                  int      disp_unit = 0;
+                  Number * ptr       = nullptr;
+                  ierr =
+                    MPI_Win_shared_query(win, p, &size, &disp_unit, &ptr);
+                  AssertThrowMPI(ierr);
+                  shared_values[p] =
+                    ArrayView<const Number>(ptr, size / sizeof(Number));
+                }
+
+              allocated_size = new_alloc_size;
+              return;
+            }
+#else
+          (void)communicator_sm;
+#endif
+
+          if (new_alloc_size > allocated_size || shared_values.size() > 0)
             {
               Assert(((allocated_size > 0 && data.values != nullptr) ||
                       data.values == nullptr),
@@ -141,7 +219,10 @@ namespace LinearAlgebra
                 reinterpret_cast<void **>(&new_val),
                 64,
                 sizeof(Number) * new_alloc_size);
-              data.values.reset(new_val);
+              // assign a new deleter as well, since the previous memory
+              // might have been a shared-memory window
+              data.values = {new_val, &std::free};
+              shared_values.clear();
 
               allocated_size = new_alloc_size;
             }
@@ -230,7 +311,9 @@ namespace LinearAlgebra
         resize_val(const types::global_dof_index new_alloc_size,
                    types::global_dof_index &     allocated_size,
                    ::dealii::MemorySpace::
-                     MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &data)
+                     MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &data,
+                   std::vector<ArrayView<const Number>> & /*shared_values*/,
+                   const MPI_Comm & /*communicator_sm*/)
         {
           static_assert(
             std::is_same<Number, float>::value ||
@@ -382,18 +465,12 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::clear_mpi_requests()
     {
 #ifdef DEAL_II_WITH_MPI
-      for (auto &compress_request : compress_requests)
-        {
-          const int ierr = MPI_Request_free(&compress_request);
-          AssertThrowMPI(ierr);
-        }
-      compress_requests.clear();
-      for (auto &update_ghost_values_request : update_ghost_values_requests)
-        {
-          const int ierr = MPI_Request_free(&update_ghost_values_request);
-          AssertThrowMPI(ierr);
-        }
-      update_ghost_values_requests.clear();
+      // the requests are persistent ones held by the partitioner, so let the
+      // partitioner free them
+      if (compress_requests.size() > 0)
+        partitioner->free_requests(compress_requests);
+      if (update_ghost_values_requests.size() > 0)
+        partitioner->free_requests(update_ghost_values_requests);
 #endif
     }
 
@@ -403,9 +480,15 @@ namespace LinearAlgebra
     void
     Vector<Number, MemorySpaceType>::resize_val(const size_type new_alloc_size)
     {
-      internal::la_parallel_vector_templates_functions<
-        Number,
-        MemorySpaceType>::resize_val(new_alloc_size, allocated_size, data);
+      internal::la_parallel_vector_templates_functions<Number,
+                                                       MemorySpaceType>::
+        resize_val(new_alloc_size,
+                   allocated_size,
+                   data,
+                   shared_values,
+                   partitioner.get() != nullptr ?
+                     partitioner->get_shared_memory_communicator() :
+                     MPI_COMM_SELF);
 
       thread_loop_partitioner =
         std::make_shared<::dealii::parallel::internal::TBBPartitioner>();
@@ -420,6 +503,9 @@ namespace LinearAlgebra
     {
       clear_mpi_requests();
 
+      // set partitioner to serial version
+      partitioner = std::make_shared<Utilities::MPI::Partitioner>(size);
+
       // check whether we need to reallocate
       resize_val(size);
 
@@ -427,9 +513,6 @@ namespace LinearAlgebra
       import_data.values.reset();
       import_data.values_dev.reset();
 
-      // set partitioner to serial version
-      partitioner = std::make_shared<Utilities::MPI::Partitioner>(size);
-
       // set entries to zero if so requested
       if (omit_zeroing_entries == false)
         this->operator=(Number());
@@ -452,8 +535,11 @@ namespace LinearAlgebra
       // check whether the partitioners are
       // different (check only if the are allocated
       // differently, not if the actual data is
-      // different)
-      if (partitioner.get() != v.partitioner.get())
+      // different). with a shared-memory communicator, the memory might
+      // need to be moved into a shared-memory window even for the same
+      // partitioner, which resize_val() decides collectively
+      if (partitioner.get() != v.partitioner.get() ||
+          v.partitioner->get_shared_memory_communicator() != MPI_COMM_SELF)
         {
           partitioner = v.partitioner;
           const size_type new_allocated_size =
@@ -950,7 +1036,8 @@ namespace LinearAlgebra
               ArrayView<Number, MemorySpace::Host>(
                 data.values.get() + partitioner->local_size(),
                 partitioner->n_ghost_indices()),
-              compress_requests);
+              compress_requests,
+              shared_values);
         }
 
 #  if defined DEAL_II_COMPILER_CUDA_AWARE && \
@@ -1081,9 +1168,6 @@ namespace LinearAlgebra
 #ifdef DEAL_II_WITH_MPI
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
-      AssertDimension(partitioner->ghost_targets().size() +
-                        partitioner->import_targets().size(),
-                      update_ghost_values_requests.size());
       if (update_ghost_values_requests.size() > 0)
         {
           // make this function thread safe
@@ -1095,7 +1179,8 @@ namespace LinearAlgebra
             ArrayView<Number, MemorySpace::Host>(
               data.values.get() + partitioner->local_size(),
               partitioner->n_ghost_indices()),
-            update_ghost_values_requests);
+            update_ghost_values_requests,
+            shared_values);
 #  else
           partitioner->export_to_ghosted_array_finish(
             ArrayView<Number, MemorySpace::CUDA>(
@@ -1257,6 +1342,7 @@ namespace LinearAlgebra
       std::swap(thread_loop_partitioner, v.thread_loop_partitioner);
       std::swap(allocated_size, v.allocated_size);
       std::swap(data, v.data);
+      std::swap(shared_values, v.shared_values);
       std::swap(import_data, v.import_data);
       std::swap(vector_is_ghosted, v.vector_is_ghosted);
     }
@@ -1854,6 +1940,53 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multi_dot_local(
+      const ArrayView<const Vector<Number, MemorySpaceType> *const> &vectors,
+      const ArrayView<Number> &results) const
+    {
+      AssertDimension(vectors.size(), results.size());
+
+      std::vector<
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType> *>
+        v_data(vectors.size());
+      for (unsigned int k = 0; k < vectors.size(); ++k)
+        {
+          Assert(vectors[k] != nullptr, ExcNotInitialized());
+          AssertDimension(partitioner->local_size(),
+                          vectors[k]->partitioner->local_size());
+          v_data[k] = &vectors[k]->data;
+        }
+
+      dealii::internal::VectorOperations::
+        functions<Number, Number, MemorySpaceType>::multi_dot(
+          thread_loop_partitioner,
+          partitioner->local_size(),
+          v_data.data(),
+          vectors.size(),
+          data,
+          results.data());
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multi_dot(
+      const ArrayView<const Vector<Number, MemorySpaceType> *const> &vectors,
+      const ArrayView<Number> &results) const
+    {
+      multi_dot_local(vectors, results);
+      if (partitioner->n_mpi_processes() > 1)
+        Utilities::MPI::sum(ArrayView<const Number>(results.data(),
+                                                    results.size()),
+                            partitioner->get_mpi_communicator(),
+                            results);
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     inline bool
     Vector<Number, MemorySpaceType>::partitioners_are_compatible(
@@ -20,10 +20,12 @@
 
 #include <deal.II/base/exceptions.h>
 
+#include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/vector_memory.h>
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 DEAL_II_NAMESPACE_OPEN
@@ -829,6 +831,204 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
   return inverse_operator(op, solver);
 }
 
+
+namespace internal
+{
+  namespace LinearOperatorImplementation
+  {
+    /**
+     * The solutions of the previous inner solves of an operator created by
+     * warm_start_inverse_operator(), one for vmult and one for Tvmult.
+     */
+    template <typename Range>
+    struct WarmStartData
+    {
+      Range solution;
+      bool  has_solution = false;
+
+      Range transpose_solution;
+      bool  has_transpose_solution = false;
+    };
+
+
+
+    /**
+     * Solve with @p op for the right hand side @p u, starting from the
+     * content of @p solution if @p has_solution is set, and from zero
+     * otherwise. If @p solver_control is given and @p relative_tolerance is
+     * positive, the tolerance of @p solver_control is set relative to the
+     * norm of @p u before solving.
+     */
+    template <typename Solver,
+              typename Operator,
+              typename Preconditioner,
+              typename Range,
+              typename Domain>
+    void
+    warm_start_solve(Solver &              solver,
+                     const Operator &      op,
+                     const Preconditioner &preconditioner,
+                     const Domain &        u,
+                     Range &               solution,
+                     bool &                has_solution,
+                     SolverControl *const  solver_control,
+                     const double          relative_tolerance)
+    {
+      if (has_solution == false)
+        {
+          op.reinit_range_vector(solution, /*omit_zeroing_entries =*/false);
+          has_solution = true;
+        }
+
+      if (solver_control != nullptr && relative_tolerance > 0.)
+        {
+          const double u_norm = u.l2_norm();
+          if (u_norm == 0.)
+            {
+              solution = 0.;
+              return;
+            }
+          solver_control->set_tolerance(relative_tolerance * u_norm);
+        }
+
+      solver.solve(op, solution, u, preconditioner);
+    }
+  } // namespace LinearOperatorImplementation
+} // namespace internal
+
+
+/**
+ * @relatesalso LinearOperator
+ *
+ * Variant of inverse_operator() for inner solves that are applied many
+ * times with similar right hand sides, like the inverse of the velocity
+ * block inside a Schur complement or a block preconditioner of a Stokes
+ * problem that is applied in every step of an outer solver or of a
+ * nonlinear iteration.
+ *
+ * Rather than solving from a zero initial guess in each application, the
+ * returned operator keeps the solution of the previous application (in a
+ * vector that is allocated once and shared among all copies of the
+ * returned LinearOperator) and uses it as starting value for the next
+ * solve. This pays off when subsequent right hand sides are close to each
+ * other; if they are not, the starting value is not better than zero, but
+ * does not do any harm either except for an unnecessary first residual
+ * computation. Note that, as a consequence, the result of an application
+ * depends on the previous applications to within the solver tolerance, and
+ * the operator is not exactly linear. An outer solver should be chosen that
+ * can deal with this, e.g., SolverFGMRES, unless the inner solves are
+ * accurate.
+ *
+ * If @p solver_control points to the SolverControl object that @p solver
+ * uses and @p relative_tolerance is positive, the tolerance is set to
+ * <code>relative_tolerance * u.l2_norm()</code> before each inner solve of
+ * the system with right hand side <code>u</code>. When the operator is
+ * applied to (a function of) the residual of an outer iteration, the inner
+ * solves are then only as accurate as needed relative to the current outer
+ * residual, which avoids oversolving in the late outer iterations.
+ *
+ * Like for inverse_operator(), the returned object stores a reference to
+ * @p solver and @p preconditioner that must remain valid for the lifetime of
+ * the LinearOperator object.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Payload,
+          typename Solver,
+          typename Preconditioner,
+          typename Range  = typename Solver::vector_type,
+          typename Domain = Range>
+LinearOperator<Domain, Range, Payload>
+warm_start_inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
+                            Solver &              solver,
+                            const Preconditioner &preconditioner,
+                            SolverControl *const  solver_control = nullptr,
+                            const double          relative_tolerance = 0.)
+{
+  LinearOperator<Domain, Range, Payload> return_op{
+    op.inverse_payload(solver, preconditioner)};
+
+  return_op.reinit_range_vector  = op.reinit_domain_vector;
+  return_op.reinit_domain_vector = op.reinit_range_vector;
+
+  const auto data = std::make_shared<
+    internal::LinearOperatorImplementation::WarmStartData<Range>>();
+
+  return_op.vmult = [op,
+                     &solver,
+                     &preconditioner,
+                     data,
+                     solver_control,
+                     relative_tolerance](Range &v, const Domain &u) {
+    internal::LinearOperatorImplementation::warm_start_solve(
+      solver,
+      op,
+      preconditioner,
+      u,
+      data->solution,
+      data->has_solution,
+      solver_control,
+      relative_tolerance);
+    v = data->solution;
+  };
+
+  return_op.vmult_add = [op,
+                         &solver,
+                         &preconditioner,
+                         data,
+                         solver_control,
+                         relative_tolerance](Range &v, const Domain &u) {
+    internal::LinearOperatorImplementation::warm_start_solve(
+      solver,
+      op,
+      preconditioner,
+      u,
+      data->solution,
+      data->has_solution,
+      solver_control,
+      relative_tolerance);
+    v += data->solution;
+  };
+
+  return_op.Tvmult = [op,
+                      &solver,
+                      &preconditioner,
+                      data,
+                      solver_control,
+                      relative_tolerance](Range &v, const Domain &u) {
+    internal::LinearOperatorImplementation::warm_start_solve(
+      solver,
+      transpose_operator(op),
+      preconditioner,
+      u,
+      data->transpose_solution,
+      data->has_transpose_solution,
+      solver_control,
+      relative_tolerance);
+    v = data->transpose_solution;
+  };
+
+  return_op.Tvmult_add = [op,
+                          &solver,
+                          &preconditioner,
+                          data,
+                          solver_control,
+                          relative_tolerance](Range &v, const Domain &u) {
+    internal::LinearOperatorImplementation::warm_start_solve(
+      solver,
+      transpose_operator(op),
+      preconditioner,
+      u,
+      data->transpose_solution,
+      data->has_transpose_solution,
+      solver_control,
+      relative_tolerance);
+    v += data->transpose_solution;
+  };
+
+  return return_op;
+}
+
 //@}
 
 
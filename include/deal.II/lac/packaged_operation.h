@@ -23,6 +23,10 @@
 #include <deal.II/lac/vector_memory.h>
 
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -36,6 +40,19 @@ template <typename Range = Vector<double>>
 class PackagedOperation;
 #endif
 
+namespace internal
+{
+  namespace PackagedOperationImplementation
+  {
+    template <typename Range>
+    class LinearCombination;
+
+    template <typename Range>
+    std::shared_ptr<const LinearCombination<Range>>
+    linear_combination_of(const Range &u);
+  } // namespace PackagedOperationImplementation
+} // namespace internal
+
 
 /**
  * A class to store a computation.
@@ -95,6 +112,19 @@ class PackagedOperation;
  *   y -= residual;
  * @endcode
  *
+ * Expressions that only consist of additions, subtractions and scalings of
+ * vectors, like <code>a + 2. * b - c</code> above, are not evaluated as a
+ * chain of nested operations. Instead, the coefficients of all vectors are
+ * collected when the expression is built, and <code>apply</code> evaluates
+ * them with as few vector updates as possible, using the
+ * <code>equ()</code>, <code>sadd()</code>, and two-vector <code>add()</code>
+ * functions of the vector class. This requires one pass over memory per two
+ * vectors, instead of one or more passes per vector and per scaling. The
+ * same holds if such a linear combination is added to or subtracted from a
+ * general PackagedOperation, like in the residual <code>b - op_a * x</code>.
+ * Vector types that do not provide these functions are evaluated term by
+ * term as before.
+ *
  * @note The step-20 tutorial program has a detailed usage example of the
  * LinearOperator class.
  *
@@ -176,6 +206,9 @@ public:
       v.reinit(u, omit_zeroing_entries);
     };
 
+    linear_combination =
+      internal::PackagedOperationImplementation::linear_combination_of(u);
+
     return *this;
   }
 
@@ -274,9 +307,307 @@ public:
    * content of the vector is set to 0.
    */
   std::function<void(Range &v, bool omit_zeroing_entries)> reinit_vector;
+
+  /**
+   * If this object represents a linear combination of vectors, i.e., it was
+   * created from vectors by additions, subtractions, and scalings only, a
+   * description of the coefficients and vectors involved. The operators
+   * combining PackagedOperation objects use it to evaluate the whole
+   * combination in as few passes over memory as possible. Otherwise, or if
+   * the @p Range vector type does not support the required operations, this
+   * is an empty pointer.
+   */
+  std::shared_ptr<
+    const internal::PackagedOperationImplementation::LinearCombination<Range>>
+    linear_combination;
 };
 
 
+
+namespace internal
+{
+  namespace PackagedOperationImplementation
+  {
+    /**
+     * A trait class that determines whether the vector type @p T provides
+     * the functions <code>equ(a, V)</code>, <code>sadd(s, a, V)</code>,
+     * <code>add(a, V)</code>, and <code>add(a, V, b, W)</code> needed to
+     * evaluate a LinearCombination.
+     */
+    template <typename T>
+    class supports_linear_combination
+    {
+      template <typename C>
+      static std::false_type
+      test(...);
+
+      template <typename C, typename Number = typename C::value_type>
+      static decltype(
+        std::declval<C &>().equ(std::declval<Number>(),
+                                std::declval<const C &>()),
+        std::declval<C &>().sadd(std::declval<Number>(),
+                                 std::declval<Number>(),
+                                 std::declval<const C &>()),
+        std::declval<C &>().add(std::declval<Number>(),
+                                std::declval<const C &>()),
+        std::declval<C &>().add(std::declval<Number>(),
+                                std::declval<const C &>(),
+                                std::declval<Number>(),
+                                std::declval<const C &>()),
+        std::true_type())
+      test(int);
+
+    public:
+      using type = decltype(test<T>(0));
+    };
+
+
+
+    /**
+     * The coefficients and vectors of a linear combination
+     * $\sum_i a_i u_i$ of vectors, stored by a PackagedOperation that was
+     * created from vectors by additions, subtractions, and scalings only.
+     * The vectors are stored by reference.
+     */
+    template <typename Range>
+    class LinearCombination
+    {
+    public:
+      using value_type = typename Range::value_type;
+
+      /**
+       * Compute $v = s v + \sum_i a_i u_i$. If @p s is zero, the previous
+       * content of @p v is ignored. Two terms are processed at a time, so
+       * that the vector is traversed only once per two terms.
+       */
+      void
+      apply(Range &v, const value_type s) const
+      {
+        Assert(terms.size() > 0, ExcInternalError());
+
+        std::size_t i = 0;
+        if (s == value_type())
+          {
+            v.equ(terms[0].first, *terms[0].second);
+            i = 1;
+          }
+        else if (s != value_type(1.))
+          {
+            v.sadd(s, terms[0].first, *terms[0].second);
+            i = 1;
+          }
+
+        for (; i + 1 < terms.size(); i += 2)
+          v.add(terms[i].first,
+                *terms[i].second,
+                terms[i + 1].first,
+                *terms[i + 1].second);
+
+        if (i < terms.size())
+          v.add(terms[i].first, *terms[i].second);
+      }
+
+      /**
+       * Coefficients and references to the vectors of the combination.
+       */
+      std::vector<std::pair<value_type, const Range *>> terms;
+    };
+
+
+
+    // Create the linear combination consisting of only the vector u, or an
+    // empty pointer if the vector type does not support linear combinations.
+    template <typename Range>
+    std::shared_ptr<const LinearCombination<Range>>
+    linear_combination_of(const Range &u, std::true_type)
+    {
+      auto result = std::make_shared<LinearCombination<Range>>();
+      result->terms.emplace_back(typename Range::value_type(1.), &u);
+      return result;
+    }
+
+
+
+    template <typename Range>
+    std::shared_ptr<const LinearCombination<Range>>
+    linear_combination_of(const Range &, std::false_type)
+    {
+      return nullptr;
+    }
+
+
+
+    template <typename Range>
+    std::shared_ptr<const LinearCombination<Range>>
+    linear_combination_of(const Range &u)
+    {
+      return linear_combination_of(
+        u, typename supports_linear_combination<Range>::type());
+    }
+
+
+
+    // Return a copy of the linear combination @p lc with all coefficients
+    // multiplied by @p number.
+    template <typename Range>
+    std::shared_ptr<const LinearCombination<Range>>
+    scaled_linear_combination(const LinearCombination<Range> &       lc,
+                              const typename Range::value_type number)
+    {
+      auto result = std::make_shared<LinearCombination<Range>>(lc);
+      for (auto &term : result->terms)
+        term.first *= number;
+      return result;
+    }
+
+
+
+    // Create a PackagedOperation that evaluates the linear combination lc.
+    template <typename Range>
+    PackagedOperation<Range>
+    make_packaged_operation(
+      const std::shared_ptr<const LinearCombination<Range>> &lc)
+    {
+      PackagedOperation<Range> return_comp;
+
+      const Range *u             = lc->terms[0].second;
+      return_comp.reinit_vector = [u](Range &x, bool omit_zeroing_entries) {
+        x.reinit(*u, omit_zeroing_entries);
+      };
+
+      return_comp.apply = [lc](Range &v) {
+        lc->apply(v, typename Range::value_type());
+      };
+
+      return_comp.apply_add = [lc](Range &v) {
+        lc->apply(v, typename Range::value_type(1.));
+      };
+
+      return_comp.linear_combination = lc;
+
+      return return_comp;
+    }
+
+
+
+    // Try to create a fused PackagedOperation for the sum (or, if subtract
+    // is true, the difference) of first_comp and second_comp. This is
+    // possible if at least one of them is a linear combination of vectors.
+    // Return whether return_comp was set.
+    template <typename Range>
+    bool
+    fuse_sum(const PackagedOperation<Range> &first_comp,
+             const PackagedOperation<Range> &second_comp,
+             const bool                      subtract,
+             PackagedOperation<Range> &      return_comp,
+             std::true_type)
+    {
+      using value_type = typename Range::value_type;
+
+      const auto &first_lc  = first_comp.linear_combination;
+      const auto &second_lc = second_comp.linear_combination;
+
+      if (first_lc != nullptr && second_lc != nullptr)
+        {
+          // both are linear combinations: merge the lists of terms
+          auto lc = std::make_shared<LinearCombination<Range>>(*first_lc);
+          for (const auto &term : second_lc->terms)
+            lc->terms.emplace_back(subtract ? -term.first : term.first,
+                                   term.second);
+          return_comp = make_packaged_operation<Range>(lc);
+          return true;
+        }
+      else if (first_lc != nullptr)
+        {
+          // evaluate the general operation first, and then fold its sign
+          // into the first update with the linear combination
+          return_comp.reinit_vector = first_comp.reinit_vector;
+
+          const value_type sign = subtract ? value_type(-1.) : value_type(1.);
+
+          return_comp.apply = [first_lc, second_comp, sign](Range &v) {
+            second_comp.apply(v);
+            first_lc->apply(v, sign);
+          };
+
+          return_comp.apply_add = [first_lc, second_comp, sign](Range &v) {
+            if (sign != value_type(1.))
+              v *= -1.;
+            second_comp.apply_add(v);
+            first_lc->apply(v, sign);
+          };
+          return true;
+        }
+      else if (second_lc != nullptr)
+        {
+          return_comp.reinit_vector = first_comp.reinit_vector;
+
+          const auto lc =
+            subtract ? scaled_linear_combination(*second_lc, value_type(-1.)) :
+                       second_lc;
+
+          return_comp.apply = [first_comp, lc](Range &v) {
+            first_comp.apply(v);
+            lc->apply(v, value_type(1.));
+          };
+
+          return_comp.apply_add = [first_comp, lc](Range &v) {
+            first_comp.apply_add(v);
+            lc->apply(v, value_type(1.));
+          };
+          return true;
+        }
+
+      return false;
+    }
+
+
+
+    template <typename Range>
+    bool
+    fuse_sum(const PackagedOperation<Range> &,
+             const PackagedOperation<Range> &,
+             const bool,
+             PackagedOperation<Range> &,
+             std::false_type)
+    {
+      return false;
+    }
+
+
+
+    // Try to create a fused PackagedOperation for the scaling of comp with a
+    // nonzero number. Return whether return_comp was set.
+    template <typename Range>
+    bool
+    fuse_scaling(const PackagedOperation<Range> & comp,
+                 const typename Range::value_type number,
+                 PackagedOperation<Range> &       return_comp,
+                 std::true_type)
+    {
+      if (comp.linear_combination == nullptr)
+        return false;
+
+      return_comp = make_packaged_operation(
+        scaled_linear_combination(*comp.linear_combination, number));
+      return true;
+    }
+
+
+
+    template <typename Range>
+    bool
+    fuse_scaling(const PackagedOperation<Range> &,
+                 const typename Range::value_type,
+                 PackagedOperation<Range> &,
+                 std::false_type)
+    {
+      return false;
+    }
+  } // namespace PackagedOperationImplementation
+} // namespace internal
+
+
 /**
  * @name Vector space operations
  */
@@ -297,6 +628,16 @@ operator+(const PackagedOperation<Range> &first_comp,
 {
   PackagedOperation<Range> return_comp;
 
+  // evaluate linear combinations of vectors in a fused way if possible
+  if (internal::PackagedOperationImplementation::fuse_sum(
+        first_comp,
+        second_comp,
+        /*subtract =*/false,
+        return_comp,
+        typename internal::PackagedOperationImplementation::
+          supports_linear_combination<Range>::type()))
+    return return_comp;
+
   return_comp.reinit_vector = first_comp.reinit_vector;
 
   // ensure to have valid PackagedOperation objects by catching first_comp and
@@ -330,6 +671,16 @@ operator-(const PackagedOperation<Range> &first_comp,
 {
   PackagedOperation<Range> return_comp;
 
+  // evaluate linear combinations of vectors in a fused way if possible
+  if (internal::PackagedOperationImplementation::fuse_sum(
+        first_comp,
+        second_comp,
+        /*subtract =*/true,
+        return_comp,
+        typename internal::PackagedOperationImplementation::
+          supports_linear_combination<Range>::type()))
+    return return_comp;
+
   return_comp.reinit_vector = first_comp.reinit_vector;
 
   // ensure to have valid PackagedOperation objects by catching first_comp and
@@ -374,6 +725,14 @@ PackagedOperation<Range> operator*(const PackagedOperation<Range> &comp,
 
       return_comp.apply_add = [](Range &) {};
     }
+  // scale the coefficients of a linear combination of vectors directly
+  else if (internal::PackagedOperationImplementation::fuse_scaling(
+             comp,
+             number,
+             return_comp,
+             typename internal::PackagedOperationImplementation::
+               supports_linear_combination<Range>::type()))
+    return return_comp;
   else
     {
       return_comp.apply = [comp, number](Range &v) {
@@ -530,6 +889,16 @@ operator+(const Range &u, const Range &v)
 {
   PackagedOperation<Range> return_comp;
 
+  // evaluate linear combinations of vectors in a fused way if possible
+  if (internal::PackagedOperationImplementation::fuse_sum(
+        PackagedOperation<Range>(u),
+        PackagedOperation<Range>(v),
+        /*subtract =*/false,
+        return_comp,
+        typename internal::PackagedOperationImplementation::
+          supports_linear_combination<Range>::type()))
+    return return_comp;
+
   // ensure to have valid PackagedOperation objects by catching op by value
   // u is caught by reference
 
@@ -575,6 +944,16 @@ operator-(const Range &u, const Range &v)
 {
   PackagedOperation<Range> return_comp;
 
+  // evaluate linear combinations of vectors in a fused way if possible
+  if (internal::PackagedOperationImplementation::fuse_sum(
+        PackagedOperation<Range>(u),
+        PackagedOperation<Range>(v),
+        /*subtract =*/true,
+        return_comp,
+        typename internal::PackagedOperationImplementation::
+          supports_linear_combination<Range>::type()))
+    return return_comp;
+
   // ensure to have valid PackagedOperation objects by catching op by value
   // u is caught by reference
 
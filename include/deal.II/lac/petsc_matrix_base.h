@@ -32,6 +32,7 @@
 #    include <petscmat.h>
 
 #    include <cmath>
+#    include <cstdint>
 #    include <memory>
 #    include <vector>
 
@@ -562,6 +563,42 @@ namespace PETScWrappers
     void
     compress(const VectorOperation::values operation);
 
+    /**
+     * Start a bulk assembly of the matrix. Until finish_coo_assembly() is
+     * called, all add() operations, e.g. the ones issued by
+     * AffineConstraints::distribute_local_to_global(), are not passed to
+     * PETSc entry by entry but collected as a list of (row, column, value)
+     * triplets in coordinate (COO) format. finish_coo_assembly() then hands
+     * all contributions to PETSc with a single call to MatSetValuesCOO(),
+     * which avoids the search for the position of each entry in the rows of
+     * the matrix and the stash of the off-processor entries.
+     *
+     * The first bulk assembly after the creation of the matrix also sets
+     * the pattern of the triplets with MatSetPreallocationCOO(), which
+     * replaces the sparsity pattern the matrix was initialized with. Later
+     * assemblies only collect the values and must add the same entries in
+     * the same order, which is the case when the same loop over cells is
+     * run again. In contrast to the usual add() operation, zero values are
+     * never elided while collecting the triplets, because the positions
+     * must be the same in all assemblies.
+     *
+     * Bulk assembly requires PETSc 3.17 or later. For older versions, this
+     * function only sets the matrix to zero, the entries are added
+     * individually as usual, and finish_coo_assembly() calls compress().
+     */
+    void
+    start_coo_assembly();
+
+    /**
+     * Hand the triplets collected since the call to start_coo_assembly() to
+     * PETSc and assemble the matrix. The previous content of the matrix is
+     * replaced by the sum of the collected contributions, so the matrix does
+     * not need to be set to zero before the assembly, and there is no need
+     * to call compress() afterwards. This is a collective operation.
+     */
+    void
+    finish_coo_assembly();
+
     /**
      * Return the value of the entry (<i>i,j</i>).  This may be an expensive
      * operation and you should always take care where to call this function.
@@ -1070,6 +1107,34 @@ namespace PETScWrappers
      */
     mutable std::vector<PetscScalar> column_values;
 
+    /**
+     * Whether add() operations are currently collected for a bulk assembly,
+     * i.e., whether start_coo_assembly() has been called without a matching
+     * call to finish_coo_assembly().
+     */
+    bool coo_assembly_active;
+
+    /**
+     * Row and column indices of the triplets collected in a bulk assembly.
+     * They are only kept until the pattern has been set in PETSc (and in
+     * debug mode, to check that later assemblies add the same entries).
+     */
+    std::vector<PetscInt> coo_rows;
+    std::vector<PetscInt> coo_columns;
+
+    /**
+     * Values of the triplets collected in a bulk assembly.
+     */
+    std::vector<PetscScalar> coo_values;
+
+    /**
+     * The PETSc id of the matrix object for which the pattern of the
+     * triplets has been set, or -1 if it has not been set. Comparing this to
+     * the id of the current matrix object detects a re-creation of the
+     * matrix by reinit(), which requires to set the pattern again.
+     */
+    std::int64_t coo_pattern_matrix_id;
+
 
     // To allow calling protected prepare_add() and prepare_set().
     template <class>
@@ -1435,6 +1500,40 @@ namespace PETScWrappers
   {
     (void)elide_zero_values;
 
+    if (coo_assembly_active)
+      {
+        // collect the triplets and leave it to finish_coo_assembly() to
+        // hand them to PETSc
+        const bool record_indices = (coo_pattern_matrix_id < 0);
+#      ifdef DEBUG
+        const bool check_indices = !record_indices;
+#      endif
+        const std::size_t first = coo_values.size();
+        for (size_type j = 0; j < n_cols; ++j)
+          {
+            AssertIsFinite(values[j]);
+            coo_values.push_back(values[j]);
+          }
+        if (record_indices)
+          {
+            coo_rows.resize(first + n_cols, static_cast<PetscInt>(row));
+            coo_columns.insert(coo_columns.end(),
+                               col_indices,
+                               col_indices + n_cols);
+          }
+#      ifdef DEBUG
+        else if (check_indices && coo_rows.size() >= first + n_cols)
+          for (size_type j = 0; j < n_cols; ++j)
+            Assert(coo_rows[first + j] == static_cast<PetscInt>(row) &&
+                     coo_columns[first + j] ==
+                       static_cast<PetscInt>(col_indices[j]),
+                   ExcMessage("The entries added in this bulk assembly do "
+                              "not match the ones of the first bulk "
+                              "assembly."));
+#      endif
+        return;
+      }
+
     prepare_action(VectorOperation::add);
 
     const PetscInt  petsc_i = row;
@@ -22,6 +22,7 @@
 #  ifdef DEAL_II_WITH_PETSC
 
 #    include <deal.II/lac/exceptions.h>
+#    include <deal.II/lac/la_parallel_vector.h>
 
 #    include <petscpc.h>
 
@@ -85,6 +86,27 @@ namespace PETScWrappers
     void
     Tvmult(VectorBase &dst, const VectorBase &src) const;
 
+    /**
+     * Apply the preconditioner once to the given src vector of type
+     * LinearAlgebra::distributed::Vector. The locally owned elements of
+     * @p src and @p dst are wrapped into PETSc vectors without copying them,
+     * so that the preconditioner can be used within deal.II's own solvers
+     * and matrix-free operators. The parallel layout of the vectors must
+     * match the one of the matrix the preconditioner was built from.
+     */
+    void
+    vmult(LinearAlgebra::distributed::Vector<PetscScalar> &      dst,
+          const LinearAlgebra::distributed::Vector<PetscScalar> &src) const;
+
+    /**
+     * Apply the transpose preconditioner once to the given src vector of type
+     * LinearAlgebra::distributed::Vector, without copying the vector data,
+     * see vmult().
+     */
+    void
+    Tvmult(LinearAlgebra::distributed::Vector<PetscScalar> &      dst,
+           const LinearAlgebra::distributed::Vector<PetscScalar> &src) const;
+
 
     /**
      * Give access to the underlying PETSc object.
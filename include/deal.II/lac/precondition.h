@@ -33,6 +33,8 @@
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <cstring>
+
 DEAL_II_NAMESPACE_OPEN
 
 // forward declarations
@@ -934,6 +936,12 @@ private:
  * AdditionalData::eig_cg_n_iterations to zero, and provide the variable
  * AdditionalData::max_eigenvalue instead. The minimal eigenvalue is
  * implicitly specified via `max_eigenvalue/smoothing_range`.
+ *
+ * When the preconditioner is re-initialized for a sequence of matrices with
+ * similar spectra, the estimates computed for the first matrix can be kept
+ * by setting AdditionalData::reuse_eigenvalue_estimates. Alternatively, the
+ * estimates returned by estimate_eigenvalues() can be stored and passed to
+ * other objects via AdditionalData::max_eigenvalue.
 
  * <h4>Using the PreconditionChebyshev as a solver</h4>
  *
@@ -982,6 +990,28 @@ private:
  * entries that would be needed from the matrix alone), there is a backward
  * compatibility function that can extract the diagonal in case of a serial
  * computation.
+ *
+ * <h4>Fused vector updates</h4>
+ *
+ * If the vector type is LinearAlgebra::distributed::Vector, the
+ * preconditioner is a DiagonalMatrix, and the matrix provides a function
+ * @code
+ * void vmult(VectorType &dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_before_matrix_vector_product,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_after_matrix_vector_product) const;
+ * @endcode
+ * the vector updates of the Chebyshev iteration are performed on subranges
+ * of the vectors right after the matrix-vector product has finished writing
+ * into them, while the data is still in caches. Such a function is typically
+ * implemented by passing the two functions to the variant of
+ * MatrixFree::cell_loop() with pre and post operations, which calls the
+ * first one on ranges of the locally owned indices of @p dst and @p src
+ * before they are first accessed and the second one after they have been
+ * accessed for the last time. The matrix must not set @p dst to zero on its
+ * own; this is done within @p operation_before_matrix_vector_product.
  */
 template <typename MatrixType         = SparseMatrix<double>,
           typename VectorType         = Vector<double>,
@@ -1062,6 +1092,20 @@ public:
      */
     double max_eigenvalue;
 
+    /**
+     * If set to true, a call to initialize() on an object whose eigenvalues
+     * have already been estimated keeps the previous estimates, and the
+     * polynomial degree derived from them, instead of computing new ones on
+     * the first application of the preconditioner. This is useful when the
+     * preconditioner is set up repeatedly for matrices with similar
+     * spectra, e.g. in a nonlinear or time-dependent solver where the
+     * matrix changes slightly between linear solves, and avoids the cost of
+     * the eigenvalue estimation in all but the first setup. The new matrix
+     * must act on vectors of the same layout as the previous one. The
+     * default is false. The estimates are discarded by clear().
+     */
+    bool reuse_eigenvalue_estimates;
+
     /**
      * Constraints to be used for the operator given. This variable is used to
      * zero out the correct entries when creating an initial guess.
@@ -2024,6 +2068,95 @@ namespace internal
         solution.swap(solution_old);
     }
 
+    // generic part: run the matrix-vector product and the vector updates
+    // one after the other
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    inline void
+    vmult_and_update(const MatrixType &        matrix,
+                     const PreconditionerType &preconditioner,
+                     const VectorType &        rhs,
+                     const unsigned int        iteration_index,
+                     const double              factor1,
+                     const double              factor2,
+                     VectorType &              solution,
+                     VectorType &              solution_old,
+                     VectorType &              temp_vector1,
+                     VectorType &              temp_vector2)
+    {
+      matrix.vmult(temp_vector1, solution);
+      vector_updates(rhs,
+                     preconditioner,
+                     iteration_index,
+                     factor1,
+                     factor2,
+                     solution_old,
+                     temp_vector1,
+                     temp_vector2,
+                     solution);
+    }
+
+    // selection for diagonal matrix around parallel deal.II vector and a
+    // matrix that can run operations on subranges of the vectors before and
+    // after the matrix-vector product: the vector updates are run right after
+    // the matrix-vector product has finished with a range of the vectors
+    template <typename MatrixType, typename Number>
+    inline typename std::enable_if<
+      internal::SolverCGImplementation::has_vmult_with_std_functions<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>,
+        MatrixType>::value>::type
+    vmult_and_update(
+      const MatrixType &matrix,
+      const DiagonalMatrix<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>> &jacobi,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &rhs,
+      const unsigned int iteration_index,
+      const double       factor1,
+      const double       factor2,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &solution,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &solution_old,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &temp_vector1,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &)
+    {
+      Assert(iteration_index > 0, ExcInternalError());
+
+      VectorUpdater<Number> updater(rhs.begin(),
+                                    jacobi.get_vector().begin(),
+                                    iteration_index,
+                                    factor1,
+                                    factor2,
+                                    solution_old.begin(),
+                                    temp_vector1.begin(),
+                                    solution.begin());
+      matrix.vmult(
+        temp_vector1,
+        solution,
+        [&](const unsigned int start_range, const unsigned int end_range) {
+          // zero the destination before the matrix-vector product first
+          // writes into it
+          if (end_range > start_range)
+            std::memset(temp_vector1.begin() + start_range,
+                        0,
+                        sizeof(Number) * (end_range - start_range));
+        },
+        [&](const unsigned int start_range, const unsigned int end_range) {
+          if (end_range > start_range)
+            updater.apply_to_subrange(start_range, end_range);
+        });
+
+      // swap vectors x^{n+1}->x^{n}, given the updates in the function above
+      if (iteration_index == 1)
+        {
+          solution.swap(temp_vector1);
+          solution_old.swap(temp_vector1);
+        }
+      else
+        solution.swap(solution_old);
+    }
+
     template <typename MatrixType, typename PreconditionerType>
     inline void
     initialize_preconditioner(
@@ -2177,6 +2310,7 @@ inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , reuse_eigenvalue_estimates(false)
 {}
 
 
@@ -2188,12 +2322,13 @@ inline typename PreconditionChebyshev<MatrixType,
                   PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   AdditionalData::operator=(const AdditionalData &other_data)
 {
-  degree              = other_data.degree;
-  smoothing_range     = other_data.smoothing_range;
-  eig_cg_n_iterations = other_data.eig_cg_n_iterations;
-  eig_cg_residual     = other_data.eig_cg_residual;
-  max_eigenvalue      = other_data.max_eigenvalue;
-  preconditioner      = other_data.preconditioner;
+  degree                     = other_data.degree;
+  smoothing_range            = other_data.smoothing_range;
+  eig_cg_n_iterations        = other_data.eig_cg_n_iterations;
+  eig_cg_residual            = other_data.eig_cg_residual;
+  max_eigenvalue             = other_data.max_eigenvalue;
+  reuse_eigenvalue_estimates = other_data.reuse_eigenvalue_estimates;
+  preconditioner             = other_data.preconditioner;
   constraints.copy_from(other_data.constraints);
 
   return *this;
@@ -2221,13 +2356,26 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
   const MatrixType &    matrix,
   const AdditionalData &additional_data)
 {
+  // keep the degree possibly computed from a previous eigenvalue estimate
+  // when the estimates are reused
+  const bool reuse_estimates =
+    additional_data.reuse_eigenvalue_estimates && eigenvalues_are_initialized;
+  const unsigned int old_degree = data.degree;
+
   matrix_ptr = &matrix;
   data       = additional_data;
   Assert(data.degree > 0,
          ExcMessage("The degree of the Chebyshev method must be positive."));
   internal::PreconditionChebyshevImplementation::initialize_preconditioner(
     matrix, data.preconditioner);
-  eigenvalues_are_initialized = false;
+
+  if (reuse_estimates)
+    {
+      if (data.degree == numbers::invalid_unsigned_int)
+        data.degree = old_degree;
+    }
+  else
+    eigenvalues_are_initialized = false;
 }
 
 
@@ -2363,19 +2511,15 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
     ->theta = (info.max_eigenvalue_estimate + alpha) * 0.5;
 
   // We do not need the second temporary vector in case we have a
-  // DiagonalMatrix as preconditioner and use deal.II's own vectors
+  // DiagonalMatrix as preconditioner and use deal.II's own vectors on the
+  // host, for which the vector updates are done in a single loop
   using NumberType = typename VectorType::value_type;
   if (std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value ==
         false ||
       (std::is_same<VectorType, dealii::Vector<NumberType>>::value == false &&
-       ((std::is_same<VectorType,
-                      LinearAlgebra::distributed::
-                        Vector<NumberType, MemorySpace::Host>>::value ==
-         false) ||
-        (std::is_same<VectorType,
-                      LinearAlgebra::distributed::
-                        Vector<NumberType, MemorySpace::CUDA>>::value ==
-         false))))
+       std::is_same<VectorType,
+                    LinearAlgebra::distributed::
+                      Vector<NumberType, MemorySpace::Host>>::value == false))
     temp_vector2.reinit(src, true);
   else
     {
@@ -2421,20 +2565,20 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
   double rhok = delta / theta, sigma = theta / delta;
   for (unsigned int k = 0; k < data.degree - 1; ++k)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
       const double rhokp   = 1. / (2. * sigma - rhok);
       const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
       rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
-        rhs,
+      internal::PreconditionChebyshevImplementation::vmult_and_update(
+        *matrix_ptr,
         *data.preconditioner,
+        rhs,
         k + 1,
         factor1,
         factor2,
+        solution,
         solution_old,
         temp_vector1,
-        temp_vector2,
-        solution);
+        temp_vector2);
     }
 }
 
@@ -2496,17 +2640,17 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
-  matrix_ptr->vmult(temp_vector1, solution);
-  internal::PreconditionChebyshevImplementation::vector_updates(
-    rhs,
+  internal::PreconditionChebyshevImplementation::vmult_and_update(
+    *matrix_ptr,
     *data.preconditioner,
+    rhs,
     1,
     0.,
     1. / theta,
+    solution,
     solution_old,
     temp_vector1,
-    temp_vector2,
-    solution);
+    temp_vector2);
 
   if (data.degree < 2 || std::abs(delta) < 1e-40)
     return;
@@ -2514,20 +2658,20 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   double rhok = delta / theta, sigma = theta / delta;
   for (unsigned int k = 0; k < data.degree - 1; ++k)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
       const double rhokp   = 1. / (2. * sigma - rhok);
       const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
       rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
-        rhs,
+      internal::PreconditionChebyshevImplementation::vmult_and_update(
+        *matrix_ptr,
         *data.preconditioner,
+        rhs,
         k + 2,
         factor1,
         factor2,
+        solution,
         solution_old,
         temp_vector1,
-        temp_vector2,
-        solution);
+        temp_vector2);
     }
 }
 
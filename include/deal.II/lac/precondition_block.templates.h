@@ -151,6 +151,10 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
             this->inverse_svd(0) = M_cell;
             this->inverse_svd(0).compute_inverse_svd(0.);
             break;
+          case PreconditionBlockBase<inverse_type>::batched_lu:
+          case PreconditionBlockBase<inverse_type>::batched_cholesky:
+            this->set_batched_block(0, M_cell);
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -206,11 +210,18 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
                 this->inverse_svd(cell) = M_cell;
                 this->inverse_svd(cell).compute_inverse_svd(0.);
                 break;
+              case PreconditionBlockBase<inverse_type>::batched_lu:
+              case PreconditionBlockBase<inverse_type>::batched_cholesky:
+                this->set_batched_block(cell, M_cell);
+                break;
               default:
                 Assert(false, ExcNotImplemented());
             }
         }
     }
+  if (this->inversion == PreconditionBlockBase<inverse_type>::batched_lu ||
+      this->inversion == PreconditionBlockBase<inverse_type>::batched_cholesky)
+    this->factorize_batched_blocks();
   this->inverses_computed(true);
 }
 
@@ -458,6 +469,10 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
             this->inverse_svd(0) = M_cell;
             this->inverse_svd(0).compute_inverse_svd(1.e-12);
             break;
+          case PreconditionBlockBase<inverse_type>::batched_lu:
+          case PreconditionBlockBase<inverse_type>::batched_cholesky:
+            this->set_batched_block(0, M_cell);
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -501,11 +516,18 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
                 this->inverse_svd(cell) = M_cell;
                 this->inverse_svd(cell).compute_inverse_svd(1.e-12);
                 break;
+              case PreconditionBlockBase<inverse_type>::batched_lu:
+              case PreconditionBlockBase<inverse_type>::batched_cholesky:
+                this->set_batched_block(cell, M_cell);
+                break;
               default:
                 Assert(false, ExcNotImplemented());
             }
         }
     }
+  if (this->inversion == PreconditionBlockBase<inverse_type>::batched_lu ||
+      this->inversion == PreconditionBlockBase<inverse_type>::batched_cholesky)
+    this->factorize_batched_blocks();
   this->inverses_computed(true);
 }
 
@@ -594,6 +616,44 @@ PreconditionBlockJacobi<MatrixType, inverse_type>::do_vmult(
           begin_diag_block += this->blocksize;
         }
     }
+  else if (!this->same_diagonal() &&
+           (this->inversion ==
+              PreconditionBlockBase<inverse_type>::batched_lu ||
+            this->inversion ==
+              PreconditionBlockBase<inverse_type>::batched_cholesky))
+    {
+      // all blocks have the same size and are stored in a single group, so
+      // we can solve with width blocks at once
+      const BatchedFullMatrix<inverse_type> &matrices =
+        this->inverse_batched(0);
+      using VectorizedArrayType =
+        typename BatchedFullMatrix<inverse_type>::VectorizedArrayType;
+      constexpr unsigned int width = VectorizedArrayType::size();
+
+      AlignedVector<VectorizedArrayType> x_batch(this->blocksize);
+      for (unsigned int batch = 0; batch < matrices.n_batches(); ++batch)
+        {
+          const unsigned int n_lanes =
+            std::min(width, this->size() - batch * width);
+          for (row_cell = 0; row_cell < this->blocksize; ++row_cell)
+            {
+              x_batch[row_cell] = inverse_type();
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                x_batch[row_cell][v] =
+                  src((batch * width + v) * this->blocksize + row_cell);
+            }
+          matrices.solve_batch(batch, x_batch.data());
+          for (row_cell = 0; row_cell < this->blocksize; ++row_cell)
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              {
+                row = (batch * width + v) * this->blocksize + row_cell;
+                if (adding)
+                  dst(row) += x_batch[row_cell][v];
+                else
+                  dst(row) = x_batch[row_cell][v];
+              }
+        }
+    }
   else
     for (unsigned int cell = 0; cell < this->size(); ++cell)
       {
@@ -24,9 +24,11 @@
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/subscriptor.h>
 
+#include <deal.II/lac/batched_full_matrix.h>
 #include <deal.II/lac/householder.h>
 #include <deal.II/lac/lapack_full_matrix.h>
 
+#include <map>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -81,7 +83,21 @@ public:
     /**
      * Use the singular value decomposition of LAPACKFullMatrix.
      */
-    svd
+    svd,
+    /**
+     * Use the LU factorization with partial pivoting of BatchedFullMatrix,
+     * which factorizes and applies blocks of the same size together,
+     * vectorized over the lanes of VectorizedArray. The diagonal blocks are
+     * set with set_batched_block() and factorized with
+     * factorize_batched_blocks().
+     */
+    batched_lu,
+    /**
+     * Same as #batched_lu, but use the Cholesky factorization of
+     * BatchedFullMatrix, which requires symmetric positive definite
+     * diagonal blocks.
+     */
+    batched_cholesky
   };
 
   /**
@@ -112,6 +128,30 @@ public:
          bool         compress,
          Inversion    method = gauss_jordan);
 
+  /**
+   * Set up the storage for the methods #batched_lu and #batched_cholesky if
+   * the blocks have different sizes, as is the case for RelaxationBlock.
+   * The blocks are grouped by their size, given in @p block_sizes, and
+   * each group is stored in one BatchedFullMatrix. If all the blocks have
+   * the same size, it is sufficient to pass it to reinit().
+   */
+  void
+  reinit_batched(const std::vector<size_type> &block_sizes);
+
+  /**
+   * Store the diagonal block @p M at position <tt>i</tt> if Inversion is
+   * #batched_lu or #batched_cholesky. Different blocks can be set
+   * concurrently from different threads.
+   */
+  void
+  set_batched_block(size_type i, const FullMatrix<number> &M);
+
+  /**
+   * Factorize all the blocks set with set_batched_block().
+   */
+  void
+  factorize_batched_blocks();
+
   /**
    * Tell the class that inverses are computed.
    */
@@ -196,6 +236,22 @@ public:
   const LAPACKFullMatrix<number> &
   inverse_svd(size_type i) const;
 
+  /**
+   * Access to the factorized diagonal blocks if Inversion is #batched_lu or
+   * #batched_cholesky. Return the batched matrices of the group containing
+   * the block at position <tt>i</tt>, whose index within the group is given
+   * by batched_index().
+   */
+  const BatchedFullMatrix<number> &
+  inverse_batched(size_type i) const;
+
+  /**
+   * Return the index of the block at position <tt>i</tt> within the
+   * group returned by inverse_batched().
+   */
+  unsigned int
+  batched_index(size_type i) const;
+
   /**
    * Access to the diagonal blocks.
    */
@@ -272,6 +328,18 @@ private:
    */
   std::vector<LAPACKFullMatrix<number>> var_inverse_svd;
 
+  /**
+   * Storage of the factorized diagonal blocks if Inversion #batched_lu or
+   * #batched_cholesky is used, with one entry for each size of the blocks.
+   */
+  std::vector<BatchedFullMatrix<number>> var_inverse_batched;
+
+  /**
+   * The group in #var_inverse_batched and the index within that group of
+   * each block.
+   */
+  std::vector<std::pair<unsigned int, unsigned int>> var_batched_index;
+
   /**
    * Storage of the original diagonal blocks.
    *
@@ -321,6 +389,8 @@ PreconditionBlockBase<number>::clear()
                                   var_inverse_householder.end());
   if (var_inverse_svd.size() != 0)
     var_inverse_svd.erase(var_inverse_svd.begin(), var_inverse_svd.end());
+  var_inverse_batched.clear();
+  var_batched_index.clear();
   if (var_diagonal.size() != 0)
     var_diagonal.erase(var_diagonal.begin(), var_diagonal.end());
   var_same_diagonal  = false;
@@ -355,6 +425,10 @@ PreconditionBlockBase<number>::reinit(unsigned int n,
             var_inverse_svd.resize(1);
             var_inverse_svd[0].reinit(b, b);
             break;
+          case batched_lu:
+          case batched_cholesky:
+            reinit_batched(std::vector<size_type>(1, b));
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -399,6 +473,12 @@ PreconditionBlockBase<number>::reinit(unsigned int n,
               var_inverse_svd.swap(tmp);
               break;
             }
+          case batched_lu:
+          case batched_cholesky:
+            // blocks of varying sizes are set up by reinit_batched()
+            if (b > 0)
+              reinit_batched(std::vector<size_type>(n, b));
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -406,6 +486,63 @@ PreconditionBlockBase<number>::reinit(unsigned int n,
 }
 
 
+template <typename number>
+inline void
+PreconditionBlockBase<number>::reinit_batched(
+  const std::vector<size_type> &block_sizes)
+{
+  Assert(inversion == batched_lu || inversion == batched_cholesky,
+         ExcInverseNotAvailable());
+
+  // group the blocks by their size and count the blocks in each group
+  std::map<size_type, unsigned int> group_of_size;
+  std::vector<unsigned int>         n_blocks_in_group;
+  std::vector<size_type>            size_of_group;
+  var_batched_index.resize(block_sizes.size());
+  for (unsigned int i = 0; i < block_sizes.size(); ++i)
+    {
+      const auto group =
+        group_of_size.insert(std::make_pair(block_sizes[i],
+                                            n_blocks_in_group.size()));
+      if (group.second)
+        {
+          n_blocks_in_group.push_back(0);
+          size_of_group.push_back(block_sizes[i]);
+        }
+      var_batched_index[i].first  = group.first->second;
+      var_batched_index[i].second = n_blocks_in_group[group.first->second]++;
+    }
+
+  var_inverse_batched.resize(n_blocks_in_group.size());
+  for (unsigned int g = 0; g < n_blocks_in_group.size(); ++g)
+    var_inverse_batched[g].reinit(n_blocks_in_group[g], size_of_group[g]);
+}
+
+
+template <typename number>
+inline void
+PreconditionBlockBase<number>::set_batched_block(size_type                 i,
+                                                 const FullMatrix<number> &M)
+{
+  const size_type ii = same_diagonal() ? 0U : i;
+  AssertIndexRange(ii, var_batched_index.size());
+  var_inverse_batched[var_batched_index[ii].first].set_matrix(
+    var_batched_index[ii].second, M);
+}
+
+
+template <typename number>
+inline void
+PreconditionBlockBase<number>::factorize_batched_blocks()
+{
+  for (BatchedFullMatrix<number> &matrices : var_inverse_batched)
+    if (inversion == batched_lu)
+      matrices.compute_lu_factorization();
+    else
+      matrices.compute_cholesky_factorization();
+}
+
+
 template <typename number>
 inline unsigned int
 PreconditionBlockBase<number>::size() const
@@ -436,6 +573,13 @@ PreconditionBlockBase<number>::inverse_vmult(size_type              i,
         AssertIndexRange(ii, var_inverse_svd.size());
         var_inverse_svd[ii].vmult(dst, src);
         break;
+      case batched_lu:
+      case batched_cholesky:
+        AssertIndexRange(ii, var_batched_index.size());
+        dst = src;
+        var_inverse_batched[var_batched_index[ii].first].solve(
+          var_batched_index[ii].second, dst.begin());
+        break;
       default:
         Assert(false, ExcNotImplemented());
     }
@@ -465,6 +609,13 @@ PreconditionBlockBase<number>::inverse_Tvmult(size_type              i,
         AssertIndexRange(ii, var_inverse_svd.size());
         var_inverse_svd[ii].Tvmult(dst, src);
         break;
+      case batched_lu:
+      case batched_cholesky:
+        AssertIndexRange(ii, var_batched_index.size());
+        dst = src;
+        var_inverse_batched[var_batched_index[ii].first].Tsolve(
+          var_batched_index[ii].second, dst.begin());
+        break;
       default:
         Assert(false, ExcNotImplemented());
     }
@@ -507,6 +658,26 @@ PreconditionBlockBase<number>::inverse_svd(size_type i) const
 }
 
 
+template <typename number>
+inline const BatchedFullMatrix<number> &
+PreconditionBlockBase<number>::inverse_batched(size_type i) const
+{
+  const size_type ii = same_diagonal() ? 0U : i;
+  AssertIndexRange(ii, var_batched_index.size());
+  return var_inverse_batched[var_batched_index[ii].first];
+}
+
+
+template <typename number>
+inline unsigned int
+PreconditionBlockBase<number>::batched_index(size_type i) const
+{
+  const size_type ii = same_diagonal() ? 0U : i;
+  AssertIndexRange(ii, var_batched_index.size());
+  return var_batched_index[ii].second;
+}
+
+
 template <typename number>
 inline const FullMatrix<number> &
 PreconditionBlockBase<number>::diagonal(size_type i) const
@@ -653,6 +824,8 @@ PreconditionBlockBase<number>::log_statistics() const
     {}
   else if (inversion == gauss_jordan)
     {}
+  else if (inversion == batched_lu || inversion == batched_cholesky)
+    {}
   else
     {
       Assert(false, ExcNotImplemented());
@@ -669,6 +842,9 @@ PreconditionBlockBase<number>::memory_consumption() const
     mem += MemoryConsumption::memory_consumption(var_inverse_full[i]);
   for (size_type i = 0; i < var_diagonal.size(); ++i)
     mem += MemoryConsumption::memory_consumption(var_diagonal[i]);
+  for (const BatchedFullMatrix<number> &matrices : var_inverse_batched)
+    mem += matrices.memory_consumption();
+  mem += MemoryConsumption::memory_consumption(var_batched_index);
   return mem;
 }
 
@@ -94,6 +94,12 @@ class SparseMatrix;
  * preconditioner, at the beginning of their program and each time the solver is
  * started (that is several times e.g. in a nonlinear iteration) this
  * preselected solver and preconditioner is called.
+ *
+ * If deal.II is configured with Ginkgo, the preconditioners "ginkgo_jacobi",
+ * "ginkgo_ilu" and "ginkgo_parilut" select the respective preconditioners of
+ * Ginkgo (see GinkgoWrappers::create_preconditioner()) for the Ginkgo solvers
+ * of SolverSelector. As they are applied by Ginkgo, vmult() and Tvmult() are
+ * not available for them.
  */
 template <typename MatrixType = SparseMatrix<double>,
           typename VectorType = dealii::Vector<double>>
@@ -161,10 +167,18 @@ public:
    * <li>  "sor" </li>
    * <li>  "ssor" </li>
    * </ul>
+   * and, if deal.II is configured with Ginkgo, "ginkgo_jacobi", "ginkgo_ilu"
+   * and "ginkgo_parilut".
    */
   static std::string
   get_precondition_names();
 
+  /**
+   * Return the name of the selected preconditioning.
+   */
+  const std::string &
+  get_preconditioning() const;
+
   /**
    * @addtogroup Exceptions
    * @{
@@ -312,7 +326,19 @@ template <typename MatrixType, typename VectorType>
 std::string
 PreconditionSelector<MatrixType, VectorType>::get_precondition_names()
 {
+#ifdef DEAL_II_WITH_GINKGO
+  return "none|jacobi|sor|ssor|ginkgo_jacobi|ginkgo_ilu|ginkgo_parilut";
+#else
   return "none|jacobi|sor|ssor";
+#endif
+}
+
+
+template <typename MatrixType, typename VectorType>
+inline const std::string &
+PreconditionSelector<MatrixType, VectorType>::get_preconditioning() const
+{
+  return preconditioning;
 }
 
 
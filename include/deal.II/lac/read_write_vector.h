@@ -289,7 +289,11 @@ namespace LinearAlgebra
      * is used to decide if the elements in @p V should be added to the
      * current vector or replace the current elements. The last parameter can
      * be used if the same communication pattern is used multiple times. This
-     * can be used to improve performance.
+     * can be used to improve performance. If it is not given, the
+     * communication pattern is created on the first call and stored for
+     * subsequent calls with a source vector with the same locally owned
+     * elements and MPI communicator, until the current vector is
+     * reinitialized.
      */
     template <typename MemorySpace>
     void
@@ -127,31 +127,58 @@ namespace LinearAlgebra
              const ::dealii::VectorOperation::values operation,
              ::dealii::LinearAlgebra::ReadWriteVector<Number> &rw_vector)
       {
-        distributed::Vector<Number, ::dealii::MemorySpace::Host> tmp_vector(
-          communication_pattern);
-
-        const unsigned int n_elements = communication_pattern->local_size();
-        std::copy(values, values + n_elements, tmp_vector.begin());
-        tmp_vector.update_ghost_values();
+        const Utilities::MPI::Partitioner &partitioner = *communication_pattern;
+        const unsigned int local_size = partitioner.local_size();
+
+        // only the ghost entries need to be communicated; we receive them
+        // into a buffer of the size of the ghost range and read the locally
+        // owned entries directly from the source array rather than copying
+        // all of them into a temporary ghosted vector first
+        std::vector<Number> ghost_values(partitioner.n_ghost_indices());
+#ifdef DEAL_II_WITH_MPI
+        if (partitioner.n_ghost_indices() > 0 ||
+            partitioner.n_import_indices() > 0)
+          {
+            std::vector<Number> import_data(partitioner.n_import_indices());
+            std::vector<MPI_Request> requests;
+            partitioner.export_to_ghosted_array_start(
+              0,
+              ArrayView<const Number>(values, local_size),
+              make_array_view(import_data),
+              make_array_view(ghost_values),
+              requests);
+            partitioner.export_to_ghosted_array_finish(
+              make_array_view(ghost_values), requests);
+          }
+#endif
 
+        const auto source_value = [&](const size_type global_index) {
+          const unsigned int local_index =
+            partitioner.global_to_local(global_index);
+          return local_index < local_size ?
+                   values[local_index] :
+                   ghost_values[local_index - local_size];
+        };
+
+        // walk through the stored elements with the iterator of the index
+        // set, which avoids the binary search of nth_index_in_set() for
+        // every element
         const IndexSet &stored = rw_vector.get_stored_elements();
+        size_type       i      = 0;
         if (operation == VectorOperation::add)
-          for (size_type i = 0; i < stored.n_elements(); ++i)
-            rw_vector.local_element(i) +=
-              tmp_vector(stored.nth_index_in_set(i));
+          for (auto it = stored.begin(); it != stored.end(); ++it, ++i)
+            rw_vector.local_element(i) += source_value(*it);
         else if (operation == VectorOperation::min)
-          for (size_type i = 0; i < stored.n_elements(); ++i)
+          for (auto it = stored.begin(); it != stored.end(); ++it, ++i)
             rw_vector.local_element(i) =
-              get_min(tmp_vector(stored.nth_index_in_set(i)),
-                      rw_vector.local_element(i));
+              get_min(source_value(*it), rw_vector.local_element(i));
         else if (operation == VectorOperation::max)
-          for (size_type i = 0; i < stored.n_elements(); ++i)
+          for (auto it = stored.begin(); it != stored.end(); ++it, ++i)
             rw_vector.local_element(i) =
-              get_max(tmp_vector(stored.nth_index_in_set(i)),
-                      rw_vector.local_element(i));
+              get_max(source_value(*it), rw_vector.local_element(i));
         else
-          for (size_type i = 0; i < stored.n_elements(); ++i)
-            rw_vector.local_element(i) = tmp_vector(stored.nth_index_in_set(i));
+          for (auto it = stored.begin(); it != stored.end(); ++it, ++i)
+            rw_vector.local_element(i) = source_value(*it);
       }
     };
 
@@ -416,29 +443,46 @@ namespace LinearAlgebra
     const std::shared_ptr<const CommunicationPatternBase>
       &communication_pattern)
   {
-    // If no communication pattern is given, create one. Otherwise, use the
-    // given one.
-    std::shared_ptr<const Utilities::MPI::Partitioner> comm_pattern;
+    // If no communication pattern is given, reuse the one stored from the
+    // last call if the source vector has the same locally owned elements and
+    // communicator, and create (and store) a new one otherwise. If a
+    // pattern is given, use the given one.
+    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
     if (communication_pattern.get() == nullptr)
       {
-        comm_pattern = std::make_shared<Utilities::MPI::Partitioner>(
-          vec.locally_owned_elements(),
-          get_stored_elements(),
-          vec.get_mpi_communicator());
+        const IndexSet source_elements = vec.locally_owned_elements();
+        partitioner =
+          std::dynamic_pointer_cast<const Utilities::MPI::Partitioner>(
+            comm_pattern);
+        if (partitioner == nullptr ||
+            partitioner->get_mpi_communicator() !=
+              vec.get_mpi_communicator() ||
+            source_elements.size() != source_stored_elements.size() ||
+            source_elements != source_stored_elements)
+          {
+            auto new_partitioner =
+              std::make_shared<Utilities::MPI::Partitioner>(
+                source_elements,
+                get_stored_elements(),
+                vec.get_mpi_communicator());
+            source_stored_elements = source_elements;
+            comm_pattern           = new_partitioner;
+            partitioner            = new_partitioner;
+          }
       }
     else
       {
-        comm_pattern =
+        partitioner =
           std::dynamic_pointer_cast<const Utilities::MPI::Partitioner>(
             communication_pattern);
-        AssertThrow(comm_pattern != nullptr,
+        AssertThrow(partitioner != nullptr,
                     ExcMessage("The communication pattern is not of type "
                                "Utilities::MPI::Partitioner."));
       }
 
 
     internal::read_write_vector_functions<Number, MemorySpace>::import(
-      comm_pattern, vec.begin(), operation, *this);
+      partitioner, vec.begin(), operation, *this);
   }
 
 
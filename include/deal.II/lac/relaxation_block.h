@@ -172,6 +172,22 @@ public:
      */
     std::vector<std::vector<unsigned int>> order;
 
+    /**
+     * If true, initialize() colors the blocks with
+     * GraphColoring::make_graph_coloring() such that blocks of the same color
+     * neither overlap nor couple through the matrix. The relaxation step then
+     * traverses the blocks color by color and processes the blocks of one
+     * color in parallel. For multiplicative methods, this changes the order
+     * in which the blocks are visited compared to the sequential algorithm,
+     * but the result does not depend on the number of threads.
+     *
+     * The coloring replaces the traversal given by #order, which must be
+     * empty. It requires a vector type that allows writing to different
+     * entries from several threads, so it cannot be used together with
+     * #temp_ghost_vector.
+     */
+    bool use_coloring = false;
+
     /**
      * Temporary ghost vector that is used in the relaxation method when
      * performing parallel MPI computations. The user is required to have this
@@ -265,6 +281,24 @@ private:
    */
   void
   block_kernel(const size_type block_begin, const size_type block_end);
+
+  /**
+   * Perform the relaxation step on a single block, see do_step().
+   */
+  void
+  do_block_step(const unsigned int                       block,
+                VectorType &                             dst,
+                const VectorType &                       prev,
+                const VectorType &                       src,
+                Vector<typename VectorType::value_type> &b_cell,
+                Vector<typename VectorType::value_type> &x_cell) const;
+
+  /**
+   * The blocks sorted by color if AdditionalData::use_coloring is set.
+   * Blocks of the same color do not couple, so their relaxation steps can
+   * be done in parallel.
+   */
+  std::vector<std::vector<unsigned int>> block_colors;
 };
 
 
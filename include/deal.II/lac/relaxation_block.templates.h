@@ -18,11 +18,15 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/graph_coloring.h>
+
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/relaxation_block.h>
 #include <deal.II/lac/trilinos_vector.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <numeric>
+
 DEAL_II_NAMESPACE_OPEN
 
 template <typename MatrixType, typename InverseNumberType, typename VectorType>
@@ -73,6 +77,68 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::initialize(
                additional_data->same_diagonal,
                additional_data->inversion);
 
+  if (this->inversion ==
+        PreconditionBlockBase<InverseNumberType>::batched_lu ||
+      this->inversion ==
+        PreconditionBlockBase<InverseNumberType>::batched_cholesky)
+    {
+      std::vector<size_type> block_sizes(
+        additional_data->block_list.n_rows());
+      for (size_type block = 0; block < block_sizes.size(); ++block)
+        block_sizes[block] = additional_data->block_list.row_length(block);
+      this->reinit_batched(block_sizes);
+    }
+
+  if (additional_data->use_coloring &&
+      additional_data->block_list.n_rows() > 0)
+    {
+      Assert(additional_data->order.empty(),
+             ExcMessage("A coloring of the blocks cannot be combined with "
+                        "a prescribed order of the blocks."));
+      Assert(additional_data->temp_ghost_vector == nullptr,
+             ExcNotImplemented());
+
+      // two blocks conflict if the rows of one block couple to an index of
+      // the other block. since the diagonal entry comes first in each row,
+      // the indices of the block are part of the conflict indices as well
+      const SparsityPattern &block_list = additional_data->block_list;
+      std::vector<unsigned int> blocks(block_list.n_rows());
+      std::iota(blocks.begin(), blocks.end(), 0U);
+      using Iterator = std::vector<unsigned int>::const_iterator;
+      const std::vector<std::vector<Iterator>> coloring =
+        GraphColoring::make_graph_coloring(
+          blocks.cbegin(),
+          blocks.cend(),
+          std::function<std::vector<types::global_dof_index>(
+            const Iterator &)>([&M, &block_list](const Iterator &block) {
+            std::vector<types::global_dof_index> indices;
+            for (SparsityPattern::iterator row = block_list.begin(*block);
+                 row != block_list.end(*block);
+                 ++row)
+              {
+                indices.push_back(row->column());
+                for (typename MatrixType::const_iterator entry =
+                       M.begin(row->column());
+                     entry != M.end(row->column());
+                     ++entry)
+                  indices.push_back(entry->column());
+              }
+            std::sort(indices.begin(), indices.end());
+            indices.erase(std::unique(indices.begin(), indices.end()),
+                          indices.end());
+            return indices;
+          }));
+
+      block_colors.resize(coloring.size());
+      for (unsigned int color = 0; color < coloring.size(); ++color)
+        {
+          block_colors[color].reserve(coloring[color].size());
+          for (const Iterator &block : coloring[color])
+            block_colors[color].push_back(*block);
+          std::sort(block_colors[color].begin(), block_colors[color].end());
+        }
+    }
+
   if (additional_data->invert_diagonal)
     invert_diagblocks();
 }
@@ -84,6 +150,7 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::clear()
 {
   A               = nullptr;
   additional_data = nullptr;
+  block_colors.clear();
   PreconditionBlockBase<InverseNumberType>::clear();
 }
 
@@ -106,6 +173,11 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::invert_diagblocks()
                                      this->block_kernel(block_begin, block_end);
                                    },
                                    16);
+      if (this->inversion ==
+            PreconditionBlockBase<InverseNumberType>::batched_lu ||
+          this->inversion ==
+            PreconditionBlockBase<InverseNumberType>::batched_cholesky)
+        this->factorize_batched_blocks();
     }
   this->inverses_computed(true);
 }
@@ -168,6 +240,10 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
               this->inverse_svd(block).compute_inverse_svd(
                 this->additional_data->threshold);
             break;
+          case PreconditionBlockBase<InverseNumberType>::batched_lu:
+          case PreconditionBlockBase<InverseNumberType>::batched_cholesky:
+            this->set_batched_block(block, M_cell);
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -227,7 +303,29 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::do_step(
   const VectorType &ghosted_prev =
     internal::prepare_ghost_vector(prev, additional_data->temp_ghost_vector);
 
-  const MatrixType &                      M = *this->A;
+  if (!block_colors.empty())
+    {
+      // blocks of one color do not couple, so they can be processed in
+      // parallel, with the colors in reverse order for backward sweeps
+      const unsigned int n_colors = block_colors.size();
+      for (unsigned int c = 0; c < n_colors; ++c)
+        {
+          const std::vector<unsigned int> &color =
+            block_colors[backward ? (n_colors - c - 1) : c];
+          parallel::apply_to_subranges(
+            0U,
+            static_cast<unsigned int>(color.size()),
+            [&](const unsigned int begin, const unsigned int end) {
+              Vector<typename VectorType::value_type> b_cell, x_cell;
+              for (unsigned int i = begin; i < end; ++i)
+                do_block_step(color[i], dst, ghosted_prev, src, b_cell, x_cell);
+            },
+            16);
+        }
+      dst.compress(dealii::VectorOperation::add);
+      return;
+    }
+
   Vector<typename VectorType::value_type> b_cell, x_cell;
 
   const bool         permutation_empty = additional_data->order.size() == 0;
@@ -251,42 +349,53 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::do_step(
                              ->order[n_permutations - 1 - perm][raw_block]) :
                           (additional_data->order[perm][raw_block]));
 
-          const size_type bs = additional_data->block_list.row_length(block);
-
-          b_cell.reinit(bs);
-          x_cell.reinit(bs);
-          // Collect off-diagonal parts
-          SparsityPattern::iterator row =
-            additional_data->block_list.begin(block);
-          for (size_type row_cell = 0; row_cell < bs; ++row_cell, ++row)
-            {
-              b_cell(row_cell) = src(row->column());
-              for (typename MatrixType::const_iterator entry =
-                     M.begin(row->column());
-                   entry != M.end(row->column());
-                   ++entry)
-                b_cell(row_cell) -=
-                  entry->value() * ghosted_prev(entry->column());
-            }
-          // Apply inverse diagonal
-          this->inverse_vmult(block, x_cell, b_cell);
-#ifdef DEBUG
-          for (unsigned int i = 0; i < x_cell.size(); ++i)
-            {
-              AssertIsFinite(x_cell(i));
-            }
-#endif
-          // Store in result vector
-          row = additional_data->block_list.begin(block);
-          for (size_type row_cell = 0; row_cell < bs; ++row_cell, ++row)
-            dst(row->column()) +=
-              additional_data->relaxation * x_cell(row_cell);
+          do_block_step(block, dst, ghosted_prev, src, b_cell, x_cell);
         }
     }
   dst.compress(dealii::VectorOperation::add);
 }
 
 
+template <typename MatrixType, typename InverseNumberType, typename VectorType>
+inline void
+RelaxationBlock<MatrixType, InverseNumberType, VectorType>::do_block_step(
+  const unsigned int                       block,
+  VectorType &                             dst,
+  const VectorType &                       prev,
+  const VectorType &                       src,
+  Vector<typename VectorType::value_type> &b_cell,
+  Vector<typename VectorType::value_type> &x_cell) const
+{
+  const MatrixType &M  = *this->A;
+  const size_type   bs = additional_data->block_list.row_length(block);
+
+  b_cell.reinit(bs);
+  x_cell.reinit(bs);
+  // Collect off-diagonal parts
+  SparsityPattern::iterator row = additional_data->block_list.begin(block);
+  for (size_type row_cell = 0; row_cell < bs; ++row_cell, ++row)
+    {
+      b_cell(row_cell) = src(row->column());
+      for (typename MatrixType::const_iterator entry = M.begin(row->column());
+           entry != M.end(row->column());
+           ++entry)
+        b_cell(row_cell) -= entry->value() * prev(entry->column());
+    }
+  // Apply inverse diagonal
+  this->inverse_vmult(block, x_cell, b_cell);
+#ifdef DEBUG
+  for (unsigned int i = 0; i < x_cell.size(); ++i)
+    {
+      AssertIsFinite(x_cell(i));
+    }
+#endif
+  // Store in result vector
+  row = additional_data->block_list.begin(block);
+  for (size_type row_cell = 0; row_cell < bs; ++row_cell, ++row)
+    dst(row->column()) += additional_data->relaxation * x_cell(row_cell);
+}
+
+
 //----------------------------------------------------------------------//
 
 template <typename MatrixType, typename InverseNumberType, typename VectorType>
@@ -574,6 +574,21 @@ public:
     const std::pair<NumberType, NumberType> &value_limits,
     const bool                               compute_eigenvectors);
 
+  /**
+   * Computing all eigenvalues and eigenvectors of the real symmetric matrix
+   * $\mathbf{A} \in \mathbb{R}^{M \times M}$ using the divide and conquer
+   * algorithm (psyevd). If the complete spectrum is needed, this is usually
+   * the fastest of the symmetric eigensolvers and the one that needs the
+   * least communication, as the eigenvectors are computed without the
+   * reorthogonalization done by psyevx.
+   *
+   * If successful, the computed eigenvalues are arranged in ascending order.
+   * The eigenvectors are stored in the columns of the matrix, thereby
+   * overwriting the original content of the matrix.
+   */
+  std::vector<NumberType>
+  eigenpairs_symmetric_divide_and_conquer();
+
   /**
    * Computing the singular value decomposition (SVD) of a
    * matrix $\mathbf{A} \in \mathbb{R}^{M \times N}$, optionally computing the
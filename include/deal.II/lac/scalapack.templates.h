@@ -928,6 +928,47 @@ extern "C"
            int *        iwork,
            int *        liwork,
            int *        info);
+
+  /**
+   * psyevd computes all eigenvalues and eigenvectors of a real symmetric
+   * matrix A with the divide and conquer algorithm.
+   */
+  void
+  pdsyevd_(const char *jobz,
+           const char *uplo,
+           const int * n,
+           double *    A,
+           const int * IA,
+           const int * JA,
+           const int * DESCA,
+           double *    w,
+           double *    Z,
+           const int * IZ,
+           const int * JZ,
+           const int * DESCZ,
+           double *    work,
+           const int * lwork,
+           int *       iwork,
+           const int * liwork,
+           int *       info);
+  void
+  pssyevd_(const char *jobz,
+           const char *uplo,
+           const int * n,
+           float *     A,
+           const int * IA,
+           const int * JA,
+           const int * DESCA,
+           float *     w,
+           float *     Z,
+           const int * IZ,
+           const int * JZ,
+           const int * DESCZ,
+           float *     work,
+           const int * lwork,
+           int *       iwork,
+           const int * liwork,
+           int *       info);
 }
 
 
@@ -2293,6 +2334,106 @@ psyevr(const char * jobz,
 #  endif
 }
 
+
+template <typename number>
+inline void
+psyevd(const char * /*jobz*/,
+       const char * /*uplo*/,
+       const int * /*n*/,
+       number * /*A*/,
+       const int * /*IA*/,
+       const int * /*JA*/,
+       const int * /*DESCA*/,
+       number * /*w*/,
+       number * /*Z*/,
+       const int * /*IZ*/,
+       const int * /*JZ*/,
+       const int * /*DESCZ*/,
+       number * /*work*/,
+       const int * /*lwork*/,
+       int * /*iwork*/,
+       const int * /*liwork*/,
+       int * /*info*/)
+{
+  Assert(false, dealii::ExcNotImplemented());
+}
+
+inline void
+psyevd(const char *jobz,
+       const char *uplo,
+       const int * n,
+       double *    A,
+       const int * IA,
+       const int * JA,
+       const int * DESCA,
+       double *    w,
+       double *    Z,
+       const int * IZ,
+       const int * JZ,
+       const int * DESCZ,
+       double *    work,
+       const int * lwork,
+       int *       iwork,
+       const int * liwork,
+       int *       info)
+{
+  pdsyevd_(jobz,
+           uplo,
+           n,
+           A,
+           IA,
+           JA,
+           DESCA,
+           w,
+           Z,
+           IZ,
+           JZ,
+           DESCZ,
+           work,
+           lwork,
+           iwork,
+           liwork,
+           info);
+}
+
+inline void
+psyevd(const char *jobz,
+       const char *uplo,
+       const int * n,
+       float *     A,
+       const int * IA,
+       const int * JA,
+       const int * DESCA,
+       float *     w,
+       float *     Z,
+       const int * IZ,
+       const int * JZ,
+       const int * DESCZ,
+       float *     work,
+       const int * lwork,
+       int *       iwork,
+       const int * liwork,
+       int *       info)
+{
+  pssyevd_(jobz,
+           uplo,
+           n,
+           A,
+           IA,
+           JA,
+           DESCA,
+           w,
+           Z,
+           IZ,
+           JZ,
+           DESCZ,
+           work,
+           lwork,
+           iwork,
+           liwork,
+           info);
+}
+
 #endif // DEAL_II_WITH_SCALAPACK
 
 #endif // dealii_scalapack_templates_h
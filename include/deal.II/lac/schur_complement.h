@@ -229,6 +229,14 @@ DEAL_II_NAMESPACE_OPEN
  * that the preconditioner always solves to the same tolerance, thereby
  * rendering its behaviour constant.
  *
+ * Since $ A^{-1} $ is applied in every outer iteration, it can pay off to
+ * construct @p A_inv with warm_start_inverse_operator() instead of
+ * inverse_operator(), which starts each inner solve from the solution of the
+ * previous one and can set the inner tolerance relative to the norm of the
+ * right hand side passed to it. The resulting operator is only linear up to
+ * the inner tolerance, so a flexible outer solver is again advisable unless
+ * the inner solves are accurate.
+ *
  * Further examples of this functionality can be found in the test-suite, such
  * as <code>tests/lac/schur_complement_01.cc</code> . The solution of a multi-
  * component problem (namely step-22) using the schur_complement can be found
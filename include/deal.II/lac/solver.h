@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/solver_control.h>
@@ -34,6 +35,84 @@ template <typename number>
 class Vector;
 #endif
 
+
+namespace internal
+{
+  namespace SolverImplementation
+  {
+    // A trait class that determines whether the vector type provides a
+    // multi_dot() function computing several inner products in a single
+    // sweep over memory and with a single global reduction
+    template <typename VectorType>
+    class has_multi_dot
+    {
+      template <typename C>
+      static std::false_type
+      test(...);
+
+      template <typename C>
+      static auto
+      test(const C *v)
+        -> decltype(v->multi_dot(
+                      std::declval<const ArrayView<const C *const> &>(),
+                      std::declval<
+                        const ArrayView<typename C::value_type> &>()),
+                    std::true_type());
+
+    public:
+      static constexpr bool value =
+        decltype(test<VectorType>(nullptr))::value;
+    };
+
+    // Fallback for vector types without multi_dot(): compute the inner
+    // products one by one
+    template <typename VectorType, typename Number>
+    inline void
+    dot_products(const VectorType &                        v,
+                 const ArrayView<const VectorType *const> &w,
+                 const ArrayView<Number> &                 results,
+                 std::false_type)
+    {
+      for (unsigned int k = 0; k < w.size(); ++k)
+        results[k] = v * (*w[k]);
+    }
+
+    template <typename VectorType, typename Number>
+    inline void
+    dot_products(const VectorType &                        v,
+                 const ArrayView<const VectorType *const> &w,
+                 const ArrayView<Number> &                 results,
+                 std::true_type)
+    {
+      std::vector<typename VectorType::value_type> tmp(w.size());
+      v.multi_dot(w, make_array_view(tmp));
+      for (unsigned int k = 0; k < w.size(); ++k)
+        results[k] = tmp[k];
+    }
+
+    /**
+     * Compute the inner products <tt>results[k] = v * (*w[k])</tt> for all
+     * vectors in @p w. For vector types that provide a multi_dot() function,
+     * all products are computed with a single global reduction and by
+     * reading @p v from memory only once per group of vectors; otherwise,
+     * the products are computed one by one.
+     */
+    template <typename VectorType, typename Number>
+    inline void
+    dot_products(const VectorType &                        v,
+                 const ArrayView<const VectorType *const> &w,
+                 const ArrayView<Number> &                 results)
+    {
+      AssertDimension(w.size(), results.size());
+      dot_products(v,
+                   w,
+                   results,
+                   std::integral_constant<bool,
+                                          has_multi_dot<VectorType>::value>());
+    }
+  } // namespace SolverImplementation
+} // namespace internal
+
 /**
  * A base class for iterative linear solvers. This class provides interfaces
  * to a memory pool and the objects that determine whether a solver has
@@ -112,6 +112,20 @@ namespace internal
  * to find a general good criterion, so if things do not work for you, try to
  * change this value.
  *
+ * The third parameter selects a variant with merged global reductions,
+ * intended for large parallel computations where the latency of the
+ * reductions rather than the memory bandwidth limits the speed of an
+ * iteration. The standard algorithm computes five separate inner products
+ * per iteration. With the flag set, the inner product $\langle r_{k+1},
+ * \bar r\rangle$ needed in the next iteration is obtained from the inner
+ * products with the vector $t$ computed for the stabilization step, and the
+ * norm of the residual is computed by the recurrence $\|s-\omega t\|^2 =
+ * \|s\|^2 - 2\omega \langle t,s\rangle + \omega^2 \|t\|^2$, such that
+ * only three global reductions remain per iteration. In case this recurrence
+ * suffers from cancellation, the norm is recomputed from the vector. The
+ * iterates are mathematically the same as for the standard algorithm, but
+ * are affected differently by round-off.
+ *
  *
  * <h3>Observing the progress of linear solver iterations</h3>
  *
@@ -142,10 +156,12 @@ public:
      * The default is to perform an exact residual computation and breakdown
      * parameter 1e-10.
      */
-    explicit AdditionalData(const bool   exact_residual = true,
-                            const double breakdown      = 1.e-10)
+    explicit AdditionalData(const bool   exact_residual   = true,
+                            const double breakdown        = 1.e-10,
+                            const bool   merge_reductions = false)
       : exact_residual(exact_residual)
       , breakdown(breakdown)
+      , merge_reductions(merge_reductions)
     {}
     /**
      * Flag for exact computation of residual.
@@ -155,6 +171,11 @@ public:
      * Breakdown threshold.
      */
     double breakdown;
+    /**
+     * Flag for the variant with merged inner products that performs three
+     * instead of five global reductions per iteration.
+     */
+    bool merge_reductions;
   };
 
   /**
@@ -394,11 +415,19 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
   rbar         = r;
   bool startup = true;
 
+  // inner products of the intermediate residual s (stored in r) with itself
+  // and with rbar, and the inner product of the new residual with rbar, as
+  // used by the variant with merged reductions
+  double s_s = 0., s_rbar = 0., next_rho = 0.;
+
   do
     {
       ++step;
 
-      rhobar = r * rbar;
+      if (additional_data.merge_reductions && startup == false)
+        rhobar = next_rho;
+      else
+        rhobar = r * rbar;
       beta   = rhobar * alpha / (rho * omega);
       rho    = rhobar;
       if (startup == true)
@@ -423,7 +452,21 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
       if (std::fabs(alpha) > 1.e10)
         return IterationResult(true, state, step, res);
 
-      res = std::sqrt(r.add_and_dot(-alpha, v, r));
+      if (additional_data.merge_reductions)
+        {
+          r.add(-alpha, v);
+          const VectorType *const s_vectors[2] = {&r, &rbar};
+          double                  s_products[2];
+          internal::SolverImplementation::dot_products(
+            r,
+            ArrayView<const VectorType *const>(s_vectors, 2),
+            ArrayView<double>(s_products, 2));
+          s_s    = s_products[0];
+          s_rbar = s_products[1];
+          res    = std::sqrt(s_s);
+        }
+      else
+        res = std::sqrt(r.add_and_dot(-alpha, v, r));
 
       // check for early success, see the lac/bicgstab_early testcase as to
       // why this is necessary
@@ -440,15 +483,39 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
 
       preconditioner.vmult(z, r);
       A.vmult(t, z);
-      rhobar = t * r;
-      omega  = rhobar / (t * t);
+      // compute t*r and t*t (and t*rbar for the variant with merged
+      // reductions) in one sweep over t and one global reduction
+      const VectorType *const tr_vectors[3] = {&r, &t, &rbar};
+      double                  tr_products[3];
+      const unsigned int n_products = additional_data.merge_reductions ? 3 : 2;
+      internal::SolverImplementation::dot_products(
+        t,
+        ArrayView<const VectorType *const>(tr_vectors, n_products),
+        ArrayView<double>(tr_products, n_products));
+      rhobar = tr_products[0];
+      omega  = rhobar / tr_products[1];
       Vx->add(alpha, y, omega, z);
 
+      if (additional_data.merge_reductions)
+        next_rho = s_rbar - omega * tr_products[2];
+
       if (additional_data.exact_residual)
         {
           r.add(-omega, t);
           res = criterion(A, *Vx, *Vb);
         }
+      else if (additional_data.merge_reductions)
+        {
+          r.add(-omega, t);
+          const double res_square =
+            s_s - omega * (2. * tr_products[0] - omega * tr_products[1]);
+          // the recurrence loses accuracy when the new residual is much
+          // smaller than s, so compute the norm from the vector in that case
+          if (res_square > 1e-8 * s_s)
+            res = std::sqrt(res_square);
+          else
+            res = r.l2_norm();
+        }
       else
         res = std::sqrt(r.add_and_dot(-omega, t, r));
 
@@ -0,0 +1,492 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_block_cg_h
+#define dealii_solver_block_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename>
+    class BlockVector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
+
+namespace internal
+{
+  namespace SolverBlockCGImplementation
+  {
+    /**
+     * The number of vector entries processed at once in the fused loops for
+     * LinearAlgebra::distributed::BlockVector, chosen such that the chunks
+     * of all columns stay in the cache while they are combined with each
+     * other.
+     */
+    constexpr unsigned int chunk_size = 128;
+
+
+
+    /**
+     * Compute the matrix of scalar products $C_{ij} = x_i \cdot y_j$
+     * between the columns of the two block vectors @p x and @p y. Generic
+     * implementation for arbitrary block vector types.
+     */
+    template <typename BlockVectorType>
+    void
+    compute_gram_matrix(const BlockVectorType &x,
+                        const BlockVectorType &y,
+                        FullMatrix<double> &   C)
+    {
+      const unsigned int n_columns = x.n_blocks();
+      C.reinit(n_columns, n_columns);
+      for (unsigned int i = 0; i < n_columns; ++i)
+        for (unsigned int j = 0; j < n_columns; ++j)
+          C(i, j) = x.block(i) * y.block(j);
+    }
+
+
+
+    /**
+     * Specialization of the function above for
+     * LinearAlgebra::distributed::BlockVector, which computes all scalar
+     * products in a single sweep through the vectors and a single global
+     * reduction.
+     */
+    template <typename Number>
+    void
+    compute_gram_matrix(const LinearAlgebra::distributed::BlockVector<Number> &x,
+                        const LinearAlgebra::distributed::BlockVector<Number> &y,
+                        FullMatrix<double> &C)
+    {
+      const unsigned int n_columns  = x.n_blocks();
+      const unsigned int local_size = x.block(0).local_size();
+
+      std::vector<double> sums(n_columns * n_columns);
+      for (unsigned int start = 0; start < local_size; start += chunk_size)
+        {
+          const unsigned int end = std::min(start + chunk_size, local_size);
+          for (unsigned int i = 0; i < n_columns; ++i)
+            {
+              const Number *const x_ptr = x.block(i).begin();
+              for (unsigned int j = 0; j < n_columns; ++j)
+                {
+                  const Number *const y_ptr = y.block(j).begin();
+                  Number              sum   = 0.;
+                  for (unsigned int k = start; k < end; ++k)
+                    sum += x_ptr[k] * y_ptr[k];
+                  sums[i * n_columns + j] += sum;
+                }
+            }
+        }
+
+      Utilities::MPI::sum(sums, x.block(0).get_mpi_communicator(), sums);
+
+      C.reinit(n_columns, n_columns);
+      for (unsigned int i = 0; i < n_columns; ++i)
+        for (unsigned int j = 0; j < n_columns; ++j)
+          C(i, j) = sums[i * n_columns + j];
+    }
+
+
+
+    /**
+     * Perform the update $y_j \leftarrow y_j + \sum_i x_i C_{ij}$ for all
+     * columns $j$ of the block vector @p y, i.e., $Y \leftarrow Y + X C$.
+     * Generic implementation for arbitrary block vector types.
+     */
+    template <typename BlockVectorType>
+    void
+    add_block_product(BlockVectorType &         y,
+                      const BlockVectorType &   x,
+                      const FullMatrix<double> &C)
+    {
+      const unsigned int n_columns = x.n_blocks();
+      for (unsigned int j = 0; j < n_columns; ++j)
+        for (unsigned int i = 0; i < n_columns; ++i)
+          if (C(i, j) != 0.)
+            y.block(j).add(C(i, j), x.block(i));
+    }
+
+
+
+    /**
+     * Specialization of the function above for
+     * LinearAlgebra::distributed::BlockVector, which reads each column of
+     * @p x and writes each column of @p y only once.
+     */
+    template <typename Number>
+    void
+    add_block_product(LinearAlgebra::distributed::BlockVector<Number> &      y,
+                      const LinearAlgebra::distributed::BlockVector<Number> &x,
+                      const FullMatrix<double> &                             C)
+    {
+      const unsigned int n_columns  = x.n_blocks();
+      const unsigned int local_size = x.block(0).local_size();
+
+      for (unsigned int start = 0; start < local_size; start += chunk_size)
+        {
+          const unsigned int end = std::min(start + chunk_size, local_size);
+          for (unsigned int j = 0; j < n_columns; ++j)
+            {
+              Number *const y_ptr = y.block(j).begin();
+              for (unsigned int i = 0; i < n_columns; ++i)
+                {
+                  const Number *const x_ptr  = x.block(i).begin();
+                  const Number        factor = C(i, j);
+                  DEAL_II_OPENMP_SIMD_PRAGMA
+                  for (unsigned int k = start; k < end; ++k)
+                    y_ptr[k] += factor * x_ptr[k];
+                }
+            }
+        }
+    }
+
+
+
+    /**
+     * Solve the small system $C X = B$ with the symmetric positive
+     * semi-definite matrix @p C by a Cholesky factorization, overwriting
+     * @p B by the solution. Pivots that are smaller than @p tolerance times
+     * the largest diagonal entry are dropped, and the corresponding rows of
+     * the solution are set to zero. This handles the rank deficiency that
+     * appears in the block CG method when some of the columns converge
+     * before the others or become linearly dependent. Returns the number of
+     * dropped pivots.
+     */
+    inline unsigned int
+    solve_semidefinite(const FullMatrix<double> &C,
+                       FullMatrix<double> &      B,
+                       const double              tolerance)
+    {
+      const unsigned int n = C.m();
+      AssertDimension(C.n(), n);
+      AssertDimension(B.m(), n);
+
+      double max_diagonal = 0.;
+      for (unsigned int i = 0; i < n; ++i)
+        max_diagonal = std::max(max_diagonal, std::abs(C(i, i)));
+
+      // compute the lower-triangular factor L of C = L L^T column by column
+      FullMatrix<double> L(n, n);
+      std::vector<bool>  dropped(n, false);
+      unsigned int       n_dropped = 0;
+      for (unsigned int k = 0; k < n; ++k)
+        {
+          double diagonal = C(k, k);
+          for (unsigned int j = 0; j < k; ++j)
+            diagonal -= L(k, j) * L(k, j);
+          if (!(diagonal > tolerance * max_diagonal))
+            {
+              dropped[k] = true;
+              ++n_dropped;
+              continue;
+            }
+          L(k, k) = std::sqrt(diagonal);
+          for (unsigned int i = k + 1; i < n; ++i)
+            {
+              double entry = C(i, k);
+              for (unsigned int j = 0; j < k; ++j)
+                entry -= L(i, j) * L(k, j);
+              L(i, k) = entry / L(k, k);
+            }
+        }
+
+      // forward and backward substitution, skipping the dropped pivots
+      for (unsigned int c = 0; c < B.n(); ++c)
+        {
+          for (unsigned int i = 0; i < n; ++i)
+            if (dropped[i])
+              B(i, c) = 0.;
+            else
+              {
+                double entry = B(i, c);
+                for (unsigned int j = 0; j < i; ++j)
+                  entry -= L(i, j) * B(j, c);
+                B(i, c) = entry / L(i, i);
+              }
+          for (unsigned int i = n; i-- > 0;)
+            if (!dropped[i])
+              {
+                double entry = B(i, c);
+                for (unsigned int j = i + 1; j < n; ++j)
+                  entry -= L(j, i) * B(j, c);
+                B(i, c) = entry / L(i, i);
+              }
+        }
+
+      return n_dropped;
+    }
+  } // namespace SolverBlockCGImplementation
+} // namespace internal
+
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * The block conjugate gradient method of D. P. O'Leary, "The block conjugate
+ * gradient algorithm and related methods", Linear Algebra and its
+ * Applications 29 (1980), pp. 293-322, for solving a symmetric positive
+ * definite system with several right hand sides at once.
+ *
+ * The columns of the solution and the right hand side are represented by the
+ * blocks of a block vector type, such as LinearAlgebra::distributed::
+ * BlockVector or BlockVector, where each block holds one column. The
+ * matrix and the preconditioner passed to solve() need to provide a function
+ * <code>vmult(BlockVectorType &dst, const BlockVectorType &src)</code> that
+ * applies the operator to all columns. This is where the method gains over
+ * calling SolverCG once for each right hand side: An implementation of the
+ * operator (e.g. a matrix-free one based on MatrixFree and FEEvaluation) can
+ * apply the operator to all columns in a single sweep, such that the matrix
+ * entries, or the index and geometry data in the matrix-free case, are only
+ * loaded once for all right hand sides. Furthermore, the method searches in
+ * the sum of the Krylov spaces of all columns, which typically reduces the
+ * number of iterations compared to solving the systems one by one.
+ *
+ * In each iteration, the method computes two small dense matrices of scalar
+ * products between the columns. For LinearAlgebra::distributed::BlockVector,
+ * each of them is computed in a single sweep through the vectors with a
+ * single global reduction, and the vector updates with the small matrices
+ * are also done in a single sweep. For other block vector types, the usual
+ * vector operations on the individual blocks are used.
+ *
+ * When some of the columns converge faster than others, or the right hand
+ * sides are linearly dependent, the small matrices become singular. The
+ * method handles this by dropping the dependent directions in the
+ * factorization of the small matrices, see
+ * AdditionalData::deflation_tolerance.
+ *
+ * The convergence criterion of the SolverControl object refers to the
+ * Frobenius norm of the residual, i.e., the $l_2$ norm of all columns
+ * together.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. This mechanism can also be used
+ * to observe the progress of the iteration.
+ */
+template <typename BlockVectorType>
+class SolverBlockCG : public SolverBase<BlockVectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    explicit AdditionalData(const double deflation_tolerance = 1e-12)
+      : deflation_tolerance(deflation_tolerance)
+    {}
+
+    /**
+     * Relative tolerance for the pivots in the factorization of the small
+     * matrices of scalar products. Directions whose pivot is smaller than
+     * this value times the largest diagonal entry are considered to be
+     * linearly dependent on the others and are not used for the update in
+     * the respective step.
+     */
+    double deflation_tolerance;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverBlockCG(SolverControl &                cn,
+                VectorMemory<BlockVectorType> &mem,
+                const AdditionalData &         data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverBlockCG(SolverControl &cn, const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $AX=B$ for all columns of X, which are given by
+   * the blocks of @p x and @p b.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        BlockVectorType &         x,
+        const BlockVectorType &   b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Stores a copy of the additional data.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename BlockVectorType>
+SolverBlockCG<BlockVectorType>::SolverBlockCG(
+  SolverControl &                cn,
+  VectorMemory<BlockVectorType> &mem,
+  const AdditionalData &         data)
+  : SolverBase<BlockVectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename BlockVectorType>
+SolverBlockCG<BlockVectorType>::SolverBlockCG(SolverControl &       cn,
+                                              const AdditionalData &data)
+  : SolverBase<BlockVectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename BlockVectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverBlockCG<BlockVectorType>::solve(const MatrixType &        A,
+                                      BlockVectorType &         x,
+                                      const BlockVectorType &   b,
+                                      const PreconditionerType &preconditioner)
+{
+  using namespace internal::SolverBlockCGImplementation;
+
+  AssertDimension(x.n_blocks(), b.n_blocks());
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("BlockCG");
+
+  // Memory allocation
+  typename VectorMemory<BlockVectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer z_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer q_pointer(this->memory);
+
+  // define some aliases for simpler access: r is the residual, z the
+  // preconditioned residual, p the search directions, and q = A p
+  BlockVectorType &r = *r_pointer;
+  BlockVectorType &z = *z_pointer;
+  BlockVectorType &p = *p_pointer;
+  BlockVectorType &q = *q_pointer;
+
+  r.reinit(x, true);
+  z.reinit(x, true);
+  p.reinit(x, true);
+  q.reinit(x, true);
+
+  int    it  = 0;
+  double res = -std::numeric_limits<double>::max();
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  res  = r.l2_norm();
+  conv = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  preconditioner.vmult(z, r);
+  p = z;
+
+  // gamma = Z^T R, delta = P^T Q, and alpha and beta the coefficient
+  // matrices for the updates of the solution and the search directions
+  FullMatrix<double> gamma, gamma_new, delta, alpha, beta;
+  compute_gram_matrix(z, r, gamma);
+
+  while (conv == SolverControl::iterate)
+    {
+      it++;
+      A.vmult(q, p);
+
+      // alpha = delta^{-1} gamma
+      compute_gram_matrix(p, q, delta);
+      alpha = gamma;
+      solve_semidefinite(delta, alpha, additional_data.deflation_tolerance);
+
+      add_block_product(x, p, alpha);
+      alpha *= -1.;
+      add_block_product(r, q, alpha);
+
+      res  = r.l2_norm();
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      preconditioner.vmult(z, r);
+
+      // beta = gamma^{-1} gamma_new
+      compute_gram_matrix(z, r, gamma_new);
+      beta = gamma_new;
+      solve_semidefinite(gamma, beta, additional_data.deflation_tolerance);
+      gamma = gamma_new;
+
+      // p = z + p beta, using q as temporary storage
+      q = z;
+      add_block_product(q, p, beta);
+      p.swap(q);
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
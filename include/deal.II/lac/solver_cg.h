@@ -20,7 +20,10 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/solver.h>
@@ -28,15 +31,96 @@
 #include <deal.II/lac/tridiagonal_matrix.h>
 
 #include <cmath>
+#include <functional>
+#include <type_traits>
 
 DEAL_II_NAMESPACE_OPEN
 
 // forward declaration
 #ifndef DOXYGEN
 class PreconditionIdentity;
+template <typename VectorType>
+class DiagonalMatrix;
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
 #endif
 
 
+namespace internal
+{
+  namespace SolverCGImplementation
+  {
+    // A trait class that determines whether type T provides a vmult function
+    // with two additional functions that are run on subranges of the vectors
+    // before and after the matrix-vector product, as provided by the variant
+    // of MatrixFree::cell_loop() with pre and post operations
+    template <typename VectorType, typename T>
+    class has_vmult_with_std_functions
+    {
+      template <typename C>
+      static std::false_type
+      test(...);
+
+      template <typename C>
+      static auto
+      test(VectorType *v)
+        -> decltype(std::declval<C>().vmult(
+                      *v,
+                      *v,
+                      std::declval<const std::function<
+                        void(const unsigned int, const unsigned int)> &>(),
+                      std::declval<const std::function<
+                        void(const unsigned int, const unsigned int)> &>()),
+                    std::true_type());
+
+    public:
+      static constexpr bool value = decltype(test<T>(nullptr))::value;
+    };
+
+    // A trait class that determines whether the CG iteration with vector
+    // updates fused into the matrix-vector product can be used for the given
+    // combination of vector, matrix, and preconditioner
+    template <typename VectorType,
+              typename MatrixType,
+              typename PreconditionerType>
+    struct supports_fused_updates
+    {
+      static constexpr bool value =
+        has_vmult_with_std_functions<VectorType, MatrixType>::value &&
+        std::is_same<VectorType,
+                     LinearAlgebra::distributed::Vector<
+                       typename VectorType::value_type,
+                       ::dealii::MemorySpace::Host>>::value &&
+        (std::is_same<PreconditionerType, PreconditionIdentity>::value ||
+         std::is_same<PreconditionerType,
+                      DiagonalMatrix<VectorType>>::value);
+    };
+
+    // Return the entries of a diagonal preconditioner, or the null pointer
+    // for the identity
+    template <typename VectorType>
+    inline const typename VectorType::value_type *
+    get_diagonal_entries(const PreconditionIdentity &)
+    {
+      return nullptr;
+    }
+
+    template <typename VectorType>
+    inline const typename VectorType::value_type *
+    get_diagonal_entries(const DiagonalMatrix<VectorType> &preconditioner)
+    {
+      return preconditioner.get_vector().begin();
+    }
+  } // namespace SolverCGImplementation
+} // namespace internal
+
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -90,6 +174,35 @@ class PreconditionIdentity;
  * The solve() function of this class uses the mechanism described in the
  * Solver base class to determine convergence. This mechanism can also be used
  * to observe the progress of the iteration.
+ *
+ *
+ * <h3>Fused vector updates</h3>
+ *
+ * If the vector type is LinearAlgebra::distributed::Vector, the
+ * preconditioner is either PreconditionIdentity or a DiagonalMatrix, and the
+ * matrix provides a function
+ * @code
+ * void vmult(VectorType &dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_before_matrix_vector_product,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_after_matrix_vector_product) const;
+ * @endcode
+ * that passes the two functions to the variant of MatrixFree::cell_loop()
+ * with pre and post operations (see also PreconditionChebyshev), the solver
+ * merges most of the vector operations into the matrix-vector product: The
+ * update of the solution and of the search direction is run on each range of
+ * the vectors right before the matrix-vector product reads it, and the
+ * scalar product of the search direction with the result is accumulated
+ * right after the range has been written. The update of the residual, the
+ * application of the diagonal preconditioner and the two scalar products
+ * needed for the next step are done in a single sweep through the vectors.
+ * This saves several passes through memory per iteration. Since the update
+ * of the solution is deferred to the next matrix-vector product, the vector
+ * passed to the iteration_status() mechanism lags one update behind the
+ * current iterate, and print_vectors() is not called. The solution vector
+ * is up to date when solve() returns.
  */
 template <typename VectorType = Vector<double>>
 class SolverCG : public SolverBase<VectorType>
@@ -193,6 +306,30 @@ protected:
       &                                          eigenvalues_signal,
     const boost::signals2::signal<void(double)> &cond_signal);
 
+  /**
+   * Implementation of solve() with vector updates fused into the
+   * matrix-vector product, see the general documentation of this class.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve_with_fused_updates(const MatrixType &        A,
+                           VectorType &              x,
+                           const VectorType &        b,
+                           const PreconditionerType &preconditioner,
+                           std::true_type);
+
+  /**
+   * Dummy implementation for the case where the vector updates can not be
+   * fused into the matrix-vector product; never called.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve_with_fused_updates(const MatrixType &        A,
+                           VectorType &              x,
+                           const VectorType &        b,
+                           const PreconditionerType &preconditioner,
+                           std::false_type);
+
   /**
    * Additional parameters.
    */
@@ -320,6 +457,20 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
                             const VectorType &        b,
                             const PreconditionerType &preconditioner)
 {
+  constexpr bool use_fused_updates =
+    internal::SolverCGImplementation::
+      supports_fused_updates<VectorType, MatrixType, PreconditionerType>::value;
+  if (use_fused_updates)
+    {
+      solve_with_fused_updates(
+        A,
+        x,
+        b,
+        preconditioner,
+        std::integral_constant<bool, use_fused_updates>());
+      return;
+    }
+
   using number = typename VectorType::value_type;
 
   SolverControl::State conv = SolverControl::iterate;
@@ -457,6 +608,232 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
 
 
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCG<VectorType>::solve_with_fused_updates(
+  const MatrixType &        A,
+  VectorType &              x,
+  const VectorType &        b,
+  const PreconditionerType &preconditioner,
+  std::true_type)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("cg");
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &g = *g_pointer;
+  VectorType &d = *d_pointer;
+  VectorType &h = *h_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues =
+    !condition_number_signal.empty() || !all_condition_numbers_signal.empty() ||
+    !eigenvalues_signal.empty() || !all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue
+  // computations
+  std::vector<number> diagonal;
+  std::vector<number> offdiagonal;
+
+  int    it  = 0;
+  double res = -std::numeric_limits<double>::max();
+
+  number eigen_beta_alpha = 0;
+
+  // the search direction is set up in the first matrix-vector product as a
+  // multiple of itself, so it must not contain invalid numbers
+  g.reinit(x, true);
+  d.reinit(x);
+  h.reinit(x, true);
+
+  // compute residual. if vector is
+  // zero, then short-circuit the
+  // full computation
+  if (!x.all_zero())
+    {
+      A.vmult(g, x);
+      g.add(-1., b);
+    }
+  else
+    g.equ(-1., b);
+  res = g.l2_norm();
+
+  conv = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  // the entries of the diagonal preconditioner, or the null pointer for the
+  // identity
+  const number *const diagonal_entries =
+    internal::SolverCGImplementation::get_diagonal_entries<VectorType>(
+      preconditioner);
+  const unsigned int local_size = x.local_size();
+  const MPI_Comm &   comm       = x.get_mpi_communicator();
+
+  number gh = res * res;
+  if (diagonal_entries != nullptr)
+    {
+      gh = 0;
+      for (unsigned int i = 0; i < local_size; ++i)
+        gh += g.local_element(i) * diagonal_entries[i] * g.local_element(i);
+      gh = Utilities::MPI::sum(gh, comm);
+    }
+
+  number alpha = 0., beta = 0.;
+
+  while (conv == SolverControl::iterate)
+    {
+      it++;
+
+      number dh = 0.;
+      A.vmult(
+        h,
+        d,
+        [&](const unsigned int begin, const unsigned int end) {
+          number *const       x_ptr = x.begin();
+          number *const       d_ptr = d.begin();
+          number *const       h_ptr = h.begin();
+          const number *const g_ptr = g.begin();
+
+          // apply the update of the solution from the previous iteration
+          // before the search direction gets overwritten
+          if (it > 1)
+            {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int i = begin; i < end; ++i)
+                x_ptr[i] += alpha * d_ptr[i];
+            }
+
+          if (diagonal_entries != nullptr)
+            {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int i = begin; i < end; ++i)
+                d_ptr[i] = beta * d_ptr[i] - diagonal_entries[i] * g_ptr[i];
+            }
+          else
+            {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int i = begin; i < end; ++i)
+                d_ptr[i] = beta * d_ptr[i] - g_ptr[i];
+            }
+
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = begin; i < end; ++i)
+            h_ptr[i] = 0.;
+        },
+        [&](const unsigned int begin, const unsigned int end) {
+          const number *const d_ptr = d.begin();
+          const number *const h_ptr = h.begin();
+
+          number sum = 0.;
+          for (unsigned int i = begin; i < end; ++i)
+            sum += d_ptr[i] * h_ptr[i];
+          dh += sum;
+        });
+
+      dh = Utilities::MPI::sum(dh, comm);
+      Assert(std::abs(dh) != 0., ExcDivideByZero());
+      alpha = gh / dh;
+
+      // update the residual and compute both its norm and its scalar
+      // product with the preconditioned residual in one sweep
+      number              sums[2] = {0., 0.};
+      number *const       g_ptr   = g.begin();
+      const number *const h_ptr   = h.begin();
+      if (diagonal_entries != nullptr)
+        {
+          number gg = 0., gz = 0.;
+          for (unsigned int i = 0; i < local_size; ++i)
+            {
+              g_ptr[i] += alpha * h_ptr[i];
+              gg += g_ptr[i] * g_ptr[i];
+              gz += g_ptr[i] * diagonal_entries[i] * g_ptr[i];
+            }
+          sums[0] = gg;
+          sums[1] = gz;
+        }
+      else
+        {
+          number gg = 0.;
+          for (unsigned int i = 0; i < local_size; ++i)
+            {
+              g_ptr[i] += alpha * h_ptr[i];
+              gg += g_ptr[i] * g_ptr[i];
+            }
+          sums[0] = gg;
+        }
+      Utilities::MPI::sum(ArrayView<const number>(sums, 2),
+                          comm,
+                          ArrayView<number>(sums, 2));
+      if (diagonal_entries == nullptr)
+        sums[1] = sums[0];
+
+      res = std::sqrt(std::abs(sums[0]));
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        {
+          x.add(alpha, d);
+          break;
+        }
+
+      Assert(std::abs(gh) != 0., ExcDivideByZero());
+      beta = sums[1] / gh;
+      gh   = sums[1];
+
+      this->coefficients_signal(alpha, beta);
+      // set up the vectors
+      // containing the diagonal
+      // and the off diagonal of
+      // the projected matrix.
+      if (do_eigenvalues)
+        {
+          diagonal.push_back(number(1.) / alpha + eigen_beta_alpha);
+          eigen_beta_alpha = beta / alpha;
+          offdiagonal.push_back(std::sqrt(beta) / alpha);
+        }
+      compute_eigs_and_cond(diagonal,
+                            offdiagonal,
+                            all_eigenvalues_signal,
+                            all_condition_numbers_signal);
+    }
+
+  compute_eigs_and_cond(diagonal,
+                        offdiagonal,
+                        eigenvalues_signal,
+                        condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCG<VectorType>::solve_with_fused_updates(const MatrixType &,
+                                               VectorType &,
+                                               const VectorType &,
+                                               const PreconditionerType &,
+                                               std::false_type)
+{
+  Assert(false, ExcInternalError());
+}
+
+
+
 template <typename VectorType>
 boost::signals2::connection
 SolverCG<VectorType>::connect_coefficients_slot(
@@ -20,7 +20,10 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/full_matrix.h>
@@ -37,6 +40,18 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -180,16 +195,45 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * An enum to select the algorithm used to orthogonalize the new vector
+     * against the Arnoldi basis in each iteration.
+     */
+    enum OrthogonalizationStrategy
+    {
+      /**
+       * Use the modified Gram-Schmidt algorithm, which is numerically the
+       * most robust variant, but needs a separate global reduction for the
+       * scalar product with each of the basis vectors.
+       */
+      modified_gram_schmidt,
+      /**
+       * Use the classical Gram-Schmidt algorithm, which computes the scalar
+       * products with all basis vectors at once. For
+       * LinearAlgebra::distributed::Vector, this is done in a single sweep
+       * through the vectors with a single global reduction, and the norm of
+       * the result is computed from the same reduction, such that an
+       * iteration needs one reduction (or two if re-orthogonalization is
+       * enabled). For other vector types, the same algorithm is run with the
+       * usual vector operations.
+       */
+      classical_gram_schmidt
+    };
+
     /**
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, and use the modified
+     * Gram-Schmidt algorithm.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int              max_n_tmp_vectors          = 30,
+      const bool                      right_preconditioning      = false,
+      const bool                      use_default_residual       = true,
+      const bool                      force_re_orthogonalization = false,
+      const OrthogonalizationStrategy orthogonalization_strategy =
+        modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -220,6 +264,21 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * The algorithm used for the orthogonalization of the Arnoldi basis.
+     *
+     * With the classical Gram-Schmidt algorithm, the loss of orthogonality
+     * is detected from the norm of the vector before and after the
+     * orthogonalization as with the modified algorithm, but in every step
+     * rather than every fifth step, and from then on the orthogonalization
+     * is repeated once in each step. Since the classical algorithm
+     * loses orthogonality faster, it is recommended to combine it with
+     * #force_re_orthogonalization for ill-conditioned problems or large
+     * Arnoldi bases, which gives the numerically stable "CGS2" variant at
+     * the cost of two global reductions per iteration.
+     */
+    OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -408,6 +467,27 @@ protected:
     const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
       boost::signals2::signal<void(int)>());
 
+  /**
+   * Orthogonalize the vector @p vv against the @p dim (orthogonal) vectors
+   * given by the first argument using the classical Gram-Schmidt algorithm.
+   * The arguments and the strategy for re-orthogonalization are the same as
+   * for modified_gram_schmidt(). The scalar products with all vectors and
+   * the norm of @p vv are computed together, and the norm after the
+   * orthogonalization is obtained from them via the Pythagorean theorem,
+   * such that each pass needs a single global reduction.
+   */
+  static double
+  classical_gram_schmidt(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                                       orthogonal_vectors,
+    const unsigned int                        dim,
+    const unsigned int                        accumulated_iterations,
+    VectorType &                              vv,
+    Vector<double> &                          h,
+    bool &                                    re_orthogonalize,
+    const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
+      boost::signals2::signal<void(int)>());
+
   /**
    * Estimates the eigenvalues from the Hessenberg matrix, H_orig, generated
    * during the inner iterations. Uses these estimate to compute the condition
@@ -585,6 +665,134 @@ namespace internal
 
 
 
+    /**
+     * The number of vector entries processed at once in the classical
+     * Gram-Schmidt algorithm for LinearAlgebra::distributed::Vector, chosen
+     * such that the chunk of the vector to be orthogonalized stays in the
+     * L1 cache while it is combined with all basis vectors.
+     */
+    constexpr unsigned int gs_chunk_size = 256;
+
+
+
+    /**
+     * Compute the scalar products of the vector @p vv with the first @p dim
+     * vectors of @p orthogonal_vectors into the entries 0 to @p dim-1 of
+     * @p h, and the square of the norm of @p vv into the entry @p dim.
+     * Generic implementation for arbitrary vector types.
+     */
+    template <class VectorType>
+    inline void
+    compute_scalar_products(const TmpVectors<VectorType> &orthogonal_vectors,
+                            const unsigned int            dim,
+                            const VectorType &            vv,
+                            double *                      h)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        h[i] = vv * orthogonal_vectors[i];
+      h[dim] = vv * vv;
+    }
+
+
+
+    /**
+     * Specialization of the function above for
+     * LinearAlgebra::distributed::Vector: The scalar products are computed
+     * chunk by chunk, such that the entries of @p vv are read from the
+     * cache for all vectors, and all results are combined in a single
+     * global reduction.
+     */
+    template <typename Number>
+    inline void
+    compute_scalar_products(
+      const TmpVectors<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        &                orthogonal_vectors,
+      const unsigned int dim,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &vv,
+      double *                                                             h)
+    {
+      const unsigned int  local_size = vv.local_size();
+      const Number *const vv_ptr     = vv.begin();
+      for (unsigned int i = 0; i <= dim; ++i)
+        h[i] = 0.;
+
+      for (unsigned int start = 0; start < local_size; start += gs_chunk_size)
+        {
+          const unsigned int end = std::min(start + gs_chunk_size, local_size);
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              const Number *const v_ptr = orthogonal_vectors[i].begin();
+              Number              sum   = 0.;
+              for (unsigned int j = start; j < end; ++j)
+                sum += vv_ptr[j] * v_ptr[j];
+              h[i] += sum;
+            }
+          Number sum = 0.;
+          for (unsigned int j = start; j < end; ++j)
+            sum += vv_ptr[j] * vv_ptr[j];
+          h[dim] += sum;
+        }
+
+      Utilities::MPI::sum(ArrayView<const double>(h, dim + 1),
+                          vv.get_mpi_communicator(),
+                          ArrayView<double>(h, dim + 1));
+    }
+
+
+
+    /**
+     * Subtract the projections onto the first @p dim vectors of
+     * @p orthogonal_vectors, with the coefficients given by @p h, from the
+     * vector @p vv. Generic implementation for arbitrary vector types.
+     */
+    template <class VectorType>
+    inline void
+    subtract_projections(const TmpVectors<VectorType> &orthogonal_vectors,
+                         const unsigned int            dim,
+                         const double *                h,
+                         VectorType &                  vv)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        vv.add(-h[i], orthogonal_vectors[i]);
+    }
+
+
+
+    /**
+     * Specialization of the function above for
+     * LinearAlgebra::distributed::Vector, which subtracts all projections
+     * chunk by chunk, such that @p vv is only read and written once.
+     */
+    template <typename Number>
+    inline void
+    subtract_projections(
+      const TmpVectors<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        &                orthogonal_vectors,
+      const unsigned int dim,
+      const double *                                                 h,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &vv)
+    {
+      const unsigned int local_size = vv.local_size();
+      Number *const      vv_ptr     = vv.begin();
+
+      for (unsigned int start = 0; start < local_size; start += gs_chunk_size)
+        {
+          const unsigned int end = std::min(start + gs_chunk_size, local_size);
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              const Number *const v_ptr  = orthogonal_vectors[i].begin();
+              const Number        factor = h[i];
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int j = start; j < end; ++j)
+                vv_ptr[j] -= factor * v_ptr[j];
+            }
+        }
+    }
+
+
+
     // A comparator for better printing eigenvalues
     inline bool
     complex_less_pred(const std::complex<double> &x,
@@ -600,14 +808,16 @@ namespace internal
 
 template <class VectorType>
 inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
-  const unsigned int max_n_tmp_vectors,
-  const bool         right_preconditioning,
-  const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const unsigned int              max_n_tmp_vectors,
+  const bool                      right_preconditioning,
+  const bool                      use_default_residual,
+  const bool                      force_re_orthogonalization,
+  const OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -736,6 +946,77 @@ SolverGMRES<VectorType>::modified_gram_schmidt(
 
 
 
+template <class VectorType>
+inline double
+SolverGMRES<VectorType>::classical_gram_schmidt(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                                       orthogonal_vectors,
+  const unsigned int                        dim,
+  const unsigned int                        accumulated_iterations,
+  VectorType &                              vv,
+  Vector<double> &                          h,
+  bool &                                    reorthogonalize,
+  const boost::signals2::signal<void(int)> &reorthogonalize_signal)
+{
+  Assert(dim > 0, ExcInternalError());
+  Assert(h.size() > dim, ExcInternalError());
+
+  // compute all scalar products and the norm of vv at once, using the entry
+  // h(dim) as temporary storage for the latter; the caller overwrites this
+  // entry by the norm after orthogonalization
+  internal::SolverGMRESImplementation::compute_scalar_products(
+    orthogonal_vectors, dim, vv, h.begin());
+  internal::SolverGMRESImplementation::subtract_projections(orthogonal_vectors,
+                                                            dim,
+                                                            h.begin(),
+                                                            vv);
+
+  // as the basis is orthonormal, the norm of the orthogonalized vector
+  // follows from the Pythagorean theorem without another reduction
+  const double norm_vv_start_sqr = h(dim);
+  double       norm_vv_sqr       = norm_vv_start_sqr;
+  for (unsigned int i = 0; i < dim; ++i)
+    norm_vv_sqr -= h(i) * h(i);
+
+  // Re-orthogonalization if loss of orthogonality detected, using the same
+  // criterion as in modified_gram_schmidt(). As the norms are available
+  // without additional cost, the check is done in every step. Note that the
+  // Pythagorean formula above suffers from cancellation in exactly the case
+  // the criterion detects, so the second pass is also necessary to get an
+  // accurate norm.
+  if (reorthogonalize == false)
+    {
+      if (norm_vv_sqr >
+          100. * norm_vv_start_sqr *
+            std::numeric_limits<typename VectorType::value_type>::epsilon())
+        return std::sqrt(norm_vv_sqr);
+
+      reorthogonalize = true;
+      if (!reorthogonalize_signal.empty())
+        reorthogonalize_signal(accumulated_iterations);
+    }
+
+  // second pass of the classical Gram-Schmidt algorithm; the corrections to
+  // the coefficients are small, so the Pythagorean formula is now accurate
+  std::vector<double> htmp(dim + 1);
+  internal::SolverGMRESImplementation::compute_scalar_products(
+    orthogonal_vectors, dim, vv, htmp.data());
+  internal::SolverGMRESImplementation::subtract_projections(orthogonal_vectors,
+                                                            dim,
+                                                            htmp.data(),
+                                                            vv);
+  norm_vv_sqr = htmp[dim];
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      h(i) += htmp[i];
+      norm_vv_sqr -= htmp[i] * htmp[i];
+    }
+
+  return std::sqrt(std::max(norm_vv_sqr, 0.));
+}
+
+
+
 template <class VectorType>
 inline void
 SolverGMRES<VectorType>::compute_eigs_and_cond(
@@ -954,13 +1235,23 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+                 AdditionalData::classical_gram_schmidt ?
+               classical_gram_schmidt(tmp_vectors,
+                                      dim,
+                                      accumulated_iterations,
+                                      vv,
+                                      h,
+                                      re_orthogonalize,
+                                      re_orthogonalize_signal) :
+               modified_gram_schmidt(tmp_vectors,
+                                     dim,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal));
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
@@ -335,7 +335,13 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
       for (unsigned int j = 0; j < i; ++j)
         {
           v = Q[j];
-          v *= (v * tmp_q) / (tmp_q * tmp_q);
+          const VectorType *const vq_vectors[2] = {&v, &tmp_q};
+          double                  vq_products[2];
+          internal::SolverImplementation::dot_products(
+            tmp_q,
+            ArrayView<const VectorType *const>(vq_vectors, 2),
+            ArrayView<double>(vq_products, 2));
+          v *= vq_products[0] / vq_products[1];
           tmp_q.add(-1.0, v);
         }
 
@@ -345,6 +351,12 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
       M(i, i) = 1.;
     }
 
+  // Pointers to the vectors Q, used for computing several inner products
+  // with these vectors in a single sweep and global reduction
+  std::vector<const VectorType *> Q_ptrs(s);
+  for (unsigned int i = 0; i < s; ++i)
+    Q_ptrs[i] = &Q[i];
+
   double omega = 1.;
 
   bool early_exit = false;
@@ -356,8 +368,10 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
 
       // Compute phi
       Vector<double> phi(s);
-      for (unsigned int i = 0; i < s; ++i)
-        phi(i) = Q[i] * r;
+      internal::SolverImplementation::dot_products(
+        r,
+        ArrayView<const VectorType *const>(Q_ptrs.data(), s),
+        ArrayView<double>(phi.begin(), s));
 
       // Inner iteration over s
       for (unsigned int k = 0; k < s; ++k)
@@ -410,8 +424,13 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
           U[k] = uhat;
 
           // Update kth column of M
+          Vector<double> Mk_column(s - k);
+          internal::SolverImplementation::dot_products(
+            G[k],
+            ArrayView<const VectorType *const>(Q_ptrs.data() + k, s - k),
+            ArrayView<double>(Mk_column.begin(), s - k));
           for (unsigned int i = k; i < s; ++i)
-            M(i, k) = Q[i] * G[k];
+            M(i, k) = Mk_column(i - k);
 
           // Orthogonalize r to Q0,...,Qk,
           // update x
@@ -450,7 +469,13 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
       preconditioner.vmult(vhat, r);
       A.vmult(v, vhat);
 
-      omega = (v * r) / (v * v);
+      const VectorType *const vr_vectors[2] = {&r, &v};
+      double                  vr_products[2];
+      internal::SolverImplementation::dot_products(
+        v,
+        ArrayView<const VectorType *const>(vr_vectors, 2),
+        ArrayView<double>(vr_products, 2));
+      omega = vr_products[0] / vr_products[1];
 
       r.add(-1.0 * omega, v);
       x.add(omega, vhat);
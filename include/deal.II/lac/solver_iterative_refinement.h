@@ -0,0 +1,223 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_iterative_refinement_h
+#define dealii_solver_iterative_refinement_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector_memory.h>
+
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * Iterative refinement, also called defect correction, with an inner solver
+ * that may work on a vector type of lower precision. This is the typical
+ * setting of mixed-precision solvers: The outer iteration computes the
+ * residual $r_k = b - A x_k$ with the matrix @p A in the precision of
+ * @p VectorType (e.g. double), converts it to @p InnerVectorType (e.g.
+ * float), approximately solves the correction equation $\tilde A d_k = r_k$
+ * with an inner solver, an inner matrix $\tilde A$, and an inner
+ * preconditioner that all work in the lower precision, and then updates
+ * $x_{k+1} = x_k + d_k$. As long as the inner solve reduces the residual by
+ * some factor, the outer iteration converges to the accuracy of the outer
+ * precision, while most of the work and memory transfer is spent in the
+ * cheaper inner precision. A typical example is a matrix-free operator in
+ * double precision for the outer residual with a SolverCG in float with a
+ * multigrid preconditioner that is set up in float entirely.
+ *
+ * The inner solver is passed to solve() and can be any deal.II solver for
+ * @p InnerVectorType, e.g. SolverCG or SolverGMRES. Its SolverControl
+ * determines how accurately each correction equation is solved, for which a
+ * ReductionControl with a moderate relative tolerance such as $10^{-2}$ to
+ * $10^{-4}$ is usually appropriate. If the inner solver does not reach its
+ * tolerance, the correction obtained so far is used and the outer iteration
+ * continues, so the inner solver may also just run a fixed number of
+ * iterations.
+ *
+ * Since the outer residual is computed in the precision of @p VectorType,
+ * the convergence test via the SolverControl passed to the constructor of
+ * this class refers to the accuracy of the outer precision. The vectors
+ * passed between the two precisions are converted element by element
+ * without further temporary vectors. For this, the vector types need to
+ * support assignment from each other, as well as reinit() from a vector of
+ * the other type, as is the case for Vector and
+ * LinearAlgebra::distributed::Vector.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence of the outer iteration. This
+ * mechanism can also be used to observe the progress of the iteration.
+ */
+template <typename VectorType, typename InnerVectorType>
+class SolverIterativeRefinement : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver. This
+   * solver does not need additional data.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverIterativeRefinement(SolverControl &           cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverIterativeRefinement(SolverControl &       cn,
+                            const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x, using the given inner solver with
+   * the inner matrix and preconditioner for the correction equations.
+   */
+  template <typename MatrixType,
+            typename InnerSolverType,
+            typename InnerMatrixType,
+            typename InnerPreconditionerType>
+  void
+  solve(const MatrixType &             A,
+        VectorType &                   x,
+        const VectorType &             b,
+        InnerSolverType &              inner_solver,
+        const InnerMatrixType &        inner_matrix,
+        const InnerPreconditionerType &inner_preconditioner);
+
+protected:
+  /**
+   * Storage for the vectors of the inner precision.
+   */
+  GrowingVectorMemory<InnerVectorType> inner_memory;
+};
+
+/*@}*/
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType, typename InnerVectorType>
+SolverIterativeRefinement<VectorType, InnerVectorType>::
+  SolverIterativeRefinement(SolverControl &           cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData &)
+  : SolverBase<VectorType>(cn, mem)
+{}
+
+
+
+template <typename VectorType, typename InnerVectorType>
+SolverIterativeRefinement<VectorType, InnerVectorType>::
+  SolverIterativeRefinement(SolverControl &cn, const AdditionalData &)
+  : SolverBase<VectorType>(cn)
+{}
+
+
+
+template <typename VectorType, typename InnerVectorType>
+template <typename MatrixType,
+          typename InnerSolverType,
+          typename InnerMatrixType,
+          typename InnerPreconditionerType>
+void
+SolverIterativeRefinement<VectorType, InnerVectorType>::solve(
+  const MatrixType &             A,
+  VectorType &                   x,
+  const VectorType &             b,
+  InnerSolverType &              inner_solver,
+  const InnerMatrixType &        inner_matrix,
+  const InnerPreconditionerType &inner_preconditioner)
+{
+  SolverControl::State conv = SolverControl::iterate;
+
+  double res = -std::numeric_limits<double>::max();
+
+  unsigned int iter = 0;
+
+  // Memory allocation: 'r' holds the residual in the outer precision, 'r_in'
+  // and 'd_in' the residual and the correction in the inner precision
+  typename VectorMemory<VectorType>::Pointer      r_pointer(this->memory);
+  typename VectorMemory<InnerVectorType>::Pointer r_in_pointer(inner_memory);
+  typename VectorMemory<InnerVectorType>::Pointer d_in_pointer(inner_memory);
+
+  VectorType &     r    = *r_pointer;
+  InnerVectorType &r_in = *r_in_pointer;
+  InnerVectorType &d_in = *d_in_pointer;
+  r.reinit(x, true);
+  r_in.reinit(x, true);
+  d_in.reinit(x, true);
+
+  LogStream::Prefix prefix("IterativeRefinement");
+
+  while (conv == SolverControl::iterate)
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+
+      res  = r.l2_norm();
+      conv = this->iteration_status(iter, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // solve the correction equation in the inner precision; if the inner
+      // solver does not converge, we still use the correction computed so
+      // far, as the outer iteration checks convergence itself
+      r_in = r;
+      d_in = 0;
+      try
+        {
+          inner_solver.solve(inner_matrix, d_in, r_in, inner_preconditioner);
+        }
+      catch (const SolverControl::NoConvergence &)
+        {}
+
+      // add the correction to the solution, converting element by element
+      auto x_entry = x.begin();
+      for (auto d_entry = d_in.begin(); d_entry != d_in.end();
+           ++d_entry, ++x_entry)
+        *x_entry += *d_entry;
+
+      ++iter;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(iter, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,445 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_pipelined_cg_h
+#define dealii_solver_pipelined_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
+
+namespace internal
+{
+  namespace SolverPipelinedCGImplementation
+  {
+    /**
+     * The three scalar products needed in each iteration of the pipelined
+     * CG method, i.e., $(r,u)$, $(w,u)$, and $(r,r)$, along with the handle
+     * of the non-blocking reduction that computes them.
+     */
+    struct Reductions
+    {
+      Reductions()
+        : values{{0., 0., 0.}}
+        , request(MPI_REQUEST_NULL)
+      {}
+
+      std::array<double, 3> values;
+      MPI_Request           request;
+    };
+
+
+
+    /**
+     * Perform the vector updates of an iteration of the pipelined CG method
+     * and compute the scalar products for the next iteration. Generic
+     * implementation for arbitrary vector types, which uses the usual vector
+     * operations and blocking scalar products.
+     */
+    template <typename VectorType>
+    void
+    update_and_start_reductions(const double      alpha,
+                                const double      beta,
+                                const VectorType &m,
+                                const VectorType &n,
+                                VectorType &      x,
+                                VectorType &      r,
+                                VectorType &      u,
+                                VectorType &      w,
+                                VectorType &      z,
+                                VectorType &      q,
+                                VectorType &      s,
+                                VectorType &      p,
+                                Reductions &      reductions)
+    {
+      if (alpha != 0.)
+        {
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+
+          x.add(alpha, p);
+          r.add(-alpha, s);
+          u.add(-alpha, q);
+          w.add(-alpha, z);
+        }
+
+      reductions.values[0] = r * u;
+      reductions.values[1] = w * u;
+      reductions.values[2] = r * r;
+    }
+
+
+
+    /**
+     * Specialization of the function above for
+     * LinearAlgebra::distributed::Vector: All vector updates and the local
+     * parts of the scalar products are computed in a single sweep through
+     * the vectors, and the global sums are started with a non-blocking
+     * reduction that is completed by finish_reductions().
+     */
+    template <typename Number>
+    void
+    update_and_start_reductions(
+      const double                                                         alpha,
+      const double                                                         beta,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &m,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &n,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      x,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      r,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      u,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      w,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      z,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      q,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      s,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      p,
+      Reductions &reductions)
+    {
+      const unsigned int  local_size = x.local_size();
+      const Number *const m_ptr      = m.begin();
+      const Number *const n_ptr      = n.begin();
+      Number *const       x_ptr      = x.begin();
+      Number *const       r_ptr      = r.begin();
+      Number *const       u_ptr      = u.begin();
+      Number *const       w_ptr      = w.begin();
+      Number *const       z_ptr      = z.begin();
+      Number *const       q_ptr      = q.begin();
+      Number *const       s_ptr      = s.begin();
+      Number *const       p_ptr      = p.begin();
+
+      const Number a = alpha, b = beta;
+      Number       ru = 0., wu = 0., rr = 0.;
+      if (alpha != 0.)
+        {
+          for (unsigned int i = 0; i < local_size; ++i)
+            {
+              z_ptr[i] = n_ptr[i] + b * z_ptr[i];
+              q_ptr[i] = m_ptr[i] + b * q_ptr[i];
+              s_ptr[i] = w_ptr[i] + b * s_ptr[i];
+              p_ptr[i] = u_ptr[i] + b * p_ptr[i];
+              x_ptr[i] += a * p_ptr[i];
+              r_ptr[i] -= a * s_ptr[i];
+              u_ptr[i] -= a * q_ptr[i];
+              w_ptr[i] -= a * z_ptr[i];
+              ru += r_ptr[i] * u_ptr[i];
+              wu += w_ptr[i] * u_ptr[i];
+              rr += r_ptr[i] * r_ptr[i];
+            }
+        }
+      else
+        {
+          for (unsigned int i = 0; i < local_size; ++i)
+            {
+              ru += r_ptr[i] * u_ptr[i];
+              wu += w_ptr[i] * u_ptr[i];
+              rr += r_ptr[i] * r_ptr[i];
+            }
+        }
+
+      reductions.values[0] = ru;
+      reductions.values[1] = wu;
+      reductions.values[2] = rr;
+
+#ifdef DEAL_II_WITH_MPI
+      if (Utilities::MPI::job_supports_mpi() &&
+          Utilities::MPI::n_mpi_processes(x.get_mpi_communicator()) > 1)
+        {
+          const int ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                                          reductions.values.data(),
+                                          3,
+                                          MPI_DOUBLE,
+                                          MPI_SUM,
+                                          x.get_mpi_communicator(),
+                                          &reductions.request);
+          AssertThrowMPI(ierr);
+        }
+#endif
+    }
+
+
+
+    /**
+     * Wait for the reduction started by update_and_start_reductions() to
+     * complete.
+     */
+    inline void
+    finish_reductions(Reductions &reductions)
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (reductions.request != MPI_REQUEST_NULL)
+        {
+          const int ierr = MPI_Wait(&reductions.request, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#else
+      (void)reductions;
+#endif
+    }
+  } // namespace SolverPipelinedCGImplementation
+} // namespace internal
+
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * The pipelined preconditioned conjugate gradient method of P. Ghysels and
+ * W. Vanroose, "Hiding global synchronization latency in the preconditioned
+ * Conjugate Gradient algorithm", Parallel Computing 40 (2014), pp. 224-238.
+ *
+ * In exact arithmetic, this method computes the same iterates as SolverCG.
+ * However, it is reformulated with auxiliary vectors such that all three
+ * scalar products of an iteration, $(r,u)$, $(w,u)$, and $(r,r)$, are
+ * computed in a single global reduction, and this reduction can be overlapped
+ * with the application of the preconditioner and the matrix-vector product.
+ * This hides the latency of the global communication, which dominates the
+ * cost of the standard CG method at large scales, where each iteration
+ * involves two separate global reductions (plus one for the residual norm)
+ * that are each latency-bound.
+ *
+ * This comes at the cost of more vectors (nine instead of four) and more
+ * vector updates per iteration. For LinearAlgebra::distributed::Vector, the
+ * vector updates and the local parts of the scalar products are merged into
+ * a single sweep through the vectors, and the reduction is started with a
+ * non-blocking <code>MPI_Iallreduce</code> that is completed after the
+ * preconditioner and the matrix-vector product have been applied. For other
+ * vector types, the usual vector operations and blocking scalar products are
+ * used. Furthermore, the recurrences used to update the residual are known
+ * to be somewhat less stable than the ones of the classical method, so the
+ * attainable accuracy can be lower for very strict tolerances.
+ *
+ * The method is most useful for very large parallel runs with cheap
+ * matrix-vector products and preconditioners, where the latency of the
+ * reductions dominates. For smaller runs, SolverCG is usually faster.
+ *
+ * Like all other solver classes, this class has a local structure called
+ * @p AdditionalData which is used to pass additional parameters to the
+ * solver. This class does not need any additional parameters.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. This mechanism can also be used
+ * to observe the progress of the iteration.
+ */
+template <typename VectorType>
+class SolverPipelinedCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver. This
+   * solver does not need additional data.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl &           cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl &       cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &           cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData &)
+  : SolverBase<VectorType>(cn, mem)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &cn,
+                                                 const AdditionalData &)
+  : SolverBase<VectorType>(cn)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner)
+{
+  using namespace internal::SolverPipelinedCGImplementation;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("PipeCG");
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+
+  // define some aliases for simpler access, using the notation of the paper
+  // by Ghysels and Vanroose: r is the residual, u the preconditioned
+  // residual, w = A u, m = P w, n = A m, and z, q, s, p are the search
+  // directions corresponding to n, m, w, and u, respectively
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &z = *z_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &p = *p_pointer;
+
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  // the search directions are multiplied by beta=0 in the first iteration,
+  // so they must not contain invalid numbers
+  z.reinit(x);
+  q.reinit(x);
+  s.reinit(x);
+  p.reinit(x);
+
+  int    it  = 0;
+  double res = -std::numeric_limits<double>::max();
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  Reductions reductions;
+  update_and_start_reductions(0., 0., m, n, x, r, u, w, z, q, s, p, reductions);
+
+  double gamma_old = 0., alpha_old = 0.;
+  while (true)
+    {
+      // overlap the global reduction with the preconditioner and the
+      // matrix-vector product
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+
+      finish_reductions(reductions);
+      const double gamma = reductions.values[0];
+      const double delta = reductions.values[1];
+      res                = std::sqrt(std::abs(reductions.values[2]));
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      double alpha, beta;
+      if (it == 0)
+        {
+          beta = 0.;
+          Assert(delta != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+        }
+      else
+        {
+          Assert(gamma_old != 0. && alpha_old != 0., ExcDivideByZero());
+          beta = gamma / gamma_old;
+          Assert(delta - beta * gamma / alpha_old != 0., ExcDivideByZero());
+          alpha = gamma / (delta - beta * gamma / alpha_old);
+        }
+
+      update_and_start_reductions(
+        alpha, beta, m, n, x, r, u, w, z, q, s, p, reductions);
+
+      gamma_old = gamma;
+      alpha_old = alpha;
+      ++it;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
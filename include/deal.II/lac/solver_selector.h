@@ -21,7 +21,9 @@
 
 #include <deal.II/base/smartpointer.h>
 
+#include <deal.II/lac/ginkgo_solver.h>
 #include <deal.II/lac/precondition.h>
+#include <deal.II/lac/precondition_selector.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_bicgstab.h>
 #include <deal.II/lac/solver_cg.h>
@@ -84,6 +86,16 @@ DEAL_II_NAMESPACE_OPEN
  * the calling of this solver has to be added and each user with program lines
  * quoted above only needs to 'set solver = xyz' in their parameter file to get
  * access to that new solver.
+ *
+ * If deal.II is configured with Ginkgo, the solvers "ginkgo_cg",
+ * "ginkgo_bicgstab", "ginkgo_cgs", "ginkgo_fcg" and "ginkgo_gmres" solve the
+ * system with the respective solvers of the GinkgoWrappers namespace, on the
+ * executor given to set_ginkgo_executor(). They require the matrix to be a
+ * SparseMatrix and the vectors to be of type Vector, and they can be combined
+ * with PreconditionIdentity or with a PreconditionSelector that selects one
+ * of the Ginkgo preconditioners, e.g., "ginkgo_ilu". Since a new Ginkgo
+ * solver is set up for each call to solve(), the classes in GinkgoWrappers
+ * should be used directly if many systems with the same matrix are solved.
  */
 template <typename VectorType = Vector<double>>
 class SolverSelector : public Subscriptor
@@ -134,6 +146,13 @@ public:
   void
   set_control(SolverControl &ctrl);
 
+  /**
+   * Set the executor of the Ginkgo solvers, one of "reference", "omp" and
+   * "cuda". The default is "reference".
+   */
+  void
+  set_ginkgo_executor(const std::string &exec_type);
+
   /**
    * Set the additional data. For more information see the @p Solver class.
    */
@@ -181,6 +200,8 @@ public:
    * <li>  "fgmres" </li>
    * <li>  "minres" </li>
    * </ul>
+   * and, if deal.II is configured with Ginkgo, "ginkgo_cg",
+   * "ginkgo_bicgstab", "ginkgo_cgs", "ginkgo_fcg" and "ginkgo_gmres".
    */
   static std::string
   get_solver_names();
@@ -238,12 +259,136 @@ private:
    * Stores the additional data.
    */
   typename SolverFGMRES<VectorType>::AdditionalData fgmres_data;
+
+  /**
+   * The executor of the Ginkgo solvers.
+   */
+  std::string ginkgo_exec_type = "reference";
 };
 
 /*@}*/
 /* --------------------- Inline and template functions ------------------- */
 
 
+#ifndef DOXYGEN
+#  ifdef DEAL_II_WITH_GINKGO
+namespace internal
+{
+  namespace SolverSelectorImplementation
+  {
+    /**
+     * Return the name of the Ginkgo preconditioner selected by @p precond,
+     * as understood by GinkgoWrappers::create_preconditioner(). Only
+     * PreconditionIdentity and PreconditionSelector can be translated.
+     */
+    template <typename PreconditionerType>
+    std::string
+    ginkgo_preconditioner_name(const PreconditionerType &)
+    {
+      AssertThrow(false,
+                  ExcMessage("The Ginkgo solvers of SolverSelector can only be "
+                             "combined with PreconditionIdentity or with a "
+                             "PreconditionSelector."));
+      return "";
+    }
+
+
+
+    inline std::string
+    ginkgo_preconditioner_name(const PreconditionIdentity &)
+    {
+      return "none";
+    }
+
+
+
+    template <typename MatrixType, typename VectorType>
+    std::string
+    ginkgo_preconditioner_name(
+      const PreconditionSelector<MatrixType, VectorType> &precond)
+    {
+      const std::string &name = precond.get_preconditioning();
+      if (name == "none")
+        return name;
+
+      AssertThrow(name.compare(0, 7, "ginkgo_") == 0,
+                  ExcMessage("The Ginkgo solvers of SolverSelector can only be "
+                             "combined with the Ginkgo preconditioners of "
+                             "PreconditionSelector, but <" +
+                             name + "> was selected."));
+      return name.substr(7);
+    }
+
+
+
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    void
+    solve_with_ginkgo(const std::string &,
+                      const std::string &,
+                      const unsigned int,
+                      SolverControl &,
+                      const MatrixType &,
+                      VectorType &,
+                      const VectorType &,
+                      const PreconditionerType &)
+    {
+      AssertThrow(false,
+                  ExcMessage("The Ginkgo solvers of SolverSelector can only be "
+                             "used with SparseMatrix and Vector."));
+    }
+
+
+
+    template <typename Number, typename PreconditionerType>
+    void
+    solve_with_ginkgo(const std::string &         solver_name,
+                      const std::string &         exec_type,
+                      const unsigned int          gmres_restart,
+                      SolverControl &             control,
+                      const SparseMatrix<Number> &A,
+                      Vector<Number> &            x,
+                      const Vector<Number> &      b,
+                      const PreconditionerType &  precond)
+    {
+      const std::shared_ptr<gko::LinOpFactory> preconditioner =
+        GinkgoWrappers::create_preconditioner<Number>(
+          ginkgo_preconditioner_name(precond), exec_type);
+
+      std::unique_ptr<GinkgoWrappers::SolverBase<Number, int32_t>> solver;
+      if (solver_name == "cg")
+        solver = std::make_unique<GinkgoWrappers::SolverCG<Number>>(
+          control, exec_type, preconditioner);
+      else if (solver_name == "bicgstab")
+        solver = std::make_unique<GinkgoWrappers::SolverBicgstab<Number>>(
+          control, exec_type, preconditioner);
+      else if (solver_name == "cgs")
+        solver = std::make_unique<GinkgoWrappers::SolverCGS<Number>>(
+          control, exec_type, preconditioner);
+      else if (solver_name == "fcg")
+        solver = std::make_unique<GinkgoWrappers::SolverFCG<Number>>(
+          control, exec_type, preconditioner);
+      else if (solver_name == "gmres")
+        solver = std::make_unique<GinkgoWrappers::SolverGMRES<Number>>(
+          control,
+          exec_type,
+          preconditioner,
+          typename GinkgoWrappers::SolverGMRES<Number>::AdditionalData(
+            gmres_restart));
+      else
+        AssertThrow(false,
+                    ExcMessage("The Ginkgo solver <" + solver_name +
+                               "> is not known."));
+
+      solver->solve(A, x, b);
+    }
+  } // namespace SolverSelectorImplementation
+} // namespace internal
+#  endif
+#endif
+
+
 template <typename VectorType>
 SolverSelector<VectorType>::SolverSelector(const std::string &name,
                                            SolverControl &    solver_control)
@@ -300,6 +445,22 @@ SolverSelector<VectorType>::solve(const Matrix &        A,
       SolverFGMRES<VectorType> solver(*control, fgmres_data);
       solver.solve(A, x, b, precond);
     }
+#ifdef DEAL_II_WITH_GINKGO
+  else if (solver_name.compare(0, 7, "ginkgo_") == 0)
+    {
+      // The restart length of deal.II's GMRES is two less than the number of
+      // temporary vectors
+      internal::SolverSelectorImplementation::solve_with_ginkgo(
+        solver_name.substr(7),
+        ginkgo_exec_type,
+        gmres_data.max_n_tmp_vectors - 2,
+        *control,
+        A,
+        x,
+        b,
+        precond);
+    }
+#endif
   else
     Assert(false, ExcSolverDoesNotExist(solver_name));
 }
@@ -315,11 +476,25 @@ SolverSelector<VectorType>::set_control(SolverControl &ctrl)
 
 
 
+template <typename VectorType>
+void
+SolverSelector<VectorType>::set_ginkgo_executor(const std::string &exec_type)
+{
+  ginkgo_exec_type = exec_type;
+}
+
+
+
 template <typename VectorType>
 std::string
 SolverSelector<VectorType>::get_solver_names()
 {
+#ifdef DEAL_II_WITH_GINKGO
+  return "richardson|cg|bicgstab|gmres|fgmres|minres|"
+         "ginkgo_cg|ginkgo_bicgstab|ginkgo_cgs|ginkgo_fcg|ginkgo_gmres";
+#else
   return "richardson|cg|bicgstab|gmres|fgmres|minres";
+#endif
 }
 
 
@@ -18,6 +18,9 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
@@ -318,11 +321,58 @@ protected:
   std::vector<const size_type *> prebuilt_lower_bound;
 
   /**
-   * Fills the #prebuilt_lower_bound array.
+   * Fills the #prebuilt_lower_bound array, and computes the level structure
+   * of the forward and backward substitutions used by
+   * apply_to_rows_by_level().
    */
   void
   prebuild_lower_bound();
 
+  /**
+   * Call @p row_worker, a function object taking the index of a row as its
+   * only argument, for all rows of the matrix in an order that is valid for
+   * a forward substitution with the lower triangular part of the sparsity
+   * pattern (if @p forward is true) or a backward substitution with the
+   * upper triangular part (if @p forward is false). This means that the
+   * worker for a row is only called once the workers for all rows its
+   * triangular part refers to have finished.
+   *
+   * The rows are grouped into levels such that the rows in one level only
+   * depend on rows of previous levels, and the rows of each level are
+   * processed in parallel. This level structure is computed once by
+   * prebuild_lower_bound(). If the levels are too narrow for parallel
+   * execution to pay off, or only a single thread is available, the rows
+   * are processed one after the other in their natural order, which gives
+   * the same result.
+   */
+  template <typename RowWorker>
+  void
+  apply_to_rows_by_level(const bool forward, const RowWorker &row_worker) const;
+
+  /**
+   * The rows of the matrix sorted by their level in the forward
+   * substitution. The rows of level <code>l</code> are
+   * <code>forward_level_rows[forward_level_starts[l]]</code> up to
+   * <code>forward_level_rows[forward_level_starts[l+1]]</code>. Empty if
+   * the levels are too narrow for parallel execution.
+   */
+  std::vector<size_type> forward_level_rows;
+
+  /**
+   * The start of each level in #forward_level_rows.
+   */
+  std::vector<size_type> forward_level_starts;
+
+  /**
+   * Same as #forward_level_rows for the backward substitution.
+   */
+  std::vector<size_type> backward_level_rows;
+
+  /**
+   * The start of each level in #backward_level_rows.
+   */
+  std::vector<size_type> backward_level_starts;
+
 private:
   /**
    * In general this pointer is zero except for the case that no
@@ -352,6 +402,43 @@ SparseLUDecomposition<number>::get_strengthen_diagonal(
 
 
 
+template <typename number>
+template <typename RowWorker>
+inline void
+SparseLUDecomposition<number>::apply_to_rows_by_level(
+  const bool       forward,
+  const RowWorker &row_worker) const
+{
+  const std::vector<size_type> &level_rows =
+    forward ? forward_level_rows : backward_level_rows;
+  const std::vector<size_type> &level_starts =
+    forward ? forward_level_starts : backward_level_starts;
+
+  if (level_rows.empty() || MultithreadInfo::n_threads() == 1)
+    {
+      const size_type N = this->m();
+      if (forward)
+        for (size_type row = 0; row < N; ++row)
+          row_worker(row);
+      else
+        for (size_type row = N; row-- > 0;)
+          row_worker(row);
+      return;
+    }
+
+  for (unsigned int level = 0; level + 1 < level_starts.size(); ++level)
+    parallel::apply_to_subranges(
+      level_starts[level],
+      level_starts[level + 1],
+      [&](const size_type begin, const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          row_worker(level_rows[i]);
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
 template <typename number>
 inline bool
 SparseLUDecomposition<number>::empty() const
@@ -56,6 +56,10 @@ SparseLUDecomposition<number>::clear()
 {
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
+  forward_level_rows.clear();
+  forward_level_starts.clear();
+  backward_level_rows.clear();
+  backward_level_starts.clear();
 
   SparseMatrix<number>::clear();
 
@@ -133,6 +137,10 @@ SparseLUDecomposition<number>::initialize(
     std::vector<const size_type *> tmp;
     tmp.swap(prebuilt_lower_bound);
   }
+  forward_level_rows.clear();
+  forward_level_starts.clear();
+  backward_level_rows.clear();
+  backward_level_starts.clear();
   SparseMatrix<number>::reinit(*sparsity_pattern_to_use);
 }
 
@@ -157,6 +165,56 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
                                &column_numbers[rowstart_indices[row + 1]],
                                row);
     }
+
+  // compute the levels of the forward and backward substitutions: the level
+  // of a row is one more than the largest level of the rows it depends on.
+  // the rows are then sorted by their level with a counting sort
+  const auto compute_levels = [&](const bool              forward,
+                                  std::vector<size_type> &level_rows,
+                                  std::vector<size_type> &level_starts) {
+    std::vector<unsigned int> row_level(N, 0);
+    unsigned int              n_levels = 0;
+    for (size_type i = 0; i < N; ++i)
+      {
+        const size_type  row = forward ? i : N - 1 - i;
+        const size_type *begin =
+          forward ? &column_numbers[rowstart_indices[row] + 1] :
+                    prebuilt_lower_bound[row];
+        const size_type *end = forward ?
+                                 prebuilt_lower_bound[row] :
+                                 &column_numbers[rowstart_indices[row + 1]];
+        unsigned int level = 0;
+        for (const size_type *col = begin; col != end; ++col)
+          level = std::max(level, row_level[*col] + 1);
+        row_level[row] = level;
+        n_levels       = std::max(n_levels, level + 1);
+      }
+
+    level_rows.clear();
+    level_starts.clear();
+
+    // only keep the level structure if the levels are wide enough on
+    // average to be worth processing in parallel
+    if (N == 0 ||
+        N / n_levels <
+          4 * internal::SparseMatrixImplementation::minimum_parallel_grain_size)
+      return;
+
+    level_starts.resize(n_levels + 1, 0);
+    for (size_type row = 0; row < N; ++row)
+      ++level_starts[row_level[row] + 1];
+    for (unsigned int level = 0; level < n_levels; ++level)
+      level_starts[level + 1] += level_starts[level];
+
+    level_rows.resize(N);
+    std::vector<size_type> next_position(level_starts.begin(),
+                                         level_starts.end() - 1);
+    for (size_type row = 0; row < N; ++row)
+      level_rows[next_position[row_level[row]]++] = row;
+  };
+
+  compute_levels(true, forward_level_rows, forward_level_starts);
+  compute_levels(false, backward_level_rows, backward_level_starts);
 }
 
 template <typename number>
@@ -239,7 +297,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(forward_level_rows) +
+          MemoryConsumption::memory_consumption(forward_level_starts) +
+          MemoryConsumption::memory_consumption(backward_level_rows) +
+          MemoryConsumption::memory_consumption(backward_level_starts));
 }
 
 
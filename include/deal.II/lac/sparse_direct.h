@@ -130,9 +130,13 @@ public:
    * different matrices, after the object of this class has been initialized
    * for a certain sparsity pattern. You may therefore save some computing
    * time if you want to invert several matrices with the same sparsity
-   * pattern. However, note that the bulk of the computing time is actually
-   * spent in the factorization, so this functionality may not always be of
-   * large benefit.
+   * pattern: The symbolic part of the factorization (the fill-reducing
+   * ordering and the analysis of the elimination tree) only depends on the
+   * sparsity pattern. It is therefore kept when the function is called
+   * again for a matrix with the same sparsity pattern as the previous one,
+   * e.g., for the Jacobian matrices of a Newton iteration, and only the
+   * numeric factorization is recomputed. The bulk of the computing time is
+   * typically spent in the numeric factorization, though.
    *
    * In contrast to the other direct solver classes, the initialization method
    * does nothing. Therefore initialize is not automatically called by this
@@ -241,6 +245,16 @@ public:
   void
   solve(Vector<double> &rhs_and_solution, const bool transpose = false) const;
 
+  /**
+   * Like the previous function, but for several right hand sides, which
+   * are replaced by the respective solutions. Compared to calling the
+   * previous function for each of the vectors, the temporary memory needed
+   * by UMFPACK is allocated only once.
+   */
+  void
+  solve(std::vector<Vector<double>> &rhs_and_solution,
+        const bool                   transpose = false) const;
+
   /**
    * Like the previous function, but for a complex-valued right hand side
    * and solution vector.
@@ -383,6 +397,16 @@ private:
   void
   clear();
 
+  /**
+   * Compute the symbolic factorization from the arrays Ap and Ai for a
+   * real-valued or complex-valued matrix, respectively.
+   */
+  void
+  compute_symbolic_decomposition(std::false_type);
+
+  void
+  compute_symbolic_decomposition(std::true_type);
+
   /**
    * Make sure that the arrays Ai and Ap are sorted in each row. UMFPACK wants
    * it this way. We need to have three versions of this function, one for the
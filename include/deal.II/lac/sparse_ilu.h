@@ -41,6 +41,12 @@ DEAL_II_NAMESPACE_OPEN
  * given in the book Y. Saad: "Iterative methods for sparse linear systems",
  * second edition, in section 10.3.2.
  *
+ * The forward and backward substitutions in vmult() group the rows into
+ * levels of rows that do not depend on each other, computed once in
+ * initialize(), and process the rows of each level in parallel when
+ * multiple threads are available and the levels are wide enough. The result
+ * does not depend on the number of threads.
+ *
  *
  * <h3>Usage and state management</h3>
  *
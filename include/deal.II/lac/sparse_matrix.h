@@ -44,6 +44,8 @@ class FullMatrix;
 template <typename Matrix>
 class BlockMatrixBase;
 template <typename number>
+class BlockSparseMatrix;
+template <typename number>
 class SparseILU;
 #    ifdef DEAL_II_WITH_MPI
 namespace Utilities
@@ -738,6 +740,20 @@ public:
   const SparsityPattern &
   get_sparsity_pattern() const;
 
+  /**
+   * Return the minimal number of consecutive rows that the row-parallel
+   * operations of this class handle as one task. vmult(), vmult_add(),
+   * matrix_norm_square(), matrix_scalar_product(), residual(), and the
+   * zeroing of the entries in reinit() all split the rows [0,m()) with
+   * parallel::apply_to_subranges() and this grain size. User code that works
+   * on the rows of the matrix (or on vectors of matching size) in the same
+   * way gets a similar assignment of rows to threads, which matters on NUMA
+   * systems where memory is placed close to the thread that touches it
+   * first.
+   */
+  static unsigned int
+  get_parallel_grain_size();
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object. See MemoryConsumption.
@@ -1698,6 +1714,23 @@ protected:
   prepare_set();
 
 private:
+  /**
+   * Matrix-vector multiplication restricted to the rows
+   * [begin_row, end_row) of this matrix: Set
+   * <code>dst(i) = sum_j M(i,j) src(j)</code> for these rows, or add
+   * the sum to <code>dst(i)</code> if @p add is true. The other entries of
+   * @p dst are not touched, and no threads are spawned. This is used by
+   * BlockSparseMatrix::vmult() to accumulate the contributions of all blocks
+   * of a block row for a range of rows within one task.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_on_subrange(OutVector &     dst,
+                    const InVector &src,
+                    const size_type begin_row,
+                    const size_type end_row,
+                    const bool      add) const;
+
   /**
    * Pointer to the sparsity pattern used for this matrix. In order to
    * guarantee that it is not deleted while still in use, we subscribe to it
@@ -1734,6 +1767,10 @@ private:
   template <typename>
   friend class BlockMatrixBase;
 
+  // To allow it calling private vmult_on_subrange().
+  template <typename>
+  friend class BlockSparseMatrix;
+
   // Also give access to internal details to the iterator/accessor classes.
   template <typename, bool>
   friend class SparseMatrixIterators::Iterator;
@@ -196,27 +196,21 @@ SparseMatrix<number>::operator=(const double d)
   Assert(cols->compressed || cols->empty(),
          SparsityPattern::ExcNotCompressed());
 
-  // do initial zeroing of elements in parallel. Try to achieve a similar
-  // layout as when doing matrix-vector products, as on some NUMA systems, a
-  // memory block is assigned to memory banks where the first access is
-  // generated. For sparse matrices, the first operations is usually the
-  // operator=. The grain size is chosen to reflect the number of rows in
-  // minimum_parallel_grain_size, weighted by the number of nonzero entries
-  // per row on average.
+  // do initial zeroing of elements in parallel. Use the same layout as when
+  // doing matrix-vector products, i.e., split the rows into the chunks
+  // given by get_parallel_grain_size(), as on some NUMA systems, a memory
+  // block is assigned to memory banks where the first access is generated.
+  // For sparse matrices, the first operations is usually the operator=.
   const std::size_t matrix_size = cols->n_nonzero_elements();
-  const size_type   grain_size =
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size *
-    (cols->n_nonzero_elements() + m()) / m();
-  if (matrix_size > grain_size)
+  if (m() > get_parallel_grain_size())
     parallel::apply_to_subranges(
       0U,
-      matrix_size,
-      [this](const size_type begin, const size_type end) {
-        internal::SparseMatrixImplementation::zero_subrange(begin,
-                                                            end,
-                                                            val.get());
+      m(),
+      [this](const size_type begin_row, const size_type end_row) {
+        internal::SparseMatrixImplementation::zero_subrange(
+          cols->rowstart[begin_row], cols->rowstart[end_row], val.get());
       },
-      grain_size);
+      get_parallel_grain_size());
   else if (matrix_size > 0)
     {
 #ifdef DEAL_II_HAVE_CXX17
@@ -266,10 +260,12 @@ SparseMatrix<number>::reinit(const SparsityPattern &sparsity)
       return;
     }
 
+  // allocate the memory without initializing it. the zeroing below then
+  // first touches each row on a thread that later works on it in vmult()
   const std::size_t N = cols->n_nonzero_elements();
   if (N > max_len || max_len == 0)
     {
-      val     = std::make_unique<number[]>(N);
+      val.reset(new number[N]);
       max_len = N;
     }
 
@@ -289,6 +285,15 @@ SparseMatrix<number>::clear()
 
 
 
+template <typename number>
+unsigned int
+SparseMatrix<number>::get_parallel_grain_size()
+{
+  return internal::SparseMatrixImplementation::minimum_parallel_grain_size;
+}
+
+
+
 template <typename number>
 bool
 SparseMatrix<number>::empty() const
@@ -789,7 +794,37 @@ SparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
         dst,
         false);
     },
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+    get_parallel_grain_size());
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrix<number>::vmult_on_subrange(OutVector &     dst,
+                                        const InVector &src,
+                                        const size_type begin_row,
+                                        const size_type end_row,
+                                        const bool      add) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(begin_row <= end_row && end_row <= m(),
+         ExcIndexRange(end_row, begin_row, m() + 1));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  internal::SparseMatrixImplementation::vmult_on_subrange(begin_row,
+                                                          end_row,
+                                                          val.get(),
+                                                          cols->rowstart.get(),
+                                                          cols->colnums.get(),
+                                                          src,
+                                                          dst,
+                                                          add);
 }
 
 
@@ -847,7 +882,7 @@ SparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
         dst,
         true);
     },
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+    get_parallel_grain_size());
 }
 
 
@@ -935,7 +970,7 @@ SparseMatrix<number>::matrix_norm_square(const Vector<somenumber> &v) const
     },
     0,
     m(),
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+    get_parallel_grain_size());
 }
 
 
@@ -1004,7 +1039,7 @@ SparseMatrix<number>::matrix_scalar_product(const Vector<somenumber> &u,
     },
     0,
     m(),
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+    get_parallel_grain_size());
 }
 
 
@@ -1354,7 +1389,7 @@ SparseMatrix<number>::residual(Vector<somenumber> &      dst,
     },
     0,
     m(),
-    internal::SparseMatrixImplementation::minimum_parallel_grain_size));
+    get_parallel_grain_size()));
 }
 
 
@@ -0,0 +1,629 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/sparse_matrix.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix in the sliced ELLPACK format with row sorting, also known
+ * as SELL-C-$\sigma$ format, storing a copy of a SparseMatrix in a layout
+ * suitable for vectorized matrix-vector products.
+ *
+ * The rows of the matrix are grouped into chunks of $C$ consecutive rows,
+ * where $C$ is the width of VectorizedArray<Number>. Within each chunk, the
+ * entries are stored column-by-column, i.e., the $j$-th entry of all $C$
+ * rows of a chunk are placed next to each other in memory. The chunk is
+ * padded with zeros up to the length of its longest row. This way, the
+ * matrix-vector product processes $C$ rows at once with SIMD instructions,
+ * loading the matrix entries contiguously and gathering the entries of the
+ * source vector.
+ *
+ * In order to keep the padding small for matrices with rows of very
+ * different length, the rows are sorted by decreasing length within windows
+ * of $\sigma$ consecutive rows before they are grouped into chunks. The
+ * permutation is undone when writing the result, so the class acts on vectors
+ * in the original numbering. A small $\sigma$ keeps the access to the
+ * destination vector local, whereas a large $\sigma$ minimizes the padding.
+ * With $\sigma=1$, the format reduces to the plain sliced ELLPACK format.
+ *
+ * The chunks are distributed among threads by parallel::apply_to_subranges()
+ * in vmult() and residual(). Since the chunks have roughly balanced work
+ * after sorting, this gives better load balance than splitting by rows for
+ * matrices with very different row lengths.
+ *
+ * The class provides the functions vmult(), Tvmult(), vmult_add(),
+ * Tvmult_add(), and residual() for vectors with the same number type as the
+ * matrix, and can hence be used as the matrix type in the iterative solvers
+ * such as SolverCG or SolverGMRES. After setting up, the matrix is
+ * independent of the SparseMatrix it was created from, i.e., changes to the
+ * latter are not reflected in this object unless reinit() is called again.
+ *
+ * @tparam Number The number type of the matrix entries, float or double.
+ */
+template <typename Number>
+class SparseMatrixSELL : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = Number;
+
+  /**
+   * The number of rows in each chunk, given by the width of the SIMD data
+   * type.
+   */
+  static constexpr unsigned int chunk_size = VectorizedArray<Number>::size();
+
+  /**
+   * Constructor. Creates an empty matrix.
+   */
+  SparseMatrixSELL();
+
+  /**
+   * Constructor. Copies the entries of the given matrix, see reinit().
+   */
+  template <typename Number2>
+  explicit SparseMatrixSELL(const SparseMatrix<Number2> &matrix,
+                            const unsigned int           sorting_scope = 0);
+
+  /**
+   * Copy the entries of the given sparse matrix into this object. The
+   * argument @p sorting_scope specifies the number $\sigma$ of consecutive
+   * rows within which the rows are sorted by their length. It must be either
+   * zero, in which case a default of 32 chunks (i.e., 32 times chunk_size
+   * rows) is selected, or a multiple of chunk_size.
+   */
+  template <typename Number2>
+  void
+  reinit(const SparseMatrix<Number2> &matrix,
+         const unsigned int           sorting_scope = 0);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of actually nonzero elements of the matrix, i.e.,
+   * without the entries added for padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of entries stored by this class including the padding,
+   * i.e., the sum of the length of the longest row times chunk_size over all
+   * chunks.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix.
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix. This function does the same as vmult() but takes the transposed
+   * matrix. Since different rows of the matrix write into the same entries of
+   * the result, this function is not parallelized.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add $M*src$ on $dst$ with $M$ being
+   * this matrix.
+   */
+  template <typename VectorType>
+  void
+  vmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add $M^T*src$ to $dst$ with $M$
+   * being this matrix. This function does the same as vmult_add() but takes
+   * the transposed matrix.
+   */
+  template <typename VectorType>
+  void
+  Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Compute the residual of an equation <i>Mx=b</i>, where the residual is
+   * defined to be <i>r=b-Mx</i>. Write the residual into <tt>dst</tt>. The
+   * <i>l<sub>2</sub></i> norm of the residual vector is returned.
+   *
+   * Source <i>x</i> and destination <i>dst</i> must not be the same vector.
+   */
+  template <typename VectorType>
+  typename VectorType::value_type
+  residual(VectorType &      dst,
+           const VectorType &x,
+           const VectorType &b) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Run the matrix-vector product on the given range of chunks. Depending on
+   * the template argument, the result is either written to @p dst, added to
+   * it, or subtracted from @p rhs and written to @p dst, in which case the
+   * sum of squares of the result is returned.
+   */
+  template <int operation>
+  Number
+  apply_to_chunk_range(const unsigned int begin,
+                       const unsigned int end,
+                       const Number *     src,
+                       const Number *     rhs,
+                       Number *           dst) const;
+
+  /**
+   * Number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * Number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * Number of nonzero entries of the original matrix.
+   */
+  std::size_t n_nonzero;
+
+  /**
+   * The position of the first entry of each chunk in the arrays @p values
+   * and @p column_indices, counted in units of chunk_size entries. The
+   * length of chunk @p c is <tt>chunk_starts[c+1]-chunk_starts[c]</tt>.
+   */
+  std::vector<std::size_t> chunk_starts;
+
+  /**
+   * The matrix entries of all chunks, where each VectorizedArray holds the
+   * entries of chunk_size rows with the same position within the row.
+   */
+  AlignedVector<VectorizedArray<Number>> values;
+
+  /**
+   * The column indices of the entries in @p values, with chunk_size entries
+   * for each entry of @p values. Padded entries point to column zero with a
+   * zero value.
+   */
+  std::vector<unsigned int> column_indices;
+
+  /**
+   * The original index of the row stored in lane @p v of chunk @p c at
+   * position <tt>c*chunk_size+v</tt>. Lanes beyond the last row are marked
+   * by numbers::invalid_unsigned_int.
+   */
+  std::vector<unsigned int> row_indices;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename Number>
+inline SparseMatrixSELL<Number>::SparseMatrixSELL()
+  : n_rows(0)
+  , n_cols(0)
+  , n_nonzero(0)
+{}
+
+
+
+template <typename Number>
+template <typename Number2>
+inline SparseMatrixSELL<Number>::SparseMatrixSELL(
+  const SparseMatrix<Number2> &matrix,
+  const unsigned int           sorting_scope)
+  : SparseMatrixSELL()
+{
+  reinit(matrix, sorting_scope);
+}
+
+
+
+template <typename Number>
+template <typename Number2>
+inline void
+SparseMatrixSELL<Number>::reinit(const SparseMatrix<Number2> &matrix,
+                                 const unsigned int           sorting_scope)
+{
+  const unsigned int sigma =
+    sorting_scope == 0 ? 32 * chunk_size : sorting_scope;
+  Assert(sigma % chunk_size == 0,
+         ExcMessage("The sorting scope must be a multiple of the chunk size " +
+                    std::to_string(chunk_size)));
+  AssertThrow(matrix.m() < std::numeric_limits<unsigned int>::max() &&
+                matrix.n() < std::numeric_limits<unsigned int>::max(),
+              ExcMessage("SparseMatrixSELL only supports matrices with less "
+                         "than 2^32 rows and columns."));
+
+  clear();
+  n_rows    = matrix.m();
+  n_cols    = matrix.n();
+  n_nonzero = 0;
+
+  // sort the rows by decreasing length within windows of sigma rows; the
+  // sort is stable so that rows of equal length keep their natural order
+  const unsigned int n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+  row_indices.resize(n_chunks * chunk_size, numbers::invalid_unsigned_int);
+  std::iota(row_indices.begin(),
+            row_indices.begin() + n_rows,
+            static_cast<unsigned int>(0));
+  std::vector<unsigned int> row_lengths(n_rows);
+  for (unsigned int row = 0; row < n_rows; ++row)
+    row_lengths[row] = matrix.get_row_length(row);
+  for (unsigned int start = 0; start < n_rows; start += sigma)
+    std::stable_sort(row_indices.begin() + start,
+                     row_indices.begin() +
+                       std::min<std::size_t>(start + sigma, n_rows),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return row_lengths[a] > row_lengths[b];
+                     });
+
+  chunk_starts.resize(n_chunks + 1);
+  chunk_starts[0] = 0;
+  for (unsigned int c = 0; c < n_chunks; ++c)
+    {
+      unsigned int max_length = 0;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        if (row_indices[c * chunk_size + v] != numbers::invalid_unsigned_int)
+          max_length =
+            std::max(max_length, row_lengths[row_indices[c * chunk_size + v]]);
+      chunk_starts[c + 1] = chunk_starts[c] + max_length;
+    }
+
+  // fill the entries chunk by chunk, padding with zeros
+  values.resize_fast(chunk_starts.back());
+  column_indices.resize(chunk_starts.back() * chunk_size, 0);
+  for (unsigned int c = 0; c < n_chunks; ++c)
+    {
+      for (std::size_t j = chunk_starts[c]; j < chunk_starts[c + 1]; ++j)
+        values[j] = Number();
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const unsigned int row = row_indices[c * chunk_size + v];
+          if (row == numbers::invalid_unsigned_int)
+            continue;
+          std::size_t j = chunk_starts[c];
+          for (auto entry = matrix.begin(row); entry != matrix.end(row);
+               ++entry, ++j)
+            {
+              values[j][v]                     = entry->value();
+              column_indices[j * chunk_size + v] = entry->column();
+            }
+          n_nonzero += row_lengths[row];
+        }
+    }
+}
+
+
+
+template <typename Number>
+inline void
+SparseMatrixSELL<Number>::clear()
+{
+  n_rows    = 0;
+  n_cols    = 0;
+  n_nonzero = 0;
+  chunk_starts.clear();
+  values.clear();
+  column_indices.clear();
+  row_indices.clear();
+}
+
+
+
+template <typename Number>
+inline typename SparseMatrixSELL<Number>::size_type
+SparseMatrixSELL<Number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline typename SparseMatrixSELL<Number>::size_type
+SparseMatrixSELL<Number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename Number>
+inline std::size_t
+SparseMatrixSELL<Number>::n_nonzero_elements() const
+{
+  return n_nonzero;
+}
+
+
+
+template <typename Number>
+inline std::size_t
+SparseMatrixSELL<Number>::n_stored_elements() const
+{
+  return values.size() * chunk_size;
+}
+
+
+
+template <typename Number>
+template <int operation>
+inline Number
+SparseMatrixSELL<Number>::apply_to_chunk_range(const unsigned int begin,
+                                               const unsigned int end,
+                                               const Number *     src,
+                                               const Number *     rhs,
+                                               Number *           dst) const
+{
+  Number norm_sqr = 0;
+  for (unsigned int c = begin; c < end; ++c)
+    {
+      VectorizedArray<Number> sum = Number();
+      for (std::size_t j = chunk_starts[c]; j < chunk_starts[c + 1]; ++j)
+        {
+          VectorizedArray<Number> x;
+          x.gather(src, column_indices.data() + j * chunk_size);
+          sum += values[j] * x;
+        }
+
+      const unsigned int *rows = row_indices.data() + c * chunk_size;
+      if (rows[chunk_size - 1] != numbers::invalid_unsigned_int)
+        {
+          // full chunk
+          if (operation == 0)
+            sum.scatter(rows, dst);
+          else if (operation == 1)
+            {
+              VectorizedArray<Number> old;
+              old.gather(dst, rows);
+              (old + sum).scatter(rows, dst);
+            }
+          else
+            {
+              VectorizedArray<Number> b;
+              b.gather(rhs, rows);
+              b -= sum;
+              b.scatter(rows, dst);
+              for (unsigned int v = 0; v < chunk_size; ++v)
+                norm_sqr += b[v] * b[v];
+            }
+        }
+      else
+        // last chunk with fewer rows than lanes
+        for (unsigned int v = 0; v < chunk_size; ++v)
+          if (rows[v] != numbers::invalid_unsigned_int)
+            {
+              if (operation == 0)
+                dst[rows[v]] = sum[v];
+              else if (operation == 1)
+                dst[rows[v]] += sum[v];
+              else
+                {
+                  dst[rows[v]] = rhs[rows[v]] - sum[v];
+                  norm_sqr += dst[rows[v]] * dst[rows[v]];
+                }
+            }
+    }
+  return norm_sqr;
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<Number>::vmult(VectorType &dst, const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, Number>::value,
+                "The vector must have the same number type as the matrix");
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_starts.size() - 1),
+    [&](const unsigned int begin, const unsigned int end) {
+      apply_to_chunk_range<0>(begin, end, src.begin(), nullptr, dst.begin());
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      chunk_size);
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<Number>::vmult_add(VectorType &      dst,
+                                    const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, Number>::value,
+                "The vector must have the same number type as the matrix");
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_starts.size() - 1),
+    [&](const unsigned int begin, const unsigned int end) {
+      apply_to_chunk_range<1>(begin, end, src.begin(), nullptr, dst.begin());
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      chunk_size);
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<Number>::Tvmult(VectorType &dst, const VectorType &src) const
+{
+  dst = Number();
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<Number>::Tvmult_add(VectorType &      dst,
+                                     const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, Number>::value,
+                "The vector must have the same number type as the matrix");
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), m());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  const Number *src_ptr = src.begin();
+  Number *      dst_ptr = dst.begin();
+  for (unsigned int c = 0; c + 1 < chunk_starts.size(); ++c)
+    {
+      const unsigned int *    rows = row_indices.data() + c * chunk_size;
+      VectorizedArray<Number> x    = Number();
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        if (rows[v] != numbers::invalid_unsigned_int)
+          x[v] = src_ptr[rows[v]];
+
+      // several lanes might refer to the same column, so the entries must be
+      // added one at a time
+      for (std::size_t j = chunk_starts[c]; j < chunk_starts[c + 1]; ++j)
+        {
+          const VectorizedArray<Number> product = values[j] * x;
+          const unsigned int *columns = column_indices.data() + j * chunk_size;
+          for (unsigned int v = 0; v < chunk_size; ++v)
+            dst_ptr[columns[v]] += product[v];
+        }
+    }
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+inline typename VectorType::value_type
+SparseMatrixSELL<Number>::residual(VectorType &      dst,
+                                   const VectorType &x,
+                                   const VectorType &b) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, Number>::value,
+                "The vector must have the same number type as the matrix");
+  AssertDimension(dst.size(), m());
+  AssertDimension(x.size(), n());
+  AssertDimension(b.size(), m());
+  Assert(&x != &dst, ExcSourceEqualsDestination());
+
+  const Number norm_sqr = parallel::accumulate_from_subranges<Number>(
+    [&](const unsigned int begin, const unsigned int end) {
+      return apply_to_chunk_range<2>(
+        begin, end, x.begin(), b.begin(), dst.begin());
+    },
+    0U,
+    static_cast<unsigned int>(chunk_starts.size() - 1),
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      chunk_size);
+
+  return std::sqrt(norm_sqr);
+}
+
+
+
+template <typename Number>
+inline std::size_t
+SparseMatrixSELL<Number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(chunk_starts) +
+         MemoryConsumption::memory_consumption(values) +
+         MemoryConsumption::memory_consumption(column_indices) +
+         MemoryConsumption::memory_consumption(row_indices);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -40,6 +40,9 @@ DEAL_II_NAMESPACE_OPEN
  * lower triangular matrix. The MIC(0) decomposition of the matrix $A$ is
  * defined by $B = (X-L)X^{-1}(X-L^T)$, where $X$ is a diagonal matrix defined
  * by the condition $\text{rowsum}(A) = \text{rowsum}(B)$.
+ *
+ * As for SparseILU, the triangular solves in vmult() process independent
+ * rows in parallel, using a level structure computed in initialize().
  */
 template <typename number>
 class SparseMIC : public SparseLUDecomposition<number>
@@ -20,12 +20,18 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/lapack_full_matrix.h>
 
 #include <deal.II/matrix_free/tensor_product_kernels.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
@@ -150,6 +156,14 @@ protected:
   std::array<Table<2, Number>, dim> eigenvectors;
 
 private:
+  /**
+   * Return whether the 1D matrices have different sizes in different
+   * tensor directions, in which case vmult() and apply_inverse() cannot use
+   * the evaluator with a single size for all directions.
+   */
+  bool
+  sizes_are_anisotropic() const;
+
   /**
    * An array for temporary data.
    */
@@ -210,6 +224,13 @@ private:
  *
  * This class requires LAPACK support.
  *
+ * The 1D matrices may have different sizes in different tensor directions,
+ * as is, e.g., the case for patches in overlapping Schwarz methods at the
+ * boundary. In that case, the template parameter <tt>n_rows_1d</tt> must be
+ * -1 and a slower code path for vmult() and apply_inverse() is selected. The
+ * eigendecomposition is computed only once for directions with identical 1D
+ * matrices.
+ *
  * Note that this class allows for two modes of usage. The first is a use case
  * with run time constants for the matrix dimensions that is achieved by
  * setting the optional template parameter <tt>n_rows_1d</tt> to -1. The second
@@ -224,9 +245,9 @@ private:
  * underlying LAPACK implementation supports only float and double numbers, so
  * only these two types are currently supported by the generic class.
  * Nevertheless, a template specialization for the vectorized types
- * VectorizedArray<float> and VectorizedArray<double> exists. This is necessary
- * to perform LAPACK calculations for each vectorization lane, i.e. for the
- * supported float and double numbers.
+ * VectorizedArray<float> and VectorizedArray<double> exists. It computes the
+ * eigendecompositions of all vectorization lanes at once by a Jacobi method
+ * operating on VectorizedArray, rather than calling LAPACK lane by lane.
  *
  * @tparam n_rows_1d Compile-time number of rows of 1D matrices (only
  * valid if the number of rows and columns coincide for each
@@ -452,6 +473,264 @@ namespace internal
       for (unsigned int i = 0; i < n_rows; ++i, ++eigenvalues)
         *eigenvalues = deriv_copy.eigenvalue(i).real();
     }
+
+
+
+    /**
+     * Return whether the two matrices @p a and @p b have the same size and
+     * the same entries, as determined by a bitwise comparison. This is used
+     * to avoid duplicate eigendecompositions for tensor directions with the
+     * same 1D matrices.
+     */
+    template <typename Number>
+    inline bool
+    matrices_are_equal(const Table<2, Number> &a, const Table<2, Number> &b)
+    {
+      if (a.n_rows() != b.n_rows() || a.n_cols() != b.n_cols())
+        return false;
+      if (a.n_elements() == 0)
+        return true;
+      return std::memcmp(&a(0, 0),
+                         &b(0, 0),
+                         a.n_elements() * sizeof(Number)) == 0;
+    }
+
+
+
+    /**
+     * Compute the generalized eigenvalues and eigenvectors of the real
+     * generalized symmetric eigenproblem $A v = \lambda M v$ for all lanes
+     * of a VectorizedArray at once. Instead of calling LAPACK for each lane,
+     * the problem is reduced to a standard eigenproblem by a Cholesky
+     * factorization $M = L L^\mathrm{T}$, which is then solved by the
+     * cyclic Jacobi method. All arithmetic operations are done on
+     * VectorizedArray; only the rotation parameters are computed lane by
+     * lane, as they involve case distinctions. Like the LAPACK variant, the
+     * eigenvectors are normalized such that $S^\mathrm{T} M S = I$ and the
+     * eigenvalues are sorted in ascending order in each lane.
+     */
+    template <typename Number>
+    void
+    spectral_assembly_vectorized(
+      const Table<2, VectorizedArray<Number>> &mass_matrix,
+      const Table<2, VectorizedArray<Number>> &derivative_matrix,
+      AlignedVector<VectorizedArray<Number>> & eigenvalues,
+      Table<2, VectorizedArray<Number>> &      eigenvectors)
+    {
+      using VectorizedArrayType      = VectorizedArray<Number>;
+      constexpr unsigned int n_lanes = VectorizedArrayType::size();
+      const unsigned int     n       = mass_matrix.n_rows();
+      const Number           rotation_tolerance =
+        std::numeric_limits<Number>::epsilon() * Number(1e-2);
+
+      // Cholesky factorization of the mass matrix, storing the lower
+      // triangular factor L
+      Table<2, VectorizedArrayType> L(n, n);
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          VectorizedArrayType diagonal = mass_matrix(j, j);
+          for (unsigned int k = 0; k < j; ++k)
+            diagonal -= L(j, k) * L(j, k);
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            Assert(diagonal[v] > Number(),
+                   ExcMessage("The mass matrix must be positive definite."));
+          L(j, j)                          = std::sqrt(diagonal);
+          const VectorizedArrayType inv_jj = Number(1.) / L(j, j);
+          for (unsigned int i = j + 1; i < n; ++i)
+            {
+              VectorizedArrayType sum = mass_matrix(i, j);
+              for (unsigned int k = 0; k < j; ++k)
+                sum -= L(i, k) * L(j, k);
+              L(i, j) = sum * inv_jj;
+            }
+        }
+
+      // transform to the standard eigenproblem C = L^{-1} A L^{-T}, first
+      // computing X = L^{-1} A and then C = L^{-1} X^T by forward
+      // substitution
+      Table<2, VectorizedArrayType> X(n, n);
+      Table<2, VectorizedArrayType> C(n, n);
+      for (unsigned int c = 0; c < n; ++c)
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            VectorizedArrayType sum = derivative_matrix(i, c);
+            for (unsigned int k = 0; k < i; ++k)
+              sum -= L(i, k) * X(k, c);
+            X(i, c) = sum / L(i, i);
+          }
+      for (unsigned int c = 0; c < n; ++c)
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            VectorizedArrayType sum = X(c, i);
+            for (unsigned int k = 0; k < i; ++k)
+              sum -= L(i, k) * C(k, c);
+            C(i, c) = sum / L(i, i);
+          }
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = i + 1; j < n; ++j)
+          {
+            const VectorizedArrayType average =
+              Number(0.5) * (C(i, j) + C(j, i));
+            C(i, j) = average;
+            C(j, i) = average;
+          }
+
+      // cyclic Jacobi method on C, accumulating the rotations in V. The
+      // off-diagonal entries are set to zero exactly when rotated away or
+      // when they are negligible compared to the diagonal, so the iteration
+      // terminates once all of them are zero in all lanes
+      Table<2, VectorizedArrayType> V(n, n);
+      for (unsigned int i = 0; i < n; ++i)
+        V(i, i) = Number(1.);
+      for (unsigned int sweep = 0; sweep < 50; ++sweep)
+        {
+          bool converged = true;
+          for (unsigned int p = 0; p < n && converged; ++p)
+            for (unsigned int q = p + 1; q < n && converged; ++q)
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                if (C(p, q)[v] != Number())
+                  {
+                    converged = false;
+                    break;
+                  }
+          if (converged)
+            break;
+
+          for (unsigned int p = 0; p < n; ++p)
+            for (unsigned int q = p + 1; q < n; ++q)
+              {
+                VectorizedArrayType c, s, t;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    const Number a_pq = C(p, q)[v];
+                    const Number a_pp = C(p, p)[v];
+                    const Number a_qq = C(q, q)[v];
+                    if (std::abs(a_pq) <=
+                        rotation_tolerance *
+                          (std::abs(a_pp) + std::abs(a_qq)))
+                      {
+                        c[v] = Number(1.);
+                        s[v] = Number();
+                        t[v] = Number();
+                      }
+                    else
+                      {
+                        const Number theta =
+                          (a_qq - a_pp) / (Number(2.) * a_pq);
+                        Number       tan =
+                          Number(1.) / (std::abs(theta) +
+                                        std::sqrt(theta * theta + Number(1.)));
+                        if (theta < Number())
+                          tan = -tan;
+                        t[v] = tan;
+                        c[v] = Number(1.) / std::sqrt(tan * tan + Number(1.));
+                        s[v] = tan * c[v];
+                      }
+                  }
+
+                const VectorizedArrayType a_pq = C(p, q);
+                C(p, p) -= t * a_pq;
+                C(q, q) += t * a_pq;
+                C(p, q) = VectorizedArrayType();
+                C(q, p) = VectorizedArrayType();
+                for (unsigned int r = 0; r < n; ++r)
+                  if (r != p && r != q)
+                    {
+                      const VectorizedArrayType a_rp = C(r, p);
+                      const VectorizedArrayType a_rq = C(r, q);
+                      C(r, p) = C(p, r) = c * a_rp - s * a_rq;
+                      C(r, q) = C(q, r) = s * a_rp + c * a_rq;
+                    }
+                for (unsigned int r = 0; r < n; ++r)
+                  {
+                    const VectorizedArrayType v_rp = V(r, p);
+                    const VectorizedArrayType v_rq = V(r, q);
+                    V(r, p)                        = c * v_rp - s * v_rq;
+                    V(r, q)                        = s * v_rp + c * v_rq;
+                  }
+              }
+        }
+
+      // back-transformation of the eigenvectors, S = L^{-T} V, stored in X
+      for (unsigned int c = 0; c < n; ++c)
+        for (unsigned int i = n; i-- > 0;)
+          {
+            VectorizedArrayType sum = V(i, c);
+            for (unsigned int k = i + 1; k < n; ++k)
+              sum -= L(k, i) * X(k, c);
+            X(i, c) = sum / L(i, i);
+          }
+
+      // sort the eigenpairs by ascending eigenvalues in each lane
+      eigenvalues.resize(n);
+      eigenvectors.reinit(n, n);
+      std::vector<unsigned int> permutation(n);
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          for (unsigned int i = 0; i < n; ++i)
+            permutation[i] = i;
+          std::sort(permutation.begin(),
+                    permutation.end(),
+                    [&](const unsigned int a, const unsigned int b) {
+                      return C(a, a)[v] < C(b, b)[v];
+                    });
+          for (unsigned int j = 0; j < n; ++j)
+            {
+              eigenvalues[j][v] = C(permutation[j], permutation[j])[v];
+              for (unsigned int i = 0; i < n; ++i)
+                eigenvectors(i, j)[v] = X(i, permutation[j])[v];
+            }
+        }
+    }
+
+
+
+    /**
+     * Multiply the square 1D matrix @p matrix (stored row by row) or its
+     * transpose, depending on @p transpose, with the tensor @p src along the
+     * given @p direction and write the result into @p dst, or add it to
+     * @p dst if @p add is true. Unlike EvaluatorTensorProduct, the tensor
+     * may have a different number of entries @p n_rows[d] in each direction
+     * $d$, with the index in direction 0 running fastest. @p src and @p dst
+     * must not overlap.
+     */
+    template <int dim, typename Number>
+    inline void
+    apply_anisotropic(const Number *                         matrix,
+                      const std::array<unsigned int, dim> &n_rows,
+                      const unsigned int                     direction,
+                      const bool                             transpose,
+                      const bool                             add,
+                      const Number *                         src,
+                      Number *                               dst)
+    {
+      AssertIndexRange(direction, dim);
+      const unsigned int n = n_rows[direction];
+      unsigned int       stride = 1, n_blocks = 1;
+      for (unsigned int d = 0; d < direction; ++d)
+        stride *= n_rows[d];
+      for (unsigned int d = direction + 1; d < dim; ++d)
+        n_blocks *= n_rows[d];
+
+      for (unsigned int i2 = 0; i2 < n_blocks; ++i2)
+        for (unsigned int i1 = 0; i1 < stride; ++i1)
+          {
+            const Number *in  = src + i2 * stride * n + i1;
+            Number *      out = dst + i2 * stride * n + i1;
+            for (unsigned int i = 0; i < n; ++i)
+              {
+                Number result = Number();
+                for (unsigned int j = 0; j < n; ++j)
+                  result +=
+                    (transpose ? matrix[j * n + i] : matrix[i * n + j]) *
+                    in[stride * j];
+                if (add)
+                  out[stride * i] += result;
+                else
+                  out[stride * i] = result;
+              }
+          }
+    }
   } // namespace TensorProductMatrix
 } // namespace internal
 
@@ -480,6 +759,19 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::n() const
 
 
 
+template <int dim, typename Number, int n_rows_1d>
+inline bool
+TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::
+  sizes_are_anisotropic() const
+{
+  for (unsigned int d = 1; d < dim; ++d)
+    if (mass_matrix[d].n_rows() != mass_matrix[0].n_rows())
+      return true;
+  return false;
+}
+
+
+
 template <int dim, typename Number, int n_rows_1d>
 inline void
 TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
@@ -489,7 +781,36 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
   AssertDimension(dst_view.size(), this->m());
   AssertDimension(src_view.size(), this->n());
   std::lock_guard<std::mutex> lock(this->mutex);
-  const unsigned int          n = Utilities::fixed_power<dim>(
+
+  // patches with a different number of unknowns per direction cannot use
+  // the evaluator with a single size, so apply the sum of Kronecker
+  // products term by term
+  if (n_rows_1d == -1 && sizes_are_anisotropic())
+    {
+      std::array<unsigned int, dim> n_rows;
+      for (unsigned int d = 0; d < dim; ++d)
+        n_rows[d] = mass_matrix[d].n_rows();
+      const unsigned int n_total = dst_view.size();
+      tmp_array.resize_fast(n_total * 2);
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const Number *in = src_view.data();
+          for (unsigned int e = 0; e < dim; ++e)
+            {
+              const Number *matrix =
+                e == d ? &derivative_matrix[e](0, 0) : &mass_matrix[e](0, 0);
+              Number *out = e + 1 == dim ?
+                              dst_view.data() :
+                              tmp_array.begin() + (e % 2) * n_total;
+              internal::TensorProductMatrix::apply_anisotropic<dim>(
+                matrix, n_rows, e, false, e + 1 == dim && d > 0, in, out);
+              in = out;
+            }
+        }
+      return;
+    }
+
+  const unsigned int n = Utilities::fixed_power<dim>(
     n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size());
   tmp_array.resize_fast(n * 2);
   constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
@@ -557,6 +878,55 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
   AssertDimension(dst_view.size(), this->n());
   AssertDimension(src_view.size(), this->m());
   std::lock_guard<std::mutex> lock(this->mutex);
+
+  if (n_rows_1d == -1 && sizes_are_anisotropic())
+    {
+      std::array<unsigned int, dim> n_rows;
+      for (unsigned int d = 0; d < dim; ++d)
+        n_rows[d] = eigenvalues[d].size();
+      const unsigned int n_total = dst_view.size();
+      tmp_array.resize_fast(n_total * 2);
+      Number *buffers[2] = {tmp_array.begin(), tmp_array.begin() + n_total};
+
+      // transform into the eigenbasis, S^T src, in each direction
+      const Number *in = src_view.data();
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          internal::TensorProductMatrix::apply_anisotropic<dim>(
+            &eigenvectors[d](0, 0), n_rows, d, true, false, in, buffers[d % 2]);
+          in = buffers[d % 2];
+        }
+
+      // divide by the sum of the eigenvalues, with the index in direction 0
+      // running fastest
+      Number *                      t = buffers[(dim - 1) % 2];
+      std::array<unsigned int, dim> index{};
+      for (unsigned int c = 0; c < n_total; ++c)
+        {
+          Number sum_of_eigenvalues = eigenvalues[0][index[0]];
+          for (unsigned int d = 1; d < dim; ++d)
+            sum_of_eigenvalues += eigenvalues[d][index[d]];
+          t[c] /= sum_of_eigenvalues;
+          for (unsigned int d = 0; d < dim; ++d)
+            if (++index[d] < n_rows[d])
+              break;
+            else
+              index[d] = 0;
+        }
+
+      // transform back, S (...), in each direction
+      in = t;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          Number *out =
+            d + 1 == dim ? dst_view.data() : buffers[(dim + d) % 2];
+          internal::TensorProductMatrix::apply_anisotropic<dim>(
+            &eigenvectors[d](0, 0), n_rows, d, false, false, in, out);
+          in = out;
+        }
+      return;
+    }
+
   const unsigned int n = n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size();
   tmp_array.resize_fast(Utilities::fixed_power<dim>(n));
   constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
@@ -682,6 +1052,23 @@ TensorProductMatrixSymmetricSum<dim, Number, n_rows_1d>::reinit_impl(
       AssertDimension(mass_matrices[dir].n_rows(),
                       derivative_matrices[dir].n_cols());
 
+      // the eigendecomposition only depends on the 1D matrices, so reuse the
+      // one of a previous direction with the same matrices, as, e.g., when
+      // called with a single pair of matrices for all directions
+      bool found_equal_direction = false;
+      for (int d = 0; d < dir && !found_equal_direction; ++d)
+        if (internal::TensorProductMatrix::matrices_are_equal(
+              this->mass_matrix[d], this->mass_matrix[dir]) &&
+            internal::TensorProductMatrix::matrices_are_equal(
+              this->derivative_matrix[d], this->derivative_matrix[dir]))
+          {
+            this->eigenvalues[dir]  = this->eigenvalues[d];
+            this->eigenvectors[dir] = this->eigenvectors[d];
+            found_equal_direction   = true;
+          }
+      if (found_equal_direction)
+        continue;
+
       this->eigenvectors[dir].reinit(mass_matrices[dir].n_cols(),
                                      mass_matrices[dir].n_rows());
       this->eigenvalues[dir].resize(mass_matrices[dir].n_cols());
@@ -793,24 +1180,6 @@ TensorProductMatrixSymmetricSum<dim, VectorizedArray<Number>, n_rows_1d>::
   this->mass_matrix        = mass_matrix;
   this->derivative_matrix  = derivative_matrix;
 
-  constexpr unsigned int macro_size = VectorizedArray<Number>::size();
-  std::size_t            n_rows_max = (n_rows_1d > 0) ? n_rows_1d : 0;
-  if (n_rows_1d == -1)
-    for (unsigned int d = 0; d < dim; ++d)
-      n_rows_max = std::max(n_rows_max, mass_matrix[d].n_rows());
-  const std::size_t nm_flat_size_max = n_rows_max * n_rows_max * macro_size;
-  const std::size_t n_flat_size_max  = n_rows_max * macro_size;
-
-  std::vector<Number> mass_matrix_flat;
-  std::vector<Number> deriv_matrix_flat;
-  std::vector<Number> eigenvalues_flat;
-  std::vector<Number> eigenvectors_flat;
-  mass_matrix_flat.resize(nm_flat_size_max);
-  deriv_matrix_flat.resize(nm_flat_size_max);
-  eigenvalues_flat.resize(n_flat_size_max);
-  eigenvectors_flat.resize(nm_flat_size_max);
-  std::array<unsigned int, macro_size> offsets_nm;
-  std::array<unsigned int, macro_size> offsets_n;
   for (int dir = 0; dir < dim; ++dir)
     {
       Assert(n_rows_1d == -1 ||
@@ -823,48 +1192,29 @@ TensorProductMatrixSymmetricSum<dim, VectorizedArray<Number>, n_rows_1d>::
       AssertDimension(mass_matrix[dir].n_rows(),
                       derivative_matrix[dir].n_cols());
 
-      const unsigned int n_rows = mass_matrix[dir].n_rows();
-      const unsigned int n_cols = mass_matrix[dir].n_cols();
-      const unsigned int nm     = n_rows * n_cols;
-      for (unsigned int vv = 0; vv < macro_size; ++vv)
-        offsets_nm[vv] = nm * vv;
-
-      vectorized_transpose_and_store(false,
-                                     nm,
-                                     &(mass_matrix[dir](0, 0)),
-                                     offsets_nm.cbegin(),
-                                     mass_matrix_flat.data());
-      vectorized_transpose_and_store(false,
-                                     nm,
-                                     &(derivative_matrix[dir](0, 0)),
-                                     offsets_nm.cbegin(),
-                                     deriv_matrix_flat.data());
-
-      const Number *mass_cbegin    = mass_matrix_flat.data();
-      const Number *deriv_cbegin   = deriv_matrix_flat.data();
-      Number *      eigenvec_begin = eigenvectors_flat.data();
-      Number *      eigenval_begin = eigenvalues_flat.data();
-      for (unsigned int lane = 0; lane < macro_size; ++lane)
-        internal::TensorProductMatrix::spectral_assembly<Number>(
-          mass_cbegin + nm * lane,
-          deriv_cbegin + nm * lane,
-          n_rows,
-          n_cols,
-          eigenval_begin + n_rows * lane,
-          eigenvec_begin + nm * lane);
-
-      this->eigenvalues[dir].resize(n_rows);
-      this->eigenvectors[dir].reinit(n_rows, n_cols);
-      for (unsigned int vv = 0; vv < macro_size; ++vv)
-        offsets_n[vv] = n_rows * vv;
-      vectorized_load_and_transpose(n_rows,
-                                    eigenvalues_flat.data(),
-                                    offsets_n.cbegin(),
-                                    this->eigenvalues[dir].begin());
-      vectorized_load_and_transpose(nm,
-                                    eigenvectors_flat.data(),
-                                    offsets_nm.cbegin(),
-                                    &(this->eigenvectors[dir](0, 0)));
+      // reuse the eigendecomposition of a previous direction with the same
+      // matrices in all lanes
+      bool found_equal_direction = false;
+      for (int d = 0; d < dir && !found_equal_direction; ++d)
+        if (internal::TensorProductMatrix::matrices_are_equal(
+              this->mass_matrix[d], this->mass_matrix[dir]) &&
+            internal::TensorProductMatrix::matrices_are_equal(
+              this->derivative_matrix[d], this->derivative_matrix[dir]))
+          {
+            this->eigenvalues[dir]  = this->eigenvalues[d];
+            this->eigenvectors[dir] = this->eigenvectors[d];
+            found_equal_direction   = true;
+          }
+      if (found_equal_direction)
+        continue;
+
+      // compute the eigendecompositions of all lanes at once rather than
+      // calling LAPACK lane by lane
+      internal::TensorProductMatrix::spectral_assembly_vectorized<Number>(
+        this->mass_matrix[dir],
+        this->derivative_matrix[dir],
+        this->eigenvalues[dir],
+        this->eigenvectors[dir]);
     }
 }
 
@@ -0,0 +1,334 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_trilinos_tpetra_sparse_matrix_h
+#define dealii_trilinos_tpetra_sparse_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#if defined(DEAL_II_TRILINOS_WITH_TPETRA) && defined(DEAL_II_WITH_MPI)
+
+#  include <deal.II/base/index_set.h>
+#  include <deal.II/base/subscriptor.h>
+
+#  include <deal.II/lac/exceptions.h>
+#  include <deal.II/lac/trilinos_tpetra_vector.h>
+#  include <deal.II/lac/vector_operation.h>
+
+#  include <Teuchos_RCP.hpp>
+#  include <Tpetra_CrsGraph.hpp>
+#  include <Tpetra_CrsMatrix.hpp>
+#  include <Tpetra_Map.hpp>
+#  include <mpi.h>
+
+#  include <memory>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declaration
+#  ifndef DOXYGEN
+class DynamicSparsityPattern;
+#  endif
+
+namespace LinearAlgebra
+{
+  namespace TpetraWrappers
+  {
+    /**
+     * This class implements a wrapper to the Trilinos sparse matrix class
+     * Tpetra::CrsMatrix, to be used together with TpetraWrappers::Vector.
+     * As opposed to the Epetra-based TrilinosWrappers::SparseMatrix, Tpetra
+     * uses 64-bit global indices if deal.II is configured with them and
+     * executes the matrix-vector products with Kokkos, i.e., threaded or on
+     * the GPU, depending on the configuration of Kokkos (see the
+     * documentation of TpetraWrappers::Vector).
+     *
+     * The structure of the matrix is fixed by reinit() from a
+     * DynamicSparsityPattern, which is converted into a Tpetra::CrsGraph
+     * that the matrix uses as a static graph. Hence, entries can only be
+     * added to positions present in the sparsity pattern. Entries in rows
+     * owned by other processes are communicated to their owners by
+     * compress(), which needs to be called after the assembly, and before
+     * the matrix is used or assembled again.
+     *
+     * @ingroup TrilinosWrappers
+     * @ingroup Matrix1
+     */
+    template <typename Number>
+    class SparseMatrix : public Subscriptor
+    {
+    public:
+      /**
+       * Declare the type for container size.
+       */
+      using size_type = types::global_dof_index;
+
+      /**
+       * Declare the type of the matrix entries.
+       */
+      using value_type = Number;
+
+      /**
+       * The type of the underlying Tpetra map.
+       */
+      using MapType = Tpetra::Map<int, types::global_dof_index>;
+
+      /**
+       * The type of the underlying Tpetra graph.
+       */
+      using GraphType = Tpetra::CrsGraph<int, types::global_dof_index>;
+
+      /**
+       * The type of the underlying Tpetra matrix.
+       */
+      using MatrixType = Tpetra::CrsMatrix<Number, int, types::global_dof_index>;
+
+      /**
+       * Default constructor. Generates an empty matrix.
+       */
+      SparseMatrix() = default;
+
+      /**
+       * Constructor, see reinit().
+       */
+      SparseMatrix(const IndexSet &              row_parallel_partitioning,
+                   const IndexSet &              col_parallel_partitioning,
+                   const DynamicSparsityPattern &sparsity_pattern,
+                   const MPI_Comm &              communicator);
+
+      /**
+       * Copying is not supported, as it would need to duplicate the graph.
+       */
+      SparseMatrix(const SparseMatrix &) = delete;
+
+      /**
+       * Copying is not supported, as it would need to duplicate the graph.
+       */
+      SparseMatrix &
+      operator=(const SparseMatrix &) = delete;
+
+      /**
+       * Initialize the matrix with the rows given by
+       * @p row_parallel_partitioning and the columns given by
+       * @p col_parallel_partitioning, with the sparsity structure in the
+       * locally owned rows of @p sparsity_pattern. The latter typically
+       * contains the locally relevant rows as obtained from
+       * DoFTools::make_sparsity_pattern() and
+       * SparsityTools::distribute_sparsity_pattern(), but only the locally
+       * owned rows are used here. All entries are set to zero.
+       */
+      void
+      reinit(const IndexSet &              row_parallel_partitioning,
+             const IndexSet &              col_parallel_partitioning,
+             const DynamicSparsityPattern &sparsity_pattern,
+             const MPI_Comm &              communicator);
+
+      /**
+       * Release all memory and return to a state just like after having
+       * called the default constructor.
+       */
+      void
+      clear();
+
+      /**
+       * Set all entries of the matrix to zero, keeping the sparsity
+       * structure. Only zero is allowed as argument.
+       */
+      SparseMatrix &
+      operator=(const Number d);
+
+      /**
+       * Set the element (<i>i,j</i>) to @p value. The entry must be part of
+       * the sparsity pattern and @p i must be a locally owned row.
+       */
+      void
+      set(const size_type i, const size_type j, const Number value);
+
+      /**
+       * Add @p value to the element (<i>i,j</i>). The entry must be part of
+       * the sparsity pattern. Rows owned by other processes are sent to their
+       * owners in compress().
+       */
+      void
+      add(const size_type i, const size_type j, const Number value);
+
+      /**
+       * Add the @p n_cols values in @p values to the columns
+       * @p col_indices of @p row, as it is done when distributing a cell
+       * matrix with AffineConstraints::distribute_local_to_global().
+       */
+      void
+      add(const size_type  row,
+          const size_type  n_cols,
+          const size_type *col_indices,
+          const Number *   values,
+          const bool       elide_zero_values      = true,
+          const bool       col_indices_are_sorted = false);
+
+      /**
+       * Communicate the entries added to rows owned by other processes and
+       * finalize the matrix, so that it can be used in matrix-vector products
+       * or by Tpetra-based preconditioners. The argument is only there for
+       * compatibility with the other matrix classes, as only additions to
+       * non-owned rows are supported.
+       */
+      void
+      compress(const VectorOperation::values operation);
+
+      /**
+       * Return the number of rows.
+       */
+      size_type
+      m() const;
+
+      /**
+       * Return the number of columns.
+       */
+      size_type
+      n() const;
+
+      /**
+       * Return the total number of nonzero elements of the matrix.
+       */
+      size_type
+      n_nonzero_elements() const;
+
+      /**
+       * Return the rows owned by the current process.
+       */
+      IndexSet
+      locally_owned_range_indices() const;
+
+      /**
+       * Return the columns of the vectors the matrix is applied to that are
+       * owned by the current process.
+       */
+      IndexSet
+      locally_owned_domain_indices() const;
+
+      /**
+       * Matrix-vector multiplication: let <i>dst = M*src</i>.
+       */
+      void
+      vmult(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Matrix-vector multiplication: let <i>dst = M<sup>T</sup>*src</i>.
+       */
+      void
+      Tvmult(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Adding matrix-vector multiplication: let <i>dst += M*src</i>.
+       */
+      void
+      vmult_add(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Adding matrix-vector multiplication: let
+       * <i>dst += M<sup>T</sup>*src</i>.
+       */
+      void
+      Tvmult_add(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Return a const reference to the underlying Tpetra matrix, e.g., to
+       * set up Ifpack2 or MueLu preconditioners on it.
+       */
+      const MatrixType &
+      trilinos_matrix() const;
+
+      /**
+       * Return a (modifiable) reference to the underlying Tpetra matrix.
+       */
+      MatrixType &
+      trilinos_matrix();
+
+      /**
+       * Return a reference-counted pointer to the underlying Tpetra matrix,
+       * as it is needed by the factories of the Tpetra-based packages.
+       */
+      Teuchos::RCP<MatrixType>
+      trilinos_rcp() const;
+
+      /**
+       * Return the memory consumption of this class in bytes, estimated from
+       * the number of stored entries.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * Exception thrown when an entry is not part of the sparsity pattern.
+       */
+      DeclException2(ExcInvalidIndex,
+                     size_type,
+                     size_type,
+                     << "The entry with index <" << arg1 << ',' << arg2
+                     << "> does not exist.");
+
+      /**
+       * Exception thrown by an error in Trilinos.
+       */
+      DeclException1(ExcTrilinosError,
+                     int,
+                     << "An error with error number " << arg1
+                     << " occurred while calling a Trilinos function");
+
+    private:
+      /**
+       * The locally owned rows.
+       */
+      IndexSet row_partitioning;
+
+      /**
+       * The locally owned part of the domain.
+       */
+      IndexSet col_partitioning;
+
+      /**
+       * The number of entries stored in the locally owned rows.
+       */
+      std::size_t n_local_entries = 0;
+
+      /**
+       * The map of the rows, which also is the range map of the matrix.
+       */
+      Teuchos::RCP<const MapType> row_map;
+
+      /**
+       * The domain map of the matrix.
+       */
+      Teuchos::RCP<const MapType> domain_map;
+
+      /**
+       * The graph of the matrix.
+       */
+      Teuchos::RCP<GraphType> graph;
+
+      /**
+       * The actual matrix.
+       */
+      Teuchos::RCP<MatrixType> matrix;
+    };
+  } // namespace TpetraWrappers
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
+
+#endif
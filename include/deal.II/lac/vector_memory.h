@@ -27,6 +27,7 @@
 
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -308,6 +309,19 @@ public:
  * GrowingVectorMemory object whenever needed without the performance penalty
  * of creating a new memory pool every time. A drawback of this policy is that
  * vectors once allocated are only released at the end of the program run.
+ *
+ * When a vector is requested, the pool hands out the unused vector that was
+ * most recently returned by the calling thread, or the most recently
+ * returned vector overall if the calling thread has not returned any. Since
+ * the typical usage pattern is that a solver allocates its temporary vectors
+ * and re-initializes them with the layout of the solution vector, this
+ * strategy makes it likely that the vector already has the requested layout
+ * (e.g. the same Utilities::MPI::Partitioner for
+ * LinearAlgebra::distributed::Vector), such that the re-initialization does
+ * not need to allocate new memory, and that the memory has been touched by
+ * the same thread before, which keeps it close to this thread on systems
+ * with non-uniform memory access. The functions n_reused_vectors() and
+ * n_new_vectors() report how many requests could be served by the pool.
  */
 template <typename VectorType = dealii::Vector<double>>
 class GrowingVectorMemory : public VectorMemory<VectorType>
@@ -386,6 +400,21 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Return the number of calls to alloc() through this object that were
+   * served by an unused vector of the pool.
+   */
+  size_type
+  n_reused_vectors() const;
+
+  /**
+   * Return the number of calls to alloc() through this object that needed
+   * to create a new vector because no unused vector was available in the
+   * pool.
+   */
+  size_type
+  n_new_vectors() const;
+
 private:
   /**
    * A type that describes this entries of an array that represents
@@ -424,6 +453,12 @@ private:
      * Pointer to the storage object
      */
     std::vector<entry_type> *data;
+
+    /**
+     * The indices into #data of the currently unused vectors, along with the
+     * thread that returned them, in the order in which they were returned.
+     */
+    std::vector<std::pair<std::thread::id, size_type>> unused_entries;
   };
 
   /**
@@ -444,6 +479,11 @@ private:
    */
   size_type current_alloc;
 
+  /**
+   * Number of allocations that needed to create a new vector.
+   */
+  size_type new_alloc;
+
   /**
    * A flag controlling the logging of statistics by the destructor.
    */
@@ -79,6 +79,10 @@ GrowingVectorMemory<VectorType>::Pool::initialize(const size_type size)
           i->first  = false;
           i->second = std::make_unique<VectorType>();
         }
+
+      unused_entries.clear();
+      for (size_type i = 0; i < size; ++i)
+        unused_entries.emplace_back(std::thread::id(), i);
     }
 }
 
@@ -90,6 +94,7 @@ inline GrowingVectorMemory<VectorType>::GrowingVectorMemory(
 
   : total_alloc(0)
   , current_alloc(0)
+  , new_alloc(0)
   , log_statistics(log_statistics)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -121,23 +126,36 @@ GrowingVectorMemory<VectorType>::alloc()
 
   ++total_alloc;
   ++current_alloc;
-  // see if there is a free vector
-  // available in our list
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
+
+  // see if there is a free vector available in our list. prefer the one
+  // most recently returned by the calling thread, otherwise take the one
+  // most recently returned by any thread
+  Pool &pool = get_pool();
+  if (pool.unused_entries.empty() == false)
     {
-      if (i->first == false)
-        {
-          i->first = true;
-          return i->second.get();
-        }
+      const std::thread::id this_thread = std::this_thread::get_id();
+      auto                  entry       = pool.unused_entries.end() - 1;
+      for (auto e = pool.unused_entries.rbegin();
+           e != pool.unused_entries.rend();
+           ++e)
+        if (e->first == this_thread)
+          {
+            entry = std::prev(e.base());
+            break;
+          }
+
+      const size_type index = entry->second;
+      pool.unused_entries.erase(entry);
+      Assert((*pool.data)[index].first == false, ExcInternalError());
+      (*pool.data)[index].first = true;
+      return (*pool.data)[index].second.get();
     }
 
   // no free vector found, so let's just allocate a new one
-  get_pool().data->emplace_back(true, std::make_unique<VectorType>());
+  ++new_alloc;
+  pool.data->emplace_back(true, std::make_unique<VectorType>());
 
-  return get_pool().data->back().second.get();
+  return pool.data->back().second.get();
 }
 
 
@@ -148,13 +166,16 @@ GrowingVectorMemory<VectorType>::free(const VectorType *const v)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
+  Pool &pool = get_pool();
+  for (size_type i = pool.data->size(); i-- > 0;)
     {
-      if (v == i->second.get())
+      entry_type &entry = (*pool.data)[i];
+      if (v == entry.second.get())
         {
-          i->first = false;
+          Assert(entry.first == true,
+                 typename VectorMemory<VectorType>::ExcNotAllocatedHere());
+          entry.first = false;
+          pool.unused_entries.emplace_back(std::this_thread::get_id(), i);
           --current_alloc;
           return;
         }
@@ -172,6 +193,7 @@ GrowingVectorMemory<VectorType>::release_unused_memory()
 
   if (get_pool().data != nullptr)
     get_pool().data->clear();
+  get_pool().unused_entries.clear();
 }
 
 
@@ -190,11 +212,33 @@ GrowingVectorMemory<VectorType>::memory_consumption() const
        i != end;
        ++i)
     result += sizeof(*i) + MemoryConsumption::memory_consumption(i->second);
+  result += get_pool().unused_entries.capacity() *
+            sizeof(typename decltype(get_pool().unused_entries)::value_type);
 
   return result;
 }
 
 
+
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::size_type
+GrowingVectorMemory<VectorType>::n_reused_vectors() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return total_alloc - new_alloc;
+}
+
+
+
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::size_type
+GrowingVectorMemory<VectorType>::n_new_vectors() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return new_alloc;
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
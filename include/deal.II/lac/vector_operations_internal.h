@@ -89,6 +89,44 @@ namespace internal
 
 
 
+    /**
+     * The maximal number of chunks into which the index range of a vector is
+     * split for the parallel loops and reductions below.
+     */
+    const unsigned int max_n_chunks = 512;
+
+    /**
+     * Split an index range of length @p vec_size into @p n_chunks chunks of
+     * length @p chunk_size (except for the last one that might be shorter)
+     * for the parallel loops and reductions below. The chunks are at least as
+     * long as the minimum grain size and are rounded to a multiple of 512,
+     * which is advantageous because our accumulation algorithms favor lengths
+     * of a power of 2 due to pairwise summation -> at most one 'oddly' sized
+     * chunk.
+     *
+     * The layout only depends on the length of the range, not on the number
+     * of threads, such that reductions give bitwise identical results
+     * independently of the number of threads the program runs with.
+     */
+    inline void
+    compute_chunk_layout(const size_type vec_size,
+                         unsigned int &  n_chunks,
+                         size_type &     chunk_size)
+    {
+      const size_type gs =
+        internal::VectorImplementation::minimum_parallel_grain_size;
+      chunk_size = std::max<size_type>(gs, (vec_size + max_n_chunks - 1) /
+                                             max_n_chunks);
+      if (chunk_size > 512)
+        chunk_size = ((chunk_size + 511) / 512) * 512;
+      n_chunks = (vec_size + chunk_size - 1) / chunk_size;
+      AssertIndexRange(n_chunks, max_n_chunks + 1);
+      AssertIndexRange((n_chunks - 1) * chunk_size, vec_size);
+      AssertIndexRange(vec_size, n_chunks * chunk_size + 1);
+    }
+
+
+
 #ifdef DEAL_II_WITH_TBB
     /**
      * This struct takes the loop range from the tbb parallel for loop and
@@ -108,24 +146,7 @@ namespace internal
         , start(start)
         , end(end)
       {
-        const size_type vec_size = end - start;
-        // set chunk size for sub-tasks
-        const unsigned int gs =
-          internal::VectorImplementation::minimum_parallel_grain_size;
-        n_chunks =
-          std::min(static_cast<size_type>(4 * MultithreadInfo::n_threads()),
-                   vec_size / gs);
-        chunk_size = vec_size / n_chunks;
-
-        // round to next multiple of 512 (or minimum grain size if that happens
-        // to be smaller). this is advantageous because our accumulation
-        // algorithms favor lengths of a power of 2 due to pairwise summation ->
-        // at most one 'oddly' sized chunk
-        if (chunk_size > 512)
-          chunk_size = ((chunk_size + 511) / 512) * 512;
-        n_chunks = (vec_size + chunk_size - 1) / chunk_size;
-        AssertIndexRange((n_chunks - 1) * chunk_size, vec_size);
-        AssertIndexRange(vec_size, n_chunks * chunk_size + 1);
+        compute_chunk_layout(end - start, n_chunks, chunk_size);
       }
 
       void
@@ -940,6 +961,69 @@ namespace internal
       const Number        a;
     };
 
+    // Result type of the MultiDot operation below: a fixed-size array of
+    // numbers that supports the additions needed by accumulate_recursive()
+    // and parallel_reduce(). The default constructor sets all entries to zero.
+    template <typename Number, unsigned int n_vectors>
+    struct MultiDotResult
+    {
+      MultiDotResult()
+      {
+        for (unsigned int k = 0; k < n_vectors; ++k)
+          values[k] = Number();
+      }
+
+      MultiDotResult &
+      operator+=(const MultiDotResult &other)
+      {
+        for (unsigned int k = 0; k < n_vectors; ++k)
+          values[k] += other.values[k];
+        return *this;
+      }
+
+      MultiDotResult
+      operator+(const MultiDotResult &other) const
+      {
+        MultiDotResult result(*this);
+        result += other;
+        return result;
+      }
+
+      Number values[n_vectors];
+    };
+
+    // Computes the scalar products of X with n_vectors vectors Y[k] at once,
+    // such that the entries of X are only read once. As the result is not a
+    // single number, the vectorized code path of accumulate_regular() is not
+    // available, but the loop over the vectors is short enough for the
+    // compiler to keep all partial sums in registers.
+    template <typename Number, typename Number2, unsigned int n_vectors>
+    struct MultiDot
+    {
+      static const bool vectorizes = false;
+
+      MultiDot(const Number *const X, const Number2 *const *const Y_ptrs)
+        : X(X)
+      {
+        for (unsigned int k = 0; k < n_vectors; ++k)
+          Y[k] = Y_ptrs[k];
+      }
+
+      MultiDotResult<Number, n_vectors>
+      operator()(const size_type i) const
+      {
+        MultiDotResult<Number, n_vectors> result;
+        const Number                      x = X[i];
+        for (unsigned int k = 0; k < n_vectors; ++k)
+          result.values[k] =
+            x * Number(numbers::NumberTraits<Number2>::conjugate(Y[k][i]));
+        return result;
+      }
+
+      const Number *const X;
+      const Number2 *     Y[n_vectors];
+    };
+
 
 
     // this is the main working loop for all vector sums using the templated
@@ -1229,7 +1313,6 @@ namespace internal
 
 
 
-#ifdef DEAL_II_WITH_TBB
     /**
      * This struct takes the loop range from the tbb parallel for loop and
      * translates it to the actual ranges of the reduction loop inside the
@@ -1251,12 +1334,14 @@ namespace internal
      * the algorithm TBB sees is just a parallel for and nothing unpredictable
      * can happen.
      *
-     * To sum up: Once the number of threads and the vector size are fixed, we
-     * have an exact layout of how the calls into the recursive function will
-     * happen. Inside the recursive function, we again only depend on the
-     * length. Finally, the concurrent threads write into different positions in
-     * a result vector in a thread-safe way and the addition in the short array
-     * is again serial.
+     * To sum up: Once the vector size is fixed, we have an exact layout of how
+     * the calls into the recursive function will happen, see
+     * compute_chunk_layout(). Inside the recursive function, we again only
+     * depend on the length. Finally, the concurrent threads write into
+     * different positions in a result vector in a thread-safe way and the
+     * addition in the short array is again serial. The serial code path uses
+     * the same layout via accumulate_chunks(), so the result does not depend
+     * on the number of threads either.
      */
     template <typename Operation, typename ResultType>
     struct TBBReduceFunctor
@@ -1270,24 +1355,7 @@ namespace internal
         , start(start)
         , end(end)
       {
-        const size_type vec_size = end - start;
-        // set chunk size for sub-tasks
-        const unsigned int gs =
-          internal::VectorImplementation::minimum_parallel_grain_size;
-        n_chunks =
-          std::min(static_cast<size_type>(4 * MultithreadInfo::n_threads()),
-                   vec_size / gs);
-        chunk_size = vec_size / n_chunks;
-
-        // round to next multiple of 512 (or leave it at the minimum grain size
-        // if that happens to be smaller). this is advantageous because our
-        // algorithm favors lengths of a power of 2 due to pairwise summation ->
-        // at most one 'oddly' sized chunk
-        if (chunk_size > 512)
-          chunk_size = ((chunk_size + 511) / 512) * 512;
-        n_chunks = (vec_size + chunk_size - 1) / chunk_size;
-        AssertIndexRange((n_chunks - 1) * chunk_size, vec_size);
-        AssertIndexRange(vec_size, n_chunks * chunk_size + 1);
+        compute_chunk_layout(end - start, n_chunks, chunk_size);
 
         if (n_chunks > threshold_array_allocate)
           {
@@ -1304,10 +1372,22 @@ namespace internal
        * An operator used by TBB to work on a given @p range of chunks
        * [range.begin(), range.end()).
        */
+#ifdef DEAL_II_WITH_TBB
       void
       operator()(const tbb::blocked_range<size_type> &range) const
       {
-        for (size_type i = range.begin(); i < range.end(); ++i)
+        accumulate_chunks(range.begin(), range.end());
+      }
+#endif
+
+      /**
+       * Compute the partial results of the chunks [begin_chunk, end_chunk).
+       */
+      void
+      accumulate_chunks(const size_type begin_chunk,
+                        const size_type end_chunk) const
+      {
+        for (size_type i = begin_chunk; i < end_chunk; ++i)
           accumulate_recursive(op,
                                start + i * chunk_size,
                                std::min(start + (i + 1) * chunk_size, end),
@@ -1333,14 +1413,13 @@ namespace internal
       const size_type  end;
 
       mutable unsigned int    n_chunks;
-      unsigned int            chunk_size;
+      size_type               chunk_size;
       ResultType              small_array[threshold_array_allocate];
       std::vector<ResultType> large_array;
       // this variable either points to small_array or large_array depending on
-      // the number of threads we want to feed
+      // the number of chunks
       mutable ResultType *array_ptr;
     };
-#endif
 
 
 
@@ -1358,46 +1437,50 @@ namespace internal
       const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
         &partitioner)
     {
-#ifdef DEAL_II_WITH_TBB
       const size_type vec_size = end - start;
-      // only go to the parallel function in case there are at least 4 parallel
-      // items, otherwise the overhead is too large
+      // only split the range into chunks in case there are at least 4 of
+      // them, otherwise the overhead is too large. in order to get the same
+      // result independently of the number of threads, the serial code path
+      // uses the same chunks as the parallel one
       if (vec_size >=
-            4 * internal::VectorImplementation::minimum_parallel_grain_size &&
-          MultithreadInfo::n_threads() > 1)
+          4 * internal::VectorImplementation::minimum_parallel_grain_size)
         {
-          Assert(partitioner.get() != nullptr,
-                 ExcInternalError(
-                   "Unexpected initialization of Vector that does "
-                   "not set the TBB partitioner to a usable state."));
-          std::shared_ptr<tbb::affinity_partitioner> tbb_partitioner =
-            partitioner->acquire_one_partitioner();
-
           TBBReduceFunctor<Operation, ResultType> generic_functor(op,
                                                                   start,
                                                                   end);
-          // We use a minimum grain size of 1 here since the grains at this
-          // stage of dividing the work refer to the number of vector chunks
-          // that are processed by (possibly different) threads in the
-          // parallelized for loop (i.e., they do not refer to individual
-          // vector entries). The number of chunks here is calculated inside
-          // TBBForFunctor. See also GitHub issue #2496 for further discussion
-          // of this strategy.
-          ::dealii::parallel::internal::parallel_for(
-            static_cast<size_type>(0),
-            static_cast<size_type>(generic_functor.n_chunks),
-            generic_functor,
-            1,
-            tbb_partitioner);
-          partitioner->release_one_partitioner(tbb_partitioner);
+#ifdef DEAL_II_WITH_TBB
+          if (MultithreadInfo::n_threads() > 1)
+            {
+              Assert(partitioner.get() != nullptr,
+                     ExcInternalError(
+                       "Unexpected initialization of Vector that does "
+                       "not set the TBB partitioner to a usable state."));
+              std::shared_ptr<tbb::affinity_partitioner> tbb_partitioner =
+                partitioner->acquire_one_partitioner();
+
+              // We use a minimum grain size of 1 here since the grains at
+              // this stage of dividing the work refer to the number of vector
+              // chunks that are processed by (possibly different) threads in
+              // the parallelized for loop (i.e., they do not refer to
+              // individual vector entries). The number of chunks here is
+              // calculated inside TBBReduceFunctor. See also GitHub issue
+              // #2496 for further discussion of this strategy.
+              ::dealii::parallel::internal::parallel_for(
+                static_cast<size_type>(0),
+                static_cast<size_type>(generic_functor.n_chunks),
+                generic_functor,
+                1,
+                tbb_partitioner);
+              partitioner->release_one_partitioner(tbb_partitioner);
+            }
+          else
+#endif
+            generic_functor.accumulate_chunks(0, generic_functor.n_chunks);
           result = generic_functor.do_sum();
         }
       else
         accumulate_recursive(op, start, end, result);
-#else
-      accumulate_recursive(op, start, end, result);
       (void)partitioner;
-#endif
     }
 
 
@@ -1636,6 +1719,18 @@ namespace internal
         return Number();
       }
 
+      static void
+      multi_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
+        /*thread_loop_partitioner*/,
+        const size_type /*size*/,
+        const ::dealii::MemorySpace::MemorySpaceData<Number2, MemorySpace>
+          *const * /*v_data*/,
+        const unsigned int /*n_vectors*/,
+        ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> & /*data*/,
+        Number * /*results*/)
+      {}
+
       template <typename MemorySpace2>
       static void
       import(
@@ -1993,6 +2088,90 @@ namespace internal
         return sum;
       }
 
+      // Computes the scalar products of the vector described by @p data
+      // with the @p n_vectors vectors in @p v_data. The vectors are worked
+      // on in groups of up to four, such that the entries of @p data are
+      // loaded from memory only once per group rather than once per vector.
+      static void
+      multi_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number2, ::dealii::MemorySpace::Host> *const *v_data,
+        const unsigned int n_vectors,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &     data,
+        Number *results)
+      {
+        for (unsigned int start = 0; start < n_vectors; start += 4)
+          {
+            const Number2 *y_ptrs[4];
+            const unsigned int n_group = std::min(n_vectors - start, 4U);
+            for (unsigned int k = 0; k < n_group; ++k)
+              y_ptrs[k] = v_data[start + k]->values.get();
+
+            switch (n_group)
+              {
+                case 1:
+                  {
+                    // a single vector can use the vectorized code path
+                    Number              sum;
+                    Dot<Number, Number2> dot(data.values.get(), y_ptrs[0]);
+                    parallel_reduce(dot, 0, size, sum, thread_loop_partitioner);
+                    AssertIsFinite(sum);
+                    results[start] = sum;
+                    break;
+                  }
+                case 2:
+                  multi_dot_group<2>(thread_loop_partitioner,
+                                       size,
+                                       y_ptrs,
+                                       data,
+                                       results + start);
+                  break;
+                case 3:
+                  multi_dot_group<3>(thread_loop_partitioner,
+                                       size,
+                                       y_ptrs,
+                                       data,
+                                       results + start);
+                  break;
+                case 4:
+                  multi_dot_group<4>(thread_loop_partitioner,
+                                       size,
+                                       y_ptrs,
+                                       data,
+                                       results + start);
+                  break;
+                default:
+                  Assert(false, ExcInternalError());
+              }
+          }
+      }
+
+      template <unsigned int n_group>
+      static void
+      multi_dot_group(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &                  thread_loop_partitioner,
+        const size_type      size,
+        const Number2 *const y_ptrs[4],
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::Host> &data,
+        Number *                                                results)
+      {
+        MultiDotResult<Number, n_group>   sums;
+        MultiDot<Number, Number2, n_group> multi_dot(data.values.get(), y_ptrs);
+        parallel_reduce(multi_dot, 0, size, sums, thread_loop_partitioner);
+        for (unsigned int k = 0; k < n_group; ++k)
+          {
+            AssertIsFinite(sums.values[k]);
+            results[k] = sums.values[k];
+          }
+      }
+
       template <typename MemorySpace2>
       static void
       import(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
@@ -2509,6 +2688,25 @@ namespace internal
         return res;
       }
 
+      // There is no fused kernel for several scalar products on the
+      // device, so compute them one by one
+      static void
+      multi_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> *const *v_data,
+        const unsigned int n_vectors,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::CUDA>
+          &     data,
+        Number *results)
+      {
+        for (unsigned int k = 0; k < n_vectors; ++k)
+          results[k] = dot(thread_loop_partitioner, size, *v_data[k], data);
+      }
+
       template <typename MemorySpace2>
       static void
       import(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
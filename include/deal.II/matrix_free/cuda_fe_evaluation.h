@@ -55,6 +55,80 @@ namespace CUDAWrappers
                 threadIdx.x % n_points_1d +
                     n_points_1d * (threadIdx.y + n_points_1d * threadIdx.z));
     }
+
+
+
+    /**
+     * The types of values and gradients returned by FEEvaluation, together
+     * with the access to a single component. For systems, the values are a
+     * Tensor over the components and the gradients a Tensor of gradients.
+     */
+    template <int dim, int n_components, typename Number>
+    struct EvaluationTypes
+    {
+      using value_type    = Tensor<1, n_components, Number>;
+      using gradient_type = Tensor<1, n_components, Tensor<1, dim, Number>>;
+
+      static __device__ Number &
+      component(value_type &value, const unsigned int c)
+      {
+        return value[c];
+      }
+
+      static __device__ const Number &
+      component(const value_type &value, const unsigned int c)
+      {
+        return value[c];
+      }
+
+      static __device__ Tensor<1, dim, Number> &
+      component(gradient_type &gradient, const unsigned int c)
+      {
+        return gradient[c];
+      }
+
+      static __device__ const Tensor<1, dim, Number> &
+      component(const gradient_type &gradient, const unsigned int c)
+      {
+        return gradient[c];
+      }
+    };
+
+
+
+    /**
+     * Specialization for scalar elements, where values are plain numbers.
+     */
+    template <int dim, typename Number>
+    struct EvaluationTypes<dim, 1, Number>
+    {
+      using value_type    = Number;
+      using gradient_type = Tensor<1, dim, Number>;
+
+      static __device__ Number &
+      component(value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static __device__ const Number &
+      component(const value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static __device__ Tensor<1, dim, Number> &
+      component(gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+
+      static __device__ const Tensor<1, dim, Number> &
+      component(const gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+    };
   } // namespace internal
 
   /**
@@ -75,7 +149,14 @@ namespace CUDAWrappers
    * @tparam n_components Number of vector components when solving a system of
    * PDEs. If the same operation is applied to several components of a PDE (e.g.
    * a vector Laplace equation), they can be applied simultaneously with one
-   * call (and often more efficiently). Defaults to 1
+   * call (and often more efficiently). Defaults to 1. For more than one
+   * component, the MatrixFree object must be set up with an FESystem
+   * consisting of as many copies of the same scalar element, the values are
+   * returned as Tensor<1,n_components,Number> and the gradients as
+   * Tensor<1,n_components,Tensor<1,dim,Number>>. The values of all components
+   * are stored one after another in the shared memory, so the functor passed
+   * to MatrixFree::cell_loop() must set `n_local_dofs` to the number of
+   * degrees of freedom of all components.
    *
    * @tparam Number Number format, @p double or @p float. Defaults to @p
    * double.
@@ -91,14 +172,20 @@ namespace CUDAWrappers
   {
   public:
     /**
-     * An alias for scalar quantities.
+     * An alias for the values, a scalar for elements with a single component
+     * and a Tensor over the components otherwise.
      */
-    using value_type = Number;
+    using value_type =
+      typename internal::EvaluationTypes<dim, n_components_, Number>::
+        value_type;
 
     /**
-     * An alias for vectorial quantities.
+     * An alias for the gradients, a Tensor<1,dim> for elements with a single
+     * component and a Tensor of those over the components otherwise.
      */
-    using gradient_type = Tensor<1, dim, Number>;
+    using gradient_type =
+      typename internal::EvaluationTypes<dim, n_components_, Number>::
+        gradient_type;
 
     /**
      * An alias to kernel specific information.
@@ -311,6 +398,11 @@ namespace CUDAWrappers
     apply_for_each_quad_point(const Functor &func);
 
   private:
+    /**
+     * Access to the individual components of value_type and gradient_type.
+     */
+    using Types = internal::EvaluationTypes<dim, n_components_, Number>;
+
     types::global_dof_index *local_to_global;
     unsigned int             n_cells;
     unsigned int             padding_length;
@@ -347,7 +439,8 @@ namespace CUDAWrappers
     , use_coloring(data->use_coloring)
     , values(shdata->values)
   {
-    local_to_global = data->local_to_global + padding_length * cell_id;
+    local_to_global =
+      data->local_to_global + padding_length * n_components_ * cell_id;
     inv_jac         = data->inv_jacobian + padding_length * cell_id;
     JxW             = data->JxW + padding_length * cell_id;
 
@@ -366,18 +459,21 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     read_dof_values(const Number *src)
   {
-    static_assert(n_components_ == 1, "This function only supports FE with one \
-                  components");
     const unsigned int idx = internal::compute_index<dim, n_q_points_1d>();
 
-    const types::global_dof_index src_idx = local_to_global[idx];
-    // Use the read-only data cache.
-    values[idx] = __ldg(&src[src_idx]);
+    for (unsigned int c = 0; c < n_components_; ++c)
+      {
+        const types::global_dof_index src_idx =
+          local_to_global[idx + c * padding_length];
+        // Use the read-only data cache.
+        values[idx + c * tensor_dofs_per_cell] = __ldg(&src[src_idx]);
+      }
 
     __syncthreads();
 
-    internal::resolve_hanging_nodes<dim, fe_degree, false>(constraint_mask,
-                                                           values);
+    for (unsigned int c = 0; c < n_components_; ++c)
+      internal::resolve_hanging_nodes<dim, fe_degree, false>(
+        constraint_mask, values + c * tensor_dofs_per_cell);
   }
 
 
@@ -391,19 +487,23 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     distribute_local_to_global(Number *dst) const
   {
-    static_assert(n_components_ == 1, "This function only supports FE with one \
-                  components");
-    internal::resolve_hanging_nodes<dim, fe_degree, true>(constraint_mask,
-                                                          values);
+    for (unsigned int c = 0; c < n_components_; ++c)
+      internal::resolve_hanging_nodes<dim, fe_degree, true>(
+        constraint_mask, values + c * tensor_dofs_per_cell);
 
     const unsigned int idx = internal::compute_index<dim, n_q_points_1d>();
 
-    const types::global_dof_index destination_idx = local_to_global[idx];
-
-    if (use_coloring)
-      dst[destination_idx] += values[idx];
-    else
-      atomicAdd(&dst[destination_idx], values[idx]);
+    for (unsigned int c = 0; c < n_components_; ++c)
+      {
+        const types::global_dof_index destination_idx =
+          local_to_global[idx + c * padding_length];
+        const Number value = values[idx + c * tensor_dofs_per_cell];
+
+        if (use_coloring)
+          dst[destination_idx] += value;
+        else
+          atomicAdd(&dst[destination_idx], value);
+      }
   }
 
 
@@ -427,21 +527,30 @@ namespace CUDAWrappers
       n_q_points_1d,
       Number>
       evaluator_tensor_product(mf_object_id);
-    if (evaluate_val == true && evaluate_grad == true)
-      {
-        evaluator_tensor_product.value_and_gradient_at_quad_pts(values,
-                                                                gradients);
-        __syncthreads();
-      }
-    else if (evaluate_grad == true)
+    for (unsigned int c = 0; c < n_components_; ++c)
       {
-        evaluator_tensor_product.gradient_at_quad_pts(values, gradients);
-        __syncthreads();
-      }
-    else if (evaluate_val == true)
-      {
-        evaluator_tensor_product.value_at_quad_pts(values);
-        __syncthreads();
+        Number *values_c = values + c * n_q_points;
+        Number *gradients_c[dim];
+        for (unsigned int d = 0; d < dim; ++d)
+          gradients_c[d] = gradients[d] + c * n_q_points;
+
+        if (evaluate_val == true && evaluate_grad == true)
+          {
+            evaluator_tensor_product.value_and_gradient_at_quad_pts(
+              values_c, gradients_c);
+            __syncthreads();
+          }
+        else if (evaluate_grad == true)
+          {
+            evaluator_tensor_product.gradient_at_quad_pts(values_c,
+                                                          gradients_c);
+            __syncthreads();
+          }
+        else if (evaluate_val == true)
+          {
+            evaluator_tensor_product.value_at_quad_pts(values_c);
+            __syncthreads();
+          }
       }
   }
 
@@ -464,20 +573,29 @@ namespace CUDAWrappers
       n_q_points_1d,
       Number>
       evaluator_tensor_product(mf_object_id);
-    if (integrate_val == true && integrate_grad == true)
-      {
-        evaluator_tensor_product.integrate_value_and_gradient(values,
-                                                              gradients);
-      }
-    else if (integrate_val == true)
+    for (unsigned int c = 0; c < n_components_; ++c)
       {
-        evaluator_tensor_product.integrate_value(values);
-        __syncthreads();
-      }
-    else if (integrate_grad == true)
-      {
-        evaluator_tensor_product.integrate_gradient<false>(values, gradients);
-        __syncthreads();
+        Number *values_c = values + c * n_q_points;
+        Number *gradients_c[dim];
+        for (unsigned int d = 0; d < dim; ++d)
+          gradients_c[d] = gradients[d] + c * n_q_points;
+
+        if (integrate_val == true && integrate_grad == true)
+          {
+            evaluator_tensor_product.integrate_value_and_gradient(values_c,
+                                                                  gradients_c);
+          }
+        else if (integrate_val == true)
+          {
+            evaluator_tensor_product.integrate_value(values_c);
+            __syncthreads();
+          }
+        else if (integrate_grad == true)
+          {
+            evaluator_tensor_product.integrate_gradient<false>(values_c,
+                                                               gradients_c);
+            __syncthreads();
+          }
       }
   }
 
@@ -496,7 +614,10 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::get_value(
     const unsigned int q_point) const
   {
-    return values[q_point];
+    value_type value;
+    for (unsigned int c = 0; c < n_components_; ++c)
+      Types::component(value, c) = values[q_point + c * n_q_points];
+    return value;
   }
 
 
@@ -515,7 +636,10 @@ namespace CUDAWrappers
     get_value() const
   {
     const unsigned int q_point = internal::compute_index<dim, n_q_points_1d>();
-    return values[q_point];
+    value_type         value;
+    for (unsigned int c = 0; c < n_components_; ++c)
+      Types::component(value, c) = values[q_point + c * n_q_points];
+    return value;
   }
 
 
@@ -533,7 +657,10 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     get_dof_value(const unsigned int dof) const
   {
-    return values[dof];
+    value_type value;
+    for (unsigned int c = 0; c < n_components_; ++c)
+      Types::component(value, c) = values[dof + c * tensor_dofs_per_cell];
+    return value;
   }
 
 
@@ -552,7 +679,10 @@ namespace CUDAWrappers
     get_dof_value() const
   {
     const unsigned int dof = internal::compute_index<dim, fe_degree + 1>();
-    return values[dof];
+    value_type         value;
+    for (unsigned int c = 0; c < n_components_; ++c)
+      Types::component(value, c) = values[dof + c * tensor_dofs_per_cell];
+    return value;
   }
 
 
@@ -566,7 +696,9 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     submit_value(const value_type &val_in, const unsigned int q_point)
   {
-    values[q_point] = val_in * JxW[q_point];
+    for (unsigned int c = 0; c < n_components_; ++c)
+      values[q_point + c * n_q_points] =
+        Types::component(val_in, c) * JxW[q_point];
   }
 
 
@@ -581,7 +713,9 @@ namespace CUDAWrappers
     submit_value(const value_type &val_in)
   {
     const unsigned int q_point = internal::compute_index<dim, n_q_points_1d>();
-    values[q_point]            = val_in * JxW[q_point];
+    for (unsigned int c = 0; c < n_components_; ++c)
+      values[q_point + c * n_q_points] =
+        Types::component(val_in, c) * JxW[q_point];
   }
 
 
@@ -595,7 +729,8 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     submit_dof_value(const value_type &val_in, const unsigned int dof)
   {
-    values[dof] = val_in;
+    for (unsigned int c = 0; c < n_components_; ++c)
+      values[dof + c * tensor_dofs_per_cell] = Types::component(val_in, c);
   }
 
 
@@ -610,7 +745,8 @@ namespace CUDAWrappers
     submit_dof_value(const value_type &val_in)
   {
     const unsigned int dof = internal::compute_index<dim, fe_degree + 1>();
-    values[dof]            = val_in;
+    for (unsigned int c = 0; c < n_components_; ++c)
+      values[dof + c * tensor_dofs_per_cell] = Types::component(val_in, c);
   }
 
 
@@ -628,19 +764,18 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     get_gradient(const unsigned int q_point) const
   {
-    static_assert(n_components_ == 1, "This function only supports FE with one \
-                  components");
     // TODO optimize if the mesh is uniform
     const Number *inv_jacobian = &inv_jac[q_point];
     gradient_type grad;
-    for (int d_1 = 0; d_1 < dim; ++d_1)
-      {
-        Number tmp = 0.;
-        for (int d_2 = 0; d_2 < dim; ++d_2)
-          tmp += inv_jacobian[padding_length * n_cells * (dim * d_2 + d_1)] *
-                 gradients[d_2][q_point];
-        grad[d_1] = tmp;
-      }
+    for (unsigned int c = 0; c < n_components_; ++c)
+      for (int d_1 = 0; d_1 < dim; ++d_1)
+        {
+          Number tmp = 0.;
+          for (int d_2 = 0; d_2 < dim; ++d_2)
+            tmp += inv_jacobian[padding_length * n_cells * (dim * d_2 + d_1)] *
+                   gradients[d_2][q_point + c * n_q_points];
+          Types::component(grad, c)[d_1] = tmp;
+        }
 
     return grad;
   }
@@ -660,21 +795,19 @@ namespace CUDAWrappers
   FEEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
     get_gradient() const
   {
-    static_assert(n_components_ == 1, "This function only supports FE with one \
-                  components");
-
     // TODO optimize if the mesh is uniform
     const unsigned int q_point = internal::compute_index<dim, n_q_points_1d>();
     const Number *     inv_jacobian = &inv_jac[q_point];
     gradient_type      grad;
-    for (int d_1 = 0; d_1 < dim; ++d_1)
-      {
-        Number tmp = 0.;
-        for (int d_2 = 0; d_2 < dim; ++d_2)
-          tmp += inv_jacobian[padding_length * n_cells * (dim * d_2 + d_1)] *
-                 gradients[d_2][q_point];
-        grad[d_1] = tmp;
-      }
+    for (unsigned int c = 0; c < n_components_; ++c)
+      for (int d_1 = 0; d_1 < dim; ++d_1)
+        {
+          Number tmp = 0.;
+          for (int d_2 = 0; d_2 < dim; ++d_2)
+            tmp += inv_jacobian[padding_length * n_cells * (dim * d_2 + d_1)] *
+                   gradients[d_2][q_point + c * n_q_points];
+          Types::component(grad, c)[d_1] = tmp;
+        }
 
     return grad;
   }
@@ -692,14 +825,15 @@ namespace CUDAWrappers
   {
     // TODO optimize if the mesh is uniform
     const Number *inv_jacobian = &inv_jac[q_point];
-    for (int d_1 = 0; d_1 < dim; ++d_1)
-      {
-        Number tmp = 0.;
-        for (int d_2 = 0; d_2 < dim; ++d_2)
-          tmp += inv_jacobian[n_cells * padding_length * (dim * d_1 + d_2)] *
-                 grad_in[d_2];
-        gradients[d_1][q_point] = tmp * JxW[q_point];
-      }
+    for (unsigned int c = 0; c < n_components_; ++c)
+      for (int d_1 = 0; d_1 < dim; ++d_1)
+        {
+          Number tmp = 0.;
+          for (int d_2 = 0; d_2 < dim; ++d_2)
+            tmp += inv_jacobian[n_cells * padding_length * (dim * d_1 + d_2)] *
+                   Types::component(grad_in, c)[d_2];
+          gradients[d_1][q_point + c * n_q_points] = tmp * JxW[q_point];
+        }
   }
 
 
@@ -716,14 +850,15 @@ namespace CUDAWrappers
     // TODO optimize if the mesh is uniform
     const unsigned int q_point = internal::compute_index<dim, n_q_points_1d>();
     const Number *     inv_jacobian = &inv_jac[q_point];
-    for (int d_1 = 0; d_1 < dim; ++d_1)
-      {
-        Number tmp = 0.;
-        for (int d_2 = 0; d_2 < dim; ++d_2)
-          tmp += inv_jacobian[n_cells * padding_length * (dim * d_1 + d_2)] *
-                 grad_in[d_2];
-        gradients[d_1][q_point] = tmp * JxW[q_point];
-      }
+    for (unsigned int c = 0; c < n_components_; ++c)
+      for (int d_1 = 0; d_1 < dim; ++d_1)
+        {
+          Number tmp = 0.;
+          for (int d_2 = 0; d_2 < dim; ++d_2)
+            tmp += inv_jacobian[n_cells * padding_length * (dim * d_1 + d_2)] *
+                   Types::component(grad_in, c)[d_2];
+          gradients[d_1][q_point + c * n_q_points] = tmp * JxW[q_point];
+        }
   }
 
 
@@ -72,6 +72,13 @@ namespace CUDAWrappers
    * This class traverse the cells in a different order than the usual
    * Triangulation class in deal.II.
    *
+   * Besides scalar elements, this class supports an FESystem consisting of
+   * several copies of the same scalar element, e.g., FESystem<dim>(FE_Q<dim>
+   * (degree), dim) for a vector Laplacian or linear elasticity, which is then
+   * evaluated with an FEEvaluation object with the respective number of
+   * components. Hanging node constraints are only supported for scalar
+   * elements.
+   *
    * @note Only float and double are supported.
    *
    * @ingroup CUDAWrappers
@@ -487,6 +494,13 @@ namespace CUDAWrappers
      */
     unsigned int fe_degree;
 
+    /**
+     * Number of components of the finite element used. For more than one
+     * component, the indices of the degrees of freedom of each cell are
+     * stored component by component, each with a length of padding_length.
+     */
+    unsigned int n_components;
+
     /**
      * Number of degrees of freedom per cell.
      */
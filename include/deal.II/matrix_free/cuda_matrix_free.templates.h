@@ -25,6 +25,7 @@
 
 #  include <deal.II/base/cuda_size.h>
 #  include <deal.II/base/graph_coloring.h>
+#  include <deal.II/base/utilities.h>
 
 #  include <deal.II/dofs/dof_tools.h>
 
@@ -240,6 +241,7 @@ namespace CUDAWrappers
       const std::vector<unsigned int> &    lexicographic_inv;
       std::vector<types::global_dof_index> lexicographic_dof_indices;
       const unsigned int                   fe_degree;
+      const unsigned int                   n_components;
       const unsigned int                   dofs_per_cell;
       const unsigned int                   q_points_per_cell;
       const UpdateFlags &                  update_flags;
@@ -261,6 +263,7 @@ namespace CUDAWrappers
       const UpdateFlags &    update_flags)
       : data(data)
       , fe_degree(data->fe_degree)
+      , n_components(data->n_components)
       , dofs_per_cell(data->dofs_per_cell)
       , q_points_per_cell(data->q_points_per_cell)
       , fe_values(mapping,
@@ -340,7 +343,7 @@ namespace CUDAWrappers
       else
         data->block_dim[color] = dim3(cells_per_block);
 
-      local_to_global_host.resize(n_cells * padding_length);
+      local_to_global_host.resize(n_cells * padding_length * n_components);
 
       if (update_flags & update_quadrature_points)
         q_points_host.resize(n_cells * padding_length);
@@ -375,14 +378,24 @@ namespace CUDAWrappers
       for (unsigned int i = 0; i < dofs_per_cell; ++i)
         lexicographic_dof_indices[i] = local_dof_indices[lexicographic_inv[i]];
 
-      hanging_nodes.setup_constraints(lexicographic_dof_indices,
-                                      cell,
-                                      partitioner,
-                                      constraint_mask_host[cell_id]);
+      // hanging nodes are only supported for scalar elements, which is
+      // checked in MatrixFree::internal_reinit()
+      if (n_components == 1)
+        hanging_nodes.setup_constraints(lexicographic_dof_indices,
+                                        cell,
+                                        partitioner,
+                                        constraint_mask_host[cell_id]);
+      else
+        constraint_mask_host[cell_id] = 0;
 
-      memcpy(&local_to_global_host[cell_id * padding_length],
-             lexicographic_dof_indices.data(),
-             dofs_per_cell * sizeof(types::global_dof_index));
+      // the lexicographic numbering of a system runs over the components one
+      // after another, so each component gets its own padded slot
+      const unsigned int dofs_per_component = dofs_per_cell / n_components;
+      for (unsigned int c = 0; c < n_components; ++c)
+        memcpy(&local_to_global_host[(cell_id * n_components + c) *
+                                     padding_length],
+               lexicographic_dof_indices.data() + c * dofs_per_component,
+               dofs_per_component * sizeof(types::global_dof_index));
 
       fe_values.reinit(cell);
 
@@ -427,13 +440,15 @@ namespace CUDAWrappers
       // Local-to-global mapping
       if (data->parallelization_scheme ==
           MatrixFree<dim, Number>::parallel_over_elem)
-        transpose_in_place(local_to_global_host, n_cells, padding_length);
+        transpose_in_place(local_to_global_host,
+                           n_cells,
+                           padding_length * n_components);
 
       alloc_and_copy(
         &data->local_to_global[color],
         ArrayView<const types::global_dof_index>(local_to_global_host.data(),
                                                  local_to_global_host.size()),
-        n_cells * padding_length);
+        n_cells * padding_length * n_components);
 
       // Quadrature points
       if (update_flags & update_quadrature_points)
@@ -562,10 +577,14 @@ namespace CUDAWrappers
       constexpr unsigned int cells_per_block =
         cells_per_block_shmem(dim, Functor::n_dofs_1d - 1);
 
+      // for systems, the values and gradients of all components are stored
+      // one after another
+      constexpr unsigned int n_components =
+        Functor::n_local_dofs / Utilities::pow(Functor::n_dofs_1d, dim);
       constexpr unsigned int n_dofs_per_block =
         cells_per_block * Functor::n_local_dofs;
       constexpr unsigned int n_q_points_per_block =
-        cells_per_block * Functor::n_q_points;
+        cells_per_block * Functor::n_q_points * n_components;
       // TODO make use of dynamically allocated shared memory
       __shared__ Number values[n_dofs_per_block];
       __shared__ Number gradients[dim][n_q_points_per_block];
@@ -576,7 +595,7 @@ namespace CUDAWrappers
 
       Number *gq[dim];
       for (int d = 0; d < dim; ++d)
-        gq[d] = &gradients[d][local_cell * Functor::n_q_points];
+        gq[d] = &gradients[d][local_cell * Functor::n_q_points * n_components];
 
       SharedData<dim, Number> shared_data(
         &values[local_cell * Functor::n_local_dofs], gq);
@@ -829,7 +848,8 @@ namespace CUDAWrappers
     // For each color, add local_to_global, inv_jacobian, JxW, and q_points.
     for (unsigned int i = 0; i < n_colors; ++i)
       {
-        bytes += n_cells[i] * padding_length * sizeof(unsigned int) +
+        bytes += n_cells[i] * padding_length * n_components *
+                   sizeof(unsigned int) +
                  n_cells[i] * padding_length * dim * dim * sizeof(Number) +
                  n_cells[i] * padding_length * sizeof(Number) +
                  n_cells[i] * padding_length * sizeof(point_type) +
@@ -873,6 +893,15 @@ namespace CUDAWrappers
     const FiniteElement<dim> &fe = dof_handler.get_fe();
 
     fe_degree = fe.degree;
+
+    n_components = fe.n_components();
+    AssertThrow(fe.n_base_elements() == 1,
+                ExcMessage("Only scalar elements or systems consisting of "
+                           "copies of the same scalar element are supported."));
+    AssertThrow(n_components == 1 ||
+                  dof_handler.get_triangulation().has_hanging_nodes() == false,
+                ExcMessage("Hanging nodes are only supported for scalar "
+                           "elements."));
     // TODO this should be a templated parameter
     const unsigned int n_dofs_1d     = fe_degree + 1;
     const unsigned int n_q_points_1d = quad.size();
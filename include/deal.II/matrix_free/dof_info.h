@@ -166,11 +166,21 @@ namespace internal
        * processor, get a temporary number by this function, and will later be
        * assigned the correct index after all the ghost indices have been
        * collected by the call to @p assign_ghosts.
+       *
+       * The indices @p local_indices_resolved are the ones used for the
+       * access with constraints, whereas @p local_indices are the plain
+       * indices of the cell. Both coincide unless the hanging-node
+       * constraints on the cell are resolved within FEEvaluation, which is
+       * indicated by @p cell_has_hanging_nodes, in which case the resolved
+       * indices contain the indices of the coarser neighbor in the
+       * constrained positions.
        */
       template <typename number>
       void
       read_dof_indices(
+        const std::vector<types::global_dof_index> &local_indices_resolved,
         const std::vector<types::global_dof_index> &local_indices,
+        const bool                                  cell_has_hanging_nodes,
         const std::vector<unsigned int> &           lexicographic_inv,
         const dealii::AffineConstraints<number> &   constraints,
         const unsigned int                          cell_number,
@@ -314,6 +324,23 @@ namespace internal
          * `row_starts[cell_index*n_vectorization*n_components].first`.
          */
         interleaved,
+        /**
+         * This value indicates the same interleaved storage as
+         * `interleaved`, but with the indices on each lane of the vectorized
+         * array stored as 16-bit offsets relative to the smallest index of
+         * the cell on that lane. This is possible for cells whose indices
+         * span less than $2^{16}$ entries, which is the typical case for
+         * continuous elements with a numbering that preserves locality, and
+         * halves the memory transfer for the indices compared to
+         * `interleaved`. For a cell of this index type, the data access in
+         * FEEvaluationBase is directed to the array
+         * `dof_indices_interleaved_compressed` with the index
+         * `row_starts[cell_index*n_vectorization*n_components].first`, with
+         * the smallest index of each lane stored in the array
+         * `dof_indices_contiguous` at the index
+         * `cell_index*n_vectorization`.
+         */
+        interleaved_compressed,
         /**
          * This value indicates that the indices within a cell are all
          * contiguous, and one can get the index to the cell by reading that
@@ -462,6 +489,14 @@ namespace internal
        */
       std::vector<unsigned int> dof_indices_interleaved;
 
+      /**
+       * Reordered index storage for
+       * `IndexStorageVariants::interleaved_compressed`, holding the offsets
+       * of the indices relative to the smallest index on the respective
+       * lane.
+       */
+      std::vector<unsigned short> dof_indices_interleaved_compressed;
+
       /**
        * Compressed index storage for faster access than through @p
        * dof_indices used according to the description in IndexStorageVariants.
@@ -544,6 +579,17 @@ namespace internal
        */
       std::vector<unsigned int> plain_dof_indices;
 
+      /**
+       * Stores the configuration of hanging nodes on each cell in terms of
+       * the bit mask used by internal::MatrixFreeFunctions::HangingNodes,
+       * with the same index as the @p row_starts_plain_indices field. A
+       * value of zero means that the cell either has no hanging nodes or
+       * that they are resolved by the general constraint pool. This field
+       * is empty if no cell has its hanging-node constraints resolved
+       * within FEEvaluation.
+       */
+      std::vector<unsigned short> hanging_node_constraint_masks;
+
       /**
        * Stores the offset in terms of the number of base elements over all
        * DoFInfo objects.
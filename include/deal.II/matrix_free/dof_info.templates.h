@@ -31,6 +31,9 @@
 #include <deal.II/matrix_free/mapping_info.h>
 #include <deal.II/matrix_free/task_info.h>
 
+#include <algorithm>
+#include <limits>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace internal
@@ -126,7 +129,9 @@ namespace internal
       start_components.clear();
       row_starts_plain_indices.clear();
       plain_dof_indices.clear();
+      hanging_node_constraint_masks.clear();
       dof_indices_interleaved.clear();
+      dof_indices_interleaved_compressed.clear();
       for (unsigned int i = 0; i < 3; ++i)
         {
           index_storage_variants[i].clear();
@@ -176,7 +181,9 @@ namespace internal
           // shift for this cell within the block as compared to the next
           // one
           const bool has_constraints =
-            row_starts[ib].second != row_starts[ib + n_fe_components].second;
+            row_starts[ib].second != row_starts[ib + n_fe_components].second ||
+            (hanging_node_constraint_masks.size() > 0 &&
+             hanging_node_constraint_masks[cell * n_vectorization + v] != 0);
 
           auto do_copy = [&](const unsigned int *begin,
                              const unsigned int *end) {
@@ -212,7 +219,9 @@ namespace internal
     template <typename number>
     void
     DoFInfo::read_dof_indices(
+      const std::vector<types::global_dof_index> &local_indices_resolved,
       const std::vector<types::global_dof_index> &local_indices,
+      const bool                                  cell_has_hanging_nodes,
       const std::vector<unsigned int> &           lexicographic_inv,
       const dealii::AffineConstraints<number> &   constraints,
       const unsigned int                          cell_number,
@@ -246,7 +255,7 @@ namespace internal
                i++)
             {
               types::global_dof_index current_dof =
-                local_indices[lexicographic_inv[i]];
+                local_indices_resolved[lexicographic_inv[i]];
               const auto *entries_ptr =
                 constraints.get_constraint_entries(current_dof);
 
@@ -355,6 +364,7 @@ namespace internal
               (row_starts.size() - 1) / n_components + 1);
           row_starts_plain_indices[cell_number] = plain_dof_indices.size();
           const bool cell_has_constraints =
+            cell_has_hanging_nodes ||
             (row_starts[(cell_number + 1) * n_components].second >
              row_starts[cell_number * n_components].second);
           if (cell_has_constraints == true)
@@ -563,6 +573,10 @@ namespace internal
                                     numbers::invalid_unsigned_int);
           new_plain_indices.reserve(plain_dof_indices.size());
         }
+      std::vector<unsigned short> new_hanging_node_constraint_masks;
+      if (hanging_node_constraint_masks.size() > 0)
+        new_hanging_node_constraint_masks.resize(
+          vectorization_length * task_info.cell_partition_data.back(), 0);
 
       // copy the indices and the constraint indicators to the new data field,
       // where we will go through the cells in the renumbered way. in case the
@@ -602,9 +616,17 @@ namespace internal
                     new_constraint_indicator.push_back(
                       constraint_indicator[index]);
                 }
+              const bool cell_has_hanging_node_constraints =
+                hanging_node_constraint_masks.size() > 0 &&
+                hanging_node_constraint_masks[cell_no / n_components] != 0;
+              if (cell_has_hanging_node_constraints)
+                new_hanging_node_constraint_masks[i * vectorization_length +
+                                                  j] =
+                  hanging_node_constraint_masks[cell_no / n_components];
               if (store_plain_indices &&
-                  row_starts[cell_no].second !=
-                    row_starts[cell_no + n_components].second)
+                  (row_starts[cell_no].second !=
+                     row_starts[cell_no + n_components].second ||
+                   cell_has_hanging_node_constraints))
                 {
                   new_rowstart_plain[i * vectorization_length + j] =
                     new_plain_indices.size();
@@ -647,6 +669,7 @@ namespace internal
       new_constraint_indicator.swap(constraint_indicator);
       new_plain_indices.swap(plain_dof_indices);
       new_rowstart_plain.swap(row_starts_plain_indices);
+      new_hanging_node_constraint_masks.swap(hanging_node_constraint_masks);
 
 #ifdef DEBUG
       // sanity check 1: all indices should be smaller than the number of dofs
@@ -729,8 +752,6 @@ namespace internal
       dof_indices_contiguous[dof_access_cell].resize(
         irregular_cells.size() * vectorization_length,
         numbers::invalid_unsigned_int);
-      dof_indices_interleaved.resize(dof_indices.size(),
-                                     numbers::invalid_unsigned_int);
       dof_indices_interleave_strides[dof_access_cell].resize(
         irregular_cells.size() * vectorization_length,
         numbers::invalid_unsigned_int);
@@ -753,7 +774,9 @@ namespace internal
             {
               const unsigned int cell_no = i * vectorization_length + j;
               if (row_starts[cell_no * n_components].second !=
-                  row_starts[(cell_no + 1) * n_components].second)
+                    row_starts[(cell_no + 1) * n_components].second ||
+                  (hanging_node_constraint_masks.size() > 0 &&
+                   hanging_node_constraint_masks[cell_no] != 0))
                 {
                   has_constraints = true;
                   break;
@@ -992,7 +1015,11 @@ namespace internal
                 index_storage_variants[dof_access_cell][i])]++;
             }
 
-      // Step 4: Copy the interleaved indices into their own data structure
+      // Step 4: Check whether the indices on each lane of the interleaved
+      // cells span less than 2^16 entries, in which case we store them as
+      // 16-bit offsets relative to the smallest index on the lane, saved in
+      // dof_indices_contiguous, see IndexStorageVariants.
+      bool have_interleaved = false, have_interleaved_compressed = false;
       for (unsigned int i = 0; i < irregular_cells.size(); ++i)
         if (index_storage_variants[dof_access_cell][i] ==
             IndexStorageVariants::interleaved)
@@ -1009,24 +1036,84 @@ namespace internal
             const unsigned int *dof_indices =
               &this->dof_indices
                  [row_starts[i * vectorization_length * n_components].first];
-            unsigned int *interleaved_dof_indices =
-              &this->dof_indices_interleaved
+            unsigned int *index_base =
+              &dof_indices_contiguous[dof_access_cell]
+                                     [i * vectorization_length];
+            bool can_compress = ndofs > 0;
+            for (unsigned int j = 0; j < vectorization_length && can_compress;
+                 ++j)
+              {
+                const auto range =
+                  std::minmax_element(dof_indices + j * ndofs,
+                                      dof_indices + (j + 1) * ndofs);
+                index_base[j] = *range.first;
+                if (*range.second - *range.first >
+                    std::numeric_limits<unsigned short>::max())
+                  can_compress = false;
+              }
+            if (can_compress)
+              {
+                index_storage_variants[dof_access_cell][i] =
+                  IndexStorageVariants::interleaved_compressed;
+                have_interleaved_compressed = true;
+              }
+            else
+              {
+                std::fill(index_base,
+                          index_base + vectorization_length,
+                          numbers::invalid_unsigned_int);
+                have_interleaved = true;
+              }
+          }
+
+      // Step 5: Copy the interleaved indices into their own data structure,
+      // only allocating the arrays that are actually used
+      if (have_interleaved)
+        dof_indices_interleaved.resize(dof_indices.size(),
+                                       numbers::invalid_unsigned_int);
+      if (have_interleaved_compressed)
+        dof_indices_interleaved_compressed.resize(dof_indices.size());
+      for (unsigned int i = 0; i < irregular_cells.size(); ++i)
+        if (index_storage_variants[dof_access_cell][i] ==
+              IndexStorageVariants::interleaved ||
+            index_storage_variants[dof_access_cell][i] ==
+              IndexStorageVariants::interleaved_compressed)
+          {
+            const unsigned int ndofs =
+              dofs_per_cell[have_hp ? cell_active_fe_index[i] : 0];
+            const unsigned int *dof_indices =
+              &this->dof_indices
                  [row_starts[i * vectorization_length * n_components].first];
-            AssertDimension(this->dof_indices.size(),
-                            this->dof_indices_interleaved.size());
             AssertDimension(n_vectorization_lanes_filled[dof_access_cell][i],
                             vectorization_length);
-            AssertIndexRange(
-              row_starts[i * vectorization_length * n_components].first,
-              this->dof_indices_interleaved.size());
             AssertIndexRange(
               row_starts[i * vectorization_length * n_components].first +
                 ndofs * vectorization_length,
-              this->dof_indices_interleaved.size() + 1);
-            for (unsigned int k = 0; k < ndofs; ++k)
-              for (unsigned int j = 0; j < vectorization_length; ++j)
-                interleaved_dof_indices[k * vectorization_length + j] =
-                  dof_indices[j * ndofs + k];
+              this->dof_indices.size() + 1);
+            if (index_storage_variants[dof_access_cell][i] ==
+                IndexStorageVariants::interleaved)
+              {
+                unsigned int *interleaved_dof_indices =
+                  this->dof_indices_interleaved.data() +
+                  row_starts[i * vectorization_length * n_components].first;
+                for (unsigned int k = 0; k < ndofs; ++k)
+                  for (unsigned int j = 0; j < vectorization_length; ++j)
+                    interleaved_dof_indices[k * vectorization_length + j] =
+                      dof_indices[j * ndofs + k];
+              }
+            else
+              {
+                const unsigned int *index_base =
+                  &dof_indices_contiguous[dof_access_cell]
+                                         [i * vectorization_length];
+                unsigned short *compressed_dof_indices =
+                  this->dof_indices_interleaved_compressed.data() +
+                  row_starts[i * vectorization_length * n_components].first;
+                for (unsigned int k = 0; k < ndofs; ++k)
+                  for (unsigned int j = 0; j < vectorization_length; ++j)
+                    compressed_dof_indices[k * vectorization_length + j] =
+                      dof_indices[j * ndofs + k] - index_base[j];
+              }
           }
     }
 
@@ -1651,8 +1738,13 @@ namespace internal
       memory +=
         (row_starts.capacity() * sizeof(std::pair<unsigned int, unsigned int>));
       memory += MemoryConsumption::memory_consumption(dof_indices);
+      memory += MemoryConsumption::memory_consumption(dof_indices_interleaved);
+      memory += MemoryConsumption::memory_consumption(
+        dof_indices_interleaved_compressed);
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
       memory += MemoryConsumption::memory_consumption(plain_dof_indices);
+      memory +=
+        MemoryConsumption::memory_consumption(hanging_node_constraint_masks);
       memory += MemoryConsumption::memory_consumption(constraint_indicator);
       memory += MemoryConsumption::memory_consumption(*vector_partitioner);
       return memory;
@@ -1672,6 +1764,12 @@ namespace internal
       out << "       Memory dof indices:           ";
       task_info.print_memory_statistics(
         out, MemoryConsumption::memory_consumption(dof_indices));
+      out << "       Memory interleaved indices:   ";
+      task_info.print_memory_statistics(
+        out,
+        MemoryConsumption::memory_consumption(dof_indices_interleaved) +
+          MemoryConsumption::memory_consumption(
+            dof_indices_interleaved_compressed));
       out << "       Memory constraint indicators: ";
       task_info.print_memory_statistics(
         out, MemoryConsumption::memory_consumption(constraint_indicator));
@@ -99,13 +99,22 @@ namespace internal
    * identity) and FEEvaluationImplTransformToCollocation (which can be
    * transformed to a collocation space and can then use the identity in these
    * spaces), which both allow for shorter code.
+   *
+   * The last template argument selects the variant of the 1D kernels. It
+   * defaults to the choice of EvaluatorSelector for the given element type,
+   * but can be set to evaluate_symmetric_hierarchical for
+   * MatrixFreeFunctions::truncated_tensor in case the 1D shape functions
+   * have the symmetry of the Legendre basis, see
+   * UnivariateShapeData::symmetric_hierarchical.
    */
   template <MatrixFreeFunctions::ElementType type,
             int                              dim,
             int                              fe_degree,
             int                              n_q_points_1d,
             int                              n_components,
-            typename Number>
+            typename Number,
+            EvaluatorVariant variant =
+              EvaluatorSelector<type, (fe_degree + n_q_points_1d > 4)>::variant>
   struct FEEvaluationImpl
   {
     static void
@@ -137,9 +146,16 @@ namespace internal
             int                              fe_degree,
             int                              n_q_points_1d,
             int                              n_components,
-            typename Number>
+            typename Number,
+            EvaluatorVariant                 variant>
   inline void
-  FEEvaluationImpl<type, dim, fe_degree, n_q_points_1d, n_components, Number>::
+  FEEvaluationImpl<type,
+                   dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   variant>::
     evaluate(const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
              const Number *                                values_dofs_actual,
              Number *                                      values_quad,
@@ -154,8 +170,6 @@ namespace internal
         evaluate_hessians == false)
       return;
 
-    const EvaluatorVariant variant =
-      EvaluatorSelector<type, (fe_degree + n_q_points_1d > 4)>::variant;
     using Eval = EvaluatorTensorProduct<variant,
                                         dim,
                                         fe_degree + 1,
@@ -418,9 +432,16 @@ namespace internal
             int                              fe_degree,
             int                              n_q_points_1d,
             int                              n_components,
-            typename Number>
+            typename Number,
+            EvaluatorVariant                 variant>
   inline void
-  FEEvaluationImpl<type, dim, fe_degree, n_q_points_1d, n_components, Number>::
+  FEEvaluationImpl<type,
+                   dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   variant>::
     integrate(const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
               Number *                                      values_dofs_actual,
               Number *                                      values_quad,
@@ -430,8 +451,6 @@ namespace internal
               const bool                                    integrate_gradients,
               const bool add_into_values_array)
   {
-    const EvaluatorVariant variant =
-      EvaluatorSelector<type, (fe_degree + n_q_points_1d > 4)>::variant;
     using Eval = EvaluatorTensorProduct<variant,
                                         dim,
                                         fe_degree + 1,
@@ -1359,9 +1378,11 @@ namespace internal
                      Number *                                      values_dofs,
                      Number *                                      values_quad,
                      Number *           gradients_quad,
+                     Number *           hessians_quad,
                      Number *           scratch_data,
                      const bool         evaluate_val,
                      const bool         evaluate_grad,
+                     const bool         evaluate_hess,
                      const unsigned int subface_index)
     {
       const AlignedVector<Number> &val1 =
@@ -1390,6 +1411,19 @@ namespace internal
              data.data.front().shape_gradients :
              data.data.front().gradients_within_subface[subface_index / 2]);
 
+      const AlignedVector<Number> &hess1 =
+        symmetric_evaluate ?
+          data.data.front().shape_hessians_eo :
+          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+             data.data.front().shape_hessians :
+             data.data.front().hessians_within_subface[subface_index % 2]);
+      const AlignedVector<Number> &hess2 =
+        symmetric_evaluate ?
+          data.data.front().shape_hessians_eo :
+          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+             data.data.front().shape_hessians :
+             data.data.front().hessians_within_subface[subface_index / 2]);
+
       using Eval =
         internal::EvaluatorTensorProduct<symmetric_evaluate ?
                                            internal::evaluate_evenodd :
@@ -1400,12 +1434,12 @@ namespace internal
                                          Number>;
       Eval eval1(val1,
                  grad1,
-                 AlignedVector<Number>(),
+                 hess1,
                  data.data.front().fe_degree + 1,
                  data.data.front().n_q_points_1d);
       Eval eval2(val2,
                  grad2,
-                 AlignedVector<Number>(),
+                 hess2,
                  data.data.front().fe_degree + 1,
                  data.data.front().n_q_points_1d);
 
@@ -1420,6 +1454,71 @@ namespace internal
                                         Utilities::pow(n_q_points_1d, dim - 1) :
                                         data.n_q_points_face;
 
+      // the data on the face is given as the values, the normal derivatives,
+      // and in case of Hessians the second normal derivatives of the
+      // function, each of size size_deg
+      const unsigned int dofs_stride = (evaluate_hess ? 3 : 2) * size_deg;
+
+      // Hessians are computed in the coordinate system of the face, i.e., the
+      // tangential directions come first and the normal direction last, and
+      // stored in the order xx, yy, (zz,) xy, (xz, yz) as on cells
+      if (evaluate_hess)
+        {
+          const Number *dofs = values_dofs;
+          Number *      hess = hessians_quad;
+          for (unsigned int c = 0; c < n_components; ++c)
+            {
+              switch (dim)
+                {
+                  case 3:
+                    eval1.template hessians<0, true, false>(dofs,
+                                                            scratch_data);
+                    eval2.template values<1, true, false>(scratch_data, hess);
+                    eval1.template values<0, true, false>(dofs, scratch_data);
+                    eval2.template hessians<1, true, false>(scratch_data,
+                                                            hess + n_q_points);
+                    eval1.template values<0, true, false>(dofs + 2 * size_deg,
+                                                          scratch_data);
+                    eval2.template values<1, true, false>(scratch_data,
+                                                          hess +
+                                                            2 * n_q_points);
+                    eval1.template gradients<0, true, false>(dofs,
+                                                             scratch_data);
+                    eval2.template gradients<1, true, false>(scratch_data,
+                                                             hess +
+                                                               3 * n_q_points);
+                    eval1.template gradients<0, true, false>(dofs + size_deg,
+                                                             scratch_data);
+                    eval2.template values<1, true, false>(scratch_data,
+                                                          hess +
+                                                            4 * n_q_points);
+                    eval1.template values<0, true, false>(dofs + size_deg,
+                                                          scratch_data);
+                    eval2.template gradients<1, true, false>(scratch_data,
+                                                             hess +
+                                                               5 * n_q_points);
+                    break;
+                  case 2:
+                    eval1.template hessians<0, true, false>(dofs, hess);
+                    eval1.template values<0, true, false>(dofs + 2 * size_deg,
+                                                          hess + n_q_points);
+                    eval1.template gradients<0, true, false>(dofs + size_deg,
+                                                             hess +
+                                                               2 * n_q_points);
+                    break;
+                  case 1:
+                    hess[0] = dofs[2];
+                    break;
+                  default:
+                    AssertThrow(false, ExcNotImplemented());
+                }
+              dofs += dofs_stride;
+              hess += (dim * (dim + 1)) / 2 * n_q_points;
+            }
+          if (evaluate_val == false && evaluate_grad == false)
+            return;
+        }
+
       if (evaluate_grad == false)
         for (unsigned int c = 0; c < n_components; ++c)
           {
@@ -1441,7 +1540,7 @@ namespace internal
                 default:
                   Assert(false, ExcNotImplemented());
               }
-            values_dofs += 2 * size_deg;
+            values_dofs += dofs_stride;
             values_quad += n_q_points;
           }
       else
@@ -1512,7 +1611,7 @@ namespace internal
                 default:
                   AssertThrow(false, ExcNotImplemented());
               }
-            values_dofs += 2 * size_deg;
+            values_dofs += dofs_stride;
             values_quad += n_q_points;
             gradients_quad += dim * n_q_points;
           }
@@ -1699,7 +1798,7 @@ namespace internal
     interpolate(const MatrixFreeFunctions::ShapeInfo<Number> &data,
                 const Number *                                input,
                 Number *                                      output,
-                const bool                                    do_gradients,
+                const unsigned int                            max_derivative,
                 const unsigned int                            face_no)
     {
       internal::EvaluatorTensorProduct<internal::evaluate_general,
@@ -1713,16 +1812,30 @@ namespace internal
               data.data.front().fe_degree + 1,
               0);
 
-      const unsigned int in_stride = do_evaluate ?
-                                       data.dofs_per_component_on_cell :
-                                       2 * data.dofs_per_component_on_face;
-      const unsigned int out_stride = do_evaluate ?
-                                        2 * data.dofs_per_component_on_face :
-                                        data.dofs_per_component_on_cell;
+      // the face data of each component consists of the values and first
+      // normal derivatives, and the second normal derivatives if requested
+      const unsigned int face_stride =
+        (max_derivative > 1 ? 3 : 2) * data.dofs_per_component_on_face;
+      const unsigned int in_stride =
+        do_evaluate ? data.dofs_per_component_on_cell : face_stride;
+      const unsigned int out_stride =
+        do_evaluate ? face_stride : data.dofs_per_component_on_cell;
       const unsigned int face_direction = face_no / 2;
       for (unsigned int c = 0; c < n_components; c++)
         {
-          if (do_gradients)
+          if (max_derivative > 1)
+            {
+              if (face_direction == 0)
+                evalf.template apply_face<0, do_evaluate, add_into_output, 2>(
+                  input, output);
+              else if (face_direction == 1)
+                evalf.template apply_face<1, do_evaluate, add_into_output, 2>(
+                  input, output);
+              else
+                evalf.template apply_face<2, do_evaluate, add_into_output, 2>(
+                  input, output);
+            }
+          else if (max_derivative == 1)
             {
               if (face_direction == 0)
                 evalf.template apply_face<0, do_evaluate, add_into_output, 1>(
@@ -1873,9 +1986,11 @@ namespace internal
              const VectorizedArrayType *   values_array,
              VectorizedArrayType *         values_quad,
              VectorizedArrayType *         gradients_quad,
+             VectorizedArrayType *         hessians_quad,
              VectorizedArrayType *         scratch_data,
              const bool                    evaluate_values,
              const bool                    evaluate_gradients,
+             const bool                    evaluate_hessians,
              const unsigned int            face_no,
              const unsigned int            subface_index,
              const unsigned int            face_orientation,
@@ -1899,7 +2014,7 @@ namespace internal
 
       VectorizedArrayType
                            temp_data[static_dofs_per_face < stack_array_size_threshold ?
-                    n_components * 2ull * static_dofs_per_face :
+                    n_components * 3ull * static_dofs_per_face :
                     1];
       VectorizedArrayType *temp1;
       if (static_dofs_per_face < stack_array_size_threshold)
@@ -1912,7 +2027,11 @@ namespace internal
                                  n_components,
                                  VectorizedArrayType>::
         template interpolate<true, false>(
-          data, values_array, temp1, evaluate_gradients, face_no);
+          data,
+          values_array,
+          temp1,
+          evaluate_hessians ? 2 : (evaluate_gradients ? 1 : 0),
+          face_no);
 
       const unsigned int n_q_points_1d_actual =
         fe_degree > -1 ? n_q_points_1d : 0;
@@ -1929,11 +2048,13 @@ namespace internal
                                                  temp1,
                                                  values_quad,
                                                  gradients_quad,
-                                                 scratch_data + 2 *
+                                                 hessians_quad,
+                                                 scratch_data + 3 *
                                                                   n_components *
                                                                   dofs_per_face,
                                                  evaluate_values,
                                                  evaluate_gradients,
+                                                 evaluate_hessians,
                                                  subface_index);
       else
         FEFaceEvaluationImpl<
@@ -1946,11 +2067,13 @@ namespace internal
                                                  temp1,
                                                  values_quad,
                                                  gradients_quad,
-                                                 scratch_data + 2 *
+                                                 hessians_quad,
+                                                 scratch_data + 3 *
                                                                   n_components *
                                                                   dofs_per_face,
                                                  evaluate_values,
                                                  evaluate_gradients,
+                                                 evaluate_hessians,
                                                  subface_index);
 
       if (face_orientation)
@@ -1962,7 +2085,9 @@ namespace internal
                                     data.n_q_points_face,
                                     scratch_data,
                                     values_quad,
-                                    gradients_quad);
+                                    gradients_quad,
+                                    evaluate_hessians,
+                                    hessians_quad);
     }
 
     static void
@@ -2490,11 +2615,13 @@ namespace internal
                                                  temp1,
                                                  values_quad,
                                                  gradients_quad,
+                                                 nullptr,
                                                  scratch_data + 2 *
                                                                   n_components *
                                                                   dofs_per_face,
                                                  evaluate_values,
                                                  evaluate_gradients,
+                                                 false,
                                                  subface_index);
       else
         FEFaceEvaluationImpl<
@@ -2507,11 +2634,13 @@ namespace internal
                                                  temp1,
                                                  values_quad,
                                                  gradients_quad,
+                                                 nullptr,
                                                  scratch_data + 2 *
                                                                   n_components *
                                                                   dofs_per_face,
                                                  evaluate_values,
                                                  evaluate_gradients,
+                                                 false,
                                                  subface_index);
 
       if (face_orientation)
@@ -3017,7 +3146,9 @@ namespace internal
                                 const unsigned int            n_q_points,
                                 VectorizedArrayType *         tmp_values,
                                 VectorizedArrayType *         values_quad,
-                                VectorizedArrayType *         gradients_quad)
+                                VectorizedArrayType *         gradients_quad,
+                                const bool                    hessians = false,
+                                VectorizedArrayType *hessians_quad = nullptr)
     {
       Assert(face_orientation, ExcInternalError());
       const unsigned int *orientation = &orientation_map[face_orientation][0];
@@ -3049,6 +3180,20 @@ namespace internal
                   gradients_quad[(c * dim + d) * n_q_points + q] =
                     tmp_values[q];
               }
+          if (hessians == true)
+            for (unsigned int d = 0; d < (dim * (dim + 1)) / 2; ++d)
+              {
+                VectorizedArrayType *hess =
+                  hessians_quad + (c * (dim * (dim + 1)) / 2 + d) * n_q_points;
+                if (integrate)
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    tmp_values[q] = hess[orientation[q]];
+                else
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    tmp_values[orientation[q]] = hess[q];
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  hess[q] = tmp_values[q];
+              }
         }
     }
   };
@@ -21,6 +21,10 @@
 
 #include <deal.II/matrix_free/evaluation_kernels.h>
 
+#include <array>
+#include <type_traits>
+#include <utility>
+
 DEAL_II_NAMESPACE_OPEN
 
 #ifndef DOXYGEN
@@ -32,25 +36,38 @@ namespace internal
     // specialization of the FEEvaluationImpl* classes in case fe_degree
     // and n_q_points_1d are only given as runtime parameters.
     // The logic is the following:
-    // 1. Start with fe_degree=0, n_q_points_1d=0 and DEPTH=0.
-    // 2. If the current assumption on fe_degree doesn't match the runtime
-    //    parameter, increase fe_degree  by one and try again.
-    //    If fe_degree==10 use the class Default which serves as a fallback.
-    // 3. After fixing the fe_degree, DEPTH is increased (DEPTH=1) and we start
-    // with
-    //    n_q_points=fe_degree+1.
-    // 4. If the current assumption on n_q_points_1d doesn't match the runtime
-    //    parameter, increase n_q_points_1d by one and try again.
-    //    If n_q_points_1d==degree+3 use the class Default which serves as a
-    //    fallback.
+    // 1. For every degree between 0 and DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX,
+    //    which is set at configuration time, and for n_q_points_1d equal to
+    //    degree+1 and degree+2, the class Kernel provides the specialized
+    //    evaluate and integrate functions.
+    // 2. The class KernelTable collects pointers to these functions in a
+    //    table indexed by the degree and n_q_points_1d-degree-1, so that the
+    //    runtime parameters select the kernel with a single indirect call
+    //    instead of a chain of comparisons. The same table is used for the
+    //    non-tensor elements of type truncated_tensor and
+    //    tensor_symmetric_plus_dg0 with the kernels of class ElementKernel.
+    // 3. For all other combinations, the class Default serves as a fallback.
 
     /**
      * This class serves as a fallback in case we don't have the appropriate
      * template specialization for the run time and template parameters given.
+     * For symmetric tensor product elements, the general kernel is used,
+     * whereas the other element types use their own kernel with run time
+     * sizes.
      */
-    template <int dim, int n_components, typename Number>
+    template <int dim,
+              int n_components,
+              typename Number,
+              internal::MatrixFreeFunctions::ElementType type =
+                internal::MatrixFreeFunctions::tensor_symmetric>
     struct Default
     {
+      static constexpr internal::MatrixFreeFunctions::ElementType
+        fallback_type =
+          type == internal::MatrixFreeFunctions::tensor_symmetric ?
+            internal::MatrixFreeFunctions::tensor_general :
+            type;
+
       static inline void
       evaluate(
         const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
@@ -63,21 +80,20 @@ namespace internal
         const bool evaluate_gradients,
         const bool evaluate_hessians)
       {
-        internal::FEEvaluationImpl<
-          internal::MatrixFreeFunctions::tensor_general,
-          dim,
-          -1,
-          0,
-          n_components,
-          Number>::evaluate(shape_info,
-                            values_dofs_actual,
-                            values_quad,
-                            gradients_quad,
-                            hessians_quad,
-                            scratch_data,
-                            evaluate_values,
-                            evaluate_gradients,
-                            evaluate_hessians);
+        internal::FEEvaluationImpl<fallback_type,
+                                   dim,
+                                   -1,
+                                   0,
+                                   n_components,
+                                   Number>::evaluate(shape_info,
+                                                     values_dofs_actual,
+                                                     values_quad,
+                                                     gradients_quad,
+                                                     hessians_quad,
+                                                     scratch_data,
+                                                     evaluate_values,
+                                                     evaluate_gradients,
+                                                     evaluate_hessians);
       }
 
       static inline void
@@ -91,78 +107,196 @@ namespace internal
         const bool integrate_gradients,
         const bool sum_into_values_array = false)
       {
-        internal::FEEvaluationImpl<
-          internal::MatrixFreeFunctions::tensor_general,
-          dim,
-          -1,
-          0,
-          n_components,
-          Number>::integrate(shape_info,
-                             values_dofs_actual,
-                             values_quad,
-                             gradients_quad,
-                             scratch_data,
-                             integrate_values,
-                             integrate_gradients,
-                             sum_into_values_array);
+        internal::FEEvaluationImpl<fallback_type,
+                                   dim,
+                                   -1,
+                                   0,
+                                   n_components,
+                                   Number>::integrate(shape_info,
+                                                      values_dofs_actual,
+                                                      values_quad,
+                                                      gradients_quad,
+                                                      scratch_data,
+                                                      integrate_values,
+                                                      integrate_gradients,
+                                                      sum_into_values_array);
       }
     };
 
 
-    /**
-     * This class implements the actual choice of the template specialization.
-     */
-    template <int dim,
-              int n_components,
-              typename Number,
-              int DEPTH         = 0,
-              int degree        = 0,
-              int n_q_points_1d = 0,
-              class Enable      = void>
-    struct Factory : Default<dim, n_components, Number>
-    {};
-
-    /**
-     * This specialization sets the maximal fe_degree for
-     * which we want to determine the correct template parameters based at
-     * runtime.
-     */
-    template <int n_q_points_1d, int dim, int n_components, typename Number>
-    struct Factory<dim, n_components, Number, 0, 10, n_q_points_1d>
-      : Default<dim, n_components, Number>
-    {};
 
     /**
-     * This specialization sets the maximal number of n_q_points_1d for
-     * which we want to determine the correct template parameters based at
-     * runtime.
+     * This class implements the evaluation and integration for a fixed degree
+     * and number of quadrature points, choosing between the collocation, the
+     * transformation to collocation, and the general kernels for symmetric
+     * tensor product elements.
      */
-    template <int degree,
+    template <int dim,
+              int degree,
               int n_q_points_1d,
-              int dim,
               int n_components,
               typename Number>
-    struct Factory<dim,
-                   n_components,
-                   Number,
-                   1,
-                   degree,
-                   n_q_points_1d,
-                   typename std::enable_if<n_q_points_1d == degree + 3>::type>
-      : Default<dim, n_components, Number>
-    {};
+    struct Kernel
+    {
+      /**
+       * We enable a transformation to collocation for derivatives if it gives
+       * correct results (first condition), if it is the most efficient choice
+       * in terms of operation counts (second condition) and if we were able
+       * to initialize the fields in shape_info.templates.h from the
+       * polynomials (third condition).
+       */
+      static constexpr bool      use_collocation =
+        n_q_points_1d > degree &&n_q_points_1d <= 3 * degree / 2 + 1 &&
+        n_q_points_1d < 200;
+
+      static void
+      evaluate(
+        const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+        Number *   values_dofs_actual,
+        Number *   values_quad,
+        Number *   gradients_quad,
+        Number *   hessians_quad,
+        Number *   scratch_data,
+        const bool evaluate_values,
+        const bool evaluate_gradients,
+        const bool evaluate_hessians)
+      {
+        if (n_q_points_1d == degree + 1 &&
+            shape_info.element_type ==
+              internal::MatrixFreeFunctions::tensor_symmetric_collocation)
+          internal::
+            FEEvaluationImplCollocation<dim, degree, n_components, Number>::
+              evaluate(shape_info,
+                       values_dofs_actual,
+                       values_quad,
+                       gradients_quad,
+                       hessians_quad,
+                       scratch_data,
+                       evaluate_values,
+                       evaluate_gradients,
+                       evaluate_hessians);
+        else if (use_collocation)
+          internal::FEEvaluationImplTransformToCollocation<
+            dim,
+            degree,
+            n_q_points_1d,
+            n_components,
+            Number>::evaluate(shape_info,
+                              values_dofs_actual,
+                              values_quad,
+                              gradients_quad,
+                              hessians_quad,
+                              scratch_data,
+                              evaluate_values,
+                              evaluate_gradients,
+                              evaluate_hessians);
+        else
+          internal::FEEvaluationImpl<
+            internal::MatrixFreeFunctions::tensor_symmetric,
+            dim,
+            degree,
+            n_q_points_1d,
+            n_components,
+            Number>::evaluate(shape_info,
+                              values_dofs_actual,
+                              values_quad,
+                              gradients_quad,
+                              hessians_quad,
+                              scratch_data,
+                              evaluate_values,
+                              evaluate_gradients,
+                              evaluate_hessians);
+      }
+
+      static void
+      integrate(
+        const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+        Number *   values_dofs_actual,
+        Number *   values_quad,
+        Number *   gradients_quad,
+        Number *   scratch_data,
+        const bool integrate_values,
+        const bool integrate_gradients,
+        const bool sum_into_values_array)
+      {
+        if (n_q_points_1d == degree + 1 &&
+            shape_info.element_type ==
+              internal::MatrixFreeFunctions::tensor_symmetric_collocation)
+          internal::
+            FEEvaluationImplCollocation<dim, degree, n_components, Number>::
+              integrate(shape_info,
+                        values_dofs_actual,
+                        values_quad,
+                        gradients_quad,
+                        scratch_data,
+                        integrate_values,
+                        integrate_gradients,
+                        sum_into_values_array);
+        else if (use_collocation)
+          internal::FEEvaluationImplTransformToCollocation<
+            dim,
+            degree,
+            n_q_points_1d,
+            n_components,
+            Number>::integrate(shape_info,
+                               values_dofs_actual,
+                               values_quad,
+                               gradients_quad,
+                               scratch_data,
+                               integrate_values,
+                               integrate_gradients,
+                               sum_into_values_array);
+        else
+          internal::FEEvaluationImpl<
+            internal::MatrixFreeFunctions::tensor_symmetric,
+            dim,
+            degree,
+            n_q_points_1d,
+            n_components,
+            Number>::integrate(shape_info,
+                               values_dofs_actual,
+                               values_quad,
+                               gradients_quad,
+                               scratch_data,
+                               integrate_values,
+                               integrate_gradients,
+                               sum_into_values_array);
+      }
+    };
+
+
 
     /**
-     * This class chooses the correct template degree.
+     * This class implements the evaluation and integration for a fixed degree
+     * and number of quadrature points for the element types that are not
+     * plain tensor products, i.e., truncated_tensor and
+     * tensor_symmetric_plus_dg0. For truncated tensor products whose 1D shape
+     * functions alternate between even and odd functions on a symmetric
+     * quadrature formula, as detected by ShapeInfo and stored in
+     * UnivariateShapeData::symmetric_hierarchical, the kernel exploiting the
+     * symmetry of hierarchical bases is used, which saves almost half of the
+     * arithmetic operations compared to the general kernel.
      */
-    template <int degree,
-              int n_q_points_1d,
-              int dim,
-              int n_components,
+    template <internal::MatrixFreeFunctions::ElementType type,
+              int                                        dim,
+              int                                        degree,
+              int                                        n_q_points_1d,
+              int                                        n_components,
               typename Number>
-    struct Factory<dim, n_components, Number, 0, degree, n_q_points_1d>
+    struct ElementKernel
     {
-      static inline void
+      /**
+       * The variant used in case the 1D shape functions are symmetric
+       * hierarchical. For element types other than truncated_tensor, this is
+       * the default variant, so only a single kernel gets instantiated.
+       */
+      static constexpr internal::EvaluatorVariant hierarchical_variant =
+        type == internal::MatrixFreeFunctions::truncated_tensor ?
+          internal::evaluate_symmetric_hierarchical :
+          internal::EvaluatorSelector<type,
+                                      (degree + n_q_points_1d > 4)>::variant;
+
+      static void
       evaluate(
         const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
         Number *   values_dofs_actual,
@@ -174,10 +308,14 @@ namespace internal
         const bool evaluate_gradients,
         const bool evaluate_hessians)
       {
-        const unsigned int runtime_degree = shape_info.data.front().fe_degree;
-        constexpr unsigned int start_n_q_points = degree + 1;
-        if (runtime_degree == degree)
-          Factory<dim, n_components, Number, 1, degree, start_n_q_points>::
+        if (shape_info.data.front().symmetric_hierarchical)
+          internal::FEEvaluationImpl<type,
+                                     dim,
+                                     degree,
+                                     n_q_points_1d,
+                                     n_components,
+                                     Number,
+                                     hierarchical_variant>::
             evaluate(shape_info,
                      values_dofs_actual,
                      values_quad,
@@ -188,19 +326,23 @@ namespace internal
                      evaluate_gradients,
                      evaluate_hessians);
         else
-          Factory<dim, n_components, Number, 0, degree + 1, n_q_points_1d>::
-            evaluate(shape_info,
-                     values_dofs_actual,
-                     values_quad,
-                     gradients_quad,
-                     hessians_quad,
-                     scratch_data,
-                     evaluate_values,
-                     evaluate_gradients,
-                     evaluate_hessians);
+          internal::FEEvaluationImpl<type,
+                                     dim,
+                                     degree,
+                                     n_q_points_1d,
+                                     n_components,
+                                     Number>::evaluate(shape_info,
+                                                       values_dofs_actual,
+                                                       values_quad,
+                                                       gradients_quad,
+                                                       hessians_quad,
+                                                       scratch_data,
+                                                       evaluate_values,
+                                                       evaluate_gradients,
+                                                       evaluate_hessians);
       }
 
-      static inline void
+      static void
       integrate(
         const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
         Number *   values_dofs_actual,
@@ -209,12 +351,16 @@ namespace internal
         Number *   scratch_data,
         const bool integrate_values,
         const bool integrate_gradients,
-        const bool sum_into_values_array = false)
+        const bool sum_into_values_array)
       {
-        const int runtime_degree = shape_info.data.front().fe_degree;
-        constexpr unsigned int start_n_q_points = degree + 1;
-        if (runtime_degree == degree)
-          Factory<dim, n_components, Number, 1, degree, start_n_q_points>::
+        if (shape_info.data.front().symmetric_hierarchical)
+          internal::FEEvaluationImpl<type,
+                                     dim,
+                                     degree,
+                                     n_q_points_1d,
+                                     n_components,
+                                     Number,
+                                     hierarchical_variant>::
             integrate(shape_info,
                       values_dofs_actual,
                       values_quad,
@@ -224,45 +370,109 @@ namespace internal
                       integrate_gradients,
                       sum_into_values_array);
         else
-          Factory<dim, n_components, Number, 0, degree + 1, n_q_points_1d>::
-            integrate(shape_info,
-                      values_dofs_actual,
-                      values_quad,
-                      gradients_quad,
-                      scratch_data,
-                      integrate_values,
-                      integrate_gradients,
-                      sum_into_values_array);
+          internal::FEEvaluationImpl<type,
+                                     dim,
+                                     degree,
+                                     n_q_points_1d,
+                                     n_components,
+                                     Number>::integrate(shape_info,
+                                                        values_dofs_actual,
+                                                        values_quad,
+                                                        gradients_quad,
+                                                        scratch_data,
+                                                        integrate_values,
+                                                        integrate_gradients,
+                                                        sum_into_values_array);
       }
     };
 
+
+
     /**
-     * This class chooses the correct template n_q_points_1d after degree was
-     * chosen.
+     * This class holds the tables of pointers to the functions of Kernel
+     * (for symmetric tensor product elements) or ElementKernel (for the
+     * element type @p type otherwise) for all degrees between 0 and
+     * DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX and n_q_points_1d equal to degree+1
+     * and degree+2, and selects the entry corresponding to the runtime
+     * parameters in @p shape_info. If there is no such entry, the functions
+     * of Default are used.
      */
-    template <int degree,
-              int n_q_points_1d,
-              int dim,
+    template <int dim,
               int n_components,
-              typename Number>
-    struct Factory<dim,
-                   n_components,
-                   Number,
-                   1,
-                   degree,
-                   n_q_points_1d,
-                   typename std::enable_if<(n_q_points_1d < degree + 3)>::type>
+              typename Number,
+              internal::MatrixFreeFunctions::ElementType type =
+                internal::MatrixFreeFunctions::tensor_symmetric>
+    struct KernelTable
     {
+      template <int degree, int n_q_points_1d>
+      using KernelType = typename std::conditional<
+        type == internal::MatrixFreeFunctions::tensor_symmetric,
+        Kernel<dim, degree, n_q_points_1d, n_components, Number>,
+        ElementKernel<type, dim, degree, n_q_points_1d, n_components, Number>>::
+        type;
+
+      using EvaluateFunction =
+        void (*)(const internal::MatrixFreeFunctions::ShapeInfo<Number> &,
+                 Number *,
+                 Number *,
+                 Number *,
+                 Number *,
+                 Number *,
+                 const bool,
+                 const bool,
+                 const bool);
+
+      using IntegrateFunction =
+        void (*)(const internal::MatrixFreeFunctions::ShapeInfo<Number> &,
+                 Number *,
+                 Number *,
+                 Number *,
+                 Number *,
+                 const bool,
+                 const bool,
+                 const bool);
+
       /**
-       * We enable a transformation to collocation for derivatives if it gives
-       * correct results (first condition), if it is the most efficient choice
-       * in terms of operation counts (second condition) and if we were able
-       * to initialize the fields in shape_info.templates.h from the
-       * polynomials (third condition).
+       * The table of evaluate functions. The entry <code>[d][i]</code>
+       * corresponds to degree <code>d</code> and <code>d+1+i</code>
+       * quadrature points per direction.
        */
-      static constexpr bool      use_collocation =
-        n_q_points_1d > degree &&n_q_points_1d <= 3 * degree / 2 + 1 &&
-        n_q_points_1d < 200;
+      template <std::size_t... degrees>
+      static constexpr std::array<std::array<EvaluateFunction, 2>,
+                                  sizeof...(degrees)>
+      make_evaluate_table(std::index_sequence<degrees...>)
+      {
+        return {{{{&KernelType<degrees, degrees + 1>::evaluate,
+                   &KernelType<degrees, degrees + 2>::evaluate}}...}};
+      }
+
+      /**
+       * The table of integrate functions, with the same layout as the one
+       * returned by make_evaluate_table().
+       */
+      template <std::size_t... degrees>
+      static constexpr std::array<std::array<IntegrateFunction, 2>,
+                                  sizeof...(degrees)>
+      make_integrate_table(std::index_sequence<degrees...>)
+      {
+        return {{{{&KernelType<degrees, degrees + 1>::integrate,
+                   &KernelType<degrees, degrees + 2>::integrate}}...}};
+      }
+
+      /**
+       * Return whether there is a specialized kernel for the degree and the
+       * number of quadrature points stored in @p shape_info.
+       */
+      static bool
+      has_kernel(
+        const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info)
+      {
+        const unsigned int degree = shape_info.data.front().fe_degree;
+        const unsigned int n_q_points_1d =
+          shape_info.data.front().n_q_points_1d;
+        return degree <= DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX &&
+               n_q_points_1d >= degree + 1 && n_q_points_1d <= degree + 2;
+      }
 
       static inline void
       evaluate(
@@ -276,66 +486,37 @@ namespace internal
         const bool evaluate_gradients,
         const bool evaluate_hessians)
       {
-        const int runtime_n_q_points_1d = shape_info.data.front().n_q_points_1d;
-        if (runtime_n_q_points_1d == n_q_points_1d)
+        constexpr std::size_t n_degrees =
+          DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX + 1;
+        static constexpr std::array<std::array<EvaluateFunction, 2>, n_degrees>
+          table =
+            make_evaluate_table(std::make_index_sequence<n_degrees>());
+
+        if (has_kernel(shape_info))
           {
-            if (n_q_points_1d == degree + 1 &&
-                shape_info.element_type ==
-                  internal::MatrixFreeFunctions::tensor_symmetric_collocation)
-              internal::
-                FEEvaluationImplCollocation<dim, degree, n_components, Number>::
-                  evaluate(shape_info,
-                           values_dofs_actual,
-                           values_quad,
-                           gradients_quad,
-                           hessians_quad,
-                           scratch_data,
-                           evaluate_values,
-                           evaluate_gradients,
-                           evaluate_hessians);
-            else if (use_collocation)
-              internal::FEEvaluationImplTransformToCollocation<
-                dim,
-                degree,
-                n_q_points_1d,
-                n_components,
-                Number>::evaluate(shape_info,
-                                  values_dofs_actual,
-                                  values_quad,
-                                  gradients_quad,
-                                  hessians_quad,
-                                  scratch_data,
-                                  evaluate_values,
-                                  evaluate_gradients,
-                                  evaluate_hessians);
-            else
-              internal::FEEvaluationImpl<
-                internal::MatrixFreeFunctions::tensor_symmetric,
-                dim,
-                degree,
-                n_q_points_1d,
-                n_components,
-                Number>::evaluate(shape_info,
-                                  values_dofs_actual,
-                                  values_quad,
-                                  gradients_quad,
-                                  hessians_quad,
-                                  scratch_data,
-                                  evaluate_values,
-                                  evaluate_gradients,
-                                  evaluate_hessians);
+            const unsigned int degree = shape_info.data.front().fe_degree;
+            table[degree][shape_info.data.front().n_q_points_1d - degree - 1](
+              shape_info,
+              values_dofs_actual,
+              values_quad,
+              gradients_quad,
+              hessians_quad,
+              scratch_data,
+              evaluate_values,
+              evaluate_gradients,
+              evaluate_hessians);
           }
         else
-          Factory<dim, n_components, Number, 1, degree, n_q_points_1d + 1>::
-            evaluate(shape_info,
-                     values_dofs_actual,
-                     values_quad,
-                     gradients_quad,
-                     hessians_quad,
-                     scratch_data,
-                     evaluate_values,
-                     evaluate_gradients,
-                     evaluate_hessians);
+          Default<dim, n_components, Number, type>::evaluate(
+            shape_info,
+            values_dofs_actual,
+            values_quad,
+            gradients_quad,
+            hessians_quad,
+            scratch_data,
+            evaluate_values,
+            evaluate_gradients,
+            evaluate_hessians);
       }
 
       static inline void
@@ -349,62 +530,35 @@ namespace internal
         const bool integrate_gradients,
         const bool sum_into_values_array)
       {
-        const int runtime_n_q_points_1d = shape_info.data.front().n_q_points_1d;
-        if (runtime_n_q_points_1d == n_q_points_1d)
+        constexpr std::size_t n_degrees =
+          DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX + 1;
+        static constexpr std::array<std::array<IntegrateFunction, 2>, n_degrees>
+          table =
+            make_integrate_table(std::make_index_sequence<n_degrees>());
+
+        if (has_kernel(shape_info))
           {
-            if (n_q_points_1d == degree + 1 &&
-                shape_info.element_type ==
-                  internal::MatrixFreeFunctions::tensor_symmetric_collocation)
-              internal::
-                FEEvaluationImplCollocation<dim, degree, n_components, Number>::
-                  integrate(shape_info,
-                            values_dofs_actual,
-                            values_quad,
-                            gradients_quad,
-                            scratch_data,
-                            integrate_values,
-                            integrate_gradients,
-                            sum_into_values_array);
-            else if (use_collocation)
-              internal::FEEvaluationImplTransformToCollocation<
-                dim,
-                degree,
-                n_q_points_1d,
-                n_components,
-                Number>::integrate(shape_info,
-                                   values_dofs_actual,
-                                   values_quad,
-                                   gradients_quad,
-                                   scratch_data,
-                                   integrate_values,
-                                   integrate_gradients,
-                                   sum_into_values_array);
-            else
-              internal::FEEvaluationImpl<
-                internal::MatrixFreeFunctions::tensor_symmetric,
-                dim,
-                degree,
-                n_q_points_1d,
-                n_components,
-                Number>::integrate(shape_info,
-                                   values_dofs_actual,
-                                   values_quad,
-                                   gradients_quad,
-                                   scratch_data,
-                                   integrate_values,
-                                   integrate_gradients,
-                                   sum_into_values_array);
+            const unsigned int degree = shape_info.data.front().fe_degree;
+            table[degree][shape_info.data.front().n_q_points_1d - degree - 1](
+              shape_info,
+              values_dofs_actual,
+              values_quad,
+              gradients_quad,
+              scratch_data,
+              integrate_values,
+              integrate_gradients,
+              sum_into_values_array);
           }
         else
-          Factory<dim, n_components, Number, 1, degree, n_q_points_1d + 1>::
-            integrate(shape_info,
-                      values_dofs_actual,
-                      values_quad,
-                      gradients_quad,
-                      scratch_data,
-                      integrate_values,
-                      integrate_gradients,
-                      sum_into_values_array);
+          Default<dim, n_components, Number, type>::integrate(
+            shape_info,
+            values_dofs_actual,
+            values_quad,
+            gradients_quad,
+            scratch_data,
+            integrate_values,
+            integrate_gradients,
+            sum_into_values_array);
       }
     };
 
@@ -430,15 +584,15 @@ namespace internal
       Assert(shape_info.element_type <=
                internal::MatrixFreeFunctions::tensor_symmetric,
              ExcInternalError());
-      Factory<dim, n_components, Number>::evaluate(shape_info,
-                                                   values_dofs_actual,
-                                                   values_quad,
-                                                   gradients_quad,
-                                                   hessians_quad,
-                                                   scratch_data,
-                                                   evaluate_values,
-                                                   evaluate_gradients,
-                                                   evaluate_hessians);
+      KernelTable<dim, n_components, Number>::evaluate(shape_info,
+                                                       values_dofs_actual,
+                                                       values_quad,
+                                                       gradients_quad,
+                                                       hessians_quad,
+                                                       scratch_data,
+                                                       evaluate_values,
+                                                       evaluate_gradients,
+                                                       evaluate_hessians);
     }
 
 
@@ -462,14 +616,14 @@ namespace internal
       Assert(shape_info.element_type <=
                internal::MatrixFreeFunctions::tensor_symmetric,
              ExcInternalError());
-      Factory<dim, n_components, Number>::integrate(shape_info,
-                                                    values_dofs_actual,
-                                                    values_quad,
-                                                    gradients_quad,
-                                                    scratch_data,
-                                                    integrate_values,
-                                                    integrate_gradients,
-                                                    sum_into_values_array);
+      KernelTable<dim, n_components, Number>::integrate(shape_info,
+                                                        values_dofs_actual,
+                                                        values_quad,
+                                                        gradients_quad,
+                                                        scratch_data,
+                                                        integrate_values,
+                                                        integrate_gradients,
+                                                        sum_into_values_array);
     }
   } // namespace EvaluationSelectorImplementation
 } // namespace internal
@@ -484,8 +638,9 @@ namespace internal
  * pass these values to the respective template specializations.
  * Otherwise, we perform a runtime matching of the runtime parameters to find
  * the correct specialization. This matching currently supports
- * $0\leq fe\_degree \leq 9$ and $degree+1\leq n\_q\_points\_1d\leq
- * fe\_degree+2$.
+ * $0\leq fe\_degree \leq$ <code>DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX</code>,
+ * which is set when configuring deal.II and defaults to 9, and
+ * $degree+1\leq n\_q\_points\_1d\leq fe\_degree+2$.
  */
 template <int dim,
           int fe_degree,
@@ -547,9 +702,11 @@ struct SelectEvaluator
  * the selection is done based on the shape_info variable which contains
  * the relevant runtime parameters.
  * In case these parameters do not satisfy
- * $0\leq fe\_degree \leq 9$ and
- * $degree+1\leq n\_q\_points\_1d\leq fe\_degree+2$, a non-optimized fallback
- * is used.
+ * $0\leq fe\_degree \leq$ <code>DEAL_II_FE_EVAL_FACTORY_DEGREE_MAX</code>
+ * and $degree+1\leq n\_q\_points\_1d\leq fe\_degree+2$, a non-optimized
+ * fallback is used. The specialized kernels are selected through a table of
+ * function pointers, so the cost of the selection does not depend on the
+ * degree.
  */
 template <int dim, int n_q_points_1d, int n_components, typename Number>
 struct SelectEvaluator<dim, -1, n_q_points_1d, n_components, Number>
@@ -691,21 +848,22 @@ SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::evaluate(
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::truncated_tensor)
     {
-      internal::FEEvaluationImpl<
+      internal::EvaluationSelectorImplementation::ElementKernel<
         internal::MatrixFreeFunctions::truncated_tensor,
         dim,
         fe_degree,
         n_q_points_1d,
         n_components,
-        Number>::evaluate(shape_info,
-                          values_dofs_actual,
-                          values_quad,
-                          gradients_quad,
-                          hessians_quad,
-                          scratch_data,
-                          evaluate_values,
-                          evaluate_gradients,
-                          evaluate_hessians);
+        Number>::evaluate(
+          shape_info,
+          values_dofs_actual,
+          values_quad,
+          gradients_quad,
+          hessians_quad,
+          scratch_data,
+          evaluate_values,
+          evaluate_gradients,
+          evaluate_hessians);
     }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::tensor_general)
@@ -822,20 +980,21 @@ SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::integrate(
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::truncated_tensor)
     {
-      internal::FEEvaluationImpl<
+      internal::EvaluationSelectorImplementation::ElementKernel<
         internal::MatrixFreeFunctions::truncated_tensor,
         dim,
         fe_degree,
         n_q_points_1d,
         n_components,
-        Number>::integrate(shape_info,
-                           values_dofs_actual,
-                           values_quad,
-                           gradients_quad,
-                           scratch_data,
-                           integrate_values,
-                           integrate_gradients,
-                           sum_into_values_array);
+        Number>::integrate(
+          shape_info,
+          values_dofs_actual,
+          values_quad,
+          gradients_quad,
+          scratch_data,
+          integrate_values,
+          integrate_gradients,
+          sum_into_values_array);
     }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::tensor_general)
@@ -876,40 +1035,38 @@ SelectEvaluator<dim, -1, dummy, n_components, Number>::evaluate(
   if (shape_info.element_type ==
       internal::MatrixFreeFunctions::tensor_symmetric_plus_dg0)
     {
-      internal::FEEvaluationImpl<
-        internal::MatrixFreeFunctions::tensor_symmetric_plus_dg0,
+      internal::EvaluationSelectorImplementation::KernelTable<
         dim,
-        -1,
-        0,
         n_components,
-        Number>::evaluate(shape_info,
-                          values_dofs_actual,
-                          values_quad,
-                          gradients_quad,
-                          hessians_quad,
-                          scratch_data,
-                          evaluate_values,
-                          evaluate_gradients,
-                          evaluate_hessians);
+        Number,
+        internal::MatrixFreeFunctions::tensor_symmetric_plus_dg0>::evaluate(
+          shape_info,
+          values_dofs_actual,
+          values_quad,
+          gradients_quad,
+          hessians_quad,
+          scratch_data,
+          evaluate_values,
+          evaluate_gradients,
+          evaluate_hessians);
     }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::truncated_tensor)
     {
-      internal::FEEvaluationImpl<
-        internal::MatrixFreeFunctions::truncated_tensor,
+      internal::EvaluationSelectorImplementation::KernelTable<
         dim,
-        -1,
-        0,
         n_components,
-        Number>::evaluate(shape_info,
-                          values_dofs_actual,
-                          values_quad,
-                          gradients_quad,
-                          hessians_quad,
-                          scratch_data,
-                          evaluate_values,
-                          evaluate_gradients,
-                          evaluate_hessians);
+        Number,
+        internal::MatrixFreeFunctions::truncated_tensor>::evaluate(
+          shape_info,
+          values_dofs_actual,
+          values_quad,
+          gradients_quad,
+          hessians_quad,
+          scratch_data,
+          evaluate_values,
+          evaluate_gradients,
+          evaluate_hessians);
     }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::tensor_general)
@@ -957,38 +1114,36 @@ SelectEvaluator<dim, -1, dummy, n_components, Number>::integrate(
   if (shape_info.element_type ==
       internal::MatrixFreeFunctions::tensor_symmetric_plus_dg0)
     {
-      internal::FEEvaluationImpl<
-        internal::MatrixFreeFunctions::tensor_symmetric_plus_dg0,
+      internal::EvaluationSelectorImplementation::KernelTable<
         dim,
-        -1,
-        0,
         n_components,
-        Number>::integrate(shape_info,
-                           values_dofs_actual,
-                           values_quad,
-                           gradients_quad,
-                           scratch_data,
-                           integrate_values,
-                           integrate_gradients,
-                           sum_into_values_array);
+        Number,
+        internal::MatrixFreeFunctions::tensor_symmetric_plus_dg0>::integrate(
+          shape_info,
+          values_dofs_actual,
+          values_quad,
+          gradients_quad,
+          scratch_data,
+          integrate_values,
+          integrate_gradients,
+          sum_into_values_array);
     }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::truncated_tensor)
     {
-      internal::FEEvaluationImpl<
-        internal::MatrixFreeFunctions::truncated_tensor,
+      internal::EvaluationSelectorImplementation::KernelTable<
         dim,
-        -1,
-        0,
         n_components,
-        Number>::integrate(shape_info,
-                           values_dofs_actual,
-                           values_quad,
-                           gradients_quad,
-                           scratch_data,
-                           integrate_values,
-                           integrate_gradients,
-                           sum_into_values_array);
+        Number,
+        internal::MatrixFreeFunctions::truncated_tensor>::integrate(
+          shape_info,
+          values_dofs_actual,
+          values_quad,
+          gradients_quad,
+          scratch_data,
+          integrate_values,
+          integrate_gradients,
+          sum_into_values_array);
     }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::tensor_general)
@@ -29,8 +29,10 @@
 
 #include <deal.II/lac/vector_operation.h>
 
+#include <deal.II/matrix_free/evaluation_flags.h>
 #include <deal.II/matrix_free/evaluation_kernels.h>
 #include <deal.II/matrix_free/evaluation_selector.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/mapping_data_on_the_fly.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/shape_info.h>
@@ -57,105 +59,6 @@ template <int dim,
 class FEEvaluation;
 
 
-/**
- * @brief The namespace for the EvaluationFlags enum
- *
- * This namespace contains the enum EvaluationFlags used in FEEvaluation
- * to control evaluation and integration of values, gradients, etc..
- */
-namespace EvaluationFlags
-{
-  /**
-   * @brief The EvaluationFlags enum
-   *
-   * This enum contains a set of flags used by FEEvaluation::integrate(),
-   * FEEvaluation::evaluate() and others to determine if values, gradients,
-   * hessians, or a combination of them is being used.
-   */
-  enum EvaluationFlags
-  {
-    /**
-     * Do not use or compute anything.
-     */
-    nothing = 0,
-    /**
-     * Use or evaluate values.
-     */
-    values = 0x1,
-    /**
-     * Use or evaluate gradients.
-     */
-    gradients = 0x2,
-    /**
-     * Use or evaluate hessians.
-     */
-    hessians = 0x4
-  };
-
-
-  /**
-   * Global operator which returns an object in which all bits are set which are
-   * either set in the first or the second argument. This operator exists since
-   * if it did not then the result of the bit-or <tt>operator |</tt> would be an
-   * integer which would in turn trigger a compiler warning when we tried to
-   * assign it to an object of type UpdateFlags.
-   *
-   * @ref EvaluationFlags
-   */
-  inline EvaluationFlags
-  operator|(const EvaluationFlags f1, const EvaluationFlags f2)
-  {
-    return static_cast<EvaluationFlags>(static_cast<unsigned int>(f1) |
-                                        static_cast<unsigned int>(f2));
-  }
-
-
-
-  /**
-   * Global operator which sets the bits from the second argument also in the
-   * first one.
-   *
-   * @ref EvaluationFlags
-   */
-  inline EvaluationFlags &
-  operator|=(EvaluationFlags &f1, const EvaluationFlags f2)
-  {
-    f1 = f1 | f2;
-    return f1;
-  }
-
-
-  /**
-   * Global operator which returns an object in which all bits are set which are
-   * set in the first as well as the second argument. This operator exists since
-   * if it did not then the result of the bit-and <tt>operator &</tt> would be
-   * an integer which would in turn trigger a compiler warning when we tried to
-   * assign it to an object of type UpdateFlags.
-   *
-   * @ref EvaluationFlags
-   */
-  inline EvaluationFlags operator&(const EvaluationFlags f1,
-                                   const EvaluationFlags f2)
-  {
-    return static_cast<EvaluationFlags>(static_cast<unsigned int>(f1) &
-                                        static_cast<unsigned int>(f2));
-  }
-
-
-  /**
-   * Global operator which clears all the bits in the first argument if they are
-   * not also set in the second argument.
-   *
-   * @ref EvaluationFlags
-   */
-  inline EvaluationFlags &
-  operator&=(EvaluationFlags &f1, const EvaluationFlags f2)
-  {
-    f1 = f1 & f2;
-    return f1;
-  }
-
-} // namespace EvaluationFlags
 
 /**
  * This is the base class for the FEEvaluation classes. This class is a base
@@ -346,6 +249,12 @@ public:
    * MatrixFree object and lead to a structure that does not effectively use
    * vectorization in the evaluate routines based on these values (instead,
    * VectorizedArray::size() same copies are worked on).
+   *
+   * @note On cells whose hanging-node constraints are resolved within this
+   * class (see MatrixFree::AdditionalData::use_fast_hanging_node_algorithm),
+   * the transposed interpolation is applied to the values on the degrees of
+   * freedom in place, i.e., the values returned by get_dof_value() change
+   * during this call.
    */
   template <typename VectorType>
   void
@@ -866,11 +775,25 @@ public:
    * Return an ArrayView to internal memory for temporary use. Note that some
    * of this memory is overwritten during evaluate() and integrate() calls so
    * do not assume it to be stable over those calls. The maximum size you can
-   * write into is 3*dofs_per_cell+2*n_q_points.
+   * write into is 3*dofs_per_cell+2*n_q_points. If
+   * MatrixFree::AdditionalData::share_evaluator_scratch_data is set, this
+   * memory is shared with all other evaluators of the current thread and
+   * gets overwritten also by their evaluate() and integrate() calls.
    */
   ArrayView<VectorizedArrayType>
   get_scratch_data() const;
 
+  /**
+   * Return the memory consumption of this object in bytes. This includes the
+   * arrays for the values on the degrees of freedom and the values,
+   * gradients, and Hessians on the quadrature points as well as the
+   * temporary memory used within evaluate() and integrate(), which is
+   * counted also if it is shared with other evaluators. The sum over all
+   * evaluators of a kernel gives its footprint in scratch memory.
+   */
+  std::size_t
+  memory_consumption() const;
+
   //@}
 
 protected:
@@ -993,6 +916,18 @@ protected:
   read_write_operation_global(const VectorOperation &operation,
                               VectorType *           vectors[]) const;
 
+  /**
+   * Apply the interpolation at hanging nodes to the values on the degrees of
+   * freedom of the cells in the current batch whose hanging-node constraints
+   * are resolved within this class rather than through the constraint pool,
+   * see MatrixFree::AdditionalData::use_fast_hanging_node_algorithm. For
+   * @p transpose equal to false, the values read from the coarser neighbor
+   * are interpolated to the constrained degrees of freedom, whereas the
+   * transposed operation is applied before summing into a vector.
+   */
+  void
+  apply_hanging_node_constraints(const bool transpose) const;
+
   /**
    * This is the general array for all data fields.
    */
@@ -1005,6 +940,11 @@ protected:
    */
   VectorizedArrayType *scratch_data;
 
+  /**
+   * The number of entries in the array pointed to by scratch_data.
+   */
+  unsigned int scratch_data_size;
+
   /**
    * This field stores the values for local degrees of freedom (e.g. after
    * reading out from a vector but before applying unit cell transformations
@@ -1144,6 +1084,17 @@ protected:
    */
   const Tensor<1, dim, VectorizedArrayType> *normal_x_jacobian;
 
+  /**
+   * A pointer to the gradients of the inverse Jacobian transformation of the
+   * present cell or face in the format of
+   * MappingInfoStorage::jacobian_gradients. Only set to a useful value on
+   * cells and faces of general shape if the Jacobian gradients have been
+   * requested by update_hessians or update_jacobian_grads, and used for
+   * computing Hessians.
+   */
+  const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
+    *jacobian_gradients;
+
   /**
    * A pointer to the quadrature weights of the underlying quadrature formula.
    */
@@ -2772,6 +2723,42 @@ private:
   void
   check_template_arguments(const unsigned int fe_no,
                            const unsigned int first_selected_component);
+
+  /**
+   * Compute the inverse Jacobians and JxW values on the quadrature points of
+   * the current cell batch from the support points of the mapping, for use
+   * with MatrixFree::AdditionalData::compute_jacobians_on_the_fly, and set
+   * the pointers in the base class to the result.
+   */
+  void
+  compute_jacobians_on_the_fly();
+
+  /**
+   * Inverse Jacobians on the quadrature points, filled in case they are
+   * computed on the fly.
+   */
+  AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobians_on_the_fly;
+
+  /**
+   * JxW values on the quadrature points, filled in case they are computed on
+   * the fly.
+   */
+  AlignedVector<VectorizedArrayType> JxW_on_the_fly;
+
+  /**
+   * Gradients of the inverse Jacobians on the quadrature points, filled in
+   * case they are computed on the fly and Hessians have been requested in
+   * the mapping update flags.
+   */
+  AlignedVector<
+    Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>>
+    jacobian_gradients_on_the_fly;
+
+  /**
+   * Temporary storage for the evaluation of the geometry in case the
+   * Jacobians are computed on the fly.
+   */
+  AlignedVector<VectorizedArrayType> geometry_scratch;
 };
 
 
@@ -2965,6 +2952,19 @@ public:
    * method is less efficient than the other reinit() method taking a
    * numbering of the faces because it needs to copy the data associated with
    * the faces to the cells in this call.
+   *
+   * This is the method to use within MatrixFree::loop_cell_centric(). If the
+   * present object was constructed with `is_interior_face == false`, it
+   * represents the neighbors of the cells in the batch across face @p
+   * face_number: read_dof_values() and gather_evaluate() read the vector
+   * entries of the neighbors and evaluate() interpolates them to the face as
+   * seen from the neighbors. This allows to compute the numerical flux of a
+   * discontinuous Galerkin method from both sides while only integrating on
+   * the cells of the batch, without any write to the neighbors. The exterior
+   * side does not support integration and is restricted to faces in standard
+   * orientation without hanging nodes, where all neighbors of a batch see the
+   * face with the same number. For lanes at the boundary, the values of the
+   * cell itself are returned.
    */
   void
   reinit(const unsigned int cell_batch_number, const unsigned int face_number);
@@ -2978,6 +2978,14 @@ public:
    * functions get_value(), get_gradient() or get_normal_derivative() give
    * useful information (unless these values have been set manually by
    * accessing the internal data pointers).
+   *
+   * If EvaluationFlags::hessians is given, the second derivatives are
+   * computed as well and can be queried by get_hessian(),
+   * get_hessian_diagonal(), and get_laplacian(). On faces that are not
+   * affine, this requires the Jacobian gradients on the faces, i.e.,
+   * update_hessians in the mapping update flags of the faces, which are only
+   * available for MappingQGeneric and derived classes and not in
+   * element-centric loops.
    */
   void
   evaluate(const EvaluationFlags::EvaluationFlags evaluation_flag);
@@ -3131,6 +3139,16 @@ public:
    * points is inaccurate and this value must be used instead.
    */
   const unsigned int n_q_points;
+
+private:
+  /**
+   * For the exterior side of a face visited through reinit(cell_batch_number,
+   * face_number), i.e., in an element-centric loop, the number of the face
+   * as seen from the neighboring cells. The degrees of freedom of the
+   * neighbors are interpolated to the face with this number. For all other
+   * cases, this variable is not used.
+   */
+  unsigned int neighbor_face_no;
 };
 
 
@@ -3231,6 +3249,7 @@ inline FEEvaluationBase<dim,
   , J_value(nullptr)
   , normal_vectors(nullptr)
   , normal_x_jacobian(nullptr)
+  , jacobian_gradients(nullptr)
   , quadrature_weights(
       mapping_data->descriptor[active_quad_index].quadrature_weights.begin())
   , cell(numbers::invalid_unsigned_int)
@@ -3328,6 +3347,7 @@ inline FEEvaluationBase<dim,
   , J_value(nullptr)
   , normal_vectors(nullptr)
   , normal_x_jacobian(nullptr)
+  , jacobian_gradients(nullptr)
   , quadrature_weights(nullptr)
   , cell(0)
   , cell_type(internal::MatrixFreeFunctions::general)
@@ -3409,6 +3429,7 @@ inline FEEvaluationBase<dim,
   , J_value(nullptr)
   , normal_vectors(nullptr)
   , normal_x_jacobian(nullptr)
+  , jacobian_gradients(nullptr)
   , quadrature_weights(
       other.matrix_info == nullptr ?
         nullptr :
@@ -3581,7 +3602,15 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   const unsigned int allocated_size =
     shift + n_components_ * dofs_per_component +
     (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points);
-  scratch_data_array->resize_fast(allocated_size);
+
+  // the temporary memory behind the values and derivatives can be shared
+  // with other evaluators, in which case it is not part of the local array
+  VectorizedArrayType *shared_scratch_data =
+    matrix_info != nullptr ? matrix_info->acquire_shared_scratch_data(shift) :
+                             nullptr;
+  scratch_data_array->resize_fast(shared_scratch_data != nullptr ?
+                                    allocated_size - shift :
+                                    allocated_size);
 
   // set the pointers to the correct position in the data array
   for (unsigned int c = 0; c < n_components_; ++c)
@@ -3601,11 +3630,14 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           scratch_data_array->begin() +
           n_components *
             ((dim + 1) * n_quadrature_points + dofs_per_component) +
-          (c * (dim * dim + dim) + d) * n_quadrature_points;
+          (c * (dim * dim + dim) / 2 + d) * n_quadrature_points;
     }
   scratch_data =
-    scratch_data_array->begin() + n_components_ * dofs_per_component +
-    (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points);
+    shared_scratch_data != nullptr ?
+      shared_scratch_data :
+      scratch_data_array->begin() + n_components_ * dofs_per_component +
+        (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points);
+  scratch_data_size = shift;
 }
 
 
@@ -3998,11 +4030,28 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       internal::check_vector_compatibility(*src[0], *dof_info);
     }
 
+  // The exterior side of a face in an element-centric loop reads the
+  // degrees of freedom of the neighbors of the cells in the current batch,
+  // which are not stored next to each other, so skip the fast paths based on
+  // the storage variant of the current cell batch below
+  const bool is_ecl_exterior =
+    is_face &&
+    dof_access_index ==
+      internal::MatrixFreeFunctions::DoFInfo::dof_access_cell &&
+    is_interior_face == false;
+  Assert(is_ecl_exterior == false ||
+           (std::is_same<VectorOperation,
+                         internal::VectorReader<Number, VectorizedArrayType>>::
+              value),
+         ExcMessage("The exterior side of a face in an element-centric loop "
+                    "can only read values."));
+
   // Case 2: contiguous indices which use reduced storage of indices and can
   // use vectorized load/store operations -> go to separate function
   AssertIndexRange(cell,
                    dof_info->index_storage_variants[dof_access_index].size());
-  if (dof_info->index_storage_variants
+  if (is_ecl_exterior == false &&
+      dof_info->index_storage_variants
         [is_face ? dof_access_index :
                    internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
         [cell] >=
@@ -4025,11 +4074,15 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   const unsigned int dofs_per_component =
     this->data->dofs_per_component_on_cell;
-  if (dof_info->index_storage_variants
-        [is_face ? dof_access_index :
-                   internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
-        [cell] ==
-      internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::interleaved)
+  if (is_ecl_exterior)
+    {
+      // go to the generic path below
+    }
+  else if (dof_info->index_storage_variants
+             [is_face ? dof_access_index :
+                        internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
+             [cell] == internal::MatrixFreeFunctions::DoFInfo::
+                         IndexStorageVariants::interleaved)
     {
       const unsigned int *dof_indices =
         dof_info->dof_indices_interleaved.data() +
@@ -4054,6 +4107,54 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
               dof_indices, *src[0], 0, values_dofs[comp][i], vector_selector);
       return;
     }
+  else if (dof_info->index_storage_variants
+             [is_face ? dof_access_index :
+                        internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
+             [cell] == internal::MatrixFreeFunctions::DoFInfo::
+                         IndexStorageVariants::interleaved_compressed)
+    {
+      // reconstruct the indices of all lanes from the 16-bit offsets and the
+      // smallest index on each lane before the gather/scatter operation
+      const unsigned int *index_base =
+        dof_info
+          ->dof_indices_contiguous
+            [internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
+          .data() +
+        cell * n_lanes;
+      const unsigned short *index_offsets =
+        dof_info->dof_indices_interleaved_compressed.data() +
+        dof_info->row_starts[cell * n_fe_components * n_lanes].first +
+        dof_info->component_dof_indices_offset[active_fe_index]
+                                              [first_selected_component] *
+          n_lanes;
+      unsigned int dof_indices[n_lanes];
+      if (n_components == 1 || n_fe_components == 1)
+        for (unsigned int i = 0; i < dofs_per_component;
+             ++i, index_offsets += n_lanes)
+          {
+            DEAL_II_OPENMP_SIMD_PRAGMA
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              dof_indices[v] = index_base[v] + index_offsets[v];
+            for (unsigned int comp = 0; comp < n_components; ++comp)
+              operation.process_dof_gather(dof_indices,
+                                           *src[comp],
+                                           0,
+                                           values_dofs[comp][i],
+                                           vector_selector);
+          }
+      else
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          for (unsigned int i = 0; i < dofs_per_component;
+               ++i, index_offsets += n_lanes)
+            {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                dof_indices[v] = index_base[v] + index_offsets[v];
+              operation.process_dof_gather(
+                dof_indices, *src[0], 0, values_dofs[comp][i], vector_selector);
+            }
+      return;
+    }
 
   const unsigned int *  dof_indices[n_lanes];
   VectorizedArrayType **values_dofs =
@@ -4068,8 +4169,19 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   bool has_constraints = false;
   if (is_face)
     {
-      if (dof_access_index ==
-          internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
+      if (is_ecl_exterior)
+        {
+          // lanes at the boundary have no neighbor; read the values of the
+          // cell itself to not access invalid memory
+          const std::array<unsigned int, n_lanes> neighbors =
+            this->get_cell_ids();
+          for (unsigned int v = 0; v < n_vectorization_actual; ++v)
+            cells_copied[v] = neighbors[v] != numbers::invalid_unsigned_int ?
+                                neighbors[v] :
+                                cell * n_lanes + v;
+        }
+      else if (dof_access_index ==
+               internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
         for (unsigned int v = 0; v < n_vectorization_actual; ++v)
           cells_copied[v] = cell * VectorizedArrayType::size() + v;
       cells = dof_access_index ==
@@ -4125,6 +4237,22 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
         dof_indices[v] = nullptr;
     }
 
+  // Cells whose hanging-node constraints are resolved within FEEvaluation
+  // store the indices of the coarser neighbor in the constrained positions,
+  // so they need the plain indices for read_dof_values_plain() and must skip
+  // the constrained positions in set_dof_values()
+  constexpr bool is_setter =
+    std::is_same<VectorOperation,
+                 internal::VectorSetter<Number, VectorizedArrayType>>::value;
+  const bool check_hanging_nodes =
+    dof_info->hanging_node_constraint_masks.size() > 0 &&
+    (apply_constraints == false || is_setter);
+  if (check_hanging_nodes)
+    for (unsigned int v = 0; v < n_vectorization_actual; ++v)
+      if (dof_info->hanging_node_constraint_masks
+            [is_face ? cells[v] : cell * n_lanes + v] != 0)
+        has_constraints = true;
+
   // Case where we have no constraints throughout the whole cell: Can go
   // through the list of DoFs directly
   if (!has_constraints)
@@ -4176,11 +4304,16 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       unsigned int next_index_indicators =
         dof_info->row_starts[cell_dof_index + 1].second;
 
+      const bool cell_has_hanging_nodes =
+        check_hanging_nodes &&
+        dof_info->hanging_node_constraint_masks[cell_index] != 0;
+
       // For read_dof_values_plain, redirect the dof_indices field to the
       // unconstrained indices
       if (apply_constraints == false &&
-          dof_info->row_starts[cell_dof_index].second !=
-            dof_info->row_starts[cell_dof_index + n_components_read].second)
+          (dof_info->row_starts[cell_dof_index].second !=
+             dof_info->row_starts[cell_dof_index + n_components_read].second ||
+           cell_has_hanging_nodes))
         {
           Assert(dof_info->row_starts_plain_indices[cell_index] !=
                    numbers::invalid_unsigned_int,
@@ -4193,6 +4326,16 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           next_index_indicators = index_indicators;
         }
 
+      // For set_dof_values, the positions constrained by hanging nodes are
+      // the ones where the plain indices differ from the resolved ones
+      const unsigned int *plain_indices =
+        (is_setter && cell_has_hanging_nodes) ?
+          dof_info->plain_dof_indices.data() +
+            dof_info->component_dof_indices_offset[active_fe_index]
+                                                  [first_selected_component] +
+            dof_info->row_starts_plain_indices[cell_index] :
+          nullptr;
+
       if (n_components == 1 || n_fe_components == 1)
         {
           unsigned int ind_local = 0;
@@ -4202,10 +4345,12 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                 dof_info->constraint_indicator[index_indicators];
               // run through values up to next constraint
               for (unsigned int j = 0; j < indicator.first; ++j)
-                for (unsigned int comp = 0; comp < n_components; ++comp)
-                  operation.process_dof(dof_indices[v][j],
-                                        *src[comp],
-                                        values_dofs[comp][ind_local + j][v]);
+                if (plain_indices == nullptr ||
+                    plain_indices[ind_local + j] == dof_indices[v][j])
+                  for (unsigned int comp = 0; comp < n_components; ++comp)
+                    operation.process_dof(dof_indices[v][j],
+                                          *src[comp],
+                                          values_dofs[comp][ind_local + j][v]);
 
               ind_local += indicator.first;
               dof_indices[v] += indicator.first;
@@ -4237,10 +4382,12 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           AssertIndexRange(ind_local, dofs_per_component + 1);
 
           for (; ind_local < dofs_per_component; ++dof_indices[v], ++ind_local)
-            for (unsigned int comp = 0; comp < n_components; ++comp)
-              operation.process_dof(*dof_indices[v],
-                                    *src[comp],
-                                    values_dofs[comp][ind_local][v]);
+            if (plain_indices == nullptr ||
+                plain_indices[ind_local] == *dof_indices[v])
+              for (unsigned int comp = 0; comp < n_components; ++comp)
+                operation.process_dof(*dof_indices[v],
+                                      *src[comp],
+                                      values_dofs[comp][ind_local][v]);
         }
       else
         {
@@ -4610,6 +4757,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                        std::bitset<VectorizedArrayType::size()>().flip(),
                        true);
 
+  apply_hanging_node_constraints(false);
+
 #  ifdef DEBUG
   dof_values_initialized = true;
 #  endif
@@ -4680,6 +4829,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       IsBlockVector<VectorType>::value>::get_vector_component(dst,
                                                               d + first_index);
 
+  apply_hanging_node_constraints(true);
+
   internal::VectorDistributorLocalToGlobal<Number, VectorizedArrayType>
     distributor;
   read_write_operation(distributor, dst_data, mask);
@@ -4721,6 +4872,75 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  apply_hanging_node_constraints(const bool transpose) const
+{
+  if (matrix_info == nullptr || dof_info == nullptr ||
+      dof_info->hanging_node_constraint_masks.empty())
+    return;
+
+  // collect the masks of the cells on the lanes
+  constexpr unsigned int n_lanes = VectorizedArrayType::size();
+  const unsigned int     n_vectorization_actual =
+    dof_info->n_vectorization_lanes_filled[dof_access_index][cell];
+  unsigned short masks[n_lanes];
+  bool           has_hanging_nodes = false;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    {
+      masks[v] = 0;
+      if (v >= n_vectorization_actual)
+        continue;
+      const unsigned int cell_index =
+        (!is_face ||
+         dof_access_index ==
+           internal::MatrixFreeFunctions::DoFInfo::dof_access_cell) ?
+          cell * n_lanes + v :
+          (is_interior_face ?
+             this->matrix_info->get_face_info(cell).cells_interior[v] :
+             this->matrix_info->get_face_info(cell).cells_exterior[v]);
+      if (cell_index == numbers::invalid_unsigned_int)
+        continue;
+      AssertIndexRange(cell_index,
+                       dof_info->hanging_node_constraint_masks.size());
+      masks[v] = dof_info->hanging_node_constraint_masks[cell_index];
+      if (masks[v] != 0)
+        has_hanging_nodes = true;
+    }
+  if (has_hanging_nodes == false)
+    return;
+
+  // apply the interpolation for each distinct mask in the batch in turn,
+  // writing only into the lanes with that mask
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    if (masks[v] != 0)
+      {
+        const unsigned short mask = masks[v];
+
+        std::bitset<VectorizedArrayType::size()> lanes;
+        for (unsigned int w = v; w < n_lanes; ++w)
+          if (masks[w] == mask)
+            {
+              lanes[w] = true;
+              masks[w] = 0;
+            }
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          internal::MatrixFreeFunctions::interpolate_hanging_nodes<dim>(
+            this->data->data.front(),
+            mask,
+            transpose,
+            lanes,
+            values_dofs[comp]);
+      }
+}
+
+
+
 /*------------------------------ access to data fields ----------------------*/
 
 template <int dim,
@@ -4747,8 +4967,32 @@ FEEvaluationBase<dim, n_components, Number, is_face, VectorizedArrayType>::
   get_scratch_data() const
 {
   return ArrayView<VectorizedArrayType>(
-    const_cast<VectorizedArrayType *>(scratch_data),
-    scratch_data_array->end() - scratch_data);
+    const_cast<VectorizedArrayType *>(scratch_data), scratch_data_size);
+}
+
+
+
+template <int dim,
+          int n_components,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline std::size_t
+FEEvaluationBase<dim, n_components, Number, is_face, VectorizedArrayType>::
+  memory_consumption() const
+{
+  std::size_t memory =
+    sizeof(*this) + scratch_data_array->memory_consumption() +
+    local_dof_indices.capacity() * sizeof(types::global_dof_index);
+
+  // add the temporary memory if it is not part of the local array but
+  // shared with other evaluators
+  const bool scratch_data_is_local =
+    scratch_data_array->size() >= scratch_data_size &&
+    scratch_data == scratch_data_array->end() - scratch_data_size;
+  if (scratch_data_is_local == false)
+    memory += scratch_data_size * sizeof(VectorizedArrayType);
+  return memory;
 }
 
 
@@ -5082,7 +5326,6 @@ inline Tensor<1, n_components_, Tensor<2, dim, VectorizedArrayType>>
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   get_hessian(const unsigned int q_point) const
 {
-  Assert(!is_face, ExcNotImplemented());
 #  ifdef DEBUG
   Assert(this->hessians_quad_initialized == true,
          internal::ExcAccessToUninitializedField());
@@ -5098,7 +5341,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   Tensor<2, dim, VectorizedArrayType> hessian_out[n_components];
 
   // Cartesian cell
-  if (this->cell_type == internal::MatrixFreeFunctions::cartesian)
+  if (!is_face && this->cell_type == internal::MatrixFreeFunctions::cartesian)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         for (unsigned int d = 0; d < dim; ++d)
@@ -5133,7 +5376,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           }
     }
   // cell with general Jacobian, but constant within the cell
-  else if (this->cell_type == internal::MatrixFreeFunctions::affine)
+  else if (this->cell_type <= internal::MatrixFreeFunctions::affine)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         {
@@ -5166,11 +5409,12 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // cell with general Jacobian
   else
     {
+      Assert(jacobian_gradients != nullptr,
+             ExcMessage("The Jacobian gradients are not available. Make sure "
+                        "to set update_hessians in the mapping update flags "
+                        "of MatrixFree::AdditionalData."));
       const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
-        &jac_grad =
-          mapping_data->jacobian_gradients
-            [1 - this->is_interior_face]
-            [this->mapping_data->data_index_offsets[this->cell] + q_point];
+        &jac_grad = jacobian_gradients[q_point];
       for (unsigned int comp = 0; comp < n_components; comp++)
         {
           // compute laplacian before the gradient because it needs to access
@@ -5224,7 +5468,6 @@ inline Tensor<1, n_components_, Tensor<1, dim, VectorizedArrayType>>
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   get_hessian_diagonal(const unsigned int q_point) const
 {
-  Assert(!is_face, ExcNotImplemented());
 #  ifdef DEBUG
   Assert(this->hessians_quad_initialized == true,
          internal::ExcAccessToUninitializedField());
@@ -5240,7 +5483,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   Tensor<1, n_components_, Tensor<1, dim, VectorizedArrayType>> hessian_out;
 
   // Cartesian cell
-  if (this->cell_type == internal::MatrixFreeFunctions::cartesian)
+  if (!is_face && this->cell_type == internal::MatrixFreeFunctions::cartesian)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         for (unsigned int d = 0; d < dim; ++d)
@@ -5248,7 +5491,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
             (this->hessians_quad[comp][d][q_point] * jac[d][d] * jac[d][d]);
     }
   // cell with general Jacobian, but constant within the cell
-  else if (this->cell_type == internal::MatrixFreeFunctions::affine)
+  else if (this->cell_type <= internal::MatrixFreeFunctions::affine)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         {
@@ -5273,10 +5516,12 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // cell with general Jacobian
   else
     {
+      Assert(jacobian_gradients != nullptr,
+             ExcMessage("The Jacobian gradients are not available. Make sure "
+                        "to set update_hessians in the mapping update flags "
+                        "of MatrixFree::AdditionalData."));
       const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
-        &jac_grad =
-          mapping_data->jacobian_gradients
-            [0][this->mapping_data->data_index_offsets[this->cell] + q_point];
+        &jac_grad = jacobian_gradients[q_point];
       for (unsigned int comp = 0; comp < n_components; comp++)
         {
           // compute laplacian before the gradient because it needs to access
@@ -5316,7 +5561,6 @@ inline Tensor<1, n_components_, VectorizedArrayType>
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   get_laplacian(const unsigned int q_point) const
 {
-  Assert(is_face == false, ExcNotImplemented());
 #  ifdef DEBUG
   Assert(this->hessians_quad_initialized == true,
          internal::ExcAccessToUninitializedField());
@@ -6980,10 +7224,20 @@ FEEvaluation<dim,
   this->cell_type =
     this->matrix_info->get_mapping_info().get_cell_type(cell_index);
 
-  const unsigned int offsets =
-    this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
+  if (this->cell_type > internal::MatrixFreeFunctions::affine &&
+      this->matrix_info->get_mapping_info().jacobians_on_the_fly)
+    compute_jacobians_on_the_fly();
+  else
+    {
+      const unsigned int offsets =
+        this->mapping_data->data_index_offsets[cell_index];
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+      this->jacobian_gradients =
+        this->mapping_data->jacobian_gradients[0].empty() ?
+          nullptr :
+          &this->mapping_data->jacobian_gradients[0][offsets];
+    }
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -6995,6 +7249,108 @@ FEEvaluation<dim,
 
 
 
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components_,
+          typename Number,
+          typename VectorizedArrayType>
+inline void
+FEEvaluation<dim,
+             fe_degree,
+             n_q_points_1d,
+             n_components_,
+             Number,
+             VectorizedArrayType>::compute_jacobians_on_the_fly()
+{
+  const internal::MatrixFreeFunctions::MappingInfo<dim,
+                                                   Number,
+                                                   VectorizedArrayType>
+    &mapping_info = this->matrix_info->get_mapping_info();
+  AssertIndexRange(this->quad_no, mapping_info.mapping_shape_info.size());
+  const internal::MatrixFreeFunctions::ShapeInfo<VectorizedArrayType>
+    &shape_info = mapping_info.mapping_shape_info[this->quad_no];
+  const unsigned int n_mapping_points = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_points         = this->n_quadrature_points;
+  AssertDimension(shape_info.n_q_points, n_points);
+  constexpr unsigned int hess_dim = dim * (dim + 1) / 2;
+
+  const unsigned int offset =
+    mapping_info.mapping_support_point_offsets[this->cell];
+  Assert(offset != numbers::invalid_unsigned_int, ExcInternalError());
+
+  // the Jacobian gradients are derived from the second derivatives of the
+  // mapping
+  const bool compute_gradients =
+    mapping_info.update_flags_cells & update_jacobian_grads;
+
+  // the evaluator works on a copy of the support points; the values are not
+  // requested, but some evaluation paths use their slot as intermediate
+  // storage
+  geometry_scratch.resize_fast(
+    dim * (n_mapping_points + (1 + hess_dim + dim + 2) * n_points +
+           3 * n_mapping_points));
+  VectorizedArrayType *points = geometry_scratch.begin();
+  VectorizedArrayType *values = points + dim * n_mapping_points;
+  VectorizedArrayType *hess   = values + dim * n_points;
+  VectorizedArrayType *grads  = hess + dim * hess_dim * n_points;
+  VectorizedArrayType *temp   = grads + dim * dim * n_points;
+  std::copy(mapping_info.mapping_support_points.begin() + offset,
+            mapping_info.mapping_support_points.begin() + offset +
+              dim * n_mapping_points,
+            points);
+  SelectEvaluator<dim, -1, 0, dim, VectorizedArrayType>::evaluate(
+    shape_info,
+    points,
+    values,
+    grads,
+    hess,
+    temp,
+    false,
+    true,
+    compute_gradients);
+
+  jacobians_on_the_fly.resize_fast(n_points);
+  JxW_on_the_fly.resize_fast(n_points);
+  if (compute_gradients)
+    jacobian_gradients_on_the_fly.resize_fast(n_points);
+  const AlignedVector<Number> &weights =
+    this->mapping_data->descriptor[this->active_quad_index].quadrature_weights;
+  for (unsigned int q = 0; q < n_points; ++q)
+    {
+      Tensor<2, dim, VectorizedArrayType> jac;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          jac[d][e] = grads[q + (d * dim + e) * n_points];
+      JxW_on_the_fly[q]       = determinant(jac) * weights[q];
+      jacobians_on_the_fly[q] = transpose(invert(jac));
+
+      if (compute_gradients)
+        {
+          Tensor<3, dim, VectorizedArrayType> jac_grad;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              for (unsigned int e = 0; e < dim; ++e)
+                jac_grad[d][e][e] = hess[q + (d * hess_dim + e) * n_points];
+              for (unsigned int c = dim, e = 0; e < dim; ++e)
+                for (unsigned int f = e + 1; f < dim; ++f, ++c)
+                  jac_grad[d][e][f] = jac_grad[d][f][e] =
+                    hess[q + (d * hess_dim + c) * n_points];
+            }
+          jacobian_gradients_on_the_fly[q] =
+            internal::MatrixFreeFunctions::process_jacobian_gradient(
+              jacobians_on_the_fly[q], jac_grad);
+        }
+    }
+
+  this->jacobian = jacobians_on_the_fly.begin();
+  this->J_value  = JxW_on_the_fly.begin();
+  this->jacobian_gradients =
+    compute_gradients ? jacobian_gradients_on_the_fly.begin() : nullptr;
+}
+
+
+
 template <int dim,
           int fe_degree,
           int n_q_points_1d,
@@ -7632,6 +7988,7 @@ inline FEFaceEvaluation<dim,
   , dofs_per_component(this->data->dofs_per_component_on_cell)
   , dofs_per_cell(this->data->dofs_per_component_on_cell * n_components_)
   , n_q_points(this->data->n_q_points_face)
+  , neighbor_face_no(numbers::invalid_unsigned_int)
 {}
 
 
@@ -7701,6 +8058,11 @@ FEFaceEvaluation<dim,
   this->normal_x_jacobian =
     &this->mapping_data
        ->normals_times_jacobians[!this->is_interior_face][offsets];
+  this->jacobian_gradients =
+    this->mapping_data->jacobian_gradients[!this->is_interior_face].empty() ?
+      nullptr :
+      &this->mapping_data
+         ->jacobian_gradients[!this->is_interior_face][offsets];
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -7750,6 +8112,53 @@ FEFaceEvaluation<dim,
   this->dof_access_index =
     internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
 
+  // On the exterior side, the values are interpolated from the neighbors of
+  // the cells in the batch, so find the face number as seen from the
+  // neighbors. As the same interpolation is applied to all lanes, all
+  // neighbors must see the face with the same number in standard orientation
+  // and without hanging nodes.
+  if (this->is_interior_face == false)
+    {
+      constexpr unsigned int n_lanes = VectorizedArrayType::size();
+      neighbor_face_no               = numbers::invalid_unsigned_int;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int face_index =
+            this->matrix_info->get_cell_and_face_to_plain_faces()(cell_index,
+                                                                  face_number,
+                                                                  v);
+          if (face_index == numbers::invalid_unsigned_int)
+            continue;
+
+          const internal::MatrixFreeFunctions::FaceToCellTopology<n_lanes>
+            &faces = this->matrix_info->get_face_info(face_index / n_lanes);
+          const unsigned int lane = face_index % n_lanes;
+          if (faces.cells_exterior[lane] == numbers::invalid_unsigned_int)
+            continue;
+
+          Assert(faces.face_orientation == 0 &&
+                   faces.subface_index ==
+                     GeometryInfo<dim>::max_children_per_cell,
+                 ExcNotImplemented("The exterior side of a face in an "
+                                   "element-centric loop is only supported "
+                                   "for faces in standard orientation and "
+                                   "without hanging nodes."));
+          const unsigned int face_no_lane =
+            faces.cells_interior[lane] == cell_index * n_lanes + v ?
+              faces.exterior_face_no :
+              faces.interior_face_no;
+          Assert(neighbor_face_no == numbers::invalid_unsigned_int ||
+                   neighbor_face_no == face_no_lane,
+                 ExcNotImplemented("The neighbors of the cells in a batch "
+                                   "must all see the face with the same "
+                                   "number for the exterior side of a face "
+                                   "in an element-centric loop."));
+          neighbor_face_no = face_no_lane;
+        }
+      if (neighbor_face_no == numbers::invalid_unsigned_int)
+        neighbor_face_no = GeometryInfo<dim>::opposite_face[face_number];
+    }
+
   const unsigned int offsets =
     this->matrix_info->get_mapping_info()
       .face_data_by_cells[this->quad_no]
@@ -7772,6 +8181,7 @@ FEFaceEvaluation<dim,
     &this->matrix_info->get_mapping_info()
        .face_data_by_cells[this->quad_no]
        .normals_times_jacobians[!this->is_interior_face][offsets];
+  this->jacobian_gradients = nullptr;
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -7874,16 +8284,18 @@ FEFaceEvaluation<dim,
   evaluate(const VectorizedArrayType *            values_array,
            const EvaluationFlags::EvaluationFlags evaluation_flag)
 {
-  Assert(
-    (evaluation_flag &
-     ~(EvaluationFlags::values | EvaluationFlags::gradients)) == 0,
-    ExcMessage(
-      "Only EvaluationFlags::values and EvaluationFlags::gradients are supported."));
-
-  if (!(evaluation_flag & EvaluationFlags::values) &&
-      !(evaluation_flag & EvaluationFlags::gradients))
+  if (evaluation_flag == EvaluationFlags::nothing)
     return;
 
+  // on the exterior side of an element-centric loop, the values of the
+  // neighbors are interpolated to the face as seen from the neighbors
+  const unsigned int face_number =
+    (this->dof_access_index ==
+       internal::MatrixFreeFunctions::DoFInfo::dof_access_cell &&
+     this->is_interior_face == false) ?
+      neighbor_face_no :
+      this->face_no;
+
   internal::FEFaceEvaluationSelector<
     dim,
     fe_degree,
@@ -7894,10 +8306,12 @@ FEFaceEvaluation<dim,
                                    values_array,
                                    this->begin_values(),
                                    this->begin_gradients(),
+                                   this->hessians_quad[0][0],
                                    this->scratch_data,
                                    evaluation_flag & EvaluationFlags::values,
                                    evaluation_flag & EvaluationFlags::gradients,
-                                   this->face_no,
+                                   evaluation_flag & EvaluationFlags::hessians,
+                                   face_number,
                                    this->subface_index,
                                    this->face_orientation,
                                    this->mapping_data
@@ -7909,6 +8323,8 @@ FEFaceEvaluation<dim,
     this->values_quad_initialized = true;
   if (evaluation_flag & EvaluationFlags::gradients)
     this->gradients_quad_initialized = true;
+  if (evaluation_flag & EvaluationFlags::hessians)
+    this->hessians_quad_initialized = true;
 #  endif
 }
 
@@ -8010,6 +8426,12 @@ FEFaceEvaluation<dim,
      ~(EvaluationFlags::values | EvaluationFlags::gradients)) == 0,
     ExcMessage(
       "Only EvaluationFlags::values and EvaluationFlags::gradients are supported."));
+  Assert(this->dof_access_index !=
+             internal::MatrixFreeFunctions::DoFInfo::dof_access_cell ||
+           this->is_interior_face,
+         ExcMessage("The exterior side of a face in an element-centric loop "
+                    "does not support integration, as the result would be "
+                    "added to the neighbor."));
 
   if (!(evaluation_flag & EvaluationFlags::values) &&
       !(evaluation_flag & EvaluationFlags::gradients))
@@ -8091,13 +8513,16 @@ FEFaceEvaluation<dim,
                 "evaluating to a pointer to basic number (float,double). "
                 "Use read_dof_values() followed by evaluate() instead.");
 
-  Assert(
-    (evaluation_flag &
-     ~(EvaluationFlags::values | EvaluationFlags::gradients)) == 0,
-    ExcMessage(
-      "Only EvaluationFlags::values and EvaluationFlags::gradients are supported."));
+  // the fast path reads the degrees of freedom of the cells in the batch,
+  // whereas the exterior side of an element-centric loop needs the neighbors.
+  // Hessians are only computed by the general path.
+  const bool is_ecl_exterior =
+    this->dof_access_index ==
+      internal::MatrixFreeFunctions::DoFInfo::dof_access_cell &&
+    this->is_interior_face == false;
 
-  if (!internal::FEFaceEvaluationSelector<dim,
+  if (is_ecl_exterior || (evaluation_flag & EvaluationFlags::hessians) ||
+      !internal::FEFaceEvaluationSelector<dim,
                                           fe_degree,
                                           n_q_points_1d,
                                           n_components,
@@ -8130,6 +8555,8 @@ FEFaceEvaluation<dim,
     this->values_quad_initialized = true;
   if (evaluation_flag & EvaluationFlags::gradients)
     this->gradients_quad_initialized = true;
+  if (evaluation_flag & EvaluationFlags::hessians)
+    this->hessians_quad_initialized = true;
 #  endif
 }
 
@@ -8189,6 +8616,12 @@ FEFaceEvaluation<dim,
                 "evaluating to a pointer to basic number (float,double). "
                 "Use integrate() followed by distribute_local_to_global() "
                 "instead.");
+  Assert(this->dof_access_index !=
+             internal::MatrixFreeFunctions::DoFInfo::dof_access_cell ||
+           this->is_interior_face,
+         ExcMessage("The exterior side of a face in an element-centric loop "
+                    "does not support integration, as the result would be "
+                    "added to the neighbor."));
 
   if (!internal::FEFaceEvaluationSelector<dim,
                                           fe_degree,
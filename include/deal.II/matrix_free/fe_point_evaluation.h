@@ -0,0 +1,946 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_fe_point_evaluation_h
+#define dealii_fe_point_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/derivative_form.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_tools.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/matrix_free/evaluation_flags.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace FEPointEvaluation
+  {
+    /**
+     * Struct to distinguish between the value and gradient types of
+     * different numbers of components used by the FEPointEvaluation class.
+     */
+    template <int dim, int n_components, typename Number>
+    struct EvaluatorTypeTraits
+    {
+      using value_type    = Tensor<1, n_components, Number>;
+      using gradient_type = Tensor<1, n_components, Tensor<1, dim, Number>>;
+
+      static Number &
+      access(value_type &value, const unsigned int component)
+      {
+        return value[component];
+      }
+
+      static const Number &
+      access(const value_type &value, const unsigned int component)
+      {
+        return value[component];
+      }
+
+      static Tensor<1, dim, Number> &
+      access(gradient_type &gradient, const unsigned int component)
+      {
+        return gradient[component];
+      }
+
+      static const Tensor<1, dim, Number> &
+      access(const gradient_type &gradient, const unsigned int component)
+      {
+        return gradient[component];
+      }
+    };
+
+    template <int dim, typename Number>
+    struct EvaluatorTypeTraits<dim, 1, Number>
+    {
+      using value_type    = Number;
+      using gradient_type = Tensor<1, dim, Number>;
+
+      static Number &
+      access(value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static const Number &
+      access(const value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static Tensor<1, dim, Number> &
+      access(gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+
+      static const Tensor<1, dim, Number> &
+      access(const gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+    };
+  } // namespace FEPointEvaluation
+} // namespace internal
+
+
+
+/**
+ * This class provides an interface to the evaluation of interpolated
+ * solution values and gradients on cells on arbitrary reference point
+ * positions. These points can change from cell to cell, both with respect
+ * to their quantity as well to the location. The two typical use cases are
+ * evaluations on non-matching grids and particle simulations.
+ *
+ * The use of this class is similar to FEValues or FEEvaluation: The class
+ * is first initialized to a cell by calling `FEPointEvaluation::reinit(cell,
+ * unit_points)`, with the main difference to the other concepts that the
+ * underlying points in reference coordinates need to be passed along. Then,
+ * upon call to evaluate() or integrate(), the user can compute information
+ * at the give points. Eventually, the access functions get_value() or
+ * get_gradient() allow to query this information at a specific point index.
+ *
+ * In contrast to creating an FEValues object with a Quadrature formula of the
+ * given points on each cell, the present class does not compute the values
+ * of all shape functions at all points. For elements with a tensor product
+ * structure such as FE_Q or FE_DGQ (also as part of an FESystem), the
+ * one-dimensional polynomials are evaluated at each point and combined by sum
+ * factorization, see internal::evaluate_tensor_product_value_and_gradient().
+ * This reduces the cost of an evaluation from $\mathcal O(k^d)$ per shape
+ * function and point, i.e., $\mathcal O(k^{2d})$ per point, to $\mathcal
+ * O(k^d)$ per point. Furthermore, the points are processed in batches of the
+ * width of VectorizedArray<Number>, so that the arithmetic is done with SIMD
+ * instructions. The same holds for the geometry of cells described by a
+ * MappingQGeneric (or MappingQCache) object, whose support points are
+ * interpolated with the same kernels. For other finite elements or mappings,
+ * the class falls back to an internal FEValues object.
+ *
+ * The function integrate() is the transpose of evaluate(): It multiplies
+ * the values and gradients submitted by submit_value() and submit_gradient()
+ * at each point by the values and gradients of the test functions and sums
+ * over all points. This is the operation needed for example to scatter the
+ * contributions of particles to the degrees of freedom of a cell.
+ *
+ * A typical use case for the evaluation of a solution on a set of points
+ * inside a cell is as follows:
+ * @code
+ * FEPointEvaluation<1, dim> evaluator(mapping, fe, update_values);
+ * std::vector<double>       local_values(fe.dofs_per_cell);
+ * for (const auto &cell : dof_handler.active_cell_iterators())
+ *   {
+ *     cell->get_dof_values(solution, local_values.begin(),
+ *                          local_values.end());
+ *     evaluator.reinit(cell, reference_points_on_cell);
+ *     evaluator.evaluate(local_values, EvaluationFlags::values);
+ *     for (unsigned int q = 0; q < reference_points_on_cell.size(); ++q)
+ *       do_something(evaluator.get_value(q));
+ *   }
+ * @endcode
+ *
+ * @tparam n_components Number of vector components when accessing the
+ * solution.
+ *
+ * @tparam dim Topological dimension of the cells.
+ *
+ * @tparam spacedim Space dimension of the triangulation.
+ *
+ * @tparam Number The type of the solution coefficients and the results.
+ *
+ * @ingroup matrixfree
+ */
+template <int n_components,
+          int dim,
+          int spacedim    = dim,
+          typename Number = double>
+class FEPointEvaluation
+{
+public:
+  using value_type = typename internal::FEPointEvaluation::
+    EvaluatorTypeTraits<spacedim, n_components, Number>::value_type;
+  using gradient_type = typename internal::FEPointEvaluation::
+    EvaluatorTypeTraits<spacedim, n_components, Number>::gradient_type;
+
+  /**
+   * Constructor.
+   *
+   * @param mapping The Mapping class describing the actual geometry of a cell
+   * passed to the reinit() function.
+   *
+   * @param fe The FiniteElement object that is used for the evaluation, which
+   * is typically the same on all cells to be evaluated.
+   *
+   * @param update_flags Specify the quantities to be computed by the mapping
+   * during the call of reinit(). During evaluate() or integrate(), this data
+   * is queried to produce the desired result (e.g., the gradient of a finite
+   * element solution).
+   *
+   * @param first_selected_component For multi-component FiniteElement
+   * objects, this parameter allows to select a range of `n_components`
+   * components starting from this parameter.
+   */
+  FEPointEvaluation(const Mapping<dim, spacedim> &      mapping,
+                    const FiniteElement<dim, spacedim> &fe,
+                    const UpdateFlags                   update_flags,
+                    const unsigned int first_selected_component = 0);
+
+  /**
+   * Set up the mapping information for the given cell, e.g., by computing
+   * the Jacobian of the mapping for the given points if gradients of the
+   * functions are requested.
+   *
+   * @param[in] cell An iterator to the current cell
+   *
+   * @param[in] unit_points List of points in the reference locations of the
+   * current cell where the FiniteElement object should be
+   * evaluated/integrated in the evaluate() and integrate() functions.
+   */
+  void
+  reinit(const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+         const ArrayView<const Point<dim>> &unit_points);
+
+  /**
+   * This function interpolates the finite element solution, represented by
+   * @p solution_values, on the cell and `unit_points` passed to reinit().
+   *
+   * @param[in] solution_values This array is supposed to contain the unknown
+   * values on the element as returned by `cell->get_dof_values(global_vector,
+   * solution_values)`.
+   *
+   * @param[in] evaluation_flags Flags specifying which quantities should be
+   * evaluated at the points.
+   */
+  void
+  evaluate(const ArrayView<const Number> &         solution_values,
+           const EvaluationFlags::EvaluationFlags &evaluation_flags);
+
+  /**
+   * This function multiplies the quantities passed in by previous
+   * submit_value() or submit_gradient() calls by the value or gradient of the
+   * test functions, and performs summation over all given points.
+   *
+   * @param[out] solution_values This array will contain the result of the
+   * integral, which can be used to during
+   * `cell->set_dof_values(solution_values, global_vector)` or
+   * `cell->distribute_local_to_global(solution_values, global_vector)`. Note
+   * that for multi-component systems where only some of the components are
+   * selected by the present class, the entries in `solution_values` not
+   * touched by this class will be set to zero.
+   *
+   * @param[in] integration_flags Flags specifying which quantities should be
+   * integrated at the points.
+   */
+  void
+  integrate(const ArrayView<Number> &               solution_values,
+            const EvaluationFlags::EvaluationFlags &integration_flags);
+
+  /**
+   * Return the value at quadrature point number @p point_index after a call
+   * to FEPointEvaluation::evaluate() with EvaluationFlags::values set, or the
+   * value that has been stored there with a call to
+   * FEPointEvaluation::submit_value(). If the object is vector-valued, a
+   * vector-valued return argument is given.
+   */
+  const value_type &
+  get_value(const unsigned int point_index) const;
+
+  /**
+   * Write a value to the field containing the values on points with
+   * component point_index. Access to the same field as through get_value().
+   * If applied before the function FEPointEvaluation::integrate() with
+   * EvaluationFlags::values set is called, this specifies the value which is
+   * tested by all basis function on the current cell and integrated over.
+   */
+  void
+  submit_value(const value_type &value, const unsigned int point_index);
+
+  /**
+   * Return the gradient in real coordinates at the point with index
+   * `point_index` after a call to FEPointEvaluation::evaluate() with
+   * EvaluationFlags::gradients set, or the gradient that has been stored
+   * there with a call to FEPointEvaluation::submit_gradient(). The
+   * gradient in real coordinates is obtained by taking the unit gradient
+   * and applying the inverse Jacobian of the mapping. If the object is vector-valued, a vector-valued
+   * return argument is given.
+   */
+  const gradient_type &
+  get_gradient(const unsigned int point_index) const;
+
+  /**
+   * Write a contribution that is tested by the gradient to the field
+   * containing the values on points with the given `point_index`. Access to
+   * the same field as through get_gradient(). If applied before the function
+   * FEPointEvaluation::integrate(EvaluationFlags::gradients) is called, this
+   * specifies what is tested by all basis function gradients on the current
+   * cell and integrated over.
+   */
+  void
+  submit_gradient(const gradient_type &, const unsigned int point_index);
+
+  /**
+   * Return the Jacobian of the transformation on the current cell with the
+   * given point index. Prerequisite: This class needs to be constructed with
+   * UpdateFlags containing `update_jacobian`.
+   */
+  const DerivativeForm<1, dim, spacedim> &
+  jacobian(const unsigned int point_index) const;
+
+  /**
+   * Return the inverse of the Jacobian of the transformation on the current
+   * cell with the given point index. Prerequisite: This class needs to be
+   * constructed with UpdateFlags containing `update_inverse_jacobian` or
+   * `update_gradients`.
+   */
+  const DerivativeForm<1, spacedim, dim> &
+  inverse_jacobian(const unsigned int point_index) const;
+
+  /**
+   * Return the position in real coordinates of the given point index among
+   * the points passed to reinit(). Prerequisite: This class needs to be
+   * constructed with UpdateFlags containing `update_quadrature_points`.
+   */
+  const Point<spacedim> &
+  real_point(const unsigned int point_index) const;
+
+  /**
+   * Return the position in unit/reference coordinates of the given point
+   * index, i.e., the respective point passed to the reinit() function.
+   */
+  const Point<dim> &
+  unit_point(const unsigned int point_index) const;
+
+  /**
+   * Return the number of points the current cell has been set up for in the
+   * last call to reinit().
+   */
+  unsigned int
+  n_points() const;
+
+private:
+  /**
+   * Compute the mapping data (positions, Jacobians) for the current cell
+   * with the sum factorization kernels on the support points of a
+   * MappingQGeneric object.
+   */
+  void
+  compute_mapping_data_tensor_product(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+  /**
+   * Pointer to the Mapping object passed to the constructor.
+   */
+  SmartPointer<const Mapping<dim, spacedim>> mapping;
+
+  /**
+   * Pointer to MappingQGeneric class that enables the fast path of this
+   * class, or `nullptr` for other mappings.
+   */
+  const MappingQGeneric<dim, spacedim> *mapping_q_generic;
+
+  /**
+   * Pointer to the FiniteElement object passed to the constructor.
+   */
+  SmartPointer<const FiniteElement<dim, spacedim>> fe;
+
+  /**
+   * Description of the 1D polynomial basis for tensor product elements used
+   * for the fast path of this class using tensor product evaluators.
+   */
+  std::vector<Polynomials::Polynomial<double>> poly;
+
+  /**
+   * The one-dimensional polynomials describing the geometry of a
+   * MappingQGeneric object.
+   */
+  std::vector<Polynomials::Polynomial<double>> mapping_poly;
+
+  /**
+   * Renumbering from the lexicographic order of the mapping polynomials to
+   * the hierarchical order of the support points returned by the mapping.
+   */
+  std::vector<unsigned int> mapping_renumber;
+
+  /**
+   * For the fast path of the finite element evaluation, this array stores
+   * for each selected component and each lexicographic index of the scalar
+   * tensor product space the index of the respective degree of freedom in the
+   * cell-local numbering of the finite element.
+   */
+  std::vector<unsigned int> dof_map;
+
+  /**
+   * Stores whether the fast path with tensor product evaluators is possible
+   * for the finite element.
+   */
+  bool use_tensor_product_fe;
+
+  /**
+   * The desired update flags for the evaluation.
+   */
+  const UpdateFlags update_flags;
+
+  /**
+   * The update flags that the mapping needs to compute on each cell.
+   */
+  UpdateFlags update_flags_mapping;
+
+  /**
+   * Number of the first selected component of the finite element.
+   */
+  const unsigned int first_selected_component;
+
+  /**
+   * In case the fast path is not possible, the evaluation is done through
+   * this FEValues object that is set up on each cell in reinit().
+   */
+  std::shared_ptr<FEValues<dim, spacedim>> fe_values;
+
+  /**
+   * The points in reference coordinates passed to the last reinit() call.
+   */
+  std::vector<Point<dim>> unit_points;
+
+  /**
+   * The points in real coordinates.
+   */
+  std::vector<Point<spacedim>> real_points;
+
+  /**
+   * The Jacobians of the mapping at the points.
+   */
+  std::vector<DerivativeForm<1, dim, spacedim>> jacobians;
+
+  /**
+   * The inverse Jacobians of the mapping at the points.
+   */
+  std::vector<DerivativeForm<1, spacedim, dim>> inverse_jacobians;
+
+  /**
+   * Temporary array to store the coefficients of one component in
+   * lexicographic order.
+   */
+  std::vector<Number> solution_renumbered;
+
+  /**
+   * Temporary array to accumulate the vectorized contributions of the
+   * points to one component in integrate().
+   */
+  AlignedVector<VectorizedArray<Number>> solution_renumbered_vectorized;
+
+  /**
+   * Temporary array to store the values at the points.
+   */
+  std::vector<value_type> values;
+
+  /**
+   * Temporary array to store the gradients in real coordinates at the
+   * points.
+   */
+  std::vector<gradient_type> gradients;
+};
+
+// ----------------------- template and inline function ----------------------
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+FEPointEvaluation<n_components, dim, spacedim, Number>::FEPointEvaluation(
+  const Mapping<dim, spacedim> &      mapping,
+  const FiniteElement<dim, spacedim> &fe,
+  const UpdateFlags                   update_flags,
+  const unsigned int                  first_selected_component)
+  : mapping(&mapping)
+  , mapping_q_generic(
+      dynamic_cast<const MappingQGeneric<dim, spacedim> *>(&mapping))
+  , fe(&fe)
+  , use_tensor_product_fe(false)
+  , update_flags(update_flags)
+  , update_flags_mapping(update_default)
+  , first_selected_component(first_selected_component)
+{
+  AssertIndexRange(first_selected_component + n_components,
+                   fe.n_components() + 1);
+
+  // the fast path is possible if all selected components belong to the
+  // same scalar base element that is described by a tensor product of
+  // one-dimensional polynomials
+  const unsigned int base_element_number =
+    fe.component_to_base_index(first_selected_component).first;
+  bool same_base_element = true;
+  for (unsigned int c = 1; c < n_components; ++c)
+    if (fe.component_to_base_index(first_selected_component + c).first !=
+        base_element_number)
+      same_base_element = false;
+
+  const FiniteElement<dim, spacedim> &base_element =
+    fe.base_element(base_element_number);
+  const FE_Poly<dim, spacedim> *fe_poly =
+    dynamic_cast<const FE_Poly<dim, spacedim> *>(&base_element);
+  if (same_base_element && base_element.n_components() == 1 &&
+      fe_poly != nullptr)
+    if (const auto *tensor_poly =
+          dynamic_cast<const TensorProductPolynomials<dim> *>(
+            &fe_poly->get_poly_space()))
+      {
+        use_tensor_product_fe = true;
+        poly                  = tensor_poly->get_underlying_polynomials();
+
+        const std::vector<unsigned int> lexicographic =
+          fe_poly->get_poly_space_numbering_inverse();
+        dof_map.resize(n_components * lexicographic.size());
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int i = 0; i < lexicographic.size(); ++i)
+            dof_map[c * lexicographic.size() + i] =
+              fe.component_to_system_index(first_selected_component + c,
+                                           lexicographic[i]);
+      }
+
+  if (mapping_q_generic != nullptr)
+    {
+      const unsigned int degree = mapping_q_generic->get_degree();
+      mapping_poly              = Polynomials::generate_complete_Lagrange_basis(
+        QGaussLobatto<1>(degree + 1).get_points());
+      mapping_renumber =
+        FETools::lexicographic_to_hierarchic_numbering<dim>(degree);
+    }
+
+  // translate the update flags of the evaluation into the quantities
+  // needed from the mapping
+  if (update_flags & update_quadrature_points)
+    update_flags_mapping |= update_quadrature_points;
+  if (update_flags & update_jacobians)
+    update_flags_mapping |= update_jacobians;
+  if (update_flags & (update_gradients | update_inverse_jacobians))
+    update_flags_mapping |= update_inverse_jacobians;
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::reinit(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<dim>> &                         unit_points)
+{
+  this->unit_points.assign(unit_points.begin(), unit_points.end());
+
+  const unsigned int n_points = unit_points.size();
+  values.resize(n_points);
+  if (update_flags & update_gradients)
+    gradients.resize(n_points);
+
+  if (use_tensor_product_fe && mapping_q_generic != nullptr)
+    {
+      fe_values.reset();
+      compute_mapping_data_tensor_product(cell);
+      return;
+    }
+
+  // general path: set up an FEValues object for the given points, which
+  // provides both the mapping data and the shape functions for elements
+  // without tensor product structure
+  UpdateFlags flags = update_flags_mapping;
+  if (use_tensor_product_fe == false)
+    flags |= update_flags & (update_values | update_gradients);
+  fe_values = std::make_shared<FEValues<dim, spacedim>>(
+    *mapping, *fe, Quadrature<dim>(this->unit_points), flags);
+  fe_values->reinit(cell);
+
+  if (update_flags_mapping & update_quadrature_points)
+    real_points = fe_values->get_quadrature_points();
+  if (update_flags_mapping & update_jacobians)
+    {
+      jacobians.resize(n_points);
+      for (unsigned int q = 0; q < n_points; ++q)
+        jacobians[q] = fe_values->jacobian(q);
+    }
+  if (update_flags_mapping & update_inverse_jacobians)
+    {
+      inverse_jacobians.resize(n_points);
+      for (unsigned int q = 0; q < n_points; ++q)
+        inverse_jacobians[q] = fe_values->inverse_jacobian(q);
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::
+  compute_mapping_data_tensor_product(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+{
+  const unsigned int n_points = unit_points.size();
+  if (update_flags_mapping & update_quadrature_points)
+    real_points.resize(n_points);
+  if (update_flags_mapping & (update_jacobians | update_inverse_jacobians))
+    jacobians.resize(n_points);
+  if (update_flags_mapping & update_inverse_jacobians)
+    inverse_jacobians.resize(n_points);
+  if (update_flags_mapping == update_default)
+    return;
+
+  const std::vector<Point<spacedim>> support_points =
+    mapping_q_generic->compute_mapping_support_points(cell);
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+  for (unsigned int i = 0; i < n_points; i += n_lanes)
+    {
+      // gather a batch of points, filling the unused lanes with the last
+      // point
+      Point<dim, VectorizedArray<Number>> p_vectorized;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        for (unsigned int d = 0; d < dim; ++d)
+          p_vectorized[d][v] = unit_points[std::min(i + v, n_points - 1)][d];
+
+      const auto result =
+        internal::evaluate_tensor_product_value_and_gradient(mapping_poly,
+                                                             support_points,
+                                                             p_vectorized,
+                                                             mapping_renumber);
+
+      for (unsigned int v = 0; v < n_lanes && i + v < n_points; ++v)
+        {
+          if (update_flags_mapping & update_quadrature_points)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              real_points[i + v][d] = result.first[d][v];
+          if (update_flags_mapping &
+              (update_jacobians | update_inverse_jacobians))
+            for (unsigned int d = 0; d < spacedim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                jacobians[i + v][d][e] = result.second[e][d][v];
+          if (update_flags_mapping & update_inverse_jacobians)
+            inverse_jacobians[i + v] =
+              jacobians[i + v].covariant_form().transpose();
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::evaluate(
+  const ArrayView<const Number> &         solution_values,
+  const EvaluationFlags::EvaluationFlags &evaluation_flags)
+{
+  using ETT = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<spacedim, n_components, Number>;
+
+  if (!((evaluation_flags & EvaluationFlags::values) ||
+        (evaluation_flags & EvaluationFlags::gradients)))
+    return;
+
+  AssertDimension(solution_values.size(), fe->dofs_per_cell);
+  Assert(!(evaluation_flags & EvaluationFlags::gradients) ||
+           (update_flags & update_gradients),
+         ExcNotInitialized());
+
+  const unsigned int n_points = unit_points.size();
+
+  if (use_tensor_product_fe)
+    {
+      const unsigned int n_shapes_scalar = dof_map.size() / n_components;
+      solution_renumbered.resize(n_shapes_scalar);
+
+      constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          for (unsigned int i = 0; i < n_shapes_scalar; ++i)
+            solution_renumbered[i] =
+              solution_values[dof_map[c * n_shapes_scalar + i]];
+
+          for (unsigned int i = 0; i < n_points; i += n_lanes)
+            {
+              Point<dim, VectorizedArray<Number>> p_vectorized;
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                for (unsigned int d = 0; d < dim; ++d)
+                  p_vectorized[d][v] =
+                    unit_points[std::min(i + v, n_points - 1)][d];
+
+              const auto result =
+                internal::evaluate_tensor_product_value_and_gradient(
+                  poly, solution_renumbered, p_vectorized);
+
+              for (unsigned int v = 0; v < n_lanes && i + v < n_points; ++v)
+                {
+                  if (evaluation_flags & EvaluationFlags::values)
+                    ETT::access(values[i + v], c) = result.first[v];
+                  if (evaluation_flags & EvaluationFlags::gradients)
+                    {
+                      Tensor<1, spacedim, Number> &gradient =
+                        ETT::access(gradients[i + v], c);
+                      gradient = Tensor<1, spacedim, Number>();
+                      for (unsigned int e = 0; e < dim; ++e)
+                        gradient +=
+                          result.second[e][v] * inverse_jacobians[i + v][e];
+                    }
+                }
+            }
+        }
+    }
+  else
+    {
+      Assert(fe_values.get() != nullptr, ExcNotInitialized());
+      for (unsigned int q = 0; q < n_points; ++q)
+        {
+          if (evaluation_flags & EvaluationFlags::values)
+            values[q] = value_type();
+          if (evaluation_flags & EvaluationFlags::gradients)
+            gradients[q] = gradient_type();
+        }
+      for (unsigned int i = 0; i < fe->dofs_per_cell; ++i)
+        {
+          const unsigned int component = fe->system_to_component_index(i).first;
+          if (component < first_selected_component ||
+              component >= first_selected_component + n_components)
+            continue;
+          const unsigned int c = component - first_selected_component;
+          for (unsigned int q = 0; q < n_points; ++q)
+            {
+              if (evaluation_flags & EvaluationFlags::values)
+                ETT::access(values[q], c) +=
+                  solution_values[i] *
+                  fe_values->shape_value_component(i, q, component);
+              if (evaluation_flags & EvaluationFlags::gradients)
+                ETT::access(gradients[q], c) +=
+                  solution_values[i] *
+                  fe_values->shape_grad_component(i, q, component);
+            }
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::integrate(
+  const ArrayView<Number> &               solution_values,
+  const EvaluationFlags::EvaluationFlags &integration_flags)
+{
+  using ETT = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<spacedim, n_components, Number>;
+
+  AssertDimension(solution_values.size(), fe->dofs_per_cell);
+  Assert(!(integration_flags & EvaluationFlags::gradients) ||
+           (update_flags & update_gradients),
+         ExcNotInitialized());
+
+  for (unsigned int i = 0; i < solution_values.size(); ++i)
+    solution_values[i] = Number();
+  if (!((integration_flags & EvaluationFlags::values) ||
+        (integration_flags & EvaluationFlags::gradients)))
+    return;
+
+  const unsigned int n_points = unit_points.size();
+
+  if (use_tensor_product_fe)
+    {
+      const unsigned int n_shapes_scalar = dof_map.size() / n_components;
+      solution_renumbered_vectorized.resize(n_shapes_scalar);
+
+      constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          solution_renumbered_vectorized.fill(VectorizedArray<Number>());
+          for (unsigned int i = 0; i < n_points; i += n_lanes)
+            {
+              // gather a batch of points and the submitted data, putting
+              // zero contributions in the unused lanes
+              Point<dim, VectorizedArray<Number>>     p_vectorized;
+              VectorizedArray<Number>                 value = Number();
+              Tensor<1, dim, VectorizedArray<Number>> gradient;
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                {
+                  const unsigned int q = std::min(i + v, n_points - 1);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    p_vectorized[d][v] = unit_points[q][d];
+                  if (i + v >= n_points)
+                    continue;
+                  if (integration_flags & EvaluationFlags::values)
+                    value[v] = ETT::access(values[q], c);
+                  if (integration_flags & EvaluationFlags::gradients)
+                    {
+                      const Tensor<1, spacedim, Number> &grad_real =
+                        ETT::access(gradients[q], c);
+                      for (unsigned int e = 0; e < dim; ++e)
+                        gradient[e][v] = inverse_jacobians[q][e] * grad_real;
+                    }
+                }
+
+              internal::integrate_add_tensor_product_value_and_gradient(
+                poly,
+                value,
+                gradient,
+                p_vectorized,
+                solution_renumbered_vectorized.begin());
+            }
+
+          // sum the contributions of the lanes into the result
+          for (unsigned int i = 0; i < n_shapes_scalar; ++i)
+            {
+              Number sum = solution_renumbered_vectorized[i][0];
+              for (unsigned int v = 1; v < n_lanes; ++v)
+                sum += solution_renumbered_vectorized[i][v];
+              solution_values[dof_map[c * n_shapes_scalar + i]] = sum;
+            }
+        }
+    }
+  else
+    {
+      Assert(fe_values.get() != nullptr, ExcNotInitialized());
+      for (unsigned int i = 0; i < fe->dofs_per_cell; ++i)
+        {
+          const unsigned int component = fe->system_to_component_index(i).first;
+          if (component < first_selected_component ||
+              component >= first_selected_component + n_components)
+            continue;
+          const unsigned int c = component - first_selected_component;
+          for (unsigned int q = 0; q < n_points; ++q)
+            {
+              if (integration_flags & EvaluationFlags::values)
+                solution_values[i] +=
+                  fe_values->shape_value_component(i, q, component) *
+                  ETT::access(values[q], c);
+              if (integration_flags & EvaluationFlags::gradients)
+                solution_values[i] +=
+                  fe_values->shape_grad_component(i, q, component) *
+                  ETT::access(gradients[q], c);
+            }
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline const typename FEPointEvaluation<n_components, dim, spacedim, Number>::
+  value_type &
+  FEPointEvaluation<n_components, dim, spacedim, Number>::get_value(
+    const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, values.size());
+  return values[point_index];
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline const typename FEPointEvaluation<n_components, dim, spacedim, Number>::
+  gradient_type &
+  FEPointEvaluation<n_components, dim, spacedim, Number>::get_gradient(
+    const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, gradients.size());
+  return gradients[point_index];
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline void
+FEPointEvaluation<n_components, dim, spacedim, Number>::submit_value(
+  const value_type & value,
+  const unsigned int point_index)
+{
+  AssertIndexRange(point_index, values.size());
+  values[point_index] = value;
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline void
+FEPointEvaluation<n_components, dim, spacedim, Number>::submit_gradient(
+  const gradient_type &gradient,
+  const unsigned int   point_index)
+{
+  AssertIndexRange(point_index, gradients.size());
+  gradients[point_index] = gradient;
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline const DerivativeForm<1, dim, spacedim> &
+FEPointEvaluation<n_components, dim, spacedim, Number>::jacobian(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, jacobians.size());
+  return jacobians[point_index];
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline const DerivativeForm<1, spacedim, dim> &
+FEPointEvaluation<n_components, dim, spacedim, Number>::inverse_jacobian(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, inverse_jacobians.size());
+  return inverse_jacobians[point_index];
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline const Point<spacedim> &
+FEPointEvaluation<n_components, dim, spacedim, Number>::real_point(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, real_points.size());
+  return real_points[point_index];
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline const Point<dim> &
+FEPointEvaluation<n_components, dim, spacedim, Number>::unit_point(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, unit_points.size());
+  return unit_points[point_index];
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+inline unsigned int
+FEPointEvaluation<n_components, dim, spacedim, Number>::n_points() const
+{
+  return unit_points.size();
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
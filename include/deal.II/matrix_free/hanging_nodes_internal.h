@@ -0,0 +1,935 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 - 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_matrix_free_hanging_nodes_internal_h
+#define dealii_matrix_free_hanging_nodes_internal_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+
+#include <bitset>
+#include <map>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    // Here is the system for how we store constraint types in a binary mask,
+    // following the layout of CUDAWrappers::MatrixFree. This is not a
+    // complete contradiction-free system, i.e., there are invalid states
+    // that we just assume that we never get; the setup in MatrixFree checks
+    // the resulting interpolation against the given constraints.
+
+    // If the mask is zero, there are no constraints. Then, there are three
+    // different fields with one bit per dimension. The first field determines
+    // the type, or the position of an element along each direction. The
+    // second field determines if there is a constrained face with that
+    // direction as normal. The last field determines if there is a
+    // constrained edge of a given pair of coordinate planes, but where
+    // neither of the corresponding faces are constrained (only valid in 3D).
+
+    // The element is placed in the 'first position' along *-axis. These also
+    // determine which face is constrained. For example, in 2D, if
+    // constr_face_x and constr_type are set, then x = 0 is constrained.
+    constexpr unsigned short constr_type_x = 1 << 0;
+    constexpr unsigned short constr_type_y = 1 << 1;
+    constexpr unsigned short constr_type_z = 1 << 2;
+
+    // Element has as a constraint at * = 0 or * = fe_degree face
+    constexpr unsigned short constr_face_x = 1 << 3;
+    constexpr unsigned short constr_face_y = 1 << 4;
+    constexpr unsigned short constr_face_z = 1 << 5;
+
+    // Element has as a constraint at * = 0 or * = fe_degree edge
+    constexpr unsigned short constr_edge_xy = 1 << 6;
+    constexpr unsigned short constr_edge_yz = 1 << 7;
+    constexpr unsigned short constr_edge_zx = 1 << 8;
+
+    // The largest number of degrees of freedom per direction supported by
+    // the interpolation at hanging nodes, determining the size of the
+    // temporary array on the stack
+    constexpr unsigned int max_n_dofs_1d_hanging_nodes = 32;
+
+
+
+    /**
+     * This class computes the configuration of hanging nodes on the cells of
+     * MatrixFree in terms of a bit mask and replaces the indices of the
+     * constrained degrees of freedom on the refined side by the ones on the
+     * coarser neighbor, such that the constraints can be applied by
+     * interpolate_hanging_nodes() within FEEvaluation. The identification of
+     * the hanging faces and edges is the same as in the respective class for
+     * CUDAWrappers::MatrixFree, which is explained in <em>Section 3 of
+     * Matrix-Free Finite-Element Computations On Graphics Processors With
+     * Adaptively Refined Unstructured Meshes</em> by Karl Ljungkvist,
+     * SpringSim-HPC, 2017 April 23-26.
+     */
+    template <int dim>
+    class HangingNodes
+    {
+    public:
+      /**
+       * Constructor. The argument @p lexicographic_mapping translates from
+       * the lexicographic numbering of the degrees of freedom on a cell into
+       * the numbering of the finite element.
+       */
+      HangingNodes(const DoFHandler<dim> &          dof_handler,
+                   const std::vector<unsigned int> &lexicographic_mapping);
+
+      /**
+       * Compute the value of the constraint mask for a given cell and modify
+       * the global indices @p dof_indices given in lexicographic order on
+       * the cell such that the constrained degrees of freedom are replaced
+       * by the ones of the coarser neighbor at the same position. Returns
+       * false if the neighborhood of the cell is not accessible, in which
+       * case the indices must not be used.
+       */
+      bool
+      setup_constraints(
+        const typename DoFHandler<dim>::active_cell_iterator &cell,
+        std::vector<types::global_dof_index> &                dof_indices,
+        unsigned short &                                      mask) const;
+
+      /**
+       * Check whether the interpolation described by @p mask, which
+       * expresses the values on the degrees of freedom @p plain_indices in
+       * terms of the degrees of freedom @p resolved_indices (both in
+       * lexicographic order), coincides with the constraints stored in
+       * @p constraints.
+       */
+      template <typename Number, typename number2>
+      bool
+      constraints_are_compatible(
+        const std::vector<types::global_dof_index> &plain_indices,
+        const std::vector<types::global_dof_index> &resolved_indices,
+        const unsigned short                        mask,
+        const UnivariateShapeData<Number> &         shape_data,
+        const dealii::AffineConstraints<number2> &  constraints);
+
+    private:
+      /**
+       * Set up line-to-cell mapping for edge constraints in 3D.
+       */
+      void
+      setup_line_to_cell();
+
+      void
+      rotate_subface_index(int times, unsigned int &subface_index) const;
+
+      void
+      rotate_face(int                                   times,
+                  unsigned int                          n_dofs_1d,
+                  std::vector<types::global_dof_index> &dofs) const;
+
+      unsigned int
+      line_dof_idx(int          local_line,
+                   unsigned int dof,
+                   unsigned int n_dofs_1d) const;
+
+      void
+      transpose_face(std::vector<types::global_dof_index> &dofs) const;
+
+      void
+      transpose_subface_index(unsigned int &subface) const;
+
+      using cell_iterator = typename DoFHandler<dim>::cell_iterator;
+      using active_cell_iterator =
+        typename DoFHandler<dim>::active_cell_iterator;
+      const unsigned int n_raw_lines;
+      std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+                                       line_to_cells;
+      const std::vector<unsigned int> &lexicographic_mapping;
+      const unsigned int               fe_degree;
+      const DoFHandler<dim> &          dof_handler;
+
+      /**
+       * The interpolation matrices for the constraint masks encountered so
+       * far, used to check the constraints.
+       */
+      std::map<unsigned short, std::vector<double>> interpolation_matrices;
+    };
+
+
+
+    /**
+     * Apply the interpolation at hanging nodes described by @p mask to the
+     * values @p values of a scalar FE_Q-type element in lexicographic order,
+     * using the one-dimensional interpolation matrices of @p shape_data. For
+     * @p transpose equal to false, the values of the constrained degrees of
+     * freedom are assumed to hold the values of the coarser neighbor at the
+     * same position (as set up by HangingNodes::setup_constraints()) and are
+     * replaced by the interpolated values. For @p transpose equal to true,
+     * the transposed operation is performed, which is used when summing
+     * integrals into a vector. The operation is applied direction by
+     * direction on the lines of degrees of freedom located on the
+     * constrained faces and edges, i.e., in sum factorization form.
+     *
+     * Only the vectorization lanes set in @p lanes are written to, such that
+     * several cells of a batch with different masks can be processed one
+     * after the other.
+     */
+    template <int dim, typename Number>
+    inline void
+    interpolate_hanging_nodes(const UnivariateShapeData<Number> &shape_data,
+                              const unsigned short               mask,
+                              const bool                         transpose,
+                              const std::bitset<Number::size()> &lanes,
+                              Number *                           values)
+    {
+      if (mask == 0)
+        return;
+
+      const unsigned int n_dofs_1d = shape_data.fe_degree + 1;
+      const unsigned int degree    = shape_data.fe_degree;
+      AssertIndexRange(n_dofs_1d, max_n_dofs_1d_hanging_nodes + 1);
+      AssertDimension(shape_data.subface_interpolation_matrices[0].size(),
+                      n_dofs_1d * n_dofs_1d);
+
+      const bool all_lanes = lanes.all();
+      Number     tmp[max_n_dofs_1d_hanging_nodes];
+
+      // interpolate along a single line of degrees of freedom starting at
+      // 'offset' with the given stride, where the lower (type bit set) or the
+      // upper half of the coarse line is selected by 'type'
+      const auto interpolate_line = [&](const unsigned int offset,
+                                        const unsigned int stride,
+                                        const bool         type) {
+        const Number *weights =
+          shape_data.subface_interpolation_matrices[type ? 0 : 1].begin();
+        for (unsigned int k = 0; k < n_dofs_1d; ++k)
+          {
+            Number sum = Number();
+            if (transpose)
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                sum += weights[i * n_dofs_1d + k] * values[offset + i * stride];
+            else
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                sum += weights[k * n_dofs_1d + i] * values[offset + i * stride];
+            tmp[k] = sum;
+          }
+        if (all_lanes)
+          for (unsigned int k = 0; k < n_dofs_1d; ++k)
+            values[offset + k * stride] = tmp[k];
+        else
+          for (unsigned int k = 0; k < n_dofs_1d; ++k)
+            for (unsigned int v = 0; v < Number::size(); ++v)
+              if (lanes[v])
+                values[offset + k * stride][v] = tmp[k][v];
+      };
+
+      const auto interpolate_direction = [&](const unsigned int direction) {
+        const bool type = mask & (constr_type_x << direction);
+        if (dim == 2)
+          {
+            // a line along 'direction' is constrained if the face with the
+            // other direction as normal is constrained and the line is on
+            // that face
+            const unsigned int other = 1 - direction;
+            if (mask & (constr_face_x << other))
+              {
+                const unsigned int index =
+                  (mask & (constr_type_x << other)) ? 0 : degree;
+                interpolate_line(index * Utilities::pow(n_dofs_1d, other),
+                                 Utilities::pow(n_dofs_1d, direction),
+                                 type);
+              }
+          }
+        else if (dim == 3)
+          {
+            const unsigned int direction1 = (direction + 1) % 3;
+            const unsigned int direction2 = (direction + 2) % 3;
+            const unsigned short face1    = constr_face_x << direction1;
+            const unsigned short face2    = constr_face_x << direction2;
+            const unsigned short edge     = constr_edge_xy << direction1;
+            if ((mask & (face1 | face2 | edge)) == 0)
+              return;
+
+            const unsigned int index1 =
+              (mask & (constr_type_x << direction1)) ? 0 : degree;
+            const unsigned int index2 =
+              (mask & (constr_type_x << direction2)) ? 0 : degree;
+            const unsigned int stride1 = Utilities::pow(n_dofs_1d, direction1);
+            const unsigned int stride2 = Utilities::pow(n_dofs_1d, direction2);
+            for (unsigned int i2 = 0; i2 < n_dofs_1d; ++i2)
+              for (unsigned int i1 = 0; i1 < n_dofs_1d; ++i1)
+                {
+                  const bool on_face1 = (i1 == index1);
+                  const bool on_face2 = (i2 == index2);
+                  if (((mask & face1) && on_face1) ||
+                      ((mask & face2) && on_face2) ||
+                      ((mask & edge) && on_face1 && on_face2))
+                    interpolate_line(i1 * stride1 + i2 * stride2,
+                                     Utilities::pow(n_dofs_1d, direction),
+                                     type);
+                }
+          }
+        else
+          Assert(false, ExcNotImplemented());
+      };
+
+      // the interpolation is the product of the interpolations along the
+      // directions, so apply the transposed factors in reverse order
+      if (transpose)
+        for (int d = dim - 1; d >= 0; --d)
+          interpolate_direction(d);
+      else
+        for (unsigned int d = 0; d < dim; ++d)
+          interpolate_direction(d);
+    }
+
+
+
+    template <int dim>
+    inline HangingNodes<dim>::HangingNodes(
+      const DoFHandler<dim> &          dof_handler,
+      const std::vector<unsigned int> &lexicographic_mapping)
+      : n_raw_lines(dof_handler.get_triangulation().n_raw_lines())
+      , line_to_cells(dim == 3 ? n_raw_lines : 0)
+      , lexicographic_mapping(lexicographic_mapping)
+      , fe_degree(dof_handler.get_fe().degree)
+      , dof_handler(dof_handler)
+    {
+      // Set up line-to-cell mapping for edge constraints (only if dim = 3)
+      setup_line_to_cell();
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::setup_line_to_cell()
+    {}
+
+
+
+    template <>
+    inline void
+    HangingNodes<3>::setup_line_to_cell()
+    {
+      // In 3D, we can have DoFs on only an edge being constrained (e.g. in a
+      // cartesian 2x2x2 grid, where only the upper left 2 cells are refined).
+      // This sets up a helper data structure in the form of a mapping from
+      // edges (i.e. lines) to neighboring cells.
+
+      // Mapping from an edge to which children that share that edge.
+      const unsigned int line_to_children[12][2] = {{0, 2},
+                                                    {1, 3},
+                                                    {0, 1},
+                                                    {2, 3},
+                                                    {4, 6},
+                                                    {5, 7},
+                                                    {4, 5},
+                                                    {6, 7},
+                                                    {0, 4},
+                                                    {1, 5},
+                                                    {2, 6},
+                                                    {3, 7}};
+
+      std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+        line_to_inactive_cells(n_raw_lines);
+
+      // First add active and inactive cells to their lines:
+      for (const auto &cell : dof_handler.cell_iterators())
+        {
+          for (unsigned int line = 0; line < GeometryInfo<3>::lines_per_cell;
+               ++line)
+            {
+              const unsigned int line_idx = cell->line(line)->index();
+              if (cell->is_active())
+                line_to_cells[line_idx].push_back(std::make_pair(cell, line));
+              else
+                line_to_inactive_cells[line_idx].push_back(
+                  std::make_pair(cell, line));
+            }
+        }
+
+      // Now, we can access edge-neighboring active cells on same level to also
+      // access of an edge to the edges "children". These are found from looking
+      // at the corresponding edge of children of inactive edge neighbors.
+      for (unsigned int line_idx = 0; line_idx < n_raw_lines; ++line_idx)
+        {
+          if ((line_to_cells[line_idx].size() > 0) &&
+              line_to_inactive_cells[line_idx].size() > 0)
+            {
+              // We now have cells to add (active ones) and edges to which they
+              // should be added (inactive cells).
+              const cell_iterator &inactive_cell =
+                line_to_inactive_cells[line_idx][0].first;
+              const unsigned int neighbor_line =
+                line_to_inactive_cells[line_idx][0].second;
+
+              for (unsigned int c = 0; c < 2; ++c)
+                {
+                  const cell_iterator &child =
+                    inactive_cell->child(line_to_children[neighbor_line][c]);
+                  const unsigned int child_line_idx =
+                    child->line(neighbor_line)->index();
+
+                  // Now add all active cells
+                  for (const auto &cl : line_to_cells[line_idx])
+                    line_to_cells[child_line_idx].push_back(cl);
+                }
+            }
+        }
+    }
+
+
+
+    template <int dim>
+    inline bool
+    HangingNodes<dim>::setup_constraints(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      std::vector<types::global_dof_index> &                dof_indices,
+      unsigned short &                                      mask) const
+    {
+      mask                         = 0;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      const unsigned int dofs_per_face =
+        Utilities::fixed_power<dim - 1>(n_dofs_1d);
+
+      std::vector<types::global_dof_index> neighbor_dofs(dofs_per_face);
+
+      const auto lex_face_mapping =
+        FETools::lexicographic_to_hierarchic_numbering<dim - 1>(fe_degree);
+
+      for (const unsigned int face : GeometryInfo<dim>::face_indices())
+        {
+          if ((!cell->at_boundary(face)) &&
+              (cell->neighbor(face)->has_children() == false))
+            {
+              const active_cell_iterator &neighbor = cell->neighbor(face);
+
+              // Neighbor is coarser than us, i.e., face is constrained
+              if (neighbor->level() < cell->level())
+                {
+                  if (neighbor->is_artificial())
+                    return false;
+
+                  const unsigned int neighbor_face =
+                    cell->neighbor_face_no(face);
+
+                  // Find position of face on neighbor
+                  unsigned int subface = 0;
+                  for (; subface < GeometryInfo<dim>::max_children_per_face;
+                       ++subface)
+                    if (neighbor->neighbor_child_on_subface(neighbor_face,
+                                                            subface) == cell)
+                      break;
+
+                  // Get indices to read
+                  neighbor->face(neighbor_face)->get_dof_indices(neighbor_dofs);
+
+                  if (dim == 2)
+                    {
+                      if (face < 2)
+                        {
+                          mask |= constr_face_x;
+                          if (face == 0)
+                            mask |= constr_type_x;
+                          if (subface == 0)
+                            mask |= constr_type_y;
+                        }
+                      else
+                        {
+                          mask |= constr_face_y;
+                          if (face == 2)
+                            mask |= constr_type_y;
+                          if (subface == 0)
+                            mask |= constr_type_x;
+                        }
+
+                      // Reorder neighbor_dofs and copy into faceth face of
+                      // dof_indices
+
+                      // Offset if upper/right face
+                      unsigned int offset = (face % 2 == 1) ? fe_degree : 0;
+
+                      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                        {
+                          unsigned int idx = 0;
+                          // If X-line, i.e., if y = 0 or y = fe_degree
+                          if (face > 1)
+                            idx = n_dofs_1d * offset + i;
+                          // If Y-line, i.e., if x = 0 or x = fe_degree
+                          else
+                            idx = n_dofs_1d * i + offset;
+
+                          dof_indices[idx] = neighbor_dofs[lex_face_mapping[i]];
+                        }
+                    }
+                  else if (dim == 3)
+                    {
+                      const bool transpose = !(cell->face_orientation(face));
+
+                      int rotate = 0;
+
+                      if (cell->face_rotation(face))
+                        rotate -= 1;
+                      if (cell->face_flip(face))
+                        rotate -= 2;
+
+                      rotate_face(rotate, n_dofs_1d, neighbor_dofs);
+                      rotate_subface_index(rotate, subface);
+
+                      if (transpose)
+                        {
+                          transpose_face(neighbor_dofs);
+                          transpose_subface_index(subface);
+                        }
+
+                      // YZ-plane
+                      if (face < 2)
+                        {
+                          mask |= constr_face_x;
+                          if (face == 0)
+                            mask |= constr_type_x;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_y;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_z;
+                        }
+                      // XZ-plane
+                      else if (face < 4)
+                        {
+                          mask |= constr_face_y;
+                          if (face == 2)
+                            mask |= constr_type_y;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_z;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_x;
+                        }
+                      // XY-plane
+                      else
+                        {
+                          mask |= constr_face_z;
+                          if (face == 4)
+                            mask |= constr_type_z;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_x;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_y;
+                        }
+
+                      // Offset if upper/right/back face
+                      unsigned int offset = (face % 2 == 1) ? fe_degree : 0;
+
+                      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                        {
+                          for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                            {
+                              unsigned int idx = 0;
+                              // If YZ-plane, i.e., if x = 0 or x = fe_degree,
+                              // and orientation standard
+                              if (face < 2)
+                                idx = n_dofs_1d * n_dofs_1d * i +
+                                      n_dofs_1d * j + offset;
+                              // If XZ-plane, i.e., if y = 0 or y = fe_degree,
+                              // and orientation standard
+                              else if (face < 4)
+                                idx = n_dofs_1d * n_dofs_1d * j +
+                                      n_dofs_1d * offset + i;
+                              // If XY-plane, i.e., if z = 0 or z = fe_degree,
+                              // and orientation standard
+                              else
+                                idx = n_dofs_1d * n_dofs_1d * offset +
+                                      n_dofs_1d * i + j;
+
+                              dof_indices[idx] =
+                                neighbor_dofs[lex_face_mapping[n_dofs_1d * i +
+                                                               j]];
+                            }
+                        }
+                    }
+                  else
+                    Assert(false, ExcNotImplemented());
+                }
+            }
+        }
+
+      // In 3D we can have a situation where only DoFs on an edge are
+      // constrained. Append these here.
+      if (dim == 3)
+        {
+          // For each line on cell, which faces does it belong to, what is the
+          // edge mask, what is the types of the faces it belong to, and what is
+          // the type along the edge.
+          const unsigned short line_to_edge[12][4] = {
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_x | constr_type_z,
+             constr_type_y},
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_z,
+             constr_type_y},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_y | constr_type_z,
+             constr_type_x},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_z,
+             constr_type_x},
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_x,
+             constr_type_y},
+            {constr_face_x | constr_face_z, constr_edge_zx, 0, constr_type_y},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_y,
+             constr_type_x},
+            {constr_face_y | constr_face_z, constr_edge_yz, 0, constr_type_x},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_x | constr_type_y,
+             constr_type_z},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_y,
+             constr_type_z},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_x,
+             constr_type_z},
+            {constr_face_x | constr_face_y, constr_edge_xy, 0, constr_type_z}};
+
+          for (unsigned int local_line = 0;
+               local_line < GeometryInfo<dim>::lines_per_cell;
+               ++local_line)
+            {
+              // If we don't already have a constraint for as part of a face
+              if (!(mask & line_to_edge[local_line][0]))
+                {
+                  // For each cell which share that edge
+                  const unsigned int line = cell->line(local_line)->index();
+                  for (const auto &edge_neighbor : line_to_cells[line])
+                    {
+                      // If one of them is coarser than us
+                      const cell_iterator neighbor_cell = edge_neighbor.first;
+                      if (neighbor_cell->level() < cell->level())
+                        {
+                          if (neighbor_cell->is_artificial())
+                            return false;
+
+                          const unsigned int local_line_neighbor =
+                            edge_neighbor.second;
+                          mask |= line_to_edge[local_line][1] |
+                                  line_to_edge[local_line][2];
+
+                          bool flipped = false;
+                          if (cell->line(local_line)->vertex_index(0) ==
+                              neighbor_cell->line(local_line_neighbor)
+                                ->vertex_index(0))
+                            {
+                              // Assuming line directions match axes directions,
+                              // we have an unflipped edge of first type
+                              mask |= line_to_edge[local_line][3];
+                            }
+                          else if (cell->line(local_line)->vertex_index(1) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(1))
+                            {
+                              // We have an unflipped edge of second type
+                            }
+                          else if (cell->line(local_line)->vertex_index(1) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(0))
+                            {
+                              // We have a flipped edge of second type
+                              flipped = true;
+                            }
+                          else if (cell->line(local_line)->vertex_index(0) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(1))
+                            {
+                              // We have a flipped edge of first type
+                              mask |= line_to_edge[local_line][3];
+                              flipped = true;
+                            }
+                          else
+                            Assert(false, ExcInternalError());
+
+                          // Copy the unconstrained values
+                          neighbor_dofs.resize(n_dofs_1d * n_dofs_1d *
+                                               n_dofs_1d);
+                          neighbor_cell->get_dof_indices(neighbor_dofs);
+
+                          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                            {
+                              // Get local dof index along line
+                              const unsigned int idx =
+                                line_dof_idx(local_line, i, n_dofs_1d);
+                              dof_indices[idx] = neighbor_dofs
+                                [lexicographic_mapping[line_dof_idx(
+                                  local_line_neighbor,
+                                  flipped ? fe_degree - i : i,
+                                  n_dofs_1d)]];
+                            }
+
+                          // Stop looping over edge neighbors
+                          break;
+                        }
+                    }
+                }
+            }
+        }
+
+      return true;
+    }
+
+
+
+    template <int dim>
+    template <typename Number, typename number2>
+    inline bool
+    HangingNodes<dim>::constraints_are_compatible(
+      const std::vector<types::global_dof_index> &plain_indices,
+      const std::vector<types::global_dof_index> &resolved_indices,
+      const unsigned short                        mask,
+      const UnivariateShapeData<Number> &         shape_data,
+      const dealii::AffineConstraints<number2> &  constraints)
+    {
+      const unsigned int n_dofs = plain_indices.size();
+      AssertDimension(n_dofs, resolved_indices.size());
+
+      // compute the interpolation matrix of the mask by applying the
+      // interpolation to the unit vectors
+      std::vector<double> &matrix = interpolation_matrices[mask];
+      if (matrix.empty())
+        {
+          matrix.resize(n_dofs * n_dofs);
+          AlignedVector<Number> values(n_dofs);
+          for (unsigned int j = 0; j < n_dofs; ++j)
+            {
+              values.fill(Number());
+              values[j] = 1.;
+              interpolate_hanging_nodes<dim>(
+                shape_data,
+                mask,
+                false,
+                std::bitset<Number::size()>().flip(),
+                values.begin());
+              for (unsigned int i = 0; i < n_dofs; ++i)
+                matrix[i * n_dofs + j] = values[i][0];
+            }
+        }
+
+      const double tolerance = 1e-12;
+
+      std::map<types::global_dof_index, double> weights;
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          const double *row = matrix.data() + i * n_dofs;
+          if (plain_indices[i] == resolved_indices[i])
+            {
+              // an unconstrained degree of freedom must not be touched by
+              // the interpolation
+              for (unsigned int j = 0; j < n_dofs; ++j)
+                if (std::abs(row[j] - (i == j ? 1. : 0.)) > tolerance)
+                  return false;
+              continue;
+            }
+
+          const auto *entries =
+            constraints.get_constraint_entries(plain_indices[i]);
+          if (entries == nullptr ||
+              constraints.is_inhomogeneously_constrained(plain_indices[i]))
+            return false;
+
+          weights.clear();
+          for (unsigned int j = 0; j < n_dofs; ++j)
+            if (std::abs(row[j]) > tolerance)
+              {
+                if (constraints.is_constrained(resolved_indices[j]))
+                  return false;
+                weights[resolved_indices[j]] += row[j];
+              }
+
+          unsigned int n_entries = 0;
+          for (const auto &entry : *entries)
+            if (std::abs(entry.second) > tolerance)
+              {
+                const auto weight = weights.find(entry.first);
+                if (weight == weights.end() ||
+                    std::abs(weight->second - entry.second) > 1e-10)
+                  return false;
+                ++n_entries;
+              }
+          if (n_entries != weights.size())
+            return false;
+        }
+
+      return true;
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::rotate_subface_index(int           times,
+                                            unsigned int &subface_index) const
+    {
+      const unsigned int rot_mapping[4] = {2, 0, 3, 1};
+
+      times = times % 4;
+      times = times < 0 ? times + 4 : times;
+      for (int t = 0; t < times; ++t)
+        subface_index = rot_mapping[subface_index];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::rotate_face(
+      int                                   times,
+      unsigned int                          n_dofs_1d,
+      std::vector<types::global_dof_index> &dofs) const
+    {
+      const unsigned int rot_mapping[4] = {2, 0, 3, 1};
+
+      times = times % 4;
+      times = times < 0 ? times + 4 : times;
+
+      std::vector<types::global_dof_index> copy(dofs.size());
+      for (int t = 0; t < times; ++t)
+        {
+          std::swap(copy, dofs);
+
+          // Vertices
+          for (unsigned int i = 0; i < 4; ++i)
+            dofs[rot_mapping[i]] = copy[i];
+
+          // Edges
+          const unsigned int n_int  = n_dofs_1d - 2;
+          unsigned int       offset = 4;
+          for (unsigned int i = 0; i < n_int; ++i)
+            {
+              // Left edge
+              dofs[offset + i] = copy[offset + 2 * n_int + (n_int - 1 - i)];
+              // Right edge
+              dofs[offset + n_int + i] =
+                copy[offset + 3 * n_int + (n_int - 1 - i)];
+              // Bottom edge
+              dofs[offset + 2 * n_int + i] = copy[offset + n_int + i];
+              // Top edge
+              dofs[offset + 3 * n_int + i] = copy[offset + i];
+            }
+
+          // Interior points
+          offset += 4 * n_int;
+
+          for (unsigned int i = 0; i < n_int; ++i)
+            for (unsigned int j = 0; j < n_int; ++j)
+              dofs[offset + i * n_int + j] =
+                copy[offset + j * n_int + (n_int - 1 - i)];
+        }
+    }
+
+
+
+    template <int dim>
+    inline unsigned int
+    HangingNodes<dim>::line_dof_idx(int          local_line,
+                                    unsigned int dof,
+                                    unsigned int n_dofs_1d) const
+    {
+      unsigned int x, y, z;
+
+      if (local_line < 8)
+        {
+          x =
+            (local_line % 4 == 0) ? 0 : (local_line % 4 == 1) ? fe_degree : dof;
+          y =
+            (local_line % 4 == 2) ? 0 : (local_line % 4 == 3) ? fe_degree : dof;
+          z = (local_line / 4) * fe_degree;
+        }
+      else
+        {
+          x = ((local_line - 8) % 2) * fe_degree;
+          y = ((local_line - 8) / 2) * fe_degree;
+          z = dof;
+        }
+
+      return n_dofs_1d * n_dofs_1d * z + n_dofs_1d * y + x;
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::transpose_face(
+      std::vector<types::global_dof_index> &dofs) const
+    {
+      const std::vector<types::global_dof_index> copy(dofs);
+
+      // Vertices
+      dofs[1] = copy[2];
+      dofs[2] = copy[1];
+
+      // Edges
+      const unsigned int n_int  = fe_degree - 1;
+      unsigned int       offset = 4;
+      for (unsigned int i = 0; i < n_int; ++i)
+        {
+          // Right edge
+          dofs[offset + i] = copy[offset + 2 * n_int + i];
+          // Left edge
+          dofs[offset + n_int + i] = copy[offset + 3 * n_int + i];
+          // Bottom edge
+          dofs[offset + 2 * n_int + i] = copy[offset + i];
+          // Top edge
+          dofs[offset + 3 * n_int + i] = copy[offset + n_int + i];
+        }
+
+      // Interior
+      offset += 4 * n_int;
+      for (unsigned int i = 0; i < n_int; ++i)
+        for (unsigned int j = 0; j < n_int; ++j)
+          dofs[offset + i * n_int + j] = copy[offset + j * n_int + i];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::transpose_subface_index(unsigned int &subface) const
+    {
+      if (subface == 1)
+        subface = 2;
+      else if (subface == 2)
+        subface = 1;
+    }
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -31,6 +31,7 @@
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/helper_functions.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
 
@@ -318,6 +319,11 @@ namespace internal
        * for different kinds of iterators, e.g. standard DoFHandler,
        * multigrid, etc.)  on a fixed Triangulation. In addition, a mapping
        * and several quadrature formulas are given.
+       *
+       * If @p compute_jacobians_on_the_fly is set, the Jacobians and JxW
+       * values of cells of type GeometryType::general are not stored but
+       * only the support points of the mapping, see the member variable
+       * jacobians_on_the_fly.
        */
       void
       initialize(
@@ -330,7 +336,8 @@ namespace internal
         const UpdateFlags                              update_flags_cells,
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
-        const UpdateFlags update_flags_faces_by_cells);
+        const UpdateFlags update_flags_faces_by_cells,
+        const bool        compute_jacobians_on_the_fly = false);
 
       /**
        * Update the information in the given cells and faces that is the
@@ -437,6 +444,44 @@ namespace internal
        */
       SmartPointer<const Mapping<dim>> mapping;
 
+      /**
+       * Stores whether the inverse Jacobians and JxW values, and the
+       * Jacobian gradients if requested by the update flags, of cells of type
+       * GeometryType::general are computed on the fly by FEEvaluation from
+       * the support points in @p mapping_support_points rather than being
+       * read from @p cell_data. This is only enabled when requested in
+       * initialize() for a MappingQGeneric without hp-adaptivity. The entries
+       * of MappingInfoStorage::JxW_values, MappingInfoStorage::jacobians, and
+       * MappingInfoStorage::jacobian_gradients for the general cells in
+       * @p cell_data are then empty.
+       */
+      bool jacobians_on_the_fly = false;
+
+      /**
+       * The support points of the mapping on the cell batches of general
+       * type in case @p jacobians_on_the_fly is set, with the Gauss-Lobatto
+       * points of the mapping degree as the nodes and `dim` times the number
+       * of mapping points entries per cell batch, component by component.
+       * For reducing roundoff, the first support point of each lane is
+       * subtracted from all points of that lane, which does not change the
+       * Jacobians.
+       */
+      AlignedVector<VectorizedArrayType> mapping_support_points;
+
+      /**
+       * The start index of the support points of a cell batch in
+       * @p mapping_support_points, or numbers::invalid_unsigned_int for cell
+       * batches whose Jacobians are precomputed.
+       */
+      std::vector<unsigned int> mapping_support_point_offsets;
+
+      /**
+       * The interpolation matrices from the mapping support points to the
+       * quadrature points of the cells, one for each quadrature formula in
+       * @p cell_data, used for the computation of Jacobians on the fly.
+       */
+      std::vector<ShapeInfo<VectorizedArrayType>> mapping_shape_info;
+
       /**
        * Internal function to compute the geometry for the case the mapping is
        * a MappingQ and a single quadrature formula per slot (non-hp case) is
@@ -544,6 +589,78 @@ namespace internal
 
 
 
+    /**
+     * For second derivatives on the real cell, we need the gradient of the
+     * inverse Jacobian J. If L is the gradient of the Jacobian on the unit
+     * cell, the gradient of the inverse is given by (multidimensional
+     * calculus) - J * (J * L) * J (the third J is because we need to
+     * transform the gradient L from the unit to the real cell, and then apply
+     * the inverse Jacobian). Compare this with 1D with j(x) = 1/k(phi(x)),
+     * where j = phi' is the inverse of the jacobian and k is the derivative of
+     * the jacobian on the unit cell. Then j' = phi' k'/k^2 = j k' j^2.
+     *
+     * Given the transpose of the inverse Jacobian @p inv_jac and the gradient
+     * of the Jacobian @p jac_grad on the unit cell, this function returns the
+     * format stored in MappingInfoStorage::jacobian_gradients, i.e., the
+     * diagonal entries of the second derivatives first and then the
+     * upper-diagonal ones.
+     */
+    template <int dim, typename Number>
+    Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, Number>>
+    process_jacobian_gradient(const Tensor<2, dim, Number> &inv_jac,
+                              const Tensor<3, dim, Number> &jac_grad)
+    {
+      Number inv_jac_grad[dim][dim][dim];
+
+      // compute: inv_jac_grad = J*grad_unit(J^-1)
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          for (unsigned int f = 0; f < dim; ++f)
+            {
+              inv_jac_grad[f][e][d] = (inv_jac[f][0] * jac_grad[d][e][0]);
+              for (unsigned int g = 1; g < dim; ++g)
+                inv_jac_grad[f][e][d] += (inv_jac[f][g] * jac_grad[d][e][g]);
+            }
+
+      // compute: transpose (-jac * jac_grad[d] * jac)
+      Number tmp[dim];
+      Number grad_jac_inv[dim][dim][dim];
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          {
+            for (unsigned int f = 0; f < dim; ++f)
+              {
+                tmp[f] = Number();
+                for (unsigned int g = 0; g < dim; ++g)
+                  tmp[f] -= inv_jac_grad[d][f][g] * inv_jac[g][e];
+              }
+
+            // needed for non-diagonal part of Jacobian grad
+            for (unsigned int f = 0; f < dim; ++f)
+              {
+                grad_jac_inv[f][d][e] = inv_jac[f][0] * tmp[0];
+                for (unsigned int g = 1; g < dim; ++g)
+                  grad_jac_inv[f][d][e] += inv_jac[f][g] * tmp[g];
+              }
+          }
+
+      Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, Number>> result;
+
+      // the diagonal part of Jacobian gradient comes first
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          result[d][e] = grad_jac_inv[d][d][e];
+
+      // then the upper-diagonal part
+      for (unsigned int d = 0, count = 0; d < dim; ++d)
+        for (unsigned int e = d + 1; e < dim; ++e, ++count)
+          for (unsigned int f = 0; f < dim; ++f)
+            result[dim + count][f] = grad_jac_inv[d][e][f];
+      return result;
+    }
+
+
+
     /**
      * A class that is used to compare floating point arrays (e.g. std::vectors,
      * Tensor<1,dim>, etc.). The idea of this class is to consider two arrays as
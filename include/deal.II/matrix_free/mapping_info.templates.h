@@ -245,7 +245,11 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
-      mapping = nullptr;
+      mapping              = nullptr;
+      jacobians_on_the_fly = false;
+      mapping_support_points.clear();
+      mapping_support_point_offsets.clear();
+      mapping_shape_info.clear();
     }
 
 
@@ -309,7 +313,8 @@ namespace internal
       const UpdateFlags update_flags_cells,
       const UpdateFlags update_flags_boundary_faces,
       const UpdateFlags update_flags_inner_faces,
-      const UpdateFlags update_flags_faces_by_cells)
+      const UpdateFlags update_flags_faces_by_cells,
+      const bool        compute_jacobians_on_the_fly)
     {
       clear();
       this->mapping = &mapping;
@@ -323,11 +328,16 @@ namespace internal
       // the mapping that are independent of the FE
       this->update_flags_cells = compute_update_flags(update_flags_cells, quad);
 
+      // the Hessians on faces need the gradients of the Jacobians
       this->update_flags_boundary_faces =
         ((update_flags_inner_faces | update_flags_boundary_faces) &
              update_quadrature_points ?
            update_quadrature_points :
            update_default) |
+        ((update_flags_inner_faces | update_flags_boundary_faces) &
+             (update_hessians | update_jacobian_grads) ?
+           update_jacobian_grads :
+           update_default) |
         update_normal_vectors | update_JxW_values | update_jacobians;
       this->update_flags_inner_faces    = this->update_flags_boundary_faces;
       this->update_flags_faces_by_cells = update_flags_faces_by_cells;
@@ -354,10 +364,14 @@ namespace internal
 
       // In case we have no hp adaptivity (active_fe_index is empty), we have
       // cells, and the mapping is MappingQGeneric or a derived class, we can
-      // use the fast method.
+      // use the fast method. Only this method supports computing the
+      // Jacobians on the fly from the mapping support points.
       if (active_fe_index.empty() && !cells.empty() &&
           dynamic_cast<const MappingQGeneric<dim> *>(&mapping))
-        compute_mapping_q(tria, cells, face_info.faces);
+        {
+          jacobians_on_the_fly = compute_jacobians_on_the_fly;
+          compute_mapping_q(tria, cells, face_info.faces);
+        }
       else
         {
           // Could call these functions in parallel, but not useful because
@@ -390,12 +404,16 @@ namespace internal
         data.clear_data_fields();
 
       this->mapping = &mapping;
+      mapping_support_points.clear();
+      mapping_support_point_offsets.clear();
+      mapping_shape_info.clear();
 
       if (active_fe_index.empty() && !cells.empty() &&
           dynamic_cast<const MappingQGeneric<dim> *>(&mapping))
         compute_mapping_q(tria, cells, face_info.faces);
       else
         {
+          jacobians_on_the_fly = false;
           // Could call these functions in parallel, but not useful because
           // the work inside is nicely split up already
           initialize_cells(tria, cells, active_fe_index, mapping);
@@ -499,69 +517,6 @@ namespace internal
           }
       }
 
-      // For second derivatives on the real cell, we need the gradient of the
-      // inverse Jacobian J. This involves some calculus and is done
-      // vectorized. If L is the gradient of the jacobian on the unit cell,
-      // the gradient of the inverse is given by (multidimensional calculus) -
-      // J * (J * L) * J (the third J is because we need to transform the
-      // gradient L from the unit to the real cell, and then apply the inverse
-      // Jacobian). Compare this with 1D with j(x) = 1/k(phi(x)), where j =
-      // phi' is the inverse of the jacobian and k is the derivative of the
-      // jacobian on the unit cell. Then j' = phi' k'/k^2 = j k' j^2.
-      template <int dim, typename Number>
-      Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, Number>>
-      process_jacobian_gradient(const Tensor<2, dim, Number> &inv_jac,
-                                const Tensor<3, dim, Number> &jac_grad)
-      {
-        Number inv_jac_grad[dim][dim][dim];
-
-        // compute: inv_jac_grad = J*grad_unit(J^-1)
-        for (unsigned int d = 0; d < dim; ++d)
-          for (unsigned int e = 0; e < dim; ++e)
-            for (unsigned int f = 0; f < dim; ++f)
-              {
-                inv_jac_grad[f][e][d] = (inv_jac[f][0] * jac_grad[d][e][0]);
-                for (unsigned int g = 1; g < dim; ++g)
-                  inv_jac_grad[f][e][d] += (inv_jac[f][g] * jac_grad[d][e][g]);
-              }
-
-        // compute: transpose (-jac * jac_grad[d] * jac)
-        Number tmp[dim];
-        Number grad_jac_inv[dim][dim][dim];
-        for (unsigned int d = 0; d < dim; ++d)
-          for (unsigned int e = 0; e < dim; ++e)
-            {
-              for (unsigned int f = 0; f < dim; ++f)
-                {
-                  tmp[f] = Number();
-                  for (unsigned int g = 0; g < dim; ++g)
-                    tmp[f] -= inv_jac_grad[d][f][g] * inv_jac[g][e];
-                }
-
-              // needed for non-diagonal part of Jacobian grad
-              for (unsigned int f = 0; f < dim; ++f)
-                {
-                  grad_jac_inv[f][d][e] = inv_jac[f][0] * tmp[0];
-                  for (unsigned int g = 1; g < dim; ++g)
-                    grad_jac_inv[f][d][e] += inv_jac[f][g] * tmp[g];
-                }
-            }
-
-        Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, Number>> result;
-
-        // the diagonal part of Jacobian gradient comes first
-        for (unsigned int d = 0; d < dim; ++d)
-          for (unsigned int e = 0; e < dim; ++e)
-            result[d][e] = grad_jac_inv[d][d][e];
-
-        // then the upper-diagonal part
-        for (unsigned int d = 0, count = 0; d < dim; ++d)
-          for (unsigned int e = d + 1; e < dim; ++e, ++count)
-            for (unsigned int f = 0; f < dim; ++f)
-              result[dim + count][f] = grad_jac_inv[d][e][f];
-        return result;
-      }
-
       /**
        * Helper function called internally during the initialize function.
        */
@@ -1268,6 +1223,7 @@ namespace internal
         const std::vector<GeometryType> &  cell_type,
         const std::vector<bool> &          process_cell,
         const UpdateFlags                  update_flags_cells,
+        const bool                         jacobians_on_the_fly,
         const AlignedVector<double> &      plain_quadrature_points,
         const ShapeInfo<VectorizedDouble> &shape_info,
         MappingInfoStorage<dim, dim, Number, VectorizedArrayType> &my_data)
@@ -1291,7 +1247,14 @@ namespace internal
         for (unsigned int cell = begin_cell; cell < end_cell; ++cell)
           for (unsigned vv = 0; vv < n_lanes; vv += n_lanes_d)
             {
-              if (cell_type[cell] > affine || process_cell[cell])
+              // the Jacobians of general cells are not stored in case they
+              // are computed on the fly, but we might still need the
+              // quadrature points
+              const bool store_cell =
+                process_cell[cell] &&
+                !(jacobians_on_the_fly && cell_type[cell] > affine);
+              if (store_cell || (cell_type[cell] > affine &&
+                                 update_flags_cells & update_quadrature_points))
                 {
                   unsigned int start_indices[n_lanes_d];
                   for (unsigned int v = 0; v < n_lanes_d; ++v)
@@ -1335,7 +1298,7 @@ namespace internal
 
               const unsigned int n_points =
                 cell_type[cell] <= affine ? 1 : n_q_points;
-              if (process_cell[cell])
+              if (store_cell)
                 for (unsigned int q = 0; q < n_points; ++q)
                   {
                     const unsigned int idx =
@@ -2067,6 +2030,72 @@ namespace internal
 
 
 
+      /**
+       * Compute the gradient of the inverse Jacobian on a face from the
+       * inverse @p inv_jac of the Jacobian in the coordinates of the cell and
+       * the second derivatives of the mapping evaluated by
+       * FEFaceEvaluationSelector, which are given in the coordinate system of
+       * the face at the position @p face_grad_grads with a stride of
+       * @p n_q_points between the entries, and store the result in the
+       * format of MappingInfoStorage::jacobian_gradients in the coordinate
+       * system of the face into lane @p vv of @p jacobian_gradient.
+       */
+      template <int dim,
+                typename VectorizedDouble,
+                typename VectorizedArrayType>
+      void
+      store_face_jacobian_gradient(
+        const unsigned int                      face_no,
+        const Tensor<2, dim, VectorizedDouble> &inv_jac,
+        const VectorizedDouble *                face_grad_grads,
+        const unsigned int                      n_q_points,
+        const unsigned int                      vv,
+        Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
+          &jacobian_gradient)
+      {
+        constexpr unsigned int hess_dim = dim * (dim + 1) / 2;
+
+        // the mixed derivatives in the face are sorted as xy, xz, yz in the
+        // tangential and normal directions of the face, which we need to map
+        // back to the coordinate directions of the cell
+        Tensor<3, dim, VectorizedDouble> jac_grad;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            for (unsigned int e = 0; e < dim; ++e)
+              {
+                const unsigned int ee =
+                  reorder_face_derivative_indices<dim>(face_no, e);
+                jac_grad[d][ee][ee] =
+                  face_grad_grads[(d * hess_dim + e) * n_q_points];
+              }
+            for (unsigned int c = dim, e = 0; e < dim; ++e)
+              for (unsigned int f = e + 1; f < dim; ++f, ++c)
+                {
+                  const unsigned int ee =
+                    reorder_face_derivative_indices<dim>(face_no, e);
+                  const unsigned int ff =
+                    reorder_face_derivative_indices<dim>(face_no, f);
+                  jac_grad[d][ee][ff] = jac_grad[d][ff][ee] =
+                    face_grad_grads[(d * hess_dim + c) * n_q_points];
+                }
+          }
+
+        const auto inv_jac_grad =
+          process_jacobian_gradient(transpose(inv_jac), jac_grad);
+
+        // the gradients on the face are given in the coordinate system of the
+        // face, so reorder the derivative index again
+        for (unsigned int d = 0; d < hess_dim; ++d)
+          for (unsigned int e = 0; e < dim; ++e)
+            store_vectorized_array(
+              inv_jac_grad[d]
+                          [reorder_face_derivative_indices<dim>(face_no, e)],
+              vv,
+              jacobian_gradient[d][e]);
+      }
+
+
+
       /**
        * This evaluates the mapping information on a range of cells calling
        * into the tensor product interpolators of the matrix-free framework,
@@ -2096,10 +2125,15 @@ namespace internal
         const unsigned int n_q_points = my_data.descriptor[0].n_q_points;
         const unsigned int n_mapping_points =
           shape_info.dofs_per_component_on_cell;
+        constexpr unsigned int hess_dim = dim * (dim + 1) / 2;
+        const bool             compute_jacobian_grads =
+          update_flags_faces & update_jacobian_grads;
 
         AlignedVector<VectorizedDouble> cell_points(dim * n_mapping_points);
         AlignedVector<VectorizedDouble> face_quads(dim * n_q_points);
         AlignedVector<VectorizedDouble> face_grads(dim * dim * n_q_points);
+        AlignedVector<VectorizedDouble> face_grad_grads(
+          compute_jacobian_grads ? dim * hess_dim * n_q_points : 0);
         AlignedVector<VectorizedDouble> scratch_data(
           dim * (2 * n_q_points + 3 * n_mapping_points));
 
@@ -2134,9 +2168,11 @@ namespace internal
                          cell_points.data(),
                          face_quads.data(),
                          face_grads.data(),
+                         face_grad_grads.data(),
                          scratch_data.data(),
                          true,
                          true,
+                         compute_jacobian_grads,
                          face_no,
                          GeometryInfo<dim>::max_children_per_cell,
                          faces[face].face_orientation > 8 ?
@@ -2185,6 +2221,15 @@ namespace internal
                           my_data.jacobians[0][offset + q][d][e]);
                     }
 
+                  if (compute_jacobian_grads && face_type[face] > affine)
+                    store_face_jacobian_gradient(
+                      face_no,
+                      inv_jac,
+                      face_grad_grads.data() + q,
+                      n_q_points,
+                      vv,
+                      my_data.jacobian_gradients[0][offset + q]);
+
                   std::array<Tensor<1, dim, VectorizedDouble>, dim - 1>
                     tangential_vectors;
                   for (unsigned int d = 0; d != dim - 1; ++d)
@@ -2255,9 +2300,11 @@ namespace internal
                              cell_points.data(),
                              face_quads.data(),
                              face_grads.data(),
+                             face_grad_grads.data(),
                              scratch_data.data(),
                              false,
                              true,
+                             compute_jacobian_grads,
                              faces[face].exterior_face_no,
                              faces[face].subface_index,
                              faces[face].face_orientation < 8 ?
@@ -2289,6 +2336,15 @@ namespace internal
                               vv,
                               my_data.jacobians[1][offset + q][d][e]);
                         }
+
+                      if (compute_jacobian_grads && face_type[face] > affine)
+                        store_face_jacobian_gradient(
+                          faces[face].exterior_face_no,
+                          inv_jac,
+                          face_grad_grads.data() + q,
+                          n_q_points,
+                          vv,
+                          my_data.jacobian_gradients[1][offset + q]);
                       my_data.normals_times_jacobians[1][offset + q] =
                         my_data.normal_vectors[offset + q] *
                         my_data.jacobians[1][offset + q];
@@ -2402,13 +2458,6 @@ namespace internal
             face_data[my_q].JxW_values.size());
           face_data[my_q].jacobians[1].resize_fast(
             face_data[my_q].JxW_values.size());
-          if (update_flags_common & update_jacobian_grads)
-            {
-              face_data[my_q].jacobian_gradients[0].resize_fast(
-                face_data[my_q].JxW_values.size());
-              face_data[my_q].jacobian_gradients[1].resize_fast(
-                face_data[my_q].JxW_values.size());
-            }
           face_data[my_q].normals_times_jacobians[0].resize_fast(
             face_data[my_q].JxW_values.size());
           face_data[my_q].normals_times_jacobians[1].resize_fast(
@@ -2616,6 +2665,53 @@ namespace internal
                               preliminary_cell_type.data() + cell + n_lanes);
         }
 
+      // step 3b: in case the Jacobians of general cells are computed on the
+      // fly, keep the mapping support points of those cells in the
+      // vectorized layout used by FEEvaluation, and the interpolation
+      // matrices to the quadrature points in the precision of the
+      // VectorizedArrayType
+      if (jacobians_on_the_fly)
+        {
+          mapping_support_point_offsets.clear();
+          mapping_support_point_offsets.resize(cell_type.size(),
+                                               numbers::invalid_unsigned_int);
+          unsigned int n_general_cells = 0;
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            if (cell_type[cell] > affine && process_cell[cell])
+              mapping_support_point_offsets[cell] =
+                (n_general_cells++) * dim * n_mapping_points;
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            if (cell_type[cell] > affine && !process_cell[cell])
+              mapping_support_point_offsets[cell] =
+                mapping_support_point_offsets[cell_data_index_vect[cell]];
+
+          mapping_support_points.resize_fast(n_general_cells * dim *
+                                             n_mapping_points);
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            if (cell_type[cell] > affine && process_cell[cell])
+              {
+                VectorizedArrayType *points =
+                  mapping_support_points.data() +
+                  mapping_support_point_offsets[cell];
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      const double *lane_points =
+                        plain_quadrature_points.data() +
+                        (dim * (cell * n_lanes + v) + d) * n_mapping_points;
+                      for (unsigned int i = 0; i < n_mapping_points; ++i)
+                        points[d * n_mapping_points + i][v] =
+                          lane_points[i] - lane_points[0];
+                    }
+              }
+
+          FE_DGQ<dim> fe_geometry(mapping_degree);
+          mapping_shape_info.resize(cell_data.size());
+          for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
+            mapping_shape_info[my_q].reinit(
+              cell_data[my_q].descriptor[0].quadrature_1d, fe_geometry);
+        }
+
       // step 4: compute the data on cells from the cached quadrature
       // points, filling up all SIMD lanes as appropriate
       for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
@@ -2638,7 +2734,9 @@ namespace internal
               max_size =
                 std::max(max_size,
                          my_data.data_index_offsets[cell] +
-                           (cell_type[cell] <= affine ? 2 : n_q_points));
+                           (cell_type[cell] <= affine ?
+                              2 :
+                              (jacobians_on_the_fly ? 0 : n_q_points)));
             }
 
           my_data.JxW_values.resize_fast(max_size);
@@ -2676,6 +2774,7 @@ namespace internal
                 cell_type,
                 process_cell,
                 update_flags_cells,
+                jacobians_on_the_fly,
                 plain_quadrature_points,
                 shape_infos[my_q],
                 my_data);
@@ -2992,15 +3091,18 @@ namespace internal
                      (cell_it->at_boundary(face) &&
                       cell_it->has_periodic_neighbor(face)));
 
+                  // the derivatives on the neighbor are computed by
+                  // FEFaceEvaluation in the numbering of the neighbor's face,
+                  // so the reordering of the Jacobian must use that face
+                  unsigned int face_neigh = face;
                   if (is_local)
                     {
                       auto cell_it_neigh =
                         cell_it->neighbor_or_periodic_neighbor(face);
-                      fe_val_neigh.reinit(cell_it_neigh,
-                                          cell_it->at_boundary(face) ?
-                                            cell_it->periodic_neighbor_face_no(
-                                              face) :
-                                            cell_it->neighbor_face_no(face));
+                      face_neigh = cell_it->at_boundary(face) ?
+                                     cell_it->periodic_neighbor_face_no(face) :
+                                     cell_it->neighbor_face_no(face);
+                      fe_val_neigh.reinit(cell_it_neigh, face_neigh);
                     }
 
                   // copy data for affine data type
@@ -3026,22 +3128,20 @@ namespace internal
                               }
                         }
                       if (is_local && (update_flags & update_jacobians))
-                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                             ++q)
-                          {
-                            DerivativeForm<1, dim, dim> inv_jac =
-                              fe_val_neigh.jacobian(q).covariant_form();
-                            for (unsigned int d = 0; d < dim; ++d)
-                              for (unsigned int e = 0; e < dim; ++e)
-                                {
-                                  const unsigned int ee = ExtractFaceHelper::
-                                    reorder_face_derivative_indices<dim>(face,
-                                                                         e);
-                                  face_data_by_cells[my_q]
-                                    .jacobians[1][offset + q][d][e][v] =
-                                    inv_jac[d][ee];
-                                }
-                          }
+                        {
+                          DerivativeForm<1, dim, dim> inv_jac =
+                            fe_val_neigh.jacobian(0).covariant_form();
+                          for (unsigned int d = 0; d < dim; ++d)
+                            for (unsigned int e = 0; e < dim; ++e)
+                              {
+                                const unsigned int ee = ExtractFaceHelper::
+                                  reorder_face_derivative_indices<dim>(
+                                    face_neigh, e);
+                                face_data_by_cells[my_q]
+                                  .jacobians[1][offset][d][e][v] =
+                                  inv_jac[d][ee];
+                              }
+                        }
                       if (update_flags & update_jacobian_grads)
                         {
                           Assert(false, ExcNotImplemented());
@@ -3077,6 +3177,23 @@ namespace internal
                                     inv_jac[d][ee];
                                 }
                           }
+                      if (is_local && (update_flags & update_jacobians))
+                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
+                             ++q)
+                          {
+                            DerivativeForm<1, dim, dim> inv_jac =
+                              fe_val_neigh.jacobian(q).covariant_form();
+                            for (unsigned int d = 0; d < dim; ++d)
+                              for (unsigned int e = 0; e < dim; ++e)
+                                {
+                                  const unsigned int ee = ExtractFaceHelper::
+                                    reorder_face_derivative_indices<dim>(
+                                      face_neigh, e);
+                                  face_data_by_cells[my_q]
+                                    .jacobians[1][offset + q][d][e][v] =
+                                    inv_jac[d][ee];
+                                }
+                          }
                       if (update_flags & update_jacobian_grads)
                         {
                           Assert(false, ExcNotImplemented());
@@ -3131,6 +3248,9 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(face_data);
       memory += cell_type.capacity() * sizeof(GeometryType);
       memory += face_type.capacity() * sizeof(GeometryType);
+      memory += MemoryConsumption::memory_consumption(mapping_support_points);
+      memory +=
+        MemoryConsumption::memory_consumption(mapping_support_point_offsets);
       memory += sizeof(*this);
       return memory;
     }
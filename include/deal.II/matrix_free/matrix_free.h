@@ -48,6 +48,7 @@
 #include <deal.II/matrix_free/task_info.h>
 #include <deal.II/matrix_free/type_traits.h>
 
+#include <array>
 #include <cstdlib>
 #include <limits>
 #include <list>
@@ -224,7 +225,11 @@ public:
       const bool         initialize_mapping  = true,
       const bool         overlap_communication_computation    = true,
       const bool         hold_all_faces_to_owned_cells        = false,
-      const bool         cell_vectorization_categories_strict = false)
+      const bool         cell_vectorization_categories_strict = false,
+      const MPI_Comm     communicator_sm                      = MPI_COMM_SELF,
+      const bool         use_fast_hanging_node_algorithm      = true,
+      const bool         compute_jacobians_on_the_fly         = false,
+      const bool         share_evaluator_scratch_data         = false)
       : tasks_parallel_scheme(tasks_parallel_scheme)
       , tasks_block_size(tasks_block_size)
       , mapping_update_flags(mapping_update_flags)
@@ -240,6 +245,10 @@ public:
       , hold_all_faces_to_owned_cells(hold_all_faces_to_owned_cells)
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
+      , communicator_sm(communicator_sm)
+      , use_fast_hanging_node_algorithm(use_fast_hanging_node_algorithm)
+      , compute_jacobians_on_the_fly(compute_jacobians_on_the_fly)
+      , share_evaluator_scratch_data(share_evaluator_scratch_data)
     {}
 
     /**
@@ -265,6 +274,10 @@ public:
       , cell_vectorization_category(other.cell_vectorization_category)
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
+      , communicator_sm(other.communicator_sm)
+      , use_fast_hanging_node_algorithm(other.use_fast_hanging_node_algorithm)
+      , compute_jacobians_on_the_fly(other.compute_jacobians_on_the_fly)
+      , share_evaluator_scratch_data(other.share_evaluator_scratch_data)
     {}
 
     /**
@@ -291,6 +304,10 @@ public:
       cell_vectorization_category   = other.cell_vectorization_category;
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
+      communicator_sm                 = other.communicator_sm;
+      use_fast_hanging_node_algorithm = other.use_fast_hanging_node_algorithm;
+      compute_jacobians_on_the_fly    = other.compute_jacobians_on_the_fly;
+      share_evaluator_scratch_data    = other.share_evaluator_scratch_data;
 
       return *this;
     }
@@ -523,6 +540,91 @@ public:
      * them in a single vectorized array.
      */
     bool cell_vectorization_categories_strict;
+
+    /**
+     * Communicator of the processes that share memory with the current
+     * process, e.g. obtained by MPI_Comm_split_type() with
+     * MPI_COMM_TYPE_SHARED on the communicator of the triangulation. If it
+     * contains more than one process, it is handed to the partitioners of
+     * the vectors, see
+     * Utilities::MPI::Partitioner::set_shared_memory_communicator(), and
+     * vectors initialized via initialize_dof_vector() are allocated in MPI
+     * shared-memory windows. The ghost exchange inside the loops then
+     * copies the entries owned by processes on the same node directly from
+     * their memory instead of sending MPI messages. The default
+     * MPI_COMM_SELF disables this feature.
+     *
+     * @note In this case, all vectors passed to the loops need to be
+     * initialized via initialize_dof_vector() or with the partitioner
+     * returned by get_vector_partitioner().
+     */
+    MPI_Comm communicator_sm;
+
+    /**
+     * Option to resolve the constraints from hanging nodes directly on the
+     * cells rather than through the general constraint pool. If enabled,
+     * the degrees of freedom on the refined side of a hanging face or edge
+     * are replaced by the ones of the coarser neighbor when setting up this
+     * class, and only a few bits per cell that describe the refinement
+     * configuration are stored. FEEvaluation::read_dof_values() and
+     * FEEvaluation::distribute_local_to_global() then apply the
+     * interpolation from the coarse to the fine side by sum factorization
+     * on the affected faces and edges, which avoids the indirect access into
+     * the constraint pool for each entry.
+     *
+     * This algorithm is only used for scalar FE_Q elements in 2D and 3D on
+     * active cells without hp-adaptivity, for cells owned by the current
+     * process, and if the plain indices are stored (see
+     * @p store_plain_indices). On cells where the hanging-node constraints
+     * of the given AffineConstraints object do not match the interpolation
+     * of the element, e.g. because of additional constraints on the
+     * degrees of freedom of the coarser neighbor, the general constraint
+     * pool is used. Defaults to true.
+     */
+    bool use_fast_hanging_node_algorithm;
+
+    /**
+     * Option to not store the inverse Jacobians and JxW values on the
+     * quadrature points of cells with a general (curved or otherwise
+     * non-affine) geometry. Instead, only the support points of the mapping
+     * are kept for those cells, and FEEvaluation::reinit() computes the
+     * geometric factors on the fly by evaluating the gradients of the
+     * mapping polynomial with sum factorization. For high polynomial degrees
+     * on deformed meshes, the memory transfer of the precomputed Jacobians
+     * often dominates the cost of an operator evaluation, which this option
+     * trades for some additional arithmetic work. Cartesian and affine cells
+     * are not affected since they only store a single Jacobian per cell
+     * batch anyway.
+     *
+     * If second derivatives are requested via @p mapping_update_flags, the
+     * gradients of the inverse Jacobians needed by FEEvaluation::get_hessian()
+     * are computed on the fly from the second derivatives of the mapping as
+     * well, which avoids storing the largest of all geometric fields.
+     *
+     * This option is only available for mappings derived from
+     * MappingQGeneric without hp-adaptivity. In other cases, the flag is
+     * silently ignored and all data is precomputed. The face data is not
+     * affected by this option. Defaults to false.
+     */
+    bool compute_jacobians_on_the_fly;
+
+    /**
+     * Option to let all FEEvaluation and FEFaceEvaluation objects that are
+     * constructed on the same thread share the temporary memory they use
+     * within their evaluate() and integrate() functions, see
+     * acquire_shared_scratch_data(). This temporary memory makes up a
+     * considerable part of the memory footprint of an evaluator, so
+     * kernels that combine many evaluators, e.g. in multi-physics
+     * applications, touch less memory and stay in faster caches. The
+     * arrays for values, gradients, and Hessians remain separate for each
+     * evaluator because user code needs them at the same time.
+     *
+     * When this option is enabled, the array returned by
+     * FEEvaluationBase::get_scratch_data() is overwritten by the
+     * evaluate() and integrate() calls of all other evaluators of the
+     * same thread, not only the ones of the same object. Defaults to false.
+     */
+    bool share_evaluator_scratch_data;
   };
 
   /**
@@ -1300,6 +1402,20 @@ public:
    * FEFaceEvalution::reinit(cell, face_no) to access quantities on arbitrary
    * faces of a cell and the respective neighbors.
    *
+   * A typical face term of a discontinuous Galerkin operator then combines an
+   * FEFaceEvaluation object constructed with `is_interior_face == true` and
+   * one with `is_interior_face == false`, both initialized with the same cell
+   * batch and face number. The former is used for the cells of the batch
+   * including the integration, whereas the latter only reads and evaluates
+   * the values of the neighbors. Since each face is visited from both sides,
+   * this does twice the work of loop() for the numerical fluxes, but it
+   * writes only to the entries of the cells in the batch, avoids the
+   * accumulation into the neighbors, and lets the cell and face terms of a
+   * cell share the same data in caches. This requires to set
+   * AdditionalData::mapping_update_flags_faces_by_cells and the
+   * @p src_vector_face_access must allow access to all face values or
+   * gradients of the neighbors, which is also the default.
+   *
    * @param cell_operation Pointer to member function of `CLASS` with the
    * signature <tt>cell_operation (const MatrixFree<dim,Number> &, OutVector &,
    * InVector &, std::pair<unsigned int,unsigned int> &)</tt> where the first
@@ -1759,6 +1875,22 @@ public:
   unsigned int
   n_active_entries_per_face_batch(const unsigned int face_batch_number) const;
 
+  /**
+   * Return the fraction of the lanes of all cell batches in n_cell_batches()
+   * that are filled with actual cells, i.e., the ratio between the number of
+   * locally owned cells and the number of cell batches times the length of
+   * the vectorization. Since the computations run on all lanes, a value
+   * considerably smaller than one indicates that a corresponding fraction of
+   * the arithmetic work is spent on padding. This typically happens with hp
+   * adaptivity or with cell vectorization categories, where each degree or
+   * category forms batches of its own, with few cells per group. In that
+   * case, merging categories or reducing the number of different degrees,
+   * or choosing a shorter vectorization length via the template argument @p
+   * VectorizedArrayType, increases the efficiency.
+   */
+  double
+  get_vectorization_fill_ratio() const;
+
   /**
    * Return the number of degrees of freedom per cell for a given hp index.
    */
@@ -1854,6 +1986,60 @@ public:
   void
   print_memory_consumption(StreamType &out) const;
 
+  /**
+   * Prints the wall time spent in the different phases of the last call to
+   * reinit() to the given output stream, namely the setup of the shape
+   * information, the face topology, the extraction of the DoF indices, the
+   * partitioning of the cells, the face batches together with the vector
+   * access patterns, and the mapping information. In parallel, the minimum,
+   * average and maximum over all MPI ranks are printed, which makes this
+   * function a collective operation.
+   */
+  template <typename StreamType>
+  void
+  print_setup_timings(StreamType &out) const;
+
+  /**
+   * Return an estimate of the number of bytes that a cell_loop() over all
+   * cell batches transfers from and to main memory. The estimate adds the
+   * vector entries of the DoFHandler with index @p dof_handler_index,
+   * where each of the @p n_src_vectors source vectors is read including its
+   * ghost entries and each of the @p n_dst_vectors destination vectors is
+   * read and written, the DoF indices according to the storage variant
+   * chosen for each cell batch, and the Jacobians and their determinants for
+   * the quadrature formula with index @p quad_index. Data the operator
+   * accesses in addition, such as coefficients, is not included.
+   *
+   * Caches are assumed to not hold any of the data between two loops, which
+   * is the relevant case for large problems.
+   */
+  std::size_t
+  estimate_cell_loop_memory_transfer(
+    const unsigned int dof_handler_index = 0,
+    const unsigned int quad_index        = 0,
+    const unsigned int n_src_vectors     = 1,
+    const unsigned int n_dst_vectors     = 1) const;
+
+  /**
+   * Print the memory transfer estimated by
+   * estimate_cell_loop_memory_transfer(), split into the vector, index and
+   * geometry data, the resulting number of bytes per degree of freedom, and
+   * the bandwidth achieved by a cell_loop() that took @p time_per_loop
+   * seconds. If a value for the @p stream_bandwidth (in GB/s) measured on
+   * the machine is given, the bandwidth is also reported as a fraction of
+   * the latter. In parallel, the data is summed over all MPI ranks and the
+   * maximal time is used, which makes this function a collective operation.
+   */
+  template <typename StreamType>
+  void
+  print_cell_loop_performance(StreamType &       out,
+                              const double       time_per_loop,
+                              const unsigned int dof_handler_index = 0,
+                              const unsigned int quad_index        = 0,
+                              const unsigned int n_src_vectors     = 1,
+                              const unsigned int n_dst_vectors     = 1,
+                              const double       stream_bandwidth  = 0.) const;
+
   /**
    * Prints a summary of this class to the given output stream. It is focused
    * on the indices, and does not print all the data stored.
@@ -1957,6 +2143,21 @@ public:
   void
   release_scratch_data(const AlignedVector<VectorizedArrayType> *memory) const;
 
+  /**
+   * Return a pointer to temporary memory of at least @p size entries that is
+   * shared between all callers on the current thread, or a null pointer if
+   * AdditionalData::share_evaluator_scratch_data was not set. The memory is
+   * owned by this class and remains valid until the MatrixFree object is
+   * destroyed, even if requests with a larger size are made later. As
+   * opposed to acquire_scratch_data(), the memory is not reserved for
+   * exclusive use by the caller and may only be used for temporary data that
+   * is not expected to survive calls of other users. This interface is used
+   * by FEEvaluation objects for the intermediate results of the sum
+   * factorization.
+   */
+  VectorizedArrayType *
+  acquire_shared_scratch_data(const std::size_t size) const;
+
   /**
    * Obtains a scratch data object for internal use. Make sure to release it
    * afterwards by passing the pointer you obtain from this object to the
@@ -2029,6 +2230,16 @@ private:
   void
   make_connectivity_graph_faces(DynamicSparsityPattern &connectivity);
 
+  /**
+   * Compute the bytes transferred by a cell loop separately for the vectors,
+   * the indices and the geometry, see estimate_cell_loop_memory_transfer().
+   */
+  std::array<std::size_t, 3>
+  compute_cell_loop_memory_transfer(const unsigned int dof_handler_index,
+                                    const unsigned int quad_index,
+                                    const unsigned int n_src_vectors,
+                                    const unsigned int n_dst_vectors) const;
+
   /**
    * This struct defines which DoFHandler has actually been given at
    * construction, in order to define the correct behavior when querying the
@@ -2136,6 +2347,12 @@ private:
    */
   bool mapping_is_initialized;
 
+  /**
+   * Wall times of the phases of the last call to reinit(), see
+   * print_setup_timings().
+   */
+  std::vector<std::pair<std::string, double>> setup_timings;
+
   /**
    * Scratchpad memory for use in evaluation. We allow more than one
    * evaluation object to attach to this field (this, the outer
@@ -2147,6 +2364,22 @@ private:
     std::list<std::pair<bool, AlignedVector<VectorizedArrayType>>>>
     scratch_pad;
 
+  /**
+   * Scratchpad memory shared between all evaluation objects of a thread, see
+   * acquire_shared_scratch_data(). The front of each list holds the largest
+   * array, whereas the other arrays are kept alive for the evaluation
+   * objects that requested memory before the array was enlarged.
+   */
+  mutable Threads::ThreadLocalStorage<
+    std::list<AlignedVector<VectorizedArrayType>>>
+    shared_scratch_pad;
+
+  /**
+   * Stores whether acquire_shared_scratch_data() hands out memory, see
+   * AdditionalData::share_evaluator_scratch_data.
+   */
+  bool share_evaluator_scratch_data;
+
   /**
    * Scratchpad memory for use in evaluation and other contexts, non-thread
    * safe variant.
@@ -2481,6 +2714,24 @@ MatrixFree<dim, Number, VectorizedArrayType>::n_active_entries_per_cell_batch(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+inline double
+MatrixFree<dim, Number, VectorizedArrayType>::get_vectorization_fill_ratio()
+  const
+{
+  const unsigned int n_batches = n_cell_batches();
+  if (n_batches == 0)
+    return 1.;
+
+  std::size_t n_filled_lanes = 0;
+  for (unsigned int cell = 0; cell < n_batches; ++cell)
+    n_filled_lanes += n_active_entries_per_cell_batch(cell);
+  return static_cast<double>(n_filled_lanes) /
+         (static_cast<double>(n_batches) * VectorizedArrayType::size());
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline unsigned int
 MatrixFree<dim, Number, VectorizedArrayType>::n_active_entries_per_face_batch(
@@ -2754,6 +3005,26 @@ MatrixFree<dim, Number, VectorizedArrayType>::release_scratch_data(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+VectorizedArrayType *
+MatrixFree<dim, Number, VectorizedArrayType>::acquire_shared_scratch_data(
+  const std::size_t size) const
+{
+  if (share_evaluator_scratch_data == false)
+    return nullptr;
+
+  // never resize an array that has been handed out before, as other
+  // evaluation objects might still point into it, but put a larger array in
+  // front of the list instead
+  std::list<AlignedVector<VectorizedArrayType>> &data =
+    shared_scratch_pad.get();
+  if (data.empty() || data.front().size() < size)
+    data.emplace_front(size);
+  return data.front().begin();
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 AlignedVector<Number> *
 MatrixFree<dim, Number, VectorizedArrayType>::
@@ -3049,6 +3320,26 @@ MatrixFree<dim, Number, VectorizedArrayType>::reinit(
 // additional helper functions to select the blocks and template magic.
 namespace internal
 {
+  // return the arrays of the processes sharing memory with the current
+  // process, which are only available for LinearAlgebra::distributed::Vector
+  template <typename Number, typename VectorType>
+  std::vector<ArrayView<const Number>>
+  get_shared_vector_data(const VectorType &)
+  {
+    return {};
+  }
+
+
+
+  template <typename Number>
+  const std::vector<ArrayView<const Number>> &
+  get_shared_vector_data(const LinearAlgebra::distributed::Vector<Number> &vec)
+  {
+    return vec.shared_vector_data();
+  }
+
+
+
   /**
    * Internal class for exchanging data between vectors.
    */
@@ -3387,7 +3678,8 @@ namespace internal
             ArrayView<Number>(const_cast<Number *>(vec.begin()) +
                                 vec.get_partitioner()->local_size(),
                               vec.get_partitioner()->n_ghost_indices()),
-            this->requests[component_in_block_vector]);
+            this->requests[component_in_block_vector],
+            get_shared_vector_data<Number>(vec));
 
           matrix_free.release_scratch_data_non_threadsafe(
             tmp_data[component_in_block_vector]);
@@ -3603,7 +3895,8 @@ namespace internal
             ArrayView<Number>(vec.begin(), part.local_size()),
             ArrayView<Number>(vec.begin() + vec.get_partitioner()->local_size(),
                               vec.get_partitioner()->n_ghost_indices()),
-            this->requests[component_in_block_vector]);
+            this->requests[component_in_block_vector],
+            get_shared_vector_data<Number>(vec));
 
           matrix_free.release_scratch_data_non_threadsafe(
             tmp_data[component_in_block_vector]);
@@ -21,8 +21,11 @@
 
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/tria.h>
@@ -32,23 +35,25 @@
 #include <deal.II/fe/fe_dgp.h>
 #include <deal.II/fe/fe_dgq.h>
 #include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_q_dg0.h>
 
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/face_setup_internal.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/matrix_free.h>
 
 #ifdef DEAL_II_WITH_TBB
-#  include <deal.II/base/parallel.h>
-
 DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 #  include <tbb/concurrent_unordered_map.h>
 DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #endif
 
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -108,6 +113,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::MatrixFree()
   , indices_are_initialized(false)
   , mapping_is_initialized(false)
   , mg_level(numbers::invalid_unsigned_int)
+  , share_evaluator_scratch_data(false)
 {}
 
 
@@ -345,6 +351,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
   indices_are_initialized    = v.indices_are_initialized;
   mapping_is_initialized     = v.mapping_is_initialized;
   mg_level                   = v.mg_level;
+  share_evaluator_scratch_data = v.share_evaluator_scratch_data;
+  setup_timings              = v.setup_timings;
 }
 
 
@@ -361,9 +369,15 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
   const typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
     &additional_data)
 {
+  setup_timings.clear();
+  Timer timer;
+
   // Store the level of the mesh to be worked on.
   this->mg_level = additional_data.mg_level;
 
+  this->share_evaluator_scratch_data =
+    additional_data.share_evaluator_scratch_data;
+
   // Reads out the FE information and stores the shape function values,
   // gradients and Hessians for quadrature points.
   {
@@ -381,6 +395,10 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
       n_quad_in_collection = std::max(n_quad_in_collection, quad[q].size());
     shape_info.reinit(TableIndices<4>(
       n_components, n_quad, n_fe_in_collection, n_quad_in_collection));
+
+    // the entries of the shape info table are independent of each other, so
+    // we set them up in parallel
+    Threads::TaskGroup<> tasks;
     for (unsigned int no = 0, c = 0; no < dof_handler.size(); no++)
       for (unsigned int b = 0; b < dof_handler[no]->get_fe(0).n_base_elements();
            ++b, ++c)
@@ -389,9 +407,14 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
              ++fe_no)
           for (unsigned int nq = 0; nq < n_quad; nq++)
             for (unsigned int q_no = 0; q_no < quad[nq].size(); ++q_no)
-              shape_info(c, nq, fe_no, q_no)
-                .reinit(quad[nq][q_no], dof_handler[no]->get_fe(fe_no), b);
+              tasks += Threads::new_task([&, no, b, c, fe_no, nq, q_no]() {
+                shape_info(c, nq, fe_no, q_no)
+                  .reinit(quad[nq][q_no], dof_handler[no]->get_fe(fe_no), b);
+              });
+    tasks.join_all();
   }
+  setup_timings.emplace_back("shape info", timer.wall_time());
+  timer.restart();
 
   if (additional_data.initialize_indices == true)
     {
@@ -499,6 +522,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
   // determined in @p extract_local_to_global_indices.
   if (additional_data.initialize_mapping == true)
     {
+      timer.restart();
       mapping_info.initialize(
         dof_handler[0]->get_triangulation(),
         cell_level_index,
@@ -511,9 +535,11 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.compute_jacobians_on_the_fly);
 
       mapping_is_initialized = true;
+      setup_timings.emplace_back("mapping info", timer.wall_time());
     }
 }
 
@@ -735,6 +761,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
   const std::vector<IndexSet> &                          locally_owned_set,
   const AdditionalData &                                 additional_data)
 {
+  Timer timer;
+
   // insert possible ghost cells and construct face topology
   const bool do_face_integrals =
     (additional_data.mapping_update_flags_inner_faces |
@@ -747,6 +775,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                             dof_handlers.hp_dof_handler[0]->get_triangulation(),
                           additional_data,
                           cell_level_index);
+  setup_timings.emplace_back("face topology", timer.wall_time());
+  timer.restart();
 
   const unsigned int n_fe           = dof_handlers.n_dof_handlers;
   const unsigned int n_active_cells = cell_level_index.size();
@@ -875,6 +905,103 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
             static_cast<unsigned int>(i - start_index));
     }
 
+  // set up the resolution of hanging-node constraints within FEEvaluation
+  // for scalar FE_Q elements on active cells
+  std::vector<std::unique_ptr<internal::MatrixFreeFunctions::HangingNodes<dim>>>
+    hanging_nodes(n_fe);
+  if (dim > 1 && additional_data.use_fast_hanging_node_algorithm &&
+      additional_data.store_plain_indices &&
+      dof_handlers.active_dof_handler == DoFHandlers::usual &&
+      additional_data.mg_level == numbers::invalid_unsigned_int &&
+      dof_handlers.dof_handler[0]->get_triangulation().has_hanging_nodes())
+    for (unsigned int no = 0; no < n_fe; ++no)
+      {
+        const DoFHandler<dim> &dofh = *dof_handlers.dof_handler[no];
+        if (dynamic_cast<const FE_Q<dim> *>(&dofh.get_fe()) != nullptr &&
+            dofh.get_fe().degree <
+              internal::MatrixFreeFunctions::max_n_dofs_1d_hanging_nodes)
+          {
+            hanging_nodes[no] = std::make_unique<
+              internal::MatrixFreeFunctions::HangingNodes<dim>>(
+              dofh, lexicographic[no][0]);
+            dof_info[no].hanging_node_constraint_masks.resize(n_active_cells,
+                                                              0);
+          }
+      }
+  std::vector<types::global_dof_index> local_dof_indices_resolved;
+  std::vector<types::global_dof_index> plain_indices_lex, resolved_indices_lex;
+
+  // For the standard DoFHandler on active cells, reading the indices of a
+  // cell and resolving its hanging nodes only needs read access to the mesh
+  // and the DoFHandler. We do this work in parallel for batches of cells
+  // ahead of the loop below, which appends the compressed indices to the
+  // arrays in DoFInfo and must hence run in serial. The batches limit the
+  // memory of the intermediate arrays.
+  const bool gather_indices_in_parallel =
+    dof_handlers.active_dof_handler == DoFHandlers::usual &&
+    additional_data.mg_level == numbers::invalid_unsigned_int;
+  const unsigned int n_cells_per_batch = 4096;
+  unsigned int       batch_begin       = 0;
+  std::vector<std::vector<types::global_dof_index>> batch_dof_indices(n_fe);
+  std::vector<std::vector<types::global_dof_index>> batch_resolved_indices(
+    n_fe);
+  std::vector<std::vector<unsigned short>> batch_masks(n_fe);
+  const auto gather_batch = [&](const unsigned int begin,
+                                const unsigned int end) {
+    for (unsigned int no = 0; no < n_fe; ++no)
+      {
+        const DoFHandler<dim> &dofh          = *dof_handlers.dof_handler[no];
+        const unsigned int     dofs_per_cell = dof_info[no].dofs_per_cell[0];
+        batch_dof_indices[no].resize((end - begin) * dofs_per_cell);
+        if (hanging_nodes[no] != nullptr)
+          {
+            batch_resolved_indices[no].resize((end - begin) * dofs_per_cell);
+            batch_masks[no].resize(end - begin);
+          }
+        parallel::apply_to_subranges(
+          begin,
+          end,
+          [&](const unsigned int range_begin, const unsigned int range_end) {
+            std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+            std::vector<types::global_dof_index> indices_lex(dofs_per_cell);
+            for (unsigned int c = range_begin; c < range_end; ++c)
+              {
+                typename DoFHandler<dim>::active_cell_iterator cell_it(
+                  &dofh.get_triangulation(),
+                  cell_level_index[c].first,
+                  cell_level_index[c].second,
+                  &dofh);
+                cell_it->get_dof_indices(dof_indices);
+                const unsigned int offset = (c - begin) * dofs_per_cell;
+                std::copy(dof_indices.begin(),
+                          dof_indices.end(),
+                          batch_dof_indices[no].begin() + offset);
+
+                if (hanging_nodes[no] != nullptr)
+                  {
+                    unsigned short mask = 0;
+                    if (c < cell_level_index_end_local)
+                      {
+                        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                          indices_lex[i] = dof_indices[lexicographic[no][0][i]];
+                        if (hanging_nodes[no]->setup_constraints(cell_it,
+                                                                 indices_lex,
+                                                                 mask) ==
+                            false)
+                          mask = 0;
+                      }
+                    batch_masks[no][c - begin] = mask;
+                    if (mask != 0)
+                      std::copy(indices_lex.begin(),
+                                indices_lex.end(),
+                                batch_resolved_indices[no].begin() + offset);
+                  }
+              }
+          },
+          64);
+      }
+  };
+
   // extract all the global indices associated with the computation, and form
   // the ghost indices
   std::vector<unsigned int> subdomain_boundary_cells;
@@ -886,6 +1013,13 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
         (additional_data.overlap_communication_computation == false &&
          task_info.n_procs > 1);
 
+      if (gather_indices_in_parallel && counter % n_cells_per_batch == 0)
+        {
+          batch_begin = counter;
+          gather_batch(counter,
+                       std::min(counter + n_cells_per_batch, n_active_cells));
+        }
+
       for (unsigned int no = 0; no < n_fe; ++no)
         {
           // read indices from standard DoFHandler in the usual way
@@ -898,9 +1032,63 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                 cell_level_index[counter].first,
                 cell_level_index[counter].second,
                 dofh);
-              local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
-              cell_it->get_dof_indices(local_dof_indices);
-              dof_info[no].read_dof_indices(local_dof_indices,
+              const unsigned int dofs_per_cell = dof_info[no].dofs_per_cell[0];
+              const unsigned int offset =
+                (counter - batch_begin) * dofs_per_cell;
+              local_dof_indices.assign(batch_dof_indices[no].begin() + offset,
+                                       batch_dof_indices[no].begin() + offset +
+                                         dofs_per_cell);
+
+              // on the locally owned cells, replace the indices constrained
+              // by hanging nodes by the indices of the coarser neighbor if
+              // the interpolation within FEEvaluation reproduces the given
+              // constraints
+              bool cell_has_hanging_nodes = false;
+              if (hanging_nodes[no] != nullptr &&
+                  counter < cell_level_index_end_local &&
+                  batch_masks[no][counter - batch_begin] != 0)
+                {
+                  const std::vector<unsigned int> &lexicographic_inv =
+                    lexicographic[no][0];
+                  plain_indices_lex.resize(local_dof_indices.size());
+                  for (unsigned int i = 0; i < local_dof_indices.size(); ++i)
+                    plain_indices_lex[i] =
+                      local_dof_indices[lexicographic_inv[i]];
+                  resolved_indices_lex.assign(
+                    batch_resolved_indices[no].begin() + offset,
+                    batch_resolved_indices[no].begin() + offset +
+                      dofs_per_cell);
+
+                  const unsigned short mask =
+                    batch_masks[no][counter - batch_begin];
+                  if (hanging_nodes[no]->constraints_are_compatible(
+                        plain_indices_lex,
+                        resolved_indices_lex,
+                        mask,
+                        shape_info(dof_info[no].global_base_element_offset,
+                                   0,
+                                   0,
+                                   0)
+                          .data.front(),
+                        *constraint[no]))
+                    {
+                      local_dof_indices_resolved.resize(
+                        local_dof_indices.size());
+                      for (unsigned int i = 0; i < local_dof_indices.size();
+                           ++i)
+                        local_dof_indices_resolved[lexicographic_inv[i]] =
+                          resolved_indices_lex[i];
+                      dof_info[no].hanging_node_constraint_masks[counter] =
+                        mask;
+                      cell_has_hanging_nodes = true;
+                    }
+                }
+
+              dof_info[no].read_dof_indices(cell_has_hanging_nodes ?
+                                              local_dof_indices_resolved :
+                                              local_dof_indices,
+                                            local_dof_indices,
+                                            cell_has_hanging_nodes,
                                             lexicographic[no][0],
                                             *constraint[no],
                                             counter,
@@ -931,6 +1119,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
               local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
               cell_it->get_mg_dof_indices(local_dof_indices);
               dof_info[no].read_dof_indices(local_dof_indices,
+                                            local_dof_indices,
+                                            false,
                                             lexicographic[no][0],
                                             *constraint[no],
                                             counter,
@@ -962,6 +1152,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
               cell_it->get_dof_indices(local_dof_indices);
               dof_info[no].read_dof_indices(
                 local_dof_indices,
+                local_dof_indices,
+                false,
                 lexicographic[no][cell_it->active_fe_index()],
                 *constraint[no],
                 counter,
@@ -981,6 +1173,12 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
         subdomain_boundary_cells.push_back(counter);
     }
 
+  for (unsigned int no = 0; no < n_fe; ++no)
+    if (std::all_of(dof_info[no].hanging_node_constraint_masks.begin(),
+                    dof_info[no].hanging_node_constraint_masks.end(),
+                    [](const unsigned short mask) { return mask == 0; }))
+      dof_info[no].hanging_node_constraint_masks.clear();
+
   const unsigned int n_lanes     = VectorizedArrayType::size();
   task_info.n_active_cells       = cell_level_index_end_local;
   task_info.n_ghost_cells        = n_active_cells - cell_level_index_end_local;
@@ -1027,6 +1225,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
         dof_info[no].assign_ghosts(cells_with_ghosts);
       }
   }
+  setup_timings.emplace_back("DoF indices", timer.wall_time());
+  timer.restart();
 
   std::vector<unsigned int>  renumbering;
   std::vector<unsigned char> irregular_cells;
@@ -1316,6 +1516,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                                constraint_pool_row_index,
                                irregular_cells);
 
+  setup_timings.emplace_back("cell partitioning", timer.wall_time());
+  timer.restart();
+
   // Finally resort the faces and collect several faces for vectorization
   if ((additional_data.mapping_update_flags_inner_faces |
        additional_data.mapping_update_flags_boundary_faces) != update_default)
@@ -1824,8 +2027,25 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
         }
     }
 
+  // hand the shared-memory communicator to all partitioners, such that
+  // vectors and the data exchange within the loops can use shared memory
+  // among the processes on the same node. the partitioners are only created
+  // here, so it is safe to modify them
+  for (auto &di : dof_info)
+    {
+      const_cast<Utilities::MPI::Partitioner *>(di.vector_partitioner.get())
+        ->set_shared_memory_communicator(additional_data.communicator_sm);
+      for (auto &partitioner : di.vector_partitioner_face_variants)
+        if (partitioner.get() != nullptr &&
+            partitioner.get() != di.vector_partitioner.get())
+          const_cast<Utilities::MPI::Partitioner *>(partitioner.get())
+            ->set_shared_memory_communicator(additional_data.communicator_sm);
+    }
+
   for (unsigned int no = 0; no < n_fe; ++no)
     dof_info[no].compute_vector_zero_access_pattern(task_info, face_info.faces);
+  setup_timings.emplace_back("face batches and access pattern",
+                             timer.wall_time());
 
   indices_are_initialized = true;
 }
@@ -2066,6 +2286,187 @@ MatrixFree<dim, Number, VectorizedArrayType>::print_memory_consumption(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename StreamType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::print_setup_timings(
+  StreamType &out) const
+{
+  double total_time = 0;
+  for (const auto &timing : setup_timings)
+    {
+      const Utilities::MPI::MinMaxAvg time =
+        Utilities::MPI::min_max_avg(timing.second, task_info.communicator);
+      out << "   Setup " << std::left << std::setw(34) << timing.first + ":"
+          << std::right;
+      if (task_info.n_procs < 2)
+        out << time.min;
+      else
+        out << time.min << "/" << time.avg << "/" << time.max;
+      out << " s" << std::endl;
+      total_time += timing.second;
+    }
+  const Utilities::MPI::MinMaxAvg time =
+    Utilities::MPI::min_max_avg(total_time, task_info.communicator);
+  out << "  Setup matrix-free data total: --> ";
+  if (task_info.n_procs < 2)
+    out << time.min;
+  else
+    out << time.min << "/" << time.avg << "/" << time.max;
+  out << " s" << std::endl;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::array<std::size_t, 3>
+MatrixFree<dim, Number, VectorizedArrayType>::compute_cell_loop_memory_transfer(
+  const unsigned int dof_handler_index,
+  const unsigned int quad_index,
+  const unsigned int n_src_vectors,
+  const unsigned int n_dst_vectors) const
+{
+  AssertIndexRange(dof_handler_index, dof_info.size());
+  AssertIndexRange(quad_index, mapping_info.cell_data.size());
+  Assert(indices_are_initialized && mapping_is_initialized,
+         ExcMessage("The memory transfer can only be estimated once both "
+                    "the indices and the mapping have been initialized."));
+
+  using namespace internal::MatrixFreeFunctions;
+  const DoFInfo &    di           = dof_info[dof_handler_index];
+  const unsigned int n_lanes      = VectorizedArrayType::size();
+  const unsigned int n_components = di.start_components.back();
+  const MappingInfoStorage<dim, dim, Number, VectorizedArrayType> &geometry =
+    mapping_info.cell_data[quad_index];
+
+  std::array<std::size_t, 3> bytes = {{0, 0, 0}};
+
+  // the source vectors are read including their ghost entries, whereas the
+  // destination vectors are read and written back
+  bytes[0] =
+    (static_cast<std::size_t>(n_src_vectors) *
+       (di.vector_partitioner->local_size() +
+        di.vector_partitioner->n_ghost_indices()) +
+     2 * static_cast<std::size_t>(n_dst_vectors) *
+       di.vector_partitioner->local_size()) *
+    sizeof(Number);
+
+  for (unsigned int cell = 0; cell < n_cell_batches(); ++cell)
+    {
+      const unsigned int fe_index =
+        di.dofs_per_cell.size() > 1 ? di.cell_active_fe_index[cell] : 0;
+      const unsigned int dofs_per_cell = di.dofs_per_cell[fe_index];
+
+      switch (di.index_storage_variants[DoFInfo::dof_access_cell][cell])
+        {
+          case DoFInfo::IndexStorageVariants::full:
+            {
+              const unsigned int first = cell * n_lanes * n_components;
+              const unsigned int last =
+                std::min<std::size_t>(first + n_lanes * n_components,
+                                      di.row_starts.size() - 1);
+              bytes[1] += (di.row_starts[last].first -
+                           di.row_starts[first].first) *
+                            sizeof(unsigned int) +
+                          (di.row_starts[last].second -
+                           di.row_starts[first].second) *
+                            sizeof(std::pair<unsigned short, unsigned short>);
+              break;
+            }
+          case DoFInfo::IndexStorageVariants::interleaved:
+            bytes[1] += dofs_per_cell * n_lanes * sizeof(unsigned int);
+            break;
+          case DoFInfo::IndexStorageVariants::interleaved_compressed:
+            bytes[1] += dofs_per_cell * n_lanes * sizeof(unsigned short) +
+                        n_lanes * sizeof(unsigned int);
+            break;
+          default:
+            // contiguous variants only read the first index of each lane
+            bytes[1] += n_lanes * sizeof(unsigned int);
+            break;
+        }
+      if (!di.hanging_node_constraint_masks.empty())
+        bytes[1] += n_lanes * sizeof(unsigned short);
+
+      // Cartesian and affine cells store a single entry of the Jacobian and
+      // its determinant, general cells one entry per quadrature point
+      const unsigned int n_entries =
+        mapping_info.get_cell_type(cell) <= affine ?
+          1 :
+          geometry
+            .descriptor[std::min<std::size_t>(fe_index,
+                                              geometry.descriptor.size() - 1)]
+            .n_q_points;
+      bytes[2] += n_entries * (sizeof(VectorizedArrayType) +
+                               sizeof(Tensor<2, dim, VectorizedArrayType>));
+    }
+
+  return bytes;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::size_t
+MatrixFree<dim, Number, VectorizedArrayType>::
+  estimate_cell_loop_memory_transfer(const unsigned int dof_handler_index,
+                                     const unsigned int quad_index,
+                                     const unsigned int n_src_vectors,
+                                     const unsigned int n_dst_vectors) const
+{
+  const std::array<std::size_t, 3> bytes = compute_cell_loop_memory_transfer(
+    dof_handler_index, quad_index, n_src_vectors, n_dst_vectors);
+  return bytes[0] + bytes[1] + bytes[2];
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename StreamType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::print_cell_loop_performance(
+  StreamType &       out,
+  const double       time_per_loop,
+  const unsigned int dof_handler_index,
+  const unsigned int quad_index,
+  const unsigned int n_src_vectors,
+  const unsigned int n_dst_vectors,
+  const double       stream_bandwidth) const
+{
+  Assert(time_per_loop > 0, ExcMessage("The time must be positive."));
+
+  const std::array<std::size_t, 3> bytes = compute_cell_loop_memory_transfer(
+    dof_handler_index, quad_index, n_src_vectors, n_dst_vectors);
+  const double n_dofs =
+    Utilities::MPI::sum(static_cast<double>(
+                          dof_info[dof_handler_index]
+                            .vector_partitioner->local_size()),
+                        task_info.communicator);
+  const double total_bytes =
+    Utilities::MPI::sum(static_cast<double>(bytes[0] + bytes[1] + bytes[2]),
+                        task_info.communicator);
+  const double max_time =
+    Utilities::MPI::max(time_per_loop, task_info.communicator);
+
+  const char *names[3] = {"vectors", "indices", "geometry"};
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      out << "   Transfer " << std::left << std::setw(25)
+          << std::string(names[i]) + ":" << std::right;
+      task_info.print_memory_statistics(out, bytes[i]);
+    }
+  out << "   Bytes per DoF:                    " << total_bytes / n_dofs
+      << std::endl;
+  const double bandwidth = 1e-9 * total_bytes / max_time;
+  out << "   Achieved bandwidth:               " << bandwidth << " GB/s";
+  if (stream_bandwidth > 0)
+    out << " (" << 100. * bandwidth / stream_bandwidth
+        << "% of STREAM bandwidth)";
+  out << std::endl;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 void
 MatrixFree<dim, Number, VectorizedArrayType>::print(std::ostream &out) const
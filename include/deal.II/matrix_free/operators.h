@@ -426,6 +426,45 @@ namespace MatrixFreeOperators
     virtual void
     Tapply_add(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Apply the operator to @p src and add the result in @p dst, as needed
+     * by vmult_interface_down() and vmult_interface_up(). The result of these
+     * two functions only depends on the cells that contain degrees of freedom
+     * on the refinement edge, stored in interface_cell_ranges.
+     *
+     * The default implementation calls apply_add() and thus works on all
+     * cells. Derived classes should override this function and only work on
+     * the cells in interface_cell_ranges, e.g. by calling
+     * loop_over_interface_cells() with their cell operation.
+     */
+    virtual void
+    apply_add_interface(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Call @p cell_operation of @p owner on the cell batches listed in
+     * interface_cell_ranges. The ghost values of @p src are imported before
+     * and the ghost contributions to @p dst are sent to their owners after
+     * the cell operations, like MatrixFree::cell_loop() does.
+     */
+    template <typename OperatorType>
+    void
+    loop_over_interface_cells(
+      void (OperatorType::*cell_operation)(
+        const MatrixFree<dim, value_type, VectorizedArrayType> &,
+        VectorType &,
+        const VectorType &,
+        const std::pair<unsigned int, unsigned int> &) const,
+      const OperatorType *owner,
+      VectorType &        dst,
+      const VectorType &  src) const;
+
+    /**
+     * Ranges of cell batches that contain at least one degree of freedom on
+     * the refinement edge. Set up by the initialize() function for level
+     * operators.
+     */
+    std::vector<std::pair<unsigned int, unsigned int>> interface_cell_ranges;
+
     /**
      * MatrixFree object to be used with this operator.
      */
@@ -722,6 +761,134 @@ namespace MatrixFreeOperators
 
 
 
+  /**
+   * This class implements the action of the exact inverse of the mass matrix
+   * on an element for the case of deformed (curved) cells, where the
+   * Jacobian determinant varies within the cell and the mass matrix is not
+   * a tensor product any more. Contrary to CellwiseInverseMassMatrix, the
+   * FEEvaluation object may use more quadrature points than there are
+   * degrees of freedom in each direction, e.g. to integrate the mass matrix
+   * on curved cells more accurately.
+   *
+   * The inverse is computed by a preconditioned conjugate gradient method on
+   * each cell, run for all cells in a batch of VectorizedArray lanes at once
+   * with separate step lengths for each lane. The mass matrix is applied
+   * with the sum factorization kernels behind FEEvaluation::evaluate() and
+   * FEEvaluation::integrate() and the JxW values of the @p fe_eval object,
+   * so no additional data needs to be stored at quadrature points. As a
+   * preconditioner, the approximate inverse given by tensor products of the
+   * inverse 1D shape matrices with the pointwise inverse of the JxW values
+   * is used, see apply_preconditioner(). This approximation is exact on
+   * affine cells, so the solver terminates after the first residual
+   * evaluation on those cells, and typically needs few iterations on curved
+   * cells since its quality only depends on the variation of the Jacobian
+   * determinant within the cell. On cells that are known to be affine, the
+   * cheaper CellwiseInverseMassMatrix class should be preferred.
+   *
+   * All @p n_components components of the FEEvaluation object are inverted
+   * in one call.
+   *
+   * The FEEvaluation object passed to the constructor is used as a
+   * temporary storage during apply(), so user code must call
+   * FEEvaluation::reinit() on the correct cell before apply() and must not
+   * rely on the content of its arrays of values in the degrees of freedom
+   * and quadrature points afterwards.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d            = fe_degree + 1,
+            int n_components             = 1,
+            typename Number              = double,
+            typename VectorizedArrayType = VectorizedArray<Number>>
+  class CellwiseInverseMassMatrixCG
+  {
+    static_assert(
+      std::is_same<Number, typename VectorizedArrayType::value_type>::value,
+      "Type of Number and of VectorizedArrayType do not match.");
+
+  public:
+    /**
+     * The type of the evaluator used for the action of the mass matrix.
+     */
+    using FEEvaluationType = FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType>;
+
+    /**
+     * Constructor. Sets the evaluator used for the mass matrix and the
+     * preconditioner as well as the relative tolerance and the maximal
+     * number of iterations of the conjugate gradient method.
+     */
+    CellwiseInverseMassMatrixCG(FEEvaluationType & fe_eval,
+                                const double       relative_tolerance = 1e-12,
+                                const unsigned int max_iterations     = 100);
+
+    /**
+     * Applies the inverse mass matrix operation on an input array, using the
+     * JxW values provided by the `fe_eval` argument passed to the
+     * constructor. It is assumed that the pointers of the input and output
+     * arrays are valid over the length FEEvaluation::dofs_per_cell, which is
+     * the number of entries processed by this function. The `in_array` and
+     * `out_array` arguments may point to the same memory position, including
+     * FEEvaluation::begin_dof_values() of the evaluator.
+     *
+     * The return value is the number of iterations of the conjugate gradient
+     * method needed to reduce the residual of all lanes by the factor of the
+     * relative tolerance. An exception is thrown in debug mode if the method
+     * did not converge within the given maximal number of iterations.
+     */
+    unsigned int
+    apply(const VectorizedArrayType *in_array,
+          VectorizedArrayType *      out_array) const;
+
+    /**
+     * Applies the approximate inverse of the mass matrix used as
+     * preconditioner, given by tensor products of the inverse 1D shape
+     * functions of `fe_eval` and the inverse JxW values in the quadrature
+     * points. On affine cells, this is the exact inverse of the mass matrix.
+     * The `in_array` and `out_array` arguments may point to the same memory
+     * position.
+     */
+    void
+    apply_preconditioner(const VectorizedArrayType *in_array,
+                         VectorizedArrayType *      out_array) const;
+
+  private:
+    /**
+     * Apply the mass matrix on the given input array.
+     */
+    void
+    apply_mass_matrix(const VectorizedArrayType *in_array,
+                      VectorizedArrayType *      out_array) const;
+
+    /**
+     * A reference to the FEEvaluation object for the action of the mass
+     * matrix.
+     */
+    FEEvaluationType &fe_eval;
+
+    /**
+     * The relative tolerance of the conjugate gradient method.
+     */
+    const double relative_tolerance;
+
+    /**
+     * The maximal number of iterations of the conjugate gradient method.
+     */
+    const unsigned int max_iterations;
+
+    /**
+     * Temporary storage for the vectors of the conjugate gradient method and
+     * the tensor product evaluation in the preconditioner.
+     */
+    mutable AlignedVector<VectorizedArrayType> scratch_data;
+  };
+
+
+
   /**
    * This class implements the operation of the action of a mass matrix.
    *
@@ -772,6 +939,14 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Applies the mass matrix operation on the cells adjacent to the
+     * refinement edge.
+     */
+    virtual void
+    apply_add_interface(VectorType &      dst,
+                        const VectorType &src) const override;
+
     /**
      * For this operator, there is just a cell contribution.
      */
@@ -910,6 +1085,14 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Applies the Laplace operator on the cells adjacent to the refinement
+     * edge.
+     */
+    virtual void
+    apply_add_interface(VectorType &      dst,
+                        const VectorType &src) const override;
+
     /**
      * Applies the Laplace operator on a cell.
      */
@@ -1083,6 +1266,253 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  inline CellwiseInverseMassMatrixCG<dim,
+                                     fe_degree,
+                                     n_q_points_1d,
+                                     n_components,
+                                     Number,
+                                     VectorizedArrayType>::
+    CellwiseInverseMassMatrixCG(FEEvaluationType & fe_eval,
+                                const double       relative_tolerance,
+                                const unsigned int max_iterations)
+    : fe_eval(fe_eval)
+    , relative_tolerance(relative_tolerance)
+    , max_iterations(max_iterations)
+    , scratch_data(5 * FEEvaluationType::static_dofs_per_cell +
+                   2 * FEEvaluationType::static_n_q_points)
+  {}
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  CellwiseInverseMassMatrixCG<dim,
+                              fe_degree,
+                              n_q_points_1d,
+                              n_components,
+                              Number,
+                              VectorizedArrayType>::
+    apply_preconditioner(const VectorizedArrayType *in_array,
+                         VectorizedArrayType *      out_array) const
+  {
+    constexpr unsigned int dofs_per_component =
+      FEEvaluationType::static_dofs_per_component;
+    constexpr unsigned int n_q_points = FEEvaluationType::static_n_q_points;
+
+    const internal::MatrixFreeFunctions::UnivariateShapeData<
+      VectorizedArrayType> &shape_data =
+      fe_eval.get_shape_info().data.front();
+    Assert(fe_eval.get_shape_info().element_type <=
+               internal::MatrixFreeFunctions::tensor_symmetric &&
+             shape_data.inverse_shape_values_eo.size() > 0,
+           ExcNotImplemented());
+
+    internal::EvaluatorTensorProduct<internal::evaluate_evenodd,
+                                     dim,
+                                     fe_degree + 1,
+                                     n_q_points_1d,
+                                     VectorizedArrayType>
+      evaluator(AlignedVector<VectorizedArrayType>(),
+                AlignedVector<VectorizedArrayType>(),
+                shape_data.inverse_shape_values_eo);
+
+    // the number of quadrature points can be larger than the number of
+    // degrees of freedom, so we cannot work in place and alternate between
+    // two arrays behind the vectors of the conjugate gradient method
+    // instead
+    VectorizedArrayType *tmp0 =
+      scratch_data.begin() + 5 * FEEvaluationType::static_dofs_per_cell;
+    VectorizedArrayType *tmp1 = tmp0 + n_q_points;
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        const VectorizedArrayType *in  = in_array + c * dofs_per_component;
+        VectorizedArrayType *      out = out_array + c * dofs_per_component;
+
+        // Need to select 'apply' method with hessian slot because values
+        // assume symmetries that do not exist in the inverse shapes
+        evaluator.template hessians<0, true, false>(in, tmp0);
+        if (dim > 1)
+          evaluator.template hessians<1, true, false>(tmp0, tmp1);
+        if (dim > 2)
+          evaluator.template hessians<2, true, false>(tmp1, tmp0);
+
+        VectorizedArrayType *values_quad = dim == 2 ? tmp1 : tmp0;
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          values_quad[q] /= fe_eval.JxW(q);
+
+        if (dim == 3)
+          {
+            evaluator.template hessians<2, false, false>(tmp0, tmp1);
+            evaluator.template hessians<1, false, false>(tmp1, tmp0);
+          }
+        else if (dim == 2)
+          evaluator.template hessians<1, false, false>(tmp1, tmp0);
+        evaluator.template hessians<0, false, false>(tmp0, out);
+      }
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  CellwiseInverseMassMatrixCG<dim,
+                              fe_degree,
+                              n_q_points_1d,
+                              n_components,
+                              Number,
+                              VectorizedArrayType>::
+    apply_mass_matrix(const VectorizedArrayType *in_array,
+                      VectorizedArrayType *      out_array) const
+  {
+    constexpr unsigned int dofs_per_cell =
+      FEEvaluationType::static_dofs_per_cell;
+    constexpr unsigned int n_q_points = FEEvaluationType::static_n_q_points;
+
+    std::copy(in_array, in_array + dofs_per_cell, fe_eval.begin_dof_values());
+    fe_eval.evaluate(EvaluationFlags::values);
+    VectorizedArrayType *values_quad = fe_eval.begin_values();
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        const VectorizedArrayType JxW = fe_eval.JxW(q);
+        for (unsigned int c = 0; c < n_components; ++c)
+          values_quad[c * n_q_points + q] *= JxW;
+      }
+    fe_eval.integrate(EvaluationFlags::values);
+    std::copy(fe_eval.begin_dof_values(),
+              fe_eval.begin_dof_values() + dofs_per_cell,
+              out_array);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  inline unsigned int
+  CellwiseInverseMassMatrixCG<
+    dim,
+    fe_degree,
+    n_q_points_1d,
+    n_components,
+    Number,
+    VectorizedArrayType>::apply(const VectorizedArrayType *in_array,
+                                VectorizedArrayType *      out_array) const
+  {
+    constexpr unsigned int dofs_per_cell =
+      FEEvaluationType::static_dofs_per_cell;
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+    VectorizedArrayType *solution       = scratch_data.begin();
+    VectorizedArrayType *residual       = solution + dofs_per_cell;
+    VectorizedArrayType *preconditioned = residual + dofs_per_cell;
+    VectorizedArrayType *search         = preconditioned + dofs_per_cell;
+    VectorizedArrayType *product        = search + dofs_per_cell;
+
+    const auto dot = [](const VectorizedArrayType *a,
+                        const VectorizedArrayType *b) {
+      VectorizedArrayType sum = VectorizedArrayType();
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        sum += a[i] * b[i];
+      return sum;
+    };
+
+    // divide lane by lane, setting the result to zero in lanes where the
+    // denominator is zero, which happens for converged or unused lanes
+    const auto divide = [](const VectorizedArrayType &a,
+                           const VectorizedArrayType &b) {
+      VectorizedArrayType result;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        result[v] = b[v] == Number() ? Number() : a[v] / b[v];
+      return result;
+    };
+
+    // the right hand side is only read once, so the input and output arrays
+    // may alias each other and the arrays of fe_eval
+    std::copy(in_array, in_array + dofs_per_cell, residual);
+    const VectorizedArrayType rhs_norm_square = dot(residual, residual);
+
+    const auto is_converged = [&](const VectorizedArrayType &norm_square) {
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        if (norm_square[v] > relative_tolerance * relative_tolerance *
+                               rhs_norm_square[v])
+          return false;
+      return true;
+    };
+
+    // the preconditioner is exact on affine cells, so use it for the initial
+    // guess
+    apply_preconditioner(residual, solution);
+    apply_mass_matrix(solution, product);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      residual[i] -= product[i];
+
+    unsigned int iteration = 0;
+    if (is_converged(dot(residual, residual)))
+      {
+        std::copy(solution, solution + dofs_per_cell, out_array);
+        return iteration;
+      }
+
+    apply_preconditioner(residual, preconditioned);
+    std::copy(preconditioned, preconditioned + dofs_per_cell, search);
+    VectorizedArrayType residual_dot_preconditioned =
+      dot(residual, preconditioned);
+
+    for (; iteration < max_iterations;)
+      {
+        ++iteration;
+        apply_mass_matrix(search, product);
+        const VectorizedArrayType alpha =
+          divide(residual_dot_preconditioned, dot(search, product));
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            solution[i] += alpha * search[i];
+            residual[i] -= alpha * product[i];
+          }
+
+        if (is_converged(dot(residual, residual)))
+          break;
+
+        apply_preconditioner(residual, preconditioned);
+        const VectorizedArrayType new_residual_dot_preconditioned =
+          dot(residual, preconditioned);
+        const VectorizedArrayType beta =
+          divide(new_residual_dot_preconditioned,
+                 residual_dot_preconditioned);
+        residual_dot_preconditioned = new_residual_dot_preconditioned;
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          search[i] = preconditioned[i] + beta * search[i];
+      }
+    Assert(iteration < max_iterations || is_converged(dot(residual, residual)),
+           ExcMessage("The conjugate gradient method for the inverse mass "
+                      "matrix did not converge within " +
+                      std::to_string(max_iterations) + " iterations."));
+
+    std::copy(solution, solution + dofs_per_cell, out_array);
+    return iteration;
+  }
+
+
+
   //----------------- Base operator -----------------------------
   template <int dim, typename VectorType, typename VectorizedArrayType>
   Base<dim, VectorType, VectorizedArrayType>::Base()
@@ -1219,6 +1649,7 @@ namespace MatrixFreeOperators
     edge_constrained_values.clear();
     edge_constrained_values.resize(selected_rows.size());
     have_interface_matrices = false;
+    interface_cell_ranges.clear();
   }
 
 
@@ -1305,6 +1736,51 @@ namespace MatrixFreeOperators
             static_cast<unsigned int>(edge_constrained_indices[j].size()),
             data->get_vector_partitioner()->get_mpi_communicator()) > 0;
       }
+
+    // collect the cell batches that touch the refinement edge, merging
+    // consecutive batches into ranges
+    interface_cell_ranges.clear();
+    if (have_interface_matrices)
+      {
+        std::vector<types::global_dof_index> dof_indices;
+        for (unsigned int cell = 0; cell < data->n_macro_cells(); ++cell)
+          {
+            bool at_interface = false;
+            for (unsigned int j = 0;
+                 j < selected_rows.size() && at_interface == false;
+                 ++j)
+              {
+                const IndexSet &edge_indices =
+                  mg_constrained_dofs[j].get_refinement_edge_indices(level);
+                if (edge_indices.n_elements() == 0)
+                  continue;
+                for (unsigned int v = 0;
+                     v < data->n_active_entries_per_cell_batch(cell) &&
+                     at_interface == false;
+                     ++v)
+                  {
+                    const auto dof_cell =
+                      data->get_cell_iterator(cell, v, selected_rows[j]);
+                    dof_indices.resize(dof_cell->get_fe().n_dofs_per_cell());
+                    dof_cell->get_mg_dof_indices(dof_indices);
+                    for (const auto index : dof_indices)
+                      if (edge_indices.is_element(index))
+                        {
+                          at_interface = true;
+                          break;
+                        }
+                  }
+              }
+            if (at_interface)
+              {
+                if (!interface_cell_ranges.empty() &&
+                    interface_cell_ranges.back().second == cell)
+                  ++interface_cell_ranges.back().second;
+                else
+                  interface_cell_ranges.emplace_back(cell, cell + 1);
+              }
+          }
+      }
   }
 
 
@@ -1516,7 +1992,7 @@ namespace MatrixFreeOperators
             .local_element(edge_constrained_indices[j][i]) = 0.;
         }
 
-    apply_add(dst, src);
+    apply_add_interface(dst, src);
 
     for (unsigned int j = 0; j < BlockHelper::n_blocks(dst); ++j)
       {
@@ -1570,7 +2046,7 @@ namespace MatrixFreeOperators
           BlockHelper::subblock(src_cpy, j).local_element(c) = 0.;
       }
 
-    apply_add(dst, src_cpy);
+    apply_add_interface(dst, src_cpy);
 
     for (unsigned int j = 0; j < BlockHelper::n_blocks(dst); ++j)
       for (unsigned int i = 0; i < edge_constrained_indices[j].size(); ++i)
@@ -1641,6 +2117,44 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::apply_add_interface(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    apply_add(dst, src);
+  }
+
+
+
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  template <typename OperatorType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::loop_over_interface_cells(
+    void (OperatorType::*cell_operation)(
+      const MatrixFree<dim, value_type, VectorizedArrayType> &,
+      VectorType &,
+      const VectorType &,
+      const std::pair<unsigned int, unsigned int> &) const,
+    const OperatorType *owner,
+    VectorType &        dst,
+    const VectorType &  src) const
+  {
+    const bool src_has_ghosts = src.has_ghost_elements();
+    if (src_has_ghosts == false)
+      src.update_ghost_values();
+
+    for (const auto &range : interface_cell_ranges)
+      (owner->*cell_operation)(*data, dst, src, range);
+
+    dst.compress(VectorOperation::add);
+    if (src_has_ghosts == false)
+      src.zero_out_ghosts();
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::Tapply_add(
@@ -1833,6 +2347,30 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  MassOperator<dim,
+               fe_degree,
+               n_q_points_1d,
+               n_components,
+               VectorType,
+               VectorizedArrayType>::apply_add_interface(VectorType &      dst,
+                                                         const VectorType &src)
+    const
+  {
+    this->loop_over_interface_cells(&MassOperator::local_apply_cell,
+                                    this,
+                                    dst,
+                                    src);
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_q_points_1d,
@@ -2026,6 +2564,29 @@ namespace MatrixFreeOperators
       &LaplaceOperator::local_apply_cell, this, dst, src);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  LaplaceOperator<dim,
+                  fe_degree,
+                  n_q_points_1d,
+                  n_components,
+                  VectorType,
+                  VectorizedArrayType>::
+    apply_add_interface(VectorType &dst, const VectorType &src) const
+  {
+    this->loop_over_interface_cells(&LaplaceOperator::local_apply_cell,
+                                    this,
+                                    dst,
+                                    src);
+  }
+
   namespace Implementation
   {
     template <typename VectorizedArrayType>
@@ -247,6 +247,17 @@ namespace internal
        */
       AlignedVector<Number> hessians_within_subface[2];
 
+      /**
+       * Stores the one-dimensional interpolation matrices from the degrees
+       * of freedom of the element on the full interval to the nodes of the
+       * element on the two sub-intervals $(0, 0.5)$ and $(0.5, 1)$, i.e.,
+       * the one-dimensional factors of the hanging-node constraints. The
+       * length of each array is <tt>n_dofs_1d * n_dofs_1d</tt> with the
+       * degrees of freedom on the full interval running fastest. Only filled
+       * for elements with support points, i.e., FE_Q.
+       */
+      AlignedVector<Number> subface_interpolation_matrices[2];
+
       /**
        * We store a copy of the one-dimensional quadrature formula
        * used for initialization.
@@ -268,6 +279,17 @@ namespace internal
        * end points of the unit cell.
        */
       bool nodal_at_cell_boundaries;
+
+      /**
+       * Indicates whether the basis functions of a truncated tensor product
+       * (ElementType::truncated_tensor) are symmetric in the even slots and
+       * point-symmetric in the odd slots over the quadrature points, as is
+       * the case for the Legendre basis of FE_DGP with a symmetric
+       * quadrature formula. In that case, the evaluation halves the number
+       * of operations in the 1D kernels by the variant
+       * evaluate_symmetric_hierarchical.
+       */
+      bool symmetric_hierarchical;
     };
 
 
@@ -485,6 +507,16 @@ namespace internal
       bool
       check_1d_shapes_collocation(
         const UnivariateShapeData<Number> &univariate_shape_data) const;
+
+      /**
+       * Check whether the 1D basis functions have the symmetry of the
+       * Legendre basis with respect to the quadrature points, i.e., the
+       * shape functions with even index are symmetric and the ones with odd
+       * index are point-symmetric about the midpoint of the unit interval.
+       */
+      bool
+      check_1d_shapes_symmetric_hierarchical(
+        const UnivariateShapeData<Number> &univariate_shape_data) const;
     };
 
 
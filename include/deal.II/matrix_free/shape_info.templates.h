@@ -48,6 +48,7 @@ namespace internal
       , fe_degree(0)
       , n_q_points_1d(0)
       , nodal_at_cell_boundaries(false)
+      , symmetric_hierarchical(false)
     {}
 
 
@@ -297,6 +298,31 @@ namespace internal
             fe->shape_grad_grad(my_i, q_point)[0][0];
         }
 
+      // interpolation from the nodes on the full interval to the nodes on the
+      // two halves of the interval, which is the 1D building block of the
+      // constraints at hanging nodes
+      if (fe->has_support_points() &&
+          fe->dofs_per_cell == Utilities::fixed_power<dim>(n_dofs_1d))
+        for (unsigned int c = 0; c < 2; ++c)
+          {
+            auto &matrix =
+              univariate_shape_data.subface_interpolation_matrices[c];
+            matrix.resize_fast(n_dofs_1d * n_dofs_1d);
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                {
+                  Point<dim> q_point = unit_point;
+                  q_point[0] =
+                    0.5 *
+                    (c +
+                     fe->get_unit_support_points()[scalar_lexicographic[i]][0]);
+                  const double value =
+                    fe->shape_value(scalar_lexicographic[j], q_point);
+                  matrix[i * n_dofs_1d + j] =
+                    std::abs(value) < 1e-15 ? 0. : value;
+                }
+          }
+
       // get gradient and Hessian transformation matrix for the polynomial
       // space associated with the quadrature rule (collocation space). We
       // need to avoid the case with more than a few hundreds of quadrature
@@ -440,6 +466,9 @@ namespace internal
         }
       else if (element_type == tensor_symmetric_plus_dg0)
         check_1d_shapes_symmetric(univariate_shape_data);
+      else if (element_type == truncated_tensor)
+        univariate_shape_data.symmetric_hierarchical =
+          check_1d_shapes_symmetric_hierarchical(univariate_shape_data);
 
       nodal_at_cell_boundaries = true;
       for (unsigned int i = 1; i < n_dofs_1d; ++i)
@@ -698,6 +727,52 @@ namespace internal
 
 
 
+    template <typename Number>
+    bool
+    ShapeInfo<Number>::check_1d_shapes_symmetric_hierarchical(
+      const UnivariateShapeData<Number> &univariate_shape_data) const
+    {
+      if (dofs_per_component_on_cell == 0)
+        return false;
+
+      const unsigned int n_q_points_1d = univariate_shape_data.n_q_points_1d;
+      const unsigned int n_dofs_1d     = univariate_shape_data.fe_degree + 1;
+
+      const double zero_tol =
+        std::is_same<Number, double>::value == true ? 1e-12 : 1e-7;
+
+      // the shape values of index i must satisfy phi_i(1-x) = (-1)^i
+      // phi_i(x), the gradients get an additional factor -1 and the Hessians
+      // have the same symmetry as the values. Scale the tolerance for the
+      // derivatives as in check_1d_shapes_symmetric().
+      const std::array<const AlignedVector<Number> *, 3> shapes = {
+        {&univariate_shape_data.shape_values,
+         &univariate_shape_data.shape_gradients,
+         &univariate_shape_data.shape_hessians}};
+      const std::array<double, 3> tolerances = {
+        {zero_tol,
+         zero_tol * std::sqrt(n_dofs_1d) * n_dofs_1d,
+         zero_tol * n_dofs_1d * n_dofs_1d * n_dofs_1d}};
+      for (unsigned int d = 0; d < 3; ++d)
+        for (unsigned int i = 0; i < n_dofs_1d; ++i)
+          {
+            const double sign = ((i + d) % 2 == 0) ? 1. : -1.;
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              {
+                const double value = get_first_array_element(
+                  (*shapes[d])[i * n_q_points_1d + q]);
+                const double mirrored = get_first_array_element(
+                  (*shapes[d])[i * n_q_points_1d + n_q_points_1d - 1 - q]);
+                if (std::abs(value - sign * mirrored) >
+                    std::max(tolerances[d], zero_tol * std::abs(value)))
+                  return false;
+              }
+          }
+      return true;
+    }
+
+
+
     template <typename Number>
     std::size_t
     ShapeInfo<Number>::memory_consumption() const
@@ -735,6 +810,8 @@ namespace internal
             MemoryConsumption::memory_consumption(values_within_subface[i]);
           memory +=
             MemoryConsumption::memory_consumption(gradients_within_subface[i]);
+          memory += MemoryConsumption::memory_consumption(
+            subface_interpolation_matrices[i]);
         }
       return memory;
     }
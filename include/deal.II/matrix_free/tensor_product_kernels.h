@@ -20,6 +20,9 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/tensor.h>
 #include <deal.II/base/utilities.h>
 
 
@@ -2257,6 +2260,249 @@ namespace internal
       }
   }
 
+
+
+  /**
+   * Helper type to deduce the result type of multiplying the coefficients of
+   * an interpolation of type @p Number by the shape function values of type
+   * @p Number2 at a point. Besides the usual ProductType, this struct maps a
+   * Point argument to a Tensor of rank one, because sums of points are not a
+   * meaningful operation.
+   */
+  template <typename Number, typename Number2>
+  struct ProductTypeNoPoint
+  {
+    using type = typename ProductType<Number, Number2>::type;
+  };
+
+  template <int dim, typename Number, typename Number2>
+  struct ProductTypeNoPoint<Point<dim, Number>, Number2>
+  {
+    using type = Tensor<1, dim, typename ProductType<Number, Number2>::type>;
+  };
+
+
+
+  /**
+   * Evaluate the values and first derivatives of the one-dimensional
+   * polynomials @p poly in all coordinate directions of the point @p p and
+   * store them in the array @p shapes. The entry for polynomial @p i in
+   * direction @p d is placed at <code>shapes[(d * poly.size() + i) *
+   * 2]</code> and its derivative in the next slot.
+   */
+  template <int dim, typename Number2>
+  inline void
+  evaluate_tensor_product_shapes_1d(
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    const Point<dim, Number2> &                         p,
+    Number2 *                                           shapes)
+  {
+    const unsigned int n_shapes = poly.size();
+    for (unsigned int d = 0; d < dim; ++d)
+      for (unsigned int i = 0; i < n_shapes; ++i)
+        poly[i].value(p[d], 1, shapes + (d * n_shapes + i) * 2);
+  }
+
+
+
+  /**
+   * Interpolate the polynomial of a tensor product space spanned by the
+   * one-dimensional polynomials @p poly with coefficients @p values to the
+   * point @p p given in reference coordinates, and return the value and the
+   * gradient with respect to the reference coordinates. This is the point
+   * evaluation counterpart of the sum factorization kernels above: rather
+   * than evaluating the $(k+1)^d$ shape functions one by one, the
+   * one-dimensional polynomials are evaluated once per direction and then
+   * combined dimension by dimension, reducing the cost from
+   * $\mathcal O(k^{2d})$ to $\mathcal O(k^d)$ operations.
+   *
+   * The coefficients are expected in lexicographic order, unless a
+   * renumbering @p renumber is given, in which case the coefficient of the
+   * lexicographic index @p i is assumed to be located at position
+   * <code>renumber[i]</code> of @p values.
+   *
+   * The type @p Number of the coefficients can be a scalar or a tensor like
+   * Point (e.g. for the evaluation of the geometry described by the support
+   * points of a mapping), whereas @p Number2 is the type of the coordinates
+   * of the point, e.g. VectorizedArray to evaluate several points at once.
+   */
+  template <int dim, typename Number, typename Number2>
+  inline std::pair<
+    typename ProductTypeNoPoint<Number, Number2>::type,
+    Tensor<1, dim, typename ProductTypeNoPoint<Number, Number2>::type>>
+  evaluate_tensor_product_value_and_gradient(
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    const std::vector<Number> &                         values,
+    const Point<dim, Number2> &                         p,
+    const std::vector<unsigned int> &                   renumber = {})
+  {
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    using Number3 = typename ProductTypeNoPoint<Number, Number2>::type;
+
+    // use `int` type for the loop variables to inform the compiler that the
+    // loops below will never overflow, which allows it to generate better
+    // code for the variable loop bounds
+    const int n_shapes = poly.size();
+    AssertDimension(Utilities::fixed_power<dim>(poly.size()), values.size());
+    Assert(renumber.empty() || renumber.size() == values.size(),
+           ExcDimensionMismatch(renumber.size(), values.size()));
+
+    // evaluate the 1D polynomials and their derivatives, using a buffer on
+    // the stack for the common case of moderate polynomial degrees
+    constexpr int max_n_shapes = 20;
+
+    std::array<Number2, 2 * dim * max_n_shapes> shapes_stack;
+    std::vector<Number2>                        shapes_heap;
+    Number2 *                                   shapes = shapes_stack.data();
+    if (n_shapes > max_n_shapes)
+      {
+        shapes_heap.resize(2 * dim * n_shapes);
+        shapes = shapes_heap.data();
+      }
+    evaluate_tensor_product_shapes_1d(poly, p, shapes);
+    const Number2 *shapes_x = shapes;
+    const Number2 *shapes_y = shapes + 2 * n_shapes;
+    const Number2 *shapes_z = shapes + 4 * n_shapes;
+
+    // go through the tensor product of shape functions and interpolate with
+    // the optimal algorithm
+    std::pair<Number3, Tensor<1, dim, Number3>> result = {};
+    for (int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
+      {
+        Number3 value_y = {}, deriv_x = {}, deriv_y = {};
+        for (int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
+          {
+            // interpolation and derivative in x direction
+            Number3 value = {}, deriv = {};
+
+            // distinguish the inner loop based on whether we have a
+            // renumbering or not
+            if (renumber.empty())
+              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                {
+                  value += values[i] * shapes_x[2 * i0];
+                  deriv += values[i] * shapes_x[2 * i0 + 1];
+                }
+            else
+              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                {
+                  value += values[renumber[i]] * shapes_x[2 * i0];
+                  deriv += values[renumber[i]] * shapes_x[2 * i0 + 1];
+                }
+
+            // interpolation and derivative in y direction
+            if (dim > 1)
+              {
+                value_y += value * shapes_y[2 * i1];
+                deriv_x += deriv * shapes_y[2 * i1];
+                deriv_y += value * shapes_y[2 * i1 + 1];
+              }
+            else
+              {
+                result.first     = value;
+                result.second[0] = deriv;
+              }
+          }
+        if (dim == 3)
+          {
+            // interpolation and derivative in z direction
+            result.first += value_y * shapes_z[2 * i2];
+            result.second[0] += deriv_x * shapes_z[2 * i2];
+            result.second[1] += deriv_y * shapes_z[2 * i2];
+            result.second[dim - 1] += value_y * shapes_z[2 * i2 + 1];
+          }
+        else if (dim == 2)
+          {
+            result.first     = value_y;
+            result.second[0] = deriv_x;
+            result.second[1] = deriv_y;
+          }
+      }
+
+    return result;
+  }
+
+
+
+  /**
+   * Test the value @p value and the reference-cell gradient @p gradient at
+   * the point @p p by the shape functions of the tensor product space
+   * spanned by the one-dimensional polynomials @p poly, and add the result
+   * into @p values. This is the transpose of
+   * evaluate_tensor_product_value_and_gradient(), i.e., it computes
+   * $v_i \mathrel{+}= \varphi_i(p)\, \text{value} + \hat\nabla
+   * \varphi_i(p) \cdot \text{gradient}$ for all shape functions $i$ with
+   * sum factorization. The same ordering conventions as for the
+   * evaluation function apply.
+   */
+  template <int dim, typename Number, typename Number2>
+  inline void
+  integrate_add_tensor_product_value_and_gradient(
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    const Number &                                      value,
+    const Tensor<1, dim, Number> &                      gradient,
+    const Point<dim, Number2> &                         p,
+    Number *                                            values,
+    const std::vector<unsigned int> &                   renumber = {})
+  {
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    const int n_shapes = poly.size();
+    Assert(renumber.empty() ||
+             renumber.size() == Utilities::fixed_power<dim>(poly.size()),
+           ExcDimensionMismatch(renumber.size(),
+                                Utilities::fixed_power<dim>(poly.size())));
+
+    constexpr int max_n_shapes = 20;
+
+    std::array<Number2, 2 * dim * max_n_shapes> shapes_stack;
+    std::vector<Number2>                        shapes_heap;
+    Number2 *                                   shapes = shapes_stack.data();
+    if (n_shapes > max_n_shapes)
+      {
+        shapes_heap.resize(2 * dim * n_shapes);
+        shapes = shapes_heap.data();
+      }
+    evaluate_tensor_product_shapes_1d(poly, p, shapes);
+    const Number2 *shapes_x = shapes;
+    const Number2 *shapes_y = shapes + 2 * n_shapes;
+    const Number2 *shapes_z = shapes + 4 * n_shapes;
+
+    // apply the transposed operations of the evaluation in reverse order,
+    // starting with the z direction
+    for (int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
+      {
+        Number test_value_z = value, test_grad_x = gradient[0],
+               test_grad_y = gradient[dim > 1 ? 1 : 0];
+        if (dim == 3)
+          {
+            test_value_z = value * shapes_z[2 * i2] +
+                           gradient[dim - 1] * shapes_z[2 * i2 + 1];
+            test_grad_x = gradient[0] * shapes_z[2 * i2];
+            test_grad_y = gradient[dim > 1 ? 1 : 0] * shapes_z[2 * i2];
+          }
+        for (int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
+          {
+            Number test_value_y = test_value_z, test_grad_xy = test_grad_x;
+            if (dim > 1)
+              {
+                test_value_y = test_value_z * shapes_y[2 * i1] +
+                               test_grad_y * shapes_y[2 * i1 + 1];
+                test_grad_xy = test_grad_x * shapes_y[2 * i1];
+              }
+            if (renumber.empty())
+              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                values[i] += test_value_y * shapes_x[2 * i0] +
+                             test_grad_xy * shapes_x[2 * i0 + 1];
+            else
+              for (int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                values[renumber[i]] += test_value_y * shapes_x[2 * i0] +
+                                       test_grad_xy * shapes_x[2 * i0 + 1];
+          }
+      }
+  }
+
 } // end of namespace internal
 
 
@@ -18,6 +18,26 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/vector_access_internal.h>
+
+#include <deal.II/numerics/error_estimator.h>
+#include <deal.II/numerics/vector_tools_common.h>
+
+#include <functional>
+#include <map>
+#include <vector>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -27,7 +47,1266 @@ DEAL_II_NAMESPACE_OPEN
  * evaluation.
  */
 namespace MatrixFreeTools
-{} // namespace MatrixFreeTools
+{
+  /**
+   * Compute the diagonal of a linear operator (@p diagonal_global), given
+   * @p matrix_free and the local cell integral operation @p local_vmult. The
+   * vector is initialized to the right size in the function.
+   *
+   * The function probes the cell operator column by column: for each cell
+   * batch and each local degree of freedom, the dof values of an
+   * FEEvaluation object are set to the respective unit vector and
+   * @p local_vmult is called. The latter should perform the evaluation at
+   * the quadrature points, the quadrature loop, and the integration, i.e.,
+   * everything of the cell operation except for
+   * FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global(). The cost per cell is thus
+   * that of `dofs_per_cell` applications of the sum-factorized cell
+   * operation, done for all lanes of the cell batch at once. The loop over
+   * the cells is run with MatrixFree::cell_loop() and is thus parallelized
+   * with threads if requested in MatrixFree::AdditionalData.
+   *
+   * The constraints stored in @p matrix_free, including hanging-node
+   * constraints resolved inside FEEvaluation (see
+   * MatrixFree::AdditionalData::use_fast_hanging_node_algorithm), are taken
+   * into account in the same way as within
+   * FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global(): The result is the diagonal
+   * of the operator $C^T A C$, with $A$ the unconstrained operator and $C$
+   * the matrix expressing the local degrees of freedom on the cells in
+   * terms of the unconstrained global ones. As a consequence, the entries
+   * of constrained degrees of freedom are zero; it is up to the user to set
+   * them to a suitable value, e.g. one, before building a Jacobi or
+   * Chebyshev preconditioner.
+   *
+   * @note The FEEvaluation object must be vector-valued with the same
+   * number of components as the underlying finite element (starting at
+   * @p first_selected_component), or scalar.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    VectorType &                                        diagonal_global,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Compute the cell matrices of a linear operator given @p matrix_free and
+   * the local cell integral operation @p local_vmult, which is defined in
+   * the same way as for compute_diagonal(). The matrices are placed in
+   * @p cell_matrices, at the index `cell_batch * VectorizedArrayType::size()
+   * + lane` for the cells of the respective cell batch, where the entries
+   * belonging to unfilled lanes of the last cell batches are empty. The
+   * rows and columns of the matrices are in the numbering of the local
+   * degrees of freedom of FEEvaluation, i.e., the one of
+   * FEEvaluation::begin_dof_values(). The constraints are not applied to
+   * the cell matrices.
+   *
+   * These matrices are the blocks of a block-Jacobi preconditioner for
+   * discontinuous elements, where the degrees of freedom of different cells
+   * are not coupled through the cell integrals. As for compute_diagonal(),
+   * the computation is based on column-wise probing of the sum-factorized
+   * cell operation and is run in parallel with MatrixFree::cell_loop().
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  compute_block_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    std::vector<FullMatrix<Number>> &                   cell_matrices,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Assemble the matrix of a linear operator into @p matrix, given
+   * @p matrix_free and the local cell integral operation @p local_vmult,
+   * which is defined in the same way as for compute_diagonal(). The cell
+   * matrices are computed by column-wise probing of the sum-factorized cell
+   * operation with all lanes of a cell batch at once, and are then added
+   * into the global matrix with AffineConstraints::distribute_local_to_global()
+   * using @p constraints. This makes it possible to set up a matrix for an
+   * algebraic multigrid method on the coarse level of a matrix-free
+   * multigrid solver without re-implementing the weak form with FEValues.
+   *
+   * The matrix must be initialized with a sparsity pattern that contains
+   * the couplings of the degrees of freedom of the cells and the
+   * constraints, e.g. by DoFTools::make_sparsity_pattern() with the same
+   * AffineConstraints object. The matrix type can be any type that can be
+   * used with AffineConstraints::distribute_local_to_global(), e.g.,
+   * SparseMatrix, TrilinosWrappers::SparseMatrix, or
+   * PETScWrappers::MPI::SparseMatrix. If @p matrix_free was set up for a
+   * multigrid level, the level degrees of freedom are used.
+   *
+   * The cell matrices are computed in parallel inside MatrixFree::cell_loop()
+   * if requested in MatrixFree::AdditionalData, whereas the additions to the
+   * global matrix are serialized, since not all matrix types support
+   * concurrent writes. The function calls `matrix.compress()` at the end.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number> &                   constraints,
+    MatrixType &                                        matrix,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Compute the error indicator of KellyErrorEstimator::estimate() for the
+   * finite element function @p solution with the face integrals of
+   * @p matrix_free, and store it in @p estimated_error_per_cell, which is
+   * resized to the number of active cells of the triangulation. The jumps of
+   * the normal derivative are computed with FEFaceEvaluation, i.e., with sum
+   * factorization for all faces of a face batch at once, and the face loop
+   * is run with MatrixFree::loop() and thus in parallel if requested in
+   * MatrixFree::AdditionalData. Faces with hanging nodes are integrated over
+   * the subfaces as in KellyErrorEstimator, and all components of the
+   * FEFaceEvaluation object contribute to the indicator.
+   *
+   * On boundary faces whose boundary id is a key of @p neumann_bc, the
+   * difference between the normal derivative and the respective function is
+   * integrated instead of the jump, and all other boundary faces do not
+   * contribute. The functions need to have @p n_components components.
+   *
+   * The face integrals are multiplied by the factor of the given
+   * @p strategy, where only KellyErrorEstimator::cell_diameter_over_24 and
+   * KellyErrorEstimator::cell_diameter are supported. There is no
+   * coefficient and no selection of cells by subdomain or material id.
+   *
+   * @p matrix_free needs to be set up with update_gradients,
+   * update_JxW_values and update_normal_vectors in the mapping update
+   * flags of inner and boundary faces, and additionally with
+   * update_quadrature_points on boundary faces if @p neumann_bc is not
+   * empty. Entries of cells that are not locally owned are set to zero. In
+   * parallel computations,
+   * MatrixFree::AdditionalData::hold_all_faces_to_owned_cells must be set
+   * in order to also get the contributions of the faces at subdomain
+   * boundaries that MatrixFree would otherwise assign to the neighboring
+   * process only, and @p solution must be a
+   * LinearAlgebra::distributed::Vector set up with
+   * MatrixFree::initialize_dof_vector(), whose ghost values are updated
+   * inside the loop.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  estimate_error_kelly(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  solution,
+    Vector<float> &estimated_error_per_cell,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &neumann_bc = {},
+    const typename KellyErrorEstimator<dim>::Strategy strategy =
+      KellyErrorEstimator<dim>::cell_diameter_over_24,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Compute the cellwise error of the finite element function @p solution
+   * with respect to @p exact_solution in the given @p norm with the cell
+   * integrals of @p matrix_free, and store it in @p difference, which is
+   * resized to the number of active cells of the triangulation. This is the
+   * counterpart of VectorTools::integrate_difference(), and the global error
+   * can be obtained from @p difference with
+   * VectorTools::compute_global_error(). The finite element function is
+   * evaluated with FEEvaluation, i.e., with sum factorization for all cells
+   * of a cell batch at once, and the loop over the cells is run with
+   * MatrixFree::cell_loop() and thus in parallel if requested in
+   * MatrixFree::AdditionalData. The function is evaluated with one call to
+   * Function::value_list() or Function::gradient_list() per cell batch and
+   * component, for the quadrature points of all cells of the batch.
+   *
+   * The supported norms are VectorTools::L2_norm, VectorTools::H1_seminorm,
+   * VectorTools::H1_norm, and VectorTools::Linfty_norm, where the latter is
+   * the maximum over the quadrature points of @p quad_no. All components of
+   * the FEEvaluation object contribute to the norm, and @p exact_solution
+   * needs to have @p n_components components. @p matrix_free needs to be set
+   * up with update_quadrature_points and update_JxW_values in the mapping
+   * update flags of cells, and with update_gradients for the H1 norms.
+   * Entries of cells that are not locally owned are set to zero. In
+   * parallel, @p solution must be a LinearAlgebra::distributed::Vector set
+   * up with MatrixFree::initialize_dof_vector(), whose ghost values are
+   * updated inside the loop.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  solution,
+    const Function<dim, Number> &                       exact_solution,
+    Vector<float> &                                     difference,
+    const VectorTools::NormType &                       norm,
+    const unsigned int                                  dof_no  = 0,
+    const unsigned int                                  quad_no = 0,
+    const unsigned int first_selected_component                 = 0);
+
+  /**
+   * Interpolate @p function into the finite element space of @p matrix_free,
+   * the counterpart of VectorTools::interpolate(). The function is evaluated
+   * at the quadrature points of @p quad_no, which need to coincide with the
+   * support points of the finite element, e.g. those of
+   * QGaussLobatto<1>(fe_degree + 1) for FE_Q. This is the case if
+   * ShapeInfo::element_type is
+   * internal::MatrixFreeFunctions::tensor_symmetric_collocation. As in
+   * integrate_difference(), the function is evaluated with one call to
+   * Function::value_list() per cell batch and component, and the loop is run
+   * with MatrixFree::cell_loop().
+   *
+   * @p function needs to have @p n_components components, which are
+   * interpolated into the components of the finite element starting at
+   * @p first_selected_component. @p matrix_free needs to be set up with
+   * update_quadrature_points in the mapping update flags of cells, and
+   * @p vec needs to be initialized with MatrixFree::initialize_dof_vector().
+   * The values are written with FEEvaluation::set_dof_values(), which skips
+   * constrained degrees of freedom, so AffineConstraints::distribute() needs
+   * to be called afterwards if there are constraints, e.g. from hanging
+   * nodes. The ghost entries of a LinearAlgebra::distributed::Vector are
+   * reset at the end, since all locally owned entries are set on locally
+   * owned cells.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  interpolate(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+              const Function<dim, Number> &                       function,
+              VectorType &                                        vec,
+              const unsigned int                                  dof_no  = 0,
+              const unsigned int                                  quad_no = 0,
+              const unsigned int first_selected_component                 = 0);
+
+
+
+  // ---------------------------- implementations ---------------------------
+
+#ifndef DOXYGEN
+
+  namespace internal
+  {
+    /**
+     * Compute the cell matrices of the cell batch @p phi is currently
+     * initialized to by applying @p local_vmult to the local unit vectors,
+     * and store them in the first @p n_filled entries of @p cell_matrices.
+     */
+    template <typename FEEvalType, typename Number>
+    void
+    compute_cell_matrices(FEEvalType &                             phi,
+                          const std::function<void(FEEvalType &)> &local_vmult,
+                          const unsigned int                       n_filled,
+                          FullMatrix<Number> *cell_matrices)
+    {
+      for (unsigned int v = 0; v < n_filled; ++v)
+        cell_matrices[v].reinit(phi.dofs_per_cell, phi.dofs_per_cell);
+      for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+        {
+          for (unsigned int j = 0; j < phi.dofs_per_cell; ++j)
+            phi.begin_dof_values()[j] = Number();
+          phi.begin_dof_values()[i] = Number(1.);
+
+          local_vmult(phi);
+
+          for (unsigned int v = 0; v < n_filled; ++v)
+            for (unsigned int j = 0; j < phi.dofs_per_cell; ++j)
+              cell_matrices[v](j, i) = phi.begin_dof_values()[j][v];
+        }
+    }
+
+
+
+    /**
+     * A helper class for compute_diagonal() that collects the weights
+     * between the local degrees of freedom of the cells in a cell batch and
+     * the global degrees of freedom they depend on, and accumulates the
+     * diagonal entries of the constrained operator.
+     */
+    template <int dim,
+              int n_components,
+              typename Number,
+              typename VectorizedArrayType>
+    class ComputeDiagonalHelper
+    {
+    public:
+      static constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+      ComputeDiagonalHelper(
+        const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+        const dealii::internal::MatrixFreeFunctions::ShapeInfo<
+          VectorizedArrayType> &shape_info,
+        const unsigned int      dof_no,
+        const unsigned int      first_selected_component)
+        : matrix_free(matrix_free)
+        , dof_info(matrix_free.get_dof_info(dof_no))
+        , shape_info(shape_info)
+        , first_selected_component(first_selected_component)
+        , dofs_per_component(shape_info.dofs_per_component_on_cell)
+        , n_lanes_filled(0)
+      {
+        const unsigned int n_fe_components = dof_info.start_components.back();
+        Assert(n_components == 1 || n_fe_components > 1,
+               ExcMessage("The diagonal can only be computed for a single "
+                          "vector, which requires a vector-valued finite "
+                          "element for a vector-valued FEEvaluation object."));
+        (void)n_fe_components;
+      }
+
+      /**
+       * Set up the weights for the given cell batch.
+       */
+      void
+      reinit(const unsigned int cell)
+      {
+        n_lanes_filled = matrix_free.n_active_entries_per_cell_batch(cell);
+        const unsigned int n_fe_components = dof_info.start_components.back();
+        const unsigned int dofs_per_cell   = n_components * dofs_per_component;
+
+        for (unsigned int v = 0; v < n_lanes_filled; ++v)
+          {
+            // first collect the weights of the indices stored in DoFInfo,
+            // resolving the constraints from the pool
+            std::vector<std::map<unsigned int, Number>> weights(dofs_per_cell);
+            const unsigned int                          cell_index =
+              cell * n_lanes + v;
+            const unsigned int cell_dof_index =
+              cell_index * n_fe_components + first_selected_component;
+            const unsigned int *dof_indices =
+              dof_info.dof_indices.data() +
+              dof_info.row_starts[cell_dof_index].first;
+            for (unsigned int comp = 0; comp < n_components; ++comp)
+              {
+                unsigned int ind_local = comp * dofs_per_component;
+                for (unsigned int index_indicators =
+                       dof_info.row_starts[cell_dof_index + comp].second;
+                     index_indicators !=
+                     dof_info.row_starts[cell_dof_index + comp + 1].second;
+                     ++index_indicators)
+                  {
+                    const std::pair<unsigned short, unsigned short> indicator =
+                      dof_info.constraint_indicator[index_indicators];
+                    for (unsigned int j = 0; j < indicator.first;
+                         ++j, ++ind_local, ++dof_indices)
+                      weights[ind_local][*dof_indices] += Number(1.);
+
+                    const Number *data_val =
+                      matrix_free.constraint_pool_begin(indicator.second);
+                    const Number *end_pool =
+                      matrix_free.constraint_pool_end(indicator.second);
+                    for (; data_val != end_pool; ++data_val, ++dof_indices)
+                      weights[ind_local][*dof_indices] += *data_val;
+                    ++ind_local;
+                  }
+                for (; ind_local < (comp + 1) * dofs_per_component;
+                     ++ind_local, ++dof_indices)
+                  weights[ind_local][*dof_indices] += Number(1.);
+              }
+
+            // for cells with hanging nodes resolved within FEEvaluation, the
+            // weights above refer to the values before the interpolation
+            // from the coarser neighbor
+            if (dof_info.hanging_node_constraint_masks.size() > 0 &&
+                dof_info.hanging_node_constraint_masks[cell_index] != 0)
+              {
+                const std::vector<Number> &matrix = get_interpolation_matrix(
+                  dof_info.hanging_node_constraint_masks[cell_index]);
+                std::vector<std::map<unsigned int, Number>> interpolated(
+                  dofs_per_cell);
+                for (unsigned int comp = 0; comp < n_components; ++comp)
+                  for (unsigned int i = 0; i < dofs_per_component; ++i)
+                    for (unsigned int j = 0; j < dofs_per_component; ++j)
+                      {
+                        const Number entry =
+                          matrix[i * dofs_per_component + j];
+                        if (entry != Number())
+                          for (const auto &w :
+                               weights[comp * dofs_per_component + j])
+                            interpolated[comp * dofs_per_component + i]
+                                        [w.first] += entry * w.second;
+                      }
+                weights.swap(interpolated);
+              }
+
+            // convert the weights into the two lists from local to global
+            // and from global to local indices
+            global_indices[v].clear();
+            global_to_local[v].clear();
+            local_to_global[v].clear();
+            local_to_global[v].resize(dofs_per_cell);
+            std::map<unsigned int, unsigned int> global_positions;
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              for (const auto &w : weights[i])
+                {
+                  if (w.second == Number())
+                    continue;
+                  const auto inserted =
+                    global_positions.emplace(w.first, global_indices[v].size());
+                  if (inserted.second)
+                    {
+                      global_indices[v].push_back(w.first);
+                      global_to_local[v].emplace_back();
+                    }
+                  const unsigned int position = inserted.first->second;
+                  local_to_global[v][i].emplace_back(position, w.second);
+                  global_to_local[v][position].emplace_back(i, w.second);
+                }
+            diagonal[v].clear();
+            diagonal[v].resize(global_indices[v].size(), Number());
+          }
+      }
+
+      /**
+       * Return whether the local degree of freedom @p i is connected to any
+       * global degree of freedom in any of the lanes.
+       */
+      bool
+      is_active(const unsigned int i) const
+      {
+        for (unsigned int v = 0; v < n_lanes_filled; ++v)
+          if (!local_to_global[v][i].empty())
+            return true;
+        return false;
+      }
+
+      /**
+       * Add the contribution of the result of the cell operation applied to
+       * the @p i-th local unit vector, given in @p column, to the diagonal.
+       */
+      void
+      submit(const unsigned int i, const VectorizedArrayType *column)
+      {
+        for (unsigned int v = 0; v < n_lanes_filled; ++v)
+          for (const auto &entry : local_to_global[v][i])
+            {
+              Number sum = Number();
+              for (const auto &w : global_to_local[v][entry.first])
+                sum += w.second * column[w.first][v];
+              diagonal[v][entry.first] += entry.second * sum;
+            }
+      }
+
+      /**
+       * Add the diagonal entries of the current cell batch to the global
+       * vector.
+       */
+      template <typename VectorType>
+      void
+      distribute_local_to_global(VectorType &diagonal_global) const
+      {
+        for (unsigned int v = 0; v < n_lanes_filled; ++v)
+          for (unsigned int i = 0; i < global_indices[v].size(); ++i)
+            dealii::internal::vector_access_add(diagonal_global,
+                                                global_indices[v][i],
+                                                diagonal[v][i]);
+      }
+
+    private:
+      /**
+       * Return the interpolation matrix of a single component for the
+       * hanging-node configuration @p mask, computing it on first use.
+       */
+      const std::vector<Number> &
+      get_interpolation_matrix(const unsigned short mask)
+      {
+        std::vector<Number> &matrix = interpolation_matrices[mask];
+        if (matrix.empty())
+          {
+            matrix.resize(dofs_per_component * dofs_per_component);
+            AlignedVector<VectorizedArrayType> values(dofs_per_component);
+            for (unsigned int j = 0; j < dofs_per_component; ++j)
+              {
+                values.fill(VectorizedArrayType());
+                values[j] = 1.;
+                dealii::internal::MatrixFreeFunctions::
+                  interpolate_hanging_nodes<dim>(
+                    shape_info.data.front(),
+                    mask,
+                    false,
+                    std::bitset<n_lanes>().flip(),
+                    values.begin());
+                for (unsigned int i = 0; i < dofs_per_component; ++i)
+                  matrix[i * dofs_per_component + j] = values[i][0];
+              }
+          }
+        return matrix;
+      }
+
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free;
+      const dealii::internal::MatrixFreeFunctions::DoFInfo &dof_info;
+      const dealii::internal::MatrixFreeFunctions::ShapeInfo<
+        VectorizedArrayType> &shape_info;
+      const unsigned int      first_selected_component;
+      const unsigned int      dofs_per_component;
+      unsigned int            n_lanes_filled;
+
+      std::array<std::vector<unsigned int>, n_lanes> global_indices;
+      std::array<std::vector<std::vector<std::pair<unsigned int, Number>>>,
+                 n_lanes>
+        local_to_global;
+      std::array<std::vector<std::vector<std::pair<unsigned int, Number>>>,
+                 n_lanes>
+                                                     global_to_local;
+      std::array<std::vector<Number>, n_lanes>       diagonal;
+      std::map<unsigned short, std::vector<Number>> interpolation_matrices;
+    };
+  } // namespace internal
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    VectorType &                                        diagonal_global,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+
+    matrix_free.initialize_dof_vector(diagonal_global, dof_no);
+
+    int dummy = 0;
+    matrix_free.template cell_loop<VectorType, int>(
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &data,
+          VectorType &                                        diagonal,
+          const int &,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEEvalType phi(data, dof_no, quad_no, first_selected_component);
+        internal::ComputeDiagonalHelper<dim,
+                                        n_components,
+                                        Number,
+                                        VectorizedArrayType>
+          helper(data, phi.get_shape_info(), dof_no, first_selected_component);
+
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            helper.reinit(cell);
+            for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+              {
+                if (helper.is_active(i) == false)
+                  continue;
+                for (unsigned int j = 0; j < phi.dofs_per_cell; ++j)
+                  phi.begin_dof_values()[j] = VectorizedArrayType();
+                phi.begin_dof_values()[i] = Number(1.);
+
+                local_vmult(phi);
+
+                helper.submit(i, phi.begin_dof_values());
+              }
+            helper.distribute_local_to_global(diagonal);
+          }
+      },
+      diagonal_global,
+      dummy,
+      true);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  compute_block_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    std::vector<FullMatrix<Number>> &                   cell_matrices,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+    cell_matrices.clear();
+    cell_matrices.resize(matrix_free.n_cell_batches() * n_lanes);
+
+    int dummy = 0;
+    matrix_free.template cell_loop<int, int>(
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &data,
+          int &,
+          const int &,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEEvalType phi(data, dof_no, quad_no, first_selected_component);
+
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            internal::compute_cell_matrices(
+              phi,
+              local_vmult,
+              data.n_active_entries_per_cell_batch(cell),
+              cell_matrices.data() + cell * n_lanes);
+          }
+      },
+      dummy,
+      dummy);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number> &                   constraints,
+    MatrixType &                                        matrix,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+    Threads::Mutex mutex;
+    int            dummy = 0;
+    matrix_free.template cell_loop<int, int>(
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &data,
+          int &,
+          const int &,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEEvalType phi(data, dof_no, quad_no, first_selected_component);
+        const std::vector<unsigned int> &lexicographic =
+          phi.get_shape_info().lexicographic_numbering;
+        const unsigned int first_dof =
+          first_selected_component *
+          phi.get_shape_info().dofs_per_component_on_cell;
+
+        std::array<FullMatrix<Number>, n_lanes> cell_matrices;
+        std::vector<types::global_dof_index>    dof_indices;
+        std::vector<types::global_dof_index>    dof_indices_lex(
+          phi.dofs_per_cell);
+
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            const unsigned int n_filled =
+              data.n_active_entries_per_cell_batch(cell);
+            internal::compute_cell_matrices(phi,
+                                            local_vmult,
+                                            n_filled,
+                                            cell_matrices.data());
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (unsigned int v = 0; v < n_filled; ++v)
+              {
+                const auto cell_iterator =
+                  data.get_cell_iterator(cell, v, dof_no);
+                dof_indices.resize(cell_iterator->get_fe().n_dofs_per_cell());
+                if (data.get_mg_level() != numbers::invalid_unsigned_int)
+                  cell_iterator->get_mg_dof_indices(dof_indices);
+                else
+                  cell_iterator->get_dof_indices(dof_indices);
+                for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+                  dof_indices_lex[i] =
+                    dof_indices[lexicographic[first_dof + i]];
+                constraints.distribute_local_to_global(cell_matrices[v],
+                                                       dof_indices_lex,
+                                                       matrix);
+              }
+          }
+      },
+      dummy,
+      dummy);
+
+    matrix.compress(VectorOperation::add);
+  }
+
+
+
+  namespace internal
+  {
+    /**
+     * Return the values of a scalar FEFaceEvaluation object as a tensor
+     * with one component, and the values of a vector-valued one unchanged.
+     */
+    template <typename VectorizedArrayType>
+    inline Tensor<1, 1, VectorizedArrayType>
+    as_component_tensor(const VectorizedArrayType &value)
+    {
+      Tensor<1, 1, VectorizedArrayType> result;
+      result[0] = value;
+      return result;
+    }
+
+
+
+    template <int n_components, typename VectorizedArrayType>
+    inline const Tensor<1, n_components, VectorizedArrayType> &
+    as_component_tensor(
+      const Tensor<1, n_components, VectorizedArrayType> &value)
+    {
+      return value;
+    }
+
+
+
+    /**
+     * Same as as_component_tensor(), but for the gradients of a
+     * FEEvaluation object.
+     */
+    template <int dim, typename VectorizedArrayType>
+    inline Tensor<1, 1, Tensor<1, dim, VectorizedArrayType>>
+    as_component_gradient_tensor(
+      const Tensor<1, dim, VectorizedArrayType> &gradient)
+    {
+      Tensor<1, 1, Tensor<1, dim, VectorizedArrayType>> result;
+      result[0] = gradient;
+      return result;
+    }
+
+
+
+    template <int n_components, int dim, typename VectorizedArrayType>
+    inline const Tensor<1, n_components, Tensor<1, dim, VectorizedArrayType>> &
+    as_component_gradient_tensor(
+      const Tensor<1, n_components, Tensor<1, dim, VectorizedArrayType>>
+        &gradient)
+    {
+      return gradient;
+    }
+
+
+
+    template <int dim, typename VectorizedArrayType>
+    inline const Tensor<2, dim, VectorizedArrayType> &
+    as_component_gradient_tensor(
+      const Tensor<2, dim, VectorizedArrayType> &gradient)
+    {
+      return gradient;
+    }
+
+
+
+    /**
+     * Collect the quadrature points of the first @p n_filled cells of the
+     * cell batch @p phi is currently initialized to in @p points, with the
+     * points of each cell stored contiguously.
+     */
+    template <int dim, typename FEEvalType>
+    void
+    collect_quadrature_points(const FEEvalType &       phi,
+                              const unsigned int       n_filled,
+                              std::vector<Point<dim>> &points)
+    {
+      points.resize(n_filled * phi.n_q_points);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        {
+          const auto point = phi.quadrature_point(q);
+          for (unsigned int v = 0; v < n_filled; ++v)
+            for (unsigned int d = 0; d < dim; ++d)
+              points[v * phi.n_q_points + q][d] = point[d][v];
+        }
+    }
+
+
+
+    /**
+     * Reset the ghost entries of @p vec after they have been written by
+     * FEEvaluation::set_dof_values(). Vectors without ghost entries are left
+     * untouched.
+     */
+    template <typename Number>
+    void
+    zero_out_ghosts(LinearAlgebra::distributed::Vector<Number> &vec)
+    {
+      vec.zero_out_ghosts();
+    }
+
+
+
+    template <typename VectorType>
+    void
+    zero_out_ghosts(VectorType &)
+    {}
+  } // namespace internal
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  estimate_error_kelly(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  solution,
+    Vector<float> &estimated_error_per_cell,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &                                               neumann_bc,
+    const typename KellyErrorEstimator<dim>::Strategy strategy,
+    const unsigned int                                dof_no,
+    const unsigned int                                quad_no,
+    const unsigned int                                first_selected_component)
+  {
+    using FEFaceEvalType = FEFaceEvaluation<dim,
+                                            fe_degree,
+                                            n_q_points_1d,
+                                            n_components,
+                                            Number,
+                                            VectorizedArrayType>;
+    using MatrixFreeType = MatrixFree<dim, Number, VectorizedArrayType>;
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+    Assert(strategy == KellyErrorEstimator<dim>::cell_diameter_over_24 ||
+             strategy == KellyErrorEstimator<dim>::cell_diameter,
+           ExcNotImplemented());
+    Assert(matrix_free.get_mg_level() == numbers::invalid_unsigned_int,
+           ExcNotImplemented());
+    for (const auto &boundary_function : neumann_bc)
+      {
+        (void)boundary_function;
+        Assert(boundary_function.second != nullptr, ExcInternalError());
+        AssertDimension(boundary_function.second->n_components, n_components);
+      }
+
+    // the integrals over the faces of each face batch, which are only
+    // written by the thread working on the respective batch
+    const unsigned int n_inner_faces = matrix_free.n_inner_face_batches();
+    AlignedVector<VectorizedArrayType> face_integrals(
+      n_inner_faces + matrix_free.n_boundary_face_batches());
+
+    const auto face_operation =
+      [&](const MatrixFreeType &data,
+          int &,
+          const VectorType &                           src,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEFaceEvalType phi_m(
+          data, true, dof_no, quad_no, first_selected_component);
+        FEFaceEvalType phi_p(
+          data, false, dof_no, quad_no, first_selected_component);
+        for (unsigned int face = range.first; face < range.second; ++face)
+          {
+            phi_m.reinit(face);
+            phi_m.gather_evaluate(src, EvaluationFlags::gradients);
+            phi_p.reinit(face);
+            phi_p.gather_evaluate(src, EvaluationFlags::gradients);
+
+            // both normal derivatives use the normal of the interior side
+            VectorizedArrayType integral = VectorizedArrayType();
+            for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+              {
+                const Tensor<1, n_components, VectorizedArrayType> jump =
+                  internal::as_component_tensor(
+                    phi_m.get_normal_derivative(q) -
+                    phi_p.get_normal_derivative(q));
+                VectorizedArrayType jump_square = VectorizedArrayType();
+                for (unsigned int c = 0; c < n_components; ++c)
+                  jump_square += jump[c] * jump[c];
+                integral += jump_square * phi_m.JxW(q);
+              }
+            face_integrals[face] = integral;
+          }
+      };
+
+    const auto boundary_operation =
+      [&](const MatrixFreeType &data,
+          int &,
+          const VectorType &                           src,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEFaceEvalType phi(
+          data, true, dof_no, quad_no, first_selected_component);
+        for (unsigned int face = range.first; face < range.second; ++face)
+          {
+            const auto boundary_function =
+              neumann_bc.find(data.get_boundary_id(face));
+            if (boundary_function == neumann_bc.end())
+              {
+                face_integrals[face] = VectorizedArrayType();
+                continue;
+              }
+
+            phi.reinit(face);
+            phi.gather_evaluate(src, EvaluationFlags::gradients);
+
+            VectorizedArrayType integral = VectorizedArrayType();
+            for (unsigned int q = 0; q < phi.n_q_points; ++q)
+              {
+                Tensor<1, n_components, VectorizedArrayType> difference =
+                  internal::as_component_tensor(phi.get_normal_derivative(q));
+                const Point<dim, VectorizedArrayType> point =
+                  phi.quadrature_point(q);
+                for (unsigned int v = 0;
+                     v < data.n_active_entries_per_face_batch(face);
+                     ++v)
+                  {
+                    Point<dim> point_v;
+                    for (unsigned int d = 0; d < dim; ++d)
+                      point_v[d] = point[d][v];
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      difference[c][v] -=
+                        boundary_function->second->value(point_v, c);
+                  }
+                VectorizedArrayType difference_square = VectorizedArrayType();
+                for (unsigned int c = 0; c < n_components; ++c)
+                  difference_square += difference[c] * difference[c];
+                integral += difference_square * phi.JxW(q);
+              }
+            face_integrals[face] = integral;
+          }
+      };
+
+    int dummy = 0;
+    matrix_free.template loop<int, VectorType>(
+      [](const MatrixFreeType &,
+         int &,
+         const VectorType &,
+         const std::pair<unsigned int, unsigned int> &) {},
+      face_operation,
+      boundary_operation,
+      dummy,
+      solution);
+
+    // add the face integrals to the cells on both sides, where the subfaces
+    // of a coarse cell at a hanging face appear in separate face batches.
+    // cells in ghost cell batches are not locally owned and are skipped
+    estimated_error_per_cell.reinit(
+      matrix_free.get_dof_handler(dof_no).get_triangulation().n_active_cells());
+    const unsigned int n_cell_batches = matrix_free.n_cell_batches();
+    const auto add_face_integral = [&](const unsigned int cell,
+                                       const Number       integral) {
+      if (cell / n_lanes < n_cell_batches)
+        estimated_error_per_cell(
+          matrix_free.get_cell_iterator(cell / n_lanes, cell % n_lanes, dof_no)
+            ->active_cell_index()) += integral;
+    };
+    for (unsigned int face = 0; face < face_integrals.size(); ++face)
+      {
+        const auto &face_info = matrix_free.get_face_info(face);
+        for (unsigned int v = 0;
+             v < matrix_free.n_active_entries_per_face_batch(face);
+             ++v)
+          {
+            add_face_integral(face_info.cells_interior[v],
+                              face_integrals[face][v]);
+            if (face < n_inner_faces)
+              add_face_integral(face_info.cells_exterior[v],
+                                face_integrals[face][v]);
+          }
+      }
+
+    for (unsigned int cell = 0; cell < n_cell_batches; ++cell)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          const auto cell_iterator =
+            matrix_free.get_cell_iterator(cell, v, dof_no);
+          const double factor =
+            strategy == KellyErrorEstimator<dim>::cell_diameter_over_24 ?
+              cell_iterator->diameter() / 24 :
+              cell_iterator->diameter();
+          float &error = estimated_error_per_cell(
+            cell_iterator->active_cell_index());
+          error = std::sqrt(error * factor);
+        }
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  solution,
+    const Function<dim, Number> &                       exact_solution,
+    Vector<float> &                                     difference,
+    const VectorTools::NormType &                       norm,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no,
+    const unsigned int first_selected_component)
+  {
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+    using MatrixFreeType = MatrixFree<dim, Number, VectorizedArrayType>;
+
+    Assert(norm == VectorTools::L2_norm || norm == VectorTools::H1_seminorm ||
+             norm == VectorTools::H1_norm || norm == VectorTools::Linfty_norm,
+           ExcNotImplemented());
+    AssertDimension(exact_solution.n_components, n_components);
+
+    const bool need_values = norm != VectorTools::H1_seminorm;
+    const bool need_gradients =
+      norm == VectorTools::H1_seminorm || norm == VectorTools::H1_norm;
+    EvaluationFlags::EvaluationFlags evaluation_flags =
+      EvaluationFlags::nothing;
+    if (need_values)
+      evaluation_flags |= EvaluationFlags::values;
+    if (need_gradients)
+      evaluation_flags |= EvaluationFlags::gradients;
+
+    difference.reinit(
+      matrix_free.get_dof_handler(dof_no).get_triangulation().n_active_cells());
+
+    int dummy = 0;
+    matrix_free.template cell_loop<int, VectorType>(
+      [&](const MatrixFreeType &data,
+          int &,
+          const VectorType &                           src,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEEvalType phi(data, dof_no, quad_no, first_selected_component);
+        std::vector<Point<dim>>             points;
+        std::vector<Number>                 function_values;
+        std::vector<Tensor<1, dim, Number>> function_gradients;
+
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+            phi.gather_evaluate(src, evaluation_flags);
+
+            const unsigned int n_filled =
+              data.n_active_entries_per_cell_batch(cell);
+            internal::collect_quadrature_points(phi, n_filled, points);
+            function_values.resize(points.size());
+            function_gradients.resize(points.size());
+
+            VectorizedArrayType integral = VectorizedArrayType();
+            VectorizedArrayType maximum  = VectorizedArrayType();
+            for (unsigned int c = 0; c < n_components; ++c)
+              {
+                if (need_values)
+                  exact_solution.value_list(points, function_values, c);
+                if (need_gradients)
+                  exact_solution.gradient_list(points, function_gradients, c);
+
+                for (unsigned int q = 0; q < phi.n_q_points; ++q)
+                  {
+                    if (need_values)
+                      {
+                        VectorizedArrayType value_difference =
+                          internal::as_component_tensor(phi.get_value(q))[c];
+                        for (unsigned int v = 0; v < n_filled; ++v)
+                          value_difference[v] -=
+                            function_values[v * phi.n_q_points + q];
+                        if (norm == VectorTools::Linfty_norm)
+                          maximum =
+                            std::max(maximum, std::abs(value_difference));
+                        else
+                          integral += value_difference * value_difference *
+                                      phi.JxW(q);
+                      }
+                    if (need_gradients)
+                      {
+                        Tensor<1, dim, VectorizedArrayType>
+                          gradient_difference =
+                            internal::as_component_gradient_tensor(
+                              phi.get_gradient(q))[c];
+                        for (unsigned int v = 0; v < n_filled; ++v)
+                          for (unsigned int d = 0; d < dim; ++d)
+                            gradient_difference[d][v] -=
+                              function_gradients[v * phi.n_q_points + q][d];
+                        integral += gradient_difference * gradient_difference *
+                                    phi.JxW(q);
+                      }
+                  }
+              }
+
+            for (unsigned int v = 0; v < n_filled; ++v)
+              difference(
+                data.get_cell_iterator(cell, v, dof_no)->active_cell_index()) =
+                norm == VectorTools::Linfty_norm ? maximum[v] :
+                                                   std::sqrt(integral[v]);
+          }
+      },
+      dummy,
+      solution);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  interpolate(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+              const Function<dim, Number> &                       function,
+              VectorType &                                        vec,
+              const unsigned int                                  dof_no,
+              const unsigned int                                  quad_no,
+              const unsigned int first_selected_component)
+  {
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+    using MatrixFreeType = MatrixFree<dim, Number, VectorizedArrayType>;
+
+    AssertDimension(function.n_components, n_components);
+
+    int dummy = 0;
+    matrix_free.template cell_loop<int, int>(
+      [&](const MatrixFreeType &data,
+          int &,
+          const int &,
+          const std::pair<unsigned int, unsigned int> &range) {
+        FEEvalType phi(data, dof_no, quad_no, first_selected_component);
+        Assert(phi.get_shape_info().element_type ==
+                 dealii::internal::MatrixFreeFunctions::
+                   tensor_symmetric_collocation,
+               ExcMessage("The quadrature points must coincide with the "
+                          "support points of the finite element."));
+        const unsigned int dofs_per_component =
+          phi.get_shape_info().dofs_per_component_on_cell;
+        std::vector<Point<dim>> points;
+        std::vector<Number>     function_values;
+
+        for (unsigned int cell = range.first; cell < range.second; ++cell)
+          {
+            phi.reinit(cell);
+
+            const unsigned int n_filled =
+              data.n_active_entries_per_cell_batch(cell);
+            internal::collect_quadrature_points(phi, n_filled, points);
+            function_values.resize(points.size());
+
+            for (unsigned int c = 0; c < n_components; ++c)
+              {
+                function.value_list(points, function_values, c);
+                for (unsigned int q = 0; q < phi.n_q_points; ++q)
+                  {
+                    VectorizedArrayType value = VectorizedArrayType();
+                    for (unsigned int v = 0; v < n_filled; ++v)
+                      value[v] = function_values[v * phi.n_q_points + q];
+                    phi.begin_dof_values()[c * dofs_per_component + q] = value;
+                  }
+              }
+            phi.set_dof_values(vec);
+          }
+      },
+      dummy,
+      dummy);
+
+    internal::zero_out_ghosts(vec);
+  }
+
+#endif // DOXYGEN
+
+} // namespace MatrixFreeTools
 
 
 DEAL_II_NAMESPACE_CLOSE
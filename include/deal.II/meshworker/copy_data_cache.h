@@ -0,0 +1,337 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_meshworker_copy_data_cache_h
+#define dealii_meshworker_copy_data_cache_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace MeshWorker
+{
+  /**
+   * A cache of the CopyData objects computed by a cell worker, with one
+   * entry per active cell of a triangulation.
+   *
+   * In nonlinear problems, the local contributions of many cells often
+   * change very little (or not at all) from one Newton iteration to the
+   * next. Wrapping the cell worker passed to WorkStream::run() or
+   * MeshWorker::mesh_loop() by make_cached_cell_worker() makes the loop skip
+   * the cell worker (and with it the reinitialization of FEValues objects and
+   * the local integration) on cells for which a user-provided indicator says
+   * that nothing has changed, and instead hand the cached CopyData object of
+   * that cell to the copier. The copier, and consequently the distribution of
+   * the local contributions into global matrices and vectors, is called on
+   * all cells as before.
+   *
+   * Since the slot of each cell is only accessed by the thread working on
+   * that cell, the cache can be used in parallel loops without any locking.
+   *
+   * The cache is cleared automatically whenever the triangulation changes.
+   *
+   * An example is given by
+   * @code
+   * MeshWorker::CopyDataCache<CopyData> cache(triangulation);
+   *
+   * for (unsigned int it = 0; it < n_newton_iterations; ++it)
+   *   {
+   *     // decide which cells need to be reassembled in this iteration
+   *     auto cell_has_changed = [&](const CellIteratorType &cell) {
+   *       return solution_update_on_cell_is_large(cell);
+   *     };
+   *
+   *     MeshWorker::mesh_loop(
+   *       dof_handler.active_cell_iterators(),
+   *       MeshWorker::make_cached_cell_worker(cache,
+   *                                           cell_worker,
+   *                                           cell_has_changed),
+   *       copier,
+   *       scratch,
+   *       copy,
+   *       MeshWorker::assemble_own_cells);
+   *   }
+   * @endcode
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CopyData>
+  class CopyDataCache
+  {
+  public:
+    /**
+     * Constructor. Set up an empty cache for the active cells of @p tria.
+     */
+    template <int dim, int spacedim>
+    explicit CopyDataCache(const Triangulation<dim, spacedim> &tria);
+
+    /**
+     * The cache stores a connection to the triangulation, so it cannot be
+     * copied.
+     */
+    CopyDataCache(const CopyDataCache<CopyData> &) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~CopyDataCache();
+
+    /**
+     * Copy assignment is deleted for the same reason as the copy
+     * constructor.
+     */
+    CopyDataCache<CopyData> &
+    operator=(const CopyDataCache<CopyData> &) = delete;
+
+    /**
+     * Return whether there is a cached object for the given active @p cell.
+     */
+    template <class CellIteratorType>
+    bool
+    is_cached(const CellIteratorType &cell) const;
+
+    /**
+     * Return the cached object for the given active @p cell.
+     */
+    template <class CellIteratorType>
+    const CopyData &
+    get(const CellIteratorType &cell) const;
+
+    /**
+     * Store @p copy_data as the cached object for the given active @p cell.
+     */
+    template <class CellIteratorType>
+    void
+    store(const CellIteratorType &cell, const CopyData &copy_data);
+
+    /**
+     * Remove the cached object of the given active @p cell, so that it is
+     * computed again the next time.
+     */
+    template <class CellIteratorType>
+    void
+    invalidate(const CellIteratorType &cell);
+
+    /**
+     * Remove all cached objects.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of cells for which an object is cached.
+     */
+    unsigned int
+    n_cached_cells() const;
+
+  private:
+    /**
+     * Drop all cached objects and resize the cache to @p n_active_cells
+     * cells.
+     */
+    void
+    reinit(const unsigned int n_active_cells);
+
+    /**
+     * The cached objects, indexed by the active cell index. The objects are
+     * allocated on first use, since CopyData classes need not be default
+     * constructible. Invalidating a cell only resets its flag in #is_valid,
+     * so that its object can be reused.
+     */
+    std::vector<std::unique_ptr<CopyData>> data;
+
+    /**
+     * Whether the respective entry of #data is valid. These are characters
+     * rather than a std::vector<bool> so that different threads can set the
+     * flags of different cells at the same time.
+     */
+    std::vector<unsigned char> is_valid;
+
+    /**
+     * The connection to the signal of the triangulation that clears the
+     * cache whenever the triangulation changes.
+     */
+    boost::signals2::connection tria_listener;
+  };
+
+
+
+  /**
+   * Return a cell worker that calls @p cell_worker only on cells for which
+   * @p cell_has_changed returns true or for which @p cache does not yet hold
+   * an object, and stores the resulting CopyData object in the cache. On all
+   * other cells, the cached object is copied into the CopyData argument
+   * instead.
+   *
+   * @p cell_worker and @p cell_has_changed can be any function objects that
+   * can be called with the arguments of a cell worker and with a cell
+   * iterator, respectively. The returned function object can be used in
+   * place of @p cell_worker in WorkStream::run() and MeshWorker::mesh_loop().
+   * In the latter case, the cell worker needs to be the first worker that
+   * writes into the CopyData object of a cell, i.e.,
+   * AssembleFlags::cells_after_faces must not be set if face workers are
+   * used, since the cached object replaces the content of the CopyData
+   * object.
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CopyData, class CellWorkerType, class ChangeIndicatorType>
+  auto
+  make_cached_cell_worker(CopyDataCache<CopyData> &  cache,
+                          const CellWorkerType &     cell_worker,
+                          const ChangeIndicatorType &cell_has_changed)
+  {
+    return [&cache, cell_worker, cell_has_changed](const auto &cell,
+                                                   auto &      scratch_data,
+                                                   CopyData &  copy_data) {
+      if (cache.is_cached(cell) && !cell_has_changed(cell))
+        copy_data = cache.get(cell);
+      else
+        {
+          cell_worker(cell, scratch_data, copy_data);
+          cache.store(cell, copy_data);
+        }
+    };
+  }
+
+
+
+  /* ------------------------ CopyDataCache functions ----------------------- */
+
+#ifndef DOXYGEN
+
+  template <class CopyData>
+  template <int dim, int spacedim>
+  CopyDataCache<CopyData>::CopyDataCache(
+    const Triangulation<dim, spacedim> &tria)
+  {
+    reinit(tria.n_active_cells());
+    tria_listener = tria.signals.any_change.connect(
+      [this, &tria]() { reinit(tria.n_active_cells()); });
+  }
+
+
+
+  template <class CopyData>
+  CopyDataCache<CopyData>::~CopyDataCache()
+  {
+    tria_listener.disconnect();
+  }
+
+
+
+  template <class CopyData>
+  template <class CellIteratorType>
+  inline bool
+  CopyDataCache<CopyData>::is_cached(const CellIteratorType &cell) const
+  {
+    Assert(cell->is_active(), ExcMessage("The cell needs to be active."));
+    AssertIndexRange(cell->active_cell_index(), is_valid.size());
+    return is_valid[cell->active_cell_index()] != 0;
+  }
+
+
+
+  template <class CopyData>
+  template <class CellIteratorType>
+  inline const CopyData &
+  CopyDataCache<CopyData>::get(const CellIteratorType &cell) const
+  {
+    Assert(is_cached(cell),
+           ExcMessage("There is no cached object for this cell."));
+    return *data[cell->active_cell_index()];
+  }
+
+
+
+  template <class CopyData>
+  template <class CellIteratorType>
+  inline void
+  CopyDataCache<CopyData>::store(const CellIteratorType &cell,
+                                 const CopyData &        copy_data)
+  {
+    Assert(cell->is_active(), ExcMessage("The cell needs to be active."));
+    AssertIndexRange(cell->active_cell_index(), is_valid.size());
+    std::unique_ptr<CopyData> &entry = data[cell->active_cell_index()];
+    if (entry == nullptr)
+      entry = std::make_unique<CopyData>(copy_data);
+    else
+      *entry = copy_data;
+    is_valid[cell->active_cell_index()] = 1;
+  }
+
+
+
+  template <class CopyData>
+  template <class CellIteratorType>
+  inline void
+  CopyDataCache<CopyData>::invalidate(const CellIteratorType &cell)
+  {
+    Assert(cell->is_active(), ExcMessage("The cell needs to be active."));
+    AssertIndexRange(cell->active_cell_index(), is_valid.size());
+    is_valid[cell->active_cell_index()] = 0;
+  }
+
+
+
+  template <class CopyData>
+  void
+  CopyDataCache<CopyData>::clear()
+  {
+    reinit(is_valid.size());
+  }
+
+
+
+  template <class CopyData>
+  unsigned int
+  CopyDataCache<CopyData>::n_cached_cells() const
+  {
+    unsigned int n = 0;
+    for (const unsigned char valid : is_valid)
+      n += (valid != 0);
+    return n;
+  }
+
+
+
+  template <class CopyData>
+  void
+  CopyDataCache<CopyData>::reinit(const unsigned int n_active_cells)
+  {
+    // release the memory of the cached objects rather than only resetting
+    // the flags, since the objects may be large
+    std::vector<std::unique_ptr<CopyData>>(n_active_cells).swap(data);
+    is_valid.assign(n_active_cells, 0);
+  }
+
+
+
+#endif
+
+} // namespace MeshWorker
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
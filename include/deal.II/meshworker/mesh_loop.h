@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/graph_coloring.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/work_stream.h>
 
@@ -31,8 +32,10 @@
 #include <deal.II/meshworker/local_integrator.h>
 #include <deal.II/meshworker/loop.h>
 
+#include <algorithm>
 #include <functional>
 #include <type_traits>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -96,6 +99,201 @@ namespace MeshWorker
       // remove the template layers to retrieve the underlying iterator type.
       using type = typename CellIteratorBaseType<CellIteratorType>::type;
     };
+
+    /**
+     * Visit @p cell and its faces in the way described in the documentation
+     * of mesh_loop() for the given @p flags, and call @p cell_worker,
+     * @p boundary_worker, and @p face_worker for the work that needs to be
+     * done on the cell, on its boundary faces, and on its interior faces,
+     * respectively. The three function objects receive the same arguments as
+     * the corresponding workers of mesh_loop(), except for the scratch and
+     * copy data objects.
+     */
+    template <class CellIteratorBaseType,
+              class CellWorker,
+              class BoundaryWorker,
+              class FaceWorker>
+    void
+    visit_cell_and_faces(const CellIteratorBaseType &cell,
+                         const AssembleFlags         flags,
+                         const CellWorker &          cell_worker,
+                         const BoundaryWorker &      boundary_worker,
+                         const FaceWorker &          face_worker)
+    {
+      const bool ignore_subdomain =
+        (cell->get_triangulation().locally_owned_subdomain() ==
+         numbers::invalid_subdomain_id);
+
+      types::subdomain_id current_subdomain_id =
+        (cell->is_level_cell() ? cell->level_subdomain_id() :
+                                 cell->subdomain_id());
+
+      const bool own_cell =
+        ignore_subdomain ||
+        (current_subdomain_id ==
+         cell->get_triangulation().locally_owned_subdomain());
+
+      if ((!ignore_subdomain) &&
+          (current_subdomain_id == numbers::artificial_subdomain_id))
+        return;
+
+      if (!(flags & (cells_after_faces)) &&
+          (((flags & (assemble_own_cells)) && own_cell) ||
+           ((flags & assemble_ghost_cells) && !own_cell)))
+        cell_worker(cell);
+
+      if (flags & (work_on_faces | work_on_boundary))
+        for (const unsigned int face_no :
+             GeometryInfo<CellIteratorBaseType::AccessorType::Container::
+                            dimension>::face_indices())
+          {
+            if (cell->at_boundary(face_no) &&
+                !cell->has_periodic_neighbor(face_no))
+              {
+                // only integrate boundary faces of own cells
+                if ((flags & assemble_boundary_faces) && own_cell)
+                  boundary_worker(cell, face_no);
+              }
+            else
+              {
+                // interior face, potentially assemble
+                TriaIterator<typename CellIteratorBaseType::AccessorType>
+                  neighbor = cell->neighbor_or_periodic_neighbor(face_no);
+
+                types::subdomain_id neighbor_subdomain_id =
+                  numbers::artificial_subdomain_id;
+                if (neighbor->is_level_cell())
+                  neighbor_subdomain_id = neighbor->level_subdomain_id();
+                // subdomain id is only valid for active cells
+                else if (neighbor->is_active())
+                  neighbor_subdomain_id = neighbor->subdomain_id();
+
+                const bool own_neighbor =
+                  ignore_subdomain ||
+                  (neighbor_subdomain_id ==
+                   cell->get_triangulation().locally_owned_subdomain());
+
+                // skip all faces between two ghost cells
+                if (!own_cell && !own_neighbor)
+                  continue;
+
+                // skip if the user doesn't want faces between own cells
+                if (own_cell && own_neighbor &&
+                    !(flags & (assemble_own_interior_faces_both |
+                               assemble_own_interior_faces_once)))
+                  continue;
+
+                // skip face to ghost
+                if (own_cell != own_neighbor &&
+                    !(flags &
+                      (assemble_ghost_faces_both | assemble_ghost_faces_once)))
+                  continue;
+
+                // Deal with refinement edges from the refined side. Assuming
+                // one-irregular meshes, this situation should only occur if
+                // both cells are active.
+                const bool periodic_neighbor =
+                  cell->has_periodic_neighbor(face_no);
+
+                if ((!periodic_neighbor &&
+                     cell->neighbor_is_coarser(face_no)) ||
+                    (periodic_neighbor &&
+                     cell->periodic_neighbor_is_coarser(face_no)))
+                  {
+                    Assert(cell->is_active(), ExcInternalError());
+                    Assert(neighbor->is_active(), ExcInternalError());
+
+                    // skip if only one processor needs to assemble the face
+                    // to a ghost cell and the fine cell is not ours.
+                    if (!own_cell && (flags & assemble_ghost_faces_once))
+                      continue;
+
+                    const std::pair<unsigned int, unsigned int>
+                      neighbor_face_no =
+                        periodic_neighbor ?
+                          cell->periodic_neighbor_of_coarser_periodic_neighbor(
+                            face_no) :
+                          cell->neighbor_of_coarser_neighbor(face_no);
+
+                    face_worker(cell,
+                                face_no,
+                                numbers::invalid_unsigned_int,
+                                neighbor,
+                                neighbor_face_no.first,
+                                neighbor_face_no.second);
+
+                    if (flags & assemble_own_interior_faces_both)
+                      {
+                        // If own faces are to be assembled from both sides,
+                        // call the faceworker again with swapped arguments.
+                        // This is because we won't be looking at an adaptively
+                        // refined edge coming from the other side.
+                        face_worker(neighbor,
+                                    neighbor_face_no.first,
+                                    neighbor_face_no.second,
+                                    cell,
+                                    face_no,
+                                    numbers::invalid_unsigned_int);
+                      }
+                  }
+                else
+                  {
+                    // If iterator is active and neighbor is refined, skip
+                    // internal face.
+                    if (dealii::internal::is_active_iterator(cell) &&
+                        neighbor->has_children())
+                      continue;
+
+                    // Now neighbor is on same level, double-check this:
+                    Assert(cell->level() == neighbor->level(),
+                           ExcInternalError());
+
+                    // If we own both cells only do faces from one side (unless
+                    // AssembleFlags says otherwise). Here, we rely on cell
+                    // comparison that will look at cell->index().
+                    if (own_cell && own_neighbor &&
+                        (flags & assemble_own_interior_faces_once) &&
+                        (neighbor < cell))
+                      continue;
+
+                    // We only look at faces to ghost on the same level once
+                    // (only where own_cell=true and own_neighbor=false)
+                    if (!own_cell)
+                      continue;
+
+                    // now only one processor assembles faces_to_ghost. We let
+                    // the processor with the smaller (level-)subdomain id
+                    // assemble the face.
+                    if (own_cell && !own_neighbor &&
+                        (flags & assemble_ghost_faces_once) &&
+                        (neighbor_subdomain_id < current_subdomain_id))
+                      continue;
+
+                    const unsigned int neighbor_face_no =
+                      periodic_neighbor ?
+                        cell->periodic_neighbor_face_no(face_no) :
+                        cell->neighbor_face_no(face_no);
+                    Assert(periodic_neighbor ||
+                             neighbor->face(neighbor_face_no) ==
+                               cell->face(face_no),
+                           ExcInternalError());
+
+                    face_worker(cell,
+                                face_no,
+                                numbers::invalid_unsigned_int,
+                                neighbor,
+                                neighbor_face_no,
+                                numbers::invalid_unsigned_int);
+                  }
+              }
+          } // faces
+
+      // Execute the cell_worker if faces are handled before cells
+      if ((flags & cells_after_faces) &&
+          (((flags & assemble_own_cells) && own_cell) ||
+           ((flags & assemble_ghost_cells) && !own_cell)))
+        cell_worker(cell);
+    }
   } // namespace internal
 
   /**
@@ -283,219 +481,62 @@ namespace MeshWorker
         "If you specify a cell_worker, you need to set assemble_own_cells or assemble_ghost_cells."));
 
     Assert(
-      (flags &
-       (assemble_own_interior_faces_once | assemble_own_interior_faces_both)) !=
-        (assemble_own_interior_faces_once | assemble_own_interior_faces_both),
-      ExcMessage(
-        "You can only specify assemble_own_interior_faces_once OR assemble_own_interior_faces_both."));
-
-    Assert(
-      (flags & (assemble_ghost_faces_once | assemble_ghost_faces_both)) !=
-        (assemble_ghost_faces_once | assemble_ghost_faces_both),
-      ExcMessage(
-        "You can only specify assemble_ghost_faces_once OR assemble_ghost_faces_both."));
-
-    Assert(
-      !(flags & cells_after_faces) ||
-        (flags & (assemble_own_cells | assemble_ghost_cells)),
-      ExcMessage(
-        "The option cells_after_faces only makes sense if you assemble on cells."));
-
-    Assert((!face_worker) == !(flags & work_on_faces),
-           ExcMessage(
-             "If you specify a face_worker, assemble_face_* needs to be set."));
-
-    Assert(
-      (!boundary_worker) == !(flags & assemble_boundary_faces),
-      ExcMessage(
-        "If you specify a boundary_worker, assemble_boundary_faces needs to be set."));
-
-    auto cell_action = [&](const CellIteratorBaseType &cell,
-                           ScratchData &               scratch,
-                           CopyData &                  copy) {
-      // First reset the CopyData class to the empty copy_data given by the
-      // user.
-      copy = sample_copy_data;
-
-      const bool ignore_subdomain =
-        (cell->get_triangulation().locally_owned_subdomain() ==
-         numbers::invalid_subdomain_id);
-
-      types::subdomain_id current_subdomain_id =
-        (cell->is_level_cell() ? cell->level_subdomain_id() :
-                                 cell->subdomain_id());
-
-      const bool own_cell =
-        ignore_subdomain ||
-        (current_subdomain_id ==
-         cell->get_triangulation().locally_owned_subdomain());
-
-      if ((!ignore_subdomain) &&
-          (current_subdomain_id == numbers::artificial_subdomain_id))
-        return;
-
-      if (!(flags & (cells_after_faces)) &&
-          (((flags & (assemble_own_cells)) && own_cell) ||
-           ((flags & assemble_ghost_cells) && !own_cell)))
-        cell_worker(cell, scratch, copy);
-
-      if (flags & (work_on_faces | work_on_boundary))
-        for (const unsigned int face_no :
-             GeometryInfo<CellIteratorBaseType::AccessorType::Container::
-                            dimension>::face_indices())
-          {
-            if (cell->at_boundary(face_no) &&
-                !cell->has_periodic_neighbor(face_no))
-              {
-                // only integrate boundary faces of own cells
-                if ((flags & assemble_boundary_faces) && own_cell)
-                  boundary_worker(cell, face_no, scratch, copy);
-              }
-            else
-              {
-                // interior face, potentially assemble
-                TriaIterator<typename CellIteratorBaseType::AccessorType>
-                  neighbor = cell->neighbor_or_periodic_neighbor(face_no);
-
-                types::subdomain_id neighbor_subdomain_id =
-                  numbers::artificial_subdomain_id;
-                if (neighbor->is_level_cell())
-                  neighbor_subdomain_id = neighbor->level_subdomain_id();
-                // subdomain id is only valid for active cells
-                else if (neighbor->is_active())
-                  neighbor_subdomain_id = neighbor->subdomain_id();
-
-                const bool own_neighbor =
-                  ignore_subdomain ||
-                  (neighbor_subdomain_id ==
-                   cell->get_triangulation().locally_owned_subdomain());
-
-                // skip all faces between two ghost cells
-                if (!own_cell && !own_neighbor)
-                  continue;
-
-                // skip if the user doesn't want faces between own cells
-                if (own_cell && own_neighbor &&
-                    !(flags & (assemble_own_interior_faces_both |
-                               assemble_own_interior_faces_once)))
-                  continue;
-
-                // skip face to ghost
-                if (own_cell != own_neighbor &&
-                    !(flags &
-                      (assemble_ghost_faces_both | assemble_ghost_faces_once)))
-                  continue;
-
-                // Deal with refinement edges from the refined side. Assuming
-                // one-irregular meshes, this situation should only occur if
-                // both cells are active.
-                const bool periodic_neighbor =
-                  cell->has_periodic_neighbor(face_no);
-
-                if ((!periodic_neighbor &&
-                     cell->neighbor_is_coarser(face_no)) ||
-                    (periodic_neighbor &&
-                     cell->periodic_neighbor_is_coarser(face_no)))
-                  {
-                    Assert(cell->is_active(), ExcInternalError());
-                    Assert(neighbor->is_active(), ExcInternalError());
-
-                    // skip if only one processor needs to assemble the face
-                    // to a ghost cell and the fine cell is not ours.
-                    if (!own_cell && (flags & assemble_ghost_faces_once))
-                      continue;
-
-                    const std::pair<unsigned int, unsigned int>
-                      neighbor_face_no =
-                        periodic_neighbor ?
-                          cell->periodic_neighbor_of_coarser_periodic_neighbor(
-                            face_no) :
-                          cell->neighbor_of_coarser_neighbor(face_no);
-
-                    face_worker(cell,
-                                face_no,
-                                numbers::invalid_unsigned_int,
-                                neighbor,
-                                neighbor_face_no.first,
-                                neighbor_face_no.second,
-                                scratch,
-                                copy);
-
-                    if (flags & assemble_own_interior_faces_both)
-                      {
-                        // If own faces are to be assembled from both sides,
-                        // call the faceworker again with swapped arguments.
-                        // This is because we won't be looking at an adaptively
-                        // refined edge coming from the other side.
-                        face_worker(neighbor,
-                                    neighbor_face_no.first,
-                                    neighbor_face_no.second,
-                                    cell,
-                                    face_no,
-                                    numbers::invalid_unsigned_int,
-                                    scratch,
-                                    copy);
-                      }
-                  }
-                else
-                  {
-                    // If iterator is active and neighbor is refined, skip
-                    // internal face.
-                    if (dealii::internal::is_active_iterator(cell) &&
-                        neighbor->has_children())
-                      continue;
-
-                    // Now neighbor is on same level, double-check this:
-                    Assert(cell->level() == neighbor->level(),
-                           ExcInternalError());
-
-                    // If we own both cells only do faces from one side (unless
-                    // AssembleFlags says otherwise). Here, we rely on cell
-                    // comparison that will look at cell->index().
-                    if (own_cell && own_neighbor &&
-                        (flags & assemble_own_interior_faces_once) &&
-                        (neighbor < cell))
-                      continue;
+      (flags &
+       (assemble_own_interior_faces_once | assemble_own_interior_faces_both)) !=
+        (assemble_own_interior_faces_once | assemble_own_interior_faces_both),
+      ExcMessage(
+        "You can only specify assemble_own_interior_faces_once OR assemble_own_interior_faces_both."));
 
-                    // We only look at faces to ghost on the same level once
-                    // (only where own_cell=true and own_neighbor=false)
-                    if (!own_cell)
-                      continue;
+    Assert(
+      (flags & (assemble_ghost_faces_once | assemble_ghost_faces_both)) !=
+        (assemble_ghost_faces_once | assemble_ghost_faces_both),
+      ExcMessage(
+        "You can only specify assemble_ghost_faces_once OR assemble_ghost_faces_both."));
 
-                    // now only one processor assembles faces_to_ghost. We let
-                    // the processor with the smaller (level-)subdomain id
-                    // assemble the face.
-                    if (own_cell && !own_neighbor &&
-                        (flags & assemble_ghost_faces_once) &&
-                        (neighbor_subdomain_id < current_subdomain_id))
-                      continue;
+    Assert(
+      !(flags & cells_after_faces) ||
+        (flags & (assemble_own_cells | assemble_ghost_cells)),
+      ExcMessage(
+        "The option cells_after_faces only makes sense if you assemble on cells."));
 
-                    const unsigned int neighbor_face_no =
-                      periodic_neighbor ?
-                        cell->periodic_neighbor_face_no(face_no) :
-                        cell->neighbor_face_no(face_no);
-                    Assert(periodic_neighbor ||
-                             neighbor->face(neighbor_face_no) ==
-                               cell->face(face_no),
-                           ExcInternalError());
+    Assert((!face_worker) == !(flags & work_on_faces),
+           ExcMessage(
+             "If you specify a face_worker, assemble_face_* needs to be set."));
 
-                    face_worker(cell,
-                                face_no,
-                                numbers::invalid_unsigned_int,
-                                neighbor,
-                                neighbor_face_no,
-                                numbers::invalid_unsigned_int,
-                                scratch,
-                                copy);
-                  }
-              }
-          } // faces
+    Assert(
+      (!boundary_worker) == !(flags & assemble_boundary_faces),
+      ExcMessage(
+        "If you specify a boundary_worker, assemble_boundary_faces needs to be set."));
 
-      // Execute the cell_worker if faces are handled before cells
-      if ((flags & cells_after_faces) &&
-          (((flags & assemble_own_cells) && own_cell) ||
-           ((flags & assemble_ghost_cells) && !own_cell)))
-        cell_worker(cell, scratch, copy);
+    auto cell_action = [&](const CellIteratorBaseType &cell,
+                           ScratchData &               scratch,
+                           CopyData &                  copy) {
+      // First reset the CopyData class to the empty copy_data given by the
+      // user.
+      copy = sample_copy_data;
+
+      internal::visit_cell_and_faces(
+        cell,
+        flags,
+        [&](const CellIteratorBaseType &c) { cell_worker(c, scratch, copy); },
+        [&](const CellIteratorBaseType &c, const unsigned int face_no) {
+          boundary_worker(c, face_no, scratch, copy);
+        },
+        [&](const CellIteratorBaseType &c,
+            const unsigned int          face_no,
+            const unsigned int          subface_no,
+            const CellIteratorBaseType &neighbor,
+            const unsigned int          neighbor_face_no,
+            const unsigned int          neighbor_subface_no) {
+          face_worker(c,
+                      face_no,
+                      subface_no,
+                      neighbor,
+                      neighbor_face_no,
+                      neighbor_subface_no,
+                      scratch,
+                      copy);
+        });
     };
 
     // Submit to workstream
@@ -930,6 +971,484 @@ namespace MeshWorker
                                     queue_length,
                                     chunk_size);
   }
+
+
+  /**
+   * A precomputed list of the work mesh_loop() does on a range of cells for
+   * a given set of AssembleFlags: for each cell, whether the cell worker is
+   * to be called, and the boundary and interior faces (including the
+   * subface and neighbor information on refinement edges) that are visited
+   * from this cell. Setting up this information is done once in the
+   * constructor, and the object can then be passed to the corresponding
+   * variant of mesh_loop() any number of times, for example in every
+   * iteration of a nonlinear solver, as long as the mesh does not change.
+   * Cells on which there is nothing to do are not stored.
+   *
+   * In addition, make_coloring() partitions the stored cells into colors
+   * such that no two cells of the same color, including the neighbors they
+   * access through their faces, share any of the indices returned by a
+   * user-provided function. mesh_loop() then runs all cells of one color in
+   * parallel, and the copier is called on the worker threads without
+   * synchronization (see the WorkStream documentation on colored
+   * iterators).
+   *
+   * An example is given by
+   * @code
+   * using CellIteratorType = decltype(dof_handler.begin_active());
+   *
+   * MeshWorker::MeshLoopWorkList<CellIteratorType> work_list(
+   *   dof_handler.active_cell_iterators(),
+   *   MeshWorker::assemble_own_cells | MeshWorker::assemble_boundary_faces |
+   *     MeshWorker::assemble_own_interior_faces_once);
+   * work_list.make_coloring([](const CellIteratorType &cell) {
+   *   std::vector<types::global_dof_index> indices(
+   *     cell->get_fe().dofs_per_cell);
+   *   cell->get_dof_indices(indices);
+   *   return indices;
+   * });
+   *
+   * for (unsigned int it = 0; it < n_newton_iterations; ++it)
+   *   MeshWorker::mesh_loop(work_list,
+   *                         cell_worker, copier,
+   *                         scratch, copy,
+   *                         boundary_worker, face_worker);
+   * @endcode
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorBaseType>
+  class MeshLoopWorkList
+  {
+  public:
+    /**
+     * The work on one face, given by the arguments passed to the face worker
+     * of mesh_loop(). For boundary faces, only @p cell and @p face_no are
+     * set, and @p neighbor_face_no equals numbers::invalid_unsigned_int.
+     */
+    struct FaceWork
+    {
+      CellIteratorBaseType cell;
+      unsigned int         face_no;
+      unsigned int         subface_no;
+      CellIteratorBaseType neighbor;
+      unsigned int         neighbor_face_no;
+      unsigned int         neighbor_subface_no;
+    };
+
+    /**
+     * The work associated with one cell.
+     */
+    struct CellWork
+    {
+      /**
+       * The cell.
+       */
+      CellIteratorBaseType cell;
+
+      /**
+       * Whether the cell worker is to be called on this cell.
+       */
+      bool work_on_cell;
+
+      /**
+       * The faces visited from this cell, in the order in which mesh_loop()
+       * would visit them.
+       */
+      std::vector<FaceWork> faces;
+    };
+
+    /**
+     * Iterator type into the list of cells.
+     */
+    using const_iterator = typename std::vector<CellWork>::const_iterator;
+
+    /**
+     * Set up the work list for the cells in the range [@p begin, @p end) as
+     * mesh_loop() would visit them with the given @p flags.
+     */
+    template <class CellIteratorType>
+    MeshLoopWorkList(const CellIteratorType &                         begin,
+                     const typename identity<CellIteratorType>::type &end,
+                     const AssembleFlags                              flags);
+
+    /**
+     * Same as above, but for iterator ranges (and, therefore, filtered
+     * iterators).
+     */
+    template <class CellIteratorType>
+    MeshLoopWorkList(IteratorRange<CellIteratorType> iterator_range,
+                     const AssembleFlags             flags);
+
+    /**
+     * The object stores iterators into its own data in case it is colored,
+     * so it cannot be copied.
+     */
+    MeshLoopWorkList(const MeshLoopWorkList &) = delete;
+
+    /**
+     * Move constructor.
+     */
+    MeshLoopWorkList(MeshLoopWorkList &&) = default;
+
+    /**
+     * Copy assignment is deleted for the same reason as the copy
+     * constructor.
+     */
+    MeshLoopWorkList &
+    operator=(const MeshLoopWorkList &) = delete;
+
+    /**
+     * Partition the cells of this list into colors such that two cells of
+     * the same color do not share any of the conflict indices. The conflict
+     * indices of a cell are the union of the indices @p get_conflict_indices
+     * returns for the cell itself and for all neighbors it accesses through
+     * its faces. They need to cover everything the copier writes into for
+     * the colored loop to be free of races; the typical choice are the DoF
+     * indices of the cell.
+     */
+    void
+    make_coloring(const std::function<std::vector<types::global_dof_index>(
+                    const CellIteratorBaseType &)> &get_conflict_indices);
+
+    /**
+     * Return whether make_coloring() has been called.
+     */
+    bool
+    is_colored() const;
+
+    /**
+     * Return the colors computed by make_coloring().
+     */
+    const std::vector<std::vector<const_iterator>> &
+    get_coloring() const;
+
+    /**
+     * Return the flags this list was set up with.
+     */
+    AssembleFlags
+    get_flags() const;
+
+    /**
+     * Iterator to the first cell of the list.
+     */
+    const_iterator
+    begin() const;
+
+    /**
+     * Iterator past the last cell of the list.
+     */
+    const_iterator
+    end() const;
+
+  private:
+    /**
+     * Add the work on @p cell to the list.
+     */
+    void
+    add_cell(const CellIteratorBaseType &cell);
+
+    /**
+     * The flags this list was set up with.
+     */
+    const AssembleFlags flags;
+
+    /**
+     * The work on all cells with something to do.
+     */
+    std::vector<CellWork> cell_work;
+
+    /**
+     * Whether make_coloring() has been called.
+     */
+    bool colored;
+
+    /**
+     * The colors computed by make_coloring().
+     */
+    std::vector<std::vector<const_iterator>> coloring;
+  };
+
+
+
+  /**
+   * A variant of mesh_loop() that runs the work stored in a MeshLoopWorkList
+   * instead of determining it anew for each cell. The flags are the ones the
+   * @p work_list was set up with; the remaining arguments have the same
+   * meaning as for the other mesh_loop() functions.
+   *
+   * If MeshLoopWorkList::make_coloring() has been called, the colors are run
+   * one after the other with the cells of each color in parallel, and the
+   * copier is called on the worker threads. Otherwise the cells are run
+   * through WorkStream::run() with a copier that is called sequentially, as
+   * in the other mesh_loop() functions.
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorBaseType, class ScratchData, class CopyData>
+  void
+  mesh_loop(
+    const MeshLoopWorkList<CellIteratorBaseType> &work_list,
+    const typename identity<std::function<
+      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
+      &cell_worker,
+    const typename identity<std::function<void(const CopyData &)>>::type
+      &copier,
+
+    const ScratchData &sample_scratch_data,
+    const CopyData &   sample_copy_data,
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &boundary_worker = std::function<void(const CellIteratorBaseType &,
+                                            const unsigned int,
+                                            ScratchData &,
+                                            CopyData &)>(),
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &face_worker = std::function<void(const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        ScratchData &,
+                                        CopyData &)>(),
+
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    const AssembleFlags flags = work_list.get_flags();
+    (void)flags;
+
+    Assert((!cell_worker) == !(flags & work_on_cells),
+           ExcMessage("If you specify a cell_worker, you need to set "
+                      "assemble_own_cells or assemble_ghost_cells."));
+    Assert((!face_worker) == !(flags & work_on_faces),
+           ExcMessage(
+             "If you specify a face_worker, assemble_face_* needs to be set."));
+    Assert((!boundary_worker) == !(flags & assemble_boundary_faces),
+           ExcMessage("If you specify a boundary_worker, "
+                      "assemble_boundary_faces needs to be set."));
+
+    using Iterator =
+      typename MeshLoopWorkList<CellIteratorBaseType>::const_iterator;
+
+    const bool cells_after_faces_flag = (flags & cells_after_faces);
+
+    auto cell_action =
+      [&](const Iterator &work, ScratchData &scratch, CopyData &copy) {
+        // First reset the CopyData class to the empty copy_data given by the
+        // user.
+        copy = sample_copy_data;
+
+        if (work->work_on_cell && !cells_after_faces_flag)
+          cell_worker(work->cell, scratch, copy);
+
+        for (const auto &face : work->faces)
+          if (face.neighbor_face_no == numbers::invalid_unsigned_int)
+            boundary_worker(face.cell, face.face_no, scratch, copy);
+          else
+            face_worker(face.cell,
+                        face.face_no,
+                        face.subface_no,
+                        face.neighbor,
+                        face.neighbor_face_no,
+                        face.neighbor_subface_no,
+                        scratch,
+                        copy);
+
+        if (work->work_on_cell && cells_after_faces_flag)
+          cell_worker(work->cell, scratch, copy);
+      };
+
+    if (work_list.is_colored())
+      WorkStream::run(work_list.get_coloring(),
+                      cell_action,
+                      copier,
+                      sample_scratch_data,
+                      sample_copy_data,
+                      queue_length,
+                      chunk_size);
+    else
+      WorkStream::run(work_list.begin(),
+                      work_list.end(),
+                      cell_action,
+                      copier,
+                      sample_scratch_data,
+                      sample_copy_data,
+                      queue_length,
+                      chunk_size);
+  }
+
+
+
+  /* ------------------- MeshLoopWorkList functions -------------------- */
+
+#ifndef DOXYGEN
+
+  template <class CellIteratorBaseType>
+  template <class CellIteratorType>
+  MeshLoopWorkList<CellIteratorBaseType>::MeshLoopWorkList(
+    const CellIteratorType &                         begin,
+    const typename identity<CellIteratorType>::type &end,
+    const AssembleFlags                              flags)
+    : flags(flags)
+    , colored(false)
+  {
+    for (CellIteratorType cell = begin; cell != end; ++cell)
+      add_cell(cell);
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  template <class CellIteratorType>
+  MeshLoopWorkList<CellIteratorBaseType>::MeshLoopWorkList(
+    IteratorRange<CellIteratorType> iterator_range,
+    const AssembleFlags             flags)
+    : flags(flags)
+    , colored(false)
+  {
+    for (const auto &cell : iterator_range)
+      add_cell(cell);
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  void
+  MeshLoopWorkList<CellIteratorBaseType>::add_cell(
+    const CellIteratorBaseType &cell)
+  {
+    CellWork work;
+    work.cell         = cell;
+    work.work_on_cell = false;
+
+    internal::visit_cell_and_faces(
+      cell,
+      flags,
+      [&](const CellIteratorBaseType &) { work.work_on_cell = true; },
+      [&](const CellIteratorBaseType &c, const unsigned int face_no) {
+        work.faces.push_back({c,
+                              face_no,
+                              numbers::invalid_unsigned_int,
+                              CellIteratorBaseType(),
+                              numbers::invalid_unsigned_int,
+                              numbers::invalid_unsigned_int});
+      },
+      [&](const CellIteratorBaseType &c,
+          const unsigned int          face_no,
+          const unsigned int          subface_no,
+          const CellIteratorBaseType &neighbor,
+          const unsigned int          neighbor_face_no,
+          const unsigned int          neighbor_subface_no) {
+        work.faces.push_back({c,
+                              face_no,
+                              subface_no,
+                              neighbor,
+                              neighbor_face_no,
+                              neighbor_subface_no});
+      });
+
+    if (work.work_on_cell || !work.faces.empty())
+      cell_work.push_back(std::move(work));
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  void
+  MeshLoopWorkList<CellIteratorBaseType>::make_coloring(
+    const std::function<std::vector<types::global_dof_index>(
+      const CellIteratorBaseType &)> &get_conflict_indices)
+  {
+    coloring.clear();
+    colored = true;
+
+    // GraphColoring does not accept empty ranges
+    if (cell_work.empty())
+      return;
+
+    coloring = GraphColoring::make_graph_coloring(
+      cell_work.cbegin(),
+      cell_work.cend(),
+      std::function<std::vector<types::global_dof_index>(
+        const const_iterator &)>([&](const const_iterator &work) {
+        std::vector<types::global_dof_index> indices =
+          get_conflict_indices(work->cell);
+        for (const FaceWork &face : work->faces)
+          if (face.neighbor_face_no != numbers::invalid_unsigned_int)
+            {
+              const std::vector<types::global_dof_index> neighbor_indices =
+                get_conflict_indices(face.neighbor);
+              indices.insert(indices.end(),
+                             neighbor_indices.begin(),
+                             neighbor_indices.end());
+            }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()),
+                      indices.end());
+        return indices;
+      }));
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  inline bool
+  MeshLoopWorkList<CellIteratorBaseType>::is_colored() const
+  {
+    return colored;
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  inline const std::vector<std::vector<
+    typename MeshLoopWorkList<CellIteratorBaseType>::const_iterator>> &
+  MeshLoopWorkList<CellIteratorBaseType>::get_coloring() const
+  {
+    return coloring;
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  inline AssembleFlags
+  MeshLoopWorkList<CellIteratorBaseType>::get_flags() const
+  {
+    return flags;
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  inline typename MeshLoopWorkList<CellIteratorBaseType>::const_iterator
+  MeshLoopWorkList<CellIteratorBaseType>::begin() const
+  {
+    return cell_work.cbegin();
+  }
+
+
+
+  template <class CellIteratorBaseType>
+  inline typename MeshLoopWorkList<CellIteratorBaseType>::const_iterator
+  MeshLoopWorkList<CellIteratorBaseType>::end() const
+  {
+    return cell_work.cend();
+  }
+
+#endif
+
 } // namespace MeshWorker
 
 DEAL_II_NAMESPACE_CLOSE
@@ -764,6 +764,17 @@ namespace MeshWorker
     const Mapping<dim, spacedim> &
     get_mapping() const;
 
+    /**
+     * Enable the geometry cache of the FEValues objects used on the current
+     * cell and on its neighbor, see FEValues::enable_geometry_cache(). This
+     * is useful on meshes with large structured regions, where the shape
+     * function data transformed to the real cell can be reused between
+     * cells of the same shape. Since the cache is stored in the FEValues
+     * objects, it is not shared between copies of this object.
+     */
+    void
+    enable_geometry_cache(const unsigned int max_n_entries = 64);
+
   private:
     /**
      * Construct a unique name to store vectors of values, gradients,
@@ -832,6 +843,12 @@ namespace MeshWorker
      */
     UpdateFlags neighbor_face_update_flags;
 
+    /**
+     * The maximal number of entries in the geometry cache of the cell
+     * FEValues objects, or zero if the cache is disabled.
+     */
+    unsigned int geometry_cache_max_n_entries;
+
     /**
      * Finite element values on the current cell.
      */
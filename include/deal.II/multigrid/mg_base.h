@@ -209,6 +209,30 @@ public:
   restrict_and_add(const unsigned int from_level,
                    VectorType &       dst,
                    const VectorType & src) const = 0;
+
+  /**
+   * Compute the residual <tt>rhs - matrix_times_u</tt> on level
+   * <tt>from_level</tt>, restrict it to level <tt>from_level-1</tt> and add
+   * the result to <tt>dst</tt>. This is the operation a multigrid cycle
+   * performs after the pre-smoothing step. The result must be equivalent to
+   * @code
+   * matrix_times_u.sadd(-1., 1., rhs);
+   * restrict_and_add(from_level, dst, matrix_times_u);
+   * @endcode
+   * which is what the default implementation does. Derived classes can
+   * override this function to compute the residual while they copy the
+   * fine-level vector into their internal data structures, saving one pass
+   * over the level vector.
+   *
+   * @arg matrix_times_u contains the matrix-vector product on level
+   * <tt>from_level</tt> on input. Its content is unspecified on output, so
+   * it can be used as scratch space.
+   */
+  virtual void
+  restrict_residual_and_add(const unsigned int from_level,
+                            VectorType &       dst,
+                            const VectorType & rhs,
+                            VectorType &       matrix_times_u) const;
 };
 
 
@@ -21,7 +21,12 @@
 
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/linear_operator.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/trilinos_precondition.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
 
 #include <deal.II/multigrid/mg_base.h>
 
@@ -321,6 +326,99 @@ private:
   LAPACKFullMatrix<number> matrix;
 };
 
+#ifdef DEAL_II_WITH_TRILINOS
+/**
+ * Coarse grid solver based on the algebraic multigrid preconditioner
+ * TrilinosWrappers::PreconditionAMG, which this class owns.
+ *
+ * Upon initialize(), the AMG hierarchy is set up for the given matrix. If the
+ * entries of the coarse matrix change but its sparsity pattern does not, e.g.
+ * between time steps or nonlinear iterations, update_matrix_values()
+ * recomputes the hierarchy while reusing the aggregation of the previous
+ * setup, which is considerably cheaper than a new initialize().
+ *
+ * The AMG hierarchy lives on the communicator of the coarse matrix, and
+ * processes that do not own rows of the matrix do not take part in the
+ * computations on the coarse levels of AMG. If the coarse level of the
+ * geometric multigrid hierarchy is partitioned onto a subset of the processes
+ * (see MGTransferGlobalCoarseningTools::partition_triangulation_onto_subset()),
+ * AMG therefore effectively runs on that subset.
+ *
+ * By default, operator() applies one cycle of AMG. If a SolverControl is
+ * given to initialize(), the coarse problem is instead solved by the
+ * conjugate gradient method preconditioned by AMG.
+ */
+template <class VectorType = LinearAlgebra::distributed::Vector<double>>
+class MGCoarseGridAMG : public MGCoarseGridBase<VectorType>
+{
+public:
+  /**
+   * Constructor leaving an uninitialized object.
+   */
+  MGCoarseGridAMG() = default;
+
+  /**
+   * Set up the AMG hierarchy for @p matrix with the given @p amg_data. Only
+   * a reference to @p matrix and @p solver_control is stored, so their
+   * lifetime needs to exceed the usage in this class. If @p solver_control
+   * is a null pointer, operator() applies a single AMG cycle.
+   */
+  void
+  initialize(const TrilinosWrappers::SparseMatrix &                  matrix,
+             const TrilinosWrappers::PreconditionAMG::AdditionalData &amg_data =
+               TrilinosWrappers::PreconditionAMG::AdditionalData(),
+             SolverControl *solver_control = nullptr);
+
+  /**
+   * Recompute the AMG hierarchy after the entries of the matrix given to
+   * initialize() have changed, keeping the aggregation computed in the last
+   * call to initialize(). The sparsity pattern of the matrix must not have
+   * changed.
+   */
+  void
+  update_matrix_values();
+
+  /**
+   * Release the AMG hierarchy and all pointers.
+   */
+  void
+  clear();
+
+  /**
+   * Apply AMG to @p src, or solve with the coarse matrix if a SolverControl
+   * was given to initialize().
+   */
+  virtual void
+  operator()(const unsigned int level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+  /**
+   * Return the AMG preconditioner, e.g. to query or reuse it elsewhere.
+   */
+  const TrilinosWrappers::PreconditionAMG &
+  get_preconditioner() const;
+
+private:
+  /**
+   * Reference to the coarse matrix.
+   */
+  SmartPointer<const TrilinosWrappers::SparseMatrix,
+               MGCoarseGridAMG<VectorType>>
+    matrix;
+
+  /**
+   * Reference to the control object of the outer iterative solver, if any.
+   */
+  SmartPointer<SolverControl, MGCoarseGridAMG<VectorType>> solver_control;
+
+  /**
+   * The AMG preconditioner.
+   */
+  TrilinosWrappers::PreconditionAMG amg;
+};
+#endif
+
 /*@}*/
 
 #ifndef DOXYGEN
@@ -617,6 +715,67 @@ MGCoarseGridSVD<number, VectorType>::log() const
 }
 
 
+#ifdef DEAL_II_WITH_TRILINOS
+/* ------------------ Functions for MGCoarseGridAMG -----------*/
+
+template <class VectorType>
+void
+MGCoarseGridAMG<VectorType>::initialize(
+  const TrilinosWrappers::SparseMatrix &                   matrix,
+  const TrilinosWrappers::PreconditionAMG::AdditionalData &amg_data,
+  SolverControl *                                          solver_control)
+{
+  this->matrix         = &matrix;
+  this->solver_control = solver_control;
+  amg.initialize(matrix, amg_data);
+}
+
+
+template <class VectorType>
+void
+MGCoarseGridAMG<VectorType>::update_matrix_values()
+{
+  Assert(matrix != nullptr, ExcNotInitialized());
+  amg.reinit();
+}
+
+
+template <class VectorType>
+void
+MGCoarseGridAMG<VectorType>::clear()
+{
+  amg.clear();
+  matrix         = nullptr;
+  solver_control = nullptr;
+}
+
+
+template <class VectorType>
+void
+MGCoarseGridAMG<VectorType>::operator()(const unsigned int /*level*/,
+                                        VectorType &      dst,
+                                        const VectorType &src) const
+{
+  Assert(matrix != nullptr, ExcNotInitialized());
+  if (solver_control != nullptr)
+    {
+      dst = 0.;
+      SolverCG<VectorType> solver(*solver_control);
+      solver.solve(*matrix, dst, src, amg);
+    }
+  else
+    amg.vmult(dst, src);
+}
+
+
+template <class VectorType>
+const TrilinosWrappers::PreconditionAMG &
+MGCoarseGridAMG<VectorType>::get_preconditioner() const
+{
+  return amg;
+}
+#endif
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -435,6 +435,17 @@ private:
  * multigrid method must be used only with the vector associated to that
  * single block.
  *
+ * Calling one of the @p initialize functions again for the same range of
+ * levels keeps the smoother objects and re-initializes them, rather than
+ * creating new ones. This allows to cheaply update the smoothers when the
+ * level matrices change, e.g. between the steps of a nonlinear solver. For
+ * PreconditionChebyshev, setting
+ * PreconditionChebyshev::AdditionalData::reuse_eigenvalue_estimates keeps
+ * the eigenvalue estimates of the previous setup on each level, and
+ * handing in the same PreconditionChebyshev::AdditionalData::preconditioner
+ * objects keeps the level diagonals, so that only the operators themselves
+ * need to be updated.
+ *
  * The library contains instantiation for <tt>SparseMatrix<.></tt> and
  * <tt>Vector<.></tt>, where the template arguments are all combinations of @p
  * float and @p double. Additional instantiations may be created by including
@@ -1025,7 +1036,10 @@ MGSmootherPrecondition<MatrixType, PreconditionerType, VectorType>::initialize(
   const unsigned int max = m.max_level();
 
   matrices.resize(min, max);
-  smoothers.resize(min, max);
+  // keep the smoother objects if the levels did not change, so that data
+  // computed in a previous setup can be reused
+  if (smoothers.min_level() != min || smoothers.max_level() != max)
+    smoothers.resize(min, max);
 
   for (unsigned int i = min; i <= max; ++i)
     {
@@ -1054,7 +1068,10 @@ MGSmootherPrecondition<MatrixType, PreconditionerType, VectorType>::initialize(
   Assert(data.max_level() == max, ExcDimensionMismatch(data.max_level(), max));
 
   matrices.resize(min, max);
-  smoothers.resize(min, max);
+  // keep the smoother objects if the levels did not change, so that data
+  // computed in a previous setup can be reused
+  if (smoothers.min_level() != min || smoothers.max_level() != max)
+    smoothers.resize(min, max);
 
   for (unsigned int i = min; i <= max; ++i)
     {
@@ -1082,7 +1099,10 @@ MGSmootherPrecondition<MatrixType, PreconditionerType, VectorType>::initialize(
   const unsigned int max = m.max_level();
 
   matrices.resize(min, max);
-  smoothers.resize(min, max);
+  // keep the smoother objects if the levels did not change, so that data
+  // computed in a previous setup can be reused
+  if (smoothers.min_level() != min || smoothers.max_level() != max)
+    smoothers.resize(min, max);
 
   for (unsigned int i = min; i <= max; ++i)
     {
@@ -1109,7 +1129,10 @@ MGSmootherPrecondition<MatrixType, PreconditionerType, VectorType>::initialize(
   Assert(data.max_level() == max, ExcDimensionMismatch(data.max_level(), max));
 
   matrices.resize(min, max);
-  smoothers.resize(min, max);
+  // keep the smoother objects if the levels did not change, so that data
+  // computed in a previous setup can be reused
+  if (smoothers.min_level() != min || smoothers.max_level() != max)
+    smoothers.resize(min, max);
 
   for (unsigned int i = min; i <= max; ++i)
     {
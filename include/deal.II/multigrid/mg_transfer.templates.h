@@ -487,29 +487,33 @@ MGLevelGlobalTransfer<LinearAlgebra::distributed::Vector<Number>>::copy_to_mg(
   // copy the source vector to the temporary vector that we hold for the
   // purpose of data exchange
   this_ghosted_global_vector = src;
-  this_ghosted_global_vector.update_ghost_values();
-
-  for (unsigned int level = dst.max_level() + 1; level != dst.min_level();)
-    {
-      --level;
-
-      LinearAlgebra::distributed::Vector<Number> &dst_level = dst[level];
-
-      auto copy_unknowns = [&](const Table<2, unsigned int> &indices) {
-        for (unsigned int i = 0; i < indices.n_cols(); ++i)
-          dst_level.local_element(indices(1, i)) =
-            this_ghosted_global_vector.local_element(indices(0, i));
-      };
-
-      // first copy local unknowns
-      copy_unknowns(this_copy_indices[level]);
+  this_ghosted_global_vector.update_ghost_values_start();
+
+  const auto copy_unknowns = [&](const Table<2, unsigned int> &indices,
+                                 const unsigned int            level) {
+    LinearAlgebra::distributed::Vector<Number> &dst_level = dst[level];
+    for (unsigned int i = 0; i < indices.n_cols(); ++i)
+      dst_level.local_element(indices(1, i)) =
+        this_ghosted_global_vector.local_element(indices(0, i));
+  };
+
+  // first copy local unknowns on all levels while the ghost values of the
+  // global vector are exchanged
+  for (unsigned int level = dst.min_level(); level <= dst.max_level(); ++level)
+    copy_unknowns(this_copy_indices[level], level);
 
-      // Do the same for the indices where the level index is local, but the
-      // global index is not
-      copy_unknowns(this_copy_indices_level_mine[level]);
+  this_ghosted_global_vector.update_ghost_values_finish();
 
-      dst_level.compress(VectorOperation::insert);
+  // Do the same for the indices where the level index is local, but the
+  // global index is not, and send the entries of the level vectors to their
+  // owners using one communication channel per level
+  for (unsigned int level = dst.min_level(); level <= dst.max_level(); ++level)
+    {
+      copy_unknowns(this_copy_indices_level_mine[level], level);
+      dst[level].compress_start(level, VectorOperation::insert);
     }
+  for (unsigned int level = dst.min_level(); level <= dst.max_level(); ++level)
+    dst[level].compress_finish(VectorOperation::insert);
 }
 
 
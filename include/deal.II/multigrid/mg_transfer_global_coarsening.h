@@ -0,0 +1,659 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_transfer_global_coarsening_h
+#define dealii_mg_transfer_global_coarsening_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/partitioner.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/hp/dof_handler.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_base.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * Utility functions for setting up the levels of a global-coarsening
+ * multigrid hierarchy.
+ */
+namespace MGTransferGlobalCoarseningTools
+{
+  /**
+   * Strategies for the selection of the polynomial degree of the next
+   * coarser level in a p-multigrid hierarchy.
+   */
+  enum class PolynomialCoarseningSequenceType
+  {
+    /**
+     * Halve the polynomial degree, rounding down: $p \to \lfloor p/2
+     * \rfloor$, but at least one.
+     */
+    bisect,
+    /**
+     * Decrease the polynomial degree by one: $p \to p-1$.
+     */
+    decrease_by_one,
+    /**
+     * Go directly to the linear element: $p \to 1$.
+     */
+    go_to_one
+  };
+
+  /**
+   * Return the polynomial degree of the level following the level with
+   * polynomial degree @p degree in the coarsening sequence given by
+   * @p p_sequence.
+   */
+  unsigned int
+  create_next_polynomial_coarsening_degree(
+    const unsigned int                      degree,
+    const PolynomialCoarseningSequenceType &p_sequence);
+
+  /**
+   * Return the sequence of polynomial degrees of a p-multigrid hierarchy
+   * starting at @p max_degree on the finest level and ending at degree one
+   * on the coarsest level. The degrees are sorted from the coarsest level to
+   * the finest one, i.e., in the order of the levels of an MGLevelObject.
+   */
+  std::vector<unsigned int>
+  create_polynomial_coarsening_sequence(
+    const unsigned int                      max_degree,
+    const PolynomialCoarseningSequenceType &p_sequence);
+
+  /**
+   * Partition the active cells of the serial triangulation @p tria, which
+   * describes a coarse level of a global-coarsening multigrid hierarchy,
+   * onto a subset of the processes of @p communicator. The number of
+   * partitions is chosen such that each of them contains at least
+   * @p min_cells_per_process cells (or all cells, if there are fewer cells
+   * than that), but it does not exceed the number of processes. The
+   * partitions are created along a space-filling curve with
+   * GridTools::partition_triangulation_zorder() and are spread evenly over
+   * the ranks of @p communicator, such that the processes that own cells
+   * are likely placed on different compute nodes. The function returns the
+   * number of processes that own cells.
+   *
+   * The partitioned triangulation can be used to set up a
+   * parallel::fullydistributed::Triangulation for the coarse level via
+   * TriangulationDescription::Utilities::create_description_from_triangulation().
+   * Since MGTwoLevelTransfer::reinit_geometric_transfer() does not require a
+   * coarse cell to be owned by the same process as its children, the
+   * transfer then redistributes the data between the fine level and the
+   * agglomerated coarse level, and the operators, smoothers, and coarse
+   * solver of the coarse level only involve the processes that own cells.
+   * This avoids coarse levels with only a handful of cells per process, on
+   * which the cost would otherwise be dominated by the latency of the
+   * communication between all processes.
+   */
+  template <int dim, int spacedim>
+  unsigned int
+  partition_triangulation_onto_subset(
+    Triangulation<dim, spacedim> &tria,
+    const MPI_Comm                communicator,
+    const unsigned int            min_cells_per_process);
+
+  /**
+   * Set the active FE indices of the next coarser level of a p-multigrid
+   * hierarchy on hp-adaptive meshes. For each locally owned cell, the
+   * element on the same cell of @p dof_handler_coarse is chosen as the one
+   * in its FECollection whose degree is given by
+   * create_next_polynomial_coarsening_degree() applied to the degree of the
+   * element of @p dof_handler_fine on that cell.
+   *
+   * Both DoFHandler objects need to be defined on the same triangulation,
+   * and the FECollection of @p dof_handler_coarse needs to be set with
+   * hp::DoFHandler::set_fe() before and contain an element of each degree
+   * that is requested. The degrees of freedom of @p dof_handler_coarse need
+   * to be distributed afterwards. Applying this function repeatedly until
+   * all cells use linear elements gives the p-coarsening part of a hierarchy
+   * that can be continued by geometric coarsening.
+   */
+  template <int dim, int spacedim>
+  void
+  set_next_polynomial_coarsening_fe_indices(
+    const hp::DoFHandler<dim, spacedim> &   dof_handler_fine,
+    hp::DoFHandler<dim, spacedim> &         dof_handler_coarse,
+    const PolynomialCoarseningSequenceType &p_sequence);
+} // namespace MGTransferGlobalCoarseningTools
+
+
+
+/**
+ * Class for the transfer between two multigrid levels, where each level is
+ * described by a separate DoFHandler object. The two DoFHandler objects
+ * either live on two different triangulations, where the fine triangulation
+ * is obtained from the coarse one by refining some of its cells once
+ * (geometric or h-transfer, see reinit_geometric_transfer()), or on the same
+ * triangulation with finite elements of different polynomial degree
+ * (polynomial or p-transfer, see reinit_polynomial_transfer()). Chaining such
+ * two-level transfers by MGTransferGlobalCoarsening allows to set up
+ * global-coarsening hierarchies, where each level covers the whole
+ * computational domain and can be partitioned independently of the other
+ * levels, in contrast to the local smoothing approach of
+ * MGTransferMatrixFree that works on the level hierarchy of a single
+ * DoFHandler.
+ *
+ * Only the specialization for LinearAlgebra::distributed::Vector is
+ * implemented.
+ */
+template <int dim, typename VectorType>
+class MGTwoLevelTransfer;
+
+
+
+/**
+ * Two-level transfer for LinearAlgebra::distributed::Vector.
+ *
+ * The transfer works cell-wise on the locally owned cells of the fine
+ * DoFHandler. The coarse-cell values of the coarse cell covering a fine cell
+ * (either the cell itself or its parent) are interpolated into the fine cell
+ * by one-dimensional embedding matrices that are applied by sum
+ * factorization, using the kernels from tensor_product_kernels.h. The
+ * embedding matrices are computed by an $L^2$ projection of the 1D shape
+ * functions of the coarse element into the space of the 1D shape functions
+ * of the fine element, which is exact if the coarse space is contained in
+ * the fine one. Contributions to degrees of freedom shared between several
+ * fine cells are weighted by their valence, and constrained fine degrees of
+ * freedom are not touched by the prolongation. The restriction is the exact
+ * transpose of the prolongation. The constraints of the coarse level, e.g.
+ * due to hanging nodes, are resolved when reading and writing the
+ * coarse-cell values. Since the coarse cell of a fine cell is not
+ * necessarily available on the same process, the cell-wise data of the
+ * coarse level is exchanged during setup.
+ *
+ * The transfer is currently only implemented for finite elements derived
+ * from FE_Poly whose polynomial space is given by TensorProductPolynomials,
+ * like FE_Q and FE_DGQ, and for systems composed of several copies of such a
+ * scalar element.
+ *
+ * Both levels may also be described by hp::DoFHandler objects with a
+ * different element on each cell, e.g., for a p-multigrid hierarchy on an
+ * hp-adaptive mesh (see
+ * MGTransferGlobalCoarseningTools::set_next_polynomial_coarsening_fe_indices()).
+ * The 1D embedding matrices are then set up once for each combination of
+ * fine and coarse element that appears on the cells.
+ */
+template <int dim, typename Number>
+class MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  /**
+   * Set up the geometric transfer between @p dof_handler_coarse and
+   * @p dof_handler_fine. The triangulation of @p dof_handler_fine needs to
+   * be obtained from the triangulation of @p dof_handler_coarse by refining
+   * each cell at most once, i.e., each active fine cell is either an active
+   * coarse cell or a child of one. Both DoFHandler objects may use different
+   * elements (of the family supported by this class) with the same number of
+   * components.
+   *
+   * The constraints of each level, e.g. hanging-node constraints and
+   * homogeneous Dirichlet boundary conditions, describe the space on the
+   * respective level and need to contain the locally relevant degrees of
+   * freedom.
+   */
+  void
+  reinit_geometric_transfer(
+    const DoFHandler<dim> &          dof_handler_fine,
+    const DoFHandler<dim> &          dof_handler_coarse,
+    const AffineConstraints<Number> &constraint_fine =
+      AffineConstraints<Number>(),
+    const AffineConstraints<Number> &constraint_coarse =
+      AffineConstraints<Number>());
+
+  /**
+   * Same as above, for levels described by hp::DoFHandler objects.
+   */
+  void
+  reinit_geometric_transfer(
+    const hp::DoFHandler<dim> &      dof_handler_fine,
+    const hp::DoFHandler<dim> &      dof_handler_coarse,
+    const AffineConstraints<Number> &constraint_fine =
+      AffineConstraints<Number>(),
+    const AffineConstraints<Number> &constraint_coarse =
+      AffineConstraints<Number>());
+
+  /**
+   * Set up the polynomial transfer between @p dof_handler_coarse and
+   * @p dof_handler_fine, which need to be defined on the same triangulation
+   * (or on two triangulations with the same active cells) and typically use
+   * elements of different polynomial degree.
+   */
+  void
+  reinit_polynomial_transfer(
+    const DoFHandler<dim> &          dof_handler_fine,
+    const DoFHandler<dim> &          dof_handler_coarse,
+    const AffineConstraints<Number> &constraint_fine =
+      AffineConstraints<Number>(),
+    const AffineConstraints<Number> &constraint_coarse =
+      AffineConstraints<Number>());
+
+  /**
+   * Same as above, for levels described by hp::DoFHandler objects. The
+   * elements on a cell of the two levels may differ from cell to cell.
+   */
+  void
+  reinit_polynomial_transfer(
+    const hp::DoFHandler<dim> &      dof_handler_fine,
+    const hp::DoFHandler<dim> &      dof_handler_coarse,
+    const AffineConstraints<Number> &constraint_fine =
+      AffineConstraints<Number>(),
+    const AffineConstraints<Number> &constraint_coarse =
+      AffineConstraints<Number>());
+
+  /**
+   * Prolongate the coarse vector @p src and add the result to the fine
+   * vector @p dst. The vectors need to have the locally owned ranges of the
+   * DoFHandler objects passed to one of the reinit functions; the ghost
+   * layout does not matter.
+   */
+  void
+  prolongate_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                     const LinearAlgebra::distributed::Vector<Number> &src) const;
+
+  /**
+   * Restrict the fine vector @p src and add the result to the coarse vector
+   * @p dst. This is the transpose of prolongate_and_add().
+   */
+  void
+  restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                   const LinearAlgebra::distributed::Vector<Number> &src) const;
+
+  /**
+   * Return the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Common implementation of reinit_geometric_transfer() and
+   * reinit_polynomial_transfer() for DoFHandler and hp::DoFHandler.
+   */
+  template <typename DoFHandlerType>
+  void
+  reinit(const DoFHandlerType &           dof_handler_fine,
+         const DoFHandlerType &           dof_handler_coarse,
+         const AffineConstraints<Number> &constraint_fine,
+         const AffineConstraints<Number> &constraint_coarse,
+         const bool                       geometric_transfer);
+
+  /**
+   * The data of the transfer between one pair of fine and coarse elements.
+   */
+  struct TransferScheme
+  {
+    /**
+     * The number of 1D shape functions of the coarse element.
+     */
+    unsigned int n_coarse_dofs_1d;
+
+    /**
+     * The number of 1D shape functions of the fine element.
+     */
+    unsigned int n_fine_dofs_1d;
+
+    /**
+     * The 1D embedding matrices from the coarse into the fine element, with
+     * the coarse index running slowest. The first two entries describe the
+     * embedding into the left and right child of the unit interval, the
+     * last one the embedding into the unit interval itself, used for fine
+     * cells that coincide with their coarse cell.
+     */
+    std::array<AlignedVector<Number>, 3> prolongation_matrices_1d;
+  };
+
+  /**
+   * The number of components of the finite elements.
+   */
+  unsigned int n_components;
+
+  /**
+   * The transfer schemes for all combinations of fine and coarse elements
+   * that appear on the locally owned fine cells. Without hp, there is a
+   * single scheme.
+   */
+  std::vector<TransferScheme> schemes;
+
+  /**
+   * For each locally owned fine cell, the index of its entry in schemes.
+   */
+  std::vector<unsigned int> fine_cell_scheme;
+
+  /**
+   * For each locally owned fine cell, the child index within its coarse
+   * cell, or numbers::invalid_unsigned_int if the fine cell coincides with
+   * the coarse cell.
+   */
+  std::vector<unsigned int> fine_cell_child_index;
+
+  /**
+   * For each locally owned fine cell, the position of its first degree of
+   * freedom in fine_dof_indices and fine_dof_weights, with an additional
+   * last entry.
+   */
+  std::vector<unsigned int> fine_cell_dof_start;
+
+  /**
+   * For each locally owned fine cell, the position of the pointer of its
+   * first coarse degree of freedom in coarse_dof_ptrs.
+   */
+  std::vector<unsigned int> coarse_cell_ptr_start;
+
+  /**
+   * The indices of the degrees of freedom of the fine cells in lexicographic
+   * order and in the local numbering of partitioner_fine.
+   */
+  std::vector<unsigned int> fine_dof_indices;
+
+  /**
+   * The weights of the fine degrees of freedom, i.e., the inverse of their
+   * valence or zero for constrained degrees of freedom.
+   */
+  AlignedVector<Number> fine_dof_weights;
+
+  /**
+   * Pointers into coarse_dof_indices and coarse_dof_weights for each
+   * lexicographic degree of freedom of the coarse cell of each fine cell.
+   */
+  std::vector<unsigned int> coarse_dof_ptrs;
+
+  /**
+   * The indices of the unconstrained coarse degrees of freedom the
+   * coarse-cell values are composed of, in the local numbering of
+   * partitioner_coarse.
+   */
+  std::vector<unsigned int> coarse_dof_indices;
+
+  /**
+   * The weights of the constraints the coarse-cell values are composed of.
+   */
+  std::vector<Number> coarse_dof_weights;
+
+  /**
+   * Partitioner of the fine level including all ghost entries touched by the
+   * locally owned fine cells.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_fine;
+
+  /**
+   * Partitioner of the coarse level including all ghost entries touched by
+   * the coarse cells of the locally owned fine cells.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_coarse;
+
+  /**
+   * Internal vector with the ghost layout of partitioner_fine.
+   */
+  mutable LinearAlgebra::distributed::Vector<Number> vec_fine;
+
+  /**
+   * Internal vector with the ghost layout of partitioner_coarse.
+   */
+  mutable LinearAlgebra::distributed::Vector<Number> vec_coarse;
+
+  template <int, typename>
+  friend class MGTransferGlobalCoarsening;
+};
+
+
+
+/**
+ * Implementation of the MGTransferBase interface for global-coarsening
+ * multigrid hierarchies, where each level is described by a separate
+ * DoFHandler object and the transfer between two consecutive levels is
+ * performed by an MGTwoLevelTransfer object. The levels may be obtained by
+ * geometric coarsening, by reducing the polynomial degree, or by a
+ * combination of both.
+ *
+ * The finest level of the hierarchy is expected to be described by the
+ * DoFHandler passed to copy_to_mg() and copy_from_mg().
+ */
+template <int dim, typename VectorType>
+class MGTransferGlobalCoarsening : public MGTransferBase<VectorType>
+{
+public:
+  /**
+   * Constructor taking the two-level transfer objects, where
+   * <tt>transfer[l]</tt> describes the transfer between the levels
+   * <tt>l-1</tt> and <tt>l</tt>; the entry on the minimal level is not used.
+   * The optional function @p initialize_dof_vector is used to set up the
+   * level vectors in copy_to_mg(), e.g., with the partitioners of the level
+   * operators. If it is not given, the internal partitioners of the
+   * two-level transfers are used.
+   */
+  MGTransferGlobalCoarsening(
+    const MGLevelObject<MGTwoLevelTransfer<dim, VectorType>> &transfer,
+    const std::function<void(const unsigned int, VectorType &)>
+      &initialize_dof_vector = {});
+
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt>. The previous content of @p dst is overwritten.
+   */
+  void
+  prolongate(const unsigned int to_level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+  /**
+   * Restrict a vector from level <tt>from_level</tt> to level
+   * <tt>from_level-1</tt> and add the result to @p dst.
+   */
+  void
+  restrict_and_add(const unsigned int from_level,
+                   VectorType &       dst,
+                   const VectorType & src) const override;
+
+  /**
+   * Initialize the level vectors in @p dst and copy the fine-mesh vector
+   * @p src into the finest level.
+   */
+  template <class InVector, int spacedim>
+  void
+  copy_to_mg(const DoFHandler<dim, spacedim> &dof_handler,
+             MGLevelObject<VectorType> &      dst,
+             const InVector &                 src) const;
+
+  /**
+   * Copy the finest level of @p src into the fine-mesh vector @p dst.
+   */
+  template <class OutVector, int spacedim>
+  void
+  copy_from_mg(const DoFHandler<dim, spacedim> &dof_handler,
+               OutVector &                      dst,
+               const MGLevelObject<VectorType> &src) const;
+
+  /**
+   * Add the finest level of @p src to the fine-mesh vector @p dst.
+   */
+  template <class OutVector, int spacedim>
+  void
+  copy_from_mg_add(const DoFHandler<dim, spacedim> &dof_handler,
+                   OutVector &                      dst,
+                   const MGLevelObject<VectorType> &src) const;
+
+  /**
+   * Return the memory consumption of the two-level transfers in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The two-level transfer objects.
+   */
+  const MGLevelObject<MGTwoLevelTransfer<dim, VectorType>> &transfer;
+
+  /**
+   * Function for the initialization of the level vectors.
+   */
+  const std::function<void(const unsigned int, VectorType &)>
+    initialize_dof_vector;
+};
+
+
+
+/*@}*/
+
+
+
+#ifndef DOXYGEN
+
+/* ----------------------- Inline functions --------------------------------- */
+
+
+
+template <int dim, typename VectorType>
+MGTransferGlobalCoarsening<dim, VectorType>::MGTransferGlobalCoarsening(
+  const MGLevelObject<MGTwoLevelTransfer<dim, VectorType>> &transfer,
+  const std::function<void(const unsigned int, VectorType &)>
+    &initialize_dof_vector)
+  : transfer(transfer)
+  , initialize_dof_vector(initialize_dof_vector)
+{}
+
+
+
+template <int dim, typename VectorType>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::prolongate(
+  const unsigned int to_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  dst = 0;
+  transfer[to_level].prolongate_and_add(dst, src);
+}
+
+
+
+template <int dim, typename VectorType>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::restrict_and_add(
+  const unsigned int from_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  transfer[from_level].restrict_and_add(dst, src);
+}
+
+
+
+template <int dim, typename VectorType>
+template <class InVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::copy_to_mg(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  MGLevelObject<VectorType> &      dst,
+  const InVector &                 src) const
+{
+  (void)dof_handler;
+
+  const unsigned int min_level = dst.min_level();
+  const unsigned int max_level = dst.max_level();
+
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      if (initialize_dof_vector)
+        initialize_dof_vector(level, dst[level]);
+      else
+        {
+          Assert(max_level > min_level,
+                 ExcMessage("The partitioner of a hierarchy consisting of a "
+                            "single level cannot be deduced from the "
+                            "two-level transfers. Please pass a function for "
+                            "the initialization of the level vectors."));
+          if (level > min_level)
+            dst[level].reinit(transfer[level].partitioner_fine);
+          else
+            dst[level].reinit(transfer[level + 1].partitioner_coarse);
+        }
+      dst[level] = 0;
+    }
+
+  dst[max_level].copy_locally_owned_data_from(src);
+}
+
+
+
+template <int dim, typename VectorType>
+template <class OutVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::copy_from_mg(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  OutVector &                      dst,
+  const MGLevelObject<VectorType> &src) const
+{
+  (void)dof_handler;
+
+  dst.copy_locally_owned_data_from(src[src.max_level()]);
+}
+
+
+
+template <int dim, typename VectorType>
+template <class OutVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::copy_from_mg_add(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  OutVector &                      dst,
+  const MGLevelObject<VectorType> &src) const
+{
+  (void)dof_handler;
+
+  const VectorType &src_fine = src[src.max_level()];
+  AssertDimension(dst.local_size(), src_fine.local_size());
+  for (unsigned int i = 0; i < src_fine.local_size(); ++i)
+    dst.local_element(i) += src_fine.local_element(i);
+}
+
+
+
+template <int dim, typename VectorType>
+std::size_t
+MGTransferGlobalCoarsening<dim, VectorType>::memory_consumption() const
+{
+  std::size_t size = 0;
+
+  for (unsigned int l = transfer.min_level() + 1; l <= transfer.max_level();
+       ++l)
+    size += transfer[l].memory_consumption();
+
+  return size;
+}
+
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -49,6 +49,13 @@ DEAL_II_NAMESPACE_OPEN
  * FE_Q and FE_DGQ elements, including systems involving multiple components
  * of one of these elements. Systems with different elements or other elements
  * are currently not implemented.
+ *
+ * For systems such as FESystem(FE_Q<dim>(p), dim), all components of a cell
+ * are transferred together: the indices of the child cells and the weights
+ * are read once per cell, and the 1D interpolation matrices are applied to
+ * all components in the same pass over the cells. Vector-valued problems
+ * should therefore use this class on a single vector rather than splitting
+ * the components into the blocks of MGTransferBlockMatrixFree.
  */
 template <int dim, typename Number>
 class MGTransferMatrixFree
@@ -149,6 +156,20 @@ public:
     LinearAlgebra::distributed::Vector<Number> &      dst,
     const LinearAlgebra::distributed::Vector<Number> &src) const override;
 
+  /**
+   * Compute the residual <tt>rhs - matrix_times_u</tt> on level @p from_level,
+   * restrict it to level <tt>from_level-1</tt> and add it to @p dst. If
+   * @p matrix_times_u does not use the ghosted layout of the transfer, the
+   * residual is written directly into the internal ghosted vector, which
+   * avoids a separate pass for the subtraction.
+   */
+  virtual void
+  restrict_residual_and_add(
+    const unsigned int                                from_level,
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &rhs,
+    LinearAlgebra::distributed::Vector<Number> &matrix_times_u) const override;
+
   /**
    * Restrict fine-mesh field @p src to each multigrid level in @p dof_handler and
    * store the result in @p dst.
@@ -229,6 +250,15 @@ private:
    */
   std::vector<unsigned int> n_owned_level_cells;
 
+  /**
+   * For each level, the number of cells at the start of the list of locally
+   * owned cells for which both the parent and the child degrees of freedom
+   * are locally owned, rounded down to a multiple of the SIMD width. The
+   * transfer works on these cells while the ghost values of the source
+   * vector are still being exchanged.
+   */
+  std::vector<unsigned int> n_ghost_free_level_cells;
+
   /**
    * This variable holds the one-dimensional embedding (prolongation) matrix
    * from mother element to all the children.
@@ -270,23 +300,61 @@ private:
     vector_partitioners;
 
   /**
-   * Perform the prolongation operation.
+   * Reorder the locally owned cells on each level such that the cells whose
+   * transfer only involves locally owned degrees of freedom come first, and
+   * set n_ghost_free_level_cells accordingly.
+   */
+  void
+  sort_ghost_free_cells_first(
+    std::vector<std::vector<Number>> &weights_unvectorized);
+
+  /**
+   * Call do_prolongate_add() with the template argument matching fe_degree
+   * for the cells in the range [@p cell_begin, @p cell_end).
    */
-  template <int degree>
   void
-  do_prolongate_add(
+  prolongate_cell_range(
     const unsigned int                                to_level,
     LinearAlgebra::distributed::Vector<Number> &      dst,
-    const LinearAlgebra::distributed::Vector<Number> &src) const;
+    const LinearAlgebra::distributed::Vector<Number> &src,
+    const unsigned int                                cell_begin,
+    const unsigned int                                cell_end) const;
+
+  /**
+   * Call do_restrict_add() with the template argument matching fe_degree for
+   * the cells in the range [@p cell_begin, @p cell_end).
+   */
+  void
+  restrict_cell_range(
+    const unsigned int                                from_level,
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src,
+    const unsigned int                                cell_begin,
+    const unsigned int                                cell_end) const;
+
+  /**
+   * Perform the prolongation operation on the cells in the range
+   * [@p cell_begin, @p cell_end).
+   */
+  template <int degree>
+  void
+  do_prolongate_add(const unsigned int                                to_level,
+                    LinearAlgebra::distributed::Vector<Number> &      dst,
+                    const LinearAlgebra::distributed::Vector<Number> &src,
+                    const unsigned int cell_begin,
+                    const unsigned int cell_end) const;
 
   /**
-   * Performs the restriction operation.
+   * Performs the restriction operation on the cells in the range
+   * [@p cell_begin, @p cell_end).
    */
   template <int degree>
   void
   do_restrict_add(const unsigned int                                from_level,
                   LinearAlgebra::distributed::Vector<Number> &      dst,
-                  const LinearAlgebra::distributed::Vector<Number> &src) const;
+                  const LinearAlgebra::distributed::Vector<Number> &src,
+                  const unsigned int cell_begin,
+                  const unsigned int cell_end) const;
 };
 
 
@@ -301,7 +369,10 @@ private:
  * performs exactly the same transfer operations for each block as
  * MGTransferMatrixFree.
  * Both the cases that the same DoFHandler is used for all the blocks
- * and that each block uses its own DoFHandler are supported.
+ * and that each block uses its own DoFHandler are supported. Since each block
+ * is transferred separately, the blocks should represent different fields
+ * (like velocity and pressure); the components of a vector-valued element
+ * within one block are transferred together by MGTransferMatrixFree.
  */
 template <int dim, typename Number>
 class MGTransferBlockMatrixFree
@@ -406,6 +477,18 @@ public:
     LinearAlgebra::distributed::BlockVector<Number> &      dst,
     const LinearAlgebra::distributed::BlockVector<Number> &src) const override;
 
+  /**
+   * Same as MGTransferMatrixFree::restrict_residual_and_add(), applied to
+   * each block.
+   */
+  virtual void
+  restrict_residual_and_add(
+    const unsigned int                                     from_level,
+    LinearAlgebra::distributed::BlockVector<Number> &      dst,
+    const LinearAlgebra::distributed::BlockVector<Number> &rhs,
+    LinearAlgebra::distributed::BlockVector<Number> &matrix_times_u)
+    const override;
+
   /**
    * Transfer from a block-vector on the global grid to block-vectors defined
    * on each of the levels separately for active degrees of freedom.
@@ -32,6 +32,9 @@
 
 #include <deal.II/multigrid/mg_base.h>
 
+#include <array>
+#include <chrono>
+#include <ostream>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -82,6 +85,15 @@ namespace mg
     boost::signals2::signal<void(const bool before, const unsigned int level)>
       restriction;
 
+    /**
+     * This signal is triggered before (@p before is true) and after (@p before
+     * is false) the matrix-vector product on @p level that enters the
+     * residual restricted to the next coarser level, including the products
+     * with the edge matrices.
+     */
+    boost::signals2::signal<void(const bool before, const unsigned int level)>
+      residual;
+
     /**
      * This signal is triggered before (@p before is true) and after (@p before
      * is false) the call to MGTransfer::prolongate() which prolongs a vector to
@@ -145,7 +157,9 @@ public:
     /// The W-cycle
     w_cycle,
     /// The F-cycle
-    f_cycle
+    f_cycle,
+    /// The K-cycle, see the description of level_k_step()
+    k_cycle
   };
 
   using vector_type       = VectorType;
@@ -291,6 +305,13 @@ public:
   connect_prolongation(
     const std::function<void(const bool, const unsigned int)> &slot);
 
+  /**
+   * Connect a function to mg::Signals::residual.
+   */
+  boost::signals2::connection
+  connect_residual(
+    const std::function<void(const bool, const unsigned int)> &slot);
+
   /**
    * Connect a function to mg::Signals::pre_smoother_step.
    */
@@ -330,6 +351,27 @@ private:
   void
   level_step(const unsigned int level, Cycle cycle);
 
+  /**
+   * The coarse-grid correction of the K-cycle on <tt>level</tt>, used by
+   * level_step() in place of a single recursion when #cycle_type is
+   * k_cycle. Following Notay and Vassilevski, the correction is computed
+   * by up to two iterations of flexible conjugate gradients on
+   * <tt>level</tt> for the residual in #defect2, with a K-cycle on
+   * <tt>level</tt> as preconditioner. The second iteration is skipped if
+   * the first one already reduces the residual by a factor of four, so the
+   * cycle adapts between a V-cycle and a W-cycle depending on how well the
+   * coarser levels approximate the problem. This makes the method robust
+   * for anisotropic problems with few levels, at the cost of one or two
+   * additional matrix-vector products and a few inner products on each
+   * level.
+   *
+   * The K-cycle requires a symmetric positive definite level matrix and
+   * preconditioner, and is not implemented in combination with edge
+   * matrices.
+   */
+  void
+  level_k_step(const unsigned int level);
+
   /**
    * Cycle type performed by the method cycle().
    */
@@ -364,10 +406,19 @@ private:
   MGLevelObject<VectorType> t;
 
   /**
-   * Auxiliary vector for W- and F-cycles. Left uninitialized in V-cycle.
+   * Auxiliary vector for W-, F- and K-cycles. Left uninitialized in V-cycle.
    */
   MGLevelObject<VectorType> defect2;
 
+  /**
+   * Auxiliary vectors for the K-cycle, holding the residual, the first
+   * search direction and its product with the level matrix in
+   * level_k_step(). Left uninitialized in the other cycles.
+   */
+  MGLevelObject<VectorType> krylov_residual;
+  MGLevelObject<VectorType> krylov_direction;
+  MGLevelObject<VectorType> krylov_product;
+
 
   /**
    * The matrix for each level.
@@ -432,6 +483,153 @@ private:
 };
 
 
+namespace mg
+{
+  /**
+   * A class that accumulates the wall time spent in the stages of the cycles
+   * of a Multigrid object, separately for each level, by connecting to the
+   * signals described in mg::Signals. This gives a breakdown of where the
+   * time of a multigrid preconditioner goes without modifying the
+   * components of the method:
+   * @code
+   * Multigrid<VectorType> mg(matrix, coarse, transfer, smoother, smoother);
+   * mg::Timings           timings;
+   * timings.connect(mg);
+   *
+   * // ... solve with PreconditionMG based on mg ...
+   *
+   * timings.print(pcout.get_stream());
+   * @endcode
+   *
+   * The times are measured on the calling process only, so the time spent
+   * waiting for other processes in the communication of a stage is included
+   * in the time of that stage. Use a barrier before the measured solve and,
+   * if the distribution of the waiting times is of interest, compare the
+   * results of different processes, e.g., with Utilities::MPI::min_max_avg().
+   *
+   * The object must not be destroyed while the Multigrid object it is
+   * connected to performs a cycle. Upon destruction, its connections are
+   * released.
+   */
+  class Timings
+  {
+  public:
+    /**
+     * The stages of a multigrid cycle distinguished by this class.
+     */
+    enum Stage
+    {
+      /// The pre-smoothing, see mg::Signals::pre_smoother_step
+      pre_smoothing,
+      /// The matrix-vector product for the residual, see
+      /// mg::Signals::residual
+      residual,
+      /// The restriction of the residual, see mg::Signals::restriction
+      restriction,
+      /// The coarse-grid solver, see mg::Signals::coarse_solve
+      coarse_solve,
+      /// The prolongation of the correction, see mg::Signals::prolongation
+      prolongation,
+      /// The post-smoothing, see mg::Signals::post_smoother_step
+      post_smoothing,
+      /// The number of stages
+      n_stages
+    };
+
+    /**
+     * Default constructor.
+     */
+    Timings() = default;
+
+    /**
+     * The object holds connections that refer to it, so it cannot be copied.
+     */
+    Timings(const Timings &) = delete;
+
+    /**
+     * The object holds connections that refer to it, so it cannot be copied.
+     */
+    Timings &
+    operator=(const Timings &) = delete;
+
+    /**
+     * Destructor. Releases all connections.
+     */
+    ~Timings();
+
+    /**
+     * Start recording the stages of the cycles performed by @p mg. The
+     * function can be called for several Multigrid objects, whose times are
+     * then accumulated in the same entries.
+     */
+    template <typename VectorType>
+    void
+    connect(Multigrid<VectorType> &mg);
+
+    /**
+     * Release all connections established by connect(). The recorded times
+     * are kept.
+     */
+    void
+    disconnect();
+
+    /**
+     * Set all recorded times and counts to zero.
+     */
+    void
+    reset();
+
+    /**
+     * Return the accumulated wall time in seconds spent in @p stage on
+     * @p level.
+     */
+    double
+    get_time(const Stage stage, const unsigned int level) const;
+
+    /**
+     * Return how often @p stage has been performed on @p level.
+     */
+    unsigned int
+    get_n_calls(const Stage stage, const unsigned int level) const;
+
+    /**
+     * Print a table with the accumulated times of all stages on all levels
+     * and the sum over the levels to @p out.
+     */
+    void
+    print(std::ostream &out) const;
+
+  private:
+    /**
+     * The slot connected to all signals, starting (@p before is true) or
+     * stopping the measurement of @p stage on @p level.
+     */
+    void
+    record(const Stage stage, const bool before, const unsigned int level);
+
+    /**
+     * The data recorded for one stage on one level.
+     */
+    struct Entry
+    {
+      double                                time    = 0.;
+      unsigned int                          n_calls = 0;
+      std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * The recorded data, indexed by level and stage.
+     */
+    std::vector<std::array<Entry, n_stages>> entries;
+
+    /**
+     * The connections to the signals of the Multigrid objects.
+     */
+    std::vector<boost::signals2::connection> connections;
+  };
+} // namespace mg
+
+
 /**
  * Multi-level preconditioner. Here, we collect all information needed for
  * multi-level preconditioning and provide the standard interface for LAC
@@ -634,6 +832,26 @@ Multigrid<VectorType>::get_minlevel() const
 }
 
 
+
+template <typename VectorType>
+inline void
+mg::Timings::connect(Multigrid<VectorType> &mg)
+{
+  const auto slot = [this](const Stage stage) {
+    return [this, stage](const bool before, const unsigned int level) {
+      this->record(stage, before, level);
+    };
+  };
+
+  connections.push_back(mg.connect_pre_smoother_step(slot(pre_smoothing)));
+  connections.push_back(mg.connect_residual(slot(residual)));
+  connections.push_back(mg.connect_restriction(slot(restriction)));
+  connections.push_back(mg.connect_coarse_solve(slot(coarse_solve)));
+  connections.push_back(mg.connect_prolongation(slot(prolongation)));
+  connections.push_back(mg.connect_post_smoother_step(slot(post_smoothing)));
+}
+
+
 /* --------------------------- inline functions --------------------- */
 
 
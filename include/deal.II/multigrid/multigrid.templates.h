@@ -114,13 +114,14 @@ Multigrid<VectorType>::level_v_step(const unsigned int level)
   pre_smooth->apply(level, solution[level], defect[level]);
   this->signals.pre_smoother_step(false, level);
 
-  // compute residual on level, which includes the (CG) edge matrix
+  // compute the matrix-vector product on level, which includes the (CG)
+  // edge matrix. The residual is formed as part of the restriction below.
+  this->signals.residual(true, level);
   matrix->vmult(level, t[level], solution[level]);
   if (edge_out != nullptr)
     {
       edge_out->vmult_add(level, t[level], solution[level]);
     }
-  t[level].sadd(-1.0, 1.0, defect[level]);
 
   // Get the defect on the next coarser level as part of the (DG) edge matrix
   // and then the main part by the restriction of the transfer
@@ -129,9 +130,13 @@ Multigrid<VectorType>::level_v_step(const unsigned int level)
       edge_down->vmult(level, t[level - 1], solution[level]);
       defect[level - 1] -= t[level - 1];
     }
+  this->signals.residual(false, level);
 
   this->signals.restriction(true, level);
-  transfer->restrict_and_add(level, defect[level - 1], t[level]);
+  transfer->restrict_residual_and_add(level,
+                                      defect[level - 1],
+                                      defect[level],
+                                      t[level]);
   this->signals.restriction(false, level);
 
   // do recursion
@@ -186,11 +191,12 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
   pre_smooth->apply(level, solution[level], defect2[level]);
   this->signals.pre_smoother_step(false, level);
 
-  // compute residual on level, which includes the (CG) edge matrix
+  // compute the matrix-vector product on level, which includes the (CG)
+  // edge matrix. The residual is formed as part of the restriction below.
+  this->signals.residual(true, level);
   matrix->vmult(level, t[level], solution[level]);
   if (edge_out != nullptr)
     edge_out->vmult_add(level, t[level], solution[level]);
-  t[level].sadd(-1.0, 1.0, defect2[level]);
 
   // Get the defect on the next coarser level as part of the (DG) edge matrix
   // and then the main part by the restriction of the transfer
@@ -198,13 +204,22 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
     edge_down->vmult(level, defect2[level - 1], solution[level]);
   else
     defect2[level - 1] = typename VectorType::value_type(0.);
+  this->signals.residual(false, level);
 
   this->signals.restriction(true, level);
-  transfer->restrict_and_add(level, defect2[level - 1], t[level]);
+  transfer->restrict_residual_and_add(level,
+                                      defect2[level - 1],
+                                      defect2[level],
+                                      t[level]);
   this->signals.restriction(false, level);
 
-  // Every cycle starts with a recursion of its type.
-  level_step(level - 1, cycle);
+  // Every cycle starts with a recursion of its type, where the K-cycle
+  // accelerates the recursion by a Krylov method unless the next coarser
+  // level is the coarsest one
+  if (cycle == k_cycle && level - 1 > minlevel)
+    level_k_step(level - 1);
+  else
+    level_step(level - 1, cycle);
 
   // For W and F-cycle, repeat the process on the next coarser level except
   // for the coarse solver which we invoke just once
@@ -246,6 +261,65 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::level_k_step(const unsigned int level)
+{
+  Assert(level > minlevel, ExcInternalError());
+  Assert(edge_out == nullptr && edge_in == nullptr && edge_down == nullptr &&
+           edge_up == nullptr,
+         ExcMessage("The K-cycle is not implemented in combination with "
+                    "edge matrices."));
+
+  using number = typename VectorType::value_type;
+
+  // The right hand side of the inner iteration combines the defect from the
+  // initial copy_to_mg with the one that has come from the finer level
+  krylov_residual[level] = defect2[level];
+  krylov_residual[level] += defect[level];
+  const auto initial_norm = krylov_residual[level].l2_norm();
+
+  // First iteration, with the search direction given by a K-cycle on this
+  // level. The direction is left in the solution vector for the case that
+  // we stop after this iteration.
+  level_step(level, k_cycle);
+  krylov_direction[level] = solution[level];
+  matrix->vmult(level, krylov_product[level], krylov_direction[level]);
+  const number rho_1   = krylov_direction[level] * krylov_product[level];
+  const number alpha_1 = krylov_direction[level] * krylov_residual[level];
+  if (rho_1 == number())
+    return;
+
+  krylov_residual[level].add(-alpha_1 / rho_1, krylov_product[level]);
+  if (krylov_residual[level].l2_norm() <= 0.25 * initial_norm)
+    {
+      solution[level] *= alpha_1 / rho_1;
+      return;
+    }
+
+  // Second iteration, applying the K-cycle on the updated residual and
+  // orthogonalizing the new search direction against the first one
+  defect2[level] = krylov_residual[level];
+  level_step(level, k_cycle);
+  matrix->vmult(level, t[level], solution[level]);
+  const number gamma   = solution[level] * krylov_product[level];
+  const number beta    = solution[level] * t[level];
+  const number alpha_2 = solution[level] * krylov_residual[level];
+  const number rho_2   = beta - gamma * gamma / rho_1;
+  if (rho_2 == number())
+    {
+      solution[level] = krylov_direction[level];
+      solution[level] *= alpha_1 / rho_1;
+      return;
+    }
+
+  solution[level].sadd(alpha_2 / rho_2,
+                       alpha_1 / rho_1 - gamma * alpha_2 / (rho_1 * rho_2),
+                       krylov_direction[level]);
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::cycle()
@@ -256,6 +330,12 @@ Multigrid<VectorType>::cycle()
   t.resize(minlevel, maxlevel);
   if (cycle_type != v_cycle)
     defect2.resize(minlevel, maxlevel);
+  if (cycle_type == k_cycle)
+    {
+      krylov_residual.resize(minlevel, maxlevel);
+      krylov_direction.resize(minlevel, maxlevel);
+      krylov_product.resize(minlevel, maxlevel);
+    }
 
   for (unsigned int level = minlevel; level <= maxlevel; ++level)
     {
@@ -265,6 +345,12 @@ Multigrid<VectorType>::cycle()
       t[level].reinit(defect[level], level > minlevel);
       if (cycle_type != v_cycle)
         defect2[level].reinit(defect[level]);
+      if (cycle_type == k_cycle)
+        {
+          krylov_residual[level].reinit(defect[level], true);
+          krylov_direction[level].reinit(defect[level], true);
+          krylov_product[level].reinit(defect[level], true);
+        }
     }
 
   if (cycle_type == v_cycle)
@@ -324,6 +410,16 @@ Multigrid<VectorType>::connect_prolongation(
 
 
 
+template <typename VectorType>
+boost::signals2::connection
+Multigrid<VectorType>::connect_residual(
+  const std::function<void(const bool, const unsigned int)> &slot)
+{
+  return this->signals.residual.connect(slot);
+}
+
+
+
 template <typename VectorType>
 boost::signals2::connection
 Multigrid<VectorType>::connect_pre_smoother_step(
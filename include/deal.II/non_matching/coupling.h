@@ -170,6 +170,13 @@ namespace NonMatching
    * For both spaces, it is possible to specify a custom Mapping, which
    * defaults to StaticMappingQ1 for both.
    *
+   * The contributions of the cells of the immersed triangulation are computed
+   * in parallel using multiple threads (see WorkStream). If the shape
+   * functions of the space finite element are primitive and H1-conforming,
+   * as for FE_Q, they are evaluated directly at the reference points of all
+   * the quadrature points an immersed cell has in a background cell, instead
+   * of setting up an FEValues object for each such pair of cells.
+   *
    * This function will also work in parallel, provided that the immersed
    * triangulation is of type parallel::shared::Triangulation<dim1,spacedim>.
    * An exception is thrown if you use an immersed
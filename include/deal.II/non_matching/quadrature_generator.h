@@ -0,0 +1,336 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_non_matching_quadrature_generator_h
+#define dealii_non_matching_quadrature_generator_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/non_matching/immersed_surface_quadrature.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  /**
+   * Struct storing settings for the QuadratureGenerator class.
+   */
+  struct AdditionalQGeneratorData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalQGeneratorData(const unsigned int max_box_splits         = 4,
+                             const unsigned int n_root_search_intervals = 16,
+                             const double       root_tolerance          = 1e-12,
+                             const double       min_height_gradient_ratio =
+                               0.1);
+
+    /**
+     * The number of times a box may be split into its children, if the
+     * level set function is not a graph over a face of the box.
+     */
+    unsigned int max_box_splits;
+
+    /**
+     * The number of intervals in which a line through the box is sampled
+     * to bracket the roots of the level set function along the line.
+     */
+    unsigned int n_root_search_intervals;
+
+    /**
+     * The tolerance, relative to the length of the line, to which the roots
+     * along a line are computed.
+     */
+    double root_tolerance;
+
+    /**
+     * The level set function $\psi$ is considered a graph over the face of a
+     * box orthogonal to the direction $k$ if the partial derivative
+     * $\partial_k \psi$ has the same sign at all sample points and its
+     * modulus is at least this fraction of the largest $|\nabla \psi|$. If
+     * this is not the case for any direction, the box is split.
+     */
+    double min_height_gradient_ratio;
+  };
+
+
+
+  /**
+   * This class creates quadrature rules over the regions of a box where a
+   * level set function $\psi$ is negative (the inside region), where it is
+   * positive (the outside region), and over the zero contour of $\psi$ (the
+   * surface region):
+   * @f[
+   * \{x \in B : \psi(x) < 0 \}, \quad
+   * \{x \in B : \psi(x) > 0 \}, \quad
+   * \{x \in B : \psi(x) = 0 \}.
+   * @f]
+   *
+   * The rules are created dimension by dimension, in the spirit of
+   * R. Saye, High-Order Quadrature Methods for Implicitly Defined Surfaces and
+   * Volumes in Hyperrectangles, SIAM J. Sci. Comput., 37(2), 2015: if $\psi$
+   * is monotone in a direction $k$ over the box, the box is integrated with
+   * a tensor product of the one-dimensional rule passed to the constructor
+   * over the face orthogonal to $k$ and of the same rule over the segments of
+   * each line in direction $k$ that are bounded by the roots of $\psi$ on the
+   * line. The surface points are the roots, with the weights scaled by
+   * $|\nabla \psi| / |\partial_k \psi|$. The face is in turn integrated by
+   * the same algorithm for the restrictions of $\psi$ to the lower and upper
+   * wall of the box in direction $k$, so that the number of roots on the
+   * lines does not change within each of the pieces of the face the rule is
+   * built on. If $\psi$ is not monotone in any
+   * direction, or if it is not clear whether the box is cut at all, the box
+   * is split into its children, up to AdditionalQGeneratorData::max_box_splits
+   * times. Whether $\psi$ has a definite sign over a box or is monotone is
+   * decided from its values and gradients at a grid of sample points, so
+   * that features much smaller than a box can be missed.
+   *
+   * The rules have the order of the one-dimensional rule where $\psi$ is
+   * smooth and the zero contour is a graph over a face of each box that is
+   * not split further.
+   */
+  template <int dim>
+  class QuadratureGenerator
+  {
+  public:
+    using AdditionalData = AdditionalQGeneratorData;
+
+    /**
+     * Constructor. The one-dimensional quadrature @p quadrature1D is used as
+     * the building block of all the rules, and should usually be a Gauss
+     * rule.
+     */
+    QuadratureGenerator(const Quadrature<1> & quadrature1D,
+                        const AdditionalData &additional_data =
+                          AdditionalData());
+
+    /**
+     * Construct the quadrature rules for the level set function @p level_set
+     * over the box @p box. The rules can be accessed with the functions
+     * get_inside_quadrature(), get_outside_quadrature(), and
+     * get_surface_quadrature() until the next call of this function.
+     */
+    void
+    generate(const Function<dim> &level_set, const BoundingBox<dim> &box);
+
+    /**
+     * Return the quadrature rule for the region where the level set function
+     * is negative.
+     */
+    const Quadrature<dim> &
+    get_inside_quadrature() const;
+
+    /**
+     * Return the quadrature rule for the region where the level set function
+     * is positive.
+     */
+    const Quadrature<dim> &
+    get_outside_quadrature() const;
+
+    /**
+     * Return the quadrature rule for the zero contour of the level set
+     * function. The normals point in the direction of the gradient of the
+     * level set function, i.e., out of the inside region.
+     */
+    const ImmersedSurfaceQuadrature<dim> &
+    get_surface_quadrature() const;
+
+  private:
+    /**
+     * The one-dimensional quadrature used as building block.
+     */
+    const Quadrature<1> quadrature1D;
+
+    /**
+     * The settings of the algorithm.
+     */
+    const AdditionalData additional_data;
+
+    /**
+     * The points and weights of the inside region, collected while the
+     * boxes are processed.
+     */
+    std::vector<Point<dim>> inside_points;
+    std::vector<double>     inside_weights;
+
+    /**
+     * The points and weights of the outside region, collected while the
+     * boxes are processed.
+     */
+    std::vector<Point<dim>> outside_points;
+    std::vector<double>     outside_weights;
+
+    /**
+     * The rule for the inside region.
+     */
+    Quadrature<dim> inside_quadrature;
+
+    /**
+     * The rule for the outside region.
+     */
+    Quadrature<dim> outside_quadrature;
+
+    /**
+     * The rule for the zero contour.
+     */
+    ImmersedSurfaceQuadrature<dim> surface_quadrature;
+  };
+
+
+
+  /**
+   * This class creates the quadrature rules of QuadratureGenerator on the
+   * unit cell of all cells of a triangulation, for a level set function
+   * that is given by a finite element field on a DoFHandler with a scalar
+   * finite element. The rules are with respect to the reference cell, i.e.,
+   * they can be used to set up FEValues objects on the respective cell.
+   *
+   * The rules of all locally owned cells are created by reinit(), using
+   * multiple threads. The rules of a cell are kept as long as the values of
+   * the level set function on that cell do not change, so that only the cells
+   * near a moving interface are processed again when reinit() is called with
+   * the level set of the next time step.
+   */
+  template <int dim>
+  class DiscreteQuadratureGenerator
+  {
+  public:
+    using AdditionalData = AdditionalQGeneratorData;
+
+    /**
+     * Constructor. @p dof_handler must use a scalar finite element, and needs
+     * to outlive this object.
+     */
+    DiscreteQuadratureGenerator(const Quadrature<1> &   quadrature1D,
+                                const DoFHandler<dim> &dof_handler,
+                                const AdditionalData & additional_data =
+                                  AdditionalData());
+
+    /**
+     * Create the rules of all locally owned cells for the level set function
+     * given by @p level_set, which must include the ghost entries of the
+     * locally owned cells in parallel. Cells whose level set values equal
+     * the ones of the previous call keep their rules. Returns the number of
+     * cells for which the rules have been created again.
+     */
+    template <typename VectorType>
+    unsigned int
+    reinit(const VectorType &level_set);
+
+    /**
+     * Remove all cached rules, e.g., after the triangulation has been
+     * refined.
+     */
+    void
+    clear();
+
+    /**
+     * Return the rule for the region of @p cell where the level set function
+     * is negative. If the cell is not cut and lies in that region, the rule is
+     * the tensor product of the one-dimensional rule.
+     */
+    const Quadrature<dim> &
+    get_inside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the rule for the region of @p cell where the level set function
+     * is positive.
+     */
+    const Quadrature<dim> &
+    get_outside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the rule for the zero contour of the level set function in
+     * @p cell.
+     */
+    const ImmersedSurfaceQuadrature<dim> &
+    get_surface_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+  private:
+    /**
+     * The cached data of a cell.
+     */
+    struct CellData
+    {
+      /**
+       * The level set values the rules were created for.
+       */
+      Vector<double> level_set_values;
+
+      /**
+       * The rule for the inside region.
+       */
+      Quadrature<dim> inside_quadrature;
+
+      /**
+       * The rule for the outside region.
+       */
+      Quadrature<dim> outside_quadrature;
+
+      /**
+       * The rule for the zero contour.
+       */
+      ImmersedSurfaceQuadrature<dim> surface_quadrature;
+    };
+
+    /**
+     * Create the rules of the cells <tt>cells[begin,end)</tt> whose level
+     * set values, given in the corresponding entries of @p level_set_values,
+     * differ from the cached ones, and return the number of these cells.
+     */
+    unsigned int
+    generate_on_cells(
+      const std::vector<typename DoFHandler<dim>::active_cell_iterator> &cells,
+      const std::vector<Vector<double>> &level_set_values,
+      const std::size_t                  begin,
+      const std::size_t                  end);
+
+    /**
+     * The one-dimensional quadrature used as building block.
+     */
+    const Quadrature<1> quadrature1D;
+
+    /**
+     * The settings of the algorithm.
+     */
+    const AdditionalData additional_data;
+
+    /**
+     * The DoFHandler of the level set function.
+     */
+    SmartPointer<const DoFHandler<dim>> dof_handler;
+
+    /**
+     * The cached data, indexed by the active cell index.
+     */
+    std::vector<CellData> cell_data;
+  };
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
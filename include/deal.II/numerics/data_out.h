@@ -98,6 +98,12 @@ namespace internal
  * the same data in more than one format without having to rebuild the
  * patches.
  *
+ * The patches are kept when build_patches() is called again, e.g. after the
+ * solution vectors attached to this object have changed in the next time
+ * step. Each patch is then overwritten in place, so the memory for its data
+ * fields is only allocated again if the number of patches, subdivisions, or
+ * output variables has changed.
+ *
  *
  * <h3>User interface information</h3>
  *
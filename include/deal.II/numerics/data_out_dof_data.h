@@ -434,8 +434,11 @@ namespace internal
 
       DataPostprocessorInputs::Scalar<spacedim>        patch_values_scalar;
       DataPostprocessorInputs::Vector<spacedim>        patch_values_system;
+      DataPostprocessorInputs::VectorBatch<spacedim>   patch_values_batch;
       std::vector<std::vector<dealii::Vector<double>>> postprocessed_values;
 
+      Table<2, double> postprocessed_values_batch;
+
       const dealii::hp::MappingCollection<dim, spacedim> mapping_collection;
       const std::vector<
         std::shared_ptr<dealii::hp::FECollection<dim, spacedim>>>
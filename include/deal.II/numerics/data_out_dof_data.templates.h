@@ -156,7 +156,9 @@ namespace internal
       , n_subdivisions(data.n_subdivisions)
       , patch_values_scalar(data.patch_values_scalar)
       , patch_values_system(data.patch_values_system)
+      , patch_values_batch(data.patch_values_batch)
       , postprocessed_values(data.postprocessed_values)
+      , postprocessed_values_batch(data.postprocessed_values_batch)
       , mapping_collection(data.mapping_collection)
       , finite_elements(data.finite_elements)
       , update_flags(data.update_flags)
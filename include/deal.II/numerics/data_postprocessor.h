@@ -22,6 +22,7 @@
 
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/fe/fe_update_flags.h>
@@ -361,6 +362,74 @@ namespace DataPostprocessorInputs
     std::vector<std::vector<Tensor<2, spacedim>>> solution_hessians;
   };
 
+
+
+  /**
+   * A structure that is used to pass information to
+   * DataPostprocessor::evaluate_vector_field_batch(). It contains the same
+   * information as the Vector class, but stores it by component rather than
+   * by evaluation point: the values of one solution component, or of one
+   * derivative of one component, at all evaluation points of a cell are
+   * stored in consecutive memory locations. A postprocessor can then loop
+   * over the evaluation points in its innermost loop, which the compiler is
+   * able to vectorize, and the results can be written into the graphical
+   * output without going through one Vector object per point.
+   *
+   * The rules for how components are arranged for complex-valued solutions
+   * are the same as for the Vector class: all real parts come first,
+   * followed by all imaginary parts.
+   *
+   * Through the fields in the CommonInputs base class, this class also
+   * makes available access to the locations of evaluations points,
+   * normal vectors (if appropriate), and which cell data is currently
+   * being evaluated on (also if appropriate).
+   */
+  template <int spacedim>
+  struct VectorBatch : public CommonInputs<spacedim>
+  {
+    /**
+     * The values of the solution, indexed as <tt>(component, point)</tt>.
+     *
+     * This table is only filled if DataPostprocessor::get_needed_update_flags()
+     * returns (possibly among other flags) UpdateFlags::update_values.
+     */
+    Table<2, double> solution_values;
+
+    /**
+     * The gradients of the solution, indexed as <tt>(component, direction,
+     * point)</tt>.
+     *
+     * This table is only filled if DataPostprocessor::get_needed_update_flags()
+     * returns (possibly among other flags) UpdateFlags::update_gradients.
+     */
+    Table<3, double> solution_gradients;
+
+    /**
+     * The second derivatives of the solution, indexed as <tt>(component,
+     * direction, direction, point)</tt>.
+     *
+     * This table is only filled if DataPostprocessor::get_needed_update_flags()
+     * returns (possibly among other flags) UpdateFlags::update_hessians.
+     */
+    Table<4, double> solution_hessians;
+
+    /**
+     * Fill the current object with the data of @p inputs, which stores the
+     * same information by evaluation point. Only those fields are copied that
+     * are selected by @p update_flags; the data of the CommonInputs base
+     * class is always copied.
+     */
+    void
+    copy_from(const Vector<spacedim> &inputs, const UpdateFlags update_flags);
+
+    /**
+     * Same as above, but for the data of a scalar field, which is then
+     * represented by a single component.
+     */
+    void
+    copy_from(const Scalar<spacedim> &inputs, const UpdateFlags update_flags);
+  };
+
 } // namespace DataPostprocessorInputs
 
 
@@ -539,6 +608,36 @@ public:
   evaluate_vector_field(const DataPostprocessorInputs::Vector<dim> &input_data,
                         std::vector<Vector<double>> &computed_quantities) const;
 
+  /**
+   * Same as the evaluate_vector_field() function, but the input data is
+   * stored by component rather than by evaluation point, see
+   * DataPostprocessorInputs::VectorBatch, and the output is written into
+   * the table @p computed_quantities, indexed as <tt>(output quantity,
+   * point)</tt>. The table already has the correct size when this function
+   * is called.
+   *
+   * DataOut calls this function instead of evaluate_scalar_field() and
+   * evaluate_vector_field() if provides_batch_evaluation() returns true;
+   * a scalar, real-valued field is then passed as a field with a single
+   * component. In this case, derived classes
+   * need not implement evaluate_scalar_field() or evaluate_vector_field():
+   * the default implementations of these functions convert their arguments
+   * and call the current function, so that such a postprocessor also works
+   * with DataOutFaces and other classes that only know the point-wise
+   * interface.
+   */
+  virtual void
+  evaluate_vector_field_batch(
+    const DataPostprocessorInputs::VectorBatch<dim> &input_data,
+    Table<2, double> &                               computed_quantities) const;
+
+  /**
+   * Return whether a derived class implements evaluate_vector_field_batch().
+   * The default implementation returns false.
+   */
+  virtual bool
+  provides_batch_evaluation() const;
+
   /**
    * Return the vector of strings describing the names of the computed
    * quantities.
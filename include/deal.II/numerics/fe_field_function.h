@@ -255,6 +255,13 @@ namespace Functions
      * lie on the same cell. If this is not the case, things may slow down a
      * bit.
      *
+     * The points are first sorted into the cells they lie in. If the finite
+     * element is derived from FE_Poly (or is a system of such elements), the
+     * shape function values do not depend on the mapping and all points of a
+     * cell are evaluated together on the reference cell, with the cells
+     * worked on in parallel. Otherwise, an FEValues object is set up for
+     * each cell.
+     *
      * @note When using this function on a
      * parallel::distributed::Triangulation you may get an exception when
      * trying to evaluate the solution at a point that lies on an artificial
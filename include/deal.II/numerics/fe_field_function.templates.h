@@ -20,8 +20,11 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_system.h>
 #include <deal.II/fe/fe_values.h>
 
 #include <deal.II/grid/grid_tools.h>
@@ -41,6 +44,113 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace FEFieldFunctionImplementation
+  {
+    /**
+     * Return whether the values of the shape functions of the given element
+     * can be computed on the reference cell alone, i.e., without any
+     * information from the mapping, and are primitive. This is the case for
+     * all elements derived from FE_Poly (the usual Lagrange-type elements)
+     * and systems composed of those.
+     */
+    template <int dim, int spacedim>
+    bool
+    has_mapping_independent_values(const FiniteElement<dim, spacedim> &fe)
+    {
+      if (dynamic_cast<const FE_Poly<dim, spacedim> *>(&fe) != nullptr)
+        return true;
+
+      if (const auto *fe_system =
+            dynamic_cast<const FESystem<dim, spacedim> *>(&fe))
+        {
+          for (unsigned int b = 0; b < fe_system->n_base_elements(); ++b)
+            if (!has_mapping_independent_values(fe_system->base_element(b)))
+              return false;
+          return true;
+        }
+
+      // elements without degrees of freedom, such as FE_Nothing, are
+      // trivially fine
+      return fe.dofs_per_cell == 0;
+    }
+
+
+
+    /**
+     * Same as above, but for all elements of a collection.
+     */
+    template <int dim, int spacedim>
+    bool
+    has_mapping_independent_values(
+      const dealii::hp::FECollection<dim, spacedim> &fe_collection)
+    {
+      for (unsigned int i = 0; i < fe_collection.size(); ++i)
+        if (!has_mapping_independent_values(fe_collection[i]))
+          return false;
+      return true;
+    }
+
+
+
+    /**
+     * Evaluate the finite element field described by @p data_vector at the
+     * reference points @p qpoints, grouped by the cells in @p cells, as
+     * computed by GridTools::compute_point_locations(). The local degrees of
+     * freedom are read only once per cell and all points of a cell are
+     * evaluated together; the cells are worked on in parallel. For every
+     * point, @p write_point_values is called with the index of the point in
+     * the original list (as given by @p maps) and the values of all
+     * components there.
+     *
+     * This function requires has_mapping_independent_values() to be true
+     * for the finite elements in use.
+     */
+    template <int dim,
+              typename CellIteratorType,
+              typename VectorType,
+              typename PointValueWriter>
+    void
+    evaluate_values_by_cell(
+      const std::vector<CellIteratorType> &         cells,
+      const std::vector<std::vector<Point<dim>>> &  qpoints,
+      const std::vector<std::vector<unsigned int>> &maps,
+      const VectorType &                            data_vector,
+      const unsigned int                            n_components,
+      const PointValueWriter &                      write_point_values)
+    {
+      using number = typename VectorType::value_type;
+
+      parallel::apply_to_subranges(
+        0u,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          Vector<number> local_dof_values;
+          Vector<number> point_values(n_components);
+          for (unsigned int c = begin; c < end; ++c)
+            {
+              const auto &fe = cells[c]->get_fe();
+              local_dof_values.reinit(fe.dofs_per_cell);
+              cells[c]->get_dof_values(data_vector, local_dof_values);
+
+              for (unsigned int q = 0; q < qpoints[c].size(); ++q)
+                {
+                  point_values = number();
+                  for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                    point_values(fe.system_to_component_index(i).first) +=
+                      local_dof_values(i) * fe.shape_value(i, qpoints[c][q]);
+                  write_point_values(maps[c][q], point_values);
+                }
+            }
+        },
+        16);
+    }
+  } // namespace FEFieldFunctionImplementation
+} // namespace internal
+
+
+
 namespace Functions
 {
   template <int dim, typename DoFHandlerType, typename VectorType>
@@ -276,6 +386,29 @@ namespace Functions
     const unsigned int n_cells =
       compute_point_locations(points, cells, qpoints, maps);
 
+    // If the shape function values do not depend on the mapping, there is
+    // no need to set up an FEValues object for each of the cells: evaluate
+    // the field directly on the reference cell, cell by cell
+    if (internal::FEFieldFunctionImplementation::has_mapping_independent_values(
+          dh->get_fe_collection()))
+      {
+        for (unsigned int i = 0; i < n_cells; ++i)
+          AssertThrow(!cells[i]->is_artificial(),
+                      VectorTools::ExcPointNotAvailableHere());
+
+        internal::FEFieldFunctionImplementation::evaluate_values_by_cell(
+          cells,
+          qpoints,
+          maps,
+          data_vector,
+          this->n_components,
+          [&](const unsigned int                             point,
+              const Vector<typename VectorType::value_type> &point_values) {
+            values[point] = point_values;
+          });
+        return;
+      }
+
     // Create quadrature collection
     hp::QCollection<dim> quadrature_collection;
     for (unsigned int i = 0; i < n_cells; ++i)
@@ -323,7 +456,33 @@ namespace Functions
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
 
-    // Simply forward everything to the vector_value_list()
+    if (internal::FEFieldFunctionImplementation::has_mapping_independent_values(
+          dh->get_fe_collection()))
+      {
+        std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+        std::vector<std::vector<Point<dim>>>                       qpoints;
+        std::vector<std::vector<unsigned int>>                     maps;
+
+        const unsigned int n_cells =
+          compute_point_locations(points, cells, qpoints, maps);
+        for (unsigned int i = 0; i < n_cells; ++i)
+          AssertThrow(!cells[i]->is_artificial(),
+                      VectorTools::ExcPointNotAvailableHere());
+
+        internal::FEFieldFunctionImplementation::evaluate_values_by_cell(
+          cells,
+          qpoints,
+          maps,
+          data_vector,
+          this->n_components,
+          [&](const unsigned int                             point,
+              const Vector<typename VectorType::value_type> &point_values) {
+            values[point] = point_values(component);
+          });
+        return;
+      }
+
+    // Otherwise simply forward everything to the vector_value_list()
     // function. This requires a temporary object, but everything we
     // do here is so expensive that that really doesn't make any
     // difference any more.
@@ -36,6 +36,7 @@
 
 #include <deal.II/grid/grid_tools.h>
 
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/vector.h>
 
 #include <deal.II/numerics/data_postprocessor.h>
@@ -68,6 +69,19 @@ namespace internal
       Point<dim>                           requested_location;
       std::vector<Point<dim>>              support_point_locations;
       std::vector<types::global_dof_index> solution_indices;
+
+      /**
+       * The degrees of freedom of the cell containing the requested location,
+       * and the values of all components of the shape functions of that cell
+       * at the requested location, stored as a matrix of size
+       * <tt>n_components x dofs_per_cell</tt>. These are computed the first
+       * time the field is evaluated at the requested location and then
+       * reused until the triangulation changes, so that each evaluation only
+       * needs to do a small matrix-vector product. An empty matrix indicates
+       * that the data has not been computed yet.
+       */
+      std::vector<types::global_dof_index> requested_location_dof_indices;
+      FullMatrix<double>                   requested_location_shape_values;
     };
   } // namespace PointValueHistoryImplementation
 } // namespace internal
@@ -381,7 +395,13 @@ public:
    * evaluate_field methods this method does not care if the dof_handler has
    * been modified because it uses calls to @p VectorTools::point_value to
    * extract there data. Therefore, if only this method is used, the class is
-   * fully compatible with adaptive refinement. The component_mask supplied
+   * fully compatible with adaptive refinement. The cell containing each point
+   * and the values of its shape functions there are only computed the first
+   * time this function is called after the class was closed or the
+   * triangulation changed; later calls simply combine the entries of @p
+   * solution with these values. (Consequently, if the degrees of freedom are
+   * renumbered without a change to the mesh, the cached data is invalid.)
+   * The component_mask supplied
    * when the field was added is used to select components to extract. If a @p
    * DoFHandler is used, one (and only one) evaluate_field method must be
    * called for each dataset (time step, iteration, etc) for each vector_name,
@@ -0,0 +1,379 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_tools_evaluation_h
+#define dealii_vector_tools_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace VectorTools
+{
+  /**
+   * @name Evaluation of functions and errors
+   */
+  //@{
+
+  /**
+   * Given a (distributed) solution vector @p vector, evaluate the values of
+   * the (finite element) function defined by the solution vector and the
+   * DoFHandler @p dof_handler at the (arbitrary and even remote) points
+   * @p evaluation_points, which may differ on each process.
+   *
+   * The search for the cells containing the points and the set up of the
+   * communication pattern is done by the Utilities::MPI::RemotePointEvaluation
+   * object @p cache, which is (re-)initialized by this function. Subsequent
+   * calls of the variant of this function taking the @p cache as first
+   * argument can reuse it as long as the triangulation and the points do not
+   * change, e.g., to evaluate several vectors or the same vector in several
+   * time steps.
+   *
+   * If a point is found on several cells, e.g. because it lies on a face
+   * shared by cells of different processes, the average of the values is
+   * returned. Points that could not be found in the mesh get a zero value,
+   * see Utilities::MPI::RemotePointEvaluation::all_points_found().
+   *
+   * @note The vector @p vector needs to provide access to the values of all
+   * degrees of freedom on the locally owned cells. For distributed vectors,
+   * this function imports the ghost values if the vector is not in ghosted
+   * state yet and resets them afterwards.
+   */
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  std::vector<typename FEPointEvaluation<n_components,
+                                         dim,
+                                         spacedim,
+                                         typename VectorType::value_type>::
+                value_type>
+  point_values(
+    const Mapping<dim, spacedim> &                        mapping,
+    const DoFHandler<dim, spacedim> &                     dof_handler,
+    const VectorType &                                    vector,
+    const std::vector<Point<spacedim>> &                  evaluation_points,
+    Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache);
+
+  /**
+   * Same as above, but for a Utilities::MPI::RemotePointEvaluation object
+   * that has already been set up for the points of interest.
+   */
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  std::vector<typename FEPointEvaluation<n_components,
+                                         dim,
+                                         spacedim,
+                                         typename VectorType::value_type>::
+                value_type>
+  point_values(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector);
+
+  /**
+   * Given a (distributed) solution vector @p vector, evaluate the gradients
+   * of the (finite element) function defined by the solution vector and the
+   * DoFHandler @p dof_handler at the (arbitrary and even remote) points
+   * @p evaluation_points. See point_values() for the details.
+   */
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  std::vector<typename FEPointEvaluation<n_components,
+                                         dim,
+                                         spacedim,
+                                         typename VectorType::value_type>::
+                gradient_type>
+  point_gradients(
+    const Mapping<dim, spacedim> &                        mapping,
+    const DoFHandler<dim, spacedim> &                     dof_handler,
+    const VectorType &                                    vector,
+    const std::vector<Point<spacedim>> &                  evaluation_points,
+    Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache);
+
+  /**
+   * Same as above, but for a Utilities::MPI::RemotePointEvaluation object
+   * that has already been set up for the points of interest.
+   */
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  std::vector<typename FEPointEvaluation<n_components,
+                                         dim,
+                                         spacedim,
+                                         typename VectorType::value_type>::
+                gradient_type>
+  point_gradients(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector);
+
+  //@}
+
+
+
+#ifndef DOXYGEN
+  namespace internal
+  {
+    /**
+     * Reset the ghost values of vectors that support it, i.e., the
+     * parallel vectors of deal.II. For other vector types, this is a no-op.
+     */
+    template <typename VectorType>
+    inline auto
+    zero_out_ghosts_if_supported(const VectorType &vector, int)
+      -> decltype(vector.zero_out_ghosts())
+    {
+      vector.zero_out_ghosts();
+    }
+
+    template <typename VectorType>
+    inline void
+    zero_out_ghosts_if_supported(const VectorType &, long)
+    {}
+
+
+
+    /**
+     * Copy the value computed by @p evaluator at the point @p q into
+     * @p result.
+     */
+    template <int n_components, int dim, int spacedim, typename Number>
+    inline void
+    store_point_result(
+      const FEPointEvaluation<n_components, dim, spacedim, Number> &evaluator,
+      const unsigned int                                            q,
+      typename FEPointEvaluation<n_components, dim, spacedim, Number>::
+        value_type &result)
+    {
+      result = evaluator.get_value(q);
+    }
+
+
+
+    /**
+     * Copy the gradient computed by @p evaluator at the point @p q into
+     * @p result.
+     */
+    template <int n_components, int dim, int spacedim, typename Number>
+    inline void
+    store_point_result(
+      const FEPointEvaluation<n_components, dim, spacedim, Number> &evaluator,
+      const unsigned int                                            q,
+      typename FEPointEvaluation<n_components, dim, spacedim, Number>::
+        gradient_type &result)
+    {
+      result = evaluator.get_gradient(q);
+    }
+
+
+
+    /**
+     * Evaluate the values or gradients of the finite element function at
+     * the points set up in @p cache, and average the results of points
+     * found at more than one location.
+     */
+    template <int n_components,
+              int dim,
+              int spacedim,
+              typename VectorType,
+              typename value_type>
+    inline std::vector<value_type>
+    evaluate_at_points(
+      const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache,
+      const DoFHandler<dim, spacedim> &                           dof_handler,
+      const VectorType &                                          vector,
+      const EvaluationFlags::EvaluationFlags                      flags)
+    {
+      using Number = typename VectorType::value_type;
+
+      Assert(cache.is_ready(),
+             ExcMessage(
+               "Utilities::MPI::RemotePointEvaluation is not ready yet! "
+               "Please call Utilities::MPI::RemotePointEvaluation::reinit() "
+               "yourself or another function that does this for you."));
+      Assert(&dof_handler.get_triangulation() == &cache.get_triangulation(),
+             ExcMessage(
+               "The provided Utilities::MPI::RemotePointEvaluation and "
+               "DoFHandler object have been set up with different "
+               "Triangulation objects, a scenario not supported!"));
+
+      // make sure the values on ghosted cells are available
+      const bool has_ghost_elements = vector.has_ghost_elements();
+      if (has_ghost_elements == false)
+        vector.update_ghost_values();
+
+      const UpdateFlags update_flags =
+        (flags & EvaluationFlags::gradients) ? update_gradients :
+                                               update_values;
+      FEPointEvaluation<n_components, dim, spacedim, Number> evaluator(
+        cache.get_mapping(), dof_handler.get_fe(), update_flags);
+      std::vector<Number> solution_values;
+
+      const auto evaluation_function =
+        [&](const ArrayView<value_type> &values,
+            const typename Utilities::MPI::RemotePointEvaluation<dim, spacedim>::
+              CellData &cell_data) {
+          for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
+            {
+              typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+                &cache.get_triangulation(),
+                cell_data.cells[i].first,
+                cell_data.cells[i].second,
+                &dof_handler);
+
+              const unsigned int begin = cell_data.reference_point_ptrs[i];
+              const unsigned int n_points =
+                cell_data.reference_point_ptrs[i + 1] - begin;
+              const ArrayView<const Point<dim>> unit_points(
+                cell_data.reference_point_values.data() + begin, n_points);
+
+              solution_values.resize(cell->get_fe().dofs_per_cell);
+              cell->get_dof_values(vector,
+                                   solution_values.begin(),
+                                   solution_values.end());
+
+              evaluator.reinit(cell, unit_points);
+              evaluator.evaluate(make_array_view(solution_values), flags);
+
+              for (unsigned int q = 0; q < n_points; ++q)
+                store_point_result(evaluator, q, values[begin + q]);
+            }
+        };
+
+      std::vector<value_type> evaluation_values, buffer;
+      cache.template evaluate_and_process<value_type>(evaluation_values,
+                                                      buffer,
+                                                      evaluation_function);
+
+      if (has_ghost_elements == false)
+        zero_out_ghosts_if_supported(vector, 0);
+
+      if (cache.is_map_unique())
+        return evaluation_values;
+
+      // average the results of points found on several cells
+      const std::vector<unsigned int> &point_ptrs = cache.get_point_ptrs();
+      std::vector<value_type>          result(point_ptrs.size() - 1);
+      for (unsigned int i = 0; i + 1 < point_ptrs.size(); ++i)
+        {
+          const unsigned int n_entries = point_ptrs[i + 1] - point_ptrs[i];
+          if (n_entries == 0)
+            continue;
+
+          result[i] = evaluation_values[point_ptrs[i]];
+          for (unsigned int j = point_ptrs[i] + 1; j < point_ptrs[i + 1]; ++j)
+            result[i] += evaluation_values[j];
+          result[i] *= Number(1.) / static_cast<Number>(n_entries);
+        }
+      return result;
+    }
+  } // namespace internal
+
+
+
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  inline std::vector<typename FEPointEvaluation<n_components,
+                                                dim,
+                                                spacedim,
+                                                typename VectorType::value_type>::
+                       value_type>
+  point_values(
+    const Mapping<dim, spacedim> &                        mapping,
+    const DoFHandler<dim, spacedim> &                     dof_handler,
+    const VectorType &                                    vector,
+    const std::vector<Point<spacedim>> &                  evaluation_points,
+    Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache)
+  {
+    cache.reinit(evaluation_points, dof_handler.get_triangulation(), mapping);
+
+    return point_values<n_components>(cache, dof_handler, vector);
+  }
+
+
+
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  inline std::vector<typename FEPointEvaluation<n_components,
+                                                dim,
+                                                spacedim,
+                                                typename VectorType::value_type>::
+                       value_type>
+  point_values(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector)
+  {
+    using value_type = typename FEPointEvaluation<
+      n_components,
+      dim,
+      spacedim,
+      typename VectorType::value_type>::value_type;
+
+    return internal::
+      evaluate_at_points<n_components, dim, spacedim, VectorType, value_type>(
+        cache, dof_handler, vector, EvaluationFlags::values);
+  }
+
+
+
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  inline std::vector<typename FEPointEvaluation<n_components,
+                                                dim,
+                                                spacedim,
+                                                typename VectorType::value_type>::
+                       gradient_type>
+  point_gradients(
+    const Mapping<dim, spacedim> &                        mapping,
+    const DoFHandler<dim, spacedim> &                     dof_handler,
+    const VectorType &                                    vector,
+    const std::vector<Point<spacedim>> &                  evaluation_points,
+    Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache)
+  {
+    cache.reinit(evaluation_points, dof_handler.get_triangulation(), mapping);
+
+    return point_gradients<n_components>(cache, dof_handler, vector);
+  }
+
+
+
+  template <int n_components, int dim, int spacedim, typename VectorType>
+  inline std::vector<typename FEPointEvaluation<n_components,
+                                                dim,
+                                                spacedim,
+                                                typename VectorType::value_type>::
+                       gradient_type>
+  point_gradients(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector)
+  {
+    using gradient_type = typename FEPointEvaluation<
+      n_components,
+      dim,
+      spacedim,
+      typename VectorType::value_type>::gradient_type;
+
+    return internal::
+      evaluate_at_points<n_components, dim, spacedim, VectorType, gradient_type>(
+        cache, dof_handler, vector, EvaluationFlags::gradients);
+  }
+#endif
+} // namespace VectorTools
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // dealii_vector_tools_evaluation_h
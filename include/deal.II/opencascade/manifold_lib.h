@@ -21,6 +21,8 @@
 
 #ifdef DEAL_II_WITH_OPENCASCADE
 
+#  include <deal.II/base/thread_local_storage.h>
+
 #  include <deal.II/grid/manifold.h>
 
 #  include <deal.II/opencascade/utilities.h>
@@ -30,10 +32,43 @@
 #  include <Adaptor3d_Curve.hxx>
 #  include <Adaptor3d_HCurve.hxx>
 #  include <BRepAdaptor_Curve.hxx>
+#  include <Geom_Surface.hxx>
+#  include <ShapeAnalysis_Surface.hxx>
 #  undef HAVE_CONFIG_H
 
+#  include <unordered_map>
+
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace OpenCASCADE
+  {
+    /**
+     * Hash function for the points in the projection caches of the
+     * OpenCASCADE manifolds.
+     */
+    template <int spacedim>
+    struct PointHash
+    {
+      std::size_t
+      operator()(const Point<spacedim> &p) const
+      {
+        std::size_t seed = 0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            // Make sure that 0.0 and -0.0, which compare equal, also have
+            // the same hash
+            const double x = (p(d) == 0. ? 0. : p(d));
+            seed ^= std::hash<double>()(x) + 0x9e3779b9 + (seed << 6) +
+                    (seed >> 2);
+          }
+        return seed;
+      }
+    };
+  } // namespace OpenCASCADE
+} // namespace internal
+
 /**
  * @addtogroup OpenCASCADE
  * @{
@@ -59,6 +94,15 @@ namespace OpenCASCADE
    * TopoDS_Edge when projecting on a face. In this case, the vertices of the
    * face would be collapsed to the edge, and your surrounding points would
    * not be lying on the given shape, raising an exception.
+   *
+   * The projection onto the faces of the shape re-uses the OpenCASCADE
+   * projection objects of each face between calls, and remembers the face
+   * and the UV coordinates of all points it has computed before. Since the
+   * new points of one refinement level are the surrounding points of the
+   * next level, the projection of a new point usually starts from the UV
+   * coordinates of one of its surrounding points on the same face. These
+   * caches are kept separately for each thread, so that the projections of
+   * the points in get_new_points() are computed in parallel.
    */
   template <int dim, int spacedim>
   class NormalProjectionManifold : public FlatManifold<dim, spacedim>
@@ -94,6 +138,17 @@ namespace OpenCASCADE
       const ArrayView<const Point<spacedim>> &surrounding_points,
       const Point<spacedim> &                 candidate) const override;
 
+    /**
+     * Compute the weighted averages of the @p surrounding_points as
+     * FlatManifold does and project them onto the shape. The projections of
+     * the different new points are independent of each other and are
+     * computed in parallel.
+     */
+    virtual void
+    get_new_points(const ArrayView<const Point<spacedim>> &surrounding_points,
+                   const Table<2, double> &                weights,
+                   ArrayView<Point<spacedim>> new_points) const override;
+
 
   protected:
     /**
@@ -108,6 +163,49 @@ namespace OpenCASCADE
      * Relative tolerance used by this class to compute distances.
      */
     const double tolerance;
+
+  private:
+    /**
+     * Return the point on the faces of the shape closest to @p candidate.
+     * This computes the same point as OpenCASCADE::closest_point(), but
+     * uses the cached projection objects and, if available, the cached UV
+     * coordinates of one of the @p surrounding_points as initial guess.
+     */
+    Point<spacedim>
+    closest_point_on_faces(
+      const ArrayView<const Point<spacedim>> &surrounding_points,
+      const Point<spacedim> &                 candidate) const;
+
+    /**
+     * The surfaces of all faces of the shape.
+     */
+    std::vector<Handle(Geom_Surface)> surfaces;
+
+    /**
+     * The data that each thread keeps for the projections.
+     */
+    struct ProjectionCache
+    {
+      /**
+       * A projection object for each of the surfaces. These objects set up
+       * some internal data on their first use and are not thread-safe.
+       */
+      std::vector<Handle(ShapeAnalysis_Surface)> projectors;
+
+      /**
+       * The index of the face and the UV coordinates of points that have
+       * been computed before.
+       */
+      std::unordered_map<Point<spacedim>,
+                         std::pair<unsigned int, Point<2>>,
+                         internal::OpenCASCADE::PointHash<spacedim>>
+        uv_coordinates;
+    };
+
+    /**
+     * The projection objects and cached UV coordinates of each thread.
+     */
+    mutable Threads::ThreadLocalStorage<ProjectionCache> projection_cache;
   };
 
   /**
@@ -284,6 +382,12 @@ namespace OpenCASCADE
    * surrounding points actually live on the Manifold, i.e., calling
    * OpenCASCADE::closest_point() on those points leaves them untouched. If
    * this is not the case, an ExcPointNotOnManifold is thrown.
+   *
+   * The class remembers the arclength of all points it has pushed forward or
+   * pulled back. Since these points become the surrounding points of later
+   * calls to get_new_point(), their pull-back then does not need to project
+   * onto the curve and integrate its length again. The cache is kept
+   * separately for each thread.
    */
   template <int dim, int spacedim>
   class ArclengthProjectionLineManifold : public ChartManifold<dim, spacedim, 1>
@@ -337,6 +441,17 @@ namespace OpenCASCADE
      * edge is periodic.
      */
     const double length;
+
+  private:
+    /**
+     * The arclength of the points that have been pushed forward or pulled
+     * back before, for each thread.
+     */
+    mutable Threads::ThreadLocalStorage<
+      std::unordered_map<Point<spacedim>,
+                         double,
+                         internal::OpenCASCADE::PointHash<spacedim>>>
+      arclength_cache;
   };
 
   /**
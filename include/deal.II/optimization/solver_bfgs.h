@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/table.h>
+
 #include <deal.II/lac/solver.h>
 
 #include <deal.II/numerics/history.h>
@@ -51,6 +53,34 @@ DEAL_II_NAMESPACE_OPEN
  * @f}
  * for a symmetric positive definite $H$. Limited memory variant is
  * implemented via the two-loop recursion.
+ *
+ * The two-loop recursion computes one inner product with each vector of
+ * the history after the other, i.e., $2m$ global reductions for a history
+ * of size $m$. For large parallel computations, e.g., with gradients
+ * computed by matrix-free operators on LinearAlgebra::distributed::Vector,
+ * the latency of these reductions can dominate. Therefore, the solver can
+ * alternatively use the compact representation of the limited memory
+ * matrix due to Byrd, Nocedal, and Schnabel (1994),
+ * @f{align*}{
+ * H g = g + \left[S \quad Y
+ight]
+ * egin{bmatrix}
+ * R^{-T}(D + Y^T Y) R^{-1} & -R^{-T} \\ -R^{-1} & 0
+ * \end{bmatrix}
+ * egin{bmatrix} S^T g \\ Y^T g \end{bmatrix},
+ * @f}
+ * where the columns of $S$ and $Y$ are the vectors $s$ and $y$ of the
+ * history, $R$ is the upper triangular part of $S^T Y$, and $D$ its
+ * diagonal. The small matrices $R$ and $Y^T Y$ are updated with the inner
+ * products of the newest vector $y$, and all products $S^T g$, $Y^T g$
+ * as well as the norm of the gradient and the products needed for the next
+ * update are computed with one batched reduction each, see
+ * AdditionalData::compact_representation. For vector types with a
+ * multi_dot() function, like LinearAlgebra::distributed::Vector, this
+ * reduces the number of global reductions per iteration from $2m+2$ to
+ * two, in addition to those of the line search. The default line search
+ * furthermore obtains the initial slope from these products instead of a
+ * separate reduction.
  */
 template <typename VectorType>
 class SolverBFGS : public SolverBase<VectorType>
@@ -70,8 +100,9 @@ public:
     /**
      * Constructor.
      */
-    explicit AdditionalData(const unsigned int max_history_size = 5,
-                            const bool         debug_output     = false);
+    explicit AdditionalData(const unsigned int max_history_size       = 5,
+                            const bool         debug_output           = false,
+                            const bool         compact_representation = false);
 
     /**
      * Maximum history size.
@@ -82,6 +113,16 @@ public:
      * Print extra debug output to deallog.
      */
     bool debug_output;
+
+    /**
+     * Use the compact representation of the limited memory matrix instead
+     * of the two-loop recursion, see the general documentation of this
+     * class. The iterates are mathematically the same but affected
+     * differently by round-off. The compact representation relies on the
+     * identity as initial matrix and is therefore only used if no slot is
+     * connected with connect_preconditioner_slot().
+     */
+    bool compact_representation;
   };
 
 
@@ -185,9 +226,11 @@ protected:
 template <typename VectorType>
 SolverBFGS<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_history_size_,
-  const bool         debug_output_)
+  const bool         debug_output_,
+  const bool         compact_representation_)
   : max_history_size(max_history_size_)
   , debug_output(debug_output_)
+  , compact_representation(compact_representation_)
 {}
 
 
@@ -242,9 +285,16 @@ SolverBFGS<VectorType>::solve(
   // https://sourceforge.net/p/octave/optim/ci/default/tree/src/__bfgsmin.cc
   LogStream::Prefix prefix("BFGS");
 
+  const bool compact =
+    additional_data.compact_representation && preconditioner_signal.empty();
+
   // default line search:
   bool   first_step = true;
   Number f_prev     = 0.;
+  // slope g*p of the current search direction if known from the batched
+  // inner products of the compact representation
+  bool   slope_is_known = false;
+  Number slope          = 0.;
   // provide default line search if no signal was attached
   VectorType x0;
   if (line_search_signal.empty())
@@ -253,7 +303,7 @@ SolverBFGS<VectorType>::solve(
       const auto default_line_min =
         [&](Number &f, VectorType &x, VectorType &g, const VectorType &p) {
           const Number f0 = f;
-          const Number g0 = g * p;
+          const Number g0 = slope_is_known ? slope : g * p;
           Assert(g0 < 0,
                  ExcMessage(
                    "Function does not decrease along the current direction"));
@@ -313,6 +363,17 @@ SolverBFGS<VectorType>::solve(
   std::vector<Number> c1;
   c1.reserve(additional_data.max_history_size);
 
+  // data of the compact representation, all indexed like the history with
+  // index zero for the newest entry: the inner products s_i*y_j and
+  // y_i*y_j, the products S^T g and Y^T g with the current gradient, and
+  // the coefficients of the search direction in terms of s_i and y_i
+  const unsigned int              max_m = additional_data.max_history_size;
+  Table<2, Number>                S_Y(compact ? max_m : 0, compact ? max_m : 0);
+  Table<2, Number>                Y_Y(compact ? max_m : 0, compact ? max_m : 0);
+  std::vector<Number>             S_g, Y_g, a, q;
+  std::vector<const VectorType *> dot_vectors;
+  std::vector<Number>             dot_results;
+
   // limited history
   FiniteSizeHistory<VectorType> y(additional_data.max_history_size);
   FiniteSizeHistory<VectorType> s(additional_data.max_history_size);
@@ -326,7 +387,9 @@ SolverBFGS<VectorType>::solve(
 
   f = compute(x, g);
 
-  conv = this->iteration_status(k, g.l2_norm(), x);
+  Number g_g = compact ? g * g : 0.;
+
+  conv = this->iteration_status(k, compact ? std::sqrt(g_g) : g.l2_norm(), x);
   if (conv != SolverControl::iterate)
     return;
 
@@ -336,27 +399,67 @@ SolverBFGS<VectorType>::solve(
         deallog << "Iteration " << k << " history " << m << std::endl
                 << "f=" << f << std::endl;
 
-      // 1. Two loop recursion to calculate p = - H*g
-      c1.resize(m);
-      p = g;
-      // first loop:
-      for (unsigned int i = 0; i < m; ++i)
+      if (compact)
         {
-          c1[i] = rho[i] * (s[i] * p);
-          p.add(-c1[i], y[i]);
+          // 1. Compact representation to calculate p = - H*g. In terms of
+          // the chronological ordering of the history, solve R q = S^T g
+          // and R^T a = (D + Y^T Y) q - Y^T g, which gives
+          // H*g = g + S a - Y q. With index zero for the newest entry, R
+          // is lower triangular with the entries S_Y(i,j) for i >= j.
+          a.resize(m);
+          q.resize(m);
+          for (unsigned int i = 0; i < m; ++i)
+            {
+              Number sum = S_g[i];
+              for (unsigned int j = 0; j < i; ++j)
+                sum -= S_Y(i, j) * q[j];
+              q[i] = sum / S_Y(i, i);
+            }
+          for (int j = m - 1; j >= 0; --j)
+            {
+              Number sum = S_Y(j, j) * q[j] - Y_g[j];
+              for (unsigned int i = 0; i < m; ++i)
+                sum += Y_Y(j, i) * q[i];
+              for (unsigned int i = j + 1; i < m; ++i)
+                sum -= S_Y(i, j) * a[i];
+              a[j] = sum / S_Y(j, j);
+            }
+
+          p = g;
+          for (unsigned int i = 0; i < m; ++i)
+            p.add(a[i], s[i], -q[i], y[i]);
+          p *= -1.;
+
+          // the slope along p follows from the same products
+          slope = -g_g;
+          for (unsigned int i = 0; i < m; ++i)
+            slope += q[i] * Y_g[i] - a[i] * S_g[i];
+          slope_is_known = true;
         }
-      // H0
-      if (!preconditioner_signal.empty())
-        preconditioner_signal(p, s, y);
-
-      // second loop:
-      for (int i = m - 1; i >= 0; --i)
+      else
         {
-          Assert(i >= 0, ExcInternalError());
-          const Number c2 = rho[i] * (y[i] * p);
-          p.add(c1[i] - c2, s[i]);
+          // 1. Two loop recursion to calculate p = - H*g
+          c1.resize(m);
+          p = g;
+          // first loop:
+          for (unsigned int i = 0; i < m; ++i)
+            {
+              c1[i] = rho[i] * (s[i] * p);
+              p.add(-c1[i], y[i]);
+            }
+          // H0
+          if (!preconditioner_signal.empty())
+            preconditioner_signal(p, s, y);
+
+          // second loop:
+          for (int i = m - 1; i >= 0; --i)
+            {
+              Assert(i >= 0, ExcInternalError());
+              const Number c2 = rho[i] * (y[i] * p);
+              p.add(c1[i] - c2, s[i]);
+            }
+          p *= -1.;
         }
-      p *= -1.;
 
       // 2. Line search
       s_k                = x;
@@ -365,19 +468,94 @@ SolverBFGS<VectorType>::solve(
                              .get(); // <-- signals return boost::optional
       s_k.sadd(-1, 1, x);
       y_k.sadd(-1, 1, g);
+      slope_is_known = false;
 
       if (additional_data.debug_output)
         deallog << "Line search a=" << alpha << " f=" << f << std::endl;
 
+      // in the compact representation, compute the products of the new
+      // gradient with all vectors of the history, with the new vectors s_k
+      // and y_k, and with itself in a single batched reduction
+      if (compact)
+        {
+          dot_vectors.clear();
+          for (unsigned int i = 0; i < m; ++i)
+            dot_vectors.push_back(&s[i]);
+          for (unsigned int i = 0; i < m; ++i)
+            dot_vectors.push_back(&y[i]);
+          dot_vectors.push_back(&s_k);
+          dot_vectors.push_back(&y_k);
+          dot_vectors.push_back(&g);
+          dot_results.resize(dot_vectors.size());
+          internal::SolverImplementation::dot_products(
+            g,
+            ArrayView<const VectorType *const>(dot_vectors.data(),
+                                               dot_vectors.size()),
+            make_array_view(dot_results));
+          g_g = dot_results[2 * m + 2];
+        }
+
       // 3. Check convergence
       k++;
-      const Number g_l2 = g.l2_norm();
+      const Number g_l2 = compact ? std::sqrt(g_g) : g.l2_norm();
       conv              = this->iteration_status(k, g_l2, x);
       if (conv != SolverControl::iterate)
         break;
 
-      // 4. Store s, y, rho
-      const Number curvature = s_k * y_k;
+      // 4. Store s, y, rho. For the compact representation, the products of
+      // y_k with the history and with s_k and y_k again use one reduction
+      Number curvature;
+      if (compact)
+        {
+          dot_vectors.pop_back();
+          std::vector<Number> y_k_products(dot_vectors.size());
+          internal::SolverImplementation::dot_products(
+            y_k,
+            ArrayView<const VectorType *const>(dot_vectors.data(),
+                                               dot_vectors.size()),
+            make_array_view(y_k_products));
+          curvature = y_k_products[2 * m];
+
+          if (curvature > 0. && max_m > 0)
+            {
+              // shift the entries to make room for the new pair at index
+              // zero, dropping the oldest pair if the history is full
+              const unsigned int new_m = std::min(m + 1, max_m);
+              for (int i = new_m - 1; i > 0; --i)
+                for (int j = new_m - 1; j > 0; --j)
+                  {
+                    S_Y(i, j) = S_Y(i - 1, j - 1);
+                    Y_Y(i, j) = Y_Y(i - 1, j - 1);
+                  }
+              // s_i*y_k and y_i*y_k for the old pairs; the products s_k*y_i
+              // are not needed since they are not part of R
+              for (unsigned int i = 1; i < new_m; ++i)
+                {
+                  S_Y(i, 0) = y_k_products[i - 1];
+                  Y_Y(i, 0) = Y_Y(0, i) = y_k_products[m + i - 1];
+                }
+              S_Y(0, 0) = curvature;
+              Y_Y(0, 0) = y_k_products[2 * m + 1];
+
+              S_g.insert(S_g.begin(), dot_results[2 * m]);
+              Y_g.insert(Y_g.begin(), dot_results[2 * m + 1]);
+              for (unsigned int i = 0; i < m; ++i)
+                {
+                  S_g[i + 1] = dot_results[i];
+                  Y_g[i + 1] = dot_results[m + i];
+                }
+              S_g.resize(new_m);
+              Y_g.resize(new_m);
+            }
+          else
+            {
+              S_g.assign(dot_results.begin(), dot_results.begin() + m);
+              Y_g.assign(dot_results.begin() + m, dot_results.begin() + 2 * m);
+            }
+        }
+      else
+        curvature = s_k * y_k;
+
       if (additional_data.debug_output)
         deallog << "Curvature " << curvature << std::endl;
 
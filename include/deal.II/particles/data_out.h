@@ -77,6 +77,47 @@ namespace Particles
                     DataComponentInterpretation::DataComponentInterpretation>
                     &data_component_interpretations = {});
 
+    /**
+     * Write the locations, IDs, and properties of the locally owned particles
+     * of @p particles to @p out as a cloud of points in the vtu format. In
+     * contrast to build_patches() followed by DataOutInterface::write_vtu(),
+     * this function does not create a patch for each particle, but copies
+     * the data directly from the particle handler into one array per data
+     * set, see DataOutBase::write_vtu_point_cloud(). This substantially
+     * reduces the memory needed to write large numbers of particles.
+     *
+     * The arguments @p data_component_names and
+     * @p data_component_interpretations have the same meaning as for
+     * build_patches(). The @p flags control the output, e.g., the zlib
+     * compression level used for the binary output.
+     */
+    void
+    write_vtu_point_cloud(
+      const Particles::ParticleHandler<dim, spacedim> &particles,
+      std::ostream &                                   out,
+      const std::vector<std::string> &data_component_names = {},
+      const std::vector<
+        DataComponentInterpretation::DataComponentInterpretation>
+        &                          data_component_interpretations = {},
+      const DataOutBase::VtkFlags &flags = DataOutBase::VtkFlags());
+
+    /**
+     * Collective version of write_vtu_point_cloud() that writes the locally
+     * owned particles of all processes in @p comm into the single file
+     * @p filename with MPI-IO, see
+     * DataOutBase::write_vtu_point_cloud_in_parallel().
+     */
+    void
+    write_vtu_point_cloud_in_parallel(
+      const Particles::ParticleHandler<dim, spacedim> &particles,
+      const std::string &                              filename,
+      const MPI_Comm &                                 comm,
+      const std::vector<std::string> &data_component_names = {},
+      const std::vector<
+        DataComponentInterpretation::DataComponentInterpretation>
+        &                          data_component_interpretations = {},
+      const DataOutBase::VtkFlags &flags = DataOutBase::VtkFlags());
+
   protected:
     /**
      * Returns the patches built by the data_out class which was previously
@@ -107,6 +148,30 @@ namespace Particles
     get_nonscalar_data_ranges() const override;
 
   private:
+    /**
+     * Check the names and interpretations of the particle properties given
+     * to build_patches() or write_vtu_point_cloud(), and store them along
+     * with the particle ID in the member variables below.
+     */
+    void
+    set_data_components(
+      const Particles::ParticleHandler<dim, spacedim> &particles,
+      const std::vector<std::string> &                 data_component_names,
+      const std::vector<
+        DataComponentInterpretation::DataComponentInterpretation>
+        &data_component_interpretations);
+
+    /**
+     * Copy the locations of the locally owned particles into @p points, and
+     * their IDs and the properties described by the data components set
+     * in set_data_components() into the rows of @p data.
+     */
+    void
+    collect_point_cloud(
+      const Particles::ParticleHandler<dim, spacedim> &particles,
+      std::vector<Point<spacedim>> &                   points,
+      Table<2, double> &                               data) const;
+
     /**
      * This is a vector of patches that is created each time build_patches() is
      * called. These patches are used in the output routines of the base
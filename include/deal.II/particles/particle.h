@@ -84,6 +84,9 @@ namespace types
  */
 namespace Particles
 {
+  template <int dim, int spacedim>
+  class ParticleHandler;
+
   namespace internal
   {
     /**
@@ -393,6 +396,13 @@ namespace Particles
      * A handle to all particle properties
      */
     PropertyPool::Handle properties;
+
+    /**
+     * Make ParticleHandler a friend, so that it can reassign the handles of
+     * the particles it stores when reordering their properties in memory.
+     */
+    template <int, int>
+    friend class ParticleHandler;
   };
 
   /* ---------------------- inline and template functions ------------------ */
@@ -24,6 +24,9 @@
 
 #include <deal.II/particles/particle.h>
 
+#include <utility>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
@@ -36,6 +39,22 @@ namespace Particles
   class ParticleHandler;
 #endif
 
+  namespace internal
+  {
+    /**
+     * The type of container in which a ParticleHandler stores its
+     * particles: a contiguous array of pairs of the level and index of the
+     * cell a particle is in and the particle itself. The array is kept
+     * sorted by cell, so that all particles of a cell are stored next to
+     * each other and the particles of a cell can be found by bisection.
+     * Within a cell, particles are kept in the order in which they were
+     * inserted.
+     */
+    template <int dim, int spacedim>
+    using ParticleContainer =
+      std::vector<std::pair<LevelInd, Particle<dim, spacedim>>>;
+  } // namespace internal
+
   /**
    * Accessor class used by ParticleIterator to access particle data.
    */
@@ -204,14 +223,13 @@ namespace Particles
     ParticleAccessor();
 
     /**
-     * Construct an accessor from a reference to a map and an iterator to the
-     * map. This constructor is protected so that it can only be accessed by
-     * friend classes.
+     * Construct an accessor from a reference to a container and an iterator
+     * into the container. This constructor is protected so that it can only
+     * be accessed by friend classes.
      */
     ParticleAccessor(
-      const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-      const typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
+      const internal::ParticleContainer<dim, spacedim> &container,
+      const typename internal::ParticleContainer<dim, spacedim>::iterator
         &particle);
 
   private:
@@ -219,14 +237,13 @@ namespace Particles
      * A pointer to the container that stores the particles. Obviously,
      * this accessor is invalidated if the container changes.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> *map;
+    internal::ParticleContainer<dim, spacedim> *container;
 
     /**
      * An iterator into the container of particles. Obviously,
      * this accessor is invalidated if the container changes.
      */
-    typename std::multimap<internal::LevelInd,
-                           Particle<dim, spacedim>>::iterator particle;
+    typename internal::ParticleContainer<dim, spacedim>::iterator particle;
 
     // Make ParticleIterator a friend to allow it constructing
     // ParticleAccessors.
@@ -88,9 +88,10 @@ namespace Particles
                     const unsigned int                  n_properties = 0);
 
     /**
-     * Destructor.
+     * Destructor. Destroys all particles before the property pool in which
+     * they store their properties.
      */
-    virtual ~ParticleHandler() override = default;
+    virtual ~ParticleHandler() override;
 
     /**
      * Initialize the particle handler. This function does not clear the
@@ -210,15 +211,34 @@ namespace Particles
 
     /**
      * Remove a particle pointed to by the iterator.
+     *
+     * The particles are stored in a contiguous array. Removing a particle
+     * therefore invalidates all iterators to particles and is of $O(N)$
+     * complexity for $N$ particles. If more than one particle needs to be
+     * removed, use remove_particles() instead.
      */
     void
     remove_particle(const particle_iterator &particle);
 
+    /**
+     * Remove all particles pointed to by the iterators in the given vector,
+     * which need not be sorted. This function is of $O(N + M \log M)$
+     * complexity for $N$ existing and $M$ removed particles, and invalidates
+     * all iterators to particles.
+     */
+    void
+    remove_particles(const std::vector<particle_iterator> &particles_to_remove);
+
     /**
      * Insert a particle into the collection of particles. Return an iterator
      * to the new position of the particle. This function involves a copy of
-     * the particle and its properties. Note that this function is of $O(N \log
-     * N)$ complexity for $N$ particles.
+     * the particle and its properties, and invalidates all other iterators to
+     * particles. Inserting a particle into a cell that comes after all cells
+     * that already contain particles (for example, when inserting particles
+     * while looping over the active cells) is of amortized $O(\log N)$
+     * complexity for $N$ particles, whereas inserting into an earlier cell
+     * requires moving the particles of all later cells. To insert many
+     * particles at once, the insert_particles() functions are more efficient.
      */
     particle_iterator
     insert_particle(
@@ -229,7 +249,8 @@ namespace Particles
      * Insert a number of particles into the collection of particles.
      * This function involves a copy of the particles and their properties.
      * Note that this function is of O(n_existing_particles + n_particles)
-     * complexity.
+     * complexity, because the new particles are appended to and merged with
+     * the existing, already sorted ones.
      */
     void
     insert_particles(
@@ -237,6 +258,22 @@ namespace Particles
         typename Triangulation<dim, spacedim>::active_cell_iterator,
         Particle<dim, spacedim>> &particles);
 
+    /**
+     * Insert a number of particles into the collection of particles. This
+     * function does the same as the function above, but takes the particles
+     * together with the cells they are in as a vector, which is cheaper to
+     * build than a std::multimap when generating many particles at once. As
+     * in insert_particle(), the properties of the new particles are copied
+     * into the property pool of this object. The particles do not need to be
+     * sorted by cell, but inserting them in the order of the active cells
+     * avoids most of the work of merging them with the existing particles.
+     */
+    void
+    insert_particles(
+      const std::vector<
+        std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                  Particle<dim, spacedim>>> &particles);
+
     /**
      * Create and insert a number of particles into the collection of particles.
      * This function takes a list of positions and creates a set of particles
@@ -561,13 +598,66 @@ namespace Particles
     void
     sort_particles_into_subdomains_and_cells();
 
+    /**
+     * Reorder the locally owned particles to improve the memory locality of
+     * loops over all particles. The particles of each cell are sorted along
+     * a Hilbert space-filling curve through their reference locations, see
+     * Utilities::inverse_Hilbert_space_filling_curve(), so that particles
+     * that are close to each other are also close in memory. Afterwards, the
+     * properties of the particles are redistributed over the slots of the
+     * property pool that the particles already occupy, so that they are
+     * stored in increasing order of their addresses in the order in which
+     * the particles are traversed. The order of the cells is not changed.
+     *
+     * Since particles are inserted and move between cells over time, the
+     * memory access pattern of loops over particles becomes more and more
+     * irregular. It is therefore useful to call this function periodically,
+     * for example every few time steps after
+     * sort_particles_into_subdomains_and_cells().
+     *
+     * This function invalidates all particle iterators as well as the
+     * information stored by exchange_ghost_particles() for
+     * update_ghost_particles().
+     */
+    void
+    reorder_particles_for_memory_locality();
+
     /**
      * Exchange all particles that live in cells that are ghost cells to
      * other processes. Clears and re-populates the ghost_neighbors
      * member variable.
+     *
+     * If @p enable_ghost_cache is set to true, the lists of particles that
+     * were sent to and received from each neighboring process are stored,
+     * so that later calls to update_ghost_particles() only need to
+     * communicate the current locations and properties of these particles.
      */
     void
-    exchange_ghost_particles();
+    exchange_ghost_particles(const bool enable_ghost_cache = false);
+
+    /**
+     * Update the locations, reference locations and properties (as well as
+     * the additional data registered through
+     * register_additional_store_load_functions()) of all ghost particles,
+     * assuming that the set of ghost particles on each process is the same
+     * as in the last call to exchange_ghost_particles() with
+     * <code>enable_ghost_cache=true</code>. In that case, this function only
+     * sends messages of known, fixed size between neighboring processes,
+     * into buffers that were allocated during the last call, and overwrites
+     * the existing ghost particles in place. This is considerably cheaper
+     * than a full exchange.
+     *
+     * If the set of locally owned particles has changed on any process since
+     * the last exchange, for example because particles were inserted or
+     * removed, or because sort_particles_into_subdomains_and_cells() moved
+     * particles into other cells, the cached information is no longer valid
+     * and this function falls back to calling
+     * <code>exchange_ghost_particles(true)</code>. Because this decision
+     * requires a global reduction, this function must be called on all
+     * processes at the same time.
+     */
+    void
+    update_ghost_particles();
 
     /**
      * Callback function that should be called before every refinement
@@ -587,6 +677,45 @@ namespace Particles
     void
     register_load_callback_function(const bool serialization);
 
+    /**
+     * Return the contribution of the particles to the weight of @p cell
+     * during load balancing, namely @p weight_per_particle times the number
+     * of particles the cell, or its children in case of @p status being
+     * CELL_COARSEN, currently contain. The arguments @p cell and @p status
+     * are the ones provided by the Triangulation::Signals::cell_weight
+     * signal, so this function can be used to build weight functions
+     * connected to this signal, see also connect_cell_weight_signal().
+     */
+    unsigned int
+    cell_weight(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const typename Triangulation<dim, spacedim>::CellStatus     status,
+      const unsigned int weight_per_particle) const;
+
+    /**
+     * Connect cell_weight() with the given @p weight_per_particle to the
+     * Triangulation::Signals::cell_weight signal of the triangulation the
+     * particles live on, so that the particles are taken into account the
+     * next time the triangulation repartitions itself. Recall that the
+     * triangulation assigns a weight of 1000 to every cell, so a value of
+     * 1000 for @p weight_per_particle considers a particle as costly as a
+     * cell.
+     *
+     * Only one such connection is kept: Calling this function again
+     * replaces the previous connection. The connection is released by
+     * disconnect_cell_weight_signal(), by initialize(), and when this object
+     * is destroyed.
+     */
+    void
+    connect_cell_weight_signal(const unsigned int weight_per_particle);
+
+    /**
+     * Release the connection established by connect_cell_weight_signal(),
+     * if any.
+     */
+    void
+    disconnect_cell_weight_signal();
+
     /**
      * Serialize the contents of this class.
      */
@@ -647,17 +776,18 @@ namespace Particles
       mapping;
 
     /**
-     * Set of particles currently living in the local domain, organized by
-     * the level/index of the cell they are in.
+     * Set of particles currently living in the local domain, stored
+     * contiguously and sorted by the level/index of the cell they are in.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> particles;
+    internal::ParticleContainer<dim, spacedim> particles;
 
     /**
      * Set of particles that currently live in the ghost cells of the local
-     * domain, organized by the level/index of the cell they are in. These
-     * particles are equivalent to the ghost entries in distributed vectors.
+     * domain, stored contiguously and sorted by the level/index of the cell
+     * they are in. These particles are equivalent to the ghost entries in
+     * distributed vectors.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> ghost_particles;
+    internal::ParticleContainer<dim, spacedim> ghost_particles;
 
     /**
      * This variable stores how many particles are stored globally. It is
@@ -733,6 +863,12 @@ namespace Particles
      */
     unsigned int handle;
 
+    /**
+     * The connection of cell_weight() to the cell_weight signal of the
+     * triangulation established by connect_cell_weight_signal().
+     */
+    boost::signals2::connection cell_weight_connection;
+
     /**
      * The GridTools::Cache is used to store the information about the
      * vertex_to_cells set and the vertex_to_cell_centers vectors to prevent
@@ -744,6 +880,57 @@ namespace Particles
      */
     std::unique_ptr<GridTools::Cache<dim, spacedim>> triangulation_cache;
 
+    /**
+     * A structure that stores the communication pattern of the last
+     * exchange of ghost particles, which is used by update_ghost_particles().
+     */
+    struct GhostParticleCache
+    {
+      /**
+       * Whether the cache describes the current set of locally owned and
+       * ghost particles. This is set to false by all functions that change
+       * the container of locally owned particles.
+       */
+      bool valid = false;
+
+      /**
+       * The processes ghost particles are exchanged with.
+       */
+      std::vector<types::subdomain_id> neighbors;
+
+      /**
+       * Iterators to the locally owned particles that are sent to the
+       * processes in @p neighbors, ordered by process.
+       */
+      std::vector<particle_iterator> particles_to_send;
+
+      /**
+       * The number of particles sent to and received from each of the
+       * processes in @p neighbors.
+       */
+      std::vector<unsigned int> n_send_particles;
+      std::vector<unsigned int> n_recv_particles;
+
+      /**
+       * For each received particle, in the order in which they are
+       * received, the position of the corresponding ghost particle in the
+       * ghost particle container.
+       */
+      std::vector<unsigned int> ghost_positions;
+
+      /**
+       * Buffers for the data that is sent and received, which are kept
+       * between calls to avoid repeated memory allocation.
+       */
+      std::vector<char> send_data;
+      std::vector<char> recv_data;
+    };
+
+    /**
+     * The cached communication pattern for ghost particles.
+     */
+    GhostParticleCache ghost_cache;
+
 #ifdef DEAL_II_WITH_MPI
     /**
      * Transfer particles that have crossed subdomain boundaries to other
@@ -765,13 +952,16 @@ namespace Particles
      * particle to be send in which the particle belongs. This parameter
      * is necessary if the cell information of the particle iterator is
      * outdated (e.g. after particle movement).
+     *
+     * @param [in] build_ghost_cache If true, store the communication pattern
+     * in the ghost_cache member variable. The number of particles received
+     * from each neighbor is recorded in the process.
      */
     void
     send_recv_particles(
       const std::map<types::subdomain_id, std::vector<particle_iterator>>
         &particles_to_send,
-      std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-        &received_particles,
+      internal::ParticleContainer<dim, spacedim> &received_particles,
       const std::map<
         types::subdomain_id,
         std::vector<
@@ -779,7 +969,8 @@ namespace Particles
         &new_cells_for_particles = std::map<
           types::subdomain_id,
           std::vector<
-            typename Triangulation<dim, spacedim>::active_cell_iterator>>());
+            typename Triangulation<dim, spacedim>::active_cell_iterator>>(),
+      const bool build_ghost_cache = false);
 #endif
 
     /**
@@ -49,9 +49,8 @@ namespace Particles
      * container, and an iterator to the cell-particle pair.
      */
     ParticleIterator(
-      const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-      const typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
+      const internal::ParticleContainer<dim, spacedim> &container,
+      const typename internal::ParticleContainer<dim, spacedim>::iterator
         &particle);
 
     /**
@@ -20,6 +20,10 @@
 
 #include <deal.II/base/array_view.h>
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
@@ -30,15 +34,33 @@ namespace Particles
    * needs the same amount, it is more efficient to let this be handled by a
    * central manager that does not need to allocate/deallocate memory every
    * time a particle is constructed/destroyed.
-   * The current implementation uses simple new/delete allocation for every
-   * block. Additionally, the current implementation
-   * assumes the same number of properties per particle, but of course the
+   *
+   * The current implementation allocates memory in large blocks ("slabs"),
+   * each of which provides space for the properties of many particles.
+   * Handles that are released by deallocate_properties_array() are kept in
+   * a free list and handed out again by later calls to
+   * allocate_properties_array(), so that the allocation and deallocation of
+   * properties does not involve calls to the system's memory allocator in
+   * most cases, and the properties of all particles are stored in few,
+   * contiguous blocks of memory. Within each slab, the properties of one
+   * particle are stored contiguously, as required by the ArrayView returned
+   * by get_properties(). Slabs are never moved, so handles stay valid until
+   * they are deallocated. Memory of slabs that no longer contain any
+   * properties in use can be returned to the system by calling
+   * release_unused_memory(), for example after many particles have been
+   * deleted.
+   *
+   * The current implementation assumes the same number of properties per
+   * particle, but of course the
    * PropertyType could contain a pointer to dynamically allocated memory
    * with varying sizes per particle (this memory would not be managed by this
    * class).
    * Because PropertyPool only returns handles it could be enhanced internally
    * (e.g. to allow for varying number of properties per handle) without
    * affecting its interface.
+   *
+   * @note Unlike individual calls to <code>new</code>, the functions of this
+   * class that allocate or deallocate memory are not thread-safe.
    */
   class PropertyPool
   {
@@ -85,22 +107,73 @@ namespace Particles
 
     /**
      * Reserve the dynamic memory needed for storing the properties of
-     * @p size particles.
+     * @p size particles, in addition to the ones that are currently
+     * allocated. If fewer free slots than @p size are available, a new slab
+     * providing the missing slots is allocated at once.
      */
     void
     reserve(const std::size_t size);
 
+    /**
+     * Return memory of slabs in which no slot is currently allocated to
+     * the system. Handles that are in use are not affected by this
+     * function. In addition, the free slots are sorted so that subsequent
+     * calls to allocate_properties_array() return slots in the order in
+     * which they are stored in memory.
+     */
+    void
+    release_unused_memory();
+
     /**
      * Return how many properties are stored per slot in the pool.
      */
     unsigned int
     n_properties_per_slot() const;
 
+    /**
+     * Return the number of slots that are currently allocated, i.e., the
+     * number of handles that have been returned by
+     * allocate_properties_array() but not yet released.
+     */
+    std::size_t
+    n_allocated_slots() const;
+
+    /**
+     * Return an estimate of the memory consumption, in bytes, of this
+     * object, including the slabs and the free list.
+     */
+    std::size_t
+    memory_consumption() const;
+
   private:
+    /**
+     * Allocate a new slab with space for @p n_slots particles and add its
+     * slots to the free list.
+     */
+    void
+    allocate_slab(const std::size_t n_slots);
+
     /**
      * The number of properties that are reserved per particle.
      */
     const unsigned int n_properties;
+
+    /**
+     * The slabs of memory in which the properties are stored, together with
+     * the number of slots each of them provides.
+     */
+    std::vector<std::pair<std::unique_ptr<double[]>, std::size_t>> slabs;
+
+    /**
+     * The total number of slots provided by all slabs.
+     */
+    std::size_t n_slots;
+
+    /**
+     * Handles to the slots that are currently not in use. New handles are
+     * taken from the back of this vector.
+     */
+    std::vector<Handle> free_slots;
   };
 
 
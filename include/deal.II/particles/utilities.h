@@ -21,6 +21,7 @@
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
@@ -31,6 +32,9 @@
 #include <deal.II/grid/grid_tools_cache.h>
 
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
 
 #include <deal.II/particles/particle_handler.h>
 
@@ -252,6 +256,189 @@ namespace Particles
       interpolated_field.compress(VectorOperation::add);
     }
 
+    /**
+     * Given a DoFHandler and a ParticleHandler, deposit values carried by
+     * the particles on a finite element field, i.e., compute
+     * \f[
+     *  f_j \mathrel{+}= \sum_i v_j(x_i) q_{i,k(j)},
+     * \f]
+     * where $x_i$ is the position of the particle with id `i`, $q_{i,k}$ is
+     * the value associated with this particle for the `k`-th selected
+     * component, and `k(j)` is the index of the component of the basis
+     * function $v_j$ within the selected components. This is the transpose
+     * of interpolate_field_on_particles() and gives the same result as the
+     * multiplication of the vector of particle values with the transpose of
+     * the matrix created by create_interpolation_matrix(), without setting up
+     * this matrix. It is therefore the method of choice for one-time scatter
+     * operations, like depositing the charge or mass of particles on the mesh
+     * in a particle-in-cell method.
+     *
+     * The cells that contain particles are processed in parallel with
+     * WorkStream::run(). On each cell, the contributions of all particles
+     * of the cell are computed together by FEPointEvaluation, which uses
+     * sum factorization for elements with tensor product structure such as
+     * FE_Q. The cell contributions are then added into @p field_vector by
+     * AffineConstraints::distribute_local_to_global() in the sequential
+     * copier of WorkStream, so that no two threads write into the vector at
+     * the same time. Only primitive finite element spaces are supported.
+     *
+     * @param[in] field_dh The DoFHandler describing the field that is
+     * deposited on.
+     *
+     * @param[in] particle_handler The particle handler whose particles
+     * carry the values to deposit.
+     *
+     * @param[in] particle_values The values carried by the particles, in the
+     * same layout as the output vector of interpolate_field_on_particles(),
+     * i.e., the value of the `k`-th selected component of the particle with
+     * id `i` is located at index `i * n_comps + k`.
+     *
+     * @param[in,out] field_vector The vector the contributions of the
+     * particles are added to. It must be coherent with @p field_dh.
+     *
+     * @param[in] constraints Constraints used to distribute the
+     * contributions of the cells into @p field_vector.
+     *
+     * @param[in] field_comps An optional component mask that decides which
+     * subset of the vector fields the values are deposited on.
+     */
+    template <int dim,
+              int spacedim,
+              typename InputVectorType,
+              typename OutputVectorType>
+    void
+    deposit_particle_values_on_field(
+      const DoFHandler<dim, spacedim> &                field_dh,
+      const Particles::ParticleHandler<dim, spacedim> &particle_handler,
+      const InputVectorType &                          particle_values,
+      OutputVectorType &                               field_vector,
+      const AffineConstraints<typename OutputVectorType::value_type>
+        &constraints =
+          AffineConstraints<typename OutputVectorType::value_type>(),
+      const ComponentMask &field_comps = ComponentMask())
+    {
+      using number = typename OutputVectorType::value_type;
+
+      if (particle_handler.n_locally_owned_particles() == 0)
+        {
+          field_vector.compress(VectorOperation::add);
+          return; // nothing else to do here
+        }
+
+      const auto &tria = field_dh.get_triangulation();
+      const auto &fe   = field_dh.get_fe();
+
+      Assert(fe.is_primitive(),
+             ExcMessage("This function only works for primitive finite "
+                        "element spaces."));
+
+      // Take care of components
+      const ComponentMask comps =
+        (field_comps.size() == 0 ? ComponentMask(fe.n_components(), true) :
+                                   field_comps);
+      AssertDimension(comps.size(), fe.n_components());
+      const auto n_comps = comps.n_selected_components();
+
+      AssertDimension(field_vector.size(), field_dh.n_dofs());
+      AssertDimension(particle_values.size(),
+                      particle_handler.get_next_free_particle_index() *
+                        n_comps);
+
+      // Collect the cells that contain particles. The particles are stored
+      // sorted by cell, so that we can jump from one cell to the next
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+        cells_with_particles;
+      for (auto particle = particle_handler.begin();
+           particle != particle_handler.end();)
+        {
+          const typename Triangulation<dim, spacedim>::active_cell_iterator
+            cell = particle->get_surrounding_cell(tria);
+          cells_with_particles.push_back(cell);
+          particle = particle_handler.particles_in_cell(cell).end();
+        }
+
+      // Evaluators for each selected component, along with the buffers
+      // needed on a cell
+      struct ScratchData
+      {
+        ScratchData(const FiniteElement<dim, spacedim> &fe,
+                    const ComponentMask &               comps)
+          : local_values(fe.dofs_per_cell)
+        {
+          for (unsigned int c = 0; c < fe.n_components(); ++c)
+            if (comps[c])
+              evaluators.emplace_back(StaticMappingQ1<dim, spacedim>::mapping,
+                                      fe,
+                                      update_values,
+                                      c);
+        }
+
+        std::vector<FEPointEvaluation<1, dim, spacedim>> evaluators;
+        std::vector<Point<dim>>                          unit_points;
+        std::vector<types::particle_index>               particle_ids;
+        std::vector<double>                              local_values;
+      };
+
+      struct CopyData
+      {
+        Vector<number>                       cell_vector;
+        std::vector<types::global_dof_index> dof_indices;
+      };
+
+      const auto worker =
+        [&](const typename std::vector<
+              typename Triangulation<dim, spacedim>::active_cell_iterator>::
+              const_iterator &cell,
+            ScratchData &     scratch,
+            CopyData &        copy_data) {
+          scratch.unit_points.clear();
+          scratch.particle_ids.clear();
+          for (const auto &particle : particle_handler.particles_in_cell(*cell))
+            {
+              scratch.unit_points.push_back(particle.get_reference_location());
+              scratch.particle_ids.push_back(particle.get_id());
+            }
+
+          const typename DoFHandler<dim, spacedim>::cell_iterator dh_cell(
+            **cell, &field_dh);
+          copy_data.dof_indices.resize(fe.dofs_per_cell);
+          dh_cell->get_dof_indices(copy_data.dof_indices);
+          copy_data.cell_vector.reinit(fe.dofs_per_cell);
+
+          for (unsigned int k = 0; k < n_comps; ++k)
+            {
+              auto &evaluator = scratch.evaluators[k];
+              evaluator.reinit(*cell, scratch.unit_points);
+              for (unsigned int q = 0; q < scratch.particle_ids.size(); ++q)
+                evaluator.submit_value(
+                  particle_values[scratch.particle_ids[q] * n_comps + k], q);
+
+              // the integration sets the entries of the components not
+              // selected by the evaluator to zero, so we can simply add up
+              // the contributions of all components
+              evaluator.integrate(make_array_view(scratch.local_values),
+                                  EvaluationFlags::values);
+              for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                copy_data.cell_vector(i) += scratch.local_values[i];
+            }
+        };
+
+      const auto copier = [&](const CopyData &copy_data) {
+        constraints.distribute_local_to_global(copy_data.cell_vector,
+                                               copy_data.dof_indices,
+                                               field_vector);
+      };
+
+      WorkStream::run(cells_with_particles.cbegin(),
+                      cells_with_particles.cend(),
+                      worker,
+                      copier,
+                      ScratchData(fe, comps),
+                      CopyData());
+
+      field_vector.compress(VectorOperation::add);
+    }
+
   } // namespace Utilities
 } // namespace Particles
 DEAL_II_NAMESPACE_CLOSE
@@ -310,7 +310,11 @@ template <int dim, typename Number>
 inline SymmetricTensor<2, dim, Number>
 Physics::Elasticity::Kinematics::C(const Tensor<2, dim, Number> &F)
 {
-  return symmetrize(transpose(F) * F);
+  // Only compute the independent entries of F^T.F instead of forming the
+  // full product and symmetrizing it afterwards. This saves both the
+  // temporary tensors and almost half of the arithmetic, which matters
+  // when Number is a VectorizedArray
+  return internal::Physics::right_cauchy_green_tensor(F);
 }
 
 
@@ -319,7 +323,17 @@ template <int dim, typename Number>
 inline SymmetricTensor<2, dim, Number>
 Physics::Elasticity::Kinematics::b(const Tensor<2, dim, Number> &F)
 {
-  return symmetrize(F * transpose(F));
+  // Same as in C(), but for F.F^T
+  SymmetricTensor<2, dim, Number> result;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = i; j < dim; ++j)
+      {
+        Number sum = F[i][0] * F[j][0];
+        for (unsigned int K = 1; K < dim; ++K)
+          sum += F[i][K] * F[j][K];
+        result[i][j] = sum;
+      }
+  return result;
 }
 
 
@@ -328,9 +342,13 @@ template <int dim, typename Number>
 inline SymmetricTensor<2, dim, Number>
 Physics::Elasticity::Kinematics::E(const Tensor<2, dim, Number> &F)
 {
-  return internal::NumberType<Number>::value(0.5) *
-         (C(F) - static_cast<SymmetricTensor<2, dim, Number>>(
-                   StandardTensors<dim>::I));
+  // Subtract the identity on the diagonal only rather than converting it to
+  // a tensor of the given number type first
+  SymmetricTensor<2, dim, Number> result = C(F);
+  for (unsigned int A = 0; A < dim; ++A)
+    result[A][A] -= internal::NumberType<Number>::value(1.0);
+  result *= internal::NumberType<Number>::value(0.5);
+  return result;
 }
 
 
@@ -349,11 +367,13 @@ template <int dim, typename Number>
 inline SymmetricTensor<2, dim, Number>
 Physics::Elasticity::Kinematics::e(const Tensor<2, dim, Number> &F)
 {
-  const Tensor<2, dim, Number> F_inv = invert(F);
-  return internal::NumberType<Number>::value(0.5) *
-         symmetrize(static_cast<SymmetricTensor<2, dim, Number>>(
-                      StandardTensors<dim>::I) -
-                    transpose(F_inv) * F_inv);
+  // The product F^{-T}.F^{-1} has the same structure as the right
+  // Cauchy-Green tensor, so use the symmetric kernel of C() for it
+  SymmetricTensor<2, dim, Number> result = C(invert(F));
+  result *= internal::NumberType<Number>::value(-0.5);
+  for (unsigned int i = 0; i < dim; ++i)
+    result[i][i] += internal::NumberType<Number>::value(0.5);
+  return result;
 }
 
 
@@ -385,7 +405,7 @@ Physics::Elasticity::Kinematics::w(const Tensor<2, dim, Number> &F,
 {
   // This could be implemented as w = l-d, but that would mean computing "l"
   // a second time.
-  const Tensor<2, dim> grad_v = l(F, dF_dt);
+  const Tensor<2, dim, Number> grad_v = l(F, dF_dt);
   return internal::NumberType<Number>::value(0.5) *
          (grad_v - transpose(grad_v));
 }
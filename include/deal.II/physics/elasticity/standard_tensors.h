@@ -314,6 +314,55 @@ namespace Physics
 
 // --------------------- inline functions and constants -------------------
 
+namespace internal
+{
+  namespace Physics
+  {
+    /**
+     * Return the right Cauchy-Green tensor $\mathbf{C} = \mathbf{F}^T \cdot
+     * \mathbf{F}$, computing only its independent entries.
+     */
+    template <int dim, typename Number>
+    inline dealii::SymmetricTensor<2, dim, Number>
+    right_cauchy_green_tensor(const Tensor<2, dim, Number> &F)
+    {
+      dealii::SymmetricTensor<2, dim, Number> C;
+      for (unsigned int A = 0; A < dim; ++A)
+        for (unsigned int B = A; B < dim; ++B)
+          {
+            Number sum = F[0][A] * F[0][B];
+            for (unsigned int k = 1; k < dim; ++k)
+              sum += F[k][A] * F[k][B];
+            C[A][B] = sum;
+          }
+      return C;
+    }
+
+
+
+    /**
+     * Add @p factor times the fourth-order symmetric identity tensor to
+     * @p H. Only the nonzero entries of the identity tensor are touched,
+     * which avoids converting the tensor StandardTensors::S to the number
+     * type of @p H.
+     */
+    template <int dim, typename Number>
+    inline void
+    add_symmetric_identity(const Number &                           factor,
+                           dealii::SymmetricTensor<4, dim, Number> &H)
+    {
+      const Number half_factor = factor * 0.5;
+      for (unsigned int A = 0; A < dim; ++A)
+        {
+          H[A][A][A][A] += factor;
+          for (unsigned int B = A + 1; B < dim; ++B)
+            H[A][B][A][B] += half_factor;
+        }
+    }
+  } // namespace Physics
+} // namespace internal
+
+
 
 template <int dim>
 template <typename Number>
@@ -324,17 +373,18 @@ Physics::Elasticity::StandardTensors<dim>::Dev_P(
   const Number det_F = determinant(F);
   Assert(numbers::value_is_greater_than(det_F, 0.0),
          ExcMessage("Deformation gradient has a negative determinant."));
-  const Tensor<2, dim, Number>          C_ns  = transpose(F) * F;
-  const SymmetricTensor<2, dim, Number> C     = symmetrize(C_ns);
-  const SymmetricTensor<2, dim, Number> C_inv = symmetrize(invert(C_ns));
-
-  // See Wriggers p46 equ 3.125 (but transpose indices)
-  SymmetricTensor<4, dim, Number> Dev_P =
-    outer_product(C, C_inv);                   // Dev_P = C_x_C_inv
-  Dev_P /= -dim;                               // Dev_P = -[1/dim]C_x_C_inv
-  Dev_P += SymmetricTensor<4, dim, Number>(S); // Dev_P = S - [1/dim]C_x_C_inv
-  Dev_P *=
-    std::pow(det_F, -2.0 / dim); // Dev_P = J^{-2/dim} [S - [1/dim]C_x_C_inv]
+  const SymmetricTensor<2, dim, Number> C =
+    internal::Physics::right_cauchy_green_tensor(F);
+  const SymmetricTensor<2, dim, Number> C_inv = invert(C);
+  const Number                          J_pow = std::pow(det_F, -2.0 / dim);
+
+  // See Wriggers p46 equ 3.125 (but transpose indices). Apply the scaling
+  // J^{-2/dim} to the outer product and the identity tensor individually,
+  // which avoids separate passes over all entries of the result
+  SymmetricTensor<4, dim, Number> Dev_P = outer_product(C, C_inv);
+  Dev_P *= J_pow * (-1.0 / dim); // Dev_P = -J^{-2/dim}[1/dim]C_x_C_inv
+  internal::Physics::add_symmetric_identity(
+    J_pow, Dev_P); // Dev_P = J^{-2/dim} [S - [1/dim]C_x_C_inv]
 
   return Dev_P;
 }
@@ -350,17 +400,16 @@ Physics::Elasticity::StandardTensors<dim>::Dev_P_T(
   const Number det_F = determinant(F);
   Assert(numbers::value_is_greater_than(det_F, 0.0),
          ExcMessage("Deformation gradient has a negative determinant."));
-  const Tensor<2, dim, Number>          C_ns  = transpose(F) * F;
-  const SymmetricTensor<2, dim, Number> C     = symmetrize(C_ns);
-  const SymmetricTensor<2, dim, Number> C_inv = symmetrize(invert(C_ns));
+  const SymmetricTensor<2, dim, Number> C =
+    internal::Physics::right_cauchy_green_tensor(F);
+  const SymmetricTensor<2, dim, Number> C_inv = invert(C);
+  const Number                          J_pow = std::pow(det_F, -2.0 / dim);
 
   // See Wriggers p46 equ 3.125 (not transposed)
-  SymmetricTensor<4, dim, Number> Dev_P_T =
-    outer_product(C_inv, C);                     // Dev_P = C_inv_x_C
-  Dev_P_T /= -dim;                               // Dev_P = -[1/dim]C_inv_x_C
-  Dev_P_T += SymmetricTensor<4, dim, Number>(S); // Dev_P = S - [1/dim]C_inv_x_C
-  Dev_P_T *=
-    std::pow(det_F, -2.0 / dim); // Dev_P = J^{-2/dim} [S - [1/dim]C_inv_x_C]
+  SymmetricTensor<4, dim, Number> Dev_P_T = outer_product(C_inv, C);
+  Dev_P_T *= J_pow * (-1.0 / dim); // Dev_P = -J^{-2/dim}[1/dim]C_inv_x_C
+  internal::Physics::add_symmetric_identity(
+    J_pow, Dev_P_T); // Dev_P = J^{-2/dim} [S - [1/dim]C_inv_x_C]
 
   return Dev_P_T;
 }
@@ -373,7 +422,8 @@ DEAL_II_CONSTEXPR SymmetricTensor<2, dim, Number>
                   Physics::Elasticity::StandardTensors<dim>::ddet_F_dC(
   const Tensor<2, dim, Number> &F)
 {
-  return Number(0.5) * determinant(F) * symmetrize(invert(transpose(F) * F));
+  return Number(0.5) * determinant(F) *
+         invert(internal::Physics::right_cauchy_green_tensor(F));
 }
 
 
@@ -385,7 +435,7 @@ Physics::Elasticity::StandardTensors<dim>::dC_inv_dC(
   const Tensor<2, dim, Number> &F)
 {
   const SymmetricTensor<2, dim, Number> C_inv =
-    symmetrize(invert(transpose(F) * F));
+    invert(internal::Physics::right_cauchy_green_tensor(F));
 
   SymmetricTensor<4, dim, Number> dC_inv_dC;
   for (unsigned int A = 0; A < dim; ++A)
@@ -843,18 +843,31 @@ namespace internal
     transformation_contraction(const dealii::SymmetricTensor<2, dim, Number> &T,
                                const Tensor<2, dim, Number> &                 F)
     {
+      // Access the entries of T through a full tensor and accumulate into
+      // local variables, which avoids the index translation of the
+      // symmetric tensor accessors in the innermost loops
+      const Tensor<2, dim, Number> T_full = T;
+
       Tensor<2, dim, Number> tmp_1;
       for (unsigned int i = 0; i < dim; ++i)
         for (unsigned int J = 0; J < dim; ++J)
-          // Loop over I but complex.h defines a macro I, so use I_ instead
-          for (unsigned int I_ = 0; I_ < dim; ++I_)
-            tmp_1[i][J] += F[i][I_] * T[I_][J];
+          {
+            // Loop over I but complex.h defines a macro I, so use I_ instead
+            Number sum = F[i][0] * T_full[0][J];
+            for (unsigned int I_ = 1; I_ < dim; ++I_)
+              sum += F[i][I_] * T_full[I_][J];
+            tmp_1[i][J] = sum;
+          }
 
       dealii::SymmetricTensor<2, dim, Number> out;
       for (unsigned int i = 0; i < dim; ++i)
         for (unsigned int j = i; j < dim; ++j)
-          for (unsigned int J = 0; J < dim; ++J)
-            out[i][j] += F[j][J] * tmp_1[i][J];
+          {
+            Number sum = F[j][0] * tmp_1[i][0];
+            for (unsigned int J = 1; J < dim; ++J)
+              sum += F[j][J] * tmp_1[i][J];
+            out[i][j] = sum;
+          }
 
       return out;
     }
@@ -911,15 +924,22 @@ namespace internal
       // Note: Its significantly quicker (in 3d) to push forward
       // each index individually
 
-      // Push forward (inner) index 1
-      Tensor<4, dim, Number> tmp;
+      // Push forward (inner) index 1. Read the entries of H from a full
+      // tensor, which avoids the index translation of the symmetric tensor
+      // accessors in the innermost loop
+      const Tensor<4, dim, Number> H_full = H;
+      Tensor<4, dim, Number>       tmp;
       // Loop over I but complex.h defines a macro I, so use I_ instead
       for (unsigned int I_ = 0; I_ < dim; ++I_)
         for (unsigned int j = 0; j < dim; ++j)
           for (unsigned int K = 0; K < dim; ++K)
             for (unsigned int L = 0; L < dim; ++L)
-              for (unsigned int J = 0; J < dim; ++J)
-                tmp[I_][j][K][L] += F[j][J] * H[I_][J][K][L];
+              {
+                Number sum = F[j][0] * H_full[I_][0][K][L];
+                for (unsigned int J = 1; J < dim; ++J)
+                  sum += F[j][J] * H_full[I_][J][K][L];
+                tmp[I_][j][K][L] = sum;
+              }
 
       // Push forward (outer) indices 0 and 3
       tmp = contract<1, 0>(F, contract<3, 1>(tmp, F));
@@ -930,8 +950,12 @@ namespace internal
         for (unsigned int j = i; j < dim; ++j)
           for (unsigned int k = 0; k < dim; ++k)
             for (unsigned int l = k; l < dim; ++l)
-              for (unsigned int K = 0; K < dim; ++K)
-                out[i][j][k][l] += F[k][K] * tmp[i][j][K][l];
+              {
+                Number sum = F[k][0] * tmp[i][j][0][l];
+                for (unsigned int K = 1; K < dim; ++K)
+                  sum += F[k][K] * tmp[i][j][K][l];
+                out[i][j][k][l] = sum;
+              }
 
       return out;
     }
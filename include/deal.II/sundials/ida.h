@@ -43,6 +43,8 @@
 #    include <ida/ida_spbcgs.h>
 #    include <ida/ida_spgmr.h>
 #    include <ida/ida_sptfqmr.h>
+#  else
+#    include <sundials/sundials_linearsolver.h>
 #  endif
 #  include <boost/signals2.hpp>
 
@@ -73,6 +75,14 @@ namespace SUNDIALS
    *  - setup_jacobian;
    *  - solve_jacobian_system;
    *
+   * If AdditionalData::use_krylov_solver is set, the linear systems are
+   * instead solved by the GMRES solver of IDA, and setup_jacobian() and
+   * solve_jacobian_system() are replaced by the optional functions
+   *  - jacobian_times_vector;
+   *  - setup_preconditioner;
+   *  - solve_with_preconditioner;
+   *  - reuse_preconditioner;
+   *
    * Optionally, also the following functions could be rewritten. By default
    * they do nothing, or are not required. If you call the constructor in a way
    * that requires a not-implemented function, an Assertion will be
@@ -299,6 +309,15 @@ namespace SUNDIALS
        * @param reset_type Initial condition correction type after restart
        * @param maximum_non_linear_iterations_ic Initial condition Newton max
        * iterations
+       *
+       * Linear solver parameters:
+       *
+       * @param use_krylov_solver Use the GMRES solver of IDA
+       * @param krylov_subspace_size Maximum dimension of the Krylov subspace
+       * @param maximum_preconditioner_reuses Maximum number of setup requests
+       * of IDA for which the preconditioner is reused
+       * @param preconditioner_alpha_tolerance Maximum relative change of
+       * alpha for which the preconditioner is reused
        */
       AdditionalData( // Initial parameters
         const double initial_time      = 0.0,
@@ -316,7 +335,12 @@ namespace SUNDIALS
         // Initial conditions parameters
         const InitialConditionCorrection &ic_type    = use_y_diff,
         const InitialConditionCorrection &reset_type = use_y_diff,
-        const unsigned int                maximum_non_linear_iterations_ic = 5)
+        const unsigned int                maximum_non_linear_iterations_ic = 5,
+        // Linear solver parameters
+        const bool         use_krylov_solver              = false,
+        const unsigned int krylov_subspace_size           = 0,
+        const unsigned int maximum_preconditioner_reuses  = 0,
+        const double       preconditioner_alpha_tolerance = 0.25)
         : initial_time(initial_time)
         , final_time(final_time)
         , initial_step_size(initial_step_size)
@@ -330,6 +354,10 @@ namespace SUNDIALS
         , reset_type(reset_type)
         , maximum_non_linear_iterations_ic(maximum_non_linear_iterations_ic)
         , maximum_non_linear_iterations(maximum_non_linear_iterations)
+        , use_krylov_solver(use_krylov_solver)
+        , krylov_subspace_size(krylov_subspace_size)
+        , maximum_preconditioner_reuses(maximum_preconditioner_reuses)
+        , preconditioner_alpha_tolerance(preconditioner_alpha_tolerance)
       {}
 
       /**
@@ -354,6 +382,12 @@ namespace SUNDIALS
        *   set Correction type after restart          = none
        *   set Maximum number of nonlinear iterations = 5
        * end
+       * subsection Linear solver parameters
+       *   set Krylov subspace size                              = 0
+       *   set Maximum number of preconditioner reuses           = 0
+       *   set Relative change of alpha for preconditioner reuse = 0.25
+       *   set Use Krylov solver                                 = false
+       * end
        * subsection Running parameters
        *   set Initial step size                      = 0.1
        *   set Maximum number of nonlinear iterations = 10
@@ -452,6 +486,15 @@ namespace SUNDIALS
         prm.add_parameter("Maximum number of nonlinear iterations",
                           maximum_non_linear_iterations_ic);
         prm.leave_subsection();
+
+        prm.enter_subsection("Linear solver parameters");
+        prm.add_parameter("Use Krylov solver", use_krylov_solver);
+        prm.add_parameter("Krylov subspace size", krylov_subspace_size);
+        prm.add_parameter("Maximum number of preconditioner reuses",
+                          maximum_preconditioner_reuses);
+        prm.add_parameter("Relative change of alpha for preconditioner reuse",
+                          preconditioner_alpha_tolerance);
+        prm.leave_subsection();
       }
 
       /**
@@ -536,6 +579,42 @@ namespace SUNDIALS
        * Maximum number of iterations for Newton method during time advancement.
        */
       unsigned int maximum_non_linear_iterations;
+
+      /**
+       * Solve the linear systems of the Newton iterations with the scaled
+       * preconditioned GMRES solver (SPGMR) of IDA instead of
+       * solve_jacobian_system(). The products of the Jacobian with a vector
+       * are computed by jacobian_times_vector(), or, if that function is not
+       * provided, by difference quotients of residual(), which results in a
+       * Jacobian-free Newton-Krylov method. The optional left preconditioner
+       * is given by setup_preconditioner() and solve_with_preconditioner().
+       */
+      bool use_krylov_solver;
+
+      /**
+       * The maximum dimension of the Krylov subspace of the GMRES solver.
+       *
+       * If set to zero, default values provided by IDA will be used.
+       */
+      unsigned int krylov_subspace_size;
+
+      /**
+       * The number of consecutive setup requests of IDA for which the
+       * default implementation of reuse_preconditioner() keeps the
+       * preconditioner, instead of calling setup_preconditioner(). Since the
+       * Jacobian products are exact, an outdated preconditioner only
+       * increases the number of GMRES iterations. Zero means that the
+       * preconditioner is set up whenever IDA asks for it.
+       */
+      unsigned int maximum_preconditioner_reuses;
+
+      /**
+       * The maximum relative change of the coefficient alpha of the
+       * Jacobian (which changes with the step size and the BDF order) since
+       * the last call to setup_preconditioner() for which the default
+       * implementation of reuse_preconditioner() keeps the preconditioner.
+       */
+      double preconditioner_alpha_tolerance;
     };
 
     /**
@@ -706,6 +785,83 @@ namespace SUNDIALS
     std::function<int(const VectorType &rhs, VectorType &dst)>
       solve_jacobian_system;
 
+    /**
+     * Compute the product `dst = J*src` of the system Jacobian
+     * \f[
+     *   J=\dfrac{\partial F}{\partial y} +
+     *  \alpha \dfrac{\partial F}{\partial \dot y}
+     * \f]
+     * at the given state with `src`. This function is only used if
+     * AdditionalData::use_krylov_solver is set. Its implementation is
+     * optional: if it is not provided, IDA approximates the product by a
+     * difference quotient of residual(). A LinearOperator representing the
+     * Jacobian can be used here by calling its vmult() function.
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (IDA will reduce the time step and try again)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const double      t,
+                      const VectorType &y,
+                      const VectorType &y_dot,
+                      const double      alpha,
+                      const VectorType &src,
+                      VectorType &      dst)>
+      jacobian_times_vector;
+
+    /**
+     * Set up the preconditioner applied in solve_with_preconditioner(). This
+     * function is only used if AdditionalData::use_krylov_solver is set, and
+     * it is called whenever IDA asks for a new setup and
+     * reuse_preconditioner() returns false.
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (IDA will reduce the time step and try again)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const double      t,
+                      const VectorType &y,
+                      const VectorType &y_dot,
+                      const double      alpha)>
+      setup_preconditioner;
+
+    /**
+     * Apply the preconditioner of the GMRES solver, i.e., compute
+     * `dst = P^{-1} rhs` with an approximation $P$ of the Jacobian. This
+     * function is only used if AdditionalData::use_krylov_solver is set. If
+     * it is not provided, the GMRES solver runs without preconditioner.
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (IDA will set up the preconditioner again, or
+     *       reduce the time step)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const VectorType &rhs, VectorType &dst)>
+      solve_with_preconditioner;
+
+    /**
+     * Decide whether the current preconditioner is kept when IDA asks for a
+     * new preconditioner setup at time `t` with the Jacobian coefficient
+     * `alpha`. If this function returns true, setup_preconditioner() is not
+     * called. Since this function is called for every setup request, it
+     * also has to keep track of the information the decision is based on.
+     *
+     * The default implementation reuses the preconditioner for at most
+     * AdditionalData::maximum_preconditioner_reuses consecutive requests, as
+     * long as alpha has changed by at most
+     * AdditionalData::preconditioner_alpha_tolerance relative to its value
+     * at the last setup, and no nonlinear convergence failure has occurred
+     * since.
+     */
+    std::function<bool(const double t, const double alpha)>
+      reuse_preconditioner;
+
     /**
      * Process solution. This function is called by IDA at fixed time steps,
      * every `output_period` seconds, and it is passed a polynomial
@@ -821,6 +977,30 @@ namespace SUNDIALS
      */
     N_Vector diff_id;
 
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+    /**
+     * The GMRES solver used if AdditionalData::use_krylov_solver is set.
+     */
+    SUNLinearSolver linear_solver;
+#  endif
+
+    /**
+     * The value of alpha for which setup_preconditioner() was called last.
+     */
+    double last_preconditioner_alpha;
+
+    /**
+     * The number of setup requests for which the preconditioner has been
+     * reused since the last call to setup_preconditioner().
+     */
+    unsigned int n_preconditioner_reuses;
+
+    /**
+     * The number of nonlinear convergence failures of IDA at the last call
+     * to setup_preconditioner().
+     */
+    long int n_convergence_failures_at_setup;
+
     /**
      * MPI communicator. SUNDIALS solver runs happily in
      * parallel. Note that if the library is compiled without MPI
@@ -253,6 +253,11 @@ namespace SUNDIALS
        * Fixed point and Picard parameters:
        *
        * @param anderson_subspace_size Anderson acceleration subspace size
+       *
+       * Linear solver parameters:
+       *
+       * @param use_krylov_solver Use the GMRES solver of KINSOL
+       * @param krylov_subspace_size Maximum dimension of the Krylov subspace
        */
       AdditionalData(
         // Global parameters
@@ -265,7 +270,10 @@ namespace SUNDIALS
         const double            maximum_newton_step           = 0.0,
         const double            dq_relative_error             = 0.0,
         const unsigned int      maximum_beta_failures         = 0,
-        const unsigned int      anderson_subspace_size        = 0)
+        const unsigned int      anderson_subspace_size        = 0,
+        // Linear solver parameters
+        const bool         use_krylov_solver    = false,
+        const unsigned int krylov_subspace_size = 0)
         : strategy(strategy)
         , maximum_non_linear_iterations(maximum_non_linear_iterations)
         , function_tolerance(function_tolerance)
@@ -276,6 +284,8 @@ namespace SUNDIALS
         , dq_relative_error(dq_relative_error)
         , maximum_beta_failures(maximum_beta_failures)
         , anderson_subspace_size(anderson_subspace_size)
+        , use_krylov_solver(use_krylov_solver)
+        , krylov_subspace_size(krylov_subspace_size)
       {}
 
       /**
@@ -293,6 +303,10 @@ namespace SUNDIALS
        * subsection Fixed point and Picard parameters
        *   set Anderson acceleration subspace size = 5
        * end
+       * subsection Linear solver parameters
+       *   set Krylov subspace size = 0
+       *   set Use Krylov solver    = false
+       * end
        * subsection Linesearch parameters
        *   set Maximum number of beta-condition failures = 0
        * end
@@ -363,6 +377,11 @@ namespace SUNDIALS
         prm.add_parameter("Anderson acceleration subspace size",
                           anderson_subspace_size);
         prm.leave_subsection();
+
+        prm.enter_subsection("Linear solver parameters");
+        prm.add_parameter("Use Krylov solver", use_krylov_solver);
+        prm.add_parameter("Krylov subspace size", krylov_subspace_size);
+        prm.leave_subsection();
       }
 
       /**
@@ -443,6 +462,29 @@ namespace SUNDIALS
        * If you set this to 0, no acceleration is used.
        */
       unsigned int anderson_subspace_size;
+
+      /**
+       * Solve the linear systems of the Newton and Picard iterations with the
+       * scaled preconditioned GMRES solver (SPGMR) of KINSOL. The products
+       * of the Jacobian with a vector are computed by
+       * jacobian_times_vector(), or, if that function is not provided, by
+       * difference quotients of residual(), which results in a
+       * Jacobian-free Newton-Krylov method. The optional right
+       * preconditioner is given by setup_preconditioner() and
+       * solve_with_preconditioner().
+       *
+       * If set to true, solve_jacobian_system() and setup_jacobian() are not
+       * used.
+       */
+      bool use_krylov_solver;
+
+      /**
+       * The maximum dimension of the Krylov subspace of the GMRES solver.
+       * Only used if use_krylov_solver is true.
+       *
+       * If set to zero, default values provided by KINSOL will be used.
+       */
+      unsigned int krylov_subspace_size;
     };
 
     /**
@@ -592,6 +634,76 @@ namespace SUNDIALS
                       VectorType &      dst)>
       solve_jacobian_system;
 
+    /**
+     * A function object that users may supply and that is intended to
+     * compute the product `dst = J*src` of the Jacobian $J$ at `current_u`
+     * with the vector `src`. This function is only used if
+     * AdditionalData::use_krylov_solver is set. If it is not provided,
+     * KINSOL approximates the product by a difference quotient of
+     * residual().
+     *
+     * A LinearOperator representing the Jacobian can be used here by
+     * calling its vmult() function.
+     *
+     * This function should return 0 on success, and a nonzero value if the
+     * product could not be computed.
+     */
+    std::function<int(const VectorType &current_u,
+                      const VectorType &src,
+                      VectorType &      dst)>
+      jacobian_times_vector;
+
+    /**
+     * A function object that users may supply and that is intended to set
+     * up the preconditioner applied in solve_with_preconditioner(). This
+     * function is only used if AdditionalData::use_krylov_solver is set.
+     *
+     * KINSOL calls this function as rarely as setup_jacobian() in the case
+     * of a user supplied linear solver, i.e., the preconditioner is reused
+     * for up to AdditionalData::maximum_setup_calls nonlinear iterations,
+     * and it is recomputed when the Krylov solver or the line search fails
+     * to make progress. With AdditionalData::no_init_setup, the
+     * preconditioner that is left over from the previous call to solve() is
+     * used for the first iterations of the next one.
+     *
+     * @param current_u Current value of u
+     * @param current_f Current value of F(u) or G(u)
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (KINSOL will try to change its internal
+     * parameters and attempt a new solution step)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const VectorType &current_u, const VectorType &current_f)>
+      setup_preconditioner;
+
+    /**
+     * A function object that users may supply and that is intended to apply
+     * the preconditioner of the GMRES solver, i.e., to compute
+     * `dst = P^{-1} rhs` with an approximation $P$ of the Jacobian. This
+     * function is only used if AdditionalData::use_krylov_solver is set. If
+     * it is not provided, the GMRES solver runs without preconditioner.
+     *
+     * @param[in] current_u Current value of u
+     * @param[in] current_f Current value of F(u) or G(u)
+     * @param[in] rhs The vector the preconditioner is applied to
+     * @param[out] dst The preconditioned vector
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (KINSOL will try to change its internal
+     * parameters and attempt a new solution step)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const VectorType &current_u,
+                      const VectorType &current_f,
+                      const VectorType &rhs,
+                      VectorType &      dst)>
+      solve_with_preconditioner;
+
     /**
      * A function object that users may supply and that is intended to return a
      * vector whose components are the weights used by KINSOL to compute the
@@ -0,0 +1,88 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2020 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_h
+#define dealii_sundials_n_vector_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/mpi.h>
+
+#  include <sundials/sundials_nvector.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    /**
+     * Create a SUNDIALS N_Vector that stores a copy of @p vector. In
+     * contrast to the N_Vector types shipped with SUNDIALS, the returned
+     * N_Vector keeps the data in an object of type @p VectorType, and all
+     * vector operations SUNDIALS performs on it, including on all the vectors
+     * SUNDIALS clones from it, are forwarded to the functions of
+     * @p VectorType. Consequently, the user callbacks of the SUNDIALS
+     * wrappers can access the vectors through unwrap_nvector() without
+     * copying them.
+     *
+     * The @p communicator is used for the few reductions that have no
+     * counterpart in the deal.II vector interface, e.g., the minimal entry.
+     * It must be MPI_COMM_SELF for serial vector types and the communicator
+     * of the vector otherwise.
+     *
+     * The N_Vector must be released with N_VDestroy(), which also destroys
+     * the copy of @p vector. The operations that give access to the
+     * underlying array, N_VGetArrayPointer() and N_VSetArrayPointer(), are
+     * not supported, so the N_Vector cannot be used with the direct linear
+     * solvers of SUNDIALS.
+     */
+    template <typename VectorType>
+    N_Vector
+    create_nvector(const VectorType &vector, const MPI_Comm &communicator);
+
+    /**
+     * Create a SUNDIALS N_Vector that refers to @p vector without copying
+     * it, see create_nvector(). @p vector must outlive the N_Vector, and
+     * N_VDestroy() only releases the wrapper.
+     */
+    template <typename VectorType>
+    N_Vector
+    make_nvector_view(VectorType &vector, const MPI_Comm &communicator);
+
+    /**
+     * Return a pointer to the vector of type @p VectorType an N_Vector
+     * created by create_nvector() or make_nvector_view() (or cloned from
+     * such an N_Vector) stores.
+     */
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector v);
+
+    /**
+     * Same as unwrap_nvector(), but return a pointer to a constant vector.
+     */
+    template <typename VectorType>
+    const VectorType *
+    unwrap_nvector_const(N_Vector v);
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_h
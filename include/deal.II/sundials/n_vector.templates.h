@@ -0,0 +1,617 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2020 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_templates_h
+#define dealii_sundials_n_vector_templates_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/sundials/n_vector.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/exceptions.h>
+#  include <deal.II/base/index_set.h>
+#  include <deal.II/base/mpi.h>
+#  include <deal.II/base/mpi.templates.h>
+
+#  include <deal.II/lac/vector_memory.h>
+#  include <deal.II/lac/vector_operation.h>
+
+#  include <sundials/sundials_types.h>
+
+#  include <algorithm>
+#  include <cmath>
+#  include <limits>
+#  include <memory>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    namespace NVectorOperations
+    {
+      /**
+       * The content of an N_Vector wrapping a deal.II vector. It either owns
+       * the vector or refers to a vector owned by someone else.
+       */
+      template <typename VectorType>
+      class NVectorContent
+      {
+      public:
+        /**
+         * Take ownership of @p vector.
+         */
+        NVectorContent(std::unique_ptr<VectorType> &&vector,
+                       const MPI_Comm &              communicator)
+          : owned_vector(std::move(vector))
+          , vector(owned_vector.get())
+          , communicator(communicator)
+        {}
+
+        /**
+         * Refer to @p vector.
+         */
+        NVectorContent(VectorType &vector, const MPI_Comm &communicator)
+          : vector(&vector)
+          , communicator(communicator)
+        {}
+
+        /**
+         * The wrapped vector.
+         */
+        VectorType &
+        get() const
+        {
+          return *vector;
+        }
+
+        /**
+         * The communicator of the wrapped vector.
+         */
+        const MPI_Comm &
+        get_mpi_communicator() const
+        {
+          return communicator;
+        }
+
+      private:
+        /**
+         * The vector if it is owned by this object.
+         */
+        std::unique_ptr<VectorType> owned_vector;
+
+        /**
+         * Pointer to the wrapped vector.
+         */
+        VectorType *vector;
+
+        /**
+         * The communicator used for the reductions.
+         */
+        const MPI_Comm communicator;
+      };
+
+
+
+      template <typename VectorType>
+      NVectorContent<VectorType> &
+      get_content(N_Vector v)
+      {
+        Assert(v != nullptr, ExcInternalError());
+        Assert(v->content != nullptr,
+               ExcMessage("The N_Vector does not contain a vector."));
+        return *static_cast<NVectorContent<VectorType> *>(v->content);
+      }
+
+
+
+      /**
+       * Set the entries of @p z to the value @p entry returns for each
+       * locally owned index. This is the fallback for the entry-wise
+       * operations that have no counterpart in the vector interface.
+       */
+      template <typename VectorType, typename Entry>
+      void
+      set_entries(VectorType &z, const Entry &entry)
+      {
+        for (const auto i : z.locally_owned_elements())
+          z(i) = entry(i);
+        z.compress(VectorOperation::insert);
+      }
+
+
+
+      /**
+       * Temporary vector with the layout of @p x, taken from a
+       * GrowingVectorMemory pool to avoid allocations in the norms SUNDIALS
+       * computes in every step.
+       */
+      template <typename VectorType>
+      typename VectorMemory<VectorType>::Pointer
+      get_temporary(const VectorType &x)
+      {
+        GrowingVectorMemory<VectorType>            mem;
+        typename VectorMemory<VectorType>::Pointer tmp(mem);
+        tmp->reinit(x, true);
+        return tmp;
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create_empty_nvector();
+
+
+
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+      template <typename VectorType>
+      N_Vector_ID
+      get_vector_id(N_Vector)
+      {
+        return SUNDIALS_NVEC_CUSTOM;
+      }
+#  endif
+
+
+
+      template <typename VectorType>
+      N_Vector
+      clone_empty(N_Vector)
+      {
+        return create_empty_nvector<VectorType>();
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      clone(N_Vector w)
+      {
+        NVectorContent<VectorType> &content = get_content<VectorType>(w);
+
+        auto vector = std::make_unique<VectorType>();
+        vector->reinit(content.get());
+
+        N_Vector v = create_empty_nvector<VectorType>();
+        v->content = new NVectorContent<VectorType>(
+          std::move(vector), content.get_mpi_communicator());
+        return v;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      destroy(N_Vector v)
+      {
+        if (v == nullptr)
+          return;
+        delete static_cast<NVectorContent<VectorType> *>(v->content);
+        delete v->ops;
+        delete v;
+      }
+
+
+
+      template <typename VectorType>
+      void
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+      space(N_Vector v, sunindextype *lrw, sunindextype *liw)
+#  else
+      space(N_Vector v, long int *lrw, long int *liw)
+#  endif
+      {
+        *lrw = get_content<VectorType>(v)
+                 .get()
+                 .locally_owned_elements()
+                 .n_elements();
+        *liw = 1;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      linear_sum(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z)
+      {
+        VectorType &      z_vector = get_content<VectorType>(z).get();
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        const VectorType &y_vector = get_content<VectorType>(y).get();
+
+        if (&z_vector == &x_vector)
+          z_vector.sadd(a, b, y_vector);
+        else if (&z_vector == &y_vector)
+          z_vector.sadd(b, a, x_vector);
+        else
+          {
+            z_vector.equ(a, x_vector);
+            z_vector.add(b, y_vector);
+          }
+      }
+
+
+
+      template <typename VectorType>
+      void
+      set_constant(realtype c, N_Vector z)
+      {
+        get_content<VectorType>(z).get() = c;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      product(N_Vector x, N_Vector y, N_Vector z)
+      {
+        VectorType &      z_vector = get_content<VectorType>(z).get();
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        const VectorType &y_vector = get_content<VectorType>(y).get();
+
+        if (&z_vector == &y_vector)
+          z_vector.scale(x_vector);
+        else
+          {
+            if (&z_vector != &x_vector)
+              z_vector = x_vector;
+            z_vector.scale(y_vector);
+          }
+      }
+
+
+
+      template <typename VectorType>
+      void
+      divide(N_Vector x, N_Vector y, N_Vector z)
+      {
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        const VectorType &y_vector = get_content<VectorType>(y).get();
+        set_entries(get_content<VectorType>(z).get(),
+                    [&](const types::global_dof_index i) {
+                      return x_vector(i) / y_vector(i);
+                    });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      scale(realtype c, N_Vector x, N_Vector z)
+      {
+        VectorType &      z_vector = get_content<VectorType>(z).get();
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+
+        if (&z_vector == &x_vector)
+          z_vector *= c;
+        else
+          z_vector.equ(c, x_vector);
+      }
+
+
+
+      template <typename VectorType>
+      void
+      absolute_value(N_Vector x, N_Vector z)
+      {
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        set_entries(get_content<VectorType>(z).get(),
+                    [&](const types::global_dof_index i) {
+                      return std::abs(x_vector(i));
+                    });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      inverse(N_Vector x, N_Vector z)
+      {
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        set_entries(get_content<VectorType>(z).get(),
+                    [&](const types::global_dof_index i) {
+                      return realtype(1.) / x_vector(i);
+                    });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      add_constant(N_Vector x, realtype b, N_Vector z)
+      {
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        set_entries(get_content<VectorType>(z).get(),
+                    [&](const types::global_dof_index i) {
+                      return x_vector(i) + b;
+                    });
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      dot_product(N_Vector x, N_Vector y)
+      {
+        return get_content<VectorType>(x).get() *
+               get_content<VectorType>(y).get();
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      max_norm(N_Vector x)
+      {
+        return get_content<VectorType>(x).get().linfty_norm();
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_l2_norm(N_Vector x, N_Vector w)
+      {
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+
+        typename VectorMemory<VectorType>::Pointer tmp =
+          get_temporary(x_vector);
+        *tmp = x_vector;
+        tmp->scale(get_content<VectorType>(w).get());
+        return tmp->l2_norm();
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm(N_Vector x, N_Vector w)
+      {
+        const VectorType &vector = get_content<VectorType>(x).get();
+        return weighted_l2_norm<VectorType>(x, w) /
+               std::sqrt(static_cast<realtype>(vector.size()));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm_mask(N_Vector x, N_Vector w, N_Vector id)
+      {
+        const VectorType &x_vector  = get_content<VectorType>(x).get();
+        const VectorType &w_vector  = get_content<VectorType>(w).get();
+        const VectorType &id_vector = get_content<VectorType>(id).get();
+
+        typename VectorMemory<VectorType>::Pointer tmp =
+          get_temporary(x_vector);
+        set_entries(*tmp, [&](const types::global_dof_index i) {
+          return id_vector(i) > 0. ? x_vector(i) * w_vector(i) : 0.;
+        });
+        return tmp->l2_norm() /
+               std::sqrt(static_cast<realtype>(x_vector.size()));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_element(N_Vector x)
+      {
+        const NVectorContent<VectorType> &content = get_content<VectorType>(x);
+        const VectorType &                x_vector = content.get();
+
+        realtype local_min = std::numeric_limits<realtype>::max();
+        for (const auto i : x_vector.locally_owned_elements())
+          local_min = std::min<realtype>(local_min, x_vector(i));
+        return Utilities::MPI::min(local_min, content.get_mpi_communicator());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      l1_norm(N_Vector x)
+      {
+        return get_content<VectorType>(x).get().l1_norm();
+      }
+
+
+
+      template <typename VectorType>
+      void
+      compare(realtype c, N_Vector x, N_Vector z)
+      {
+        const VectorType &x_vector = get_content<VectorType>(x).get();
+        set_entries(get_content<VectorType>(z).get(),
+                    [&](const types::global_dof_index i) {
+                      return std::abs(x_vector(i)) >= c ? 1. : 0.;
+                    });
+      }
+
+
+
+      template <typename VectorType>
+      booleantype
+      inverse_test(N_Vector x, N_Vector z)
+      {
+        const NVectorContent<VectorType> &content = get_content<VectorType>(x);
+        const VectorType &                x_vector = content.get();
+
+        // the entries of z are only defined where x is nonzero
+        int all_nonzero = 1;
+        set_entries(get_content<VectorType>(z).get(),
+                    [&](const types::global_dof_index i) {
+                      if (x_vector(i) == 0.)
+                        {
+                          all_nonzero = 0;
+                          return realtype();
+                        }
+                      return realtype(1.) / x_vector(i);
+                    });
+        all_nonzero =
+          Utilities::MPI::min(all_nonzero, content.get_mpi_communicator());
+#  if DEAL_II_SUNDIALS_VERSION_GTE(2, 0, 0)
+        return all_nonzero == 1 ? SUNTRUE : SUNFALSE;
+#  else
+        return all_nonzero == 1 ? TRUE : FALSE;
+#  endif
+      }
+
+
+
+      template <typename VectorType>
+      booleantype
+      constraint_mask(N_Vector c, N_Vector x, N_Vector m)
+      {
+        const NVectorContent<VectorType> &content = get_content<VectorType>(x);
+        const VectorType &                x_vector = content.get();
+        const VectorType &c_vector = get_content<VectorType>(c).get();
+
+        // m is set to one where x violates the constraint encoded in c: a
+        // magnitude of two requires x to be positive (or negative), one
+        // nonnegative (or nonpositive), and zero means no constraint.
+        int all_satisfied = 1;
+        set_entries(get_content<VectorType>(m).get(),
+                    [&](const types::global_dof_index i) {
+                      const realtype product = x_vector(i) * c_vector(i);
+                      const realtype abs_c   = std::abs(c_vector(i));
+                      if ((abs_c > 1.5 && product <= 0.) ||
+                          (abs_c > 0.5 && product < 0.))
+                        {
+                          all_satisfied = 0;
+                          return realtype(1.);
+                        }
+                      return realtype();
+                    });
+        all_satisfied =
+          Utilities::MPI::min(all_satisfied, content.get_mpi_communicator());
+#  if DEAL_II_SUNDIALS_VERSION_GTE(2, 0, 0)
+        return all_satisfied == 1 ? SUNTRUE : SUNFALSE;
+#  else
+        return all_satisfied == 1 ? TRUE : FALSE;
+#  endif
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_quotient(N_Vector num, N_Vector denom)
+      {
+        const NVectorContent<VectorType> &content =
+          get_content<VectorType>(num);
+        const VectorType &num_vector   = content.get();
+        const VectorType &denom_vector = get_content<VectorType>(denom).get();
+
+        realtype local_min = BIG_REAL;
+        for (const auto i : num_vector.locally_owned_elements())
+          if (denom_vector(i) != 0.)
+            local_min =
+              std::min<realtype>(local_min, num_vector(i) / denom_vector(i));
+        return Utilities::MPI::min(local_min, content.get_mpi_communicator());
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create_empty_nvector()
+      {
+        N_Vector v = new _generic_N_Vector;
+        v->content = nullptr;
+        v->ops     = new _generic_N_Vector_Ops();
+
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+        v->ops->nvgetvectorid = get_vector_id<VectorType>;
+#  endif
+        v->ops->nvclone        = clone<VectorType>;
+        v->ops->nvcloneempty   = clone_empty<VectorType>;
+        v->ops->nvdestroy      = destroy<VectorType>;
+        v->ops->nvspace        = space<VectorType>;
+        v->ops->nvlinearsum    = linear_sum<VectorType>;
+        v->ops->nvconst        = set_constant<VectorType>;
+        v->ops->nvprod         = product<VectorType>;
+        v->ops->nvdiv          = divide<VectorType>;
+        v->ops->nvscale        = scale<VectorType>;
+        v->ops->nvabs          = absolute_value<VectorType>;
+        v->ops->nvinv          = inverse<VectorType>;
+        v->ops->nvaddconst     = add_constant<VectorType>;
+        v->ops->nvdotprod      = dot_product<VectorType>;
+        v->ops->nvmaxnorm      = max_norm<VectorType>;
+        v->ops->nvwrmsnorm     = weighted_rms_norm<VectorType>;
+        v->ops->nvwrmsnormmask = weighted_rms_norm_mask<VectorType>;
+        v->ops->nvmin          = min_element<VectorType>;
+        v->ops->nvwl2norm      = weighted_l2_norm<VectorType>;
+        v->ops->nvl1norm       = l1_norm<VectorType>;
+        v->ops->nvcompare      = compare<VectorType>;
+        v->ops->nvinvtest      = inverse_test<VectorType>;
+        v->ops->nvconstrmask   = constraint_mask<VectorType>;
+        v->ops->nvminquotient  = min_quotient<VectorType>;
+
+        return v;
+      }
+    } // namespace NVectorOperations
+
+
+
+    template <typename VectorType>
+    N_Vector
+    create_nvector(const VectorType &vector, const MPI_Comm &communicator)
+    {
+      N_Vector v = NVectorOperations::create_empty_nvector<VectorType>();
+      v->content = new NVectorOperations::NVectorContent<VectorType>(
+        std::make_unique<VectorType>(vector), communicator);
+      return v;
+    }
+
+
+
+    template <typename VectorType>
+    N_Vector
+    make_nvector_view(VectorType &vector, const MPI_Comm &communicator)
+    {
+      N_Vector v = NVectorOperations::create_empty_nvector<VectorType>();
+      v->content =
+        new NVectorOperations::NVectorContent<VectorType>(vector, communicator);
+      return v;
+    }
+
+
+
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector v)
+    {
+      return &NVectorOperations::get_content<VectorType>(v).get();
+    }
+
+
+
+    template <typename VectorType>
+    const VectorType *
+    unwrap_nvector_const(N_Vector v)
+    {
+      return &NVectorOperations::get_content<VectorType>(v).get();
+    }
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_templates_h
@@ -0,0 +1,180 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/asynchronous_writer.h>
+
+#include <fstream>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+AsynchronousWriter::AsynchronousWriter(const unsigned int n_threads,
+                                       const std::size_t  max_queued_bytes)
+  : queued_bytes(0)
+  , queued_jobs(0)
+  , max_queued_bytes(max_queued_bytes)
+  , stop_workers(false)
+{
+  Assert(n_threads > 0,
+         ExcMessage("At least one worker thread is needed to write output."));
+  for (unsigned int i = 0; i < n_threads; ++i)
+    workers.emplace_back([this]() { run_worker(); });
+}
+
+
+
+AsynchronousWriter::~AsynchronousWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop_workers = true;
+  }
+  job_available.notify_all();
+
+  // the workers only stop once the queue is empty, so all pending output
+  // gets written
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+
+
+AsynchronousWriter &
+AsynchronousWriter::instance()
+{
+  static AsynchronousWriter writer;
+  return writer;
+}
+
+
+
+std::future<void>
+AsynchronousWriter::write_file(const std::string &filename,
+                               std::string &&     data)
+{
+  const std::size_t n_bytes = data.size();
+  const auto        buffer  = std::make_shared<std::string>(std::move(data));
+  return submit(std::function<void()>([filename, buffer]() {
+                  std::ofstream out(filename, std::ios::binary);
+                  AssertThrow(out, ExcFileNotOpen(filename));
+                  out.write(buffer->data(), buffer->size());
+                  out.close();
+                  AssertThrow(out, ExcIO());
+                }),
+                n_bytes);
+}
+
+
+
+void
+AsynchronousWriter::wait()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  job_completed.wait(lock, [this]() { return queued_jobs == 0; });
+}
+
+
+
+void
+AsynchronousWriter::set_max_queued_bytes(const std::size_t max_queued_bytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->max_queued_bytes = max_queued_bytes;
+  }
+  // a larger limit may allow waiting submitters to continue
+  job_completed.notify_all();
+}
+
+
+
+std::size_t
+AsynchronousWriter::n_queued_bytes() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return queued_bytes;
+}
+
+
+
+unsigned int
+AsynchronousWriter::n_queued_jobs() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return queued_jobs;
+}
+
+
+
+void
+AsynchronousWriter::enqueue(std::function<void()> &&job,
+                            const std::size_t       n_bytes)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    Assert(stop_workers == false,
+           ExcMessage("Jobs can not be submitted while the writer is being "
+                      "destroyed."));
+
+    // wait until the job fits into the memory limit, but always accept it
+    // if nothing else is pending
+    job_completed.wait(lock, [this, n_bytes]() {
+      return queued_jobs == 0 || queued_bytes + n_bytes <= max_queued_bytes;
+    });
+
+    queue.emplace_back(std::move(job), n_bytes);
+    queued_bytes += n_bytes;
+    ++queued_jobs;
+  }
+  job_available.notify_one();
+}
+
+
+
+void
+AsynchronousWriter::run_worker()
+{
+  while (true)
+    {
+      std::pair<std::function<void()>, std::size_t> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        job_available.wait(lock,
+                           [this]() { return stop_workers || !queue.empty(); });
+        if (queue.empty())
+          return;
+
+        job = std::move(queue.front());
+        queue.pop_front();
+      }
+
+      // the jobs are packaged tasks that store exceptions in their futures,
+      // so this call does not throw
+      job.first();
+
+      // release the memory held by the job before signaling its completion
+      job.first = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued_bytes -= job.second;
+        --queued_jobs;
+      }
+      job_completed.notify_all();
+    }
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -55,6 +55,23 @@ namespace Utilities
       cusparseStatus_t cusparse_error_code = cusparseDestroy(cusparse_handle);
       AssertCusparse(cusparse_error_code);
     }
+
+
+
+    void
+    Handle::set_stream(const cudaStream_t stream)
+    {
+      cusolverStatus_t cusolver_error_code =
+        cusolverDnSetStream(cusolver_dn_handle, stream);
+      AssertCusolver(cusolver_error_code);
+
+      cusolver_error_code = cusolverSpSetStream(cusolver_sp_handle, stream);
+      AssertCusolver(cusolver_error_code);
+
+      cusparseStatus_t cusparse_error_code =
+        cusparseSetStream(cusparse_handle, stream);
+      AssertCusparse(cusparse_error_code);
+    }
   } // namespace CUDA
 } // namespace Utilities
 
@@ -31,9 +31,12 @@
 //    array of nodes.
 //////////////////////////////////////////////////////////////////////
 
+#include <deal.II/base/asynchronous_writer.h>
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -45,10 +48,14 @@
 #include <cstring>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <sstream>
+#include <type_traits>
+#include <unordered_map>
 
 // we use uint32_t and uint8_t below, which are declared here:
 #include <cstdint>
@@ -61,6 +68,10 @@
 #  include <hdf5.h>
 #endif
 
+#ifdef DEAL_II_WITH_ADIOS2
+#  include <adios2.h>
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -103,9 +114,18 @@ namespace
       }
   }
 
+  /**
+   * Size in bytes of the blocks the data is split into before compression.
+   * Each block is compressed independently, which allows to compress the
+   * blocks in parallel. VTK readers accept any number of blocks; the block
+   * size is chosen large enough to not affect the compression ratio.
+   */
+  constexpr std::size_t vtu_compression_block_size = 1 << 20;
+
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
-   * result is then written to the given stream.
+   * result is then written to the given stream. The data is split into blocks
+   * of size vtu_compression_block_size that are compressed in parallel.
    */
   template <typename T>
   void
@@ -115,36 +135,80 @@ namespace
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(data.size() * sizeof(T));
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err =
-          compress2(&compressed_data[0],
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
-
-        // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        const std::size_t n_bytes  = data.size() * sizeof(T);
+        const std::size_t n_blocks = (n_bytes + vtu_compression_block_size - 1) /
+                                     vtu_compression_block_size;
+        const std::size_t last_block_size =
+          n_bytes - (n_blocks - 1) * vtu_compression_block_size;
+        const int compression_level =
+          get_zlib_compression_level(flags.compression_level);
+
+        // allocate a buffer for each block and compress the blocks in
+        // parallel
+        std::vector<std::vector<unsigned char>> compressed_blocks(n_blocks);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b)
+              {
+                const std::size_t block_size = (b == n_blocks - 1) ?
+                                                 last_block_size :
+                                                 vtu_compression_block_size;
+                auto compressed_data_length = compressBound(block_size);
+                compressed_blocks[b].resize(compressed_data_length);
+
+                int err = compress2(
+                  compressed_blocks[b].data(),
+                  &compressed_data_length,
+                  reinterpret_cast<const Bytef *>(data.data()) +
+                    b * vtu_compression_block_size,
+                  block_size,
+                  compression_level);
+                (void)err;
+                Assert(err == Z_OK, ExcInternalError());
+
+                // Discard the unnecessary bytes
+                compressed_blocks[b].resize(compressed_data_length);
+              }
+          },
+          1);
+
+        // now encode the compression header: number of blocks, size of
+        // block, size of last block, and the list of compressed sizes of the
+        // blocks
+        std::vector<uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = static_cast<uint32_t>(n_blocks);
+        compression_header[1] = static_cast<uint32_t>(
+          n_blocks > 1 ? vtu_compression_block_size : last_block_size);
+        compression_header[2] = static_cast<uint32_t>(last_block_size);
+        std::size_t compressed_size = 0;
+        for (std::size_t b = 0; b < n_blocks; ++b)
+          {
+            compression_header[3 + b] =
+              static_cast<uint32_t>(compressed_blocks[b].size());
+            compressed_size += compressed_blocks[b].size();
+          }
+
+        // the compressed blocks are encoded together, as the base64 encoding
+        // of the data must not be interrupted between blocks
+        std::vector<unsigned char> compressed_data;
+        compressed_data.reserve(compressed_size);
+        for (std::vector<unsigned char> &block : compressed_blocks)
+          {
+            compressed_data.insert(compressed_data.end(),
+                                   block.begin(),
+                                   block.end());
+            block = std::vector<unsigned char>();
+          }
 
         const auto header_start =
-          reinterpret_cast<const unsigned char *>(&compression_header[0]);
+          reinterpret_cast<const unsigned char *>(compression_header.data());
 
         output_stream << Utilities::encode_base64(
-                           {header_start, header_start + 4 * sizeof(uint32_t)})
+                           {header_start,
+                            header_start +
+                              compression_header.size() * sizeof(uint32_t)})
                       << Utilities::encode_base64(compressed_data);
       }
   }
@@ -332,26 +396,12 @@ namespace DataOutBase
   {
     node_dim = dim;
 
-    Point<3> int_pt;
+    // Only record the point here. The points are numbered, and duplicates
+    // merged, for all points at once in flush_points()
+    if (index >= written_points.size())
+      written_points.resize(index + 1);
     for (unsigned int d = 0; d < dim; ++d)
-      int_pt(d) = p(d);
-
-    const Map3DPoint::const_iterator it = existing_points.find(int_pt);
-    unsigned int                     internal_ind;
-
-    // If the point isn't in the set, or we're not filtering duplicate points,
-    // add it
-    if (it == existing_points.end() || !flags.filter_duplicate_vertices)
-      {
-        internal_ind = existing_points.size();
-        existing_points.insert(std::make_pair(int_pt, internal_ind));
-      }
-    else
-      {
-        internal_ind = it->second;
-      }
-    // Now add the index to the list of filtered points
-    filtered_points[index] = internal_ind;
+      written_points[index](d) = p(d);
   }
 
 
@@ -360,6 +410,9 @@ namespace DataOutBase
   DataOutFilter::internal_add_cell(const unsigned int cell_index,
                                    const unsigned int pt_index)
   {
+    AssertIndexRange(pt_index, filtered_points.size());
+    if (cell_index >= filtered_cells.size())
+      filtered_cells.resize(cell_index + 1);
     filtered_cells[cell_index] = filtered_points[pt_index];
   }
 
@@ -370,12 +423,9 @@ namespace DataOutBase
   {
     node_data.resize(existing_points.size() * node_dim);
 
-    for (const auto &existing_point : existing_points)
-      {
-        for (unsigned int d = 0; d < node_dim; ++d)
-          node_data[node_dim * existing_point.second + d] =
-            existing_point.first(d);
-      }
+    for (unsigned int i = 0; i < existing_points.size(); ++i)
+      for (unsigned int d = 0; d < node_dim; ++d)
+        node_data[node_dim * i + d] = existing_points[i](d);
   }
 
 
@@ -386,11 +436,8 @@ namespace DataOutBase
   {
     cell_data.resize(filtered_cells.size());
 
-    for (const auto &filtered_cell : filtered_cells)
-      {
-        cell_data[filtered_cell.first] =
-          filtered_cell.second + local_node_offset;
-      }
+    for (unsigned int i = 0; i < filtered_cells.size(); ++i)
+      cell_data[i] = filtered_cells[i] + local_node_offset;
   }
 
 
@@ -445,7 +492,67 @@ namespace DataOutBase
 
   void
   DataOutFilter::flush_points()
-  {}
+  {
+    const unsigned int n_points = written_points.size();
+    filtered_points.resize(n_points);
+
+    if (!flags.filter_duplicate_vertices)
+      {
+        std::iota(filtered_points.begin(), filtered_points.end(), 0u);
+        existing_points.swap(written_points);
+        written_points.clear();
+        return;
+      }
+
+    // Find the first occurrence of each point. To this end, the points are
+    // distributed to buckets by their hash, and the buckets are processed in
+    // parallel. Since the indices in each bucket are sorted, the first index
+    // inserted into a bucket's map is that of the first occurrence.
+    const unsigned int n_buckets =
+      (n_points < 4096 ? 1 : 4 * MultithreadInfo::n_threads());
+    std::vector<std::size_t> hashes(n_points);
+    parallel::apply_to_subranges(
+      0u,
+      n_points,
+      [this, &hashes](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          hashes[i] = Point3Hash()(written_points[i]);
+      },
+      1024);
+
+    std::vector<std::vector<unsigned int>> buckets(n_buckets);
+    for (auto &bucket : buckets)
+      bucket.reserve(n_points / n_buckets + 1);
+    for (unsigned int i = 0; i < n_points; ++i)
+      buckets[hashes[i] % n_buckets].push_back(i);
+
+    std::vector<unsigned int> first_occurrence(n_points);
+    Threads::TaskGroup<>      tasks;
+    for (const auto &bucket : buckets)
+      tasks += Threads::new_task([this, &bucket, &first_occurrence]() {
+        std::unordered_map<Point<3>, unsigned int, Point3Hash> bucket_points;
+        bucket_points.reserve(bucket.size());
+        for (const unsigned int i : bucket)
+          first_occurrence[i] =
+            bucket_points.emplace(written_points[i], i).first->second;
+      });
+    tasks.join_all();
+
+    // Number the points in the order of their first occurrence. The first
+    // occurrence of a point always precedes its duplicates, so the internal
+    // index of a duplicate has already been set when it is reached.
+    existing_points.clear();
+    for (unsigned int i = 0; i < n_points; ++i)
+      if (first_occurrence[i] == i)
+        {
+          filtered_points[i] = existing_points.size();
+          existing_points.push_back(written_points[i]);
+        }
+      else
+        filtered_points[i] = filtered_points[first_occurrence[i]];
+
+    written_points.clear();
+  }
 
 
 
@@ -1590,131 +1697,519 @@ namespace
 
     return stream;
   }
-} // namespace
 
 
 
-namespace DataOutBase
-{
-  const unsigned int Deal_II_IntermediateFlags::format_version = 3;
-
+  /**
+   * Write a piece without points and cells, but with the declarations of all
+   * data fields, to a vtu file.
+   */
+  void
+  write_empty_vtu_piece(
+    const std::vector<std::string> &data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &           nonscalar_data_ranges,
+    std::ostream &out)
+  {
+    // This is the minimal file that is accepted by paraview and visit. if we
+    // remove the field definitions, visit is complaining.
+    out << "<Piece NumberOfPoints=\"0\" NumberOfCells=\"0\" >\n"
+        << "<Cells>\n"
+        << "<DataArray type=\"UInt8\" Name=\"types\"></DataArray>\n"
+        << "</Cells>\n"
+        << "  <PointData Scalars=\"scalars\">\n";
+    std::vector<bool> data_set_written(data_names.size(), false);
+    for (const auto &nonscalar_data_range : nonscalar_data_ranges)
+      {
+        // mark these components as already written:
+        for (unsigned int i = std::get<0>(nonscalar_data_range);
+             i <= std::get<1>(nonscalar_data_range);
+             ++i)
+          data_set_written[i] = true;
 
-  template <int dim, int spacedim>
-  const unsigned int Patch<dim, spacedim>::space_dim;
+        // write the header. concatenate all the component names with double
+        // underscores unless a vector name has been specified
+        out << "    <DataArray type=\"Float32\" Name=\"";
 
+        if (!std::get<2>(nonscalar_data_range).empty())
+          out << std::get<2>(nonscalar_data_range);
+        else
+          {
+            for (unsigned int i = std::get<0>(nonscalar_data_range);
+                 i < std::get<1>(nonscalar_data_range);
+                 ++i)
+              out << data_names[i] << "__";
+            out << data_names[std::get<1>(nonscalar_data_range)];
+          }
 
-  template <int dim, int spacedim>
-  const unsigned int Patch<dim, spacedim>::no_neighbor;
+        out << "\" NumberOfComponents=\"3\"></DataArray>\n";
+      }
 
+    for (unsigned int data_set = 0; data_set < data_names.size(); ++data_set)
+      if (data_set_written[data_set] == false)
+        {
+          out << "    <DataArray type=\"Float32\" Name=\""
+              << data_names[data_set] << "\"></DataArray>\n";
+        }
 
-  template <int dim, int spacedim>
-  Patch<dim, spacedim>::Patch()
-    : patch_index(no_neighbor)
-    , n_subdivisions(1)
-    , points_are_available(false)
-  // all the other data has a constructor of its own, except for the "neighbors"
-  // field, which we set to invalid values.
-  {
-    for (unsigned int i : GeometryInfo<dim>::face_indices())
-      neighbors[i] = no_neighbor;
+    out << "  </PointData>\n";
+    out << "</Piece>\n";
 
-    AssertIndexRange(dim, spacedim + 1);
-    Assert(spacedim <= 3, ExcNotImplemented());
+    out << std::flush;
   }
 
 
 
-  template <int dim, int spacedim>
-  bool
-  Patch<dim, spacedim>::operator==(const Patch &patch) const
+  /**
+   * Write the time and the cycle of the simulation stored in @p flags, if
+   * they have been set, as field data of a vtu file.
+   */
+  void
+  write_vtu_field_data(const DataOutBase::VtkFlags &flags, std::ostream &out)
   {
-    // TODO: make tolerance relative
-    const double epsilon = 3e-16;
-    for (const unsigned int i : GeometryInfo<dim>::vertex_indices())
-      if (vertices[i].distance(patch.vertices[i]) > epsilon)
-        return false;
-
-    for (unsigned int i : GeometryInfo<dim>::face_indices())
-      if (neighbors[i] != patch.neighbors[i])
-        return false;
-
-    if (patch_index != patch.patch_index)
-      return false;
-
-    if (n_subdivisions != patch.n_subdivisions)
-      return false;
-
-    if (points_are_available != patch.points_are_available)
-      return false;
-
-    if (data.n_rows() != patch.data.n_rows())
-      return false;
-
-    if (data.n_cols() != patch.data.n_cols())
-      return false;
-
-    for (unsigned int i = 0; i < data.n_rows(); ++i)
-      for (unsigned int j = 0; j < data.n_cols(); ++j)
-        if (data[i][j] != patch.data[i][j])
-          return false;
-
-    return true;
-  }
-
+    // if desired, output time and cycle of the simulation, following the
+    // instructions at
+    // http://www.visitusers.org/index.php?title=Time_and_Cycle_in_VTK_files
+    const unsigned int n_metadata =
+      ((flags.cycle != std::numeric_limits<unsigned int>::min() ? 1 : 0) +
+       (flags.time != std::numeric_limits<double>::min() ? 1 : 0));
+    if (n_metadata > 0)
+      out << "<FieldData>\n";
 
+    if (flags.cycle != std::numeric_limits<unsigned int>::min())
+      {
+        out
+          << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
+          << flags.cycle << "</DataArray>\n";
+      }
+    if (flags.time != std::numeric_limits<double>::min())
+      {
+        out
+          << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
+          << flags.time << "</DataArray>\n";
+      }
 
-  template <int dim, int spacedim>
-  std::size_t
-  Patch<dim, spacedim>::memory_consumption() const
-  {
-    return (sizeof(vertices) / sizeof(vertices[0]) *
-              MemoryConsumption::memory_consumption(vertices[0]) +
-            sizeof(neighbors) / sizeof(neighbors[0]) *
-              MemoryConsumption::memory_consumption(neighbors[0]) +
-            MemoryConsumption::memory_consumption(patch_index) +
-            MemoryConsumption::memory_consumption(n_subdivisions) +
-            MemoryConsumption::memory_consumption(data) +
-            MemoryConsumption::memory_consumption(points_are_available));
+    if (n_metadata > 0)
+      out << "</FieldData>\n";
   }
 
 
 
-  template <int dim, int spacedim>
+  /**
+   * Write the <PointData> section of a vtu piece, given the values of all
+   * data sets at all nodes in @p data_vectors.
+   */
+  template <typename Number>
   void
-  Patch<dim, spacedim>::swap(Patch<dim, spacedim> &other_patch)
+  write_vtu_point_data(
+    const Table<2, Number> &        data_vectors,
+    const std::vector<std::string> &data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &           nonscalar_data_ranges,
+    const char *  ascii_or_binary,
+    VtuStream &   vtu_out,
+    std::ostream &out)
   {
-    std::swap(vertices, other_patch.vertices);
-    std::swap(neighbors, other_patch.neighbors);
-    std::swap(patch_index, other_patch.patch_index);
-    std::swap(n_subdivisions, other_patch.n_subdivisions);
-    data.swap(other_patch.data);
-    std::swap(points_are_available, other_patch.points_are_available);
-  }
-
+    const unsigned int n_data_sets = data_names.size();
+    const unsigned int n_nodes     = data_vectors.n_cols();
+    AssertDimension(data_vectors.n_rows(), n_data_sets);
 
+    out << "  <PointData Scalars=\"scalars\">\n";
 
-  template <int spacedim>
-  const unsigned int Patch<0, spacedim>::space_dim;
+    // when writing, first write out all vector data, then handle the scalar
+    // data sets that have been left over
+    std::vector<bool> data_set_written(n_data_sets, false);
+    for (const auto &range : nonscalar_data_ranges)
+      {
+        const auto  first_component = std::get<0>(range);
+        const auto  last_component  = std::get<1>(range);
+        const auto &name            = std::get<2>(range);
+        const bool  is_tensor =
+          (std::get<3>(range) ==
+           DataComponentInterpretation::component_is_part_of_tensor);
+        const unsigned int n_components = (is_tensor ? 9 : 3);
+        AssertThrow(last_component >= first_component,
+                    ExcLowerRange(last_component, first_component));
+        AssertThrow(last_component < n_data_sets,
+                    ExcIndexRange(last_component, 0, n_data_sets));
+        if (is_tensor)
+          {
+            AssertThrow((last_component + 1 - first_component <= 9),
+                        ExcMessage(
+                          "Can't declare a tensor with more than 9 components "
+                          "in VTK"));
+          }
+        else
+          {
+            AssertThrow((last_component + 1 - first_component <= 3),
+                        ExcMessage(
+                          "Can't declare a vector with more than 3 components "
+                          "in VTK"));
+          }
 
+        // mark these components as already written:
+        for (unsigned int i = first_component; i <= last_component; ++i)
+          data_set_written[i] = true;
 
-  template <int spacedim>
-  const unsigned int Patch<0, spacedim>::no_neighbor;
+        // write the header. concatenate all the component names with double
+        // underscores unless a vector name has been specified
+        out << "    <DataArray type=\"Float32\" Name=\"";
 
+        if (!name.empty())
+          out << name;
+        else
+          {
+            for (unsigned int i = first_component; i < last_component; ++i)
+              out << data_names[i] << "__";
+            out << data_names[last_component];
+          }
 
-  template <int spacedim>
-  unsigned int Patch<0, spacedim>::neighbors[1] = {
-    Patch<0, spacedim>::no_neighbor};
+        out << "\" NumberOfComponents=\"" << n_components << "\" format=\""
+            << ascii_or_binary << "\">\n";
 
-  template <int spacedim>
-  unsigned int Patch<0, spacedim>::n_subdivisions = 1;
+        // now write data. pad all vectors to have three components
+        std::vector<float> data;
+        data.reserve(n_nodes * n_components);
 
-  template <int spacedim>
-  Patch<0, spacedim>::Patch()
-    : patch_index(no_neighbor)
-    , points_are_available(false)
-  {
-    Assert(spacedim <= 3, ExcNotImplemented());
-  }
+        for (unsigned int n = 0; n < n_nodes; ++n)
+          {
+            if (!is_tensor)
+              {
+                switch (last_component - first_component)
+                  {
+                    case 0:
+                      data.push_back(data_vectors(first_component, n));
+                      data.push_back(0);
+                      data.push_back(0);
+                      break;
+
+                    case 1:
+                      data.push_back(data_vectors(first_component, n));
+                      data.push_back(data_vectors(first_component + 1, n));
+                      data.push_back(0);
+                      break;
+
+                    case 2:
+                      data.push_back(data_vectors(first_component, n));
+                      data.push_back(data_vectors(first_component + 1, n));
+                      data.push_back(data_vectors(first_component + 2, n));
+                      break;
+
+                    default:
+                      // Anything else is not yet implemented
+                      Assert(false, ExcInternalError());
+                  }
+              }
+            else
+              {
+                Tensor<2, 3> vtk_data;
+                vtk_data = 0.;
+
+                const unsigned int size = last_component - first_component + 1;
+                if (size == 1)
+                  // 1D, 1 element
+                  {
+                    vtk_data[0][0] = data_vectors(first_component, n);
+                  }
+                else if (size == 4)
+                  // 2D, 4 elements
+                  {
+                    for (unsigned int c = 0; c < size; ++c)
+                      {
+                        const auto ind =
+                          Tensor<2, 2>::unrolled_to_component_indices(c);
+                        vtk_data[ind[0]][ind[1]] =
+                          data_vectors(first_component + c, n);
+                      }
+                  }
+                else if (size == 9)
+                  // 3D 9 elements
+                  {
+                    for (unsigned int c = 0; c < size; ++c)
+                      {
+                        const auto ind =
+                          Tensor<2, 3>::unrolled_to_component_indices(c);
+                        vtk_data[ind[0]][ind[1]] =
+                          data_vectors(first_component + c, n);
+                      }
+                  }
+                else
+                  {
+                    Assert(false, ExcInternalError());
+                  }
+
+                // now put the tensor into data
+                // note we padd with zeros because VTK format always wants to
+                // see a 3x3 tensor, regardless of dimension
+                for (unsigned int i = 0; i < 3; ++i)
+                  for (unsigned int j = 0; j < 3; ++j)
+                    data.push_back(vtk_data[i][j]);
+              }
+          } // loop over nodes
+
+        vtu_out << data;
+        out << "    </DataArray>\n";
+
+      } // loop over ranges
+
+    // now do the left over scalar data sets
+    for (unsigned int data_set = 0; data_set < n_data_sets; ++data_set)
+      if (data_set_written[data_set] == false)
+        {
+          out << "    <DataArray type=\"Float32\" Name=\""
+              << data_names[data_set] << "\" format=\"" << ascii_or_binary
+              << "\">\n";
+
+          std::vector<float> data(data_vectors[data_set].begin(),
+                                  data_vectors[data_set].end());
+          vtu_out << data;
+          out << "    </DataArray>\n";
+        }
+
+    out << "  </PointData>\n";
+  }
+
+
+#ifdef DEAL_II_WITH_MPI
+  /**
+   * Write the vtu header, the pieces given by all processes in @p comm in the
+   * order of their rank, and the vtu footer to the file @p filename with
+   * MPI-IO. Pieces of different processes are written at the same time.
+   */
+  void
+  write_vtu_piece_in_parallel(const std::string &          piece,
+                              const DataOutBase::VtkFlags &flags,
+                              const std::string &          filename,
+                              const MPI_Comm               comm)
+  {
+    const int myrank = Utilities::MPI::this_mpi_process(comm);
+
+    MPI_Info info;
+    int ierr = MPI_Info_create(&info);
+    AssertThrowMPI(ierr);
+    MPI_File fh;
+    ierr = MPI_File_open(comm,
+                         DEAL_II_MPI_CONST_CAST(filename.c_str()),
+                         MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                         info,
+                         &fh);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_set_size(fh, 0); // delete the file contents
+    AssertThrowMPI(ierr);
+    // this barrier is necessary, because otherwise others might already write
+    // while one core is still setting the size to zero.
+    ierr = MPI_Barrier(comm);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Info_free(&info);
+    AssertThrowMPI(ierr);
+
+    // Rather than writing through the shared file pointer, which serializes
+    // the processes, every process computes the offset of its piece in the
+    // file from the sizes of the pieces on the processes with lower rank and
+    // then all processes write at the same time
+    std::string header;
+    if (myrank == 0)
+      {
+        std::stringstream ss;
+        DataOutBase::write_vtu_header(ss, flags);
+        header = ss.str();
+      }
+    unsigned long long header_size = header.size();
+    ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED_LONG_LONG, 0, comm);
+    AssertThrowMPI(ierr);
+
+    const unsigned long long my_piece_size = piece.size();
+    unsigned long long       piece_offset  = 0;
+    ierr = MPI_Exscan(&my_piece_size,
+                      &piece_offset,
+                      1,
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      comm);
+    AssertThrowMPI(ierr);
+    // the result of MPI_Exscan is undefined on the first process
+    if (myrank == 0)
+      piece_offset = 0;
+    const unsigned long long total_piece_size =
+      Utilities::MPI::sum(my_piece_size, comm);
+
+    // write header
+    if (myrank == 0)
+      {
+        ierr = MPI_File_write_at(fh,
+                                 0,
+                                 DEAL_II_MPI_CONST_CAST(header.c_str()),
+                                 header.size(),
+                                 MPI_CHAR,
+                                 MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    AssertThrow(my_piece_size <=
+                  static_cast<unsigned long long>(
+                    std::numeric_limits<int>::max()),
+                ExcMessage("The output of a single process in "
+                           "a parallel vtu output must be less than 2GB."));
+    ierr = MPI_File_write_at_all(fh,
+                                 header_size + piece_offset,
+                                 DEAL_II_MPI_CONST_CAST(piece.c_str()),
+                                 piece.size(),
+                                 MPI_CHAR,
+                                 MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+
+    // write footer
+    if (myrank == 0)
+      {
+        std::stringstream ss;
+        DataOutBase::write_vtu_footer(ss);
+        const std::string footer = ss.str();
+        ierr = MPI_File_write_at(fh,
+                                 header_size + total_piece_size,
+                                 DEAL_II_MPI_CONST_CAST(footer.c_str()),
+                                 footer.size(),
+                                 MPI_CHAR,
+                                 MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+    ierr = MPI_File_close(&fh);
+    AssertThrowMPI(ierr);
+  }
+#endif
+} // namespace
+
+
+
+namespace DataOutBase
+{
+  const unsigned int Deal_II_IntermediateFlags::format_version = 3;
+
+
+  template <int dim, int spacedim>
+  const unsigned int Patch<dim, spacedim>::space_dim;
+
+
+  template <int dim, int spacedim>
+  const unsigned int Patch<dim, spacedim>::no_neighbor;
+
+
+  template <int dim, int spacedim>
+  Patch<dim, spacedim>::Patch()
+    : patch_index(no_neighbor)
+    , n_subdivisions(1)
+    , points_are_available(false)
+  // all the other data has a constructor of its own, except for the "neighbors"
+  // field, which we set to invalid values.
+  {
+    for (unsigned int i : GeometryInfo<dim>::face_indices())
+      neighbors[i] = no_neighbor;
+
+    AssertIndexRange(dim, spacedim + 1);
+    Assert(spacedim <= 3, ExcNotImplemented());
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  Patch<dim, spacedim>::operator==(const Patch &patch) const
+  {
+    // TODO: make tolerance relative
+    const double epsilon = 3e-16;
+    for (const unsigned int i : GeometryInfo<dim>::vertex_indices())
+      if (vertices[i].distance(patch.vertices[i]) > epsilon)
+        return false;
+
+    for (unsigned int i : GeometryInfo<dim>::face_indices())
+      if (neighbors[i] != patch.neighbors[i])
+        return false;
+
+    if (patch_index != patch.patch_index)
+      return false;
+
+    if (n_subdivisions != patch.n_subdivisions)
+      return false;
+
+    if (points_are_available != patch.points_are_available)
+      return false;
+
+    if (data.n_rows() != patch.data.n_rows())
+      return false;
+
+    if (data.n_cols() != patch.data.n_cols())
+      return false;
+
+    for (unsigned int i = 0; i < data.n_rows(); ++i)
+      for (unsigned int j = 0; j < data.n_cols(); ++j)
+        if (data[i][j] != patch.data[i][j])
+          return false;
+
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  Patch<dim, spacedim>::memory_consumption() const
+  {
+    return (sizeof(vertices) / sizeof(vertices[0]) *
+              MemoryConsumption::memory_consumption(vertices[0]) +
+            sizeof(neighbors) / sizeof(neighbors[0]) *
+              MemoryConsumption::memory_consumption(neighbors[0]) +
+            MemoryConsumption::memory_consumption(patch_index) +
+            MemoryConsumption::memory_consumption(n_subdivisions) +
+            MemoryConsumption::memory_consumption(data) +
+            MemoryConsumption::memory_consumption(points_are_available));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Patch<dim, spacedim>::swap(Patch<dim, spacedim> &other_patch)
+  {
+    std::swap(vertices, other_patch.vertices);
+    std::swap(neighbors, other_patch.neighbors);
+    std::swap(patch_index, other_patch.patch_index);
+    std::swap(n_subdivisions, other_patch.n_subdivisions);
+    data.swap(other_patch.data);
+    std::swap(points_are_available, other_patch.points_are_available);
+  }
+
+
+
+  template <int spacedim>
+  const unsigned int Patch<0, spacedim>::space_dim;
+
+
+  template <int spacedim>
+  const unsigned int Patch<0, spacedim>::no_neighbor;
+
+
+  template <int spacedim>
+  unsigned int Patch<0, spacedim>::neighbors[1] = {
+    Patch<0, spacedim>::no_neighbor};
+
+  template <int spacedim>
+  unsigned int Patch<0, spacedim>::n_subdivisions = 1;
+
+  template <int spacedim>
+  Patch<0, spacedim>::Patch()
+    : patch_index(no_neighbor)
+    , points_are_available(false)
+  {
+    Assert(spacedim <= 3, ExcNotImplemented());
+  }
 
 
 
@@ -2255,12 +2750,14 @@ namespace DataOutBase
                      const unsigned int                   cycle,
                      const bool                           print_date_and_time,
                      const VtkFlags::ZlibCompressionLevel compression_level,
-                     const bool write_higher_order_cells)
+                     const bool write_higher_order_cells,
+                     const bool filter_duplicate_vertices)
     : time(time)
     , cycle(cycle)
     , print_date_and_time(print_date_and_time)
     , compression_level(compression_level)
     , write_higher_order_cells(write_higher_order_cells)
+    , filter_duplicate_vertices(filter_duplicate_vertices)
   {}
 
 
@@ -2432,7 +2929,8 @@ namespace DataOutBase
   template <int dim, int spacedim, typename StreamType>
   void
   write_high_order_cells(const std::vector<Patch<dim, spacedim>> &patches,
-                         StreamType &                             out)
+                         StreamType &                             out,
+                         const std::vector<unsigned int> &node_numbering = {})
   {
     Assert(dim <= 3 && dim > 1, ExcNotImplemented());
     unsigned int first_vertex_of_patch = 0;
@@ -2468,9 +2966,18 @@ namespace DataOutBase
                 connectivity[connectivity_index] = local_index;
               }
 
-        out.template write_high_order_cell<dim>(count++,
-                                                first_vertex_of_patch,
-                                                connectivity);
+        // if the nodes have been renumbered, translate the indices and pass
+        // them without an offset
+        if (node_numbering.empty())
+          out.template write_high_order_cell<dim>(count++,
+                                                  first_vertex_of_patch,
+                                                  connectivity);
+        else
+          {
+            for (unsigned int &index : connectivity)
+              index = node_numbering[first_vertex_of_patch + index];
+            out.template write_high_order_cell<dim>(count++, 0, connectivity);
+          }
 
         // finally update the number of the first vertex of this patch
         first_vertex_of_patch += Utilities::fixed_power<dim>(n);
@@ -2480,23 +2987,115 @@ namespace DataOutBase
   }
 
 
-  template <int dim, int spacedim, class StreamType>
+  /**
+   * Compute a numbering of the nodes of all @p patches in which nodes with
+   * the same coordinates and the same values in @p data_vectors, both
+   * compared in single precision, get the same number. The numbers are
+   * assigned in the order in which the nodes first appear. On return,
+   * @p node_numbering holds the new number of each node, and
+   * @p representatives the index of the first node with each new number.
+   * The coordinates of all nodes are returned in @p nodes.
+   */
+  template <int dim, int spacedim>
   void
-  write_data(const std::vector<Patch<dim, spacedim>> &patches,
-             unsigned int                             n_data_sets,
-             const bool                               double_precision,
-             StreamType &                             out)
+  compute_merged_node_numbering(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const Table<2, float> &                  data_vectors,
+    std::vector<Point<spacedim>> &           nodes,
+    std::vector<unsigned int> &              node_numbering,
+    std::vector<unsigned int> &              representatives)
   {
-    Assert(dim <= 3, ExcNotImplemented());
-    unsigned int count = 0;
-
+    nodes.clear();
     for (const auto &patch : patches)
       {
         const unsigned int n_subdivisions = patch.n_subdivisions;
         const unsigned int n              = n_subdivisions + 1;
-        // Length of loops in all dimensions
-        Assert((patch.data.n_rows() == n_data_sets &&
-                !patch.points_are_available) ||
+        const unsigned int n1             = (dim > 0) ? n : 1;
+        const unsigned int n2             = (dim > 1) ? n : 1;
+        const unsigned int n3             = (dim > 2) ? n : 1;
+
+        for (unsigned int i3 = 0; i3 < n3; ++i3)
+          for (unsigned int i2 = 0; i2 < n2; ++i2)
+            for (unsigned int i1 = 0; i1 < n1; ++i1)
+              nodes.push_back(compute_node(patch, i1, i2, i3, n_subdivisions));
+      }
+    const unsigned int n_nodes = nodes.size();
+    AssertDimension(data_vectors.n_cols(), n_nodes);
+
+    // set up the comparison keys from the bit patterns of the values in
+    // single precision, which gives a strict ordering also in the presence
+    // of NaNs
+    const unsigned int    key_length = spacedim + data_vectors.n_rows();
+    std::vector<uint32_t> keys(std::size_t(n_nodes) * key_length);
+    for (unsigned int i = 0; i < n_nodes; ++i)
+      {
+        uint32_t *key = keys.data() + std::size_t(i) * key_length;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const float coordinate = nodes[i][d];
+            std::memcpy(key + d, &coordinate, sizeof(float));
+          }
+        for (unsigned int c = 0; c < data_vectors.n_rows(); ++c)
+          std::memcpy(key + spacedim + c, &data_vectors(c, i), sizeof(float));
+      }
+
+    std::vector<unsigned int> sorted(n_nodes);
+    std::iota(sorted.begin(), sorted.end(), 0U);
+    const auto key_begin = [&](const unsigned int i) {
+      return keys.begin() + std::size_t(i) * key_length;
+    };
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [&](const unsigned int a, const unsigned int b) {
+                const int comparison = std::memcmp(&*key_begin(a),
+                                                   &*key_begin(b),
+                                                   key_length *
+                                                     sizeof(uint32_t));
+                return comparison < 0 || (comparison == 0 && a < b);
+              });
+
+    // within each group of equal keys, the first entry after sorting is the
+    // node with the smallest index
+    std::vector<unsigned int> first_of_group(n_nodes);
+    for (unsigned int i = 0; i < n_nodes; ++i)
+      first_of_group[sorted[i]] =
+        (i > 0 && std::equal(key_begin(sorted[i]),
+                             key_begin(sorted[i]) + key_length,
+                             key_begin(sorted[i - 1]))) ?
+          first_of_group[sorted[i - 1]] :
+          sorted[i];
+
+    node_numbering.resize(n_nodes);
+    representatives.clear();
+    for (unsigned int i = 0; i < n_nodes; ++i)
+      if (first_of_group[i] == i)
+        {
+          node_numbering[i] = representatives.size();
+          representatives.push_back(i);
+        }
+      else
+        node_numbering[i] = node_numbering[first_of_group[i]];
+  }
+
+
+
+  template <int dim, int spacedim, class StreamType>
+  void
+  write_data(const std::vector<Patch<dim, spacedim>> &patches,
+             unsigned int                             n_data_sets,
+             const bool                               double_precision,
+             StreamType &                             out)
+  {
+    Assert(dim <= 3, ExcNotImplemented());
+    unsigned int count = 0;
+
+    for (const auto &patch : patches)
+      {
+        const unsigned int n_subdivisions = patch.n_subdivisions;
+        const unsigned int n              = n_subdivisions + 1;
+        // Length of loops in all dimensions
+        Assert((patch.data.n_rows() == n_data_sets &&
+                !patch.points_are_available) ||
                  (patch.data.n_rows() == n_data_sets + spacedim &&
                   patch.points_are_available),
                ExcDimensionMismatch(patch.points_are_available ?
@@ -5108,85 +5707,14 @@ namespace DataOutBase
     if (patches.size() == 0)
       {
         // we still need to output a valid vtu file, because other CPUs might
-        // output data. This is the minimal file that is accepted by paraview
-        // and visit. if we remove the field definitions, visit is complaining.
-        out << "<Piece NumberOfPoints=\"0\" NumberOfCells=\"0\" >\n"
-            << "<Cells>\n"
-            << "<DataArray type=\"UInt8\" Name=\"types\"></DataArray>\n"
-            << "</Cells>\n"
-            << "  <PointData Scalars=\"scalars\">\n";
-        std::vector<bool> data_set_written(data_names.size(), false);
-        for (const auto &nonscalar_data_range : nonscalar_data_ranges)
-          {
-            // mark these components as already written:
-            for (unsigned int i = std::get<0>(nonscalar_data_range);
-                 i <= std::get<1>(nonscalar_data_range);
-                 ++i)
-              data_set_written[i] = true;
-
-            // write the header. concatenate all the component names with double
-            // underscores unless a vector name has been specified
-            out << "    <DataArray type=\"Float32\" Name=\"";
-
-            if (!std::get<2>(nonscalar_data_range).empty())
-              out << std::get<2>(nonscalar_data_range);
-            else
-              {
-                for (unsigned int i = std::get<0>(nonscalar_data_range);
-                     i < std::get<1>(nonscalar_data_range);
-                     ++i)
-                  out << data_names[i] << "__";
-                out << data_names[std::get<1>(nonscalar_data_range)];
-              }
-
-            out << "\" NumberOfComponents=\"3\"></DataArray>\n";
-          }
-
-        for (unsigned int data_set = 0; data_set < data_names.size();
-             ++data_set)
-          if (data_set_written[data_set] == false)
-            {
-              out << "    <DataArray type=\"Float32\" Name=\""
-                  << data_names[data_set] << "\"></DataArray>\n";
-            }
-
-        out << "  </PointData>\n";
-        out << "</Piece>\n";
-
-        out << std::flush;
-
+        // output data
+        write_empty_vtu_piece(data_names, nonscalar_data_ranges, out);
         return;
       }
 #endif
 
     // first up: metadata
-    //
-    // if desired, output time and cycle of the simulation, following the
-    // instructions at
-    // http://www.visitusers.org/index.php?title=Time_and_Cycle_in_VTK_files
-    {
-      const unsigned int n_metadata =
-        ((flags.cycle != std::numeric_limits<unsigned int>::min() ? 1 : 0) +
-         (flags.time != std::numeric_limits<double>::min() ? 1 : 0));
-      if (n_metadata > 0)
-        out << "<FieldData>\n";
-
-      if (flags.cycle != std::numeric_limits<unsigned int>::min())
-        {
-          out
-            << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
-            << flags.cycle << "</DataArray>\n";
-        }
-      if (flags.time != std::numeric_limits<double>::min())
-        {
-          out
-            << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
-            << flags.time << "</DataArray>\n";
-        }
-
-      if (n_metadata > 0)
-        out << "</FieldData>\n";
-    }
+    write_vtu_field_data(flags, out);
 
 
     VtuStream vtu_out(out, flags);
@@ -5220,10 +5748,7 @@ namespace DataOutBase
     // each patch is written as a linear cell.
     unsigned int n_points_per_cell = GeometryInfo<dim>::vertices_per_cell;
     if (flags.write_higher_order_cells)
-      {
-        n_cells           = patches.size();
-        n_points_per_cell = n_nodes / n_cells;
-      }
+      n_cells = patches.size();
 
     // in gmv format the vertex coordinates and the data have an order that is a
     // bit unpleasant (first all x coordinates, then all y coordinate, ...;
@@ -5245,6 +5770,28 @@ namespace DataOutBase
     Threads::Task<> reorder_task =
       Threads::new_task(fun_ptr, patches, data_vectors);
 
+    // if requested, number the nodes shared between the high-order cells
+    // only once. this needs the data values, so we have to wait for the
+    // reordering of the data vectors here
+    const bool merge_nodes =
+      flags.write_higher_order_cells && flags.filter_duplicate_vertices;
+    std::vector<Point<spacedim>> nodes;
+    std::vector<unsigned int>    node_numbering, representatives;
+    if (merge_nodes)
+      {
+        reorder_task.join();
+        compute_merged_node_numbering(
+          patches, data_vectors, nodes, node_numbering, representatives);
+
+        Table<2, float> merged_data_vectors(n_data_sets,
+                                            representatives.size());
+        for (unsigned int c = 0; c < n_data_sets; ++c)
+          for (unsigned int i = 0; i < representatives.size(); ++i)
+            merged_data_vectors(c, i) = data_vectors(c, representatives[i]);
+        data_vectors.swap(merged_data_vectors);
+        n_nodes = representatives.size();
+      }
+
     ///////////////////////////////
     // first make up a list of used vertices along with their coordinates
     //
@@ -5255,7 +5802,14 @@ namespace DataOutBase
     out << "  <Points>\n";
     out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\""
         << ascii_or_binary << "\">\n";
-    write_nodes(patches, vtu_out);
+    if (merge_nodes)
+      {
+        for (unsigned int i = 0; i < representatives.size(); ++i)
+          vtu_out.write_point(i, nodes[representatives[i]]);
+        vtu_out.flush_points();
+      }
+    else
+      write_nodes(patches, vtu_out);
     out << "    </DataArray>\n";
     out << "  </Points>\n\n";
     /////////////////////////////////
@@ -5264,7 +5818,7 @@ namespace DataOutBase
     out << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\""
         << ascii_or_binary << "\">\n";
     if (flags.write_higher_order_cells)
-      write_high_order_cells(patches, vtu_out);
+      write_high_order_cells(patches, vtu_out, node_numbering);
     else
       write_cells(patches, vtu_out);
     out << "    </DataArray>\n";
@@ -5274,9 +5828,19 @@ namespace DataOutBase
     out << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\""
         << ascii_or_binary << "\">\n";
 
+    // high-order cells have as many points as the subdivisions of their
+    // patch give, which may differ between the patches
     std::vector<int32_t> offsets(n_cells);
-    for (unsigned int i = 0; i < n_cells; ++i)
-      offsets[i] = (i + 1) * n_points_per_cell;
+    if (flags.write_higher_order_cells)
+      for (unsigned int i = 0, offset = 0; i < n_cells; ++i)
+        {
+          offset +=
+            Utilities::fixed_power<dim>(patches[i].n_subdivisions + 1);
+          offsets[i] = offset;
+        }
+    else
+      for (unsigned int i = 0; i < n_cells; ++i)
+        offsets[i] = (i + 1) * n_points_per_cell;
     vtu_out << offsets;
     out << "\n";
     out << "    </DataArray>\n";
@@ -5313,173 +5877,235 @@ namespace DataOutBase
 
     // now write the data vectors to @p{out} first make sure that all data is in
     // place
-    reorder_task.join();
+    if (!merge_nodes)
+      reorder_task.join();
 
     // then write data.  the 'POINT_DATA' means: node data (as opposed to cell
     // data, which we do not support explicitly here). all following data sets
     // are point data
-    out << "  <PointData Scalars=\"scalars\">\n";
+    write_vtu_point_data(data_vectors,
+                         data_names,
+                         nonscalar_data_ranges,
+                         ascii_or_binary,
+                         vtu_out,
+                         out);
 
-    // when writing, first write out all vector data, then handle the scalar
-    // data sets that have been left over
-    std::vector<bool> data_set_written(n_data_sets, false);
-    for (const auto &range : nonscalar_data_ranges)
+    // Finish up writing a valid XML file
+    out << " </Piece>\n";
+
+    // make sure everything now gets to disk
+    out.flush();
+
+    // assert the stream is still ok
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  template <int spacedim>
+  void
+  write_vtu_point_cloud(
+    const std::vector<Point<spacedim>> &points,
+    const Table<2, double> &            data,
+    const std::vector<std::string> &    data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    write_vtu_header(out, flags);
+    write_vtu_point_cloud_main(
+      points, data, data_names, nonscalar_data_ranges, flags, out);
+    write_vtu_footer(out);
+
+    out << std::flush;
+  }
+
+
+
+  template <int spacedim>
+  void
+  write_vtu_point_cloud_main(
+    const std::vector<Point<spacedim>> &points,
+    const Table<2, double> &            data,
+    const std::vector<std::string> &    data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    AssertThrow(out, ExcIO());
+
+    const unsigned int n_points = points.size();
+    AssertDimension(data.n_rows(), data_names.size());
+    Assert(data.n_rows() == 0 || data.n_cols() == n_points,
+           ExcDimensionMismatch(data.n_cols(), n_points));
+
+    // an empty piece still needs to declare all fields, see write_vtu_main()
+    if (n_points == 0)
       {
-        const auto  first_component = std::get<0>(range);
-        const auto  last_component  = std::get<1>(range);
-        const auto &name            = std::get<2>(range);
-        const bool  is_tensor =
-          (std::get<3>(range) ==
-           DataComponentInterpretation::component_is_part_of_tensor);
-        const unsigned int n_components = (is_tensor ? 9 : 3);
-        AssertThrow(last_component >= first_component,
-                    ExcLowerRange(last_component, first_component));
-        AssertThrow(last_component < n_data_sets,
-                    ExcIndexRange(last_component, 0, n_data_sets));
-        if (is_tensor)
-          {
-            AssertThrow((last_component + 1 - first_component <= 9),
-                        ExcMessage(
-                          "Can't declare a tensor with more than 9 components "
-                          "in VTK"));
-          }
-        else
-          {
-            AssertThrow((last_component + 1 - first_component <= 3),
-                        ExcMessage(
-                          "Can't declare a vector with more than 3 components "
-                          "in VTK"));
-          }
+        write_empty_vtu_piece(data_names, nonscalar_data_ranges, out);
+        return;
+      }
 
-        // mark these components as already written:
-        for (unsigned int i = first_component; i <= last_component; ++i)
-          data_set_written[i] = true;
+    write_vtu_field_data(flags, out);
 
-        // write the header. concatenate all the component names with double
-        // underscores unless a vector name has been specified
-        out << "    <DataArray type=\"Float32\" Name=\"";
+    VtuStream vtu_out(out, flags);
 
-        if (!name.empty())
-          out << name;
-        else
-          {
-            for (unsigned int i = first_component; i < last_component; ++i)
-              out << data_names[i] << "__";
-            out << data_names[last_component];
-          }
+#ifdef DEAL_II_WITH_ZLIB
+    const char *ascii_or_binary = "binary";
+#else
+    const char *ascii_or_binary = "ascii";
+#endif
 
-        out << "\" NumberOfComponents=\"" << n_components << "\" format=\""
-            << ascii_or_binary << "\">\n";
+    // every point is written as a cell of its own of type VTK_VERTEX, so the
+    // cell information is simply an enumeration of the points
+    out << "<Piece NumberOfPoints=\"" << n_points << "\" NumberOfCells=\""
+        << n_points << "\" >\n";
+    out << "  <Points>\n";
+    out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\""
+        << ascii_or_binary << "\">\n";
+    for (unsigned int i = 0; i < n_points; ++i)
+      vtu_out.write_point(i, points[i]);
+    vtu_out.flush_points();
+    out << "    </DataArray>\n";
+    out << "  </Points>\n\n";
 
-        // now write data. pad all vectors to have three components
-        std::vector<float> data;
-        data.reserve(n_nodes * n_components);
+    out << "  <Cells>\n";
+    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+      std::vector<int32_t> connectivity(n_points);
+      std::iota(connectivity.begin(), connectivity.end(), 0);
+      vtu_out << connectivity;
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
 
-        for (unsigned int n = 0; n < n_nodes; ++n)
-          {
-            if (!is_tensor)
-              {
-                switch (last_component - first_component)
-                  {
-                    case 0:
-                      data.push_back(data_vectors(first_component, n));
-                      data.push_back(0);
-                      data.push_back(0);
-                      break;
+    out << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+      std::vector<int32_t> offsets(n_points);
+      std::iota(offsets.begin(), offsets.end(), 1);
+      vtu_out << offsets;
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
 
-                    case 1:
-                      data.push_back(data_vectors(first_component, n));
-                      data.push_back(data_vectors(first_component + 1, n));
-                      data.push_back(0);
-                      break;
+    out << "    <DataArray type=\"UInt8\" Name=\"types\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+#ifdef DEAL_II_WITH_ZLIB
+      std::vector<uint8_t> cell_types(n_points,
+                                      static_cast<uint8_t>(vtk_cell_type[0]));
+#else
+      std::vector<unsigned int> cell_types(n_points, vtk_cell_type[0]);
+#endif
+      vtu_out << cell_types;
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
+    out << "  </Cells>\n";
 
-                    case 2:
-                      data.push_back(data_vectors(first_component, n));
-                      data.push_back(data_vectors(first_component + 1, n));
-                      data.push_back(data_vectors(first_component + 2, n));
-                      break;
+    write_vtu_point_data(
+      data, data_names, nonscalar_data_ranges, ascii_or_binary, vtu_out, out);
 
-                    default:
-                      // Anything else is not yet implemented
-                      Assert(false, ExcInternalError());
-                  }
-              }
-            else
-              {
-                Tensor<2, 3> vtk_data;
-                vtk_data = 0.;
+    out << " </Piece>\n";
 
-                const unsigned int size = last_component - first_component + 1;
-                if (size == 1)
-                  // 1D, 1 element
-                  {
-                    vtk_data[0][0] = data_vectors(first_component, n);
-                  }
-                else if (size == 4)
-                  // 2D, 4 elements
-                  {
-                    for (unsigned int c = 0; c < size; ++c)
-                      {
-                        const auto ind =
-                          Tensor<2, 2>::unrolled_to_component_indices(c);
-                        vtk_data[ind[0]][ind[1]] =
-                          data_vectors(first_component + c, n);
-                      }
-                  }
-                else if (size == 9)
-                  // 3D 9 elements
-                  {
-                    for (unsigned int c = 0; c < size; ++c)
-                      {
-                        const auto ind =
-                          Tensor<2, 3>::unrolled_to_component_indices(c);
-                        vtk_data[ind[0]][ind[1]] =
-                          data_vectors(first_component + c, n);
-                      }
-                  }
-                else
-                  {
-                    Assert(false, ExcInternalError());
-                  }
+    out.flush();
 
-                // now put the tensor into data
-                // note we padd with zeros because VTK format always wants to
-                // see a 3x3 tensor, regardless of dimension
-                for (unsigned int i = 0; i < 3; ++i)
-                  for (unsigned int j = 0; j < 3; ++j)
-                    data.push_back(vtk_data[i][j]);
-              }
-          } // loop over nodes
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_vtu_in_parallel(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &                nonscalar_data_ranges,
+    const VtkFlags &   flags,
+    const std::string &filename,
+    const MPI_Comm     comm)
+  {
+#ifndef DEAL_II_WITH_MPI
+    // without MPI fall back to the normal way to write a vtu file:
+    (void)comm;
 
-        vtu_out << data;
-        out << "    </DataArray>\n";
+    std::ofstream f(filename);
+    write_vtu(patches, data_names, nonscalar_data_ranges, flags, f);
+#else
+    const int myrank = Utilities::MPI::this_mpi_process(comm);
 
-      } // loop over ranges
+    const types::global_dof_index my_n_patches = patches.size();
+    const types::global_dof_index global_n_patches =
+      Utilities::MPI::sum(my_n_patches, comm);
 
-    // now do the left over scalar data sets
-    for (unsigned int data_set = 0; data_set < n_data_sets; ++data_set)
-      if (data_set_written[data_set] == false)
-        {
-          out << "    <DataArray type=\"Float32\" Name=\""
-              << data_names[data_set] << "\" format=\"" << ascii_or_binary
-              << "\">\n";
+    // Do not write pieces with 0 cells as this will crash paraview if this is
+    // the first piece written. But if nobody has any pieces to write (file is
+    // empty), let processor 0 write their empty data, otherwise the vtk file is
+    // invalid.
+    std::stringstream ss;
+    if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
+      write_vtu_main(patches, data_names, nonscalar_data_ranges, flags, ss);
 
-          std::vector<float> data(data_vectors[data_set].begin(),
-                                  data_vectors[data_set].end());
-          vtu_out << data;
-          out << "    </DataArray>\n";
-        }
+    write_vtu_piece_in_parallel(ss.str(), flags, filename, comm);
+#endif
+  }
 
-    out << "  </PointData>\n";
 
-    // Finish up writing a valid XML file
-    out << " </Piece>\n";
 
-    // make sure everything now gets to disk
-    out.flush();
+  template <int spacedim>
+  void
+  write_vtu_point_cloud_in_parallel(
+    const std::vector<Point<spacedim>> &points,
+    const Table<2, double> &            data,
+    const std::vector<std::string> &    data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &                nonscalar_data_ranges,
+    const VtkFlags &   flags,
+    const std::string &filename,
+    const MPI_Comm     comm)
+  {
+#ifndef DEAL_II_WITH_MPI
+    (void)comm;
 
-    // assert the stream is still ok
-    AssertThrow(out, ExcIO());
+    std::ofstream f(filename);
+    write_vtu_point_cloud(
+      points, data, data_names, nonscalar_data_ranges, flags, f);
+#else
+    const unsigned long long my_n_points = points.size();
+    const unsigned long long global_n_points =
+      Utilities::MPI::sum(my_n_points, comm);
+
+    // as in write_vtu_in_parallel(), only write empty pieces if nobody has
+    // any points
+    std::stringstream ss;
+    if (my_n_points > 0 ||
+        (global_n_points == 0 && Utilities::MPI::this_mpi_process(comm) == 0))
+      write_vtu_point_cloud_main(
+        points, data, data_names, nonscalar_data_ranges, flags, ss);
+
+    write_vtu_piece_in_parallel(ss.str(), flags, filename, comm);
+#endif
   }
 
 
@@ -6898,99 +7524,12 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   const std::string &filename,
   MPI_Comm           comm) const
 {
-#ifndef DEAL_II_WITH_MPI
-  // without MPI fall back to the normal way to write a vtu file:
-  (void)comm;
-
-  std::ofstream f(filename);
-  write_vtu(f);
-#else
-
-  const int myrank = Utilities::MPI::this_mpi_process(comm);
-
-  MPI_Info info;
-  int ierr = MPI_Info_create(&info);
-  AssertThrowMPI(ierr);
-  MPI_File fh;
-  ierr = MPI_File_open(comm,
-                       DEAL_II_MPI_CONST_CAST(filename.c_str()),
-                       MPI_MODE_CREATE | MPI_MODE_WRONLY,
-                       info,
-                       &fh);
-  AssertThrowMPI(ierr);
-
-  ierr = MPI_File_set_size(fh, 0); // delete the file contents
-  AssertThrowMPI(ierr);
-  // this barrier is necessary, because otherwise others might already write
-  // while one core is still setting the size to zero.
-  ierr = MPI_Barrier(comm);
-  AssertThrowMPI(ierr);
-  ierr = MPI_Info_free(&info);
-  AssertThrowMPI(ierr);
-
-  unsigned int header_size;
-
-  // write header
-  if (myrank == 0)
-    {
-      std::stringstream ss;
-      DataOutBase::write_vtu_header(ss, vtk_flags);
-      header_size = ss.str().size();
-      ierr = MPI_File_write(fh,
-                            DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                            header_size,
-                            MPI_CHAR,
-                            MPI_STATUS_IGNORE);
-      AssertThrowMPI(ierr);
-    }
-
-  ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
-  AssertThrowMPI(ierr);
-
-  ierr = MPI_File_seek_shared(fh, header_size, MPI_SEEK_SET);
-  AssertThrowMPI(ierr);
-  {
-    const auto &patches = get_patches();
-    const types::global_dof_index my_n_patches = patches.size();
-    const types::global_dof_index global_n_patches =
-      Utilities::MPI::sum(my_n_patches, comm);
-
-    // Do not write pieces with 0 cells as this will crash paraview if this is
-    // the first piece written. But if nobody has any pieces to write (file is
-    // empty), let processor 0 write their empty data, otherwise the vtk file is
-    // invalid.
-    std::stringstream ss;
-    if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
-      DataOutBase::write_vtu_main(patches,
-                                  get_dataset_names(),
-                                  get_nonscalar_data_ranges(),
-                                  vtk_flags,
-                                  ss);
-
-    ierr = MPI_File_write_ordered(fh,
-                                  DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                                  ss.str().size(),
-                                  MPI_CHAR,
-                                  MPI_STATUS_IGNORE);
-    AssertThrowMPI(ierr);
-  }
-
-  // write footer
-  if (myrank == 0)
-    {
-      std::stringstream ss;
-      DataOutBase::write_vtu_footer(ss);
-      unsigned int footer_size = ss.str().size();
-      ierr = MPI_File_write_shared(fh,
-                                   DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                                   footer_size,
-                                   MPI_CHAR,
-                                   MPI_STATUS_IGNORE);
-      AssertThrowMPI(ierr);
-    }
-  ierr = MPI_File_close(&fh);
-  AssertThrowMPI(ierr);
-#endif
+  DataOutBase::write_vtu_in_parallel(get_patches(),
+                                     get_dataset_names(),
+                                     get_nonscalar_data_ranges(),
+                                     vtk_flags,
+                                     filename,
+                                     comm);
 }
 
 
@@ -7088,6 +7627,111 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
 
 
 
+template <int dim, int spacedim>
+std::future<std::string>
+DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record_async(
+  const std::string &directory,
+  const std::string &filename_without_extension,
+  const unsigned int counter,
+  const MPI_Comm &   mpi_communicator,
+  const unsigned int n_digits_for_counter,
+  const unsigned int n_groups) const
+{
+  const unsigned int rank = Utilities::MPI::this_mpi_process(mpi_communicator);
+  const unsigned int n_ranks =
+    Utilities::MPI::n_mpi_processes(mpi_communicator);
+  const unsigned int n_files_written =
+    (n_groups == 0 || n_groups > n_ranks) ? n_ranks : n_groups;
+
+  Assert(n_files_written >= 1, ExcInternalError());
+  const unsigned int n_digits =
+    Utilities::needed_digits(std::max(0, int(n_files_written) - 1));
+
+  // the buffers to be written, as pairs of filename and content. they are
+  // held by shared pointers since the job below has to be copyable
+  auto files =
+    std::make_shared<std::vector<std::pair<std::string, std::string>>>();
+
+  if (n_groups == 0 || n_groups > n_ranks)
+    {
+      // every processor writes one file, which we can generate in memory
+      const std::string filename =
+        directory + filename_without_extension + "_" +
+        Utilities::int_to_string(counter, n_digits_for_counter) + "." +
+        Utilities::int_to_string(rank, n_digits) + ".vtu";
+
+      std::ostringstream output;
+      this->write_vtu(output);
+      files->emplace_back(filename, output.str());
+    }
+  else
+    {
+      // the files are written collectively through MPI I/O, which has to
+      // happen on this thread. only the record is written in the background
+      const unsigned int color = rank % n_files_written;
+      const std::string  filename =
+        directory + filename_without_extension + "_" +
+        Utilities::int_to_string(counter, n_digits_for_counter) + "." +
+        Utilities::int_to_string(color, n_digits) + ".vtu";
+
+      if (n_groups == 1)
+        this->write_vtu_in_parallel(filename.c_str(), mpi_communicator);
+      else
+        {
+#ifdef DEAL_II_WITH_MPI
+          MPI_Comm comm_group;
+          int ierr = MPI_Comm_split(mpi_communicator, color, rank, &comm_group);
+          AssertThrowMPI(ierr);
+          this->write_vtu_in_parallel(filename.c_str(), comm_group);
+          ierr = MPI_Comm_free(&comm_group);
+          AssertThrowMPI(ierr);
+#else
+          AssertThrow(false,
+                      ExcMessage("Logical error. Should not arrive here."));
+#endif
+        }
+    }
+
+  // generate the pvtu record
+  const std::string filename_master =
+    filename_without_extension + "_" +
+    Utilities::int_to_string(counter, n_digits_for_counter) + ".pvtu";
+
+  if (rank == 0)
+    {
+      std::vector<std::string> filename_vector;
+      for (unsigned int i = 0; i < n_files_written; ++i)
+        filename_vector.emplace_back(
+          filename_without_extension + "_" +
+          Utilities::int_to_string(counter, n_digits_for_counter) + "." +
+          Utilities::int_to_string(i, n_digits) + ".vtu");
+
+      std::ostringstream master_output;
+      this->write_pvtu_record(master_output, filename_vector);
+      files->emplace_back(directory + filename_master, master_output.str());
+    }
+
+  std::size_t n_bytes = 0;
+  for (const auto &file : *files)
+    n_bytes += file.second.size();
+
+  return AsynchronousWriter::instance().submit(
+    std::function<std::string()>([files, filename_master]() {
+      for (const auto &file : *files)
+        {
+          std::ofstream out(file.first, std::ios::binary);
+          AssertThrow(out, ExcFileNotOpen(file.first));
+          out.write(file.second.data(), file.second.size());
+          out.close();
+          AssertThrow(out, ExcIO());
+        }
+      return filename_master;
+    }),
+    n_bytes);
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_deal_II_intermediate(
@@ -7361,6 +8005,251 @@ DataOutBase::write_filtered_data(
 
 
 
+template <int dim, int spacedim>
+std::vector<DataOutBase::Patch<dim, spacedim>>
+DataOutBase::reduce_patches(const std::vector<Patch<dim, spacedim>> &patches,
+                            const unsigned int max_n_subdivisions,
+                            const unsigned int patch_stride)
+{
+  Assert(max_n_subdivisions > 0, ExcMessage("At least one subdivision needed"));
+  Assert(patch_stride > 0, ExcMessage("The patch stride must be positive"));
+
+  std::vector<Patch<dim, spacedim>> reduced_patches;
+  reduced_patches.reserve((patches.size() + patch_stride - 1) / patch_stride);
+
+  for (unsigned int p = 0; p < patches.size(); p += patch_stride)
+    {
+      reduced_patches.push_back(patches[p]);
+      Patch<dim, spacedim> &patch = reduced_patches.back();
+      patch.patch_index           = reduced_patches.size() - 1;
+
+      // the neighbors refer to the indices of the original patches, which
+      // are no longer valid once we have dropped patches
+      if (patch_stride > 1)
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          patch.neighbors[f] = Patch<dim, spacedim>::no_neighbor;
+
+      if (dim == 0 || patch.n_subdivisions <= max_n_subdivisions)
+        continue;
+
+      // find the smallest factor by which we can coarsen the patch so that
+      // the points of the reduced patch are a subset of the original ones
+      const unsigned int n_old = patch.n_subdivisions;
+      unsigned int       factor =
+        (n_old + max_n_subdivisions - 1) / max_n_subdivisions;
+      while (n_old % factor != 0)
+        ++factor;
+      const unsigned int n_new = n_old / factor;
+
+      const unsigned int n_old_points = n_old + 1;
+      const unsigned int n_new_points = n_new + 1;
+      const unsigned int n_points_per_direction[3] = {
+        n_new_points,
+        (dim > 1 ? n_new_points : 1),
+        (dim > 2 ? n_new_points : 1)};
+
+      const Table<2, float> &old_data = patches[p].data;
+      Table<2, float>        new_data(old_data.n_rows(),
+                               Utilities::fixed_power<dim>(n_new_points));
+      for (unsigned int i3 = 0; i3 < n_points_per_direction[2]; ++i3)
+        for (unsigned int i2 = 0; i2 < n_points_per_direction[1]; ++i2)
+          for (unsigned int i1 = 0; i1 < n_points_per_direction[0]; ++i1)
+            {
+              const unsigned int new_index =
+                (i3 * n_new_points + i2) * n_new_points + i1;
+              const unsigned int old_index =
+                (i3 * factor * n_old_points + i2 * factor) * n_old_points +
+                i1 * factor;
+              for (unsigned int row = 0; row < old_data.n_rows(); ++row)
+                new_data[row][new_index] = old_data[row][old_index];
+            }
+
+      patch.n_subdivisions = n_new;
+      patch.data.swap(new_data);
+    }
+
+  return reduced_patches;
+}
+
+
+
+#ifdef DEAL_II_WITH_ADIOS2
+struct DataOutBase::ADIOS2Stream::Implementation
+{
+#  ifdef DEAL_II_WITH_MPI
+  Implementation(MPI_Comm comm)
+    : adios(comm)
+  {}
+#  else
+  Implementation(MPI_Comm)
+  {}
+#  endif
+
+  adios2::ADIOS  adios;
+  adios2::IO     io;
+  adios2::Engine engine;
+};
+
+
+
+DataOutBase::ADIOS2Stream::ADIOS2Stream(
+  const std::string &                       stream_name,
+  MPI_Comm                                  comm,
+  const std::string &                       engine_type,
+  const std::map<std::string, std::string> &engine_parameters,
+  const unsigned int                        max_n_subdivisions,
+  const unsigned int                        patch_stride)
+  : implementation(std::make_unique<Implementation>(comm))
+  , max_n_subdivisions(max_n_subdivisions)
+  , patch_stride(patch_stride)
+  , comm(comm)
+{
+  AssertThrow(patch_stride > 0,
+              ExcMessage("The patch stride must be positive."));
+
+  implementation->io = implementation->adios.DeclareIO(stream_name);
+  implementation->io.SetEngine(engine_type);
+  adios2::Params parameters(engine_parameters.begin(),
+                            engine_parameters.end());
+  implementation->io.SetParameters(parameters);
+  implementation->engine =
+    implementation->io.Open(stream_name, adios2::Mode::Write);
+}
+
+
+
+DataOutBase::ADIOS2Stream::~ADIOS2Stream()
+{
+  if (implementation->engine)
+    implementation->engine.Close();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBase::ADIOS2Stream::write(
+  const std::vector<Patch<dim, spacedim>> &patches,
+  const std::vector<std::string> &         data_names,
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    &          nonscalar_data_ranges,
+  const double time)
+{
+  // reduce the patches if requested, and then filter the data the same way
+  // as for the XDMF output; we do not merge duplicate points here to keep the
+  // in-situ output cheap
+  DataOutFilter filtered_data(DataOutFilterFlags(false, true));
+  if (max_n_subdivisions != numbers::invalid_unsigned_int || patch_stride > 1)
+    write_filtered_data(reduce_patches(patches,
+                                       max_n_subdivisions,
+                                       patch_stride),
+                        data_names,
+                        nonscalar_data_ranges,
+                        filtered_data);
+  else
+    write_filtered_data(patches,
+                        data_names,
+                        nonscalar_data_ranges,
+                        filtered_data);
+
+  std::vector<double>       node_data;
+  std::vector<unsigned int> cell_data;
+  filtered_data.fill_node_data(node_data);
+  filtered_data.fill_cell_data(0, cell_data);
+
+  adios2::IO &    io     = implementation->io;
+  adios2::Engine &engine = implementation->engine;
+
+  // the attributes only need to be written once, with the first step
+  if (!io.InquireAttribute<unsigned int>("dimension"))
+    {
+      io.DefineAttribute<unsigned int>("dimension", dim);
+      io.DefineAttribute<unsigned int>("space_dimension", spacedim);
+
+      std::vector<std::string>  names;
+      std::vector<unsigned int> dimensions;
+      for (unsigned int i = 0; i < filtered_data.n_data_sets(); ++i)
+        {
+          names.push_back(filtered_data.get_data_set_name(i));
+          dimensions.push_back(filtered_data.get_data_set_dim(i));
+        }
+      if (names.size() > 0)
+        {
+          io.DefineAttribute<std::string>("data_set_names",
+                                          names.data(),
+                                          names.size());
+          io.DefineAttribute<unsigned int>("data_set_dimensions",
+                                           dimensions.data(),
+                                           dimensions.size());
+        }
+    }
+
+  engine.BeginStep();
+
+  // the local block sizes change with the mesh, so we cannot use
+  // adios2::ConstantDims for them and reset the shape of the variables in
+  // every step instead
+  const unsigned int n_nodes           = filtered_data.n_nodes();
+  const unsigned int n_cells           = filtered_data.n_cells();
+  const unsigned int vertices_per_cell = GeometryInfo<dim>::vertices_per_cell;
+
+  const auto put_block = [&](const std::string &name,
+                             const std::size_t  n_rows,
+                             const std::size_t  n_columns,
+                             const auto *       data) {
+    using number = typename std::remove_cv<
+      typename std::remove_pointer<decltype(data)>::type>::type;
+    adios2::Variable<number> variable = io.InquireVariable<number>(name);
+    if (!variable)
+      variable = io.DefineVariable<number>(name, {}, {}, {n_rows, n_columns});
+    else
+      variable.SetSelection({{}, {n_rows, n_columns}});
+    engine.Put(variable, data, adios2::Mode::Sync);
+  };
+
+  put_block("points", n_nodes, spacedim, node_data.data());
+  put_block("cells", n_cells, vertices_per_cell, cell_data.data());
+  for (unsigned int i = 0; i < filtered_data.n_data_sets(); ++i)
+    put_block(filtered_data.get_data_set_name(i),
+              n_nodes,
+              filtered_data.get_data_set_dim(i),
+              filtered_data.get_data_set(i));
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      adios2::Variable<double> time_variable =
+        io.InquireVariable<double>("time");
+      if (!time_variable)
+        time_variable = io.DefineVariable<double>("time");
+      engine.Put(time_variable, time, adios2::Mode::Sync);
+    }
+
+  engine.EndStep();
+}
+#endif
+
+
+
+#ifdef DEAL_II_WITH_ADIOS2
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_adios2(
+  DataOutBase::ADIOS2Stream &stream,
+  const double               time) const
+{
+  stream.write(get_patches(),
+               get_dataset_names(),
+               get_nonscalar_data_ranges(),
+               time);
+}
+#endif
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_hdf5_parallel(
@@ -8447,6 +9336,94 @@ XDMFEntry::get_xdmf_content(const unsigned int indent_level) const
 
 
 
+// ------------------------------------------ XDMFTimeSeries ----------
+
+XDMFTimeSeries::XDMFTimeSeries(const std::string &filename_prefix,
+                               const DataOutBase::DataOutFilterFlags &flags,
+                               MPI_Comm                               comm)
+  : filename_prefix(filename_prefix)
+  , flags(flags)
+  , comm(comm)
+  , mesh_version(0)
+  , mesh_hash(0)
+{}
+
+
+
+template <int dim, int spacedim>
+void
+XDMFTimeSeries::write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                                const double                           time,
+                                const bool force_mesh_output)
+{
+  DataOutBase::DataOutFilter data_filter(flags);
+  data_out.write_filtered_data(data_filter);
+
+  // Hash the locally owned part of the filtered mesh. The mesh has changed
+  // if the hash has changed on any of the processes.
+  std::size_t new_mesh_hash = 0;
+  {
+    const auto combine = [&new_mesh_hash](const std::size_t value) {
+      new_mesh_hash ^=
+        value + 0x9e3779b9 + (new_mesh_hash << 6) + (new_mesh_hash >> 2);
+    };
+
+    std::vector<double> node_data;
+    data_filter.fill_node_data(node_data);
+    std::vector<unsigned int> cell_data;
+    data_filter.fill_cell_data(0, cell_data);
+
+    combine(node_data.size());
+    for (const double x : node_data)
+      combine(std::hash<double>()(x));
+    combine(cell_data.size());
+    for (const unsigned int c : cell_data)
+      combine(std::hash<unsigned int>()(c));
+  }
+
+  const bool write_mesh_file =
+    (Utilities::MPI::max(static_cast<unsigned int>(
+                           force_mesh_output || mesh_version == 0 ||
+                           new_mesh_hash != mesh_hash),
+                         comm) == 1);
+
+  if (write_mesh_file)
+    {
+      mesh_filename = filename_prefix + "-mesh-" +
+                      Utilities::int_to_string(mesh_version, 4) + ".h5";
+      mesh_hash = new_mesh_hash;
+      ++mesh_version;
+    }
+  const std::string solution_filename =
+    filename_prefix + "-" + Utilities::int_to_string(entries.size(), 5) +
+    ".h5";
+
+  data_out.write_hdf5_parallel(
+    data_filter, write_mesh_file, mesh_filename, solution_filename, comm);
+
+  entries.push_back(data_out.create_xdmf_entry(
+    data_filter, mesh_filename, solution_filename, time, comm));
+  data_out.write_xdmf_file(entries, filename_prefix + ".xdmf", comm);
+}
+
+
+
+unsigned int
+XDMFTimeSeries::n_mesh_versions() const
+{
+  return mesh_version;
+}
+
+
+
+const std::vector<XDMFEntry> &
+XDMFTimeSeries::get_entries() const
+{
+  return entries;
+}
+
+
+
 namespace DataOutBase
 {
   template <int dim, int spacedim>
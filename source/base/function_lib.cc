@@ -37,6 +37,16 @@ namespace Functions
   }
 
 
+  template <int dim>
+  VectorizedArray<double>
+  SquareFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    return p.square();
+  }
+
+
   template <int dim>
   void
   SquareFunction<dim>::vector_value(const Point<dim> &p,
@@ -449,6 +459,19 @@ namespace Functions
     return 0.;
   }
 
+
+  template <int dim>
+  VectorizedArray<double>
+  CosineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    VectorizedArray<double> result = std::cos(numbers::PI_2 * p[0]);
+    for (unsigned int d = 1; d < dim; ++d)
+      result *= std::cos(numbers::PI_2 * p[d]);
+    return result;
+  }
+
   template <int dim>
   void
   CosineFunction<dim>::value_list(const std::vector<Point<dim>> &points,
@@ -1032,6 +1055,19 @@ namespace Functions
     return 0.;
   }
 
+
+  template <int dim>
+  VectorizedArray<double>
+  ExpFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    VectorizedArray<double> exponent = p[0];
+    for (unsigned int d = 1; d < dim; ++d)
+      exponent += p[d];
+    return std::exp(exponent);
+  }
+
   template <int dim>
   void
   ExpFunction<dim>::value_list(const std::vector<Point<dim>> &points,
@@ -1939,6 +1975,22 @@ namespace Functions
 
 
 
+  template <int dim>
+  VectorizedArray<double>
+  FourierCosineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    AssertIndexRange(component, 1);
+    VectorizedArray<double> argument = fourier_coefficients[0] * p[0];
+    for (unsigned int d = 1; d < dim; ++d)
+      argument += fourier_coefficients[d] * p[d];
+    return std::cos(argument);
+  }
+
+
+
   template <int dim>
   Tensor<1, dim>
   FourierCosineFunction<dim>::gradient(const Point<dim> & p,
@@ -1989,6 +2041,22 @@ namespace Functions
 
 
 
+  template <int dim>
+  VectorizedArray<double>
+  FourierSineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    AssertIndexRange(component, 1);
+    VectorizedArray<double> argument = fourier_coefficients[0] * p[0];
+    for (unsigned int d = 1; d < dim; ++d)
+      argument += fourier_coefficients[d] * p[d];
+    return std::sin(argument);
+  }
+
+
+
   template <int dim>
   Tensor<1, dim>
   FourierSineFunction<dim>::gradient(const Point<dim> & p,
@@ -2196,6 +2264,31 @@ namespace Functions
 
 
 
+  template <int dim>
+  VectorizedArray<double>
+  Monomial<dim>::vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                                  const unsigned int component) const
+  {
+    (void)component;
+    AssertIndexRange(component, this->n_components);
+
+    VectorizedArray<double> prod = 1.;
+    for (unsigned int s = 0; s < dim; ++s)
+      {
+#ifdef DEBUG
+        for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+          if (p[s][v] < 0)
+            Assert(std::floor(exponents[s]) == exponents[s],
+                   ExcMessage("Exponentiation of a negative base number with "
+                              "a real exponent can't be performed."));
+#endif
+        prod *= std::pow(p[s], exponents[s]);
+      }
+    return prod;
+  }
+
+
+
   template <int dim>
   void
   Monomial<dim>::vector_value(const Point<dim> &p, Vector<double> &values) const
@@ -329,6 +329,110 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
     values(component) = fp.get()[component]->Eval();
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &points,
+                                std::vector<double> &          values,
+                                const unsigned int             component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  AssertIndexRange(component, this->n_components);
+  AssertDimension(values.size(), points.size());
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  // look up the thread-local objects only once rather than for every point
+  std::vector<double> &variables = vars.get();
+  mu::Parser &         parser    = *fp.get()[component];
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  try
+    {
+      for (unsigned int q = 0; q < points.size(); ++q)
+        {
+          for (unsigned int i = 0; i < dim; ++i)
+            variables[i] = points[q][i];
+          values[q] = parser.Eval();
+        }
+    }
+  catch (mu::ParserError &e)
+    {
+      std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+      std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+      std::cerr << "Token:    <" << e.GetToken() << ">\n";
+      std::cerr << "Position: <" << e.GetPos() << ">\n";
+      std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+      AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+    }
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>> &  values) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  AssertDimension(values.size(), points.size());
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  std::vector<double> &                           variables = vars.get();
+  const std::vector<std::unique_ptr<mu::Parser>> &parsers   = fp.get();
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  for (unsigned int q = 0; q < points.size(); ++q)
+    {
+      Assert(values[q].size() == this->n_components,
+             ExcDimensionMismatch(values[q].size(), this->n_components));
+      for (unsigned int i = 0; i < dim; ++i)
+        variables[i] = points[q][i];
+      for (unsigned int component = 0; component < this->n_components;
+           ++component)
+        values[q](component) = parsers[component]->Eval();
+    }
+}
+
+
+
+template <int dim>
+VectorizedArray<double>
+FunctionParser<dim>::vectorized_value(
+  const Point<dim, VectorizedArray<double>> &p,
+  const unsigned int                         component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  AssertIndexRange(component, this->n_components);
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  std::vector<double> &variables = vars.get();
+  mu::Parser &         parser    = *fp.get()[component];
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  VectorizedArray<double> result;
+  for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        variables[i] = p[i][v];
+      result[v] = parser.Eval();
+    }
+  return result;
+}
+
 #else
 
 
@@ -371,6 +475,37 @@ FunctionParser<dim>::vector_value(const Point<dim> &, Vector<double> &) const
 }
 
 
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &,
+                                std::vector<double> &,
+                                const unsigned int) const
+{
+  AssertThrow(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(const std::vector<Point<dim>> &,
+                                       std::vector<Vector<double>> &) const
+{
+  AssertThrow(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+VectorizedArray<double>
+FunctionParser<dim>::vectorized_value(
+  const Point<dim, VectorizedArray<double>> &,
+  const unsigned int) const
+{
+  AssertThrow(false, ExcNeedsFunctionparser());
+  return VectorizedArray<double>(0.);
+}
+
+
 #endif
 
 // Explicit Instantiations.
@@ -25,8 +25,10 @@
 
 #  include <hdf5.h>
 
+#  include <map>
 #  include <memory>
 #  include <numeric>
+#  include <string>
 #  include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -331,6 +333,47 @@ namespace HDF5
     }
 
 
+    // This overload of release_plist is used by the asynchronous writes,
+    // which do not record the I/O mode.
+    void
+    release_plist(hid_t &plist, const bool mpi)
+    {
+      H5D_mpio_actual_io_mode_t io_mode;
+      uint32_t                  local_no_collective_cause;
+      uint32_t                  global_no_collective_cause;
+      release_plist(plist,
+                    io_mode,
+                    local_no_collective_cause,
+                    global_no_collective_cause,
+                    mpi,
+                    false);
+    }
+
+
+    // An asynchronous collective write calls MPI from a background thread
+    // while the main thread may continue to call MPI. This requires that
+    // MPI has been initialized with MPI_THREAD_MULTIPLE.
+    void
+    check_async_write_support(const bool mpi)
+    {
+      if (mpi)
+        {
+#  ifdef DEAL_II_WITH_MPI
+          int       provided;
+          const int ierr = MPI_Query_thread(&provided);
+          AssertThrowMPI(ierr);
+          AssertThrow(provided == MPI_THREAD_MULTIPLE,
+                      ExcMessage("Asynchronous parallel HDF5 writes require "
+                                 "that MPI has been initialized with "
+                                 "MPI_THREAD_MULTIPLE."));
+#  else
+          AssertThrow(false, ExcNotImplemented());
+#  endif
+        }
+      (void)mpi;
+    }
+
+
     // Convert a HDF5 no_collective_cause code to a human readable string
     std::string
     no_collective_cause_to_string(const uint32_t no_collective_cause)
@@ -658,7 +701,8 @@ namespace HDF5
                    const hid_t &                 parent_group_id,
                    const std::vector<hsize_t> &  dimensions,
                    const std::shared_ptr<hid_t> &t_type,
-                   const bool                    mpi)
+                   const bool                    mpi,
+                   const DataSetCreationOptions &options)
     : HDF5Object(name, mpi)
     , rank(dimensions.size())
     , dimensions(dimensions)
@@ -685,15 +729,82 @@ namespace HDF5
     *dataspace = H5Screate_simple(rank, dimensions.data(), nullptr);
     Assert(*dataspace >= 0, ExcMessage("Error at H5Screate_simple"));
 
+    // The dataset creation property list is only needed for chunked
+    // datasets. Compression filters can only be applied to chunked datasets,
+    // therefore the whole dataset is stored in one chunk if the user did not
+    // provide the chunk dimensions.
+    hid_t  dcpl = H5P_DEFAULT;
+    herr_t ret;
+    if (!options.chunk_dimensions.empty() ||
+        options.compression != DataSetCreationOptions::Compression::none)
+      {
+        std::vector<hsize_t> chunk_dimensions = options.chunk_dimensions;
+        if (chunk_dimensions.empty())
+          for (const auto &dimension : dimensions)
+            chunk_dimensions.push_back(std::max<hsize_t>(dimension, 1));
+        AssertDimension(chunk_dimensions.size(), rank);
+
+        dcpl = H5Pcreate(H5P_DATASET_CREATE);
+        Assert(dcpl >= 0, ExcMessage("Error at H5Pcreate"));
+        ret = H5Pset_chunk(dcpl, rank, chunk_dimensions.data());
+        Assert(ret >= 0, ExcMessage("Error at H5Pset_chunk"));
+
+        if (options.shuffle &&
+            options.compression != DataSetCreationOptions::Compression::none)
+          {
+            ret = H5Pset_shuffle(dcpl);
+            Assert(ret >= 0, ExcMessage("Error at H5Pset_shuffle"));
+          }
+
+        switch (options.compression)
+          {
+            case (DataSetCreationOptions::Compression::none):
+              break;
+            case (DataSetCreationOptions::Compression::deflate):
+              AssertIndexRange(options.deflate_level, 10);
+              ret = H5Pset_deflate(dcpl, options.deflate_level);
+              Assert(ret >= 0, ExcMessage("Error at H5Pset_deflate"));
+              break;
+            case (DataSetCreationOptions::Compression::szip):
+              AssertThrow(H5Zfilter_avail(H5Z_FILTER_SZIP) > 0,
+                          ExcMessage("The szip filter is not available."));
+              ret = H5Pset_szip(dcpl,
+                                H5_SZIP_NN_OPTION_MASK,
+                                options.szip_pixels_per_block);
+              Assert(ret >= 0, ExcMessage("Error at H5Pset_szip"));
+              break;
+            case (DataSetCreationOptions::Compression::custom):
+              AssertThrow(H5Zfilter_avail(options.custom_filter_id) > 0,
+                          ExcMessage("The requested filter is not available."));
+              ret = H5Pset_filter(dcpl,
+                                  options.custom_filter_id,
+                                  H5Z_FLAG_MANDATORY,
+                                  options.custom_filter_parameters.size(),
+                                  options.custom_filter_parameters.data());
+              Assert(ret >= 0, ExcMessage("Error at H5Pset_filter"));
+              break;
+            default:
+              Assert(false, ExcInternalError());
+              break;
+          }
+      }
+
     *hdf5_reference = H5Dcreate2(parent_group_id,
                                  name.data(),
                                  *t_type,
                                  *dataspace,
                                  H5P_DEFAULT,
-                                 H5P_DEFAULT,
+                                 dcpl,
                                  H5P_DEFAULT);
     Assert(*hdf5_reference >= 0, ExcMessage("Error at H5Dcreate2"));
 
+    if (dcpl != H5P_DEFAULT)
+      {
+        ret = H5Pclose(dcpl);
+        Assert(ret >= 0, ExcMessage("Error at H5Pclose"));
+      }
+    (void)ret;
+
     size = 1;
     for (const auto &dimension : dimensions)
       {
@@ -707,6 +818,8 @@ namespace HDF5
   Container
   DataSet::read()
   {
+    wait_for_pending_write();
+
     const std::shared_ptr<hid_t> t_type =
       internal::get_hdf5_datatype<typename Container::value_type>();
     hid_t  plist;
@@ -742,6 +855,8 @@ namespace HDF5
   Container
   DataSet::read_selection(const std::vector<hsize_t> &coordinates)
   {
+    wait_for_pending_write();
+
     Assert(coordinates.size() % rank == 0,
            ExcMessage(
              "The dimension of coordinates has to be divisible by the rank"));
@@ -795,6 +910,8 @@ namespace HDF5
   DataSet::read_hyperslab(const std::vector<hsize_t> &offset,
                           const std::vector<hsize_t> &count)
   {
+    wait_for_pending_write();
+
     const std::shared_ptr<hid_t> t_type =
       internal::get_hdf5_datatype<typename Container::value_type>();
     hid_t  plist;
@@ -852,6 +969,8 @@ namespace HDF5
                           const std::vector<hsize_t> &count,
                           const std::vector<hsize_t> &block)
   {
+    wait_for_pending_write();
+
     const std::shared_ptr<hid_t> t_type =
       internal::get_hdf5_datatype<typename Container::value_type>();
     hid_t  plist;
@@ -901,6 +1020,8 @@ namespace HDF5
   void
   DataSet::read_none()
   {
+    wait_for_pending_write();
+
     const std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<number>();
     const std::vector<hsize_t>   data_dimensions = {0};
 
@@ -941,6 +1062,8 @@ namespace HDF5
   void
   DataSet::write(const Container &data)
   {
+    wait_for_pending_write();
+
     AssertDimension(size, internal::get_container_size(data));
     const std::shared_ptr<hid_t> t_type =
       internal::get_hdf5_datatype<typename Container::value_type>();
@@ -974,6 +1097,8 @@ namespace HDF5
   DataSet::write_selection(const Container &           data,
                            const std::vector<hsize_t> &coordinates)
   {
+    wait_for_pending_write();
+
     AssertDimension(coordinates.size(), data.size() * rank);
     const std::shared_ptr<hid_t> t_type =
       internal::get_hdf5_datatype<typename Container::value_type>();
@@ -1024,6 +1149,8 @@ namespace HDF5
                            const std::vector<hsize_t> &offset,
                            const std::vector<hsize_t> &count)
   {
+    wait_for_pending_write();
+
     AssertDimension(std::accumulate(count.begin(),
                                     count.end(),
                                     1,
@@ -1084,6 +1211,8 @@ namespace HDF5
                            const std::vector<hsize_t> &count,
                            const std::vector<hsize_t> &block)
   {
+    wait_for_pending_write();
+
     const std::shared_ptr<hid_t> t_type =
       internal::get_hdf5_datatype<typename Container::value_type>();
 
@@ -1131,6 +1260,8 @@ namespace HDF5
   void
   DataSet::write_none()
   {
+    wait_for_pending_write();
+
     std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<number>();
     std::vector<hsize_t>   data_dimensions = {0};
 
@@ -1166,6 +1297,129 @@ namespace HDF5
   }
 
 
+  template <typename Container>
+  Threads::Task<>
+  DataSet::write_async(const Container &data)
+  {
+    AssertDimension(size, internal::get_container_size(data));
+    wait_for_pending_write();
+    internal::check_async_write_support(mpi);
+
+    using number = typename Container::value_type;
+
+    // Copy the data, so that the caller may modify it while the write is in
+    // progress. The lambda function holds references to the HDF5 handles of
+    // the dataset, so that the dataset stays open even if this object is
+    // destroyed before the write is completed.
+    const auto buffer = std::make_shared<std::vector<number>>(
+      make_array_view(data).begin(), make_array_view(data).end());
+    const std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<number>();
+    const std::shared_ptr<hid_t> dataset = hdf5_reference;
+    const bool                   use_mpi = mpi;
+
+    pending_write = Threads::new_task([buffer, t_type, dataset, use_mpi]() {
+      hid_t  plist;
+      herr_t ret;
+
+      internal::set_plist(plist, use_mpi);
+
+      ret = H5Dwrite(
+        *dataset, *t_type, H5S_ALL, H5S_ALL, plist, buffer->data());
+      AssertThrow(ret >= 0, ExcMessage("Error at H5Dwrite"));
+
+      internal::release_plist(plist, use_mpi);
+
+      (void)ret;
+    });
+
+    return pending_write;
+  }
+
+
+
+  template <typename Container>
+  Threads::Task<>
+  DataSet::write_hyperslab_async(const Container &           data,
+                                 const std::vector<hsize_t> &offset,
+                                 const std::vector<hsize_t> &count)
+  {
+    AssertDimension(std::accumulate(count.begin(),
+                                    count.end(),
+                                    1,
+                                    std::multiplies<unsigned int>()),
+                    internal::get_container_size(data));
+    wait_for_pending_write();
+    internal::check_async_write_support(mpi);
+
+    using number = typename Container::value_type;
+
+    const auto buffer = std::make_shared<std::vector<number>>(
+      make_array_view(data).begin(), make_array_view(data).end());
+    const std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<number>();
+    const std::shared_ptr<hid_t> dataset = hdf5_reference;
+    const bool                   use_mpi = mpi;
+
+    // The selection is made on a copy of the dataspace of this object, which
+    // can therefore be used for other selections while the write is in
+    // progress. In this particular overload the data_dimensions are the same
+    // as count
+    herr_t      ret;
+    const hid_t file_dataspace = H5Scopy(*dataspace);
+    Assert(file_dataspace >= 0, ExcMessage("Error at H5Scopy"));
+    ret = H5Sselect_hyperslab(file_dataspace,
+                              H5S_SELECT_SET,
+                              offset.data(),
+                              nullptr,
+                              count.data(),
+                              nullptr);
+    Assert(ret >= 0, ExcMessage("Error at H5Sselect_hyperslab"));
+    const hid_t memory_dataspace =
+      H5Screate_simple(count.size(), count.data(), nullptr);
+    Assert(memory_dataspace >= 0, ExcMessage("Error at H5Screate_simple"));
+    (void)ret;
+
+    pending_write = Threads::new_task(
+      [buffer, t_type, dataset, use_mpi, file_dataspace, memory_dataspace]() {
+        hid_t  plist;
+        herr_t ret;
+
+        internal::set_plist(plist, use_mpi);
+
+        ret = H5Dwrite(*dataset,
+                       *t_type,
+                       memory_dataspace,
+                       file_dataspace,
+                       plist,
+                       buffer->data());
+        AssertThrow(ret >= 0, ExcMessage("Error at H5Dwrite"));
+
+        internal::release_plist(plist, use_mpi);
+
+        ret = H5Sclose(memory_dataspace);
+        Assert(ret >= 0, ExcMessage("Error at H5Sclose"));
+        ret = H5Sclose(file_dataspace);
+        Assert(ret >= 0, ExcMessage("Error at H5Sclose"));
+
+        (void)ret;
+      });
+
+    return pending_write;
+  }
+
+
+
+  void
+  DataSet::wait_for_pending_write()
+  {
+    if (pending_write.joinable())
+      {
+        pending_write.join();
+        pending_write = Threads::Task<>();
+      }
+  }
+
+
+
 
   void
   DataSet::set_query_io_mode(const bool new_query_io_mode)
@@ -1376,6 +1630,18 @@ namespace HDF5
 
 
 
+  template <typename number>
+  DataSet
+  Group::create_dataset(const std::string &           name,
+                        const std::vector<hsize_t> &  dimensions,
+                        const DataSetCreationOptions &options) const
+  {
+    std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<number>();
+    return {name, *hdf5_reference, dimensions, t_type, mpi, options};
+  }
+
+
+
   template <typename Container>
   void
   Group::write_dataset(const std::string &name, const Container &data) const
@@ -1410,10 +1676,20 @@ namespace HDF5
 
 
 
-  File::File(const std::string &  name,
-             const FileAccessMode mode,
-             const bool           mpi,
-             const MPI_Comm       mpi_communicator)
+  File::File(const std::string &                       name,
+             const FileAccessMode                      mode,
+             const MPI_Comm                            mpi_communicator,
+             const std::map<std::string, std::string> &mpi_io_hints)
+    : File(name, mode, true, mpi_communicator, mpi_io_hints)
+  {}
+
+
+
+  File::File(const std::string &                       name,
+             const FileAccessMode                      mode,
+             const bool                                mpi,
+             const MPI_Comm                            mpi_communicator,
+             const std::map<std::string, std::string> &mpi_io_hints)
     : Group(name, mpi)
   {
     hdf5_reference = std::shared_ptr<hid_t>(new hid_t, [](hid_t *pointer) {
@@ -1431,12 +1707,30 @@ namespace HDF5
       {
 #  ifdef DEAL_II_WITH_MPI
 #    ifdef H5_HAVE_PARALLEL
-        const MPI_Info info = MPI_INFO_NULL;
+        MPI_Info info = MPI_INFO_NULL;
+        if (!mpi_io_hints.empty())
+          {
+            int ierr = MPI_Info_create(&info);
+            AssertThrowMPI(ierr);
+            for (const auto &hint : mpi_io_hints)
+              {
+                ierr = MPI_Info_set(info,
+                                    const_cast<char *>(hint.first.c_str()),
+                                    const_cast<char *>(hint.second.c_str()));
+                AssertThrowMPI(ierr);
+              }
+          }
 
         plist = H5Pcreate(H5P_FILE_ACCESS);
         Assert(plist >= 0, ExcMessage("Error at H5Pcreate"));
+        // HDF5 duplicates the info object, therefore it can be freed here
         ret = H5Pset_fapl_mpio(plist, mpi_communicator, info);
         Assert(ret >= 0, ExcMessage("Error at H5Pset_fapl_mpio"));
+        if (info != MPI_INFO_NULL)
+          {
+            const int ierr = MPI_Info_free(&info);
+            AssertThrowMPI(ierr);
+          }
 #    else
         AssertThrow(false, ExcMessage("HDF5 parallel support is disabled."));
 #    endif // H5_HAVE_PARALLEL
@@ -1474,6 +1768,7 @@ namespace HDF5
 
     (void)ret;
     (void)mpi_communicator;
+    (void)mpi_io_hints;
   }
 
 
@@ -1589,6 +1884,23 @@ namespace HDF5
   template void
   DataSet::write_none<unsigned int>();
 
+  template Threads::Task<>
+  DataSet::write_async<std::vector<int>>(const std::vector<int> &data);
+  template Threads::Task<>
+  DataSet::write_async<std::vector<unsigned int>>(
+    const std::vector<unsigned int> &data);
+
+  template Threads::Task<>
+  DataSet::write_hyperslab_async<std::vector<int>>(
+    const std::vector<int> &    data,
+    const std::vector<hsize_t> &offset,
+    const std::vector<hsize_t> &count);
+  template Threads::Task<>
+  DataSet::write_hyperslab_async<std::vector<unsigned int>>(
+    const std::vector<unsigned int> &data,
+    const std::vector<hsize_t> &     offset,
+    const std::vector<hsize_t> &     count);
+
   template DataSet
   Group::create_dataset<int>(const std::string &         name,
                              const std::vector<hsize_t> &dimensions) const;
@@ -1597,6 +1909,16 @@ namespace HDF5
     const std::string &         name,
     const std::vector<hsize_t> &dimensions) const;
 
+  template DataSet
+  Group::create_dataset<int>(const std::string &           name,
+                             const std::vector<hsize_t> &  dimensions,
+                             const DataSetCreationOptions &options) const;
+  template DataSet
+  Group::create_dataset<unsigned int>(
+    const std::string &           name,
+    const std::vector<hsize_t> &  dimensions,
+    const DataSetCreationOptions &options) const;
+
   template void
   Group::write_dataset<std::vector<int>>(const std::string &     name,
                                          const std::vector<int> &data) const;
@@ -104,6 +104,12 @@ IndexSet::do_compress() const
   // which itself calls the current function)
   std::lock_guard<std::mutex> lock(compress_mutex);
 
+  // another thread may have compressed the set while we were waiting for
+  // the lock. in that case, other threads may already be reading the
+  // compressed data, so we must not touch it again
+  if (is_compressed == true)
+    return;
+
   // see if any of the contiguous ranges can be merged. do not use
   // std::vector::erase in-place as it is quadratic in the number of
   // ranges. since the ranges are sorted by their first index, determining
@@ -186,9 +192,11 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
                    ((r2->begin <= r1->begin) && (r2->end > r1->begin)),
                  ExcInternalError());
 
-          // add the overlapping range to the result
-          result.add_range(std::max(r1->begin, r2->begin),
-                           std::min(r1->end, r2->end));
+          // add the overlapping range to the result. the overlaps are found
+          // in ascending order and do not overlap each other, so we can simply
+          // append them
+          result.ranges.emplace_back(std::max(r1->begin, r2->begin),
+                                     std::min(r1->end, r2->end));
 
           // now move that iterator that ends earlier one up. note that it has
           // to be this one because a subsequent range may still have a chance
@@ -200,6 +208,7 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
         }
     }
 
+  result.is_compressed = false;
   result.compress();
   return result;
 }
@@ -498,7 +507,41 @@ IndexSet::block_read(std::istream &in)
     in.read(reinterpret_cast<char *>(&*ranges.begin()),
             ranges.size() * sizeof(Range));
 
-  do_compress(); // needed so that largest_range can be recomputed
+  is_compressed = false;
+  compress(); // needed so that largest_range can be recomputed
+}
+
+
+
+void
+IndexSet::index_within_set(const std::vector<size_type> &global_indices,
+                           std::vector<size_type> &      local_indices) const
+{
+  // to make this call thread-safe, compress() must not be called through this
+  // function
+  Assert(is_compressed == true, ExcMessage("IndexSet must be compressed."));
+  Assert(std::is_sorted(global_indices.begin(), global_indices.end()),
+         ExcMessage("The given indices must be sorted."));
+
+  local_indices.resize(global_indices.size());
+
+  std::vector<Range>::const_iterator range = ranges.begin();
+  for (unsigned int i = 0; i < global_indices.size(); ++i)
+    {
+      const size_type index = global_indices[i];
+      AssertIndexRange(index, size());
+
+      // skip the ranges that end before the current index. since the
+      // indices are sorted, none of the subsequent indices can be in
+      // these ranges either
+      while (range != ranges.end() && range->end <= index)
+        ++range;
+
+      if (range != ranges.end() && range->begin <= index)
+        local_indices[i] = (index - range->begin) + range->nth_index_in_set;
+      else
+        local_indices[i] = numbers::invalid_dof_index;
+    }
 }
 
 
@@ -0,0 +1,264 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <numeric>
+#include <tuple>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation()
+      : ready_flag(false)
+      , communicator(MPI_COMM_SELF)
+      , unique_mapping(false)
+      , all_found(false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::~RemotePointEvaluation()
+    {
+      if (tria_signal.connected())
+        tria_signal.disconnect();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::reinit(
+      const std::vector<Point<spacedim>> &points,
+      const Triangulation<dim, spacedim> &tria,
+      const Mapping<dim, spacedim> &      mapping)
+    {
+      this->tria    = &tria;
+      this->mapping = &mapping;
+
+      if (tria_signal.connected())
+        tria_signal.disconnect();
+      tria_signal =
+        tria.signals.any_change.connect([&]() { this->ready_flag = false; });
+
+      const auto *tria_parallel =
+        dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+          &tria);
+      communicator = tria_parallel != nullptr ?
+                       tria_parallel->get_communicator() :
+                       MPI_COMM_SELF;
+      const unsigned int my_rank = this_mpi_process(communicator);
+
+      GridTools::Cache<dim, spacedim> cache(tria, mapping);
+
+      // find the cells and reference positions of the points on the locally
+      // owned part of the mesh, along with the rank that requested the point
+      // and the index of the point on that rank
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                             cells;
+      std::vector<std::vector<Point<dim>>>   reference_points;
+      std::vector<std::vector<unsigned int>> point_indices;
+      std::vector<std::vector<unsigned int>> owners;
+      if (tria_parallel != nullptr)
+        {
+          // the covering rtree describes the locally owned part of the mesh
+          // of all processes by bounding boxes, which allows us to identify
+          // the candidate owners of each point
+          std::vector<std::vector<BoundingBox<spacedim>>> global_bboxes(
+            n_mpi_processes(communicator));
+          for (const auto &box : cache.get_covering_rtree())
+            global_bboxes[box.second].push_back(box.first);
+
+          std::vector<std::vector<Point<spacedim>>> real_points;
+          std::tie(cells, reference_points, point_indices, real_points, owners) =
+            GridTools::distributed_compute_point_locations(cache,
+                                                           points,
+                                                           global_bboxes);
+        }
+      else
+        {
+          std::vector<unsigned int> missing_points;
+          std::tie(cells, reference_points, point_indices, missing_points) =
+            GridTools::compute_point_locations_try_all(cache, points);
+          owners.resize(cells.size());
+          for (unsigned int i = 0; i < cells.size(); ++i)
+            owners[i].resize(point_indices[i].size(), my_rank);
+        }
+
+      // set up the data on the evaluating side, sorted by cells
+      cell_data.cells.clear();
+      cell_data.reference_point_ptrs.assign(1, 0);
+      cell_data.reference_point_values.clear();
+
+      // (rank of requester, index on requester, index in cell ordering)
+      std::vector<std::tuple<unsigned int, unsigned int, unsigned int>>
+        point_map;
+      for (unsigned int i = 0; i < cells.size(); ++i)
+        {
+          cell_data.cells.emplace_back(cells[i]->level(), cells[i]->index());
+          for (unsigned int j = 0; j < reference_points[i].size(); ++j)
+            {
+              point_map.emplace_back(owners[i][j],
+                                     point_indices[i][j],
+                                     cell_data.reference_point_values.size());
+              cell_data.reference_point_values.push_back(
+                reference_points[i][j]);
+            }
+          cell_data.reference_point_ptrs.push_back(
+            cell_data.reference_point_values.size());
+        }
+
+      // sort by the requesting rank and the index of the point there, which
+      // defines the layout of the send buffer
+      std::sort(point_map.begin(), point_map.end());
+
+      send_permutation.resize(point_map.size());
+      send_ranks.clear();
+      send_ptrs.assign(1, 0);
+      std::map<unsigned int, std::vector<unsigned int>> indices_to_send;
+      for (unsigned int i = 0; i < point_map.size(); ++i)
+        {
+          const unsigned int rank = std::get<0>(point_map[i]);
+          if (send_ranks.empty() || send_ranks.back() != rank)
+            {
+              send_ranks.push_back(rank);
+              send_ptrs.push_back(send_ptrs.back());
+            }
+          ++send_ptrs.back();
+          send_permutation[std::get<2>(point_map[i])] = i;
+          indices_to_send[rank].push_back(std::get<1>(point_map[i]));
+        }
+
+      // tell the requesting processes which of their points will be
+      // delivered by this process and in which order; this is the only
+      // dynamic communication step, all later evaluations use the fixed
+      // pattern
+      const std::map<unsigned int, std::vector<unsigned int>>
+        received_indices = some_to_some(communicator, indices_to_send);
+
+      std::vector<unsigned int> n_entries_per_point(points.size(), 0);
+      for (const auto &rank_and_indices : received_indices)
+        for (const unsigned int index : rank_and_indices.second)
+          {
+            AssertIndexRange(index, points.size());
+            ++n_entries_per_point[index];
+          }
+
+      point_ptrs.resize(points.size() + 1);
+      point_ptrs[0] = 0;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        point_ptrs[i + 1] = point_ptrs[i] + n_entries_per_point[i];
+
+      recv_ranks.clear();
+      recv_ptrs.assign(1, 0);
+      recv_permutation.clear();
+      recv_permutation.reserve(point_ptrs.back());
+      std::vector<unsigned int> next_entry(point_ptrs.begin(),
+                                           point_ptrs.end() - 1);
+      for (const auto &rank_and_indices : received_indices)
+        {
+          recv_ranks.push_back(rank_and_indices.first);
+          for (const unsigned int index : rank_and_indices.second)
+            recv_permutation.push_back(next_entry[index]++);
+          recv_ptrs.push_back(recv_permutation.size());
+        }
+
+      bool local_unique = true, local_all_found = true;
+      for (const unsigned int n : n_entries_per_point)
+        {
+          if (n != 1)
+            local_unique = false;
+          if (n == 0)
+            local_all_found = false;
+        }
+      unique_mapping =
+        min(static_cast<unsigned int>(local_unique), communicator) == 1;
+      all_found =
+        min(static_cast<unsigned int>(local_all_found), communicator) == 1;
+
+      ready_flag = true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const std::vector<unsigned int> &
+    RemotePointEvaluation<dim, spacedim>::get_point_ptrs() const
+    {
+      return point_ptrs;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::is_map_unique() const
+    {
+      return unique_mapping;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::all_points_found() const
+    {
+      return all_found;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Triangulation<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_triangulation() const
+    {
+      return *tria;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Mapping<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_mapping() const
+    {
+      return *mapping;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::is_ready() const
+    {
+      return ready_flag;
+    }
+
+  } // end of namespace MPI
+} // end of namespace Utilities
+
+#include "mpi_remote_point_evaluation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
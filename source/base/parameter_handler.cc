@@ -16,6 +16,7 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
@@ -537,21 +538,89 @@ ParameterHandler::parse_input(const std::string &filename,
   std::ifstream is(filename);
   AssertThrow(is, PathSearch::ExcFileNotFound(filename, "ParameterHandler"));
 
+  parse_input_by_file_ending(is, filename, last_line, skip_undefined);
+
+  if (assert_mandatory_entries_are_found)
+    assert_that_entries_have_been_set();
+}
+
+
+
+void
+ParameterHandler::parse_input(const std::string &filename,
+                              const MPI_Comm &   mpi_communicator,
+                              const std::string &last_line,
+                              const bool         skip_undefined,
+                              const bool assert_mandatory_entries_are_found)
+{
+  if (Utilities::MPI::n_mpi_processes(mpi_communicator) == 1)
+    {
+      parse_input(filename,
+                  last_line,
+                  skip_undefined,
+                  assert_mandatory_entries_are_found);
+      return;
+    }
+
+#ifdef DEAL_II_WITH_MPI
+  // read the file on the root process and distribute its content. a
+  // negative size signals to all processes that the file could not be
+  // opened, so that they can throw the exception together
+  std::string content;
+  long long   size = -1;
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+    {
+      std::ifstream is(filename);
+      if (is)
+        {
+          std::ostringstream buffer;
+          buffer << is.rdbuf();
+          content = buffer.str();
+          size    = content.size();
+        }
+    }
+
+  int ierr = MPI_Bcast(&size, 1, MPI_LONG_LONG, 0, mpi_communicator);
+  AssertThrowMPI(ierr);
+  AssertThrow(size >= 0,
+              PathSearch::ExcFileNotFound(filename, "ParameterHandler"));
+
+  content.resize(size);
+  ierr = MPI_Bcast(&content[0],
+                   static_cast<int>(size),
+                   MPI_CHAR,
+                   0,
+                   mpi_communicator);
+  AssertThrowMPI(ierr);
+
+  std::istringstream is(content);
+  parse_input_by_file_ending(is, filename, last_line, skip_undefined);
+
+  if (assert_mandatory_entries_are_found)
+    assert_that_entries_have_been_set();
+#endif
+}
+
+
+
+void
+ParameterHandler::parse_input_by_file_ending(std::istream &     input,
+                                             const std::string &filename,
+                                             const std::string &last_line,
+                                             const bool         skip_undefined)
+{
   std::string file_ending = filename.substr(filename.find_last_of('.') + 1);
   boost::algorithm::to_lower(file_ending);
   if (file_ending == "prm")
-    parse_input(is, filename, last_line, skip_undefined);
+    parse_input(input, filename, last_line, skip_undefined);
   else if (file_ending == "xml")
-    parse_input_from_xml(is, skip_undefined);
+    parse_input_from_xml(input, skip_undefined);
   else if (file_ending == "json")
-    parse_input_from_json(is, skip_undefined);
+    parse_input_from_json(input, skip_undefined);
   else
     AssertThrow(false,
                 ExcMessage("Unknown input file name extension. Supported types "
                            "are .prm, .xml, and .json."));
-
-  if (assert_mandatory_entries_are_found)
-    assert_that_entries_have_been_set();
 }
 
 
@@ -1812,8 +1881,7 @@ ParameterHandler::scan_line(std::string        line,
     line.erase(line.find('#'), std::string::npos);
 
   // replace \t by space:
-  while (line.find('\t') != std::string::npos)
-    line.replace(line.find('\t'), 1, " ");
+  std::replace(line.begin(), line.end(), '\t', ' ');
 
   // trim start and end:
   line = Utilities::trim(line);
@@ -1881,29 +1949,31 @@ ParameterHandler::scan_line(std::string        line,
         Utilities::trim(std::string(line, pos + 1, std::string::npos));
 
       // resolve aliases before we look up the entry. if necessary, print
-      // a warning that the alias is deprecated
+      // a warning that the alias is deprecated. we look up the node of the
+      // entry only once and then access its fields directly, rather than
+      // walking down the whole tree again for every field
       std::string path = get_current_full_path(entry_name);
-      if (entries->get_optional<std::string>(path + path_separator + "alias"))
+      boost::optional<boost::property_tree::ptree &> entry =
+        entries->get_child_optional(path);
+      if (entry && entry->get_optional<std::string>("alias"))
         {
-          if (entries->get<std::string>(path + path_separator +
-                                        "deprecation_status") == "true")
+          if (entry->get<std::string>("deprecation_status") == "true")
             {
               std::cerr << "Warning in line <" << current_line_n
                         << "> of file <" << input_filename
                         << ">: You are using the deprecated spelling <"
                         << entry_name << "> of the parameter <"
-                        << entries->get<std::string>(path + path_separator +
-                                                     "alias")
-                        << ">." << std::endl;
+                        << entry->get<std::string>("alias") << ">."
+                        << std::endl;
             }
-          path = get_current_full_path(
-            entries->get<std::string>(path + path_separator + "alias"));
+          path  = get_current_full_path(entry->get<std::string>("alias"));
+          entry = entries->get_child_optional(path);
         }
 
-      // get the node for the entry. if it doesn't exist, then we end up
-      // in the else-branch below, which asserts that the entry is indeed
-      // declared
-      if (entries->get_optional<std::string>(path + path_separator + "value"))
+      // if the node for the entry doesn't exist or does not hold a value,
+      // then we end up in the else-branch below, which asserts that the
+      // entry is indeed declared
+      if (entry && entry->get_optional<std::string>("value"))
         {
           // if entry was declared: does it match the regex? if not, don't enter
           // it into the database exception: if it contains characters which
@@ -1912,7 +1982,7 @@ ParameterHandler::scan_line(std::string        line,
             {
               // verify that the new value satisfies the provided pattern
               const unsigned int pattern_index =
-                entries->get<unsigned int>(path + path_separator + "pattern");
+                entry->get<unsigned int>("pattern");
               AssertThrow(patterns[pattern_index]->match(entry_value),
                           ExcInvalidEntryForPattern(
                             current_line_n,
@@ -1924,8 +1994,7 @@ ParameterHandler::scan_line(std::string        line,
               // then also execute the actions associated with this
               // parameter (if any have been provided)
               const boost::optional<std::string> action_indices_as_string =
-                entries->get_optional<std::string>(path + path_separator +
-                                                   "actions");
+                entry->get_optional<std::string>("actions");
               if (action_indices_as_string)
                 {
                   std::vector<int> action_indices =
@@ -1938,7 +2007,7 @@ ParameterHandler::scan_line(std::string        line,
             }
 
           // finally write the new value into the database
-          entries->put(path + path_separator + "value", entry_value);
+          entry->put("value", entry_value);
         }
       else
         {
@@ -23,6 +23,155 @@ namespace Utilities
 {
   namespace MPI
   {
+    namespace internal
+    {
+      bool
+      PersistentRequestCache::Key::operator==(const Key &other) const
+      {
+        return is_import == other.is_import && channel == other.channel &&
+               ghost_array == other.ghost_array &&
+               ghost_array_size == other.ghost_array_size &&
+               temporary_storage == other.temporary_storage &&
+               entry_size == other.entry_size;
+      }
+
+
+
+      PersistentRequestCache::PersistentRequestCache(
+        const PersistentRequestCache &)
+      {}
+
+
+
+      PersistentRequestCache &
+      PersistentRequestCache::operator=(const PersistentRequestCache &)
+      {
+        clear();
+        return *this;
+      }
+
+
+
+      PersistentRequestCache::~PersistentRequestCache()
+      {
+        clear();
+      }
+
+
+
+      bool
+      PersistentRequestCache::acquire(const Key &               key,
+                                      std::vector<MPI_Request> &requests)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+          if (entry->in_use == false && entry->key == key)
+            {
+              requests = entry->requests;
+
+              // move the entry to the end of the list of recently used ones
+              Entry used_entry = std::move(*entry);
+              used_entry.in_use = true;
+              entries.erase(entry);
+              entries.push_back(std::move(used_entry));
+              return true;
+            }
+        return false;
+      }
+
+
+
+      void
+      PersistentRequestCache::insert(const Key &                     key,
+                                     const std::vector<MPI_Request> &requests)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // release the least recently used entry that is not in use if the
+        // cache is full
+        if (entries.size() >= max_n_entries)
+          for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+            if (entry->in_use == false)
+              {
+#ifdef DEAL_II_WITH_MPI
+                for (MPI_Request &request : entry->requests)
+                  {
+                    const int ierr = MPI_Request_free(&request);
+                    AssertThrowMPI(ierr);
+                  }
+#endif
+                entries.erase(entry);
+                break;
+              }
+
+        entries.push_back(Entry{key, requests, true});
+      }
+
+
+
+      void
+      PersistentRequestCache::release(const std::vector<MPI_Request> &requests)
+      {
+        if (requests.empty())
+          return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Entry &entry : entries)
+          if (entry.in_use && entry.requests == requests)
+            {
+              entry.in_use = false;
+              return;
+            }
+      }
+
+
+
+      void
+      PersistentRequestCache::erase(const std::vector<MPI_Request> &requests)
+      {
+        if (requests.empty())
+          return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+          if (entry->in_use && entry->requests == requests)
+            {
+              entries.erase(entry);
+              return;
+            }
+      }
+
+
+
+      void
+      PersistentRequestCache::clear()
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+#ifdef DEAL_II_WITH_MPI
+        // requests can only be freed while MPI is still active, which is not
+        // the case for partitioners destroyed at the end of the program
+        int mpi_is_finalized = 0;
+        int ierr             = MPI_Finalized(&mpi_is_finalized);
+        AssertThrowMPI(ierr);
+        if (mpi_is_finalized == 0)
+          for (Entry &entry : entries)
+            {
+              Assert(entry.in_use == false,
+                     ExcMessage("A persistent MPI request is freed while the "
+                                "communication is still running."));
+              for (MPI_Request &request : entry.requests)
+                {
+                  ierr = MPI_Request_free(&request);
+                  AssertThrowMPI(ierr);
+                }
+            }
+#endif
+        entries.clear();
+      }
+    } // namespace internal
+
+
+
     Partitioner::Partitioner()
       : global_size(0)
       , local_range_data(
@@ -34,6 +183,9 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , communicator_sm(MPI_COMM_SELF)
+      , n_ghost_targets_sm(0)
+      , n_import_targets_sm(0)
     {}
 
 
@@ -50,6 +202,9 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , communicator_sm(MPI_COMM_SELF)
+      , n_ghost_targets_sm(0)
+      , n_import_targets_sm(0)
     {
       locally_owned_range_data.add_range(0, size);
       locally_owned_range_data.compress();
@@ -70,6 +225,9 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , communicator_sm(MPI_COMM_SELF)
+      , n_ghost_targets_sm(0)
+      , n_import_targets_sm(0)
     {
       set_owned_indices(locally_owned_indices);
       set_ghost_indices(ghost_indices_in);
@@ -88,6 +246,9 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , communicator_sm(MPI_COMM_SELF)
+      , n_ghost_targets_sm(0)
+      , n_import_targets_sm(0)
     {
       set_owned_indices(locally_owned_indices);
     }
@@ -110,6 +271,8 @@ namespace Utilities
     void
     Partitioner::set_owned_indices(const IndexSet &locally_owned_indices)
     {
+      persistent_requests.clear();
+
       if (Utilities::MPI::job_supports_mpi() == true)
         {
           my_pid  = Utilities::MPI::this_mpi_process(communicator);
@@ -152,6 +315,14 @@ namespace Utilities
     Partitioner::set_ghost_indices(const IndexSet &ghost_indices_in,
                                    const IndexSet &larger_ghost_index_set)
     {
+      // the communication pattern changes, so the persistent requests and
+      // the shared-memory data set up for the old one cannot be used anymore
+      persistent_requests.clear();
+      ghost_targets_sm_ranks.clear();
+      import_targets_sm_ranks.clear();
+      n_ghost_targets_sm  = 0;
+      n_import_targets_sm = 0;
+
       // Set ghost indices from input. To be sure that no entries from the
       // locally owned range are present, subtract the locally owned indices
       // in any case.
@@ -232,22 +403,81 @@ namespace Utilities
       std::vector<unsigned int> owning_ranks_of_ghosts(
         ghost_indices_data.n_elements());
 
-      // set up dictionary
-      internal::ComputeIndexOwner::ConsensusAlgorithmsPayload process(
-        locally_owned_range_data,
-        ghost_indices_data,
-        communicator,
-        owning_ranks_of_ghosts,
-        /* track origins of ghosts*/ true);
-
-      // read dictionary by communicating with the process who owns the index
-      // in the static partition (i.e. in the dictionary). This process
-      // returns the actual owner of the index.
-      ConsensusAlgorithms::Selector<
-        std::pair<types::global_dof_index, types::global_dof_index>,
-        unsigned int>
-        consensus_algorithm(process, communicator);
-      consensus_algorithm.run();
+      // the indices that the other processes want to import from us
+      std::map<unsigned int, IndexSet> import_data;
+
+      // Every process owns a single contiguous range of indices. Collect
+      // these ranges from all processes: if the (nonempty) ranges are sorted
+      // by rank, as is the case for all the usual partitions, the owner of
+      // each ghost index can then be determined locally by walking through
+      // the sorted ghost indices and the ranges at the same time. This
+      // avoids the exchange with the processes that hold the respective
+      // part of the dictionary below. Since all processes see the same
+      // ranges, they all take the same branch.
+      std::vector<types::global_dof_index> all_ranges(2 * n_procs);
+      {
+        const types::global_dof_index my_range[2] = {local_range_data.first,
+                                                     local_range_data.second};
+
+        const int ierr = MPI_Allgather(my_range,
+                                       2,
+                                       DEAL_II_DOF_INDEX_MPI_TYPE,
+                                       all_ranges.data(),
+                                       2,
+                                       DEAL_II_DOF_INDEX_MPI_TYPE,
+                                       communicator);
+        AssertThrowMPI(ierr);
+      }
+
+      bool                    ranges_are_sorted_by_rank = true;
+      types::global_dof_index previous_end              = 0;
+      for (unsigned int p = 0; p < n_procs; ++p)
+        if (all_ranges[2 * p + 1] > all_ranges[2 * p])
+          {
+            if (all_ranges[2 * p] < previous_end)
+              ranges_are_sorted_by_rank = false;
+            previous_end = all_ranges[2 * p + 1];
+          }
+
+      if (ranges_are_sorted_by_rank)
+        {
+          unsigned int rank = 0;
+          unsigned int i    = 0;
+          for (const types::global_dof_index index : ghost_indices_data)
+            {
+              // skip the processes whose range ends before the current
+              // index, as well as those with empty ranges
+              while (rank < n_procs &&
+                     (all_ranges[2 * rank + 1] <= index ||
+                      all_ranges[2 * rank] == all_ranges[2 * rank + 1]))
+                ++rank;
+              Assert(rank < n_procs && all_ranges[2 * rank] <= index,
+                     ExcMessage("The ghost index " + std::to_string(index) +
+                                " is not owned by any process."));
+              owning_ranks_of_ghosts[i++] = rank;
+            }
+        }
+      else
+        {
+          // set up dictionary
+          internal::ComputeIndexOwner::ConsensusAlgorithmsPayload process(
+            locally_owned_range_data,
+            ghost_indices_data,
+            communicator,
+            owning_ranks_of_ghosts,
+            /* track origins of ghosts*/ true);
+
+          // read dictionary by communicating with the process who owns the
+          // index in the static partition (i.e. in the dictionary). This
+          // process returns the actual owner of the index.
+          ConsensusAlgorithms::Selector<
+            std::pair<types::global_dof_index, types::global_dof_index>,
+            unsigned int>
+            consensus_algorithm(process, communicator);
+          consensus_algorithm.run();
+
+          import_data = process.get_requesters();
+        }
 
       {
         ghost_targets_data = {};
@@ -269,8 +499,49 @@ namespace Utilities
           }
       }
 
-      // find how much the individual processes that want import from me
-      std::map<unsigned int, IndexSet> import_data = process.get_requesters();
+      // if we found the owners ourselves, we still need to tell them which
+      // of their indices we want to import. this only needs a single
+      // exchange with the processes we actually share indices with
+      if (ranges_are_sorted_by_rank)
+        {
+          using IndexRange =
+            std::pair<types::global_dof_index, types::global_dof_index>;
+
+          ConsensusAlgorithms::AnonymousProcess<IndexRange, unsigned int>
+            process(
+              [&]() {
+                std::vector<unsigned int> targets;
+                targets.reserve(ghost_targets_data.size());
+                for (const auto &target : ghost_targets_data)
+                  targets.push_back(target.first);
+                return targets;
+              },
+              [&](const unsigned int       other_rank,
+                  std::vector<IndexRange> &send_buffer) {
+                IndexSet owned_by_other_rank(size());
+                owned_by_other_rank.add_range(all_ranges[2 * other_rank],
+                                              all_ranges[2 * other_rank + 1]);
+                const IndexSet requested_indices =
+                  ghost_indices_data & owned_by_other_rank;
+                for (auto interval = requested_indices.begin_intervals();
+                     interval != requested_indices.end_intervals();
+                     ++interval)
+                  send_buffer.emplace_back(*interval->begin(),
+                                           interval->last() + 1);
+              },
+              [&](const unsigned int             other_rank,
+                  const std::vector<IndexRange> &buffer_recv,
+                  std::vector<unsigned int> &) {
+                IndexSet &requested_indices = import_data[other_rank];
+                requested_indices.set_size(size());
+                for (const auto &range : buffer_recv)
+                  requested_indices.add_range(range.first, range.second);
+                requested_indices.compress();
+              });
+          ConsensusAlgorithms::Selector<IndexRange, unsigned int>(process,
+                                                                  communicator)
+            .run();
+        }
 
       // count import requests and setup the compressed indices
       n_import_indices_data = 0;
@@ -380,21 +651,28 @@ namespace Utilities
           n_ghost_indices_in_larger_set = larger_ghost_index_set.n_elements();
 
           // first translate tight ghost indices into indices within the large
-          // set:
+          // set. the ghost indices are sorted, so we can do this for all of
+          // them at once:
+          std::vector<dealii::IndexSet::size_type> ghost_indices;
+          ghost_indices_data.fill_index_vector(ghost_indices);
+          std::vector<dealii::IndexSet::size_type> indices_in_larger_set;
+          larger_ghost_index_set.compress();
+          larger_ghost_index_set.index_within_set(ghost_indices,
+                                                  indices_in_larger_set);
+
           std::vector<unsigned int> expanded_numbering;
-          for (dealii::IndexSet::size_type index : ghost_indices_data)
+          expanded_numbering.reserve(indices_in_larger_set.size());
+          for (const dealii::IndexSet::size_type index : indices_in_larger_set)
             {
-              Assert(larger_ghost_index_set.is_element(index),
+              Assert(index != numbers::invalid_dof_index,
                      ExcMessage("The given larger ghost index set must contain "
                                 "all indices in the actual index set."));
               Assert(
-                larger_ghost_index_set.index_within_set(index) <
-                  static_cast<types::global_dof_index>(
-                    std::numeric_limits<unsigned int>::max()),
+                index < static_cast<types::global_dof_index>(
+                          std::numeric_limits<unsigned int>::max()),
                 ExcMessage(
                   "Index overflow: This class supports at most 2^32-1 ghost elements"));
-              expanded_numbering.push_back(
-                larger_ghost_index_set.index_within_set(index));
+              expanded_numbering.push_back(index);
             }
 
           // now rework expanded_numbering into ranges and store in:
@@ -427,10 +705,188 @@ namespace Utilities
             }
           ghost_indices_subset_data = ghost_indices_subset;
         }
+
+      initialize_shared_memory_data();
+    }
+
+
+
+    void
+    Partitioner::set_shared_memory_communicator(
+      const MPI_Comm &communicator_sm_in)
+    {
+      persistent_requests.clear();
+      communicator_sm = communicator_sm_in;
+      initialize_shared_memory_data();
     }
 
 
 
+    void
+    Partitioner::initialize_shared_memory_data()
+    {
+      ghost_targets_sm_ranks.clear();
+      n_ghost_targets_sm = 0;
+      ghost_indices_sm_data.clear();
+      ghost_indices_sm_chunks_by_rank_data.clear();
+      import_targets_sm_ranks.clear();
+      n_import_targets_sm = 0;
+      import_targets_sm_offsets.clear();
+
+#ifdef DEAL_II_WITH_MPI
+      if (n_procs < 2 || Utilities::MPI::n_mpi_processes(communicator_sm) < 2)
+        return;
+
+      // translate the ranks of the ghost and import targets into ranks
+      // within the shared-memory communicator, where MPI returns
+      // MPI_UNDEFINED for processes not part of it
+      MPI_Group group, group_sm;
+      int       ierr = MPI_Comm_group(communicator, &group);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_group(communicator_sm, &group_sm);
+      AssertThrowMPI(ierr);
+      const auto translate_ranks =
+        [&](const std::vector<std::pair<unsigned int, unsigned int>> &targets,
+            std::vector<unsigned int> &                               ranks_sm,
+            unsigned int &                                            n_sm) {
+          std::vector<int> ranks(targets.size());
+          std::vector<int> translated_ranks(targets.size());
+          for (unsigned int i = 0; i < targets.size(); ++i)
+            ranks[i] = targets[i].first;
+          const int ierr = MPI_Group_translate_ranks(group,
+                                                     ranks.size(),
+                                                     ranks.data(),
+                                                     group_sm,
+                                                     translated_ranks.data());
+          AssertThrowMPI(ierr);
+
+          ranks_sm.resize(targets.size());
+          n_sm = 0;
+          for (unsigned int i = 0; i < targets.size(); ++i)
+            if (translated_ranks[i] == MPI_UNDEFINED)
+              ranks_sm[i] = numbers::invalid_unsigned_int;
+            else
+              {
+                ranks_sm[i] = translated_ranks[i];
+                ++n_sm;
+              }
+        };
+      translate_ranks(ghost_targets_data,
+                      ghost_targets_sm_ranks,
+                      n_ghost_targets_sm);
+      translate_ranks(import_targets_data,
+                      import_targets_sm_ranks,
+                      n_import_targets_sm);
+      ierr = MPI_Group_free(&group);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Group_free(&group_sm);
+      AssertThrowMPI(ierr);
+
+      // express the ghost indices owned by processes sharing memory with us
+      // as ranges in the locally owned array of the owner, for which we need
+      // the first locally owned index of all processes
+      std::vector<types::global_dof_index> first_index_sm(
+        Utilities::MPI::n_mpi_processes(communicator_sm));
+      ierr = MPI_Allgather(&local_range_data.first,
+                           1,
+                           DEAL_II_DOF_INDEX_MPI_TYPE,
+                           first_index_sm.data(),
+                           1,
+                           DEAL_II_DOF_INDEX_MPI_TYPE,
+                           communicator_sm);
+      AssertThrowMPI(ierr);
+
+      ghost_indices_sm_chunks_by_rank_data.resize(ghost_targets_data.size() +
+                                                  1);
+      ghost_indices_sm_chunks_by_rank_data[0] = 0;
+      IndexSet::ElementIterator ghost_index = ghost_indices_data.begin();
+      for (unsigned int p = 0; p < ghost_targets_data.size(); ++p)
+        {
+          for (unsigned int i = 0; i < ghost_targets_data[p].second;
+               ++i, ++ghost_index)
+            if (ghost_targets_sm_ranks[p] != numbers::invalid_unsigned_int)
+              {
+                const unsigned int index =
+                  *ghost_index - first_index_sm[ghost_targets_sm_ranks[p]];
+                if (ghost_indices_sm_data.size() >
+                      ghost_indices_sm_chunks_by_rank_data[p] &&
+                    ghost_indices_sm_data.back().second == index)
+                  ++ghost_indices_sm_data.back().second;
+                else
+                  ghost_indices_sm_data.emplace_back(index, index + 1);
+              }
+          ghost_indices_sm_chunks_by_rank_data[p + 1] =
+            ghost_indices_sm_data.size();
+        }
+
+      // tell the owners sharing memory with us where our ghost values for
+      // them are placed in our array when they are sent back in
+      // import_from_ghosted_array_start(), i.e., after the locally owned
+      // entries and the ghost values for the lower ranks
+      const unsigned int mpi_tag =
+        Utilities::MPI::internal::Tags::partitioner_setup_shared_memory;
+      std::vector<unsigned int> send_offsets;
+      send_offsets.reserve(n_ghost_targets_sm);
+      std::vector<MPI_Request> requests;
+      requests.reserve(n_ghost_targets_sm + n_import_targets_sm);
+      unsigned int offset = local_size();
+      for (unsigned int p = 0; p < ghost_targets_data.size(); ++p)
+        {
+          if (ghost_targets_sm_ranks[p] != numbers::invalid_unsigned_int)
+            {
+              send_offsets.push_back(offset);
+              requests.emplace_back();
+              ierr = MPI_Isend(&send_offsets.back(),
+                               1,
+                               MPI_UNSIGNED,
+                               ghost_targets_data[p].first,
+                               mpi_tag,
+                               communicator,
+                               &requests.back());
+              AssertThrowMPI(ierr);
+            }
+          offset += ghost_targets_data[p].second;
+        }
+
+      import_targets_sm_offsets.resize(import_targets_data.size(), 0);
+      for (unsigned int p = 0; p < import_targets_data.size(); ++p)
+        if (import_targets_sm_ranks[p] != numbers::invalid_unsigned_int)
+          {
+            requests.emplace_back();
+            ierr = MPI_Irecv(&import_targets_sm_offsets[p],
+                             1,
+                             MPI_UNSIGNED,
+                             import_targets_data[p].first,
+                             mpi_tag,
+                             communicator,
+                             &requests.back());
+            AssertThrowMPI(ierr);
+          }
+
+      ierr =
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+#endif
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+    void
+    Partitioner::free_requests(std::vector<MPI_Request> &requests) const
+    {
+      persistent_requests.erase(requests);
+      for (MPI_Request &request : requests)
+        {
+          const int ierr = MPI_Request_free(&request);
+          AssertThrowMPI(ierr);
+        }
+      requests.clear();
+    }
+#endif
+
+
+
     bool
     Partitioner::is_compatible(const Partitioner &part) const
     {
@@ -483,6 +939,13 @@ namespace Utilities
       memory +=
         MemoryConsumption::memory_consumption(ghost_indices_subset_data);
       memory += MemoryConsumption::memory_consumption(ghost_indices_data);
+      memory += MemoryConsumption::memory_consumption(ghost_targets_sm_ranks);
+      memory += MemoryConsumption::memory_consumption(ghost_indices_sm_data);
+      memory += MemoryConsumption::memory_consumption(
+        ghost_indices_sm_chunks_by_rank_data);
+      memory += MemoryConsumption::memory_consumption(import_targets_sm_ranks);
+      memory +=
+        MemoryConsumption::memory_consumption(import_targets_sm_offsets);
       return memory;
     }
 
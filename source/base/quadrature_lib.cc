@@ -15,12 +15,16 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/polynomial.h>
+#include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature_lib.h>
 
 #include <algorithm>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -1350,6 +1354,221 @@ QSplit<dim>::QSplit(const QSimplex<dim> &base, const Point<dim> &split_point)
 
 
 
+namespace QuadratureRegistry
+{
+  namespace
+  {
+    /**
+     * Identifiers of the quadrature formulas stored in the registry.
+     */
+    enum class QuadratureKind
+    {
+      gauss,
+      gauss_lobatto,
+      gauss_radau_chebyshev
+    };
+
+    /**
+     * The mutex that protects all data of the registry.
+     */
+    std::mutex registry_mutex;
+
+    /**
+     * Return the rules stored for dimension @p dim, indexed by the kind of
+     * the rule, the number of points, and an additional parameter of the
+     * rule such as the end point of QGaussRadauChebyshev.
+     */
+    template <int dim>
+    std::map<std::tuple<QuadratureKind, unsigned int, unsigned int>,
+             std::shared_ptr<const Quadrature<dim>>> &
+    get_rules()
+    {
+      static std::map<std::tuple<QuadratureKind, unsigned int, unsigned int>,
+                      std::shared_ptr<const Quadrature<dim>>>
+        rules;
+      return rules;
+    }
+
+    /**
+     * Return the projections of face rules onto all faces (if @p subfaces
+     * is false) or all subfaces of the reference cell, together with the
+     * face rules they were computed from. Since face rules are identified by
+     * their points and weights, these are stored in a list that is searched
+     * linearly, which is cheap compared to the projection for the small
+     * number of different face rules used by typical programs.
+     */
+    template <int dim>
+    std::vector<std::pair<Quadrature<dim - 1>,
+                          std::shared_ptr<const Quadrature<dim>>>> &
+    get_face_projections(const bool subfaces)
+    {
+      static std::vector<
+        std::pair<Quadrature<dim - 1>, std::shared_ptr<const Quadrature<dim>>>>
+        projections[2];
+      return projections[subfaces ? 1 : 0];
+    }
+
+
+
+    template <int dim, typename CreatorType>
+    std::shared_ptr<const Quadrature<dim>>
+    get_or_create(const QuadratureKind kind,
+                  const unsigned int   n,
+                  const unsigned int   parameter,
+                  const CreatorType &  create)
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex);
+
+      std::shared_ptr<const Quadrature<dim>> &rule =
+        get_rules<dim>()[std::make_tuple(kind, n, parameter)];
+      if (rule == nullptr)
+        rule = create();
+      return rule;
+    }
+
+
+
+    template <int dim>
+    std::shared_ptr<const Quadrature<dim>>
+    get_or_create_projection(const Quadrature<dim - 1> &quadrature,
+                             const bool                 subfaces)
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex);
+
+      auto &projections = get_face_projections<dim>(subfaces);
+      for (const auto &entry : projections)
+        if (entry.first == quadrature)
+          return entry.second;
+
+      projections.emplace_back(
+        quadrature,
+        std::make_shared<const Quadrature<dim>>(
+          subfaces ? QProjector<dim>::project_to_all_subfaces(quadrature) :
+                     QProjector<dim>::project_to_all_faces(quadrature)));
+      return projections.back().second;
+    }
+  } // namespace
+
+
+
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  gauss(const unsigned int n)
+  {
+    return get_or_create<dim>(QuadratureKind::gauss, n, 0, [n]() {
+      return std::make_shared<const QGauss<dim>>(n);
+    });
+  }
+
+
+
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  gauss_lobatto(const unsigned int n)
+  {
+    return get_or_create<dim>(QuadratureKind::gauss_lobatto, n, 0, [n]() {
+      return std::make_shared<const QGaussLobatto<dim>>(n);
+    });
+  }
+
+
+
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  gauss_radau_chebyshev(
+    const unsigned int                                 n,
+    const typename QGaussRadauChebyshev<dim>::EndPoint end_point)
+  {
+    return get_or_create<dim>(
+      QuadratureKind::gauss_radau_chebyshev,
+      n,
+      static_cast<unsigned int>(end_point),
+      [n, end_point]() {
+        return std::make_shared<const QGaussRadauChebyshev<dim>>(n,
+                                                                 end_point);
+      });
+  }
+
+
+
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  project_to_all_faces(const Quadrature<dim - 1> &quadrature)
+  {
+    return get_or_create_projection<dim>(quadrature, false);
+  }
+
+
+
+  template <int dim>
+  std::shared_ptr<const Quadrature<dim>>
+  project_to_all_subfaces(const Quadrature<dim - 1> &quadrature)
+  {
+    return get_or_create_projection<dim>(quadrature, true);
+  }
+
+
+
+  void
+  clear()
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+
+    get_rules<1>().clear();
+    get_rules<2>().clear();
+    get_rules<3>().clear();
+    for (const bool subfaces : {false, true})
+      {
+        get_face_projections<1>(subfaces).clear();
+        get_face_projections<2>(subfaces).clear();
+        get_face_projections<3>(subfaces).clear();
+      }
+  }
+
+
+
+  // explicit instantiations
+  template std::shared_ptr<const Quadrature<1>>
+  gauss<1>(const unsigned int);
+  template std::shared_ptr<const Quadrature<2>>
+  gauss<2>(const unsigned int);
+  template std::shared_ptr<const Quadrature<3>>
+  gauss<3>(const unsigned int);
+
+  template std::shared_ptr<const Quadrature<1>>
+  gauss_lobatto<1>(const unsigned int);
+  template std::shared_ptr<const Quadrature<2>>
+  gauss_lobatto<2>(const unsigned int);
+  template std::shared_ptr<const Quadrature<3>>
+  gauss_lobatto<3>(const unsigned int);
+
+  template std::shared_ptr<const Quadrature<1>>
+  gauss_radau_chebyshev<1>(const unsigned int,
+                           const QGaussRadauChebyshev<1>::EndPoint);
+  template std::shared_ptr<const Quadrature<2>>
+  gauss_radau_chebyshev<2>(const unsigned int,
+                           const QGaussRadauChebyshev<2>::EndPoint);
+  template std::shared_ptr<const Quadrature<3>>
+  gauss_radau_chebyshev<3>(const unsigned int,
+                           const QGaussRadauChebyshev<3>::EndPoint);
+
+  template std::shared_ptr<const Quadrature<1>>
+  project_to_all_faces<1>(const Quadrature<0> &);
+  template std::shared_ptr<const Quadrature<2>>
+  project_to_all_faces<2>(const Quadrature<1> &);
+  template std::shared_ptr<const Quadrature<3>>
+  project_to_all_faces<3>(const Quadrature<2> &);
+
+  template std::shared_ptr<const Quadrature<1>>
+  project_to_all_subfaces<1>(const Quadrature<0> &);
+  template std::shared_ptr<const Quadrature<2>>
+  project_to_all_subfaces<2>(const Quadrature<1> &);
+  template std::shared_ptr<const Quadrature<3>>
+  project_to_all_subfaces<3>(const Quadrature<2> &);
+} // namespace QuadratureRegistry
+
+
+
 // explicit specialization
 // note that 1d formulae are specialized by implementation above
 template class QGauss<2>;
@@ -34,6 +34,43 @@ ScalarPolynomialsBase<dim>::ScalarPolynomialsBase(
 
 
 
+template <int dim>
+void
+ScalarPolynomialsBase<dim>::evaluate_values_and_gradients(
+  const ArrayView<const Point<dim>> &unit_points,
+  Table<2, double> &                 values,
+  Table<2, Tensor<1, dim>> &         grads) const
+{
+  const unsigned int n_points = unit_points.size();
+  Assert(values.n_rows() == 0 ||
+           (values.n_rows() == n_pols && values.n_cols() == n_points),
+         ExcDimensionMismatch2(values.n_rows(), n_pols, 0));
+  Assert(grads.n_rows() == 0 ||
+           (grads.n_rows() == n_pols && grads.n_cols() == n_points),
+         ExcDimensionMismatch2(grads.n_rows(), n_pols, 0));
+
+  std::vector<double>         point_values(values.n_rows() > 0 ? n_pols : 0);
+  std::vector<Tensor<1, dim>> point_grads(grads.n_rows() > 0 ? n_pols : 0);
+  std::vector<Tensor<2, dim>> grad_grads;
+  std::vector<Tensor<3, dim>> third_derivatives;
+  std::vector<Tensor<4, dim>> fourth_derivatives;
+  for (unsigned int q = 0; q < n_points; ++q)
+    {
+      evaluate(unit_points[q],
+               point_values,
+               point_grads,
+               grad_grads,
+               third_derivatives,
+               fourth_derivatives);
+      for (unsigned int i = 0; i < point_values.size(); ++i)
+        values(i, q) = point_values[i];
+      for (unsigned int i = 0; i < point_grads.size(); ++i)
+        grads(i, q) = point_grads[i];
+    }
+}
+
+
+
 template <int dim>
 std::size_t
 ScalarPolynomialsBase<dim>::memory_consumption() const
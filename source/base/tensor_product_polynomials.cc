@@ -13,13 +13,17 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/polynomials_piecewise.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
 
 #include <boost/container/small_vector.hpp>
 
+#include <algorithm>
 #include <array>
 #include <memory>
 
@@ -73,6 +77,40 @@ namespace internal
       indices[1] = (n / n_pols_0) % n_pols_1;
       indices[2] = n / (n_pols_0 * n_pols_1);
     }
+
+
+
+    // evaluate the value and the first @p n_derivatives derivatives of a
+    // one-dimensional polynomial at all lanes of @p x at once
+    inline void
+    evaluate_1d(const Polynomials::Polynomial<double> &polynomial,
+                const VectorizedArray<double> &        x,
+                const unsigned int                     n_derivatives,
+                VectorizedArray<double> *              values)
+    {
+      polynomial.value(x, n_derivatives, values);
+    }
+
+
+
+    // fallback for polynomials that can only be evaluated at one point at a
+    // time, such as piecewise polynomials
+    template <typename PolynomialType>
+    inline void
+    evaluate_1d(const PolynomialType &         polynomial,
+                const VectorizedArray<double> &x,
+                const unsigned int             n_derivatives,
+                VectorizedArray<double> *      values)
+    {
+      AssertIndexRange(n_derivatives, 2);
+      double point_values[2];
+      for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+        {
+          polynomial.value(x[v], n_derivatives, point_values);
+          for (unsigned int k = 0; k <= n_derivatives; ++k)
+            values[k][v] = point_values[k];
+        }
+    }
   } // namespace
 } // namespace internal
 
@@ -426,6 +464,118 @@ TensorProductPolynomials<dim, PolynomialType>::evaluate(
 
 
 
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim, PolynomialType>::evaluate_values_and_gradients(
+  const ArrayView<const Point<dim>> &unit_points,
+  Table<2, double> &                 values,
+  Table<2, Tensor<1, dim>> &         grads) const
+{
+  const unsigned int n_points = unit_points.size();
+  Assert(values.n_rows() == 0 ||
+           (values.n_rows() == this->n() && values.n_cols() == n_points),
+         ExcDimensionMismatch2(values.n_rows(), this->n(), 0));
+  Assert(grads.n_rows() == 0 ||
+           (grads.n_rows() == this->n() && grads.n_cols() == n_points),
+         ExcDimensionMismatch2(grads.n_rows(), this->n(), 0));
+
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+  std::vector<VectorizedArray<double>> point_values(
+    values.n_rows() > 0 ? this->n() : 0);
+  std::vector<Tensor<1, dim, VectorizedArray<double>>> point_grads(
+    grads.n_rows() > 0 ? this->n() : 0);
+
+  // evaluate batches of n_lanes points, with the unused lanes of the last
+  // batch set to zero
+  for (unsigned int q0 = 0; q0 < n_points; q0 += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_lanes, n_points - q0);
+
+      Point<dim, VectorizedArray<double>> p;
+      for (unsigned int v = 0; v < n_filled; ++v)
+        for (unsigned int d = 0; d < dim; ++d)
+          p[d][v] = unit_points[q0 + v][d];
+
+      evaluate_values_and_gradients(p,
+                                    make_array_view(point_values),
+                                    make_array_view(point_grads));
+
+      for (unsigned int i = 0; i < point_values.size(); ++i)
+        for (unsigned int v = 0; v < n_filled; ++v)
+          values(i, q0 + v) = point_values[i][v];
+      for (unsigned int i = 0; i < point_grads.size(); ++i)
+        for (unsigned int v = 0; v < n_filled; ++v)
+          for (unsigned int d = 0; d < dim; ++d)
+            grads(i, q0 + v)[d] = point_grads[i][d][v];
+    }
+}
+
+
+
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim, PolynomialType>::evaluate_values_and_gradients(
+  const Point<dim, VectorizedArray<double>> &               p,
+  const ArrayView<VectorizedArray<double>> &                values,
+  const ArrayView<Tensor<1, dim, VectorizedArray<double>>> &grads) const
+{
+  Assert(dim <= 3, ExcNotImplemented());
+  Assert(values.size() == this->n() || values.size() == 0,
+         ExcDimensionMismatch2(values.size(), this->n(), 0));
+  Assert(grads.size() == this->n() || grads.size() == 0,
+         ExcDimensionMismatch2(grads.size(), this->n(), 0));
+
+  const bool update_values = (values.size() == this->n()),
+             update_grads  = (grads.size() == this->n());
+  if (update_values == false && update_grads == false)
+    return;
+
+  // as in evaluate(), first compute the values (and derivatives, if
+  // necessary) of all 1D polynomials and then build the tensor product
+  const unsigned int n_derivatives = update_grads ? 1 : 0;
+  const unsigned int n_polynomials = polynomials.size();
+  boost::container::small_vector<
+    std::array<std::array<VectorizedArray<double>, 2>, dim>,
+    20>
+    values_1d(n_polynomials);
+  for (unsigned int i = 0; i < n_polynomials; ++i)
+    for (unsigned int d = 0; d < dim; ++d)
+      internal::evaluate_1d(polynomials[i],
+                            p[d],
+                            n_derivatives,
+                            values_1d[i][d].data());
+
+  unsigned int indices[3];
+  unsigned int ind = 0;
+  for (indices[2] = 0; indices[2] < (dim > 2 ? n_polynomials : 1); ++indices[2])
+    for (indices[1] = 0; indices[1] < (dim > 1 ? n_polynomials : 1);
+         ++indices[1])
+      for (indices[0] = 0; indices[0] < n_polynomials; ++indices[0], ++ind)
+        {
+          const unsigned int i = index_map_inverse[ind];
+
+          if (update_values)
+            {
+              VectorizedArray<double> value = values_1d[indices[0]][0][0];
+              for (unsigned int x = 1; x < dim; ++x)
+                value *= values_1d[indices[x]][x][0];
+              values[i] = value;
+            }
+
+          if (update_grads)
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                VectorizedArray<double> grad =
+                  values_1d[indices[0]][0][(d == 0) ? 1 : 0];
+                for (unsigned int x = 1; x < dim; ++x)
+                  grad *= values_1d[indices[x]][x][(d == x) ? 1 : 0];
+                grads[i][d] = grad;
+              }
+        }
+}
+
+
+
 template <int dim, typename PolynomialType>
 std::unique_ptr<ScalarPolynomialsBase<dim>>
 TensorProductPolynomials<dim, PolynomialType>::clone() const
@@ -412,8 +412,14 @@ TimerOutput::enter_subsection(const std::string &section_name)
          ExcMessage(std::string("Cannot enter the already active section <") +
                     section_name + ">."));
 
-  if (sections.find(section_name) == sections.end())
+  // look up the section only once, creating it if it does not exist yet,
+  // since this function may be called very often
+  std::map<std::string, Section>::iterator section =
+    sections.lower_bound(section_name);
+  if (section == sections.end() || section->first != section_name)
     {
+      section = sections.emplace_hint(section, section_name, Section());
+
       if (mpi_communicator != MPI_COMM_SELF)
         {
           // create a new timer for this section. the second argument
@@ -423,18 +429,18 @@ TimerOutput::enter_subsection(const std::string &section_name)
           // The mpi_communicator from TimerOutput is passed to the
           // Timer here, so this Timer will collect timing information
           // among all processes inside mpi_communicator.
-          sections[section_name].timer = Timer(mpi_communicator, true);
+          section->second.timer = Timer(mpi_communicator, true);
         }
 
 
-      sections[section_name].total_cpu_time  = 0;
-      sections[section_name].total_wall_time = 0;
-      sections[section_name].n_calls         = 0;
+      section->second.total_cpu_time  = 0;
+      section->second.total_wall_time = 0;
+      section->second.n_calls         = 0;
     }
 
-  sections[section_name].timer.reset();
-  sections[section_name].timer.start();
-  sections[section_name].n_calls++;
+  section->second.timer.reset();
+  section->second.timer.start();
+  section->second.n_calls++;
 
   active_sections.push_back(section_name);
 }
@@ -464,16 +470,18 @@ TimerOutput::leave_subsection(const std::string &section_name)
   const std::string actual_section_name =
     (section_name.empty() ? active_sections.back() : section_name);
 
-  sections[actual_section_name].timer.stop();
-  sections[actual_section_name].total_wall_time +=
-    sections[actual_section_name].timer.last_wall_time();
+  // look up the section only once
+  Section &section = sections[actual_section_name];
+
+  section.timer.stop();
+  section.total_wall_time += section.timer.last_wall_time();
 
   // Get cpu time. On MPI systems, if constructed with an mpi_communicator
   // like MPI_COMM_WORLD, then the Timer will sum up the CPU time between
   // processors among the provided mpi_communicator. Therefore, no
   // communication is needed here.
-  const double cpu_time = sections[actual_section_name].timer.last_cpu_time();
-  sections[actual_section_name].total_cpu_time += cpu_time;
+  const double cpu_time = section.timer.last_cpu_time();
+  section.total_cpu_time += cpu_time;
 
   // in case we have to print out something, do that here...
   if ((output_frequency == every_call ||
@@ -484,7 +492,7 @@ TimerOutput::leave_subsection(const std::string &section_name)
       std::ostringstream cpu;
       cpu << cpu_time << "s";
       std::ostringstream wall;
-      wall << sections[actual_section_name].timer.last_wall_time() << "s";
+      wall << section.timer.last_wall_time() << "s";
       if (output_type == cpu_times)
         output_time = ", CPU time: " + cpu.str();
       else if (output_type == wall_times)
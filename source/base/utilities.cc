@@ -62,6 +62,11 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #  include <cstdlib>
 #endif
 
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
 
 #ifdef DEAL_II_WITH_TRILINOS
 #  ifdef DEAL_II_WITH_MPI
@@ -949,8 +954,10 @@ namespace Utilities
           case 0:
             return "disabled";
           case 128:
-#ifdef __ALTIVEC__
+#if defined(__ALTIVEC__)
             return "AltiVec";
+#elif defined(__ARM_NEON)
+            return "NEON";
 #else
             return "SSE2";
 #endif
@@ -1066,6 +1073,31 @@ namespace Utilities
 
 
 
+    void
+    advise_huge_pages(void *ptr, std::size_t size)
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      // madvise() requires a page-aligned start address, so only pass on
+      // the part of the region that starts at the first full page
+      const std::size_t page_size = ::sysconf(_SC_PAGESIZE);
+      const std::size_t start     = reinterpret_cast<std::size_t>(ptr);
+      const std::size_t aligned_start =
+        (start + page_size - 1) / page_size * page_size;
+      if (aligned_start < start + size)
+        // the advice is only a hint to the kernel, so there is nothing to
+        // do if it gets rejected (e.g. when transparent huge pages are
+        // disabled on the system)
+        (void)::madvise(reinterpret_cast<void *>(aligned_start),
+                        start + size - aligned_start,
+                        MADV_HUGEPAGE);
+#else
+      (void)ptr;
+      (void)size;
+#endif
+    }
+
+
+
     bool
     job_supports_mpi()
     {
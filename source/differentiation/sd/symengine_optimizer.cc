@@ -23,6 +23,10 @@
 #  include <boost/archive/text_iarchive.hpp>
 #  include <boost/archive/text_oarchive.hpp>
 
+#  include <cstdio>
+#  include <fstream>
+#  include <sstream>
+#  include <string>
 #  include <utility>
 
 DEAL_II_NAMESPACE_OPEN
@@ -372,6 +376,118 @@ namespace Differentiation
 
 
 
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::optimize(const std::string &cache_directory,
+                                         const MPI_Comm &   mpi_communicator)
+    {
+      Assert(optimized() == false,
+             ExcMessage("Cannot call optimize() more than once."));
+
+      // The root process either reads the serialized optimizer from the
+      // cache, or performs the optimization and writes it to the cache.
+      std::string serialized_optimizer;
+      bool        optimized_here = false;
+      if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+        {
+          const std::string filename = cache_directory + "/batch_optimizer_" +
+                                       std::to_string(hash()) + ".txt";
+
+          std::ifstream ifs(filename);
+          if (ifs)
+            {
+              std::ostringstream oss;
+              oss << ifs.rdbuf();
+              serialized_optimizer = oss.str();
+            }
+          else
+            {
+              optimize();
+              optimized_here = true;
+
+              std::ostringstream oss;
+              {
+                boost::archive::text_oarchive oa(oss);
+                oa << *this;
+              }
+              serialized_optimizer = oss.str();
+
+              // Write to a temporary file first, so that other runs never
+              // read an incomplete cache entry.
+              const std::string tmp_filename = filename + ".tmp";
+              {
+                std::ofstream ofs(tmp_filename);
+                ofs << serialized_optimizer;
+                AssertThrow(ofs, ExcIO());
+              }
+              AssertThrow(std::rename(tmp_filename.c_str(),
+                                      filename.c_str()) == 0,
+                          ExcIO());
+            }
+        }
+
+#  ifdef DEAL_II_WITH_MPI
+      if (dealii::Utilities::MPI::n_mpi_processes(mpi_communicator) > 1)
+        {
+          unsigned long long size = serialized_optimizer.size();
+          int                ierr =
+            MPI_Bcast(&size, 1, MPI_UNSIGNED_LONG_LONG, 0, mpi_communicator);
+          AssertThrowMPI(ierr);
+
+          serialized_optimizer.resize(size);
+          ierr = MPI_Bcast(&serialized_optimizer[0],
+                           static_cast<int>(size),
+                           MPI_CHAR,
+                           0,
+                           mpi_communicator);
+          AssertThrowMPI(ierr);
+        }
+#  endif
+
+      if (optimized_here == true)
+        return;
+
+      // Discard the data that is restored by the deserialization
+      dependent_variables_output.clear();
+      map_dep_expr_vec_entry.clear();
+      independent_variables_symbols.clear();
+      dependent_variables_functions.clear();
+      optimizer.reset();
+      ready_for_value_extraction = false;
+
+      std::istringstream            iss(serialized_optimizer);
+      boost::archive::text_iarchive ia(iss);
+      ia >> *this;
+    }
+
+
+
+    template <typename ReturnType>
+    std::size_t
+    BatchOptimizer<ReturnType>::hash() const
+    {
+      SymEngine::hash_t seed = 0;
+      SymEngine::hash_combine(
+        seed,
+        static_cast<typename std::underlying_type<OptimizerType>::type>(
+          method));
+      SymEngine::hash_combine(
+        seed,
+        static_cast<typename std::underlying_type<OptimizationFlags>::type>(
+          flags));
+
+      // The map is ordered, so that the symbols are combined in the same
+      // order on all processes.
+      for (const auto &entry : independent_variables_symbols)
+        SymEngine::hash_combine(seed, entry.first.get_RCP()->hash());
+      for (const auto &function : dependent_variables_functions)
+        SymEngine::hash_combine(seed, function.get_RCP()->hash());
+
+      return seed;
+    }
+
+
+
     template <typename ReturnType>
     void
     BatchOptimizer<ReturnType>::substitute(
@@ -31,6 +31,7 @@
 #  include <deal.II/grid/tria_iterator.h>
 
 #  include <algorithm>
+#  include <cmath>
 #  include <functional>
 #  include <limits>
 #  include <numeric>
@@ -162,6 +163,124 @@ namespace
 
 
 
+  /**
+   * Number of test thresholds minus one that the `compute_threshold`
+   * functions examine in each round. Rather than bisecting the interesting
+   * range, which requires one global reduction for every halving of the
+   * range, we evaluate the criteria against all of these thresholds at
+   * once and shrink the range by a factor of this number per reduction.
+   */
+  constexpr unsigned int n_threshold_bins = 64;
+
+  /**
+   * Maximal number of rounds in the `compute_threshold` functions. Each
+   * round shrinks the interesting range by a factor of n_threshold_bins, so
+   * five rounds resolve it at least as finely as the 25 bisection steps we
+   * used to perform.
+   */
+  constexpr unsigned int max_threshold_rounds = 5;
+
+
+
+  /**
+   * Subdivide the interesting range into n_threshold_bins intervals and
+   * return the n_threshold_bins+1 end points of these intervals. The
+   * subdivision is geometric if the range is positive, for the same reason
+   * the bisection used the geometric mean as split point in that case, and
+   * arithmetic otherwise.
+   */
+  std::vector<double>
+  compute_test_thresholds(const double (&interesting_range)[2])
+  {
+    std::vector<double> thresholds(n_threshold_bins + 1);
+    if (interesting_range[0] > 0)
+      {
+        const double ratio = interesting_range[1] / interesting_range[0];
+        for (unsigned int k = 0; k <= n_threshold_bins; ++k)
+          thresholds[k] =
+            interesting_range[0] *
+            std::pow(ratio, static_cast<double>(k) / n_threshold_bins);
+      }
+    else
+      for (unsigned int k = 0; k <= n_threshold_bins; ++k)
+        thresholds[k] =
+          interesting_range[0] + (interesting_range[1] - interesting_range[0]) *
+                                   k / n_threshold_bins;
+
+    // avoid round-off at the end points
+    thresholds.front() = interesting_range[0];
+    thresholds.back()  = interesting_range[1];
+    return thresholds;
+  }
+
+
+
+  /**
+   * For each of the given @p thresholds, return the sum of @p weight over
+   * all of the locally owned criteria that are larger than the threshold.
+   * The criteria are sorted into the intervals between the thresholds in a
+   * single pass, followed by a suffix sum over the intervals.
+   */
+  template <typename T, typename number, typename WeightFunction>
+  std::vector<T>
+  compute_local_sums_above_thresholds(const dealii::Vector<number> &criteria,
+                                      const std::vector<double> &   thresholds,
+                                      const WeightFunction &        weight)
+  {
+    // entry j holds criteria c with thresholds[j] < c <= thresholds[j+1],
+    // and the last entry those larger than the largest threshold
+    std::vector<T> sums(thresholds.size(), T());
+    for (const number c : criteria)
+      {
+        const std::size_t k =
+          std::lower_bound(thresholds.begin(), thresholds.end(), c) -
+          thresholds.begin();
+        if (k > 0)
+          sums[k - 1] += weight(c);
+      }
+
+    for (unsigned int j = sums.size() - 1; j > 0; --j)
+      sums[j - 1] += sums[j];
+    return sums;
+  }
+
+
+
+  /**
+   * Given the global sums @p sums_above of the quantity that we want to
+   * match with @p target for all of the @p thresholds, shrink the
+   * interesting range to the interval between the two thresholds that
+   * enclose the target. Since the sums decrease with the threshold, this is
+   * the interval that ends at the first threshold whose sum does not exceed
+   * the target. If that sum matches the target exactly, the range collapses
+   * to this threshold.
+   */
+  template <typename T>
+  void
+  shrink_interesting_range(const std::vector<double> &thresholds,
+                           const std::vector<T> &     sums_above,
+                           const T                    target,
+                           double (&interesting_range)[2])
+  {
+    for (unsigned int k = 0; k < thresholds.size(); ++k)
+      if (sums_above[k] <= target)
+        {
+          if (sums_above[k] == target || k == 0)
+            interesting_range[0] = interesting_range[1] = thresholds[k];
+          else
+            {
+              interesting_range[0] = thresholds[k - 1];
+              interesting_range[1] = thresholds[k];
+            }
+          return;
+        }
+
+    // even the largest threshold leaves too much above it
+    interesting_range[0] = interesting_range[1] = thresholds.back();
+  }
+
+
+
   /**
    * Given a vector of criteria and bottom and top thresholds for coarsening and
    * refinement, mark all those cells that we locally own as appropriate for
@@ -256,51 +375,45 @@ namespace internal
                 if (interesting_range[0] == interesting_range[1])
                   return interesting_range[0];
 
-                const double test_threshold =
-                  (interesting_range[0] > 0 ?
-                     std::sqrt(interesting_range[0] * interesting_range[1]) :
-                     (interesting_range[0] + interesting_range[1]) / 2);
-
-                // Count how many of our own elements would be above this
-                // threshold. Use a 64bit result type if we are compiling with
-                // 64bit indices to avoid an overflow when computing the sum
-                // below.
-                const types::global_cell_index my_count =
-                  std::count_if(criteria.begin(),
-                                criteria.end(),
-                                [test_threshold](const double c) {
-                                  return c > test_threshold;
-                                });
-                const types::global_cell_index total_count =
-                  Utilities::MPI::sum(my_count, mpi_communicator);
-
-                // now adjust the range. if we have too many cells, we take the
-                // upper half of the previous range, otherwise the lower half.
-                // if we have hit the right number, then set the range to the
-                // exact value. slave nodes also update their own
+                // Count how many of our own elements would be above each of
+                // the test thresholds, and sum these numbers up over all
+                // processors in a single reduction. Use a 64bit result type if
+                // we are compiling with 64bit indices to avoid an overflow when
+                // computing the sum below.
+                const std::vector<double> test_thresholds =
+                  compute_test_thresholds(interesting_range);
+                const std::vector<types::global_cell_index> my_counts =
+                  compute_local_sums_above_thresholds<
+                    types::global_cell_index>(criteria,
+                                              test_thresholds,
+                                              [](const number) {
+                                                return 1;
+                                              });
+                std::vector<types::global_cell_index> total_counts(
+                  my_counts.size());
+                Utilities::MPI::sum(my_counts, mpi_communicator, total_counts);
+
+                // now shrink the range to the interval that contains the
+                // target number of cells. slave nodes also update their own
                 // interesting_range, however their results are not significant
                 // since the values will be overwritten by MPI_Bcast from the
                 // master node in next loop.
-                if (total_count > n_target_cells)
-                  interesting_range[0] = test_threshold;
-                else if (total_count < n_target_cells)
-                  interesting_range[1] = test_threshold;
-                else
-                  interesting_range[0] = interesting_range[1] = test_threshold;
-
-                // terminate the iteration after 25 go-arounds. this is
-                // necessary because oftentimes error indicators on cells have
-                // exactly the same value, and so there may not be a particular
-                // value that cuts the indicators in such a way that we can
-                // achieve the desired number of cells. using a maximal number
-                // of iterations means that we terminate the iteration after a
-                // fixed number N of steps if the indicators were perfectly
-                // badly distributed, and we make at most a mistake of 1/2^N in
-                // the number of cells flagged if indicators are perfectly
-                // equidistributed
+                shrink_interesting_range(test_thresholds,
+                                         total_counts,
+                                         n_target_cells,
+                                         interesting_range);
+
+                // terminate the iteration after a fixed number of rounds. this
+                // is necessary because oftentimes error indicators on cells
+                // have exactly the same value, and so there may not be a
+                // particular value that cuts the indicators in such a way that
+                // we can achieve the desired number of cells. using a maximal
+                // number of rounds means that we make at most a mistake of
+                // 1/n_threshold_bins^max_threshold_rounds in the number of
+                // cells flagged if indicators are perfectly equidistributed
                 ++iteration;
-                if (iteration == 25)
-                  interesting_range[0] = interesting_range[1] = test_threshold;
+                if (iteration == max_threshold_rounds)
+                  interesting_range[0] = interesting_range[1];
               }
             while (true);
 
@@ -357,56 +470,49 @@ namespace internal
                     return final_threshold;
                   }
 
-                const double test_threshold =
-                  (interesting_range[0] > 0 ?
-                     std::sqrt(interesting_range[0] * interesting_range[1]) :
-                     (interesting_range[0] + interesting_range[1]) / 2);
-
-                // accumulate the error of those our own elements above this
-                // threshold and then add to it the number for all the others
-                double my_error = 0;
-                for (unsigned int i = 0; i < criteria.size(); ++i)
-                  if (criteria(i) > test_threshold)
-                    my_error += criteria(i);
-
-                double total_error = 0.;
-
-                ierr = MPI_Reduce(&my_error,
-                                  &total_error,
-                                  1,
+                // accumulate the error of those our own elements above each
+                // of the test thresholds and then add to it the numbers for
+                // all the others in a single reduction
+                const std::vector<double> test_thresholds =
+                  compute_test_thresholds(interesting_range);
+                const std::vector<double> my_errors =
+                  compute_local_sums_above_thresholds<double>(
+                    criteria, test_thresholds, [](const number c) {
+                      return static_cast<double>(c);
+                    });
+
+                std::vector<double> total_errors(my_errors.size(), 0.);
+                ierr = MPI_Reduce(my_errors.data(),
+                                  total_errors.data(),
+                                  my_errors.size(),
                                   MPI_DOUBLE,
                                   MPI_SUM,
                                   master_mpi_rank,
                                   mpi_communicator);
                 AssertThrowMPI(ierr);
 
-                // now adjust the range. if we have too many cells, we take the
-                // upper half of the previous range, otherwise the lower half.
-                // if we have hit the right number, then set the range to the
-                // exact value. slave nodes also update their own
+                // now shrink the range to the interval that contains the
+                // target error. slave nodes also update their own
                 // interesting_range, however their results are not significant
                 // since the values will be overwritten by MPI_Bcast from the
                 // master node in next loop.
-                if (total_error > target_error)
-                  interesting_range[0] = test_threshold;
-                else if (total_error < target_error)
-                  interesting_range[1] = test_threshold;
-                else
-                  interesting_range[0] = interesting_range[1] = test_threshold;
-
-                // terminate the iteration after 25 go-arounds. this is
-                // necessary because oftentimes error indicators on cells
+                shrink_interesting_range(test_thresholds,
+                                         total_errors,
+                                         target_error,
+                                         interesting_range);
+
+                // terminate the iteration after a fixed number of rounds. this
+                // is necessary because oftentimes error indicators on cells
                 // have exactly the same value, and so there may not be a
                 // particular value that cuts the indicators in such a way
                 // that we can achieve the desired number of cells. using a
-                // max of 25 iterations means that we terminate the
-                // iteration after 25 steps if the indicators were perfectly
-                // badly distributed, and we make at most a mistake of
-                // 1/2^25 in the number of cells flagged if indicators are
-                // perfectly equidistributed
+                // maximal number of rounds means that we make at most a
+                // mistake of 1/n_threshold_bins^max_threshold_rounds in the
+                // number of cells flagged if indicators are perfectly
+                // equidistributed
                 ++iteration;
-                if (iteration == 25)
-                  interesting_range[0] = interesting_range[1] = test_threshold;
+                if (iteration == max_threshold_rounds)
+                  interesting_range[0] = interesting_range[1];
               }
             while (true);
 
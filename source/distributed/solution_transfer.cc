@@ -38,6 +38,8 @@
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
 
+#  include <algorithm>
+#  include <cstring>
 #  include <functional>
 #  include <numeric>
 
@@ -45,68 +47,6 @@
 DEAL_II_NAMESPACE_OPEN
 
 
-namespace
-{
-  /**
-   * Optimized pack function for values assigned on degrees of freedom.
-   *
-   * Given that the elements of @p dof_values are stored in consecutive
-   * locations, we can just memcpy them. Since floating point values don't
-   * compress well, we also forgo the compression the default
-   * Utilities::pack() and Utilities::unpack() functions offer.
-   */
-  template <typename value_type>
-  std::vector<char>
-  pack_dof_values(std::vector<Vector<value_type>> &dof_values,
-                  const unsigned int               dofs_per_cell)
-  {
-    for (const auto &values : dof_values)
-      {
-        AssertDimension(values.size(), dofs_per_cell);
-        (void)values;
-      }
-
-    const std::size_t bytes_per_entry = sizeof(value_type) * dofs_per_cell;
-
-    std::vector<char> buffer(dof_values.size() * bytes_per_entry);
-    for (unsigned int i = 0; i < dof_values.size(); ++i)
-      std::memcpy(&buffer[i * bytes_per_entry],
-                  &dof_values[i](0),
-                  bytes_per_entry);
-
-    return buffer;
-  }
-
-
-
-  /**
-   * Optimized unpack function for values assigned on degrees of freedom.
-   */
-  template <typename value_type>
-  std::vector<Vector<value_type>>
-  unpack_dof_values(
-    const boost::iterator_range<std::vector<char>::const_iterator> &data_range,
-    const unsigned int dofs_per_cell)
-  {
-    const std::size_t  bytes_per_entry = sizeof(value_type) * dofs_per_cell;
-    const unsigned int n_elements      = data_range.size() / bytes_per_entry;
-
-    Assert((data_range.size() % bytes_per_entry == 0), ExcInternalError());
-
-    std::vector<Vector<value_type>> unpacked_data;
-    unpacked_data.reserve(n_elements);
-    for (unsigned int i = 0; i < n_elements; ++i)
-      {
-        Vector<value_type> dof_values(dofs_per_cell);
-        std::memcpy(&dof_values(0),
-                    &(*std::next(data_range.begin(), i * bytes_per_entry)),
-                    bytes_per_entry);
-        unpacked_data.emplace_back(std::move(dof_values));
-      }
-
-    return unpacked_data;
-  }
-} // namespace
 
 
 
@@ -362,19 +302,70 @@ namespace parallel
             }
         }
 
-      const unsigned int dofs_per_cell =
-        dof_handler->get_fe(fe_index).dofs_per_cell;
-
-      auto it_input  = input_vectors.cbegin();
-      auto it_output = dof_values.begin();
-      for (; it_input != input_vectors.cend(); ++it_input, ++it_output)
+      const FiniteElement<dim, DoFHandlerType::space_dimension> &fe =
+        dof_handler->get_fe(fe_index);
+      const unsigned int dofs_per_cell = fe.dofs_per_cell;
+      const unsigned int n_vectors     = input_vectors.size();
+
+      // All vectors are packed into a single record of n_vectors *
+      // dofs_per_cell entries. Given that these entries are stored in
+      // consecutive locations, we can just memcpy them. Since floating point
+      // values don't compress well, we also forgo the compression the default
+      // Utilities::pack() and Utilities::unpack() functions offer.
+      const std::size_t bytes_per_entry =
+        sizeof(typename VectorType::value_type) * dofs_per_cell;
+      std::vector<char> buffer(n_vectors * bytes_per_entry);
+      if (dofs_per_cell == 0 || n_vectors == 0)
+        return buffer;
+
+      ::dealii::Vector<typename VectorType::value_type> all_values(
+        n_vectors * dofs_per_cell);
+      ::dealii::Vector<typename VectorType::value_type> local_values(
+        dofs_per_cell);
+
+      if (cell->has_children())
         {
-          it_output->reinit(dofs_per_cell);
-          cell->get_interpolated_dof_values(*(*it_input), *it_output, fe_index);
+          // The cell is about to be coarsened. Rather than letting
+          // get_interpolated_dof_values() walk over the children once for
+          // every vector, visit each child only once, query its restriction
+          // matrix, and restrict the values of all vectors in turn. The
+          // rules for adding up or overwriting the child contributions are
+          // the same as in DoFCellAccessor::get_interpolated_dof_values().
+          ::dealii::Vector<typename VectorType::value_type> restricted_values(
+            dofs_per_cell);
+          for (unsigned int child = 0; child < cell->n_children(); ++child)
+            {
+              const FullMatrix<double> &restriction =
+                fe.get_restriction_matrix(child, cell->refinement_case());
+              for (unsigned int v = 0; v < n_vectors; ++v)
+                {
+                  cell->child(child)->get_interpolated_dof_values(
+                    *input_vectors[v], local_values, fe_index);
+                  restriction.vmult(restricted_values, local_values);
+
+                  const unsigned int offset = v * dofs_per_cell;
+                  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                    if (fe.restriction_is_additive(i))
+                      all_values(offset + i) += restricted_values(i);
+                    else if (restricted_values(i) !=
+                             typename VectorType::value_type())
+                      all_values(offset + i) = restricted_values(i);
+                }
+            }
         }
+      else
+        for (unsigned int v = 0; v < n_vectors; ++v)
+          {
+            cell->get_interpolated_dof_values(*input_vectors[v],
+                                              local_values,
+                                              fe_index);
+            std::copy(local_values.begin(),
+                      local_values.end(),
+                      all_values.begin() + v * dofs_per_cell);
+          }
 
-      return pack_dof_values<typename VectorType::value_type>(dof_values,
-                                                              dofs_per_cell);
+      std::memcpy(buffer.data(), all_values.begin(), buffer.size());
+      return buffer;
     }
 
 
@@ -434,35 +425,62 @@ namespace parallel
             }
         }
 
-      const unsigned int dofs_per_cell =
-        dof_handler->get_fe(fe_index).dofs_per_cell;
-
-      const std::vector<::dealii::Vector<typename VectorType::value_type>>
-        dof_values =
-          unpack_dof_values<typename VectorType::value_type>(data_range,
-                                                             dofs_per_cell);
-
-      // check if sizes match
-      Assert(dof_values.size() == all_out.size(), ExcInternalError());
+      const FiniteElement<dim, DoFHandlerType::space_dimension> &fe =
+        dof_handler->get_fe(fe_index);
+      const unsigned int dofs_per_cell = fe.dofs_per_cell;
+      const std::size_t  bytes_per_entry =
+        sizeof(typename VectorType::value_type) * dofs_per_cell;
 
       // check if we have enough dofs provided by the FE object
       // to interpolate the transferred data correctly
-      for (auto it_dof_values = dof_values.begin();
-           it_dof_values != dof_values.end();
-           ++it_dof_values)
-        Assert(
-          dofs_per_cell == it_dof_values->size(),
-          ExcMessage(
-            "The transferred data was packed with a different number of dofs than the "
-            "currently registered FE object assigned to the DoFHandler has."));
-
-      // distribute data for each registered vector on mesh
-      auto it_input  = dof_values.cbegin();
-      auto it_output = all_out.begin();
-      for (; it_input != dof_values.cend(); ++it_input, ++it_output)
-        cell->set_dof_values_by_interpolation(*it_input,
-                                              *(*it_output),
-                                              fe_index);
+      Assert(
+        data_range.size() == all_out.size() * bytes_per_entry,
+        ExcMessage(
+          "The transferred data was packed with a different number of dofs than the "
+          "currently registered FE object assigned to the DoFHandler has."));
+      if (dofs_per_cell == 0 || all_out.empty())
+        return;
+
+      // the record holds the values of all vectors one after the other
+      ::dealii::Vector<typename VectorType::value_type> all_values(
+        all_out.size() * dofs_per_cell);
+      std::memcpy(all_values.begin(), &*data_range.begin(), data_range.size());
+
+      ::dealii::Vector<typename VectorType::value_type> local_values(
+        dofs_per_cell);
+      if (cell->has_children())
+        {
+          // The cell has been refined. Visit each child only once and
+          // prolongate the values of all vectors to it, rather than
+          // letting set_dof_values_by_interpolation() walk over the
+          // children once for every vector.
+          ::dealii::Vector<typename VectorType::value_type> child_values(
+            dofs_per_cell);
+          for (unsigned int child = 0; child < cell->n_children(); ++child)
+            {
+              const FullMatrix<double> &prolongation =
+                fe.get_prolongation_matrix(child, cell->refinement_case());
+              for (unsigned int v = 0; v < all_out.size(); ++v)
+                {
+                  std::copy(all_values.begin() + v * dofs_per_cell,
+                            all_values.begin() + (v + 1) * dofs_per_cell,
+                            local_values.begin());
+                  prolongation.vmult(child_values, local_values);
+                  cell->child(child)->set_dof_values_by_interpolation(
+                    child_values, *all_out[v], fe_index);
+                }
+            }
+        }
+      else
+        for (unsigned int v = 0; v < all_out.size(); ++v)
+          {
+            std::copy(all_values.begin() + v * dofs_per_cell,
+                      all_values.begin() + (v + 1) * dofs_per_cell,
+                      local_values.begin());
+            cell->set_dof_values_by_interpolation(local_values,
+                                                  *all_out[v],
+                                                  fe_index);
+          }
     }
   } // namespace distributed
 } // namespace parallel
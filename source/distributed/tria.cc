@@ -30,8 +30,10 @@
 #include <deal.II/lac/sparsity_tools.h>
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 
@@ -1762,10 +1764,10 @@ namespace parallel
 
     template <int dim, int spacedim>
     void
-    Triangulation<dim, spacedim>::DataTransfer::save(
+    Triangulation<dim, spacedim>::DataTransfer::save_start(
       const typename dealii::internal::p4est::types<dim>::forest
         *                parallel_forest,
-      const std::string &filename) const
+      const std::string &filename)
     {
       // Large fractions of this function have been copied from
       // DataOutInterface::write_vtu_in_parallel.
@@ -1774,6 +1776,16 @@ namespace parallel
       Assert(sizes_fixed_cumulative.size() > 0,
              ExcMessage("No data has been packed!"));
 
+      // complete a previous save operation, as its buffers are still in use
+      save_finish();
+
+      // move the packed data into the storage of the save operation, which is
+      // not touched by subsequent transfers
+      save_sizes_fixed_cumulative = sizes_fixed_cumulative;
+      save_data_fixed             = std::move(src_data_fixed);
+      save_sizes_variable         = std::move(src_sizes_variable);
+      save_data_variable          = std::move(src_data_variable);
+
       const int myrank = Utilities::MPI::this_mpi_process(mpi_communicator);
 
       //
@@ -1793,6 +1805,7 @@ namespace parallel
                              info,
                              &fh);
         AssertThrowMPI(ierr);
+        save_files.push_back(fh);
 
         ierr = MPI_File_set_size(fh, 0); // delete the file contents
         AssertThrowMPI(ierr);
@@ -1812,36 +1825,37 @@ namespace parallel
         // it is sufficient to let only the first processor perform this task.
         if (myrank == 0)
           {
-            const unsigned int *data = sizes_fixed_cumulative.data();
-
-            ierr = MPI_File_write_at(fh,
-                                     0,
-                                     DEAL_II_MPI_CONST_CAST(data),
-                                     sizes_fixed_cumulative.size(),
-                                     MPI_UNSIGNED,
-                                     MPI_STATUS_IGNORE);
+            const unsigned int *data = save_sizes_fixed_cumulative.data();
+
+            MPI_Request request;
+            ierr = MPI_File_iwrite_at(fh,
+                                      0,
+                                      DEAL_II_MPI_CONST_CAST(data),
+                                      save_sizes_fixed_cumulative.size(),
+                                      MPI_UNSIGNED,
+                                      &request);
             AssertThrowMPI(ierr);
+            save_requests.push_back(request);
           }
 
         // Write packed data to file simultaneously.
         const unsigned int offset_fixed =
-          sizes_fixed_cumulative.size() * sizeof(unsigned int);
+          save_sizes_fixed_cumulative.size() * sizeof(unsigned int);
 
-        const char *data = src_data_fixed.data();
+        const char *data = save_data_fixed.data();
 
-        ierr = MPI_File_write_at(
+        MPI_Request request;
+        ierr = MPI_File_iwrite_at(
           fh,
           offset_fixed +
             parallel_forest->global_first_quadrant[myrank] *
-              sizes_fixed_cumulative.back(), // global position in file
+              save_sizes_fixed_cumulative.back(), // global position in file
           DEAL_II_MPI_CONST_CAST(data),
-          src_data_fixed.size(), // local buffer
+          save_data_fixed.size(), // local buffer
           MPI_CHAR,
-          MPI_STATUS_IGNORE);
-        AssertThrowMPI(ierr);
-
-        ierr = MPI_File_close(&fh);
+          &request);
         AssertThrowMPI(ierr);
+        save_requests.push_back(request);
       }
 
       //
@@ -1863,6 +1877,7 @@ namespace parallel
                                info,
                                &fh);
           AssertThrowMPI(ierr);
+          save_files.push_back(fh);
 
           ierr = MPI_File_set_size(fh, 0); // delete the file contents
           AssertThrowMPI(ierr);
@@ -1875,16 +1890,18 @@ namespace parallel
 
           // Write sizes of each cell into file simultaneously.
           {
-            const int *data = src_sizes_variable.data();
-            ierr =
-              MPI_File_write_at(fh,
-                                parallel_forest->global_first_quadrant[myrank] *
-                                  sizeof(int), // global position in file
-                                DEAL_II_MPI_CONST_CAST(data),
-                                src_sizes_variable.size(), // local buffer
-                                MPI_INT,
-                                MPI_STATUS_IGNORE);
+            const int * data = save_sizes_variable.data();
+            MPI_Request request;
+            ierr = MPI_File_iwrite_at(
+              fh,
+              parallel_forest->global_first_quadrant[myrank] *
+                sizeof(int), // global position in file
+              DEAL_II_MPI_CONST_CAST(data),
+              save_sizes_variable.size(), // local buffer
+              MPI_INT,
+              &request);
             AssertThrowMPI(ierr);
+            save_requests.push_back(request);
           }
 
 
@@ -1892,7 +1909,7 @@ namespace parallel
             parallel_forest->global_num_quadrants * sizeof(int);
 
           // Gather size of data in bytes we want to store from this processor.
-          const unsigned int size_on_proc = src_data_variable.size();
+          const unsigned int size_on_proc = save_data_variable.size();
 
           // Compute prefix sum
           unsigned int prefix_sum = 0;
@@ -1904,21 +1921,57 @@ namespace parallel
                             mpi_communicator);
           AssertThrowMPI(ierr);
 
-          const char *data = src_data_variable.data();
+          const char *data = save_data_variable.data();
 
           // Write data consecutively into file.
-          ierr = MPI_File_write_at(fh,
-                                   offset_variable +
-                                     prefix_sum, // global position in file
-                                   DEAL_II_MPI_CONST_CAST(data),
-                                   src_data_variable.size(), // local buffer
-                                   MPI_CHAR,
-                                   MPI_STATUS_IGNORE);
+          MPI_Request request;
+          ierr = MPI_File_iwrite_at(fh,
+                                    offset_variable +
+                                      prefix_sum, // global position in file
+                                    DEAL_II_MPI_CONST_CAST(data),
+                                    save_data_variable.size(), // local buffer
+                                    MPI_CHAR,
+                                    &request);
           AssertThrowMPI(ierr);
+          save_requests.push_back(request);
+        }
+    }
+
 
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::DataTransfer::save_finish()
+    {
+      if (save_files.empty())
+        return;
+
+      int ierr = MPI_Waitall(save_requests.size(),
+                             save_requests.data(),
+                             MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+
+      for (MPI_File &fh : save_files)
+        {
           ierr = MPI_File_close(&fh);
           AssertThrowMPI(ierr);
         }
+
+      save_requests.clear();
+      save_files.clear();
+
+      // free the buffers that have been written
+      save_sizes_fixed_cumulative.clear();
+      save_sizes_fixed_cumulative.shrink_to_fit();
+
+      save_data_fixed.clear();
+      save_data_fixed.shrink_to_fit();
+
+      save_sizes_variable.clear();
+      save_sizes_variable.shrink_to_fit();
+
+      save_data_variable.clear();
+      save_data_variable.shrink_to_fit();
     }
 
 
@@ -2141,6 +2194,15 @@ namespace parallel
     template <int dim, int spacedim>
     Triangulation<dim, spacedim>::~Triangulation()
     {
+      // complete a save operation that might still be in progress, so the
+      // buffers are not released while being written
+      try
+        {
+          data_transfer.save_finish();
+        }
+      catch (...)
+        {}
+
       // virtual functions called in constructors and destructors never use the
       // override in a derived class
       // for clarity be explicit on which function is called
@@ -2669,6 +2731,16 @@ namespace parallel
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::save(const std::string &filename) const
+    {
+      save_start(filename);
+      save_finish();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::save_start(const std::string &filename) const
     {
       Assert(
         cell_attached_data.n_attached_deserialize == 0,
@@ -2716,10 +2788,10 @@ namespace parallel
             cell_attached_data.pack_callbacks_fixed,
             cell_attached_data.pack_callbacks_variable);
 
-          // then store buffers in file
-          tria->data_transfer.save(parallel_forest, filename);
+          // then start writing the buffers to file
+          tria->data_transfer.save_start(parallel_forest, filename);
 
-          // and release the memory afterwards
+          // and release the memory that is not needed for writing
           tria->data_transfer.clear();
         }
 
@@ -2746,6 +2818,20 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::save_finish() const
+    {
+      // cast away constness
+      auto tria =
+        const_cast<dealii::parallel::distributed::Triangulation<dim, spacedim>
+                     *>(this);
+
+      tria->data_transfer.save_finish();
+    }
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::load(const std::string &filename,
@@ -2815,7 +2901,8 @@ namespace parallel
           // number of CPUs and so everything works without this call, but
           // this command changes the distribution for some reason, so we
           // will leave it in here.
-          if (this->signals.cell_weight.num_slots() == 0)
+          if (this->signals.cell_weight.num_slots() == 0 &&
+              this->signals.multi_constraint_cell_weight.num_slots() == 0)
             {
               // no cell weights given -- call p4est's 'partition' without a
               // callback for cell weights
@@ -3545,6 +3632,26 @@ namespace parallel
            ++cell)
         cell->recursively_set_subdomain_id(numbers::artificial_subdomain_id);
 
+      // The following loop matches the deal.II cells with the p4est
+      // quadrants and refines the deal.II mesh until both agree. Matching a
+      // tree only has an effect if its cells changed in the previous
+      // iteration, or if flags were set in it during the previous
+      // iteration, because the outcome of the matching only depends on
+      // the cells of the tree. Thus, we only visit all trees in the first
+      // iteration, and then only those trees in which flags have been set.
+      std::vector<bool> coarse_cell_needs_matching(this->n_cells(0), true);
+      const auto        mark_coarse_cells_with_flags =
+        [this](std::vector<bool> &marked_coarse_cells) {
+          for (const auto &cell : this->active_cell_iterators())
+            if (cell->refine_flag_set() || cell->coarsen_flag_set())
+              {
+                cell_iterator coarse_cell = cell;
+                while (coarse_cell->level() > 0)
+                  coarse_cell = coarse_cell->parent();
+                marked_coarse_cells[coarse_cell->index()] = true;
+              }
+        };
+
       do
         {
           for (typename Triangulation<dim, spacedim>::cell_iterator cell =
@@ -3552,6 +3659,9 @@ namespace parallel
                cell != this->end(0);
                ++cell)
             {
+              if (coarse_cell_needs_matching[cell->index()] == false)
+                continue;
+
               // if this processor stores no part of the forest that comes out
               // of this coarse grid cell, then we need to delete all children
               // of this cell (the coarse grid cell remains)
@@ -3610,6 +3720,8 @@ namespace parallel
 
               unsigned int coarse_cell_index =
                 p4est_tree_to_coarse_cell_permutation[ghost_tree];
+              if (coarse_cell_needs_matching[coarse_cell_index] == false)
+                continue;
 
               match_quadrant<dim, spacedim>(this,
                                             coarse_cell_index,
@@ -3617,6 +3729,12 @@ namespace parallel
                                             ghost_owner);
             }
 
+          // remember the trees in which the matching has set flags, since
+          // prepare_coarsening_and_refinement() might remove some of them
+          // now but not in the next iteration
+          std::vector<bool> coarse_cell_has_flags(this->n_cells(0), false);
+          mark_coarse_cells_with_flags(coarse_cell_has_flags);
+
           // fix all the flags to make sure we have a consistent mesh
           this->prepare_coarsening_and_refinement();
 
@@ -3629,6 +3747,12 @@ namespace parallel
                                  cell.coarsen_flag_set();
                         });
 
+          // the trees to be matched in the next iteration are those with
+          // flags before or after the smoothing
+          if (mesh_changed)
+            mark_coarse_cells_with_flags(coarse_cell_has_flags);
+          coarse_cell_needs_matching.swap(coarse_cell_has_flags);
+
           // actually do the refinement to change the local mesh by
           // calling the base class refinement function directly
           try
@@ -3933,7 +4057,8 @@ namespace parallel
         {
           // partition the new mesh between all processors. If cell weights have
           // not been given balance the number of cells.
-          if (this->signals.cell_weight.num_slots() == 0)
+          if (this->signals.cell_weight.num_slots() == 0 &&
+              this->signals.multi_constraint_cell_weight.num_slots() == 0)
             dealii::internal::p4est::functions<dim>::partition(
               parallel_forest,
               /* prepare coarsening */ 1,
@@ -4097,7 +4222,8 @@ namespace parallel
                         (parallel_forest->mpisize + 1));
         }
 
-      if (this->signals.cell_weight.num_slots() == 0)
+      if (this->signals.cell_weight.num_slots() == 0 &&
+          this->signals.multi_constraint_cell_weight.num_slots() == 0)
         {
           // no cell weights given -- call p4est's 'partition' without a
           // callback for cell weights
@@ -4948,6 +5074,64 @@ namespace parallel
             }
         }
 
+      // if several constraints are to be balanced, normalize each of them
+      // such that its global sum matches the sum of the reference weights of
+      // 1000 per cell, and add the result to the scalar weights. this lets
+      // the space-filling curve partitioning of p4est balance all of them
+      // at the same time.
+      if (this->signals.multi_constraint_cell_weight.num_slots() > 0)
+        {
+          std::vector<std::vector<unsigned int>> constraint_weights;
+          constraint_weights.reserve(weights.size());
+          for (const auto &quad_cell_rel : local_quadrant_cell_relations)
+            {
+              const auto &cell_status = std::get<1>(quad_cell_rel);
+              const auto &cell_it     = std::get<2>(quad_cell_rel);
+
+              // as above, cells that are to be refined provide the weight
+              // of each of their future children
+              constraint_weights.push_back(
+                this->signals.multi_constraint_cell_weight(
+                  cell_it,
+                  cell_status ==
+                      parallel::distributed::Triangulation<dim, spacedim>::
+                        CELL_INVALID ?
+                    parallel::distributed::Triangulation<dim, spacedim>::
+                      CELL_REFINE :
+                    cell_status));
+            }
+
+          const unsigned int n_constraints = Utilities::MPI::max(
+            constraint_weights.empty() ?
+              0U :
+              static_cast<unsigned int>(constraint_weights[0].size()),
+            this->mpi_communicator);
+
+          std::vector<double> constraint_sums(n_constraints, 0.);
+          for (const auto &cell_weights : constraint_weights)
+            {
+              AssertDimension(cell_weights.size(), n_constraints);
+              for (unsigned int c = 0; c < n_constraints; ++c)
+                constraint_sums[c] += cell_weights[c];
+            }
+          Utilities::MPI::sum(constraint_sums,
+                              this->mpi_communicator,
+                              constraint_sums);
+
+          const double n_global_quadrants =
+            parallel_forest->global_num_quadrants;
+          for (unsigned int i = 0; i < weights.size(); ++i)
+            {
+              double weight = weights[i];
+              for (unsigned int c = 0; c < n_constraints; ++c)
+                if (constraint_sums[c] > 0.)
+                  weight += 1000. * n_global_quadrants *
+                            constraint_weights[i][c] / constraint_sums[c];
+              weights[i] = static_cast<unsigned int>(std::min<double>(
+                std::round(weight), std::numeric_limits<unsigned int>::max()));
+            }
+        }
+
       return weights;
     }
 
@@ -5089,6 +5273,24 @@ namespace parallel
 
 
 
+    template <int spacedim>
+    void
+    Triangulation<1, spacedim>::save_start(const std::string &) const
+    {
+      Assert(false, ExcNotImplemented());
+    }
+
+
+
+    template <int spacedim>
+    void
+    Triangulation<1, spacedim>::save_finish() const
+    {
+      Assert(false, ExcNotImplemented());
+    }
+
+
+
     template <int spacedim>
     bool
     Triangulation<1, spacedim>::is_multilevel_hierarchy_constructed() const
@@ -342,6 +342,89 @@ namespace parallel
 
 
 
+  template <int dim, int spacedim>
+  std::vector<Utilities::MPI::MinMaxAvg>
+  TriangulationBase<dim, spacedim>::compute_cell_weight_statistics() const
+  {
+    const auto status = dealii::Triangulation<dim, spacedim>::CELL_PERSIST;
+
+    double              scalar_weight = 0.;
+    std::vector<double> constraint_weights;
+    for (const auto &cell : this->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          scalar_weight += 1000. + this->signals.cell_weight(cell, status);
+
+          if (this->signals.multi_constraint_cell_weight.num_slots() > 0)
+            {
+              const std::vector<unsigned int> weights =
+                this->signals.multi_constraint_cell_weight(cell, status);
+              if (constraint_weights.empty())
+                constraint_weights.resize(weights.size(), 0.);
+              AssertDimension(weights.size(), constraint_weights.size());
+              for (unsigned int c = 0; c < weights.size(); ++c)
+                constraint_weights[c] += weights[c];
+            }
+        }
+
+    // processes without cells do not know the number of constraints
+    constraint_weights.resize(
+      Utilities::MPI::max(static_cast<unsigned int>(constraint_weights.size()),
+                          this->mpi_communicator),
+      0.);
+
+    std::vector<double> local_weights(1, scalar_weight);
+    local_weights.insert(local_weights.end(),
+                         constraint_weights.begin(),
+                         constraint_weights.end());
+
+    return Utilities::MPI::min_max_avg(local_weights, this->mpi_communicator);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  TriangulationBase<dim, spacedim>::MemoryStatistics::artificial_cell_memory()
+    const
+  {
+    const std::size_t n_cells = n_locally_owned_active_cells + n_ghost_cells +
+                                n_artificial_cells + n_parent_cells;
+    return (n_cells == 0) ? 0 :
+                            triangulation_memory * n_artificial_cells / n_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  typename TriangulationBase<dim, spacedim>::MemoryStatistics
+  TriangulationBase<dim, spacedim>::compute_memory_statistics() const
+  {
+    MemoryStatistics statistics;
+    statistics.n_coarse_cells =
+      (this->n_levels() > 0) ? this->n_cells(0) : 0;
+    statistics.n_locally_owned_active_cells = 0;
+    statistics.n_ghost_cells                = 0;
+    statistics.n_artificial_cells           = 0;
+    for (const auto &cell : this->active_cell_iterators())
+      if (cell->is_locally_owned())
+        ++statistics.n_locally_owned_active_cells;
+      else if (cell->is_ghost())
+        ++statistics.n_ghost_cells;
+      else
+        ++statistics.n_artificial_cells;
+    statistics.n_parent_cells = this->n_cells() - this->n_active_cells();
+
+    statistics.triangulation_memory =
+      this->dealii::Triangulation<dim, spacedim>::memory_consumption();
+    statistics.additional_memory =
+      this->memory_consumption() - statistics.triangulation_memory;
+
+    return statistics;
+  }
+
+
+
   template <int dim, int spacedim>
   DistributedTriangulationBase<dim, spacedim>::DistributedTriangulationBase(
     MPI_Comm mpi_communicator,
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -35,6 +36,7 @@
 #include <deal.II/grid/tria_iterator.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -1642,6 +1644,273 @@ namespace internal
 
 
 
+        /**
+         * An operation for
+         * internal::DoFAccessorImplementation::Implementation::process_dof_indices()
+         * that sets the DoF indices of an object only where the given index
+         * is valid, leaving the indices of the other objects untouched.
+         */
+        template <typename DoFHandlerType, int structdim>
+        struct ValidDoFIndexSetter
+        {
+          /**
+           * Set vertex DoF index.
+           */
+          static DEAL_II_ALWAYS_INLINE void
+          process_vertex_dof(
+            const dealii::DoFAccessor<structdim, DoFHandlerType, false>
+              &                            accessor,
+            const unsigned int             vertex,
+            const unsigned int             d,
+            const types::global_dof_index &index_value,
+            const unsigned int             fe_index)
+          {
+            if (index_value != numbers::invalid_dof_index)
+              accessor.set_vertex_dof_index(vertex, d, index_value, fe_index);
+          }
+
+          /**
+           * Set DoF index for lines, quads, and inner degrees of freedom.
+           */
+          template <int structdim_>
+          static DEAL_II_ALWAYS_INLINE void
+          process_dof(
+            const dealii::DoFAccessor<structdim_, DoFHandlerType, false>
+              &                            accessor,
+            const unsigned int             d,
+            const types::global_dof_index &index_value,
+            const unsigned int             fe_index)
+          {
+            if (index_value != numbers::invalid_dof_index)
+              accessor.set_dof_index(d, index_value, fe_index);
+          }
+
+          /**
+           * Fallback for DoFInvalidAccessor.
+           */
+          template <int structdim_>
+          static DEAL_II_ALWAYS_INLINE void
+          process_dof(
+            const dealii::DoFInvalidAccessor<structdim_,
+                                             DoFHandlerType::dimension,
+                                             DoFHandlerType::space_dimension> &,
+            const unsigned int,
+            const types::global_dof_index &,
+            const unsigned int)
+          {
+            Assert(false, ExcInternalError());
+          }
+        };
+
+
+
+        /**
+         * Multithreaded variant of the enumeration in distribute_dofs() for
+         * DoFHandler objects where all cells use the same finite element. The
+         * result is identical to the sequential loop over the cells: The DoFs
+         * of a vertex, line, or quad are numbered by the first cell in the
+         * order of the active cell iterators that contains the object, and
+         * the DoFs of a cell are numbered in the cell-local order.
+         *
+         * The cells are split into chunks of consecutive cells, and the
+         * enumeration is done in three passes over the chunks that each run
+         * in parallel. The first pass determines for each object the first
+         * cell that contains it. The second pass counts the DoFs owned by the
+         * cells of each chunk in that sense, and a prefix sum over the chunks
+         * gives the first index of each chunk. The third pass computes the
+         * indices and writes them for the owned objects only, so each entry
+         * of the DoF storage is written by exactly one thread and without
+         * further calls into the finite element.
+         */
+        template <class DoFHandlerType>
+        static types::global_dof_index
+        distribute_dofs_in_parallel(const types::subdomain_id subdomain_id,
+                                    DoFHandlerType &          dof_handler)
+        {
+          const unsigned int dim = DoFHandlerType::dimension;
+
+          const dealii::Triangulation<dim, DoFHandlerType::space_dimension>
+            &tria = dof_handler.get_triangulation();
+          const FiniteElement<dim, DoFHandlerType::space_dimension> &fe =
+            dof_handler.get_fe(0);
+
+          std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+          cells.reserve(tria.n_active_cells());
+          for (const auto &cell : dof_handler.active_cell_iterators())
+            if (!cell->is_artificial())
+              if ((subdomain_id == numbers::invalid_subdomain_id) ||
+                  (cell->subdomain_id() == subdomain_id))
+                cells.push_back(cell);
+
+          if (cells.empty())
+            return 0;
+
+          const unsigned int n_cells = cells.size();
+          const unsigned int n_chunks =
+            std::min(n_cells, 8 * MultithreadInfo::n_threads());
+          const unsigned int chunk_size = (n_cells + n_chunks - 1) / n_chunks;
+
+          // run the given function on the cells of each chunk in parallel
+          const auto run_on_chunks =
+            [&](const std::function<void(const unsigned int,
+                                         const unsigned int,
+                                         const unsigned int)> &function) {
+              parallel::apply_to_subranges(
+                0U,
+                n_chunks,
+                [&](const unsigned int begin, const unsigned int end) {
+                  for (unsigned int chunk = begin; chunk < end; ++chunk)
+                    function(chunk,
+                             chunk * chunk_size,
+                             std::min(n_cells, (chunk + 1) * chunk_size));
+                },
+                1);
+            };
+
+          const unsigned int inner_dofs =
+            dim == 1 ? fe.dofs_per_line :
+                       (dim == 2 ? fe.dofs_per_quad : fe.dofs_per_hex);
+          const bool has_vertex_dofs = fe.dofs_per_vertex > 0;
+          const bool has_line_dofs   = dim > 1 && fe.dofs_per_line > 0;
+          const bool has_quad_dofs   = dim > 2 && fe.dofs_per_quad > 0;
+
+          // Pass 1: find the first cell containing each object
+          std::vector<std::atomic<unsigned int>> first_cell_on_vertex(
+            has_vertex_dofs ? tria.n_vertices() : 0);
+          std::vector<std::atomic<unsigned int>> first_cell_on_line(
+            has_line_dofs ? tria.n_raw_lines() : 0);
+          std::vector<std::atomic<unsigned int>> first_cell_on_quad(
+            has_quad_dofs ? tria.n_raw_quads() : 0);
+          for (auto *first_cell : {&first_cell_on_vertex,
+                                   &first_cell_on_line,
+                                   &first_cell_on_quad})
+            for (auto &entry : *first_cell)
+              entry.store(numbers::invalid_unsigned_int,
+                          std::memory_order_relaxed);
+
+          const auto set_minimum = [](std::atomic<unsigned int> &entry,
+                                      const unsigned int         value) {
+            unsigned int old_value = entry.load(std::memory_order_relaxed);
+            while (value < old_value &&
+                   !entry.compare_exchange_weak(old_value,
+                                                value,
+                                                std::memory_order_relaxed))
+              ;
+          };
+
+          run_on_chunks([&](const unsigned int,
+                            const unsigned int begin,
+                            const unsigned int end) {
+            for (unsigned int c = begin; c < end; ++c)
+              {
+                if (has_vertex_dofs)
+                  for (const unsigned int v :
+                       GeometryInfo<dim>::vertex_indices())
+                    set_minimum(first_cell_on_vertex[cells[c]->vertex_index(v)],
+                                c);
+                if (has_line_dofs)
+                  for (unsigned int l = 0;
+                       l < GeometryInfo<dim>::lines_per_cell;
+                       ++l)
+                    set_minimum(first_cell_on_line[cells[c]->line_index(l)], c);
+                if (has_quad_dofs)
+                  for (unsigned int q = 0;
+                       q < GeometryInfo<dim>::quads_per_cell;
+                       ++q)
+                    set_minimum(first_cell_on_quad[cells[c]->quad_index(q)], c);
+              }
+          });
+
+          // Pass 2: count the DoFs owned by each chunk and compute the first
+          // index of each chunk
+          std::vector<types::global_dof_index> chunk_start(n_chunks + 1, 0);
+          run_on_chunks([&](const unsigned int chunk,
+                            const unsigned int begin,
+                            const unsigned int end) {
+            types::global_dof_index n_dofs = 0;
+            for (unsigned int c = begin; c < end; ++c)
+              {
+                if (has_vertex_dofs)
+                  for (const unsigned int v :
+                       GeometryInfo<dim>::vertex_indices())
+                    if (first_cell_on_vertex[cells[c]->vertex_index(v)] == c)
+                      n_dofs += fe.dofs_per_vertex;
+                if (has_line_dofs)
+                  for (unsigned int l = 0;
+                       l < GeometryInfo<dim>::lines_per_cell;
+                       ++l)
+                    if (first_cell_on_line[cells[c]->line_index(l)] == c)
+                      n_dofs += fe.dofs_per_line;
+                if (has_quad_dofs)
+                  for (unsigned int q = 0;
+                       q < GeometryInfo<dim>::quads_per_cell;
+                       ++q)
+                    if (first_cell_on_quad[cells[c]->quad_index(q)] == c)
+                      n_dofs += fe.dofs_per_quad;
+                n_dofs += inner_dofs;
+              }
+            chunk_start[chunk + 1] = n_dofs;
+          });
+          std::partial_sum(chunk_start.begin(),
+                           chunk_start.end(),
+                           chunk_start.begin());
+
+          // Pass 3: enumerate the DoFs in the cell-local order and set them
+          // on the owned objects
+          run_on_chunks([&](const unsigned int chunk,
+                            const unsigned int begin,
+                            const unsigned int end) {
+            types::global_dof_index next_free_dof = chunk_start[chunk];
+            std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+            const auto fill = [&](const bool         is_owned,
+                                  const unsigned int n_dofs,
+                                  unsigned int &     index) {
+              for (unsigned int i = 0; i < n_dofs; ++i, ++index)
+                dof_indices[index] =
+                  is_owned ? next_free_dof++ : numbers::invalid_dof_index;
+            };
+            for (unsigned int c = begin; c < end; ++c)
+              {
+                unsigned int index = 0;
+                for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+                  fill(has_vertex_dofs &&
+                         first_cell_on_vertex[cells[c]->vertex_index(v)] == c,
+                       fe.dofs_per_vertex,
+                       index);
+                if (dim > 1)
+                  for (unsigned int l = 0;
+                       l < GeometryInfo<dim>::lines_per_cell;
+                       ++l)
+                    fill(has_line_dofs &&
+                           first_cell_on_line[cells[c]->line_index(l)] == c,
+                         fe.dofs_per_line,
+                         index);
+                if (dim > 2)
+                  for (unsigned int q = 0;
+                       q < GeometryInfo<dim>::quads_per_cell;
+                       ++q)
+                    fill(has_quad_dofs &&
+                           first_cell_on_quad[cells[c]->quad_index(q)] == c,
+                         fe.dofs_per_quad,
+                         index);
+                fill(true, inner_dofs, index);
+                AssertDimension(index, dof_indices.size());
+
+                internal::DoFAccessorImplementation::Implementation::
+                  process_dof_indices(
+                    *cells[c],
+                    dof_indices,
+                    cells[c]->active_fe_index(),
+                    ValidDoFIndexSetter<DoFHandlerType, dim>());
+              }
+            Assert(next_free_dof == chunk_start[chunk + 1], ExcInternalError());
+          });
+
+          return chunk_start.back();
+        }
+
+
+
         /**
          * Distribute degrees of freedom on all cells, or on cells with the
          * correct subdomain_id if the corresponding argument is not equal to
@@ -1656,6 +1925,17 @@ namespace internal
           Assert(dof_handler.get_triangulation().n_levels() > 0,
                  ExcMessage("Empty triangulation"));
 
+          if (DoFHandlerType::is_hp_dof_handler == false &&
+              MultithreadInfo::n_threads() > 1)
+            {
+              const types::global_dof_index n_dofs =
+                distribute_dofs_in_parallel(subdomain_id, dof_handler);
+
+              update_all_active_cell_dof_indices_caches(dof_handler);
+
+              return n_dofs;
+            }
+
           // Step 1: distribute dofs on all cells, but definitely
           // exclude artificial cells
           types::global_dof_index next_free_dof = 0;
@@ -39,6 +39,8 @@
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <deal.II/multigrid/mg_tools.h>
 
 DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
@@ -2195,6 +2197,88 @@ namespace DoFRenumbering
 
 
 
+  template <typename DoFHandlerType>
+  void
+  keep_previous_numbering(
+    DoFHandlerType &dof_handler,
+    const std::map<CellId, std::vector<types::global_dof_index>>
+      &previous_cell_dof_indices)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_dofs(), numbers::invalid_dof_index);
+    compute_keep_previous_numbering(renumbering,
+                                    dof_handler,
+                                    previous_cell_dof_indices);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  compute_keep_previous_numbering(
+    std::vector<types::global_dof_index> &new_indices,
+    const DoFHandlerType &                dof_handler,
+    const std::map<CellId, std::vector<types::global_dof_index>>
+      &previous_cell_dof_indices)
+  {
+    Assert((dynamic_cast<const parallel::TriangulationBase<
+              DoFHandlerType::dimension,
+              DoFHandlerType::space_dimension> *>(
+              &dof_handler.get_triangulation()) == nullptr),
+           ExcNotImplemented());
+
+    const types::global_dof_index n_dofs = dof_handler.n_dofs();
+    Assert(new_indices.size() == n_dofs,
+           ExcDimensionMismatch(new_indices.size(), n_dofs));
+
+    std::fill(new_indices.begin(),
+              new_indices.end(),
+              numbers::invalid_dof_index);
+
+    // first keep the indices of the DoFs on the unchanged cells, as long as
+    // they fit into the present range of indices
+    std::vector<bool>                    index_is_taken(n_dofs, false);
+    std::vector<types::global_dof_index> local_dof_indices;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        const auto previous = previous_cell_dof_indices.find(cell->id());
+        if (previous == previous_cell_dof_indices.end())
+          continue;
+
+        local_dof_indices.resize(cell->get_fe().dofs_per_cell);
+        if (previous->second.size() != local_dof_indices.size())
+          continue;
+        cell->get_dof_indices(local_dof_indices);
+
+        for (unsigned int i = 0; i < local_dof_indices.size(); ++i)
+          {
+            const types::global_dof_index previous_index = previous->second[i];
+            if (previous_index < n_dofs &&
+                new_indices[local_dof_indices[i]] ==
+                  numbers::invalid_dof_index &&
+                index_is_taken[previous_index] == false)
+              {
+                new_indices[local_dof_indices[i]] = previous_index;
+                index_is_taken[previous_index]    = true;
+              }
+          }
+      }
+
+    // then fill the gaps with the remaining DoFs in their present order
+    types::global_dof_index next_free_index = 0;
+    for (types::global_dof_index &new_index : new_indices)
+      if (new_index == numbers::invalid_dof_index)
+        {
+          while (index_is_taken[next_free_index])
+            ++next_free_index;
+          new_index = next_free_index++;
+        }
+  }
+
+
+
   template <typename DoFHandlerType>
   void
   subdomain_wise(DoFHandlerType &dof_handler)
@@ -2265,6 +2349,117 @@ namespace DoFRenumbering
            ExcInternalError());
   }
 
+
+
+
+  template <int dim, typename Number, typename AdditionalDataType>
+  void
+  matrix_free_data_locality(DoFHandler<dim> &                dof_handler,
+                            const AffineConstraints<Number> &constraints,
+                            const AdditionalDataType &       matrix_free_data)
+  {
+    // only the index data of the cell batches is needed, so skip the
+    // (expensive) setup of the mapping data
+    typename MatrixFree<dim, Number>::AdditionalData additional_data(
+      matrix_free_data);
+    additional_data.initialize_mapping = false;
+
+    MatrixFree<dim, Number> matrix_free;
+    matrix_free.reinit(dof_handler, constraints, QGauss<1>(2), additional_data);
+
+    matrix_free_data_locality(dof_handler, matrix_free);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    std::vector<types::global_dof_index> new_dof_indices;
+    compute_matrix_free_data_locality(new_dof_indices,
+                                      dof_handler,
+                                      matrix_free);
+
+    if (matrix_free.get_mg_level() == numbers::invalid_unsigned_int)
+      dof_handler.renumber_dofs(new_dof_indices);
+    else
+      dof_handler.renumber_dofs(matrix_free.get_mg_level(), new_dof_indices);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    unsigned int dof_handler_index = numbers::invalid_unsigned_int;
+    for (unsigned int i = 0; i < matrix_free.n_components(); ++i)
+      if (&matrix_free.get_dof_handler(i) == &dof_handler)
+        {
+          dof_handler_index = i;
+          break;
+        }
+    Assert(dof_handler_index != numbers::invalid_unsigned_int,
+           ExcMessage("The given DoFHandler is not part of the MatrixFree "
+                      "object."));
+
+    const unsigned int level = matrix_free.get_mg_level();
+    const IndexSet &   locally_owned_dofs =
+      level == numbers::invalid_unsigned_int ?
+        dof_handler.locally_owned_dofs() :
+        dof_handler.locally_owned_mg_dofs(level);
+
+    // the dof indices of the matrix-free framework are stored in the
+    // MPI-local numbering of the vector partitioner, with the locally owned
+    // range first; they include the indices the constrained degrees of
+    // freedom of a cell depend on and thus describe the actual access pattern
+    // of the cell loop
+    const dealii::internal::MatrixFreeFunctions::DoFInfo &dof_info =
+      matrix_free.get_dof_info(dof_handler_index);
+    const unsigned int n_owned = locally_owned_dofs.n_elements();
+    AssertDimension(dof_info.vector_partitioner->local_size(), n_owned);
+
+    new_dof_indices.resize(n_owned);
+    std::fill(new_dof_indices.begin(),
+              new_dof_indices.end(),
+              numbers::invalid_dof_index);
+
+    // number the degrees of freedom in the order the cell batches are visited
+    // by the cell loop, and cell by cell within a batch, such that the
+    // indices of each cell are contiguous whenever possible
+    types::global_dof_index next_free_index = 0;
+    const unsigned int      n_lanes         = dof_info.vectorization_length;
+    const unsigned int      n_components    = dof_info.start_components.back();
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int index = (cell * n_lanes + v) * n_components;
+          for (unsigned int i = dof_info.row_starts[index].first;
+               i < dof_info.row_starts[index + n_components].first;
+               ++i)
+            {
+              const unsigned int local_index = dof_info.dof_indices[i];
+              if (local_index < n_owned &&
+                  new_dof_indices[local_index] == numbers::invalid_dof_index)
+                new_dof_indices[local_index] =
+                  locally_owned_dofs.nth_index_in_set(next_free_index++);
+            }
+        }
+
+    // the degrees of freedom not accessed by the cell loop are numbered last
+    for (auto &index : new_dof_indices)
+      if (index == numbers::invalid_dof_index)
+        index = locally_owned_dofs.nth_index_in_set(next_free_index++);
+
+    Assert(next_free_index == n_owned, ExcInternalError());
+  }
+
 } // namespace DoFRenumbering
 
 
@@ -49,6 +49,7 @@
 #include <deal.II/lac/vector.h>
 
 #include <algorithm>
+#include <fstream>
 #include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
@@ -1133,6 +1134,67 @@ namespace DoFTools
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * A function object that tells whether an index is part of the locally
+       * owned index set passed to the constructor. Owned index sets are
+       * contiguous in most cases, and then each query is a single range
+       * comparison rather than the binary search over all ranges done by
+       * IndexSet::is_element().
+       */
+      class OwnedIndexFilter
+      {
+      public:
+        OwnedIndexFilter(const IndexSet &owned_indices)
+          : owned_indices(owned_indices)
+          , is_contiguous(owned_indices.is_contiguous())
+          , first_index(is_contiguous && owned_indices.n_elements() > 0 ?
+                          owned_indices.nth_index_in_set(0) :
+                          0)
+          , n_indices(is_contiguous ? owned_indices.n_elements() : 0)
+        {}
+
+        bool
+        operator()(const types::global_dof_index index) const
+        {
+          // for the contiguous case, indices below first_index wrap around
+          // and are rejected by the same comparison
+          return is_contiguous ? (index - first_index < n_indices) :
+                                 owned_indices.is_element(index);
+        }
+
+      private:
+        const IndexSet &              owned_indices;
+        const bool                    is_contiguous;
+        const types::global_dof_index first_index;
+        const types::global_dof_index n_indices;
+      };
+
+
+
+      /**
+       * Add the indices collected in @p dofs_on_cells to @p dof_set in one
+       * go: sorting them and removing duplicates first lets IndexSet merge
+       * them into its ranges without any intermediate reallocation.
+       */
+      void
+      add_collected_indices(std::vector<types::global_dof_index> &dofs_on_cells,
+                            IndexSet &                            dof_set)
+      {
+        std::sort(dofs_on_cells.begin(), dofs_on_cells.end());
+        dof_set.add_indices(dofs_on_cells.begin(),
+                            std::unique(dofs_on_cells.begin(),
+                                        dofs_on_cells.end()));
+        dof_set.compress();
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
   template <typename DoFHandlerType>
   void
   extract_locally_active_dofs(const DoFHandlerType &dof_handler,
@@ -1140,12 +1202,15 @@ namespace DoFTools
   {
     // collect all the locally owned dofs
     dof_set = dof_handler.locally_owned_dofs();
+    const internal::OwnedIndexFilter is_owned(dof_set);
 
     // add the DoF on the adjacent ghost cells to the IndexSet, cache them
-    // in a set. need to check each dof manually because we can't be sure
-    // that the dof range of locally_owned_dofs is really contiguous.
+    // in a vector that is sorted once at the end (see the comment in
+    // extract_locally_relevant_dofs()). need to check each dof manually
+    // because we can't be sure that the dof range of locally_owned_dofs is
+    // really contiguous.
     std::vector<types::global_dof_index> dof_indices;
-    std::set<types::global_dof_index>    global_dof_indices;
+    std::vector<types::global_dof_index> dofs_on_cells;
 
     typename DoFHandlerType::active_cell_iterator cell =
                                                     dof_handler.begin_active(),
@@ -1157,13 +1222,11 @@ namespace DoFTools
           cell->get_dof_indices(dof_indices);
 
           for (const types::global_dof_index dof_index : dof_indices)
-            if (!dof_set.is_element(dof_index))
-              global_dof_indices.insert(dof_index);
+            if (!is_owned(dof_index))
+              dofs_on_cells.push_back(dof_index);
         }
 
-    dof_set.add_indices(global_dof_indices.begin(), global_dof_indices.end());
-
-    dof_set.compress();
+    internal::add_collected_indices(dofs_on_cells, dof_set);
   }
 
 
@@ -1175,6 +1238,7 @@ namespace DoFTools
   {
     // collect all the locally owned dofs
     dof_set = dof_handler.locally_owned_dofs();
+    const internal::OwnedIndexFilter is_owned(dof_set);
 
     // now add the DoF on the adjacent ghost cells to the IndexSet
 
@@ -1196,16 +1260,12 @@ namespace DoFTools
           dof_indices.resize(cell->get_fe().dofs_per_cell);
           cell->get_dof_indices(dof_indices);
           for (const auto dof_index : dof_indices)
-            if (!dof_set.is_element(dof_index))
+            if (!is_owned(dof_index))
               dofs_on_ghosts.push_back(dof_index);
         }
 
     // sort, compress out duplicates, fill into index set
-    std::sort(dofs_on_ghosts.begin(), dofs_on_ghosts.end());
-    dof_set.add_indices(dofs_on_ghosts.begin(),
-                        std::unique(dofs_on_ghosts.begin(),
-                                    dofs_on_ghosts.end()));
-    dof_set.compress();
+    internal::add_collected_indices(dofs_on_ghosts, dof_set);
   }
 
 
@@ -1218,6 +1278,7 @@ namespace DoFTools
   {
     // collect all the locally owned dofs
     dof_set = dof_handler.locally_owned_mg_dofs(level);
+    const internal::OwnedIndexFilter is_owned(dof_set);
 
     // add the DoF on the adjacent ghost cells to the IndexSet
 
@@ -1244,17 +1305,12 @@ namespace DoFTools
         dof_indices.resize(cell->get_fe().dofs_per_cell);
         cell->get_mg_dof_indices(dof_indices);
         for (const auto dof_index : dof_indices)
-          if (!dof_set.is_element(dof_index))
+          if (!is_owned(dof_index))
             dofs_on_ghosts.push_back(dof_index);
       }
 
     // sort, compress out duplicates, fill into index set
-    std::sort(dofs_on_ghosts.begin(), dofs_on_ghosts.end());
-    dof_set.add_indices(dofs_on_ghosts.begin(),
-                        std::unique(dofs_on_ghosts.begin(),
-                                    dofs_on_ghosts.end()));
-
-    dof_set.compress();
+    internal::add_collected_indices(dofs_on_ghosts, dof_set);
   }
 
 
@@ -1329,6 +1385,7 @@ namespace DoFTools
                           std::vector<bool>(n_selected_dofs, false));
 
     // Loop over all owned cells and ask the element for the constant modes
+    locally_owned_dofs.compress();
     std::vector<types::global_dof_index> dof_indices;
     for (const auto &cell : dof_handler.active_cell_iterators())
       if (cell->is_locally_owned())
@@ -1337,19 +1394,24 @@ namespace DoFTools
           cell->get_dof_indices(dof_indices);
 
           for (unsigned int i = 0; i < dof_indices.size(); ++i)
-            if (locally_owned_dofs.is_element(dof_indices[i]))
-              {
-                const unsigned int loc_index =
-                  locally_owned_dofs.index_within_set(dof_indices[i]);
-                const unsigned int comp = dofs_by_component[loc_index];
-                if (component_mask[comp])
-                  for (auto &indices :
-                       constant_mode_to_component_translation[comp])
-                    constant_modes[indices
-                                     .first][component_numbering[loc_index]] =
-                      element_constant_modes[cell->active_fe_index()](
-                        indices.second, i);
-              }
+            {
+              // index_within_set() returns an invalid index for dofs that
+              // are not locally owned, so there is no need to search for the
+              // index twice by asking is_element() first
+              const types::global_dof_index loc_index =
+                locally_owned_dofs.index_within_set(dof_indices[i]);
+              if (loc_index != numbers::invalid_dof_index)
+                {
+                  const unsigned int comp = dofs_by_component[loc_index];
+                  if (component_mask[comp])
+                    for (auto &indices :
+                         constant_mode_to_component_translation[comp])
+                      constant_modes[indices.first]
+                                    [component_numbering[loc_index]] =
+                        element_constant_modes[cell->active_fe_index()](
+                          indices.second, i);
+                }
+            }
         }
   }
 
@@ -2491,6 +2553,105 @@ namespace DoFTools
 
 
 
+  namespace internal
+  {
+    /**
+     * Identifier at the beginning of each snapshot file.
+     */
+    static const std::string snapshot_identifier = "deal.II snapshot";
+
+    /**
+     * Version of the format of snapshot files, to be increased whenever the
+     * data written by write_snapshot() changes.
+     */
+    static const unsigned int snapshot_format_version = 1;
+  } // namespace internal
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_snapshot(const DoFHandler<dim, spacedim> &dof_handler,
+                 const std::string &              filename)
+  {
+    Assert((dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+              &dof_handler.get_triangulation()) == nullptr),
+           ExcNotImplemented());
+
+    std::ofstream out(filename, std::ios::binary);
+    AssertThrow(out, ExcIO());
+
+    boost::archive::binary_oarchive archive(out);
+
+    std::string  identifier      = internal::snapshot_identifier;
+    unsigned int format_version  = internal::snapshot_format_version;
+    unsigned int dimension       = dim;
+    unsigned int space_dimension = spacedim;
+    std::string  fe_name         = dof_handler.get_fe().get_name();
+    archive << identifier << format_version << dimension << space_dimension
+            << fe_name;
+
+    archive << dof_handler.get_triangulation() << dof_handler;
+
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  read_snapshot(Triangulation<dim, spacedim> &      triangulation,
+                DoFHandler<dim, spacedim> &         dof_handler,
+                const FiniteElement<dim, spacedim> &fe,
+                const std::string &                 filename)
+  {
+    Assert((dynamic_cast<parallel::TriangulationBase<dim, spacedim> *>(
+              &triangulation) == nullptr),
+           ExcNotImplemented());
+    Assert(&dof_handler.get_triangulation() == &triangulation,
+           ExcMessage("The DoFHandler needs to be associated with the "
+                      "triangulation the snapshot is read into."));
+
+    std::ifstream in(filename, std::ios::binary);
+    AssertThrow(in, ExcIO());
+
+    boost::archive::binary_iarchive archive(in);
+
+    std::string  identifier;
+    unsigned int format_version  = 0;
+    unsigned int dimension       = 0;
+    unsigned int space_dimension = 0;
+    std::string  fe_name;
+    archive >> identifier >> format_version >> dimension >>
+      space_dimension >> fe_name;
+
+    AssertThrow(identifier == internal::snapshot_identifier,
+                ExcMessage("The file <" + filename +
+                           "> does not contain a snapshot."));
+    AssertThrow(format_version == internal::snapshot_format_version,
+                ExcMessage("The snapshot in the file <" + filename +
+                           "> has been written in version " +
+                           Utilities::to_string(format_version) +
+                           " of the format, but only version " +
+                           Utilities::to_string(
+                             internal::snapshot_format_version) +
+                           " can be read."));
+    AssertThrow(dimension == dim && space_dimension == spacedim,
+                ExcMessage("The snapshot in the file <" + filename +
+                           "> has been written for a different dimension."));
+    AssertThrow(fe_name == fe.get_name(),
+                ExcMessage("The snapshot in the file <" + filename +
+                           "> has been written for the finite element " +
+                           fe_name + " instead of " + fe.get_name() + "."));
+
+    archive >> triangulation;
+
+    dof_handler.set_fe(fe);
+    archive >> dof_handler;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   make_cell_patches(SparsityPattern &                block_list,
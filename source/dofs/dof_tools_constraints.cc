@@ -319,22 +319,23 @@ namespace DoFTools
 
       /**
        * Make sure that the given @p face_interpolation_matrix pointer points
-       * to a valid matrix. If the pointer is zero beforehand, create an entry
-       * with the correct data. If it is nonzero, don't touch it.
+       * to a valid matrix. If the pointer is zero beforehand, let it point to
+       * the matrix between the elements @p fe_index_1 and @p fe_index_2 of
+       * the given collection. The collection computes this matrix only once
+       * for its lifetime, so repeated calls of the constraint functions do not
+       * recompute it. If the pointer is nonzero, don't touch it.
        */
       template <int dim, int spacedim>
       void
       ensure_existence_of_face_matrix(
-        const FiniteElement<dim, spacedim> & fe1,
-        const FiniteElement<dim, spacedim> & fe2,
-        std::unique_ptr<FullMatrix<double>> &matrix)
+        const dealii::hp::FECollection<dim, spacedim> &fe_collection,
+        const unsigned int                             fe_index_1,
+        const unsigned int                             fe_index_2,
+        const FullMatrix<double> *&                    matrix)
       {
         if (matrix == nullptr)
-          {
-            matrix = std::make_unique<FullMatrix<double>>(fe2.dofs_per_face,
-                                                          fe1.dofs_per_face);
-            fe1.get_face_interpolation_matrix(fe2, *matrix);
-          }
+          matrix =
+            &fe_collection.get_face_interpolation_matrix(fe_index_1, fe_index_2);
       }
 
 
@@ -345,17 +346,16 @@ namespace DoFTools
       template <int dim, int spacedim>
       void
       ensure_existence_of_subface_matrix(
-        const FiniteElement<dim, spacedim> & fe1,
-        const FiniteElement<dim, spacedim> & fe2,
-        const unsigned int                   subface,
-        std::unique_ptr<FullMatrix<double>> &matrix)
+        const dealii::hp::FECollection<dim, spacedim> &fe_collection,
+        const unsigned int                             fe_index_1,
+        const unsigned int                             fe_index_2,
+        const unsigned int                             subface,
+        const FullMatrix<double> *&                    matrix)
       {
         if (matrix == nullptr)
-          {
-            matrix = std::make_unique<FullMatrix<double>>(fe2.dofs_per_face,
-                                                          fe1.dofs_per_face);
-            fe1.get_subface_interpolation_matrix(fe2, subface, *matrix);
-          }
+          matrix = &fe_collection.get_subface_interpolation_matrix(fe_index_1,
+                                                                   fe_index_2,
+                                                                   subface);
       }
 
 
@@ -999,11 +999,15 @@ namespace DoFTools
       std::vector<types::global_dof_index> scratch_dofs;
 
       // caches for the face and subface interpolation matrices between
-      // different (or the same) finite elements. we compute them only once,
-      // namely the first time they are needed, and then just reuse them
-      Table<2, std::unique_ptr<FullMatrix<double>>> face_interpolation_matrices(
+      // different (or the same) finite elements. the matrices themselves are
+      // computed only once by the FECollection, namely the first time they
+      // are needed, and we just store pointers to them here to avoid looking
+      // them up again
+      const dealii::hp::FECollection<dim, spacedim> &fe_collection =
+        dof_handler.get_fe_collection();
+      Table<2, const FullMatrix<double> *> face_interpolation_matrices(
         n_finite_elements(dof_handler), n_finite_elements(dof_handler));
-      Table<3, std::unique_ptr<FullMatrix<double>>>
+      Table<3, const FullMatrix<double> *>
         subface_interpolation_matrices(
           n_finite_elements(dof_handler),
           n_finite_elements(dof_handler),
@@ -1096,8 +1100,10 @@ namespace DoFTools
                         {
                           mother_face_dominates =
                             mother_face_dominates &
-                            (cell->get_fe().compare_for_domination(
-                              subcell->get_fe(), /*codim=*/1));
+                            fe_collection.compare_for_domination(
+                              cell->active_fe_index(),
+                              subcell->active_fe_index(),
+                              /*codim=*/1);
                           fe_ind_face_subface.insert(
                             subcell->active_fe_index());
                         }
@@ -1150,8 +1156,9 @@ namespace DoFTools
                             // subface between FE_Q(1) and FE_Nothing, there are
                             // no constraints that we need to take care of. in
                             // that case, just continue
-                            if (cell->get_fe().compare_for_domination(
-                                  subface->get_fe(subface_fe_index),
+                            if (fe_collection.compare_for_domination(
+                                  cell->active_fe_index(),
+                                  subface_fe_index,
                                   /*codim=*/1) ==
                                 FiniteElementDomination::no_requirements)
                               continue;
@@ -1194,8 +1201,9 @@ namespace DoFTools
                             // result of projection verifies the approximation
                             // properties of a finite element onto that mesh
                             ensure_existence_of_subface_matrix(
-                              cell->get_fe(),
-                              subface->get_fe(subface_fe_index),
+                              fe_collection,
+                              cell->active_fe_index(),
+                              subface_fe_index,
                               c,
                               subface_interpolation_matrices
                                 [cell->active_fe_index()][subface_fe_index][c]);
@@ -1227,8 +1235,6 @@ namespace DoFTools
                                  DoFHandlerType>::value == true,
                                ExcInternalError());
 
-                        const dealii::hp::FECollection<dim, spacedim>
-                          &fe_collection = dof_handler.get_fe_collection();
                         // we first have to find the finite element that is able
                         // to generate a space that all the other ones can be
                         // constrained to. At this point we potentially have
@@ -1273,8 +1279,9 @@ namespace DoFTools
                                ExcInternalError());
 
                         ensure_existence_of_face_matrix(
-                          dominating_fe,
-                          cell->get_fe(),
+                          fe_collection,
+                          dominating_fe_index,
+                          cell->active_fe_index(),
                           face_interpolation_matrices[dominating_fe_index]
                                                      [cell->active_fe_index()]);
 
@@ -1381,8 +1388,9 @@ namespace DoFTools
                                      subface_fe.dofs_per_face,
                                    ExcInternalError());
                             ensure_existence_of_subface_matrix(
-                              dominating_fe,
-                              subface_fe,
+                              fe_collection,
+                              dominating_fe_index,
+                              subface_fe_index,
                               sf,
                               subface_interpolation_matrices
                                 [dominating_fe_index][subface_fe_index][sf]);
@@ -1453,9 +1461,10 @@ namespace DoFTools
                       neighbor = cell->neighbor(face);
 
                     // see which side of the face we have to constrain
-                    switch (
-                      cell->get_fe().compare_for_domination(neighbor->get_fe(),
-                                                            /*codim=*/1))
+                    switch (fe_collection.compare_for_domination(
+                      cell->active_fe_index(),
+                      neighbor->active_fe_index(),
+                      /*codim=*/1))
                       {
                         case FiniteElementDomination::this_element_dominates:
                           {
@@ -1478,8 +1487,9 @@ namespace DoFTools
                             // make sure the element constraints for this face
                             // are available
                             ensure_existence_of_face_matrix(
-                              cell->get_fe(),
-                              neighbor->get_fe(),
+                              fe_collection,
+                              cell->active_fe_index(),
+                              neighbor->active_fe_index(),
                               face_interpolation_matrices
                                 [cell->active_fe_index()]
                                 [neighbor->active_fe_index()]);
@@ -1553,9 +1563,6 @@ namespace DoFTools
                             std::set<unsigned int> fes;
                             fes.insert(this_fe_index);
                             fes.insert(neighbor_fe_index);
-                            const dealii::hp::FECollection<dim, spacedim>
-                              &fe_collection = dof_handler.get_fe_collection();
-
                             const unsigned int dominating_fe_index =
                               fe_collection.find_dominating_fe_extended(
                                 fes, /*codim=*/1);
@@ -1582,8 +1589,9 @@ namespace DoFTools
                                    ExcInternalError());
 
                             ensure_existence_of_face_matrix(
-                              dominating_fe,
-                              cell->get_fe(),
+                              fe_collection,
+                              dominating_fe_index,
+                              cell->active_fe_index(),
                               face_interpolation_matrices
                                 [dominating_fe_index][cell->active_fe_index()]);
 
@@ -1666,8 +1674,9 @@ namespace DoFTools
                                    ExcInternalError());
 
                             ensure_existence_of_face_matrix(
-                              dominating_fe,
-                              neighbor->get_fe(),
+                              fe_collection,
+                              dominating_fe_index,
+                              neighbor->active_fe_index(),
                               face_interpolation_matrices
                                 [dominating_fe_index]
                                 [neighbor->active_fe_index()]);
@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -48,6 +49,7 @@
 #include <deal.II/numerics/vector_tools.h>
 
 #include <algorithm>
+#include <array>
 #include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
@@ -1419,6 +1421,308 @@ namespace DoFTools
                                          face_has_flux_coupling);
   }
 
+
+
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * The index lists a cell contributes to the direct construction of a
+       * sparsity pattern: the DoF indices of the cell, the sorted indices
+       * onto which they are condensed by the constraints, and the sorted
+       * subset of constrained DoF indices.
+       */
+      enum CellIndexListKind
+      {
+        local_indices       = 0,
+        condensed_indices   = 1,
+        constrained_indices = 2
+      };
+
+      /**
+       * A block of couplings in the final sparsity pattern: all rows of one
+       * cell index list couple with all columns of another one.
+       */
+      struct CouplingBlock
+      {
+        unsigned int      row_cell;
+        CellIndexListKind row_kind;
+        unsigned int      column_cell;
+        CellIndexListKind column_kind;
+      };
+
+
+
+      template <typename DoFHandlerType, typename number>
+      void
+      make_sparsity_pattern_direct(
+        const DoFHandlerType &           dof,
+        SparsityPattern &                sparsity,
+        const AffineConstraints<number> &constraints,
+        const bool                       keep_constrained_dofs,
+        const bool                       add_face_couplings)
+      {
+        using size_type = types::global_dof_index;
+
+        Assert(dof.get_triangulation().locally_owned_subdomain() ==
+                 numbers::invalid_subdomain_id,
+               ExcMessage("This function builds a SparsityPattern for all "
+                          "degrees of freedom and can therefore only be "
+                          "used with sequential triangulations."));
+
+        const size_type    n_dofs  = dof.n_dofs();
+        const unsigned int n_cells = dof.get_triangulation().n_active_cells();
+
+        // first collect the index lists of all cells. only the DoF indices
+        // need to be read serially, the condensation with the constraints is
+        // done in parallel
+        std::vector<std::array<std::vector<size_type>, 3>> cell_lists(
+          n_cells);
+        for (const auto &cell : dof.active_cell_iterators())
+          {
+            std::vector<size_type> &local_dofs =
+              cell_lists[cell->active_cell_index()][local_indices];
+            local_dofs.resize(cell->get_fe().dofs_per_cell);
+            cell->get_dof_indices(local_dofs);
+          }
+
+        parallel::apply_to_subranges(
+          0U,
+          n_cells,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int c = begin; c < end; ++c)
+              {
+                std::vector<size_type> &condensed =
+                  cell_lists[c][condensed_indices];
+                std::vector<size_type> &constrained =
+                  cell_lists[c][constrained_indices];
+                for (const size_type i : cell_lists[c][local_indices])
+                  if (constraints.is_constrained(i))
+                    {
+                      constrained.push_back(i);
+                      for (const auto &entry :
+                           *constraints.get_constraint_entries(i))
+                        condensed.push_back(entry.first);
+                    }
+                  else
+                    condensed.push_back(i);
+
+                std::sort(condensed.begin(), condensed.end());
+                condensed.erase(std::unique(condensed.begin(),
+                                            condensed.end()),
+                                condensed.end());
+                std::sort(constrained.begin(), constrained.end());
+                constrained.erase(std::unique(constrained.begin(),
+                                              constrained.end()),
+                                  constrained.end());
+              }
+          },
+          64);
+
+        // next describe the couplings in terms of blocks of these index
+        // lists. this mirrors what
+        // AffineConstraints::add_entries_local_to_global() adds for a cell
+        // and for a pair of cells sharing a face
+        std::vector<CouplingBlock> blocks;
+        const auto add_cell_couplings = [&](const unsigned int c) {
+          blocks.push_back({c, condensed_indices, c, condensed_indices});
+          if (keep_constrained_dofs &&
+              !cell_lists[c][constrained_indices].empty())
+            {
+              blocks.push_back({c, constrained_indices, c, local_indices});
+              blocks.push_back({c, local_indices, c, constrained_indices});
+            }
+        };
+        const auto add_face_coupling = [&](const unsigned int c,
+                                           const unsigned int n) {
+          blocks.push_back({c, condensed_indices, n, condensed_indices});
+          if (keep_constrained_dofs)
+            {
+              if (!cell_lists[c][constrained_indices].empty())
+                blocks.push_back({c, constrained_indices, n, local_indices});
+              if (!cell_lists[n][constrained_indices].empty())
+                blocks.push_back({c, local_indices, n, constrained_indices});
+            }
+        };
+
+        for (const auto &cell : dof.active_cell_iterators())
+          {
+            const unsigned int c = cell->active_cell_index();
+            add_cell_couplings(c);
+
+            if (add_face_couplings == false)
+              continue;
+
+            for (const unsigned int face :
+                 GeometryInfo<DoFHandlerType::dimension>::face_indices())
+              {
+                const bool periodic_neighbor =
+                  cell->has_periodic_neighbor(face);
+                if (cell->at_boundary(face) && !periodic_neighbor)
+                  continue;
+
+                typename DoFHandlerType::level_cell_iterator neighbor =
+                  cell->neighbor_or_periodic_neighbor(face);
+                const bool neighbor_is_active = neighbor->is_active();
+
+                // in 1d, go straight to the cell behind the face
+                if (DoFHandlerType::dimension == 1)
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                if (neighbor->has_children())
+                  {
+                    // the finer cells skip this face, so add the couplings
+                    // in both directions here
+                    for (unsigned int sub_nr = 0;
+                         sub_nr != cell->face(face)->number_of_children();
+                         ++sub_nr)
+                      {
+                        const unsigned int n =
+                          (periodic_neighbor ?
+                             cell->periodic_neighbor_child_on_subface(face,
+                                                                      sub_nr) :
+                             cell->neighbor_child_on_subface(face, sub_nr))
+                            ->active_cell_index();
+                        add_face_coupling(c, n);
+                        add_face_coupling(n, c);
+                      }
+                  }
+                else
+                  {
+                    // refinement edges are taken care of by coarser cells
+                    if ((!periodic_neighbor &&
+                         cell->neighbor_is_coarser(face)) ||
+                        (periodic_neighbor &&
+                         cell->periodic_neighbor_is_coarser(face)))
+                      continue;
+
+                    // the other direction is added when visiting the
+                    // neighbor, unless it is the finer cell of a 1d
+                    // refinement edge
+                    const unsigned int n = neighbor->active_cell_index();
+                    add_face_coupling(c, n);
+                    if (!neighbor_is_active)
+                      add_face_coupling(n, c);
+                  }
+              }
+          }
+
+        // set up for each row the list of blocks it is part of
+        std::vector<std::size_t> row_block_start(n_dofs + 1, 0);
+        for (const CouplingBlock &block : blocks)
+          for (const size_type row : cell_lists[block.row_cell][block.row_kind])
+            ++row_block_start[row + 1];
+        std::partial_sum(row_block_start.begin(),
+                         row_block_start.end(),
+                         row_block_start.begin());
+
+        std::vector<unsigned int> row_blocks(row_block_start.back());
+        {
+          std::vector<std::size_t> next_position(row_block_start.begin(),
+                                                 row_block_start.end() - 1);
+          for (unsigned int b = 0; b < blocks.size(); ++b)
+            for (const size_type row :
+                 cell_lists[blocks[b].row_cell][blocks[b].row_kind])
+              row_blocks[next_position[row]++] = b;
+        }
+
+        // every row is now generated twice from its blocks, once to
+        // determine its exact length and once to write its entries into the
+        // allocated pattern. rows are independent of each other, so both
+        // passes can run in parallel
+        const auto gather_row = [&](const size_type         row,
+                                    std::vector<size_type> &columns) {
+          columns.clear();
+          for (std::size_t k = row_block_start[row];
+               k < row_block_start[row + 1];
+               ++k)
+            {
+              const CouplingBlock &block = blocks[row_blocks[k]];
+              const std::vector<size_type> &block_columns =
+                cell_lists[block.column_cell][block.column_kind];
+              columns.insert(columns.end(),
+                             block_columns.begin(),
+                             block_columns.end());
+            }
+          std::sort(columns.begin(), columns.end());
+          columns.erase(std::unique(columns.begin(), columns.end()),
+                        columns.end());
+        };
+
+        std::vector<unsigned int> row_lengths(n_dofs);
+        parallel::apply_to_subranges(
+          size_type(0),
+          n_dofs,
+          [&](const size_type begin, const size_type end) {
+            std::vector<size_type> columns;
+            for (size_type row = begin; row < end; ++row)
+              {
+                gather_row(row, columns);
+                // the diagonal entry is always stored
+                row_lengths[row] =
+                  columns.size() +
+                  (std::binary_search(columns.begin(), columns.end(), row) ?
+                     0 :
+                     1);
+              }
+          },
+          256);
+
+        sparsity.reinit(n_dofs, n_dofs, row_lengths);
+
+        parallel::apply_to_subranges(
+          size_type(0),
+          n_dofs,
+          [&](const size_type begin, const size_type end) {
+            std::vector<size_type> columns;
+            for (size_type row = begin; row < end; ++row)
+              {
+                gather_row(row, columns);
+                sparsity.add_entries(row,
+                                     columns.begin(),
+                                     columns.end(),
+                                     true);
+              }
+          },
+          256);
+
+        // all allocated entries are used, so this only marks the pattern as
+        // compressed without copying it
+        sparsity.compress();
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
+  template <typename DoFHandlerType, typename number>
+  void
+  make_sparsity_pattern_direct(const DoFHandlerType &           dof,
+                               SparsityPattern &                sparsity,
+                               const AffineConstraints<number> &constraints,
+                               const bool keep_constrained_dofs)
+  {
+    internal::make_sparsity_pattern_direct(
+      dof, sparsity, constraints, keep_constrained_dofs, false);
+  }
+
+
+
+  template <typename DoFHandlerType, typename number>
+  void
+  make_flux_sparsity_pattern_direct(
+    const DoFHandlerType &           dof,
+    SparsityPattern &                sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs)
+  {
+    internal::make_sparsity_pattern_direct(
+      dof, sparsity, constraints, keep_constrained_dofs, true);
+  }
+
+
 } // end of namespace DoFTools
 
 
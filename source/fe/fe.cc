@@ -14,8 +14,8 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
-#include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/quadrature_lib.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 
@@ -1223,7 +1223,7 @@ FiniteElement<dim, spacedim>::get_face_data(
 {
   return get_data(flags,
                   mapping,
-                  QProjector<dim>::project_to_all_faces(quadrature),
+                  *QuadratureRegistry::project_to_all_faces<dim>(quadrature),
                   output_data);
 }
 
@@ -1241,7 +1241,7 @@ FiniteElement<dim, spacedim>::get_subface_data(
 {
   return get_data(flags,
                   mapping,
-                  QProjector<dim>::project_to_all_subfaces(quadrature),
+                  *QuadratureRegistry::project_to_all_subfaces<dim>(quadrature),
                   output_data);
 }
 
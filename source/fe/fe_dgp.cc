@@ -40,19 +40,96 @@ FE_DGP<dim, spacedim>::FE_DGP(const unsigned int degree)
         FiniteElementData<dim>(get_dpo_vector(degree), 1, degree).dofs_per_cell,
         std::vector<bool>(1, true)))
 {
-  // Reinit the vectors of restriction and prolongation matrices to the right
-  // sizes
-  this->reinit_restriction_and_prolongation_matrices();
-  // Fill prolongation matrices with embedding operators
+  // do not initialize embedding and restriction here. these matrices are
+  // initialized on demand in get_restriction_matrix and
+  // get_prolongation_matrix
+}
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_DGP<dim, spacedim>::get_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // initialization upon first request. the matrices for isotropic refinement
+  // are set last, so they indicate whether all matrices are available
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if the matrices got computed while waiting for the lock, there is
+      // nothing left to do
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_DGP<dim, spacedim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim, spacedim>::get_prolongation_matrix(child,
+                                                               refinement_case);
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_DGP<dim, spacedim>::get_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // the matrices are initialized together with the prolongation matrices
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_DGP<dim, spacedim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim, spacedim>::get_restriction_matrix(child,
+                                                              refinement_case);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_DGP<dim, spacedim>::initialize_transfer_matrices()
+{
+  // compute the prolongation matrices in a temporary object and only move
+  // them into place at the end, because other threads check them to see
+  // whether the matrices are available without acquiring the lock
+  std::vector<std::vector<FullMatrix<double>>> prolongation(
+    this->prolongation);
+  for (auto &matrices : prolongation)
+    for (auto &matrix : matrices)
+      matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+  for (auto &matrices : this->restriction)
+    for (auto &matrix : matrices)
+      matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+
+  // Fill prolongation matrices with embedding operators and restriction
+  // matrices with L2-projection. the computation needs the element to live
+  // in the space dimension of the reference cell
   if (dim == spacedim)
     {
-      FETools::compute_embedding_matrices(*this, this->prolongation);
-      // Fill restriction matrices with L2-projection
+      FETools::compute_embedding_matrices(*this, prolongation);
       FETools::compute_projection_matrices(*this, this->restriction);
     }
+  else
+    {
+      const FE_DGP<dim> tmp(this->degree);
+      FETools::compute_embedding_matrices(tmp, prolongation);
+      FETools::compute_projection_matrices(tmp, this->restriction);
+    }
+
+  for (unsigned int i = 0; i < prolongation.size(); ++i)
+    this->prolongation[i].swap(prolongation[i]);
 }
 
 
+
 template <int dim, int spacedim>
 std::string
 FE_DGP<dim, spacedim>::get_name() const
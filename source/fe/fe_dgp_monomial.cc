@@ -149,14 +149,79 @@ FE_DGPMonomial<dim>::FE_DGPMonomial(const unsigned int degree)
   // DG doesn't have constraints, so
   // leave them empty
 
-  // Reinit the vectors of
-  // restriction and prolongation
-  // matrices to the right sizes
-  this->reinit_restriction_and_prolongation_matrices();
+  // do not initialize embedding and restriction here. these matrices are
+  // initialized on demand in get_restriction_matrix and
+  // get_prolongation_matrix
+}
+
+
+
+template <int dim>
+const FullMatrix<double> &
+FE_DGPMonomial<dim>::get_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // initialization upon first request. the matrices for isotropic refinement
+  // are set last, so they indicate whether all matrices are available
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if the matrices got computed while waiting for the lock, there is
+      // nothing left to do
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_DGPMonomial<dim> &>(*this).initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim>::get_prolongation_matrix(child, refinement_case);
+}
+
+
+
+template <int dim>
+const FullMatrix<double> &
+FE_DGPMonomial<dim>::get_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // the matrices are initialized together with the prolongation matrices
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_DGPMonomial<dim> &>(*this).initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim>::get_restriction_matrix(child, refinement_case);
+}
+
+
+
+template <int dim>
+void
+FE_DGPMonomial<dim>::initialize_transfer_matrices()
+{
+  // compute the prolongation matrices in a temporary object and only move
+  // them into place at the end, because other threads check them to see
+  // whether the matrices are available without acquiring the lock
+  std::vector<std::vector<FullMatrix<double>>> prolongation(
+    this->prolongation);
+  for (auto &matrices : prolongation)
+    for (auto &matrix : matrices)
+      matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+  for (auto &matrices : this->restriction)
+    for (auto &matrix : matrices)
+      matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+
   // Fill prolongation matrices with embedding operators
-  FETools::compute_embedding_matrices(*this, this->prolongation);
+  FETools::compute_embedding_matrices(*this, prolongation);
   // Fill restriction matrices with L2-projection
   FETools::compute_projection_matrices(*this, this->restriction);
+
+  for (unsigned int i = 0; i < prolongation.size(); ++i)
+    this->prolongation[i].swap(prolongation[i]);
 }
 
 
@@ -404,7 +404,10 @@ FE_PolyTensor<dim, spacedim>::fill_fe_values(
   // TODO: Preliminary hack to demonstrate the overall principle!
 
   // Compute eventual sign changes depending on the neighborhood
-  // between two faces.
+  // between two faces. Keep the signs of the previous cell, which allow us
+  // to skip the transformation of those shape functions on translated cells
+  // whose sign did not change.
+  fe_data.previous_sign_change.swap(fe_data.sign_change);
   std::fill(fe_data.sign_change.begin(), fe_data.sign_change.end(), 1.0);
 
   internal::FE_PolyTensor::get_face_sign_change_rt(cell,
@@ -431,13 +434,18 @@ FE_PolyTensor<dim, spacedim>::fill_fe_values(
       //
       // we only need to do this if the current cell is not a translation of
       // the previous one; or, even if it is a translation, if we use mappings
-      // other than the standard mappings that require us to recompute values
-      // and derivatives because of possible sign changes
-      if (fe_data.update_each & update_values &&
-          ((cell_similarity != CellSimilarity::translation) ||
-           ((mapping_kind == mapping_piola) ||
-            (mapping_kind == mapping_raviart_thomas) ||
-            (mapping_kind == mapping_nedelec))))
+      // other than the standard mappings and the sign of the shape function
+      // changed with respect to the previous cell. all transformations
+      // depend only on the Jacobian (and its derivatives), which is the same
+      // on translated cells
+      const bool recompute =
+        (cell_similarity != CellSimilarity::translation) ||
+        (((mapping_kind == mapping_piola) ||
+          (mapping_kind == mapping_raviart_thomas) ||
+          (mapping_kind == mapping_nedelec)) &&
+         (fe_data.sign_change[i] != fe_data.previous_sign_change[i]));
+
+      if (fe_data.update_each & update_values && recompute)
         {
           switch (mapping_kind)
             {
@@ -506,12 +514,7 @@ FE_PolyTensor<dim, spacedim>::fill_fe_values(
         }
 
       // update gradients. apply the same logic as above
-      if (fe_data.update_each & update_gradients &&
-          ((cell_similarity != CellSimilarity::translation) ||
-           ((mapping_kind == mapping_piola) ||
-            (mapping_kind == mapping_raviart_thomas) ||
-            (mapping_kind == mapping_nedelec))))
-
+      if (fe_data.update_each & update_gradients && recompute)
         {
           switch (mapping_kind)
             {
@@ -651,12 +654,7 @@ FE_PolyTensor<dim, spacedim>::fill_fe_values(
         }
 
       // update hessians. apply the same logic as above
-      if (fe_data.update_each & update_hessians &&
-          ((cell_similarity != CellSimilarity::translation) ||
-           ((mapping_kind == mapping_piola) ||
-            (mapping_kind == mapping_raviart_thomas) ||
-            (mapping_kind == mapping_nedelec))))
-
+      if (fe_data.update_each & update_hessians && recompute)
         {
           switch (mapping_kind)
             {
@@ -927,11 +925,7 @@ FE_PolyTensor<dim, spacedim>::fill_fe_values(
         }
 
       // third derivatives are not implemented
-      if (fe_data.update_each & update_3rd_derivatives &&
-          ((cell_similarity != CellSimilarity::translation) ||
-           ((mapping_kind == mapping_piola) ||
-            (mapping_kind == mapping_raviart_thomas) ||
-            (mapping_kind == mapping_nedelec))))
+      if (fe_data.update_each & update_3rd_derivatives && recompute)
         {
           Assert(false, ExcNotImplemented())
         }
@@ -77,15 +77,9 @@ FE_RaviartThomas<dim>::FE_RaviartThomas(const unsigned int deg)
   // and similar functions will be the correct ones, not
   // the raw shape functions from the polynomial space anymore.
 
-  // Reinit the vectors of
-  // restriction and prolongation
-  // matrices to the right sizes.
-  // Restriction only for isotropic
-  // refinement
-  this->reinit_restriction_and_prolongation_matrices(true);
-  // Fill prolongation matrices with embedding operators
-  FETools::compute_embedding_matrices(*this, this->prolongation);
-  initialize_restriction();
+  // do not initialize embedding and restriction here. these matrices are
+  // initialized on demand in get_restriction_matrix and
+  // get_prolongation_matrix
 
   // TODO[TL]: for anisotropic refinement we will probably need a table of
   // submatrices with an array for each refine case
@@ -110,6 +104,77 @@ FE_RaviartThomas<dim>::FE_RaviartThomas(const unsigned int deg)
 
 
 
+template <int dim>
+const FullMatrix<double> &
+FE_RaviartThomas<dim>::get_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // initialization upon first request. the matrices for isotropic refinement
+  // are set last, so they indicate whether all matrices are available
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if the matrices got computed while waiting for the lock, there is
+      // nothing left to do
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_RaviartThomas<dim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim>::get_prolongation_matrix(child, refinement_case);
+}
+
+
+
+template <int dim>
+const FullMatrix<double> &
+FE_RaviartThomas<dim>::get_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // the matrices are initialized together with the prolongation matrices
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_RaviartThomas<dim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim>::get_restriction_matrix(child, refinement_case);
+}
+
+
+
+template <int dim>
+void
+FE_RaviartThomas<dim>::initialize_transfer_matrices()
+{
+  // compute the prolongation matrices in a temporary object and only move
+  // them into place at the end, because other threads check them to see
+  // whether the matrices are available without acquiring the lock
+  std::vector<std::vector<FullMatrix<double>>> prolongation(
+    this->prolongation);
+  for (auto &matrices : prolongation)
+    for (auto &matrix : matrices)
+      matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+  // Restriction only for isotropic refinement
+  for (auto &matrix : this->restriction.back())
+    matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+
+  // Fill prolongation matrices with embedding operators
+  FETools::compute_embedding_matrices(*this, prolongation);
+  initialize_restriction();
+
+  for (unsigned int i = 0; i < prolongation.size(); ++i)
+    this->prolongation[i].swap(prolongation[i]);
+}
+
+
+
 template <int dim>
 std::string
 FE_RaviartThomas<dim>::get_name() const
@@ -68,22 +68,10 @@ FE_RaviartThomasNodal<dim>::FE_RaviartThomasNodal(const unsigned int deg)
   // and similar functions will be the correct ones, not
   // the raw shape functions from the polynomial space anymore.
 
-  // Reinit the vectors of
-  // prolongation matrices to the
-  // right sizes. There are no
-  // restriction matrices implemented
-  for (unsigned int ref_case = RefinementCase<dim>::cut_x;
-       ref_case < RefinementCase<dim>::isotropic_refinement + 1;
-       ++ref_case)
-    {
-      const unsigned int nc =
-        GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case));
+  // do not initialize the embedding matrices here. they are initialized on
+  // demand in get_prolongation_matrix. There are no restriction matrices
+  // implemented
 
-      for (unsigned int i = 0; i < nc; ++i)
-        this->prolongation[ref_case - 1][i].reinit(n_dofs, n_dofs);
-    }
-  // Fill prolongation matrices with embedding operators
-  FETools::compute_embedding_matrices(*this, this->prolongation);
   // TODO[TL]: for anisotropic refinement we will probably need a table of
   // submatrices with an array for each refine case
   FullMatrix<double> face_embeddings[GeometryInfo<dim>::max_children_per_face];
@@ -107,6 +95,52 @@ FE_RaviartThomasNodal<dim>::FE_RaviartThomasNodal(const unsigned int deg)
 
 
 
+template <int dim>
+const FullMatrix<double> &
+FE_RaviartThomasNodal<dim>::get_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  // initialization upon first request. the matrices for isotropic refinement
+  // are set last, so they indicate whether all matrices are available
+  if (this->prolongation.back()[0].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if the matrices got computed while waiting for the lock, there is
+      // nothing left to do
+      if (this->prolongation.back()[0].n() == 0)
+        const_cast<FE_RaviartThomasNodal<dim> &>(*this)
+          .initialize_transfer_matrices();
+    }
+
+  return FiniteElement<dim>::get_prolongation_matrix(child, refinement_case);
+}
+
+
+
+template <int dim>
+void
+FE_RaviartThomasNodal<dim>::initialize_transfer_matrices()
+{
+  // compute the matrices in a temporary object and only move them into place
+  // at the end, because other threads check them to see whether the matrices
+  // are available without acquiring the lock
+  std::vector<std::vector<FullMatrix<double>>> prolongation(
+    this->prolongation);
+  for (auto &matrices : prolongation)
+    for (auto &matrix : matrices)
+      matrix.reinit(this->dofs_per_cell, this->dofs_per_cell);
+
+  // Fill prolongation matrices with embedding operators
+  FETools::compute_embedding_matrices(*this, prolongation);
+
+  for (unsigned int i = 0; i < prolongation.size(); ++i)
+    this->prolongation[i].swap(prolongation[i]);
+}
+
+
+
 template <int dim>
 std::string
 FE_RaviartThomasNodal<dim>::get_name() const
@@ -60,88 +60,24 @@ namespace
 
 
 
-  template <int dim, int spacedim>
-  std::complex<double>
-  integrate(const FiniteElement<dim, spacedim> &fe,
-            const Quadrature<dim> &             quadrature,
-            const Tensor<1, dim> &              k_vector,
-            const unsigned int                  j)
-  {
-    std::complex<double> sum = 0;
-    for (unsigned int q = 0; q < quadrature.size(); ++q)
-      {
-        const Point<dim> &x_q = quadrature.point(q);
-        sum += std::exp(std::complex<double>(0, 1) * (k_vector * x_q)) *
-               fe.shape_value(j, x_q) * quadrature.weight(q);
-      }
-    return sum;
-  }
-
-
-
   /*
    * Ensure that the transformation matrix for FiniteElement index
    * @p fe_index is calculated. If not, calculate it.
+   *
+   * The rows of the matrix are enumerated such that the last index of the
+   * wave vector runs fastest. The entries are the integrals of the
+   * products of the complex exponentials and the shape functions over the
+   * unit cell. To compute them, the shape functions are evaluated only once
+   * at each quadrature point and each exponential only once per quadrature
+   * point, instead of both once for every entry of the matrix.
    */
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &              n_coefficients_per_direction,
-    const hp::FECollection<1, spacedim> &          fe_collection,
-    const hp::QCollection<1> &                     q_collection,
-    const Table<1, Tensor<1, 1>> &                 k_vectors,
-    const unsigned int                             fe,
-    std::vector<FullMatrix<std::complex<double>>> &fourier_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (fourier_transform_matrices[fe].m() == 0)
-      {
-        fourier_transform_matrices[fe].reinit(n_coefficients_per_direction[fe],
-                                              fe_collection[fe].dofs_per_cell);
-
-        for (unsigned int k = 0; k < n_coefficients_per_direction[fe]; ++k)
-          for (unsigned int j = 0; j < fe_collection[fe].dofs_per_cell; ++j)
-            fourier_transform_matrices[fe](k, j) =
-              integrate(fe_collection[fe], q_collection[fe], k_vectors(k), j);
-      }
-  }
-
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &              n_coefficients_per_direction,
-    const hp::FECollection<2, spacedim> &          fe_collection,
-    const hp::QCollection<2> &                     q_collection,
-    const Table<2, Tensor<1, 2>> &                 k_vectors,
-    const unsigned int                             fe,
-    std::vector<FullMatrix<std::complex<double>>> &fourier_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (fourier_transform_matrices[fe].m() == 0)
-      {
-        fourier_transform_matrices[fe].reinit(
-          Utilities::fixed_power<2>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].dofs_per_cell);
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe];
-               ++k2, ++k)
-            for (unsigned int j = 0; j < fe_collection[fe].dofs_per_cell; ++j)
-              fourier_transform_matrices[fe](k, j) = integrate(
-                fe_collection[fe], q_collection[fe], k_vectors(k1, k2), j);
-      }
-  }
-
-  template <int spacedim>
+  template <int dim, int spacedim>
   void
   ensure_existence(
     const std::vector<unsigned int> &              n_coefficients_per_direction,
-    const hp::FECollection<3, spacedim> &          fe_collection,
-    const hp::QCollection<3> &                     q_collection,
-    const Table<3, Tensor<1, 3>> &                 k_vectors,
+    const hp::FECollection<dim, spacedim> &        fe_collection,
+    const hp::QCollection<dim> &                   q_collection,
+    const Table<dim, Tensor<1, dim>> &             k_vectors,
     const unsigned int                             fe,
     std::vector<FullMatrix<std::complex<double>>> &fourier_transform_matrices)
   {
@@ -149,21 +85,48 @@ namespace
 
     if (fourier_transform_matrices[fe].m() == 0)
       {
-        fourier_transform_matrices[fe].reinit(
-          Utilities::fixed_power<3>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].dofs_per_cell);
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe]; ++k2)
-            for (unsigned int k3 = 0; k3 < n_coefficients_per_direction[fe];
-                 ++k3, ++k)
-              for (unsigned int j = 0; j < fe_collection[fe].dofs_per_cell; ++j)
-                fourier_transform_matrices[fe](k, j) =
-                  integrate(fe_collection[fe],
-                            q_collection[fe],
-                            k_vectors(k1, k2, k3),
-                            j);
+        const FiniteElement<dim, spacedim> &finite_element = fe_collection[fe];
+        const Quadrature<dim> &             quadrature     = q_collection[fe];
+        const unsigned int n_coefficients = n_coefficients_per_direction[fe];
+        const unsigned int n_q_points     = quadrature.size();
+        const unsigned int dofs_per_cell  = finite_element.dofs_per_cell;
+
+        FullMatrix<double> weighted_shape_values(n_q_points, dofs_per_cell);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            weighted_shape_values(q, j) =
+              finite_element.shape_value(j, quadrature.point(q)) *
+              quadrature.weight(q);
+
+        FullMatrix<std::complex<double>> &matrix =
+          fourier_transform_matrices[fe];
+        matrix.reinit(Utilities::fixed_power<dim>(n_coefficients),
+                      dofs_per_cell);
+
+        std::vector<std::complex<double>> values(dofs_per_cell);
+        for (unsigned int k = 0; k < matrix.m(); ++k)
+          {
+            TableIndices<dim> indices;
+            for (unsigned int d = dim, rest = k; d > 0; --d)
+              {
+                indices[d - 1] = rest % n_coefficients;
+                rest /= n_coefficients;
+              }
+            const Tensor<1, dim> &k_vector = k_vectors(indices);
+
+            std::fill(values.begin(), values.end(), 0.);
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                const Point<dim> &         x_q = quadrature.point(q);
+                const std::complex<double> exponential =
+                  std::exp(std::complex<double>(0, 1) * (k_vector * x_q));
+                for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                  values[j] += exponential * weighted_shape_values(q, j);
+              }
+
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              matrix(k, j) = values[j];
+          }
       }
   }
 } // namespace
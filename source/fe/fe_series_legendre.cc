@@ -35,28 +35,23 @@ namespace
                  << "x[" << arg1 << "] = " << arg2 << " is not in [0,1]");
 
   /*
-   * dim dimensional Legendre function with indices @p indices
-   * evaluated at @p x_q in [0,1]^dim.
+   * One dimensional factor of the dim dimensional Legendre function with
+   * index @p index in coordinate direction @p d, evaluated at the
+   * coordinate @p x_d = x_q[d] in [0,1].
    */
-  template <int dim>
   double
-  Lh(const Point<dim> &x_q, const TableIndices<dim> &indices)
+  Lh(const double x_d, const unsigned int d, const unsigned int index)
   {
 #ifdef DEAL_II_WITH_GSL
-    double res = 1.0;
-    for (unsigned int d = 0; d < dim; d++)
-      {
-        const double x = 2.0 * (x_q[d] - 0.5);
-        Assert((x_q[d] <= 1.0) && (x_q[d] >= 0.), ExcLegendre(d, x_q[d]));
-        const int ind = indices[d];
-        res *= std::sqrt(2.0) * gsl_sf_legendre_Pl(ind, x);
-      }
-    return res;
+    const double x = 2.0 * (x_d - 0.5);
+    Assert((x_d <= 1.0) && (x_d >= 0.), ExcLegendre(d, x_d));
+    return std::sqrt(2.0) * gsl_sf_legendre_Pl(index, x);
 
 #else
 
-    (void)x_q;
-    (void)indices;
+    (void)x_d;
+    (void)d;
+    (void)index;
     AssertThrow(false,
                 ExcMessage("deal.II has to be configured with GSL "
                            "in order to use Legendre transformation."));
@@ -82,110 +77,80 @@ namespace
 
 
 
-  template <int dim, int spacedim>
-  double
-  integrate(const FiniteElement<dim, spacedim> &fe,
-            const Quadrature<dim> &             quadrature,
-            const TableIndices<dim> &           indices,
-            const unsigned int                  dof)
-  {
-    double sum = 0;
-    for (unsigned int q = 0; q < quadrature.size(); ++q)
-      {
-        const Point<dim> &x_q = quadrature.point(q);
-        sum +=
-          Lh(x_q, indices) * fe.shape_value(dof, x_q) * quadrature.weight(q);
-      }
-    return sum * multiplier(indices);
-  }
-
-
-
   /**
    * Ensure that the transformation matrix for FiniteElement index
    * @p fe_index is calculated. If not, calculate it.
+   *
+   * The rows of the matrix are enumerated such that the last index of the
+   * Legendre function runs fastest. The entries are the integrals of the
+   * products of the Legendre functions and the shape functions over the
+   * unit cell. To compute them, the shape functions and the one dimensional
+   * factors of the Legendre functions are evaluated only once at each
+   * quadrature point instead of once for every entry of the matrix, which
+   * reduces the number of (expensive) evaluations of these functions from
+   * the product of the number of coefficients, shape functions, and
+   * quadrature points to their sum.
    */
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &    n_coefficients_per_direction,
-    const hp::FECollection<1, spacedim> &fe_collection,
-    const hp::QCollection<1> &           q_collection,
-    const unsigned int                   fe,
-    std::vector<FullMatrix<double>> &    legendre_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (legendre_transform_matrices[fe].m() == 0)
-      {
-        legendre_transform_matrices[fe].reinit(n_coefficients_per_direction[fe],
-                                               fe_collection[fe].dofs_per_cell);
-
-        for (unsigned int k = 0; k < n_coefficients_per_direction[fe]; ++k)
-          for (unsigned int j = 0; j < fe_collection[fe].dofs_per_cell; ++j)
-            legendre_transform_matrices[fe](k, j) = integrate(
-              fe_collection[fe], q_collection[fe], TableIndices<1>(k), j);
-      }
-  }
-
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &    n_coefficients_per_direction,
-    const hp::FECollection<2, spacedim> &fe_collection,
-    const hp::QCollection<2> &           q_collection,
-    const unsigned int                   fe,
-    std::vector<FullMatrix<double>> &    legendre_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (legendre_transform_matrices[fe].m() == 0)
-      {
-        legendre_transform_matrices[fe].reinit(
-          Utilities::fixed_power<2>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].dofs_per_cell);
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe];
-               ++k2, k++)
-            for (unsigned int j = 0; j < fe_collection[fe].dofs_per_cell; ++j)
-              legendre_transform_matrices[fe](k, j) =
-                integrate(fe_collection[fe],
-                          q_collection[fe],
-                          TableIndices<2>(k1, k2),
-                          j);
-      }
-  }
-
-  template <int spacedim>
+  template <int dim, int spacedim>
   void
   ensure_existence(
-    const std::vector<unsigned int> &    n_coefficients_per_direction,
-    const hp::FECollection<3, spacedim> &fe_collection,
-    const hp::QCollection<3> &           q_collection,
-    const unsigned int                   fe,
-    std::vector<FullMatrix<double>> &    legendre_transform_matrices)
+    const std::vector<unsigned int> &      n_coefficients_per_direction,
+    const hp::FECollection<dim, spacedim> &fe_collection,
+    const hp::QCollection<dim> &           q_collection,
+    const unsigned int                     fe,
+    std::vector<FullMatrix<double>> &      legendre_transform_matrices)
   {
     AssertIndexRange(fe, fe_collection.size());
 
     if (legendre_transform_matrices[fe].m() == 0)
       {
-        legendre_transform_matrices[fe].reinit(
-          Utilities::fixed_power<3>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].dofs_per_cell);
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe]; ++k2)
-            for (unsigned int k3 = 0; k3 < n_coefficients_per_direction[fe];
-                 ++k3, k++)
-              for (unsigned int j = 0; j < fe_collection[fe].dofs_per_cell; ++j)
-                legendre_transform_matrices[fe](k, j) =
-                  integrate(fe_collection[fe],
-                            q_collection[fe],
-                            TableIndices<3>(k1, k2, k3),
-                            j);
+        const FiniteElement<dim, spacedim> &finite_element = fe_collection[fe];
+        const Quadrature<dim> &             quadrature     = q_collection[fe];
+        const unsigned int n_coefficients = n_coefficients_per_direction[fe];
+        const unsigned int n_q_points     = quadrature.size();
+        const unsigned int dofs_per_cell  = finite_element.dofs_per_cell;
+
+        FullMatrix<double> weighted_shape_values(n_q_points, dofs_per_cell);
+        Table<3, double>   legendre_values(dim, n_coefficients, n_q_points);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            const Point<dim> &x_q = quadrature.point(q);
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              weighted_shape_values(q, j) =
+                finite_element.shape_value(j, x_q) * quadrature.weight(q);
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int k = 0; k < n_coefficients; ++k)
+                legendre_values(d, k, q) = Lh(x_q[d], d, k);
+          }
+
+        FullMatrix<double> &matrix = legendre_transform_matrices[fe];
+        matrix.reinit(Utilities::fixed_power<dim>(n_coefficients),
+                      dofs_per_cell);
+
+        std::vector<double> values(dofs_per_cell);
+        for (unsigned int k = 0; k < matrix.m(); ++k)
+          {
+            TableIndices<dim> indices;
+            for (unsigned int d = dim, rest = k; d > 0; --d)
+              {
+                indices[d - 1] = rest % n_coefficients;
+                rest /= n_coefficients;
+              }
+
+            std::fill(values.begin(), values.end(), 0.);
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                double legendre_value = 1.0;
+                for (unsigned int d = 0; d < dim; ++d)
+                  legendre_value *= legendre_values(d, indices[d], q);
+                for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                  values[j] += legendre_value * weighted_shape_values(q, j);
+              }
+
+            const double factor = multiplier(indices);
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              matrix(k, j) = values[j] * factor;
+          }
       }
   }
 } // namespace
@@ -1304,19 +1304,11 @@ FESystem<dim, spacedim>::compute_fill(
                                          base_fe_data,
                                          base_data);
 
-        // now data has been generated, so copy it. we used to work by
-        // looping over all base elements (i.e. this outer loop), then over
-        // multiplicity, then over the shape functions from that base
-        // element, but that requires that we can infer the global number of
-        // a shape function from its number in the base element. for that we
-        // had the component_to_system_table.
-        //
-        // however, this does of course no longer work since we have
-        // non-primitive elements. so we go the other way round: loop over
-        // all shape functions of the composed element, and here only treat
-        // those shape functions that belong to a given base element
-        // TODO: Introduce the needed table and loop only over base element
-        // shape functions. This here is not efficient at all AND very bad style
+        // now data has been generated, so copy it. the data of the base
+        // element is computed only once and then copied into the rows of
+        // all copies of the base element, with the rows to read from and to
+        // write to (there is more than one row for non-primitive shape
+        // functions) given by the table set up in initialize()
         const UpdateFlags base_flags = base_fe_data.update_each;
 
         // some base element might involve values that depend on the shape
@@ -1324,63 +1316,32 @@ FESystem<dim, spacedim>::compute_fill(
         // also in case we detected a cell similarity (but no heavy work will
         // be done inside the individual elements in case we have a
         // translation and simple elements).
-        for (unsigned int system_index = 0; system_index < this->dofs_per_cell;
-             ++system_index)
-          if (this->system_to_base_table[system_index].first.first == base_no)
+        for (const std::array<unsigned int, 3> &rows :
+             base_to_system_rows[base_no])
+          for (unsigned int s = 0; s < rows[2]; ++s)
             {
-              const unsigned int base_index =
-                this->system_to_base_table[system_index].second;
-              Assert(base_index < base_fe.dofs_per_cell, ExcInternalError());
-
-              // now copy. if the shape function is primitive, then there
-              // is only one value to be copied, but for non-primitive
-              // elements, there might be more values to be copied
-              //
-              // so, find out from which index to take this one value, and
-              // to which index to put
-              unsigned int out_index = 0;
-              for (unsigned int i = 0; i < system_index; ++i)
-                out_index += this->n_nonzero_components(i);
-              unsigned int in_index = 0;
-              for (unsigned int i = 0; i < base_index; ++i)
-                in_index += base_fe.n_nonzero_components(i);
-
-              // then loop over the number of components to be copied
-              Assert(this->n_nonzero_components(system_index) ==
-                       base_fe.n_nonzero_components(base_index),
-                     ExcInternalError());
+              const unsigned int in_index  = rows[0] + s;
+              const unsigned int out_index = rows[1] + s;
 
               if (base_flags & update_values)
-                for (unsigned int s = 0;
-                     s < this->n_nonzero_components(system_index);
-                     ++s)
-                  for (unsigned int q = 0; q < n_q_points; ++q)
-                    output_data.shape_values[out_index + s][q] =
-                      base_data.shape_values(in_index + s, q);
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  output_data.shape_values(out_index, q) =
+                    base_data.shape_values(in_index, q);
 
               if (base_flags & update_gradients)
-                for (unsigned int s = 0;
-                     s < this->n_nonzero_components(system_index);
-                     ++s)
-                  for (unsigned int q = 0; q < n_q_points; ++q)
-                    output_data.shape_gradients[out_index + s][q] =
-                      base_data.shape_gradients[in_index + s][q];
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  output_data.shape_gradients[out_index][q] =
+                    base_data.shape_gradients[in_index][q];
 
               if (base_flags & update_hessians)
-                for (unsigned int s = 0;
-                     s < this->n_nonzero_components(system_index);
-                     ++s)
-                  for (unsigned int q = 0; q < n_q_points; ++q)
-                    output_data.shape_hessians[out_index + s][q] =
-                      base_data.shape_hessians[in_index + s][q];
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  output_data.shape_hessians[out_index][q] =
+                    base_data.shape_hessians[in_index][q];
 
               if (base_flags & update_3rd_derivatives)
-                for (unsigned int s = 0;
-                     s < this->n_nonzero_components(system_index);
-                     ++s)
-                  for (unsigned int q = 0; q < n_q_points; ++q)
-                    output_data.shape_3rd_derivatives[out_index + s][q] =
-                      base_data.shape_3rd_derivatives[in_index + s][q];
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  output_data.shape_3rd_derivatives[out_index][q] =
+                    base_data.shape_3rd_derivatives[in_index][q];
             }
       }
 }
@@ -1728,6 +1689,44 @@ FESystem<dim, spacedim>::initialize(
         }
     });
 
+  // set up the table that tells compute_fill() which rows of the shape
+  // function arrays of the base elements go where. the rows are numbered
+  // consecutively through all nonzero components of all shape functions
+  init_tasks += Threads::new_task([&]() {
+    base_to_system_rows.clear();
+    base_to_system_rows.resize(this->n_base_elements());
+
+    // the first row of each shape function of each base element
+    std::vector<std::vector<unsigned int>> base_first_rows(
+      this->n_base_elements());
+    for (unsigned int base = 0; base < this->n_base_elements(); ++base)
+      {
+        const FiniteElement<dim, spacedim> &base_fe = base_element(base);
+        base_first_rows[base].resize(base_fe.dofs_per_cell);
+        unsigned int row = 0;
+        for (unsigned int i = 0; i < base_fe.dofs_per_cell; ++i)
+          {
+            base_first_rows[base][i] = row;
+            row += base_fe.n_nonzero_components(i);
+          }
+      }
+
+    unsigned int system_row = 0;
+    for (unsigned int i = 0; i < this->dofs_per_cell; ++i)
+      {
+        const unsigned int base = this->system_to_base_table[i].first.first,
+                           base_index = this->system_to_base_table[i].second;
+        Assert(this->n_nonzero_components(i) ==
+                 base_element(base).n_nonzero_components(base_index),
+               ExcInternalError());
+        base_to_system_rows[base].push_back(
+          {{base_first_rows[base][base_index],
+            system_row,
+            this->n_nonzero_components(i)}});
+        system_row += this->n_nonzero_components(i);
+      }
+  });
+
   // Initialize generalized support points and an (internal) index table
   init_tasks += Threads::new_task([&]() {
     // Iterate over all base elements, extract a representative set of
@@ -2521,6 +2520,7 @@ FESystem<dim, spacedim>::memory_consumption() const
                      sizeof(base_elements));
   for (unsigned int i = 0; i < base_elements.size(); ++i)
     mem += MemoryConsumption::memory_consumption(*base_elements[i].first);
+  mem += MemoryConsumption::memory_consumption(base_to_system_rows);
   return mem;
 }
 
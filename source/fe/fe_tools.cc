@@ -16,8 +16,179 @@
 
 #include <deal.II/fe/fe_tools.templates.h>
 
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+
 DEAL_II_NAMESPACE_OPEN
 
+
+namespace FETools
+{
+  namespace internal
+  {
+    namespace FEToolsMatrixCacheHelper
+    {
+      namespace
+      {
+        // the cache behind compute_embedding_matrices() and friends and the
+        // lock protecting it. these are defined in this file rather than in
+        // fe_tools.templates.h, so that there is only one instance of them
+        std::mutex &
+        get_cache_lock()
+        {
+          static std::mutex cache_lock;
+          return cache_lock;
+        }
+
+        std::map<std::string, std::vector<FullMatrix<double>>> &
+        get_cache()
+        {
+          static std::map<std::string, std::vector<FullMatrix<double>>> cache;
+          return cache;
+        }
+
+        // the first line of the files written by
+        // save_embedding_matrix_cache()
+        std::string
+        get_file_header()
+        {
+          return std::string("deal.II embedding matrix cache, version ") +
+                 DEAL_II_PACKAGE_VERSION;
+        }
+
+        template <typename T>
+        void
+        write_value(std::ostream &out, const T value)
+        {
+          out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        T
+        read_value(std::istream &in)
+        {
+          T value = T();
+          in.read(reinterpret_cast<char *>(&value), sizeof(T));
+          AssertThrow(in, ExcIO());
+          return value;
+        }
+      } // namespace
+
+
+
+      bool
+      get_cached_matrices(const std::string &              key,
+                          std::vector<FullMatrix<double>> &matrices)
+      {
+        std::lock_guard<std::mutex> lock(get_cache_lock());
+        const auto entry = get_cache().find(key);
+        if (entry == get_cache().end())
+          return false;
+        matrices = entry->second;
+        return true;
+      }
+
+
+
+      void
+      store_cached_matrices(const std::string &                    key,
+                            const std::vector<FullMatrix<double>> &matrices)
+      {
+        std::lock_guard<std::mutex> lock(get_cache_lock());
+        get_cache().emplace(key, matrices);
+      }
+    } // namespace FEToolsMatrixCacheHelper
+  }   // namespace internal
+
+
+
+  void
+  clear_embedding_matrix_cache()
+  {
+    using namespace internal::FEToolsMatrixCacheHelper;
+    std::lock_guard<std::mutex> lock(get_cache_lock());
+    get_cache().clear();
+  }
+
+
+
+  void
+  save_embedding_matrix_cache(const std::string &filename)
+  {
+    using namespace internal::FEToolsMatrixCacheHelper;
+
+    std::ofstream out(filename, std::ios::binary);
+    AssertThrow(out, ExcFileNotOpen(filename));
+
+    std::lock_guard<std::mutex> lock(get_cache_lock());
+    out << get_file_header() << '\n';
+    write_value<std::uint64_t>(out, get_cache().size());
+    for (const auto &entry : get_cache())
+      {
+        write_value<std::uint64_t>(out, entry.first.size());
+        out.write(entry.first.data(), entry.first.size());
+        write_value<std::uint64_t>(out, entry.second.size());
+        for (const FullMatrix<double> &matrix : entry.second)
+          {
+            write_value<std::uint64_t>(out, matrix.m());
+            write_value<std::uint64_t>(out, matrix.n());
+            if (!matrix.empty())
+              out.write(reinterpret_cast<const char *>(&matrix(0, 0)),
+                        matrix.m() * matrix.n() * sizeof(double));
+          }
+      }
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  void
+  load_embedding_matrix_cache(const std::string &filename)
+  {
+    using namespace internal::FEToolsMatrixCacheHelper;
+
+    std::ifstream in(filename, std::ios::binary);
+    AssertThrow(in, ExcFileNotOpen(filename));
+
+    std::string header;
+    std::getline(in, header);
+    AssertThrow(header == get_file_header(),
+                ExcMessage("The file <" + filename +
+                           "> is not an embedding matrix cache written by "
+                           "this version of deal.II."));
+
+    // read everything before touching the cache, so that an incomplete
+    // file does not leave partial entries behind
+    std::map<std::string, std::vector<FullMatrix<double>>> entries;
+    const std::uint64_t n_entries = read_value<std::uint64_t>(in);
+    for (std::uint64_t e = 0; e < n_entries; ++e)
+      {
+        std::string key(read_value<std::uint64_t>(in), ' ');
+        in.read(&key[0], key.size());
+        std::vector<FullMatrix<double>> matrices(
+          read_value<std::uint64_t>(in));
+        for (FullMatrix<double> &matrix : matrices)
+          {
+            const std::uint64_t m = read_value<std::uint64_t>(in);
+            const std::uint64_t n = read_value<std::uint64_t>(in);
+            matrix.reinit(m, n);
+            if (!matrix.empty())
+              in.read(reinterpret_cast<char *>(&matrix(0, 0)),
+                      m * n * sizeof(double));
+          }
+        AssertThrow(in, ExcIO());
+        entries.emplace(std::move(key), std::move(matrices));
+      }
+
+    std::lock_guard<std::mutex> lock(get_cache_lock());
+    for (auto &entry : entries)
+      get_cache().insert(std::move(entry));
+  }
+} // namespace FETools
+
+
 /*-------------- Explicit Instantiations -------------------------------*/
 #include "fe_tools.inst"
 
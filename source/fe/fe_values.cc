@@ -46,6 +46,7 @@
 
 #include <boost/container/small_vector.hpp>
 
+#include <cmath>
 #include <iomanip>
 #include <memory>
 #include <type_traits>
@@ -4393,6 +4394,7 @@ FEValues<dim, spacedim>::FEValues(const Mapping<dim, spacedim> &      mapping,
                                 mapping,
                                 fe)
   , quadrature(q)
+  , geometry_cache_max_n_entries(0)
 {
   initialize(update_flags);
 }
@@ -4409,6 +4411,7 @@ FEValues<dim, spacedim>::FEValues(const FiniteElement<dim, spacedim> &fe,
                                 StaticMappingQ1<dim, spacedim>::mapping,
                                 fe)
   , quadrature(q)
+  , geometry_cache_max_n_entries(0)
 {
   initialize(update_flags);
 }
@@ -4555,6 +4558,13 @@ template <int dim, int spacedim>
 void
 FEValues<dim, spacedim>::do_reinit()
 {
+  if (geometry_cache_max_n_entries > 0 &&
+      this->cell_similarity != CellSimilarity::translation)
+    {
+      do_reinit_with_geometry_cache();
+      return;
+    }
+
   // first call the mapping and let it generate the data
   // specific to the mapping. also let it inspect the
   // cell similarity flag and, if necessary, update
@@ -4585,12 +4595,178 @@ FEValues<dim, spacedim>::do_reinit()
 
 
 
+namespace
+{
+  template <int dim, int spacedim>
+  double
+  difference_norm_square(const DerivativeForm<1, dim, spacedim> &a,
+                         const DerivativeForm<1, dim, spacedim> &b)
+  {
+    double result = 0;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      result += (a[d] - b[d]).norm_square();
+    return result;
+  }
+
+  template <int rank, int dim>
+  double
+  difference_norm_square(const Tensor<rank, dim> &a, const Tensor<rank, dim> &b)
+  {
+    return (a - b).norm_square();
+  }
+
+  template <int dim, int spacedim>
+  double
+  norm_square(const DerivativeForm<1, dim, spacedim> &a)
+  {
+    return a.norm() * a.norm();
+  }
+
+  template <int rank, int dim>
+  double
+  norm_square(const Tensor<rank, dim> &a)
+  {
+    return a.norm_square();
+  }
+
+  // Return whether two sets of Jacobians or their derivatives agree up to
+  // roundoff, using the same relative tolerance as
+  // TriaAccessor::is_translation_of()
+  template <typename T>
+  bool
+  geometry_data_agrees(const std::vector<T> &data,
+                       const std::vector<T> &cached_data)
+  {
+    if (data.size() != cached_data.size())
+      return false;
+    for (unsigned int q = 0; q < data.size(); ++q)
+      if (difference_norm_square(data[q], cached_data[q]) >
+          1e-24 * norm_square(cached_data[q]))
+        return false;
+    return true;
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::enable_geometry_cache(const unsigned int max_n_entries)
+{
+  // the cached data must only depend on the Jacobians, which excludes
+  // elements that are evaluated in real space and non-primitive elements
+  // that might need to adjust signs according to the orientation of the cell
+  if (this->fe->is_primitive() == false ||
+      (this->fe->requires_update_flags(update_values | update_gradients) &
+       update_quadrature_points))
+    return;
+
+  // we need the Jacobians to decide whether the cache can be used
+  if ((this->update_flags & update_jacobians) == 0 && max_n_entries > 0)
+    {
+      initialize(this->update_flags | update_jacobians);
+      this->cell_similarity = CellSimilarity::invalid_next_cell;
+    }
+
+  geometry_cache_max_n_entries = max_n_entries;
+  geometry_cache.clear();
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::do_reinit_with_geometry_cache()
+{
+  const typename Triangulation<dim, spacedim>::cell_iterator cell =
+    *this->present_cell;
+
+  // the key consists of the binary exponent of the cell size and the vertex
+  // coordinates relative to the first vertex, rounded to roughly 12 digits
+  // relative to the cell size
+  std::array<Tensor<1, spacedim>, GeometryInfo<dim>::vertices_per_cell>
+         relative_vertices;
+  double max_extent = 0.;
+  for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+    {
+      relative_vertices[v] = cell->vertex(v) - cell->vertex(0);
+      for (unsigned int d = 0; d < spacedim; ++d)
+        max_extent = std::max(max_extent, std::abs(relative_vertices[v][d]));
+    }
+  int exponent = 0;
+  std::frexp(max_extent, &exponent);
+  const double inverse_resolution = std::ldexp(1., 40 - exponent);
+
+  std::vector<std::int64_t> key;
+  key.reserve(1 + (GeometryInfo<dim>::vertices_per_cell - 1) * spacedim);
+  key.push_back(exponent);
+  for (unsigned int v = 1; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      key.push_back(std::llround(relative_vertices[v][d] * inverse_resolution));
+
+  // the mapping is evaluated in full on every cell, which also keeps its
+  // internal data consistent with the present cell
+  this->cell_similarity =
+    this->get_mapping().fill_fe_values(cell,
+                                       CellSimilarity::none,
+                                       quadrature,
+                                       *this->mapping_data,
+                                       this->mapping_output);
+
+  const auto entry = geometry_cache.find(key);
+  if (entry != geometry_cache.end() &&
+      geometry_data_agrees(this->mapping_output.jacobians,
+                           entry->second.jacobians) &&
+      geometry_data_agrees(this->mapping_output.jacobian_pushed_forward_grads,
+                           entry->second.jacobian_pushed_forward_grads) &&
+      geometry_data_agrees(
+        this->mapping_output.jacobian_pushed_forward_2nd_derivatives,
+        entry->second.jacobian_pushed_forward_2nd_derivatives))
+    {
+      this->finite_element_output = entry->second.finite_element_output;
+
+      // the internal data of the finite element still refer to the
+      // previous cell, so the next cell must not rely on them via the
+      // translation check
+      this->cell_similarity = CellSimilarity::invalid_next_cell;
+      return;
+    }
+
+  this->get_fe().fill_fe_values(cell,
+                                this->cell_similarity,
+                                this->quadrature,
+                                this->get_mapping(),
+                                *this->mapping_data,
+                                this->mapping_output,
+                                *this->fe_data,
+                                this->finite_element_output);
+
+  if (entry != geometry_cache.end() ||
+      geometry_cache.size() < geometry_cache_max_n_entries)
+    {
+      GeometryCacheEntry &new_entry = geometry_cache[key];
+      new_entry.jacobians           = this->mapping_output.jacobians;
+      new_entry.jacobian_pushed_forward_grads =
+        this->mapping_output.jacobian_pushed_forward_grads;
+      new_entry.jacobian_pushed_forward_2nd_derivatives =
+        this->mapping_output.jacobian_pushed_forward_2nd_derivatives;
+      new_entry.finite_element_output = this->finite_element_output;
+    }
+}
+
+
+
 template <int dim, int spacedim>
 std::size_t
 FEValues<dim, spacedim>::memory_consumption() const
 {
-  return (FEValuesBase<dim, spacedim>::memory_consumption() +
-          MemoryConsumption::memory_consumption(quadrature));
+  std::size_t memory = FEValuesBase<dim, spacedim>::memory_consumption() +
+                       MemoryConsumption::memory_consumption(quadrature);
+  for (const auto &entry : geometry_cache)
+    memory += MemoryConsumption::memory_consumption(entry.first) +
+              MemoryConsumption::memory_consumption(entry.second.jacobians) +
+              entry.second.finite_element_output.memory_consumption();
+  return memory;
 }
 
 
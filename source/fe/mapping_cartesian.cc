@@ -17,6 +17,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/tensor.h>
 
@@ -116,7 +117,7 @@ MappingCartesian<dim, spacedim>::get_face_data(
 {
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>(
-      QProjector<dim>::project_to_all_faces(quadrature));
+      *QuadratureRegistry::project_to_all_faces<dim>(quadrature));
   auto &data = dynamic_cast<InternalData &>(*data_ptr);
 
   // verify that we have computed the transitive hull of the required
@@ -141,7 +142,7 @@ MappingCartesian<dim, spacedim>::get_subface_data(
 {
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>(
-      QProjector<dim>::project_to_all_subfaces(quadrature));
+      *QuadratureRegistry::project_to_all_subfaces<dim>(quadrature));
   auto &data = dynamic_cast<InternalData &>(*data_ptr);
 
   // verify that we have computed the transitive hull of the required
@@ -627,8 +627,9 @@ MappingFEField<dim, spacedim, VectorType, DoFHandlerType>::get_face_data(
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>(euler_dof_handler->get_fe(), fe_mask);
   auto &                data = dynamic_cast<InternalData &>(*data_ptr);
-  const Quadrature<dim> q(QProjector<dim>::project_to_all_faces(quadrature));
-  this->compute_face_data(update_flags, q, quadrature.size(), data);
+  const std::shared_ptr<const Quadrature<dim>> q =
+    QuadratureRegistry::project_to_all_faces<dim>(quadrature);
+  this->compute_face_data(update_flags, *q, quadrature.size(), data);
 
   return data_ptr;
 }
@@ -643,8 +644,9 @@ MappingFEField<dim, spacedim, VectorType, DoFHandlerType>::get_subface_data(
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>(euler_dof_handler->get_fe(), fe_mask);
   auto &                data = dynamic_cast<InternalData &>(*data_ptr);
-  const Quadrature<dim> q(QProjector<dim>::project_to_all_subfaces(quadrature));
-  this->compute_face_data(update_flags, q, quadrature.size(), data);
+  const std::shared_ptr<const Quadrature<dim>> q =
+    QuadratureRegistry::project_to_all_subfaces<dim>(quadrature);
+  this->compute_face_data(update_flags, *q, quadrature.size(), data);
 
   return data_ptr;
 }
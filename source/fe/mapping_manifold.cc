@@ -288,9 +288,10 @@ MappingManifold<dim, spacedim>::get_face_data(
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>();
   auto &data = dynamic_cast<InternalData &>(*data_ptr);
-  data.initialize_face(this->requires_update_flags(update_flags),
-                       QProjector<dim>::project_to_all_faces(quadrature),
-                       quadrature.size());
+  data.initialize_face(
+    this->requires_update_flags(update_flags),
+    *QuadratureRegistry::project_to_all_faces<dim>(quadrature),
+    quadrature.size());
 
   return data_ptr;
 }
@@ -306,9 +307,10 @@ MappingManifold<dim, spacedim>::get_subface_data(
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>();
   auto &data = dynamic_cast<InternalData &>(*data_ptr);
-  data.initialize_face(this->requires_update_flags(update_flags),
-                       QProjector<dim>::project_to_all_subfaces(quadrature),
-                       quadrature.size());
+  data.initialize_face(
+    this->requires_update_flags(update_flags),
+    *QuadratureRegistry::project_to_all_subfaces<dim>(quadrature),
+    quadrature.size());
 
   return data_ptr;
 }
@@ -14,10 +14,22 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/quadrature.h>
 #include <deal.II/base/work_stream.h>
 
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q_cache.h>
 
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
 #include <functional>
 
 DEAL_II_NAMESPACE_OPEN
@@ -35,6 +47,7 @@ MappingQCache<dim, spacedim>::MappingQCache(
   const MappingQCache<dim, spacedim> &mapping)
   : MappingQGeneric<dim, spacedim>(mapping)
   , support_point_cache(mapping.support_point_cache)
+  , reference_support_point_cache(mapping.reference_support_point_cache)
 {}
 
 
@@ -47,6 +60,7 @@ MappingQCache<dim, spacedim>::~MappingQCache()
   // invalid memory that has been left back by freeing an object of this
   // class.
   support_point_cache.reset();
+  reference_support_point_cache.reset();
   clear_signal.disconnect();
 }
 
@@ -95,26 +109,36 @@ MappingQCache<dim, spacedim>::initialize(
     &compute_points_on_cell)
 {
   clear_signal.disconnect();
-  clear_signal = triangulation.signals.any_change.connect(
-    [&]() -> void { this->support_point_cache.reset(); });
+  clear_signal = triangulation.signals.any_change.connect([&]() -> void {
+    this->support_point_cache.reset();
+    this->reference_support_point_cache.reset();
+  });
 
+  const unsigned int n_points = n_support_points();
   support_point_cache =
-    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
+    std::make_shared<std::vector<std::vector<Point<spacedim>>>>(
       triangulation.n_levels());
   for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
-    (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
-
+    (*support_point_cache)[l].resize(
+      static_cast<std::size_t>(triangulation.n_raw_cells(l)) * n_points);
+  reference_support_point_cache.reset();
+
+  // the evaluation of the points on a cell can be expensive (e.g. for
+  // transfinite interpolation on high degrees), so distribute the cells over
+  // the threads one at a time; the results are written directly into the
+  // slots of the respective cells, so no copier is needed
   WorkStream::run(
     triangulation.begin(),
     triangulation.end(),
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
         void *,
         void *) {
-      (*support_point_cache)[cell->level()][cell->index()] =
-        compute_points_on_cell(cell);
-      AssertDimension(
-        (*support_point_cache)[cell->level()][cell->index()].size(),
-        Utilities::pow(this->get_degree() + 1, dim));
+      const std::vector<Point<spacedim>> points = compute_points_on_cell(cell);
+      AssertDimension(points.size(), n_points);
+      std::copy(points.begin(),
+                points.end(),
+                (*support_point_cache)[cell->level()].begin() +
+                  static_cast<std::size_t>(cell->index()) * n_points);
     },
     /* copier */ std::function<void(void *)>(),
     /* scratch_data */ nullptr,
@@ -125,15 +149,122 @@ MappingQCache<dim, spacedim>::initialize(
 
 
 
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::update_with_displacement(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const VectorType &               displacement)
+{
+  Assert(support_point_cache.get() != nullptr,
+         ExcMessage("Must call MappingQCache::initialize() before "
+                    "using it or after mesh has changed!"));
+  Assert(support_point_cache->size() ==
+           dof_handler.get_triangulation().n_levels(),
+         ExcMessage("The DoFHandler must be based on the triangulation "
+                    "this object was initialized with."));
+  Assert(dof_handler.get_fe().n_components() >= spacedim,
+         ExcMessage("The finite element must have at least spacedim "
+                    "components to describe a displacement."));
+
+  // keep the points of initialize() as the reference configuration
+  if (reference_support_point_cache.get() == nullptr)
+    reference_support_point_cache = support_point_cache;
+
+  // other instances created by clone() may share the cache: in that case,
+  // give this object its own copy rather than moving the mesh of the others
+  if (support_point_cache == reference_support_point_cache ||
+      support_point_cache.use_count() > 1)
+    support_point_cache =
+      std::make_shared<std::vector<std::vector<Point<spacedim>>>>(
+        *reference_support_point_cache);
+
+  // the support points of the mapping are the support points of FE_Q with
+  // Gauss-Lobatto points in the same (hierarchical) order, so evaluating
+  // the displacement in these points on the unit cell gives the displacement
+  // of the cached points; no geometry information is needed to evaluate
+  // the values of shape functions, so a linear mapping suffices
+  const unsigned int n_points = n_support_points();
+  const Quadrature<dim> quadrature(
+    FE_Q<dim, spacedim>(QGaussLobatto<1>(this->get_degree() + 1))
+      .get_unit_support_points());
+  const MappingQGeneric<dim, spacedim> mapping_q1(1);
+  const FEValues<dim, spacedim>        fe_values_template(mapping_q1,
+                                                   dof_handler.get_fe(),
+                                                   quadrature,
+                                                   update_values);
+
+  using DisplacementType =
+    typename ProductType<Tensor<1, spacedim>,
+                         typename VectorType::value_type>::type;
+
+  struct Scratch
+  {
+    Scratch(const FEValues<dim, spacedim> &fe_values_template)
+      : fe_values(fe_values_template.get_mapping(),
+                  fe_values_template.get_fe(),
+                  fe_values_template.get_quadrature(),
+                  fe_values_template.get_update_flags())
+      , displacements(fe_values_template.n_quadrature_points)
+    {}
+
+    Scratch(const Scratch &scratch)
+      : Scratch(scratch.fe_values)
+    {}
+
+    FEValues<dim, spacedim>       fe_values;
+    std::vector<DisplacementType> displacements;
+  };
+
+  const FEValuesExtractors::Vector displacement_components(0);
+  WorkStream::run(
+    dof_handler.begin_active(),
+    dof_handler.end(),
+    [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+        Scratch &scratch,
+        void *) {
+      scratch.fe_values.reinit(cell);
+      scratch.fe_values[displacement_components].get_function_values(
+        displacement, scratch.displacements);
+
+      const std::size_t offset =
+        static_cast<std::size_t>(cell->index()) * n_points;
+      const Point<spacedim> *reference_points =
+        (*reference_support_point_cache)[cell->level()].data() + offset;
+      Point<spacedim> *points =
+        (*support_point_cache)[cell->level()].data() + offset;
+      for (unsigned int q = 0; q < n_points; ++q)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          points[q][d] = reference_points[q][d] + scratch.displacements[q][d];
+    },
+    /* copier */ std::function<void(void *)>(),
+    Scratch(fe_values_template),
+    /* copy_data */ nullptr);
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+MappingQCache<dim, spacedim>::n_support_points() const
+{
+  return Utilities::pow(this->get_degree() + 1, dim);
+}
+
+
+
 template <int dim, int spacedim>
 std::size_t
 MappingQCache<dim, spacedim>::memory_consumption() const
 {
+  std::size_t memory = sizeof(*this);
   if (support_point_cache.get() != nullptr)
-    return sizeof(*this) +
-           MemoryConsumption::memory_consumption(*support_point_cache);
-  else
-    return sizeof(*this);
+    memory += MemoryConsumption::memory_consumption(*support_point_cache);
+  if (reference_support_point_cache.get() != nullptr &&
+      reference_support_point_cache != support_point_cache)
+    memory +=
+      MemoryConsumption::memory_consumption(*reference_support_point_cache);
+  return memory;
 }
 
 
@@ -148,8 +279,12 @@ MappingQCache<dim, spacedim>::compute_mapping_support_points(
                     "using it or after mesh has changed!"));
 
   AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  return (*support_point_cache)[cell->level()][cell->index()];
+  const unsigned int n_points = n_support_points();
+  const std::size_t offset =
+    static_cast<std::size_t>(cell->index()) * n_points;
+  AssertIndexRange(offset, (*support_point_cache)[cell->level()].size());
+  const auto begin = (*support_point_cache)[cell->level()].begin() + offset;
+  return std::vector<Point<spacedim>>(begin, begin + n_points);
 }
 
 
@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -650,6 +651,13 @@ MappingQGeneric<dim, spacedim>::InternalData::memory_consumption() const
     MemoryConsumption::memory_consumption(mapping_support_points) +
     MemoryConsumption::memory_consumption(cell_of_current_support_points) +
     MemoryConsumption::memory_consumption(volume_elements) +
+    MemoryConsumption::memory_consumption(face_shape_values_1d) +
+    MemoryConsumption::memory_consumption(face_shape_derivatives_1d) +
+    MemoryConsumption::memory_consumption(end_point_shape_values_1d) +
+    MemoryConsumption::memory_consumption(end_point_shape_derivatives_1d) +
+    MemoryConsumption::memory_consumption(face_tensor_quadrature_numbering) +
+    MemoryConsumption::memory_consumption(face_lexicographic_numbering) +
+    MemoryConsumption::memory_consumption(face_scratch) +
     MemoryConsumption::memory_consumption(polynomial_degree) +
     MemoryConsumption::memory_consumption(n_shape_functions));
 }
@@ -794,19 +802,6 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize_face(
 {
   initialize(update_flags, q, n_original_q_points);
 
-  if (dim > 1 && tensor_product_quadrature)
-    {
-      constexpr unsigned int facedim = dim - 1;
-      const FE_DGQ<1>        fe(polynomial_degree);
-      shape_info.reinit(q.get_tensor_basis()[0], fe);
-      shape_info.lexicographic_numbering =
-        FETools::lexicographic_to_hierarchic_numbering<facedim>(
-          polynomial_degree);
-      shape_info.n_q_points = n_original_q_points;
-      shape_info.dofs_per_component_on_cell =
-        Utilities::pow(polynomial_degree + 1, dim);
-    }
-
   if (dim > 1)
     {
       if (this->update_each &
@@ -841,6 +836,117 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize_face(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::InternalData::initialize_face_tensor_product(
+  const Quadrature<dim - 1> &quadrature,
+  const Quadrature<dim> &    all_faces_quadrature)
+{
+  face_shape_values_1d.clear();
+  face_shape_derivatives_1d.clear();
+  end_point_shape_values_1d.clear();
+  end_point_shape_derivatives_1d.clear();
+  face_tensor_quadrature_numbering.clear();
+  face_lexicographic_numbering.clear();
+
+  // as on cells, only use sum factorization for higher order mappings and
+  // more than one point; derivatives of the Jacobian are not supported by
+  // the face kernel
+  if (dim == 1 || polynomial_degree < 2 || quadrature.size() == 1 ||
+      !quadrature.is_tensor_product() ||
+      (this->update_each &
+       (update_jacobian_grads | update_jacobian_pushed_forward_grads |
+        update_jacobian_2nd_derivatives |
+        update_jacobian_pushed_forward_2nd_derivatives |
+        update_jacobian_3rd_derivatives |
+        update_jacobian_pushed_forward_3rd_derivatives)))
+    return;
+
+  const Quadrature<1> quadrature_1d = quadrature.get_tensor_basis()[0];
+  const unsigned int  n_q_points_1d = quadrature_1d.size();
+  const unsigned int  n_q_points    = quadrature.size();
+  if (Utilities::pow(n_q_points_1d, dim - 1) != n_q_points ||
+      all_faces_quadrature.size() % n_q_points != 0)
+    return;
+
+  // find the position of each point of the projected quadrature formula in
+  // the tensor-product grid on its face. the data sets are ordered by faces
+  // first (see QProjector::DataSetDescriptor::face()). if the points of some
+  // face orientation do not coincide with the grid points, e.g. in case of a
+  // non-symmetric one-dimensional formula, we cannot use the tensor product
+  const auto find_index_1d = [&](const double x) {
+    for (unsigned int i = 0; i < n_q_points_1d; ++i)
+      if (std::abs(quadrature_1d.point(i)[0] - x) < 1e-12)
+        return i;
+    return numbers::invalid_unsigned_int;
+  };
+  std::vector<unsigned int> numbering(all_faces_quadrature.size(),
+                                      numbers::invalid_unsigned_int);
+  for (unsigned int data_set = 0; data_set < all_faces_quadrature.size();
+       data_set += n_q_points)
+    {
+      const unsigned int face_no =
+        (data_set / n_q_points) % GeometryInfo<dim>::faces_per_cell;
+      const unsigned int normal =
+        GeometryInfo<dim>::unit_normal_direction[face_no];
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          const Point<dim> &p = all_faces_quadrature.point(data_set + q);
+          if (std::abs(p[normal] - (face_no % 2)) > 1e-12)
+            return;
+
+          unsigned int index = 0, stride = 1;
+          for (unsigned int d = 0; d < dim; ++d)
+            if (d != normal)
+              {
+                const unsigned int index_1d = find_index_1d(p[d]);
+                if (index_1d == numbers::invalid_unsigned_int)
+                  return;
+                index += index_1d * stride;
+                stride *= n_q_points_1d;
+              }
+          if (numbering[data_set + index] != numbers::invalid_unsigned_int)
+            return;
+          numbering[data_set + index] = q;
+        }
+    }
+  face_tensor_quadrature_numbering.swap(numbering);
+
+  // the one-dimensional shape functions are the Lagrange polynomials in the
+  // line support points, as in compute_shape_function_values()
+  const std::vector<Polynomials::Polynomial<double>> polynomials =
+    Polynomials::generate_complete_Lagrange_basis(
+      line_support_points.get_points());
+  const unsigned int n_shapes_1d = polynomials.size();
+  AssertDimension(n_shapes_1d, polynomial_degree + 1);
+
+  face_shape_values_1d.resize(n_q_points_1d * n_shapes_1d);
+  face_shape_derivatives_1d.resize(n_q_points_1d * n_shapes_1d);
+  end_point_shape_values_1d.resize(2 * n_shapes_1d);
+  end_point_shape_derivatives_1d.resize(2 * n_shapes_1d);
+  std::vector<double> values(2);
+  for (unsigned int i = 0; i < n_shapes_1d; ++i)
+    {
+      for (unsigned int q = 0; q < n_q_points_1d; ++q)
+        {
+          polynomials[i].value(quadrature_1d.point(q)[0], values);
+          face_shape_values_1d[q * n_shapes_1d + i]      = values[0];
+          face_shape_derivatives_1d[q * n_shapes_1d + i] = values[1];
+        }
+      for (unsigned int side = 0; side < 2; ++side)
+        {
+          polynomials[i].value(side, values);
+          end_point_shape_values_1d[side * n_shapes_1d + i]      = values[0];
+          end_point_shape_derivatives_1d[side * n_shapes_1d + i] = values[1];
+        }
+    }
+
+  face_lexicographic_numbering =
+    FETools::lexicographic_to_hierarchic_numbering<dim>(polynomial_degree);
+}
+
+
+
 template <>
 void
 MappingQGeneric<1, 1>::InternalData::compute_shape_function_values(
@@ -1631,6 +1737,192 @@ namespace internal
       }
 
 
+      /**
+       * In case the face quadrature formula is a tensor product, this is a
+       * replacement for maybe_compute_q_points() and maybe_update_Jacobians()
+       * on faces. The mapping is first interpolated to the face, computing
+       * its values and its derivative in normal direction in the support
+       * points on the face, and these are then evaluated in the quadrature
+       * points of the face with sum factorization.
+       */
+      template <int dim, int spacedim>
+      void
+      maybe_update_face_q_points_and_Jacobians_tensor(
+        const unsigned int                                        face_no,
+        const typename dealii::QProjector<dim>::DataSetDescriptor data_set,
+        const typename dealii::MappingQGeneric<dim, spacedim>::InternalData
+          &                           data,
+        std::vector<Point<spacedim>> &quadrature_points)
+      {
+        const UpdateFlags update_flags = data.update_each;
+
+        const bool evaluate_values = update_flags & update_quadrature_points;
+        const bool evaluate_gradients =
+          update_flags & update_contravariant_transformation;
+        if (!evaluate_values && !evaluate_gradients)
+          return;
+
+        const unsigned int n_shapes_1d = data.polynomial_degree + 1;
+        const unsigned int n_q_points_1d =
+          data.face_shape_values_1d.size() / n_shapes_1d;
+        const unsigned int n_face_shapes =
+          Utilities::pow(n_shapes_1d, dim - 1);
+        const unsigned int n_q_points = Utilities::pow(n_q_points_1d, dim - 1);
+
+        Assert(!evaluate_values || n_q_points == quadrature_points.size(),
+               ExcDimensionMismatch(n_q_points, quadrature_points.size()));
+        Assert(!evaluate_gradients || n_q_points == data.contravariant.size(),
+               ExcDimensionMismatch(n_q_points, data.contravariant.size()));
+
+        // the coordinate directions normal and tangential to the face, the
+        // latter in increasing order (only the first one is used in 2d)
+        const unsigned int normal =
+          GeometryInfo<dim>::unit_normal_direction[face_no];
+        const unsigned int first_tangential  = (normal == 0 ? 1 : 0);
+        const unsigned int second_tangential = (normal == 2 ? 1 : 2);
+
+        const double *values_1d      = data.face_shape_values_1d.data();
+        const double *derivatives_1d = data.face_shape_derivatives_1d.data();
+        const double *end_point_values =
+          data.end_point_shape_values_1d.data() + (face_no % 2) * n_shapes_1d;
+        const double *end_point_derivatives =
+          data.end_point_shape_derivatives_1d.data() +
+          (face_no % 2) * n_shapes_1d;
+
+        // the first two slots of the scratch array hold the values and
+        // normal derivatives of the mapping in the tensor-product grid of
+        // support points on the face, the other three the intermediate
+        // results of the evaluation in the first tangential direction in 3d
+        data.face_scratch.resize(2 * n_face_shapes +
+                                 3 * n_shapes_1d * n_q_points_1d);
+        Tensor<1, spacedim> *face_values = data.face_scratch.data();
+        Tensor<1, spacedim> *face_normal_derivatives =
+          face_values + n_face_shapes;
+        std::fill(face_values,
+                  face_values + 2 * n_face_shapes,
+                  Tensor<1, spacedim>());
+
+        // interpolate to the face by going through the support points in
+        // lexicographic order and splitting the index into the index in
+        // normal direction and the remaining index on the face
+        const unsigned int stride_normal = Utilities::pow(n_shapes_1d, normal);
+        for (unsigned int i = 0; i < data.n_shape_functions; ++i)
+          {
+            const unsigned int i_normal = (i / stride_normal) % n_shapes_1d;
+            const unsigned int i_face =
+              i % stride_normal +
+              (i / (stride_normal * n_shapes_1d)) * stride_normal;
+            const Point<spacedim> &point =
+              data.mapping_support_points[data.face_lexicographic_numbering[i]];
+            face_values[i_face] += end_point_values[i_normal] * point;
+            face_normal_derivatives[i_face] +=
+              end_point_derivatives[i_normal] * point;
+          }
+
+        // write the result in the position q of the tensor-product grid on
+        // the face into the respective point of the face quadrature formula
+        const auto store = [&](const unsigned int          q,
+                               const Tensor<1, spacedim> & value,
+                               const Tensor<1, spacedim> *jacobian_columns) {
+          const unsigned int point =
+            data.face_tensor_quadrature_numbering[data_set + q];
+          if (evaluate_values)
+            quadrature_points[point] = Point<spacedim>(value);
+          if (evaluate_gradients)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                data.contravariant[point][d][e] = jacobian_columns[e][d];
+        };
+
+        Tensor<1, spacedim> jacobian_columns[dim];
+        if (dim == 2)
+          {
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              {
+                Tensor<1, spacedim> value, tangential_derivative,
+                  normal_derivative;
+                for (unsigned int j = 0; j < n_shapes_1d; ++j)
+                  {
+                    const double shape_value = values_1d[q * n_shapes_1d + j];
+                    value += shape_value * face_values[j];
+                    tangential_derivative +=
+                      derivatives_1d[q * n_shapes_1d + j] * face_values[j];
+                    normal_derivative +=
+                      shape_value * face_normal_derivatives[j];
+                  }
+                jacobian_columns[first_tangential] = tangential_derivative;
+                jacobian_columns[normal]           = normal_derivative;
+                store(q, value, jacobian_columns);
+              }
+          }
+        else
+          {
+            // evaluate in the first tangential direction, keeping the
+            // support point index in the second direction
+            const unsigned int   n_intermediate = n_shapes_1d * n_q_points_1d;
+            Tensor<1, spacedim> *tmp_values =
+              face_normal_derivatives + n_face_shapes;
+            Tensor<1, spacedim> *tmp_derivatives = tmp_values + n_intermediate;
+            Tensor<1, spacedim> *tmp_normal_derivatives =
+              tmp_derivatives + n_intermediate;
+            for (unsigned int j1 = 0; j1 < n_shapes_1d; ++j1)
+              for (unsigned int q0 = 0; q0 < n_q_points_1d; ++q0)
+                {
+                  Tensor<1, spacedim> value, derivative, normal_derivative;
+                  for (unsigned int j0 = 0; j0 < n_shapes_1d; ++j0)
+                    {
+                      const double shape_value =
+                        values_1d[q0 * n_shapes_1d + j0];
+                      const unsigned int j = j1 * n_shapes_1d + j0;
+                      value += shape_value * face_values[j];
+                      derivative +=
+                        derivatives_1d[q0 * n_shapes_1d + j0] * face_values[j];
+                      normal_derivative +=
+                        shape_value * face_normal_derivatives[j];
+                    }
+                  tmp_values[j1 * n_q_points_1d + q0]             = value;
+                  tmp_derivatives[j1 * n_q_points_1d + q0]        = derivative;
+                  tmp_normal_derivatives[j1 * n_q_points_1d + q0] =
+                    normal_derivative;
+                }
+
+            // then in the second tangential direction
+            for (unsigned int q1 = 0; q1 < n_q_points_1d; ++q1)
+              for (unsigned int q0 = 0; q0 < n_q_points_1d; ++q0)
+                {
+                  Tensor<1, spacedim> value, first_derivative,
+                    second_derivative, normal_derivative;
+                  for (unsigned int j1 = 0; j1 < n_shapes_1d; ++j1)
+                    {
+                      const double shape_value =
+                        values_1d[q1 * n_shapes_1d + j1];
+                      const unsigned int j = j1 * n_q_points_1d + q0;
+                      value += shape_value * tmp_values[j];
+                      first_derivative += shape_value * tmp_derivatives[j];
+                      second_derivative +=
+                        derivatives_1d[q1 * n_shapes_1d + j1] * tmp_values[j];
+                      normal_derivative +=
+                        shape_value * tmp_normal_derivatives[j];
+                    }
+                  jacobian_columns[first_tangential]  = first_derivative;
+                  jacobian_columns[second_tangential] = second_derivative;
+                  jacobian_columns[normal]            = normal_derivative;
+                  store(q1 * n_q_points_1d + q0, value, jacobian_columns);
+                }
+          }
+
+        if (update_flags & update_covariant_transformation)
+          for (unsigned int point = 0; point < n_q_points; ++point)
+            data.covariant[point] = data.contravariant[point].covariant_form();
+
+        if (update_flags & update_volume_elements)
+          for (unsigned int point = 0; point < n_q_points; ++point)
+            data.volume_elements[point] =
+              data.contravariant[point].determinant();
+      }
+
+
+
       /**
        * Compute the locations of quadrature points on the object described by
        * the first argument (and the cell for which the mapping support points
@@ -2223,6 +2515,11 @@ MappingQGeneric<dim, spacedim>::MappingQGeneric(const unsigned int p)
   , support_point_weights_cell(
       internal::MappingQGenericImplementation::
         compute_support_point_weights_cell<dim>(this->polynomial_degree))
+  , polynomials_1d(Polynomials::generate_complete_Lagrange_basis(
+      line_support_points.get_points()))
+  , renumber_lexicographic_to_hierarchic(
+      FETools::lexicographic_to_hierarchic_numbering<dim>(
+        this->polynomial_degree))
 {
   Assert(p >= 1,
          ExcMessage("It only makes sense to create polynomial mappings "
@@ -2239,6 +2536,9 @@ MappingQGeneric<dim, spacedim>::MappingQGeneric(
   , support_point_weights_perimeter_to_interior(
       mapping.support_point_weights_perimeter_to_interior)
   , support_point_weights_cell(mapping.support_point_weights_cell)
+  , polynomials_1d(mapping.polynomials_1d)
+  , renumber_lexicographic_to_hierarchic(
+      mapping.renumber_lexicographic_to_hierarchic)
 {}
 
 
@@ -2611,6 +2911,195 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  // the batched algorithm below is only written for dim==spacedim, so let
+  // the base class treat the points one by one in the codimension-one case
+  if (dim != spacedim)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  AssertDimension(real_points.size(), unit_points.size());
+  const unsigned int n_points = real_points.size();
+  if (n_points == 0)
+    return;
+
+  const std::vector<Point<spacedim>> support_points =
+    this->compute_mapping_support_points(cell);
+
+  // compute the affine approximation x = center + A (xi - 1/2) of the
+  // d-linear map described by the vertices of the cell, i.e., the first
+  // 2^dim mapping support points. all quantities below only involve the
+  // first dim components of the points, which is all there is for
+  // dim==spacedim
+  Tensor<2, dim>   A;
+  Tensor<1, dim>   center;
+  constexpr double vertex_weight = 1. / GeometryInfo<dim>::vertices_per_cell;
+  for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        center[d] += vertex_weight * support_points[v][d];
+        for (unsigned int e = 0; e < dim; ++e)
+          A[d][e] += ((v & (1U << e)) ? 2. : -2.) * vertex_weight *
+                     support_points[v][d];
+      }
+
+  // inverted or degenerate cells are left to the robust algorithm for
+  // single points
+  if (!(determinant(A) > 0))
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+  const Tensor<2, dim> A_inverse = invert(A);
+
+  // check whether the mapping is affine on this cell by comparing all
+  // support points with their image under the affine approximation
+  double scale = 0;
+  for (unsigned int e = 0; e < dim; ++e)
+    for (unsigned int d = 0; d < dim; ++d)
+      scale += A[d][e] * A[d][e];
+  const std::vector<Point<1>> &line_points = line_support_points.get_points();
+  const unsigned int           n_1d        = line_points.size();
+  bool                         is_affine   = true;
+  for (unsigned int i = 0; i < support_points.size() && is_affine; ++i)
+    {
+      Tensor<1, dim> unit_shift;
+      for (unsigned int e = 0, stride = 1; e < dim; ++e, stride *= n_1d)
+        unit_shift[e] = line_points[(i / stride) % n_1d][0] - 0.5;
+      const Tensor<1, dim> affine_point = center + A * unit_shift;
+      const Point<spacedim> &support_point =
+        support_points[renumber_lexicographic_to_hierarchic[i]];
+      double distance_square = 0;
+      for (unsigned int d = 0; d < dim; ++d)
+        distance_square += Utilities::fixed_power<2>(support_point[d] -
+                                                     affine_point[d]);
+      if (distance_square > 1e-24 * scale)
+        is_affine = false;
+    }
+
+  if (is_affine)
+    {
+      for (unsigned int i = 0; i < n_points; ++i)
+        {
+          Tensor<1, dim> shift;
+          for (unsigned int d = 0; d < dim; ++d)
+            shift[d] = real_points[i][d] - center[d];
+          const Tensor<1, dim> unit_shift = A_inverse * shift;
+          for (unsigned int d = 0; d < dim; ++d)
+            unit_points[i][d] = 0.5 + unit_shift[d];
+        }
+      return;
+    }
+
+  // run the Newton iteration on a batch of points at once, starting from
+  // the affine approximation projected into the reference cell. lanes that
+  // do not converge, e.g. because the point is far outside the cell and the
+  // Jacobian becomes singular along the way, are handed to the point-wise
+  // algorithm with line search afterwards
+  using VectorizedDouble             = VectorizedArray<double>;
+  constexpr unsigned int n_lanes     = VectorizedDouble::size();
+  const double           eps         = 1.e-11;
+  const unsigned int     max_n_iters = 20;
+  for (unsigned int i = 0; i < n_points; i += n_lanes)
+    {
+      const unsigned int n_active = std::min(n_lanes, n_points - i);
+
+      // gather a batch of points, filling the unused lanes with the last
+      // point
+      Tensor<1, dim, VectorizedDouble> p_real;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        for (unsigned int d = 0; d < dim; ++d)
+          p_real[d][v] = real_points[i + std::min(v, n_active - 1)][d];
+
+      Point<dim, VectorizedDouble> p_unit;
+      {
+        Tensor<1, dim, VectorizedDouble> shift = p_real;
+        for (unsigned int d = 0; d < dim; ++d)
+          shift[d] -= center[d];
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            VectorizedDouble xi = 0.5;
+            for (unsigned int e = 0; e < dim; ++e)
+              xi += A_inverse[d][e] * shift[e];
+            p_unit[d] = std::min(std::max(xi, VectorizedDouble(0.)),
+                                 VectorizedDouble(1.));
+          }
+      }
+
+      std::array<bool, n_lanes> converged;
+      std::fill(converged.begin(), converged.end(), false);
+      for (unsigned int iteration = 0; iteration < max_n_iters; ++iteration)
+        {
+          const auto result =
+            internal::evaluate_tensor_product_value_and_gradient(
+              polynomials_1d,
+              support_points,
+              p_unit,
+              renumber_lexicographic_to_hierarchic);
+
+          Tensor<1, dim, VectorizedDouble> f;
+          Tensor<2, dim, VectorizedDouble> jacobian;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              f[d] = result.first[d] - p_real[d];
+              for (unsigned int e = 0; e < dim; ++e)
+                jacobian[d][e] = result.second[e][d];
+            }
+
+          const VectorizedDouble det = determinant(jacobian);
+          const Tensor<1, dim, VectorizedDouble> delta = invert(jacobian) * f;
+          const VectorizedDouble delta_norm_square     = delta.norm_square();
+
+          bool all_converged = true;
+          for (unsigned int v = 0; v < n_active; ++v)
+            {
+              // once a lane has converged, further updates only polish the
+              // solution, so we can keep iterating with the other lanes
+              if (det[v] > 0 && delta_norm_square[v] < eps * eps)
+                converged[v] = true;
+              all_converged = all_converged && converged[v];
+            }
+
+          p_unit -= delta;
+
+          if (all_converged)
+            break;
+        }
+
+      for (unsigned int v = 0; v < n_active; ++v)
+        if (converged[v])
+          for (unsigned int d = 0; d < dim; ++d)
+            unit_points[i + v][d] = p_unit[d][v];
+        else
+          {
+            try
+              {
+                unit_points[i + v] =
+                  this->transform_real_to_unit_cell(cell, real_points[i + v]);
+              }
+            catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+              {
+                unit_points[i + v]    = Point<dim>();
+                unit_points[i + v][0] = std::numeric_limits<double>::infinity();
+              }
+          }
+    }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
@@ -2692,9 +3181,12 @@ MappingQGeneric<dim, spacedim>::get_face_data(
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>(polynomial_degree);
   auto &data = dynamic_cast<InternalData &>(*data_ptr);
+  const std::shared_ptr<const Quadrature<dim>> all_faces_quadrature =
+    QuadratureRegistry::project_to_all_faces<dim>(quadrature);
   data.initialize_face(this->requires_update_flags(update_flags),
-                       QProjector<dim>::project_to_all_faces(quadrature),
+                       *all_faces_quadrature,
                        quadrature.size());
+  data.initialize_face_tensor_product(quadrature, *all_faces_quadrature);
 
   return data_ptr;
 }
@@ -2710,9 +3202,10 @@ MappingQGeneric<dim, spacedim>::get_subface_data(
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> data_ptr =
     std::make_unique<InternalData>(polynomial_degree);
   auto &data = dynamic_cast<InternalData &>(*data_ptr);
-  data.initialize_face(this->requires_update_flags(update_flags),
-                       QProjector<dim>::project_to_all_subfaces(quadrature),
-                       quadrature.size());
+  data.initialize_face(
+    this->requires_update_flags(update_flags),
+    *QuadratureRegistry::project_to_all_subfaces<dim>(quadrature),
+    quadrature.size());
 
   return data_ptr;
 }
@@ -3141,13 +3634,11 @@ namespace internal
         internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
           &output_data)
       {
-        if (dim > 1 && data.tensor_product_quadrature)
+        if (dim > 1 && subface_no == numbers::invalid_unsigned_int &&
+            !data.face_tensor_quadrature_numbering.empty())
           {
-            maybe_update_q_points_Jacobians_and_grads_tensor<dim, spacedim>(
-              CellSimilarity::none,
-              data,
-              output_data.quadrature_points,
-              output_data.jacobian_grads);
+            maybe_update_face_q_points_and_Jacobians_tensor<dim, spacedim>(
+              face_no, data_set, data, output_data.quadrature_points);
           }
         else
           {
@@ -34,6 +34,7 @@
 #include <fstream>
 #include <functional>
 #include <map>
+#include <unordered_map>
 
 #ifdef DEAL_II_WITH_ASSIMP
 #  include <assimp/Importer.hpp>  // C++ importer interface
@@ -87,6 +88,28 @@ namespace
     // vertices except in 1d
     Assert(dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * Read a value from a %Gmsh file. In the ASCII variant of the format, the
+   * value is read with the usual stream operator. In the binary variant, it
+   * is read as the raw bytes of an object of type @p BinaryType, which is
+   * how the binary files of version 4.1 of the format store it.
+   */
+  template <typename BinaryType, typename T>
+  void
+  read_gmsh_value(std::istream &in, const bool binary, T &value)
+  {
+    if (binary)
+      {
+        BinaryType binary_value;
+        in.read(reinterpret_cast<char *>(&binary_value), sizeof(BinaryType));
+        value = static_cast<T>(binary_value);
+      }
+    else
+      in >> value;
+  }
 } // namespace
 
 template <int dim, int spacedim>
@@ -1432,6 +1455,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   // points, curves, surfaces and volumes. We use this information later to
   // assign boundary ids.
   std::array<std::map<int, int>, 4> tag_maps;
+  // whether the sections of the file are stored in binary form
+  bool binary = false;
 
   in >> line;
 
@@ -1456,8 +1481,27 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       Assert((version >= 2.0) && (version <= 4.1), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version * 10);
 
-      Assert(file_type == 0, ExcNotImplemented());
-      Assert(data_size == sizeof(double), ExcNotImplemented());
+      // binary files are only supported for the latest version of the
+      // format, in which they are written with the sizes of the data types
+      // of the machine that wrote them, i.e., we can only read files that
+      // have been written on machines of the same type
+      AssertThrow(file_type == 0 || (file_type == 1 && gmsh_file_format == 41),
+                  ExcNotImplemented());
+      AssertThrow(data_size == sizeof(double), ExcNotImplemented());
+      binary = (file_type == 1);
+
+      if (binary)
+        {
+          // the header is followed by the integer one, which allows to
+          // detect a different endianness
+          in.get();
+          int one = 0;
+          read_gmsh_value<int>(in, binary, one);
+          AssertThrow(one == 1,
+                      ExcMessage("The binary gmsh file has been written with "
+                                 "a different endianness, which is not "
+                                 "supported."));
+        }
 
       // read the end of the header and the first line of the nodes description
       // to synch ourselves with the format 1 handling above
@@ -1479,116 +1523,62 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // if the next block is of kind $Entities, parse it
       if (line == "$Entities")
         {
+          if (binary)
+            in.get();
+
           unsigned long n_points, n_curves, n_surfaces, n_volumes;
 
-          in >> n_points >> n_curves >> n_surfaces >> n_volumes;
+          read_gmsh_value<std::size_t>(in, binary, n_points);
+          read_gmsh_value<std::size_t>(in, binary, n_curves);
+          read_gmsh_value<std::size_t>(in, binary, n_surfaces);
+          read_gmsh_value<std::size_t>(in, binary, n_volumes);
+
+          // read the tag, the bounding box, and the physical tag of an entity
+          // of dimension 'entity_dim' and store the latter in tag_maps
+          const auto read_entity = [&](const unsigned int entity_dim) {
+            int          tag;
+            unsigned int n_physicals;
+            double       box[6];
+
+            // we only care for 'tag' as key for tag_maps[entity_dim]. points
+            // only store their coordinates instead of a bounding box in
+            // version 4.1
+            read_gmsh_value<int>(in, binary, tag);
+            const unsigned int n_box_entries =
+              (entity_dim == 0 && gmsh_file_format > 40) ? 3 : 6;
+            for (unsigned int d = 0; d < n_box_entries; ++d)
+              read_gmsh_value<double>(in, binary, box[d]);
+            read_gmsh_value<std::size_t>(in, binary, n_physicals);
+
+            // if there is a physical tag, we will use it as boundary id below
+            AssertThrow(n_physicals < 2,
+                        ExcMessage("More than one tag is not supported!"));
+            // if there is no physical tag, use 0 as default
+            int physical_tag = 0;
+            for (unsigned int j = 0; j < n_physicals; ++j)
+              read_gmsh_value<int>(in, binary, physical_tag);
+            tag_maps[entity_dim][tag] = physical_tag;
+
+            // we don't care about the entities bounding curves, surfaces, and
+            // volumes, but have to parse them anyway because their format is
+            // unstructured
+            if (entity_dim > 0)
+              {
+                unsigned long n_bounding_entities;
+                read_gmsh_value<std::size_t>(in, binary, n_bounding_entities);
+                for (unsigned int j = 0; j < n_bounding_entities; ++j)
+                  read_gmsh_value<int>(in, binary, tag);
+              }
+          };
+
           for (unsigned int i = 0; i < n_points; ++i)
-            {
-              // parse point ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[0]
-              if (gmsh_file_format > 40)
-                {
-                  in >> tag >> box_min_x >> box_min_y >> box_min_z >>
-                    n_physicals;
-                  box_max_x = box_min_x;
-                  box_max_y = box_min_y;
-                  box_max_z = box_min_z;
-                }
-              else
-                {
-                  in >> tag >> box_min_x >> box_min_y >> box_min_z >>
-                    box_max_x >> box_max_y >> box_max_z >> n_physicals;
-                }
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[0][tag] = physical_tag;
-            }
+            read_entity(0);
           for (unsigned int i = 0; i < n_curves; ++i)
-            {
-              // parse curve ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[1]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[1][tag] = physical_tag;
-              // we don't care about the points associated to a curve, but have
-              // to parse them anyway because their format is unstructured
-              in >> n_points;
-              for (unsigned int j = 0; j < n_points; ++j)
-                in >> tag;
-            }
-
+            read_entity(1);
           for (unsigned int i = 0; i < n_surfaces; ++i)
-            {
-              // parse surface ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[2]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[2][tag] = physical_tag;
-              // we don't care about the curves associated to a surface, but
-              // have to parse them anyway because their format is unstructured
-              in >> n_curves;
-              for (unsigned int j = 0; j < n_curves; ++j)
-                in >> tag;
-            }
+            read_entity(2);
           for (unsigned int i = 0; i < n_volumes; ++i)
-            {
-              // parse volume ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[3]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[3][tag] = physical_tag;
-              // we don't care about the surfaces associated to a volume, but
-              // have to parse them anyway because their format is unstructured
-              in >> n_surfaces;
-              for (unsigned int j = 0; j < n_surfaces; ++j)
-                in >> tag;
-            }
+            read_entity(3);
           in >> line;
           AssertThrow(line == "$EndEntities", ExcInvalidGMSHInput(line));
           in >> line;
@@ -1609,6 +1599,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // in any case, be the list of
       // nodes:
       AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
+      if (binary)
+        in.get();
     }
 
   // now read the nodes list
@@ -1617,7 +1609,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
     {
       int min_node_tag;
       int max_node_tag;
-      in >> n_entity_blocks >> n_vertices >> min_node_tag >> max_node_tag;
+      read_gmsh_value<std::size_t>(in, binary, n_entity_blocks);
+      read_gmsh_value<std::size_t>(in, binary, n_vertices);
+      read_gmsh_value<std::size_t>(in, binary, min_node_tag);
+      read_gmsh_value<std::size_t>(in, binary, max_node_tag);
     }
   else if (gmsh_file_format == 40)
     {
@@ -1628,8 +1623,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   std::vector<Point<spacedim>> vertices(n_vertices);
   // set up mapping between numbering
   // in msh-file (nod) and in the
-  // vertices vector
-  std::map<int, int> vertex_indices;
+  // vertices vector. we use a hash map, since the lookups of the vertices
+  // of all cells below dominate the run time for large meshes
+  std::unordered_map<int, int> vertex_indices;
+  vertex_indices.reserve(n_vertices);
 
   {
     unsigned int global_vertex = 0;
@@ -1648,19 +1645,25 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             // but we are ignoring both anyway.
             int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> parametric >> numNodes;
+            read_gmsh_value<int>(in, binary, tagEntity);
+            read_gmsh_value<int>(in, binary, dimEntity);
+            read_gmsh_value<int>(in, binary, parametric);
+            read_gmsh_value<std::size_t>(in, binary, numNodes);
           }
 
         std::vector<int> vertex_numbers;
         int              vertex_number;
         if (gmsh_file_format > 40)
-          for (unsigned long vertex_per_entity = 0;
-               vertex_per_entity < numNodes;
-               ++vertex_per_entity)
-            {
-              in >> vertex_number;
-              vertex_numbers.push_back(vertex_number);
-            }
+          {
+            vertex_numbers.reserve(numNodes);
+            for (unsigned long vertex_per_entity = 0;
+                 vertex_per_entity < numNodes;
+                 ++vertex_per_entity)
+              {
+                read_gmsh_value<std::size_t>(in, binary, vertex_number);
+                vertex_numbers.push_back(vertex_number);
+              }
+          }
 
         for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes;
              ++vertex_per_entity, ++global_vertex)
@@ -1672,7 +1675,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             if (gmsh_file_format > 40)
               {
                 vertex_number = vertex_numbers[vertex_per_entity];
-                in >> x[0] >> x[1] >> x[2];
+                for (double &coordinate : x)
+                  read_gmsh_value<double>(in, binary, coordinate);
               }
             else
               in >> vertex_number >> x[0] >> x[1] >> x[2];
@@ -1687,7 +1691,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               {
                 double u = 0.;
                 double v = 0.;
-                in >> u >> v;
+                read_gmsh_value<double>(in, binary, u);
+                read_gmsh_value<double>(in, binary, v);
                 (void)u;
                 (void)v;
               }
@@ -1708,12 +1713,18 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   AssertThrow(line == begin_elements_marker[gmsh_file_format == 10 ? 0 : 1],
               ExcInvalidGMSHInput(line));
 
+  if (binary)
+    in.get();
+
   // now read the cell list
   if (gmsh_file_format > 40)
     {
       int min_node_tag;
       int max_node_tag;
-      in >> n_entity_blocks >> n_cells >> min_node_tag >> max_node_tag;
+      read_gmsh_value<std::size_t>(in, binary, n_entity_blocks);
+      read_gmsh_value<std::size_t>(in, binary, n_cells);
+      read_gmsh_value<std::size_t>(in, binary, min_node_tag);
+      read_gmsh_value<std::size_t>(in, binary, max_node_tag);
     }
   else if (gmsh_file_format == 40)
     {
@@ -1756,7 +1767,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
           {
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             int tagEntity, dimEntity;
-            in >> dimEntity >> tagEntity >> cell_type >> numElements;
+            read_gmsh_value<int>(in, binary, dimEntity);
+            read_gmsh_value<int>(in, binary, tagEntity);
+            read_gmsh_value<int>(in, binary, cell_type);
+            read_gmsh_value<std::size_t>(in, binary, numElements);
             material_id = tag_maps[dimEntity][tagEntity];
           }
 
@@ -1824,7 +1838,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               {
                 // ignore tag
                 int tag;
-                in >> tag;
+                read_gmsh_value<std::size_t>(in, binary, tag);
                 nod_num = GeometryInfo<dim>::vertices_per_cell;
               }
 
@@ -1857,7 +1871,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 // allocate and read indices
                 cells.emplace_back();
                 for (const unsigned int i : GeometryInfo<dim>::vertex_indices())
-                  in >> cells.back().vertices[i];
+                  read_gmsh_value<std::size_t>(in,
+                                               binary,
+                                               cells.back().vertices[i]);
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -1892,8 +1908,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // boundary info
               {
                 subcelldata.boundary_lines.emplace_back();
-                in >> subcelldata.boundary_lines.back().vertices[0] >>
-                  subcelldata.boundary_lines.back().vertices[1];
+                for (unsigned int &vertex :
+                     subcelldata.boundary_lines.back().vertices)
+                  read_gmsh_value<std::size_t>(in, binary, vertex);
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -1930,10 +1947,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // boundary info
               {
                 subcelldata.boundary_quads.emplace_back();
-                in >> subcelldata.boundary_quads.back().vertices[0] >>
-                  subcelldata.boundary_quads.back().vertices[1] >>
-                  subcelldata.boundary_quads.back().vertices[2] >>
-                  subcelldata.boundary_quads.back().vertices[3];
+                for (unsigned int &vertex :
+                     subcelldata.boundary_quads.back().vertices)
+                  read_gmsh_value<std::size_t>(in, binary, vertex);
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -1976,7 +1992,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                   }
                 else
                   {
-                    in >> node_index;
+                    read_gmsh_value<std::size_t>(in, binary, node_index);
                   }
 
                 // we only care about boundary indicators assigned to individual
@@ -22,6 +22,7 @@
 
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_out.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
@@ -2966,14 +2967,16 @@ namespace
   generate_triangulation_patches(
     std::vector<DataOutBase::Patch<dim, spacedim>> &patches,
     ITERATOR                                        cell,
-    END                                             end)
+    END                                             end,
+    const bool include_boundary_ids = false)
   {
     // convert each of the active cells into a patch
     for (; cell != end; ++cell)
       {
         DataOutBase::Patch<dim, spacedim> patch;
         patch.n_subdivisions = 1;
-        patch.data.reinit(5, GeometryInfo<dim>::vertices_per_cell);
+        patch.data.reinit(include_boundary_ids ? 6 : 5,
+                          GeometryInfo<dim>::vertices_per_cell);
 
         for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
           {
@@ -2995,6 +2998,27 @@ namespace
               static_cast<std::make_signed<types::subdomain_id>::type>(
                 cell->level_subdomain_id());
           }
+
+        // the boundary id is a property of the faces, so attach it to the
+        // vertices of the boundary faces of the cell and mark all other
+        // vertices with -1
+        if (include_boundary_ids)
+          {
+            for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+              patch.data(5, v) = -1;
+            for (const unsigned int f : GeometryInfo<dim>::face_indices())
+              if (cell->face(f)->at_boundary())
+                for (unsigned int v = 0;
+                     v < GeometryInfo<dim>::vertices_per_face;
+                     ++v)
+                  {
+                    const unsigned int cell_vertex =
+                      GeometryInfo<dim>::face_to_cell_vertices(f, v);
+                    patch.data(5, cell_vertex) =
+                      static_cast<std::make_signed<types::boundary_id>::type>(
+                        cell->face(f)->boundary_id());
+                  }
+          }
         patches.push_back(patch);
       }
   }
@@ -3402,6 +3426,58 @@ GridOut::write_vtu(const Triangulation<dim, spacedim> &tria,
 
 
 
+template <int dim, int spacedim>
+void
+GridOut::write_vtu_in_parallel(const Triangulation<dim, spacedim> &tria,
+                               const std::string &filename) const
+{
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches;
+  std::vector<std::string> data_names = triangulation_patch_data_names();
+  data_names.emplace_back("boundary");
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    nonscalar_data_ranges;
+
+  if (const parallel::TriangulationBase<dim, spacedim> *tr =
+        dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(&tria))
+    {
+      // only convert the locally owned cells, so that all cells of the
+      // global mesh appear exactly once in the file
+      patches.reserve(tr->n_locally_owned_active_cells());
+      using active_cell_iterator =
+        typename Triangulation<dim, spacedim>::active_cell_iterator;
+      const FilteredIterator<active_cell_iterator> begin(
+        IteratorFilters::LocallyOwnedCell(), tria.begin_active()),
+        end(IteratorFilters::LocallyOwnedCell(), tria.end());
+      generate_triangulation_patches(patches, begin, end, true);
+
+      DataOutBase::write_vtu_in_parallel(patches,
+                                         data_names,
+                                         nonscalar_data_ranges,
+                                         vtu_flags,
+                                         filename,
+                                         tr->get_communicator());
+    }
+  else
+    {
+      patches.reserve(tria.n_active_cells());
+      generate_triangulation_patches(patches,
+                                     tria.begin_active(),
+                                     tria.end(),
+                                     true);
+
+      std::ofstream out(filename);
+      AssertThrow(out, ExcIO());
+      DataOutBase::write_vtu(
+        patches, data_names, nonscalar_data_ranges, vtu_flags, out);
+    }
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridOut::write_mesh_per_processor_as_vtu(
@@ -15,6 +15,7 @@
 
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -59,6 +60,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <list>
 #include <numeric>
@@ -66,6 +68,13 @@
 #include <tuple>
 #include <unordered_map>
 
+#ifdef DEAL_II_METIS_WITH_PARMETIS
+extern "C"
+{
+#  include <parmetis.h>
+}
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -1560,6 +1569,191 @@ namespace GridTools
       // return if the scalar product of a is larger.
       return (scalar_product_a > scalar_product_b);
     }
+
+    /**
+     * The algorithm behind find_active_cell_around_point() using a
+     * vertex-to-cell map. The two function objects return the number of
+     * cells adjacent to a vertex and the $i$th of these cells, which allows
+     * to use this function with both the std::set based and the compressed
+     * representation of the vertex-to-cell map.
+     */
+    template <int dim,
+              template <int, int> class MeshType,
+              int spacedim,
+              typename NCellsOfVertex,
+              typename CellOfVertex>
+    std::pair<typename MeshType<dim, spacedim>::active_cell_iterator,
+              Point<dim>>
+    find_active_cell_around_point(
+      const Mapping<dim, spacedim> & mapping,
+      const MeshType<dim, spacedim> &mesh,
+      const Point<spacedim> &        p,
+      const NCellsOfVertex &         n_cells_of_vertex,
+      const CellOfVertex &           cell_of_vertex,
+      const std::vector<std::vector<Tensor<1, spacedim>>>
+        &vertex_to_cell_centers,
+      const typename MeshType<dim, spacedim>::active_cell_iterator &cell_hint,
+      const std::vector<bool> &marked_vertices,
+      const RTree<std::pair<Point<spacedim>, unsigned int>>
+        &used_vertices_rtree)
+    {
+      std::pair<typename MeshType<dim, spacedim>::active_cell_iterator,
+                Point<dim>>
+        cell_and_position;
+      // To handle points at the border we keep track of points which are close
+      // to the unit cell:
+      std::pair<typename MeshType<dim, spacedim>::active_cell_iterator,
+                Point<dim>>
+        cell_and_position_approx;
+
+      bool found_cell  = false;
+      bool approx_cell = false;
+
+      unsigned int        closest_vertex_index = 0;
+      Tensor<1, spacedim> vertex_to_point;
+      auto                current_cell = cell_hint;
+
+      while (found_cell == false)
+        {
+          // First look at the vertices of the cell cell_hint. If it's an
+          // invalid cell, then query for the closest global vertex
+          if (current_cell.state() == IteratorState::valid)
+            {
+              const auto cell_vertices = mapping.get_vertices(current_cell);
+              const unsigned int closest_vertex =
+                find_closest_vertex_of_cell<dim, spacedim>(current_cell,
+                                                           p,
+                                                           mapping);
+              vertex_to_point      = p - cell_vertices[closest_vertex];
+              closest_vertex_index = current_cell->vertex_index(closest_vertex);
+            }
+          else
+            {
+              if (!used_vertices_rtree.empty())
+                {
+                  // If we have an rtree at our disposal, use it.
+                  using ValueType = std::pair<Point<spacedim>, unsigned int>;
+                  std::function<bool(const ValueType &)> marked;
+                  if (marked_vertices.size() == mesh.n_vertices())
+                    marked =
+                      [&marked_vertices](const ValueType &value) -> bool {
+                      return marked_vertices[value.second];
+                    };
+                  else
+                    marked = [](const ValueType &) -> bool { return true; };
+
+                  std::vector<std::pair<Point<spacedim>, unsigned int>> res;
+                  used_vertices_rtree.query(
+                    boost::geometry::index::nearest(p, 1) &&
+                      boost::geometry::index::satisfies(marked),
+                    std::back_inserter(res));
+
+                  // We should have one and only one result
+                  AssertDimension(res.size(), 1);
+                  closest_vertex_index = res[0].second;
+                }
+              else
+                {
+                  closest_vertex_index = GridTools::find_closest_vertex(
+                    mapping, mesh, p, marked_vertices);
+                }
+              vertex_to_point = p - mesh.get_vertices()[closest_vertex_index];
+            }
+
+          const double vertex_point_norm = vertex_to_point.norm();
+          if (vertex_point_norm > 0)
+            vertex_to_point /= vertex_point_norm;
+
+          const unsigned int n_neighbor_cells =
+            n_cells_of_vertex(closest_vertex_index);
+
+          // Create a corresponding map of vectors from vertex to cell center
+          std::vector<unsigned int> neighbor_permutation(n_neighbor_cells);
+
+          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
+            neighbor_permutation[i] = i;
+
+          auto comp = [&](const unsigned int a, const unsigned int b) -> bool {
+            return internal::compare_point_association<spacedim>(
+              a,
+              b,
+              vertex_to_point,
+              vertex_to_cell_centers[closest_vertex_index]);
+          };
+
+          std::sort(neighbor_permutation.begin(),
+                    neighbor_permutation.end(),
+                    comp);
+          // It is possible the vertex is close
+          // to an edge, thus we add a tolerance
+          // setting it initially to 1e-10
+          // to keep also the "best" cell
+          double best_distance = 1e-10;
+
+          // Search all of the cells adjacent to the closest vertex of the cell
+          // hint Most likely we will find the point in them.
+          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
+            {
+              try
+                {
+                  const auto cell = cell_of_vertex(closest_vertex_index,
+                                                   neighbor_permutation[i]);
+                  const Point<dim> p_unit =
+                    mapping.transform_real_to_unit_cell(cell, p);
+                  if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                    {
+                      cell_and_position.first  = cell;
+                      cell_and_position.second = p_unit;
+                      found_cell               = true;
+                      approx_cell              = false;
+                      break;
+                    }
+                  // The point is not inside this cell: checking how far
+                  // outside it is and whether we want to use this cell as a
+                  // backup if we can't find a cell within which the point
+                  // lies.
+                  const double dist =
+                    GeometryInfo<dim>::distance_to_unit_cell(p_unit);
+                  if (dist < best_distance)
+                    {
+                      best_distance                   = dist;
+                      cell_and_position_approx.first  = cell;
+                      cell_and_position_approx.second = p_unit;
+                      approx_cell                     = true;
+                    }
+                }
+              catch (typename Mapping<dim>::ExcTransformationFailed &)
+                {}
+            }
+
+          if (found_cell == true)
+            return cell_and_position;
+          else if (approx_cell == true)
+            return cell_and_position_approx;
+
+          // The first time around, we check for vertices in the hint_cell.
+          // If that does not work, we set the cell iterator to an invalid
+          // one, and look for a global vertex close to the point. If that
+          // does not work, we are in trouble, and just throw an exception.
+          //
+          // If we got here, then we did not find the point. If the
+          // current_cell.state() here is not IteratorState::valid, it means
+          // that the user did not provide a hint_cell, and at the beginning
+          // of the while loop we performed an actual global search on the
+          // mesh vertices. Not finding the point then means the point is
+          // outside the domain, or that we've had problems with the algorithm
+          // above. Try as a last resort the other (simpler) algorithm.
+          if (current_cell.state() != IteratorState::valid)
+            return GridTools::find_active_cell_around_point(mapping,
+                                                            mesh,
+                                                            p,
+                                                            marked_vertices);
+
+          current_cell =
+            typename MeshType<dim, spacedim>::active_cell_iterator();
+        }
+      return cell_and_position;
+    }
   } // namespace internal
 
   template <int dim, template <int, int> class MeshType, int spacedim>
@@ -1582,159 +1776,22 @@ namespace GridTools
     const std::vector<bool> &                              marked_vertices,
     const RTree<std::pair<Point<spacedim>, unsigned int>> &used_vertices_rtree)
   {
-    std::pair<typename MeshType<dim, spacedim>::active_cell_iterator,
-              Point<dim>>
-      cell_and_position;
-    // To handle points at the border we keep track of points which are close to
-    // the unit cell:
-    std::pair<typename MeshType<dim, spacedim>::active_cell_iterator,
-              Point<dim>>
-      cell_and_position_approx;
-
-    bool found_cell  = false;
-    bool approx_cell = false;
-
-    unsigned int        closest_vertex_index = 0;
-    Tensor<1, spacedim> vertex_to_point;
-    auto                current_cell = cell_hint;
-
-    while (found_cell == false)
-      {
-        // First look at the vertices of the cell cell_hint. If it's an
-        // invalid cell, then query for the closest global vertex
-        if (current_cell.state() == IteratorState::valid)
-          {
-            const auto cell_vertices = mapping.get_vertices(current_cell);
-            const unsigned int closest_vertex =
-              find_closest_vertex_of_cell<dim, spacedim>(current_cell,
-                                                         p,
-                                                         mapping);
-            vertex_to_point      = p - cell_vertices[closest_vertex];
-            closest_vertex_index = current_cell->vertex_index(closest_vertex);
-          }
-        else
-          {
-            if (!used_vertices_rtree.empty())
-              {
-                // If we have an rtree at our disposal, use it.
-                using ValueType = std::pair<Point<spacedim>, unsigned int>;
-                std::function<bool(const ValueType &)> marked;
-                if (marked_vertices.size() == mesh.n_vertices())
-                  marked = [&marked_vertices](const ValueType &value) -> bool {
-                    return marked_vertices[value.second];
-                  };
-                else
-                  marked = [](const ValueType &) -> bool { return true; };
-
-                std::vector<std::pair<Point<spacedim>, unsigned int>> res;
-                used_vertices_rtree.query(
-                  boost::geometry::index::nearest(p, 1) &&
-                    boost::geometry::index::satisfies(marked),
-                  std::back_inserter(res));
-
-                // We should have one and only one result
-                AssertDimension(res.size(), 1);
-                closest_vertex_index = res[0].second;
-              }
-            else
-              {
-                closest_vertex_index = GridTools::find_closest_vertex(
-                  mapping, mesh, p, marked_vertices);
-              }
-            vertex_to_point = p - mesh.get_vertices()[closest_vertex_index];
-          }
-
-        const double vertex_point_norm = vertex_to_point.norm();
-        if (vertex_point_norm > 0)
-          vertex_to_point /= vertex_point_norm;
-
-        const unsigned int n_neighbor_cells =
-          vertex_to_cells[closest_vertex_index].size();
-
-        // Create a corresponding map of vectors from vertex to cell center
-        std::vector<unsigned int> neighbor_permutation(n_neighbor_cells);
-
-        for (unsigned int i = 0; i < n_neighbor_cells; ++i)
-          neighbor_permutation[i] = i;
-
-        auto comp = [&](const unsigned int a, const unsigned int b) -> bool {
-          return internal::compare_point_association<spacedim>(
-            a,
-            b,
-            vertex_to_point,
-            vertex_to_cell_centers[closest_vertex_index]);
-        };
-
-        std::sort(neighbor_permutation.begin(),
-                  neighbor_permutation.end(),
-                  comp);
-        // It is possible the vertex is close
-        // to an edge, thus we add a tolerance
-        // setting it initially to 1e-10
-        // to keep also the "best" cell
-        double best_distance = 1e-10;
-
-        // Search all of the cells adjacent to the closest vertex of the cell
-        // hint Most likely we will find the point in them.
-        for (unsigned int i = 0; i < n_neighbor_cells; ++i)
-          {
-            try
-              {
-                auto cell = vertex_to_cells[closest_vertex_index].begin();
-                std::advance(cell, neighbor_permutation[i]);
-                const Point<dim> p_unit =
-                  mapping.transform_real_to_unit_cell(*cell, p);
-                if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-                  {
-                    cell_and_position.first  = *cell;
-                    cell_and_position.second = p_unit;
-                    found_cell               = true;
-                    approx_cell              = false;
-                    break;
-                  }
-                // The point is not inside this cell: checking how far outside
-                // it is and whether we want to use this cell as a backup if we
-                // can't find a cell within which the point lies.
-                const double dist =
-                  GeometryInfo<dim>::distance_to_unit_cell(p_unit);
-                if (dist < best_distance)
-                  {
-                    best_distance                   = dist;
-                    cell_and_position_approx.first  = *cell;
-                    cell_and_position_approx.second = p_unit;
-                    approx_cell                     = true;
-                  }
-              }
-            catch (typename Mapping<dim>::ExcTransformationFailed &)
-              {}
-          }
-
-        if (found_cell == true)
-          return cell_and_position;
-        else if (approx_cell == true)
-          return cell_and_position_approx;
-
-        // The first time around, we check for vertices in the hint_cell. If
-        // that does not work, we set the cell iterator to an invalid one, and
-        // look for a global vertex close to the point. If that does not work,
-        // we are in trouble, and just throw an exception.
-        //
-        // If we got here, then we did not find the point. If the
-        // current_cell.state() here is not IteratorState::valid, it means that
-        // the user did not provide a hint_cell, and at the beginning of the
-        // while loop we performed an actual global search on the mesh
-        // vertices. Not finding the point then means the point is outside the
-        // domain, or that we've had problems with the algorithm above. Try as a
-        // last resort the other (simpler) algorithm.
-        if (current_cell.state() != IteratorState::valid)
-          return find_active_cell_around_point(mapping,
-                                               mesh,
-                                               p,
-                                               marked_vertices);
-
-        current_cell = typename MeshType<dim, spacedim>::active_cell_iterator();
-      }
-    return cell_and_position;
+    return internal::find_active_cell_around_point(
+      mapping,
+      mesh,
+      p,
+      [&vertex_to_cells](const unsigned int vertex) -> unsigned int {
+        return vertex_to_cells[vertex].size();
+      },
+      [&vertex_to_cells](const unsigned int vertex, const unsigned int i) {
+        auto cell = vertex_to_cells[vertex].begin();
+        std::advance(cell, i);
+        return *cell;
+      },
+      vertex_to_cell_centers,
+      cell_hint,
+      marked_vertices,
+      used_vertices_rtree);
   }
 
 
@@ -2118,6 +2175,71 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  std::pair<
+    std::vector<unsigned int>,
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
+  compressed_vertex_to_cell_map(
+    const Triangulation<dim, spacedim> &triangulation)
+  {
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    // Collect all (vertex, cell) pairs with the same rules as
+    // vertex_to_cell_map(), then sort them and remove duplicates. This
+    // yields the cells of each vertex in the same order as the std::set
+    // used there, without allocating a tree node per entry.
+    std::vector<std::pair<unsigned int, active_cell_iterator>> vertex_cells;
+    vertex_cells.reserve(triangulation.n_active_cells() *
+                         GeometryInfo<dim>::vertices_per_cell);
+
+    for (const auto &cell : triangulation.active_cell_iterators())
+      for (const unsigned int i : GeometryInfo<dim>::vertex_indices())
+        vertex_cells.emplace_back(cell->vertex_index(i), cell);
+
+    // Take care of hanging nodes
+    for (const auto &cell : triangulation.active_cell_iterators())
+      {
+        for (unsigned int i : GeometryInfo<dim>::face_indices())
+          if ((cell->at_boundary(i) == false) &&
+              (cell->neighbor(i)->is_active()))
+            {
+              const active_cell_iterator adjacent_cell = cell->neighbor(i);
+              for (unsigned int j = 0; j < GeometryInfo<dim>::vertices_per_face;
+                   ++j)
+                vertex_cells.emplace_back(cell->face(i)->vertex_index(j),
+                                          adjacent_cell);
+            }
+
+        // in 3d also loop over the edges
+        if (dim == 3)
+          for (unsigned int i = 0; i < GeometryInfo<dim>::lines_per_cell; ++i)
+            if (cell->line(i)->has_children())
+              vertex_cells.emplace_back(
+                cell->line(i)->child(0)->vertex_index(1), cell);
+      }
+
+    std::sort(vertex_cells.begin(), vertex_cells.end());
+    vertex_cells.erase(std::unique(vertex_cells.begin(), vertex_cells.end()),
+                       vertex_cells.end());
+
+    std::pair<std::vector<unsigned int>, std::vector<active_cell_iterator>>
+      result;
+    result.first.resize(triangulation.n_vertices() + 1, 0);
+    result.second.reserve(vertex_cells.size());
+    for (const auto &vertex_cell : vertex_cells)
+      {
+        ++result.first[vertex_cell.first + 1];
+        result.second.push_back(vertex_cell.second);
+      }
+    for (unsigned int v = 0; v < triangulation.n_vertices(); ++v)
+      result.first[v + 1] += result.first[v];
+
+    return result;
+  }
+
+
+
   template <int dim, int spacedim>
   std::map<unsigned int, types::global_vertex_index>
   compute_local_to_global_vertex_index_map(
@@ -2777,6 +2899,179 @@ namespace GridTools
   }
 
 
+
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_parmetis(
+    const unsigned int               n_partitions,
+    const std::vector<unsigned int> &cell_weights,
+    Triangulation<dim, spacedim> &   triangulation,
+    const MPI_Comm &                 mpi_communicator)
+  {
+    Assert((dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+              &triangulation) == nullptr),
+           ExcMessage("Objects of type parallel::distributed::Triangulation "
+                      "are already partitioned implicitly and can not be "
+                      "partitioned again explicitly."));
+    Assert(n_partitions > 0, ExcInvalidNumberOfPartitions(n_partitions));
+    Assert(cell_weights.empty() ||
+             cell_weights.size() == triangulation.n_active_cells(),
+           ExcDimensionMismatch(cell_weights.size(),
+                                triangulation.n_active_cells()));
+
+    // signal that partitioning is going to happen
+    triangulation.signals.pre_partition();
+
+    // check for an easy return
+    if (n_partitions == 1)
+      {
+        for (const auto &cell : triangulation.active_cell_iterators())
+          cell->set_subdomain_id(0);
+        return;
+      }
+
+#ifndef DEAL_II_METIS_WITH_PARMETIS
+    (void)cell_weights;
+    (void)mpi_communicator;
+    AssertThrow(false,
+                ExcMessage("GridTools::partition_triangulation_parmetis() "
+                           "requires deal.II to be configured with MPI and "
+                           "a METIS installation that includes ParMETIS."));
+#else
+    // every process sets up the rows of the dual graph of the cells in its
+    // contiguous range of active cell indices
+    const unsigned int n_procs =
+      Utilities::MPI::n_mpi_processes(mpi_communicator);
+    const unsigned int my_rank =
+      Utilities::MPI::this_mpi_process(mpi_communicator);
+    const unsigned int n_active_cells = triangulation.n_active_cells();
+
+    const auto range_begin = [&](const unsigned int rank) {
+      return static_cast<unsigned int>(
+        static_cast<std::uint64_t>(n_active_cells) * rank / n_procs);
+    };
+    std::vector<idx_t> vtxdist(n_procs + 1);
+    for (unsigned int p = 0; p <= n_procs; ++p)
+      vtxdist[p] = range_begin(p);
+    const unsigned int my_begin = range_begin(my_rank);
+    const unsigned int my_end   = range_begin(my_rank + 1);
+
+    std::vector<idx_t> xadj(1, 0);
+    std::vector<idx_t> adjncy;
+    std::vector<idx_t> vwgt;
+    xadj.reserve(my_end - my_begin + 1);
+    adjncy.reserve((my_end - my_begin) * GeometryInfo<dim>::faces_per_cell);
+
+    const bool use_weights =
+      !cell_weights.empty() || !triangulation.signals.cell_weight.empty();
+    if (use_weights)
+      vwgt.reserve(my_end - my_begin);
+
+    for (const auto &cell : triangulation.active_cell_iterators())
+      {
+        const unsigned int index = cell->active_cell_index();
+        if (index < my_begin || index >= my_end)
+          continue;
+
+        for (const unsigned int f : GeometryInfo<dim>::face_indices())
+          {
+            if (cell->at_boundary(f))
+              continue;
+
+            const auto neighbor = cell->neighbor(f);
+            if (neighbor->has_children() == false)
+              adjncy.push_back(neighbor->active_cell_index());
+            else if (dim > 1 && cell->face(f)->has_children())
+              for (unsigned int sf = 0; sf < cell->face(f)->n_children(); ++sf)
+                adjncy.push_back(
+                  cell->neighbor_child_on_subface(f, sf)->active_cell_index());
+            else
+              {
+                // the neighbor is refined, but not at the common face, as
+                // it happens in 1d or with anisotropic refinement: descend
+                // to the active child that touches the face
+                const unsigned int neighbor_face = cell->neighbor_face_no(f);
+                auto               child         = neighbor;
+                while (child->has_children())
+                  child = child->child(GeometryInfo<dim>::child_cell_on_face(
+                    child->refinement_case(), neighbor_face, 0));
+                adjncy.push_back(child->active_cell_index());
+              }
+          }
+        xadj.push_back(adjncy.size());
+
+        if (use_weights)
+          vwgt.push_back(
+            cell_weights.empty() ?
+              triangulation.signals.cell_weight(
+                cell, Triangulation<dim, spacedim>::CellStatus::CELL_PERSIST) :
+              cell_weights[index]);
+      }
+
+    // partition the graph in parallel. ParMETIS requires the weights to be
+    // positive on all processes if they are used at all
+    idx_t wgtflag = 0;
+    if (use_weights)
+      {
+        wgtflag = 2;
+        for (auto &weight : vwgt)
+          weight = std::max<idx_t>(weight, 1);
+      }
+    idx_t               numflag = 0;
+    idx_t               ncon    = 1;
+    idx_t               nparts  = n_partitions;
+    std::vector<real_t> tpwgts(n_partitions, 1. / n_partitions);
+    real_t              ubvec      = 1.05;
+    idx_t               options[3] = {0, 0, 0};
+    idx_t               edgecut;
+    std::vector<idx_t>  part(std::max(my_end - my_begin, 1U));
+    MPI_Comm            comm = mpi_communicator;
+
+    const int ierr = ParMETIS_V3_PartKway(vtxdist.data(),
+                                          xadj.data(),
+                                          adjncy.data(),
+                                          use_weights ? vwgt.data() : nullptr,
+                                          nullptr,
+                                          &wgtflag,
+                                          &numflag,
+                                          &ncon,
+                                          &nparts,
+                                          tpwgts.data(),
+                                          &ubvec,
+                                          options,
+                                          &edgecut,
+                                          part.data(),
+                                          &comm);
+    AssertThrow(ierr == METIS_OK,
+                ExcMessage("ParMETIS_V3_PartKway failed with error code " +
+                           std::to_string(ierr) + "."));
+
+    // collect the subdomain ids of all cells on all processes
+    std::vector<unsigned int> my_partition(part.begin(),
+                                           part.begin() + (my_end - my_begin));
+    std::vector<int>          counts(n_procs), displacements(n_procs);
+    for (unsigned int p = 0; p < n_procs; ++p)
+      {
+        counts[p]        = range_begin(p + 1) - range_begin(p);
+        displacements[p] = range_begin(p);
+      }
+    std::vector<unsigned int> partition_indices(n_active_cells);
+    const int ierr_mpi = MPI_Allgatherv(my_partition.data(),
+                                        my_partition.size(),
+                                        MPI_UNSIGNED,
+                                        partition_indices.data(),
+                                        counts.data(),
+                                        displacements.data(),
+                                        MPI_UNSIGNED,
+                                        mpi_communicator);
+    AssertThrowMPI(ierr_mpi);
+
+    for (const auto &cell : triangulation.active_cell_iterators())
+      cell->set_subdomain_id(partition_indices[cell->active_cell_index()]);
+#endif
+  }
+
+
   namespace internal
   {
     /**
@@ -2809,6 +3104,43 @@ namespace GridTools
                                                    n_partitions);
         }
     }
+
+
+
+    /**
+     * recursive helper function for the weighted version of
+     * partition_triangulation_zorder: each active cell is assigned to the
+     * partition that contains the midpoint of its interval on the
+     * space-filling curve
+     */
+    template <class IT>
+    void
+    set_subdomain_id_in_zorder_weighted_recursively(
+      IT                         cell,
+      const std::vector<double> &cell_weights,
+      double &                   current_weight,
+      const double               total_weight,
+      const unsigned int         n_partitions)
+    {
+      if (cell->is_active())
+        {
+          const double weight = cell_weights[cell->active_cell_index()];
+          const unsigned int proc_idx = static_cast<unsigned int>(
+            std::floor((current_weight + 0.5 * weight) * n_partitions /
+                       total_weight));
+          cell->set_subdomain_id(std::min(proc_idx, n_partitions - 1));
+          current_weight += weight;
+        }
+      else
+        {
+          for (unsigned int n = 0; n < cell->n_children(); ++n)
+            set_subdomain_id_in_zorder_weighted_recursively(cell->child(n),
+                                                            cell_weights,
+                                                            current_weight,
+                                                            total_weight,
+                                                            n_partitions);
+        }
+    }
   } // namespace internal
 
   template <int dim, int spacedim>
@@ -2816,6 +3148,22 @@ namespace GridTools
   partition_triangulation_zorder(const unsigned int            n_partitions,
                                  Triangulation<dim, spacedim> &triangulation,
                                  const bool                    group_siblings)
+  {
+    partition_triangulation_zorder(n_partitions,
+                                   std::vector<std::vector<unsigned int>>(),
+                                   triangulation,
+                                   group_siblings);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_zorder(
+    const unsigned int                            n_partitions,
+    const std::vector<std::vector<unsigned int>> &cell_weights,
+    Triangulation<dim, spacedim> &                triangulation,
+    const bool                                    group_siblings)
   {
     Assert((dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
               &triangulation) == nullptr),
@@ -2855,6 +3203,27 @@ namespace GridTools
     unsigned int       current_cell_idx = 0;
     const unsigned int n_active_cells   = triangulation.n_active_cells();
 
+    // combine the constraints into a single weight per cell, each of them
+    // normalized by its sum over all cells
+    std::vector<double> combined_weights;
+    double              total_weight = 0.;
+    if (!cell_weights.empty())
+      {
+        combined_weights.resize(n_active_cells, 0.);
+        for (const auto &weights : cell_weights)
+          {
+            AssertDimension(weights.size(), n_active_cells);
+            const double sum =
+              std::accumulate(weights.begin(), weights.end(), 0.);
+            if (sum > 0.)
+              for (unsigned int i = 0; i < n_active_cells; ++i)
+                combined_weights[i] += weights[i] / sum;
+          }
+        total_weight =
+          std::accumulate(combined_weights.begin(), combined_weights.end(), 0.);
+      }
+    double current_weight = 0.;
+
     // set subdomain id for active cell descendants
     // of each coarse cell in permuted order
     for (unsigned int idx = 0; idx < triangulation.n_cells(0); ++idx)
@@ -2864,11 +3233,19 @@ namespace GridTools
         typename Triangulation<dim, spacedim>::cell_iterator coarse_cell(
           &triangulation, 0, coarse_cell_idx);
 
-        internal::set_subdomain_id_in_zorder_recursively(coarse_cell,
-                                                         current_proc_idx,
-                                                         current_cell_idx,
-                                                         n_active_cells,
-                                                         n_partitions);
+        if (total_weight > 0.)
+          internal::set_subdomain_id_in_zorder_weighted_recursively(
+            coarse_cell,
+            combined_weights,
+            current_weight,
+            total_weight,
+            n_partitions);
+        else
+          internal::set_subdomain_id_in_zorder_recursively(coarse_cell,
+                                                           current_proc_idx,
+                                                           current_cell_idx,
+                                                           n_active_cells,
+                                                           n_partitions);
       }
 
     // if all children of a cell are active (e.g. we
@@ -5229,21 +5606,129 @@ namespace GridTools
   {
     const auto &mesh            = cache.get_triangulation();
     const auto &mapping         = cache.get_mapping();
-    const auto &vertex_to_cells = cache.get_vertex_to_cell_map();
+    const auto &vertex_to_cells = cache.get_compressed_vertex_to_cell_map();
+    const auto &offsets         = vertex_to_cells.first;
+    const auto &cells           = vertex_to_cells.second;
     const auto &vertex_to_cell_centers =
       cache.get_vertex_to_cell_centers_directions();
     const auto &used_vertices_rtree = cache.get_used_vertices_rtree();
 
-    return find_active_cell_around_point(mapping,
-                                         mesh,
-                                         p,
-                                         vertex_to_cells,
-                                         vertex_to_cell_centers,
-                                         cell_hint,
-                                         marked_vertices,
-                                         used_vertices_rtree);
+    return internal::find_active_cell_around_point(
+      mapping,
+      mesh,
+      p,
+      [&offsets](const unsigned int vertex) -> unsigned int {
+        return offsets[vertex + 1] - offsets[vertex];
+      },
+      [&offsets, &cells](const unsigned int vertex, const unsigned int i) {
+        return cells[offsets[vertex] + i];
+      },
+      vertex_to_cell_centers,
+      cell_hint,
+      marked_vertices,
+      used_vertices_rtree);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>>
+  find_all_active_cells_around_points(
+    const Cache<dim, spacedim> &        cache,
+    const std::vector<Point<spacedim>> &points,
+    const double                        tolerance)
+  {
+    using cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    const auto &mapping = cache.get_mapping();
+    const auto &b_tree  = cache.get_cell_bounding_boxes_rtree();
+
+    const unsigned int n_points    = points.size();
+    const unsigned int grain_size  = 64;
+    const auto         not_in_cell = numbers::invalid_unsigned_int;
+
+    // Step 1: Query the tree of the cell bounding boxes for the candidate
+    // cells of every point. The queries are independent, so run them in
+    // parallel.
+    std::vector<std::vector<cell_iterator>> candidate_cells(n_points);
+    parallel::apply_to_subranges(
+      0u,
+      n_points,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<std::pair<BoundingBox<spacedim>, cell_iterator>> boxes;
+        for (unsigned int p = begin; p < end; ++p)
+          {
+            boxes.clear();
+            b_tree.query(boost::geometry::index::intersects(points[p]),
+                         std::back_inserter(boxes));
+            for (const auto &box : boxes)
+              if (!box.second->is_artificial())
+                candidate_cells[p].push_back(box.second);
+          }
+      },
+      grain_size);
+
+    // Step 2: Sort the pairs of candidate cells and point indices by cell,
+    // so that all points of a cell can be transformed in one call to
+    // Mapping::transform_points_real_to_unit_cell().
+    std::vector<std::pair<cell_iterator, unsigned int>> cell_and_point;
+    for (unsigned int p = 0; p < n_points; ++p)
+      for (const auto &cell : candidate_cells[p])
+        cell_and_point.emplace_back(cell, p);
+    std::sort(cell_and_point.begin(), cell_and_point.end());
+
+    std::vector<unsigned int> cell_start(1, 0);
+    for (unsigned int i = 1; i < cell_and_point.size(); ++i)
+      if (cell_and_point[i].first != cell_and_point[i - 1].first)
+        cell_start.push_back(i);
+    if (cell_and_point.size() > 0)
+      cell_start.push_back(cell_and_point.size());
+    const unsigned int n_cells = cell_start.size() - 1;
+
+    // Step 3: Compute the unit coordinates on every candidate cell, again in
+    // parallel since every cell writes to separate entries
+    std::vector<Point<dim>> unit_points(cell_and_point.size());
+    parallel::apply_to_subranges(
+      0u,
+      n_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<Point<spacedim>> real_points;
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            real_points.clear();
+            for (unsigned int i = cell_start[c]; i < cell_start[c + 1]; ++i)
+              real_points.push_back(points[cell_and_point[i].second]);
+
+            mapping.transform_points_real_to_unit_cell(
+              cell_and_point[cell_start[c]].first,
+              real_points,
+              make_array_view(unit_points.begin() + cell_start[c],
+                              unit_points.begin() + cell_start[c + 1]));
+
+            for (unsigned int i = cell_start[c]; i < cell_start[c + 1]; ++i)
+              if (!GeometryInfo<dim>::is_inside_unit_cell(unit_points[i],
+                                                          tolerance))
+                cell_and_point[i].second = not_in_cell;
+          }
+      },
+      std::max(1u, grain_size / 8));
+
+    // Step 4: Collect the cells that contain each point
+    std::vector<std::vector<std::pair<cell_iterator, Point<dim>>>> result(
+      n_points);
+    for (unsigned int i = 0; i < cell_and_point.size(); ++i)
+      if (cell_and_point[i].second != not_in_cell)
+        result[cell_and_point[i].second].emplace_back(cell_and_point[i].first,
+                                                      unit_points[i]);
+
+    return result;
   }
 
+
+
   template <int spacedim>
   std::vector<std::vector<BoundingBox<spacedim>>>
   exchange_local_bounding_boxes(
@@ -20,6 +20,9 @@
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
@@ -31,8 +34,11 @@ namespace GridTools
     , tria(&tria)
     , mapping(&mapping)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    tria_signal = tria.signals.any_change.connect([&]() {
+      mark_for_update(update_all);
+      moved_vertices_cell_bounding_boxes.clear();
+      moved_vertices_used_vertices.clear();
+    });
   }
 
   template <int dim, int spacedim>
@@ -55,6 +61,41 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::mark_vertices_moved(
+    const std::vector<bool> &moved_vertices)
+  {
+    AssertDimension(moved_vertices.size(), tria->n_vertices());
+
+    // Objects derived from vertex locations that we do not update
+    // incrementally. The connectivity information stays valid.
+    update_flags |= (update_vertex_to_cell_centers_directions &
+                     ~update_compressed_vertex_to_cell_map) |
+                    update_covering_rtree;
+
+    const auto accumulate = [&moved_vertices](std::vector<bool> &pending) {
+      if (pending.empty())
+        pending = moved_vertices;
+      else
+        for (unsigned int v = 0; v < moved_vertices.size(); ++v)
+          if (moved_vertices[v])
+            pending[v] = true;
+    };
+
+    if ((update_flags & update_cell_bounding_boxes_rtree) == update_nothing)
+      accumulate(moved_vertices_cell_bounding_boxes);
+
+    // The RTree of used vertices can only be updated if we still know the
+    // old locations from the map of used vertices.
+    if (update_flags & update_used_vertices)
+      update_flags |= update_used_vertices_rtree;
+    else
+      accumulate(moved_vertices_used_vertices);
+  }
+
+
+
   template <int dim, int spacedim>
   const std::vector<
     std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>> &
@@ -70,14 +111,50 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  const std::pair<
+    std::vector<unsigned int>,
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>> &
+  Cache<dim, spacedim>::get_compressed_vertex_to_cell_map() const
+  {
+    if (update_flags & update_compressed_vertex_to_cell_map)
+      {
+        compressed_vertex_to_cells =
+          GridTools::compressed_vertex_to_cell_map(*tria);
+        update_flags = update_flags & ~update_compressed_vertex_to_cell_map;
+      }
+    return compressed_vertex_to_cells;
+  }
+
+
+
   template <int dim, int spacedim>
   const std::vector<std::vector<Tensor<1, spacedim>>> &
   Cache<dim, spacedim>::get_vertex_to_cell_centers_directions() const
   {
     if (update_flags & update_vertex_to_cell_centers_directions)
       {
-        vertex_to_cell_centers = GridTools::vertex_to_cell_centers_directions(
-          *tria, get_vertex_to_cell_map());
+        // Compute the directions from the compressed vertex to cell map,
+        // which lists the cells of each vertex in the same order as
+        // get_vertex_to_cell_map() but is much cheaper to build
+        const auto &offsets  = get_compressed_vertex_to_cell_map().first;
+        const auto &cells    = get_compressed_vertex_to_cell_map().second;
+        const auto &vertices = tria->get_vertices();
+
+        vertex_to_cell_centers.clear();
+        vertex_to_cell_centers.resize(tria->n_vertices());
+        for (unsigned int v = 0; v < tria->n_vertices(); ++v)
+          if (tria->vertex_used(v))
+            {
+              vertex_to_cell_centers[v].resize(offsets[v + 1] - offsets[v]);
+              for (unsigned int c = offsets[v]; c < offsets[v + 1]; ++c)
+                {
+                  Tensor<1, spacedim> &direction =
+                    vertex_to_cell_centers[v][c - offsets[v]];
+                  direction = cells[c]->center() - vertices[v];
+                  direction /= direction.norm();
+                }
+            }
         update_flags = update_flags & ~update_vertex_to_cell_centers_directions;
       }
     return vertex_to_cell_centers;
@@ -93,18 +170,80 @@ namespace GridTools
       {
         used_vertices = GridTools::extract_used_vertices(*tria, *mapping);
         update_flags  = update_flags & ~update_used_vertices;
+
+        // The old locations of moved vertices are lost now, so the RTree of
+        // used vertices can no longer be updated incrementally.
+        if (!moved_vertices_used_vertices.empty())
+          {
+            update_flags |= update_used_vertices_rtree;
+            moved_vertices_used_vertices.clear();
+          }
       }
+    else if (!moved_vertices_used_vertices.empty())
+      update_moved_used_vertices();
+
     return used_vertices;
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::update_moved_used_vertices() const
+  {
+    Assert((update_flags & update_used_vertices) == update_nothing,
+           ExcInternalError());
+
+    const auto &offsets = get_compressed_vertex_to_cell_map().first;
+    const auto &cells   = get_compressed_vertex_to_cell_map().second;
+
+    const bool update_rtree =
+      (update_flags & update_used_vertices_rtree) == update_nothing;
+
+    for (unsigned int v = 0; v < moved_vertices_used_vertices.size(); ++v)
+      if (moved_vertices_used_vertices[v])
+        {
+          const auto entry = used_vertices.find(v);
+          if (entry == used_vertices.end())
+            continue;
+
+          // Find the new location of the vertex as seen by the mapping
+          // through any non-artificial cell it is a vertex of, as done by
+          // GridTools::extract_used_vertices().
+          bool found = false;
+          for (unsigned int c = offsets[v]; c < offsets[v + 1] && !found; ++c)
+            if (!cells[c]->is_artificial())
+              for (const unsigned int i : GeometryInfo<dim>::vertex_indices())
+                if (cells[c]->vertex_index(i) == v)
+                  {
+                    const Point<spacedim> new_location =
+                      mapping->get_vertices(cells[c])[i];
+                    if (update_rtree)
+                      {
+                        used_vertices_rtree.remove(
+                          std::make_pair(entry->second, v));
+                        used_vertices_rtree.insert(
+                          std::make_pair(new_location, v));
+                      }
+                    entry->second = new_location;
+                    found         = true;
+                    break;
+                  }
+        }
+
+    moved_vertices_used_vertices.clear();
+  }
+
+
+
   template <int dim, int spacedim>
   const RTree<std::pair<Point<spacedim>, unsigned int>> &
   Cache<dim, spacedim>::get_used_vertices_rtree() const
   {
     if (update_flags & update_used_vertices_rtree)
       {
+        // Pending moves are considered when filling the map of used
+        // vertices, from which the tree is packed from scratch.
         const auto &used_vertices = get_used_vertices();
         std::vector<std::pair<Point<spacedim>, unsigned int>> vertices(
           used_vertices.size());
@@ -114,6 +253,9 @@ namespace GridTools
         used_vertices_rtree = pack_rtree(vertices);
         update_flags        = update_flags & ~update_used_vertices_rtree;
       }
+    else if (!moved_vertices_used_vertices.empty())
+      update_moved_used_vertices();
+
     return used_vertices_rtree;
   }
 
@@ -126,23 +268,76 @@ namespace GridTools
   Cache<dim, spacedim>::get_cell_bounding_boxes_rtree() const
   {
     if (update_flags & update_cell_bounding_boxes_rtree)
+      build_cell_bounding_boxes_rtree();
+    else if (!moved_vertices_cell_bounding_boxes.empty())
       {
-        std::vector<std::pair<
-          BoundingBox<spacedim>,
-          typename Triangulation<dim, spacedim>::active_cell_iterator>>
-                     boxes(tria->n_active_cells());
-        unsigned int i = 0;
-        for (const auto &cell : tria->active_cell_iterators())
-          boxes[i++] = std::make_pair(mapping->get_bounding_box(cell), cell);
-
-        cell_bounding_boxes_rtree = pack_rtree(boxes);
-        update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
+        // Collect the cells adjacent to moved vertices. The compressed
+        // vertex to cell map only depends on the connectivity of the mesh
+        // and is therefore still valid.
+        const auto &offsets = get_compressed_vertex_to_cell_map().first;
+        const auto &cells   = get_compressed_vertex_to_cell_map().second;
+
+        std::vector<bool> cell_is_affected(tria->n_active_cells(), false);
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          affected_cells;
+        for (unsigned int v = 0; v < moved_vertices_cell_bounding_boxes.size();
+             ++v)
+          if (moved_vertices_cell_bounding_boxes[v] && tria->vertex_used(v))
+            for (unsigned int c = offsets[v]; c < offsets[v + 1]; ++c)
+              if (!cell_is_affected[cells[c]->active_cell_index()])
+                {
+                  cell_is_affected[cells[c]->active_cell_index()] = true;
+                  affected_cells.push_back(cells[c]);
+                }
+
+        // Removing and inserting entries degrades the quality of a packed
+        // tree. If most cells moved, packing the tree again is both faster
+        // and gives better query performance.
+        if (2 * affected_cells.size() > tria->n_active_cells())
+          build_cell_bounding_boxes_rtree();
+        else
+          {
+            for (const auto &cell : affected_cells)
+              {
+                BoundingBox<spacedim> &box =
+                  cell_bounding_boxes[cell->active_cell_index()];
+                cell_bounding_boxes_rtree.remove(std::make_pair(box, cell));
+                box = mapping->get_bounding_box(cell);
+                cell_bounding_boxes_rtree.insert(std::make_pair(box, cell));
+              }
+            moved_vertices_cell_bounding_boxes.clear();
+          }
       }
+
     return cell_bounding_boxes_rtree;
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::build_cell_bounding_boxes_rtree() const
+  {
+    std::vector<
+      std::pair<BoundingBox<spacedim>,
+                typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      boxes(tria->n_active_cells());
+    cell_bounding_boxes.resize(tria->n_active_cells());
+    for (const auto &cell : tria->active_cell_iterators())
+      {
+        cell_bounding_boxes[cell->active_cell_index()] =
+          mapping->get_bounding_box(cell);
+        boxes[cell->active_cell_index()] =
+          std::make_pair(cell_bounding_boxes[cell->active_cell_index()], cell);
+      }
+
+    cell_bounding_boxes_rtree = pack_rtree(boxes);
+    update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
+    moved_vertices_cell_bounding_boxes.clear();
+  }
+
+
+
   template <int dim, int spacedim>
   const RTree<std::pair<BoundingBox<spacedim>, unsigned int>> &
   Cache<dim, spacedim>::get_covering_rtree() const
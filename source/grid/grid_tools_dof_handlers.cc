@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
 
@@ -41,6 +42,8 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <list>
 #include <map>
 #include <numeric>
@@ -2028,14 +2031,12 @@ namespace GridTools
       &                       offset,
     const FullMatrix<double> &matrix)
   {
-    static const int space_dim = CellIterator::AccessorType::space_dimension;
-    (void)space_dim;
-    AssertIndexRange(direction, space_dim);
+    constexpr int dim      = CellIterator::AccessorType::dimension;
+    constexpr int spacedim = CellIterator::AccessorType::space_dimension;
+    AssertIndexRange(direction, spacedim);
 
 #ifdef DEBUG
     {
-      constexpr int dim      = CellIterator::AccessorType::dimension;
-      constexpr int spacedim = CellIterator::AccessorType::space_dimension;
       // For parallel::fullydistributed::Triangulation there might be unmatched
       // faces on periodic boundaries on the coarse grid, which results that
       // this assert is not fulfilled (not a bug!). See also the discussion in
@@ -2053,39 +2054,157 @@ namespace GridTools
     }
 #endif
 
-    unsigned int n_matches = 0;
-
-    // Match with a complexity of O(n^2). This could be improved...
-    std::bitset<3> orientation;
+    // Match the faces with a complexity of O(n log n): we bucket the faces
+    // in pairs2 by their centers, ignoring the component in the periodic
+    // direction, and only compare the faces of pairs1 with the faces in the
+    // buckets around their centers transformed by the matrix and the offset.
+    // The bucket size is chosen much larger than the tolerance of
+    // orthogonal_equality, so that matching faces are in the same or in
+    // adjacent buckets, but smaller than the faces, so that the buckets only
+    // contain a few faces.
     using PairIterator =
       typename std::set<std::pair<CellIterator, unsigned int>>::const_iterator;
-    for (PairIterator it1 = pairs1.begin(); it1 != pairs1.end(); ++it1)
+
+    const auto face_center = [](const CellIterator &cell,
+                                const unsigned int  face_no) {
+      Point<spacedim> center;
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_face; ++v)
+        center += cell->face(face_no)->vertex(v);
+      return center / static_cast<double>(GeometryInfo<dim>::vertices_per_face);
+    };
+
+    const std::vector<PairIterator> faces1 = [&pairs1]() {
+      std::vector<PairIterator> faces;
+      faces.reserve(pairs1.size());
+      for (PairIterator it = pairs1.begin(); it != pairs1.end(); ++it)
+        faces.push_back(it);
+      return faces;
+    }();
+    const std::vector<PairIterator> faces2 = [&pairs2]() {
+      std::vector<PairIterator> faces;
+      faces.reserve(pairs2.size());
+      for (PairIterator it = pairs2.begin(); it != pairs2.end(); ++it)
+        faces.push_back(it);
+      return faces;
+    }();
+
+    std::vector<Point<spacedim>> centers2(faces2.size());
+    double bucket_size = std::numeric_limits<double>::max();
+    for (unsigned int j = 0; j < faces2.size(); ++j)
       {
-        for (PairIterator it2 = pairs2.begin(); it2 != pairs2.end(); ++it2)
+        const CellIterator cell2     = faces2[j]->first;
+        const unsigned int face_idx2 = faces2[j]->second;
+        centers2[j]                  = face_center(cell2, face_idx2);
+        bucket_size                  = std::min(
+          bucket_size,
+          0.5 * centers2[j].distance(cell2->face(face_idx2)->vertex(0)));
+      }
+    bucket_size = std::max(bucket_size, 1e-8);
+
+    using BucketIndex    = std::array<std::int64_t, spacedim>;
+    const auto get_index = [&](const Point<spacedim> &center) {
+      BucketIndex index;
+      for (int d = 0; d < spacedim; ++d)
+        index[d] = (d == direction) ? 0 :
+                                      static_cast<std::int64_t>(
+                                        std::floor(center[d] / bucket_size));
+      return index;
+    };
+
+    std::map<BucketIndex, std::vector<unsigned int>> buckets;
+    for (unsigned int j = 0; j < faces2.size(); ++j)
+      buckets[get_index(centers2[j])].push_back(j);
+
+    // For each face in pairs1, collect all matching faces in pairs2 sorted by
+    // their position in pairs2. This is independent for each face and can
+    // run in parallel.
+    std::vector<std::vector<std::pair<unsigned int, std::bitset<3>>>>
+      candidates(faces1.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(faces1.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
           {
-            const CellIterator cell1     = it1->first;
-            const CellIterator cell2     = it2->first;
-            const unsigned int face_idx1 = it1->second;
-            const unsigned int face_idx2 = it2->second;
-            if (GridTools::orthogonal_equality(orientation,
-                                               cell1->face(face_idx1),
-                                               cell2->face(face_idx2),
-                                               direction,
-                                               offset,
-                                               matrix))
+            const CellIterator cell1     = faces1[i]->first;
+            const unsigned int face_idx1 = faces1[i]->second;
+
+            const Point<spacedim> center1 = face_center(cell1, face_idx1);
+            Point<spacedim>       transformed_center;
+            if (matrix.m() == spacedim)
+              for (int d = 0; d < spacedim; ++d)
+                for (int e = 0; e < spacedim; ++e)
+                  transformed_center(d) += matrix(d, e) * center1(e);
+            else
+              transformed_center = center1;
+            transformed_center += offset;
+
+            // loop over the 3^(spacedim-1) buckets around the transformed
+            // center
+            const BucketIndex center_index = get_index(transformed_center);
+            unsigned int      n_neighbors  = 1;
+            for (int d = 0; d < spacedim; ++d)
+              if (d != direction)
+                n_neighbors *= 3;
+            for (unsigned int n = 0; n < n_neighbors; ++n)
               {
-                // We have a match, so insert the matching pairs and
-                // remove the matched cell in pairs2 to speed up the
-                // matching:
-                const PeriodicFacePair<CellIterator> matched_face = {
-                  {cell1, cell2}, {face_idx1, face_idx2}, orientation, matrix};
-                matched_pairs.push_back(matched_face);
-                pairs2.erase(it2);
-                ++n_matches;
-                break;
+                BucketIndex  index     = center_index;
+                unsigned int remainder = n;
+                for (int d = 0; d < spacedim; ++d)
+                  if (d != direction)
+                    {
+                      index[d] += static_cast<int>(remainder % 3) - 1;
+                      remainder /= 3;
+                    }
+
+                const auto bucket = buckets.find(index);
+                if (bucket == buckets.end())
+                  continue;
+
+                for (const unsigned int j : bucket->second)
+                  {
+                    std::bitset<3> orientation;
+                    if (GridTools::orthogonal_equality(
+                          orientation,
+                          cell1->face(face_idx1),
+                          faces2[j]->first->face(faces2[j]->second),
+                          direction,
+                          offset,
+                          matrix))
+                      candidates[i].emplace_back(j, orientation);
+                  }
               }
+            std::sort(candidates[i].begin(),
+                      candidates[i].end(),
+                      [](const std::pair<unsigned int, std::bitset<3>> &a,
+                         const std::pair<unsigned int, std::bitset<3>> &b) {
+                        return a.first < b.first;
+                      });
           }
-      }
+      },
+      64);
+
+    // Now assign the matches in the order of pairs1, each face in pairs2 only
+    // once, and remove the matched faces from pairs2
+    unsigned int      n_matches = 0;
+    std::vector<bool> face2_is_matched(faces2.size(), false);
+    for (unsigned int i = 0; i < faces1.size(); ++i)
+      for (const auto &candidate : candidates[i])
+        if (face2_is_matched[candidate.first] == false)
+          {
+            const PeriodicFacePair<CellIterator> matched_face = {
+              {faces1[i]->first, faces2[candidate.first]->first},
+              {faces1[i]->second, faces2[candidate.first]->second},
+              candidate.second,
+              matrix};
+            matched_pairs.push_back(matched_face);
+            face2_is_matched[candidate.first] = true;
+            ++n_matches;
+            break;
+          }
+    for (unsigned int j = 0; j < faces2.size(); ++j)
+      if (face2_is_matched[j])
+        pairs2.erase(faces2[j]);
 
     // Assure that all faces are matched if not
     // parallel::fullydistributed::Triangulation is used. This is related to the
@@ -2093,8 +2212,6 @@ namespace GridTools
     // (not a bug!). See also the comment above and in the
     // method collect_periodic_faces.
     {
-      constexpr int dim      = CellIterator::AccessorType::dimension;
-      constexpr int spacedim = CellIterator::AccessorType::space_dimension;
       if (!(((pairs1.size() > 0) &&
              (dynamic_cast<const parallel::fullydistributed::
                              Triangulation<dim, spacedim> *>(
@@ -1677,7 +1677,9 @@ TransfiniteInterpolationManifold<dim, spacedim>::initialize(
   clear_signal = triangulation.signals.clear.connect([&]() -> void {
     this->triangulation = nullptr;
     this->level_coarse  = -1;
+    this->pull_back_cache.clear();
   });
+  pull_back_cache.clear();
   level_coarse = triangulation.last()->level();
   coarse_cell_is_flat.resize(triangulation.n_cells(level_coarse), false);
   typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -2310,9 +2312,6 @@ TransfiniteInterpolationManifold<dim, spacedim>::compute_chart_points(
          ExcMessage("The chart points array view must be as large as the "
                     "surrounding points array view."));
 
-  std::array<unsigned int, 20> nearby_cells =
-    get_possible_cells_around_points(surrounding_points);
-
   // This function is nearly always called to place new points on a cell or
   // cell face. In this case, the general structure of the surrounding points
   // is known (i.e., if there are eight surrounding points, then they will
@@ -2496,6 +2495,71 @@ TransfiniteInterpolationManifold<dim, spacedim>::compute_chart_points(
         }
     };
 
+  // The pull-backs of the surrounding points have often been computed
+  // before, either as surrounding points of a neighboring cell or as new
+  // points on the parent cell. If this is the case, we first try the chart
+  // of the cached points, with the cached chart points as initial guesses,
+  // which avoids the search over the coarse cells below in most cases.
+  auto &cache = pull_back_cache.get();
+
+  const auto add_to_cache =
+    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+      // limit the memory consumption of the cache by starting over if it
+      // gets too large
+      if (cache.size() > 100000)
+        cache.clear();
+      for (unsigned int i = 0; i < surrounding_points.size(); ++i)
+        cache[surrounding_points[i]] =
+          std::make_pair(static_cast<unsigned int>(cell->index()),
+                         chart_points[i]);
+    };
+
+  unsigned int cached_cell_index = numbers::invalid_unsigned_int;
+  for (unsigned int i = 0; i < surrounding_points.size(); ++i)
+    {
+      const auto entry = cache.find(surrounding_points[i]);
+      if (entry != cache.end())
+        {
+          cached_cell_index = entry->second.first;
+          break;
+        }
+    }
+
+  if (cached_cell_index != numbers::invalid_unsigned_int &&
+      cached_cell_index < coarse_cell_is_flat.size())
+    {
+      typename Triangulation<dim, spacedim>::cell_iterator cell(
+        triangulation, level_coarse, cached_cell_index);
+      bool inside_unit_cell = true;
+      for (unsigned int i = 0; i < surrounding_points.size(); ++i)
+        {
+          const auto entry = cache.find(surrounding_points[i]);
+          if (entry != cache.end() && entry->second.first == cached_cell_index)
+            chart_points[i] =
+              pull_back(cell, surrounding_points[i], entry->second.second);
+          else
+            chart_points[i][0] = internal::invalid_pull_back_coordinate;
+
+          if (chart_points[i][0] == internal::invalid_pull_back_coordinate)
+            compute_chart_point(cell, i);
+
+          if (GeometryInfo<dim>::is_inside_unit_cell(chart_points[i], 5e-4) ==
+              false)
+            {
+              inside_unit_cell = false;
+              break;
+            }
+        }
+      if (inside_unit_cell == true)
+        {
+          add_to_cache(cell);
+          return cell;
+        }
+    }
+
+  const std::array<unsigned int, 20> nearby_cells =
+    get_possible_cells_around_points(surrounding_points);
+
   // check whether all points are inside the unit cell of the current chart
   for (unsigned int c = 0; c < nearby_cells.size(); ++c)
     {
@@ -2517,6 +2581,7 @@ TransfiniteInterpolationManifold<dim, spacedim>::compute_chart_points(
         }
       if (inside_unit_cell == true)
         {
+          add_to_cache(cell);
           return cell;
         }
 
@@ -2576,7 +2641,14 @@ TransfiniteInterpolationManifold<dim, spacedim>::get_new_point(
   const Point<dim> p_chart =
     chart_manifold.get_new_point(chart_points_view, weights);
 
-  return push_forward(cell, p_chart);
+  const Point<spacedim> new_point = push_forward(cell, p_chart);
+
+  // the new point is likely to be a surrounding point in later calls, so
+  // remember its chart coordinates
+  pull_back_cache.get()[new_point] =
+    std::make_pair(static_cast<unsigned int>(cell->index()), p_chart);
+
+  return new_point;
 }
 
 
@@ -2604,8 +2676,14 @@ TransfiniteInterpolationManifold<dim, spacedim>::get_new_points(
                                 make_array_view(new_points_on_chart.begin(),
                                                 new_points_on_chart.end()));
 
+  auto &cache = pull_back_cache.get();
   for (unsigned int row = 0; row < weights.size(0); ++row)
-    new_points[row] = push_forward(cell, new_points_on_chart[row]);
+    {
+      new_points[row] = push_forward(cell, new_points_on_chart[row]);
+      cache[new_points[row]] =
+        std::make_pair(static_cast<unsigned int>(cell->index()),
+                       new_points_on_chart[row]);
+    }
 }
 
 
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
@@ -108,6 +109,95 @@ namespace internal
               MemoryConsumption::memory_consumption(n_active_hexes) +
               MemoryConsumption::memory_consumption(n_active_hexes_level));
     }
+
+
+
+    template <int dim, int spacedim>
+    CellGeometryCache<dim, spacedim>::CellGeometryCache()
+      : is_valid(false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    CellGeometryCache<dim, spacedim>::reinit(
+      const Triangulation<dim, spacedim> &tria)
+    {
+      // while the cache is invalid, the accessors compute the geometric data
+      // from the vertices, so we can simply use them to fill the arrays
+      clear();
+      if (tria.n_levels() == 0)
+        return;
+
+      const unsigned int n_cells    = tria.n_active_cells();
+      const unsigned int n_vertices = GeometryInfo<dim>::vertices_per_cell;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          vertices[d].resize(n_cells * n_vertices);
+          centers[d].resize(n_cells);
+          bounding_box_lower[d].resize(n_cells);
+          bounding_box_upper[d].resize(n_cells);
+        }
+      diameters.resize(n_cells);
+      measures.resize(n_cells);
+
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          const unsigned int c = cell->active_cell_index();
+          for (unsigned int v = 0; v < n_vertices; ++v)
+            {
+              const Point<spacedim> &vertex = cell->vertex(v);
+              for (unsigned int d = 0; d < spacedim; ++d)
+                vertices[d][c * n_vertices + v] = vertex[d];
+            }
+
+          const Point<spacedim>       center = cell->center();
+          const BoundingBox<spacedim> box    = cell->bounding_box();
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              centers[d][c]            = center[d];
+              bounding_box_lower[d][c] = box.get_boundary_points().first[d];
+              bounding_box_upper[d][c] = box.get_boundary_points().second[d];
+            }
+          diameters[c] = cell->diameter();
+          measures[c]  = cell->measure();
+        }
+
+      is_valid = true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    CellGeometryCache<dim, spacedim>::clear()
+    {
+      is_valid = false;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          vertices[d].clear();
+          centers[d].clear();
+          bounding_box_lower[d].clear();
+          bounding_box_upper[d].clear();
+        }
+      diameters.clear();
+      measures.clear();
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    CellGeometryCache<dim, spacedim>::memory_consumption() const
+    {
+      return (MemoryConsumption::memory_consumption(vertices) +
+              MemoryConsumption::memory_consumption(centers) +
+              MemoryConsumption::memory_consumption(diameters) +
+              MemoryConsumption::memory_consumption(measures) +
+              MemoryConsumption::memory_consumption(bounding_box_lower) +
+              MemoryConsumption::memory_consumption(bounding_box_upper));
+    }
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -4996,6 +5086,38 @@ namespace internal
 
 
 
+      /**
+       * Compute the locations of the vertices at the midpoints of refined
+       * lines from the manifold description of the lines. The given pairs
+       * contain the refined line and the index of its new vertex.
+       *
+       * The evaluation of the manifold only needs the vertices of the
+       * refined line, so the points can be computed independently of each
+       * other after the children have been set up sequentially. For curved
+       * manifolds, these evaluations make up a considerable part of the
+       * refinement cost, which is why they are done in parallel.
+       */
+      template <int dim, int spacedim>
+      static void
+      compute_new_line_vertices(
+        Triangulation<dim, spacedim> &triangulation,
+        const std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::line_iterator,
+                    unsigned int>> &new_line_vertices)
+      {
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(new_line_vertices.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              triangulation.vertices[new_line_vertices[i].second] =
+                new_line_vertices[i].first->center(true);
+          },
+          512);
+      }
+
+
+
       /**
        * A function that performs the
        * refinement of a triangulation in 1d.
@@ -5416,6 +5538,12 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          std::vector<
+            std::pair<typename Triangulation<dim, spacedim>::line_iterator,
+                      unsigned int>>
+            new_line_vertices;
+          new_line_vertices.reserve(n_lines_in_pairs / 2);
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5431,11 +5559,11 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                // the location of the new vertex is computed below
+                new_line_vertices.emplace_back(line, next_unused_vertex);
 
-                // now that we created the right point, make up the
-                // two child lines.  To this end, find a pair of
-                // unused lines
+                // now make up the two child lines.  To this end, find
+                // a pair of unused lines
                 bool pair_found = false;
                 (void)pair_found;
                 for (; next_unused_line != endl; ++next_unused_line)
@@ -5494,6 +5622,8 @@ namespace internal
                 // refinement
                 line->clear_user_flag();
               }
+
+          compute_new_line_vertices(triangulation, new_line_vertices);
         }
 
 
@@ -5890,6 +6020,11 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          std::vector<
+            std::pair<typename Triangulation<dim, spacedim>::line_iterator,
+                      unsigned int>>
+            new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5905,11 +6040,11 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                // the location of the new vertex is computed below
+                new_line_vertices.emplace_back(line, next_unused_vertex);
 
-                // now that we created the right point, make up the
-                // two child lines (++ takes care of the end of the
-                // vector)
+                // now make up the two child lines (++ takes care of the
+                // end of the vector)
                 next_unused_line =
                   triangulation.faces->lines.template next_free_pair_object<1>(
                     triangulation);
@@ -5961,6 +6096,8 @@ namespace internal
                 // for refinement
                 line->clear_user_flag();
               }
+
+          compute_new_line_vertices(triangulation, new_line_vertices);
         }
 
 
@@ -10364,6 +10501,14 @@ Triangulation<dim, spacedim>::Triangulation(
   , vertex_to_manifold_id_map_1d(std::move(tria.vertex_to_manifold_id_map_1d))
 {
   tria.number_cache = internal::TriangulationImplementation::NumberCache<dim>();
+
+  // the signals are not moved, so connect a new cache to the signals of
+  // this object
+  if (tria.cell_geometry_cache != nullptr)
+    {
+      tria.enable_cell_geometry_cache(false);
+      enable_cell_geometry_cache();
+    }
 }
 
 
@@ -10374,6 +10519,10 @@ operator=(Triangulation<dim, spacedim> &&tria) noexcept
 {
   Subscriptor::operator=(std::move(tria));
 
+  const bool use_cell_geometry_cache = tria.cell_geometry_cache != nullptr;
+  tria.enable_cell_geometry_cache(false);
+  enable_cell_geometry_cache(false);
+
   smooth_grid                  = tria.smooth_grid;
   periodic_face_pairs_level_0  = std::move(tria.periodic_face_pairs_level_0);
   periodic_face_map            = std::move(tria.periodic_face_map);
@@ -10389,6 +10538,9 @@ operator=(Triangulation<dim, spacedim> &&tria) noexcept
 
   tria.number_cache = internal::TriangulationImplementation::NumberCache<dim>();
 
+  if (use_cell_geometry_cache)
+    enable_cell_geometry_cache();
+
   return *this;
 }
 
@@ -13033,6 +13185,62 @@ Triangulation<dim, spacedim>::has_hanging_nodes() const
 }
 
 
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::enable_cell_geometry_cache(const bool enable)
+{
+  if (enable == false)
+    {
+      if (cell_geometry_cache != nullptr)
+        for (auto &connection : cell_geometry_cache->connections)
+          connection.disconnect();
+      cell_geometry_cache.reset();
+      return;
+    }
+
+  if (cell_geometry_cache != nullptr)
+    return;
+
+  cell_geometry_cache = std::make_unique<
+    internal::TriangulationImplementation::CellGeometryCache<dim, spacedim>>();
+
+  // connect at the front of the signals, so that other functions attached to
+  // the signals already see the updated cache
+  auto *     cache      = cell_geometry_cache.get();
+  const auto update     = [this, cache]() { cache->reinit(*this); };
+  const auto invalidate = [cache]() { cache->clear(); };
+  cache->connections = {
+    signals.create.connect(update, boost::signals2::at_front),
+    signals.post_refinement.connect(update, boost::signals2::at_front),
+    signals.mesh_movement.connect(update, boost::signals2::at_front),
+    signals.pre_refinement.connect(invalidate, boost::signals2::at_front),
+    signals.clear.connect(invalidate, boost::signals2::at_front)};
+
+  cache->reinit(*this);
+}
+
+
+
+template <int dim, int spacedim>
+bool
+Triangulation<dim, spacedim>::cell_geometry_cache_is_enabled() const
+{
+  return cell_geometry_cache != nullptr;
+}
+
+
+
+template <int dim, int spacedim>
+const internal::TriangulationImplementation::CellGeometryCache<dim, spacedim> &
+Triangulation<dim, spacedim>::get_cell_geometry_cache() const
+{
+  Assert(cell_geometry_cache != nullptr,
+         ExcMessage("The cell geometry cache has not been enabled."));
+  return *cell_geometry_cache;
+}
+
+
+
 template <int dim, int spacedim>
 unsigned int
 Triangulation<dim, spacedim>::n_lines() const
@@ -15385,6 +15593,8 @@ Triangulation<dim, spacedim>::memory_consumption() const
   mem += sizeof(faces);
   if (faces)
     mem += MemoryConsumption::memory_consumption(*faces);
+  if (cell_geometry_cache)
+    mem += cell_geometry_cache->memory_consumption();
 
   return mem;
 }
@@ -1541,6 +1541,12 @@ template <int structdim, int dim, int spacedim>
 double
 TriaAccessor<structdim, dim, spacedim>::measure() const
 {
+  unsigned int index = 0;
+  if (const auto *cache =
+        internal::TriaAccessorImplementation::Implementation::
+          cell_geometry_cache(*this, index))
+    return cache->measures[index];
+
   // call the function in the anonymous
   // namespace above
   return dealii::measure(*this);
@@ -1552,6 +1558,20 @@ template <int structdim, int dim, int spacedim>
 BoundingBox<spacedim>
 TriaAccessor<structdim, dim, spacedim>::bounding_box() const
 {
+  unsigned int index = 0;
+  if (const auto *cache =
+        internal::TriaAccessorImplementation::Implementation::
+          cell_geometry_cache(*this, index))
+    {
+      std::pair<Point<spacedim>, Point<spacedim>> boundary_points;
+      for (unsigned int k = 0; k < spacedim; ++k)
+        {
+          boundary_points.first[k]  = cache->bounding_box_lower[k][index];
+          boundary_points.second[k] = cache->bounding_box_upper[k][index];
+        }
+      return BoundingBox<spacedim>(boundary_points);
+    }
+
   std::pair<Point<spacedim>, Point<spacedim>> boundary_points =
     std::make_pair(this->vertex(0), this->vertex(0));
 
@@ -1832,6 +1852,18 @@ TriaAccessor<structdim, dim, spacedim>::center(
   if (respect_manifold == false)
     {
       Assert(use_interpolation == false, ExcNotImplemented());
+
+      unsigned int index = 0;
+      if (const auto *cache =
+            internal::TriaAccessorImplementation::Implementation::
+              cell_geometry_cache(*this, index))
+        {
+          Point<spacedim> p;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            p[d] = cache->centers[d][index];
+          return p;
+        }
+
       Point<spacedim> p;
       for (const unsigned int v : GeometryInfo<structdim>::vertex_indices())
         p += vertex(v);
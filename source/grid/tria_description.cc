@@ -25,6 +25,14 @@
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_description.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -142,6 +150,59 @@ namespace TriangulationDescription
 
         return level_coarse_cell_id;
       }
+
+
+
+      /**
+       * A coarse cell in terms of global vertex indices together with the
+       * coordinates of its vertices, as exchanged between the processes in
+       * create_description_from_distributed_coarse_grid().
+       */
+      template <int dim, int spacedim>
+      struct DistributedCoarseCell
+      {
+        /**
+         * Boost serialization function
+         */
+        template <class Archive>
+        void
+        serialize(Archive &ar, const unsigned int /*version*/)
+        {
+          ar &id;
+          ar &cell_data;
+          ar &vertices;
+        }
+
+        /**
+         * Global coarse-cell id.
+         */
+        types::coarse_cell_id id;
+
+        /**
+         * Cell definition with global vertex indices.
+         */
+        dealii::CellData<dim> cell_data;
+
+        /**
+         * Coordinates of the vertices of the cell.
+         */
+        std::vector<Point<spacedim>> vertices;
+      };
+
+
+
+      /**
+       * Return the rank that owns the entry @p index of a partitioning in
+       * which the ranks own contiguous ranges given by @p offsets.
+       */
+      unsigned int
+      find_owner_of_index(const std::vector<std::size_t> &offsets,
+                          const std::size_t               index)
+      {
+        AssertIndexRange(index, offsets.back());
+        return std::upper_bound(offsets.begin(), offsets.end(), index) -
+               offsets.begin() - 1;
+      }
     } // namespace
 
 
@@ -572,6 +633,332 @@ namespace TriangulationDescription
 #endif
     }
 
+
+
+    template <int dim, int spacedim>
+    Description<dim, spacedim>
+    create_description_from_distributed_coarse_grid(
+      const std::vector<Point<spacedim>> &      local_vertices,
+      const std::vector<dealii::CellData<dim>> &local_cells,
+      const MPI_Comm                            comm,
+      const typename Triangulation<dim, spacedim>::MeshSmoothing smoothing,
+      const TriangulationDescription::Settings                   settings)
+    {
+      const unsigned int n_ranks =
+        dealii::Utilities::MPI::n_mpi_processes(comm);
+      const unsigned int my_rank =
+        dealii::Utilities::MPI::this_mpi_process(comm);
+
+      // 1) determine the global numbering of vertices and cells, which are
+      //    both numbered contiguously in the order of the ranks
+      const auto compute_offsets = [&](const std::size_t local_size) {
+        const std::vector<std::size_t> sizes =
+          dealii::Utilities::MPI::all_gather(comm, local_size);
+        std::vector<std::size_t> offsets(n_ranks + 1, 0);
+        std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+        return offsets;
+      };
+      const std::vector<std::size_t> vertex_offsets =
+        compute_offsets(local_vertices.size());
+      const std::vector<std::size_t> cell_offsets =
+        compute_offsets(local_cells.size());
+
+      // 2) fetch the coordinates of the vertices of the local cells from the
+      //    processes owning them
+      std::map<unsigned int, Point<spacedim>> vertex_coordinates;
+      {
+        std::map<unsigned int, std::vector<unsigned int>> requested_vertices;
+        for (const auto &cell : local_cells)
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            requested_vertices[find_owner_of_index(vertex_offsets,
+                                                   cell.vertices[v])]
+              .push_back(cell.vertices[v]);
+
+        for (auto &request : requested_vertices)
+          {
+            std::sort(request.second.begin(), request.second.end());
+            request.second.erase(std::unique(request.second.begin(),
+                                             request.second.end()),
+                                 request.second.end());
+          }
+
+        std::map<unsigned int, std::vector<Point<spacedim>>> answers;
+        for (const auto &request :
+             dealii::Utilities::MPI::some_to_some(comm, requested_vertices))
+          {
+            auto &answer = answers[request.first];
+            answer.reserve(request.second.size());
+            for (const unsigned int v : request.second)
+              answer.push_back(local_vertices[v - vertex_offsets[my_rank]]);
+          }
+
+        const auto received_coordinates =
+          dealii::Utilities::MPI::some_to_some(comm, answers);
+        for (const auto &request : requested_vertices)
+          {
+            const auto &points = received_coordinates.at(request.first);
+            AssertDimension(points.size(), request.second.size());
+            for (unsigned int i = 0; i < points.size(); ++i)
+              vertex_coordinates[request.second[i]] = points[i];
+          }
+      }
+
+      // 3) compute the position of the center of each local cell along a
+      //    space-filling curve (Morton order) through the global bounding
+      //    box of the cell centers
+      std::vector<std::pair<std::uint64_t, unsigned int>> cell_keys;
+      {
+        std::vector<Point<spacedim>> centers(local_cells.size());
+        std::vector<double> lower(spacedim, std::numeric_limits<double>::max());
+        std::vector<double> upper(spacedim,
+                                  -std::numeric_limits<double>::max());
+        for (unsigned int c = 0; c < local_cells.size(); ++c)
+          {
+            for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+              centers[c] += vertex_coordinates[local_cells[c].vertices[v]];
+            centers[c] /= GeometryInfo<dim>::vertices_per_cell;
+
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                lower[d] = std::min(lower[d], centers[c][d]);
+                upper[d] = std::max(upper[d], centers[c][d]);
+              }
+          }
+        dealii::Utilities::MPI::min(lower, comm, lower);
+        dealii::Utilities::MPI::max(upper, comm, upper);
+
+        // use at most 63 bits for the key, such that the bisection below can
+        // use the value 2^63 as upper bound
+        const unsigned int  bits_per_direction = std::min(31, 63 / spacedim);
+        const std::uint64_t n_intervals = std::uint64_t(1)
+                                          << bits_per_direction;
+
+        cell_keys.reserve(local_cells.size());
+        for (unsigned int c = 0; c < local_cells.size(); ++c)
+          {
+            std::array<std::uint64_t, spacedim> coordinates;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                const double extent = upper[d] - lower[d];
+                const double x =
+                  extent > 0. ? (centers[c][d] - lower[d]) / extent : 0.;
+                coordinates[d] =
+                  std::min(static_cast<std::uint64_t>(x * n_intervals),
+                           n_intervals - 1);
+              }
+
+            std::uint64_t key = 0;
+            for (unsigned int b = 0; b < bits_per_direction; ++b)
+              for (unsigned int d = 0; d < spacedim; ++d)
+                key |= ((coordinates[d] >> b) & 1) << (b * spacedim + d);
+            cell_keys.emplace_back(key, c);
+          }
+        std::sort(cell_keys.begin(), cell_keys.end());
+      }
+
+      // 4) split the curve into pieces with the same number of cells. the
+      //    keys at which the curve is split are determined by a simultaneous
+      //    bisection for all pieces, which needs one reduction per bit of the
+      //    keys
+      std::vector<std::uint64_t> split_keys(n_ranks - 1, 0);
+      {
+        std::vector<std::uint64_t> upper_keys(n_ranks - 1,
+                                              std::uint64_t(1) << 63);
+        std::vector<std::uint64_t> trial_keys(n_ranks - 1);
+        std::vector<std::uint64_t> n_cells_before(n_ranks - 1);
+        while (split_keys != upper_keys)
+          {
+            for (unsigned int r = 0; r < n_ranks - 1; ++r)
+              {
+                trial_keys[r] =
+                  split_keys[r] + (upper_keys[r] - split_keys[r]) / 2;
+                n_cells_before[r] =
+                  std::lower_bound(cell_keys.begin(),
+                                   cell_keys.end(),
+                                   std::make_pair(trial_keys[r], 0U)) -
+                  cell_keys.begin();
+              }
+            dealii::Utilities::MPI::sum(n_cells_before, comm, n_cells_before);
+
+            // search the smallest key, such that the cells before it fill
+            // the first r+1 pieces
+            for (unsigned int r = 0; r < n_ranks - 1; ++r)
+              if (split_keys[r] != upper_keys[r])
+                {
+                  if (n_cells_before[r] >=
+                      cell_offsets.back() * (r + 1) / n_ranks)
+                    upper_keys[r] = trial_keys[r];
+                  else
+                    split_keys[r] = trial_keys[r] + 1;
+                }
+          }
+      }
+
+      // 5) send the cells to the processes owning the respective pieces
+      std::vector<DistributedCoarseCell<dim, spacedim>> owned_cells;
+      {
+        std::map<unsigned int,
+                 std::vector<DistributedCoarseCell<dim, spacedim>>>
+          cells_to_send;
+        for (const auto &cell_key : cell_keys)
+          {
+            DistributedCoarseCell<dim, spacedim> cell;
+            cell.id        = cell_offsets[my_rank] + cell_key.second;
+            cell.cell_data = local_cells[cell_key.second];
+            for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+              cell.vertices.push_back(
+                vertex_coordinates[cell.cell_data.vertices[v]]);
+
+            const unsigned int destination =
+              std::upper_bound(split_keys.begin(),
+                               split_keys.end(),
+                               cell_key.first) -
+              split_keys.begin();
+            cells_to_send[destination].push_back(cell);
+          }
+
+        for (const auto &received_cells :
+             dealii::Utilities::MPI::some_to_some(comm, cells_to_send))
+          owned_cells.insert(owned_cells.end(),
+                             received_cells.second.begin(),
+                             received_cells.second.end());
+      }
+
+      // 6) determine the ghost cells, i.e., the cells of other processes
+      //    that share a vertex with the locally owned cells. for this, the
+      //    owners of the vertices collect which processes use each vertex,
+      //    and tell the processes about each other.
+      std::map<unsigned int, std::vector<DistributedCoarseCell<dim, spacedim>>>
+        ghost_cells;
+      {
+        std::map<unsigned int, std::vector<unsigned int>> used_vertices;
+        for (const auto &cell : owned_cells)
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            used_vertices[find_owner_of_index(vertex_offsets,
+                                              cell.cell_data.vertices[v])]
+              .push_back(cell.cell_data.vertices[v]);
+
+        for (auto &vertices : used_vertices)
+          {
+            std::sort(vertices.second.begin(), vertices.second.end());
+            vertices.second.erase(std::unique(vertices.second.begin(),
+                                              vertices.second.end()),
+                                  vertices.second.end());
+          }
+
+        std::map<unsigned int, std::vector<unsigned int>> vertex_to_ranks;
+        for (const auto &reported :
+             dealii::Utilities::MPI::some_to_some(comm, used_vertices))
+          for (const unsigned int v : reported.second)
+            vertex_to_ranks[v].push_back(reported.first);
+
+        // send pairs of a vertex and another process using it, stored one
+        // after the other
+        std::map<unsigned int, std::vector<unsigned int>> shared_vertices;
+        for (const auto &vertex : vertex_to_ranks)
+          for (const unsigned int rank : vertex.second)
+            for (const unsigned int other_rank : vertex.second)
+              if (rank != other_rank)
+                {
+                  shared_vertices[rank].push_back(vertex.first);
+                  shared_vertices[rank].push_back(other_rank);
+                }
+
+        std::map<unsigned int, std::vector<unsigned int>>
+          vertex_to_other_ranks;
+        for (const auto &received :
+             dealii::Utilities::MPI::some_to_some(comm, shared_vertices))
+          for (unsigned int i = 0; i < received.second.size(); i += 2)
+            vertex_to_other_ranks[received.second[i]].push_back(
+              received.second[i + 1]);
+
+        std::map<unsigned int,
+                 std::vector<DistributedCoarseCell<dim, spacedim>>>
+          cells_to_send;
+        for (const auto &cell : owned_cells)
+          {
+            std::set<unsigned int> ranks;
+            for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+              {
+                const auto other_ranks =
+                  vertex_to_other_ranks.find(cell.cell_data.vertices[v]);
+                if (other_ranks != vertex_to_other_ranks.end())
+                  ranks.insert(other_ranks->second.begin(),
+                               other_ranks->second.end());
+              }
+            for (const unsigned int rank : ranks)
+              cells_to_send[rank].push_back(cell);
+          }
+
+        ghost_cells =
+          dealii::Utilities::MPI::some_to_some(comm, cells_to_send);
+      }
+
+      // 7) set up the description from the locally owned and the ghost
+      //    cells, sorted by their coarse-cell id
+      std::vector<
+        std::pair<const DistributedCoarseCell<dim, spacedim> *, unsigned int>>
+        relevant_cells;
+      for (const auto &cell : owned_cells)
+        relevant_cells.emplace_back(&cell, my_rank);
+      for (const auto &cells : ghost_cells)
+        for (const auto &cell : cells.second)
+          relevant_cells.emplace_back(&cell, cells.first);
+      std::sort(relevant_cells.begin(),
+                relevant_cells.end(),
+                [](const auto &a, const auto &b) {
+                  return a.first->id < b.first->id;
+                });
+
+      Description<dim, spacedim> construction_data;
+      construction_data.comm     = comm;
+      construction_data.settings = settings;
+      construction_data.smoothing =
+        (settings &
+         TriangulationDescription::Settings::construct_multigrid_hierarchy) ?
+          static_cast<
+            typename dealii::Triangulation<dim, spacedim>::MeshSmoothing>(
+            smoothing |
+            Triangulation<dim, spacedim>::limit_level_difference_at_vertices) :
+          smoothing;
+      construction_data.cell_infos.resize(1);
+
+      std::map<unsigned int, unsigned int> local_vertex_indices;
+      for (const auto &relevant_cell : relevant_cells)
+        {
+          const DistributedCoarseCell<dim, spacedim> &cell =
+            *relevant_cell.first;
+
+          // translate the vertices to the local numbering
+          dealii::CellData<dim> cell_data = cell.cell_data;
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            {
+              const auto local_index = local_vertex_indices.emplace(
+                cell.cell_data.vertices[v],
+                construction_data.coarse_cell_vertices.size());
+              if (local_index.second)
+                construction_data.coarse_cell_vertices.push_back(
+                  cell.vertices[v]);
+              cell_data.vertices[v] = local_index.first->second;
+            }
+          construction_data.coarse_cells.push_back(cell_data);
+          construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+            cell.id);
+
+          CellData<dim> cell_info;
+          cell_info.id = CellId(cell.id, std::vector<std::uint8_t>())
+                           .template to_binary<dim>();
+          cell_info.subdomain_id       = relevant_cell.second;
+          cell_info.level_subdomain_id = relevant_cell.second;
+          cell_info.manifold_id        = cell.cell_data.manifold_id;
+          cell_info.manifold_line_ids.fill(numbers::flat_manifold_id);
+          cell_info.manifold_quad_ids.fill(numbers::flat_manifold_id);
+          construction_data.cell_infos[0].push_back(cell_info);
+        }
+
+      return construction_data;
+    }
+
   } // namespace Utilities
 } // namespace TriangulationDescription
 
@@ -59,8 +59,7 @@ namespace hp
           FiniteElementDomination::no_requirements;
         for (const auto &other_fe : fes)
           domination =
-            domination & finite_elements[current_fe]->compare_for_domination(
-                           *finite_elements[other_fe], codim);
+            domination & compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe dominates, add it to the set.
         if ((domination == FiniteElementDomination::this_element_dominates) ||
@@ -99,8 +98,7 @@ namespace hp
           FiniteElementDomination::no_requirements;
         for (const auto &other_fe : fes)
           domination =
-            domination & finite_elements[current_fe]->compare_for_domination(
-                           *finite_elements[other_fe], codim);
+            domination & compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe is dominated, add it to the set.
         if ((domination == FiniteElementDomination::other_element_dominates) ||
@@ -143,8 +141,8 @@ namespace hp
         for (const auto &other_fe : fes)
           if (current_fe != other_fe)
             domination =
-              domination & finite_elements[current_fe]->compare_for_domination(
-                             *finite_elements[other_fe], codim);
+              domination &
+              compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe dominates, return its index.
         if ((domination == FiniteElementDomination::this_element_dominates) ||
@@ -189,8 +187,8 @@ namespace hp
         for (const auto &other_fe : fes)
           if (current_fe != other_fe)
             domination =
-              domination & finite_elements[current_fe]->compare_for_domination(
-                             *finite_elements[other_fe], codim);
+              domination &
+              compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe is dominated, return its index.
         if ((domination == FiniteElementDomination::other_element_dominates) ||
@@ -293,6 +291,116 @@ namespace hp
                         "same number of vector components!"));
 
     finite_elements.push_back(new_fe.clone());
+
+    // any information on pairs of elements refers to the old set of
+    // elements. start over with an empty cache
+    pair_cache = std::make_shared<PairCache>(finite_elements.size());
+  }
+
+
+
+  template <int dim, int spacedim>
+  FECollection<dim, spacedim>::PairCache::PairCache(
+    const unsigned int n_elements)
+    : domination(n_elements, n_elements, dim + 1)
+    , domination_computed(n_elements, n_elements, dim + 1)
+    , face_interpolation_matrices(n_elements, n_elements)
+    , subface_interpolation_matrices(n_elements,
+                                     n_elements,
+                                     GeometryInfo<dim>::max_children_per_face)
+  {}
+
+
+
+  template <int dim, int spacedim>
+  FiniteElementDomination::Domination
+  FECollection<dim, spacedim>::compare_for_domination(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int codim) const
+  {
+    AssertIndexRange(fe_index_1, finite_elements.size());
+    AssertIndexRange(fe_index_2, finite_elements.size());
+    AssertIndexRange(codim, dim + 1);
+    Assert(pair_cache != nullptr, ExcInternalError());
+
+    std::lock_guard<std::mutex> lock(pair_cache->mutex);
+    if (pair_cache->domination_computed(fe_index_1, fe_index_2, codim) ==
+        false)
+      {
+        pair_cache->domination(fe_index_1, fe_index_2, codim) =
+          finite_elements[fe_index_1]->compare_for_domination(
+            *finite_elements[fe_index_2], codim);
+        pair_cache->domination_computed(fe_index_1, fe_index_2, codim) = true;
+      }
+
+    return pair_cache->domination(fe_index_1, fe_index_2, codim);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const FullMatrix<double> &
+  FECollection<dim, spacedim>::get_face_interpolation_matrix(
+    const unsigned int fe_index,
+    const unsigned int source_fe_index) const
+  {
+    AssertIndexRange(fe_index, finite_elements.size());
+    AssertIndexRange(source_fe_index, finite_elements.size());
+    Assert(pair_cache != nullptr, ExcInternalError());
+
+    std::lock_guard<std::mutex> lock(pair_cache->mutex);
+    std::unique_ptr<const FullMatrix<double>> &matrix =
+      pair_cache->face_interpolation_matrices(fe_index, source_fe_index);
+    if (matrix == nullptr)
+      {
+        const FiniteElement<dim, spacedim> &fe = *finite_elements[fe_index];
+        const FiniteElement<dim, spacedim> &source_fe =
+          *finite_elements[source_fe_index];
+
+        auto new_matrix =
+          std::make_unique<FullMatrix<double>>(source_fe.dofs_per_face,
+                                               fe.dofs_per_face);
+        fe.get_face_interpolation_matrix(source_fe, *new_matrix);
+        matrix = std::move(new_matrix);
+      }
+
+    return *matrix;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const FullMatrix<double> &
+  FECollection<dim, spacedim>::get_subface_interpolation_matrix(
+    const unsigned int fe_index,
+    const unsigned int source_fe_index,
+    const unsigned int subface) const
+  {
+    AssertIndexRange(fe_index, finite_elements.size());
+    AssertIndexRange(source_fe_index, finite_elements.size());
+    AssertIndexRange(subface, GeometryInfo<dim>::max_children_per_face);
+    Assert(pair_cache != nullptr, ExcInternalError());
+
+    std::lock_guard<std::mutex> lock(pair_cache->mutex);
+    std::unique_ptr<const FullMatrix<double>> &matrix =
+      pair_cache->subface_interpolation_matrices(fe_index,
+                                                 source_fe_index,
+                                                 subface);
+    if (matrix == nullptr)
+      {
+        const FiniteElement<dim, spacedim> &fe = *finite_elements[fe_index];
+        const FiniteElement<dim, spacedim> &source_fe =
+          *finite_elements[source_fe_index];
+
+        auto new_matrix =
+          std::make_unique<FullMatrix<double>>(source_fe.dofs_per_face,
+                                               fe.dofs_per_face);
+        fe.get_subface_interpolation_matrix(source_fe, subface, *new_matrix);
+        matrix = std::move(new_matrix);
+      }
+
+    return *matrix;
   }
 
 
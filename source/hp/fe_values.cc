@@ -530,6 +530,38 @@ namespace hp
     this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
       .reinit(cell, face_no, subface_no);
   }
+
+
+
+  template <typename DoFHandlerType>
+  std::vector<typename DoFHandlerType::active_cell_iterator>
+  active_cells_sorted_by_fe_index(const DoFHandlerType &dof_handler)
+  {
+    // sort the cells with a counting sort, which keeps the original order
+    // of the cells within each group: first count the number of cells for
+    // each active FE index, then put every cell into the next free slot of
+    // its group
+    std::vector<unsigned int> group_start;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const unsigned int fe_index = cell->active_fe_index();
+          if (fe_index + 1 >= group_start.size())
+            group_start.resize(fe_index + 2, 0);
+          ++group_start[fe_index + 1];
+        }
+
+    for (unsigned int i = 1; i < group_start.size(); ++i)
+      group_start[i] += group_start[i - 1];
+
+    std::vector<typename DoFHandlerType::active_cell_iterator> cells(
+      group_start.empty() ? 0 : group_start.back());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        cells[group_start[cell->active_fe_index()]++] = cell;
+
+    return cells;
+  }
 } // namespace hp
 
 
@@ -36,6 +36,48 @@ namespace hp
 {
   namespace Refinement
   {
+    namespace
+    {
+      /**
+       * Assign the next finite element in the hierarchy of the collection as
+       * the future finite element on @p cell if it is flagged for refinement,
+       * or the previous one if it is flagged for coarsening. This is the
+       * per-cell kernel of p_adaptivity_from_flags(), shared by all functions
+       * that decide about p-adaptation while traversing the active cells so
+       * that none of them needs to build an intermediate vector of flags.
+       */
+      template <int dim, int spacedim>
+      inline void
+      set_future_fe_index_from_h_flag(
+        const hp::DoFHandler<dim, spacedim> &dof_handler,
+        const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+          &cell)
+      {
+        if (cell->refine_flag_set())
+          {
+            const unsigned int super_fe_index =
+              dof_handler.get_fe_collection().next_in_hierarchy(
+                cell->active_fe_index());
+
+            // Reject update if already most superordinate element.
+            if (super_fe_index != cell->active_fe_index())
+              cell->set_future_fe_index(super_fe_index);
+          }
+        else if (cell->coarsen_flag_set())
+          {
+            const unsigned int sub_fe_index =
+              dof_handler.get_fe_collection().previous_in_hierarchy(
+                cell->active_fe_index());
+
+            // Reject update if already least subordinate element.
+            if (sub_fe_index != cell->active_fe_index())
+              cell->set_future_fe_index(sub_fe_index);
+          }
+      }
+    } // namespace
+
+
+
     /**
      * Setting p adaptivity flags
      */
@@ -43,10 +85,9 @@ namespace hp
     void
     full_p_adaptivity(const hp::DoFHandler<dim, spacedim> &dof_handler)
     {
-      std::vector<bool> p_flags(
-        dof_handler.get_triangulation().n_active_cells(), true);
-
-      p_adaptivity_from_flags(dof_handler, p_flags);
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          set_future_fe_index_from_h_flag(dof_handler, cell);
     }
 
 
@@ -61,28 +102,7 @@ namespace hp
 
       for (const auto &cell : dof_handler.active_cell_iterators())
         if (cell->is_locally_owned() && p_flags[cell->active_cell_index()])
-          {
-            if (cell->refine_flag_set())
-              {
-                const unsigned int super_fe_index =
-                  dof_handler.get_fe_collection().next_in_hierarchy(
-                    cell->active_fe_index());
-
-                // Reject update if already most superordinate element.
-                if (super_fe_index != cell->active_fe_index())
-                  cell->set_future_fe_index(super_fe_index);
-              }
-            else if (cell->coarsen_flag_set())
-              {
-                const unsigned int sub_fe_index =
-                  dof_handler.get_fe_collection().previous_in_hierarchy(
-                    cell->active_fe_index());
-
-                // Reject update if already least subordinate element.
-                if (sub_fe_index != cell->active_fe_index())
-                  cell->set_future_fe_index(sub_fe_index);
-              }
-          }
+          set_future_fe_index_from_h_flag(dof_handler, cell);
     }
 
 
@@ -101,9 +121,7 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       criteria.size());
 
-      std::vector<bool> p_flags(
-        dof_handler.get_triangulation().n_active_cells(), false);
-
+      // Decide and assign future finite elements in the same traversal.
       for (const auto &cell : dof_handler.active_cell_iterators())
         if (cell->is_locally_owned() &&
             ((cell->refine_flag_set() &&
@@ -112,9 +130,7 @@ namespace hp
              (cell->coarsen_flag_set() &&
               compare_coarsen(criteria[cell->active_cell_index()],
                               p_coarsen_threshold))))
-          p_flags[cell->active_cell_index()] = true;
-
-      p_adaptivity_from_flags(dof_handler, p_flags);
+          set_future_fe_index_from_h_flag(dof_handler, cell);
     }
 
 
@@ -174,18 +190,21 @@ namespace hp
           dynamic_cast<const parallel::shared::Triangulation<dim, spacedim> *>(
             &dof_handler.get_triangulation()) == nullptr)
         {
-          max_criterion_refine =
-            Utilities::MPI::max(max_criterion_refine,
-                                parallel_tria->get_communicator());
-          min_criterion_refine =
-            Utilities::MPI::min(min_criterion_refine,
-                                parallel_tria->get_communicator());
-          max_criterion_coarsen =
-            Utilities::MPI::max(max_criterion_coarsen,
-                                parallel_tria->get_communicator());
-          min_criterion_coarsen =
-            Utilities::MPI::min(min_criterion_coarsen,
-                                parallel_tria->get_communicator());
+          // Merge all four extrema into a single collective operation:
+          // maxima are communicated as minima of their negated values.
+          const Number local_extrema[4] = {-max_criterion_refine,
+                                           min_criterion_refine,
+                                           -max_criterion_coarsen,
+                                           min_criterion_coarsen};
+          Number       global_extrema[4];
+          Utilities::MPI::min(local_extrema,
+                              parallel_tria->get_communicator(),
+                              global_extrema);
+
+          max_criterion_refine  = -global_extrema[0];
+          min_criterion_refine  = global_extrema[1];
+          max_criterion_coarsen = -global_extrema[2];
+          min_criterion_coarsen = global_extrema[3];
         }
 
       // Absent any better strategies, we will set the threshold by linear
@@ -297,10 +316,13 @@ namespace hp
 
           // 2.) Communicate the number of cells scheduled for p-adaptation
           //     globally.
-          const unsigned int n_global_flags_refinement =
-            Utilities::MPI::sum(n_flags_refinement, mpi_communicator);
-          const unsigned int n_global_flags_coarsening =
-            Utilities::MPI::sum(n_flags_coarsening, mpi_communicator);
+          const unsigned int n_local_flags[2] = {n_flags_refinement,
+                                                 n_flags_coarsening};
+          unsigned int       n_global_flags[2];
+          Utilities::MPI::sum(n_local_flags, mpi_communicator, n_global_flags);
+
+          const unsigned int n_global_flags_refinement = n_global_flags[0];
+          const unsigned int n_global_flags_coarsening = n_global_flags[1];
 
           const unsigned int target_index_refinement =
             static_cast<unsigned int>(
@@ -469,9 +491,7 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       references.size());
 
-      std::vector<bool> p_flags(
-        dof_handler.get_triangulation().n_active_cells(), false);
-
+      // Decide and assign future finite elements in the same traversal.
       for (const auto &cell : dof_handler.active_cell_iterators())
         if (cell->is_locally_owned() &&
             ((cell->refine_flag_set() &&
@@ -480,9 +500,7 @@ namespace hp
              (cell->coarsen_flag_set() &&
               compare_coarsen(criteria[cell->active_cell_index()],
                               references[cell->active_cell_index()]))))
-          p_flags[cell->active_cell_index()] = true;
-
-      p_adaptivity_from_flags(dof_handler, p_flags);
+          set_future_fe_index_from_h_flag(dof_handler, cell);
     }
 
 
@@ -118,6 +118,19 @@ namespace LinearAlgebra
                          const float     a,
                          const size_type N);
       template __global__ void
+      add_ratio_aV<float>(float *         val,
+                          const float     a,
+                          const float *   numerator,
+                          const float *   denominator,
+                          const float *   V_val,
+                          const size_type N);
+      template __global__ void
+      sadd_ratio<float>(const float *   numerator,
+                        const float *   denominator,
+                        float *         val,
+                        const float *   V_val,
+                        const size_type N);
+      template __global__ void
       set<float>(float *val, const float s, const size_type N);
       template __global__ void
       set_permutated<float, size_type>(const size_type *indices,
@@ -228,6 +241,19 @@ namespace LinearAlgebra
                           const double    a,
                           const size_type N);
       template __global__ void
+      add_ratio_aV<double>(double *        val,
+                           const double    a,
+                           const double *  numerator,
+                           const double *  denominator,
+                           const double *  V_val,
+                           const size_type N);
+      template __global__ void
+      sadd_ratio<double>(const double *  numerator,
+                         const double *  denominator,
+                         double *        val,
+                         const double *  V_val,
+                         const size_type N);
+      template __global__ void
       set<double>(double *val, const double s, const size_type N);
       template __global__ void
       set_permutated<double, size_type>(const size_type *indices,
@@ -41,6 +41,8 @@ namespace LinearAlgebra
     Vector<Number>::Vector()
       : val(nullptr, Utilities::CUDA::delete_device_data<Number>)
       , n_elements(0)
+      , stream(nullptr)
+      , reduction_buffer(nullptr, Utilities::CUDA::delete_device_data<Number>)
     {}
 
 
@@ -50,12 +52,16 @@ namespace LinearAlgebra
       : val(Utilities::CUDA::allocate_device_data<Number>(V.n_elements),
             Utilities::CUDA::delete_device_data<Number>)
       , n_elements(V.n_elements)
+      , stream(V.stream)
+      , reduction_buffer(nullptr, Utilities::CUDA::delete_device_data<Number>)
     {
       // Copy the values.
-      const cudaError_t error_code = cudaMemcpy(val.get(),
-                                                V.val.get(),
-                                                n_elements * sizeof(Number),
-                                                cudaMemcpyDeviceToDevice);
+      const cudaError_t error_code =
+        cudaMemcpyAsync(val.get(),
+                        V.val.get(),
+                        n_elements * sizeof(Number),
+                        cudaMemcpyDeviceToDevice,
+                        stream);
       AssertCuda(error_code);
     }
 
@@ -71,10 +77,12 @@ namespace LinearAlgebra
         n_elements = V.n_elements;
 
       // Copy the values.
-      const cudaError_t error_code = cudaMemcpy(val.get(),
-                                                V.val.get(),
-                                                n_elements * sizeof(Number),
-                                                cudaMemcpyDeviceToDevice);
+      const cudaError_t error_code =
+        cudaMemcpyAsync(val.get(),
+                        V.val.get(),
+                        n_elements * sizeof(Number),
+                        cudaMemcpyDeviceToDevice,
+                        stream);
       AssertCuda(error_code);
 
       return *this;
@@ -86,6 +94,8 @@ namespace LinearAlgebra
     Vector<Number>::Vector(const size_type n)
       : val(nullptr, Utilities::CUDA::delete_device_data<Number>)
       , n_elements(0)
+      , stream(nullptr)
+      , reduction_buffer(nullptr, Utilities::CUDA::delete_device_data<Number>)
     {
       reinit(n, false);
     }
@@ -106,7 +116,7 @@ namespace LinearAlgebra
       if (omit_zeroing_entries == false)
         {
           const cudaError_t error_code =
-            cudaMemset(val.get(), 0, n * sizeof(Number));
+            cudaMemsetAsync(val.get(), 0, n * sizeof(Number), stream);
           AssertCuda(error_code);
         }
       n_elements = n;
@@ -132,10 +142,14 @@ namespace LinearAlgebra
     {
       if (operation == VectorOperation::insert)
         {
-          const cudaError_t error_code = cudaMemcpy(val.get(),
-                                                    V.begin(),
-                                                    n_elements * sizeof(Number),
-                                                    cudaMemcpyHostToDevice);
+          // the copy from pageable host memory is staged before the call
+          // returns, so V can be released right afterwards
+          const cudaError_t error_code =
+            cudaMemcpyAsync(val.get(),
+                            V.begin(),
+                            n_elements * sizeof(Number),
+                            cudaMemcpyHostToDevice,
+                            stream);
           AssertCuda(error_code);
         }
       else if (operation == VectorOperation::add)
@@ -147,17 +161,18 @@ namespace LinearAlgebra
           AssertCuda(error_code);
 
           // Copy the vector from the host to the temporary vector on the device
-          error_code = cudaMemcpy(tmp,
-                                  V.begin(),
-                                  n_elements * sizeof(Number),
-                                  cudaMemcpyHostToDevice);
+          error_code = cudaMemcpyAsync(tmp,
+                                       V.begin(),
+                                       n_elements * sizeof(Number),
+                                       cudaMemcpyHostToDevice,
+                                       stream);
           AssertCuda(error_code);
 
           // Add the two vectors
           const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
 
           kernel::vector_bin_op<Number, kernel::Binop_Addition>
-            <<<n_blocks, block_size>>>(val.get(), tmp, n_elements);
+            <<<n_blocks, block_size, 0, stream>>>(val.get(), tmp, n_elements);
           AssertCudaKernel();
 
           // Delete the temporary vector
@@ -177,7 +192,7 @@ namespace LinearAlgebra
       (void)s;
 
       const cudaError_t error_code =
-        cudaMemset(val.get(), 0, n_elements * sizeof(Number));
+        cudaMemsetAsync(val.get(), 0, n_elements * sizeof(Number), stream);
       AssertCuda(error_code);
 
       return *this;
@@ -192,7 +207,7 @@ namespace LinearAlgebra
       AssertIsFinite(factor);
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::vec_scale<Number>
-        <<<n_blocks, block_size>>>(val.get(), factor, n_elements);
+        <<<n_blocks, block_size, 0, stream>>>(val.get(), factor, n_elements);
       AssertCudaKernel();
 
       return *this;
@@ -208,7 +223,9 @@ namespace LinearAlgebra
       Assert(factor != Number(0.), ExcZero());
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::vec_scale<Number>
-        <<<n_blocks, block_size>>>(val.get(), 1. / factor, n_elements);
+        <<<n_blocks, block_size, 0, stream>>>(val.get(),
+                                              1. / factor,
+                                              n_elements);
       AssertCudaKernel();
 
       return *this;
@@ -233,7 +250,9 @@ namespace LinearAlgebra
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
 
       kernel::vector_bin_op<Number, kernel::Binop_Addition>
-        <<<n_blocks, block_size>>>(val.get(), down_V.val.get(), n_elements);
+        <<<n_blocks, block_size, 0, stream>>>(val.get(),
+                                              down_V.val.get(),
+                                              n_elements);
       AssertCudaKernel();
 
       return *this;
@@ -258,7 +277,9 @@ namespace LinearAlgebra
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
 
       kernel::vector_bin_op<Number, kernel::Binop_Subtraction>
-        <<<n_blocks, block_size>>>(val.get(), down_V.val.get(), n_elements);
+        <<<n_blocks, block_size, 0, stream>>>(val.get(),
+                                              down_V.val.get(),
+                                              n_elements);
       AssertCudaKernel();
 
       return *this;
@@ -279,31 +300,17 @@ namespace LinearAlgebra
              ExcMessage(
                "Cannot add two vectors with different numbers of elements"));
 
-      Number *    result_device;
-      cudaError_t error_code =
-        cudaMalloc(&result_device, n_elements * sizeof(Number));
-      AssertCuda(error_code);
-      error_code = cudaMemset(result_device, 0, sizeof(Number));
+      Number *const result_device = get_zeroed_reduction_buffer();
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::double_vector_reduction<Number, kernel::DotProduct<Number>>
-        <<<dim3(n_blocks, 1), dim3(block_size)>>>(result_device,
-                                                  val.get(),
-                                                  down_V.val.get(),
-                                                  static_cast<unsigned int>(
-                                                    n_elements));
-
-      // Copy the result back to the host
-      Number result;
-      error_code = cudaMemcpy(&result,
-                              result_device,
-                              sizeof(Number),
-                              cudaMemcpyDeviceToHost);
-      AssertCuda(error_code);
-      // Free the memory on the device
-      Utilities::CUDA::free(result_device);
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          result_device,
+          val.get(),
+          down_V.val.get(),
+          static_cast<unsigned int>(n_elements));
 
-      return result;
+      return read_reduction_buffer();
     }
 
 
@@ -315,7 +322,7 @@ namespace LinearAlgebra
       AssertIsFinite(a);
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::vec_add<Number>
-        <<<n_blocks, block_size>>>(val.get(), a, n_elements);
+        <<<n_blocks, block_size, 0, stream>>>(val.get(), a, n_elements);
       AssertCudaKernel();
     }
 
@@ -338,8 +345,9 @@ namespace LinearAlgebra
                "Cannot add two vectors with different numbers of elements."));
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
-      kernel::add_aV<Number><<<dim3(n_blocks, 1), dim3(block_size)>>>(
-        val.get(), a, down_V.val.get(), n_elements);
+      kernel::add_aV<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          val.get(), a, down_V.val.get(), n_elements);
       AssertCudaKernel();
     }
 
@@ -376,8 +384,9 @@ namespace LinearAlgebra
                "Cannot add two vectors with different numbers of elements."));
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
-      kernel::add_aVbW<Number><<<dim3(n_blocks, 1), dim3(block_size)>>>(
-        val.get(), a, down_V.val.get(), b, down_W.val.get(), n_elements);
+      kernel::add_aVbW<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          val.get(), a, down_V.val.get(), b, down_W.val.get(), n_elements);
       AssertCudaKernel();
     }
 
@@ -403,8 +412,9 @@ namespace LinearAlgebra
                "Cannot add two vectors with different numbers of elements."));
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
-      kernel::sadd<Number><<<dim3(n_blocks, 1), dim3(block_size)>>>(
-        s, val.get(), a, down_V.val.get(), n_elements);
+      kernel::sadd<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          s, val.get(), a, down_V.val.get(), n_elements);
       AssertCudaKernel();
     }
 
@@ -426,8 +436,9 @@ namespace LinearAlgebra
                "Cannot scale two vectors with different numbers of elements."));
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
-      kernel::scale<Number><<<dim3(n_blocks, 1), dim3(block_size)>>>(
-        val.get(), down_scaling_factors.val.get(), n_elements);
+      kernel::scale<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          val.get(), down_scaling_factors.val.get(), n_elements);
       AssertCudaKernel();
     }
 
@@ -451,8 +462,9 @@ namespace LinearAlgebra
           "Cannot assign two vectors with different numbers of elements."));
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
-      kernel::equ<Number><<<dim3(n_blocks, 1), dim3(block_size)>>>(
-        val.get(), a, down_V.val.get(), n_elements);
+      kernel::equ<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          val.get(), a, down_V.val.get(), n_elements);
       AssertCudaKernel();
     }
 
@@ -471,26 +483,15 @@ namespace LinearAlgebra
     typename Vector<Number>::value_type
     Vector<Number>::mean_value() const
     {
-      Number *    result_device;
-      cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
-      AssertCuda(error_code);
-      error_code = cudaMemset(result_device, 0, sizeof(Number));
+      Number *const result_device = get_zeroed_reduction_buffer();
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::reduction<Number, kernel::ElemSum<Number>>
-        <<<dim3(n_blocks, 1), dim3(block_size)>>>(result_device,
-                                                  val.get(),
-                                                  n_elements);
-
-      // Copy the result back to the host
-      Number result;
-      error_code = cudaMemcpy(&result,
-                              result_device,
-                              sizeof(Number),
-                              cudaMemcpyDeviceToHost);
-      AssertCuda(error_code);
-      // Free the memory on the device
-      Utilities::CUDA::free(result_device);
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(result_device,
+                                                             val.get(),
+                                                             n_elements);
+
+      const Number result = read_reduction_buffer();
 
       return result /
              static_cast<typename Vector<Number>::value_type>(n_elements);
@@ -502,28 +503,15 @@ namespace LinearAlgebra
     typename Vector<Number>::real_type
     Vector<Number>::l1_norm() const
     {
-      Number *    result_device;
-      cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
-      AssertCuda(error_code);
-      error_code = cudaMemset(result_device, 0, sizeof(Number));
+      Number *const result_device = get_zeroed_reduction_buffer();
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::reduction<Number, kernel::L1Norm<Number>>
-        <<<dim3(n_blocks, 1), dim3(block_size)>>>(result_device,
-                                                  val.get(),
-                                                  n_elements);
-
-      // Copy the result back to the host
-      Number result;
-      error_code = cudaMemcpy(&result,
-                              result_device,
-                              sizeof(Number),
-                              cudaMemcpyDeviceToHost);
-      AssertCuda(error_code);
-      // Free the memory on the device
-      Utilities::CUDA::free(result_device);
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(result_device,
+                                                             val.get(),
+                                                             n_elements);
 
-      return result;
+      return read_reduction_buffer();
     }
 
 
@@ -550,28 +538,15 @@ namespace LinearAlgebra
     typename Vector<Number>::real_type
     Vector<Number>::linfty_norm() const
     {
-      Number *    result_device;
-      cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
-      AssertCuda(error_code);
-      error_code = cudaMemset(result_device, 0, sizeof(Number));
+      Number *const result_device = get_zeroed_reduction_buffer();
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::reduction<Number, kernel::LInfty<Number>>
-        <<<dim3(n_blocks, 1), dim3(block_size)>>>(result_device,
-                                                  val.get(),
-                                                  n_elements);
-
-      // Copy the result back to the host
-      Number result;
-      error_code = cudaMemcpy(&result,
-                              result_device,
-                              sizeof(Number),
-                              cudaMemcpyDeviceToHost);
-      AssertCuda(error_code);
-      // Free the memory on the device
-      Utilities::CUDA::free(result_device);
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(result_device,
+                                                             val.get(),
+                                                             n_elements);
 
-      return result;
+      return read_reduction_buffer();
     }
 
 
@@ -598,27 +573,158 @@ namespace LinearAlgebra
       Assert(down_W.size() == this->size(),
              ExcMessage("Vector W has the wrong size."));
 
-      Number *    result_device;
-      cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
+      Number *const result_device = get_zeroed_reduction_buffer();
+
+      const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
+      kernel::add_and_dot<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(result_device,
+                                                             val.get(),
+                                                             down_V.val.get(),
+                                                             down_W.val.get(),
+                                                             a,
+                                                             n_elements);
+
+      return read_reduction_buffer();
+    }
+
+
+
+    template <typename Number>
+    void
+    Vector<Number>::dot_on_device(const Vector<Number> &V,
+                                  Number *              result_device) const
+    {
+      Assert(V.size() == this->size(),
+             ExcMessage("Vector V has the wrong size."));
+
+      // the kernel accumulates into the result
+      const cudaError_t error_code =
+        cudaMemsetAsync(result_device, 0, sizeof(Number), stream);
       AssertCuda(error_code);
-      error_code = cudaMemset(result_device, 0, sizeof(Number));
+
+      const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
+      kernel::double_vector_reduction<Number, kernel::DotProduct<Number>>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          result_device,
+          val.get(),
+          V.val.get(),
+          static_cast<unsigned int>(n_elements));
+      AssertCudaKernel();
+    }
+
+
+
+    template <typename Number>
+    void
+    Vector<Number>::norm_sqr_on_device(Number *result_device) const
+    {
+      dot_on_device(*this, result_device);
+    }
+
+
+
+    template <typename Number>
+    void
+    Vector<Number>::add_and_dot_on_device(const Number          a,
+                                          const Vector<Number> &V,
+                                          const Vector<Number> &W,
+                                          Number *              result_device)
+    {
+      AssertIsFinite(a);
+      Assert(V.size() == this->size(),
+             ExcMessage("Vector V has the wrong size."));
+      Assert(W.size() == this->size(),
+             ExcMessage("Vector W has the wrong size."));
+
+      const cudaError_t error_code =
+        cudaMemsetAsync(result_device, 0, sizeof(Number), stream);
       AssertCuda(error_code);
 
       const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
       kernel::add_and_dot<Number>
-        <<<dim3(n_blocks, 1), dim3(block_size)>>>(result_device,
-                                                  val.get(),
-                                                  down_V.val.get(),
-                                                  down_W.val.get(),
-                                                  a,
-                                                  n_elements);
-
-      Number result;
-      error_code = cudaMemcpy(&result,
-                              result_device,
-                              sizeof(Number),
-                              cudaMemcpyDeviceToHost);
-      Utilities::CUDA::free(result_device);
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(result_device,
+                                                             val.get(),
+                                                             V.val.get(),
+                                                             W.val.get(),
+                                                             a,
+                                                             n_elements);
+      AssertCudaKernel();
+    }
+
+
+
+    template <typename Number>
+    void
+    Vector<Number>::add_ratio(const Number          a,
+                              const Number *        numerator,
+                              const Number *        denominator,
+                              const Vector<Number> &V)
+    {
+      AssertIsFinite(a);
+      Assert(V.size() == this->size(),
+             ExcMessage(
+               "Cannot add two vectors with different numbers of elements."));
+
+      const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
+      kernel::add_ratio_aV<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          val.get(), a, numerator, denominator, V.val.get(), n_elements);
+      AssertCudaKernel();
+    }
+
+
+
+    template <typename Number>
+    void
+    Vector<Number>::sadd_ratio(const Number *        numerator,
+                               const Number *        denominator,
+                               const Vector<Number> &V)
+    {
+      Assert(V.size() == this->size(),
+             ExcMessage(
+               "Cannot add two vectors with different numbers of elements."));
+
+      const int n_blocks = 1 + (n_elements - 1) / (chunk_size * block_size);
+      kernel::sadd_ratio<Number>
+        <<<dim3(n_blocks, 1), dim3(block_size), 0, stream>>>(
+          numerator, denominator, val.get(), V.val.get(), n_elements);
+      AssertCudaKernel();
+    }
+
+
+
+    template <typename Number>
+    Number *
+    Vector<Number>::get_zeroed_reduction_buffer() const
+    {
+      if (reduction_buffer == nullptr)
+        reduction_buffer.reset(
+          Utilities::CUDA::allocate_device_data<Number>(1));
+
+      const cudaError_t error_code =
+        cudaMemsetAsync(reduction_buffer.get(), 0, sizeof(Number), stream);
+      AssertCuda(error_code);
+
+      return reduction_buffer.get();
+    }
+
+
+
+    template <typename Number>
+    Number
+    Vector<Number>::read_reduction_buffer() const
+    {
+      Number      result;
+      cudaError_t error_code = cudaMemcpyAsync(&result,
+                                               reduction_buffer.get(),
+                                               sizeof(Number),
+                                               cudaMemcpyDeviceToHost,
+                                               stream);
+      AssertCuda(error_code);
+
+      // only wait for the work on this stream rather than the whole device
+      error_code = cudaStreamSynchronize(stream);
+      AssertCuda(error_code);
 
       return result;
     }
@@ -30,31 +30,44 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace GinkgoWrappers
 {
+  namespace
+  {
+    std::shared_ptr<gko::Executor>
+    create_executor(const std::string &exec_type)
+    {
+      std::shared_ptr<gko::Executor> executor;
+      if (exec_type == "reference")
+        {
+          executor = gko::ReferenceExecutor::create();
+        }
+      else if (exec_type == "omp")
+        {
+          executor = gko::OmpExecutor::create();
+        }
+      else if (exec_type == "cuda" && gko::CudaExecutor::get_num_devices() > 0)
+        {
+          executor = gko::CudaExecutor::create(0, gko::OmpExecutor::create());
+        }
+      else
+        {
+          Assert(
+            false,
+            ExcMessage(
+              " exec_type needs to be one of the three strings: \"reference\", \"cuda\" or \"omp\" "));
+        }
+      return executor;
+    }
+  } // namespace
+
+
+
   template <typename ValueType, typename IndexType>
   SolverBase<ValueType, IndexType>::SolverBase(SolverControl &solver_control,
                                                const std::string &exec_type)
     : solver_control(solver_control)
+    , executor(create_executor(exec_type))
     , exec_type(exec_type)
   {
-    if (exec_type == "reference")
-      {
-        executor = gko::ReferenceExecutor::create();
-      }
-    else if (exec_type == "omp")
-      {
-        executor = gko::OmpExecutor::create();
-      }
-    else if (exec_type == "cuda" && gko::CudaExecutor::get_num_devices() > 0)
-      {
-        executor = gko::CudaExecutor::create(0, gko::OmpExecutor::create());
-      }
-    else
-      {
-        Assert(
-          false,
-          ExcMessage(
-            " exec_type needs to be one of the three strings: \"reference\", \"cuda\" or \"omp\" "));
-      }
     using ResidualCriterionFactory = gko::stop::ResidualNormReduction<>;
     residual_criterion             = ResidualCriterionFactory::build()
                            .with_reduction_factor(solver_control.tolerance())
@@ -87,49 +100,79 @@ namespace GinkgoWrappers
   void
   SolverBase<ValueType, IndexType>::apply(Vector<ValueType> &      solution,
                                           const Vector<ValueType> &rhs)
+  {
+    Assert(rhs.size() == solution.size(),
+           ExcDimensionMismatch(rhs.size(), solution.size()));
+
+    apply_to_raw_data(solution.begin(), rhs.begin(), solution.size());
+  }
+
+
+
+  template <typename ValueType, typename IndexType>
+  void
+  SolverBase<ValueType, IndexType>::apply(
+    LinearAlgebra::distributed::Vector<ValueType> &      solution,
+    const LinearAlgebra::distributed::Vector<ValueType> &rhs)
+  {
+    Assert(rhs.size() == solution.size(),
+           ExcDimensionMismatch(rhs.size(), solution.size()));
+    AssertThrow(solution.local_size() == solution.size() &&
+                  rhs.local_size() == rhs.size(),
+                ExcMessage("The Ginkgo solvers need all vector entries to be "
+                           "stored on the current process."));
+
+    apply_to_raw_data(solution.begin(), rhs.begin(), solution.size());
+  }
+
+
+
+  template <typename ValueType, typename IndexType>
+  void
+  SolverBase<ValueType, IndexType>::apply_to_raw_data(
+    ValueType *       solution,
+    const ValueType * rhs,
+    const std::size_t size)
   {
     // some shortcuts.
     using val_array = gko::Array<ValueType>;
     using vec       = gko::matrix::Dense<ValueType>;
 
     Assert(system_matrix, ExcNotInitialized());
+    Assert(solver, ExcNotInitialized());
     Assert(executor, ExcNotInitialized());
-    Assert(rhs.size() == solution.size(),
-           ExcDimensionMismatch(rhs.size(), solution.size()));
-
-    // Generate the solver from the solver using the system matrix.
-    auto solver = solver_gen->generate(system_matrix);
 
-    // Create the rhs vector in Ginkgo's format.
-    std::vector<ValueType> f(rhs.size());
-    std::copy(rhs.begin(), rhs.begin() + rhs.size(), f.begin());
-    auto b =
-      vec::create(executor,
-                  gko::dim<2>(rhs.size(), 1),
-                  val_array::view(executor->get_master(), rhs.size(), f.data()),
+    // Wrap the deal.II vectors in Ginkgo's format without copying them. Ginkgo
+    // does not modify the right hand side, so the const_cast is safe.
+    auto b_host = vec::create(executor->get_master(),
+                              gko::dim<2>(size, 1),
+                              val_array::view(executor->get_master(),
+                                              size,
+                                              const_cast<ValueType *>(rhs)),
+                              1);
+    auto x_host =
+      vec::create(executor->get_master(),
+                  gko::dim<2>(size, 1),
+                  val_array::view(executor->get_master(), size, solution),
                   1);
 
-    // Create the solution vector in Ginkgo's format.
-    std::vector<ValueType> u(solution.size());
-    std::copy(solution.begin(), solution.begin() + solution.size(), u.begin());
-    auto x = vec::create(executor,
-                         gko::dim<2>(solution.size(), 1),
-                         val_array::view(executor->get_master(),
-                                         solution.size(),
-                                         u.data()),
-                         1);
-
-    // Create the logger object to log some data from the solvers to confirm
-    // convergence.
-    initialize_ginkgo_log();
-
-    Assert(convergence_logger, ExcNotInitialized());
-    // Add the convergence logger object to the combined factory to retrieve the
-    // solver and other data
-    combined_factory->add_logger(convergence_logger);
+    // On a device, the vectors need to be transferred there, which is the only
+    // copy left. On the host, the solver works on the deal.II vectors
+    // directly.
+    std::unique_ptr<vec> b_device;
+    std::unique_ptr<vec> x_device;
+    vec *                b = b_host.get();
+    vec *                x = x_host.get();
+    if (executor != executor->get_master())
+      {
+        b_device = gko::clone(executor, b_host);
+        x_device = gko::clone(executor, x_host);
+        b        = b_device.get();
+        x        = x_device.get();
+      }
 
     // Finally, apply the solver to b and get the solution in x.
-    solver->apply(gko::lend(b), gko::lend(x));
+    solver->apply(b, x);
 
     // The convergence_logger object contains the residual vector after the
     // solver has returned. use this vector to compute the residual norm of the
@@ -151,23 +194,11 @@ namespace GinkgoWrappers
 
     // Ginkgo works with a relative residual norm through its
     // ResidualNormReduction criterion. Therefore, to get the normalized
-    // residual, we divide by the norm of the rhs.
+    // residual, we divide by the norm of the rhs, which we compute from the
+    // copy on the host.
     auto b_norm = gko::matrix::Dense<ValueType>::create(executor->get_master(),
                                                         gko::dim<2>{1, 1});
-    if (executor != executor->get_master())
-      {
-        auto b_master = vec::create(executor->get_master(),
-                                    gko::dim<2>(rhs.size(), 1),
-                                    val_array::view(executor->get_master(),
-                                                    rhs.size(),
-                                                    f.data()),
-                                    1);
-        b_master->compute_norm2(b_norm.get());
-      }
-    else
-      {
-        b->compute_norm2(b_norm.get());
-      }
+    b_host->compute_norm2(b_norm.get());
 
     Assert(b_norm.get()->at(0, 0) != 0.0, ExcDivideByZero());
     // Pass the number of iterations and residual norm to the solver_control
@@ -184,22 +215,10 @@ namespace GinkgoWrappers
                   SolverControl::NoConvergence(solver_control.last_step(),
                                                solver_control.last_value()));
 
-    // Check if the solution is on a CUDA device, if so, copy it over to the
-    // host.
-    if (executor != executor->get_master())
-      {
-        auto x_master = vec::create(executor->get_master(),
-                                    gko::dim<2>(solution.size(), 1),
-                                    val_array::view(executor,
-                                                    solution.size(),
-                                                    x->get_values()),
-                                    1);
-        x.reset(x_master.release());
-      }
-    // Finally copy over the solution vector to deal.II's solution vector.
-    std::copy(x->get_values(),
-              x->get_values() + solution.size(),
-              solution.begin());
+    // If the solution was computed on a CUDA device, copy it back into the
+    // deal.II vector.
+    if (x_device)
+      x_host->copy_from(x_device.get());
   }
 
 
@@ -283,6 +302,20 @@ namespace GinkgoWrappers
     system_matrix =
       mtx::create(executor, gko::dim<2>(N), matrix.n_nonzero_elements());
     system_matrix->copy_from(system_matrix_compute.get());
+
+    // Create the logger object to log some data from the solvers to confirm
+    // convergence, and add it to the combined factory to retrieve the solver
+    // and other data. This needs to happen only once, as the logger is
+    // updated by every solve.
+    if (!convergence_logger)
+      {
+        initialize_ginkgo_log();
+        combined_factory->add_logger(convergence_logger);
+      }
+
+    // Generate the solver, and with it the preconditioner, for the system
+    // matrix. Both stay on the device and are reused by all calls to apply().
+    solver = solver_gen->generate(system_matrix);
   }
 
 
@@ -510,6 +543,58 @@ namespace GinkgoWrappers
 
 
 
+  /* ---------------------- Preconditioners ------------------------ */
+  template <typename ValueType, typename IndexType>
+  std::shared_ptr<gko::LinOpFactory>
+  create_preconditioner(const std::string &name,
+                        const std::string &exec_type,
+                        const unsigned int max_block_size)
+  {
+    const std::shared_ptr<gko::Executor> executor = create_executor(exec_type);
+
+    // The incomplete factorizations are applied by triangular solves
+    using ilu =
+      gko::preconditioner::Ilu<gko::solver::LowerTrs<ValueType, IndexType>,
+                               gko::solver::UpperTrs<ValueType, IndexType>,
+                               false,
+                               IndexType>;
+
+    if (name == "none")
+      return nullptr;
+    else if (name == "jacobi")
+      return gko::preconditioner::Jacobi<ValueType, IndexType>::build()
+        .with_max_block_size(max_block_size)
+        .on(executor);
+    else if (name == "ilu")
+      return ilu::build()
+        .with_factorization_factory(
+          gko::factorization::ParIlu<ValueType, IndexType>::build().on(
+            executor))
+        .on(executor);
+    else if (name == "parilut")
+      return ilu::build()
+        .with_factorization_factory(
+          gko::factorization::ParIlut<ValueType, IndexType>::build().on(
+            executor))
+        .on(executor);
+
+    AssertThrow(false,
+                ExcMessage("The preconditioner <" + name +
+                           "> is not known. Use one of " +
+                           get_preconditioner_names() + "."));
+    return nullptr;
+  }
+
+
+
+  std::string
+  get_preconditioner_names()
+  {
+    return "none|jacobi|ilu|parilut";
+  }
+
+
+
   // Explicit instantiations in GinkgoWrappers
 #  define DEALII_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(_macro) \
     template _macro(float, int32_t);                               \
@@ -552,6 +637,15 @@ namespace GinkgoWrappers
   DEALII_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(DECLARE_SOLVER_IR)
 #  undef DECLARE_SOLVER_IR
 
+#  define DECLARE_CREATE_PRECONDITIONER(ValueType, IndexType)       \
+    std::shared_ptr<gko::LinOpFactory>                              \
+    create_preconditioner<ValueType, IndexType>(const std::string &, \
+                                                const std::string &, \
+                                                const unsigned int)
+  DEALII_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    DECLARE_CREATE_PRECONDITIONER)
+#  undef DECLARE_CREATE_PRECONDITIONER
+
 } // namespace GinkgoWrappers
 
 
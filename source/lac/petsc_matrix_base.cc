@@ -77,6 +77,8 @@ namespace PETScWrappers
   MatrixBase::MatrixBase()
     : matrix(nullptr)
     , last_action(VectorOperation::unknown)
+    , coo_assembly_active(false)
+    , coo_pattern_matrix_id(-1)
   {}
 
 
@@ -233,6 +235,89 @@ namespace PETScWrappers
 
 
 
+  void
+  MatrixBase::start_coo_assembly()
+  {
+    Assert(coo_assembly_active == false,
+           ExcMessage("A bulk assembly has already been started."));
+    assert_is_compressed();
+
+#  if DEAL_II_PETSC_VERSION_GTE(3, 17, 0)
+    // check whether the matrix has been re-created since the pattern was
+    // set, in which case the triplets need to be recorded again
+    PetscObjectId        id;
+    const PetscErrorCode ierr =
+      PetscObjectGetId(reinterpret_cast<PetscObject>(matrix), &id);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    if (coo_pattern_matrix_id != static_cast<std::int64_t>(id))
+      {
+        coo_pattern_matrix_id = -1;
+        coo_rows.clear();
+        coo_columns.clear();
+      }
+
+    coo_values.clear();
+    coo_assembly_active = true;
+#  else
+    // without support for bulk assembly in PETSc, the entries are added
+    // individually, so the matrix needs to start from zero
+    *this = 0.;
+#  endif
+  }
+
+
+
+  void
+  MatrixBase::finish_coo_assembly()
+  {
+#  if DEAL_II_PETSC_VERSION_GTE(3, 17, 0)
+    Assert(coo_assembly_active,
+           ExcMessage("No bulk assembly has been started."));
+    coo_assembly_active = false;
+
+    PetscErrorCode ierr;
+    if (coo_pattern_matrix_id < 0)
+      {
+        AssertDimension(coo_rows.size(), coo_values.size());
+
+        // PETSc may modify the index arrays, so hand over copies in debug
+        // mode where they are kept to check later assemblies
+#    ifdef DEBUG
+        std::vector<PetscInt> rows(coo_rows), columns(coo_columns);
+#    else
+        std::vector<PetscInt> rows, columns;
+        rows.swap(coo_rows);
+        columns.swap(coo_columns);
+#    endif
+        ierr = MatSetPreallocationCOO(matrix,
+                                      static_cast<PetscCount>(rows.size()),
+                                      rows.data(),
+                                      columns.data());
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+        PetscObjectId id;
+        ierr = PetscObjectGetId(reinterpret_cast<PetscObject>(matrix), &id);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+        coo_pattern_matrix_id = static_cast<std::int64_t>(id);
+      }
+#    ifdef DEBUG
+    else
+      AssertDimension(coo_rows.size(), coo_values.size());
+#    endif
+
+    // the values of repeated entries are summed up and the result replaces
+    // the previous content of the matrix, which is assembled afterwards
+    ierr = MatSetValuesCOO(matrix, coo_values.data(), INSERT_VALUES);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    last_action = VectorOperation::unknown;
+#  else
+    compress(VectorOperation::add);
+#  endif
+  }
+
+
+
   MatrixBase::size_type
   MatrixBase::m() const
   {
@@ -82,6 +82,72 @@ namespace PETScWrappers
   }
 
 
+  namespace
+  {
+    /**
+     * Create a PETSc vector that uses the memory of the locally owned
+     * elements of @p vector, without copying them. The returned object needs
+     * to be destroyed with VecDestroy(), which leaves the memory untouched.
+     */
+    Vec
+    create_vector_view(
+      const LinearAlgebra::distributed::Vector<PetscScalar> &vector)
+    {
+      Vec                  view;
+      const PetscErrorCode ierr =
+        VecCreateMPIWithArray(vector.get_mpi_communicator(),
+                              1,
+                              static_cast<PetscInt>(vector.local_size()),
+                              static_cast<PetscInt>(vector.size()),
+                              vector.begin(),
+                              &view);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+      return view;
+    }
+  } // namespace
+
+
+
+  void
+  PreconditionerBase::vmult(
+    LinearAlgebra::distributed::Vector<PetscScalar> &      dst,
+    const LinearAlgebra::distributed::Vector<PetscScalar> &src) const
+  {
+    AssertThrow(pc != nullptr, StandardExceptions::ExcInvalidState());
+
+    Vec petsc_dst = create_vector_view(dst);
+    Vec petsc_src = create_vector_view(src);
+
+    PetscErrorCode ierr = PCApply(pc, petsc_src, petsc_dst);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    ierr = VecDestroy(&petsc_src);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = VecDestroy(&petsc_dst);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+  }
+
+
+  void
+  PreconditionerBase::Tvmult(
+    LinearAlgebra::distributed::Vector<PetscScalar> &      dst,
+    const LinearAlgebra::distributed::Vector<PetscScalar> &src) const
+  {
+    AssertThrow(pc != nullptr, StandardExceptions::ExcInvalidState());
+
+    Vec petsc_dst = create_vector_view(dst);
+    Vec petsc_src = create_vector_view(src);
+
+    PetscErrorCode ierr = PCApplyTranspose(pc, petsc_src, petsc_dst);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+
+    ierr = VecDestroy(&petsc_src);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+    ierr = VecDestroy(&petsc_dst);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+  }
+
+
   void
   PreconditionerBase::create_pc()
   {
@@ -663,28 +663,94 @@ template <typename NumberType>
 void
 ScaLAPACKMatrix<NumberType>::copy_to(FullMatrix<NumberType> &matrix) const
 {
-  // FIXME: use PDGEMR2D for copying?
-  // PDGEMR2D copies a submatrix of A on a submatrix of B.
-  // A and B can have different distributions
-  // see http://icl.cs.utk.edu/lapack-forum/viewtopic.php?t=50
   Assert(n_rows == int(matrix.m()), ExcDimensionMismatch(n_rows, matrix.m()));
   Assert(n_columns == int(matrix.n()),
          ExcDimensionMismatch(n_columns, matrix.n()));
 
-  matrix = 0.;
-  if (grid->mpi_process_is_active)
+  // Rather than summing up a full matrix over all processes, gather the
+  // local arrays of all processes together with their position in the
+  // process grid, such that each entry is communicated exactly once.
+  // Inactive processes contribute no entries.
+  const unsigned int n_mpi_processes =
+    Utilities::MPI::n_mpi_processes(grid->mpi_communicator);
+  const int local_info[4] = {
+    grid->mpi_process_is_active ? grid->this_process_row : -1,
+    grid->this_process_column,
+    n_local_rows,
+    n_local_columns};
+
+  std::vector<int> process_info(4 * n_mpi_processes);
+  int ierr = MPI_Allgather(local_info,
+                           4,
+                           MPI_INT,
+                           process_info.data(),
+                           4,
+                           MPI_INT,
+                           grid->mpi_communicator);
+  AssertThrowMPI(ierr);
+
+  std::vector<int> counts(n_mpi_processes);
+  std::vector<int> displacements(n_mpi_processes + 1);
+  for (unsigned int p = 0; p < n_mpi_processes; ++p)
     {
-      for (int i = 0; i < n_local_rows; ++i)
-        {
-          const int glob_i = global_row(i);
-          for (int j = 0; j < n_local_columns; ++j)
-            {
-              const int glob_j       = global_column(j);
-              matrix(glob_i, glob_j) = local_el(i, j);
-            }
-        }
+      counts[p] = (process_info[4 * p] >= 0) ?
+                    process_info[4 * p + 2] * process_info[4 * p + 3] :
+                    0;
+      displacements[p + 1] = displacements[p] + counts[p];
     }
-  Utilities::MPI::sum(matrix, grid->mpi_communicator, matrix);
+
+  const unsigned int my_process =
+    Utilities::MPI::this_mpi_process(grid->mpi_communicator);
+  std::vector<NumberType> all_values(displacements.back());
+  const NumberType *      my_values =
+    (counts[my_process] > 0) ? this->values.data() : nullptr;
+  ierr = MPI_Allgatherv(my_values,
+                        counts[my_process],
+                        Utilities::MPI::internal::mpi_type_id(my_values),
+                        all_values.data(),
+                        counts.data(),
+                        displacements.data(),
+                        Utilities::MPI::internal::mpi_type_id(my_values),
+                        grid->mpi_communicator);
+  AssertThrowMPI(ierr);
+
+  std::vector<unsigned int> global_rows;
+  for (unsigned int p = 0; p < n_mpi_processes; ++p)
+    if (counts[p] > 0)
+      {
+        const int process_row    = process_info[4 * p];
+        const int process_column = process_info[4 * p + 1];
+        const int local_rows     = process_info[4 * p + 2];
+        const int local_columns  = process_info[4 * p + 3];
+
+        global_rows.resize(local_rows);
+        for (int i = 0; i < local_rows; ++i)
+          {
+            const int fortran_i = i + 1;
+            global_rows[i] = indxl2g_(&fortran_i,
+                                      &row_block_size,
+                                      &process_row,
+                                      &first_process_row,
+                                      &(grid->n_process_rows)) -
+                             1;
+          }
+
+        const NumberType *process_values =
+          all_values.data() + displacements[p];
+        for (int j = 0; j < local_columns; ++j)
+          {
+            const int fortran_j = j + 1;
+            const int glob_j    = indxl2g_(&fortran_j,
+                                        &column_block_size,
+                                        &process_column,
+                                        &first_process_column,
+                                        &(grid->n_process_columns)) -
+                               1;
+            for (int i = 0; i < local_rows; ++i)
+              matrix(global_rows[i], glob_j) =
+                process_values[j * local_rows + i];
+          }
+      }
 
   // we could move the following lines under the main loop above,
   // but they would be dependent on glob_i and glob_j, which
@@ -1799,6 +1865,100 @@ ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_by_value_MRRR(
 
 
 
+template <typename NumberType>
+std::vector<NumberType>
+ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_divide_and_conquer()
+{
+  Assert(state == LAPACKSupport::matrix,
+         ExcMessage(
+           "Matrix has to be in Matrix state before calling this function."));
+  Assert(property == LAPACKSupport::symmetric,
+         ExcMessage("Matrix has to be symmetric for this operation."));
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // psyevd needs a separate matrix for the eigenvectors with the same
+  // block-cyclic distribution as the matrix
+  ScaLAPACKMatrix<NumberType> eigenvectors(n_rows, grid, row_block_size);
+  std::vector<NumberType>     ev(n_rows);
+
+  if (grid->mpi_process_is_active)
+    {
+      int        info = 0;
+      const char jobz = 'V';
+
+      /*
+       * By setting lwork to -1 a workspace query for optimal length of work is
+       * performed.
+       */
+      int lwork  = -1;
+      int liwork = 1;
+      work.resize(1);
+      iwork.resize(1);
+
+      psyevd(&jobz,
+             &uplo,
+             &n_rows,
+             this->values.data(),
+             &submatrix_row,
+             &submatrix_column,
+             descriptor,
+             ev.data(),
+             eigenvectors.values.data(),
+             &eigenvectors.submatrix_row,
+             &eigenvectors.submatrix_column,
+             eigenvectors.descriptor,
+             work.data(),
+             &lwork,
+             iwork.data(),
+             &liwork,
+             &info);
+
+      AssertThrow(info == 0, LAPACKSupport::ExcErrorCode("psyevd", info));
+
+      lwork = static_cast<int>(work[0]);
+      work.resize(lwork);
+      liwork = std::max(iwork[0], 1);
+      iwork.resize(liwork);
+
+      psyevd(&jobz,
+             &uplo,
+             &n_rows,
+             this->values.data(),
+             &submatrix_row,
+             &submatrix_column,
+             descriptor,
+             ev.data(),
+             eigenvectors.values.data(),
+             &eigenvectors.submatrix_row,
+             &eigenvectors.submatrix_column,
+             eigenvectors.descriptor,
+             work.data(),
+             &lwork,
+             iwork.data(),
+             &liwork,
+             &info);
+
+      AssertThrow(info == 0, LAPACKSupport::ExcErrorCode("psyevd", info));
+
+      // the temporary matrix of the eigenvectors has identical dimensions and
+      // block-cyclic distribution, so we simply swap the local arrays
+      this->values.swap(eigenvectors.values);
+    }
+
+  /*
+   * Send the eigenvalues to processors not being part of the process grid.
+   */
+  grid->send_to_inactive(ev.data(), ev.size());
+
+  property = LAPACKSupport::Property::general;
+  state    = LAPACKSupport::eigenvalues;
+
+  return ev;
+}
+
+
+
 template <typename NumberType>
 std::vector<NumberType>
 ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_MRRR(
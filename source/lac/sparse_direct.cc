@@ -215,10 +215,31 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
 {
   Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
 
-  clear();
-
   using number = typename Matrix::value_type;
 
+  // the symbolic factorization only depends on the sparsity pattern, so
+  // keep the arrays describing the pattern of the previous call around to
+  // check whether the symbolic factorization can be reused. the numeric
+  // factorization always has to be recomputed
+  std::vector<long int> previous_Ap;
+  std::vector<long int> previous_Ai;
+  const bool            symbolic_is_complex = (Az.size() != 0);
+  if (symbolic_decomposition != nullptr)
+    {
+      previous_Ap.swap(Ap);
+      previous_Ai.swap(Ai);
+    }
+  if (numeric_decomposition != nullptr)
+    {
+      if (symbolic_is_complex)
+        umfpack_zl_free_numeric(&numeric_decomposition);
+      else
+        umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+  if (numbers::NumberTraits<number>::is_complex == false)
+    Az.clear();
+
   n_rows = matrix.m();
   n_cols = matrix.n();
 
@@ -292,29 +313,26 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // different function
   sort_arrays(matrix);
 
-  int status;
-  if (numbers::NumberTraits<number>::is_complex == false)
-    status = umfpack_dl_symbolic(N,
-                                 N,
-                                 Ap.data(),
-                                 Ai.data(),
-                                 Ax.data(),
-                                 &symbolic_decomposition,
-                                 control.data(),
-                                 nullptr);
-  else
-    status = umfpack_zl_symbolic(N,
-                                 N,
-                                 Ap.data(),
-                                 Ai.data(),
-                                 Ax.data(),
-                                 Az.data(),
-                                 &symbolic_decomposition,
-                                 control.data(),
-                                 nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_symbolic", status));
+  const bool reuse_symbolic_decomposition =
+    symbolic_decomposition != nullptr &&
+    symbolic_is_complex == numbers::NumberTraits<number>::is_complex &&
+    previous_Ap == Ap && previous_Ai == Ai;
+  if (reuse_symbolic_decomposition == false)
+    {
+      if (symbolic_decomposition != nullptr)
+        {
+          if (symbolic_is_complex)
+            umfpack_zl_free_symbolic(&symbolic_decomposition);
+          else
+            umfpack_dl_free_symbolic(&symbolic_decomposition);
+          symbolic_decomposition = nullptr;
+        }
+      compute_symbolic_decomposition(
+        std::integral_constant<bool,
+                               numbers::NumberTraits<number>::is_complex>());
+    }
 
+  int status;
   if (numbers::NumberTraits<number>::is_complex == false)
     status = umfpack_dl_numeric(Ap.data(),
                                 Ai.data(),
@@ -334,8 +352,43 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                                 nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
+}
+
 
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
+
+void
+SparseDirectUMFPACK::compute_symbolic_decomposition(std::false_type)
+{
+  const long int N      = n_rows;
+  const int      status = umfpack_dl_symbolic(N,
+                                         N,
+                                         Ap.data(),
+                                         Ai.data(),
+                                         Ax.data(),
+                                         &symbolic_decomposition,
+                                         control.data(),
+                                         nullptr);
+  AssertThrow(status == UMFPACK_OK,
+              ExcUMFPACKError("umfpack_dl_symbolic", status));
+}
+
+
+
+void
+SparseDirectUMFPACK::compute_symbolic_decomposition(std::true_type)
+{
+  const long int N      = n_rows;
+  const int      status = umfpack_zl_symbolic(N,
+                                         N,
+                                         Ap.data(),
+                                         Ai.data(),
+                                         Ax.data(),
+                                         Az.data(),
+                                         &symbolic_decomposition,
+                                         control.data(),
+                                         nullptr);
+  AssertThrow(status == UMFPACK_OK,
+              ExcUMFPACKError("umfpack_zl_symbolic", status));
 }
 
 
@@ -380,6 +433,55 @@ SparseDirectUMFPACK::solve(Vector<double> &rhs_and_solution,
 
 
 
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &rhs_and_solution,
+                           const bool transpose /*=false*/) const
+{
+  // make sure that some kind of factorize() call has happened before
+  Assert(Ap.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() == Ax.size(), ExcNotInitialized());
+
+  Assert(Az.size() == 0,
+         ExcMessage("You have previously factored a matrix using this class "
+                    "that had complex-valued entries. This then requires "
+                    "applying the factored matrix to a complex-valued "
+                    "vector, but you are only providing a real-valued vector "
+                    "here."));
+
+  // allocate the copy of the right hand side and the work arrays only once
+  // for all right hand sides, whereas umfpack_dl_solve() would allocate
+  // the work arrays in every call. the size of the work array W is the one
+  // required with iterative refinement
+  Vector<double>        rhs(n_rows);
+  std::vector<long int> Wi(n_rows);
+  std::vector<double>   W(5 * n_rows);
+
+  // as in the function above, we solve for UMFPACK's A^T or A
+  for (Vector<double> &solution : rhs_and_solution)
+    {
+      AssertDimension(solution.size(), n_rows);
+      rhs = solution;
+
+      const int status =
+        umfpack_dl_wsolve(transpose ? UMFPACK_A : UMFPACK_At,
+                          Ap.data(),
+                          Ai.data(),
+                          Ax.data(),
+                          solution.begin(),
+                          rhs.begin(),
+                          numeric_decomposition,
+                          control.data(),
+                          nullptr,
+                          Wi.data(),
+                          W.data());
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_wsolve", status));
+    }
+}
+
+
+
 void
 SparseDirectUMFPACK::solve(Vector<std::complex<double>> &rhs_and_solution,
                            const bool transpose /*=false*/) const
@@ -649,6 +751,19 @@ SparseDirectUMFPACK::solve(Vector<double> &, const bool) const
 
 
 
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &, const bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II "
+      "without passing the necessary switch to 'cmake'. Please consult the "
+      "installation instructions in doc/readme.html."));
+}
+
+
+
 void
 SparseDirectUMFPACK::solve(Vector<std::complex<double>> &, const bool) const
 {
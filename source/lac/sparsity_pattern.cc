@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -300,11 +301,12 @@ SparsityPattern::reinit(const size_type                      m,
       rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
     }
 
-  // allocate memory for the column numbers if necessary
+  // allocate memory for the column numbers if necessary. the memory is
+  // not initialized here, see below
   if (vec_len > max_vec_len)
     {
       max_vec_len = vec_len;
-      colnums     = std::make_unique<size_type[]>(max_vec_len);
+      colnums.reset(new size_type[max_vec_len]);
     }
 
   // set the rowstart array
@@ -320,14 +322,27 @@ SparsityPattern::reinit(const size_type                      m,
            ((vec_len == 1) && (rowstart[rows] == 0)),
          ExcInternalError());
 
-  // preset the column numbers by a value indicating it is not in use
-  std::fill_n(colnums.get(), vec_len, invalid_entry);
-
-  // if diagonal elements are special: let the first entry in each row be the
-  // diagonal value
-  if (store_diagonal_first_in_row)
-    for (size_type i = 0; i < rows; ++i)
-      colnums[rowstart[i]] = i;
+  // preset the column numbers by a value indicating it is not in use. if
+  // diagonal elements are special: let the first entry in each row be the
+  // diagonal value. this is done in parallel with the same partitioning of
+  // the rows as in SparseMatrix::vmult() so that, on NUMA systems, the
+  // memory of each row is first touched by a thread that is likely to work
+  // on it later on
+  parallel::apply_to_subranges(
+    size_type(0),
+    rows,
+    [&](const size_type begin, const size_type end) {
+      std::fill(colnums.get() + rowstart[begin],
+                colnums.get() + rowstart[end],
+                invalid_entry);
+      if (store_diagonal_first_in_row)
+        for (size_type i = begin; i < end; ++i)
+          colnums[rowstart[i]] = i;
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+  std::fill(colnums.get() + rowstart[rows],
+            colnums.get() + vec_len,
+            invalid_entry);
 
   compressed = false;
 }
@@ -348,83 +363,101 @@ SparsityPattern::compress()
   if (compressed)
     return;
 
-  size_type next_free_entry = 0, next_row_start = 0, row_length = 0;
-
-  // first find out how many non-zero elements there are, in order to allocate
-  // the right amount of memory
-  const std::size_t nonzero_elements =
-    std::count_if(&colnums[rowstart[0]],
-                  &colnums[rowstart[rows]],
-                  [](const size_type col) { return col != invalid_entry; });
-  // now allocate the respective memory
-  std::unique_ptr<size_type[]> new_colnums(new size_type[nonzero_elements]);
-
-
-  // reserve temporary storage to store the entries of one row
-  std::vector<size_type> tmp_entries(max_row_length);
-
-  // Traverse all rows
-  for (size_type line = 0; line < rows; ++line)
+  const unsigned int grain_size =
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size;
+
+  // first find out how many entries are in use in each row, in order to
+  // allocate the right amount of memory. used entries are stored
+  // contiguously at the beginning of each row
+  std::vector<std::size_t> new_rowstart(rows + 1, 0);
+  parallel::apply_to_subranges(
+    size_type(0),
+    rows,
+    [&](const size_type begin, const size_type end) {
+      for (size_type line = begin; line < end; ++line)
+        {
+          std::size_t j = rowstart[line];
+          while (j < rowstart[line + 1] && colnums[j] != invalid_entry)
+            ++j;
+          new_rowstart[line + 1] = j - rowstart[line];
+        }
+    },
+    grain_size);
+  std::partial_sum(new_rowstart.begin(),
+                   new_rowstart.end(),
+                   new_rowstart.begin());
+  const std::size_t nonzero_elements = new_rowstart[rows];
+
+  // Sort only beginning at the second entry, if optimized storage of
+  // diagonal entries is on.
+  const unsigned int sort_offset = store_diagonal_first_in_row ? 1 : 0;
+
+  // if every allocated slot is in use (e.g., because the row lengths passed
+  // to reinit() were exact), we only need to sort the rows in place and can
+  // avoid allocating a second array of column indices
+  if ((nonzero_elements == rowstart[rows]) &&
+      (max_vec_len == rowstart[rows]))
     {
-      // copy used entries, break if first unused entry is reached
-      row_length = 0;
-      for (size_type j = rowstart[line]; j < rowstart[line + 1];
-           ++j, ++row_length)
-        if (colnums[j] != invalid_entry)
-          tmp_entries[row_length] = colnums[j];
-        else
-          break;
-      // now @p{rowstart} is the number of entries in this line
-
-      // Sort only beginning at the second entry, if optimized storage of
-      // diagonal entries is on.
-
-      // if this line is empty or has only one entry, don't sort
-      if (row_length > 1)
-        std::sort((store_diagonal_first_in_row) ? tmp_entries.begin() + 1 :
-                                                  tmp_entries.begin(),
-                  tmp_entries.begin() + row_length);
-
-      // insert column numbers into the new field
-      for (size_type j = 0; j < row_length; ++j)
-        new_colnums[next_free_entry++] = tmp_entries[j];
-
-      // note new start of this and the next row
-      rowstart[line] = next_row_start;
-      next_row_start = next_free_entry;
-
-      // some internal checks: either the matrix is not quadratic, or if it
-      // is, then the first element of this row must be the diagonal element
-      // (i.e. with column index==line number)
-      // this test only makes sense if we have written to the index
-      // rowstart_line in new_colnums which is the case if row_length is not 0,
-      // so check this first
-      Assert((!store_diagonal_first_in_row) ||
-               (row_length != 0 && new_colnums[rowstart[line]] == line),
-             ExcInternalError());
-      // assert that the first entry does not show up in the remaining ones
-      // and that the remaining ones are unique among themselves (this handles
-      // both cases, quadratic and rectangular matrices)
-      //
-      // the only exception here is if the row contains no entries at all
-      Assert((rowstart[line] == next_row_start) ||
-               (std::find(&new_colnums[rowstart[line] + 1],
-                          &new_colnums[next_row_start],
-                          new_colnums[rowstart[line]]) ==
-                &new_colnums[next_row_start]),
-             ExcInternalError());
-      Assert((rowstart[line] == next_row_start) ||
-               (std::adjacent_find(&new_colnums[rowstart[line] + 1],
-                                   &new_colnums[next_row_start]) ==
-                &new_colnums[next_row_start]),
-             ExcInternalError());
+      parallel::apply_to_subranges(
+        size_type(0),
+        rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type line = begin; line < end; ++line)
+            if (rowstart[line + 1] - rowstart[line] > 1)
+              std::sort(colnums.get() + rowstart[line] + sort_offset,
+                        colnums.get() + rowstart[line + 1]);
+        },
+        grain_size);
+      compressed = true;
+      return;
     }
 
-  // assert that we have used all allocated space, no more and no less
-  Assert(next_free_entry == nonzero_elements, ExcInternalError());
+  // now allocate the respective memory. the entries are not initialized
+  // here but written by the threads that later work on the respective rows,
+  // which places the memory close to them on NUMA systems
+  std::unique_ptr<size_type[]> new_colnums(new size_type[nonzero_elements]);
+
+  // copy the used entries of each row into the new field and sort them
+  parallel::apply_to_subranges(
+    size_type(0),
+    rows,
+    [&](const size_type begin, const size_type end) {
+      for (size_type line = begin; line < end; ++line)
+        {
+          size_type *const row_begin = new_colnums.get() + new_rowstart[line];
+          size_type *const row_end =
+            new_colnums.get() + new_rowstart[line + 1];
+          std::copy(colnums.get() + rowstart[line],
+                    colnums.get() + rowstart[line] + (row_end - row_begin),
+                    row_begin);
+
+          // if this line is empty or has only one entry, don't sort
+          if (row_end - row_begin > 1)
+            std::sort(row_begin + sort_offset, row_end);
+
+          // some internal checks: either the matrix is not quadratic, or if
+          // it is, then the first element of this row must be the diagonal
+          // element (i.e. with column index==line number)
+          Assert((!store_diagonal_first_in_row) ||
+                   (row_end != row_begin && *row_begin == line),
+                 ExcInternalError());
+          // assert that the first entry does not show up in the remaining
+          // ones and that the remaining ones are unique among themselves
+          // (this handles both cases, quadratic and rectangular matrices)
+          //
+          // the only exception here is if the row contains no entries at all
+          Assert((row_begin == row_end) ||
+                   (std::find(row_begin + 1, row_end, *row_begin) == row_end),
+                 ExcInternalError());
+          Assert((row_begin == row_end) ||
+                   (std::adjacent_find(row_begin + 1, row_end) == row_end),
+                 ExcInternalError());
+        }
+    },
+    grain_size);
 
-  // set iterator-past-the-end
-  rowstart[rows] = next_row_start;
+  // set the new row starts, including iterator-past-the-end
+  std::copy(new_rowstart.begin(), new_rowstart.end(), rowstart.get());
 
   // set colnums to the newly allocated array and delete previous content
   // in the process
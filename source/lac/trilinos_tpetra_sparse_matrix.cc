@@ -0,0 +1,420 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/lac/trilinos_tpetra_sparse_matrix.h>
+
+#if defined(DEAL_II_TRILINOS_WITH_TPETRA) && defined(DEAL_II_WITH_MPI)
+
+#  include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#  include <Teuchos_ArrayView.hpp>
+
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace LinearAlgebra
+{
+  namespace TpetraWrappers
+  {
+    template <typename Number>
+    SparseMatrix<Number>::SparseMatrix(
+      const IndexSet &              row_parallel_partitioning,
+      const IndexSet &              col_parallel_partitioning,
+      const DynamicSparsityPattern &sparsity_pattern,
+      const MPI_Comm &              communicator)
+    {
+      reinit(row_parallel_partitioning,
+             col_parallel_partitioning,
+             sparsity_pattern,
+             communicator);
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::reinit(
+      const IndexSet &              row_parallel_partitioning,
+      const IndexSet &              col_parallel_partitioning,
+      const DynamicSparsityPattern &sparsity_pattern,
+      const MPI_Comm &              communicator)
+    {
+      AssertDimension(sparsity_pattern.n_rows(),
+                      row_parallel_partitioning.size());
+      AssertDimension(sparsity_pattern.n_cols(),
+                      col_parallel_partitioning.size());
+
+      row_partitioning = row_parallel_partitioning;
+      col_partitioning = col_parallel_partitioning;
+
+      row_map = Teuchos::rcp(
+        new MapType(row_parallel_partitioning.make_tpetra_map(communicator,
+                                                              false)));
+      domain_map = Teuchos::rcp(
+        new MapType(col_parallel_partitioning.make_tpetra_map(communicator,
+                                                              false)));
+
+      // the graph is allocated with the exact row lengths, so that all
+      // entries can be inserted without reallocation
+      std::vector<size_t> n_entries_per_row;
+      n_entries_per_row.reserve(row_parallel_partitioning.n_elements());
+      for (const size_type row : row_parallel_partitioning)
+        n_entries_per_row.push_back(sparsity_pattern.row_length(row));
+
+      graph = Teuchos::rcp(new GraphType(
+        row_map,
+        Teuchos::ArrayView<const size_t>(n_entries_per_row.data(),
+                                         n_entries_per_row.size())));
+
+      n_local_entries = 0;
+      std::vector<size_type> column_indices;
+      for (const size_type row : row_parallel_partitioning)
+        {
+          column_indices.clear();
+          for (auto entry = sparsity_pattern.begin(row);
+               entry != sparsity_pattern.end(row);
+               ++entry)
+            column_indices.push_back(entry->column());
+          n_local_entries += column_indices.size();
+
+          if (column_indices.size() > 0)
+            graph->insertGlobalIndices(
+              row,
+              Teuchos::ArrayView<const size_type>(column_indices.data(),
+                                                  column_indices.size()));
+        }
+      graph->fillComplete(domain_map, row_map);
+
+      // the matrix uses the graph as a static graph and is left open for
+      // the assembly, which is closed by compress()
+      matrix = Teuchos::rcp(new MatrixType(graph));
+      matrix->setAllToScalar(Number());
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::clear()
+    {
+      matrix     = Teuchos::null;
+      graph      = Teuchos::null;
+      domain_map = Teuchos::null;
+      row_map    = Teuchos::null;
+      row_partitioning.clear();
+      col_partitioning.clear();
+      n_local_entries = 0;
+    }
+
+
+
+    template <typename Number>
+    SparseMatrix<Number> &
+    SparseMatrix<Number>::operator=(const Number d)
+    {
+      (void)d;
+      Assert(d == Number(), ExcScalarAssignmentOnlyForZeroValue());
+      Assert(!matrix.is_null(), ExcNotInitialized());
+
+      if (matrix->isFillComplete())
+        matrix->resumeFill();
+      matrix->setAllToScalar(Number());
+
+      return *this;
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::set(const size_type i,
+                              const size_type j,
+                              const Number    value)
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      Assert(row_partitioning.is_element(i),
+             ExcMessage("Only entries in locally owned rows can be set."));
+
+      if (matrix->isFillComplete())
+        matrix->resumeFill();
+
+      const auto n_set = matrix->replaceGlobalValues(
+        i,
+        Teuchos::ArrayView<const size_type>(&j, 1),
+        Teuchos::ArrayView<const Number>(&value, 1));
+      (void)n_set;
+      Assert(n_set == 1, ExcInvalidIndex(i, j));
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::add(const size_type i,
+                              const size_type j,
+                              const Number    value)
+    {
+      add(i, 1, &j, &value, false);
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::add(const size_type  row,
+                              const size_type  n_cols,
+                              const size_type *col_indices,
+                              const Number *   values,
+                              const bool       elide_zero_values,
+                              const bool /*col_indices_are_sorted*/)
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+
+      if (matrix->isFillComplete())
+        matrix->resumeFill();
+
+      const size_type *col_index_ptr = col_indices;
+      const Number *   value_ptr     = values;
+      size_type        n_columns     = n_cols;
+
+      // remove the zero entries, as Tpetra would otherwise still search for
+      // their positions in the row
+      std::vector<size_type> nonzero_indices;
+      std::vector<Number>    nonzero_values;
+      if (elide_zero_values)
+        {
+          nonzero_indices.reserve(n_cols);
+          nonzero_values.reserve(n_cols);
+          for (size_type j = 0; j < n_cols; ++j)
+            if (values[j] != Number())
+              {
+                nonzero_indices.push_back(col_indices[j]);
+                nonzero_values.push_back(values[j]);
+              }
+          col_index_ptr = nonzero_indices.data();
+          value_ptr     = nonzero_values.data();
+          n_columns     = nonzero_indices.size();
+        }
+
+      if (n_columns == 0)
+        return;
+
+      // entries in rows owned by other processes are stored by Tpetra and
+      // sent to their owners in globalAssemble()
+      const auto n_added = matrix->sumIntoGlobalValues(
+        row,
+        Teuchos::ArrayView<const size_type>(col_index_ptr, n_columns),
+        Teuchos::ArrayView<const Number>(value_ptr, n_columns));
+      (void)n_added;
+      Assert(!row_partitioning.is_element(row) ||
+               static_cast<size_type>(n_added) == n_columns,
+             ExcMessage("Some of the entries to be added are not part of the "
+                        "sparsity pattern of the matrix."));
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::compress(const VectorOperation::values operation)
+    {
+      (void)operation;
+      Assert(operation == VectorOperation::add ||
+               operation == VectorOperation::insert,
+             ExcNotImplemented());
+      Assert(!matrix.is_null(), ExcNotInitialized());
+
+      if (matrix->isFillComplete())
+        return;
+
+      matrix->globalAssemble();
+      matrix->fillComplete(domain_map, row_map);
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::m() const
+    {
+      return row_partitioning.size();
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::n() const
+    {
+      return col_partitioning.size();
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::n_nonzero_elements() const
+    {
+      return graph.is_null() ? 0 : graph->getGlobalNumEntries();
+    }
+
+
+
+    template <typename Number>
+    IndexSet
+    SparseMatrix<Number>::locally_owned_range_indices() const
+    {
+      return row_partitioning;
+    }
+
+
+
+    template <typename Number>
+    IndexSet
+    SparseMatrix<Number>::locally_owned_domain_indices() const
+    {
+      return col_partitioning;
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::vmult(Vector<Number> &      dst,
+                                const Vector<Number> &src) const
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      Assert(matrix->isFillComplete(),
+             ExcMessage("Call compress() before using the matrix."));
+
+      matrix->apply(src.trilinos_vector(),
+                    dst.trilinos_vector(),
+                    Teuchos::NO_TRANS,
+                    Teuchos::ScalarTraits<Number>::one(),
+                    Teuchos::ScalarTraits<Number>::zero());
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::Tvmult(Vector<Number> &      dst,
+                                 const Vector<Number> &src) const
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      Assert(matrix->isFillComplete(),
+             ExcMessage("Call compress() before using the matrix."));
+
+      matrix->apply(src.trilinos_vector(),
+                    dst.trilinos_vector(),
+                    Teuchos::TRANS,
+                    Teuchos::ScalarTraits<Number>::one(),
+                    Teuchos::ScalarTraits<Number>::zero());
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::vmult_add(Vector<Number> &      dst,
+                                    const Vector<Number> &src) const
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      Assert(matrix->isFillComplete(),
+             ExcMessage("Call compress() before using the matrix."));
+
+      matrix->apply(src.trilinos_vector(),
+                    dst.trilinos_vector(),
+                    Teuchos::NO_TRANS,
+                    Teuchos::ScalarTraits<Number>::one(),
+                    Teuchos::ScalarTraits<Number>::one());
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::Tvmult_add(Vector<Number> &      dst,
+                                     const Vector<Number> &src) const
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      Assert(matrix->isFillComplete(),
+             ExcMessage("Call compress() before using the matrix."));
+
+      matrix->apply(src.trilinos_vector(),
+                    dst.trilinos_vector(),
+                    Teuchos::TRANS,
+                    Teuchos::ScalarTraits<Number>::one(),
+                    Teuchos::ScalarTraits<Number>::one());
+    }
+
+
+
+    template <typename Number>
+    const typename SparseMatrix<Number>::MatrixType &
+    SparseMatrix<Number>::trilinos_matrix() const
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      return *matrix;
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::MatrixType &
+    SparseMatrix<Number>::trilinos_matrix()
+    {
+      Assert(!matrix.is_null(), ExcNotInitialized());
+      return *matrix;
+    }
+
+
+
+    template <typename Number>
+    Teuchos::RCP<typename SparseMatrix<Number>::MatrixType>
+    SparseMatrix<Number>::trilinos_rcp() const
+    {
+      return matrix;
+    }
+
+
+
+    template <typename Number>
+    std::size_t
+    SparseMatrix<Number>::memory_consumption() const
+    {
+      // one column index for the graph and one value for the matrix per
+      // entry, plus the row offsets of both
+      return row_partitioning.memory_consumption() +
+             col_partitioning.memory_consumption() +
+             n_local_entries * (sizeof(size_type) + sizeof(Number)) +
+             2 * (row_partitioning.n_elements() + 1) * sizeof(std::size_t);
+    }
+
+
+
+    template class SparseMatrix<float>;
+    template class SparseMatrix<double>;
+#  ifdef DEAL_II_WITH_COMPLEX_VALUES
+    template class SparseMatrix<std::complex<float>>;
+    template class SparseMatrix<std::complex<double>>;
+#  endif
+  } // namespace TpetraWrappers
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
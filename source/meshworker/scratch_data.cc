@@ -37,6 +37,7 @@ namespace MeshWorker
     , neighbor_cell_update_flags(update_flags)
     , face_update_flags(face_update_flags)
     , neighbor_face_update_flags(face_update_flags)
+    , geometry_cache_max_n_entries(0)
     , local_dof_indices(fe.dofs_per_cell)
     , neighbor_dof_indices(fe.dofs_per_cell)
   {}
@@ -61,6 +62,7 @@ namespace MeshWorker
     , neighbor_cell_update_flags(neighbor_update_flags)
     , face_update_flags(face_update_flags)
     , neighbor_face_update_flags(neighbor_face_update_flags)
+    , geometry_cache_max_n_entries(0)
     , local_dof_indices(fe.dofs_per_cell)
     , neighbor_dof_indices(fe.dofs_per_cell)
   {}
@@ -116,6 +118,7 @@ namespace MeshWorker
     , neighbor_cell_update_flags(scratch.neighbor_cell_update_flags)
     , face_update_flags(scratch.face_update_flags)
     , neighbor_face_update_flags(scratch.neighbor_face_update_flags)
+    , geometry_cache_max_n_entries(scratch.geometry_cache_max_n_entries)
     , local_dof_indices(scratch.local_dof_indices)
     , neighbor_dof_indices(scratch.neighbor_dof_indices)
     , user_data_storage(scratch.user_data_storage)
@@ -130,10 +133,12 @@ namespace MeshWorker
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell)
   {
     if (!fe_values)
-      fe_values = std::make_unique<FEValues<dim, spacedim>>(*mapping,
-                                                            *fe,
-                                                            cell_quadrature,
-                                                            cell_update_flags);
+      {
+        fe_values = std::make_unique<FEValues<dim, spacedim>>(
+          *mapping, *fe, cell_quadrature, cell_update_flags);
+        if (geometry_cache_max_n_entries > 0)
+          fe_values->enable_geometry_cache(geometry_cache_max_n_entries);
+      }
 
     fe_values->reinit(cell);
     cell->get_dof_indices(local_dof_indices);
@@ -191,8 +196,13 @@ namespace MeshWorker
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell)
   {
     if (!neighbor_fe_values)
-      neighbor_fe_values = std::make_unique<FEValues<dim, spacedim>>(
-        *mapping, *fe, cell_quadrature, neighbor_cell_update_flags);
+      {
+        neighbor_fe_values = std::make_unique<FEValues<dim, spacedim>>(
+          *mapping, *fe, cell_quadrature, neighbor_cell_update_flags);
+        if (geometry_cache_max_n_entries > 0)
+          neighbor_fe_values->enable_geometry_cache(
+            geometry_cache_max_n_entries);
+      }
 
     neighbor_fe_values->reinit(cell);
     cell->get_dof_indices(neighbor_dof_indices);
@@ -346,6 +356,20 @@ namespace MeshWorker
     return *mapping;
   }
 
+
+
+  template <int dim, int spacedim>
+  void
+  ScratchData<dim, spacedim>::enable_geometry_cache(
+    const unsigned int max_n_entries)
+  {
+    geometry_cache_max_n_entries = max_n_entries;
+    if (fe_values)
+      fe_values->enable_geometry_cache(max_n_entries);
+    if (neighbor_fe_values)
+      neighbor_fe_values->enable_geometry_cache(max_n_entries);
+  }
+
 } // namespace MeshWorker
 DEAL_II_NAMESPACE_CLOSE
 
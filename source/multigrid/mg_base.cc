@@ -30,6 +30,20 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+template <typename VectorType>
+void
+MGTransferBase<VectorType>::restrict_residual_and_add(
+  const unsigned int from_level,
+  VectorType &       dst,
+  const VectorType & rhs,
+  VectorType &       matrix_times_u) const
+{
+  matrix_times_u.sadd(-1.0, 1.0, rhs);
+  restrict_and_add(from_level, dst, matrix_times_u);
+}
+
+
+
 template <typename VectorType>
 void
 MGSmootherBase<VectorType>::apply(const unsigned int level,
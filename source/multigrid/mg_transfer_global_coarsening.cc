@@ -0,0 +1,875 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_poly.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MGTransferGlobalCoarseningTools
+{
+  unsigned int
+  create_next_polynomial_coarsening_degree(
+    const unsigned int                      degree,
+    const PolynomialCoarseningSequenceType &p_sequence)
+  {
+    switch (p_sequence)
+      {
+        case PolynomialCoarseningSequenceType::bisect:
+          return std::max(degree / 2, 1u);
+        case PolynomialCoarseningSequenceType::decrease_by_one:
+          return std::max(degree - 1, 1u);
+        case PolynomialCoarseningSequenceType::go_to_one:
+          return 1u;
+        default:
+          Assert(false, ExcNotImplemented());
+          return 1u;
+      }
+  }
+
+
+
+  std::vector<unsigned int>
+  create_polynomial_coarsening_sequence(
+    const unsigned int                      max_degree,
+    const PolynomialCoarseningSequenceType &p_sequence)
+  {
+    Assert(max_degree > 0, ExcMessage("The polynomial degree must be positive."));
+
+    std::vector<unsigned int> degrees{max_degree};
+    while (degrees.back() > 1)
+      degrees.push_back(
+        create_next_polynomial_coarsening_degree(degrees.back(), p_sequence));
+
+    std::reverse(degrees.begin(), degrees.end());
+
+    return degrees;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  partition_triangulation_onto_subset(
+    Triangulation<dim, spacedim> &tria,
+    const MPI_Comm                communicator,
+    const unsigned int            min_cells_per_process)
+  {
+    const unsigned int n_procs = Utilities::MPI::n_mpi_processes(communicator);
+    const unsigned int n_partitions =
+      std::max(1u,
+               std::min(n_procs,
+                        tria.n_active_cells() /
+                          std::max(min_cells_per_process, 1u)));
+
+    GridTools::partition_triangulation_zorder(n_partitions, tria);
+
+    // spread the partitions evenly over the ranks, rather than placing all
+    // of them on the first ranks (which are typically on the same node)
+    if (n_partitions < n_procs)
+      for (const auto &cell : tria.active_cell_iterators())
+        cell->set_subdomain_id(static_cast<types::subdomain_id>(
+          static_cast<std::uint64_t>(cell->subdomain_id()) * n_procs /
+          n_partitions));
+
+    return n_partitions;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  set_next_polynomial_coarsening_fe_indices(
+    const hp::DoFHandler<dim, spacedim> &   dof_handler_fine,
+    hp::DoFHandler<dim, spacedim> &         dof_handler_coarse,
+    const PolynomialCoarseningSequenceType &p_sequence)
+  {
+    Assert(&dof_handler_fine.get_triangulation() ==
+             &dof_handler_coarse.get_triangulation(),
+           ExcMessage("The two DoFHandler objects need to be based on the "
+                      "same triangulation."));
+
+    const hp::FECollection<dim, spacedim> &fe_collection_coarse =
+      dof_handler_coarse.get_fe_collection();
+
+    auto cell_coarse = dof_handler_coarse.begin_active();
+    for (const auto &cell_fine : dof_handler_fine.active_cell_iterators())
+      {
+        if (cell_fine->is_locally_owned())
+          {
+            const unsigned int degree =
+              create_next_polynomial_coarsening_degree(
+                cell_fine->get_fe().degree, p_sequence);
+
+            unsigned int fe_index = numbers::invalid_unsigned_int;
+            for (unsigned int i = 0; i < fe_collection_coarse.size(); ++i)
+              if (fe_collection_coarse[i].degree == degree)
+                {
+                  fe_index = i;
+                  break;
+                }
+            AssertThrow(fe_index != numbers::invalid_unsigned_int,
+                        ExcMessage("The FECollection of the coarse "
+                                   "DoFHandler contains no element of "
+                                   "degree " +
+                                   std::to_string(degree) + "."));
+
+            cell_coarse->set_active_fe_index(fe_index);
+          }
+        ++cell_coarse;
+      }
+  }
+} // namespace MGTransferGlobalCoarseningTools
+
+
+
+namespace internal
+{
+  namespace MGTwoLevelTransferImplementation
+  {
+    /**
+     * Extract the 1D polynomials of the scalar base element of @p fe and the
+     * numbering of the cell degrees of freedom in lexicographic order, with
+     * the components running slowest.
+     */
+    template <int dim>
+    void
+    get_tensor_product_data(const FiniteElement<dim> &                fe,
+                            std::vector<Polynomials::Polynomial<double>> &poly,
+                            std::vector<unsigned int> &lexicographic)
+    {
+      AssertThrow(fe.n_base_elements() == 1,
+                  ExcMessage("The global-coarsening transfer is only "
+                             "implemented for a single (scalar or vector) "
+                             "base element."));
+
+      const FE_Poly<dim> *fe_poly =
+        dynamic_cast<const FE_Poly<dim> *>(&fe.base_element(0));
+      const TensorProductPolynomials<dim> *tensor_poly =
+        fe_poly != nullptr ? dynamic_cast<const TensorProductPolynomials<dim> *>(
+                               &fe_poly->get_poly_space()) :
+                             nullptr;
+      AssertThrow(fe.base_element(0).n_components() == 1 &&
+                    tensor_poly != nullptr,
+                  ExcMessage("The global-coarsening transfer is only "
+                             "implemented for elements based on "
+                             "TensorProductPolynomials, like FE_Q and FE_DGQ."));
+
+      poly = tensor_poly->get_underlying_polynomials();
+
+      const std::vector<unsigned int> scalar_lexicographic =
+        fe_poly->get_poly_space_numbering_inverse();
+      lexicographic.resize(fe.n_components() * scalar_lexicographic.size());
+      for (unsigned int c = 0; c < fe.n_components(); ++c)
+        for (unsigned int i = 0; i < scalar_lexicographic.size(); ++i)
+          lexicographic[c * scalar_lexicographic.size() + i] =
+            fe.component_to_system_index(c, scalar_lexicographic[i]);
+    }
+
+
+
+    /**
+     * Return the process that stores the coarse-cell data of the cell with
+     * the given @p id during the setup of the transfer.
+     */
+    inline unsigned int
+    get_dictionary_rank(const CellId &id, const unsigned int n_procs)
+    {
+      return std::hash<std::string>()(id.to_string()) % n_procs;
+    }
+
+
+
+    /**
+     * Interpolate the coarse-cell values @p in of a single component into
+     * the fine cell with the 1D matrices @p shapes, one for each direction.
+     */
+    template <int dim, typename Number>
+    void
+    prolongate_cell(
+      const EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number>
+        &           eval,
+      const Number *shapes[3],
+      const Number *in,
+      Number *      out,
+      Number *      tmp0,
+      Number *      tmp1)
+    {
+      if (dim == 1)
+        eval.template apply<0, true, false>(shapes[0], in, out);
+      else if (dim == 2)
+        {
+          eval.template apply<0, true, false>(shapes[0], in, tmp0);
+          eval.template apply<1, true, false>(shapes[1], tmp0, out);
+        }
+      else
+        {
+          eval.template apply<0, true, false>(shapes[0], in, tmp0);
+          eval.template apply<1, true, false>(shapes[1], tmp0, tmp1);
+          eval.template apply<2, true, false>(shapes[2], tmp1, out);
+        }
+    }
+
+
+
+    /**
+     * Apply the transpose of prolongate_cell().
+     */
+    template <int dim, typename Number>
+    void
+    restrict_cell(
+      const EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number>
+        &           eval,
+      const Number *shapes[3],
+      const Number *in,
+      Number *      out,
+      Number *      tmp0,
+      Number *      tmp1)
+    {
+      if (dim == 1)
+        eval.template apply<0, false, false>(shapes[0], in, out);
+      else if (dim == 2)
+        {
+          eval.template apply<1, false, false>(shapes[1], in, tmp0);
+          eval.template apply<0, false, false>(shapes[0], tmp0, out);
+        }
+      else
+        {
+          eval.template apply<2, false, false>(shapes[2], in, tmp0);
+          eval.template apply<1, false, false>(shapes[1], tmp0, tmp1);
+          eval.template apply<0, false, false>(shapes[0], tmp1, out);
+        }
+    }
+  } // namespace MGTwoLevelTransferImplementation
+} // namespace internal
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  reinit_geometric_transfer(const DoFHandler<dim> &          dof_handler_fine,
+                            const DoFHandler<dim> &          dof_handler_coarse,
+                            const AffineConstraints<Number> &constraint_fine,
+                            const AffineConstraints<Number> &constraint_coarse)
+{
+  reinit(dof_handler_fine,
+         dof_handler_coarse,
+         constraint_fine,
+         constraint_coarse,
+         true);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  reinit_geometric_transfer(const hp::DoFHandler<dim> &dof_handler_fine,
+                            const hp::DoFHandler<dim> &dof_handler_coarse,
+                            const AffineConstraints<Number> &constraint_fine,
+                            const AffineConstraints<Number> &constraint_coarse)
+{
+  reinit(dof_handler_fine,
+         dof_handler_coarse,
+         constraint_fine,
+         constraint_coarse,
+         true);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  reinit_polynomial_transfer(const DoFHandler<dim> &dof_handler_fine,
+                             const DoFHandler<dim> &dof_handler_coarse,
+                             const AffineConstraints<Number> &constraint_fine,
+                             const AffineConstraints<Number> &constraint_coarse)
+{
+  reinit(dof_handler_fine,
+         dof_handler_coarse,
+         constraint_fine,
+         constraint_coarse,
+         false);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  reinit_polynomial_transfer(const hp::DoFHandler<dim> &dof_handler_fine,
+                             const hp::DoFHandler<dim> &dof_handler_coarse,
+                             const AffineConstraints<Number> &constraint_fine,
+                             const AffineConstraints<Number> &constraint_coarse)
+{
+  reinit(dof_handler_fine,
+         dof_handler_coarse,
+         constraint_fine,
+         constraint_coarse,
+         false);
+}
+
+
+
+template <int dim, typename Number>
+template <typename DoFHandlerType>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::reinit(
+  const DoFHandlerType &           dof_handler_fine,
+  const DoFHandlerType &           dof_handler_coarse,
+  const AffineConstraints<Number> &constraint_fine,
+  const AffineConstraints<Number> &constraint_coarse,
+  const bool                       geometric_transfer)
+{
+  using namespace internal::MGTwoLevelTransferImplementation;
+
+  // extract the tensor-product data of all elements of the two levels
+  const auto &fe_collection_fine   = dof_handler_fine.get_fe_collection();
+  const auto &fe_collection_coarse = dof_handler_coarse.get_fe_collection();
+  n_components = fe_collection_fine[0].n_components();
+
+  std::vector<std::vector<Polynomials::Polynomial<double>>> poly_fine(
+    fe_collection_fine.size()),
+    poly_coarse(fe_collection_coarse.size());
+  std::vector<std::vector<unsigned int>> lexicographic_fine(
+    fe_collection_fine.size()),
+    lexicographic_coarse(fe_collection_coarse.size());
+  for (unsigned int i = 0; i < fe_collection_fine.size(); ++i)
+    {
+      AssertThrow(fe_collection_fine[i].n_components() == n_components,
+                  ExcDimensionMismatch(fe_collection_fine[i].n_components(),
+                                       n_components));
+      get_tensor_product_data(fe_collection_fine[i],
+                              poly_fine[i],
+                              lexicographic_fine[i]);
+    }
+  for (unsigned int i = 0; i < fe_collection_coarse.size(); ++i)
+    {
+      AssertThrow(fe_collection_coarse[i].n_components() == n_components,
+                  ExcDimensionMismatch(fe_collection_coarse[i].n_components(),
+                                       n_components));
+      get_tensor_product_data(fe_collection_coarse[i],
+                              poly_coarse[i],
+                              lexicographic_coarse[i]);
+    }
+
+  // compute the 1D embedding matrices of a pair of elements by a projection
+  // of the coarse shape functions onto the fine ones, with the fine cell
+  // being the left child, the right child, or the whole coarse cell
+  const auto create_scheme = [&](const unsigned int fine_fe_index,
+                                 const unsigned int coarse_fe_index) {
+    const std::vector<Polynomials::Polynomial<double>> &fine =
+      poly_fine[fine_fe_index];
+    const std::vector<Polynomials::Polynomial<double>> &coarse =
+      poly_coarse[coarse_fe_index];
+
+    TransferScheme scheme;
+    scheme.n_fine_dofs_1d   = fine.size();
+    scheme.n_coarse_dofs_1d = coarse.size();
+    const unsigned int n_fine_dofs_1d   = scheme.n_fine_dofs_1d;
+    const unsigned int n_coarse_dofs_1d = scheme.n_coarse_dofs_1d;
+
+    const QGauss<1>    quadrature(std::max(n_fine_dofs_1d, n_coarse_dofs_1d));
+    FullMatrix<double> mass_matrix(n_fine_dofs_1d, n_fine_dofs_1d);
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      for (unsigned int i = 0; i < n_fine_dofs_1d; ++i)
+        for (unsigned int j = 0; j < n_fine_dofs_1d; ++j)
+          mass_matrix(i, j) += fine[i].value(quadrature.point(q)[0]) *
+                               fine[j].value(quadrature.point(q)[0]) *
+                               quadrature.weight(q);
+    mass_matrix.gauss_jordan();
+
+    for (unsigned int c = 0; c < 3; ++c)
+      {
+        FullMatrix<double> rhs(n_fine_dofs_1d, n_coarse_dofs_1d);
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          {
+            const double x        = quadrature.point(q)[0];
+            const double x_coarse = c < 2 ? 0.5 * (x + c) : x;
+            for (unsigned int i = 0; i < n_fine_dofs_1d; ++i)
+              for (unsigned int j = 0; j < n_coarse_dofs_1d; ++j)
+                rhs(i, j) += fine[i].value(x) * coarse[j].value(x_coarse) *
+                             quadrature.weight(q);
+          }
+
+        FullMatrix<double> prolongation(n_fine_dofs_1d, n_coarse_dofs_1d);
+        mass_matrix.mmult(prolongation, rhs);
+
+        scheme.prolongation_matrices_1d[c].resize(n_coarse_dofs_1d *
+                                                  n_fine_dofs_1d);
+        for (unsigned int j = 0; j < n_coarse_dofs_1d; ++j)
+          for (unsigned int i = 0; i < n_fine_dofs_1d; ++i)
+            scheme.prolongation_matrices_1d[c][j * n_fine_dofs_1d + i] =
+              prolongation(i, j);
+      }
+
+    return scheme;
+  };
+
+  const auto *tria_parallel =
+    dynamic_cast<const parallel::TriangulationBase<dim> *>(
+      &dof_handler_fine.get_triangulation());
+  const MPI_Comm communicator =
+    tria_parallel != nullptr ? tria_parallel->get_communicator() :
+                               MPI_COMM_SELF;
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(communicator);
+
+  // the data of a coarse cell: the active FE index, the pointers into the
+  // list of constraint entries for each lexicographic degree of freedom and
+  // the entries themselves, with unconstrained degrees of freedom represented
+  // by a single entry of weight one
+  using CoarseCellData = std::pair<
+    unsigned int,
+    std::pair<std::vector<unsigned int>,
+              std::vector<std::pair<types::global_dof_index, double>>>>;
+
+  // the coarse cell of a locally owned fine cell is not necessarily
+  // available on the same process, so we first send the data of all locally
+  // owned coarse cells to a process identified by the id of the cell, and
+  // then ask those processes for the data needed on the fine cells
+  std::map<unsigned int, std::vector<std::pair<CellId, CoarseCellData>>>
+    dictionary_data;
+  {
+    std::vector<types::global_dof_index> dof_indices;
+    for (const auto &cell : dof_handler_coarse.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          dof_indices.resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(dof_indices);
+
+          CoarseCellData data;
+          data.first = cell->active_fe_index();
+          data.second.first.reserve(dof_indices.size() + 1);
+          data.second.first.push_back(0);
+          for (const unsigned int i : lexicographic_coarse[data.first])
+            {
+              const types::global_dof_index index = dof_indices[i];
+              if (constraint_coarse.is_constrained(index))
+                for (const auto &entry :
+                     *constraint_coarse.get_constraint_entries(index))
+                  data.second.second.emplace_back(entry.first, entry.second);
+              else
+                data.second.second.emplace_back(index, 1.);
+              data.second.first.push_back(data.second.second.size());
+            }
+
+          dictionary_data[get_dictionary_rank(cell->id(), n_procs)]
+            .emplace_back(cell->id(), std::move(data));
+        }
+  }
+
+  std::map<CellId, CoarseCellData> dictionary;
+  for (auto &rank_and_data :
+       Utilities::MPI::some_to_some(communicator, dictionary_data))
+    for (auto &cell_and_data : rank_and_data.second)
+      dictionary.insert(std::move(cell_and_data));
+  dictionary_data.clear();
+
+  // for the geometric transfer, the coarse cell of a fine cell is either the
+  // cell itself or its parent, so we ask for both
+  std::map<unsigned int, std::vector<CellId>> requests;
+  for (const auto &cell : dof_handler_fine.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        requests[get_dictionary_rank(cell->id(), n_procs)].push_back(
+          cell->id());
+        if (geometric_transfer && cell->level() > 0)
+          requests[get_dictionary_rank(cell->parent()->id(), n_procs)]
+            .push_back(cell->parent()->id());
+      }
+  for (auto &rank_and_ids : requests)
+    {
+      std::sort(rank_and_ids.second.begin(), rank_and_ids.second.end());
+      rank_and_ids.second.erase(std::unique(rank_and_ids.second.begin(),
+                                            rank_and_ids.second.end()),
+                                rank_and_ids.second.end());
+    }
+
+  std::map<unsigned int, std::vector<std::pair<CellId, CoarseCellData>>>
+    answers;
+  for (const auto &rank_and_ids :
+       Utilities::MPI::some_to_some(communicator, requests))
+    {
+      auto &answer = answers[rank_and_ids.first];
+      for (const CellId &id : rank_and_ids.second)
+        {
+          const auto entry = dictionary.find(id);
+          if (entry != dictionary.end())
+            answer.emplace_back(*entry);
+        }
+    }
+  dictionary.clear();
+
+  std::map<CellId, CoarseCellData> coarse_cells;
+  for (auto &rank_and_data : Utilities::MPI::some_to_some(communicator, answers))
+    for (auto &cell_and_data : rank_and_data.second)
+      coarse_cells.insert(std::move(cell_and_data));
+
+  // collect the cell-wise information in terms of global indices first,
+  // before we know the ghost layout of the internal vectors
+  std::vector<types::global_dof_index> fine_global_indices;
+  std::vector<types::global_dof_index> coarse_global_indices;
+  std::map<std::pair<unsigned int, unsigned int>, unsigned int> scheme_indices;
+  schemes.clear();
+  fine_cell_scheme.clear();
+  fine_cell_child_index.clear();
+  fine_cell_dof_start.assign(1, 0);
+  coarse_cell_ptr_start.clear();
+  coarse_dof_ptrs.assign(1, 0);
+  coarse_dof_weights.clear();
+  {
+    std::vector<types::global_dof_index> dof_indices;
+    for (const auto &cell : dof_handler_fine.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          auto coarse_cell = coarse_cells.find(cell->id());
+          unsigned int child_index = numbers::invalid_unsigned_int;
+          if (coarse_cell == coarse_cells.end() && geometric_transfer &&
+              cell->level() > 0)
+            {
+              coarse_cell = coarse_cells.find(cell->parent()->id());
+              for (unsigned int c = 0; c < cell->parent()->n_children(); ++c)
+                if (cell->parent()->child(c) == cell)
+                  child_index = c;
+            }
+          AssertThrow(coarse_cell != coarse_cells.end(),
+                      ExcMessage(
+                        "No coarse cell found for a fine cell. The fine "
+                        "triangulation must coincide with the coarse one or "
+                        "be obtained from it by refining each cell at most "
+                        "once."));
+          fine_cell_child_index.push_back(child_index);
+
+          const unsigned int fine_fe_index   = cell->active_fe_index();
+          const unsigned int coarse_fe_index = coarse_cell->second.first;
+          const auto scheme = scheme_indices.emplace(
+            std::make_pair(fine_fe_index, coarse_fe_index), schemes.size());
+          if (scheme.second)
+            schemes.push_back(create_scheme(fine_fe_index, coarse_fe_index));
+          fine_cell_scheme.push_back(scheme.first->second);
+
+          dof_indices.resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(dof_indices);
+          for (const unsigned int i : lexicographic_fine[fine_fe_index])
+            fine_global_indices.push_back(dof_indices[i]);
+          fine_cell_dof_start.push_back(fine_global_indices.size());
+
+          const auto &data = coarse_cell->second.second;
+          const unsigned int n_coarse_cell_dofs =
+            lexicographic_coarse[coarse_fe_index].size();
+          AssertDimension(data.first.size(), n_coarse_cell_dofs + 1);
+          coarse_cell_ptr_start.push_back(coarse_dof_ptrs.size() - 1);
+          for (unsigned int i = 0; i < n_coarse_cell_dofs; ++i)
+            {
+              for (unsigned int j = data.first[i]; j < data.first[i + 1]; ++j)
+                {
+                  coarse_global_indices.push_back(data.second[j].first);
+                  coarse_dof_weights.push_back(data.second[j].second);
+                }
+              coarse_dof_ptrs.push_back(coarse_global_indices.size());
+            }
+        }
+  }
+
+  const auto create_partitioner =
+    [&](const DoFHandlerType &                      dof_handler,
+        const std::vector<types::global_dof_index> &indices) {
+      std::vector<types::global_dof_index> sorted_indices(indices);
+      std::sort(sorted_indices.begin(), sorted_indices.end());
+      sorted_indices.erase(std::unique(sorted_indices.begin(),
+                                       sorted_indices.end()),
+                           sorted_indices.end());
+      IndexSet ghost_indices(dof_handler.n_dofs());
+      ghost_indices.add_indices(sorted_indices.begin(), sorted_indices.end());
+      return std::make_shared<const Utilities::MPI::Partitioner>(
+        dof_handler.locally_owned_dofs(), ghost_indices, communicator);
+    };
+
+  partitioner_fine   = create_partitioner(dof_handler_fine, fine_global_indices);
+  partitioner_coarse = create_partitioner(dof_handler_coarse,
+                                          coarse_global_indices);
+  vec_fine.reinit(partitioner_fine);
+  vec_coarse.reinit(partitioner_coarse);
+
+  fine_dof_indices.resize(fine_global_indices.size());
+  for (unsigned int i = 0; i < fine_global_indices.size(); ++i)
+    fine_dof_indices[i] = partitioner_fine->global_to_local(fine_global_indices[i]);
+
+  coarse_dof_indices.resize(coarse_global_indices.size());
+  for (unsigned int i = 0; i < coarse_global_indices.size(); ++i)
+    coarse_dof_indices[i] =
+      partitioner_coarse->global_to_local(coarse_global_indices[i]);
+
+  // the weights of the fine degrees of freedom are given by the inverse of
+  // the number of cells sharing them, zero for the constrained ones
+  for (const unsigned int index : fine_dof_indices)
+    vec_fine.local_element(index) += Number(1.);
+  vec_fine.compress(VectorOperation::add);
+  vec_fine.update_ghost_values();
+
+  fine_dof_weights.resize(fine_dof_indices.size());
+  for (unsigned int i = 0; i < fine_dof_indices.size(); ++i)
+    fine_dof_weights[i] =
+      constraint_fine.is_constrained(fine_global_indices[i]) ?
+        Number(0.) :
+        Number(1.) / vec_fine.local_element(fine_dof_indices[i]);
+
+  vec_fine = Number(0.);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  prolongate_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                     const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  AssertDimension(src.local_size(), vec_coarse.local_size());
+  AssertDimension(dst.local_size(), vec_fine.local_size());
+
+  for (unsigned int i = 0; i < vec_coarse.local_size(); ++i)
+    vec_coarse.local_element(i) = src.local_element(i);
+  vec_coarse.update_ghost_values();
+  vec_fine = Number(0.);
+
+  // the buffers are sized for the largest scheme, and one evaluator is set
+  // up per scheme
+  unsigned int max_n_dofs_1d = 0;
+  std::vector<
+    internal::
+      EvaluatorTensorProduct<internal::evaluate_general, dim, 0, 0, Number, Number>>
+    evaluators;
+  evaluators.reserve(schemes.size());
+  for (const TransferScheme &scheme : schemes)
+    {
+      max_n_dofs_1d = std::max(max_n_dofs_1d,
+                               std::max(scheme.n_coarse_dofs_1d,
+                                        scheme.n_fine_dofs_1d));
+      evaluators.emplace_back(AlignedVector<Number>(),
+                              AlignedVector<Number>(),
+                              AlignedVector<Number>(),
+                              scheme.n_coarse_dofs_1d,
+                              scheme.n_fine_dofs_1d);
+    }
+  const unsigned int n_tmp_dofs = Utilities::fixed_power<dim>(max_n_dofs_1d);
+
+  AlignedVector<Number> values_coarse(n_components * n_tmp_dofs);
+  AlignedVector<Number> values_fine(n_components * n_tmp_dofs);
+  AlignedVector<Number> tmp(2 * n_tmp_dofs);
+
+  for (unsigned int cell = 0; cell < fine_cell_child_index.size(); ++cell)
+    {
+      const TransferScheme &scheme = schemes[fine_cell_scheme[cell]];
+      const unsigned int    n_coarse_scalar_dofs =
+        Utilities::fixed_power<dim>(scheme.n_coarse_dofs_1d);
+      const unsigned int n_fine_scalar_dofs =
+        Utilities::fixed_power<dim>(scheme.n_fine_dofs_1d);
+
+      const unsigned int *ptrs =
+        coarse_dof_ptrs.data() + coarse_cell_ptr_start[cell];
+      for (unsigned int i = 0; i < n_components * n_coarse_scalar_dofs; ++i)
+        {
+          Number value = Number(0.);
+          for (unsigned int j = ptrs[i]; j < ptrs[i + 1]; ++j)
+            value += coarse_dof_weights[j] *
+                     vec_coarse.local_element(coarse_dof_indices[j]);
+          values_coarse[i] = value;
+        }
+
+      const Number *shapes[3];
+      for (unsigned int d = 0; d < 3; ++d)
+        shapes[d] = scheme
+                      .prolongation_matrices_1d
+                        [fine_cell_child_index[cell] ==
+                             numbers::invalid_unsigned_int ?
+                           2 :
+                           (fine_cell_child_index[cell] >> d) & 1]
+                      .data();
+
+      for (unsigned int c = 0; c < n_components; ++c)
+        internal::MGTwoLevelTransferImplementation::prolongate_cell<dim>(
+          evaluators[fine_cell_scheme[cell]],
+          shapes,
+          values_coarse.data() + c * n_coarse_scalar_dofs,
+          values_fine.data() + c * n_fine_scalar_dofs,
+          tmp.data(),
+          tmp.data() + n_tmp_dofs);
+
+      const unsigned int offset = fine_cell_dof_start[cell];
+      for (unsigned int i = 0; i < n_components * n_fine_scalar_dofs; ++i)
+        vec_fine.local_element(fine_dof_indices[offset + i]) +=
+          fine_dof_weights[offset + i] * values_fine[i];
+    }
+
+  vec_fine.compress(VectorOperation::add);
+  for (unsigned int i = 0; i < vec_fine.local_size(); ++i)
+    dst.local_element(i) += vec_fine.local_element(i);
+
+  vec_coarse.zero_out_ghosts();
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                   const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  AssertDimension(src.local_size(), vec_fine.local_size());
+  AssertDimension(dst.local_size(), vec_coarse.local_size());
+
+  for (unsigned int i = 0; i < vec_fine.local_size(); ++i)
+    vec_fine.local_element(i) = src.local_element(i);
+  vec_fine.update_ghost_values();
+  vec_coarse = Number(0.);
+
+  unsigned int max_n_dofs_1d = 0;
+  std::vector<
+    internal::
+      EvaluatorTensorProduct<internal::evaluate_general, dim, 0, 0, Number, Number>>
+    evaluators;
+  evaluators.reserve(schemes.size());
+  for (const TransferScheme &scheme : schemes)
+    {
+      max_n_dofs_1d = std::max(max_n_dofs_1d,
+                               std::max(scheme.n_coarse_dofs_1d,
+                                        scheme.n_fine_dofs_1d));
+      evaluators.emplace_back(AlignedVector<Number>(),
+                              AlignedVector<Number>(),
+                              AlignedVector<Number>(),
+                              scheme.n_coarse_dofs_1d,
+                              scheme.n_fine_dofs_1d);
+    }
+  const unsigned int n_tmp_dofs = Utilities::fixed_power<dim>(max_n_dofs_1d);
+
+  AlignedVector<Number> values_coarse(n_components * n_tmp_dofs);
+  AlignedVector<Number> values_fine(n_components * n_tmp_dofs);
+  AlignedVector<Number> tmp(2 * n_tmp_dofs);
+
+  for (unsigned int cell = 0; cell < fine_cell_child_index.size(); ++cell)
+    {
+      const TransferScheme &scheme = schemes[fine_cell_scheme[cell]];
+      const unsigned int    n_coarse_scalar_dofs =
+        Utilities::fixed_power<dim>(scheme.n_coarse_dofs_1d);
+      const unsigned int n_fine_scalar_dofs =
+        Utilities::fixed_power<dim>(scheme.n_fine_dofs_1d);
+
+      const unsigned int offset = fine_cell_dof_start[cell];
+      for (unsigned int i = 0; i < n_components * n_fine_scalar_dofs; ++i)
+        values_fine[i] = fine_dof_weights[offset + i] *
+                         vec_fine.local_element(fine_dof_indices[offset + i]);
+
+      const Number *shapes[3];
+      for (unsigned int d = 0; d < 3; ++d)
+        shapes[d] = scheme
+                      .prolongation_matrices_1d
+                        [fine_cell_child_index[cell] ==
+                             numbers::invalid_unsigned_int ?
+                           2 :
+                           (fine_cell_child_index[cell] >> d) & 1]
+                      .data();
+
+      for (unsigned int c = 0; c < n_components; ++c)
+        internal::MGTwoLevelTransferImplementation::restrict_cell<dim>(
+          evaluators[fine_cell_scheme[cell]],
+          shapes,
+          values_fine.data() + c * n_fine_scalar_dofs,
+          values_coarse.data() + c * n_coarse_scalar_dofs,
+          tmp.data(),
+          tmp.data() + n_tmp_dofs);
+
+      const unsigned int *ptrs =
+        coarse_dof_ptrs.data() + coarse_cell_ptr_start[cell];
+      for (unsigned int i = 0; i < n_components * n_coarse_scalar_dofs; ++i)
+        for (unsigned int j = ptrs[i]; j < ptrs[i + 1]; ++j)
+          vec_coarse.local_element(coarse_dof_indices[j]) +=
+            coarse_dof_weights[j] * values_coarse[i];
+    }
+
+  vec_coarse.compress(VectorOperation::add);
+  for (unsigned int i = 0; i < vec_coarse.local_size(); ++i)
+    dst.local_element(i) += vec_coarse.local_element(i);
+
+  vec_fine.zero_out_ghosts();
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  memory_consumption() const
+{
+  std::size_t size = 0;
+  for (const TransferScheme &scheme : schemes)
+    for (const auto &matrix : scheme.prolongation_matrices_1d)
+      size += matrix.memory_consumption();
+  size += MemoryConsumption::memory_consumption(fine_cell_scheme);
+  size += MemoryConsumption::memory_consumption(fine_cell_child_index);
+  size += MemoryConsumption::memory_consumption(fine_cell_dof_start);
+  size += MemoryConsumption::memory_consumption(coarse_cell_ptr_start);
+  size += MemoryConsumption::memory_consumption(fine_dof_indices);
+  size += fine_dof_weights.memory_consumption();
+  size += MemoryConsumption::memory_consumption(coarse_dof_ptrs);
+  size += MemoryConsumption::memory_consumption(coarse_dof_indices);
+  size += MemoryConsumption::memory_consumption(coarse_dof_weights);
+  size += vec_fine.memory_consumption();
+  size += vec_coarse.memory_consumption();
+
+  return size;
+}
+
+
+
+#include "mg_transfer_global_coarsening.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -258,40 +258,49 @@ namespace internal
                         }),
             send_data_temp.end());
 
+          // Look up the owners of the level indices of all levels in a
+          // single consensus round. To this end, the level index spaces are
+          // concatenated, with level l starting at level_offsets[l].
+          std::vector<types::global_dof_index> level_offsets(n_levels + 1, 0);
           for (unsigned int level = 0; level < n_levels; ++level)
-            {
-              const IndexSet &is_local =
-                dof_handler.locally_owned_mg_dofs(level);
+            level_offsets[level + 1] =
+              level_offsets[level] +
+              dof_handler.locally_owned_mg_dofs(level).size();
 
-              std::vector<types::global_dof_index> level_dof_indices;
-              std::vector<types::global_dof_index> global_dof_indices;
-              for (const auto &dofpair : send_data_temp)
-                if (dofpair.level == level)
-                  {
-                    level_dof_indices.push_back(dofpair.level_dof_index);
-                    global_dof_indices.push_back(dofpair.global_dof_index);
-                  }
+          IndexSet is_local(level_offsets.back());
+          for (unsigned int level = 0; level < n_levels; ++level)
+            is_local.add_indices(dof_handler.locally_owned_mg_dofs(level),
+                                 level_offsets[level]);
+          is_local.compress();
 
-              IndexSet is_ghost(is_local.size());
-              is_ghost.add_indices(level_dof_indices.begin(),
-                                   level_dof_indices.end());
+          // send_data_temp is sorted by level and level index, so the
+          // shifted indices are sorted as well
+          std::vector<types::global_dof_index> shifted_level_dof_indices;
+          shifted_level_dof_indices.reserve(send_data_temp.size());
+          for (const auto &dofpair : send_data_temp)
+            shifted_level_dof_indices.push_back(level_offsets[dofpair.level] +
+                                                dofpair.level_dof_index);
 
-              AssertThrow(level_dof_indices.size() == is_ghost.n_elements(),
-                          ExcMessage("Size does not match!"));
+          IndexSet is_ghost(level_offsets.back());
+          is_ghost.add_indices(shifted_level_dof_indices.begin(),
+                               shifted_level_dof_indices.end());
 
-              const auto index_owner =
-                Utilities::MPI::compute_index_owner(is_local,
-                                                    is_ghost,
-                                                    tria->get_communicator());
+          AssertThrow(send_data_temp.size() == is_ghost.n_elements(),
+                      ExcMessage("Size does not match!"));
 
-              AssertThrow(level_dof_indices.size() == index_owner.size(),
-                          ExcMessage("Size does not match!"));
+          const auto index_owner =
+            Utilities::MPI::compute_index_owner(is_local,
+                                                is_ghost,
+                                                tria->get_communicator());
 
-              for (unsigned int i = 0; i < index_owner.size(); i++)
-                send_data[index_owner[i]].emplace_back(level,
-                                                       global_dof_indices[i],
-                                                       level_dof_indices[i]);
-            }
+          AssertThrow(send_data_temp.size() == index_owner.size(),
+                      ExcMessage("Size does not match!"));
+
+          for (unsigned int i = 0; i < index_owner.size(); i++)
+            send_data[index_owner[i]].emplace_back(
+              send_data_temp[i].level,
+              send_data_temp[i].global_dof_index,
+              send_data_temp[i].level_dof_index);
 
 
           // Protect the send/recv logic with a mutex:
@@ -996,23 +1005,42 @@ namespace internal
       // get the valence of the individual components and compute the weights as
       // the inverse of the valence
       weights_on_refined.resize(n_levels - 1);
+
+      // The levels are independent, so we first count on all levels and then
+      // exchange the counts of all levels at the same time, using one
+      // communication channel per level, rather than waiting for the data of
+      // one level before starting the next one
+      std::vector<LinearAlgebra::distributed::Vector<Number>> touch_counts(
+        n_levels);
       for (unsigned int level = 1; level < n_levels; ++level)
         {
-          LinearAlgebra::distributed::Vector<Number> touch_count(
-            target_partitioners[level]);
+          LinearAlgebra::distributed::Vector<Number> &touch_count =
+            touch_counts[level];
+          touch_count.reinit(target_partitioners[level]);
           for (unsigned int c = 0; c < n_owned_level_cells[level - 1]; ++c)
             for (unsigned int j = 0; j < elem_info.n_child_cell_dofs; ++j)
               touch_count.local_element(
                 level_dof_indices[level][elem_info.n_child_cell_dofs * c +
                                          j]) += Number(1.);
-          touch_count.compress(VectorOperation::add);
-          touch_count.update_ghost_values();
-
-          std::vector<unsigned int> degree_to_3(n_child_dofs_1d);
-          degree_to_3[0] = 0;
-          for (unsigned int i = 1; i < n_child_dofs_1d - 1; ++i)
-            degree_to_3[i] = 1;
-          degree_to_3.back() = 2;
+          touch_count.compress_start(level, VectorOperation::add);
+        }
+      for (unsigned int level = 1; level < n_levels; ++level)
+        {
+          touch_counts[level].compress_finish(VectorOperation::add);
+          touch_counts[level].update_ghost_values_start(level);
+        }
+
+      std::vector<unsigned int> degree_to_3(n_child_dofs_1d);
+      degree_to_3[0] = 0;
+      for (unsigned int i = 1; i < n_child_dofs_1d - 1; ++i)
+        degree_to_3[i] = 1;
+      degree_to_3.back() = 2;
+
+      for (unsigned int level = 1; level < n_levels; ++level)
+        {
+          const LinearAlgebra::distributed::Vector<Number> &touch_count =
+            touch_counts[level];
+          touch_count.update_ghost_values_finish();
 
           // we only store 3^dim weights because all dofs on a line have the
           // same valence, and all dofs on a quad have the same valence.
@@ -35,6 +35,7 @@
 #include <deal.II/multigrid/mg_transfer_matrix_free.h>
 
 #include <algorithm>
+#include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -86,6 +87,7 @@ MGTransferMatrixFree<dim, Number>::clear()
   parent_child_connect.clear();
   dirichlet_indices.clear();
   n_owned_level_cells.clear();
+  n_ghost_free_level_cells.clear();
   prolongation_matrix_1d.clear();
   evaluation_data.clear();
   weights_on_refined.clear();
@@ -148,6 +150,8 @@ MGTransferMatrixFree<dim, Number>::build(
   for (unsigned int i = 0; i < elem_info.prolongation_matrix_1d.size(); i++)
     prolongation_matrix_1d[i] = elem_info.prolongation_matrix_1d[i];
 
+  sort_ghost_free_cells_first(weights_unvectorized);
+
   // reshuffle into aligned vector of vectorized arrays
   const unsigned int vec_size = VectorizedArray<Number>::size();
   const unsigned int n_levels =
@@ -178,6 +182,183 @@ MGTransferMatrixFree<dim, Number>::build(
 
 
 
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::sort_ghost_free_cells_first(
+  std::vector<std::vector<Number>> &weights_unvectorized)
+{
+  const unsigned int vec_size        = VectorizedArray<Number>::size();
+  const unsigned int degree_size     = fe_degree + 1;
+  const unsigned int n_child_dofs_1d = 2 * degree_size - element_is_continuous;
+  const unsigned int n_scalar_cell_dofs =
+    Utilities::fixed_power<dim>(n_child_dofs_1d);
+  const unsigned int n_weights_per_cell = Utilities::fixed_power<dim>(3);
+
+  n_ghost_free_level_cells.resize(n_owned_level_cells.size());
+
+  // the cells of a level are referenced by the parent indices of the
+  // next finer level, so we go from the coarsest to the finest level and
+  // update the references after each permutation
+  for (unsigned int level = 0; level < n_owned_level_cells.size(); ++level)
+    {
+      const unsigned int n_cells = n_owned_level_cells[level];
+      const unsigned int n_coarse_owned =
+        vector_partitioners[level]->local_size();
+      const unsigned int n_fine_owned =
+        vector_partitioners[level + 1]->local_size();
+
+      // check the same entries as do_prolongate_add() and do_restrict_add()
+      const auto is_ghost_free = [&](const unsigned int cell) {
+        const unsigned int *child_indices =
+          &level_dof_indices[level + 1][cell * n_child_cell_dofs];
+        for (unsigned int i = 0; i < n_child_cell_dofs; ++i)
+          if (child_indices[i] >= n_fine_owned)
+            return false;
+
+        const unsigned int shift =
+          internal::MGTransfer::compute_shift_within_children<dim>(
+            parent_child_connect[level][cell].second,
+            fe_degree + 1 - element_is_continuous,
+            fe_degree);
+        const unsigned int *indices =
+          &level_dof_indices[level][parent_child_connect[level][cell].first *
+                                      n_child_cell_dofs +
+                                    shift];
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int k = 0; k < (dim > 2 ? degree_size : 1); ++k)
+            for (unsigned int j = 0; j < (dim > 1 ? degree_size : 1); ++j)
+              for (unsigned int i = 0; i < degree_size; ++i)
+                if (indices[c * n_scalar_cell_dofs +
+                            k * n_child_dofs_1d * n_child_dofs_1d +
+                            j * n_child_dofs_1d + i] >= n_coarse_owned)
+                  return false;
+        return true;
+      };
+
+      std::vector<unsigned int> new_to_old(n_cells);
+      std::iota(new_to_old.begin(), new_to_old.end(), 0U);
+      const auto first_ghosted = std::stable_partition(new_to_old.begin(),
+                                                       new_to_old.end(),
+                                                       is_ghost_free);
+      n_ghost_free_level_cells[level] =
+        ((first_ghosted - new_to_old.begin()) / vec_size) * vec_size;
+
+      std::vector<unsigned int> old_to_new(n_cells);
+      for (unsigned int c = 0; c < n_cells; ++c)
+        old_to_new[new_to_old[c]] = c;
+
+      // the owned cells come first in the index list of the finer level,
+      // followed by the cells only needed for the transfer further up
+      std::vector<unsigned int> indices(level_dof_indices[level + 1]);
+      std::vector<std::pair<unsigned int, unsigned int>> connect(n_cells);
+      std::vector<std::vector<unsigned short>>           dirichlet(n_cells);
+      std::vector<Number> weights(weights_unvectorized[level].size());
+      for (unsigned int c = 0; c < n_cells; ++c)
+        {
+          const unsigned int old = new_to_old[c];
+          std::copy_n(&level_dof_indices[level + 1][old * n_child_cell_dofs],
+                      n_child_cell_dofs,
+                      &indices[c * n_child_cell_dofs]);
+          connect[c]   = parent_child_connect[level][old];
+          dirichlet[c] = std::move(dirichlet_indices[level][old]);
+          if (!weights.empty())
+            std::copy_n(
+              &weights_unvectorized[level][old * n_weights_per_cell],
+              n_weights_per_cell,
+              &weights[c * n_weights_per_cell]);
+        }
+      level_dof_indices[level + 1].swap(indices);
+      parent_child_connect[level].swap(connect);
+      dirichlet_indices[level].swap(dirichlet);
+      weights_unvectorized[level].swap(weights);
+
+      if (level + 1 < parent_child_connect.size())
+        for (auto &parent_and_child : parent_child_connect[level + 1])
+          if (parent_and_child.first < n_cells)
+            parent_and_child.first = old_to_new[parent_and_child.first];
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::prolongate_cell_range(
+  const unsigned int                                to_level,
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src,
+  const unsigned int                                cell_begin,
+  const unsigned int                                cell_end) const
+{
+  // the implementation in do_prolongate_add is templated in the degree of the
+  // element (for efficiency reasons), so we need to find the appropriate
+  // kernel here...
+  if (fe_degree == 0)
+    do_prolongate_add<0>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 1)
+    do_prolongate_add<1>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 2)
+    do_prolongate_add<2>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 3)
+    do_prolongate_add<3>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 4)
+    do_prolongate_add<4>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 5)
+    do_prolongate_add<5>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 6)
+    do_prolongate_add<6>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 7)
+    do_prolongate_add<7>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 8)
+    do_prolongate_add<8>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 9)
+    do_prolongate_add<9>(to_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 10)
+    do_prolongate_add<10>(to_level, dst, src, cell_begin, cell_end);
+  else
+    do_prolongate_add<-1>(to_level, dst, src, cell_begin, cell_end);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::restrict_cell_range(
+  const unsigned int                                from_level,
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src,
+  const unsigned int                                cell_begin,
+  const unsigned int                                cell_end) const
+{
+  if (fe_degree == 0)
+    do_restrict_add<0>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 1)
+    do_restrict_add<1>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 2)
+    do_restrict_add<2>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 3)
+    do_restrict_add<3>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 4)
+    do_restrict_add<4>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 5)
+    do_restrict_add<5>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 6)
+    do_restrict_add<6>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 7)
+    do_restrict_add<7>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 8)
+    do_restrict_add<8>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 9)
+    do_restrict_add<9>(from_level, dst, src, cell_begin, cell_end);
+  else if (fe_degree == 10)
+    do_restrict_add<10>(from_level, dst, src, cell_begin, cell_end);
+  else
+    // go to the non-templated version of the evaluator
+    do_restrict_add<-1>(from_level, dst, src, cell_begin, cell_end);
+}
+
+
+
 template <int dim, typename Number>
 void
 MGTransferMatrixFree<dim, Number>::prolongate(
@@ -220,34 +401,42 @@ MGTransferMatrixFree<dim, Number>::prolongate(
   LinearAlgebra::distributed::Vector<Number> &dst_vec =
     dst_inplace ? dst : this->ghosted_level_vector[to_level];
 
-  src_vec.update_ghost_values();
-  // the implementation in do_prolongate_add is templated in the degree of the
-  // element (for efficiency reasons), so we need to find the appropriate
-  // kernel here...
-  if (fe_degree == 0)
-    do_prolongate_add<0>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 1)
-    do_prolongate_add<1>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 2)
-    do_prolongate_add<2>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 3)
-    do_prolongate_add<3>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 4)
-    do_prolongate_add<4>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 5)
-    do_prolongate_add<5>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 6)
-    do_prolongate_add<6>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 7)
-    do_prolongate_add<7>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 8)
-    do_prolongate_add<8>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 9)
-    do_prolongate_add<9>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 10)
-    do_prolongate_add<10>(to_level, dst_vec, src_vec);
+  const unsigned int n_cells = n_owned_level_cells[to_level - 1];
+
+  // If we have user defined MG constraints, we must create a non-const,
+  // ghosted version of the source vector to distribute constraints, which
+  // needs the ghost values of the source vector up front. Otherwise, we
+  // work on the cells that only touch locally owned entries of the source
+  // vector while its ghost values are exchanged.
+  if (this->mg_constrained_dofs != nullptr &&
+      this->mg_constrained_dofs->get_user_constraint_matrix(to_level - 1)
+          .get_local_lines()
+          .size() > 0)
+    {
+      src_vec.update_ghost_values();
+
+      LinearAlgebra::distributed::Vector<Number> copy_src(src_vec);
+
+      // Distribute any user defined constraints
+      this->mg_constrained_dofs->get_user_constraint_matrix(to_level - 1)
+        .distribute(copy_src);
+
+      // Re-initialize new ghosted vector with correct constraints
+      LinearAlgebra::distributed::Vector<Number> new_src;
+      new_src.reinit(copy_src);
+      new_src = copy_src;
+      new_src.update_ghost_values();
+
+      prolongate_cell_range(to_level, dst_vec, new_src, 0, n_cells);
+    }
   else
-    do_prolongate_add<-1>(to_level, dst_vec, src_vec);
+    {
+      const unsigned int n_ghost_free = n_ghost_free_level_cells[to_level - 1];
+      src_vec.update_ghost_values_start();
+      prolongate_cell_range(to_level, dst_vec, src_vec, 0, n_ghost_free);
+      src_vec.update_ghost_values_finish();
+      prolongate_cell_range(to_level, dst_vec, src_vec, n_ghost_free, n_cells);
+    }
 
   dst_vec.compress(VectorOperation::add);
   if (dst_inplace == false)
@@ -298,33 +487,14 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
   LinearAlgebra::distributed::Vector<Number> &dst_vec =
     dst_inplace ? dst : this->ghosted_level_vector[from_level - 1];
 
-  src_vec.update_ghost_values();
-
-  if (fe_degree == 0)
-    do_restrict_add<0>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 1)
-    do_restrict_add<1>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 2)
-    do_restrict_add<2>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 3)
-    do_restrict_add<3>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 4)
-    do_restrict_add<4>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 5)
-    do_restrict_add<5>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 6)
-    do_restrict_add<6>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 7)
-    do_restrict_add<7>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 8)
-    do_restrict_add<8>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 9)
-    do_restrict_add<9>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 10)
-    do_restrict_add<10>(from_level, dst_vec, src_vec);
-  else
-    // go to the non-templated version of the evaluator
-    do_restrict_add<-1>(from_level, dst_vec, src_vec);
+  // work on the cells that only touch locally owned entries of the source
+  // vector while its ghost values are exchanged
+  const unsigned int n_cells      = n_owned_level_cells[from_level - 1];
+  const unsigned int n_ghost_free = n_ghost_free_level_cells[from_level - 1];
+  src_vec.update_ghost_values_start();
+  restrict_cell_range(from_level, dst_vec, src_vec, 0, n_ghost_free);
+  src_vec.update_ghost_values_finish();
+  restrict_cell_range(from_level, dst_vec, src_vec, n_ghost_free, n_cells);
 
   dst_vec.compress(VectorOperation::add);
   if (dst_inplace == false)
@@ -336,6 +506,48 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
 
 
 
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::restrict_residual_and_add(
+  const unsigned int                                from_level,
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &rhs,
+  LinearAlgebra::distributed::Vector<Number> &      matrix_times_u) const
+{
+  Assert((from_level >= 1) && (from_level <= level_dof_indices.size()),
+         ExcIndexRange(from_level, 1, level_dof_indices.size() + 1));
+  AssertDimension(rhs.local_size(), matrix_times_u.local_size());
+
+  if (matrix_times_u.get_partitioner().get() ==
+      this->vector_partitioners[from_level].get())
+    {
+      matrix_times_u.sadd(-1.0, 1.0, rhs);
+      restrict_and_add(from_level, dst, matrix_times_u);
+      return;
+    }
+
+  // compute the residual while copying into the ghosted vector, rather than
+  // first updating matrix_times_u and then copying it
+  LinearAlgebra::distributed::Vector<Number> &residual =
+    this->ghosted_level_vector[from_level];
+  if (residual.get_partitioner().get() !=
+      this->vector_partitioners[from_level].get())
+    residual.reinit(this->vector_partitioners[from_level]);
+  AssertDimension(residual.local_size(), rhs.local_size());
+
+  const unsigned int local_size = rhs.local_size();
+  const Number *     rhs_ptr    = rhs.begin();
+  const Number *     mtu_ptr    = matrix_times_u.begin();
+  Number *           res_ptr    = residual.begin();
+  DEAL_II_OPENMP_SIMD_PRAGMA
+  for (unsigned int i = 0; i < local_size; ++i)
+    res_ptr[i] = rhs_ptr[i] - mtu_ptr[i];
+
+  restrict_and_add(from_level, dst, residual);
+}
+
+
+
 namespace
 {
   template <int dim, int degree, typename Number>
@@ -377,7 +589,9 @@ void
 MGTransferMatrixFree<dim, Number>::do_prolongate_add(
   const unsigned int                                to_level,
   LinearAlgebra::distributed::Vector<Number> &      dst,
-  const LinearAlgebra::distributed::Vector<Number> &src) const
+  const LinearAlgebra::distributed::Vector<Number> &src,
+  const unsigned int                                cell_begin,
+  const unsigned int                                cell_end) const
 {
   const unsigned int vec_size        = VectorizedArray<Number>::size();
   const unsigned int degree_size     = (degree > -1 ? degree : fe_degree) + 1;
@@ -386,37 +600,13 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
     Utilities::fixed_power<dim>(n_child_dofs_1d);
   constexpr unsigned int three_to_dim = Utilities::pow(3, dim);
 
-  // If we have user defined MG constraints, we must create
-  // a non-const, ghosted version of the source vector to distribute
-  // constraints.
-  const LinearAlgebra::distributed::Vector<Number> *to_use = &src;
-  LinearAlgebra::distributed::Vector<Number>        new_src;
-  if (this->mg_constrained_dofs != nullptr &&
-      this->mg_constrained_dofs->get_user_constraint_matrix(to_level - 1)
-          .get_local_lines()
-          .size() > 0)
-    {
-      LinearAlgebra::distributed::Vector<Number> copy_src(src);
+  Assert(cell_begin % vec_size == 0, ExcInternalError());
+  AssertIndexRange(cell_end, n_owned_level_cells[to_level - 1] + 1);
 
-      // Distribute any user defined constraints
-      this->mg_constrained_dofs->get_user_constraint_matrix(to_level - 1)
-        .distribute(copy_src);
-
-      // Re-initialize new ghosted vector with correct constraints
-      new_src.reinit(copy_src);
-      new_src = copy_src;
-      new_src.update_ghost_values();
-
-      to_use = &new_src;
-    }
-
-  for (unsigned int cell = 0; cell < n_owned_level_cells[to_level - 1];
-       cell += vec_size)
+  for (unsigned int cell = cell_begin; cell < cell_end; cell += vec_size)
     {
       const unsigned int n_lanes =
-        cell + vec_size > n_owned_level_cells[to_level - 1] ?
-          n_owned_level_cells[to_level - 1] - cell :
-          vec_size;
+        cell + vec_size > cell_end ? cell_end - cell : vec_size;
 
       // read from source vector
       for (unsigned int v = 0; v < n_lanes; ++v)
@@ -433,22 +623,21 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
                                  n_child_cell_dofs +
                                shift];
           for (unsigned int c = 0, m = 0; c < n_components; ++c)
-            {
-              for (unsigned int k = 0; k < (dim > 2 ? degree_size : 1); ++k)
-                for (unsigned int j = 0; j < (dim > 1 ? degree_size : 1); ++j)
-                  for (unsigned int i = 0; i < degree_size; ++i, ++m)
-                    evaluation_data[m][v] = to_use->local_element(
-                      indices[c * n_scalar_cell_dofs +
-                              k * n_child_dofs_1d * n_child_dofs_1d +
-                              j * n_child_dofs_1d + i]);
-
-              // apply Dirichlet boundary conditions on parent cell
-              for (std::vector<unsigned short>::const_iterator i =
-                     dirichlet_indices[to_level - 1][cell + v].begin();
-                   i != dirichlet_indices[to_level - 1][cell + v].end();
-                   ++i)
-                evaluation_data[*i][v] = 0.;
-            }
+            for (unsigned int k = 0; k < (dim > 2 ? degree_size : 1); ++k)
+              for (unsigned int j = 0; j < (dim > 1 ? degree_size : 1); ++j)
+                for (unsigned int i = 0; i < degree_size; ++i, ++m)
+                  evaluation_data[m][v] = src.local_element(
+                    indices[c * n_scalar_cell_dofs +
+                            k * n_child_dofs_1d * n_child_dofs_1d +
+                            j * n_child_dofs_1d + i]);
+
+          // apply Dirichlet boundary conditions on parent cell, once all
+          // components have been read
+          for (std::vector<unsigned short>::const_iterator i =
+                 dirichlet_indices[to_level - 1][cell + v].begin();
+               i != dirichlet_indices[to_level - 1][cell + v].end();
+               ++i)
+            evaluation_data[*i][v] = 0.;
         }
 
       AssertDimension(prolongation_matrix_1d.size(),
@@ -516,7 +705,9 @@ void
 MGTransferMatrixFree<dim, Number>::do_restrict_add(
   const unsigned int                                from_level,
   LinearAlgebra::distributed::Vector<Number> &      dst,
-  const LinearAlgebra::distributed::Vector<Number> &src) const
+  const LinearAlgebra::distributed::Vector<Number> &src,
+  const unsigned int                                cell_begin,
+  const unsigned int                                cell_end) const
 {
   const unsigned int vec_size        = VectorizedArray<Number>::size();
   const unsigned int degree_size     = (degree > -1 ? degree : fe_degree) + 1;
@@ -525,13 +716,13 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
     Utilities::fixed_power<dim>(n_child_dofs_1d);
   constexpr unsigned int three_to_dim = Utilities::pow(3, dim);
 
-  for (unsigned int cell = 0; cell < n_owned_level_cells[from_level - 1];
-       cell += vec_size)
+  Assert(cell_begin % vec_size == 0, ExcInternalError());
+  AssertIndexRange(cell_end, n_owned_level_cells[from_level - 1] + 1);
+
+  for (unsigned int cell = cell_begin; cell < cell_end; cell += vec_size)
     {
       const unsigned int n_lanes =
-        cell + vec_size > n_owned_level_cells[from_level - 1] ?
-          n_owned_level_cells[from_level - 1] - cell :
-          vec_size;
+        cell + vec_size > cell_end ? cell_end - cell : vec_size;
 
       // read from source vector
       {
@@ -610,24 +801,22 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
                                    .first *
                                  n_child_cell_dofs +
                                shift];
+          // apply Dirichlet boundary conditions on parent cell, for all
+          // components at once
+          for (std::vector<unsigned short>::const_iterator i =
+                 dirichlet_indices[from_level - 1][cell + v].begin();
+               i != dirichlet_indices[from_level - 1][cell + v].end();
+               ++i)
+            evaluation_data[*i][v] = 0.;
+
           for (unsigned int c = 0, m = 0; c < n_components; ++c)
-            {
-              // apply Dirichlet boundary conditions on parent cell
-              for (std::vector<unsigned short>::const_iterator i =
-                     dirichlet_indices[from_level - 1][cell + v].begin();
-                   i != dirichlet_indices[from_level - 1][cell + v].end();
-                   ++i)
-                evaluation_data[*i][v] = 0.;
-
-              for (unsigned int k = 0; k < (dim > 2 ? degree_size : 1); ++k)
-                for (unsigned int j = 0; j < (dim > 1 ? degree_size : 1); ++j)
-                  for (unsigned int i = 0; i < degree_size; ++i, ++m)
-                    dst.local_element(
-                      indices[c * n_scalar_cell_dofs +
-                              k * n_child_dofs_1d * n_child_dofs_1d +
-                              j * n_child_dofs_1d + i]) +=
-                      evaluation_data[m][v];
-            }
+            for (unsigned int k = 0; k < (dim > 2 ? degree_size : 1); ++k)
+              for (unsigned int j = 0; j < (dim > 1 ? degree_size : 1); ++j)
+                for (unsigned int i = 0; i < degree_size; ++i, ++m)
+                  dst.local_element(
+                    indices[c * n_scalar_cell_dofs +
+                            k * n_child_dofs_1d * n_child_dofs_1d +
+                            j * n_child_dofs_1d + i]) += evaluation_data[m][v];
         }
     }
 }
@@ -643,6 +832,7 @@ MGTransferMatrixFree<dim, Number>::memory_consumption() const
   memory += MemoryConsumption::memory_consumption(level_dof_indices);
   memory += MemoryConsumption::memory_consumption(parent_child_connect);
   memory += MemoryConsumption::memory_consumption(n_owned_level_cells);
+  memory += MemoryConsumption::memory_consumption(n_ghost_free_level_cells);
   memory += MemoryConsumption::memory_consumption(prolongation_matrix_1d);
   memory += MemoryConsumption::memory_consumption(evaluation_data);
   memory += MemoryConsumption::memory_consumption(weights_on_refined);
@@ -787,6 +977,31 @@ MGTransferBlockMatrixFree<dim, Number>::restrict_and_add(
 
 
 
+template <int dim, typename Number>
+void
+MGTransferBlockMatrixFree<dim, Number>::restrict_residual_and_add(
+  const unsigned int                                     from_level,
+  LinearAlgebra::distributed::BlockVector<Number> &      dst,
+  const LinearAlgebra::distributed::BlockVector<Number> &rhs,
+  LinearAlgebra::distributed::BlockVector<Number> &      matrix_times_u) const
+{
+  const unsigned int n_blocks = rhs.n_blocks();
+  AssertDimension(dst.n_blocks(), n_blocks);
+  AssertDimension(matrix_times_u.n_blocks(), n_blocks);
+
+  if (!same_for_all)
+    AssertDimension(matrix_free_transfer_vector.size(), n_blocks);
+
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      const unsigned int data_block = same_for_all ? 0 : b;
+      matrix_free_transfer_vector[data_block].restrict_residual_and_add(
+        from_level, dst.block(b), rhs.block(b), matrix_times_u.block(b));
+    }
+}
+
+
+
 template <int dim, typename Number>
 std::size_t
 MGTransferBlockMatrixFree<dim, Number>::memory_consumption() const
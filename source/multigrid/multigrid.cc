@@ -33,6 +33,8 @@
 #include <deal.II/multigrid/mg_transfer_component.templates.h>
 #include <deal.II/multigrid/multigrid.templates.h>
 
+#include <iomanip>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -300,6 +302,123 @@ MGTransferBlockSelect<number>::restrict_and_add(const unsigned int from_level,
 
 
 
+
+namespace mg
+{
+  Timings::~Timings()
+  {
+    disconnect();
+  }
+
+
+
+  void
+  Timings::disconnect()
+  {
+    for (auto &connection : connections)
+      connection.disconnect();
+    connections.clear();
+  }
+
+
+
+  void
+  Timings::reset()
+  {
+    entries.clear();
+  }
+
+
+
+  double
+  Timings::get_time(const Stage stage, const unsigned int level) const
+  {
+    AssertIndexRange(static_cast<unsigned int>(stage),
+                     static_cast<unsigned int>(n_stages));
+    return level < entries.size() ? entries[level][stage].time : 0.;
+  }
+
+
+
+  unsigned int
+  Timings::get_n_calls(const Stage stage, const unsigned int level) const
+  {
+    AssertIndexRange(static_cast<unsigned int>(stage),
+                     static_cast<unsigned int>(n_stages));
+    return level < entries.size() ? entries[level][stage].n_calls : 0;
+  }
+
+
+
+  void
+  Timings::record(const Stage stage, const bool before, const unsigned int level)
+  {
+    if (level >= entries.size())
+      entries.resize(level + 1);
+
+    Entry &entry = entries[level][stage];
+    if (before)
+      entry.start = std::chrono::steady_clock::now();
+    else
+      {
+        entry.time += std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - entry.start)
+                        .count();
+        ++entry.n_calls;
+      }
+  }
+
+
+
+  void
+  Timings::print(std::ostream &out) const
+  {
+    static const char *names[n_stages] = {"pre-smooth",
+                                          "residual",
+                                          "restrict",
+                                          "coarse",
+                                          "prolongate",
+                                          "post-smooth"};
+
+    const std::ios_base::fmtflags old_flags     = out.flags();
+    const std::streamsize         old_precision = out.precision();
+    out << std::scientific << std::setprecision(3);
+
+    out << std::setw(6) << "level";
+    for (const char *name : names)
+      out << std::setw(13) << name;
+    out << std::setw(13) << "total" << std::endl;
+
+    std::array<double, n_stages> sums = {};
+    for (unsigned int level = 0; level < entries.size(); ++level)
+      {
+        double total = 0.;
+        out << std::setw(6) << level;
+        for (unsigned int s = 0; s < n_stages; ++s)
+          {
+            out << std::setw(13) << entries[level][s].time;
+            total += entries[level][s].time;
+            sums[s] += entries[level][s].time;
+          }
+        out << std::setw(13) << total << std::endl;
+      }
+
+    double total = 0.;
+    out << std::setw(6) << "sum";
+    for (const double sum : sums)
+      {
+        out << std::setw(13) << sum;
+        total += sum;
+      }
+    out << std::setw(13) << total << std::endl;
+
+    out.flags(old_flags);
+    out.precision(old_precision);
+  }
+} // namespace mg
+
+
+
 // Explicit instantiations
 
 #include "multigrid.inst"
@@ -15,7 +15,9 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -27,6 +29,7 @@
 
 #include <deal.II/lac/block_sparse_matrix.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/petsc_block_sparse_matrix.h>
 #include <deal.II/lac/petsc_sparse_matrix.h>
 #include <deal.II/lac/sparse_matrix.h>
@@ -415,10 +418,6 @@ namespace NonMatching
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -445,15 +444,6 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    FullMatrix<typename Matrix::value_type> cell_matrix(
-      space_dh.get_fe().dofs_per_cell, immersed_dh.get_fe().dofs_per_cell);
-
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_dh.get_fe(),
-                                  quad,
-                                  update_JxW_values | update_quadrature_points |
-                                    update_values);
-
     const unsigned int n_q_points = quad.size();
     const unsigned int n_active_c =
       immersed_dh.get_triangulation().n_active_cells();
@@ -540,20 +530,80 @@ namespace NonMatching
           }
       }
 
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
-
-    for (unsigned int j = 0; cell != endc; ++cell, ++j)
+    // The pairs of space and immersed shape functions whose components are
+    // coupled
+    std::vector<std::pair<unsigned int, unsigned int>> coupled_dofs;
+    for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
       {
-        // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
-        cell->get_dof_indices(dofs);
+        const auto comp_i = space_fe.system_to_component_index(i).first;
+        if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
+          for (unsigned int j = 0; j < immersed_fe.dofs_per_cell; ++j)
+            {
+              const auto comp_j =
+                immersed_fe.system_to_component_index(j).first;
+              if (space_gtl[comp_i] == immersed_gtl[comp_j])
+                coupled_dofs.emplace_back(i, j);
+            }
+      }
+
+    // The values of primitive H1-conforming shape functions, like those of
+    // Lagrange elements, do not depend on the mapping. Evaluate them
+    // directly at the reference points of the immersed quadrature points
+    // falling into a background cell, instead of setting up an FEValues
+    // object for each pair of cells
+    const bool evaluate_space_fe_directly =
+      space_fe.is_primitive() &&
+      space_fe.conforms(FiniteElementData<dim0>::H1);
+
+    struct ScratchData
+    {
+      ScratchData(const Mapping<dim1, spacedim> &      mapping,
+                  const FiniteElement<dim1, spacedim> &fe,
+                  const Quadrature<dim1> &             quadrature)
+        : fe_values(mapping, fe, quadrature, update_JxW_values | update_values)
+      {}
+
+      ScratchData(const ScratchData &scratch)
+        : fe_values(scratch.fe_values.get_mapping(),
+                    scratch.fe_values.get_fe(),
+                    scratch.fe_values.get_quadrature(),
+                    scratch.fe_values.get_update_flags())
+      {}
+
+      FEValues<dim1, spacedim> fe_values;
+    };
+
+    struct CopyData
+    {
+      unsigned int                                         n_cells = 0;
+      std::vector<types::global_dof_index>                 immersed_dofs;
+      std::vector<std::vector<types::global_dof_index>>    space_dofs;
+      std::vector<FullMatrix<typename Matrix::value_type>> cell_matrices;
+      Table<2, double>                                     space_values;
+    };
+
+    // Each immersed cell is assembled independently, and the copier adds
+    // the contributions of all the background cells it intersects
+    const auto worker =
+      [&](const typename DoFHandler<dim1, spacedim>::active_cell_iterator
+            &                       cell,
+          ScratchData &             scratch,
+          CopyData &                copy_data) {
+        copy_data.n_cells = 0;
 
         // Get a list of outer cells, qpoints and maps.
-        const auto &cells   = cell_container[j];
-        const auto &qpoints = qpoints_container[j];
-        const auto &maps    = maps_container[j];
+        const unsigned int j       = cell->active_cell_index();
+        const auto &       cells   = cell_container[j];
+        const auto &       qpoints = qpoints_container[j];
+        const auto &       maps    = maps_container[j];
+        if (cells.empty())
+          return;
+
+        // Reinitialize the cell and the fe_values
+        FEValues<dim1, spacedim> &fe_v = scratch.fe_values;
+        fe_v.reinit(cell);
+        copy_data.immersed_dofs.resize(immersed_fe.dofs_per_cell);
+        cell->get_dof_indices(copy_data.immersed_dofs);
 
         for (unsigned int c = 0; c < cells.size(); ++c)
           {
@@ -561,59 +611,81 @@ namespace NonMatching
             typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
               *cells[c], &space_dh);
             // Make sure we act only on locally_owned cells
-            if (ocell->is_locally_owned())
-              {
-                const std::vector<Point<dim0>> & qps = qpoints[c];
-                const std::vector<unsigned int> &ids = maps[c];
+            if (!ocell->is_locally_owned())
+              continue;
+
+            const std::vector<Point<dim0>> & qps = qpoints[c];
+            const std::vector<unsigned int> &ids = maps[c];
 
+            if (copy_data.cell_matrices.size() == copy_data.n_cells)
+              {
+                copy_data.cell_matrices.emplace_back(space_fe.dofs_per_cell,
+                                                     immersed_fe.dofs_per_cell);
+                copy_data.space_dofs.emplace_back(space_fe.dofs_per_cell);
+              }
+            auto &cell_matrix = copy_data.cell_matrices[copy_data.n_cells];
+            ocell->get_dof_indices(copy_data.space_dofs[copy_data.n_cells]);
+            ++copy_data.n_cells;
+
+            // Values of the space shape functions at the points
+            auto &space_values = copy_data.space_values;
+            space_values.reinit(space_fe.dofs_per_cell, qps.size());
+            if (evaluate_space_fe_directly)
+              {
+                for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                  for (unsigned int oq = 0; oq < qps.size(); ++oq)
+                    space_values(i, oq) = space_fe.shape_value(i, qps[oq]);
+              }
+            else
+              {
                 FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
-                                                space_dh.get_fe(),
+                                                space_fe,
                                                 qps,
                                                 update_values);
                 o_fe_v.reinit(ocell);
-                ocell->get_dof_indices(odofs);
+                for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                  for (unsigned int oq = 0; oq < qps.size(); ++oq)
+                    space_values(i, oq) = o_fe_v.shape_value(i, oq);
+              }
 
-                // Reset the matrices.
-                cell_matrix = typename Matrix::value_type();
+            // Reset the matrices.
+            cell_matrix = typename Matrix::value_type();
 
-                for (unsigned int i = 0; i < space_dh.get_fe().dofs_per_cell;
-                     ++i)
+            for (const auto &dof_pair : coupled_dofs)
+              {
+                typename Matrix::value_type sum = 0;
+                for (unsigned int oq = 0; oq < qps.size(); ++oq)
                   {
-                    const auto comp_i =
-                      space_dh.get_fe().system_to_component_index(i).first;
-                    if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
-                      for (unsigned int j = 0;
-                           j < immersed_dh.get_fe().dofs_per_cell;
-                           ++j)
-                        {
-                          const auto comp_j = immersed_dh.get_fe()
-                                                .system_to_component_index(j)
-                                                .first;
-                          if (space_gtl[comp_i] == immersed_gtl[comp_j])
-                            for (unsigned int oq = 0;
-                                 oq < o_fe_v.n_quadrature_points;
-                                 ++oq)
-                              {
-                                // Get the corresponding q point
-                                const unsigned int q = ids[oq];
-
-                                cell_matrix(i, j) +=
-                                  (fe_v.shape_value(j, q) *
-                                   o_fe_v.shape_value(i, oq) * fe_v.JxW(q));
-                              }
-                        }
-                  }
+                    // Get the corresponding q point
+                    const unsigned int q = ids[oq];
 
-                // Now assemble the matrices
-                constraints.distribute_local_to_global(cell_matrix,
-                                                       odofs,
-                                                       dofs,
-                                                       matrix);
+                    sum += space_values(dof_pair.first, oq) *
+                           fe_v.shape_value(dof_pair.second, q) * fe_v.JxW(q);
+                  }
+                cell_matrix(dof_pair.first, dof_pair.second) = sum;
               }
           }
-      }
+      };
+
+    const auto copier = [&](const CopyData &copy_data) {
+      // Now assemble the matrices
+      for (unsigned int c = 0; c < copy_data.n_cells; ++c)
+        constraints.distribute_local_to_global(copy_data.cell_matrices[c],
+                                               copy_data.space_dofs[c],
+                                               copy_data.immersed_dofs,
+                                               matrix);
+    };
+
+    WorkStream::run(immersed_dh.begin_active(),
+                    immersed_dh.end(),
+                    worker,
+                    copier,
+                    ScratchData(immersed_mapping, immersed_fe, quad),
+                    CopyData());
   }
 
+
+
   template <int dim0,
             int dim1,
             int spacedim,
@@ -0,0 +1,784 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  namespace internal
+  {
+    namespace QuadratureGeneratorImplementation
+    {
+      /**
+       * The value of @p function at the points of the line through @p point
+       * in direction @p direction, as a function of the coordinate along
+       * the line.
+       */
+      template <int dim>
+      double
+      value_on_line(const Function<dim> &function,
+                    Point<dim>           point,
+                    const unsigned int   direction,
+                    const double         coordinate)
+      {
+        point[direction] = coordinate;
+        return function.value(point);
+      }
+
+
+
+      /**
+       * Return the roots in the open interval (@p a, @p b) of the function
+       * along the line through @p point in direction @p direction, sorted in
+       * ascending order. The roots are bracketed by sampling the function at
+       * @p n_intervals + 1 equidistant points, and a root is computed in each
+       * bracket with the Illinois variant of the regula falsi.
+       */
+      template <int dim>
+      std::vector<double>
+      find_roots_on_line(const Function<dim> &function,
+                         const Point<dim> &   point,
+                         const unsigned int   direction,
+                         const double         a,
+                         const double         b,
+                         const unsigned int   n_intervals,
+                         const double         relative_tolerance)
+      {
+        std::vector<double> roots;
+        const double        tolerance = relative_tolerance * (b - a);
+
+        double s_left = a;
+        double v_left = value_on_line(function, point, direction, a);
+        for (unsigned int i = 1; i <= n_intervals; ++i)
+          {
+            const double s_right =
+              (i == n_intervals) ? b : a + (b - a) * i / n_intervals;
+            const double v_right =
+              value_on_line(function, point, direction, s_right);
+
+            if ((v_left < 0.) != (v_right < 0.))
+              {
+                double lo = s_left, hi = s_right;
+                double v_lo = v_left, v_hi = v_right;
+                int    side = 0;
+                for (unsigned int it = 0; it < 100 && hi - lo > tolerance;
+                     ++it)
+                  {
+                    double s = (lo * v_hi - hi * v_lo) / (v_hi - v_lo);
+                    if (!(s > lo && s < hi))
+                      s = 0.5 * (lo + hi);
+                    const double v =
+                      value_on_line(function, point, direction, s);
+                    if (v == 0.)
+                      {
+                        lo = hi = s;
+                        break;
+                      }
+                    if ((v < 0.) == (v_lo < 0.))
+                      {
+                        lo   = s;
+                        v_lo = v;
+                        if (side == -1)
+                          v_hi *= 0.5;
+                        side = -1;
+                      }
+                    else
+                      {
+                        hi   = s;
+                        v_hi = v;
+                        if (side == 1)
+                          v_lo *= 0.5;
+                        side = 1;
+                      }
+                  }
+                const double root = 0.5 * (lo + hi);
+                if (root > a && root < b)
+                  roots.push_back(root);
+              }
+
+            s_left = s_right;
+            v_left = v_right;
+          }
+
+        return roots;
+      }
+
+
+
+      /**
+       * A restriction of the level set function to a face of the box that is
+       * processed, described by the coordinates that are fixed to the
+       * lower or upper bound of the box.
+       */
+      template <int dim>
+      struct Restriction
+      {
+        /**
+         * The coordinates that are fixed, and their values.
+         */
+        std::vector<std::pair<unsigned int, double>> fixed_coordinates;
+
+        /**
+         * Return @p point with the fixed coordinates replaced.
+         */
+        Point<dim>
+        apply(Point<dim> point) const
+        {
+          for (const auto &fixed : fixed_coordinates)
+            point[fixed.first] = fixed.second;
+          return point;
+        }
+      };
+
+
+
+      /**
+       * The recursive algorithm of QuadratureGenerator. A box with the
+       * directions marked in @p active is integrated in a direction $k$ in
+       * which all the restrictions of the level set function to the box are
+       * monotone. Its face orthogonal to $k$ is integrated by the same
+       * algorithm with the restrictions of all level set functions to the
+       * lower and upper walls in direction $k$, so that the number of roots
+       * on each line in direction $k$ does not change within the pieces the
+       * face is partitioned into, and the integrand over the face is smooth.
+       */
+      template <int dim>
+      class RecursiveIntegrator
+      {
+      public:
+        /**
+         * The function called for each point of a quadrature rule and its
+         * weight. Only the coordinates in the active directions of the box
+         * are set.
+         */
+        using Integrand = std::function<void(const Point<dim> &, const double)>;
+
+        RecursiveIntegrator(const Function<dim> &           level_set,
+                            const Quadrature<1> &           quadrature1D,
+                            const AdditionalQGeneratorData &additional_data,
+                            ImmersedSurfaceQuadrature<dim> &surface_quadrature)
+          : level_set(level_set)
+          , quadrature1D(quadrature1D)
+          , additional_data(additional_data)
+          , surface_quadrature(surface_quadrature)
+        {}
+
+        /**
+         * Call @p integrand for the points of a rule over the active
+         * directions of @p box, for which all the restrictions in
+         * @p restrictions are smooth.
+         */
+        void
+        integrate(const BoundingBox<dim> &             box,
+                  const std::array<bool, dim> &        active,
+                  const std::vector<Restriction<dim>> &restrictions,
+                  const Integrand &                    integrand,
+                  const unsigned int                   n_remaining_splits) const
+        {
+          std::vector<unsigned int> active_directions;
+          for (unsigned int d = 0; d < dim; ++d)
+            if (active[d])
+              active_directions.push_back(d);
+          const unsigned int n_active = active_directions.size();
+
+          // Sample the restrictions on a grid including the vertices of the
+          // box and drop the ones with a definite sign. Every point of the box
+          // is within half a diagonal of a sample cell from a sample point,
+          // which bounds their variation in terms of the largest gradient
+          // found.
+          const unsigned int n_samples_1d =
+            std::max<unsigned int>(quadrature1D.size(), 2) + 1;
+          const unsigned int n_samples = Utilities::pow(n_samples_1d, n_active);
+          double             half_diagonal_sqr = 0.;
+          for (const unsigned int d : active_directions)
+            half_diagonal_sqr += Utilities::fixed_power<2>(
+              0.5 * box.side_length(d) / (n_samples_1d - 1));
+
+          std::vector<Restriction<dim>>            cut_restrictions;
+          std::vector<std::vector<Tensor<1, dim>>> cut_gradients;
+          std::vector<double>                      cut_max_gradients;
+          std::vector<Tensor<1, dim>>              gradients(n_samples);
+          for (const auto &restriction : restrictions)
+            {
+              double min_value    = std::numeric_limits<double>::max();
+              double max_value    = -std::numeric_limits<double>::max();
+              double max_gradient = 0.;
+              for (unsigned int i = 0; i < n_samples; ++i)
+                {
+                  Point<dim>   point;
+                  unsigned int index = i;
+                  for (const unsigned int d : active_directions)
+                    {
+                      point[d] = box.lower_bound(d) +
+                                 box.side_length(d) * (index % n_samples_1d) /
+                                   (n_samples_1d - 1);
+                      index /= n_samples_1d;
+                    }
+                  point = restriction.apply(point);
+
+                  const double value = level_set.value(point);
+                  gradients[i]       = level_set.gradient(point);
+                  // Only the derivatives in the active directions matter
+                  for (unsigned int d = 0; d < dim; ++d)
+                    if (!active[d])
+                      gradients[i][d] = 0.;
+                  min_value    = std::min(min_value, value);
+                  max_value    = std::max(max_value, value);
+                  max_gradient = std::max(max_gradient, gradients[i].norm());
+                }
+
+              const double margin = max_gradient * std::sqrt(half_diagonal_sqr);
+              if (min_value <= margin && max_value >= -margin)
+                {
+                  cut_restrictions.push_back(restriction);
+                  cut_gradients.push_back(gradients);
+                  cut_max_gradients.push_back(max_gradient);
+                }
+            }
+
+          if (cut_restrictions.empty())
+            {
+              integrate_tensor_product(box, active_directions, integrand);
+              return;
+            }
+
+          // Find the direction in which all restrictions are monotone with the
+          // steepest smallest slope
+          unsigned int height_direction = numbers::invalid_unsigned_int;
+          double       best_slope       = 0.;
+          for (const unsigned int d : active_directions)
+            {
+              double slope = std::numeric_limits<double>::max();
+              for (unsigned int r = 0; r < cut_restrictions.size(); ++r)
+                {
+                  const double sign =
+                    (cut_gradients[r][0][d] < 0.) ? -1. : 1.;
+                  double min_slope = std::numeric_limits<double>::max();
+                  for (const auto &gradient : cut_gradients[r])
+                    min_slope = std::min(min_slope, sign * gradient[d]);
+                  if (min_slope <= 0. ||
+                      min_slope < additional_data.min_height_gradient_ratio *
+                                    cut_max_gradients[r])
+                    slope = 0.;
+                  else
+                    slope = std::min(slope, min_slope / cut_max_gradients[r]);
+                }
+              if (slope > best_slope)
+                {
+                  height_direction = d;
+                  best_slope       = slope;
+                }
+            }
+
+          if (height_direction == numbers::invalid_unsigned_int)
+            {
+              if (n_remaining_splits > 0)
+                {
+                  split(box,
+                        active,
+                        active_directions,
+                        cut_restrictions,
+                        integrand,
+                        n_remaining_splits);
+                  return;
+                }
+
+              // The box cannot be split anymore: integrate along the
+              // direction of the largest derivative at the center, which
+              // still gives correct, if less accurate, rules
+              Point<dim> center;
+              for (const unsigned int d : active_directions)
+                center[d] = box.center()[d];
+              const Tensor<1, dim> gradient =
+                level_set.gradient(cut_restrictions[0].apply(center));
+              height_direction = active_directions[0];
+              for (const unsigned int d : active_directions)
+                if (std::abs(gradient[d]) >
+                    std::abs(gradient[height_direction]))
+                  height_direction = d;
+            }
+
+          const Integrand face_integrand = [&](const Point<dim> &face_point,
+                                               const double      face_weight) {
+            integrate_line(box,
+                           height_direction,
+                           face_point,
+                           face_weight,
+                           cut_restrictions,
+                           integrand);
+          };
+
+          if (n_active == 1)
+            face_integrand(Point<dim>(), 1.);
+          else
+            {
+              // The restrictions to the lower and upper walls in the height
+              // direction partition the face
+              std::array<bool, dim> face_active = active;
+              face_active[height_direction]     = false;
+              std::vector<Restriction<dim>> face_restrictions;
+              for (const auto &restriction : cut_restrictions)
+                for (const double bound : {box.lower_bound(height_direction),
+                                           box.upper_bound(height_direction)})
+                  {
+                    face_restrictions.push_back(restriction);
+                    face_restrictions.back().fixed_coordinates.emplace_back(
+                      height_direction, bound);
+                  }
+              integrate(box,
+                        face_active,
+                        face_restrictions,
+                        face_integrand,
+                        n_remaining_splits);
+            }
+        }
+
+      private:
+        /**
+         * Integrate over the children of @p box in the active directions.
+         */
+        void
+        split(const BoundingBox<dim> &             box,
+              const std::array<bool, dim> &        active,
+              const std::vector<unsigned int> &    active_directions,
+              const std::vector<Restriction<dim>> &restrictions,
+              const Integrand &                    integrand,
+              const unsigned int                   n_remaining_splits) const
+        {
+          const unsigned int n_children = 1U << active_directions.size();
+          for (unsigned int c = 0; c < n_children; ++c)
+            {
+              Point<dim> lower = box.get_boundary_points().first;
+              Point<dim> upper = box.get_boundary_points().second;
+              for (unsigned int i = 0; i < active_directions.size(); ++i)
+                {
+                  const unsigned int d      = active_directions[i];
+                  const double       middle = 0.5 * (lower[d] + upper[d]);
+                  if (c & (1U << i))
+                    lower[d] = middle;
+                  else
+                    upper[d] = middle;
+                }
+              integrate(BoundingBox<dim>(std::make_pair(lower, upper)),
+                        active,
+                        restrictions,
+                        integrand,
+                        n_remaining_splits - 1);
+            }
+        }
+
+        /**
+         * Call @p integrand for the tensor product rule over the active
+         * directions of @p box.
+         */
+        void
+        integrate_tensor_product(
+          const BoundingBox<dim> &         box,
+          const std::vector<unsigned int> &active_directions,
+          const Integrand &                integrand) const
+        {
+          const unsigned int n_q_points = quadrature1D.size();
+          const unsigned int n_points =
+            Utilities::pow(n_q_points, active_directions.size());
+          for (unsigned int i = 0; i < n_points; ++i)
+            {
+              Point<dim>   point;
+              double       weight = 1.;
+              unsigned int index  = i;
+              for (const unsigned int d : active_directions)
+                {
+                  const unsigned int q = index % n_q_points;
+                  index /= n_q_points;
+                  point[d] = box.lower_bound(d) +
+                             box.side_length(d) * quadrature1D.point(q)[0];
+                  weight *= box.side_length(d) * quadrature1D.weight(q);
+                }
+              integrand(point, weight);
+            }
+        }
+
+        /**
+         * Call @p integrand for the rules over the segments of the line
+         * through @p face_point in direction @p height_direction between the
+         * roots of the restrictions, and add the roots of the level set
+         * function itself to the surface rule.
+         */
+        void
+        integrate_line(const BoundingBox<dim> &             box,
+                       const unsigned int                   height_direction,
+                       const Point<dim> &                   face_point,
+                       const double                         face_weight,
+                       const std::vector<Restriction<dim>> &restrictions,
+                       const Integrand &                    integrand) const
+        {
+          const double a = box.lower_bound(height_direction);
+          const double b = box.upper_bound(height_direction);
+
+          std::vector<double> all_roots;
+          for (const auto &restriction : restrictions)
+            {
+              Point<dim> point = restriction.apply(face_point);
+              const std::vector<double> roots =
+                find_roots_on_line(level_set,
+                                   point,
+                                   height_direction,
+                                   a,
+                                   b,
+                                   additional_data.n_root_search_intervals,
+                                   additional_data.root_tolerance);
+              all_roots.insert(all_roots.end(), roots.begin(), roots.end());
+
+              // The surface element of the graph over the face is
+              // |grad psi| / |d_k psi| times the area element of the face
+              if (restriction.fixed_coordinates.empty())
+                for (const double root : roots)
+                  {
+                    point[height_direction]       = root;
+                    const Tensor<1, dim> gradient = level_set.gradient(point);
+                    const double         norm     = gradient.norm();
+                    if (norm > 0. && gradient[height_direction] != 0.)
+                      surface_quadrature.push_back(
+                        point,
+                        face_weight * norm /
+                          std::abs(gradient[height_direction]),
+                        gradient / norm);
+                  }
+            }
+          std::sort(all_roots.begin(), all_roots.end());
+
+          Point<dim> point = face_point;
+          double     start = a;
+          for (unsigned int r = 0; r <= all_roots.size(); ++r)
+            {
+              const double end = (r < all_roots.size()) ? all_roots[r] : b;
+              if (end > start)
+                for (unsigned int q = 0; q < quadrature1D.size(); ++q)
+                  {
+                    point[height_direction] =
+                      start + (end - start) * quadrature1D.point(q)[0];
+                    integrand(point,
+                              face_weight * (end - start) *
+                                quadrature1D.weight(q));
+                  }
+              start = end;
+            }
+        }
+
+        const Function<dim> &           level_set;
+        const Quadrature<1> &           quadrature1D;
+        const AdditionalQGeneratorData &additional_data;
+        ImmersedSurfaceQuadrature<dim> &surface_quadrature;
+      };
+
+
+
+      /**
+       * A function given, in the reference coordinates of a cell, by the
+       * shape functions of a scalar finite element and the values of the
+       * degrees of freedom on the cell.
+       */
+      template <int dim>
+      class RefSpaceFEFieldFunction : public Function<dim>
+      {
+      public:
+        RefSpaceFEFieldFunction(const FiniteElement<dim> &fe,
+                                const Vector<double> &    dof_values)
+          : fe(fe)
+          , dof_values(dof_values)
+        {}
+
+        double
+        value(const Point<dim> &point, const unsigned int = 0) const override
+        {
+          double value = 0.;
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            value += dof_values[i] * fe.shape_value(i, point);
+          return value;
+        }
+
+        Tensor<1, dim>
+        gradient(const Point<dim> &point,
+                 const unsigned int = 0) const override
+        {
+          Tensor<1, dim> gradient;
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            gradient += dof_values[i] * fe.shape_grad(i, point);
+          return gradient;
+        }
+
+      private:
+        const FiniteElement<dim> &fe;
+        const Vector<double> &    dof_values;
+      };
+    } // namespace QuadratureGeneratorImplementation
+  }   // namespace internal
+
+
+
+  AdditionalQGeneratorData::AdditionalQGeneratorData(
+    const unsigned int max_box_splits,
+    const unsigned int n_root_search_intervals,
+    const double       root_tolerance,
+    const double       min_height_gradient_ratio)
+    : max_box_splits(max_box_splits)
+    , n_root_search_intervals(n_root_search_intervals)
+    , root_tolerance(root_tolerance)
+    , min_height_gradient_ratio(min_height_gradient_ratio)
+  {}
+
+
+
+  template <int dim>
+  QuadratureGenerator<dim>::QuadratureGenerator(
+    const Quadrature<1> & quadrature1D,
+    const AdditionalData &additional_data)
+    : quadrature1D(quadrature1D)
+    , additional_data(additional_data)
+  {
+    Assert(quadrature1D.size() > 0, ExcMessage("The quadrature is empty."));
+    Assert(additional_data.n_root_search_intervals > 0,
+           ExcMessage("At least one root search interval is needed."));
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureGenerator<dim>::generate(const Function<dim> &   level_set,
+                                     const BoundingBox<dim> &box)
+  {
+    inside_points.clear();
+    inside_weights.clear();
+    outside_points.clear();
+    outside_weights.clear();
+    surface_quadrature = ImmersedSurfaceQuadrature<dim>();
+
+    // Sort the points of the full-dimensional rules by the sign of the level
+    // set function
+    const auto integrand = [&](const Point<dim> &point, const double weight) {
+      if (level_set.value(point) < 0.)
+        {
+          inside_points.push_back(point);
+          inside_weights.push_back(weight);
+        }
+      else
+        {
+          outside_points.push_back(point);
+          outside_weights.push_back(weight);
+        }
+    };
+
+    std::array<bool, dim> active;
+    active.fill(true);
+    const internal::QuadratureGeneratorImplementation::RecursiveIntegrator<dim>
+      integrator(level_set, quadrature1D, additional_data, surface_quadrature);
+    integrator.integrate(
+      box,
+      active,
+      {internal::QuadratureGeneratorImplementation::Restriction<dim>()},
+      integrand,
+      additional_data.max_box_splits);
+
+    inside_quadrature  = Quadrature<dim>(inside_points, inside_weights);
+    outside_quadrature = Quadrature<dim>(outside_points, outside_weights);
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  QuadratureGenerator<dim>::get_inside_quadrature() const
+  {
+    return inside_quadrature;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  QuadratureGenerator<dim>::get_outside_quadrature() const
+  {
+    return outside_quadrature;
+  }
+
+
+
+  template <int dim>
+  const ImmersedSurfaceQuadrature<dim> &
+  QuadratureGenerator<dim>::get_surface_quadrature() const
+  {
+    return surface_quadrature;
+  }
+
+
+
+  template <int dim>
+  DiscreteQuadratureGenerator<dim>::DiscreteQuadratureGenerator(
+    const Quadrature<1> &  quadrature1D,
+    const DoFHandler<dim> &dof_handler,
+    const AdditionalData & additional_data)
+    : quadrature1D(quadrature1D)
+    , additional_data(additional_data)
+    , dof_handler(&dof_handler)
+  {
+    Assert(dof_handler.get_fe().n_components() == 1,
+           ExcMessage("The level set function must be scalar."));
+  }
+
+
+
+  template <int dim>
+  template <typename VectorType>
+  unsigned int
+  DiscreteQuadratureGenerator<dim>::reinit(const VectorType &level_set)
+  {
+    const unsigned int n_active_cells =
+      dof_handler->get_triangulation().n_active_cells();
+    if (cell_data.size() != n_active_cells)
+      {
+        clear();
+        cell_data.resize(n_active_cells);
+      }
+
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+    std::vector<Vector<double>>                                 values;
+    for (const auto &cell : dof_handler->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cells.push_back(cell);
+          values.emplace_back(cell->get_fe().dofs_per_cell);
+          cell->get_dof_values(level_set, values.back());
+        }
+
+    return parallel::accumulate_from_subranges<unsigned int>(
+      [&](const std::size_t begin, const std::size_t end) {
+        return generate_on_cells(cells, values, begin, end);
+      },
+      std::size_t(0),
+      cells.size(),
+      16);
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  DiscreteQuadratureGenerator<dim>::generate_on_cells(
+    const std::vector<typename DoFHandler<dim>::active_cell_iterator> &cells,
+    const std::vector<Vector<double>> &level_set_values,
+    const std::size_t                  begin,
+    const std::size_t                  end)
+  {
+    QuadratureGenerator<dim> generator(quadrature1D, additional_data);
+
+    Point<dim> unit_point;
+    for (unsigned int d = 0; d < dim; ++d)
+      unit_point[d] = 1.;
+    const BoundingBox<dim> unit_box(std::make_pair(Point<dim>(), unit_point));
+
+    unsigned int n_generated = 0;
+    for (std::size_t i = begin; i < end; ++i)
+      {
+        CellData &            data   = cell_data[cells[i]->active_cell_index()];
+        const Vector<double> &values = level_set_values[i];
+        if (data.level_set_values.size() == values.size() &&
+            std::equal(values.begin(),
+                       values.end(),
+                       data.level_set_values.begin()))
+          continue;
+
+        const internal::QuadratureGeneratorImplementation::
+          RefSpaceFEFieldFunction<dim>
+            level_set(cells[i]->get_fe(), values);
+        generator.generate(level_set, unit_box);
+
+        data.level_set_values   = values;
+        data.inside_quadrature  = generator.get_inside_quadrature();
+        data.outside_quadrature = generator.get_outside_quadrature();
+        data.surface_quadrature = generator.get_surface_quadrature();
+        ++n_generated;
+      }
+
+    return n_generated;
+  }
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::clear()
+  {
+    cell_data.clear();
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_inside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    AssertIndexRange(cell->active_cell_index(), cell_data.size());
+    Assert(cell_data[cell->active_cell_index()].level_set_values.size() > 0,
+           ExcMessage("No rules have been generated for this cell."));
+    return cell_data[cell->active_cell_index()].inside_quadrature;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_outside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    AssertIndexRange(cell->active_cell_index(), cell_data.size());
+    Assert(cell_data[cell->active_cell_index()].level_set_values.size() > 0,
+           ExcMessage("No rules have been generated for this cell."));
+    return cell_data[cell->active_cell_index()].outside_quadrature;
+  }
+
+
+
+  template <int dim>
+  const ImmersedSurfaceQuadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_surface_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    AssertIndexRange(cell->active_cell_index(), cell_data.size());
+    Assert(cell_data[cell->active_cell_index()].level_set_values.size() > 0,
+           ExcMessage("No rules have been generated for this cell."));
+    return cell_data[cell->active_cell_index()].surface_quadrature;
+  }
+
+
+
+#include "quadrature_generator.inst"
+
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
@@ -93,11 +93,20 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
   const unsigned int     n_subdivisions,
   const CurvedCellRegion curved_cell_region)
 {
-  // first create the output object that we will write into
+  const unsigned int patch_idx =
+    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
+                                           [cell_and_index->first->index()];
+  // did we mess up the indices?
+  Assert(patch_idx < this->patches.size(), ExcInternalError());
+
+  // fill the output object in place: the patches are kept between calls to
+  // build_patches(), so the memory of the data field from a previous call is
+  // reused if the sizes did not change
   ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
-                               DoFHandlerType::space_dimension>
-    patch;
+                               DoFHandlerType::space_dimension> &patch =
+    this->patches[patch_idx];
   patch.n_subdivisions = n_subdivisions;
+  patch.patch_index    = patch_idx;
 
   // set the vertices of the patch. if the mapping does not preserve locations
   // (e.g. MappingQEulerian), we need to compute the offset of the vertex for
@@ -234,10 +243,22 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                     .template set_cell<DoFHandlerType>(dh_cell);
 
                   // Finally call the postprocessor's function that
-                  // deals with scalar inputs.
-                  postprocessor->evaluate_scalar_field(
-                    scratch_data.patch_values_scalar,
-                    scratch_data.postprocessed_values[dataset_number]);
+                  // deals with scalar inputs, or hand the data to the
+                  // batched interface as a field with a single component.
+                  if (postprocessor->provides_batch_evaluation())
+                    {
+                      scratch_data.patch_values_batch.copy_from(
+                        scratch_data.patch_values_scalar, update_flags);
+                      scratch_data.postprocessed_values_batch.reinit(
+                        dataset->n_output_variables, n_q_points);
+                      postprocessor->evaluate_vector_field_batch(
+                        scratch_data.patch_values_batch,
+                        scratch_data.postprocessed_values_batch);
+                    }
+                  else
+                    postprocessor->evaluate_scalar_field(
+                      scratch_data.patch_values_scalar,
+                      scratch_data.postprocessed_values[dataset_number]);
                 }
               else
                 {
@@ -660,22 +681,44 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                   // Whether the solution was complex-scalar or
                   // complex-vector-valued doesn't matter -- we took it apart
                   // into several fields and so we have to call the
-                  // evaluate_vector_field() function.
-                  postprocessor->evaluate_vector_field(
-                    scratch_data.patch_values_system,
-                    scratch_data.postprocessed_values[dataset_number]);
+                  // evaluate_vector_field() function, or its batched
+                  // counterpart if the postprocessor provides one.
+                  if (postprocessor->provides_batch_evaluation())
+                    {
+                      scratch_data.patch_values_batch.copy_from(
+                        scratch_data.patch_values_system, update_flags);
+                      scratch_data.postprocessed_values_batch.reinit(
+                        dataset->n_output_variables, n_q_points);
+                      postprocessor->evaluate_vector_field_batch(
+                        scratch_data.patch_values_batch,
+                        scratch_data.postprocessed_values_batch);
+                    }
+                  else
+                    postprocessor->evaluate_vector_field(
+                      scratch_data.patch_values_system,
+                      scratch_data.postprocessed_values[dataset_number]);
                 }
 
               // Now we need to copy the result of the postprocessor to
               // the Patch object where it can then be further processed
-              // by the functions in DataOutBase
-              for (unsigned int q = 0; q < n_q_points; ++q)
+              // by the functions in DataOutBase. The results of the batched
+              // evaluation are already stored by output variable, which is
+              // also the layout of the Patch object.
+              if (postprocessor->provides_batch_evaluation())
                 for (unsigned int component = 0;
                      component < dataset->n_output_variables;
                      ++component)
-                  patch.data(offset + component, q) =
-                    scratch_data.postprocessed_values[dataset_number][q](
-                      component);
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    patch.data(offset + component, q) =
+                      scratch_data.postprocessed_values_batch(component, q);
+              else
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  for (unsigned int component = 0;
+                       component < dataset->n_output_variables;
+                       ++component)
+                    patch.data(offset + component, q) =
+                      scratch_data.postprocessed_values[dataset_number][q](
+                        component);
 
               // Move the counter for the output location forward as
               // appropriate
@@ -1050,18 +1093,6 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
         (*scratch_data
             .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
     }
-
-  const unsigned int patch_idx =
-    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
-  // did we mess up the indices?
-  Assert(patch_idx < this->patches.size(), ExcInternalError());
-  patch.patch_index = patch_idx;
-
-  // Put the patch into the patches vector. instead of copying the data,
-  // simply swap the contents to avoid the penalty of writing into another
-  // processor's memory
-  this->patches[patch_idx].swap(patch);
 }
 
 
@@ -1175,7 +1206,9 @@ DataOut<dim, DoFHandlerType>::build_patches(
       }
   }
 
-  this->patches.clear();
+  // keep the patches of a previous call to this function, if any: they are
+  // overwritten cell by cell below, which avoids to allocate the data fields
+  // again when only the values of the output vectors changed
   this->patches.resize(all_cells.size());
 
   // Now create a default object for the WorkStream object to work with. The
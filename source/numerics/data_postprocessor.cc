@@ -19,15 +19,132 @@ DEAL_II_NAMESPACE_OPEN
 
 
 
+namespace DataPostprocessorInputs
+{
+  template <int spacedim>
+  void
+  VectorBatch<spacedim>::copy_from(const Vector<spacedim> &inputs,
+                                   const UpdateFlags       update_flags)
+  {
+    static_cast<CommonInputs<spacedim> &>(*this) = inputs;
+
+    const unsigned int n_points = inputs.solution_values.size();
+    if (update_flags & update_values)
+      {
+        const unsigned int n_components =
+          (n_points > 0 ? inputs.solution_values[0].size() : 0);
+        solution_values.reinit(n_components, n_points, true);
+        for (unsigned int q = 0; q < n_points; ++q)
+          for (unsigned int c = 0; c < n_components; ++c)
+            solution_values(c, q) = inputs.solution_values[q](c);
+      }
+
+    if (update_flags & update_gradients)
+      {
+        const unsigned int n_components =
+          (n_points > 0 ? inputs.solution_gradients[0].size() : 0);
+        solution_gradients.reinit(
+          TableIndices<3>(n_components, spacedim, n_points), true);
+        for (unsigned int q = 0; q < n_points; ++q)
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              solution_gradients(c, d, q) = inputs.solution_gradients[q][c][d];
+      }
+
+    if (update_flags & update_hessians)
+      {
+        const unsigned int n_components =
+          (n_points > 0 ? inputs.solution_hessians[0].size() : 0);
+        solution_hessians.reinit(
+          TableIndices<4>(n_components, spacedim, spacedim, n_points), true);
+        for (unsigned int q = 0; q < n_points; ++q)
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              for (unsigned int e = 0; e < spacedim; ++e)
+                solution_hessians(c, d, e, q) =
+                  inputs.solution_hessians[q][c][d][e];
+      }
+  }
+
+
+
+  template <int spacedim>
+  void
+  VectorBatch<spacedim>::copy_from(const Scalar<spacedim> &inputs,
+                                   const UpdateFlags       update_flags)
+  {
+    static_cast<CommonInputs<spacedim> &>(*this) = inputs;
+
+    const unsigned int n_points = inputs.solution_values.size();
+    if (update_flags & update_values)
+      {
+        solution_values.reinit(1, n_points, true);
+        for (unsigned int q = 0; q < n_points; ++q)
+          solution_values(0, q) = inputs.solution_values[q];
+      }
+
+    if (update_flags & update_gradients)
+      {
+        solution_gradients.reinit(TableIndices<3>(1, spacedim, n_points), true);
+        for (unsigned int q = 0; q < n_points; ++q)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            solution_gradients(0, d, q) = inputs.solution_gradients[q][d];
+      }
+
+    if (update_flags & update_hessians)
+      {
+        solution_hessians.reinit(
+          TableIndices<4>(1, spacedim, spacedim, n_points), true);
+        for (unsigned int q = 0; q < n_points; ++q)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            for (unsigned int e = 0; e < spacedim; ++e)
+              solution_hessians(0, d, e, q) = inputs.solution_hessians[q][d][e];
+      }
+  }
+} // namespace DataPostprocessorInputs
+
+
+
+namespace
+{
+  /**
+   * Evaluate a postprocessor that implements the batched interface on data
+   * given by evaluation point, and copy the results back into the
+   * point-wise layout.
+   */
+  template <int dim, typename InputType>
+  void
+  evaluate_through_batch(const DataPostprocessor<dim> &postprocessor,
+                         const InputType &             input_data,
+                         std::vector<Vector<double>> & computed_quantities)
+  {
+    DataPostprocessorInputs::VectorBatch<dim> batch_input;
+    batch_input.copy_from(input_data, postprocessor.get_needed_update_flags());
+
+    const unsigned int n_points = computed_quantities.size();
+    const unsigned int n_outputs =
+      (n_points > 0 ? computed_quantities[0].size() : 0);
+    Table<2, double> batch_output(n_outputs, n_points);
+    postprocessor.evaluate_vector_field_batch(batch_input, batch_output);
+
+    for (unsigned int q = 0; q < n_points; ++q)
+      for (unsigned int i = 0; i < n_outputs; ++i)
+        computed_quantities[q](i) = batch_output(i, q);
+  }
+} // namespace
+
+
+
 // -------------------------- DataPostprocessor ---------------------------
 
 template <int dim>
 void
 DataPostprocessor<dim>::evaluate_scalar_field(
-  const DataPostprocessorInputs::Scalar<dim> &,
-  std::vector<Vector<double>> &) const
+  const DataPostprocessorInputs::Scalar<dim> &input_data,
+  std::vector<Vector<double>> &               computed_quantities) const
 {
-  AssertThrow(false, ExcPureFunctionCalled());
+  AssertThrow(provides_batch_evaluation(), ExcPureFunctionCalled());
+  evaluate_through_batch(*this, input_data, computed_quantities);
 }
 
 
@@ -35,14 +152,35 @@ DataPostprocessor<dim>::evaluate_scalar_field(
 template <int dim>
 void
 DataPostprocessor<dim>::evaluate_vector_field(
-  const DataPostprocessorInputs::Vector<dim> &,
-  std::vector<Vector<double>> &) const
+  const DataPostprocessorInputs::Vector<dim> &input_data,
+  std::vector<Vector<double>> &               computed_quantities) const
+{
+  AssertThrow(provides_batch_evaluation(), ExcPureFunctionCalled());
+  evaluate_through_batch(*this, input_data, computed_quantities);
+}
+
+
+
+template <int dim>
+void
+DataPostprocessor<dim>::evaluate_vector_field_batch(
+  const DataPostprocessorInputs::VectorBatch<dim> &,
+  Table<2, double> &) const
 {
   AssertThrow(false, ExcPureFunctionCalled());
 }
 
 
 
+template <int dim>
+bool
+DataPostprocessor<dim>::provides_batch_evaluation() const
+{
+  return false;
+}
+
+
+
 template <int dim>
 std::vector<DataComponentInterpretation::DataComponentInterpretation>
 DataPostprocessor<dim>::get_data_component_interpretation() const
@@ -704,18 +704,13 @@ namespace DerivativeApproximation
   } // namespace internal
 } // namespace DerivativeApproximation
 
-// Dummy structures and dummy function used for WorkStream
+// Dummy structure used for WorkStream
 namespace DerivativeApproximation
 {
   namespace internal
   {
     namespace Assembler
     {
-      struct Scratch
-      {
-        Scratch() = default;
-      };
-
       struct CopyData
       {
         CopyData() = default;
@@ -732,7 +727,10 @@ namespace DerivativeApproximation
   {
     /**
      * Compute the derivative approximation on one cell. This computes the full
-     * derivative tensor.
+     * derivative tensor. The @p x_fe_midpoint_value object evaluates the
+     * solution at the cell centers; it is passed in so that it can be reused
+     * for all cells a thread works on, rather than being set up anew for
+     * every cell.
      */
     template <class DerivativeDescription,
               int dim,
@@ -741,34 +739,13 @@ namespace DerivativeApproximation
               int spacedim>
     void
     approximate_cell(
-      const Mapping<dim, spacedim> &       mapping,
-      const DoFHandlerType<dim, spacedim> &dof_handler,
-      const InputVector &                  solution,
-      const unsigned int                   component,
+      hp::FEValues<dim> &x_fe_midpoint_value,
+      const InputVector &solution,
+      const unsigned int component,
       const TriaActiveIterator<
         dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>> &cell,
       typename DerivativeDescription::Derivative &derivative)
     {
-      QMidpoint<dim> midpoint_rule;
-
-      // create collection objects from
-      // single quadratures, mappings,
-      // and finite elements. if we have
-      // an hp DoFHandler,
-      // dof_handler.get_fe() returns a
-      // collection of which we do a
-      // shallow copy instead
-      const hp::QCollection<dim>   q_collection(midpoint_rule);
-      const hp::FECollection<dim> &fe_collection =
-        dof_handler.get_fe_collection();
-      const hp::MappingCollection<dim> mapping_collection(mapping);
-
-      hp::FEValues<dim> x_fe_midpoint_value(
-        mapping_collection,
-        fe_collection,
-        q_collection,
-        DerivativeDescription::update_flags | update_quadrature_points);
-
       // matrix Y=sum_i y_i y_i^T
       Tensor<2, dim> Y;
 
@@ -906,6 +883,55 @@ namespace DerivativeApproximation
 
 
 
+    /**
+     * Same as above, but set up the FEValues object for the given mapping
+     * and the finite elements of the given DoFHandler first.
+     */
+    template <class DerivativeDescription,
+              int dim,
+              template <int, int> class DoFHandlerType,
+              class InputVector,
+              int spacedim>
+    void
+    approximate_cell(
+      const Mapping<dim, spacedim> &       mapping,
+      const DoFHandlerType<dim, spacedim> &dof_handler,
+      const InputVector &                  solution,
+      const unsigned int                   component,
+      const TriaActiveIterator<
+        dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>> &cell,
+      typename DerivativeDescription::Derivative &derivative)
+    {
+      QMidpoint<dim> midpoint_rule;
+
+      // create collection objects from
+      // single quadratures, mappings,
+      // and finite elements. if we have
+      // an hp DoFHandler,
+      // dof_handler.get_fe() returns a
+      // collection of which we do a
+      // shallow copy instead
+      const hp::QCollection<dim>   q_collection(midpoint_rule);
+      const hp::FECollection<dim> &fe_collection =
+        dof_handler.get_fe_collection();
+      const hp::MappingCollection<dim> mapping_collection(mapping);
+
+      hp::FEValues<dim> x_fe_midpoint_value(
+        mapping_collection,
+        fe_collection,
+        q_collection,
+        DerivativeDescription::update_flags | update_quadrature_points);
+
+      approximate_cell<DerivativeDescription,
+                       dim,
+                       DoFHandlerType,
+                       InputVector,
+                       spacedim>(
+        x_fe_midpoint_value, solution, component, cell, derivative);
+    }
+
+
+
     /**
      * Compute the derivative approximation on a given cell.  Fill the @p
      * derivative_norm vector with the norm of the computed derivative tensors
@@ -921,11 +947,10 @@ namespace DerivativeApproximation
       SynchronousIterators<std::tuple<
         TriaActiveIterator<
           dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>,
-        Vector<float>::iterator>> const &  cell,
-      const Mapping<dim, spacedim> &       mapping,
-      const DoFHandlerType<dim, spacedim> &dof_handler,
-      const InputVector &                  solution,
-      const unsigned int                   component)
+        Vector<float>::iterator>> const &cell,
+      hp::FEValues<dim> &                x_fe_midpoint_value,
+      const InputVector &                solution,
+      const unsigned int                 component)
     {
       // if the cell is not locally owned, then there is nothing to do
       if (std::get<0>(*cell)->is_locally_owned() == false)
@@ -939,8 +964,7 @@ namespace DerivativeApproximation
                            dim,
                            DoFHandlerType,
                            InputVector,
-                           spacedim>(mapping,
-                                     dof_handler,
+                           spacedim>(x_fe_midpoint_value,
                                      solution,
                                      component,
                                      std::get<0>(*cell),
@@ -991,25 +1015,34 @@ namespace DerivativeApproximation
         Iterators(dof_handler.begin_active(), derivative_norm.begin())),
         end(Iterators(dof_handler.end(), derivative_norm.end()));
 
+      // The FEValues object that evaluates the solution at the cell centers
+      // serves as scratch data, so that every thread sets it up only once
+      // rather than once per cell. The collections it refers to have to
+      // outlive all of its copies.
+      const hp::QCollection<dim>       q_collection(QMidpoint<dim>{});
+      const hp::MappingCollection<dim> mapping_collection(mapping);
+      hp::FEValues<dim>                sample_fe_midpoint_value(
+        mapping_collection,
+        dof_handler.get_fe_collection(),
+        q_collection,
+        DerivativeDescription::update_flags | update_quadrature_points);
+
       // There is no need for a copier because there is no conflict between
-      // threads to write in derivative_norm. Scratch and CopyData are also
-      // useless.
+      // threads to write in derivative_norm. CopyData is also useless.
       WorkStream::run(
         begin,
         end,
-        [&mapping, &dof_handler, &solution, component](
-          SynchronousIterators<Iterators> const &cell,
-          Assembler::Scratch const &,
-          Assembler::CopyData &) {
+        [&solution, component](SynchronousIterators<Iterators> const &cell,
+                               hp::FEValues<dim> &x_fe_midpoint_value,
+                               Assembler::CopyData &) {
           approximate<DerivativeDescription,
                       dim,
                       DoFHandlerType,
                       InputVector,
-                      spacedim>(
-            cell, mapping, dof_handler, solution, component);
+                      spacedim>(cell, x_fe_midpoint_value, solution, component);
         },
         std::function<void(internal::Assembler::CopyData const &)>(),
-        internal::Assembler::Scratch(),
+        sample_fe_midpoint_value,
         internal::Assembler::CopyData());
     }
 
@@ -26,6 +26,7 @@
 #include <deal.II/lac/vector_element_access.h>
 
 #include <deal.II/numerics/point_value_history.h>
+#include <deal.II/numerics/vector_tools_common.h>
 #include <deal.II/numerics/vector_tools_point_value.h>
 
 #include <algorithm>
@@ -923,20 +924,63 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
   unsigned int n_stored =
     mask->second.n_selected_components(dof_handler->get_fe(0).n_components());
 
+  const unsigned int n_components = dof_handler->get_fe(0).n_components();
+
   typename std::vector<
     internal::PointValueHistoryImplementation::PointGeometryData<dim>>::iterator
                  point = point_geometry_data.begin();
-  Vector<number> value(dof_handler->get_fe(0).n_components());
+  Vector<number> value(n_components);
   for (unsigned int data_store_index = 0; point != point_geometry_data.end();
        ++point, ++data_store_index)
     {
-      // Make a Vector <double> for the value
-      // at the point. It will have as many
-      // components as there are in the fe.
-      VectorTools::point_value(*dof_handler,
-                               solution,
-                               point->requested_location,
-                               value);
+      // Locating the point in the mesh and evaluating the shape functions
+      // there is much more expensive than the evaluation of the field
+      // itself, so do this only once and store the result until the mesh
+      // changes. This mirrors what VectorTools::point_value() does.
+      if (point->requested_location_shape_values.m() == 0)
+        {
+          const std::pair<typename DoFHandler<dim>::active_cell_iterator,
+                          Point<dim>>
+            cell_point = GridTools::find_active_cell_around_point(
+              StaticMappingQ1<dim>::mapping,
+              *dof_handler,
+              point->requested_location);
+          AssertThrow(cell_point.first->is_locally_owned(),
+                      VectorTools::ExcPointNotAvailableHere());
+
+          const Quadrature<dim> quadrature(
+            GeometryInfo<dim>::project_to_unit_cell(cell_point.second));
+          FEValues<dim> fe_values(StaticMappingQ1<dim>::mapping,
+                                  cell_point.first->get_fe(),
+                                  quadrature,
+                                  update_values);
+          fe_values.reinit(cell_point.first);
+
+          const unsigned int dofs_per_cell = fe_values.dofs_per_cell;
+          point->requested_location_dof_indices.resize(dofs_per_cell);
+          cell_point.first->get_dof_indices(
+            point->requested_location_dof_indices);
+          point->requested_location_shape_values.reinit(n_components,
+                                                        dofs_per_cell);
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              point->requested_location_shape_values(c, i) =
+                fe_values.shape_value_component(i, 0, c);
+        }
+
+      // Now compute the value at the point
+      // for all components of the fe.
+      value = number();
+      for (unsigned int i = 0; i < point->requested_location_dof_indices.size();
+           ++i)
+        {
+          const number dof_value =
+            internal::ElementAccess<VectorType>::get(
+              solution, point->requested_location_dof_indices[i]);
+          for (unsigned int c = 0; c < n_components; ++c)
+            value(c) +=
+              point->requested_location_shape_values(c, i) * dof_value;
+        }
 
       // Look up the component_mask and add
       // in components according to that mask
@@ -1500,6 +1544,16 @@ PointValueHistory<dim>::tria_change_listener()
   // this into account next time we
   // evaluate the solution
   triangulation_changed = true;
+
+  // the cells that contain the requested
+  // locations, and consequently the shape
+  // function values there, need to be
+  // computed anew
+  for (auto &point : point_geometry_data)
+    {
+      point.requested_location_dof_indices.clear();
+      point.requested_location_shape_values.reinit(0, 0);
+    }
 }
 
 
@@ -19,6 +19,8 @@
 #ifdef DEAL_II_WITH_OPENCASCADE
 
 
+#  include <deal.II/base/parallel.h>
+
 #  include <BRepAdaptor_CompCurve.hxx>
 #  include <BRepAdaptor_Curve.hxx>
 #  include <BRepAdaptor_HCompCurve.hxx>
@@ -29,11 +31,14 @@
 #  include <ShapeAnalysis_Curve.hxx>
 #  include <ShapeAnalysis_Surface.hxx>
 #  include <Standard_Version.hxx>
+#  include <TopExp_Explorer.hxx>
 #  include <TopoDS.hxx>
 #  if (OCC_VERSION_MAJOR < 7)
 #    include <Handle_Adaptor3d_HCurve.hxx>
 #  endif
 
+#  include <limits>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -84,6 +89,10 @@ namespace OpenCASCADE
     , tolerance(tolerance)
   {
     Assert(spacedim == 3, ExcNotImplemented());
+
+    TopExp_Explorer exp;
+    for (exp.Init(sh, TopAbs_FACE); exp.More(); exp.Next())
+      surfaces.push_back(BRep_Tool::Surface(TopoDS::Face(exp.Current())));
   }
 
 
@@ -104,15 +113,112 @@ namespace OpenCASCADE
     const ArrayView<const Point<spacedim>> &surrounding_points,
     const Point<spacedim> &                 candidate) const
   {
-    (void)surrounding_points;
 #  ifdef DEBUG
-    for (unsigned int i = 0; i < surrounding_points.size(); ++i)
-      Assert(closest_point(sh, surrounding_points[i], tolerance)
-                 .distance(surrounding_points[i]) <
-               std::max(tolerance * surrounding_points[i].norm(), tolerance),
-             ExcPointNotOnManifold<spacedim>(surrounding_points[i]));
+    for (const Point<spacedim> &p : surrounding_points)
+      Assert(closest_point_on_faces(make_array_view(&p, &p + 1), p)
+                 .distance(p) < std::max(tolerance * p.norm(), tolerance),
+             ExcPointNotOnManifold<spacedim>(p));
 #  endif
-    return closest_point(sh, candidate, tolerance);
+    return closest_point_on_faces(surrounding_points, candidate);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NormalProjectionManifold<dim, spacedim>::get_new_points(
+    const ArrayView<const Point<spacedim>> &surrounding_points,
+    const Table<2, double> &                weights,
+    ArrayView<Point<spacedim>>              new_points) const
+  {
+    AssertDimension(surrounding_points.size(), weights.size(1));
+    AssertDimension(new_points.size(), weights.size(0));
+
+    // the projections are expensive compared to the overhead of spawning
+    // tasks, so already split small numbers of points
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(weights.size(0)),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int row = begin; row < end; ++row)
+          {
+            Point<spacedim> new_point;
+            for (unsigned int p = 0; p < surrounding_points.size(); ++p)
+              new_point += surrounding_points[p] * weights(row, p);
+            new_points[row] =
+              this->project_to_manifold(surrounding_points, new_point);
+          }
+      },
+      4);
+  }
+
+
+
+  template <int dim, int spacedim>
+  Point<spacedim>
+  NormalProjectionManifold<dim, spacedim>::closest_point_on_faces(
+    const ArrayView<const Point<spacedim>> &surrounding_points,
+    const Point<spacedim> &                 candidate) const
+  {
+    // shapes without faces are handled by the general function that also
+    // looks at edges
+    if (surfaces.empty())
+      return closest_point(sh, candidate, tolerance);
+
+    ProjectionCache &cache = projection_cache.get();
+    if (cache.projectors.empty())
+      for (const auto &surface : surfaces)
+        cache.projectors.push_back(new ShapeAnalysis_Surface(surface));
+
+    // look up the face and the UV coordinates of one of the surrounding
+    // points, which serve as initial guess on that face
+    unsigned int hint_face = numbers::invalid_unsigned_int;
+    gp_Pnt2d     hint_uv;
+    for (const auto &p : surrounding_points)
+      {
+        const auto entry = cache.uv_coordinates.find(p);
+        if (entry != cache.uv_coordinates.end())
+          {
+            hint_face = entry->second.first;
+            hint_uv.SetCoord(entry->second.second[0], entry->second.second[1]);
+            break;
+          }
+      }
+
+    // as in project_point_and_pull_back(), find the closest projection over
+    // all faces
+    const gp_Pnt    origin       = point(candidate);
+    double          min_distance = std::numeric_limits<double>::max();
+    Point<spacedim> closest      = candidate;
+    unsigned int    closest_face = numbers::invalid_unsigned_int;
+    gp_Pnt2d        closest_uv;
+    for (unsigned int f = 0; f < surfaces.size(); ++f)
+      {
+        const gp_Pnt2d uv =
+          (f == hint_face) ?
+            cache.projectors[f]->NextValueOfUV(hint_uv, origin, tolerance) :
+            cache.projectors[f]->ValueOfUV(origin, tolerance);
+        const Point<spacedim> projection =
+          point<spacedim>(cache.projectors[f]->Value(uv));
+        const double distance = projection.distance(candidate);
+        if (distance < min_distance)
+          {
+            min_distance = distance;
+            closest      = projection;
+            closest_face = f;
+            closest_uv   = uv;
+          }
+      }
+
+    // the new point is likely to be a surrounding point in later calls, so
+    // remember its UV coordinates. Limit the memory consumption of the cache
+    // by starting over if it gets too large
+    if (cache.uv_coordinates.size() > 100000)
+      cache.uv_coordinates.clear();
+    cache.uv_coordinates[closest] =
+      std::make_pair(closest_face, Point<2>(closest_uv.X(), closest_uv.Y()));
+
+    return closest;
   }
 
 
@@ -410,6 +516,11 @@ namespace OpenCASCADE
   ArclengthProjectionLineManifold<dim, spacedim>::pull_back(
     const Point<spacedim> &space_point) const
   {
+    auto &     cache = arclength_cache.get();
+    const auto entry = cache.find(space_point);
+    if (entry != cache.end())
+      return Point<1>(entry->second);
+
     double              t(0.0);
     ShapeAnalysis_Curve curve_analysis;
     gp_Pnt              proj;
@@ -418,8 +529,14 @@ namespace OpenCASCADE
     Assert(dist < tolerance * length,
            ExcPointNotOnManifold<spacedim>(space_point));
     (void)dist; // Silence compiler warning in Release mode.
-    return Point<1>(GCPnts_AbscissaPoint::Length(
-      curve->GetCurve(), curve->GetCurve().FirstParameter(), t));
+    const double arclength = GCPnts_AbscissaPoint::Length(
+      curve->GetCurve(), curve->GetCurve().FirstParameter(), t);
+
+    if (cache.size() > 100000)
+      cache.clear();
+    cache[space_point] = arclength;
+
+    return Point<1>(arclength);
   }
 
 
@@ -433,7 +550,21 @@ namespace OpenCASCADE
                             chart_point[0],
                             curve->GetCurve().FirstParameter());
     gp_Pnt               P = curve->GetCurve().Value(AP.Parameter());
-    return point<spacedim>(P);
+    const Point<spacedim> space_point = point<spacedim>(P);
+
+    // the point is likely to be a surrounding point in later calls, so
+    // remember its arclength to avoid the projection in pull_back(). Only do
+    // this for arclengths in the range that pull_back() returns, which
+    // might not be the case for periodic curves
+    if (chart_point[0] >= 0. && chart_point[0] <= length)
+      {
+        auto &cache = arclength_cache.get();
+        if (cache.size() > 100000)
+          cache.clear();
+        cache[space_point] = chart_point[0];
+      }
+
+    return space_point;
   }
 
   template <int dim, int spacedim>
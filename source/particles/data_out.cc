@@ -25,7 +25,7 @@ namespace Particles
 {
   template <int dim, int spacedim>
   void
-  DataOut<dim, spacedim>::build_patches(
+  DataOut<dim, spacedim>::set_data_components(
     const Particles::ParticleHandler<dim, spacedim> &particles,
     const std::vector<std::string> &                 data_component_names,
     const std::vector<DataComponentInterpretation::DataComponentInterpretation>
@@ -71,6 +71,21 @@ namespace Particles
       data_component_interpretations.end(),
       data_component_interpretations_.begin(),
       data_component_interpretations_.end());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::build_patches(
+    const Particles::ParticleHandler<dim, spacedim> &particles,
+    const std::vector<std::string> &                 data_component_names,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &data_component_interpretations_)
+  {
+    set_data_components(particles,
+                        data_component_names,
+                        data_component_interpretations_);
 
     const unsigned int n_property_components = data_component_names.size();
     const unsigned int n_data_components     = dataset_names.size();
@@ -103,6 +118,93 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::collect_point_cloud(
+    const Particles::ParticleHandler<dim, spacedim> &particles,
+    std::vector<Point<spacedim>> &                   points,
+    Table<2, double> &                               data) const
+  {
+    const unsigned int n_data_components     = dataset_names.size();
+    const unsigned int n_property_components = n_data_components - 1;
+
+    points.resize(particles.n_locally_owned_particles());
+    data.reinit(n_data_components, points.size());
+
+    auto particle = particles.begin();
+    for (unsigned int i = 0; particle != particles.end(); ++particle, ++i)
+      {
+        points[i]  = particle->get_location();
+        data(0, i) = particle->get_id();
+
+        if (n_property_components > 0)
+          {
+            const ArrayView<const double> properties =
+              particle->get_properties();
+            for (unsigned int property_index = 0;
+                 property_index < n_property_components;
+                 ++property_index)
+              data(property_index + 1, i) = properties[property_index];
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::write_vtu_point_cloud(
+    const Particles::ParticleHandler<dim, spacedim> &particles,
+    std::ostream &                                   out,
+    const std::vector<std::string> &                 data_component_names,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &                          data_component_interpretations_,
+    const DataOutBase::VtkFlags &flags)
+  {
+    set_data_components(particles,
+                        data_component_names,
+                        data_component_interpretations_);
+
+    std::vector<Point<spacedim>> points;
+    Table<2, double>             data;
+    collect_point_cloud(particles, points, data);
+
+    DataOutBase::write_vtu_point_cloud(
+      points, data, get_dataset_names(), get_nonscalar_data_ranges(), flags, out);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::write_vtu_point_cloud_in_parallel(
+    const Particles::ParticleHandler<dim, spacedim> &particles,
+    const std::string &                              filename,
+    const MPI_Comm &                                 comm,
+    const std::vector<std::string> &                 data_component_names,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &                          data_component_interpretations_,
+    const DataOutBase::VtkFlags &flags)
+  {
+    set_data_components(particles,
+                        data_component_names,
+                        data_component_interpretations_);
+
+    std::vector<Point<spacedim>> points;
+    Table<2, double>             data;
+    collect_point_cloud(particles, points, data);
+
+    DataOutBase::write_vtu_point_cloud_in_parallel(points,
+                                                   data,
+                                                   get_dataset_names(),
+                                                   get_nonscalar_data_ranges(),
+                                                   flags,
+                                                   filename,
+                                                   comm);
+  }
+
+
+
   template <int dim, int spacedim>
   const std::vector<DataOutBase::Patch<0, spacedim>> &
   DataOut<dim, spacedim>::get_patches() const
@@ -15,6 +15,7 @@
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/signaling_nan.h>
 
@@ -106,6 +107,31 @@ namespace Particles
 
         return cumulative_cell_weights;
       }
+
+
+
+      // The approximate number of particles a single task generates when
+      // the generation is split over several threads.
+      const unsigned int particles_per_task = 256;
+
+
+
+      // Return the locally owned active cells of the triangulation in the
+      // order in which they are traversed, which is also the order in which
+      // the particle handler stores particles.
+      template <int dim, int spacedim>
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      locally_owned_active_cells(
+        const Triangulation<dim, spacedim> &triangulation)
+      {
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          local_cells;
+        local_cells.reserve(triangulation.n_active_cells());
+        for (const auto &cell : triangulation.active_cell_iterators())
+          if (cell->is_locally_owned())
+            local_cells.push_back(cell);
+        return local_cells;
+      }
     } // namespace
 
     template <int dim, int spacedim>
@@ -116,6 +142,15 @@ namespace Particles
       ParticleHandler<dim, spacedim> &    particle_handler,
       const Mapping<dim, spacedim> &      mapping)
     {
+      const std::vector<
+        typename Triangulation<dim, spacedim>::active_cell_iterator>
+        local_cells = locally_owned_active_cells(triangulation);
+
+      const unsigned int n_particles_per_cell =
+        particle_reference_locations.size();
+      const types::particle_index n_particles_to_generate =
+        local_cells.size() * n_particles_per_cell;
+
       types::particle_index particle_index = 0;
 
 #ifdef DEAL_II_WITH_MPI
@@ -123,42 +158,46 @@ namespace Particles
             dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
               &triangulation))
         {
-          const types::particle_index n_particles_to_generate =
-            tria->n_locally_owned_active_cells() *
-            particle_reference_locations.size();
-
           // The local particle start index is the number of all particles
           // generated on lower MPI ranks.
-          MPI_Exscan(&n_particles_to_generate,
-                     &particle_index,
-                     1,
-                     DEAL_II_PARTICLE_INDEX_MPI_TYPE,
-                     MPI_SUM,
-                     tria->get_communicator());
+          const int ierr = MPI_Exscan(&n_particles_to_generate,
+                                      &particle_index,
+                                      1,
+                                      DEAL_II_PARTICLE_INDEX_MPI_TYPE,
+                                      MPI_SUM,
+                                      tria->get_communicator());
+          AssertThrowMPI(ierr);
         }
 #endif
 
-      for (const auto &cell : triangulation.active_cell_iterators())
-        {
-          if (cell->is_locally_owned())
-            {
-              for (const auto &reference_location :
-                   particle_reference_locations)
-                {
-                  const Point<spacedim> position_real =
-                    mapping.transform_unit_to_real_cell(cell,
-                                                        reference_location);
-
-                  const Particle<dim, spacedim> particle(position_real,
-                                                         reference_location,
-                                                         particle_index);
-                  particle_handler.insert_particle(particle, cell);
-                  ++particle_index;
-                }
-            }
-        }
+      // All particles and their ids are known in advance, so generate them
+      // cell by cell in parallel and then insert them all at once.
+      std::vector<std::pair<
+        typename Triangulation<dim, spacedim>::active_cell_iterator,
+        Particle<dim, spacedim>>>
+        particles(n_particles_to_generate);
+
+      parallel::apply_to_subranges(
+        0u,
+        static_cast<unsigned int>(local_cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int c = begin; c < end; ++c)
+            for (unsigned int i = 0; i < n_particles_per_cell; ++i)
+              {
+                const types::particle_index index =
+                  static_cast<types::particle_index>(c) * n_particles_per_cell +
+                  i;
+                particles[index].first  = local_cells[c];
+                particles[index].second = Particle<dim, spacedim>(
+                  mapping.transform_unit_to_real_cell(
+                    local_cells[c], particle_reference_locations[i]),
+                  particle_reference_locations[i],
+                  particle_index + index);
+              }
+        },
+        std::max(1u, particles_per_task / std::max(1u, n_particles_per_cell)));
 
-      particle_handler.update_cached_numbers();
+      particle_handler.insert_particles(particles);
     }
 
 
@@ -372,12 +411,16 @@ namespace Particles
 
       // Now generate as many particles per cell as determined above
       {
-        unsigned int current_particle_index = start_particle_id;
+        types::particle_index current_particle_index = start_particle_id;
 
-        std::multimap<
+        // The particles are drawn from a single random number generator to
+        // keep the result reproducible, so they are created sequentially,
+        // but inserted all at once.
+        std::vector<std::pair<
           typename Triangulation<dim, spacedim>::active_cell_iterator,
-          Particle<dim, spacedim>>
+          Particle<dim, spacedim>>>
           particles;
+        particles.reserve(n_local_particles);
 
         for (const auto &cell : triangulation.active_cell_iterators())
           if (cell->is_locally_owned())
@@ -391,9 +434,7 @@ namespace Particles
                                             current_particle_index,
                                             random_number_generator,
                                             mapping);
-                  particles.emplace_hint(particles.end(),
-                                         cell,
-                                         std::move(particle));
+                  particles.emplace_back(cell, std::move(particle));
                   ++current_particle_index;
                 }
             }
@@ -453,23 +494,30 @@ namespace Particles
     {
       const std::vector<Point<dim>> &particle_reference_locations =
         quadrature.get_points();
-      std::vector<Point<spacedim>> points_to_generate;
+      const unsigned int n_points_per_cell =
+        particle_reference_locations.size();
+
+      const std::vector<
+        typename Triangulation<dim, spacedim>::active_cell_iterator>
+        local_cells = locally_owned_active_cells(triangulation);
+
+      // Loop through cells in parallel and gather the quadrature points
+      std::vector<Point<spacedim>> points_to_generate(local_cells.size() *
+                                                      n_points_per_cell);
+      parallel::apply_to_subranges(
+        0u,
+        static_cast<unsigned int>(local_cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int c = begin; c < end; ++c)
+            for (unsigned int q = 0; q < n_points_per_cell; ++q)
+              points_to_generate[static_cast<std::size_t>(c) *
+                                   n_points_per_cell +
+                                 q] =
+                mapping.transform_unit_to_real_cell(
+                  local_cells[c], particle_reference_locations[q]);
+        },
+        std::max(1u, particles_per_task / std::max(1u, n_points_per_cell)));
 
-      //       Loop through cells and gather gauss points
-      for (const auto &cell : triangulation.active_cell_iterators())
-        {
-          if (cell->is_locally_owned())
-            {
-              for (const auto &reference_location :
-                   particle_reference_locations)
-                {
-                  const Point<spacedim> position_real =
-                    mapping.transform_unit_to_real_cell(cell,
-                                                        reference_location);
-                  points_to_generate.push_back(position_real);
-                }
-            }
-        }
       particle_handler.insert_global_particles(points_to_generate,
                                                global_bounding_boxes,
                                                properties);
@@ -125,6 +125,12 @@ namespace Particles
   {
     if (this != &particle)
       {
+        // Release the properties this particle currently owns before
+        // taking over the state of the other particle
+        if (property_pool != nullptr &&
+            properties != PropertyPool::invalid_handle)
+          property_pool->deallocate_properties_array(properties);
+
         location           = particle.location;
         reference_location = particle.reference_location;
         id                 = particle.id;
@@ -157,6 +163,10 @@ namespace Particles
   {
     if (this != &particle)
       {
+        if (property_pool != nullptr &&
+            properties != PropertyPool::invalid_handle)
+          property_pool->deallocate_properties_array(properties);
+
         location            = particle.location;
         reference_location  = particle.reference_location;
         id                  = particle.id;
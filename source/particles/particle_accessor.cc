@@ -21,7 +21,7 @@ namespace Particles
 {
   template <int dim, int spacedim>
   ParticleAccessor<dim, spacedim>::ParticleAccessor()
-    : map(nullptr)
+    : container(nullptr)
     , particle()
   {}
 
@@ -29,11 +29,11 @@ namespace Particles
 
   template <int dim, int spacedim>
   ParticleAccessor<dim, spacedim>::ParticleAccessor(
-    const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-    const typename std::multimap<internal::LevelInd,
-                                 Particle<dim, spacedim>>::iterator & particle)
-    : map(const_cast<
-          std::multimap<internal::LevelInd, Particle<dim, spacedim>> *>(&map))
+    const internal::ParticleContainer<dim, spacedim> &container,
+    const typename internal::ParticleContainer<dim, spacedim>::iterator
+      &particle)
+    : container(
+        const_cast<internal::ParticleContainer<dim, spacedim> *>(&container))
     , particle(particle)
   {}
 
@@ -43,7 +43,7 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::write_data(void *&data) const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     particle->second.write_data(data);
   }
@@ -54,7 +54,7 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::set_location(const Point<spacedim> &new_loc)
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     particle->second.set_location(new_loc);
   }
@@ -65,7 +65,7 @@ namespace Particles
   const Point<spacedim> &
   ParticleAccessor<dim, spacedim>::get_location() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.get_location();
   }
@@ -77,7 +77,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_reference_location(
     const Point<dim> &new_loc)
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     particle->second.set_reference_location(new_loc);
   }
@@ -88,7 +88,7 @@ namespace Particles
   const Point<dim> &
   ParticleAccessor<dim, spacedim>::get_reference_location() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.get_reference_location();
   }
@@ -99,7 +99,7 @@ namespace Particles
   types::particle_index
   ParticleAccessor<dim, spacedim>::get_id() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.get_id();
   }
@@ -111,7 +111,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_property_pool(
     PropertyPool &new_property_pool)
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     particle->second.set_property_pool(new_property_pool);
   }
@@ -122,7 +122,7 @@ namespace Particles
   bool
   ParticleAccessor<dim, spacedim>::has_properties() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.has_properties();
   }
@@ -134,7 +134,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_properties(
     const std::vector<double> &new_properties)
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     particle->second.set_properties(new_properties);
   }
@@ -146,7 +146,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_properties(
     const ArrayView<const double> &new_properties)
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     particle->second.set_properties(new_properties);
   }
@@ -157,7 +157,7 @@ namespace Particles
   const ArrayView<const double>
   ParticleAccessor<dim, spacedim>::get_properties() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.get_properties();
   }
@@ -169,7 +169,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::get_surrounding_cell(
     const Triangulation<dim, spacedim> &triangulation) const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     const typename Triangulation<dim, spacedim>::cell_iterator cell(
       &triangulation, particle->first.first, particle->first.second);
@@ -182,7 +182,7 @@ namespace Particles
   const ArrayView<double>
   ParticleAccessor<dim, spacedim>::get_properties()
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.get_properties();
   }
@@ -193,7 +193,7 @@ namespace Particles
   std::size_t
   ParticleAccessor<dim, spacedim>::serialized_size_in_bytes() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
 
     return particle->second.serialized_size_in_bytes();
   }
@@ -204,7 +204,7 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::next()
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(particle != container->end(), ExcInternalError());
     ++particle;
   }
 
@@ -214,7 +214,7 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::prev()
   {
-    Assert(particle != map->begin(), ExcInternalError());
+    Assert(particle != container->begin(), ExcInternalError());
     --particle;
   }
 
@@ -225,7 +225,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::
   operator!=(const ParticleAccessor<dim, spacedim> &other) const
   {
-    return (map != other.map) || (particle != other.particle);
+    return (container != other.container) || (particle != other.particle);
   }
 
 
@@ -235,7 +235,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::
   operator==(const ParticleAccessor<dim, spacedim> &other) const
   {
-    return (map == other.map) && (particle == other.particle);
+    return (container == other.container) && (particle == other.particle);
   }
 } // namespace Particles
 
@@ -13,12 +13,17 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/utilities.h>
+
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
 #include <deal.II/particles/particle_handler.h>
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <utility>
 
 DEAL_II_NAMESPACE_OPEN
@@ -27,23 +32,37 @@ namespace Particles
 {
   namespace
   {
-    template <int dim, int spacedim>
+    /**
+     * Serialize the particles in the given ranges of a particle container
+     * into one buffer, without copying the particles first.
+     */
+    template <typename ParticleRange>
     std::vector<char>
-    pack_particles(std::vector<Particle<dim, spacedim>> &particles)
+    pack_particles(const std::vector<ParticleRange> &particle_ranges)
     {
       std::vector<char> buffer;
 
-      if (particles.size() == 0)
+      std::size_t n_particles   = 0;
+      std::size_t particle_size = 0;
+      for (const auto &range : particle_ranges)
+        if (range.first != range.second)
+          {
+            n_particles += std::distance(range.first, range.second);
+            particle_size = range.first->second.serialized_size_in_bytes();
+          }
+
+      if (n_particles == 0)
         return buffer;
 
-      buffer.resize(particles.size() *
-                    particles.front().serialized_size_in_bytes());
+      buffer.resize(n_particles * particle_size);
       void *current_data = buffer.data();
 
-      for (const auto &particle : particles)
-        {
-          particle.write_data(current_data);
-        }
+      for (const auto &range : particle_ranges)
+        for (auto particle = range.first; particle != range.second; ++particle)
+          particle->second.write_data(current_data);
+
+      Assert(current_data == buffer.data() + buffer.size(),
+             ExcInternalError());
 
       return buffer;
     }
@@ -65,6 +84,7 @@ namespace Particles
       const unsigned int particle_size = particle.serialized_size_in_bytes();
 
       particles.reserve(data_range.size() / particle_size);
+      property_pool.reserve(data_range.size() / particle_size);
 
       const void *data = static_cast<const void *>(&(*data_range.begin()));
 
@@ -82,6 +102,84 @@ namespace Particles
 
       return particles;
     }
+
+
+
+    /**
+     * A comparison function object that orders the entries of an
+     * internal::ParticleContainer by the cell the particles are in. The
+     * entries can also be compared against a bare cell level/index pair,
+     * which allows to use this object with std::equal_range().
+     */
+    struct CompareParticleCells
+    {
+      template <typename ParticleType>
+      bool
+      operator()(const std::pair<internal::LevelInd, ParticleType> &a,
+                 const std::pair<internal::LevelInd, ParticleType> &b) const
+      {
+        return a.first < b.first;
+      }
+
+      template <typename ParticleType>
+      bool
+      operator()(const std::pair<internal::LevelInd, ParticleType> &a,
+                 const internal::LevelInd &                         b) const
+      {
+        return a.first < b;
+      }
+
+      template <typename ParticleType>
+      bool
+      operator()(const internal::LevelInd &                         a,
+                 const std::pair<internal::LevelInd, ParticleType> &b) const
+      {
+        return a < b.first;
+      }
+    };
+
+
+
+    /**
+     * Return the range of entries of the sorted container @p particles that
+     * belong to the cell with the given level/index pair.
+     */
+    template <typename ContainerType>
+    auto
+    particle_range_in_cell(ContainerType &           particles,
+                           const internal::LevelInd &level_index)
+      -> decltype(std::make_pair(particles.begin(), particles.end()))
+    {
+      return std::equal_range(particles.begin(),
+                              particles.end(),
+                              level_index,
+                              CompareParticleCells());
+    }
+
+
+
+    /**
+     * Restore the ordering of @p particles by cell, assuming that the first
+     * @p n_sorted entries are already sorted and the remaining entries have
+     * been appended in arbitrary order. This is of $O(N + M \log M)$
+     * complexity for $M$ appended entries, and keeps entries of the same cell
+     * in the order in which they were inserted.
+     */
+    template <int dim, int spacedim>
+    void
+    sort_appended_particles(
+      internal::ParticleContainer<dim, spacedim> &particles,
+      const std::size_t                           n_sorted)
+    {
+      Assert(n_sorted <= particles.size(), ExcInternalError());
+
+      const auto first_appended = particles.begin() + n_sorted;
+      std::stable_sort(first_appended, particles.end(), CompareParticleCells());
+      std::inplace_merge(particles.begin(),
+                         first_appended,
+                         particles.end(),
+                         CompareParticleCells());
+    }
   } // namespace
 
   template <int dim, int spacedim>
@@ -125,6 +223,19 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  ParticleHandler<dim, spacedim>::~ParticleHandler()
+  {
+    cell_weight_connection.disconnect();
+
+    // The particles release their properties into the property pool, so
+    // they have to be destroyed while the pool still exists
+    particles.clear();
+    ghost_particles.clear();
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::initialize(
@@ -132,9 +243,17 @@ namespace Particles
     const Mapping<dim, spacedim> &      new_mapping,
     const unsigned int                  n_properties)
   {
+    cell_weight_connection.disconnect();
+
     triangulation = &new_triangulation;
     mapping       = &new_mapping;
 
+    // Existing particles store their properties in the current pool, so
+    // they have to be destroyed before the pool is replaced
+    particles.clear();
+    ghost_particles.clear();
+    ghost_cache = GhostParticleCache();
+
     // Create the memory pool that will store all particle properties
     property_pool = std::make_unique<PropertyPool>(n_properties);
 
@@ -164,6 +283,7 @@ namespace Particles
   ParticleHandler<dim, spacedim>::clear_particles()
   {
     particles.clear();
+    ghost_cache.valid = false;
   }
 
 
@@ -304,9 +424,15 @@ namespace Particles
       std::make_pair(cell->level(), cell->index());
 
     if (cell->is_locally_owned())
-      return particles.count(found_cell);
+      {
+        const auto range = particle_range_in_cell(particles, found_cell);
+        return std::distance(range.first, range.second);
+      }
     else if (cell->is_ghost())
-      return ghost_particles.count(found_cell);
+      {
+        const auto range = particle_range_in_cell(ghost_particles, found_cell);
+        return std::distance(range.first, range.second);
+      }
     else
       AssertThrow(false,
                   ExcMessage("You can't ask for the particles on an artificial "
@@ -340,14 +466,16 @@ namespace Particles
 
     if (cell->is_ghost())
       {
-        const auto particles_in_cell = ghost_particles.equal_range(level_index);
+        const auto particles_in_cell =
+          particle_range_in_cell(ghost_particles, level_index);
         return boost::make_iterator_range(
           particle_iterator(ghost_particles, particles_in_cell.first),
           particle_iterator(ghost_particles, particles_in_cell.second));
       }
     else if (cell->is_locally_owned())
       {
-        const auto particles_in_cell = particles.equal_range(level_index);
+        const auto particles_in_cell =
+          particle_range_in_cell(particles, level_index);
         return boost::make_iterator_range(
           particle_iterator(particles, particles_in_cell.first),
           particle_iterator(particles, particles_in_cell.second));
@@ -369,6 +497,49 @@ namespace Particles
     const ParticleHandler<dim, spacedim>::particle_iterator &particle)
   {
     particles.erase(particle->particle);
+    ghost_cache.valid = false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::remove_particles(
+    const std::vector<particle_iterator> &particles_to_remove)
+  {
+    if (particles_to_remove.empty())
+      return;
+
+    // Convert the iterators into positions within the container and sort
+    // them, then compact the container in a single pass
+    std::vector<std::size_t> positions;
+    positions.reserve(particles_to_remove.size());
+    for (const auto &particle : particles_to_remove)
+      {
+        Assert(particle->container == &particles, ExcInternalError());
+        positions.push_back(particle->particle - particles.begin());
+      }
+    std::sort(positions.begin(), positions.end());
+
+    auto        write_position    = particles.begin() + positions.front();
+    std::size_t next_removed_item = 0;
+    for (std::size_t i = positions.front(); i < particles.size(); ++i)
+      if (next_removed_item < positions.size() &&
+          positions[next_removed_item] == i)
+        {
+          // Skip this particle, and also duplicate entries of it
+          while (next_removed_item < positions.size() &&
+                 positions[next_removed_item] == i)
+            ++next_removed_item;
+        }
+      else
+        {
+          *write_position = std::move(particles[i]);
+          ++write_position;
+        }
+
+    particles.erase(write_position, particles.end());
+    ghost_cache.valid = false;
   }
 
 
@@ -379,11 +550,17 @@ namespace Particles
     const Particle<dim, spacedim> &                                    particle,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
   {
-    typename std::multimap<internal::LevelInd,
-                           Particle<dim, spacedim>>::iterator it =
-      particles.insert(
-        std::make_pair(internal::LevelInd(cell->level(), cell->index()),
-                       particle));
+    // Insert the particle after all particles of its cell. If the cell
+    // comes after all cells that already contain particles, this is an
+    // append operation
+    const internal::LevelInd level_index(cell->level(), cell->index());
+    const auto               it = particles.insert(
+      std::upper_bound(particles.begin(),
+                       particles.end(),
+                       level_index,
+                       CompareParticleCells()),
+      std::make_pair(level_index, particle));
+    ghost_cache.valid = false;
 
     particle_iterator particle_it(particles, it);
     particle_it->set_property_pool(*property_pool);
@@ -404,13 +581,49 @@ namespace Particles
       typename Triangulation<dim, spacedim>::active_cell_iterator,
       Particle<dim, spacedim>> &new_particles)
   {
+    const std::size_t n_existing_particles = particles.size();
+    particles.reserve(n_existing_particles + new_particles.size());
     for (auto particle = new_particles.begin(); particle != new_particles.end();
          ++particle)
-      particles.insert(
-        particles.end(),
-        std::make_pair(internal::LevelInd(particle->first->level(),
-                                          particle->first->index()),
-                       particle->second));
+      particles.emplace_back(internal::LevelInd(particle->first->level(),
+                                                particle->first->index()),
+                             particle->second);
+
+    sort_appended_particles(particles, n_existing_particles);
+    ghost_cache.valid = false;
+
+    update_cached_numbers();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::insert_particles(
+    const std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                Particle<dim, spacedim>>> &new_particles)
+  {
+    const std::size_t n_existing_particles = particles.size();
+    particles.reserve(n_existing_particles + new_particles.size());
+    for (const auto &particle : new_particles)
+      {
+        // Like insert_particle(), store the properties of the new particles
+        // in the property pool of this object
+        particles.emplace_back(
+          internal::LevelInd(particle.first->level(), particle.first->index()),
+          Particle<dim, spacedim>(particle.second.get_location(),
+                                  particle.second.get_reference_location(),
+                                  particle.second.get_id()));
+        particles.back().second.set_property_pool(*property_pool);
+
+        if (particle.second.has_properties())
+          particles.back().second.set_properties(
+            particle.second.get_properties());
+      }
+
+    sort_appended_particles(particles, n_existing_particles);
+    ghost_cache.valid = false;
 
     update_cached_numbers();
   }
@@ -461,23 +674,24 @@ namespace Particles
     if (cells.size() == 0)
       return;
 
-    auto hint =
-      particles.find(std::make_pair(cells[0]->level(), cells[0]->index()));
+    const std::size_t n_existing_particles = particles.size();
+    particles.reserve(n_existing_particles + positions.size());
     for (unsigned int i = 0; i < cells.size(); ++i)
       {
         internal::LevelInd current_cell(cells[i]->level(), cells[i]->index());
         for (unsigned int p = 0; p < local_positions[i].size(); ++p)
           {
-            hint = particles.insert(
-              hint,
-              std::make_pair(current_cell,
-                             Particle<dim, spacedim>(positions[index_map[i][p]],
-                                                     local_positions[i][p],
-                                                     local_start_index +
-                                                       index_map[i][p])));
+            particles.emplace_back(
+              current_cell,
+              Particle<dim, spacedim>(positions[index_map[i][p]],
+                                      local_positions[i][p],
+                                      local_start_index + index_map[i][p]));
           }
       }
 
+    sort_appended_particles(particles, n_existing_particles);
+    ghost_cache.valid = false;
+
     update_cached_numbers();
   }
 
@@ -865,31 +1079,46 @@ namespace Particles
     std::vector<particle_iterator> particles_out_of_cell;
     particles_out_of_cell.reserve(n_locally_owned_particles());
 
-    // Now update the reference locations of the moved particles
-    for (particle_iterator it = begin(); it != end(); ++it)
+    // Now update the reference locations of the moved particles. Since the
+    // particles are stored sorted by cell, we can hand the locations of all
+    // particles in one cell to the mapping together, which then only needs
+    // to compute the data associated with the cell once
+    std::vector<Point<spacedim>> real_locations;
+    std::vector<Point<dim>>      reference_locations;
+    for (auto cell_begin = particles.begin(); cell_begin != particles.end();)
       {
+        const auto cell_end =
+          std::find_if(cell_begin,
+                       particles.end(),
+                       [&cell_begin](const auto &entry) {
+                         return entry.first != cell_begin->first;
+                       });
+        const unsigned int n_particles_in_cell = cell_end - cell_begin;
+
+        real_locations.resize(n_particles_in_cell);
+        reference_locations.resize(n_particles_in_cell);
+        for (unsigned int i = 0; i < n_particles_in_cell; ++i)
+          real_locations[i] = cell_begin[i].second.get_location();
+
         const typename Triangulation<dim, spacedim>::cell_iterator cell =
-          it->get_surrounding_cell(*triangulation);
+          particle_iterator(particles, cell_begin)
+            ->get_surrounding_cell(*triangulation);
+        mapping->transform_points_real_to_unit_cell(cell,
+                                                    real_locations,
+                                                    reference_locations);
+
+        for (unsigned int i = 0; i < n_particles_in_cell; ++i)
+          if (GeometryInfo<dim>::is_inside_unit_cell(reference_locations[i]))
+            cell_begin[i].second.set_reference_location(
+              reference_locations[i]);
+          else
+            {
+              // The particle has left the cell
+              particles_out_of_cell.push_back(
+                particle_iterator(particles, cell_begin + i));
+            }
 
-        try
-          {
-            const Point<dim> p_unit =
-              mapping->transform_real_to_unit_cell(cell, it->get_location());
-            if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-              {
-                it->set_reference_location(p_unit);
-              }
-            else
-              {
-                // The particle has left the cell
-                particles_out_of_cell.push_back(it);
-              }
-          }
-        catch (typename Mapping<dim>::ExcTransformationFailed &)
-          {
-            // The particle has left the cell
-            particles_out_of_cell.push_back(it);
-          }
+        cell_begin = cell_end;
       }
 
     // There are three reasons why a particle is not in its old cell:
@@ -930,15 +1159,18 @@ namespace Particles
         static_cast<vector_size>(particles_out_of_cell.size() * 0.25));
 
     {
-      // Create a map from vertices to adjacent cells using grid cache
-      std::vector<
-        std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>>
-        vertex_to_cells = triangulation_cache->get_vertex_to_cell_map();
-
-      // Create a corresponding map of vectors from vertex to cell center using
-      // grid cache
-      std::vector<std::vector<Tensor<1, spacedim>>> vertex_to_cell_centers =
-        triangulation_cache->get_vertex_to_cell_centers_directions();
+      // Get the compressed map from vertices to adjacent cells from the grid
+      // cache. The cells adjacent to vertex v are stored at positions
+      // vertex_to_cells.first[v] to vertex_to_cells.first[v+1]-1 of
+      // vertex_to_cells.second.
+      const auto &vertex_to_cells =
+        triangulation_cache->get_compressed_vertex_to_cell_map();
+
+      // Get the corresponding map of vectors from vertex to cell center from
+      // the grid cache
+      const std::vector<std::vector<Tensor<1, spacedim>>>
+        &vertex_to_cell_centers =
+          triangulation_cache->get_vertex_to_cell_centers_directions();
 
       std::vector<unsigned int> neighbor_permutation;
 
@@ -967,14 +1199,17 @@ namespace Particles
 
           const unsigned int closest_vertex_index =
             current_cell->vertex_index(closest_vertex);
+          const unsigned int first_neighbor_cell =
+            vertex_to_cells.first[closest_vertex_index];
           const unsigned int n_neighbor_cells =
-            vertex_to_cells[closest_vertex_index].size();
+            vertex_to_cells.first[closest_vertex_index + 1] -
+            first_neighbor_cell;
 
           neighbor_permutation.resize(n_neighbor_cells);
           for (unsigned int i = 0; i < n_neighbor_cells; ++i)
             neighbor_permutation[i] = i;
 
-          const auto cell_centers =
+          const auto &cell_centers =
             vertex_to_cell_centers[closest_vertex_index];
           std::sort(neighbor_permutation.begin(),
                     neighbor_permutation.end(),
@@ -992,17 +1227,15 @@ namespace Particles
             {
               try
                 {
-                  typename std::set<typename Triangulation<dim, spacedim>::
-                                      active_cell_iterator>::const_iterator
-                    cell = vertex_to_cells[closest_vertex_index].begin();
-
-                  std::advance(cell, neighbor_permutation[i]);
+                  const auto &cell =
+                    vertex_to_cells.second[first_neighbor_cell +
+                                           neighbor_permutation[i]];
                   const Point<dim> p_unit =
-                    mapping->transform_real_to_unit_cell(*cell,
+                    mapping->transform_real_to_unit_cell(cell,
                                                          (*it)->get_location());
                   if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
                     {
-                      current_cell               = *cell;
+                      current_cell               = cell;
                       current_reference_position = p_unit;
                       found_cell                 = true;
                       break;
@@ -1043,13 +1276,15 @@ namespace Particles
           (*it)->set_reference_location(current_reference_position);
 
           // Reinsert the particle into our domain if we own its cell.
-          // Mark it for MPI transfer otherwise
+          // Mark it for MPI transfer otherwise. The particle is moved out of
+          // the container, its now empty entry is removed below together
+          // with the entries of all other particles that left their cell.
           if (current_cell->is_locally_owned())
             {
-              sorted_particles.push_back(
-                std::make_pair(internal::LevelInd(current_cell->level(),
-                                                  current_cell->index()),
-                               (*it)->particle->second));
+              sorted_particles.emplace_back(
+                internal::LevelInd(current_cell->level(),
+                                   current_cell->index()),
+                std::move((*it)->particle->second));
             }
           else
             {
@@ -1059,12 +1294,9 @@ namespace Particles
         }
     }
 
-    // Sort the updated particles. This pre-sort speeds up inserting
-    // them into particles to O(N) complexity.
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      sorted_particles_map;
-
-    // Exchange particles between processors if we have more than one process
+    // Exchange particles between processors if we have more than one process.
+    // The received particles are appended to the ones that moved to another
+    // locally owned cell.
 #ifdef DEAL_II_WITH_MPI
     if (const auto parallel_triangulation =
           dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
@@ -1072,19 +1304,24 @@ namespace Particles
       {
         if (dealii::Utilities::MPI::n_mpi_processes(
               parallel_triangulation->get_communicator()) > 1)
-          send_recv_particles(moved_particles,
-                              sorted_particles_map,
-                              moved_cells);
+          send_recv_particles(moved_particles, sorted_particles, moved_cells);
       }
 #endif
 
-    sorted_particles_map.insert(sorted_particles.begin(),
-                                sorted_particles.end());
+    // Now remove all particles that left their cell in one pass over the
+    // container, which keeps the remaining particles sorted, and merge the
+    // particles that were re-sorted or received back into it
+    remove_particles(particles_out_of_cell);
+
+    if (!particles_out_of_cell.empty() || !sorted_particles.empty())
+      ghost_cache.valid = false;
 
-    for (unsigned int i = 0; i < particles_out_of_cell.size(); ++i)
-      remove_particle(particles_out_of_cell[i]);
+    const std::size_t n_remaining_particles = particles.size();
+    particles.insert(particles.end(),
+                     std::make_move_iterator(sorted_particles.begin()),
+                     std::make_move_iterator(sorted_particles.end()));
+    sort_appended_particles(particles, n_remaining_particles);
 
-    particles.insert(sorted_particles_map.begin(), sorted_particles_map.end());
     update_cached_numbers();
   }
 
@@ -1092,8 +1329,106 @@ namespace Particles
 
   template <int dim, int spacedim>
   void
-  ParticleHandler<dim, spacedim>::exchange_ghost_particles()
+  ParticleHandler<dim, spacedim>::reorder_particles_for_memory_locality()
   {
+    // First sort the particles of every cell along a Hilbert curve through
+    // their reference locations. The cells themselves stay in place, so the
+    // container remains sorted by cell.
+    std::vector<Point<dim>>   reference_locations;
+    std::vector<unsigned int> permutation;
+    std::vector<typename internal::ParticleContainer<dim, spacedim>::value_type>
+      sorted_cell;
+
+    for (auto cell_begin = particles.begin(); cell_begin != particles.end();)
+      {
+        const auto cell_end = std::find_if(cell_begin,
+                                           particles.end(),
+                                           [&cell_begin](const auto &entry) {
+                                             return entry.first !=
+                                                    cell_begin->first;
+                                           });
+        const unsigned int n_particles_in_cell = cell_end - cell_begin;
+
+        if (n_particles_in_cell > 1)
+          {
+            reference_locations.clear();
+            for (auto particle = cell_begin; particle != cell_end; ++particle)
+              reference_locations.push_back(
+                particle->second.get_reference_location());
+
+            const std::vector<std::array<std::uint64_t, dim>> hilbert_indices =
+              Utilities::inverse_Hilbert_space_filling_curve(
+                reference_locations);
+
+            permutation.resize(n_particles_in_cell);
+            std::iota(permutation.begin(), permutation.end(), 0u);
+            std::sort(permutation.begin(),
+                      permutation.end(),
+                      [&hilbert_indices](const unsigned int a,
+                                         const unsigned int b) {
+                        return std::lexicographical_compare(
+                          hilbert_indices[a].begin(),
+                          hilbert_indices[a].end(),
+                          hilbert_indices[b].begin(),
+                          hilbert_indices[b].end());
+                      });
+
+            sorted_cell.clear();
+            for (const unsigned int i : permutation)
+              sorted_cell.push_back(std::move(*(cell_begin + i)));
+            std::move(sorted_cell.begin(), sorted_cell.end(), cell_begin);
+          }
+
+        cell_begin = cell_end;
+      }
+
+    // Then redistribute the properties over the slots the particles occupy,
+    // such that the slots are traversed in increasing order of their
+    // addresses when looping over the particles. This is done in bulk by
+    // copying all properties into a temporary buffer, and assigning the
+    // sorted slots to the particles in storage order.
+    const unsigned int n_properties = property_pool->n_properties_per_slot();
+    if (n_properties > 0)
+      {
+        std::vector<PropertyPool::Handle> handles;
+        handles.reserve(particles.size());
+        for (const auto &particle : particles)
+          if (particle.second.properties != PropertyPool::invalid_handle)
+            handles.push_back(particle.second.properties);
+
+        std::vector<double> properties(handles.size() * n_properties);
+        for (unsigned int i = 0; i < handles.size(); ++i)
+          std::copy(handles[i],
+                    handles[i] + n_properties,
+                    properties.begin() + i * n_properties);
+
+        std::sort(handles.begin(), handles.end(), std::less<double *>());
+
+        unsigned int i = 0;
+        for (auto &particle : particles)
+          if (particle.second.properties != PropertyPool::invalid_handle)
+            {
+              particle.second.properties = handles[i];
+              std::copy(properties.begin() + i * n_properties,
+                        properties.begin() + (i + 1) * n_properties,
+                        handles[i]);
+              ++i;
+            }
+      }
+
+    ghost_cache.valid = false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::exchange_ghost_particles(
+    const bool enable_ghost_cache)
+  {
+    // Any previously cached communication pattern becomes outdated
+    ghost_cache.valid = false;
+
     // Nothing to do in serial computations
     const auto parallel_triangulation =
       dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
@@ -1161,7 +1496,176 @@ namespace Particles
           }
       }
 
-    send_recv_particles(ghost_particles_by_domain, ghost_particles);
+    send_recv_particles(
+      ghost_particles_by_domain,
+      ghost_particles,
+      std::map<
+        types::subdomain_id,
+        std::vector<
+          typename Triangulation<dim, spacedim>::active_cell_iterator>>(),
+      enable_ghost_cache);
+
+    if (enable_ghost_cache)
+      {
+        // Sort the received particles by cell, but remember for each
+        // received particle where it ended up, so that its data can be
+        // written directly to that position in update_ghost_particles()
+        std::vector<unsigned int> permutation(ghost_particles.size());
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::stable_sort(permutation.begin(),
+                         permutation.end(),
+                         [this](const unsigned int a, const unsigned int b) {
+                           return ghost_particles[a].first <
+                                  ghost_particles[b].first;
+                         });
+
+        internal::ParticleContainer<dim, spacedim> sorted_ghost_particles;
+        sorted_ghost_particles.reserve(ghost_particles.size());
+        ghost_cache.ghost_positions.resize(ghost_particles.size());
+        for (unsigned int i = 0; i < permutation.size(); ++i)
+          {
+            sorted_ghost_particles.push_back(
+              std::move(ghost_particles[permutation[i]]));
+            ghost_cache.ghost_positions[permutation[i]] = i;
+          }
+        ghost_particles.swap(sorted_ghost_particles);
+
+        ghost_cache.valid = true;
+      }
+    else
+      sort_appended_particles(ghost_particles, 0);
+#else
+    (void)enable_ghost_cache;
+#endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::update_ghost_particles()
+  {
+    // Nothing to do in serial computations
+    const auto parallel_triangulation =
+      dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+        &*triangulation);
+    if (parallel_triangulation != nullptr)
+      {
+        if (dealii::Utilities::MPI::n_mpi_processes(
+              parallel_triangulation->get_communicator()) == 1)
+          return;
+      }
+    else
+      return;
+
+#ifdef DEAL_II_WITH_MPI
+    // The cached pattern can only be used if it describes the current
+    // particles on all processes. Otherwise, do a full exchange.
+    if (Utilities::MPI::min(ghost_cache.valid ? 1U : 0U,
+                            parallel_triangulation->get_communicator()) == 0)
+      {
+        exchange_ghost_particles(true);
+        return;
+      }
+
+    const unsigned int n_neighbors = ghost_cache.neighbors.size();
+
+    // All particles are serialized into the same number of bytes, which
+    // allows to compute the size of all messages from the number of
+    // particles alone
+    const unsigned int callback_size = (size_callback ? size_callback() : 0);
+    const unsigned int send_particle_size =
+      (ghost_cache.particles_to_send.empty() ?
+         0 :
+         ghost_cache.particles_to_send.front()->serialized_size_in_bytes() +
+           callback_size);
+    const unsigned int recv_particle_size =
+      (ghost_particles.empty() ?
+         0 :
+         ghost_particles.front().second.serialized_size_in_bytes() +
+           callback_size);
+
+    // Serialize the data sorted by receiving process
+    ghost_cache.send_data.resize(ghost_cache.particles_to_send.size() *
+                                 send_particle_size);
+    void *data = static_cast<void *>(ghost_cache.send_data.data());
+    for (const auto &particle : ghost_cache.particles_to_send)
+      {
+        particle->write_data(data);
+        if (store_callback)
+          data = store_callback(particle, data);
+      }
+
+    ghost_cache.recv_data.resize(ghost_particles.size() * recv_particle_size);
+
+    // Exchange the particle data between domains
+    {
+      const int mpi_tag =
+        Utilities::MPI::internal::Tags::particle_handler_update_ghost_particles;
+
+      std::vector<MPI_Request> requests;
+      requests.reserve(2 * n_neighbors);
+
+      std::size_t recv_offset = 0;
+      for (unsigned int i = 0; i < n_neighbors; ++i)
+        if (ghost_cache.n_recv_particles[i] > 0)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Irecv(ghost_cache.recv_data.data() + recv_offset,
+                        ghost_cache.n_recv_particles[i] * recv_particle_size,
+                        MPI_CHAR,
+                        ghost_cache.neighbors[i],
+                        mpi_tag,
+                        parallel_triangulation->get_communicator(),
+                        &requests.back());
+            AssertThrowMPI(ierr);
+            recv_offset += ghost_cache.n_recv_particles[i] * recv_particle_size;
+          }
+
+      std::size_t send_offset = 0;
+      for (unsigned int i = 0; i < n_neighbors; ++i)
+        if (ghost_cache.n_send_particles[i] > 0)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Isend(ghost_cache.send_data.data() + send_offset,
+                        ghost_cache.n_send_particles[i] * send_particle_size,
+                        MPI_CHAR,
+                        ghost_cache.neighbors[i],
+                        mpi_tag,
+                        parallel_triangulation->get_communicator(),
+                        &requests.back());
+            AssertThrowMPI(ierr);
+            send_offset += ghost_cache.n_send_particles[i] * send_particle_size;
+          }
+
+      const int ierr =
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+
+    // Overwrite the ghost particles with the received data. The cells of
+    // the ghost particles do not change.
+    const void *recv_data_it =
+      static_cast<const void *>(ghost_cache.recv_data.data());
+    for (const unsigned int position : ghost_cache.ghost_positions)
+      {
+        ghost_particles[position].second =
+          Particle<dim, spacedim>(recv_data_it, property_pool.get());
+
+        if (load_callback)
+          recv_data_it =
+            load_callback(particle_iterator(ghost_particles,
+                                            ghost_particles.begin() + position),
+                          recv_data_it);
+      }
+
+    AssertThrow(recv_data_it == ghost_cache.recv_data.data() +
+                                  ghost_cache.recv_data.size(),
+                ExcMessage(
+                  "The amount of data that was read into ghost particles "
+                  "does not match the amount of data sent around."));
 #endif
   }
 
@@ -1173,12 +1677,12 @@ namespace Particles
   ParticleHandler<dim, spacedim>::send_recv_particles(
     const std::map<types::subdomain_id, std::vector<particle_iterator>>
       &particles_to_send,
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      &received_particles,
+    internal::ParticleContainer<dim, spacedim> &received_particles,
     const std::map<
       types::subdomain_id,
       std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
-      &send_cells)
+      &        send_cells,
+    const bool build_ghost_cache)
   {
     const auto parallel_triangulation =
       dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
@@ -1220,6 +1724,27 @@ namespace Particles
 
     const unsigned int cellid_size = sizeof(CellId::binary_type);
 
+    if (build_ghost_cache)
+      {
+        ghost_cache.neighbors = neighbors;
+        ghost_cache.n_send_particles.assign(n_neighbors, 0);
+        ghost_cache.n_recv_particles.assign(n_neighbors, 0);
+        ghost_cache.particles_to_send.clear();
+        ghost_cache.particles_to_send.reserve(n_send_particles);
+        for (unsigned int i = 0; i < n_neighbors; ++i)
+          {
+            const auto send_particles = particles_to_send.find(neighbors[i]);
+            if (send_particles != particles_to_send.end())
+              {
+                ghost_cache.n_send_particles[i] = send_particles->second.size();
+                ghost_cache.particles_to_send.insert(
+                  ghost_cache.particles_to_send.end(),
+                  send_particles->second.begin(),
+                  send_particles->second.end());
+              }
+          }
+      }
+
     // Containers for the amount and offsets of data we will send
     // to other processors and the data itself.
     std::vector<unsigned int> n_send_data(n_neighbors, 0);
@@ -1367,12 +1892,25 @@ namespace Particles
 
     // Put the received particles into the domain if they are in the
     // triangulation
-    const void *recv_data_it = static_cast<const void *>(recv_data.data());
+    const void * recv_data_it = static_cast<const void *>(recv_data.data());
+    unsigned int neighbor_index = 0;
 
     while (reinterpret_cast<std::size_t>(recv_data_it) -
              reinterpret_cast<std::size_t>(recv_data.data()) <
            total_recv_data)
       {
+        if (build_ghost_cache)
+          {
+            // Find out which process sent this particle
+            const std::size_t offset =
+              reinterpret_cast<std::size_t>(recv_data_it) -
+              reinterpret_cast<std::size_t>(recv_data.data());
+            while (offset >= recv_offsets[neighbor_index] +
+                               n_recv_data[neighbor_index])
+              ++neighbor_index;
+            ++ghost_cache.n_recv_particles[neighbor_index];
+          }
+
         CellId::binary_type binary_cellid;
         memcpy(&binary_cellid, recv_data_it, cellid_size);
         const CellId id(binary_cellid);
@@ -1381,15 +1919,14 @@ namespace Particles
         const typename Triangulation<dim, spacedim>::active_cell_iterator cell =
           id.to_cell(*triangulation);
 
-        typename std::multimap<internal::LevelInd,
-                               Particle<dim, spacedim>>::iterator
-          recv_particle = received_particles.insert(std::make_pair(
-            internal::LevelInd(cell->level(), cell->index()),
-            Particle<dim, spacedim>(recv_data_it, property_pool.get())));
+        received_particles.emplace_back(
+          internal::LevelInd(cell->level(), cell->index()),
+          Particle<dim, spacedim>(recv_data_it, property_pool.get()));
 
         if (load_callback)
           recv_data_it =
-            load_callback(particle_iterator(received_particles, recv_particle),
+            load_callback(particle_iterator(received_particles,
+                                            received_particles.end() - 1),
                           recv_data_it);
       }
 
@@ -1507,6 +2044,10 @@ namespace Particles
         non_const_triangulation->notify_ready_to_unpack(handle,
                                                         callback_function);
 
+        // The particles were appended cell by cell in the order in which
+        // the triangulation unpacked the data. Sort them by cell now.
+        sort_appended_particles(particles, 0);
+
         // Reset handle and update global number of particles. The number
         // can change because of discarded or newly generated particles
         handle = numbers::invalid_unsigned_int;
@@ -1519,13 +2060,91 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  unsigned int
+  ParticleHandler<dim, spacedim>::cell_weight(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const typename Triangulation<dim, spacedim>::CellStatus     status,
+    const unsigned int weight_per_particle) const
+  {
+    unsigned int n_particles = 0;
+
+    switch (status)
+      {
+        case parallel::distributed::Triangulation<dim, spacedim>::CELL_PERSIST:
+        case parallel::distributed::Triangulation<dim, spacedim>::CELL_REFINE:
+          n_particles = n_particles_in_cell(cell);
+          break;
+
+        case parallel::distributed::Triangulation<dim, spacedim>::CELL_COARSEN:
+          for (unsigned int child_index = 0;
+               child_index < GeometryInfo<dim>::max_children_per_cell;
+               ++child_index)
+            n_particles += n_particles_in_cell(cell->child(child_index));
+          break;
+
+        default:
+          Assert(false, ExcInternalError());
+          break;
+      }
+
+    return weight_per_particle * n_particles;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::connect_cell_weight_signal(
+    const unsigned int weight_per_particle)
+  {
+    Assert(triangulation != nullptr, ExcNotInitialized());
+
+    cell_weight_connection.disconnect();
+    cell_weight_connection = triangulation->signals.cell_weight.connect(
+      [this, weight_per_particle](
+        const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+        const typename Triangulation<dim, spacedim>::CellStatus     status) {
+        return this->cell_weight(cell, status, weight_per_particle);
+      });
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::disconnect_cell_weight_signal()
+  {
+    cell_weight_connection.disconnect();
+  }
+
+
+
   template <int dim, int spacedim>
   std::vector<char>
   ParticleHandler<dim, spacedim>::store_particles(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const typename Triangulation<dim, spacedim>::CellStatus     status) const
   {
-    std::vector<Particle<dim, spacedim>> stored_particles_on_cell;
+    // Collect the ranges of the containers that hold the particles to
+    // store. They are then packed into one buffer directly from the
+    // containers.
+    using ParticleRange =
+      std::pair<typename internal::ParticleContainer<dim,
+                                                     spacedim>::const_iterator,
+                typename internal::ParticleContainer<dim,
+                                                     spacedim>::const_iterator>;
+    std::vector<ParticleRange> particle_ranges;
+
+    const auto add_particles_in_cell =
+      [this, &particle_ranges](
+        const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        const internal::LevelInd level_index = {cell->level(), cell->index()};
+        particle_ranges.push_back(
+          cell->is_ghost() ?
+            particle_range_in_cell(ghost_particles, level_index) :
+            particle_range_in_cell(particles, level_index));
+      };
 
     switch (status)
       {
@@ -1533,73 +2152,16 @@ namespace Particles
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_REFINE:
           // If the cell persist or is refined store all particles of the
           // current cell.
-          {
-            unsigned int n_particles = 0;
-
-            const internal::LevelInd level_index = {cell->level(),
-                                                    cell->index()};
-            const auto               particles_in_cell =
-              (cell->is_ghost() ? ghost_particles.equal_range(level_index) :
-                                  particles.equal_range(level_index));
-
-            n_particles = n_particles_in_cell(cell);
-            stored_particles_on_cell.reserve(n_particles);
-
-            std::for_each(
-              particles_in_cell.first,
-              particles_in_cell.second,
-              [&stored_particles_on_cell](
-                const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                  &particle) {
-                stored_particles_on_cell.push_back(particle.second);
-              });
-
-            AssertDimension(n_particles, stored_particles_on_cell.size());
-          }
+          add_particles_in_cell(cell);
           break;
 
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_COARSEN:
           // If this cell is the parent of children that will be coarsened,
           // collect the particles of all children.
-          {
-            unsigned int n_particles = 0;
-
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
-              {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                  child = cell->child(child_index);
-                n_particles += n_particles_in_cell(child);
-              }
-
-            stored_particles_on_cell.reserve(n_particles);
-
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
-              {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                                         child       = cell->child(child_index);
-                const internal::LevelInd level_index = {child->level(),
-                                                        child->index()};
-                const auto               particles_in_cell =
-                  (child->is_ghost() ?
-                     ghost_particles.equal_range(level_index) :
-                     particles.equal_range(level_index));
-
-                std::for_each(
-                  particles_in_cell.first,
-                  particles_in_cell.second,
-                  [&stored_particles_on_cell](
-                    const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                      &particle) {
-                    stored_particles_on_cell.push_back(particle.second);
-                  });
-              }
-
-            AssertDimension(n_particles, stored_particles_on_cell.size());
-          }
+          for (unsigned int child_index = 0;
+               child_index < GeometryInfo<dim>::max_children_per_cell;
+               ++child_index)
+            add_particles_in_cell(cell->child(child_index));
           break;
 
         default:
@@ -1607,7 +2169,7 @@ namespace Particles
           break;
       }
 
-    return pack_particles(stored_particles_on_cell);
+    return pack_particles(particle_ranges);
   }
 
   template <int dim, int spacedim>
@@ -1618,7 +2180,10 @@ namespace Particles
     const boost::iterator_range<std::vector<char>::const_iterator> &data_range)
   {
     // We leave this container non-const to be able to `std::move`
-    // its contents directly into the particles multimap later.
+    // its contents directly into the particles container later. All
+    // particles are appended to the container here; they are sorted by cell
+    // once all cells have been unpacked in
+    // register_load_callback_function().
     std::vector<Particle<dim, spacedim>> loaded_particles_on_cell =
       unpack_particles<dim, spacedim>(data_range, *property_pool);
 
@@ -1632,66 +2197,30 @@ namespace Particles
       {
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_PERSIST:
           {
-            auto position_hint = particles.end();
-            for (const auto &particle : loaded_particles_on_cell)
-              {
-                // Use std::multimap::emplace_hint to speed up insertion of
-                // particles.
-                position_hint =
-                  particles.emplace_hint(position_hint,
-                                         std::make_pair(cell->level(),
+            for (auto &particle : loaded_particles_on_cell)
+              particles.emplace_back(internal::LevelInd(cell->level(),
                                                         cell->index()),
-                                         std::move(particle));
-                // Move the hint position forward by one, i.e., for the next
-                // particle. The 'hint' position will thus be right after the
-                // one just inserted.
-                ++position_hint;
-              }
+                                     std::move(particle));
           }
           break;
 
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_COARSEN:
           {
-            typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-              position_hint = particles.end();
             for (auto &particle : loaded_particles_on_cell)
               {
                 const Point<dim> p_unit =
                   mapping->transform_real_to_unit_cell(cell,
                                                        particle.get_location());
                 particle.set_reference_location(p_unit);
-                // Use std::multimap::emplace_hint to speed up insertion of
-                // particles.
-                position_hint =
-                  particles.emplace_hint(position_hint,
-                                         std::make_pair(cell->level(),
-                                                        cell->index()),
-                                         std::move(particle));
-                // Move the hint position forward by one, i.e., for the next
-                // particle. The 'hint' position will thus be right after the
-                // one just inserted.
-                ++position_hint;
+                particles.emplace_back(internal::LevelInd(cell->level(),
+                                                          cell->index()),
+                                       std::move(particle));
               }
           }
           break;
 
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_REFINE:
           {
-            std::vector<
-              typename std::multimap<internal::LevelInd,
-                                     Particle<dim, spacedim>>::iterator>
-              position_hints(GeometryInfo<dim>::max_children_per_cell);
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
-              {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                  child                     = cell->child(child_index);
-                position_hints[child_index] = particles.upper_bound(
-                  std::make_pair(child->level(), child->index()));
-              }
-
             for (auto &particle : loaded_particles_on_cell)
               {
                 for (unsigned int child_index = 0;
@@ -1709,17 +2238,10 @@ namespace Particles
                         if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
                           {
                             particle.set_reference_location(p_unit);
-                            // Use std::multimap::emplace_hint to speed up
-                            // insertion of particles.
-                            position_hints[child_index] =
-                              particles.emplace_hint(
-                                position_hints[child_index],
-                                std::make_pair(child->level(), child->index()),
-                                std::move(particle));
-                            // Move the hint position forward by one, i.e.,
-                            // for the next particle. The 'hint' position will
-                            // thus be right after the one just inserted.
-                            ++position_hints[child_index];
+                            particles.emplace_back(
+                              internal::LevelInd(child->level(),
+                                                 child->index()),
+                              std::move(particle));
                             break;
                           }
                       }
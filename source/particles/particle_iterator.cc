@@ -21,10 +21,10 @@ namespace Particles
 {
   template <int dim, int spacedim>
   ParticleIterator<dim, spacedim>::ParticleIterator(
-    const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-    const typename std::multimap<internal::LevelInd,
-                                 Particle<dim, spacedim>>::iterator & particle)
-    : accessor(map, particle)
+    const internal::ParticleContainer<dim, spacedim> &container,
+    const typename internal::ParticleContainer<dim, spacedim>::iterator
+      &particle)
+    : accessor(container, particle)
   {}
 
 
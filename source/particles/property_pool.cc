@@ -16,15 +16,30 @@
 
 #include <deal.II/particles/property_pool.h>
 
+#include <algorithm>
+#include <functional>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
 {
+  namespace
+  {
+    /**
+     * The smallest number of slots a slab is created with when the pool
+     * runs out of free slots.
+     */
+    const std::size_t minimum_slab_size = 1024;
+  } // namespace
+
+
+
   const PropertyPool::Handle PropertyPool::invalid_handle = nullptr;
 
 
   PropertyPool::PropertyPool(const unsigned int n_properties_per_slot)
     : n_properties(n_properties_per_slot)
+    , n_slots(0)
   {}
 
 
@@ -32,10 +47,16 @@ namespace Particles
   PropertyPool::Handle
   PropertyPool::allocate_properties_array()
   {
-    PropertyPool::Handle handle = PropertyPool::invalid_handle;
-    if (n_properties > 0)
-      handle = new double[n_properties];
+    if (n_properties == 0)
+      return PropertyPool::invalid_handle;
+
+    // Grow the pool geometrically, so that the number of slabs only grows
+    // logarithmically with the number of particles
+    if (free_slots.empty())
+      allocate_slab(std::max<std::size_t>(minimum_slab_size, n_slots / 2));
 
+    const Handle handle = free_slots.back();
+    free_slots.pop_back();
     return handle;
   }
 
@@ -44,7 +65,11 @@ namespace Particles
   void
   PropertyPool::deallocate_properties_array(Handle handle)
   {
-    delete[] handle;
+    if (handle == PropertyPool::invalid_handle)
+      return;
+
+    Assert(free_slots.size() < n_slots, ExcInternalError());
+    free_slots.push_back(handle);
   }
 
 
@@ -60,7 +85,68 @@ namespace Particles
   void
   PropertyPool::reserve(const std::size_t size)
   {
-    (void)size;
+    if (n_properties > 0 && free_slots.size() < size)
+      allocate_slab(size - free_slots.size());
+  }
+
+
+
+  void
+  PropertyPool::release_unused_memory()
+  {
+    // Sort the free slots by their address, and go through the slabs in
+    // the order of their addresses as well. A slab can be released if all
+    // of its slots are free, i.e., if the free slots contain all addresses
+    // in its range.
+    std::sort(free_slots.begin(), free_slots.end());
+    std::sort(slabs.begin(),
+              slabs.end(),
+              [](const std::pair<std::unique_ptr<double[]>, std::size_t> &a,
+                 const std::pair<std::unique_ptr<double[]>, std::size_t> &b) {
+                return std::less<double *>()(a.first.get(), b.first.get());
+              });
+
+    std::vector<std::pair<std::unique_ptr<double[]>, std::size_t>>
+                        remaining_slabs;
+    std::vector<Handle> remaining_free_slots;
+    remaining_free_slots.reserve(free_slots.size());
+
+    auto free_slot = free_slots.begin();
+    for (auto &slab : slabs)
+      {
+        double *const begin = slab.first.get();
+        double *const end   = begin + slab.second * n_properties;
+
+        // Skip free slots of slabs that were released before
+        while (free_slot != free_slots.end() &&
+               std::less<double *>()(*free_slot, begin))
+          ++free_slot;
+
+        const auto first_free_slot = free_slot;
+        while (free_slot != free_slots.end() &&
+               std::less<double *>()(*free_slot, end))
+          ++free_slot;
+
+        if (static_cast<std::size_t>(free_slot - first_free_slot) ==
+            slab.second)
+          n_slots -= slab.second;
+        else
+          {
+            remaining_free_slots.insert(remaining_free_slots.end(),
+                                        first_free_slot,
+                                        free_slot);
+            remaining_slabs.push_back(std::move(slab));
+          }
+      }
+
+    // New handles are taken from the back of the free list, so store the
+    // slots in reverse order to hand them out in increasing order of their
+    // addresses
+    std::reverse(remaining_free_slots.begin(), remaining_free_slots.end());
+
+    slabs.swap(remaining_slabs);
+    free_slots.swap(remaining_free_slots);
+    free_slots.shrink_to_fit();
   }
 
 
@@ -70,5 +156,43 @@ namespace Particles
   {
     return n_properties;
   }
+
+
+
+  std::size_t
+  PropertyPool::n_allocated_slots() const
+  {
+    return n_slots - free_slots.size();
+  }
+
+
+
+  std::size_t
+  PropertyPool::memory_consumption() const
+  {
+    return sizeof(*this) + n_slots * n_properties * sizeof(double) +
+           slabs.capacity() * sizeof(slabs[0]) +
+           free_slots.capacity() * sizeof(Handle);
+  }
+
+
+
+  void
+  PropertyPool::allocate_slab(const std::size_t n_new_slots)
+  {
+    Assert(n_properties > 0, ExcInternalError());
+
+    slabs.emplace_back(std::unique_ptr<double[]>(
+                         new double[n_new_slots * n_properties]),
+                       n_new_slots);
+    n_slots += n_new_slots;
+
+    // Add the new slots in reverse order, so that they are handed out in
+    // increasing order of their addresses
+    double *const slab = slabs.back().first.get();
+    free_slots.reserve(free_slots.size() + n_new_slots);
+    for (std::size_t i = n_new_slots; i > 0; --i)
+      free_slots.push_back(slab + (i - 1) * n_properties);
+  }
 } // namespace Particles
 DEAL_II_NAMESPACE_CLOSE
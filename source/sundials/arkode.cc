@@ -23,6 +23,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/vector_type_traits.h>
 #  ifdef DEAL_II_WITH_TRILINOS
 #    include <deal.II/lac/trilinos_parallel_block_vector.h>
 #    include <deal.II/lac/trilinos_vector.h>
@@ -32,7 +33,7 @@
 #    include <deal.II/lac/petsc_vector.h>
 #  endif
 
-#  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.templates.h>
 
 #  include <arkode/arkode_impl.h>
 #  include <sundials/sundials_config.h>
@@ -60,21 +61,10 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
 
-      int err = solver.explicit_function(tt, *src_yy, *dst_yp);
-
-      copy(yp, *dst_yp);
-
-      return err;
+      return solver.explicit_function(tt,
+                                     *unwrap_nvector_const<VectorType>(yy),
+                                     *unwrap_nvector<VectorType>(yp));
     }
 
 
@@ -88,21 +78,10 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
-
-      int err = solver.implicit_function(tt, *src_yy, *dst_yp);
-
-      copy(yp, *dst_yp);
-
-      return err;
+      return solver.implicit_function(tt,
+                                     *unwrap_nvector_const<VectorType>(yy),
+                                     *unwrap_nvector<VectorType>(yp));
     }
 
 
@@ -120,25 +99,16 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ypred(mem);
-      solver.reinit_vector(*src_ypred);
-
-      typename VectorMemory<VectorType>::Pointer src_fpred(mem);
-      solver.reinit_vector(*src_fpred);
-
-      copy(*src_ypred, ypred);
-      copy(*src_fpred, fpred);
 
       // avoid reinterpret_cast
       bool jcurPtr_tmp = false;
-      int  err         = solver.setup_jacobian(convfail,
-                                      arkode_mem->ark_tn,
-                                      arkode_mem->ark_gamma,
-                                      *src_ypred,
-                                      *src_fpred,
-                                      jcurPtr_tmp);
+      int  err =
+        solver.setup_jacobian(convfail,
+                              arkode_mem->ark_tn,
+                              arkode_mem->ark_gamma,
+                              *unwrap_nvector_const<VectorType>(ypred),
+                              *unwrap_nvector_const<VectorType>(fpred),
+                              jcurPtr_tmp);
 #  if DEAL_II_SUNDIALS_VERSION_GTE(2, 0, 0)
       *jcurPtr = jcurPtr_tmp ? SUNTRUE : SUNFALSE;
 #  else
@@ -164,29 +134,21 @@ namespace SUNDIALS
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
+      // the solution overwrites the right hand side b, so it needs to be
+      // computed in a temporary vector
+      VectorType &src = *unwrap_nvector<VectorType>(b);
 
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-      copy(*src_ycur, ycur);
-      copy(*src_fcur, fcur);
-
-      int err = solver.solve_jacobian_system(arkode_mem->ark_tn,
-                                             arkode_mem->ark_gamma,
-                                             *src_ycur,
-                                             *src_fcur,
-                                             *src,
-                                             *dst);
-      copy(b, *dst);
+      const int err = solver.solve_jacobian_system(
+        arkode_mem->ark_tn,
+        arkode_mem->ark_gamma,
+        *unwrap_nvector_const<VectorType>(ycur),
+        *unwrap_nvector_const<VectorType>(fcur),
+        src,
+        *dst);
+      src = *dst;
 
       return err;
     }
@@ -220,16 +182,13 @@ namespace SUNDIALS
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
+      VectorType &src = *unwrap_nvector<VectorType>(b);
 
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-
-      int err = solver.solve_mass_system(*src, *dst);
-      copy(b, *dst);
+      const int err = solver.solve_mass_system(src, *dst);
+      src           = *dst;
 
       return err;
     }
@@ -270,8 +229,6 @@ namespace SUNDIALS
   unsigned int
   ARKode<VectorType>::solve_ode(VectorType &solution)
   {
-    unsigned int system_size = solution.size();
-
     double       t           = data.initial_time;
     double       h           = data.initial_step_size;
     unsigned int step_number = 0;
@@ -279,29 +236,6 @@ namespace SUNDIALS
     int status;
     (void)status;
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
     reset(data.initial_time, data.initial_step_size, solution);
 
     double next_time = data.initial_time;
@@ -320,7 +254,7 @@ namespace SUNDIALS
         status = ARKodeGetLastStep(arkode_mem, &h);
         AssertARKode(status);
 
-        copy(solution, yy);
+        solution = *unwrap_nvector_const<VectorType>(yy);
 
         while (solver_should_restart(t, solution))
           reset(t, h, solution);
@@ -331,19 +265,11 @@ namespace SUNDIALS
           output_step(t, solution, step_number);
       }
 
-      // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(yy);
-        N_VDestroy_Parallel(abs_tolls);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(yy);
-        N_VDestroy_Serial(abs_tolls);
-      }
+    // Free the vectors which are no longer used.
+    N_VDestroy(yy);
+    N_VDestroy(abs_tolls);
+    yy        = nullptr;
+    abs_tolls = nullptr;
 
     return step_number;
   }
@@ -354,8 +280,6 @@ namespace SUNDIALS
                             const double      current_time_step,
                             const VectorType &solution)
   {
-    unsigned int system_size;
-
     if (arkode_mem)
       ARKodeFree(&arkode_mem);
 
@@ -364,42 +288,20 @@ namespace SUNDIALS
     // Free the vectors which are no longer used.
     if (yy)
       {
-#  ifdef DEAL_II_WITH_MPI
-        if (is_serial_vector<VectorType>::value == false)
-          {
-            N_VDestroy_Parallel(yy);
-            N_VDestroy_Parallel(abs_tolls);
-          }
-        else
-#  endif
-          {
-            N_VDestroy_Serial(yy);
-            N_VDestroy_Serial(abs_tolls);
-          }
+        N_VDestroy(yy);
+        N_VDestroy(abs_tolls);
       }
 
     int status;
     (void)status;
-    system_size = solution.size();
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
 
-    copy(yy, solution);
+    // The vectors SUNDIALS operates on store deal.II vectors, such that the
+    // callbacks can access them without copying. Serial vectors are not
+    // shared across the processes, so their reductions must stay local.
+    const MPI_Comm vector_communicator =
+      is_serial_vector<VectorType>::value ? MPI_COMM_SELF : communicator;
+    yy        = create_nvector(solution, vector_communicator);
+    abs_tolls = create_nvector(solution, vector_communicator);
 
     Assert(explicit_function || implicit_function,
            ExcFunctionNotProvided("explicit_function || implicit_function"));
@@ -414,7 +316,7 @@ namespace SUNDIALS
 
     if (get_local_tolerances)
       {
-        copy(abs_tolls, get_local_tolerances());
+        *unwrap_nvector<VectorType>(abs_tolls) = get_local_tolerances();
         status =
           ARKodeSVtolerances(arkode_mem, data.relative_tolerance, abs_tolls);
         AssertARKode(status);
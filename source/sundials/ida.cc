@@ -23,6 +23,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/vector_type_traits.h>
 #  ifdef DEAL_II_WITH_TRILINOS
 #    include <deal.II/lac/trilinos_parallel_block_vector.h>
 #    include <deal.II/lac/trilinos_vector.h>
@@ -32,13 +33,21 @@
 #    include <deal.II/lac/petsc_vector.h>
 #  endif
 
-#  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.templates.h>
 
 #  ifdef DEAL_II_SUNDIALS_WITH_IDAS
 #    include <idas/idas_impl.h>
 #  else
 #    include <ida/ida_impl.h>
 #  endif
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+#    ifdef DEAL_II_SUNDIALS_WITH_IDAS
+#      include <idas/idas_spils.h>
+#    else
+#      include <ida/ida_spils.h>
+#    endif
+#    include <sunlinsol/sunlinsol_spgmr.h>
+#  endif
 
 #  include <iomanip>
 #  include <iostream>
@@ -60,25 +69,11 @@ namespace SUNDIALS
                    void *   user_data)
     {
       IDA<VectorType> &solver = *static_cast<IDA<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer src_yp(mem);
-      solver.reinit_vector(*src_yp);
-
-      typename VectorMemory<VectorType>::Pointer residual(mem);
-      solver.reinit_vector(*residual);
-
-      copy(*src_yy, yy);
-      copy(*src_yp, yp);
-
-      int err = solver.residual(tt, *src_yy, *src_yp, *residual);
 
-      copy(rr, *residual);
-
-      return err;
+      return solver.residual(tt,
+                             *unwrap_nvector_const<VectorType>(yy),
+                             *unwrap_nvector_const<VectorType>(yp),
+                             *unwrap_nvector<VectorType>(rr));
     }
 
 
@@ -99,23 +94,11 @@ namespace SUNDIALS
       (void)resp;
       IDA<VectorType> &solver =
         *static_cast<IDA<VectorType> *>(IDA_mem->ida_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer src_yp(mem);
-      solver.reinit_vector(*src_yp);
-
-      copy(*src_yy, yy);
-      copy(*src_yp, yp);
-
-      int err = solver.setup_jacobian(IDA_mem->ida_tn,
-                                      *src_yy,
-                                      *src_yp,
-                                      IDA_mem->ida_cj);
 
-      return err;
+      return solver.setup_jacobian(IDA_mem->ida_tn,
+                                   *unwrap_nvector_const<VectorType>(yy),
+                                   *unwrap_nvector_const<VectorType>(yp),
+                                   IDA_mem->ida_cj);
     }
 
 
@@ -136,20 +119,99 @@ namespace SUNDIALS
         *static_cast<IDA<VectorType> *>(IDA_mem->ida_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
+      // the solution overwrites the right hand side b, so it needs to be
+      // computed in a temporary vector
+      VectorType &src = *unwrap_nvector<VectorType>(b);
 
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-
-      int err = solver.solve_jacobian_system(*src, *dst);
-      copy(b, *dst);
+      const int err = solver.solve_jacobian_system(src, *dst);
+      src           = *dst;
 
       return err;
     }
 
+
+
+    template <typename VectorType>
+    int
+    t_dae_jacobian_times_vector(realtype tt,
+                                N_Vector yy,
+                                N_Vector yp,
+                                N_Vector,
+                                N_Vector v,
+                                N_Vector Jv,
+                                realtype c_j,
+                                void *   user_data,
+                                N_Vector,
+                                N_Vector)
+    {
+      IDA<VectorType> &solver = *static_cast<IDA<VectorType> *>(user_data);
+
+      return solver.jacobian_times_vector(tt,
+                                          *unwrap_nvector_const<VectorType>(yy),
+                                          *unwrap_nvector_const<VectorType>(yp),
+                                          c_j,
+                                          *unwrap_nvector_const<VectorType>(v),
+                                          *unwrap_nvector<VectorType>(Jv));
+    }
+
+
+
+    template <typename VectorType>
+    int
+    t_dae_setup_preconditioner(realtype tt,
+                               N_Vector yy,
+                               N_Vector yp,
+                               N_Vector,
+                               realtype c_j,
+                               void *   user_data
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+                               ,
+                               N_Vector,
+                               N_Vector,
+                               N_Vector
+#  endif
+    )
+    {
+      IDA<VectorType> &solver = *static_cast<IDA<VectorType> *>(user_data);
+
+      if (solver.reuse_preconditioner(tt, c_j))
+        return 0;
+
+      return solver.setup_preconditioner(tt,
+                                         *unwrap_nvector_const<VectorType>(yy),
+                                         *unwrap_nvector_const<VectorType>(yp),
+                                         c_j);
+    }
+
+
+
+    template <typename VectorType>
+    int
+    t_dae_solve_with_preconditioner(realtype,
+                                    N_Vector,
+                                    N_Vector,
+                                    N_Vector,
+                                    N_Vector rvec,
+                                    N_Vector zvec,
+                                    realtype,
+                                    realtype,
+                                    void *user_data
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+                                    ,
+                                    N_Vector
+#  endif
+    )
+    {
+      IDA<VectorType> &solver = *static_cast<IDA<VectorType> *>(user_data);
+
+      return solver.solve_with_preconditioner(
+        *unwrap_nvector_const<VectorType>(rvec),
+        *unwrap_nvector<VectorType>(zvec));
+    }
+
   } // namespace
 
   template <typename VectorType>
@@ -160,6 +222,12 @@ namespace SUNDIALS
     , yp(nullptr)
     , abs_tolls(nullptr)
     , diff_id(nullptr)
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+    , linear_solver(nullptr)
+#  endif
+    , last_preconditioner_alpha(0.)
+    , n_preconditioner_reuses(0)
+    , n_convergence_failures_at_setup(0)
     , communicator(is_serial_vector<VectorType>::value ?
                      MPI_COMM_SELF :
                      Utilities::MPI::duplicate_communicator(mpi_comm))
@@ -172,6 +240,10 @@ namespace SUNDIALS
   {
     if (ida_mem)
       IDAFree(&ida_mem);
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+    if (linear_solver)
+      SUNLinSolFree(linear_solver);
+#  endif
 #  ifdef DEAL_II_WITH_MPI
     if (is_serial_vector<VectorType>::value == false)
       {
@@ -188,8 +260,6 @@ namespace SUNDIALS
   unsigned int
   IDA<VectorType>::solve_dae(VectorType &solution, VectorType &solution_dot)
   {
-    unsigned int system_size = solution.size();
-
     double       t           = data.initial_time;
     double       h           = data.initial_step_size;
     unsigned int step_number = 0;
@@ -197,35 +267,6 @@ namespace SUNDIALS
     int status;
     (void)status;
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        yp = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        diff_id = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
-        yy        = N_VNew_Serial(system_size);
-        yp        = N_VNew_Serial(system_size);
-        diff_id   = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
     reset(data.initial_time, data.initial_step_size, solution, solution_dot);
 
     double next_time = data.initial_time;
@@ -242,8 +283,8 @@ namespace SUNDIALS
         status = IDAGetLastStep(ida_mem, &h);
         AssertIDA(status);
 
-        copy(solution, yy);
-        copy(solution_dot, yp);
+        solution     = *unwrap_nvector_const<VectorType>(yy);
+        solution_dot = *unwrap_nvector_const<VectorType>(yp);
 
         while (solver_should_restart(t, solution, solution_dot))
           reset(t, h, solution, solution_dot);
@@ -253,23 +294,15 @@ namespace SUNDIALS
         output_step(t, solution, solution_dot, step_number);
       }
 
-      // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(yy);
-        N_VDestroy_Parallel(yp);
-        N_VDestroy_Parallel(abs_tolls);
-        N_VDestroy_Parallel(diff_id);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(yy);
-        N_VDestroy_Serial(yp);
-        N_VDestroy_Serial(abs_tolls);
-        N_VDestroy_Serial(diff_id);
-      }
+    // Free the vectors which are no longer used.
+    N_VDestroy(yy);
+    N_VDestroy(yp);
+    N_VDestroy(abs_tolls);
+    N_VDestroy(diff_id);
+    yy        = nullptr;
+    yp        = nullptr;
+    abs_tolls = nullptr;
+    diff_id   = nullptr;
 
     return step_number;
   }
@@ -281,72 +314,54 @@ namespace SUNDIALS
                          VectorType & solution,
                          VectorType & solution_dot)
   {
-    unsigned int system_size;
-    bool         first_step = (current_time == data.initial_time);
+    bool first_step = (current_time == data.initial_time);
 
     if (ida_mem)
       IDAFree(&ida_mem);
 
     ida_mem = IDACreate();
 
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+    if (linear_solver)
+      SUNLinSolFree(linear_solver);
+    linear_solver = nullptr;
+#  endif
+
+    // The counters of the new IDA object start from zero, so the next setup
+    // request always has to set up the preconditioner.
+    last_preconditioner_alpha       = 0.;
+    n_preconditioner_reuses         = 0;
+    n_convergence_failures_at_setup = 0;
+
 
     // Free the vectors which are no longer used.
     if (yy)
       {
-#  ifdef DEAL_II_WITH_MPI
-        if (is_serial_vector<VectorType>::value == false)
-          {
-            N_VDestroy_Parallel(yy);
-            N_VDestroy_Parallel(yp);
-            N_VDestroy_Parallel(abs_tolls);
-            N_VDestroy_Parallel(diff_id);
-          }
-        else
-#  endif
-          {
-            N_VDestroy_Serial(yy);
-            N_VDestroy_Serial(yp);
-            N_VDestroy_Serial(abs_tolls);
-            N_VDestroy_Serial(diff_id);
-          }
+        N_VDestroy(yy);
+        N_VDestroy(yp);
+        N_VDestroy(abs_tolls);
+        N_VDestroy(diff_id);
       }
 
     int status;
     (void)status;
-    system_size = solution.size();
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
 
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        yp = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        diff_id = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        yy        = N_VNew_Serial(system_size);
-        yp        = N_VNew_Serial(system_size);
-        diff_id   = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
-
-    copy(yy, solution);
-    copy(yp, solution_dot);
+    // The vectors SUNDIALS operates on store deal.II vectors, such that the
+    // callbacks can access them without copying. Serial vectors are not
+    // shared across the processes, so their reductions must stay local.
+    const MPI_Comm vector_communicator =
+      is_serial_vector<VectorType>::value ? MPI_COMM_SELF : communicator;
+    yy        = create_nvector(solution, vector_communicator);
+    yp        = create_nvector(solution_dot, vector_communicator);
+    diff_id   = create_nvector(solution, vector_communicator);
+    abs_tolls = create_nvector(solution, vector_communicator);
 
     status = IDAInit(ida_mem, t_dae_residual<VectorType>, current_time, yy, yp);
     AssertIDA(status);
 
     if (get_local_tolerances)
       {
-        copy(abs_tolls, get_local_tolerances());
+        *unwrap_nvector<VectorType>(abs_tolls) = get_local_tolerances();
         status = IDASVtolerances(ida_mem, data.relative_tolerance, abs_tolls);
         AssertIDA(status);
       }
@@ -368,13 +383,13 @@ namespace SUNDIALS
         data.reset_type == AdditionalData::use_y_diff ||
         data.ignore_algebraic_terms_for_errors)
       {
-        VectorType diff_comp_vector(solution);
-        diff_comp_vector = 0.0;
-        auto dc          = differential_components();
+        VectorType &diff_comp_vector = *unwrap_nvector<VectorType>(diff_id);
+        diff_comp_vector             = 0.0;
+        auto dc                      = differential_components();
         for (auto i = dc.begin(); i != dc.end(); ++i)
           diff_comp_vector[*i] = 1.0;
+        diff_comp_vector.compress(VectorOperation::insert);
 
-        copy(diff_id, diff_comp_vector);
         status = IDASetId(ida_mem, diff_id);
         AssertIDA(status);
       }
@@ -390,13 +405,53 @@ namespace SUNDIALS
     AssertIDA(status);
 
     // Initialize solver
-    auto IDA_mem = static_cast<IDAMem>(ida_mem);
+    if (data.use_krylov_solver)
+      {
+        // IDA only supports left preconditioning
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+        linear_solver =
+          SUNSPGMR(yy,
+                   solve_with_preconditioner ? PREC_LEFT : PREC_NONE,
+                   data.krylov_subspace_size);
+
+        status = IDASpilsSetLinearSolver(ida_mem, linear_solver);
+#  else
+        status = IDASpgmr(ida_mem, data.krylov_subspace_size);
+#  endif
+        AssertIDA(status);
 
-    IDA_mem->ida_lsetup = t_dae_lsetup<VectorType>;
-    IDA_mem->ida_lsolve = t_dae_solve<VectorType>;
+        if (solve_with_preconditioner)
+          {
+            status = IDASpilsSetPreconditioner(
+              ida_mem,
+              setup_preconditioner ? t_dae_setup_preconditioner<VectorType> :
+                                     nullptr,
+              t_dae_solve_with_preconditioner<VectorType>);
+            AssertIDA(status);
+          }
+
+        if (jacobian_times_vector)
+          {
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+            status = IDASpilsSetJacTimes(
+              ida_mem, nullptr, t_dae_jacobian_times_vector<VectorType>);
+#  else
+            status = IDASpilsSetJacTimesVecFn(
+              ida_mem, t_dae_jacobian_times_vector<VectorType>);
+#  endif
+            AssertIDA(status);
+          }
+      }
+    else
+      {
+        auto IDA_mem = static_cast<IDAMem>(ida_mem);
+
+        IDA_mem->ida_lsetup = t_dae_lsetup<VectorType>;
+        IDA_mem->ida_lsolve = t_dae_solve<VectorType>;
 #  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
-    IDA_mem->ida_setupNonNull = true;
+        IDA_mem->ida_setupNonNull = true;
 #  endif
+      }
 
     status = IDASetMaxOrd(ida_mem, data.maximum_order);
     AssertIDA(status);
@@ -421,8 +476,8 @@ namespace SUNDIALS
         status = IDAGetConsistentIC(ida_mem, yy, yp);
         AssertIDA(status);
 
-        copy(solution, yy);
-        copy(solution_dot, yp);
+        solution     = *unwrap_nvector_const<VectorType>(yy);
+        solution_dot = *unwrap_nvector_const<VectorType>(yp);
       }
     else if (type == AdditionalData::use_y_diff)
       {
@@ -433,8 +488,8 @@ namespace SUNDIALS
         status = IDAGetConsistentIC(ida_mem, yy, yp);
         AssertIDA(status);
 
-        copy(solution, yy);
-        copy(solution_dot, yp);
+        solution     = *unwrap_nvector_const<VectorType>(yy);
+        solution_dot = *unwrap_nvector_const<VectorType>(yp);
       }
   }
 
@@ -478,6 +533,30 @@ namespace SUNDIALS
     solver_should_restart =
       [](const double, VectorType &, VectorType &) -> bool { return false; };
 
+    reuse_preconditioner = [&](const double, const double alpha) -> bool {
+      long int  n_convergence_failures = 0;
+      const int status =
+        IDAGetNumNonlinSolvConvFails(ida_mem, &n_convergence_failures);
+      (void)status;
+      AssertIDA(status);
+
+      const bool reuse =
+        n_preconditioner_reuses < data.maximum_preconditioner_reuses &&
+        n_convergence_failures == n_convergence_failures_at_setup &&
+        std::abs(alpha - last_preconditioner_alpha) <=
+          data.preconditioner_alpha_tolerance * last_preconditioner_alpha;
+
+      if (reuse)
+        ++n_preconditioner_reuses;
+      else
+        {
+          last_preconditioner_alpha       = alpha;
+          n_preconditioner_reuses         = 0;
+          n_convergence_failures_at_setup = n_convergence_failures;
+        }
+      return reuse;
+    };
+
     differential_components = [&]() -> IndexSet {
       GrowingVectorMemory<VectorType>            mem;
       typename VectorMemory<VectorType>::Pointer v(mem);
@@ -37,10 +37,13 @@
 #  include <sundials/sundials_config.h>
 #  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
 #    include <kinsol/kinsol_direct.h>
+#    include <kinsol/kinsol_spils.h>
 #    include <sunlinsol/sunlinsol_dense.h>
+#    include <sunlinsol/sunlinsol_spgmr.h>
 #    include <sunmatrix/sunmatrix_dense.h>
 #  else
 #    include <kinsol/kinsol_dense.h>
+#    include <kinsol/kinsol_spgmr.h>
 #  endif
 
 #  include <iomanip>
@@ -147,6 +150,117 @@ namespace SUNDIALS
 
       return err;
     }
+
+
+
+    template <typename VectorType>
+    int
+    t_kinsol_jacobian_times_vector(N_Vector     v,
+                                   N_Vector     Jv,
+                                   N_Vector     uu,
+                                   booleantype *new_uu,
+                                   void *       user_data)
+    {
+      (void)new_uu;
+      KINSOL<VectorType> &solver =
+        *static_cast<KINSOL<VectorType> *>(user_data);
+      GrowingVectorMemory<VectorType> mem;
+
+      typename VectorMemory<VectorType>::Pointer src_uu(mem);
+      solver.reinit_vector(*src_uu);
+
+      typename VectorMemory<VectorType>::Pointer src_v(mem);
+      solver.reinit_vector(*src_v);
+
+      typename VectorMemory<VectorType>::Pointer dst_Jv(mem);
+      solver.reinit_vector(*dst_Jv);
+
+      copy(*src_uu, uu);
+      copy(*src_v, v);
+
+      int err = solver.jacobian_times_vector(*src_uu, *src_v, *dst_Jv);
+
+      copy(Jv, *dst_Jv);
+
+      return err;
+    }
+
+
+
+    template <typename VectorType>
+    int
+    t_kinsol_setup_preconditioner(N_Vector uu,
+                                  N_Vector,
+                                  N_Vector fval,
+                                  N_Vector,
+                                  void *user_data
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+                                  ,
+                                  N_Vector,
+                                  N_Vector
+#  endif
+    )
+    {
+      KINSOL<VectorType> &solver =
+        *static_cast<KINSOL<VectorType> *>(user_data);
+      GrowingVectorMemory<VectorType> mem;
+
+      typename VectorMemory<VectorType>::Pointer src_uu(mem);
+      solver.reinit_vector(*src_uu);
+
+      typename VectorMemory<VectorType>::Pointer src_fval(mem);
+      solver.reinit_vector(*src_fval);
+
+      copy(*src_uu, uu);
+      copy(*src_fval, fval);
+
+      return solver.setup_preconditioner(*src_uu, *src_fval);
+    }
+
+
+
+    template <typename VectorType>
+    int
+    t_kinsol_solve_with_preconditioner(N_Vector uu,
+                                       N_Vector,
+                                       N_Vector fval,
+                                       N_Vector,
+                                       N_Vector vv,
+                                       void *   user_data
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+                                       ,
+                                       N_Vector
+#  endif
+    )
+    {
+      KINSOL<VectorType> &solver =
+        *static_cast<KINSOL<VectorType> *>(user_data);
+      GrowingVectorMemory<VectorType> mem;
+
+      typename VectorMemory<VectorType>::Pointer src_uu(mem);
+      solver.reinit_vector(*src_uu);
+
+      typename VectorMemory<VectorType>::Pointer src_fval(mem);
+      solver.reinit_vector(*src_fval);
+
+      typename VectorMemory<VectorType>::Pointer src(mem);
+      solver.reinit_vector(*src);
+
+      typename VectorMemory<VectorType>::Pointer dst(mem);
+      solver.reinit_vector(*dst);
+
+      copy(*src_uu, uu);
+      copy(*src_fval, fval);
+      copy(*src, vv);
+
+      // vv holds the right hand side on entry and the preconditioned vector
+      // on exit
+      int err =
+        solver.solve_with_preconditioner(*src_uu, *src_fval, *src, *dst);
+      copy(vv, *dst);
+
+      return err;
+    }
   } // namespace
 
   template <typename VectorType>
@@ -272,7 +386,38 @@ namespace SUNDIALS
     SUNLinearSolver LS = nullptr;
 #  endif
 
-    if (solve_jacobian_system)
+    if (data.use_krylov_solver)
+      {
+        // KINSOL only supports right preconditioning
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+        LS = SUNSPGMR(solution,
+                      solve_with_preconditioner ? PREC_RIGHT : PREC_NONE,
+                      data.krylov_subspace_size);
+
+        status = KINSpilsSetLinearSolver(kinsol_mem, LS);
+#  else
+        status = KINSpgmr(kinsol_mem, data.krylov_subspace_size);
+#  endif
+        AssertKINSOL(status);
+
+        if (solve_with_preconditioner)
+          {
+            status = KINSpilsSetPreconditioner(
+              kinsol_mem,
+              setup_preconditioner ? t_kinsol_setup_preconditioner<VectorType> :
+                                     nullptr,
+              t_kinsol_solve_with_preconditioner<VectorType>);
+            AssertKINSOL(status);
+          }
+
+        if (jacobian_times_vector)
+          {
+            status = KINSpilsSetJacTimesVecFn(
+              kinsol_mem, t_kinsol_jacobian_times_vector<VectorType>);
+            AssertKINSOL(status);
+          }
+      }
+    else if (solve_jacobian_system)
       {
         auto KIN_mem        = static_cast<KINMem>(kinsol_mem);
         KIN_mem->kin_lsolve = t_kinsol_solve_jacobian<VectorType>;